@@ -44,6 +44,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/sched_profile.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/drivers/drivers.h>
 #include <nuttx/fs/loop.h>
@@ -52,6 +53,7 @@
 #include <nuttx/net/telnet.h>
 #include <nuttx/syslog/syslog.h>
 #include <nuttx/syslog/syslog_console.h>
+#include <nuttx/syslog/binlog.h>
 #include <nuttx/serial/pty.h>
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/power/pm.h>
@@ -195,6 +197,14 @@ void up_initialize(void)
   note_register();      /* Non-standard /dev/note */
 #endif
 
+#if defined(CONFIG_SCHED_PROFILE) && defined(CONFIG_DRIVER_PROFILE)
+  profile_register();   /* Non-standard /dev/profile */
+#endif
+
+#ifdef CONFIG_BINLOG
+  binlog_register();    /* Non-standard /dev/binlog */
+#endif
+
   /* Initialize the serial device driver */
 
 #ifdef USE_SERIALDRIVER
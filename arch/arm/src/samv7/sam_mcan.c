@@ -967,7 +967,7 @@ static bool mcan_dedicated_rxbuffer_available(FAR struct sam_mcan_s *priv,
 static void mcan_error(FAR struct can_dev_s *dev, uint32_t status);
 #endif
 static void mcan_receive(FAR struct can_dev_s *dev,
-              FAR uint32_t *rxbuffer, unsigned long nwords);
+              FAR uint32_t *rxbuffer, unsigned long nwords, uint8_t prio);
 static int  mcan_interrupt(int irq, void *context, FAR void *arg);
 
 /* Hardware initialization */
@@ -1786,7 +1786,7 @@ static int mcan_add_extfilter(FAR struct sam_mcan_s *priv,
             }
           else
             {
-              regval |= EXTFILTER_F0_EFEC_FIFO0;
+              regval |= EXTFILTER_F0_EFEC_FIFO1;
             }
 
           extfilter[0] = regval;
@@ -3310,6 +3310,8 @@ static void mcan_error(FAR struct can_dev_s *dev, uint32_t status)
  *   dev      - CAN-common state data
  *   rxbuffer - The RX buffer containing the received messages
  *   nwords   - The length of the RX buffer (element size in words).
+ *   prio     - CAN_MSGPRIO_HIGH for messages from RX FIFO1, which is fed by
+ *              the high priority filters
  *
  * Returned Value:
  *   None
@@ -3317,7 +3319,7 @@ static void mcan_error(FAR struct can_dev_s *dev, uint32_t status)
  ****************************************************************************/
 
 static void mcan_receive(FAR struct can_dev_s *dev, FAR uint32_t *rxbuffer,
-                         unsigned long nwords)
+                         unsigned long nwords, uint8_t prio)
 {
   struct can_hdr_s hdr;
   uint32_t regval;
@@ -3385,7 +3387,12 @@ static void mcan_receive(FAR struct can_dev_s *dev, FAR uint32_t *rxbuffer,
 
   /* And provide the CAN message to the upper half logic */
 
+#ifdef CONFIG_CAN_RXPRIO
+  ret = can_receive_prio(dev, &hdr, (FAR uint8_t *)rxbuffer, prio);
+#else
+  UNUSED(prio);
   ret = can_receive(dev, &hdr, (FAR uint8_t *)rxbuffer);
+#endif
   if (ret < 0)
     {
       canerr("ERROR: can_receive failed: %d\n", ret);
@@ -3592,7 +3599,8 @@ static int mcan_interrupt(int irq, void *context, FAR void *arg)
                    */
 
                   arch_invalidata_dcache();
-                  mcan_receive(priv, rxdedicated, config->rxbufferesize);
+                  mcan_receive(priv, rxdedicated, config->rxbufferesize,
+                               CAN_MSGPRIO_LOW);
 
                   /* Clear the new data flag for the buffer */
 
@@ -3651,7 +3659,7 @@ static int mcan_interrupt(int irq, void *context, FAR void *arg)
               mcan_receive(dev,
                            config->msgram.rxfifo1 +
                              (ndx * priv->config->rxfifo1esize),
-                           priv->config->rxfifo1esize);
+                           priv->config->rxfifo1esize, CAN_MSGPRIO_HIGH);
 
               /* Turning back on all configured RX error interrupts */
 
@@ -3690,7 +3698,7 @@ static int mcan_interrupt(int irq, void *context, FAR void *arg)
               mcan_receive(dev,
                            config->msgram.rxfifo0 +
                              (ndx * priv->config->rxfifo0esize),
-                           priv->config->rxfifo0esize);
+                           priv->config->rxfifo0esize, CAN_MSGPRIO_LOW);
 
               /* Turning back on all configured RX error interrupts */
 
@@ -76,6 +76,7 @@
 #include <arch/board/board.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
@@ -275,6 +276,14 @@ struct stm32_transport_s
   sq_queue_t done;            /* A queue of completed transfers */
   struct work_s work;         /* Supports worker thread operations */
 
+#ifdef CONFIG_I2S_RING
+  bool ring;                  /* True: Circular DMA ring transfer active */
+  uint8_t *ringbuf;           /* The ring buffer */
+  size_t ringsize;            /* The size of the ring buffer in bytes */
+  i2s_ringcallback_t ringcb;  /* Ring buffer half complete callback */
+  void *ringarg;              /* The argument to be returned with ringcb */
+#endif
+
 #ifdef CONFIG_STM32_I2S_DMADEBUG
   struct stm32_dmaregs_s dmaregs[DMA_NSAMPLES];
 #endif
@@ -430,6 +439,30 @@ static int      stm32_i2s_send(struct i2s_dev_s *dev, struct ap_buffer_s *apb,
                   i2s_callback_t callback, void *arg,
                   uint32_t timeout);
 
+/* Circular DMA (ring buffer) support */
+
+#ifdef CONFIG_I2S_RING
+static void     i2s_ring_done(struct stm32_i2s_s *priv,
+                  struct stm32_transport_s *xpt, uint8_t status,
+                  uint16_t dmaen);
+static int      i2s_ring_start(struct stm32_i2s_s *priv,
+                  struct stm32_transport_s *xpt, uint8_t *buffer,
+                  size_t nbytes, i2s_ringcallback_t callback, void *arg,
+                  uint32_t ccr, dma_callback_t dmacb, uint16_t dmaen);
+#ifdef I2S_HAVE_RX
+static void     i2s_rxring_callback(DMA_HANDLE handle, uint8_t status,
+                  void *arg);
+#endif
+#ifdef I2S_HAVE_TX
+static void     i2s_txring_callback(DMA_HANDLE handle, uint8_t status,
+                  void *arg);
+#endif
+static int      stm32_i2s_rxring(struct i2s_dev_s *dev, uint8_t *buffer,
+                  size_t nbytes, i2s_ringcallback_t callback, void *arg);
+static int      stm32_i2s_txring(struct i2s_dev_s *dev, uint8_t *buffer,
+                  size_t nbytes, i2s_ringcallback_t callback, void *arg);
+#endif
+
 /* Initialization */
 
 static uint32_t i2s_mckdivider(struct stm32_i2s_s *priv);
@@ -462,6 +495,13 @@ static const struct i2s_ops_s g_i2sops =
   .i2s_txsamplerate = stm32_i2s_txsamplerate,
   .i2s_txdatawidth  = stm32_i2s_txdatawidth,
   .i2s_send         = stm32_i2s_send,
+
+#ifdef CONFIG_I2S_RING
+  /* Circular DMA (ring buffer) methods */
+
+  .i2s_rxring       = stm32_i2s_rxring,
+  .i2s_txring       = stm32_i2s_txring,
+#endif
 };
 
 /****************************************************************************
@@ -1913,6 +1953,16 @@ static int stm32_i2s_receive(struct i2s_dev_s *dev, struct ap_buffer_s *apb,
       goto errout_with_exclsem;
     }
 
+#ifdef CONFIG_I2S_RING
+  /* Per-buffer transfers cannot be mixed with a ring transfer */
+
+  if (priv->rx.ring)
+    {
+      ret = -EBUSY;
+      goto errout_with_exclsem;
+    }
+#endif
+
   /* Add a reference to the audio buffer */
 
   apb_reference(apb);
@@ -2119,6 +2169,16 @@ static int stm32_i2s_send(struct i2s_dev_s *dev, struct ap_buffer_s *apb,
       goto errout_with_exclsem;
     }
 
+#ifdef CONFIG_I2S_RING
+  /* Per-buffer transfers cannot be mixed with a ring transfer */
+
+  if (priv->tx.ring)
+    {
+      ret = -EBUSY;
+      goto errout_with_exclsem;
+    }
+#endif
+
   /* Add a reference to the audio buffer */
 
   apb_reference(apb);
@@ -2158,6 +2218,295 @@ errout_with_exclsem:
 #endif
 }
 
+/****************************************************************************
+ * Name: i2s_ring_done
+ *
+ * Description:
+ *   Common DMA interrupt handling for circular DMA ring transfers:  Report
+ *   each completed half of the ring buffer to the client.
+ *
+ * Input Parameters:
+ *   priv   - I2S device structure
+ *   xpt    - The RX or TX transport
+ *   status - The DMA interrupt status
+ *   dmaen  - The SPI CR2 DMA enable bit for this direction
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the DMA interrupt handler
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2S_RING
+static void i2s_ring_done(struct stm32_i2s_s *priv,
+                          struct stm32_transport_s *xpt, uint8_t status,
+                          uint16_t dmaen)
+{
+  struct timespec ts;
+  size_t half;
+
+  /* Ignore interrupts after the ring transfer has been stopped */
+
+  if (!xpt->ring)
+    {
+      return;
+    }
+
+  (void)clock_systimespec(&ts);
+
+  /* Check for DMA errors.  The ring transfer cannot continue after an
+   * error, so stop it and report the failure.
+   */
+
+  if ((status & (DMA_STATUS_TEIF | DMA_STATUS_DMEIF)) != 0)
+    {
+      i2serr("ERROR: DMA failed: %02x\n", status);
+
+      xpt->ring = false;
+      stm32_dmastop(xpt->dma);
+      i2s_putreg(priv, STM32_SPI_CR2_OFFSET,
+                 i2s_getreg(priv, STM32_SPI_CR2_OFFSET) & ~dmaen);
+
+      xpt->ringcb(&priv->dev, NULL, 0, &ts, xpt->ringarg, -EIO);
+      return;
+    }
+
+  /* Report the first half at the half transfer interrupt and the second
+   * half at the transfer complete (wrap) interrupt.  Both may be pending
+   * together if the interrupt was delayed.
+   */
+
+  half = xpt->ringsize >> 1;
+
+  if ((status & DMA_STATUS_HTIF) != 0)
+    {
+      xpt->ringcb(&priv->dev, xpt->ringbuf, half, &ts, xpt->ringarg, OK);
+    }
+
+  if ((status & DMA_STATUS_TCIF) != 0)
+    {
+      xpt->ringcb(&priv->dev, xpt->ringbuf + half, half, &ts, xpt->ringarg,
+                  OK);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: i2s_rxring_callback and i2s_txring_callback
+ *
+ * Description:
+ *   Circular DMA interrupt callbacks
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_I2S_RING) && defined(I2S_HAVE_RX)
+static void i2s_rxring_callback(DMA_HANDLE handle, uint8_t status, void *arg)
+{
+  struct stm32_i2s_s *priv = (struct stm32_i2s_s *)arg;
+  DEBUGASSERT(priv != NULL);
+
+  i2s_ring_done(priv, &priv->rx, status, SPI_CR2_RXDMAEN);
+}
+#endif
+
+#if defined(CONFIG_I2S_RING) && defined(I2S_HAVE_TX)
+static void i2s_txring_callback(DMA_HANDLE handle, uint8_t status, void *arg)
+{
+  struct stm32_i2s_s *priv = (struct stm32_i2s_s *)arg;
+  DEBUGASSERT(priv != NULL);
+
+  i2s_ring_done(priv, &priv->tx, status, SPI_CR2_TXDMAEN);
+}
+#endif
+
+/****************************************************************************
+ * Name: i2s_ring_start
+ *
+ * Description:
+ *   Start or stop a circular DMA ring transfer in one direction.
+ *
+ * Input Parameters:
+ *   priv     - I2S device structure
+ *   xpt      - The RX or TX transport
+ *   buffer   - The ring buffer or NULL to stop the ring transfer
+ *   nbytes   - The size of the ring buffer in bytes
+ *   callback - The half complete callback
+ *   arg      - The argument to be returned with the callback
+ *   ccr      - The DMA configuration for this direction
+ *   dmacb    - The DMA interrupt callback for this direction
+ *   dmaen    - The SPI CR2 DMA enable bit for this direction
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure
+ *
+ * Assumptions:
+ *   The caller holds the I2S exclusive access semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2S_RING
+static int i2s_ring_start(struct stm32_i2s_s *priv,
+                          struct stm32_transport_s *xpt, uint8_t *buffer,
+                          size_t nbytes, i2s_ringcallback_t callback,
+                          void *arg, uint32_t ccr, dma_callback_t dmacb,
+                          uint16_t dmaen)
+{
+  irqstate_t flags;
+  size_t sampsize;
+
+  /* A NULL buffer stops any ring transfer in progress */
+
+  if (buffer == NULL)
+    {
+      flags = enter_critical_section();
+      if (xpt->ring)
+        {
+          xpt->ring = false;
+          i2s_putreg(priv, STM32_SPI_CR2_OFFSET,
+                     i2s_getreg(priv, STM32_SPI_CR2_OFFSET) & ~dmaen);
+          stm32_dmastop(xpt->dma);
+        }
+
+      leave_critical_section(flags);
+      return OK;
+    }
+
+  /* The ring buffer must hold two halves of whole samples */
+
+  sampsize = priv->datalen > 8 ? 2 : 1;
+  if (callback == NULL || nbytes == 0 ||
+      (nbytes % (2 * sampsize)) != 0 ||
+      ((uintptr_t)buffer % sampsize) != 0)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  /* The DMA channel must not be busy with a ring or per-buffer transfer */
+
+  if (xpt->ring || !sq_empty(&xpt->act) || !sq_empty(&xpt->pend))
+    {
+      leave_critical_section(flags);
+      return -EBUSY;
+    }
+
+  xpt->ringbuf  = buffer;
+  xpt->ringsize = nbytes;
+  xpt->ringcb   = callback;
+  xpt->ringarg  = arg;
+  xpt->ring     = true;
+
+  /* Configure the DMA for circular mode and start it with both the half
+   * and full transfer interrupts enabled.
+   */
+
+  stm32_dmasetup(xpt->dma, priv->base + STM32_SPI_DR_OFFSET,
+                 (uint32_t)buffer, nbytes / sampsize, ccr | DMA_SCR_CIRC);
+  stm32_dmastart(xpt->dma, dmacb, priv, true);
+
+  i2s_putreg(priv, STM32_SPI_CR2_OFFSET,
+             i2s_getreg(priv, STM32_SPI_CR2_OFFSET) | dmaen);
+
+  leave_critical_section(flags);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: stm32_i2s_rxring
+ *
+ * Description:
+ *   Start (or stop) continuous, circular DMA reception into a ring buffer.
+ *   See I2S_RXRING() in include/nuttx/audio/i2s.h.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2S_RING
+static int stm32_i2s_rxring(struct i2s_dev_s *dev, uint8_t *buffer,
+                            size_t nbytes, i2s_ringcallback_t callback,
+                            void *arg)
+{
+  struct stm32_i2s_s *priv = (struct stm32_i2s_s *)dev;
+#ifdef I2S_HAVE_RX
+  int ret;
+
+  DEBUGASSERT(priv);
+  i2sinfo("buffer=%p nbytes=%d arg=%p\n", buffer, nbytes, arg);
+
+  i2s_exclsem_take(priv);
+
+  if (!priv->rxenab)
+    {
+      i2serr("ERROR: I2S%d has no receiver\n", priv->i2sno);
+      ret = -EAGAIN;
+    }
+  else
+    {
+      ret = i2s_ring_start(priv, &priv->rx, buffer, nbytes, callback, arg,
+                           priv->rxccr, i2s_rxring_callback,
+                           SPI_CR2_RXDMAEN);
+    }
+
+  i2s_exclsem_give(priv);
+  return ret;
+
+#else
+  i2serr("ERROR: I2S%d has no receiver\n", priv->i2sno);
+  UNUSED(priv);
+  return -ENOSYS;
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: stm32_i2s_txring
+ *
+ * Description:
+ *   Start (or stop) continuous, circular DMA transmission from a ring
+ *   buffer.  See I2S_TXRING() in include/nuttx/audio/i2s.h.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2S_RING
+static int stm32_i2s_txring(struct i2s_dev_s *dev, uint8_t *buffer,
+                            size_t nbytes, i2s_ringcallback_t callback,
+                            void *arg)
+{
+  struct stm32_i2s_s *priv = (struct stm32_i2s_s *)dev;
+#ifdef I2S_HAVE_TX
+  int ret;
+
+  DEBUGASSERT(priv);
+  i2sinfo("buffer=%p nbytes=%d arg=%p\n", buffer, nbytes, arg);
+
+  i2s_exclsem_take(priv);
+
+  if (!priv->txenab)
+    {
+      i2serr("ERROR: I2S%d has no transmitter\n", priv->i2sno);
+      ret = -EAGAIN;
+    }
+  else
+    {
+      ret = i2s_ring_start(priv, &priv->tx, buffer, nbytes, callback, arg,
+                           priv->txccr, i2s_txring_callback,
+                           SPI_CR2_TXDMAEN);
+    }
+
+  i2s_exclsem_give(priv);
+  return ret;
+
+#else
+  i2serr("ERROR: I2S%d has no transmitter\n", priv->i2sno);
+  UNUSED(priv);
+  return -ENOSYS;
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: i2s_mckdivider
  *
@@ -43,6 +43,7 @@
 #include <time.h>
 #include <debug.h>
 #include <nuttx/arch.h>
+#include <nuttx/sched_profile.h>
 #include <arch/board/board.h>
 
 #include "nvic.h"
@@ -100,6 +101,10 @@
 
 static int stm32_timerisr(int irq, uint32_t *regs, void *arg)
 {
+  /* Sample the interrupted program counter for the profiler */
+
+  sched_profile_sample(regs[REG_PC]);
+
   /* Process timer interrupt */
 
   sched_process_timer();
@@ -52,6 +52,15 @@
 #define SP_UNLOCKED false  /* The Un-locked state */
 #define SP_LOCKED   true   /* The Locked state */
 
+/* Memory barriers for use with include/nuttx/spinlock.h.  In the SMP
+ * configuration the simulated CPUs are host threads that really do execute
+ * in parallel, so a full host barrier is needed and not just a compiler
+ * barrier.
+ */
+
+#define SP_DMB() __sync_synchronize()
+#define SP_DSB() __sync_synchronize()
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -88,6 +88,17 @@
 #define FB_WIDTH ((CONFIG_SIM_FBWIDTH * CONFIG_SIM_FBBPP + 7) / 8)
 #define FB_SIZE  (FB_WIDTH * CONFIG_SIM_FBHEIGHT)
 
+/* Number of frames in the framebuffer memory */
+
+#ifdef CONFIG_FB_PANDISPLAY
+#  ifndef CONFIG_FB_NBUFFERS
+#    define CONFIG_FB_NBUFFERS 2
+#  endif
+#  define FB_NFRAMES CONFIG_FB_NBUFFERS
+#else
+#  define FB_NFRAMES 1
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -112,6 +123,16 @@ static int up_getcursor(FAR struct fb_vtable_s *vtable, FAR struct fb_cursorattr
 static int up_setcursor(FAR struct fb_vtable_s *vtable, FAR struct fb_setcursor_s *setttings);
 #endif
 
+  /* Vertical sync and frame selection */
+
+#ifdef CONFIG_FB_SYNC
+static int up_waitforvsync(FAR struct fb_vtable_s *vtable);
+#endif
+#ifdef CONFIG_FB_PANDISPLAY
+static int up_pandisplay(FAR struct fb_vtable_s *vtable,
+                         FAR const struct fb_planeinfo_s *pinfo);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -119,7 +140,7 @@ static int up_setcursor(FAR struct fb_vtable_s *vtable, FAR struct fb_setcursor_
 /* The simulated framebuffer memory */
 
 #ifndef CONFIG_SIM_X11FB
-static uint8_t g_fb[FB_SIZE];
+static uint8_t g_fb[FB_SIZE * FB_NFRAMES];
 #endif
 
 /* This structure describes the simulated video controller */
@@ -138,10 +159,13 @@ static const struct fb_videoinfo_s g_videoinfo =
 static const struct fb_planeinfo_s g_planeinfo =
 {
   .fbmem    = (FAR void *)&g_fb,
-  .fblen    = FB_SIZE,
+  .fblen    = FB_SIZE * FB_NFRAMES,
   .stride   = FB_WIDTH,
   .display  = 0,
   .bpp      = CONFIG_SIM_FBBPP,
+#ifdef CONFIG_FB_PANDISPLAY
+  .yres_virtual = CONFIG_SIM_FBHEIGHT * FB_NFRAMES,
+#endif
 };
 #else
 /* This structure describes the single, X11 color plane */
@@ -149,6 +173,12 @@ static const struct fb_planeinfo_s g_planeinfo =
 static struct fb_planeinfo_s g_planeinfo;
 #endif
 
+/* First row of the visible frame */
+
+#ifdef CONFIG_FB_PANDISPLAY
+static fb_coord_t g_yoffset;
+#endif
+
 /* Current cursor position */
 
 #ifdef CONFIG_FB_HWCURSOR
@@ -177,6 +207,12 @@ struct fb_vtable_s g_fbobject =
   .getcursor     = up_getcursor,
   .setcursor     = up_setcursor,
 #endif
+#ifdef CONFIG_FB_SYNC
+  .waitforvsync  = up_waitforvsync,
+#endif
+#ifdef CONFIG_FB_PANDISPLAY
+  .pandisplay    = up_pandisplay,
+#endif
 };
 
 /****************************************************************************
@@ -216,6 +252,9 @@ static int up_getplaneinfo(FAR struct fb_vtable_s *vtable, int planeno,
   if (vtable && planeno == 0 && pinfo)
     {
       memcpy(pinfo, &g_planeinfo, sizeof(struct fb_planeinfo_s));
+#ifdef CONFIG_FB_PANDISPLAY
+      pinfo->yoffset = g_yoffset;
+#endif
       return OK;
     }
 
@@ -346,6 +385,50 @@ static int up_setcursor(FAR struct fb_vtable_s *vtable,
 }
 #endif
 
+/****************************************************************************
+ * Name: up_waitforvsync
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_SYNC
+static int up_waitforvsync(FAR struct fb_vtable_s *vtable)
+{
+  /* There is no refresh to wait for; a new frame is shown as soon as it is
+   * selected.
+   */
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: up_pandisplay
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_PANDISPLAY
+static int up_pandisplay(FAR struct fb_vtable_s *vtable,
+                         FAR const struct fb_planeinfo_s *pinfo)
+{
+  _info("vtable=%p yoffset=%d\n", vtable, pinfo->yoffset);
+  if (vtable && pinfo &&
+      (pinfo->yoffset % CONFIG_SIM_FBHEIGHT) == 0 &&
+      pinfo->yoffset < CONFIG_SIM_FBHEIGHT * FB_NFRAMES)
+    {
+#ifdef CONFIG_SIM_X11FB
+      if (up_x11pan(pinfo->yoffset) < 0)
+        {
+          return -EINVAL;
+        }
+#endif
+
+      g_yoffset = pinfo->yoffset;
+      return OK;
+    }
+
+  _err("ERROR: Returning EINVAL\n");
+  return -EINVAL;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -369,9 +452,14 @@ static int up_setcursor(FAR struct fb_vtable_s *vtable,
 int up_fbinitialize(int display)
 {
 #ifdef CONFIG_SIM_X11FB
+#ifdef CONFIG_FB_PANDISPLAY
+  g_planeinfo.yres_virtual = CONFIG_SIM_FBHEIGHT * FB_NFRAMES;
+#endif
+
   return up_x11initialize(CONFIG_SIM_FBWIDTH, CONFIG_SIM_FBHEIGHT,
-                          &g_planeinfo.fbmem, &g_planeinfo.fblen,
-                          &g_planeinfo.bpp, &g_planeinfo.stride);
+                          FB_NFRAMES, &g_planeinfo.fbmem,
+                          &g_planeinfo.fblen, &g_planeinfo.bpp,
+                          &g_planeinfo.stride);
 #else
   return OK;
 #endif
@@ -53,6 +53,7 @@
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/syslog/syslog.h>
 #include <nuttx/syslog/syslog_console.h>
+#include <nuttx/syslog/binlog.h>
 #include <nuttx/serial/pty.h>
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/power/pm.h>
@@ -236,6 +237,10 @@ void up_initialize(void)
   note_register();          /* Non-standard /dev/note */
 #endif
 
+#ifdef CONFIG_BINLOG
+  binlog_register();        /* Non-standard /dev/binlog */
+#endif
+
 #if defined(USE_DEVCONSOLE)
   /* Start the sumulated UART device */
 
@@ -289,8 +289,12 @@ unsigned long up_getwalltime( void );
 
 #ifdef CONFIG_SIM_X11FB
 int up_x11initialize(unsigned short width, unsigned short height,
-                     void **fbmem, unsigned int *fblen, unsigned char *bpp,
+                     unsigned short nbuffers, void **fbmem,
+                     unsigned int *fblen, unsigned char *bpp,
                      unsigned short *stride);
+#ifdef CONFIG_FB_PANDISPLAY
+int up_x11pan(unsigned short yoffset);
+#endif
 #ifdef CONFIG_FB_CMAP
 int up_x11cmap(unsigned short first, unsigned short len,
                unsigned char *red, unsigned char *green,
@@ -187,6 +187,7 @@ void netdriver_loop(void)
   if (g_sim_dev.d_len > 0)
     {
       NETDEV_RXPACKETS(&g_sim_dev);
+      NETDEV_RXSTAMP(&g_sim_dev);
 
       /* Data received event.  Check for valid Ethernet header with destination == our
        * MAC address
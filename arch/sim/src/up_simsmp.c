@@ -43,6 +43,8 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <signal.h>
+#include <sched.h>
+#include <unistd.h>
 #include <errno.h>
 
 /****************************************************************************
@@ -108,6 +110,42 @@ void sim_smp_hook(void);
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sim_setaffinity
+ *
+ * Description:
+ *   Bind the calling host pthread, which simulates the given CPU, to a host
+ *   CPU.  Failures are ignored; the simulated CPU then just floats.
+ *
+ * Input Parameters:
+ *   cpu - The simulated CPU number
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_CPU_AFFINITY
+static void sim_setaffinity(int cpu)
+{
+  cpu_set_t cpuset;
+  long nhost;
+
+  nhost = sysconf(_SC_NPROCESSORS_ONLN);
+  if (nhost < 1)
+    {
+      return;
+    }
+
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu % nhost, &cpuset);
+
+  (void)pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+}
+#else
+#  define sim_setaffinity(cpu)
+#endif
+
 /****************************************************************************
  * Name: sim_cpu0_trampoline
  *
@@ -136,6 +174,8 @@ static void *sim_cpu0_trampoline(void *arg)
       return NULL;
     }
 
+  sim_setaffinity(0);
+
   /* Make sure the SIGUSR1 is not masked */
 
   sigemptyset(&set);
@@ -190,6 +230,8 @@ static void *sim_idle_trampoline(void *arg)
       return NULL;
     }
 
+  sim_setaffinity(cpuinfo->cpu);
+
   /* Make sure the SIGUSR1 is not masked */
 
   sigemptyset(&set);
@@ -456,10 +498,14 @@ errout_with_mutex:
 
 int up_cpu_pause(int cpu)
 {
-  /* Take the spinlock that will prevent the CPU thread from running */
+  /* Take the spinlock that will prevent the CPU thread from running.  The
+   * CPU threads really run in parallel so both stores must be visible
+   * before the signal is sent.
+   */
 
   g_cpu_wait[cpu]   = SP_LOCKED;
   g_cpu_paused[cpu] = SP_LOCKED;
+  __sync_synchronize();
 
   /* Signal the CPU thread */
 
@@ -472,6 +518,8 @@ int up_cpu_pause(int cpu)
       pthread_yield();
     }
 
+  __sync_synchronize();
+
   return 0;
 }
 
@@ -498,6 +546,7 @@ int up_cpu_resume(int cpu)
 {
   /* Release the spinlock that will alloc the CPU thread to continue */
 
+  __sync_synchronize();
   g_cpu_wait[cpu] = SP_UNLOCKED;
   return 0;
 }
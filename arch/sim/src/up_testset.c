@@ -59,7 +59,13 @@ typedef uint8_t spinlock_t;
  * Private Data
  ****************************************************************************/
 
-#ifdef CONFIG_SMP
+/* If the host compiler provides atomic built-ins, then the test-and-set is
+ * a single host atomic exchange and simulated CPUs contending for different
+ * spinlocks do not serialize on one another.  Otherwise, a single host
+ * mutex is used to make the operation atomic.
+ */
+
+#if defined(CONFIG_SMP) && !defined(__ATOMIC_ACQUIRE)
 static pthread_mutex_t g_tsmutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
@@ -89,9 +95,18 @@ static pthread_mutex_t g_tsmutex = PTHREAD_MUTEX_INITIALIZER;
 
 spinlock_t up_testset(volatile spinlock_t *lock)
 {
+#if defined(CONFIG_SMP) && defined(__ATOMIC_ACQUIRE)
+  /* In the multi-CPU SMP case, the host atomic exchange is the test and
+   * set.  Acquire ordering keeps the accesses protected by the spinlock from
+   * being moved ahead of it.
+   */
+
+  return __atomic_exchange_n(lock, SP_LOCKED, __ATOMIC_ACQUIRE);
+
+#else
 #ifdef CONFIG_SMP
-  /* In the multi-CPU SMP case, we use a mutex to assure that the following
-   * test and set is atomic.
+  /* Without host atomics, we use a mutex to assure that the following test
+   * and set is atomic.
    */
 
   (void)pthread_mutex_lock(&g_tsmutex);
@@ -108,4 +123,5 @@ spinlock_t up_testset(volatile spinlock_t *lock)
   (void)pthread_mutex_unlock(&g_tsmutex);
 #endif
   return ret;
+#endif
 }
@@ -75,6 +75,8 @@ static XImage *g_image;
 static unsigned char *g_framebuffer;
 static unsigned short g_fbpixelwidth;
 static unsigned short g_fbpixelheight;
+static unsigned short g_fbvirtheight;
+static unsigned short g_fbyoffset;
 static int g_shmcheckpoint = 0;
 static int b_useshm;
 
@@ -276,7 +278,7 @@ static inline int up_x11mapsharedmem(int depth, unsigned int fblen)
       up_x11traperrors();
       g_image = XShmCreateImage(g_display, DefaultVisual(g_display, g_screen),
                                 depth, ZPixmap, NULL, &g_xshminfo,
-                                g_fbpixelwidth, g_fbpixelheight);
+                                g_fbpixelwidth, g_fbvirtheight);
       if (up_x11untraperrors())
         {
           up_x11uninitialize();
@@ -333,7 +335,7 @@ shmerror:
       g_framebuffer = (unsigned char *)malloc(fblen);
 
       g_image = XCreateImage(g_display, DefaultVisual(g_display, g_screen), depth,
-                             ZPixmap, 0, (char *)g_framebuffer, g_fbpixelwidth, g_fbpixelheight,
+                             ZPixmap, 0, (char *)g_framebuffer, g_fbpixelwidth, g_fbvirtheight,
                              8, 0);
 
       if (g_image == NULL)
@@ -355,12 +357,15 @@ shmerror:
  * Name: up_x11initialize
  *
  * Description:
- *   Make an X11 window look like a frame buffer.
+ *   Make an X11 window look like a frame buffer.  The image behind the
+ *   window holds nbuffers frames of height rows each; up_x11pan() selects
+ *   the one that is shown.
  *
  ****************************************************************************/
 
 int up_x11initialize(unsigned short width, unsigned short height,
-                     void **fbmem, unsigned int *fblen, unsigned char *bpp,
+                     unsigned short nbuffers, void **fbmem,
+                     unsigned int *fblen, unsigned char *bpp,
                      unsigned short *stride)
 {
   XWindowAttributes windowAttributes;
@@ -375,6 +380,7 @@ int up_x11initialize(unsigned short width, unsigned short height,
 
       g_fbpixelwidth  = width;
       g_fbpixelheight = height;
+      g_fbvirtheight  = height * nbuffers;
 
       /* Create the X11 window */
 
@@ -401,7 +407,7 @@ int up_x11initialize(unsigned short width, unsigned short height,
 
       *bpp    = depth;
       *stride = (depth * width / 8);
-      *fblen  = (*stride * height);
+      *fblen  = (*stride * g_fbvirtheight);
 
       /* Map the window to shared memory */
 
@@ -463,15 +469,36 @@ void up_x11update(void)
 #ifndef CONFIG_SIM_X11NOSHM
   if (b_useshm)
     {
-      XShmPutImage(g_display, g_window, g_gc, g_image, 0, 0, 0, 0,
+      XShmPutImage(g_display, g_window, g_gc, g_image, 0, g_fbyoffset, 0, 0,
                    g_fbpixelwidth, g_fbpixelheight, 0);
     }
   else
 #endif
     {
-      XPutImage(g_display, g_window, g_gc, g_image, 0, 0, 0, 0,
+      XPutImage(g_display, g_window, g_gc, g_image, 0, g_fbyoffset, 0, 0,
                 g_fbpixelwidth, g_fbpixelheight);
     }
 
   XSync(g_display, 0);
 }
+
+/****************************************************************************
+ * Name: up_x11pan
+ *
+ * Description:
+ *   Show the frame starting at row yoffset of the image and update the
+ *   window immediately.
+ *
+ ****************************************************************************/
+
+int up_x11pan(unsigned short yoffset)
+{
+  if (yoffset > g_fbvirtheight - g_fbpixelheight)
+    {
+      return -1;
+    }
+
+  g_fbyoffset = yoffset;
+  up_x11update();
+  return 0;
+}
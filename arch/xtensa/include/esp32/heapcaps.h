@@ -0,0 +1,123 @@
+/****************************************************************************
+ * arch/xtensa/include/esp32/heapcaps.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_INCLUDE_ESP32_HEAPCAPS_H
+#define __ARCH_XTENSA_INCLUDE_ESP32_HEAPCAPS_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef CONFIG_ESP32_HEAPCAPS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Memory capabilities that may be requested from esp32_malloc_caps().  A
+ * heap satisfies a request if it has all of the requested capabilities.
+ */
+
+#define MALLOC_CAP_8BIT      (1 << 0)  /* Byte and half-word accessible */
+#define MALLOC_CAP_32BIT     (1 << 1)  /* Aligned 32-bit accessible */
+#define MALLOC_CAP_DMA       (1 << 2)  /* Accessible by DMA */
+#define MALLOC_CAP_INTERNAL  (1 << 3)  /* Internal, on-chip memory */
+#define MALLOC_CAP_SPIRAM    (1 << 4)  /* External SPI RAM */
+#define MALLOC_CAP_EXEC      (1 << 5)  /* Executable */
+
+/* Zero capabilities select the default:  Memory usable like any other */
+
+#define MALLOC_CAP_DEFAULT   (MALLOC_CAP_8BIT | MALLOC_CAP_32BIT)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifndef __ASSEMBLY__
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: esp32_malloc_caps
+ *
+ * Description:
+ *   Allocate memory from the first heap with all of the requested
+ *   capabilities that can satisfy the request.  The heaps are tried in the
+ *   order internal DRAM, RTC fast memory, IRAM and external SPI RAM, so
+ *   small, hot data stays in internal memory unless MALLOC_CAP_SPIRAM is
+ *   requested.
+ *
+ * Input Parameters:
+ *   size - The number of bytes to allocate
+ *   caps - A bit set of MALLOC_CAP_* values
+ *
+ * Returned Value:
+ *   The allocated memory or NULL on failure.  The memory must be freed
+ *   with esp32_free_caps().
+ *
+ ****************************************************************************/
+
+FAR void *esp32_malloc_caps(size_t size, uint32_t caps);
+
+/****************************************************************************
+ * Name: esp32_free_caps
+ *
+ * Description:
+ *   Free memory allocated by esp32_malloc_caps() (or by malloc()).
+ *
+ ****************************************************************************/
+
+void esp32_free_caps(FAR void *mem);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __ASSEMBLY__ */
+#endif /* CONFIG_ESP32_HEAPCAPS */
+#endif /* __ARCH_XTENSA_INCLUDE_ESP32_HEAPCAPS_H */
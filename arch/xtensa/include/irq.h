@@ -136,6 +136,19 @@
 
 #define XCPTCONTEXT_SIZE    (4 * XCPTCONTEXT_REGS)
 
+/* Interrupt levels 1 through XTENSA_IRQ_OSLEVEL interact with the OS and
+ * are disabled by up_irq_save().  Normally that includes all of the
+ * medium priority levels up to XCHAL_EXCM_LEVEL.  With
+ * CONFIG_XTENSA_HIPRI_INTERRUPT, level XCHAL_EXCM_LEVEL is instead
+ * reserved for zero-latency interrupts that critical sections never mask.
+ */
+
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+#  define XTENSA_IRQ_OSLEVEL (XCHAL_EXCM_LEVEL - 1)
+#else
+#  define XTENSA_IRQ_OSLEVEL XCHAL_EXCM_LEVEL
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -163,6 +176,18 @@ struct xcptcontext
 
   uint32_t regs[XCPTCONTEXT_REGS];
 
+#ifdef CONFIG_XTENSA_STACKCOLOR_LAZY
+  /* Deepest stack word known to have been used (NULL if not painted) */
+
+  uint32_t *stack_hwm;
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+  /* Value of THREADPTR for this thread (see xtensa_tls.c) */
+
+  uint32_t threadptr;
+#endif
+
 #if XCHAL_CP_NUM > 0
   /* Co-processor save area */
 
@@ -223,14 +248,14 @@ static inline uint32_t up_irq_save(void)
 {
   uint32_t ps;
 
-  /* Disable all low- and medium-priority interrupts.  High priority
-   * interrupts should not interfere with ongoing RTOS operations and
-   * are not disabled.
+  /* Disable all low- and medium-priority interrupts that interact with
+   * the OS.  High priority and zero-latency interrupts should not interfere
+   * with ongoing RTOS operations and are not disabled.
    */
 
   __asm__ __volatile__
   (
-    "rsil %0, %1" : "=r"(ps) : "I"(XCHAL_EXCM_LEVEL)
+    "rsil %0, %1" : "=r"(ps) : "I"(XTENSA_IRQ_OSLEVEL)
   );
 
   /* Return the previous PS value so that it can be restored with
@@ -256,9 +281,9 @@ static inline void up_irq_enable(void)
 static inline void up_irq_disable(void)
 {
 #ifdef __XTENSA_CALL0_ABI__
-  xtensa_setps(PS_INTLEVEL(XCHAL_EXCM_LEVEL) | PS_UM);
+  xtensa_setps(PS_INTLEVEL(XTENSA_IRQ_OSLEVEL) | PS_UM);
 #else
-  xtensa_setps(PS_INTLEVEL(XCHAL_EXCM_LEVEL) | PS_UM | PS_WOE);
+  xtensa_setps(PS_INTLEVEL(XTENSA_IRQ_OSLEVEL) | PS_UM | PS_WOE);
 #endif
 }
 
@@ -275,7 +275,14 @@ void xtensa_coproc_disable(struct xtensa_cpstate_s *cpstate, int cpset);
 /* IRQs */
 
 uint32_t *xtensa_int_decode(uint32_t cpuints, uint32_t *regs);
-uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs);
+uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs, int level);
+#ifdef CONFIG_XTENSA_DIRECT_IRQ
+uint32_t *xtensa_irq_direct(int irq, uint32_t *regs, int level,
+                            xcpt_t handler, FAR void *arg);
+#endif
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+uint32_t *xtensa_hipri_decode(uint32_t cpuints, uint32_t *regs);
+#endif
 uint32_t xtensa_enable_cpuint(uint32_t *shadow, uint32_t intmask);
 uint32_t xtensa_disable_cpuint(uint32_t *shadow, uint32_t intmask);
 void xtensa_panic(int xptcode, uint32_t *regs) noreturn_function;
@@ -285,7 +292,9 @@ void xtensa_user(int exccause, uint32_t *regs) noreturn_function;
 
 #ifdef CONFIG_SMP
 void __cpu1_start(void) noreturn_function;
+#ifndef CONFIG_ARCH_HAVE_CPU_CALL
 int xtensa_intercpu_interrupt(int tocpu, int intcode);
+#endif
 void xtensa_pause_handler(void);
 #endif
 
@@ -297,6 +306,23 @@ void xtensa_context_restore(uint32_t *regs) noreturn_function;
 #if XCHAL_CP_NUM > 0
 void xtensa_coproc_savestate(struct xtensa_cpstate_s *cpstate);
 void xtensa_coproc_restorestate(struct xtensa_cpstate_s *cpstate);
+
+/* Co-processor state handling on a context switch.  With lazy co-processor
+ * state restoration, the save/restore is deferred until the co-processor
+ * is actually used (see xtensa_cplazy.c).
+ */
+
+#ifdef CONFIG_XTENSA_CP_LAZY
+struct tcb_s;
+void xtensa_coproc_suspend(struct tcb_s *tcb);
+void xtensa_coproc_resume(struct tcb_s *tcb);
+void xtensa_coproc_release(struct tcb_s *tcb);
+void xtensa_coproc_lazy(int exccause, uint32_t *regs);
+#else
+#  define xtensa_coproc_suspend(t) xtensa_coproc_savestate(&(t)->xcp.cpstate)
+#  define xtensa_coproc_resume(t)  xtensa_coproc_restorestate(&(t)->xcp.cpstate)
+#  define xtensa_coproc_release(t)
+#endif
 #endif
 
 /* Signals */
@@ -341,6 +367,28 @@ void xtensa_serial_initialize(void);
 
 void xtensa_timer_initialize(void);
 
+/* Stack cache */
+
+#ifdef CONFIG_XTENSA_STACKCACHE
+#  define XTENSA_STACKCACHE_ROUNDUP(s) \
+  ((((s) + CONFIG_XTENSA_STACKCACHE_GRANULE - 1) / \
+    CONFIG_XTENSA_STACKCACHE_GRANULE) * CONFIG_XTENSA_STACKCACHE_GRANULE)
+
+FAR void *xtensa_stackcache_alloc(size_t size);
+bool xtensa_stackcache_free(FAR void *stack, size_t size);
+#endif
+
+/* Thread-local storage */
+
+#ifdef CONFIG_XTENSA_TLS
+size_t xtensa_tls_size(void);
+uint32_t xtensa_tls_threadptr(uintptr_t top);
+void xtensa_tls_initialize(uint32_t threadptr);
+
+#  define xtensa_tls_resume(t) \
+  __asm__ __volatile__ ("wur.THREADPTR %0\n" : : "r"((t)->xcp.threadptr))
+#endif
+
 /* Network */
 
 #if defined(CONFIG_NET) && !defined(CONFIG_NETDEV_LATEINIT)
@@ -50,6 +50,7 @@
 #include "sched/sched.h"
 #include "group/group.h"
 #include "xtensa.h"
+#include "xtensa_attr.h"
 
 /****************************************************************************
  * Public Functions
@@ -75,7 +76,7 @@
  *
  ****************************************************************************/
 
-void up_block_task(struct tcb_s *tcb, tstate_t task_state)
+void IRAM_ATTR up_block_task(struct tcb_s *tcb, tstate_t task_state)
 {
   struct tcb_s *rtcb = this_task();
   bool switch_needed;
@@ -154,7 +155,7 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
            * processor save area.
            */
 
-          xtensa_coproc_savestate(&rtcb->xcp.cpstate);
+          xtensa_coproc_suspend(rtcb);
 #endif
 
           /* Restore the exception context of the rtcb at the (new) head
@@ -166,7 +167,13 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 #if XCHAL_CP_NUM > 0
           /* Set up the co-processor state for the newly started thread. */
 
-          xtensa_coproc_restorestate(&rtcb->xcp.cpstate);
+          xtensa_coproc_resume(rtcb);
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+          /* Select the thread-local storage of the newly started thread. */
+
+          xtensa_tls_resume(rtcb);
 #endif
 
 #ifdef CONFIG_ARCH_ADDRENV
@@ -54,6 +54,17 @@
 
 #ifdef CONFIG_STACK_COLORATION
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With the windowed ABI, the base save area of a frame (a0-a3) lies in the
+ * 16 bytes just below its stack pointer.  The lazy painting must not touch
+ * it.
+ */
+
+#define STACK_BASE_SAVE_AREA 16
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -159,6 +170,138 @@ static size_t do_stackcheck(uintptr_t alloc, size_t size)
   return mark << 2;
 }
 
+/****************************************************************************
+ * Name: xtensa_getsp
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_STACKCOLOR_LAZY
+static inline uint32_t xtensa_getsp(void)
+{
+  register uint32_t sp;
+
+  __asm__ __volatile__
+  (
+    "mov %0, sp\n"
+    : "=r" (sp)
+  );
+
+  return sp;
+}
+#endif
+
+/****************************************************************************
+ * Name: do_lazycheck
+ *
+ * Description:
+ *   Determine (approximately) how much of the stack of a thread has been
+ *   used when the stack is painted lazily.
+ *
+ *   The first time that the stack of a thread that is not running is
+ *   checked, the memory below its saved stack pointer is painted.  After
+ *   that, only the words below the previous high water mark are examined:
+ *   The search from there toward lower addresses ends when
+ *   CONFIG_XTENSA_STACKCOLOR_GAP consecutive words still have the magic
+ *   value.  Reading is safe even while the thread is running on another
+ *   CPU.
+ *
+ * Input Parameters:
+ *   tcb - The thread whose stack is checked
+ *
+ * Returned Value:
+ *   The estimated amount of stack space used.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_STACKCOLOR_LAZY
+static size_t do_lazycheck(FAR struct tcb_s *tcb)
+{
+  uintptr_t alloc = (uintptr_t)tcb->stack_alloc_ptr;
+  uintptr_t start;
+  uintptr_t end;
+  uintptr_t hwm;
+  uintptr_t ptr;
+  irqstate_t flags;
+  int gap;
+
+  if (tcb->adj_stack_size == 0)
+    {
+      return 0;
+    }
+
+  /* Get aligned addresses of the top and bottom of the stack */
+
+#ifdef CONFIG_TLS
+  /* Skip over the TLS data structure at the bottom of the stack */
+
+  DEBUGASSERT((alloc & TLS_STACK_MASK) == 0);
+  start = alloc + sizeof(struct tls_info_s);
+#else
+  start = alloc & ~3;
+#endif
+  end   = (alloc + tcb->adj_stack_size + 3) & ~3;
+
+  /* The thread must not be suspended or resumed while its stack is painted */
+
+  flags = enter_critical_section();
+  hwm   = (uintptr_t)tcb->xcp.stack_hwm;
+
+  if (hwm == 0)
+    {
+      if (tcb->task_state == TSTATE_TASK_RUNNING)
+        {
+          /* The stack cannot be painted while it is in use.  The best that
+           * can be said is how deep the calling thread is now.
+           */
+
+          leave_critical_section(flags);
+          return tcb == this_task() ? end - xtensa_getsp() : 0;
+        }
+
+      /* Paint the free part of the stack below the saved stack pointer */
+
+      hwm = (tcb->xcp.regs[REG_A1] - STACK_BASE_SAVE_AREA) & ~3;
+      if (hwm < start || hwm > end)
+        {
+          /* The stack pointer is outside of the stack:  The stack has
+           * overflowed.
+           */
+
+          leave_critical_section(flags);
+          return end - start;
+        }
+
+      for (ptr = start; ptr < hwm; ptr += 4)
+        {
+          *(FAR uint32_t *)ptr = STACK_COLOR;
+        }
+
+      tcb->xcp.stack_hwm = (FAR uint32_t *)hwm;
+      leave_critical_section(flags);
+      return end - hwm;
+    }
+
+  /* Search downward from the previous high water mark until a run of
+   * unused words is found.
+   */
+
+  for (ptr = hwm, gap = 0;
+       ptr > start && gap < CONFIG_XTENSA_STACKCOLOR_GAP;
+       gap++)
+    {
+      ptr -= 4;
+      if (*(FAR uint32_t *)ptr != STACK_COLOR)
+        {
+          hwm = ptr;
+          gap = -1;
+        }
+    }
+
+  tcb->xcp.stack_hwm = (FAR uint32_t *)hwm;
+  leave_critical_section(flags);
+  return end - hwm;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -181,7 +324,11 @@ static size_t do_stackcheck(uintptr_t alloc, size_t size)
 
 size_t up_check_tcbstack(FAR struct tcb_s *tcb)
 {
+#ifdef CONFIG_XTENSA_STACKCOLOR_LAZY
+  return do_lazycheck(tcb);
+#else
   return do_stackcheck((uintptr_t)tcb->stack_alloc_ptr, tcb->adj_stack_size);
+#endif
 }
 
 ssize_t up_check_tcbstack_remain(FAR struct tcb_s *tcb)
@@ -43,6 +43,7 @@
 #include <arch/irq.h>
 
 #include "xtensa.h"
+#include "xtensa_attr.h"
 
 /****************************************************************************
  * Public Functions
@@ -54,7 +55,7 @@
 
 /* A little faster than most memcpy's */
 
-void xtensa_copystate(uint32_t *dest, uint32_t *src)
+void IRAM_ATTR xtensa_copystate(uint32_t *dest, uint32_t *src)
 {
   int i;
 
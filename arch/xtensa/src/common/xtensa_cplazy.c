@@ -0,0 +1,271 @@
+/****************************************************************************
+ * arch/xtensa/src/common/xtensa_cplazy.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+
+#include <arch/irq.h>
+#include <arch/xtensa/xtensa_coproc.h>
+#include <arch/xtensa/xtensa_corebits.h>
+#include <arch/chip/core-isa.h>
+
+#include "sched/sched.h"
+#include "xtensa.h"
+
+#if defined(CONFIG_XTENSA_CP_LAZY) && XCHAL_CP_NUM > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define XTENSA_CP_NOWNERS  CONFIG_SMP_NCPUS
+#  define this_cpuowner()    g_cpowner[up_cpu_index()]
+#else
+#  define XTENSA_CP_NOWNERS  1
+#  define this_cpuowner()    g_cpowner[0]
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* This is the thread whose co-processor state is currently held in the
+ * co-processor registers of each CPU (or NULL if the registers hold no
+ * live thread state).
+ *
+ * In the single CPU case, the state of the owner is left in the co-
+ * processor registers while other threads run and is only saved when
+ * another thread actually uses a co-processor.
+ *
+ * In the SMP case, a suspended thread may be resumed on a different CPU.
+ * So the state of a thread that used a co-processor is saved when it is
+ * suspended, but only restored if it uses a co-processor again after it is
+ * resumed.
+ */
+
+static FAR struct tcb_s *g_cpowner[XTENSA_CP_NOWNERS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: xtensa_coproc_suspend
+ *
+ * Description:
+ *   Called on each context switch when the thread 'tcb' is suspended.  The
+ *   CPENABLE register still reflects the co-processors in use by that
+ *   thread.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread being suspended.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from a critical section during the context switch.
+ *
+ ****************************************************************************/
+
+void xtensa_coproc_suspend(FAR struct tcb_s *tcb)
+{
+  FAR struct xtensa_cpstate_s *cpstate = &tcb->xcp.cpstate;
+  uint32_t cpenable;
+
+  cpenable = xtensa_get_cpenable();
+  if (cpenable != 0)
+    {
+      /* Remember which co-processors the thread was using */
+
+      cpstate->cpenable = cpenable;
+
+#ifdef CONFIG_SMP
+      /* The thread may be resumed on another CPU.  Save its state now and
+       * give up the co-processor registers.
+       */
+
+      xtensa_coproc_savestate(cpstate);
+      this_cpuowner() = NULL;
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: xtensa_coproc_resume
+ *
+ * Description:
+ *   Called on each context switch when the thread 'tcb' is resumed.  The
+ *   co-processors are enabled only if the co-processor registers still hold
+ *   the state of the thread.  Otherwise, all co-processors are disabled and
+ *   the state will be restored by xtensa_coproc_lazy() on first use.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread being resumed.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from a critical section during the context switch.
+ *
+ ****************************************************************************/
+
+void xtensa_coproc_resume(FAR struct tcb_s *tcb)
+{
+  if (this_cpuowner() == tcb)
+    {
+      xtensa_set_cpenable(tcb->xcp.cpstate.cpenable);
+    }
+  else
+    {
+      xtensa_set_cpenable(0);
+    }
+}
+
+/****************************************************************************
+ * Name: xtensa_coproc_release
+ *
+ * Description:
+ *   Forget any reference to the thread 'tcb' when it is destroyed so that
+ *   its state is not saved into the released TCB later.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread being destroyed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void xtensa_coproc_release(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+  int cpu;
+
+  flags = enter_critical_section();
+
+  for (cpu = 0; cpu < XTENSA_CP_NOWNERS; cpu++)
+    {
+      if (g_cpowner[cpu] == tcb)
+        {
+          g_cpowner[cpu] = NULL;
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: xtensa_coproc_lazy
+ *
+ * Description:
+ *   Called from _xtensa_coproc_handler when a thread executes an
+ *   instruction of a disabled co-processor.  Saves the state of the
+ *   previous owner of the co-processor registers (if any), restores the
+ *   state of the current thread and enables the co-processor.  On return,
+ *   the faulting instruction is re-executed.
+ *
+ * Input Parameters:
+ *   exccause - The EXCCAUSE value (EXCCAUSE_CP0_DISABLED + n)
+ *   regs     - The register save area of the exception
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void xtensa_coproc_lazy(int exccause, uint32_t *regs)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct tcb_s *owner;
+  uint32_t cpbit;
+  int cpndx;
+
+  /* Co-processor instructions are only permitted in thread code.  Anything
+   * else is an unhandled exception.
+   */
+
+  cpndx = exccause - EXCCAUSE_CP0_DISABLED;
+  if (CURRENT_REGS != NULL || cpndx < 0 || cpndx >= XCHAL_CP_NUM)
+    {
+      xtensa_user(exccause, regs);
+    }
+
+  cpbit = (1 << cpndx);
+  owner = this_cpuowner();
+
+  if (owner == rtcb)
+    {
+      /* The registers already hold our state, this is just a co-processor
+       * that the thread had not used before.
+       */
+
+      rtcb->xcp.cpstate.cpenable |= cpbit;
+      xtensa_set_cpenable(rtcb->xcp.cpstate.cpenable);
+      return;
+    }
+
+  /* Save the state of the previous owner in its own save area */
+
+  if (owner != NULL)
+    {
+      xtensa_set_cpenable(owner->xcp.cpstate.cpenable);
+      xtensa_coproc_savestate(&owner->xcp.cpstate);
+    }
+
+  /* Then restore the saved state of this thread (if any) and enable the
+   * requested co-processor.
+   */
+
+  rtcb->xcp.cpstate.cpenable |= (rtcb->xcp.cpstate.cpstored | cpbit);
+  xtensa_coproc_restorestate(&rtcb->xcp.cpstate);
+  this_cpuowner() = rtcb;
+}
+
+#endif /* CONFIG_XTENSA_CP_LAZY && XCHAL_CP_NUM > 0 */
@@ -193,6 +193,21 @@ void xtensa_pause_handler(void)
   (void)up_cpu_paused(up_cpu_index());
 }
 
+/****************************************************************************
+ * Name: xtensa_pause_call
+ *
+ * Description:
+ *   up_cpu_call() wrapper for xtensa_pause_handler()
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_CPU_CALL
+static void xtensa_pause_call(FAR void *arg)
+{
+  xtensa_pause_handler();
+}
+#endif
+
 /****************************************************************************
  * Name: up_cpu_pause
  *
@@ -237,9 +252,16 @@ int up_cpu_pause(int cpu)
   spin_lock(&g_cpu_wait[cpu]);
   spin_lock(&g_cpu_paused[cpu]);
 
-  /* Execute SGI2 */
+  /* Execute SGI2.  With up_cpu_call(), the request is queued in the
+   * lock-free mailbox of the other CPU.  Only the g_cpu_paused handshake
+   * below waits for that CPU.
+   */
 
+#ifdef CONFIG_ARCH_HAVE_CPU_CALL
+  ret = up_cpu_call(cpu, xtensa_pause_call, NULL);
+#else
   ret = xtensa_intercpu_interrupt(cpu, CPU_INTCODE_PAUSE);
+#endif
   if (ret < 0)
     {
       /* What happened?  Unlock the g_cpu_wait spinlock */
@@ -41,6 +41,7 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <assert.h>
 #include <sched.h>
 #include <debug.h>
 
@@ -142,6 +143,20 @@ int up_create_stack(FAR struct tcb_s *tcb, size_t stack_size, uint8_t ttype)
   stack_size += XTENSA_CP_SA_SIZE;
 #endif
 
+#ifdef CONFIG_XTENSA_TLS
+  /* Add the size of the thread-local storage block in the same way */
+
+  stack_size += xtensa_tls_size() + 4;
+#endif
+
+#ifdef CONFIG_XTENSA_STACKCACHE
+  /* Round the allocation up to its size class so that any cached stack of
+   * the same class can be used.
+   */
+
+  stack_size = XTENSA_STACKCACHE_ROUNDUP(stack_size);
+#endif
+
   /* Do we need to allocate a new stack? */
 
   if (!tcb->stack_alloc_ptr)
@@ -160,9 +175,25 @@ int up_create_stack(FAR struct tcb_s *tcb, size_t stack_size, uint8_t ttype)
       else
 #endif
         {
-          /* Use the user-space allocator if this is a task or pthread */
+#ifdef CONFIG_XTENSA_STACKCACHE
+          /* Prefer the stack of a thread that exited recently */
+
+          tcb->stack_alloc_ptr = xtensa_stackcache_alloc(stack_size);
+          if (tcb->stack_alloc_ptr == NULL)
+#endif
+            {
+              /* Use the user-space allocator if this is a task or
+               * pthread.
+               */
+
+              tcb->stack_alloc_ptr = (uint32_t *)kumm_malloc(stack_size);
+            }
+
+#ifdef CONFIG_XTENSA_STACKCACHE
+          /* Only stacks allocated here may be put in the cache later */
 
-          tcb->stack_alloc_ptr = (uint32_t *)kumm_malloc(stack_size);
+          tcb->flags |= TCB_FLAG_STACK_CACHED;
+#endif
         }
 
 #ifdef CONFIG_DEBUG_FEATURES
@@ -182,7 +213,12 @@ int up_create_stack(FAR struct tcb_s *tcb, size_t stack_size, uint8_t ttype)
       uintptr_t top_of_stack;
       size_t size_of_stack;
 
-#ifdef CONFIG_STACK_COLORATION
+#if defined(CONFIG_XTENSA_STACKCOLOR_LAZY)
+      /* The stack will be painted the first time that it is checked */
+
+      tcb->xcp.stack_hwm = NULL;
+
+#elif defined(CONFIG_STACK_COLORATION)
       uint32_t *ptr;
       int i;
 
@@ -228,10 +264,20 @@ int up_create_stack(FAR struct tcb_s *tcb, size_t stack_size, uint8_t ttype)
       xcp->cpstate.cpasa    = (uint32_t *)cpstart; /* Start of aligned save area */
 #endif
 
+#ifdef CONFIG_XTENSA_TLS
+      /* Then allocate the thread-local storage block below that.  It is
+       * initialized by up_initial_state().
+       */
+
+      tcb->xcp.threadptr = xtensa_tls_threadptr(top_of_stack);
+      top_of_stack      -= xtensa_tls_size() + 4;
+#endif
+
       /* The XTENSA stack must be aligned.  If necessary top_of_stack must be
        * rounded down to the next boundary to meet this alignment requirement.
        *
-       * NOTE: Co-processor save area not included in the size of the stack.
+       * NOTE: Co-processor save area and TLS block not included in the size
+       * of the stack.
        */
 
       top_of_stack  = STACK_ALIGN_DOWN(top_of_stack);
@@ -242,6 +288,12 @@ int up_create_stack(FAR struct tcb_s *tcb, size_t stack_size, uint8_t ttype)
       tcb->adj_stack_ptr  = (FAR uint32_t *)top_of_stack;
       tcb->adj_stack_size = size_of_stack;
 
+#ifdef CONFIG_XTENSA_STACKCACHE
+      /* up_release_stack() recovers the size class from adj_stack_size */
+
+      DEBUGASSERT(XTENSA_STACKCACHE_ROUNDUP(size_of_stack) == stack_size);
+#endif
+
       board_autoled_on(LED_STACKCREATED);
       return OK;
     }
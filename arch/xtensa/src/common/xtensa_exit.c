@@ -184,7 +184,13 @@ void _exit(int status)
 #if XCHAL_CP_NUM > 0
   /* Set up the co-processor state for the newly started thread. */
 
-  xtensa_coproc_restorestate(&tcb->xcp.cpstate);
+  xtensa_coproc_resume(tcb);
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+  /* Select the thread-local storage of the newly started thread. */
+
+  xtensa_tls_resume(tcb);
 #endif
 
 #ifdef CONFIG_ARCH_ADDRENV
@@ -72,11 +72,33 @@
 void up_initial_state(struct tcb_s *tcb)
 {
   struct xcptcontext *xcp = &tcb->xcp;
+#ifdef CONFIG_XTENSA_TLS
+  uint32_t threadptr = xcp->threadptr;
+#endif
 
   /* Initialize the initial exception register context structure */
 
   memset(xcp, 0, sizeof(struct xcptcontext));
 
+#ifdef CONFIG_XTENSA_TLS
+  /* The TLS block was allocated along with the stack.  (Re-)initialize
+   * it.  The IDLE thread of CPU0 is already running with the TLS block
+   * set up by __start().  The IDLE threads of the other CPUs get no stack
+   * before up_cpu_idlestack() is called.
+   */
+
+  if (tcb->pid == 0)
+    {
+      __asm__ __volatile__ ("rur.THREADPTR %0\n" : "=r"(threadptr));
+    }
+  else if (threadptr != 0)
+    {
+      xtensa_tls_initialize(threadptr);
+    }
+
+  xcp->threadptr = threadptr;
+#endif
+
   /* Set initial values of registers */
 
   xcp->regs[REG_PC]   = (uint32_t)tcb->start;         /* Task entrypoint                */
@@ -49,15 +49,74 @@
 #include <arch/chip/core-isa.h>
 
 #include "xtensa.h"
+#include "xtensa_attr.h"
 
 #include "group/group.h"
 #include "sched/sched.h"
 
 /****************************************************************************
- * Public Functions
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* XTENSA_DELIVER - Call the handler bound to the IRQ if there is one or,
+ * else, the handler registered with irq_attach().
+ */
+
+#ifdef CONFIG_XTENSA_DIRECT_IRQ
+#  define XTENSA_DELIVER(irq, regs, handler, arg) \
+     do \
+       { \
+         if ((handler) != NULL) \
+           { \
+             (void)(handler)(irq, regs, arg); \
+             g_running_tasks[this_cpu()] = this_task(); \
+           } \
+         else \
+           { \
+             irq_dispatch(irq, regs); \
+           } \
+       } \
+     while (0)
+#else
+#  define XTENSA_DELIVER(irq, regs, handler, arg) irq_dispatch(irq, regs)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: xtensa_irq_nest
+ *
+ * Description:
+ *   Lower PS.INTLEVEL to 'level' so that interrupts at higher levels may
+ *   preempt the handler.  Returns the previous PS to be restored with
+ *   up_irq_restore().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_NESTED_INTERRUPTS
+static inline uint32_t xtensa_irq_nest(int level)
+{
+  uint32_t ps = xtensa_getps();
+
+  xtensa_setps((ps & ~PS_INTLEVEL_MASK) | PS_INTLEVEL(level));
+  return ps;
+}
+#endif
+
+/****************************************************************************
+ * Name: xtensa_irq_deliver
+ *
+ * Description:
+ *   Common logic of xtensa_irq_dispatch() and xtensa_irq_direct().  The
+ *   handler is NULL when the IRQ is to be dispatched with irq_dispatch().
+ *
  ****************************************************************************/
 
-uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
+static inline_function uint32_t *
+xtensa_irq_deliver(int irq, uint32_t *regs, int level, xcpt_t handler,
+                   FAR void *arg)
 {
 #ifdef CONFIG_SUPPRESS_INTERRUPTS
   board_autoled_on(LED_INIRQ);
@@ -69,12 +128,29 @@ uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
 
   struct tcb_s *tcb = this_task();
 #endif
+#ifdef CONFIG_XTENSA_NESTED_INTERRUPTS
+  uint32_t ps;
+
+  if (CURRENT_REGS != NULL)
+    {
+      /* This interrupt nested within another handler.  State save and
+       * context switching are left to the outermost handler.
+       */
+
+      ps = xtensa_irq_nest(level);
+      XTENSA_DELIVER(irq, regs, handler, arg);
+      up_irq_restore(ps);
+      return regs;
+    }
+#endif
 
   board_autoled_on(LED_INIRQ);
 
+#ifndef CONFIG_XTENSA_NESTED_INTERRUPTS
   /* Nested interrupts are not supported */
 
   DEBUGASSERT(CURRENT_REGS == NULL);
+#endif
 
   /* Current regs non-zero indicates that we are processing an interrupt;
    * CURRENT_REGS is also used to manage interrupt level context switches.
@@ -89,9 +165,17 @@ uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
    * operations.  This includes use of the FPU.
    */
 
-  irq_dispatch(irq, regs);
+#ifdef CONFIG_XTENSA_NESTED_INTERRUPTS
+  /* Interrupts at higher levels may nest only while CURRENT_REGS is set */
 
-#if XCHAL_CP_NUM > 0 || defined(CONFIG_ARCH_ADDRENV)
+  ps = xtensa_irq_nest(level);
+  XTENSA_DELIVER(irq, regs, handler, arg);
+  up_irq_restore(ps);
+#else
+  XTENSA_DELIVER(irq, regs, handler, arg);
+#endif
+
+#if XCHAL_CP_NUM > 0 || defined(CONFIG_ARCH_ADDRENV) || defined(CONFIG_XTENSA_TLS)
   /* Check for a context switch.  If a context switch occurred, then
    * CURRENT_REGS will have a different value than it did on entry.
    */
@@ -108,7 +192,7 @@ uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
         * NOTE 2. We saved a reference  TCB of the original thread on entry.
         */
 
-       xtensa_coproc_savestate(&tcb->xcp.cpstate);
+       xtensa_coproc_suspend(tcb);
 
        /* Then set up the co-processor state for the to-be-started thread.
         *
@@ -117,7 +201,13 @@ uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
         */
 
        tcb = this_task();
-       xtensa_coproc_restorestate(&tcb->xcp.cpstate);
+       xtensa_coproc_resume(tcb);
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+      /* Select the thread-local storage of the to-be-started thread */
+
+      xtensa_tls_resume(this_task());
 #endif
 
 #ifdef CONFIG_ARCH_ADDRENV
@@ -143,3 +233,51 @@ uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
   board_autoled_off(LED_INIRQ);
   return regs;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: xtensa_irq_dispatch
+ *
+ * Description:
+ *   Dispatch one IRQ to its registered handler.
+ *
+ * Input Parameters:
+ *   irq   - The IRQ to dispatch
+ *   regs  - The register save area of the interrupted context
+ *   level - The interrupt level being serviced.  With
+ *           CONFIG_XTENSA_NESTED_INTERRUPTS, interrupts above this level
+ *           are enabled while the handler runs.  An interrupt that nests
+ *           within another handler leaves CURRENT_REGS referring to the
+ *           interrupted thread, so a context switch that it requests takes
+ *           effect when the outermost handler returns.
+ *
+ * Returned Value:
+ *   The register save area to restore:  Normally regs, but the save area
+ *   of the newly started thread after an interrupt level context switch.
+ *
+ ****************************************************************************/
+
+uint32_t IRAM_ATTR *xtensa_irq_dispatch(int irq, uint32_t *regs, int level)
+{
+  return xtensa_irq_deliver(irq, regs, level, NULL, NULL);
+}
+
+/****************************************************************************
+ * Name: xtensa_irq_direct
+ *
+ * Description:
+ *   Deliver one IRQ to a handler known to the caller, bypassing
+ *   irq_dispatch().  Otherwise the same as xtensa_irq_dispatch().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_DIRECT_IRQ
+uint32_t IRAM_ATTR *xtensa_irq_direct(int irq, uint32_t *regs, int level,
+                                      xcpt_t handler, FAR void *arg)
+{
+  return xtensa_irq_deliver(irq, regs, level, handler, arg);
+}
+#endif
@@ -49,6 +49,7 @@
 #include "sched/sched.h"
 #include "group/group.h"
 #include "xtensa.h"
+#include "xtensa_attr.h"
 
 /****************************************************************************
  * Public Functions
@@ -65,7 +66,7 @@
  *
  ****************************************************************************/
 
-void up_release_pending(void)
+void IRAM_ATTR up_release_pending(void)
 {
   struct tcb_s *rtcb = this_task();
 
@@ -124,7 +125,7 @@ void up_release_pending(void)
            * processor save area.
            */
 
-          xtensa_coproc_savestate(&rtcb->xcp.cpstate);
+          xtensa_coproc_suspend(rtcb);
 #endif
           /* Restore the exception context of the rtcb at the (new) head
            * of the ready-to-run task list.
@@ -135,7 +136,13 @@ void up_release_pending(void)
 #if XCHAL_CP_NUM > 0
           /* Set up the co-processor state for the newly started thread. */
 
-          xtensa_coproc_restorestate(&rtcb->xcp.cpstate);
+          xtensa_coproc_resume(rtcb);
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+          /* Select the thread-local storage of the newly started thread. */
+
+          xtensa_tls_resume(rtcb);
 #endif
 
 #ifdef CONFIG_ARCH_ADDRENV
@@ -44,6 +44,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
+#include <arch/chip/core-isa.h>
 
 #include "xtensa.h"
 
@@ -84,6 +85,14 @@
 
 void up_release_stack(FAR struct tcb_s *dtcb, uint8_t ttype)
 {
+#if XCHAL_CP_NUM > 0
+  /* The co-processor save area lies in the stack.  Make sure that the
+   * co-processor state is never again saved there.
+   */
+
+  xtensa_coproc_release(dtcb);
+
+#endif
   /* Is there a stack allocated? */
 
   if (dtcb->stack_alloc_ptr)
@@ -105,13 +114,27 @@ void up_release_stack(FAR struct tcb_s *dtcb, uint8_t ttype)
 
           if (umm_heapmember(dtcb->stack_alloc_ptr))
             {
-              sched_ufree(dtcb->stack_alloc_ptr);
+#ifdef CONFIG_XTENSA_STACKCACHE
+              /* Keep the stack for the next thread of the same size class
+               * if it was allocated by up_create_stack().
+               */
+
+              if ((dtcb->flags & TCB_FLAG_STACK_CACHED) == 0 ||
+                  !xtensa_stackcache_free(dtcb->stack_alloc_ptr,
+                     XTENSA_STACKCACHE_ROUNDUP(dtcb->adj_stack_size)))
+#endif
+                {
+                  sched_ufree(dtcb->stack_alloc_ptr);
+                }
             }
         }
 
       /* Mark the stack freed */
 
       dtcb->stack_alloc_ptr = NULL;
+#ifdef CONFIG_XTENSA_STACKCACHE
+      dtcb->flags &= ~TCB_FLAG_STACK_CACHED;
+#endif
     }
 
   /* The size of the allocated stack is now zero */
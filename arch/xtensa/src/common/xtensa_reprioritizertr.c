@@ -51,6 +51,7 @@
 #include "sched/sched.h"
 #include "group/group.h"
 #include "xtensa.h"
+#include "xtensa_attr.h"
 
 /****************************************************************************
  * Public Functions
@@ -76,7 +77,7 @@
  *
  ****************************************************************************/
 
-void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
+void IRAM_ATTR up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 {
   /* Verify that the caller is sane */
 
@@ -177,7 +178,7 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
                * processor save area.
                */
 
-              xtensa_coproc_savestate(&rtcb->xcp.cpstate);
+              xtensa_coproc_suspend(rtcb);
 #endif
               /* Restore the exception context of the rtcb at the (new) head
                * of the ready-to-run task list.
@@ -188,7 +189,13 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 #if XCHAL_CP_NUM > 0
               /* Set up the co-processor state for the newly started thread. */
 
-              xtensa_coproc_restorestate(&rtcb->xcp.cpstate);
+              xtensa_coproc_resume(rtcb);
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+              /* Select the thread-local storage of the newly started thread. */
+
+              xtensa_tls_resume(rtcb);
 #endif
 
 #ifdef CONFIG_ARCH_ADDRENV
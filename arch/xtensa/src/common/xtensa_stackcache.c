@@ -0,0 +1,157 @@
+/****************************************************************************
+ * arch/xtensa/src/common/xtensa_stackcache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+
+#include "xtensa.h"
+
+#ifdef CONFIG_XTENSA_STACKCACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A cached stack.  This header overlays the lowest words of the stack
+ * memory itself so that the cache needs no storage of its own.
+ */
+
+struct xtensa_stackcache_s
+{
+  FAR struct xtensa_stackcache_s *flink; /* Next cached stack */
+  size_t size;                           /* Allocated size of this stack */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct xtensa_stackcache_s *g_stackcache; /* Most recent first */
+static uint8_t g_nstackcache;                        /* Number cached */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: xtensa_stackcache_alloc
+ *
+ * Description:
+ *   Take a cached stack of exactly 'size' bytes.  'size' must already have
+ *   been rounded up with XTENSA_STACKCACHE_ROUNDUP().
+ *
+ * Returned Value:
+ *   The stack memory or NULL if no stack of that size class is cached.
+ *
+ ****************************************************************************/
+
+FAR void *xtensa_stackcache_alloc(size_t size)
+{
+  FAR struct xtensa_stackcache_s *prev = NULL;
+  FAR struct xtensa_stackcache_s *curr;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  for (curr = g_stackcache; curr != NULL; prev = curr, curr = curr->flink)
+    {
+      if (curr->size == size)
+        {
+          if (prev == NULL)
+            {
+              g_stackcache = curr->flink;
+            }
+          else
+            {
+              prev->flink = curr->flink;
+            }
+
+          g_nstackcache--;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return curr;
+}
+
+/****************************************************************************
+ * Name: xtensa_stackcache_free
+ *
+ * Description:
+ *   Offer a released stack to the cache.  This may be called with the
+ *   stack still in use by an exiting thread:  The caller holds the
+ *   critical section until the context switch away from that thread, and
+ *   only the lowest words of the stack are modified.
+ *
+ * Returned Value:
+ *   true if the stack was cached; false if the cache is full and the
+ *   caller must free the stack.
+ *
+ ****************************************************************************/
+
+bool xtensa_stackcache_free(FAR void *stack, size_t size)
+{
+  FAR struct xtensa_stackcache_s *entry;
+  irqstate_t flags;
+  bool cached = false;
+
+  DEBUGASSERT(size >= sizeof(struct xtensa_stackcache_s));
+
+  flags = enter_critical_section();
+  if (g_nstackcache < CONFIG_XTENSA_STACKCACHE_NSTACKS)
+    {
+      entry        = (FAR struct xtensa_stackcache_s *)stack;
+      entry->size  = size;
+      entry->flink = g_stackcache;
+      g_stackcache = entry;
+      g_nstackcache++;
+      cached       = true;
+    }
+
+  leave_critical_section(flags);
+  return cached;
+}
+
+#endif /* CONFIG_XTENSA_STACKCACHE */
@@ -41,6 +41,10 @@
 #include <arch/xtensa/xtensa_corebits.h>
 #include <arch/board/board.h>
 
+#ifndef __ASSEMBLER__
+#  include <stdint.h>
+#endif
+
 /* Select timer to use for periodic tick, and determine its interrupt number
  * and priority. User may specify a timer by defining XT_TIMER_INDEX with -D,
  * in which case its validity is checked (it must exist in this core and must
@@ -143,6 +147,56 @@
 #ifndef __ASSEMBLER__
 extern unsigned _xt_tick_divisor;
 void _xt_tick_divisor_init(void);
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Function:  xtensa_getcount, xtensa_getcompare, and xtensa_setcompare
+ *
+ * Description:
+ *   Lower level operations on Xtensa special registers.
+ *
+ ****************************************************************************/
+
+/* Return the current value of the cyle count register */
+
+static inline uint32_t xtensa_getcount(void)
+{
+  uint32_t count;
+
+  __asm__ __volatile__
+  (
+    "rsr %0, CCOUNT"  : "=r"(count)
+  );
+
+  return count;
+}
+
+/* Return the old value of the compare register */
+
+static inline uint32_t xtensa_getcompare(void)
+{
+  uint32_t compare;
+
+  __asm__ __volatile__
+  (
+    "rsr %0, %1"  : "=r"(compare) : "I"(XT_CCOMPARE)
+  );
+
+  return compare;
+}
+
+/* Set the value of the compare register */
+
+static inline void xtensa_setcompare(uint32_t compare)
+{
+  __asm__ __volatile__
+  (
+    "wsr %0, %1" : : "r"(compare), "I"(XT_CCOMPARE)
+  );
+}
 #endif
 
 #endif  /* __ARCH_XTENSA_SRC_COMMON_XTENSA_TIMER_H */
@@ -0,0 +1,136 @@
+/****************************************************************************
+ * arch/xtensa/src/common/xtensa_tls.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xtensa.h"
+
+#ifdef CONFIG_XTENSA_TLS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Xtensa uses TLS variant I:  THREADPTR points to an 8-byte thread control
+ * block which is followed by the TLS block, aligned to the alignment of the
+ * TLS segment.  The compiler is never interested in the content of the
+ * thread control block.
+ */
+
+#define TLS_TCB_SIZE    8
+
+#define TLS_ALIGN       ((uintptr_t)_thread_local_align)
+#define TLS_ALIGN_UP(a) (((a) + TLS_ALIGN - 1) & ~(TLS_ALIGN - 1))
+#define TLS_ALIGN_DOWN(a) ((a) & ~(TLS_ALIGN - 1))
+
+#define TLS_TCB_OFFSET  TLS_ALIGN_UP(TLS_TCB_SIZE)
+#define TLS_DATA_SIZE   ((uintptr_t)_thread_local_data_end - \
+                         (uintptr_t)_thread_local_start)
+#define TLS_BLOCK_SIZE  ((uintptr_t)_thread_local_end - \
+                         (uintptr_t)_thread_local_start)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Provided by the linker script:  The .tdata image that initializes each
+ * TLS block, the end of the .tbss section that follows it, and the
+ * alignment of the TLS segment (the value is the address of the symbol).
+ */
+
+extern uint8_t _thread_local_start[];
+extern uint8_t _thread_local_data_end[];
+extern uint8_t _thread_local_end[];
+extern uint8_t _thread_local_align[];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: xtensa_tls_size
+ *
+ * Description:
+ *   Return the number of bytes that must be reserved at the top of a stack
+ *   to hold the thread control block and the TLS block of a thread,
+ *   including any alignment padding.
+ *
+ ****************************************************************************/
+
+size_t xtensa_tls_size(void)
+{
+  return TLS_TCB_OFFSET + TLS_BLOCK_SIZE + TLS_ALIGN - 1;
+}
+
+/****************************************************************************
+ * Name: xtensa_tls_threadptr
+ *
+ * Description:
+ *   Return the THREADPTR value of a thread whose TLS block lies in the
+ *   xtensa_tls_size() bytes just below 'top'.
+ *
+ ****************************************************************************/
+
+uint32_t xtensa_tls_threadptr(uintptr_t top)
+{
+  return TLS_ALIGN_DOWN(top - TLS_BLOCK_SIZE) - TLS_TCB_OFFSET;
+}
+
+/****************************************************************************
+ * Name: xtensa_tls_initialize
+ *
+ * Description:
+ *   (Re-)initialize the TLS block addressed by a THREADPTR value:  Copy the
+ *   .tdata image and clear the .tbss part.
+ *
+ ****************************************************************************/
+
+void xtensa_tls_initialize(uint32_t threadptr)
+{
+  uint8_t *block = (uint8_t *)(threadptr + TLS_TCB_OFFSET);
+
+  memcpy(block, _thread_local_start, TLS_DATA_SIZE);
+  memset(block + TLS_DATA_SIZE, 0, TLS_BLOCK_SIZE - TLS_DATA_SIZE);
+}
+
+#endif /* CONFIG_XTENSA_TLS */
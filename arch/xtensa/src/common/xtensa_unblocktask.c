@@ -50,6 +50,7 @@
 #include "group/group.h"
 #include "clock/clock.h"
 #include "xtensa.h"
+#include "xtensa_attr.h"
 
 /****************************************************************************
  * Public Functions
@@ -71,7 +72,7 @@
  *
  ****************************************************************************/
 
-void up_unblock_task(struct tcb_s *tcb)
+void IRAM_ATTR up_unblock_task(struct tcb_s *tcb)
 {
   struct tcb_s *rtcb = this_task();
 
@@ -138,7 +139,7 @@ void up_unblock_task(struct tcb_s *tcb)
            * processor save area.
            */
 
-          xtensa_coproc_savestate(&rtcb->xcp.cpstate);
+          xtensa_coproc_suspend(rtcb);
 #endif
 
           /* Restore the exception context of the new task that is ready to
@@ -151,7 +152,13 @@ void up_unblock_task(struct tcb_s *tcb)
 #if XCHAL_CP_NUM > 0
           /* Set up the co-processor state for the newly started thread. */
 
-          xtensa_coproc_restorestate(&rtcb->xcp.cpstate);
+          xtensa_coproc_resume(rtcb);
+#endif
+
+#ifdef CONFIG_XTENSA_TLS
+          /* Select the thread-local storage of the newly started thread. */
+
+          xtensa_tls_resume(rtcb);
 #endif
 
 #ifdef CONFIG_ARCH_ADDRENV
@@ -119,6 +119,12 @@ int up_use_stack(struct tcb_s *tcb, void *stack, size_t stack_size)
 
   tcb->stack_alloc_ptr = stack;
 
+#ifdef CONFIG_XTENSA_STACKCOLOR_LAZY
+  /* The stack will be painted the first time that it is checked */
+
+  tcb->xcp.stack_hwm = NULL;
+#endif
+
   /* XTENSA uses a push-down stack:  the stack grows toward loweraddresses in
    * memory.  The stack pointer register, points to the lowest, valid work
    * address (the "top" of the stack).  Items on the stack are referenced
@@ -127,6 +133,15 @@ int up_use_stack(struct tcb_s *tcb, void *stack, size_t stack_size)
 
   top_of_stack = (uint32_t)tcb->stack_alloc_ptr + stack_size - 4;
 
+#ifdef CONFIG_XTENSA_TLS
+  /* The thread-local storage block is taken from the top of the stack.  It
+   * is initialized by up_initial_state().
+   */
+
+  tcb->xcp.threadptr = xtensa_tls_threadptr(top_of_stack);
+  top_of_stack      -= xtensa_tls_size() + 4;
+#endif
+
   /* The XTENSA stack must be aligned at word (4 byte) or double word (8 byte)
    * boundaries. If necessary top_of_stack must be rounded down to the
    * next boundary
@@ -0,0 +1,68 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/chip/esp32_aes.h
+ *
+ * Adapted from use in NuttX by:
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Derives from logic originally provided by Espressif Systems:
+ *
+ *   Copyright 2015-2016 Espressif Systems (Shanghai) PTE LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_AES_H
+#define __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_AES_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "chip/esp32_soc.h"
+
+/****************************************************************************
+ * Pre-processor Macros
+ ****************************************************************************/
+
+/* AES Accelerator Register Addresses ***************************************/
+
+#define AES_START_REG                    (DR_REG_AES_BASE + 0x000)
+#define AES_IDLE_REG                     (DR_REG_AES_BASE + 0x004)
+#define AES_MODE_REG                     (DR_REG_AES_BASE + 0x008)
+#define AES_KEY_REG(n)                   (DR_REG_AES_BASE + 0x010 + ((n) << 2))
+#define AES_TEXT_REG(n)                  (DR_REG_AES_BASE + 0x030 + ((n) << 2))
+#define AES_ENDIAN_REG                   (DR_REG_AES_BASE + 0x040)
+
+#define AES_NKEYREGS                     8
+#define AES_NTEXTREGS                    4
+
+/* AES_START_REG and AES_IDLE_REG *******************************************/
+
+#define AES_START                        (BIT(0)) /* Write 1 to start */
+#define AES_IDLE                         (BIT(0)) /* 1: Operation complete */
+
+/* AES_MODE_REG *************************************************************/
+
+#define AES_MODE_ENC128                  0
+#define AES_MODE_ENC192                  1
+#define AES_MODE_ENC256                  2
+#define AES_MODE_DEC128                  4
+#define AES_MODE_DEC192                  5
+#define AES_MODE_DEC256                  6
+
+#define AES_MODE_DECRYPT                 (BIT(2))
+
+#endif /* __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_AES_H */
@@ -0,0 +1,83 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/chip/esp32_dma.h
+ *
+ * Adapted from use in NuttX by:
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Derives from logic originally provided by Espressif Systems:
+ *
+ *   Copyright 2015-2016 Espressif Systems (Shanghai) PTE LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_DMA_H
+#define __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_DMA_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+#include "chip/esp32_soc.h"
+
+/****************************************************************************
+ * Pre-processor Macros
+ ****************************************************************************/
+
+/* DMA linked list descriptors are shared by the UHCI, SPI and I2S DMA
+ * engines.  Buffers and descriptors must be in internal DRAM.
+ */
+
+/* Descriptor control word */
+
+#define DMADESC_SIZE_S                   0         /* Size of the buffer */
+#define DMADESC_SIZE_M                   (0xfff << DMADESC_SIZE_S)
+#define DMADESC_LENGTH_S                 12        /* Number of valid bytes */
+#define DMADESC_LENGTH_M                 (0xfff << DMADESC_LENGTH_S)
+#define DMADESC_SOSF                     (BIT(29))
+#define DMADESC_EOF                      (BIT(30)) /* Last descriptor of frame */
+#define DMADESC_OWNER_DMA                (BIT(31)) /* Owned by DMA, not the CPU */
+
+#define DMADESC_MAXSIZE                  4095
+#define DMADESC_MAXALIGNED               4092      /* Largest word multiple */
+
+/* Internal DRAM reachable by the DMA engines */
+
+#define DMA_DRAM_START                   0x3ffae000
+#define DMA_DRAM_END                     0x40000000
+
+#define DMA_CAPABLE(p) \
+  ((uintptr_t)(p) >= DMA_DRAM_START && (uintptr_t)(p) < DMA_DRAM_END)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifndef __ASSEMBLY__
+
+/* DMA linked list descriptor */
+
+struct esp32_dmadesc_s
+{
+  uint32_t ctrl;                /* Size, length, EOF and owner bits */
+  uint32_t buf;                 /* Buffer address */
+  uint32_t next;                /* Address of the next descriptor or 0 */
+};
+
+#endif /* __ASSEMBLY__ */
+#endif /* __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_DMA_H */
@@ -125,6 +125,14 @@
 #define DPORT_PERI_CLK_EN_V  0xFFFFFFFF
 #define DPORT_PERI_CLK_EN_S  0
 
+/* Bits in DPORT_PERI_CLK_EN_REG and DPORT_PERI_RST_EN_REG */
+
+#define DPORT_PERI_EN_AES                 (BIT(0))
+#define DPORT_PERI_EN_SHA                 (BIT(1))
+#define DPORT_PERI_EN_RSA                 (BIT(2))
+#define DPORT_PERI_EN_SECUREBOOT          (BIT(3))
+#define DPORT_PERI_EN_DIGITAL_SIGNATURE   (BIT(4))
+
 #define DPORT_PERI_RST_EN_REG          (DR_REG_DPORT_BASE + 0x020)
 
 /* DPORT_PERI_RST_EN : R/W ;bitpos:[31:0] ;default: 32'h0 ; */
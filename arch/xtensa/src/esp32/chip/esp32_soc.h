@@ -183,6 +183,7 @@
 #define TICKS_PER_US_ROM                        26               /* CPU is 80MHz */
 
 #define DR_REG_DPORT_BASE                       0x3ff00000
+#define DR_REG_AES_BASE                         0x3ff01000
 #define DR_REG_UART_BASE                        0x3ff40000
 #define DR_REG_SPI1_BASE                        0x3ff42000
 #define DR_REG_SPI0_BASE                        0x3ff43000
@@ -226,6 +227,13 @@
 #define DR_REG_PWM3_BASE                        0x3ff70000
 #define PERIPHS_SPI_ENCRYPT_BASEADDR            DR_REG_SPI_ENCRYPT_BASE
 
+/* Hardware random number generator.  The output is only truly random while
+ * the RF subsystem (WiFi or BT) is enabled; otherwise it is a pseudo-random
+ * sequence.
+ */
+
+#define WDEV_RND_REG                            0x3ff75144
+
 /* Interrupt hardware source table
  * This table is decided by hardware, don't touch this.
  */
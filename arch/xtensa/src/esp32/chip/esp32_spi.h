@@ -0,0 +1,198 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/chip/esp32_spi.h
+ *
+ * Adapted from use in NuttX by:
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Derives from logic originally provided by Espressif Systems:
+ *
+ *   Copyright 2015-2016 Espressif Systems (Shanghai) PTE LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_SPI_H
+#define __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_SPI_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "chip/esp32_soc.h"
+
+/****************************************************************************
+ * Pre-processor Macros
+ ****************************************************************************/
+
+/* SPI Register Offsets *****************************************************/
+
+#define SPI_CMD_OFFSET                   0x000
+#define SPI_ADDR_OFFSET                  0x004
+#define SPI_CTRL_OFFSET                  0x008
+#define SPI_CTRL1_OFFSET                 0x00c
+#define SPI_RD_STATUS_OFFSET             0x010
+#define SPI_CTRL2_OFFSET                 0x014
+#define SPI_CLOCK_OFFSET                 0x018
+#define SPI_USER_OFFSET                  0x01c
+#define SPI_USER1_OFFSET                 0x020
+#define SPI_USER2_OFFSET                 0x024
+#define SPI_MOSI_DLEN_OFFSET             0x028
+#define SPI_MISO_DLEN_OFFSET             0x02c
+#define SPI_SLV_WR_STATUS_OFFSET         0x030
+#define SPI_PIN_OFFSET                   0x034
+#define SPI_SLAVE_OFFSET                 0x038
+#define SPI_SLAVE1_OFFSET                0x03c
+#define SPI_SLAVE2_OFFSET                0x040
+#define SPI_SLAVE3_OFFSET                0x044
+#define SPI_W0_OFFSET                    0x080 /* W0-W15: 64 byte data buffer */
+#define SPI_W_OFFSET(n)                  (SPI_W0_OFFSET + ((n) << 2))
+#define SPI_EXT0_OFFSET                  0x0f0
+#define SPI_EXT1_OFFSET                  0x0f4
+#define SPI_EXT2_OFFSET                  0x0f8
+#define SPI_EXT3_OFFSET                  0x0fc
+#define SPI_DMA_CONF_OFFSET              0x100
+#define SPI_DMA_OUT_LINK_OFFSET          0x104
+#define SPI_DMA_IN_LINK_OFFSET           0x108
+#define SPI_DMA_STATUS_OFFSET            0x10c
+#define SPI_DMA_INT_ENA_OFFSET           0x110
+#define SPI_DMA_INT_RAW_OFFSET           0x114
+#define SPI_DMA_INT_ST_OFFSET            0x118
+#define SPI_DMA_INT_CLR_OFFSET           0x11c
+#define SPI_DATE_OFFSET                  0x3fc
+
+#define SPI_NWREGS                       16    /* Number of W registers */
+#define SPI_WBUFSIZE                     64    /* Bytes in W0-W15 */
+
+/* SPI_CMD Register Bits ****************************************************/
+
+#define SPI_USR                          (BIT(18)) /* Start user transaction */
+
+/* SPI_CTRL Register Bits ***************************************************/
+
+#define SPI_WR_BIT_ORDER                 (BIT(26)) /* 1: LSB first on MOSI */
+#define SPI_RD_BIT_ORDER                 (BIT(25)) /* 1: LSB first on MISO */
+
+/* SPI_CTRL2 Register Bits **************************************************/
+
+#define SPI_MOSI_DELAY_NUM_S             23
+#define SPI_MOSI_DELAY_NUM_M             (0x7 << SPI_MOSI_DELAY_NUM_S)
+#define SPI_MOSI_DELAY_MODE_S            21
+#define SPI_MOSI_DELAY_MODE_M            (0x3 << SPI_MOSI_DELAY_MODE_S)
+#define SPI_MISO_DELAY_NUM_S             18
+#define SPI_MISO_DELAY_NUM_M             (0x7 << SPI_MISO_DELAY_NUM_S)
+#define SPI_MISO_DELAY_MODE_S            16
+#define SPI_MISO_DELAY_MODE_M            (0x3 << SPI_MISO_DELAY_MODE_S)
+
+/* SPI_CLOCK Register Bits **************************************************/
+
+#define SPI_CLK_EQU_SYSCLK               (BIT(31)) /* SPI clock = APB clock */
+#define SPI_CLKDIV_PRE_S                 18        /* Pre-divider - 1 */
+#define SPI_CLKDIV_PRE_M                 (0x1fff << SPI_CLKDIV_PRE_S)
+#define SPI_CLKDIV_PRE_MAX               8192
+#define SPI_CLKCNT_N_S                   12        /* Divider - 1 */
+#define SPI_CLKCNT_N_M                   (0x3f << SPI_CLKCNT_N_S)
+#define SPI_CLKCNT_N_MAX                 64
+#define SPI_CLKCNT_H_S                   6         /* High time - 1 */
+#define SPI_CLKCNT_H_M                   (0x3f << SPI_CLKCNT_H_S)
+#define SPI_CLKCNT_L_S                   0         /* Equals CLKCNT_N */
+#define SPI_CLKCNT_L_M                   (0x3f << SPI_CLKCNT_L_S)
+
+/* SPI_USER Register Bits ***************************************************/
+
+#define SPI_USR_COMMAND                  (BIT(31))
+#define SPI_USR_ADDR                     (BIT(30))
+#define SPI_USR_DUMMY                    (BIT(29))
+#define SPI_USR_MISO                     (BIT(28)) /* Read-data phase */
+#define SPI_USR_MOSI                     (BIT(27)) /* Write-data phase */
+#define SPI_USR_DUMMY_IDLE               (BIT(26))
+#define SPI_USR_MOSI_HIGHPART            (BIT(25))
+#define SPI_USR_MISO_HIGHPART            (BIT(24))
+#define SPI_SIO                          (BIT(16))
+#define SPI_CK_OUT_EDGE                  (BIT(7))
+#define SPI_CK_I_EDGE                    (BIT(6))
+#define SPI_CS_SETUP                     (BIT(5))
+#define SPI_CS_HOLD                      (BIT(4))
+#define SPI_DOUTDIN                      (BIT(0))  /* Full duplex */
+
+/* SPI_MOSI_DLEN and SPI_MISO_DLEN Registers: bit length - 1 ****************/
+
+#define SPI_DLEN_BITLEN_S                0
+#define SPI_DLEN_BITLEN_M                (0xffffff << SPI_DLEN_BITLEN_S)
+
+/* SPI_PIN Register Bits ****************************************************/
+
+#define SPI_CS_KEEP_ACTIVE               (BIT(30))
+#define SPI_CK_IDLE_EDGE                 (BIT(29)) /* 1: SCK idles high */
+#define SPI_CK_DIS                       (BIT(5))
+#define SPI_CS2_DIS                      (BIT(2))
+#define SPI_CS1_DIS                      (BIT(1))
+#define SPI_CS0_DIS                      (BIT(0))
+
+/* SPI_SLAVE Register Bits **************************************************/
+
+#define SPI_SYNC_RESET                   (BIT(31))
+#define SPI_SLAVE_MODE                   (BIT(30))
+#define SPI_TRANS_INTEN                  (BIT(9))  /* Transaction done interrupt */
+#define SPI_SLV_WR_STA_INTEN             (BIT(8))
+#define SPI_SLV_RD_STA_INTEN             (BIT(7))
+#define SPI_SLV_WR_BUF_INTEN             (BIT(6))
+#define SPI_SLV_RD_BUF_INTEN             (BIT(5))
+#define SPI_TRANS_DONE                   (BIT(4))  /* Transaction done status */
+
+/* SPI_DMA_CONF Register Bits ***********************************************/
+
+#define SPI_DMA_CONTINUE                 (BIT(16))
+#define SPI_DMA_TX_STOP                  (BIT(15))
+#define SPI_DMA_RX_STOP                  (BIT(14))
+#define SPI_OUT_DATA_BURST_EN            (BIT(12))
+#define SPI_INDSCR_BURST_EN              (BIT(11))
+#define SPI_OUTDSCR_BURST_EN             (BIT(10))
+#define SPI_OUT_EOF_MODE                 (BIT(9))
+#define SPI_AHBM_RST                     (BIT(5))
+#define SPI_AHBM_FIFO_RST                (BIT(4))
+#define SPI_OUT_RST                      (BIT(3))
+#define SPI_IN_RST                       (BIT(2))
+
+/* SPI_DMA_OUT_LINK Register Bits *******************************************/
+
+#define SPI_OUTLINK_RESTART              (BIT(30))
+#define SPI_OUTLINK_START                (BIT(29))
+#define SPI_OUTLINK_STOP                 (BIT(28))
+#define SPI_OUTLINK_ADDR_S               0
+#define SPI_OUTLINK_ADDR_M               (0x000fffff << SPI_OUTLINK_ADDR_S)
+
+/* SPI_DMA_IN_LINK Register Bits ********************************************/
+
+#define SPI_INLINK_RESTART               (BIT(30))
+#define SPI_INLINK_START                 (BIT(29))
+#define SPI_INLINK_STOP                  (BIT(28))
+#define SPI_INLINK_AUTO_RET              (BIT(20))
+#define SPI_INLINK_ADDR_S                0
+#define SPI_INLINK_ADDR_M                (0x000fffff << SPI_INLINK_ADDR_S)
+
+/* SPI_DMA_INT_ENA, SPI_DMA_INT_RAW, SPI_DMA_INT_ST and SPI_DMA_INT_CLR *****/
+
+#define SPI_OUT_TOTAL_EOF_INT            (BIT(8))
+#define SPI_OUT_EOF_INT                  (BIT(7))
+#define SPI_OUT_DONE_INT                 (BIT(6))
+#define SPI_IN_SUC_EOF_INT               (BIT(5))
+#define SPI_IN_ERR_EOF_INT               (BIT(4))
+#define SPI_IN_DONE_INT                  (BIT(3))
+#define SPI_INLINK_DSCR_ERROR_INT        (BIT(2))
+#define SPI_OUTLINK_DSCR_ERROR_INT       (BIT(1))
+#define SPI_INLINK_DSCR_EMPTY_INT        (BIT(0))
+
+#endif /* __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_SPI_H */
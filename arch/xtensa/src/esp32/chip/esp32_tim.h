@@ -0,0 +1,86 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/chip/esp32_tim.h
+ *
+ * Adapted from use in NuttX by:
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Derives from logic originally provided by Espressif Systems:
+ *
+ *   Copyright 2015-2016 Espressif Systems (Shanghai) PTE LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_TIM_H
+#define __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_TIM_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "chip/esp32_soc.h"
+
+/****************************************************************************
+ * Pre-processor Macros
+ ****************************************************************************/
+
+/* Each of the two timer groups holds two 64-bit general purpose timers.
+ * The register block of timer n (0 or 1) within a group begins at offset
+ * TIMG_T_OFFSET(n); the interrupt registers are shared by the group.
+ */
+
+#define TIMG_T_OFFSET(n)                 (0x24 * (n))
+
+/* Timer Register Offsets (relative to TIMG_T_OFFSET(n)) ********************/
+
+#define TIMG_T_CONFIG_OFFSET             0x000
+#define TIMG_T_LO_OFFSET                 0x004 /* Latched counter [31:0] */
+#define TIMG_T_HI_OFFSET                 0x008 /* Latched counter [63:32] */
+#define TIMG_T_UPDATE_OFFSET             0x00c /* Write to latch counter */
+#define TIMG_T_ALARMLO_OFFSET            0x010
+#define TIMG_T_ALARMHI_OFFSET            0x014
+#define TIMG_T_LOADLO_OFFSET             0x018
+#define TIMG_T_LOADHI_OFFSET             0x01c
+#define TIMG_T_LOAD_OFFSET               0x020 /* Write to load counter */
+
+/* Group Interrupt Register Offsets (relative to the group base) ************/
+
+#define TIMG_INT_ENA_OFFSET              0x098
+#define TIMG_INT_RAW_OFFSET              0x09c
+#define TIMG_INT_ST_OFFSET               0x0a0
+#define TIMG_INT_CLR_OFFSET              0x0a4
+
+/* TIMG_T_CONFIG Register Bits **********************************************/
+
+#define TIMG_T_EN                        (BIT(31)) /* Counter enable */
+#define TIMG_T_INCREASE                  (BIT(30)) /* 1: Count up */
+#define TIMG_T_AUTORELOAD                (BIT(29)) /* Reload on alarm */
+#define TIMG_T_DIVIDER_S                 13        /* Prescaler, 0 = 65536 */
+#define TIMG_T_DIVIDER_M                 (0xffff << TIMG_T_DIVIDER_S)
+#define TIMG_T_EDGE_INT_EN               (BIT(12))
+#define TIMG_T_LEVEL_INT_EN              (BIT(11))
+#define TIMG_T_ALARM_EN                  (BIT(10)) /* Cleared on alarm */
+
+#define TIMG_T_DIVIDER_MIN               2
+#define TIMG_T_DIVIDER_MAX               65536
+
+/* TIMG_INT_* Register Bits *************************************************/
+
+#define TIMG_LACT_INT                    (BIT(3))
+#define TIMG_WDT_INT                     (BIT(2))
+#define TIMG_T_INT(n)                    (BIT(n))
+
+#endif /* __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_TIM_H */
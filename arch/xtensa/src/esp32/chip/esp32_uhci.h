@@ -0,0 +1,157 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/chip/esp32_uhci.h
+ *
+ * Adapted from use in NuttX by:
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Derives from logic originally provided by Espressif Systems:
+ *
+ *   Copyright 2015-2016 Espressif Systems (Shanghai) PTE LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_UHCI_H
+#define __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_UHCI_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "chip/esp32_soc.h"
+
+/****************************************************************************
+ * Pre-processor Macros
+ ****************************************************************************/
+
+/* UHCI Register Offsets ****************************************************/
+
+#define UHCI_CONF0_OFFSET                0x00
+#define UHCI_INT_RAW_OFFSET              0x04
+#define UHCI_INT_ST_OFFSET               0x08
+#define UHCI_INT_ENA_OFFSET              0x0c
+#define UHCI_INT_CLR_OFFSET              0x10
+#define UHCI_DMA_OUT_STATUS_OFFSET       0x14
+#define UHCI_DMA_OUT_PUSH_OFFSET         0x18
+#define UHCI_DMA_IN_STATUS_OFFSET        0x1c
+#define UHCI_DMA_IN_POP_OFFSET           0x20
+#define UHCI_DMA_OUT_LINK_OFFSET         0x24
+#define UHCI_DMA_IN_LINK_OFFSET          0x28
+#define UHCI_CONF1_OFFSET                0x2c
+#define UHCI_STATE0_OFFSET               0x30
+#define UHCI_STATE1_OFFSET               0x34
+#define UHCI_DMA_OUT_EOF_DES_ADDR_OFFSET 0x38
+#define UHCI_DMA_IN_SUC_EOF_DES_ADDR_OFFSET 0x3c
+#define UHCI_DMA_IN_ERR_EOF_DES_ADDR_OFFSET 0x40
+#define UHCI_DMA_OUT_EOF_BFR_DES_ADDR_OFFSET 0x44
+#define UHCI_DMA_IN_DSCR_OFFSET          0x4c
+#define UHCI_DMA_OUT_DSCR_OFFSET         0x58
+#define UHCI_ESCAPE_CONF_OFFSET          0x64
+#define UHCI_HUNG_CONF_OFFSET            0x68
+#define UHCI_DATE_OFFSET                 0xfc
+
+/* UHCI_CONF0 Register Bits *************************************************/
+
+#define UHCI_UART_RX_BRK_EOF_EN          (BIT(23))
+#define UHCI_CLK_EN                      (BIT(22))
+#define UHCI_ENCODE_CRC_EN               (BIT(21))
+#define UHCI_LEN_EOF_EN                  (BIT(20))
+#define UHCI_UART_IDLE_EOF_EN            (BIT(19)) /* End the RX frame when the UART is idle */
+#define UHCI_CRC_REC_EN                  (BIT(18))
+#define UHCI_HEAD_EN                     (BIT(17)) /* Add/expect a packet header */
+#define UHCI_SEPER_EN                    (BIT(16)) /* Use separator characters */
+#define UHCI_MEM_TRANS_EN                (BIT(15))
+#define UHCI_OUT_DATA_BURST_EN           (BIT(14))
+#define UHCI_INDSCR_BURST_EN             (BIT(13))
+#define UHCI_OUTDSCR_BURST_EN            (BIT(12))
+#define UHCI_UART2_CE                    (BIT(11)) /* Connect UHCI to UART2 */
+#define UHCI_UART1_CE                    (BIT(10)) /* Connect UHCI to UART1 */
+#define UHCI_UART0_CE                    (BIT(9))  /* Connect UHCI to UART0 */
+#define UHCI_OUT_EOF_MODE                (BIT(8))
+#define UHCI_OUT_NO_RESTART_CLR          (BIT(7))
+#define UHCI_OUT_AUTO_WRBACK             (BIT(6))
+#define UHCI_OUT_LOOP_TEST               (BIT(5))
+#define UHCI_IN_LOOP_TEST                (BIT(4))
+#define UHCI_AHBM_RST                    (BIT(3))
+#define UHCI_AHBM_FIFO_RST               (BIT(2))
+#define UHCI_OUT_RST                     (BIT(1))
+#define UHCI_IN_RST                      (BIT(0))
+
+/* UHCI_INT_RAW, UHCI_INT_ST, UHCI_INT_ENA, and UHCI_INT_CLR Register Bits **/
+
+#define UHCI_DMA_INFIFO_FULL_WM_INT      (BIT(16))
+#define UHCI_SEND_A_REG_Q_INT            (BIT(15))
+#define UHCI_SEND_S_REG_Q_INT            (BIT(14))
+#define UHCI_OUT_TOTAL_EOF_INT           (BIT(13)) /* All TX descriptors sent */
+#define UHCI_OUTLINK_EOF_ERR_INT         (BIT(12))
+#define UHCI_IN_DSCR_EMPTY_INT           (BIT(11))
+#define UHCI_OUT_DSCR_ERR_INT            (BIT(10))
+#define UHCI_IN_DSCR_ERR_INT             (BIT(9))  /* RX descriptor not owned by DMA */
+#define UHCI_OUT_EOF_INT                 (BIT(8))
+#define UHCI_OUT_DONE_INT                (BIT(7))
+#define UHCI_IN_ERR_EOF_INT              (BIT(6))
+#define UHCI_IN_SUC_EOF_INT              (BIT(5))  /* RX frame ended (UART idle) */
+#define UHCI_IN_DONE_INT                 (BIT(4))  /* RX descriptor filled */
+#define UHCI_TX_HUNG_INT                 (BIT(3))
+#define UHCI_RX_HUNG_INT                 (BIT(2))
+#define UHCI_TX_START_INT                (BIT(1))
+#define UHCI_RX_START_INT                (BIT(0))
+
+/* UHCI_DMA_OUT_LINK Register Bits ******************************************/
+
+#define UHCI_OUTLINK_PARK                (BIT(31))
+#define UHCI_OUTLINK_RESTART             (BIT(30))
+#define UHCI_OUTLINK_START               (BIT(29))
+#define UHCI_OUTLINK_STOP                (BIT(28))
+#define UHCI_OUTLINK_ADDR_S              0
+#define UHCI_OUTLINK_ADDR_M              (0x000fffff << UHCI_OUTLINK_ADDR_S)
+
+/* UHCI_DMA_IN_LINK Register Bits *******************************************/
+
+#define UHCI_INLINK_PARK                 (BIT(31))
+#define UHCI_INLINK_RESTART              (BIT(30))
+#define UHCI_INLINK_START                (BIT(29))
+#define UHCI_INLINK_STOP                 (BIT(28))
+#define UHCI_INLINK_AUTO_RET             (BIT(20))
+#define UHCI_INLINK_ADDR_S               0
+#define UHCI_INLINK_ADDR_M               (0x000fffff << UHCI_INLINK_ADDR_S)
+
+/* UHCI_CONF1 Register Bits *************************************************/
+
+#define UHCI_DMA_INFIFO_FULL_THRS_S      9
+#define UHCI_DMA_INFIFO_FULL_THRS_M      (0xfff << UHCI_DMA_INFIFO_FULL_THRS_S)
+#define UHCI_SW_START                    (BIT(8))
+#define UHCI_WAIT_SW_START               (BIT(7))
+#define UHCI_CHECK_OWNER                 (BIT(6))  /* Check descriptor owner bit */
+#define UHCI_TX_ACK_NUM_RE               (BIT(5))
+#define UHCI_TX_CHECK_SUM_RE             (BIT(4))
+#define UHCI_SAVE_HEAD                   (BIT(3))
+#define UHCI_CRC_DISABLE                 (BIT(2))
+#define UHCI_CHECK_SEQ_EN                (BIT(1))
+#define UHCI_CHECK_SUM_EN                (BIT(0))
+
+/* UHCI_ESCAPE_CONF Register Bits.  Writing zero disables all escapes. ******/
+
+#define UHCI_RX_13_ESC_EN                (BIT(7))
+#define UHCI_RX_11_ESC_EN                (BIT(6))
+#define UHCI_RX_DB_ESC_EN                (BIT(5))
+#define UHCI_RX_C0_ESC_EN                (BIT(4))
+#define UHCI_TX_13_ESC_EN                (BIT(3))
+#define UHCI_TX_11_ESC_EN                (BIT(2))
+#define UHCI_TX_DB_ESC_EN                (BIT(1))
+#define UHCI_TX_C0_ESC_EN                (BIT(0))
+
+#endif /* __ARCH_XTENSA_SRC_ESP32_CHIP_ESP32_UHCI_H */
@@ -0,0 +1,334 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_aes.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/crypto/crypto.h>
+
+#include "xtensa.h"
+#include "chip/esp32_soc.h"
+#include "chip/esp32_dport.h"
+#include "chip/esp32_aes.h"
+
+#ifdef CONFIG_ESP32_AES
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define AES_BLOCK_SIZE 16
+
+/* The digital signature and secure boot units share the AES engine and must
+ * also be released from reset.
+ */
+
+#define AES_RST_BITS   (DPORT_PERI_EN_AES | DPORT_PERI_EN_DIGITAL_SIGNATURE | \
+                        DPORT_PERI_EN_SECUREBOOT)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static sem_t g_esp32aes_lock = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32aes_enable
+ *
+ * Description:
+ *   Enable or disable the AES accelerator clock.  The accelerator is held
+ *   in reset while it is not in use.
+ *
+ ****************************************************************************/
+
+static void esp32aes_enable(bool on)
+{
+  if (on)
+    {
+      modifyreg32(DPORT_PERI_CLK_EN_REG, 0, DPORT_PERI_EN_AES);
+      modifyreg32(DPORT_PERI_RST_EN_REG, AES_RST_BITS, 0);
+    }
+  else
+    {
+      modifyreg32(DPORT_PERI_RST_EN_REG, 0, DPORT_PERI_EN_AES);
+      modifyreg32(DPORT_PERI_CLK_EN_REG, DPORT_PERI_EN_AES, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: esp32aes_setkey
+ *
+ * Description:
+ *   Load the key and select the key length and direction.  With the reset
+ *   value of AES_ENDIAN_REG, key and text words are in memory byte order.
+ *
+ ****************************************************************************/
+
+static void esp32aes_setkey(FAR const void *key, uint32_t keysize,
+                            bool encrypt)
+{
+  uint32_t word;
+  uint32_t mode;
+  int i;
+
+  for (i = 0; i < keysize / 4; i++)
+    {
+      memcpy(&word, (FAR const uint8_t *)key + 4 * i, 4);
+      putreg32(word, AES_KEY_REG(i));
+    }
+
+  mode = keysize / 8 - 2;  /* 0, 1, 2 for 128-, 192-, 256-bit keys */
+  if (!encrypt)
+    {
+      mode |= AES_MODE_DECRYPT;
+    }
+
+  putreg32(mode, AES_MODE_REG);
+}
+
+/****************************************************************************
+ * Name: esp32aes_block
+ *
+ * Description:
+ *   Process one 16 byte block through the accelerator.  'out' and 'in' may
+ *   be the same buffer and need not be aligned.
+ *
+ ****************************************************************************/
+
+static void esp32aes_block(FAR void *out, FAR const void *in)
+{
+  uint32_t word;
+  int i;
+
+  for (i = 0; i < AES_NTEXTREGS; i++)
+    {
+      memcpy(&word, (FAR const uint8_t *)in + 4 * i, 4);
+      putreg32(word, AES_TEXT_REG(i));
+    }
+
+  putreg32(AES_START, AES_START_REG);
+  while ((getreg32(AES_IDLE_REG) & AES_IDLE) == 0)
+    {
+    }
+
+  for (i = 0; i < AES_NTEXTREGS; i++)
+    {
+      word = getreg32(AES_TEXT_REG(i));
+      memcpy((FAR uint8_t *)out + 4 * i, &word, 4);
+    }
+}
+
+/****************************************************************************
+ * Name: esp32aes_xor
+ ****************************************************************************/
+
+static void esp32aes_xor(FAR uint8_t *out, FAR const uint8_t *in1,
+                         FAR const uint8_t *in2, size_t size)
+{
+  while (size-- > 0)
+    {
+      *out++ = *in1++ ^ *in2++;
+    }
+}
+
+/****************************************************************************
+ * Name: esp32aes_ctr
+ *
+ * Description:
+ *   Process a buffer in CTR mode.  The counter block is the IV (which must
+ *   be provided), incremented as a 128-bit big-endian integer after each
+ *   block.  The final block may be partial.
+ *
+ ****************************************************************************/
+
+static void esp32aes_ctr(FAR uint8_t *out, FAR const uint8_t *in,
+                         uint32_t size, FAR uint8_t *ctr)
+{
+  uint8_t stream[AES_BLOCK_SIZE];
+  uint32_t nbytes;
+  int i;
+
+  while (size > 0)
+    {
+      esp32aes_block(stream, ctr);
+
+      nbytes = size < AES_BLOCK_SIZE ? size : AES_BLOCK_SIZE;
+      esp32aes_xor(out, in, stream, nbytes);
+
+      for (i = AES_BLOCK_SIZE - 1; i >= 0 && ++ctr[i] == 0; i--)
+        {
+        }
+
+      out  += nbytes;
+      in   += nbytes;
+      size -= nbytes;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aes_cypher
+ *
+ * Description:
+ *   Encrypt or decrypt a whole buffer with the AES accelerator.  The
+ *   accelerator only operates on single blocks; ECB, CBC and CTR chaining
+ *   are done here while the key remains loaded in the accelerator.
+ *
+ * Input Parameters:
+ *   out     - The output buffer
+ *   in      - The input buffer, may be the same as out
+ *   size    - The size of the buffer.  A multiple of 16 except for CTR
+ *   iv      - The initialization vector (CBC and CTR)
+ *   key     - The key
+ *   keysize - The size of the key: 16, 24 or 32
+ *   mode    - AES_MODE_ECB, AES_MODE_CBC, or AES_MODE_CTR
+ *   encrypt - CYPHER_ENCRYPT or CYPHER_DECRYPT
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int aes_cypher(FAR void *out, FAR const void *in, uint32_t size,
+               FAR const void *iv, FAR const void *key, uint32_t keysize,
+               int mode, int encrypt)
+{
+  FAR uint8_t *dst = (FAR uint8_t *)out;
+  FAR const uint8_t *src = (FAR const uint8_t *)in;
+  uint8_t chain[AES_BLOCK_SIZE];
+  uint8_t block[AES_BLOCK_SIZE];
+  int ret;
+
+  if (keysize != 16 && keysize != 24 && keysize != 32)
+    {
+      return -EINVAL;
+    }
+
+  mode &= AES_MODE_MASK;
+  if (mode != AES_MODE_CTR && (size & (AES_BLOCK_SIZE - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (mode != AES_MODE_ECB && mode != AES_MODE_CBC && mode != AES_MODE_CTR)
+    {
+      return -EINVAL;
+    }
+
+  if (mode != AES_MODE_ECB)
+    {
+      if (iv == NULL)
+        {
+          return -EINVAL;
+        }
+
+      memcpy(chain, iv, AES_BLOCK_SIZE);
+    }
+
+  ret = nxsem_wait(&g_esp32aes_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  esp32aes_enable(true);
+
+  /* CTR mode uses the forward cipher in both directions */
+
+  esp32aes_setkey(key, keysize, encrypt || mode == AES_MODE_CTR);
+
+  if (mode == AES_MODE_CTR)
+    {
+      esp32aes_ctr(dst, src, size, chain);
+    }
+  else
+    {
+      for (; size > 0; size -= AES_BLOCK_SIZE)
+        {
+          if (mode == AES_MODE_ECB)
+            {
+              esp32aes_block(dst, src);
+            }
+          else if (encrypt)
+            {
+              /* CBC encrypt: C[i] = E(P[i] ^ C[i-1]) */
+
+              esp32aes_xor(block, src, chain, AES_BLOCK_SIZE);
+              esp32aes_block(dst, block);
+              memcpy(chain, dst, AES_BLOCK_SIZE);
+            }
+          else
+            {
+              /* CBC decrypt: P[i] = D(C[i]) ^ C[i-1].  Save C[i] first
+               * since the buffers may overlap.
+               */
+
+              memcpy(block, src, AES_BLOCK_SIZE);
+              esp32aes_block(dst, block);
+              esp32aes_xor(dst, dst, chain, AES_BLOCK_SIZE);
+              memcpy(chain, block, AES_BLOCK_SIZE);
+            }
+
+          dst += AES_BLOCK_SIZE;
+          src += AES_BLOCK_SIZE;
+        }
+    }
+
+  esp32aes_enable(false);
+  nxsem_post(&g_esp32aes_lock);
+  return OK;
+}
+
+#endif /* CONFIG_ESP32_AES */
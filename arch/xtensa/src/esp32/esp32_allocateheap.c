@@ -47,6 +47,7 @@
 #include <arch/board/board.h>
 
 #include "xtensa.h"
+#include "esp32_heapcaps.h"
 
 /****************************************************************************
  * Public Functions
@@ -65,15 +66,22 @@
  *   If a protected kernel-space heap is provided, the kernel heap must be
  *   allocated (and protected) by an analogous up_allocate_kheap().
  *
+ *   The normal heap is the internal DRAM, which supports any access and
+ *   DMA.  The heterogeneous memories (IRAM, RTC fast memory and external
+ *   SPI RAM) are not added to it; with CONFIG_ESP32_HEAPCAPS they are
+ *   managed as separate heaps available through esp32_malloc_caps().
+ *
  ****************************************************************************/
 
-#warning REVISIT heap.  Do what with non-heterogeneous memory?
-
 void up_allocate_heap(FAR void **heap_start, size_t *heap_size)
 {
   board_autoled_on(LED_HEAPALLOCATE);
   *heap_start = (FAR void *)&_sheap;
   *heap_size = (size_t)((uintptr_t)&_eheap - (uintptr_t)&_sheap);
+
+#ifdef CONFIG_ESP32_HEAPCAPS
+  esp32_heapcaps_initialize();
+#endif
 }
 
 /****************************************************************************
@@ -111,6 +111,17 @@ int up_cpu_idlestack(int cpu, FAR struct tcb_s *tcb, size_t stack_size)
   topofstack           = (uintptr_t)g_cpu1_idlestack + CPU1_IDLETHREAD_STACKSIZE;
   tcb->adj_stack_ptr   = (uint32_t *)topofstack;
 
+#ifdef CONFIG_XTENSA_TLS
+  /* Take the TLS block of the IDLE thread from the top of its stack.  It
+   * is initialized by up_initial_state().
+   */
+
+  tcb->xcp.threadptr   = xtensa_tls_threadptr(topofstack);
+  topofstack           = (topofstack - xtensa_tls_size() - 4) & ~15;
+  tcb->adj_stack_size  = topofstack - (uintptr_t)g_cpu1_idlestack;
+  tcb->adj_stack_ptr   = (uint32_t *)topofstack;
+#endif
+
 #if XCHAL_CP_NUM > 0
   /* REVISIT: Does it make since to have co-processors enabled on the IDLE thread? */
 #endif
@@ -161,6 +161,15 @@ uint8_t g_cpu0_intmap[ESP32_NCPUINTS];
 uint8_t g_cpu1_intmap[ESP32_NCPUINTS];
 #endif
 
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+/* Zero-latency handlers of each CPU, indexed by CPU interrupt */
+
+struct esp32_hipri_s g_cpu0_hipri[ESP32_NCPUINTS];
+#ifdef CONFIG_SMP
+struct esp32_hipri_s g_cpu1_hipri[ESP32_NCPUINTS];
+#endif
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -633,3 +642,48 @@ void esp32_detach_peripheral(int cpu, int periphid, int cpuint)
 
   putreg32(NO_CPUINT, regaddr);
 }
+
+/****************************************************************************
+ * Name:  esp32_hipri_attach
+ *
+ * Description:
+ *   Attach a zero-latency handler to a CPU interrupt of the current CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+int esp32_hipri_attach(int cpuint, xcpt_t handler, FAR void *arg)
+{
+  struct esp32_hipri_s *hipri;
+  irqstate_t flags;
+
+  if (cpuint < 0 || cpuint > ESP32_CPUINT_MAX ||
+      (g_priority[ESP32_PRIO_INDEX(ESP32_HIPRI_PRIORITY)] &
+       (1ul << cpuint)) == 0)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_SMP
+  if (up_cpu_index() != 0)
+    {
+      hipri = &g_cpu1_hipri[cpuint];
+    }
+  else
+#endif
+    {
+      hipri = &g_cpu0_hipri[cpuint];
+    }
+
+  /* Critical sections do not mask this interrupt.  The caller keeps it
+   * disabled while the handler is changed.
+   */
+
+  flags          = enter_critical_section();
+  hipri->handler = handler;
+  hipri->arg     = arg;
+  leave_critical_section(flags);
+
+  return OK;
+}
+#endif
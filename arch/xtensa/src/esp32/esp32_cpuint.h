@@ -50,6 +50,38 @@
 
 #define CPUINT_UNASSIGNED 0xff  /* No peripheral assigned to this CPU interrupt */
 
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+/* Zero-latency CPU interrupts are allocated at the highest medium priority
+ * level, e.g., esp32_alloc_levelint(ESP32_HIPRI_PRIORITY).
+ */
+
+#  define ESP32_HIPRI_PRIORITY XCHAL_EXCM_LEVEL
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+/* A zero-latency interrupt handler attached with esp32_hipri_attach() */
+
+struct esp32_hipri_s
+{
+  xcpt_t handler;
+  FAR void *arg;
+};
+#endif
+
+#ifdef CONFIG_ESP32_STATIC_IRQ
+/* A handler bound at build time by the board's BOARD_IRQTAB */
+
+struct esp32_irqtab_s
+{
+  xcpt_t handler;
+  FAR void *arg;
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -61,6 +93,21 @@ extern uint8_t g_cpu0_intmap[ESP32_NCPUINTS];
 extern uint8_t g_cpu1_intmap[ESP32_NCPUINTS];
 #endif
 
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+/* Zero-latency handlers of each CPU, indexed by CPU interrupt */
+
+extern struct esp32_hipri_s g_cpu0_hipri[ESP32_NCPUINTS];
+#ifdef CONFIG_SMP
+extern struct esp32_hipri_s g_cpu1_hipri[ESP32_NCPUINTS];
+#endif
+#endif
+
+#ifdef CONFIG_ESP32_STATIC_IRQ
+/* Statically bound handlers, indexed by IRQ number */
+
+extern const struct esp32_irqtab_s g_esp32_irqtab[NR_IRQS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -176,4 +223,35 @@ void esp32_attach_peripheral(int cpu, int periphid, int cpuint);
 
 void esp32_detach_peripheral(int cpu, int periphid, int cpuint);
 
+/****************************************************************************
+ * Name:  esp32_hipri_attach
+ *
+ * Description:
+ *   Attach a zero-latency handler to a CPU interrupt of the current CPU
+ *   that was allocated at ESP32_HIPRI_PRIORITY.  Critical sections do not
+ *   mask these interrupts.  The handler is called directly from the
+ *   interrupt vector with the IRQ of the attached peripheral, the
+ *   interrupted register state, and arg.  It must not call any OS
+ *   interface (no semaphores, signals, message queues, watchdogs,
+ *   enter_critical_section(), or syslog) and it cannot cause a context
+ *   switch.  It must clear the peripheral interrupt before returning.
+ *
+ *   Attach with the CPU interrupt disabled; pass a NULL handler to
+ *   detach.  irq_attach() is not used for these interrupts.
+ *
+ * Input Parameters:
+ *   cpuint  - The CPU interrupt
+ *   handler - The zero-latency handler
+ *   arg     - Argument passed to the handler
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the CPU interrupt is not at
+ *   ESP32_HIPRI_PRIORITY.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+int esp32_hipri_attach(int cpuint, xcpt_t handler, FAR void *arg);
+#endif
+
 #endif /* __ARCH_XTENSA_SRC_ESP32_ESP32_CPUINT_H */
@@ -175,6 +175,12 @@ void xtensa_appcpu_start(void)
   sp = (uint32_t)tcb->adj_stack_ptr;
   __asm__ __volatile__("mov sp, %0\n" : : "r"(sp));
 
+#ifdef CONFIG_XTENSA_TLS
+  /* Select the thread-local storage of the IDLE thread */
+
+  xtensa_tls_resume(tcb);
+#endif
+
   sinfo("CPU%d Started\n", up_cpu_index());
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION
@@ -183,6 +189,12 @@ void xtensa_appcpu_start(void)
   sched_note_cpu_started(tcb);
 #endif
 
+#if defined(CONFIG_SCHED_TICKLESS) && !defined(CONFIG_ALARM_ARCH)
+  /* Synchronize our CCOUNT with CPU0 */
+
+  esp32_tickless_syncapp();
+#endif
+
   /* Handle interlock*/
 
   g_appcpu_started = true;
@@ -212,6 +224,12 @@ void xtensa_appcpu_start(void)
   xtensa_attach_fromcpu0_interrupt();
 #endif
 
+#if defined(CONFIG_SCHED_TICKLESS) && !defined(CONFIG_ALARM_ARCH)
+  /* Enable the tickless alarm on this CPU */
+
+  esp32_tickless_appinit();
+#endif
+
 #if 0 /* Does it make since to have co-processors enabled on the IDLE thread? */
 #if XTENSA_CP_ALLSET != 0
   /* Set initial co-processor state */
@@ -328,6 +346,12 @@ int up_cpu_start(int cpu)
 
       ets_set_appcpu_boot_addr((uint32_t)xtensa_appcpu_start);
 
+#if defined(CONFIG_SCHED_TICKLESS) && !defined(CONFIG_ALARM_ARCH)
+      /* Provide our CCOUNT so that CPU1 can synchronize with it */
+
+      esp32_tickless_syncpro();
+#endif
+
       /* And wait for the initial task to run on CPU1 */
 
       spin_lock(&g_appcpu_interlock);
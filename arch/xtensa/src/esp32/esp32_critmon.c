@@ -0,0 +1,114 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_critmon.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <arch/irq.h>
+#include <arch/board/board.h>
+
+#include "xtensa_timer.h"
+
+#ifdef CONFIG_SCHED_CRITMONITOR
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_critmon_gettime
+ *
+ * Description:
+ *   Return the CCOUNT cycle counter of this CPU.  CCOUNT increments at the
+ *   CPU clock frequency (BOARD_CLOCK_FREQUENCY) and is running from reset,
+ *   so it is usable before the system timer has been initialized.
+ *
+ ****************************************************************************/
+
+uint32_t up_critmon_gettime(void)
+{
+  return xtensa_getcount();
+}
+
+/****************************************************************************
+ * Name: up_critmon_convert
+ *
+ * Description:
+ *   Convert an elapsed number of CCOUNT cycles to a struct timespec.
+ *
+ ****************************************************************************/
+
+void up_critmon_convert(uint32_t elapsed, FAR struct timespec *ts)
+{
+  ts->tv_sec  = elapsed / BOARD_CLOCK_FREQUENCY;
+  ts->tv_nsec = (long)(((uint64_t)(elapsed % BOARD_CLOCK_FREQUENCY) *
+                        NSEC_PER_SEC) / BOARD_CLOCK_FREQUENCY);
+}
+
+/****************************************************************************
+ * Name: up_irq_asserttime
+ *
+ * Description:
+ *   Return the CCOUNT value at which an interrupt was asserted.  This is
+ *   only known for the timer 0 compare interrupt:  It is asserted when
+ *   CCOUNT matches CCOMPARE0 and the timer handler has not yet advanced
+ *   CCOMPARE0 when this is called from irq_dispatch().  The assertion time
+ *   of peripheral interrupts is not latched by the hardware.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+bool up_irq_asserttime(int irq, FAR uint32_t *stamp)
+{
+  if (irq == XTENSA_IRQ_TIMER0)
+    {
+      *stamp = xtensa_getcompare();
+      return true;
+    }
+
+  return false;
+}
+#endif
+
+#endif /* CONFIG_SCHED_CRITMONITOR */
@@ -0,0 +1,234 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_heapcaps.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <debug.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "xtensa.h"
+#include "esp32_heapcaps.h"
+
+#ifdef CONFIG_ESP32_HEAPCAPS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Regions smaller than this are not worth managing */
+
+#define HEAPCAPS_MINSIZE     1024
+
+/* RTC fast memory is addressed at 0x400c0000 on the instruction bus and at
+ * 0x3ff80000 on the data bus.  Byte accesses need the data bus alias.
+ */
+
+#define RTC_IRAM_TO_DRAM(a)  ((a) - 0x400c0000 + 0x3ff80000)
+
+/* External SPI RAM is mapped by the data cache here */
+
+#define SPIRAM_START         0x3f800000
+
+/* Capabilities of the normal, internal DRAM heap */
+
+#define DRAM_CAPS            (MALLOC_CAP_8BIT | MALLOC_CAP_32BIT | \
+                              MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct esp32_heap_s
+{
+  struct mm_heap_s heap;     /* The heap instance */
+  uint32_t caps;             /* MALLOC_CAP_* capabilities of this memory */
+  bool     valid;            /* True: The heap has been initialized */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The heaps other than the normal heap, in order of preference */
+
+static struct esp32_heap_s g_esp32_heaps[] =
+{
+#ifdef CONFIG_ESP32_RTC_HEAP
+  { .caps = MALLOC_CAP_8BIT | MALLOC_CAP_32BIT | MALLOC_CAP_INTERNAL },
+#endif
+#ifdef CONFIG_ESP32_IRAM_HEAP
+  { .caps = MALLOC_CAP_32BIT | MALLOC_CAP_INTERNAL | MALLOC_CAP_EXEC },
+#endif
+#ifdef CONFIG_ESP32_SPIRAM_HEAP
+  { .caps = MALLOC_CAP_8BIT | MALLOC_CAP_32BIT | MALLOC_CAP_SPIRAM },
+#endif
+};
+
+#define NESP32_HEAPS (sizeof(g_esp32_heaps) / sizeof(struct esp32_heap_s))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_heap_initialize
+ ****************************************************************************/
+
+static void esp32_heap_initialize(FAR struct esp32_heap_s *heap,
+                                  uintptr_t start, uintptr_t end)
+{
+  start = (start + 7) & ~7;
+  end  &= ~7;
+
+  if (end > start && end - start >= HEAPCAPS_MINSIZE)
+    {
+      mm_initialize(&heap->heap, (FAR void *)start, end - start);
+      heap->valid = true;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_heapcaps_initialize
+ *
+ * Description:
+ *   Initialize the capability-tagged heaps.  Called from up_allocate_heap().
+ *
+ ****************************************************************************/
+
+void esp32_heapcaps_initialize(void)
+{
+  FAR struct esp32_heap_s *heap = g_esp32_heaps;
+
+#ifdef CONFIG_ESP32_RTC_HEAP
+  esp32_heap_initialize(heap++, RTC_IRAM_TO_DRAM((uintptr_t)&_srtcheap),
+                        RTC_IRAM_TO_DRAM((uintptr_t)&_ertcheap));
+#endif
+#ifdef CONFIG_ESP32_IRAM_HEAP
+  esp32_heap_initialize(heap++, (uintptr_t)&_siramheap,
+                        (uintptr_t)&_eiramheap);
+#endif
+#ifdef CONFIG_ESP32_SPIRAM_HEAP
+  esp32_heap_initialize(heap++, SPIRAM_START,
+                        SPIRAM_START + CONFIG_ESP32_SPIRAM_SIZE);
+#endif
+
+  UNUSED(heap);
+}
+
+/****************************************************************************
+ * Name: esp32_malloc_caps
+ *
+ * Description:
+ *   Allocate memory from the first heap with all of the requested
+ *   capabilities that can satisfy the request.
+ *
+ ****************************************************************************/
+
+FAR void *esp32_malloc_caps(size_t size, uint32_t caps)
+{
+  FAR void *mem;
+  int i;
+
+  if (caps == 0)
+    {
+      caps = MALLOC_CAP_DEFAULT;
+    }
+
+  /* The normal heap is preferred for anything that it can satisfy */
+
+  if ((caps & DRAM_CAPS) == caps)
+    {
+      mem = malloc(size);
+      if (mem != NULL)
+        {
+          return mem;
+        }
+    }
+
+  for (i = 0; i < (int)NESP32_HEAPS; i++)
+    {
+      FAR struct esp32_heap_s *heap = &g_esp32_heaps[i];
+
+      if (heap->valid && (heap->caps & caps) == caps)
+        {
+          mem = mm_malloc(&heap->heap, size);
+          if (mem != NULL)
+            {
+              return mem;
+            }
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: esp32_free_caps
+ *
+ * Description:
+ *   Free memory allocated by esp32_malloc_caps().
+ *
+ ****************************************************************************/
+
+void esp32_free_caps(FAR void *mem)
+{
+  int i;
+
+  for (i = 0; i < (int)NESP32_HEAPS; i++)
+    {
+      FAR struct esp32_heap_s *heap = &g_esp32_heaps[i];
+
+      if (heap->valid && mm_heapmember(&heap->heap, mem))
+        {
+          mm_free(&heap->heap, mem);
+          return;
+        }
+    }
+
+  free(mem);
+}
+
+#endif /* CONFIG_ESP32_HEAPCAPS */
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_heapcaps.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_ESP32_HEAPCAPS_H
+#define __ARCH_XTENSA_SRC_ESP32_ESP32_HEAPCAPS_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <arch/chip/heapcaps.h>
+
+#ifdef CONFIG_ESP32_HEAPCAPS
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Linker script symbols that bound the capability-tagged heaps */
+
+extern uint32_t _siramheap;         /* Start of IRAM not used by code */
+extern uint32_t _eiramheap;         /* End+1 of IRAM */
+extern uint32_t _srtcheap;          /* Start of RTC fast memory not used */
+extern uint32_t _ertcheap;          /* End+1 of RTC fast memory */
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_heapcaps_initialize
+ *
+ * Description:
+ *   Initialize the capability-tagged heaps.  Called from up_allocate_heap().
+ *
+ ****************************************************************************/
+
+void esp32_heapcaps_initialize(void);
+
+#endif /* CONFIG_ESP32_HEAPCAPS */
+#endif /* __ARCH_XTENSA_SRC_ESP32_ESP32_HEAPCAPS_H */
@@ -46,6 +46,7 @@
 #include <arch/irq.h>
 
 #include "xtensa.h"
+#include "xtensa_attr.h"
 #include "esp32_cpuint.h"
 
 /****************************************************************************
@@ -66,6 +67,32 @@ static inline void xtensa_intclear(uint32_t mask)
   );
 }
 
+/****************************************************************************
+ * Name: xtensa_intlevel
+ *
+ * Description:
+ *   Return the interrupt level of a set of pending CPU interrupts.  The
+ *   interrupt handlers pass only the interrupts of their own level.
+ *
+ ****************************************************************************/
+
+static inline int xtensa_intlevel(uint32_t cpuints)
+{
+  if ((cpuints & XCHAL_INTLEVEL1_MASK) != 0)
+    {
+      return 1;
+    }
+
+#if XCHAL_EXCM_LEVEL >= 3
+  if ((cpuints & XCHAL_INTLEVEL2_MASK) != 0)
+    {
+      return 2;
+    }
+#endif
+
+  return XCHAL_EXCM_LEVEL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -88,14 +115,18 @@ static inline void xtensa_intclear(uint32_t mask)
  *
  ****************************************************************************/
 
-uint32_t *xtensa_int_decode(uint32_t cpuints, uint32_t *regs)
+uint32_t IRAM_ATTR *xtensa_int_decode(uint32_t cpuints, uint32_t *regs)
 {
   uint8_t *intmap;
   uint32_t mask;
+  int level;
   int bit;
 #ifdef CONFIG_SMP
   int cpu;
 #endif
+#ifdef CONFIG_ESP32_STATIC_IRQ
+  const struct esp32_irqtab_s *entry;
+#endif
 
 #ifdef CONFIG_SMP
   /* Select PRO or APP CPU interrupt mapping table */
@@ -111,6 +142,8 @@ uint32_t *xtensa_int_decode(uint32_t cpuints, uint32_t *regs)
       intmap = g_cpu0_intmap;
     }
 
+  level = xtensa_intlevel(cpuints);
+
   /* Skip over zero bits, eight at a time */
 
   for (bit = 0, mask = 0xff;
@@ -139,7 +172,20 @@ uint32_t *xtensa_int_decode(uint32_t cpuints, uint32_t *regs)
            * level context switch.
            */
 
-          regs = xtensa_irq_dispatch((int)irq, regs);
+#ifdef CONFIG_ESP32_STATIC_IRQ
+          /* Go straight to a handler bound at build time */
+
+          entry = &g_esp32_irqtab[irq];
+          if (entry->handler != NULL)
+            {
+              regs = xtensa_irq_direct((int)irq, regs, level,
+                                       entry->handler, entry->arg);
+            }
+          else
+#endif
+            {
+              regs = xtensa_irq_dispatch((int)irq, regs, level);
+            }
 
           /* Clear the bit in the pending interrupt so that perhaps
            * we can exit the look early.
@@ -151,3 +197,64 @@ uint32_t *xtensa_int_decode(uint32_t cpuints, uint32_t *regs)
 
   return regs;
 }
+
+/****************************************************************************
+ * Name: xtensa_hipri_decode
+ *
+ * Description:
+ *   Dispatch the zero-latency interrupts at level XCHAL_EXCM_LEVEL to the
+ *   handlers attached with esp32_hipri_attach().  This bypasses
+ *   xtensa_irq_dispatch():  CURRENT_REGS is not touched and no context
+ *   switch is possible.
+ *
+ * Input Parameters:
+ *   cpuints - Set of pending interrupts valid for this level
+ *   regs    - Saves processor state on the stack
+ *
+ * Returned Value:
+ *   Always regs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_XTENSA_HIPRI_INTERRUPT
+uint32_t IRAM_ATTR *xtensa_hipri_decode(uint32_t cpuints, uint32_t *regs)
+{
+  struct esp32_hipri_s *hipri;
+  uint8_t *intmap;
+  uint32_t mask;
+  int bit;
+
+#ifdef CONFIG_SMP
+  if (up_cpu_index() != 0)
+    {
+      hipri  = g_cpu1_hipri;
+      intmap = g_cpu1_intmap;
+    }
+  else
+#endif
+    {
+      hipri  = g_cpu0_hipri;
+      intmap = g_cpu0_intmap;
+    }
+
+  for (bit = 0; bit < ESP32_NCPUINTS && cpuints != 0; bit++)
+    {
+      mask = (1 << bit);
+      if ((cpuints & mask) != 0)
+        {
+          xtensa_intclear(mask);
+
+          DEBUGASSERT(hipri[bit].handler != NULL);
+          if (hipri[bit].handler != NULL)
+            {
+              (void)hipri[bit].handler((int)intmap[bit], regs,
+                                       hipri[bit].arg);
+            }
+
+          cpuints &= ~mask;
+        }
+    }
+
+  return regs;
+}
+#endif
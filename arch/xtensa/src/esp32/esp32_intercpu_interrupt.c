@@ -44,7 +44,7 @@
 #include <assert.h>
 #include <errno.h>
 
-#include <nuttx/spinlock.h>
+#include <nuttx/arch.h>
 #include <arch/irq.h>
 
 #include "chip/esp32_dport.h"
@@ -53,24 +53,87 @@
 #ifdef CONFIG_SMP
 
 /****************************************************************************
- * Private Data
+ * Pre-processor Definitions
  ****************************************************************************/
 
-/* Single parameter passed with the inter-CPU interrupt */
+/* Number of entries in each cross-CPU call mailbox.  Must be a power of
+ * two.
+ */
+
+#define CPUCALL_NENTRIES  8
+#define CPUCALL_MASK      (CPUCALL_NENTRIES - 1)
+
+/* Make sure that prior writes are visible to the other CPU */
 
-static volatile uint8_t g_intcode[CONFIG_SMP_NCPUS] SP_SECTION;
+#define CPUCALL_MEMW()    __asm__ __volatile__ ("memw" : : : "memory")
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One queued cross-CPU function call */
+
+struct cpucall_s
+{
+  cpu_call_t func;                /* Function to call */
+  FAR void *arg;                  /* Argument passed to the function */
+};
 
-/* Spinlock protects parameter array */
+/* A call mailbox.  There is one mailbox for each pair of sending and
+ * receiving CPUs so that each has a single producer (the sending CPU with
+ * its interrupts disabled) and a single consumer (the inter-CPU interrupt
+ * handler of the receiving CPU).  No lock is then needed:  Only the
+ * producer modifies head and only the consumer modifies tail.
+ */
 
-static volatile spinlock_t g_intercpu_spin[CONFIG_SMP_NCPUS] SP_SECTION =
+struct cpucall_mbox_s
 {
-  SP_UNLOCKED, SP_UNLOCKED
+  volatile uint8_t head;          /* Next entry to be written */
+  volatile uint8_t tail;          /* Next entry to be read */
+  struct cpucall_s entry[CPUCALL_NENTRIES];
 };
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Cross-CPU call mailboxes, indexed by the receiving then sending CPU */
+
+static struct cpucall_mbox_s g_cpucall[CONFIG_SMP_NCPUS][CONFIG_SMP_NCPUS];
+
 /****************************************************************************
  * Private Function
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: esp32_cpucall_dispatch
+ *
+ * Description:
+ *   Execute all calls queued for this CPU by another CPU.
+ *
+ ****************************************************************************/
+
+static void esp32_cpucall_dispatch(int tocpu, int fromcpu)
+{
+  FAR struct cpucall_mbox_s *mbox = &g_cpucall[tocpu][fromcpu];
+  FAR struct cpucall_s *call;
+  uint8_t tail = mbox->tail;
+
+  while (tail != mbox->head)
+    {
+      call = &mbox->entry[tail & CPUCALL_MASK];
+      call->func(call->arg);
+
+      /* Release the entry only after the call so that it cannot be
+       * overwritten while in use.
+       */
+
+      tail++;
+      CPUCALL_MEMW();
+      mbox->tail = tail;
+    }
+}
+
 /****************************************************************************
  * Name: esp32_fromcpu_interrupt
  *
@@ -82,8 +145,6 @@ static volatile spinlock_t g_intercpu_spin[CONFIG_SMP_NCPUS] SP_SECTION =
 static int esp32_fromcpu_interrupt(int fromcpu)
 {
   uintptr_t regaddr;
-  int intcode;
-  int tocpu;
 
   DEBUGASSERT((unsigned)fromcpu < CONFIG_SMP_NCPUS);
 
@@ -93,31 +154,33 @@ static int esp32_fromcpu_interrupt(int fromcpu)
                              DPORT_CPU_INTR_FROM_CPU_1_REG;
   putreg32(0, regaddr);
 
-  /* Get the inter-CPU interrupt code */
-
-  tocpu            = up_cpu_index();
-  intcode          = g_intcode[tocpu];
-  g_intcode[tocpu] = CPU_INTCODE_NONE;
+  /* Then execute the calls queued by the other CPU, including pause
+   * requests.  The interrupt was cleared above so calls queued after this
+   * point will raise a new interrupt.
+   */
 
-  spin_unlock(&g_intercpu_spin[tocpu]);
+  esp32_cpucall_dispatch(up_cpu_index(), fromcpu);
+  return OK;
+}
 
-  /* Dispatch the inter-CPU interrupt based on the intcode value */
+/****************************************************************************
+ * Name: esp32_raise_intercpu
+ *
+ * Description:
+ *   Raise the inter-CPU interrupt from this CPU to the other CPU.
+ *
+ ****************************************************************************/
 
-  switch (intcode)
+static inline void esp32_raise_intercpu(int fromcpu)
+{
+  if (fromcpu == 0)
     {
-      case CPU_INTCODE_NONE:
-        break;
-
-      case CPU_INTCODE_PAUSE:
-        xtensa_pause_handler();
-        break;
-
-      default:
-        DEBUGPANIC();
-        break;
+      putreg32(DPORT_CPU_INTR_FROM_CPU_0, DPORT_CPU_INTR_FROM_CPU_0_REG);
+    }
+  else
+    {
+      putreg32(DPORT_CPU_INTR_FROM_CPU_1, DPORT_CPU_INTR_FROM_CPU_1_REG);
     }
-
-  return OK;
 }
 
 /****************************************************************************
@@ -143,51 +206,70 @@ int esp32_fromcpu1_interrupt(int irq, FAR void *context, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: xtensa_intercpu_interrupt
+ * Name: up_cpu_call
  *
  * Description:
- *   Called to trigger a CPU interrupt
+ *   Queue a function call to be executed on another CPU.  The function is
+ *   called from the inter-CPU interrupt handler of the target CPU.  This
+ *   CPU does not wait for the call to execute.
+ *
+ * Input Parameters:
+ *   cpu  - The index of the CPU that will execute the function.
+ *   func - The function to be called
+ *   arg  - The argument passed to the function
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBUSY if the mailbox of the target CPU is full.
  *
  ****************************************************************************/
 
-int xtensa_intercpu_interrupt(int tocpu, int intcode)
+int up_cpu_call(int cpu, cpu_call_t func, FAR void *arg)
 {
+  FAR struct cpucall_mbox_s *mbox;
+  FAR struct cpucall_s *call;
+  irqstate_t flags;
+  uint8_t head;
   int fromcpu;
 
-  DEBUGASSERT((unsigned)tocpu < CONFIG_SMP_NCPUS &&
-              (unsigned)intcode <= UINT8_MAX);
+  DEBUGASSERT((unsigned)cpu < CONFIG_SMP_NCPUS && func != NULL);
 
-  /* Make sure that each inter-cpu event is atomic.  The spinlock should
-   * only be locked if we just completed sending an interrupt to this
-   * CPU but the other CPU has not yet processed it.
+  /* Disable local interrupts so that this CPU is the only producer for the
+   * mailbox.  This does not involve the other CPU in any way.
    */
 
-  spin_lock(&g_intercpu_spin[tocpu]);
+  flags   = up_irq_save();
+  fromcpu = up_cpu_index();
+  DEBUGASSERT(fromcpu != cpu);
 
-  /* Save the passed parameter.  The previous interrupt code should be
-   * CPU_INTCODE_NONE or we have overrun the other CPU.
-   */
+  mbox    = &g_cpucall[cpu][fromcpu];
+  head    = mbox->head;
 
-  DEBUGASSERT(g_intcode[tocpu] == CPU_INTCODE_NONE);
-  g_intcode[tocpu] = intcode;
+  if ((uint8_t)(head - mbox->tail) >= CPUCALL_NENTRIES)
+    {
+      /* The other CPU has not yet consumed the earlier calls.  Don't wait:
+       * It may be spinning with its interrupts disabled.
+       */
 
-  /* Interrupt the other CPU (tocpu) form this CPU.  NOTE: that this logic
-   * fails in numerous ways if fromcpu == tocpu (for example because non-
-   * reentrant spinlocks are used).
-   */
+      up_irq_restore(flags);
+      return -EBUSY;
+    }
 
-  fromcpu = up_cpu_index();
-  DEBUGASSERT(fromcpu != tocpu);
+  call       = &mbox->entry[head & CPUCALL_MASK];
+  call->func = func;
+  call->arg  = arg;
 
-  if (fromcpu == 0)
-    {
-      putreg32(DPORT_CPU_INTR_FROM_CPU_0, DPORT_CPU_INTR_FROM_CPU_0_REG);
-    }
-  else
-    {
-      putreg32(DPORT_CPU_INTR_FROM_CPU_1, DPORT_CPU_INTR_FROM_CPU_1_REG);
-    }
+  /* Publish the entry only after it has been written */
+
+  CPUCALL_MEMW();
+  mbox->head = head + 1;
+  CPUCALL_MEMW();
+
+  /* Interrupt the other CPU.  If an interrupt is already pending, it will
+   * also execute this call.
+   */
 
+  esp32_raise_intercpu(fromcpu);
+  up_irq_restore(flags);
   return OK;
 }
 
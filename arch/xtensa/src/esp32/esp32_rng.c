@@ -0,0 +1,144 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_rng.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/random.h>
+#include <nuttx/wqueue.h>
+#include <arch/xtensa/xtensa_specregs.h>
+
+#include "xtensa.h"
+#include "xtensa_timer.h"
+#include "chip/esp32_soc.h"
+#include "esp32_rng.h"
+
+#ifdef CONFIG_ESP32_RNG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Feed from the low priority work queue if there is one */
+
+#ifdef CONFIG_SCHED_LPWORK
+#  define RNGWORK LPWORK
+#else
+#  define RNGWORK HPWORK
+#endif
+
+#define RNG_PERIOD   MSEC2TICK(CONFIG_ESP32_RNG_PERIOD)
+#define RNG_NSEED    (4 * CONFIG_ESP32_RNG_NWORDS)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct work_s g_rngwork;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_rng_feed
+ *
+ * Description:
+ *   Read words from the generator and add them to the entropy pool.
+ *
+ ****************************************************************************/
+
+static void esp32_rng_feed(int nwords)
+{
+  uint32_t buf[RNG_NSEED];
+  int i;
+
+  for (i = 0; i < nwords; i++)
+    {
+      /* Mix in the cycle counter too; the generator only advances every
+       * few APB cycles so back-to-back reads are also decorrelated by it.
+       */
+
+      buf[i] = getreg32(WDEV_RND_REG) ^ xtensa_getcount();
+    }
+
+  up_rngaddentropy(RND_SRC_HW, buf, nwords);
+}
+
+/****************************************************************************
+ * Name: esp32_rng_worker
+ *
+ * Description:
+ *   Periodic work queue feed.
+ *
+ ****************************************************************************/
+
+static void esp32_rng_worker(FAR void *arg)
+{
+  esp32_rng_feed(CONFIG_ESP32_RNG_NWORDS);
+  (void)work_queue(RNGWORK, &g_rngwork, esp32_rng_worker, NULL, RNG_PERIOD);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_rng_initialize
+ *
+ * Description:
+ *   Seed the entropy pool from the hardware random number generator and
+ *   start feeding it periodically from the work queue.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int esp32_rng_initialize(void)
+{
+  esp32_rng_feed(RNG_NSEED);
+  return work_queue(RNGWORK, &g_rngwork, esp32_rng_worker, NULL, RNG_PERIOD);
+}
+
+#endif /* CONFIG_ESP32_RNG */
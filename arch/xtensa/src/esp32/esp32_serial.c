@@ -64,6 +64,11 @@
 #include "chip/esp32_iomux.h"
 #include "chip/esp32_gpio_sigmap.h"
 #include "chip/esp32_uart.h"
+#ifdef CONFIG_ESP32_UHCI
+#  include "chip/esp32_dma.h"
+#  include "chip/esp32_dport.h"
+#  include "chip/esp32_uhci.h"
+#endif
 #include "rom/esp32_gpio.h"
 #include "esp32_config.h"
 #include "esp32_gpio.h"
@@ -137,6 +142,22 @@
 
 #define UART_CLK_FREQ         APB_CLK_FREQ
 
+/* UHCI DMA.  The Rx inlink requires word aligned buffers so received data
+ * is collected in a small ring of bounce buffers and then copied into the
+ * serial driver's Rx buffer.
+ */
+
+#ifdef CONFIG_ESP32_UHCI
+#  if (CONFIG_ESP32_UHCI_RXDESCSIZE & 3) != 0
+#    error CONFIG_ESP32_UHCI_RXDESCSIZE must be a multiple of 4
+#  endif
+
+#  define UHCI_NRXDESC        4
+#  define UHCI_RXINTS         (UHCI_IN_DONE_INT | UHCI_IN_SUC_EOF_INT | \
+                               UHCI_IN_DSCR_ERR_INT)
+#  define UHCI_TXINTS         UHCI_OUT_TOTAL_EOF_INT
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -161,6 +182,28 @@ struct esp32_config_s
 #endif
 };
 
+#ifdef CONFIG_ESP32_UHCI
+/* UHCI DMA controller bound to a UART */
+
+struct esp32_uhci_s
+{
+  const uint32_t uhcibase;      /* Base address of UHCI registers */
+  const uint32_t dportbit;      /* DPORT clock enable and reset bit */
+  const uint32_t uartce;        /* CONF0 bit connecting the UART */
+  const uint8_t periph;         /* UHCI peripheral ID */
+  const uint8_t irq;            /* IRQ number assigned to the UHCI */
+  bool     txbusy;              /* Tx DMA in progress */
+  bool     rxenable;            /* Rx interrupts enabled */
+  bool     rxstall;             /* Inlink stopped on a CPU-owned descriptor */
+  uint8_t  rxhead;              /* Oldest Rx descriptor not yet consumed */
+  uint16_t rxoffset;            /* Bytes already taken from rxdesc[rxhead] */
+  size_t   txlen;               /* Bytes in the Tx DMA in progress */
+  struct esp32_dmadesc_s txdesc[2];
+  struct esp32_dmadesc_s rxdesc[UHCI_NRXDESC];
+  uint32_t rxbuf[UHCI_NRXDESC][CONFIG_ESP32_UHCI_RXDESCSIZE / 4];
+};
+#endif
+
 /* Current state of the UART */
 
 struct esp32_dev_s
@@ -175,6 +218,9 @@ struct esp32_dev_s
 #if defined(CONFIG_SERIAL_IFLOWCONTROL) || defined(CONFIG_SERIAL_OFLOWCONTROL)
   bool     flowc;               /* Input flow control (RTS) enabled */
 #endif
+#ifdef CONFIG_ESP32_UHCI
+  struct esp32_uhci_s *uhci;    /* UHCI DMA state, NULL if not used */
+#endif
 };
 
 /****************************************************************************
@@ -195,6 +241,16 @@ static void esp32_txint(struct uart_dev_s *dev, bool enable);
 static bool esp32_txready(struct uart_dev_s *dev);
 static bool esp32_txempty(struct uart_dev_s *dev);
 
+#ifdef CONFIG_ESP32_UHCI
+static int  esp32_uhci_interrupt(int cpuint, void *context, FAR void *arg);
+static void esp32_uhci_rxint(struct uart_dev_s *dev, bool enable);
+static void esp32_uhci_txint(struct uart_dev_s *dev, bool enable);
+static void esp32_dmasend(struct uart_dev_s *dev);
+static void esp32_dmareceive(struct uart_dev_s *dev);
+static void esp32_dmarxfree(struct uart_dev_s *dev);
+static void esp32_dmatxavail(struct uart_dev_s *dev);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -218,6 +274,31 @@ static const struct uart_ops_s g_uart_ops =
   .txempty        = esp32_txempty,
 };
 
+#ifdef CONFIG_ESP32_UHCI
+static const struct uart_ops_s g_uart_dma_ops =
+{
+  .setup          = esp32_setup,
+  .shutdown       = esp32_shutdown,
+  .attach         = esp32_attach,
+  .detach         = esp32_detach,
+  .ioctl          = esp32_ioctl,
+  .receive        = esp32_receive,
+  .rxint          = esp32_uhci_rxint,
+  .rxavailable    = esp32_rxavailable,
+#ifdef CONFIG_SERIAL_IFLOWCONTROL
+  .rxflowcontrol  = NULL,
+#endif
+  .dmasend        = esp32_dmasend,
+  .dmareceive     = esp32_dmareceive,
+  .dmarxfree      = esp32_dmarxfree,
+  .dmatxavail     = esp32_dmatxavail,
+  .send           = esp32_send,
+  .txint          = esp32_uhci_txint,
+  .txready        = esp32_txready,
+  .txempty        = esp32_txempty,
+};
+#endif
+
 /* I/O buffers */
 
 #ifdef CONFIG_ESP32_UART0
@@ -299,6 +380,17 @@ static const struct esp32_config_s g_uart1config =
 #endif
 };
 
+#ifdef CONFIG_ESP32_UART1_UHCI
+static struct esp32_uhci_s g_uhci0 =
+{
+  .uhcibase       = DR_REG_UHCI0_BASE,
+  .dportbit       = DPORT_UHCI0_CLK_EN,
+  .uartce         = UHCI_UART1_CE,
+  .periph         = ESP32_PERIPH_UHCI0,
+  .irq            = ESP32_IRQ_UHCI0,
+};
+#endif
+
 static struct esp32_dev_s g_uart1priv =
 {
   .config         = &g_uart1config,
@@ -306,6 +398,9 @@ static struct esp32_dev_s g_uart1priv =
   .parity         = CONFIG_UART1_PARITY,
   .bits           = CONFIG_UART1_BITS,
   .stopbits2      = CONFIG_UART1_2STOP,
+#ifdef CONFIG_ESP32_UART1_UHCI
+  .uhci           = &g_uhci0,
+#endif
 };
 
 static uart_dev_t g_uart1port =
@@ -320,7 +415,11 @@ static uart_dev_t g_uart1port =
     .size   = CONFIG_UART1_TXBUFSIZE,
     .buffer = g_uart1txbuffer,
   },
+#ifdef CONFIG_ESP32_UART1_UHCI
+  .ops      = &g_uart_dma_ops,
+#else
   .ops      = &g_uart_ops,
+#endif
   .priv     = &g_uart1priv,
 };
 #endif
@@ -345,6 +444,17 @@ static const struct esp32_config_s g_uart2config =
 #endif
 };
 
+#ifdef CONFIG_ESP32_UART2_UHCI
+static struct esp32_uhci_s g_uhci1 =
+{
+  .uhcibase       = DR_REG_UHCI1_BASE,
+  .dportbit       = DPORT_UHCI1_CLK_EN,
+  .uartce         = UHCI_UART2_CE,
+  .periph         = ESP32_PERIPH_UHCI1,
+  .irq            = ESP32_IRQ_UHCI1,
+};
+#endif
+
 static struct esp32_dev_s g_uart2priv =
 {
   .config         = &g_uart2config,
@@ -352,6 +462,9 @@ static struct esp32_dev_s g_uart2priv =
   .parity         = CONFIG_UART2_PARITY,
   .bits           = CONFIG_UART2_BITS,
   .stopbits2      = CONFIG_UART2_2STOP,
+#ifdef CONFIG_ESP32_UART2_UHCI
+  .uhci           = &g_uhci1,
+#endif
 };
 
 static uart_dev_t g_uart2port =
@@ -366,7 +479,11 @@ static uart_dev_t g_uart2port =
     .size   = CONFIG_UART2_TXBUFSIZE,
     .buffer = g_uart2txbuffer,
   },
+#ifdef CONFIG_ESP32_UART2_UHCI
+  .ops      = &g_uart_dma_ops,
+#else
   .ops      = &g_uart_ops,
+#endif
   .priv     = &g_uart2priv,
 };
 #endif
@@ -431,6 +548,219 @@ static void esp32_disableallints(struct esp32_dev_s *priv, uint32_t *intena)
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Name: esp32_uhciin
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static inline uint32_t esp32_uhciin(struct esp32_uhci_s *uhci, int offset)
+{
+  return getreg32(uhci->uhcibase + offset);
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_uhciout
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static inline void esp32_uhciout(struct esp32_uhci_s *uhci, int offset,
+                                 uint32_t value)
+{
+  putreg32(value, uhci->uhcibase + offset);
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_uhci_rxstart
+ *
+ * Description:
+ *   Give all Rx descriptors to the DMA and (re-)start the inlink at the
+ *   oldest one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_uhci_rxstart(struct esp32_uhci_s *uhci)
+{
+  struct esp32_dmadesc_s *desc;
+  int i;
+
+  for (i = 0; i < UHCI_NRXDESC; i++)
+    {
+      desc       = &uhci->rxdesc[i];
+      desc->ctrl = (CONFIG_ESP32_UHCI_RXDESCSIZE << DMADESC_SIZE_S) |
+                   DMADESC_OWNER_DMA;
+      desc->buf  = (uintptr_t)uhci->rxbuf[i];
+      desc->next = (uintptr_t)&uhci->rxdesc[(i + 1) % UHCI_NRXDESC];
+    }
+
+  uhci->rxoffset = 0;
+  uhci->rxstall  = false;
+
+  esp32_uhciout(uhci, UHCI_DMA_IN_LINK_OFFSET,
+                ((uintptr_t)&uhci->rxdesc[uhci->rxhead] &
+                 UHCI_INLINK_ADDR_M) | UHCI_INLINK_START);
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_uhci_setup
+ *
+ * Description:
+ *   Enable the UHCI bound to the UART, connect it to the UART and start
+ *   the Rx inlink.  Received frames are terminated when the Rx line is
+ *   idle; no separators, headers or escapes are used.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_uhci_setup(struct esp32_dev_s *priv)
+{
+  struct esp32_uhci_s *uhci = priv->uhci;
+
+  /* Enable the UHCI clock and take it out of reset */
+
+  modifyreg32(DPORT_PERIP_CLK_EN_REG, 0, uhci->dportbit);
+  modifyreg32(DPORT_PERIP_RST_EN_REG, uhci->dportbit, 0);
+
+  /* Reset the DMA state machines and FIFOs */
+
+  esp32_uhciout(uhci, UHCI_CONF0_OFFSET,
+                UHCI_IN_RST | UHCI_OUT_RST | UHCI_AHBM_FIFO_RST |
+                UHCI_AHBM_RST);
+  esp32_uhciout(uhci, UHCI_CONF0_OFFSET, 0);
+
+  /* Raw byte stream: end Rx frames on line idle only */
+
+  esp32_uhciout(uhci, UHCI_CONF0_OFFSET,
+                uhci->uartce | UHCI_CLK_EN | UHCI_UART_IDLE_EOF_EN);
+  esp32_uhciout(uhci, UHCI_CONF1_OFFSET,
+                UHCI_CRC_DISABLE | UHCI_CHECK_OWNER);
+  esp32_uhciout(uhci, UHCI_ESCAPE_CONF_OFFSET, 0);
+
+  /* Idle threshold for Rx frames, no idle inserted between Tx frames */
+
+  esp32_serialout(priv, UART_IDLE_CONF_OFFSET,
+                  CONFIG_ESP32_UHCI_RXIDLE << UART_RX_IDLE_THRHD_S);
+
+  esp32_uhciout(uhci, UHCI_INT_CLR_OFFSET, 0xffffffff);
+
+  uhci->txbusy = false;
+  uhci->rxhead = 0;
+  esp32_uhci_rxstart(uhci);
+
+  esp32_uhciout(uhci, UHCI_INT_ENA_OFFSET,
+                UHCI_TXINTS | (uhci->rxenable ? UHCI_RXINTS : 0));
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_uhci_shutdown
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_uhci_shutdown(struct esp32_dev_s *priv)
+{
+  struct esp32_uhci_s *uhci = priv->uhci;
+
+  esp32_uhciout(uhci, UHCI_INT_ENA_OFFSET, 0);
+  esp32_uhciout(uhci, UHCI_DMA_OUT_LINK_OFFSET, UHCI_OUTLINK_STOP);
+  esp32_uhciout(uhci, UHCI_DMA_IN_LINK_OFFSET, UHCI_INLINK_STOP);
+  esp32_uhciout(uhci, UHCI_CONF0_OFFSET, 0);
+  esp32_uhciout(uhci, UHCI_INT_CLR_OFFSET, 0xffffffff);
+
+  uhci->txbusy = false;
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_uhci_rxdrain
+ *
+ * Description:
+ *   Copy completed Rx descriptors into the serial Rx buffer and give them
+ *   back to the DMA.  Stops early, keeping the remainder of the current
+ *   descriptor, if the Rx buffer fills up.  Restarts a stalled inlink once
+ *   every descriptor has been returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_uhci_rxdrain(struct uart_dev_s *dev)
+{
+  struct esp32_dev_s *priv = (struct esp32_dev_s *)dev->priv;
+  struct esp32_uhci_s *uhci = priv->uhci;
+  struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  struct esp32_dmadesc_s *desc;
+  const uint8_t *src;
+  size_t navail;
+  size_t nbytes;
+  size_t ncopy;
+
+  for (; ; )
+    {
+      desc = &uhci->rxdesc[uhci->rxhead];
+      if ((desc->ctrl & DMADESC_OWNER_DMA) != 0)
+        {
+          /* Still being filled.  Everything older has been consumed so a
+           * stalled inlink can resume here.
+           */
+
+          if (uhci->rxstall)
+            {
+              esp32_uhci_rxstart(uhci);
+            }
+
+          break;
+        }
+
+      src    = (const uint8_t *)uhci->rxbuf[uhci->rxhead] + uhci->rxoffset;
+      navail = ((desc->ctrl & DMADESC_LENGTH_M) >> DMADESC_LENGTH_S) -
+               uhci->rxoffset;
+
+      /* Let the upper half describe the free space in the Rx buffer */
+
+      xfer->length  = 0;
+      xfer->nlength = 0;
+      uart_recvchars_dma(dev);
+
+      ncopy = navail < xfer->length ? navail : xfer->length;
+      memcpy(xfer->buffer, src, ncopy);
+      nbytes = ncopy;
+
+      if (nbytes < navail && xfer->nlength > 0)
+        {
+          ncopy = navail - nbytes;
+          if (ncopy > xfer->nlength)
+            {
+              ncopy = xfer->nlength;
+            }
+
+          memcpy(xfer->nbuffer, src + nbytes, ncopy);
+          nbytes += ncopy;
+        }
+
+      xfer->nbytes = nbytes;
+      uart_recvchars_done(dev);
+
+      if (nbytes < navail)
+        {
+          /* The Rx buffer is full.  Resume when space is freed. */
+
+          uhci->rxoffset += nbytes;
+          break;
+        }
+
+      /* Return the descriptor to the DMA */
+
+      desc->ctrl     = (CONFIG_ESP32_UHCI_RXDESCSIZE << DMADESC_SIZE_S) |
+                       DMADESC_OWNER_DMA;
+      uhci->rxoffset = 0;
+      uhci->rxhead   = (uhci->rxhead + 1) % UHCI_NRXDESC;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: esp32_setup
  *
@@ -555,6 +885,16 @@ static int esp32_setup(struct uart_dev_s *dev)
            (0x02 << UART_RX_TOUT_THRHD_S) |
             UART_RX_TOUT_EN;
   esp32_serialout(priv, UART_CONF1_OFFSET, regval);
+
+#ifdef CONFIG_ESP32_UHCI
+  if (priv->uhci != NULL)
+    {
+      /* Data moves through the UHCI, not the UART interrupt */
+
+      esp32_serialout(priv, UART_INT_ENA_OFFSET, 0);
+      esp32_uhci_setup(priv);
+    }
+#endif
 #endif
 
   return OK;
@@ -614,6 +954,13 @@ static void esp32_shutdown(struct uart_dev_s *dev)
 
   esp32_serialout(priv, UART_INT_ENA_OFFSET, 0);
   esp32_serialout(priv, UART_INT_CLR_OFFSET, 0xffffffff);
+
+#ifdef CONFIG_ESP32_UHCI
+  if (priv->uhci != NULL)
+    {
+      esp32_uhci_shutdown(priv);
+    }
+#endif
 }
 
 /****************************************************************************
@@ -634,9 +981,23 @@ static void esp32_shutdown(struct uart_dev_s *dev)
 static int esp32_attach(struct uart_dev_s *dev)
 {
   struct esp32_dev_s *priv = (struct esp32_dev_s *)dev->priv;
+  xcpt_t handler = esp32_interrupt;
+  uint8_t periph = priv->config->periph;
+  uint8_t irq = priv->config->irq;
   int cpu;
   int ret = OK;
 
+#ifdef CONFIG_ESP32_UHCI
+  /* DMA ports are interrupt driven by the UHCI, not the UART */
+
+  if (priv->uhci != NULL)
+    {
+      handler = esp32_uhci_interrupt;
+      periph  = priv->uhci->periph;
+      irq     = priv->uhci->irq;
+    }
+#endif
+
   /* Allocate a level-sensitive, priority 1 CPU interrupt for the UART */
 
   priv->cpuint = esp32_alloc_levelint(1);
@@ -658,11 +1019,11 @@ static int esp32_attach(struct uart_dev_s *dev)
   /* Attach the GPIO peripheral to the allocated CPU interrupt */
 
   up_disable_irq(priv->cpuint);
-  esp32_attach_peripheral(cpu, priv->config->periph, priv->cpuint);
+  esp32_attach_peripheral(cpu, periph, priv->cpuint);
 
   /* Attach and enable the IRQ */
 
-  ret = irq_attach(priv->config->irq, esp32_interrupt, dev);
+  ret = irq_attach(irq, handler, dev);
   if (ret == OK)
     {
       /* Enable the CPU interrupt (RX and TX interrupts are still disabled
@@ -688,12 +1049,22 @@ static int esp32_attach(struct uart_dev_s *dev)
 static void esp32_detach(struct uart_dev_s *dev)
 {
   struct esp32_dev_s *priv = (struct esp32_dev_s *)dev->priv;
+  uint8_t periph = priv->config->periph;
+  uint8_t irq = priv->config->irq;
   int cpu;
 
+#ifdef CONFIG_ESP32_UHCI
+  if (priv->uhci != NULL)
+    {
+      periph = priv->uhci->periph;
+      irq    = priv->uhci->irq;
+    }
+#endif
+
   /* Disable and detach the CPU interrupt */
 
   up_disable_irq(priv->cpuint);
-  irq_detach(priv->config->irq);
+  irq_detach(irq);
 
   /* Disassociate the peripheral interrupt from the CPU interrupt */
 
@@ -703,7 +1074,7 @@ static void esp32_detach(struct uart_dev_s *dev)
   cpu = 0;
 #endif
 
-  esp32_detach_peripheral(cpu, priv->config->periph, priv->cpuint);
+  esp32_detach_peripheral(cpu, periph, priv->cpuint);
 
   /* And release the CPU interrupt */
 
@@ -794,6 +1165,60 @@ static int esp32_interrupt(int cpuint, void *context, FAR void *arg)
   return OK;
 }
 
+/****************************************************************************
+ * Name: esp32_uhci_interrupt
+ *
+ * Description:
+ *   UHCI interrupt handler for UARTs using DMA.  Rx descriptors complete
+ *   when they fill up or when the Rx line goes idle; Tx completes when the
+ *   whole outlink has been sent.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static int esp32_uhci_interrupt(int cpuint, void *context, FAR void *arg)
+{
+  struct uart_dev_s *dev = (struct uart_dev_s *)arg;
+  struct esp32_dev_s *priv;
+  struct esp32_uhci_s *uhci;
+  uint32_t status;
+
+  DEBUGASSERT(dev != NULL && dev->priv != NULL);
+  priv = (struct esp32_dev_s *)dev->priv;
+  uhci = priv->uhci;
+
+  status = esp32_uhciin(uhci, UHCI_INT_ST_OFFSET);
+  esp32_uhciout(uhci, UHCI_INT_CLR_OFFSET, status);
+
+  if ((status & UHCI_IN_DSCR_ERR_INT) != 0)
+    {
+      /* The inlink ran into a descriptor that has not been consumed yet */
+
+      uhci->rxstall = true;
+    }
+
+  if ((status & UHCI_RXINTS) != 0)
+    {
+      esp32_uhci_rxdrain(dev);
+    }
+
+  if ((status & UHCI_OUT_TOTAL_EOF_INT) != 0 && uhci->txbusy)
+    {
+      /* Release the sent bytes and start on whatever has been queued
+       * meanwhile.
+       */
+
+      dev->dmatx.nbytes = uhci->txlen;
+      uhci->txbusy      = false;
+
+      uart_xmitchars_done(dev);
+      uart_xmitchars_dma(dev);
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: esp32_ioctl
  *
@@ -1167,6 +1592,175 @@ static bool esp32_txempty(struct uart_dev_s *dev)
   return ((esp32_serialin(priv, UART_STATUS_OFFSET) & UART_TXFIFO_CNT_M) > 0);
 }
 
+/****************************************************************************
+ * Name: esp32_uhci_rxint
+ *
+ * Description:
+ *   Call to enable or disable the UHCI Rx interrupts
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_uhci_rxint(struct uart_dev_s *dev, bool enable)
+{
+  struct esp32_dev_s *priv = (struct esp32_dev_s *)dev->priv;
+  struct esp32_uhci_s *uhci = priv->uhci;
+  irqstate_t flags;
+  uint32_t regval;
+
+  flags = enter_critical_section();
+
+  uhci->rxenable = enable;
+  regval = esp32_uhciin(uhci, UHCI_INT_ENA_OFFSET);
+
+  if (enable)
+    {
+#ifndef CONFIG_SUPPRESS_SERIAL_INTS
+      esp32_uhciout(uhci, UHCI_INT_ENA_OFFSET, regval | UHCI_RXINTS);
+
+      /* Pick up anything that completed while Rx interrupts were off */
+
+      esp32_uhci_rxdrain(dev);
+#endif
+    }
+  else
+    {
+      esp32_uhciout(uhci, UHCI_INT_ENA_OFFSET, regval & ~UHCI_RXINTS);
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_uhci_txint
+ *
+ * Description:
+ *   Tx completion is always reported by the UHCI, nothing to do here.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_uhci_txint(struct uart_dev_s *dev, bool enable)
+{
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_dmasend
+ *
+ * Description:
+ *   Start the outlink on the region(s) of the Tx buffer described by
+ *   dev->dmatx.  Each descriptor holds at most DMADESC_MAXSIZE bytes; any
+ *   excess is sent by the next transfer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_dmasend(struct uart_dev_s *dev)
+{
+  struct esp32_dev_s *priv = (struct esp32_dev_s *)dev->priv;
+  struct esp32_uhci_s *uhci = priv->uhci;
+  struct uart_dmaxfer_s *xfer = &dev->dmatx;
+  struct esp32_dmadesc_s *desc = &uhci->txdesc[0];
+  size_t length = xfer->length;
+  size_t nlength = xfer->nlength;
+
+  if (length > DMADESC_MAXSIZE)
+    {
+      length  = DMADESC_MAXSIZE;
+      nlength = 0;
+    }
+  else if (nlength > DMADESC_MAXSIZE)
+    {
+      nlength = DMADESC_MAXSIZE;
+    }
+
+  desc->ctrl = (length << DMADESC_SIZE_S) | (length << DMADESC_LENGTH_S) |
+               DMADESC_OWNER_DMA;
+  desc->buf  = (uintptr_t)xfer->buffer;
+  desc->next = 0;
+
+  if (nlength > 0)
+    {
+      desc->next = (uintptr_t)&uhci->txdesc[1];
+      desc       = &uhci->txdesc[1];
+      desc->ctrl = (nlength << DMADESC_SIZE_S) |
+                   (nlength << DMADESC_LENGTH_S) | DMADESC_OWNER_DMA;
+      desc->buf  = (uintptr_t)xfer->nbuffer;
+      desc->next = 0;
+    }
+
+  desc->ctrl  |= DMADESC_EOF;
+  uhci->txlen  = length + nlength;
+  uhci->txbusy = true;
+
+  esp32_uhciout(uhci, UHCI_DMA_OUT_LINK_OFFSET,
+                ((uintptr_t)&uhci->txdesc[0] & UHCI_OUTLINK_ADDR_M) |
+                UHCI_OUTLINK_START);
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_dmareceive
+ *
+ * Description:
+ *   The inlink runs continuously into the bounce buffers; data is copied
+ *   into the region described by dev->dmarx by esp32_uhci_rxdrain().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_dmareceive(struct uart_dev_s *dev)
+{
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_dmarxfree
+ *
+ * Description:
+ *   Space was freed in the Rx buffer.  Move over any data held back in the
+ *   bounce buffers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_dmarxfree(struct uart_dev_s *dev)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  esp32_uhci_rxdrain(dev);
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_dmatxavail
+ *
+ * Description:
+ *   Data was added to the Tx buffer.  Start a transfer unless one is
+ *   already in progress; its completion will pick up the new data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_UHCI
+static void esp32_dmatxavail(struct uart_dev_s *dev)
+{
+  struct esp32_dev_s *priv = (struct esp32_dev_s *)dev->priv;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!priv->uhci->txbusy)
+    {
+      uart_xmitchars_dma(dev);
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
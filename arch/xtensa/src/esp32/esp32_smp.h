@@ -82,5 +82,21 @@ extern uint32_t g_cpu1_idlestack[CPU1_IDLETHREAD_STACKWORDS];
 int esp32_fromcpu0_interrupt(int irq, FAR void *context, FAR void *arg);
 int esp32_fromcpu1_interrupt(int irq, FAR void *context, FAR void *arg);
 
+/****************************************************************************
+ * Name: esp32_tickless_syncpro, esp32_tickless_syncapp, and
+ *       esp32_tickless_appinit
+ *
+ * Description:
+ *   Synchronize the CCOUNT of the APP CPU with the PRO CPU during start-up
+ *   of the APP CPU and enable the tickless alarm on the APP CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+void esp32_tickless_syncpro(void);
+void esp32_tickless_syncapp(void);
+void esp32_tickless_appinit(void);
+#endif
+
 #endif /* CONFIG_SMP */
 #endif /* __ARCH_XTENSA_SRC_ESP32_ESP32_SMP_H */
@@ -0,0 +1,1102 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_spi.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spi/spi.h>
+
+#include <arch/board/board.h>
+
+#include "xtensa.h"
+#include "chip/esp32_soc.h"
+#include "chip/esp32_dport.h"
+#include "chip/esp32_dma.h"
+#include "chip/esp32_spi.h"
+#include "chip/esp32_gpio_sigmap.h"
+#include "rom/esp32_gpio.h"
+#include "esp32_gpio.h"
+#include "esp32_cpuint.h"
+#include "esp32_spi.h"
+
+#ifdef CONFIG_ESP32_SPI
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* SPI source clock */
+
+#define SPI_CLK_FREQ          (APB_CLK_FREQ)
+
+/* DMA.  Rx buffers must be word aligned and are written in whole words.
+ * The Tx data of receive-only exchanges comes from a small buffer of 0xff
+ * bytes that every Tx descriptor points at.
+ */
+
+#ifdef CONFIG_ESP32_SPI_DMA
+#  define SPI_NDESC           CONFIG_ESP32_SPI_DMADESC
+#  define SPI_DUMMYSIZE       256
+#  define SPI_ALIGNED(p)      (((uintptr_t)(p) & 3) == 0)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Constant properties of an SPI bus */
+
+struct esp32_spiconfig_s
+{
+  uint32_t spibase;             /* Base address of SPI registers */
+  uint32_t clkbit;              /* DPORT clock enable and reset bit */
+  uint8_t  periph;              /* SPI peripheral ID */
+  uint8_t  irq;                 /* IRQ number assigned to the peripheral */
+  uint8_t  sckpin;              /* SCK pin number (0-39) */
+  uint8_t  mosipin;             /* MOSI pin number (0-39) */
+  uint8_t  misopin;             /* MISO pin number (0-39) */
+  uint8_t  scksig;              /* SCK output signal */
+  uint8_t  mosisig;             /* MOSI output signal */
+  uint8_t  misosig;             /* MISO input signal */
+#ifdef CONFIG_ESP32_SPI_DMA
+  uint8_t  dmachan;             /* DMA channel (1 or 2) */
+  uint8_t  dmaselshift;         /* Position in DPORT_SPI_DMA_CHAN_SEL_REG */
+#endif
+};
+
+/* Current state of an SPI bus */
+
+struct esp32_spidev_s
+{
+  struct spi_dev_s spidev;      /* Externally visible part of the SPI interface */
+  const struct esp32_spiconfig_s *config; /* Constant configuration */
+  sem_t    exclsem;             /* Held while chip is selected for mutual exclusion */
+  uint32_t frequency;           /* Requested clock frequency */
+  uint32_t actual;              /* Actual clock frequency */
+  uint32_t ckedge;              /* SPI_USER clock edge bit of the mode */
+  uint8_t  nbits;               /* Width of word in bits (8 or 16) */
+  uint8_t  mode;                /* Mode 0,1,2,3 */
+  uint8_t  cpuint;              /* CPU interrupt assigned to this bus */
+#ifdef CONFIG_ESP32_SPI_DMA
+  sem_t    dmasem;              /* Wait for the whole DMA exchange */
+  FAR const uint8_t *txbuffer;  /* Next Tx data, NULL: send 0xff */
+  FAR uint8_t *rxbuffer;        /* Next Rx location, NULL: discard */
+  size_t   nbytes;              /* Bytes remaining, including seglen */
+  size_t   seglen;              /* Bytes in the transaction in progress */
+  struct esp32_dmadesc_s txdesc[SPI_NDESC];
+  struct esp32_dmadesc_s rxdesc[SPI_NDESC];
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* SPI methods */
+
+static int      spi_lock(FAR struct spi_dev_s *dev, bool lock);
+static uint32_t spi_setfrequency(FAR struct spi_dev_s *dev,
+                                 uint32_t frequency);
+static void     spi_setmode(FAR struct spi_dev_s *dev, enum spi_mode_e mode);
+static void     spi_setbits(FAR struct spi_dev_s *dev, int nbits);
+static uint16_t spi_send(FAR struct spi_dev_s *dev, uint16_t wd);
+static void     spi_exchange(FAR struct spi_dev_s *dev,
+                             FAR const void *txbuffer, FAR void *rxbuffer,
+                             size_t nwords);
+#ifndef CONFIG_SPI_EXCHANGE
+static void     spi_sndblock(FAR struct spi_dev_s *dev,
+                             FAR const void *txbuffer, size_t nwords);
+static void     spi_recvblock(FAR struct spi_dev_s *dev,
+                              FAR void *rxbuffer, size_t nwords);
+#endif
+
+/* Interrupt handling */
+
+#ifdef CONFIG_ESP32_SPI_DMA
+static int      spi_interrupt(int irq, FAR void *context, FAR void *arg);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_SPI_DMA
+/* Tx data for receive-only DMA exchanges */
+
+static uint32_t g_spi_txdummy[SPI_DUMMYSIZE / 4];
+#endif
+
+#ifdef CONFIG_ESP32_SPI2
+static const struct spi_ops_s g_spi2ops =
+{
+  .lock              = spi_lock,
+  .select            = esp32_spi2select,
+  .setfrequency      = spi_setfrequency,
+  .setmode           = spi_setmode,
+  .setbits           = spi_setbits,
+#ifdef CONFIG_SPI_HWFEATURES
+  .hwfeatures        = 0,                 /* Not supported */
+#endif
+  .status            = esp32_spi2status,
+#ifdef CONFIG_SPI_CMDDATA
+  .cmddata           = esp32_spi2cmddata,
+#endif
+  .send              = spi_send,
+#ifdef CONFIG_SPI_EXCHANGE
+  .exchange          = spi_exchange,
+#else
+  .sndblock          = spi_sndblock,
+  .recvblock         = spi_recvblock,
+#endif
+  .registercallback  = 0,                 /* Not implemented */
+};
+
+static const struct esp32_spiconfig_s g_spi2config =
+{
+  .spibase           = DR_REG_SPI2_BASE,
+  .clkbit            = DPORT_SPI_CLK_EN_2,
+  .periph            = ESP32_PERIPH_SPI2,
+  .irq               = ESP32_IRQ_SPI2,
+  .sckpin            = CONFIG_ESP32_SPI2_SCKPIN,
+  .mosipin           = CONFIG_ESP32_SPI2_MOSIPIN,
+  .misopin           = CONFIG_ESP32_SPI2_MISOPIN,
+  .scksig            = HSPICLK_OUT_IDX,
+  .mosisig           = HSPID_OUT_IDX,
+  .misosig           = HSPIQ_IN_IDX,
+#ifdef CONFIG_ESP32_SPI_DMA
+  .dmachan           = 1,
+  .dmaselshift       = DPORT_SPI2_DMA_CHAN_SEL_S,
+#endif
+};
+
+static struct esp32_spidev_s g_spi2dev =
+{
+  .spidev            = { &g_spi2ops },
+  .config            = &g_spi2config,
+};
+#endif
+
+#ifdef CONFIG_ESP32_SPI3
+static const struct spi_ops_s g_spi3ops =
+{
+  .lock              = spi_lock,
+  .select            = esp32_spi3select,
+  .setfrequency      = spi_setfrequency,
+  .setmode           = spi_setmode,
+  .setbits           = spi_setbits,
+#ifdef CONFIG_SPI_HWFEATURES
+  .hwfeatures        = 0,                 /* Not supported */
+#endif
+  .status            = esp32_spi3status,
+#ifdef CONFIG_SPI_CMDDATA
+  .cmddata           = esp32_spi3cmddata,
+#endif
+  .send              = spi_send,
+#ifdef CONFIG_SPI_EXCHANGE
+  .exchange          = spi_exchange,
+#else
+  .sndblock          = spi_sndblock,
+  .recvblock         = spi_recvblock,
+#endif
+  .registercallback  = 0,                 /* Not implemented */
+};
+
+static const struct esp32_spiconfig_s g_spi3config =
+{
+  .spibase           = DR_REG_SPI3_BASE,
+  .clkbit            = DPORT_SPI_CLK_EN,
+  .periph            = ESP32_PERIPH_SPI3,
+  .irq               = ESP32_IRQ_SPI3,
+  .sckpin            = CONFIG_ESP32_SPI3_SCKPIN,
+  .mosipin           = CONFIG_ESP32_SPI3_MOSIPIN,
+  .misopin           = CONFIG_ESP32_SPI3_MISOPIN,
+  .scksig            = VSPICLK_OUT_MUX_IDX,
+  .mosisig           = VSPID_OUT_IDX,
+  .misosig           = VSPIQ_IN_IDX,
+#ifdef CONFIG_ESP32_SPI_DMA
+  .dmachan           = 2,
+  .dmaselshift       = DPORT_SPI3_DMA_CHAN_SEL_S,
+#endif
+};
+
+static struct esp32_spidev_s g_spi3dev =
+{
+  .spidev            = { &g_spi3ops },
+  .config            = &g_spi3config,
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_getreg
+ ****************************************************************************/
+
+static inline uint32_t spi_getreg(FAR struct esp32_spidev_s *priv,
+                                  int offset)
+{
+  return getreg32(priv->config->spibase + offset);
+}
+
+/****************************************************************************
+ * Name: spi_putreg
+ ****************************************************************************/
+
+static inline void spi_putreg(FAR struct esp32_spidev_s *priv, int offset,
+                              uint32_t value)
+{
+  putreg32(value, priv->config->spibase + offset);
+}
+
+/****************************************************************************
+ * Name: spi_lock
+ *
+ * Description:
+ *   On SPI busses where there are multiple devices, it will be necessary to
+ *   lock SPI to have exclusive access to the busses for a sequence of
+ *   transfers.  The bus should be locked before the chip is selected. After
+ *   locking the SPI bus, the caller should then also call the setfrequency,
+ *   setbits, and setmode methods to make sure that the SPI is properly
+ *   configured for the device.  If the SPI buss is being shared, then it
+ *   may have been left in an incompatible state.
+ *
+ * Input Parameters:
+ *   dev  - Device-specific state data
+ *   lock - true: Lock spi bus, false: unlock SPI bus
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static int spi_lock(FAR struct spi_dev_s *dev, bool lock)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)dev;
+  int ret;
+
+  if (lock)
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      do
+        {
+          ret = nxsem_wait(&priv->exclsem);
+
+          /* The only case that an error should occur here is if the wait
+           * was awakened by a signal.
+           */
+
+          DEBUGASSERT(ret == OK || ret == -EINTR);
+        }
+      while (ret == -EINTR);
+    }
+  else
+    {
+      (void)nxsem_post(&priv->exclsem);
+      ret = OK;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spi_setfrequency
+ *
+ * Description:
+ *   Set the SPI frequency.  SCK = SPI_CLK_FREQ / (pre * n) with a
+ *   pre-divider of 1-8192 and a divider of 2-64, or SPI_CLK_FREQ itself.
+ *   The result is never faster than requested.
+ *
+ * Input Parameters:
+ *   dev -       Device-specific state data
+ *   frequency - The SPI frequency requested
+ *
+ * Returned Value:
+ *   Returns the actual frequency selected
+ *
+ ****************************************************************************/
+
+static uint32_t spi_setfrequency(FAR struct spi_dev_s *dev,
+                                 uint32_t frequency)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)dev;
+  uint32_t divisor;
+  uint32_t regval;
+  uint32_t actual;
+  uint32_t pre;
+  uint32_t n;
+
+  DEBUGASSERT(frequency > 0);
+
+  if (priv->frequency == frequency)
+    {
+      /* We are already at this frequency.  Return the actual. */
+
+      return priv->actual;
+    }
+
+  if (frequency >= SPI_CLK_FREQ)
+    {
+      regval = SPI_CLK_EQU_SYSCLK;
+      actual = SPI_CLK_FREQ;
+    }
+  else
+    {
+      divisor = (SPI_CLK_FREQ + frequency - 1) / frequency;
+
+      pre = (divisor + SPI_CLKCNT_N_MAX - 1) / SPI_CLKCNT_N_MAX;
+      if (pre > SPI_CLKDIV_PRE_MAX)
+        {
+          pre = SPI_CLKDIV_PRE_MAX;
+        }
+
+      n = (divisor + pre - 1) / pre;
+      if (n < 2)
+        {
+          n = 2;
+        }
+      else if (n > SPI_CLKCNT_N_MAX)
+        {
+          n = SPI_CLKCNT_N_MAX;
+        }
+
+      regval = ((pre - 1) << SPI_CLKDIV_PRE_S) |
+               ((n - 1) << SPI_CLKCNT_N_S) |
+               ((n / 2 - 1) << SPI_CLKCNT_H_S) |
+               ((n - 1) << SPI_CLKCNT_L_S);
+      actual = SPI_CLK_FREQ / (pre * n);
+    }
+
+  spi_putreg(priv, SPI_CLOCK_OFFSET, regval);
+
+  /* Save the frequency setting */
+
+  priv->frequency = frequency;
+  priv->actual    = actual;
+
+  spiinfo("Frequency %d->%d\n", frequency, actual);
+  return actual;
+}
+
+/****************************************************************************
+ * Name: spi_setmode
+ *
+ * Description:
+ *   Set the SPI mode.  See enum spi_mode_e for mode definitions
+ *
+ * Input Parameters:
+ *   dev -  Device-specific state data
+ *   mode - The SPI mode requested
+ *
+ * Returned Value:
+ *   none
+ *
+ ****************************************************************************/
+
+static void spi_setmode(FAR struct spi_dev_s *dev, enum spi_mode_e mode)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)dev;
+  uint32_t regval;
+  bool ckidle;
+
+  /* Has the mode changed? */
+
+  if (mode != priv->mode)
+    {
+      /* SCK idle level is CPOL; data is shifted out on the first edge
+       * (CK_OUT_EDGE) when CPHA differs from CPOL.
+       */
+
+      switch (mode)
+        {
+        case SPIDEV_MODE0: /* CPOL=0; CPHA=0 */
+          ckidle       = false;
+          priv->ckedge = 0;
+          break;
+
+        case SPIDEV_MODE1: /* CPOL=0; CPHA=1 */
+          ckidle       = false;
+          priv->ckedge = SPI_CK_OUT_EDGE;
+          break;
+
+        case SPIDEV_MODE2: /* CPOL=1; CPHA=0 */
+          ckidle       = true;
+          priv->ckedge = SPI_CK_OUT_EDGE;
+          break;
+
+        case SPIDEV_MODE3: /* CPOL=1; CPHA=1 */
+          ckidle       = true;
+          priv->ckedge = 0;
+          break;
+
+        default:
+          DEBUGASSERT(FALSE);
+          return;
+        }
+
+      regval = spi_getreg(priv, SPI_PIN_OFFSET);
+      if (ckidle)
+        {
+          regval |= SPI_CK_IDLE_EDGE;
+        }
+      else
+        {
+          regval &= ~SPI_CK_IDLE_EDGE;
+        }
+
+      spi_putreg(priv, SPI_PIN_OFFSET, regval);
+
+      /* Save the mode so that subsequent re-configurations will be faster */
+
+      priv->mode = mode;
+    }
+}
+
+/****************************************************************************
+ * Name: spi_setbits
+ *
+ * Description:
+ *   Set the number of bits per word.  Words are sent MSB first; 16-bit
+ *   words are byte swapped on their way through the data buffer.
+ *
+ * Input Parameters:
+ *   dev -  Device-specific state data
+ *   nbits - The number of bits requests
+ *
+ * Returned Value:
+ *   none
+ *
+ ****************************************************************************/
+
+static void spi_setbits(FAR struct spi_dev_s *dev, int nbits)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)dev;
+
+  DEBUGASSERT(nbits == 8 || nbits == 16);
+  priv->nbits = nbits;
+}
+
+/****************************************************************************
+ * Name: spi_transfer
+ *
+ * Description:
+ *   Start a CPU-driven transaction of up to SPI_WBUFSIZE bytes through the
+ *   W0-W15 data buffer and wait for it to complete.
+ *
+ ****************************************************************************/
+
+static void spi_transfer(FAR struct esp32_spidev_s *priv,
+                         FAR const uint8_t *txbuffer, FAR uint8_t *rxbuffer,
+                         size_t nbytes)
+{
+  uint32_t data[SPI_NWREGS];
+  FAR uint8_t *bytes = (FAR uint8_t *)data;
+  uint32_t nbits = nbytes << 3;
+  uint8_t tmp;
+  int nwords = (nbytes + 3) >> 2;
+  int i;
+
+  if (txbuffer != NULL)
+    {
+      memcpy(data, txbuffer, nbytes);
+    }
+  else
+    {
+      memset(data, 0xff, nbytes);
+    }
+
+  if (priv->nbits > 8)
+    {
+      /* The buffer is shifted out byte by byte: put the MSB first */
+
+      for (i = 0; i + 1 < nbytes; i += 2)
+        {
+          tmp          = bytes[i];
+          bytes[i]     = bytes[i + 1];
+          bytes[i + 1] = tmp;
+        }
+    }
+
+  for (i = 0; i < nwords; i++)
+    {
+      spi_putreg(priv, SPI_W_OFFSET(i), data[i]);
+    }
+
+  spi_putreg(priv, SPI_USER_OFFSET, SPI_DOUTDIN | SPI_USR_MOSI |
+             SPI_USR_MISO | priv->ckedge);
+  spi_putreg(priv, SPI_MOSI_DLEN_OFFSET, nbits - 1);
+  spi_putreg(priv, SPI_MISO_DLEN_OFFSET, nbits - 1);
+  spi_putreg(priv, SPI_CMD_OFFSET, SPI_USR);
+
+  while ((spi_getreg(priv, SPI_CMD_OFFSET) & SPI_USR) != 0);
+
+  if (rxbuffer != NULL)
+    {
+      for (i = 0; i < nwords; i++)
+        {
+          data[i] = spi_getreg(priv, SPI_W_OFFSET(i));
+        }
+
+      if (priv->nbits > 8)
+        {
+          for (i = 0; i + 1 < nbytes; i += 2)
+            {
+              tmp          = bytes[i];
+              bytes[i]     = bytes[i + 1];
+              bytes[i + 1] = tmp;
+            }
+        }
+
+      memcpy(rxbuffer, data, nbytes);
+    }
+}
+
+/****************************************************************************
+ * Name: spi_dmasegment
+ *
+ * Description:
+ *   Build the descriptor chains for the next part of a DMA exchange and
+ *   start it.  Called from spi_dmaexchange() for the first transaction and
+ *   from the interrupt handler for each following one, so that the parts
+ *   of a long exchange run back-to-back without waking the caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_SPI_DMA
+static void spi_dmasegment(FAR struct esp32_spidev_s *priv)
+{
+  FAR struct esp32_dmadesc_s *desc;
+  uintptr_t txaddr;
+  uintptr_t rxaddr;
+  uint32_t user;
+  size_t remaining;
+  size_t chunk;
+  size_t max;
+  int i;
+
+  /* Receive-only parts are limited by the size of the dummy Tx buffer */
+
+  max = priv->txbuffer != NULL ? DMADESC_MAXALIGNED : SPI_DUMMYSIZE;
+
+  remaining = priv->nbytes;
+  if (remaining > SPI_NDESC * max)
+    {
+      remaining = SPI_NDESC * max;
+    }
+
+  priv->seglen = remaining;
+
+  /* Tx chain */
+
+  txaddr = (uintptr_t)priv->txbuffer;
+  for (i = 0; remaining > 0; i++)
+    {
+      chunk = remaining < max ? remaining : max;
+      desc  = &priv->txdesc[i];
+
+      desc->ctrl = (chunk << DMADESC_SIZE_S) | (chunk << DMADESC_LENGTH_S) |
+                   DMADESC_OWNER_DMA;
+      desc->buf  = priv->txbuffer != NULL ? txaddr : (uintptr_t)g_spi_txdummy;
+      desc->next = (uintptr_t)&priv->txdesc[i + 1];
+
+      txaddr    += chunk;
+      remaining -= chunk;
+    }
+
+  desc->ctrl |= DMADESC_EOF;
+  desc->next  = 0;
+
+  /* Rx chain */
+
+  if (priv->rxbuffer != NULL)
+    {
+      remaining = priv->seglen;
+      rxaddr    = (uintptr_t)priv->rxbuffer;
+
+      for (i = 0; remaining > 0; i++)
+        {
+          chunk = remaining < DMADESC_MAXALIGNED ?
+                  remaining : DMADESC_MAXALIGNED;
+          desc  = &priv->rxdesc[i];
+
+          desc->ctrl = (chunk << DMADESC_SIZE_S) | DMADESC_OWNER_DMA;
+          desc->buf  = rxaddr;
+          desc->next = (uintptr_t)&priv->rxdesc[i + 1];
+
+          rxaddr    += chunk;
+          remaining -= chunk;
+        }
+
+      desc->next = 0;
+    }
+
+  /* Reset the DMA state and start the links */
+
+  spi_putreg(priv, SPI_DMA_CONF_OFFSET,
+             SPI_OUT_RST | SPI_IN_RST | SPI_AHBM_RST | SPI_AHBM_FIFO_RST);
+  spi_putreg(priv, SPI_DMA_CONF_OFFSET, SPI_OUT_DATA_BURST_EN |
+             SPI_INDSCR_BURST_EN | SPI_OUTDSCR_BURST_EN);
+
+  spi_putreg(priv, SPI_DMA_OUT_LINK_OFFSET,
+             ((uintptr_t)priv->txdesc & SPI_OUTLINK_ADDR_M) |
+             SPI_OUTLINK_START);
+
+  user = SPI_DOUTDIN | SPI_USR_MOSI | priv->ckedge;
+  if (priv->rxbuffer != NULL)
+    {
+      spi_putreg(priv, SPI_DMA_IN_LINK_OFFSET,
+                 ((uintptr_t)priv->rxdesc & SPI_INLINK_ADDR_M) |
+                 SPI_INLINK_START);
+      user |= SPI_USR_MISO;
+    }
+
+  spi_putreg(priv, SPI_USER_OFFSET, user);
+  spi_putreg(priv, SPI_MOSI_DLEN_OFFSET, (priv->seglen << 3) - 1);
+  spi_putreg(priv, SPI_MISO_DLEN_OFFSET, (priv->seglen << 3) - 1);
+  spi_putreg(priv, SPI_CMD_OFFSET, SPI_USR);
+}
+#endif
+
+/****************************************************************************
+ * Name: spi_interrupt
+ *
+ * Description:
+ *   Transaction done.  Start the next part of the DMA exchange or wake up
+ *   the caller when there is none.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_SPI_DMA
+static int spi_interrupt(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)arg;
+  uint32_t regval;
+
+  regval = spi_getreg(priv, SPI_SLAVE_OFFSET);
+  if ((regval & SPI_TRANS_DONE) == 0)
+    {
+      return OK;
+    }
+
+  spi_putreg(priv, SPI_SLAVE_OFFSET, regval & ~SPI_TRANS_DONE);
+
+  if (priv->txbuffer != NULL)
+    {
+      priv->txbuffer += priv->seglen;
+    }
+
+  if (priv->rxbuffer != NULL)
+    {
+      priv->rxbuffer += priv->seglen;
+    }
+
+  priv->nbytes -= priv->seglen;
+  if (priv->nbytes > 0)
+    {
+      spi_dmasegment(priv);
+    }
+  else
+    {
+      /* Disable the interrupt and wake up the caller */
+
+      spi_putreg(priv, SPI_SLAVE_OFFSET,
+                 regval & ~(SPI_TRANS_DONE | SPI_TRANS_INTEN));
+      (void)nxsem_post(&priv->dmasem);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: spi_dmaexchange
+ *
+ * Description:
+ *   Exchange a block of data using DMA and wait for completion.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_SPI_DMA
+static void spi_dmaexchange(FAR struct esp32_spidev_s *priv,
+                            FAR const uint8_t *txbuffer,
+                            FAR uint8_t *rxbuffer, size_t nbytes)
+{
+  irqstate_t flags;
+  uint32_t regval;
+  int ret;
+
+  priv->txbuffer = txbuffer;
+  priv->rxbuffer = rxbuffer;
+  priv->nbytes   = nbytes;
+
+  flags = enter_critical_section();
+
+  regval  = spi_getreg(priv, SPI_SLAVE_OFFSET);
+  regval &= ~SPI_TRANS_DONE;
+  spi_putreg(priv, SPI_SLAVE_OFFSET, regval | SPI_TRANS_INTEN);
+
+  spi_dmasegment(priv);
+  leave_critical_section(flags);
+
+  do
+    {
+      ret = nxsem_wait(&priv->dmasem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+#endif
+
+/****************************************************************************
+ * Name: spi_send
+ *
+ * Description:
+ *   Exchange one word on SPI
+ *
+ * Input Parameters:
+ *   dev - Device-specific state data
+ *   wd  - The word to send.  the size of the data is determined by the
+ *         number of bits selected for the SPI interface.
+ *
+ * Returned Value:
+ *   response
+ *
+ ****************************************************************************/
+
+static uint16_t spi_send(FAR struct spi_dev_s *dev, uint16_t wd)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)dev;
+  uint16_t rd = 0;
+
+  spi_transfer(priv, (FAR const uint8_t *)&wd, (FAR uint8_t *)&rd,
+               priv->nbits > 8 ? 2 : 1);
+  return rd;
+}
+
+/****************************************************************************
+ * Name: spi_exchange
+ *
+ * Description:
+ *   Exchange a block of data on SPI.  Long 8-bit exchanges whose buffers
+ *   are word aligned in internal DRAM use DMA; anything else, and any
+ *   trailing partial word of a DMA receive, goes through the data buffer.
+ *
+ * Input Parameters:
+ *   dev      - Device-specific state data
+ *   txbuffer - A pointer to the buffer of data to be sent
+ *   rxbuffer - A pointer to a buffer in which to receive data
+ *   nwords   - the length of data to be exchaned in units of words.
+ *              The wordsize is determined by the number of bits-per-word
+ *              selected for the SPI interface.  If nbits <= 8, the data is
+ *              packed into uint8_t's; if nbits >8, the data is packed into
+ *              uint16_t's
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void spi_exchange(FAR struct spi_dev_s *dev,
+                         FAR const void *txbuffer, FAR void *rxbuffer,
+                         size_t nwords)
+{
+  FAR struct esp32_spidev_s *priv = (FAR struct esp32_spidev_s *)dev;
+  FAR const uint8_t *src = (FAR const uint8_t *)txbuffer;
+  FAR uint8_t *dest = (FAR uint8_t *)rxbuffer;
+  size_t nbytes = priv->nbits > 8 ? nwords << 1 : nwords;
+  size_t chunk;
+
+  spiinfo("txbuffer=%p rxbuffer=%p nwords=%d\n", txbuffer, rxbuffer, nwords);
+
+#ifdef CONFIG_ESP32_SPI_DMA
+  if (priv->nbits == 8 && nbytes > CONFIG_ESP32_SPI_DMATHRESHOLD &&
+      (src == NULL || (SPI_ALIGNED(src) && DMA_CAPABLE(src))) &&
+      (dest == NULL || (SPI_ALIGNED(dest) && DMA_CAPABLE(dest))))
+    {
+      chunk = dest != NULL ? nbytes & ~3 : nbytes;
+      if (chunk > 0)
+        {
+          spi_dmaexchange(priv, src, dest, chunk);
+        }
+
+      nbytes -= chunk;
+      if (src != NULL)
+        {
+          src += chunk;
+        }
+
+      if (dest != NULL)
+        {
+          dest += chunk;
+        }
+    }
+#endif
+
+  while (nbytes > 0)
+    {
+      chunk = nbytes < SPI_WBUFSIZE ? nbytes : SPI_WBUFSIZE;
+      spi_transfer(priv, src, dest, chunk);
+
+      nbytes -= chunk;
+      if (src != NULL)
+        {
+          src += chunk;
+        }
+
+      if (dest != NULL)
+        {
+          dest += chunk;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: spi_sndblock
+ *
+ * Description:
+ *   Send a block of data on SPI
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SPI_EXCHANGE
+static void spi_sndblock(FAR struct spi_dev_s *dev,
+                         FAR const void *txbuffer, size_t nwords)
+{
+  spiinfo("txbuffer=%p nwords=%d\n", txbuffer, nwords);
+  spi_exchange(dev, txbuffer, NULL, nwords);
+}
+#endif
+
+/****************************************************************************
+ * Name: spi_recvblock
+ *
+ * Description:
+ *   Receive a block of data from SPI, sending 0xff
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SPI_EXCHANGE
+static void spi_recvblock(FAR struct spi_dev_s *dev, FAR void *rxbuffer,
+                          size_t nwords)
+{
+  spiinfo("rxbuffer=%p nwords=%d\n", rxbuffer, nwords);
+  spi_exchange(dev, NULL, rxbuffer, nwords);
+}
+#endif
+
+/****************************************************************************
+ * Name: spi_bus_initialize
+ *
+ * Description:
+ *   Enable the SPI and DMA clocks, route the pins through the GPIO matrix
+ *   and configure master mode.
+ *
+ ****************************************************************************/
+
+static int spi_bus_initialize(FAR struct esp32_spidev_s *priv)
+{
+  const struct esp32_spiconfig_s *config = priv->config;
+  uint32_t clkbits = config->clkbit;
+#ifdef CONFIG_ESP32_SPI_DMA
+  int cpuint;
+  int cpu;
+  int ret;
+#endif
+
+#ifdef CONFIG_ESP32_SPI_DMA
+  clkbits |= DPORT_SPI_DMA_CLK_EN;
+#endif
+
+  modifyreg32(DPORT_PERIP_CLK_EN_REG, 0, clkbits);
+  modifyreg32(DPORT_PERIP_RST_EN_REG, clkbits, 0);
+
+#ifdef CONFIG_ESP32_SPI_DMA
+  modifyreg32(DPORT_SPI_DMA_CHAN_SEL_REG, 3 << config->dmaselshift,
+              config->dmachan << config->dmaselshift);
+#endif
+
+  /* Route the signals.  Chip select is driven by board logic. */
+
+  esp32_configgpio(config->sckpin, OUTPUT_FUNCTION_2);
+  gpio_matrix_out(config->sckpin, config->scksig, 0, 0);
+
+  esp32_configgpio(config->mosipin, OUTPUT_FUNCTION_2);
+  gpio_matrix_out(config->mosipin, config->mosisig, 0, 0);
+
+  esp32_configgpio(config->misopin, INPUT_FUNCTION_2);
+  gpio_matrix_in(config->misopin, config->misosig, 0);
+
+  /* Master, MSB first, no command/address/dummy phases, hardware CS off */
+
+  spi_putreg(priv, SPI_SLAVE_OFFSET, 0);
+  spi_putreg(priv, SPI_CTRL_OFFSET, 0);
+  spi_putreg(priv, SPI_CTRL2_OFFSET, 0);
+  spi_putreg(priv, SPI_USER1_OFFSET, 0);
+  spi_putreg(priv, SPI_PIN_OFFSET, SPI_CS0_DIS | SPI_CS1_DIS | SPI_CS2_DIS);
+  spi_putreg(priv, SPI_USER_OFFSET, SPI_DOUTDIN | SPI_USR_MOSI |
+             SPI_USR_MISO);
+
+  priv->frequency = 0;
+  priv->nbits     = 8;
+  priv->mode      = SPIDEV_MODE0;
+  priv->ckedge    = 0;
+
+  /* Select a default frequency of approx. 400KHz */
+
+  spi_setfrequency((FAR struct spi_dev_s *)priv, 400000);
+
+  /* Initialize the SPI semaphore that enforces mutually exclusive access */
+
+  nxsem_init(&priv->exclsem, 0, 1);
+
+#ifdef CONFIG_ESP32_SPI_DMA
+  /* The DMA wait semaphore is used for signaling and, hence, should not
+   * have priority inheritance enabled.
+   */
+
+  nxsem_init(&priv->dmasem, 0, 0);
+  nxsem_setprotocol(&priv->dmasem, SEM_PRIO_NONE);
+
+  memset(g_spi_txdummy, 0xff, sizeof(g_spi_txdummy));
+
+  /* Attach the transaction done interrupt */
+
+  cpuint = esp32_alloc_levelint(1);
+  if (cpuint < 0)
+    {
+      return cpuint;
+    }
+
+  priv->cpuint = cpuint;
+
+#ifdef CONFIG_SMP
+  cpu = up_cpu_index();
+#else
+  cpu = 0;
+#endif
+
+  up_disable_irq(priv->cpuint);
+  esp32_attach_peripheral(cpu, config->periph, priv->cpuint);
+
+  ret = irq_attach(config->irq, spi_interrupt, priv);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  up_enable_irq(priv->cpuint);
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_spibus_initialize
+ *
+ * Description:
+ *   Initialize the selected SPI bus in master mode.
+ *
+ * Input Parameters:
+ *   port - 2 for SPI2 (HSPI) or 3 for SPI3 (VSPI)
+ *
+ * Returned Value:
+ *   Valid SPI device structure reference on success; a NULL on failure
+ *
+ ****************************************************************************/
+
+FAR struct spi_dev_s *esp32_spibus_initialize(int port)
+{
+  FAR struct esp32_spidev_s *priv;
+  irqstate_t flags;
+  int ret;
+
+  switch (port)
+    {
+#ifdef CONFIG_ESP32_SPI2
+    case 2:
+      priv = &g_spi2dev;
+      break;
+#endif
+
+#ifdef CONFIG_ESP32_SPI3
+    case 3:
+      priv = &g_spi3dev;
+      break;
+#endif
+
+    default:
+      spierr("ERROR: Unsupported SPI bus: %d\n", port);
+      return NULL;
+    }
+
+  /* Initialize only once */
+
+  flags = enter_critical_section();
+  if (priv->actual == 0)
+    {
+      ret = spi_bus_initialize(priv);
+      if (ret < 0)
+        {
+          leave_critical_section(flags);
+          spierr("ERROR: SPI%d initialization failed: %d\n", port, ret);
+          return NULL;
+        }
+    }
+
+  leave_critical_section(flags);
+  return &priv->spidev;
+}
+
+#endif /* CONFIG_ESP32_SPI */
@@ -0,0 +1,138 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_spi.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_ESP32_SPI_H
+#define __ARCH_XTENSA_SRC_ESP32_ESP32_SPI_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/spi/spi.h>
+
+#ifdef CONFIG_ESP32_SPI
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* This header file defines interfaces to the ESP32 SPI master driver.  To
+ * use it on your board:
+ *
+ * 1. Configure the SPI chip select GPIOs in board initialization logic.
+ * 2. Provide esp32_spi[n]select() and esp32_spi[n]status() for each
+ *    enabled bus.  Chip select is driven by these functions; the driver
+ *    keeps it asserted across the back-to-back transactions of a long
+ *    exchange.
+ * 3. If CONFIG_SPI_CMDDATA is defined, also provide esp32_spi[n]cmddata().
+ * 4. Call esp32_spibus_initialize() with the bus number (2 for HSPI or 3
+ *    for VSPI) and bind the returned handle to the upper half driver
+ *    (e.g., mmcsd_spislotinitialize()).
+ */
+
+#ifndef __ASSEMBLY__
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_spibus_initialize
+ *
+ * Description:
+ *   Initialize the selected SPI bus in master mode.
+ *
+ * Input Parameters:
+ *   port - 2 for SPI2 (HSPI) or 3 for SPI3 (VSPI)
+ *
+ * Returned Value:
+ *   Valid SPI device structure reference on success; a NULL on failure
+ *
+ ****************************************************************************/
+
+FAR struct spi_dev_s *esp32_spibus_initialize(int port);
+
+/****************************************************************************
+ * Name:  esp32_spi[n]select, esp32_spi[n]status, and esp32_spi[n]cmddata
+ *
+ * Description:
+ *   These functions must be provided in your board-specific logic.  The
+ *   select function performs chip selection and the status function
+ *   performs status operations using GPIOs in the way your board is
+ *   configured.  If CONFIG_SPI_CMDDATA is defined, the cmddata function
+ *   performs cmd/data selection in the same way.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_SPI2
+void esp32_spi2select(FAR struct spi_dev_s *dev, uint32_t devid,
+                      bool selected);
+uint8_t esp32_spi2status(FAR struct spi_dev_s *dev, uint32_t devid);
+#ifdef CONFIG_SPI_CMDDATA
+int esp32_spi2cmddata(FAR struct spi_dev_s *dev, uint32_t devid, bool cmd);
+#endif
+#endif
+
+#ifdef CONFIG_ESP32_SPI3
+void esp32_spi3select(FAR struct spi_dev_s *dev, uint32_t devid,
+                      bool selected);
+uint8_t esp32_spi3status(FAR struct spi_dev_s *dev, uint32_t devid);
+#ifdef CONFIG_SPI_CMDDATA
+int esp32_spi3cmddata(FAR struct spi_dev_s *dev, uint32_t devid, bool cmd);
+#endif
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __ASSEMBLY__ */
+#endif /* CONFIG_ESP32_SPI */
+#endif /* __ARCH_XTENSA_SRC_ESP32_ESP32_SPI_H */
@@ -74,6 +74,9 @@ void IRAM_ATTR __start(void)
 {
   uint32_t regval;
   uint32_t sp;
+#ifdef CONFIG_XTENSA_TLS
+  uint32_t threadptr;
+#endif
 
   /* Kill the watchdog timer */
 
@@ -116,6 +119,16 @@ void IRAM_ATTR __start(void)
    */
 
   sp = (uint32_t)g_idlestack + IDLETHREAD_STACKSIZE;
+
+#ifdef CONFIG_XTENSA_TLS
+  /* The TLS block of the IDLE thread is at the top of the IDLE stack.
+   * Keep the 16-byte alignment of the stack pointer below it.
+   */
+
+  threadptr = xtensa_tls_threadptr(sp);
+  sp        = (sp - xtensa_tls_size() - 4) & ~15;
+#endif
+
   __asm__ __volatile__("mov sp, %0\n" : : "r"(sp));
 
   /* Make page 0 access raise an exception */
@@ -130,6 +143,13 @@ void IRAM_ATTR __start(void)
 
   memset(&_sbss, 0, (&_ebss - &_sbss) * sizeof(_sbss));
 
+#ifdef CONFIG_XTENSA_TLS
+  /* Now the IDLE thread may use thread-local storage */
+
+  xtensa_tls_initialize(threadptr);
+  __asm__ __volatile__ ("wur.THREADPTR %0\n" : : "r"(threadptr));
+#endif
+
   /* Make sure that the APP_CPU is disabled for now */
 
   regval  = getreg32(DPORT_APPCPU_CTRL_B_REG);
@@ -0,0 +1,553 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_tickless.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Tickless OS Support.
+ *
+ * When CONFIG_SCHED_TICKLESS is enabled, all support for timer interrupts
+ * is suppressed and the platform specific code is expected to provide the
+ * following custom functions.
+ *
+ *   void xtensa_timer_initialize(void): Initializes the timer facilities.
+ *     Called early in the intialization sequence (by up_intialize()).
+ *   int up_timer_gettime(FAR struct timespec *ts):  Returns the current
+ *     time from the platform specific time source.
+ *   int up_alarm_cancel(FAR struct timespec *ts) and
+ *   int up_alarm_start(FAR const struct timespec *ts):  Cancel/start the
+ *     alarm (CONFIG_SCHED_TICKLESS_ALARM).
+ *   int up_timer_cancel(FAR struct timespec *ts) and
+ *   int up_timer_start(FAR const struct timespec *ts):  Cancel/start the
+ *     interval timer (!CONFIG_SCHED_TICKLESS_ALARM).
+ *
+ * The time base is the 32-bit CCOUNT register which is extended to 64 bits
+ * in software.  The CCOMPARE register provides the alarm.  Since CCOMPARE
+ * generates an interrupt each time CCOUNT matches it, the alarm is never
+ * programmed more than XT_TICKLESS_MAXDELAY cycles in the future.  That
+ * assures that wrap-around of CCOUNT is always observed, even if the
+ * scheduler requests a much longer delay.
+ *
+ * In the SMP case, each CPU has its own CCOUNT and CCOMPARE registers.  The
+ * CCOUNT of the APP CPU is synchronized to the PRO CPU when the APP CPU is
+ * started and the resulting offset is added to every APP CPU count.  The
+ * alarm is programmed in the CCOMPARE register of the CPU that started it;
+ * a stale CCOMPARE interrupt on the other CPU is simply ignored.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <arch/xtensa/xtensa_specregs.h>
+#include <arch/board/board.h>
+
+#include "xtensa_timer.h"
+#include "xtensa.h"
+#include "esp32_smp.h"
+
+#ifdef CONFIG_SCHED_TICKLESS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of cycles that CCOMPARE is programmed ahead of CCOUNT.
+ * Must be less than 2^31 so that a wrap of CCOUNT can always be detected.
+ */
+
+#define XT_TICKLESS_MAXDELAY  0x40000000
+
+/* The minimum number of cycles that CCOMPARE is programmed ahead of CCOUNT.
+ * CCOUNT must not pass the new compare value before it is written.
+ */
+
+#define XT_TICKLESS_MINDELAY  256
+
+#ifdef CONFIG_SMP
+#  define tickless_lock()      spin_lockr_irqsave(&g_tickless_lock)
+#  define tickless_unlock(f)   spin_unlockr_irqrestore(&g_tickless_lock, (f))
+#else
+#  define tickless_lock()      up_irq_save()
+#  define tickless_unlock(f)   up_irq_restore(f)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* 64-bit extension of CCOUNT */
+
+static uint32_t g_last_count;   /* Last (synchronized) CCOUNT observed */
+static uint32_t g_count_wraps;  /* Upper 32 bits of the cycle count */
+
+/* The alarm (an absolute 64-bit cycle count) */
+
+static uint64_t g_alarm_cycles;
+static bool g_alarm_active;
+
+#ifdef CONFIG_SMP
+static int g_alarm_cpu;         /* CPU whose CCOMPARE holds the alarm */
+
+/* Offset to add to the CCOUNT of each CPU */
+
+static uint32_t g_count_offset[CONFIG_SMP_NCPUS];
+
+/* PRO/APP CPU CCOUNT synchronization handshake */
+
+static volatile bool g_sync_request;
+static volatile bool g_sync_ready;
+static volatile uint32_t g_sync_count;
+
+static struct spinlock_s g_tickless_lock SP_SECTION = SP_INITIALIZER;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_getcount
+ *
+ * Description:
+ *   Return the CCOUNT of this CPU, synchronized to the PRO CPU.
+ *
+ ****************************************************************************/
+
+static inline uint32_t esp32_getcount(void)
+{
+#ifdef CONFIG_SMP
+  return xtensa_getcount() + g_count_offset[up_cpu_index()];
+#else
+  return xtensa_getcount();
+#endif
+}
+
+/****************************************************************************
+ * Name: esp32_getcycles
+ *
+ * Description:
+ *   Return the 64-bit cycle count since xtensa_timer_initialize() was
+ *   called.
+ *
+ * Assumptions:
+ *   Called with the tickless lock held.  Must be called at least once
+ *   every 2^31 cycles; the CCOMPARE interrupt guarantees that.
+ *
+ ****************************************************************************/
+
+static uint64_t esp32_getcycles(void)
+{
+  uint32_t count = esp32_getcount();
+
+  /* The counts of the two CPUs may differ by a few cycles.  Ignore a count
+   * that is slightly behind the last one observed so that time never goes
+   * backward.
+   */
+
+  if ((int32_t)(count - g_last_count) >= 0)
+    {
+      if (count < g_last_count)
+        {
+          g_count_wraps++;
+        }
+
+      g_last_count = count;
+    }
+
+  return ((uint64_t)g_count_wraps << 32) | g_last_count;
+}
+
+/****************************************************************************
+ * Name: esp32_cycles2ts and esp32_ts2cycles
+ *
+ * Description:
+ *   Convert between CPU cycles and struct timespec.
+ *
+ ****************************************************************************/
+
+static void esp32_cycles2ts(uint64_t cycles, FAR struct timespec *ts)
+{
+  ts->tv_sec  = (time_t)(cycles / BOARD_CLOCK_FREQUENCY);
+  ts->tv_nsec = (long)(((cycles % BOARD_CLOCK_FREQUENCY) * NSEC_PER_SEC) /
+                       BOARD_CLOCK_FREQUENCY);
+}
+
+static uint64_t esp32_ts2cycles(FAR const struct timespec *ts)
+{
+  return (uint64_t)ts->tv_sec * BOARD_CLOCK_FREQUENCY +
+         ((uint64_t)ts->tv_nsec * BOARD_CLOCK_FREQUENCY) / NSEC_PER_SEC;
+}
+
+/****************************************************************************
+ * Name: esp32_setcompare
+ *
+ * Description:
+ *   Program CCOMPARE of this CPU for the next alarm, or just far enough in
+ *   the future to catch the next wrap of CCOUNT if there is no alarm on
+ *   this CPU.  Writing CCOMPARE also clears any pending timer interrupt.
+ *
+ * Assumptions:
+ *   Called with the tickless lock held.
+ *
+ ****************************************************************************/
+
+static void esp32_setcompare(uint64_t now)
+{
+  uint64_t delay = XT_TICKLESS_MAXDELAY;
+
+#ifdef CONFIG_SMP
+  if (g_alarm_active && g_alarm_cpu == up_cpu_index())
+#else
+  if (g_alarm_active)
+#endif
+    {
+      if (g_alarm_cycles <= now)
+        {
+          delay = XT_TICKLESS_MINDELAY;
+        }
+      else if (g_alarm_cycles - now < XT_TICKLESS_MAXDELAY)
+        {
+          delay = g_alarm_cycles - now;
+          if (delay < XT_TICKLESS_MINDELAY)
+            {
+              delay = XT_TICKLESS_MINDELAY;
+            }
+        }
+    }
+
+  xtensa_setcompare(xtensa_getcount() + (uint32_t)delay);
+}
+
+/****************************************************************************
+ * Name: esp32_start
+ *
+ * Description:
+ *   Arm the alarm on this CPU.
+ *
+ ****************************************************************************/
+
+static void esp32_start(uint64_t alarm, uint64_t now)
+{
+  g_alarm_cycles = alarm;
+  g_alarm_active = true;
+#ifdef CONFIG_SMP
+  g_alarm_cpu    = up_cpu_index();
+#endif
+
+  esp32_setcompare(now);
+}
+
+/****************************************************************************
+ * Function:  esp32_timerisr
+ *
+ * Description:
+ *   The timer ISR.  Keeps the 64-bit cycle count current and reports the
+ *   expiration of the alarm (or interval timer) to the scheduler.
+ *
+ ****************************************************************************/
+
+static int esp32_timerisr(int irq, uint32_t *regs, FAR void *arg)
+{
+  irqstate_t flags;
+  uint64_t now;
+  bool expired = false;
+
+  flags = tickless_lock();
+
+  now = esp32_getcycles();
+
+#ifdef CONFIG_SMP
+  if (g_alarm_active && g_alarm_cpu == up_cpu_index() &&
+      g_alarm_cycles <= now)
+#else
+  if (g_alarm_active && g_alarm_cycles <= now)
+#endif
+    {
+      g_alarm_active = false;
+      expired        = true;
+    }
+
+  esp32_setcompare(now);
+  tickless_unlock(flags);
+
+  /* Notify the scheduler with the lock released:  It will probably
+   * restart the alarm.
+   */
+
+  if (expired)
+    {
+#ifdef CONFIG_SCHED_TICKLESS_ALARM
+      struct timespec ts;
+
+      esp32_cycles2ts(now, &ts);
+      sched_alarm_expiration(&ts);
+#else
+      sched_timer_expiration();
+#endif
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Function:  xtensa_timer_initialize
+ *
+ * Description:
+ *   This function is called during start-up to initialize the timer
+ *   facilities.  On return, the current up-time is available from
+ *   up_timer_gettime() and the alarm is ready for use (but not actively
+ *   timing).
+ *
+ ****************************************************************************/
+
+void xtensa_timer_initialize(void)
+{
+  g_last_count  = xtensa_getcount();
+  g_count_wraps = 0;
+  xtensa_setcompare(g_last_count + XT_TICKLESS_MAXDELAY);
+
+  /* Attach the timer interrupt */
+
+  (void)irq_attach(XTENSA_IRQ_TIMER0, (xcpt_t)esp32_timerisr, NULL);
+
+  /* Enable the timer 0 CPU interrupt. */
+
+  up_enable_irq(ESP32_CPUINT_TIMER0);
+}
+
+/****************************************************************************
+ * Name: esp32_tickless_syncpro and esp32_tickless_syncapp
+ *
+ * Description:
+ *   Synchronize the CCOUNT of the APP CPU with the PRO CPU.  The PRO CPU
+ *   calls esp32_tickless_syncpro() while it waits for the APP CPU to
+ *   start; the APP CPU calls esp32_tickless_syncapp() early in its start-
+ *   up.  The difference between the two counts is then added to each APP
+ *   CPU count (less the few cycles of the handshake latency).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void esp32_tickless_syncpro(void)
+{
+  while (!g_sync_request)
+    {
+    }
+
+  g_sync_count = xtensa_getcount();
+  g_sync_ready = true;
+}
+
+void esp32_tickless_syncapp(void)
+{
+  g_sync_ready   = false;
+  g_sync_request = true;
+
+  while (!g_sync_ready)
+    {
+    }
+
+  g_count_offset[up_cpu_index()] = g_sync_count - xtensa_getcount();
+  g_sync_request = false;
+}
+
+/****************************************************************************
+ * Name: esp32_tickless_appinit
+ *
+ * Description:
+ *   Enable the CCOMPARE interrupt on the APP CPU.  The interrupt handler
+ *   is already attached by xtensa_timer_initialize() on the PRO CPU.
+ *
+ ****************************************************************************/
+
+void esp32_tickless_appinit(void)
+{
+  irqstate_t flags;
+
+  flags = tickless_lock();
+  esp32_setcompare(esp32_getcycles());
+  tickless_unlock(flags);
+
+  up_enable_irq(ESP32_CPUINT_TIMER0);
+}
+#endif
+
+/****************************************************************************
+ * Name: up_timer_gettime
+ *
+ * Description:
+ *   Return the elapsed time since power-up (or, more correctly, since
+ *   xtensa_timer_initialize() was called).  This function is functionally
+ *   equivalent to clock_gettime() with clockid CLOCK_MONOTONIC.
+ *
+ ****************************************************************************/
+
+int up_timer_gettime(FAR struct timespec *ts)
+{
+  irqstate_t flags;
+  uint64_t now;
+
+  flags = tickless_lock();
+  now   = esp32_getcycles();
+  tickless_unlock(flags);
+
+  esp32_cycles2ts(now, ts);
+  return OK;
+}
+
+#ifdef CONFIG_SCHED_TICKLESS_ALARM
+/****************************************************************************
+ * Name: up_alarm_cancel
+ *
+ * Description:
+ *   Cancel the alarm and return the time of cancellation of the alarm.
+ *
+ ****************************************************************************/
+
+int up_alarm_cancel(FAR struct timespec *ts)
+{
+  irqstate_t flags;
+  uint64_t now;
+
+  flags = tickless_lock();
+
+  now = esp32_getcycles();
+  g_alarm_active = false;
+  esp32_setcompare(now);
+
+  tickless_unlock(flags);
+
+  if (ts != NULL)
+    {
+      esp32_cycles2ts(now, ts);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: up_alarm_start
+ *
+ * Description:
+ *   Start the alarm.  sched_alarm_expiration() will be called when the
+ *   alarm occurs (unless up_alarm_cancel is called to stop it).
+ *
+ ****************************************************************************/
+
+int up_alarm_start(FAR const struct timespec *ts)
+{
+  irqstate_t flags;
+
+  flags = tickless_lock();
+  esp32_start(esp32_ts2cycles(ts), esp32_getcycles());
+  tickless_unlock(flags);
+
+  return OK;
+}
+
+#else
+/****************************************************************************
+ * Name: up_timer_cancel
+ *
+ * Description:
+ *   Cancel the interval timer and return the time remaining on the timer.
+ *
+ ****************************************************************************/
+
+int up_timer_cancel(FAR struct timespec *ts)
+{
+  irqstate_t flags;
+  uint64_t remaining = 0;
+  uint64_t now;
+
+  flags = tickless_lock();
+
+  now = esp32_getcycles();
+  if (g_alarm_active && g_alarm_cycles > now)
+    {
+      remaining = g_alarm_cycles - now;
+    }
+
+  g_alarm_active = false;
+  esp32_setcompare(now);
+
+  tickless_unlock(flags);
+
+  if (ts != NULL)
+    {
+      esp32_cycles2ts(remaining, ts);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: up_timer_start
+ *
+ * Description:
+ *   Start the interval timer.  sched_timer_expiration() will be called at
+ *   the completion of the timeout (unless up_timer_cancel is called to stop
+ *   the timing.
+ *
+ ****************************************************************************/
+
+int up_timer_start(FAR const struct timespec *ts)
+{
+  irqstate_t flags;
+  uint64_t now;
+
+  flags = tickless_lock();
+  now   = esp32_getcycles();
+  esp32_start(now + esp32_ts2cycles(ts), now);
+  tickless_unlock(flags);
+
+  return OK;
+}
+#endif /* CONFIG_SCHED_TICKLESS_ALARM */
+#endif /* CONFIG_SCHED_TICKLESS */
@@ -0,0 +1,1178 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_tim.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/timers/timer.h>
+#include <nuttx/timers/oneshot.h>
+#include <nuttx/timers/arch_alarm.h>
+
+#include "xtensa.h"
+#include "chip/esp32_soc.h"
+#include "chip/esp32_dport.h"
+#include "chip/esp32_tim.h"
+#include "esp32_cpuint.h"
+#include "esp32_tim.h"
+
+#ifdef CONFIG_ESP32_TIM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_ALARM_ARCH) && !defined(CONFIG_ESP32_ONESHOT)
+#  error CONFIG_ALARM_ARCH requires CONFIG_ESP32_ONESHOT
+#endif
+
+/* Timer source clock and the resolution limits that follow from the 16-bit
+ * prescaler.
+ */
+
+#define TIM_CLK_FREQ          (APB_CLK_FREQ)
+#define TIM_CLK_PER_USEC      (TIM_CLK_FREQ / USEC_PER_SEC)
+#define TIM_MAX_RESOLUTION    (TIMG_T_DIVIDER_MAX / TIM_CLK_PER_USEC)
+
+/* An alarm that is set too close to the current count may be passed
+ * before it is armed.  It is then moved this many counts into the future.
+ */
+
+#define TIM_ALARM_MARGIN      2
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One 64-bit timer group timer */
+
+struct esp32_tim_s
+{
+  uint32_t base;           /* Timer group base address */
+  uint8_t tim;             /* Timer within the group (0 or 1) */
+  uint8_t periph;          /* Peripheral ID */
+  uint8_t irq;             /* IRQ associated with this timer */
+  uint8_t cpu;             /* CPU the interrupt is attached to */
+  int cpuint;              /* CPU interrupt assigned, -1 if not attached */
+  bool inuse;              /* True: Claimed by a lower half */
+};
+
+#ifdef CONFIG_TIMER
+/* Timer lower half state (cast compatible with struct timer_lowerhalf_s) */
+
+struct esp32_timer_lowerhalf_s
+{
+  FAR const struct timer_ops_s *ops; /* Lower half operations */
+  FAR struct esp32_tim_s *tim;       /* Underlying timer */
+  tccb_t callback;                   /* Current upper half callback */
+  FAR void *arg;                     /* Argument passed to the callback */
+  uint32_t timeout;                  /* Timeout in microseconds */
+  bool started;                      /* True: Timer has been started */
+};
+#endif
+
+#ifdef CONFIG_ESP32_ONESHOT
+/* Oneshot lower half state (cast compatible with struct
+ * oneshot_lowerhalf_s).  The counter runs continuously; a oneshot is an
+ * alarm at a future count.
+ */
+
+struct esp32_oneshot_lowerhalf_s
+{
+  struct oneshot_lowerhalf_s lh;     /* Lower half operations */
+  FAR struct esp32_tim_s *tim;       /* Underlying timer */
+  oneshot_callback_t callback;       /* Callback of the running oneshot */
+  FAR void *arg;                     /* Argument passed to the callback */
+  uint64_t alarm;                    /* Count at which the oneshot expires */
+  uint16_t resolution;               /* Timer resolution in microseconds */
+  volatile bool running;             /* True: The oneshot is running */
+};
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Low-level timer helpers */
+
+static FAR struct esp32_tim_s *esp32_tim_allocate(int chan);
+static void esp32_tim_free(FAR struct esp32_tim_s *tim);
+static void esp32_tim_configure(FAR struct esp32_tim_s *tim,
+                                uint32_t divider, bool autoreload);
+static uint64_t esp32_tim_getcounter(FAR struct esp32_tim_s *tim);
+static void esp32_tim_setcounter(FAR struct esp32_tim_s *tim,
+                                 uint64_t value);
+static void esp32_tim_setalarm(FAR struct esp32_tim_s *tim,
+                               uint64_t alarm);
+static void esp32_tim_cancelalarm(FAR struct esp32_tim_s *tim);
+static int  esp32_tim_attach(FAR struct esp32_tim_s *tim, xcpt_t handler,
+                             FAR void *arg);
+static void esp32_tim_detach(FAR struct esp32_tim_s *tim);
+
+#ifdef CONFIG_TIMER
+/* Timer lower half methods */
+
+static int  esp32_timer_handler(int irq, FAR void *context, FAR void *arg);
+static int  esp32_timer_start(FAR struct timer_lowerhalf_s *lower);
+static int  esp32_timer_stop(FAR struct timer_lowerhalf_s *lower);
+static int  esp32_timer_getstatus(FAR struct timer_lowerhalf_s *lower,
+                                  FAR struct timer_status_s *status);
+static int  esp32_timer_settimeout(FAR struct timer_lowerhalf_s *lower,
+                                   uint32_t timeout);
+static void esp32_timer_setcallback(FAR struct timer_lowerhalf_s *lower,
+                                    tccb_t callback, FAR void *arg);
+static int  esp32_timer_ioctl(FAR struct timer_lowerhalf_s *lower, int cmd,
+                              unsigned long arg);
+static int  esp32_timer_maxtimeout(FAR struct timer_lowerhalf_s *lower,
+                                   FAR uint32_t *maxtimeout);
+#endif
+
+#ifdef CONFIG_ESP32_ONESHOT
+/* Oneshot lower half methods */
+
+static int esp32_oneshot_handler(int irq, FAR void *context, FAR void *arg);
+static int esp32_oneshot_max_delay(FAR struct oneshot_lowerhalf_s *lower,
+                                   FAR struct timespec *ts);
+static int esp32_oneshot_start(FAR struct oneshot_lowerhalf_s *lower,
+                               oneshot_callback_t callback, FAR void *arg,
+                               FAR const struct timespec *ts);
+static int esp32_oneshot_cancel(FAR struct oneshot_lowerhalf_s *lower,
+                                FAR struct timespec *ts);
+static int esp32_oneshot_current(FAR struct oneshot_lowerhalf_s *lower,
+                                 FAR struct timespec *ts);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_TIMER0
+static struct esp32_tim_s g_tim0 =
+{
+  .base   = DR_REG_TIMERGROUP0_BASE,
+  .tim    = 0,
+  .periph = ESP32_PERIPH_TG_T0_LEVEL,
+  .irq    = ESP32_IRQ_TG_T0_LEVEL,
+  .cpuint = -1,
+};
+#endif
+
+#ifdef CONFIG_ESP32_TIMER1
+static struct esp32_tim_s g_tim1 =
+{
+  .base   = DR_REG_TIMERGROUP0_BASE,
+  .tim    = 1,
+  .periph = ESP32_PERIPH_TG_T1_LEVEL,
+  .irq    = ESP32_IRQ_TG_T1_LEVEL,
+  .cpuint = -1,
+};
+#endif
+
+#ifdef CONFIG_ESP32_TIMER2
+static struct esp32_tim_s g_tim2 =
+{
+  .base   = DR_REG_TIMERGROUP1_BASE,
+  .tim    = 0,
+  .periph = ESP32_PERIPH_TG1_T0_LEVEL,
+  .irq    = ESP32_IRQ_TG1_T0_LEVEL,
+  .cpuint = -1,
+};
+#endif
+
+#ifdef CONFIG_ESP32_TIMER3
+static struct esp32_tim_s g_tim3 =
+{
+  .base   = DR_REG_TIMERGROUP1_BASE,
+  .tim    = 1,
+  .periph = ESP32_PERIPH_TG1_T1_LEVEL,
+  .irq    = ESP32_IRQ_TG1_T1_LEVEL,
+  .cpuint = -1,
+};
+#endif
+
+#ifdef CONFIG_TIMER
+static const struct timer_ops_s g_timer_ops =
+{
+  .start       = esp32_timer_start,
+  .stop        = esp32_timer_stop,
+  .getstatus   = esp32_timer_getstatus,
+  .settimeout  = esp32_timer_settimeout,
+  .setcallback = esp32_timer_setcallback,
+  .ioctl       = esp32_timer_ioctl,
+  .maxtimeout  = esp32_timer_maxtimeout,
+};
+#endif
+
+#ifdef CONFIG_ESP32_ONESHOT
+static const struct oneshot_operations_s g_oneshot_ops =
+{
+  .max_delay = esp32_oneshot_max_delay,
+  .start     = esp32_oneshot_start,
+  .cancel    = esp32_oneshot_cancel,
+  .current   = esp32_oneshot_current,
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_tim_allocate
+ *
+ * Description:
+ *   Claim a timer channel and make sure that its timer group is clocked.
+ *   The group is taken out of reset only the first time that it is clocked
+ *   so that the other timer of the group is not disturbed.
+ *
+ ****************************************************************************/
+
+static FAR struct esp32_tim_s *esp32_tim_allocate(int chan)
+{
+  FAR struct esp32_tim_s *tim;
+  irqstate_t flags;
+  uint32_t clkbit;
+
+  switch (chan)
+    {
+#ifdef CONFIG_ESP32_TIMER0
+      case 0:
+        tim = &g_tim0;
+        break;
+#endif
+#ifdef CONFIG_ESP32_TIMER1
+      case 1:
+        tim = &g_tim1;
+        break;
+#endif
+#ifdef CONFIG_ESP32_TIMER2
+      case 2:
+        tim = &g_tim2;
+        break;
+#endif
+#ifdef CONFIG_ESP32_TIMER3
+      case 3:
+        tim = &g_tim3;
+        break;
+#endif
+      default:
+        tmrerr("ERROR: Timer %d is not enabled\n", chan);
+        return NULL;
+    }
+
+  clkbit = tim->base == DR_REG_TIMERGROUP0_BASE ?
+           DPORT_TIMERGROUP_CLK_EN : DPORT_TIMERGROUP1_CLK_EN;
+
+  flags = enter_critical_section();
+  if (tim->inuse)
+    {
+      leave_critical_section(flags);
+      tmrerr("ERROR: Timer %d is already in use\n", chan);
+      return NULL;
+    }
+
+  tim->inuse = true;
+
+  if ((getreg32(DPORT_PERIP_CLK_EN_REG) & clkbit) == 0)
+    {
+      modifyreg32(DPORT_PERIP_CLK_EN_REG, 0, clkbit);
+      modifyreg32(DPORT_PERIP_RST_EN_REG, clkbit, 0);
+    }
+
+  leave_critical_section(flags);
+  return tim;
+}
+
+/****************************************************************************
+ * Name: esp32_tim_free
+ *
+ * Description:
+ *   Stop the timer and release the channel.  The timer group clock is left
+ *   running for the other timer of the group.
+ *
+ ****************************************************************************/
+
+static void esp32_tim_free(FAR struct esp32_tim_s *tim)
+{
+  esp32_tim_detach(tim);
+  putreg32(0, tim->base + TIMG_T_OFFSET(tim->tim) + TIMG_T_CONFIG_OFFSET);
+  tim->inuse = false;
+}
+
+/****************************************************************************
+ * Name: esp32_tim_configure
+ *
+ * Description:
+ *   Stop the counter, clear it, and restart it counting up at
+ *   TIM_CLK_FREQ / divider with alarms disabled.
+ *
+ ****************************************************************************/
+
+static void esp32_tim_configure(FAR struct esp32_tim_s *tim,
+                                uint32_t divider, bool autoreload)
+{
+  uint32_t cfgaddr = tim->base + TIMG_T_OFFSET(tim->tim) +
+                     TIMG_T_CONFIG_OFFSET;
+  uint32_t regval;
+
+  DEBUGASSERT(divider >= TIMG_T_DIVIDER_MIN &&
+              divider <= TIMG_T_DIVIDER_MAX);
+
+  /* A divider of 65536 is encoded as zero */
+
+  regval = TIMG_T_INCREASE | TIMG_T_LEVEL_INT_EN |
+           ((divider << TIMG_T_DIVIDER_S) & TIMG_T_DIVIDER_M);
+  if (autoreload)
+    {
+      regval |= TIMG_T_AUTORELOAD;
+    }
+
+  putreg32(regval, cfgaddr);
+  esp32_tim_setcounter(tim, 0);
+
+  /* Acknowledge any stale alarm and start counting */
+
+  putreg32(TIMG_T_INT(tim->tim), tim->base + TIMG_INT_CLR_OFFSET);
+  modifyreg32(cfgaddr, 0, TIMG_T_EN);
+}
+
+/****************************************************************************
+ * Name: esp32_tim_getcounter
+ *
+ * Description:
+ *   Latch and return the 64-bit count.
+ *
+ ****************************************************************************/
+
+static uint64_t esp32_tim_getcounter(FAR struct esp32_tim_s *tim)
+{
+  uint32_t tbase = tim->base + TIMG_T_OFFSET(tim->tim);
+  uint32_t lo;
+  uint32_t hi;
+
+  putreg32(0, tbase + TIMG_T_UPDATE_OFFSET);
+  lo = getreg32(tbase + TIMG_T_LO_OFFSET);
+  hi = getreg32(tbase + TIMG_T_HI_OFFSET);
+
+  return ((uint64_t)hi << 32) | lo;
+}
+
+/****************************************************************************
+ * Name: esp32_tim_setcounter
+ *
+ * Description:
+ *   Load the counter.  The same value is reloaded on each alarm when auto-
+ *   reload is enabled.
+ *
+ ****************************************************************************/
+
+static void esp32_tim_setcounter(FAR struct esp32_tim_s *tim,
+                                 uint64_t value)
+{
+  uint32_t tbase = tim->base + TIMG_T_OFFSET(tim->tim);
+
+  putreg32((uint32_t)value, tbase + TIMG_T_LOADLO_OFFSET);
+  putreg32((uint32_t)(value >> 32), tbase + TIMG_T_LOADHI_OFFSET);
+  putreg32(1, tbase + TIMG_T_LOAD_OFFSET);
+}
+
+/****************************************************************************
+ * Name: esp32_tim_setalarm
+ *
+ * Description:
+ *   Arm the alarm at a count and enable the timer interrupt.  The alarm
+ *   only fires when the counter reaches the alarm value, so an alarm that
+ *   was already passed when armed is moved just ahead of the counter.
+ *   The hardware disarms the alarm when it fires.
+ *
+ ****************************************************************************/
+
+static void esp32_tim_setalarm(FAR struct esp32_tim_s *tim, uint64_t alarm)
+{
+  uint32_t tbase = tim->base + TIMG_T_OFFSET(tim->tim);
+  uint64_t now;
+
+  modifyreg32(tim->base + TIMG_INT_ENA_OFFSET, 0, TIMG_T_INT(tim->tim));
+
+  for (; ; )
+    {
+      putreg32((uint32_t)alarm, tbase + TIMG_T_ALARMLO_OFFSET);
+      putreg32((uint32_t)(alarm >> 32), tbase + TIMG_T_ALARMHI_OFFSET);
+      modifyreg32(tbase + TIMG_T_CONFIG_OFFSET, 0, TIMG_T_ALARM_EN);
+
+      now = esp32_tim_getcounter(tim);
+      if (now < alarm ||
+          (getreg32(tbase + TIMG_T_CONFIG_OFFSET) & TIMG_T_ALARM_EN) == 0)
+        {
+          /* Still ahead of the counter or already fired */
+
+          break;
+        }
+
+      alarm = now + TIM_ALARM_MARGIN;
+    }
+}
+
+/****************************************************************************
+ * Name: esp32_tim_cancelalarm
+ *
+ * Description:
+ *   Disarm the alarm and discard any pending timer interrupt.
+ *
+ ****************************************************************************/
+
+static void esp32_tim_cancelalarm(FAR struct esp32_tim_s *tim)
+{
+  uint32_t tbase = tim->base + TIMG_T_OFFSET(tim->tim);
+
+  modifyreg32(tbase + TIMG_T_CONFIG_OFFSET, TIMG_T_ALARM_EN, 0);
+  modifyreg32(tim->base + TIMG_INT_ENA_OFFSET, TIMG_T_INT(tim->tim), 0);
+  putreg32(TIMG_T_INT(tim->tim), tim->base + TIMG_INT_CLR_OFFSET);
+}
+
+/****************************************************************************
+ * Name: esp32_tim_attach
+ *
+ * Description:
+ *   Attach the timer interrupt to a level 1 CPU interrupt of this CPU.
+ *
+ ****************************************************************************/
+
+static int esp32_tim_attach(FAR struct esp32_tim_s *tim, xcpt_t handler,
+                            FAR void *arg)
+{
+  int cpuint;
+  int ret;
+
+  cpuint = esp32_alloc_levelint(1);
+  if (cpuint < 0)
+    {
+      tmrerr("ERROR: No CPU interrupt available\n");
+      return cpuint;
+    }
+
+#ifdef CONFIG_SMP
+  tim->cpu = up_cpu_index();
+#else
+  tim->cpu = 0;
+#endif
+
+  tim->cpuint = cpuint;
+  up_disable_irq(cpuint);
+  esp32_attach_peripheral(tim->cpu, tim->periph, cpuint);
+
+  ret = irq_attach(tim->irq, handler, arg);
+  if (ret < 0)
+    {
+      esp32_tim_detach(tim);
+      return ret;
+    }
+
+  up_enable_irq(cpuint);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_tim_detach
+ *
+ * Description:
+ *   Detach the timer interrupt and release its CPU interrupt.
+ *
+ ****************************************************************************/
+
+static void esp32_tim_detach(FAR struct esp32_tim_s *tim)
+{
+  if (tim->cpuint >= 0)
+    {
+      esp32_tim_cancelalarm(tim);
+      up_disable_irq(tim->cpuint);
+      esp32_detach_peripheral(tim->cpu, tim->periph, tim->cpuint);
+      esp32_free_cpuint(tim->cpuint);
+      (void)irq_detach(tim->irq);
+      tim->cpuint = -1;
+    }
+}
+
+/****************************************************************************
+ * Name: esp32_tim_divider
+ *
+ * Description:
+ *   Return the prescaler for a resolution in microseconds or zero if the
+ *   resolution is not supported.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ESP32_ONESHOT) || defined(CONFIG_ESP32_FREERUN)
+static uint32_t esp32_tim_divider(uint16_t resolution)
+{
+  if (resolution < 1 || resolution > TIM_MAX_RESOLUTION)
+    {
+      tmrerr("ERROR: Unsupported resolution: %u usec\n", resolution);
+      return 0;
+    }
+
+  return (uint32_t)resolution * TIM_CLK_PER_USEC;
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_timer_handler
+ *
+ * Description:
+ *   Timer lower half interrupt.  The counter was reloaded with zero when the
+ *   alarm fired; the alarm is re-armed for the next interval unless the
+ *   upper half callback asks to stop.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TIMER
+static int esp32_timer_handler(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv =
+    (FAR struct esp32_timer_lowerhalf_s *)arg;
+  uint32_t next = priv->timeout;
+
+  putreg32(TIMG_T_INT(priv->tim->tim),
+           priv->tim->base + TIMG_INT_CLR_OFFSET);
+
+  if (priv->callback != NULL && !priv->callback(&next, priv->arg))
+    {
+      (void)esp32_timer_stop((FAR struct timer_lowerhalf_s *)priv);
+      return OK;
+    }
+
+  if (next > 0)
+    {
+      priv->timeout = next;
+    }
+
+  esp32_tim_setalarm(priv->tim, priv->timeout);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_timer_start
+ *
+ * Description:
+ *   Start the timer, resetting the time to the current timeout.
+ *
+ ****************************************************************************/
+
+static int esp32_timer_start(FAR struct timer_lowerhalf_s *lower)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv =
+    (FAR struct esp32_timer_lowerhalf_s *)lower;
+  irqstate_t flags;
+
+  if (priv->started)
+    {
+      return -EBUSY;
+    }
+
+  if (priv->timeout == 0)
+    {
+      return -EPERM;
+    }
+
+  flags = enter_critical_section();
+  esp32_tim_configure(priv->tim, TIM_CLK_PER_USEC, true);
+  esp32_tim_setalarm(priv->tim, priv->timeout);
+  priv->started = true;
+  leave_critical_section(flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_timer_stop
+ *
+ * Description:
+ *   Stop the timer.
+ *
+ ****************************************************************************/
+
+static int esp32_timer_stop(FAR struct timer_lowerhalf_s *lower)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv =
+    (FAR struct esp32_timer_lowerhalf_s *)lower;
+  uint32_t cfgaddr = priv->tim->base + TIMG_T_OFFSET(priv->tim->tim) +
+                     TIMG_T_CONFIG_OFFSET;
+  irqstate_t flags;
+
+  if (!priv->started)
+    {
+      return -ENODEV;
+    }
+
+  flags = enter_critical_section();
+  esp32_tim_cancelalarm(priv->tim);
+  modifyreg32(cfgaddr, TIMG_T_EN, 0);
+  priv->started = false;
+  leave_critical_section(flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_timer_getstatus
+ *
+ * Description:
+ *   Get the current timer status.
+ *
+ ****************************************************************************/
+
+static int esp32_timer_getstatus(FAR struct timer_lowerhalf_s *lower,
+                                 FAR struct timer_status_s *status)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv =
+    (FAR struct esp32_timer_lowerhalf_s *)lower;
+  uint64_t elapsed;
+
+  DEBUGASSERT(status != NULL);
+
+  status->flags = 0;
+  if (priv->started)
+    {
+      status->flags |= TCFLAGS_ACTIVE;
+    }
+
+  if (priv->callback != NULL)
+    {
+      status->flags |= TCFLAGS_HANDLER;
+    }
+
+  status->timeout  = priv->timeout;
+  status->timeleft = 0;
+
+  if (priv->started)
+    {
+      elapsed = esp32_tim_getcounter(priv->tim);
+      if (elapsed < priv->timeout)
+        {
+          status->timeleft = priv->timeout - (uint32_t)elapsed;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_timer_settimeout
+ *
+ * Description:
+ *   Set a new timeout value (and reset the timer if it is running).
+ *
+ ****************************************************************************/
+
+static int esp32_timer_settimeout(FAR struct timer_lowerhalf_s *lower,
+                                  uint32_t timeout)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv =
+    (FAR struct esp32_timer_lowerhalf_s *)lower;
+  irqstate_t flags;
+
+  if (timeout == 0)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  priv->timeout = timeout;
+
+  if (priv->started)
+    {
+      esp32_tim_cancelalarm(priv->tim);
+      esp32_tim_setcounter(priv->tim, 0);
+      esp32_tim_setalarm(priv->tim, timeout);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_timer_setcallback
+ *
+ * Description:
+ *   Call this user provided timeout callback on each timeout.
+ *
+ ****************************************************************************/
+
+static void esp32_timer_setcallback(FAR struct timer_lowerhalf_s *lower,
+                                    tccb_t callback, FAR void *arg)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv =
+    (FAR struct esp32_timer_lowerhalf_s *)lower;
+  irqstate_t flags;
+
+  flags          = enter_critical_section();
+  priv->callback = callback;
+  priv->arg      = arg;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: esp32_timer_ioctl
+ *
+ * Description:
+ *   Any ioctl commands that are not recognized by the "upper-half" driver
+ *   are forwarded to the lower half driver through this method.
+ *
+ ****************************************************************************/
+
+static int esp32_timer_ioctl(FAR struct timer_lowerhalf_s *lower, int cmd,
+                             unsigned long arg)
+{
+  return -ENOTTY;
+}
+
+/****************************************************************************
+ * Name: esp32_timer_maxtimeout
+ *
+ * Description:
+ *   Get the maximum supported timeout value.  Any 32-bit microsecond value
+ *   fits the 64-bit counter.
+ *
+ ****************************************************************************/
+
+static int esp32_timer_maxtimeout(FAR struct timer_lowerhalf_s *lower,
+                                  FAR uint32_t *maxtimeout)
+{
+  DEBUGASSERT(maxtimeout != NULL);
+
+  *maxtimeout = UINT32_MAX;
+  return OK;
+}
+#endif /* CONFIG_TIMER */
+
+/****************************************************************************
+ * Name: esp32_oneshot_handler
+ *
+ * Description:
+ *   Oneshot alarm interrupt.  The callback is cleared before it is called
+ *   so that it may restart the oneshot.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_ONESHOT
+static int esp32_oneshot_handler(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct esp32_oneshot_lowerhalf_s *priv =
+    (FAR struct esp32_oneshot_lowerhalf_s *)arg;
+  oneshot_callback_t callback;
+  FAR void *cbarg;
+
+  putreg32(TIMG_T_INT(priv->tim->tim),
+           priv->tim->base + TIMG_INT_CLR_OFFSET);
+
+  if (priv->running)
+    {
+      callback       = priv->callback;
+      cbarg          = priv->arg;
+      priv->running  = false;
+      priv->callback = NULL;
+      priv->arg      = NULL;
+
+      if (callback != NULL)
+        {
+          callback(&priv->lh, cbarg);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_oneshot_max_delay
+ *
+ * Description:
+ *   Determine the maximum delay of the one-shot timer.  The 64-bit counter
+ *   is effectively unlimited.
+ *
+ ****************************************************************************/
+
+static int esp32_oneshot_max_delay(FAR struct oneshot_lowerhalf_s *lower,
+                                   FAR struct timespec *ts)
+{
+  DEBUGASSERT(ts != NULL);
+
+  ts->tv_sec  = INT32_MAX;
+  ts->tv_nsec = NSEC_PER_SEC - 1;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_oneshot_start
+ *
+ * Description:
+ *   Start the oneshot timer, replacing any oneshot that is running.
+ *
+ ****************************************************************************/
+
+static int esp32_oneshot_start(FAR struct oneshot_lowerhalf_s *lower,
+                               oneshot_callback_t callback, FAR void *arg,
+                               FAR const struct timespec *ts)
+{
+  FAR struct esp32_oneshot_lowerhalf_s *priv =
+    (FAR struct esp32_oneshot_lowerhalf_s *)lower;
+  irqstate_t flags;
+  uint64_t usec;
+  uint64_t count;
+
+  DEBUGASSERT(ts != NULL);
+
+  usec  = (uint64_t)ts->tv_sec * USEC_PER_SEC +
+          (uint64_t)(ts->tv_nsec / NSEC_PER_USEC);
+  count = usec / priv->resolution;
+  if (count == 0)
+    {
+      count = 1;
+    }
+
+  flags = enter_critical_section();
+
+  esp32_tim_cancelalarm(priv->tim);
+  priv->callback = callback;
+  priv->arg      = arg;
+  priv->alarm    = esp32_tim_getcounter(priv->tim) + count;
+  priv->running  = true;
+  esp32_tim_setalarm(priv->tim, priv->alarm);
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_oneshot_cancel
+ *
+ * Description:
+ *   Cancel the oneshot timer and return the time remaining.  Zero is
+ *   returned if the oneshot was not running.
+ *
+ ****************************************************************************/
+
+static int esp32_oneshot_cancel(FAR struct oneshot_lowerhalf_s *lower,
+                                FAR struct timespec *ts)
+{
+  FAR struct esp32_oneshot_lowerhalf_s *priv =
+    (FAR struct esp32_oneshot_lowerhalf_s *)lower;
+  irqstate_t flags;
+  uint64_t remaining = 0;
+  uint64_t now;
+
+  flags = enter_critical_section();
+
+  if (priv->running)
+    {
+      esp32_tim_cancelalarm(priv->tim);
+
+      now = esp32_tim_getcounter(priv->tim);
+      if (priv->alarm > now)
+        {
+          remaining = (priv->alarm - now) * priv->resolution;
+        }
+
+      priv->running  = false;
+      priv->callback = NULL;
+      priv->arg      = NULL;
+    }
+
+  leave_critical_section(flags);
+
+  if (ts != NULL)
+    {
+      ts->tv_sec  = remaining / USEC_PER_SEC;
+      ts->tv_nsec = (remaining % USEC_PER_SEC) * NSEC_PER_USEC;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_oneshot_current
+ *
+ * Description:
+ *   Get the time since the oneshot timer was initialized.
+ *
+ ****************************************************************************/
+
+static int esp32_oneshot_current(FAR struct oneshot_lowerhalf_s *lower,
+                                 FAR struct timespec *ts)
+{
+  FAR struct esp32_oneshot_lowerhalf_s *priv =
+    (FAR struct esp32_oneshot_lowerhalf_s *)lower;
+  uint64_t usec;
+
+  DEBUGASSERT(ts != NULL);
+
+  usec        = esp32_tim_getcounter(priv->tim) * priv->resolution;
+  ts->tv_sec  = usec / USEC_PER_SEC;
+  ts->tv_nsec = (usec % USEC_PER_SEC) * NSEC_PER_USEC;
+  return OK;
+}
+#endif /* CONFIG_ESP32_ONESHOT */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_timer_initialize
+ *
+ * Description:
+ *   Bind the timer channel to a timer lower half with one microsecond
+ *   resolution and register it as a timer device at devpath.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TIMER
+int esp32_timer_initialize(FAR const char *devpath, int chan)
+{
+  FAR struct esp32_timer_lowerhalf_s *priv;
+  FAR struct esp32_tim_s *tim;
+  FAR void *handle;
+  int ret;
+
+  tim = esp32_tim_allocate(chan);
+  if (tim == NULL)
+    {
+      return -ENODEV;
+    }
+
+  priv = (FAR struct esp32_timer_lowerhalf_s *)
+    kmm_zalloc(sizeof(struct esp32_timer_lowerhalf_s));
+  if (priv == NULL)
+    {
+      esp32_tim_free(tim);
+      return -ENOMEM;
+    }
+
+  priv->ops = &g_timer_ops;
+  priv->tim = tim;
+
+  ret = esp32_tim_attach(tim, esp32_timer_handler, priv);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  handle = timer_register(devpath, (FAR struct timer_lowerhalf_s *)priv);
+  if (handle == NULL)
+    {
+      ret = -EEXIST;
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  esp32_tim_free(tim);
+  kmm_free(priv);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: oneshot_initialize
+ *
+ * Description:
+ *   Initialize the oneshot timer and return a oneshot lower half driver
+ *   instance.
+ *
+ * Input Parameters:
+ *   chan       Timer channel (0-3)
+ *   resolution The requested resolution of the timer in microseconds
+ *              (1-819).
+ *
+ * Returned Value:
+ *   On success, a non-NULL instance of the oneshot lower-half driver is
+ *   returned.  NULL is return on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_ONESHOT
+FAR struct oneshot_lowerhalf_s *oneshot_initialize(int chan,
+                                                   uint16_t resolution)
+{
+  FAR struct esp32_oneshot_lowerhalf_s *priv;
+  FAR struct esp32_tim_s *tim;
+  uint32_t divider;
+
+  divider = esp32_tim_divider(resolution);
+  if (divider == 0)
+    {
+      return NULL;
+    }
+
+  tim = esp32_tim_allocate(chan);
+  if (tim == NULL)
+    {
+      return NULL;
+    }
+
+  priv = (FAR struct esp32_oneshot_lowerhalf_s *)
+    kmm_zalloc(sizeof(struct esp32_oneshot_lowerhalf_s));
+  if (priv == NULL)
+    {
+      esp32_tim_free(tim);
+      return NULL;
+    }
+
+  priv->lh.ops     = &g_oneshot_ops;
+  priv->tim        = tim;
+  priv->resolution = resolution;
+
+  esp32_tim_configure(tim, divider, false);
+
+  if (esp32_tim_attach(tim, esp32_oneshot_handler, priv) < 0)
+    {
+      esp32_tim_free(tim);
+      kmm_free(priv);
+      return NULL;
+    }
+
+  return &priv->lh;
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_freerun_initialize
+ *
+ * Description:
+ *   Initialize the freerun timer wrapper
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32_FREERUN
+int esp32_freerun_initialize(FAR struct esp32_freerun_s *freerun, int chan,
+                             uint16_t resolution)
+{
+  uint32_t divider;
+
+  DEBUGASSERT(freerun != NULL);
+
+  divider = esp32_tim_divider(resolution);
+  if (divider == 0)
+    {
+      return -EINVAL;
+    }
+
+  freerun->tim = esp32_tim_allocate(chan);
+  if (freerun->tim == NULL)
+    {
+      return -EBUSY;
+    }
+
+  freerun->resolution = resolution;
+  esp32_tim_configure(freerun->tim, divider, false);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_freerun_counter
+ *
+ * Description:
+ *   Read the counter register of the free-running timer.
+ *
+ ****************************************************************************/
+
+int esp32_freerun_counter(FAR struct esp32_freerun_s *freerun,
+                          FAR struct timespec *ts)
+{
+  uint64_t usec;
+
+  DEBUGASSERT(freerun != NULL && freerun->tim != NULL && ts != NULL);
+
+  usec        = esp32_tim_getcounter(freerun->tim) * freerun->resolution;
+  ts->tv_sec  = usec / USEC_PER_SEC;
+  ts->tv_nsec = (usec % USEC_PER_SEC) * NSEC_PER_USEC;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: esp32_freerun_uninitialize
+ *
+ * Description:
+ *   Stop the free-running timer and release all resources that it uses.
+ *
+ ****************************************************************************/
+
+int esp32_freerun_uninitialize(FAR struct esp32_freerun_s *freerun)
+{
+  DEBUGASSERT(freerun != NULL && freerun->tim != NULL);
+
+  esp32_tim_free(freerun->tim);
+  freerun->tim = NULL;
+  return OK;
+}
+#endif /* CONFIG_ESP32_FREERUN */
+
+/****************************************************************************
+ * Name: xtensa_timer_initialize
+ *
+ * Description:
+ *   With CONFIG_ALARM_ARCH, the system timer is a oneshot with one
+ *   microsecond resolution on CONFIG_ESP32_ALARM_TIMER, driven through
+ *   drivers/timers/arch_alarm.c.  This replaces esp32_timerisr.c and
+ *   esp32_tickless.c.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ALARM_ARCH
+void xtensa_timer_initialize(void)
+{
+  FAR struct oneshot_lowerhalf_s *lower;
+
+  lower = oneshot_initialize(CONFIG_ESP32_ALARM_TIMER, 1);
+  DEBUGASSERT(lower != NULL);
+
+  up_alarm_set_lowerhalf(lower);
+}
+#endif
+
+#endif /* CONFIG_ESP32_TIM */
@@ -0,0 +1,193 @@
+/****************************************************************************
+ * arch/xtensa/src/esp32/esp32_tim.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_XTENSA_SRC_ESP32_ESP32_TIM_H
+#define __ARCH_XTENSA_SRC_ESP32_ESP32_TIM_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/timers/oneshot.h>
+
+#ifdef CONFIG_ESP32_TIM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The ESP32 has four 64-bit up-counting timers, two in each timer group.
+ * Channels 0-3 used by the interfaces below correspond to timer group 0
+ * timers 0 and 1 and timer group 1 timers 0 and 1 (CONFIG_ESP32_TIMER0-3).
+ * Each channel may be claimed by only one of these interfaces.  All of the
+ * timers are clocked from the 80MHz APB clock.
+ */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifndef __ASSEMBLY__
+
+struct esp32_tim_s;  /* Forward reference */
+
+#ifdef CONFIG_ESP32_FREERUN
+/* The free-running counter needs no interrupt:  At the finest resolution
+ * of one microsecond, the 64-bit counter wraps after half a million years.
+ */
+
+struct esp32_freerun_s
+{
+  FAR struct esp32_tim_s *tim; /* Underlying timer */
+  uint16_t resolution;         /* Timer resolution in microseconds */
+};
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_timer_initialize
+ *
+ * Description:
+ *   Bind the timer channel to a timer lower half with one microsecond
+ *   resolution and register it as a timer device at devpath (e.g.,
+ *   "/dev/timer0").
+ *
+ * Input Parameters:
+ *   devpath - The full path to the timer device
+ *   chan    - Timer channel (0-3)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TIMER
+int esp32_timer_initialize(FAR const char *devpath, int chan);
+#endif
+
+/* oneshot_initialize() is prototyped in include/nuttx/timers/oneshot.h.
+ * On the ESP32 the resolution may be from 1 to 819 microseconds.
+ */
+
+#ifdef CONFIG_ESP32_FREERUN
+/****************************************************************************
+ * Name: esp32_freerun_initialize
+ *
+ * Description:
+ *   Initialize the freerun timer wrapper
+ *
+ * Input Parameters:
+ *   freerun    Caller allocated instance of the freerun state structure
+ *   chan       Timer channel (0-3)
+ *   resolution The required resolution of the timer in units of
+ *              microseconds (1 to 819).
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int esp32_freerun_initialize(FAR struct esp32_freerun_s *freerun, int chan,
+                             uint16_t resolution);
+
+/****************************************************************************
+ * Name: esp32_freerun_counter
+ *
+ * Description:
+ *   Read the counter register of the free-running timer.
+ *
+ * Input Parameters:
+ *   freerun Caller allocated instance of the freerun state structure.  This
+ *           structure must have been previously initialized via a call to
+ *           esp32_freerun_initialize();
+ *   ts      The location in which to return the time from the free-running
+ *           timer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int esp32_freerun_counter(FAR struct esp32_freerun_s *freerun,
+                          FAR struct timespec *ts);
+
+/****************************************************************************
+ * Name: esp32_freerun_uninitialize
+ *
+ * Description:
+ *   Stop the free-running timer and release all resources that it uses.
+ *
+ * Input Parameters:
+ *   freerun Caller allocated instance of the freerun state structure.  This
+ *           structure must have been previously initialized via a call to
+ *           esp32_freerun_initialize();
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int esp32_freerun_uninitialize(FAR struct esp32_freerun_s *freerun);
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __ASSEMBLY__ */
+#endif /* CONFIG_ESP32_TIM */
+#endif /* __ARCH_XTENSA_SRC_ESP32_ESP32_TIM_H */
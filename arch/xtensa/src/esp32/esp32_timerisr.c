@@ -44,6 +44,7 @@
 #include <debug.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/sched_profile.h>
 #include <arch/xtensa/xtensa_specregs.h>
 #include <arch/board/board.h>
 
@@ -61,52 +62,6 @@ static uint32_t g_tick_divisor;
  * Private Functions
  ****************************************************************************/
 
-/****************************************************************************
- * Function:  xtensa_getcount, xtensa_getcompare, and xtensa_setcompare
- *
- * Description:
- *   Lower level operations on Xtensa special registers.
- *
- ****************************************************************************/
-
-/* Return the current value of the cyle count register */
-
-static inline uint32_t xtensa_getcount(void)
-{
-  uint32_t count;
-
-  __asm__ __volatile__
-  (
-    "rsr %0, CCOUNT"  : "=r"(count)
-  );
-
-  return count;
-}
-
-/* Return the old value of the compare register */
-
-static inline uint32_t xtensa_getcompare(void)
-{
-  uint32_t compare;
-
-  __asm__ __volatile__
-  (
-    "rsr %0, %1"  : "=r"(compare) : "I"(XT_CCOMPARE)
-  );
-
-  return compare;
-}
-
-/* Set the value of the compare register */
-
-static inline void xtensa_setcompare(uint32_t compare)
-{
-  __asm__ __volatile__
-  (
-    "wsr %0, %1" : : "r"(compare), "I"(XT_CCOMPARE)
-  );
-}
-
 /****************************************************************************
  * Function:  esp32_timerisr
  *
@@ -132,6 +87,10 @@ static int esp32_timerisr(int irq, uint32_t *regs, FAR void *arg)
   uint32_t compare;
   uint32_t diff;
 
+  /* Sample the interrupted program counter for the profiler */
+
+  sched_profile_sample(regs[REG_PC]);
+
   divisor = g_tick_divisor;
   do
     {
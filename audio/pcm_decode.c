@@ -53,6 +53,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/audio/audio.h>
 #include <nuttx/audio/pcm.h>
@@ -121,6 +122,7 @@ struct pcm_decode_s
   uint8_t  bpsamp;                 /* Bits per sample: 8 bits = 8, 16 bits = 16 */
   uint8_t  nchannels;              /* Mono=1, Stereo=2 */
   bool     streaming;              /* Streaming PCM data chunk */
+  uint32_t nqueued;                /* Bytes enqueued to the lower driver */
 
 #ifndef CONFIG_AUDIO_EXCLUDE_FFORWARD
   /* Fast forward support */
@@ -145,7 +147,9 @@ static void pcm_dump(FAR const struct wav_header_s *wav);
 
 #ifdef CONFIG_ENDIAN_BIG
 static uint16_t pcm_leuint16(uint16_t value);
-static uint16_t pcm_leuint32(uint32_t value);
+static uint32_t pcm_leuint32(uint32_t value);
+static void pcm_swapsamples(FAR struct pcm_decode_s *priv,
+              FAR struct ap_buffer_s *apb);
 #else
 #  define pcm_leuint16(v) (v)
 #  define pcm_leuint32(v) (v)
@@ -161,6 +165,10 @@ static void pcm_subsample(FAR struct pcm_decode_s *priv,
               FAR struct ap_buffer_s *apb);
 #endif
 
+static int  pcm_lowerenqueue(FAR struct pcm_decode_s *priv,
+              FAR struct ap_buffer_s *apb);
+static uint32_t pcm_latency(FAR struct pcm_decode_s *priv);
+
 /* struct audio_lowerhalf_s methods *****************************************/
 
 static int  pcm_getcaps(FAR struct audio_lowerhalf_s *dev, int type,
@@ -299,16 +307,16 @@ static uint16_t pcm_leuint16(uint16_t value)
 #endif
 
 /****************************************************************************
- * Name: pcm_leuint16
+ * Name: pcm_leuint32
  *
  * Description:
- *   Get a 16-bit value stored in little endian order for a big-endian
+ *   Get a 32-bit value stored in little endian order for a big-endian
  *   machine.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_ENDIAN_BIG
-static uint16_t pcm_leuint32(uint32_t value)
+static uint32_t pcm_leuint32(uint32_t value)
 {
   return (((value & 0x000000ff) << 24) |
           ((value & 0x0000ff00) <<  8) |
@@ -317,6 +325,39 @@ static uint16_t pcm_leuint32(uint32_t value)
 }
 #endif
 
+/****************************************************************************
+ * Name: pcm_swapsamples
+ *
+ * Description:
+ *   WAV sample data is little endian.  Convert 16-bit samples to the
+ *   native byte order of a big-endian machine in-place in the audio buffer
+ *   so that the lower half driver can transfer the buffer as-is.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENDIAN_BIG
+static void pcm_swapsamples(FAR struct pcm_decode_s *priv,
+                            FAR struct ap_buffer_s *apb)
+{
+  FAR uint8_t *ptr;
+  FAR uint8_t *end;
+  uint8_t tmp;
+
+  if (priv->bpsamp == 16)
+    {
+      ptr = &apb->samp[apb->curbyte];
+      end = ptr + ((apb->nbytes - apb->curbyte) & ~1);
+
+      for (; ptr < end; ptr += 2)
+        {
+          tmp    = ptr[0];
+          ptr[0] = ptr[1];
+          ptr[1] = tmp;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: pcm_validwav
  *
@@ -402,14 +443,14 @@ static bool pcm_parsewav(FAR struct pcm_decode_s *priv, uint8_t *data)
         {
           auderr("ERROR: Cannot support bits per sample of %d in this mode\n",
                  priv->bpsamp);
-          return -EINVAL;
+          return false;
         }
 
       if (priv->nchannels != 1 && priv->nchannels != 2)
         {
           auderr("ERROR: Cannot support number of channles of %d in this mode\n",
                  priv->nchannels);
-          return -EINVAL;
+          return false;
         }
 
       DEBUGASSERT(priv->align == priv->nchannels * priv->bpsamp / 8);
@@ -661,6 +702,82 @@ static void pcm_subsample(FAR struct pcm_decode_s *priv,
 }
 #endif
 
+/****************************************************************************
+ * Name: pcm_lowerenqueue
+ *
+ * Description:
+ *   Give a decoded audio buffer to the lower driver.  The buffer itself is
+ *   passed along; the sample data is never copied.  The number of bytes
+ *   outstanding in the lower driver is accounted for latency reporting.
+ *
+ ****************************************************************************/
+
+static int pcm_lowerenqueue(FAR struct pcm_decode_s *priv,
+                            FAR struct ap_buffer_s *apb)
+{
+  FAR struct audio_lowerhalf_s *lower = priv->lower;
+  apb_samp_t nbytes;
+  irqstate_t flags;
+  int ret;
+
+#ifdef CONFIG_ENDIAN_BIG
+  /* Convert the samples to native byte order in-place */
+
+  pcm_swapsamples(priv, apb);
+#endif
+
+  audinfo("Pass to lower enqueuebuffer: apb=%p curbyte=%d nbytes=%d\n",
+          apb, apb->curbyte, apb->nbytes);
+
+  /* Account for the buffer before enqueuing it; the lower driver may
+   * return the buffer before enqueuebuffer() returns.
+   */
+
+  nbytes = apb->nbytes - apb->curbyte;
+
+  flags = enter_critical_section();
+  priv->nqueued += nbytes;
+  leave_critical_section(flags);
+
+  ret = lower->ops->enqueuebuffer(lower, apb);
+  if (ret < 0)
+    {
+      flags = enter_critical_section();
+      priv->nqueued -= nbytes;
+      leave_critical_section(flags);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pcm_latency
+ *
+ * Description:
+ *   Return the playback time, in microseconds, of the audio data that has
+ *   been enqueued to the lower driver but not yet returned.
+ *
+ ****************************************************************************/
+
+static uint32_t pcm_latency(FAR struct pcm_decode_s *priv)
+{
+  uint32_t nqueued;
+
+  if (priv->byterate == 0)
+    {
+      return 0;
+    }
+
+  nqueued = priv->nqueued;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  return (uint32_t)(((uint64_t)nqueued * 1000000) / priv->byterate);
+#else
+  return (nqueued / priv->byterate) * 1000000 +
+         ((nqueued % priv->byterate) * 1000) / priv->byterate * 1000;
+#endif
+}
+
 /****************************************************************************
  * Name: pcm_getcaps
  *
@@ -1058,10 +1175,7 @@ static int pcm_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
 
       /* Then give the audio buffer to the lower driver */
 
-      audinfo("Pass to lower enqueuebuffer: apb=%p curbyte=%d nbytes=%d\n",
-              apb, apb->curbyte, apb->nbytes);
-
-      return lower->ops->enqueuebuffer(lower, apb);
+      return pcm_lowerenqueue(priv, apb);
     }
 
   /* No.. then this must be the first buffer that we have seen (since we
@@ -1121,10 +1235,7 @@ static int pcm_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
 
           /* Then give the audio buffer to the lower driver */
 
-          audinfo("Pass to lower enqueuebuffer: apb=%p curbyte=%d nbytes=%d\n",
-                  apb, apb->curbyte, apb->nbytes);
-
-          ret = lower->ops->enqueuebuffer(lower, apb);
+          ret = pcm_lowerenqueue(priv, apb);
           if (ret == OK)
             {
               /* Now we are streaming.  Unless for some reason there is only
@@ -1208,12 +1319,25 @@ static int pcm_ioctl(FAR struct audio_lowerhalf_s *dev, int cmd,
 
   DEBUGASSERT(priv);
 
+  /* The PCM decoder handles latency reporting itself since it knows the
+   * format of the audio data.
+   */
+
+  if (cmd == AUDIOIOC_GETLATENCY)
+    {
+      FAR uint32_t *latency = (FAR uint32_t *)((uintptr_t)arg);
+
+      DEBUGASSERT(latency != NULL);
+      *latency = pcm_latency(priv);
+      return OK;
+    }
+
   /* Defer the operation to the lower device driver */
 
   lower = priv->lower;
   DEBUGASSERT(lower && lower->ops->ioctl);
 
-  audinfo("Defer to lower ioctl, cmd=%d arg=%ld\n");
+  audinfo("Defer to lower ioctl, cmd=%d arg=%ld\n", cmd, arg);
   return lower->ops->ioctl(lower, cmd, arg);
 }
 
@@ -1332,9 +1456,25 @@ static void pcm_callback(FAR void *arg, uint16_t reason,
 #endif
 {
   FAR struct pcm_decode_s *priv = (FAR struct pcm_decode_s *)arg;
+  irqstate_t flags;
 
   DEBUGASSERT(priv && priv->export.upper);
 
+  /* Update the count of bytes outstanding in the lower driver */
+
+  if (reason == AUDIO_CALLBACK_DEQUEUE && apb != NULL)
+    {
+      apb_samp_t nbytes = apb->nbytes - apb->curbyte;
+
+      flags = enter_critical_section();
+      priv->nqueued -= MIN(nbytes, priv->nqueued);
+      leave_critical_section(flags);
+    }
+  else if (reason == AUDIO_CALLBACK_COMPLETE)
+    {
+      priv->nqueued = 0;
+    }
+
   /* The buffer belongs to to an upper level.  Just forward the event to
    * the next level up.
    */
@@ -148,7 +148,7 @@ int exec_module(FAR const struct binary_s *binp)
 
   /* Allocate a TCB for the new task. */
 
-  tcb = (FAR struct task_tcb_s *)kmm_zalloc(sizeof(struct task_tcb_s));
+  tcb = (FAR struct task_tcb_s *)sched_tcballoc(sizeof(struct task_tcb_s));
   if (!tcb)
     {
       return -ENOMEM;
@@ -300,7 +300,7 @@ errout_with_addrenv:
 
 errout_with_tcb:
 #endif
-  kmm_free(tcb);
+  sched_tcbfree(&tcb->cmn);
   return ret;
 }
 
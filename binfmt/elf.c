@@ -259,7 +259,17 @@ static int elf_loadbinary(FAR struct binary_s *binp)
 
   /* Return the load information */
 
-  binp->entrypt   = (main_t)(loadinfo.textalloc + loadinfo.ehdr.e_entry);
+#ifdef CONFIG_ELF_XIP
+  if (loadinfo.xipbase != 0)
+    {
+      binp->entrypt = (main_t)loadinfo.xipentry;
+    }
+  else
+#endif
+    {
+      binp->entrypt = (main_t)(loadinfo.textalloc + loadinfo.ehdr.e_entry);
+    }
+
   binp->stacksize = CONFIG_ELF_STACKSIZE;
 
   /* Add the ELF allocation to the alloc[] only if there is no address
@@ -46,12 +46,126 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <limits.h>
+#include <sched.h>
 #include <errno.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/binfmt/builtin.h>
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILTIN_HASH
+/* Open addressed hash table of indices into the builtin application table.
+ * Unused buckets hold -1.  g_builtin_hashmask is zero until the table has
+ * been built.
+ */
+
+static FAR int16_t *g_builtin_hash;
+static unsigned int g_builtin_hashmask;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILTIN_HASH
+/****************************************************************************
+ * Name: builtin_hashname
+ *
+ * Description:
+ *   Hash an application name (FNV-1a).
+ *
+ ****************************************************************************/
+
+static unsigned int builtin_hashname(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+  int i;
+
+  for (i = 0; i < NAME_MAX && name[i] != '\0'; i++)
+    {
+      hash ^= (uint8_t)name[i];
+      hash *= 16777619u;
+    }
+
+  return (unsigned int)hash;
+}
+
+/****************************************************************************
+ * Name: builtin_buildhash
+ *
+ * Description:
+ *   Build the hash table from the builtin application table.  If a name
+ *   appears more than once, the first entry is kept so that the result is
+ *   the same as that of the linear search.
+ *
+ ****************************************************************************/
+
+static void builtin_buildhash(void)
+{
+  FAR const char *name;
+  FAR int16_t *hash;
+  unsigned int nbuckets;
+  unsigned int bucket;
+  int count;
+  int i;
+
+  sched_lock();
+  if (g_builtin_hashmask != 0)
+    {
+      sched_unlock();
+      return;
+    }
+
+  for (count = 0; builtin_getname(count) != NULL; count++)
+    {
+    }
+
+  /* Keep the table at most half full */
+
+  for (nbuckets = 8; nbuckets < 2 * (unsigned int)count; nbuckets <<= 1)
+    {
+    }
+
+  if (count > INT16_MAX ||
+      (hash = (FAR int16_t *)kmm_malloc(nbuckets * sizeof(int16_t))) == NULL)
+    {
+      sched_unlock();
+      return;
+    }
+
+  memset(hash, 0xff, nbuckets * sizeof(int16_t));
+
+  for (i = 0; i < count; i++)
+    {
+      name = builtin_getname(i);
+      for (bucket = builtin_hashname(name) & (nbuckets - 1);
+           hash[bucket] >= 0;
+           bucket = (bucket + 1) & (nbuckets - 1))
+        {
+          if (!strncmp(builtin_getname(hash[bucket]), name, NAME_MAX))
+            {
+              break;
+            }
+        }
+
+      if (hash[bucket] < 0)
+        {
+          hash[bucket] = (int16_t)i;
+        }
+    }
+
+  g_builtin_hash     = hash;
+  g_builtin_hashmask = nbuckets - 1;
+  sched_unlock();
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -70,6 +184,33 @@ int builtin_isavail(FAR const char *appname)
   FAR const char *name;
   int i;
 
+#ifdef CONFIG_BUILTIN_HASH
+  unsigned int bucket;
+
+  if (g_builtin_hashmask == 0)
+    {
+      builtin_buildhash();
+    }
+
+  if (g_builtin_hashmask != 0)
+    {
+      for (bucket = builtin_hashname(appname) & g_builtin_hashmask;
+           (i = g_builtin_hash[bucket]) >= 0;
+           bucket = (bucket + 1) & g_builtin_hashmask)
+        {
+          if (!strncmp(builtin_getname(i), appname, NAME_MAX))
+            {
+              return i;
+            }
+        }
+
+      set_errno(ENOENT);
+      return ERROR;
+    }
+#endif
+
+  /* Search the table linearly */
+
   for (i = 0; (name = builtin_getname(i)); i++)
     {
       if (!strncmp(name, appname, NAME_MAX))
@@ -99,6 +99,25 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
 
 int elf_loadshdrs(FAR struct elf_loadinfo_s *loadinfo);
 
+/****************************************************************************
+ * Name: elf_hdrcache_lookup and elf_hdrcache_add
+ *
+ * Description:
+ *   elf_hdrcache_lookup() sets up loadinfo->ehdr and loadinfo->shdr from
+ *   the header cache if the file described by loadinfo (filename, filelen
+ *   and filetime) was loaded recently.  elf_hdrcache_add() remembers the
+ *   headers of loadinfo after they have been read from the file.
+ *
+ * Returned Value:
+ *   elf_hdrcache_lookup() returns true on a cache hit.
+ *
+ ****************************************************************************/
+
+#if CONFIG_ELF_HDRCACHE > 0
+bool elf_hdrcache_lookup(FAR struct elf_loadinfo_s *loadinfo);
+void elf_hdrcache_add(FAR const struct elf_loadinfo_s *loadinfo);
+#endif
+
 /****************************************************************************
  * Name: elf_findsection
  *
@@ -129,6 +129,17 @@ int elf_addrenv_alloc(FAR struct elf_loadinfo_s *loadinfo, size_t textsize,
   loadinfo->dataalloc = (uintptr_t)vdata;
   return OK;
 #else
+  /* There may be nothing to allocate if the text is executed in place and
+   * there is no .data or .bss.
+   */
+
+  if (textsize + datasize == 0)
+    {
+      loadinfo->textalloc = 0;
+      loadinfo->dataalloc = 0;
+      return OK;
+    }
+
   /* Allocate memory to hold the ELF image */
 
   loadinfo->textalloc = (uintptr_t)kumm_malloc(textsize + datasize);
@@ -0,0 +1,228 @@
+/****************************************************************************
+ * binfmt/libelf/libelf_hdrcache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sched.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/binfmt/elf.h>
+
+#include "libelf.h"
+
+#if CONFIG_ELF_HDRCACHE > 0
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The headers of one recently loaded ELF file.  The section headers are
+ * kept as read from the file, before any section address is assigned.
+ */
+
+struct elf_hdrcache_s
+{
+  FAR char          *filename;  /* Path of the file (NULL: unused) */
+  off_t              filelen;   /* Length of the file */
+  time_t             filetime;  /* Modification time of the file */
+  Elf32_Ehdr         ehdr;      /* Verified ELF header */
+  FAR Elf32_Shdr    *shdr;      /* Section header table */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct elf_hdrcache_s g_elf_hdrcache[CONFIG_ELF_HDRCACHE];
+static unsigned int g_elf_hdrnext;   /* Next entry to replace */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_hdrcache_find
+ *
+ * Description:
+ *   Find the cache entry for a file name.  Must be called with pre-emption
+ *   disabled.
+ *
+ ****************************************************************************/
+
+static FAR struct elf_hdrcache_s *elf_hdrcache_find(FAR const char *filename)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_ELF_HDRCACHE; i++)
+    {
+      if (g_elf_hdrcache[i].filename != NULL &&
+          strcmp(g_elf_hdrcache[i].filename, filename) == 0)
+        {
+          return &g_elf_hdrcache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: elf_hdrcache_shdrsize
+ *
+ * Description:
+ *   Return the size of the section header table described by an ELF header
+ *
+ ****************************************************************************/
+
+static inline size_t elf_hdrcache_shdrsize(FAR const Elf32_Ehdr *ehdr)
+{
+  return (size_t)ehdr->e_shentsize * (size_t)ehdr->e_shnum;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_hdrcache_lookup
+ *
+ * Description:
+ *   Set up loadinfo->ehdr and a private copy of the section header table
+ *   in loadinfo->shdr from the cache.
+ *
+ * Returned Value:
+ *   true on a cache hit; false if the headers must be read from the file.
+ *
+ ****************************************************************************/
+
+bool elf_hdrcache_lookup(FAR struct elf_loadinfo_s *loadinfo)
+{
+  FAR struct elf_hdrcache_s *entry;
+  FAR Elf32_Shdr *shdr = NULL;
+  size_t shdrsize = 0;
+  bool hit = false;
+
+  sched_lock();
+  entry = elf_hdrcache_find(loadinfo->filename);
+  if (entry != NULL && entry->filelen == loadinfo->filelen &&
+      entry->filetime == loadinfo->filetime)
+    {
+      shdrsize = elf_hdrcache_shdrsize(&entry->ehdr);
+      shdr     = (FAR Elf32_Shdr *)kmm_malloc(shdrsize);
+      if (shdr != NULL)
+        {
+          memcpy(&loadinfo->ehdr, &entry->ehdr, sizeof(Elf32_Ehdr));
+          memcpy(shdr, entry->shdr, shdrsize);
+          loadinfo->shdr = shdr;
+          hit            = true;
+        }
+    }
+
+  sched_unlock();
+
+  if (hit)
+    {
+      binfo("Using cached headers for %s\n", loadinfo->filename);
+    }
+
+  return hit;
+}
+
+/****************************************************************************
+ * Name: elf_hdrcache_add
+ *
+ * Description:
+ *   Remember the headers of loadinfo after elf_loadshdrs() has read them.
+ *   The least recently added entry is replaced if the cache is full.  A
+ *   failure to allocate memory simply leaves the file uncached.
+ *
+ ****************************************************************************/
+
+void elf_hdrcache_add(FAR const struct elf_loadinfo_s *loadinfo)
+{
+  FAR struct elf_hdrcache_s *entry;
+  FAR Elf32_Shdr *shdr;
+  FAR char *filename;
+  size_t shdrsize;
+  size_t namelen;
+
+  namelen  = strlen(loadinfo->filename) + 1;
+  shdrsize = elf_hdrcache_shdrsize(&loadinfo->ehdr);
+
+  filename = (FAR char *)kmm_malloc(namelen);
+  shdr     = (FAR Elf32_Shdr *)kmm_malloc(shdrsize);
+  if (filename == NULL || shdr == NULL)
+    {
+      kmm_free(filename);
+      kmm_free(shdr);
+      return;
+    }
+
+  memcpy(filename, loadinfo->filename, namelen);
+  memcpy(shdr, loadinfo->shdr, shdrsize);
+
+  sched_lock();
+  entry = elf_hdrcache_find(loadinfo->filename);
+  if (entry == NULL)
+    {
+      entry         = &g_elf_hdrcache[g_elf_hdrnext];
+      g_elf_hdrnext = (g_elf_hdrnext + 1) % CONFIG_ELF_HDRCACHE;
+    }
+
+  /* Release the previous contents of the entry */
+
+  if (entry->filename != NULL)
+    {
+      kmm_free(entry->filename);
+      kmm_free(entry->shdr);
+    }
+
+  entry->filename = filename;
+  entry->filelen  = loadinfo->filelen;
+  entry->filetime = loadinfo->filetime;
+  entry->shdr     = shdr;
+  memcpy(&entry->ehdr, &loadinfo->ehdr, sizeof(Elf32_Ehdr));
+  sched_unlock();
+}
+
+#endif /* CONFIG_ELF_HDRCACHE > 0 */
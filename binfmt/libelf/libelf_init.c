@@ -121,6 +121,10 @@ static inline int elf_filelen(FAR struct elf_loadinfo_s *loadinfo,
   /* Return the size of the file in the loadinfo structure */
 
   loadinfo->filelen = buf.st_size;
+#if CONFIG_ELF_HDRCACHE > 0
+  loadinfo->filename = filename;
+  loadinfo->filetime = buf.st_mtime;
+#endif
   return OK;
 }
 
@@ -170,6 +174,17 @@ int elf_init(FAR const char *filename, FAR struct elf_loadinfo_s *loadinfo)
       return ret;
     }
 
+#if CONFIG_ELF_HDRCACHE > 0
+  /* The headers need not be read or verified again if this file was
+   * loaded recently.
+   */
+
+  if (elf_hdrcache_lookup(loadinfo))
+    {
+      return OK;
+    }
+#endif
+
   /* Read the ELF ehdr from offset 0 */
 
   ret = elf_read(loadinfo, (FAR uint8_t *)&loadinfo->ehdr, sizeof(Elf32_Ehdr), 0);
@@ -41,6 +41,7 @@
 
 #include <sys/types.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -49,6 +50,10 @@
 #include <errno.h>
 #include <debug.h>
 
+#ifdef CONFIG_ELF_XIP
+#  include <sys/ioctl.h>
+#endif
+
 #include <nuttx/arch.h>
 #include <nuttx/addrenv.h>
 #include <nuttx/mm/mm.h>
@@ -80,6 +85,101 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: elf_xipsection
+ *
+ * Description:
+ *   Return true if the section at index 'shndx' can be executed in place
+ *   from the memory-mapped file at loadinfo->xipbase.  That requires a
+ *   read-only section with data in the file, suitably aligned at its file
+ *   offset, and with no relocation section that applies to it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_XIP
+static bool elf_xipsection(FAR struct elf_loadinfo_s *loadinfo, int shndx)
+{
+  FAR Elf32_Shdr *shdr = &loadinfo->shdr[shndx];
+  uintptr_t align;
+  int i;
+
+  if (shdr->sh_type == SHT_NOBITS)
+    {
+      return false;
+    }
+
+  align = MAX(shdr->sh_addralign, 1);
+  if (((loadinfo->xipbase + shdr->sh_offset) & (align - 1)) != 0)
+    {
+      return false;
+    }
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf32_Shdr *relsec = &loadinfo->shdr[i];
+
+      if ((relsec->sh_type == SHT_REL || relsec->sh_type == SHT_RELA) &&
+          relsec->sh_info == shndx && relsec->sh_size > 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: elf_xipinit
+ *
+ * Description:
+ *   Determine if the read-only sections of the ELF file can be executed in
+ *   place.  If so, loadinfo->xipbase is set to the address of the memory-
+ *   mapped file; otherwise it is left zero and all sections will be loaded
+ *   into RAM.  Read-only sections are treated as a whole so that the text
+ *   layout (and hence e_entry) is either entirely in place or entirely in
+ *   RAM.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_XIP
+static void elf_xipinit(FAR struct elf_loadinfo_s *loadinfo)
+{
+  FAR void *addr = NULL;
+  int ret;
+  int i;
+
+  loadinfo->xipbase  = 0;
+  loadinfo->xipentry = 0;
+
+  /* Only file systems with directly addressable storage support FIOC_MMAP */
+
+  ret = ioctl(loadinfo->filfd, FIOC_MMAP, (unsigned long)((uintptr_t)&addr));
+  if (ret < 0 || addr == NULL)
+    {
+      binfo("File cannot be executed in place\n");
+      return;
+    }
+
+  loadinfo->xipbase = (uintptr_t)addr;
+
+  for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf32_Shdr *shdr = &loadinfo->shdr[i];
+
+      if ((shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) == SHF_ALLOC &&
+          !elf_xipsection(loadinfo, i))
+        {
+          binfo("Section %d cannot be executed in place\n", i);
+          loadinfo->xipbase = 0;
+          return;
+        }
+    }
+
+  binfo("Executing in place at %08lx\n", (unsigned long)loadinfo->xipbase);
+}
+#endif
+
 /****************************************************************************
  * Name: elf_elfsize
  *
@@ -121,6 +221,12 @@ static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
             {
               datasize += ELF_ALIGNUP(shdr->sh_size);
             }
+#ifdef CONFIG_ELF_XIP
+          else if (loadinfo->xipbase != 0)
+            {
+              /* Read-only sections are executed in place */
+            }
+#endif
           else
             {
               textsize += ELF_ALIGNUP(shdr->sh_size);
@@ -152,6 +258,9 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
   FAR uint8_t *text;
   FAR uint8_t *data;
   FAR uint8_t **pptr;
+#ifdef CONFIG_ELF_XIP
+  uintptr_t textoff = 0;
+#endif
   int ret;
   int i;
 
@@ -183,6 +292,28 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
         }
       else
         {
+#ifdef CONFIG_ELF_XIP
+          if (loadinfo->xipbase != 0)
+            {
+              /* The section is used in place in the memory-mapped file.
+               * Keep the offset that the section would have had in the
+               * RAM .text image in order to locate the entry point.
+               */
+
+              shdr->sh_addr = loadinfo->xipbase + shdr->sh_offset;
+              if (loadinfo->ehdr.e_entry >= textoff &&
+                  loadinfo->ehdr.e_entry < textoff + shdr->sh_size)
+                {
+                  loadinfo->xipentry = shdr->sh_addr +
+                                       loadinfo->ehdr.e_entry - textoff;
+                }
+
+              binfo("%d. XIP %08lx\n", i, (unsigned long)shdr->sh_addr);
+              textoff += ELF_ALIGNUP(shdr->sh_size);
+              continue;
+            }
+#endif
+
           pptr = &text;
         }
 
@@ -192,13 +323,26 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
 
       if (shdr->sh_type != SHT_NOBITS)
         {
-          /* Read the section data from sh_offset to the memory region */
+#ifdef CONFIG_ELF_XIP
+          /* If the file is memory-mapped, copy the data directly */
 
-          ret = elf_read(loadinfo, *pptr, shdr->sh_size, shdr->sh_offset);
-          if (ret < 0)
+          if (loadinfo->xipbase != 0)
+            {
+              memcpy(*pptr, (FAR const void *)
+                     (loadinfo->xipbase + shdr->sh_offset), shdr->sh_size);
+            }
+          else
+#endif
             {
-              berr("ERROR: Failed to read section %d: %d\n", i, ret);
-              return ret;
+              /* Read the section data from sh_offset to the memory region */
+
+              ret = elf_read(loadinfo, *pptr, shdr->sh_size,
+                             shdr->sh_offset);
+              if (ret < 0)
+                {
+                  berr("ERROR: Failed to read section %d: %d\n", i, ret);
+                  return ret;
+                }
             }
         }
 
@@ -263,6 +407,12 @@ int elf_load(FAR struct elf_loadinfo_s *loadinfo)
       goto errout_with_buffers;
     }
 
+#ifdef CONFIG_ELF_XIP
+  /* Check if the read-only sections can be executed in place */
+
+  elf_xipinit(loadinfo);
+#endif
+
   /* Determine total size to allocate */
 
   elf_elfsize(loadinfo);
@@ -189,6 +189,15 @@ int elf_loadshdrs(FAR struct elf_loadinfo_s *loadinfo)
   size_t shdrsize;
   int ret;
 
+#if CONFIG_ELF_HDRCACHE > 0
+  /* The section headers may already have been taken from the cache */
+
+  if (loadinfo->shdr != NULL)
+    {
+      return OK;
+    }
+#endif
+
   DEBUGASSERT(loadinfo->shdr == NULL);
 
   /* Verify that there are sections */
@@ -226,6 +235,12 @@ int elf_loadshdrs(FAR struct elf_loadinfo_s *loadinfo)
     {
       berr("Failed to read section header table: %d\n", ret);
     }
+#if CONFIG_ELF_HDRCACHE > 0
+  else
+    {
+      elf_hdrcache_add(loadinfo);
+    }
+#endif
 
   return ret;
 }
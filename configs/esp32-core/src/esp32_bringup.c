@@ -42,13 +42,112 @@
 #include <sys/types.h>
 #include <sys/mount.h>
 #include <syslog.h>
+#include <errno.h>
 
+#include <nuttx/init.h>
+#include <nuttx/kthread.h>
+
+#include "esp32_rng.h"
 #include "esp32-core.h"
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32CORE_DEFERRED_INIT
+/* One entry in the deferred initialization list */
+
+struct esp32_deferred_s
+{
+  FAR const char *name;        /* Name of the boot phase */
+  CODE int (*initialize)(void);
+};
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#if defined(CONFIG_ESP32CORE_DEFERRED_INIT) && defined(CONFIG_FS_TMPFS)
+static int esp32_tmpfs_initialize(void);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32CORE_DEFERRED_INIT
+/* Drivers and file systems that are not needed to bring up the application
+ * and the network.  These are initialized in order by esp32_deferred()
+ * after esp32_bringup() returns.
+ */
+
+static const struct esp32_deferred_s g_deferred_init[] =
+{
+#ifdef CONFIG_FS_TMPFS
+  { "tmpfs",        esp32_tmpfs_initialize },
+#endif
+  { NULL,           NULL }
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: esp32_tmpfs_initialize
+ *
+ * Description:
+ *   Mount the TMPFS file system at /tmp
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ESP32CORE_DEFERRED_INIT) && defined(CONFIG_FS_TMPFS)
+static int esp32_tmpfs_initialize(void)
+{
+  int ret;
+
+  ret = mount(NULL, "/tmp", "tmpfs", 0, NULL);
+  return ret < 0 ? -errno : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: esp32_deferred
+ *
+ * Description:
+ *   Kernel thread that performs the deferred initialization.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ESP32CORE_DEFERRED_INIT
+static int esp32_deferred(int argc, FAR char *argv[])
+{
+  FAR const struct esp32_deferred_s *entry;
+  int ret;
+
+  for (entry = g_deferred_init; entry->initialize != NULL; entry++)
+    {
+      ret = entry->initialize();
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: Deferred %s initialization failed: %d\n",
+                 entry->name, ret);
+        }
+
+      os_bootphase(entry->name);
+    }
+
+  os_bootphase("deferred");
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -81,6 +180,30 @@ int esp32_bringup(void)
     }
 #endif
 
+#ifdef CONFIG_ESP32_RNG
+  /* Feed the hardware random number generator into the entropy pool */
+
+  ret = esp32_rng_initialize();
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: esp32_rng_initialize failed: %d\n", ret);
+    }
+#endif
+
+#ifdef CONFIG_ESP32CORE_DEFERRED_INIT
+  /* Then start the thread that will initialize the non-critical drivers */
+
+  ret = kthread_create("deferinit", CONFIG_ESP32CORE_DEFERRED_PRIORITY,
+                       CONFIG_ESP32CORE_DEFERRED_STACKSIZE,
+                       (main_t)esp32_deferred, (FAR char * const *)NULL);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to start deferinit: %d\n", ret);
+    }
+#endif
+
+  os_bootphase("bringup");
+
   /* If we got here then perhaps not all initialization was successful, but
    * at least enough succeeded to bring-up NSH with perhaps reduced
    * capabilities.
@@ -111,6 +111,19 @@ int sim_bringup(void);
 int sim_zoneinfo(int minor);
 #endif
 
+/****************************************************************************
+ * Name: sim_fsbench_initialize
+ *
+ * Description:
+ *   Create and mount a volume for each selected file system for use by a
+ *   file system benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_FSBENCH
+int sim_fsbench_initialize(void);
+#endif
+
 /****************************************************************************
  * Name: sim_gpio_initialize
  *
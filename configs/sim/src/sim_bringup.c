@@ -102,7 +102,7 @@ int sim_bringup(void)
 #ifdef CONFIG_ONESHOT
   FAR struct oneshot_lowerhalf_s *oneshot;
 #endif
-#ifdef CONFIG_RAMMTD
+#if defined(CONFIG_RAMMTD) && !defined(CONFIG_SIM_FSBENCH)
   FAR uint8_t *ramstart;
 #endif
   int ret;
@@ -136,7 +136,12 @@ int sim_bringup(void)
   (void)sim_gpio_initialize();
 #endif
 
-#ifdef CONFIG_RAMMTD
+#if defined(CONFIG_SIM_FSBENCH)
+  /* Create the file system benchmark volumes */
+
+  (void)sim_fsbench_initialize();
+
+#elif defined(CONFIG_RAMMTD)
   /* Create a RAM MTD device if configured */
 
   ramstart = (FAR uint8_t *)kmm_malloc(128 * 1024);
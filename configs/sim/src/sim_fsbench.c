@@ -0,0 +1,216 @@
+/****************************************************************************
+ * configs/sim/src/sim_fsbench.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mount.h>
+#include <stdint.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/nxffs.h>
+#include <nuttx/mtd/mtd.h>
+
+#include "sim.h"
+
+#ifdef CONFIG_SIM_FSBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Do we need any RAM MTD devices? */
+
+#undef HAVE_FSBENCH_MTD
+#if defined(CONFIG_FS_LITTLEFS) || defined(CONFIG_FS_NXFFS) || \
+    (defined(CONFIG_MTD_SMART) && defined(CONFIG_FS_SMARTFS))
+#  define HAVE_FSBENCH_MTD 1
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_fsbench_mtd
+ *
+ * Description:
+ *   Allocate and erase a RAM MTD device for one benchmark volume.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_FSBENCH_MTD
+static FAR struct mtd_dev_s *sim_fsbench_mtd(void)
+{
+  FAR struct mtd_dev_s *mtd;
+  FAR uint8_t *ramstart;
+  int ret;
+
+  ramstart = (FAR uint8_t *)kmm_malloc(CONFIG_SIM_FSBENCH_MTDSIZE);
+  if (ramstart == NULL)
+    {
+      syslog(LOG_ERR, "ERROR: Allocation for RAM MTD failed\n");
+      return NULL;
+    }
+
+  mtd = rammtd_initialize(ramstart, CONFIG_SIM_FSBENCH_MTDSIZE);
+  if (mtd == NULL)
+    {
+      syslog(LOG_ERR, "ERROR: rammtd_initialize failed\n");
+      kmm_free(ramstart);
+      return NULL;
+    }
+
+  ret = mtd->ioctl(mtd, MTDIOC_BULKERASE, 0);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: IOCTL MTDIOC_BULKERASE failed\n");
+    }
+
+  return mtd;
+}
+#endif
+
+/****************************************************************************
+ * Name: sim_fsbench_mount
+ ****************************************************************************/
+
+static void sim_fsbench_mount(FAR const char *source, FAR const char *target,
+                              FAR const char *fstype, FAR const void *data)
+{
+  int ret = mount(source, target, fstype, 0, data);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to mount %s at %s: %d\n",
+             fstype, target, ret);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_fsbench_initialize
+ *
+ * Description:
+ *   Create a volume for each of the selected file systems so that they can
+ *   be compared by a file system benchmark:
+ *
+ *     /mnt/fat     - FAT on the /dev/ram0 RAM disk image
+ *     /mnt/tmpfs   - tmpfs
+ *     /mnt/lfs     - littlefs on a RAM MTD device
+ *     /mnt/smartfs - SmartFS on /dev/smart0, a RAM MTD device.  This must
+ *                    be formatted with mksmartfs before it is mounted.
+ *     /mnt/nxffs   - NXFFS on a RAM MTD device
+ *
+ *   Each RAM MTD device is CONFIG_SIM_FSBENCH_MTDSIZE bytes.
+ *
+ ****************************************************************************/
+
+int sim_fsbench_initialize(void)
+{
+#ifdef HAVE_FSBENCH_MTD
+  FAR struct mtd_dev_s *mtd;
+  int ret;
+#endif
+
+#ifdef CONFIG_FS_FAT
+  /* The RAM disk is registered by up_initialize() */
+
+  sim_fsbench_mount("/dev/ram0", "/mnt/fat", "vfat", NULL);
+#endif
+
+#ifdef CONFIG_FS_TMPFS
+  sim_fsbench_mount(NULL, "/mnt/tmpfs", "tmpfs", NULL);
+#endif
+
+#ifdef CONFIG_FS_LITTLEFS
+  mtd = sim_fsbench_mtd();
+  if (mtd != NULL)
+    {
+      ret = register_mtddriver("/dev/lfs", mtd, 0755, NULL);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: Failed to register MTD driver: %d\n",
+                 ret);
+        }
+      else
+        {
+          sim_fsbench_mount("/dev/lfs", "/mnt/lfs", "littlefs",
+                            "autoformat");
+        }
+    }
+#endif
+
+#if defined(CONFIG_MTD_SMART) && defined(CONFIG_FS_SMARTFS)
+  mtd = sim_fsbench_mtd();
+  if (mtd != NULL)
+    {
+      ret = smart_initialize(0, mtd, NULL);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: smart_initialize failed: %d\n", ret);
+        }
+    }
+#endif
+
+#ifdef CONFIG_FS_NXFFS
+  mtd = sim_fsbench_mtd();
+  if (mtd != NULL)
+    {
+      ret = nxffs_initialize(mtd);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: NXFFS initialization failed: %d\n",
+                 ret);
+        }
+      else
+        {
+          sim_fsbench_mount(NULL, "/mnt/nxffs", "nxffs", NULL);
+        }
+    }
+#endif
+
+  return OK;
+}
+
+#endif /* CONFIG_SIM_FSBENCH */
@@ -42,6 +42,7 @@
 #include <stdlib.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/userspace.h>
@@ -124,6 +125,12 @@ const struct userspace_s userspace __attribute__ ((section (".userspace"))) =
 #ifdef CONFIG_LIB_USRWORK
   .work_usrstart    = work_usrstart,
 #endif
+
+  /* User-space clock page (declared in include/nuttx/clock.h) */
+
+#ifdef CONFIG_CLOCK_VDSO
+  .us_vdso          = &g_clock_vdso,
+#endif
 };
 
 /****************************************************************************
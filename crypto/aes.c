@@ -45,6 +45,29 @@
 
 #include <nuttx/crypto/aes.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ROTR8(x)      (((x) >> 8) | ((x) << 24))
+
+#define TE0(x)        g_te0[(x) & 0xff]
+#define TE1(x)        ROTR8(g_te0[(x) & 0xff])
+#define TE2(x)        ROTR8(ROTR8(g_te0[(x) & 0xff]))
+#define TE3(x)        ROTR8(ROTR8(ROTR8(g_te0[(x) & 0xff])))
+
+#define TD0(x)        g_td0[(x) & 0xff]
+#define TD1(x)        ROTR8(g_td0[(x) & 0xff])
+#define TD2(x)        ROTR8(ROTR8(g_td0[(x) & 0xff]))
+#define TD3(x)        ROTR8(ROTR8(ROTR8(g_td0[(x) & 0xff])))
+
+#define GETU32(p)     (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                       ((uint32_t)(p)[2] << 8)  |  (uint32_t)(p)[3])
+#define PUTU32(p, v)  do { (p)[0] = (uint8_t)((v) >> 24); \
+                           (p)[1] = (uint8_t)((v) >> 16); \
+                           (p)[2] = (uint8_t)((v) >> 8);  \
+                           (p)[3] = (uint8_t)(v); } while (0)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,6 +117,107 @@ static const uint8_t g_rsbox[256] =
   0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
 };
 
+/* Encryption T-table:  The SubBytes and MixColumns steps for one byte of
+ * a column, i.e., [02 01 01 03] * S[x] with the most significant byte
+ * first.  The other three tables are byte rotations of this one.
+ */
+
+static const uint32_t g_te0[256] =
+{
+  0xc66363a5, 0xf87c7c84, 0xee777799, 0xf67b7b8d, 0xfff2f20d, 0xd66b6bbd,
+  0xde6f6fb1, 0x91c5c554, 0x60303050, 0x02010103, 0xce6767a9, 0x562b2b7d,
+  0xe7fefe19, 0xb5d7d762, 0x4dababe6, 0xec76769a, 0x8fcaca45, 0x1f82829d,
+  0x89c9c940, 0xfa7d7d87, 0xeffafa15, 0xb25959eb, 0x8e4747c9, 0xfbf0f00b,
+  0x41adadec, 0xb3d4d467, 0x5fa2a2fd, 0x45afafea, 0x239c9cbf, 0x53a4a4f7,
+  0xe4727296, 0x9bc0c05b, 0x75b7b7c2, 0xe1fdfd1c, 0x3d9393ae, 0x4c26266a,
+  0x6c36365a, 0x7e3f3f41, 0xf5f7f702, 0x83cccc4f, 0x6834345c, 0x51a5a5f4,
+  0xd1e5e534, 0xf9f1f108, 0xe2717193, 0xabd8d873, 0x62313153, 0x2a15153f,
+  0x0804040c, 0x95c7c752, 0x46232365, 0x9dc3c35e, 0x30181828, 0x379696a1,
+  0x0a05050f, 0x2f9a9ab5, 0x0e070709, 0x24121236, 0x1b80809b, 0xdfe2e23d,
+  0xcdebeb26, 0x4e272769, 0x7fb2b2cd, 0xea75759f, 0x1209091b, 0x1d83839e,
+  0x582c2c74, 0x341a1a2e, 0x361b1b2d, 0xdc6e6eb2, 0xb45a5aee, 0x5ba0a0fb,
+  0xa45252f6, 0x763b3b4d, 0xb7d6d661, 0x7db3b3ce, 0x5229297b, 0xdde3e33e,
+  0x5e2f2f71, 0x13848497, 0xa65353f5, 0xb9d1d168, 0x00000000, 0xc1eded2c,
+  0x40202060, 0xe3fcfc1f, 0x79b1b1c8, 0xb65b5bed, 0xd46a6abe, 0x8dcbcb46,
+  0x67bebed9, 0x7239394b, 0x944a4ade, 0x984c4cd4, 0xb05858e8, 0x85cfcf4a,
+  0xbbd0d06b, 0xc5efef2a, 0x4faaaae5, 0xedfbfb16, 0x864343c5, 0x9a4d4dd7,
+  0x66333355, 0x11858594, 0x8a4545cf, 0xe9f9f910, 0x04020206, 0xfe7f7f81,
+  0xa05050f0, 0x783c3c44, 0x259f9fba, 0x4ba8a8e3, 0xa25151f3, 0x5da3a3fe,
+  0x804040c0, 0x058f8f8a, 0x3f9292ad, 0x219d9dbc, 0x70383848, 0xf1f5f504,
+  0x63bcbcdf, 0x77b6b6c1, 0xafdada75, 0x42212163, 0x20101030, 0xe5ffff1a,
+  0xfdf3f30e, 0xbfd2d26d, 0x81cdcd4c, 0x180c0c14, 0x26131335, 0xc3ecec2f,
+  0xbe5f5fe1, 0x359797a2, 0x884444cc, 0x2e171739, 0x93c4c457, 0x55a7a7f2,
+  0xfc7e7e82, 0x7a3d3d47, 0xc86464ac, 0xba5d5de7, 0x3219192b, 0xe6737395,
+  0xc06060a0, 0x19818198, 0x9e4f4fd1, 0xa3dcdc7f, 0x44222266, 0x542a2a7e,
+  0x3b9090ab, 0x0b888883, 0x8c4646ca, 0xc7eeee29, 0x6bb8b8d3, 0x2814143c,
+  0xa7dede79, 0xbc5e5ee2, 0x160b0b1d, 0xaddbdb76, 0xdbe0e03b, 0x64323256,
+  0x743a3a4e, 0x140a0a1e, 0x924949db, 0x0c06060a, 0x4824246c, 0xb85c5ce4,
+  0x9fc2c25d, 0xbdd3d36e, 0x43acacef, 0xc46262a6, 0x399191a8, 0x319595a4,
+  0xd3e4e437, 0xf279798b, 0xd5e7e732, 0x8bc8c843, 0x6e373759, 0xda6d6db7,
+  0x018d8d8c, 0xb1d5d564, 0x9c4e4ed2, 0x49a9a9e0, 0xd86c6cb4, 0xac5656fa,
+  0xf3f4f407, 0xcfeaea25, 0xca6565af, 0xf47a7a8e, 0x47aeaee9, 0x10080818,
+  0x6fbabad5, 0xf0787888, 0x4a25256f, 0x5c2e2e72, 0x381c1c24, 0x57a6a6f1,
+  0x73b4b4c7, 0x97c6c651, 0xcbe8e823, 0xa1dddd7c, 0xe874749c, 0x3e1f1f21,
+  0x964b4bdd, 0x61bdbddc, 0x0d8b8b86, 0x0f8a8a85, 0xe0707090, 0x7c3e3e42,
+  0x71b5b5c4, 0xcc6666aa, 0x904848d8, 0x06030305, 0xf7f6f601, 0x1c0e0e12,
+  0xc26161a3, 0x6a35355f, 0xae5757f9, 0x69b9b9d0, 0x17868691, 0x99c1c158,
+  0x3a1d1d27, 0x279e9eb9, 0xd9e1e138, 0xebf8f813, 0x2b9898b3, 0x22111133,
+  0xd26969bb, 0xa9d9d970, 0x078e8e89, 0x339494a7, 0x2d9b9bb6, 0x3c1e1e22,
+  0x15878792, 0xc9e9e920, 0x87cece49, 0xaa5555ff, 0x50282878, 0xa5dfdf7a,
+  0x038c8c8f, 0x59a1a1f8, 0x09898980, 0x1a0d0d17, 0x65bfbfda, 0xd7e6e631,
+  0x844242c6, 0xd06868b8, 0x824141c3, 0x299999b0, 0x5a2d2d77, 0x1e0f0f11,
+  0x7bb0b0cb, 0xa85454fc, 0x6dbbbbd6, 0x2c16163a
+};
+
+/* Decryption T-table:  [0e 09 0d 0b] * Si[x] */
+
+static const uint32_t g_td0[256] =
+{
+  0x51f4a750, 0x7e416553, 0x1a17a4c3, 0x3a275e96, 0x3bab6bcb, 0x1f9d45f1,
+  0xacfa58ab, 0x4be30393, 0x2030fa55, 0xad766df6, 0x88cc7691, 0xf5024c25,
+  0x4fe5d7fc, 0xc52acbd7, 0x26354480, 0xb562a38f, 0xdeb15a49, 0x25ba1b67,
+  0x45ea0e98, 0x5dfec0e1, 0xc32f7502, 0x814cf012, 0x8d4697a3, 0x6bd3f9c6,
+  0x038f5fe7, 0x15929c95, 0xbf6d7aeb, 0x955259da, 0xd4be832d, 0x587421d3,
+  0x49e06929, 0x8ec9c844, 0x75c2896a, 0xf48e7978, 0x99583e6b, 0x27b971dd,
+  0xbee14fb6, 0xf088ad17, 0xc920ac66, 0x7dce3ab4, 0x63df4a18, 0xe51a3182,
+  0x97513360, 0x62537f45, 0xb16477e0, 0xbb6bae84, 0xfe81a01c, 0xf9082b94,
+  0x70486858, 0x8f45fd19, 0x94de6c87, 0x527bf8b7, 0xab73d323, 0x724b02e2,
+  0xe31f8f57, 0x6655ab2a, 0xb2eb2807, 0x2fb5c203, 0x86c57b9a, 0xd33708a5,
+  0x302887f2, 0x23bfa5b2, 0x02036aba, 0xed16825c, 0x8acf1c2b, 0xa779b492,
+  0xf307f2f0, 0x4e69e2a1, 0x65daf4cd, 0x0605bed5, 0xd134621f, 0xc4a6fe8a,
+  0x342e539d, 0xa2f355a0, 0x058ae132, 0xa4f6eb75, 0x0b83ec39, 0x4060efaa,
+  0x5e719f06, 0xbd6e1051, 0x3e218af9, 0x96dd063d, 0xdd3e05ae, 0x4de6bd46,
+  0x91548db5, 0x71c45d05, 0x0406d46f, 0x605015ff, 0x1998fb24, 0xd6bde997,
+  0x894043cc, 0x67d99e77, 0xb0e842bd, 0x07898b88, 0xe7195b38, 0x79c8eedb,
+  0xa17c0a47, 0x7c420fe9, 0xf8841ec9, 0x00000000, 0x09808683, 0x322bed48,
+  0x1e1170ac, 0x6c5a724e, 0xfd0efffb, 0x0f853856, 0x3daed51e, 0x362d3927,
+  0x0a0fd964, 0x685ca621, 0x9b5b54d1, 0x24362e3a, 0x0c0a67b1, 0x9357e70f,
+  0xb4ee96d2, 0x1b9b919e, 0x80c0c54f, 0x61dc20a2, 0x5a774b69, 0x1c121a16,
+  0xe293ba0a, 0xc0a02ae5, 0x3c22e043, 0x121b171d, 0x0e090d0b, 0xf28bc7ad,
+  0x2db6a8b9, 0x141ea9c8, 0x57f11985, 0xaf75074c, 0xee99ddbb, 0xa37f60fd,
+  0xf701269f, 0x5c72f5bc, 0x44663bc5, 0x5bfb7e34, 0x8b432976, 0xcb23c6dc,
+  0xb6edfc68, 0xb8e4f163, 0xd731dcca, 0x42638510, 0x13972240, 0x84c61120,
+  0x854a247d, 0xd2bb3df8, 0xaef93211, 0xc729a16d, 0x1d9e2f4b, 0xdcb230f3,
+  0x0d8652ec, 0x77c1e3d0, 0x2bb3166c, 0xa970b999, 0x119448fa, 0x47e96422,
+  0xa8fc8cc4, 0xa0f03f1a, 0x567d2cd8, 0x223390ef, 0x87494ec7, 0xd938d1c1,
+  0x8ccaa2fe, 0x98d40b36, 0xa6f581cf, 0xa57ade28, 0xdab78e26, 0x3fadbfa4,
+  0x2c3a9de4, 0x5078920d, 0x6a5fcc9b, 0x547e4662, 0xf68d13c2, 0x90d8b8e8,
+  0x2e39f75e, 0x82c3aff5, 0x9f5d80be, 0x69d0937c, 0x6fd52da9, 0xcf2512b3,
+  0xc8ac993b, 0x10187da7, 0xe89c636e, 0xdb3bbb7b, 0xcd267809, 0x6e5918f4,
+  0xec9ab701, 0x834f9aa8, 0xe6956e65, 0xaaffe67e, 0x21bccf08, 0xef15e8e6,
+  0xbae79bd9, 0x4a6f36ce, 0xea9f09d4, 0x29b07cd6, 0x31a4b2af, 0x2a3f2331,
+  0xc6a59430, 0x35a266c0, 0x744ebc37, 0xfc82caa6, 0xe090d0b0, 0x33a7d815,
+  0xf104984a, 0x41ecdaf7, 0x7fcd500e, 0x1791f62f, 0x764dd68d, 0x43efb04d,
+  0xccaa4d54, 0xe49604df, 0x9ed1b5e3, 0x4c6a881b, 0xc12c1fb8, 0x4665517f,
+  0x9d5eea04, 0x018c355d, 0xfa877473, 0xfb0b412e, 0xb3671d5a, 0x92dbd252,
+  0xe9105633, 0x6dd64713, 0x9ad7618c, 0x37a10c7a, 0x59f8148e, 0xeb133c89,
+  0xcea927ee, 0xb761c935, 0xe11ce5ed, 0x7a47b13c, 0x9cd2df59, 0x55f2733f,
+  0x1814ce79, 0x73c737bf, 0x53f7cdea, 0x5ffdaa5b, 0xdf3d6f14, 0x7844db86,
+  0xcaaff381, 0xb968c43e, 0x3824342c, 0xc2a3405f, 0x161dc372, 0xbce2250c,
+  0x283c498b, 0xff0d9541, 0x39a80171, 0x080cb3de, 0xd8b4e49c, 0x6456c190,
+  0x7bcb8461, 0xd532b670, 0x486c5c74, 0xd0b85742
+};
+
 /* Round constant */
 
 static const uint8_t g_rcon[11] =
@@ -107,432 +231,242 @@ static struct aes_state_s g_aes_state;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sub_word
+ *
+ * Description:
+ *   Apply the forward S-box to each byte of a word.
+ *
+ ****************************************************************************/
+
+static uint32_t sub_word(uint32_t w)
+{
+  return ((uint32_t)g_sbox[w >> 24] << 24) |
+         ((uint32_t)g_sbox[(w >> 16) & 0xff] << 16) |
+         ((uint32_t)g_sbox[(w >> 8) & 0xff] << 8) |
+          (uint32_t)g_sbox[w & 0xff];
+}
+
 /****************************************************************************
  * Name: expand_key
  *
  * Description:
- *   Expend a 16 bytes key for AES128 implementation
+ *   Expand a 16, 24 or 32 byte key into the encryption round keys and the
+ *   decryption round keys for the equivalent inverse cipher.
  *
  * Input Parameters:
- *  key          AES128 key - 16 bytes
- *  expanded_key expanded AES128 key
+ *  state  AES context that receives the key schedules
+ *  key    AES key
+ *  nk     Key length in 32-bit words (4, 6 or 8)
  *
  * Returned Value:
  *  None
  *
  ****************************************************************************/
 
-static void expand_key(FAR uint8_t *expanded_key, FAR const uint8_t *key)
+static void expand_key(FAR struct aes_state_s *state,
+                       FAR const uint8_t *key, int nk)
 {
-  uint16_t buf1;
-  uint16_t ii;
+  FAR uint32_t *ek = state->enc_key;
+  FAR uint32_t *dk = state->dec_key;
+  uint32_t temp;
+  int nwords;
+  int i;
+  int j;
+
+  state->nrounds = nk + 6;
+  nwords = 4 * (state->nrounds + 1);
 
-  for (ii = 0; ii < 16; ii++)
+  for (i = 0; i < nk; i++)
     {
-      expanded_key[ii] = key[ii];
+      ek[i] = GETU32(key + 4 * i);
     }
 
-  for (ii = 1; ii < 11; ii++)
+  for (; i < nwords; i++)
     {
-      buf1 = expanded_key[ii*16 - 4];
-      expanded_key[ii * 16 + 0] = g_sbox[expanded_key[ii *16 - 3]] ^ expanded_key[(ii - 1) * 16 + 0] ^ g_rcon[ii];
-      expanded_key[ii * 16 + 1] = g_sbox[expanded_key[ii *16 - 2]] ^ expanded_key[(ii - 1) * 16 + 1];
-      expanded_key[ii * 16 + 2] = g_sbox[expanded_key[ii *16 - 1]] ^ expanded_key[(ii - 1) * 16 + 2];
-      expanded_key[ii * 16 + 3] = g_sbox[buf1] ^ expanded_key[(ii - 1) * 16 + 3];
-      expanded_key[ii * 16 + 4] = expanded_key[(ii - 1) * 16 + 4] ^ expanded_key[ii * 16 + 0];
-      expanded_key[ii * 16 + 5] = expanded_key[(ii - 1) * 16 + 5] ^ expanded_key[ii * 16 + 1];
-      expanded_key[ii * 16 + 6] = expanded_key[(ii - 1) * 16 + 6] ^ expanded_key[ii * 16 + 2];
-      expanded_key[ii * 16 + 7] = expanded_key[(ii - 1) * 16 + 7] ^ expanded_key[ii * 16 + 3];
-      expanded_key[ii * 16 + 8] = expanded_key[(ii - 1) * 16 + 8] ^ expanded_key[ii * 16 + 4];
-      expanded_key[ii * 16 + 9] = expanded_key[(ii - 1) * 16 + 9] ^ expanded_key[ii * 16 + 5];
-      expanded_key[ii * 16 +10] = expanded_key[(ii - 1) * 16 +10] ^ expanded_key[ii * 16 + 6];
-      expanded_key[ii * 16 +11] = expanded_key[(ii - 1) * 16 +11] ^ expanded_key[ii * 16 + 7];
-      expanded_key[ii * 16 +12] = expanded_key[(ii - 1) * 16 +12] ^ expanded_key[ii * 16 + 8];
-      expanded_key[ii * 16 +13] = expanded_key[(ii - 1) * 16 +13] ^ expanded_key[ii * 16 + 9];
-      expanded_key[ii * 16 +14] = expanded_key[(ii - 1) * 16 +14] ^ expanded_key[ii * 16 +10];
-      expanded_key[ii * 16 +15] = expanded_key[(ii - 1) * 16 +15] ^ expanded_key[ii * 16 +11];
+      temp = ek[i - 1];
+      if (i % nk == 0)
+        {
+          temp = sub_word((temp << 8) | (temp >> 24)) ^
+                 ((uint32_t)g_rcon[i / nk] << 24);
+        }
+      else if (nk > 6 && i % nk == 4)
+        {
+          temp = sub_word(temp);
+        }
+
+      ek[i] = ek[i - nk] ^ temp;
     }
-}
 
-/******************************************************************************
- * Name: galois_mul2
- *
- * Description:
- *    Multiply by 2 in the galois field
- *
- * Input Parameters:
- *  value    argument to multiply
- *
- * Returned Value:
- *  Multiplied argument
- *
- ******************************************************************************/
+  /* The decryption round keys are the encryption round keys in reverse
+   * order with InvMixColumns applied to all but the first and last.
+   * Td[S[x]] is InvMixColumns of the single byte x.
+   */
 
-static uint8_t galois_mul2(uint8_t value)
-{
-  if (value >> 7)
-    {
-      value = value << 1;
-      return (value ^ 0x1b);
-    }
-  else
+  for (i = 0; i <= state->nrounds; i++)
     {
-      return value << 1;
+      for (j = 0; j < 4; j++)
+        {
+          temp = ek[4 * (state->nrounds - i) + j];
+          if (i > 0 && i < state->nrounds)
+            {
+              temp = TD0(g_sbox[temp >> 24]) ^
+                     TD1(g_sbox[(temp >> 16) & 0xff]) ^
+                     TD2(g_sbox[(temp >> 8) & 0xff]) ^
+                     TD3(g_sbox[temp & 0xff]);
+            }
+
+          dk[4 * i + j] = temp;
+        }
     }
 }
 
-/******************************************************************************
+/****************************************************************************
  * Name: aes_encr
  *
  * Description:
- *  Internal implementation of AES128 encryption.
- *  Straight forward aes encryption implementation. First the group of
- *  operations:
- *
- *    - addRoundKey
- *    - subbytes
- *    - shiftrows
- *    - mixcolums
- *
- *  is executed 9 times, after this addroundkey to finish the 9th round, after
- *  that the 10th round without mixcolums no further subfunctions to save
- *  cycles for function calls no structuring with "for (....)" to save cycles.
+ *   Encrypt one 16 byte block in place.  Each round combines SubBytes,
+ *   ShiftRows and MixColumns into four table lookups per column.
  *
  * Input Parameters:
- *  expanded_key expanded AES128 key
- *  state        16 bytes of plain text and cipher text
+ *  block  16 bytes of plain text, replaced by the cipher text
+ *  state  AES context holding the key schedule
  *
  * Returned Value:
  *  None
  *
- ******************************************************************************/
+ ****************************************************************************/
 
-static void aes_encr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
+static void aes_encr(FAR uint8_t *block, FAR const struct aes_state_s *state)
 {
-  uint8_t buf1;
-  uint8_t buf2;
-  uint8_t buf3;
-  uint8_t round;
-
-  for (round = 0; round < 9; round ++)
+  FAR const uint32_t *rk = state->enc_key;
+  uint32_t s0;
+  uint32_t s1;
+  uint32_t s2;
+  uint32_t s3;
+  uint32_t t0;
+  uint32_t t1;
+  uint32_t t2;
+  uint32_t t3;
+  int r;
+
+  s0 = GETU32(block)      ^ rk[0];
+  s1 = GETU32(block + 4)  ^ rk[1];
+  s2 = GETU32(block + 8)  ^ rk[2];
+  s3 = GETU32(block + 12) ^ rk[3];
+
+  for (r = 1; r < state->nrounds; r++)
     {
-      /* addroundkey, sbox and shiftrows */
-      /* Row 0 */
-
-      state[0]   = g_sbox[(state[0]  ^ expanded_key[(round * 16)])];
-      state[4]   = g_sbox[(state[4]  ^ expanded_key[(round * 16) +  4])];
-      state[8]   = g_sbox[(state[8]  ^ expanded_key[(round * 16) +  8])];
-      state[12]  = g_sbox[(state[12] ^ expanded_key[(round * 16) + 12])];
-
-      /* Row 1 */
-
-      buf1       = state[1] ^ expanded_key[(round * 16) + 1];
-      state[1]   = g_sbox[(state[5]  ^ expanded_key[(round * 16) +  5])];
-      state[5]   = g_sbox[(state[9]  ^ expanded_key[(round * 16) +  9])];
-      state[9]   = g_sbox[(state[13] ^ expanded_key[(round * 16) + 13])];
-      state[13]  = g_sbox[buf1];
-
-      /* Row 2 */
-
-      buf1       = state[2] ^ expanded_key[(round * 16) + 2];
-      buf2       = state[6] ^ expanded_key[(round * 16) + 6];
-      state[2]   = g_sbox[(state[10] ^ expanded_key[(round * 16) + 10])];
-      state[6]   = g_sbox[(state[14] ^ expanded_key[(round * 16) + 14])];
-      state[10]  = g_sbox[buf1];
-      state[14]  = g_sbox[buf2];
-
-      /* Row 3 */
-
-      buf1       = state[15] ^ expanded_key[(round * 16) + 15];
-      state[15]  = g_sbox[(state[11] ^ expanded_key[(round * 16) + 11])];
-      state[11]  = g_sbox[(state[7]  ^ expanded_key[(round * 16) +  7])];
-      state[7]   = g_sbox[(state[3]  ^ expanded_key[(round * 16) +  3])];
-      state[3]   = g_sbox[buf1];
-
-      /* mixcolums */
-      /* Col1 */
-
-      buf1 = state[0] ^ state[1] ^ state[2] ^ state[3];
-      buf2 = state[0];
-      buf3 = state[0] ^ state[1]; buf3 = galois_mul2(buf3); state[0] = state[0] ^ buf3 ^ buf1;
-      buf3 = state[1] ^ state[2]; buf3 = galois_mul2(buf3); state[1] = state[1] ^ buf3 ^ buf1;
-      buf3 = state[2] ^ state[3]; buf3 = galois_mul2(buf3); state[2] = state[2] ^ buf3 ^ buf1;
-      buf3 = state[3] ^ buf2;     buf3 = galois_mul2(buf3); state[3] = state[3] ^ buf3 ^ buf1;
-
-      /* Col2 */
-
-      buf1 = state[4] ^ state[5] ^ state[6] ^ state[7];
-      buf2 = state[4];
-      buf3 = state[4] ^ state[5]; buf3 = galois_mul2(buf3); state[4] = state[4] ^ buf3 ^ buf1;
-      buf3 = state[5] ^ state[6]; buf3 = galois_mul2(buf3); state[5] = state[5] ^ buf3 ^ buf1;
-      buf3 = state[6] ^ state[7]; buf3 = galois_mul2(buf3); state[6] = state[6] ^ buf3 ^ buf1;
-      buf3 = state[7] ^ buf2;     buf3 = galois_mul2(buf3); state[7] = state[7] ^ buf3 ^ buf1;
-
-      /* Col3 */
-
-      buf1 = state[8] ^ state[9] ^ state[10] ^ state[11];
-      buf2 = state[8];
-      buf3 = state[8] ^ state[9];   buf3 = galois_mul2(buf3); state[8] = state[8] ^ buf3 ^ buf1;
-      buf3 = state[9] ^ state[10];  buf3 = galois_mul2(buf3); state[9] = state[9] ^ buf3 ^ buf1;
-      buf3 = state[10] ^ state[11]; buf3 = galois_mul2(buf3); state[10] = state[10] ^ buf3 ^ buf1;
-      buf3 = state[11] ^ buf2;      buf3 = galois_mul2(buf3); state[11] = state[11] ^ buf3 ^ buf1;
-
-      /* Col4 */
-
-      buf1 = state[12] ^ state[13] ^ state[14] ^ state[15];
-      buf2 = state[12];
-      buf3 = state[12] ^ state[13]; buf3 = galois_mul2(buf3); state[12] = state[12] ^ buf3 ^ buf1;
-      buf3 = state[13] ^ state[14]; buf3 = galois_mul2(buf3); state[13] = state[13] ^ buf3 ^ buf1;
-      buf3 = state[14] ^ state[15]; buf3 = galois_mul2(buf3); state[14] = state[14] ^ buf3 ^ buf1;
-      buf3 = state[15] ^ buf2;      buf3 = galois_mul2(buf3); state[15] = state[15] ^ buf3 ^ buf1;
+      rk += 4;
+      t0 = TE0(s0 >> 24) ^ TE1(s1 >> 16) ^ TE2(s2 >> 8) ^ TE3(s3) ^ rk[0];
+      t1 = TE0(s1 >> 24) ^ TE1(s2 >> 16) ^ TE2(s3 >> 8) ^ TE3(s0) ^ rk[1];
+      t2 = TE0(s2 >> 24) ^ TE1(s3 >> 16) ^ TE2(s0 >> 8) ^ TE3(s1) ^ rk[2];
+      t3 = TE0(s3 >> 24) ^ TE1(s0 >> 16) ^ TE2(s1 >> 8) ^ TE3(s2) ^ rk[3];
+
+      s0 = t0;
+      s1 = t1;
+      s2 = t2;
+      s3 = t3;
     }
 
-  /* 10th round without mixcols */
-
-  state[0]   = g_sbox[(state[0]  ^ expanded_key[(round * 16)])];
-  state[4]   = g_sbox[(state[4]  ^ expanded_key[(round * 16) +  4])];
-  state[8]   = g_sbox[(state[8]  ^ expanded_key[(round * 16) +  8])];
-  state[12]  = g_sbox[(state[12] ^ expanded_key[(round * 16) + 12])];
-
-  /* Row 1 */
-
-  buf1       = state[1] ^ expanded_key[(round * 16) + 1];
-  state[1]   = g_sbox[(state[5]  ^ expanded_key[(round * 16) +  5])];
-  state[5]   = g_sbox[(state[9]  ^ expanded_key[(round * 16) +  9])];
-  state[9]   = g_sbox[(state[13] ^ expanded_key[(round * 16) + 13])];
-  state[13]  = g_sbox[buf1];
-
-  /* Row 2 */
-
-  buf1       = state[2] ^ expanded_key[(round * 16) + 2];
-  buf2       = state[6] ^ expanded_key[(round * 16) + 6];
-  state[2]   = g_sbox[(state[10] ^ expanded_key[(round * 16) + 10])];
-  state[6]   = g_sbox[(state[14] ^ expanded_key[(round * 16) + 14])];
-  state[10]  = g_sbox[buf1];
-  state[14]  = g_sbox[buf2];
-
-  /* Row 3 */
-
-  buf1       = state[15] ^ expanded_key[(round * 16) + 15];
-  state[15]  = g_sbox[(state[11] ^ expanded_key[(round * 16) + 11])];
-  state[11]  = g_sbox[(state[7]  ^ expanded_key[(round * 16) +  7])];
-  state[7]   = g_sbox[(state[3]  ^ expanded_key[(round * 16) +  3])];
-  state[3]   = g_sbox[buf1];
-
-  /* Last addroundkey */
-
-  state[0]  ^= expanded_key[160];
-  state[1]  ^= expanded_key[161];
-  state[2]  ^= expanded_key[162];
-  state[3]  ^= expanded_key[163];
-  state[4]  ^= expanded_key[164];
-  state[5]  ^= expanded_key[165];
-  state[6]  ^= expanded_key[166];
-  state[7]  ^= expanded_key[167];
-  state[8]  ^= expanded_key[168];
-  state[9]  ^= expanded_key[169];
-  state[10] ^= expanded_key[170];
-  state[11] ^= expanded_key[171];
-  state[12] ^= expanded_key[172];
-  state[13] ^= expanded_key[173];
-  state[14] ^= expanded_key[174];
-  state[15] ^= expanded_key[175];
+  /* The last round has no MixColumns */
+
+  rk += 4;
+  t0 = ((uint32_t)g_sbox[s0 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s1 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s2 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_sbox[s3 & 0xff] ^ rk[0];
+  t1 = ((uint32_t)g_sbox[s1 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s2 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s3 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_sbox[s0 & 0xff] ^ rk[1];
+  t2 = ((uint32_t)g_sbox[s2 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s3 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s0 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_sbox[s1 & 0xff] ^ rk[2];
+  t3 = ((uint32_t)g_sbox[s3 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s0 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s1 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_sbox[s2 & 0xff] ^ rk[3];
+
+  PUTU32(block, t0);
+  PUTU32(block + 4, t1);
+  PUTU32(block + 8, t2);
+  PUTU32(block + 12, t3);
 }
 
-/******************************************************************************
+/****************************************************************************
  * Name: aes_decr
  *
  * Description:
- *  Internal implementation of AES128 decryption.
- *  Straight forward aes decryption implementation.  The order of substeps is
- *  the exact reverse of decryption inverse functions:
- *
- *     - addRoundKey is its own inverse
- *     - rsbox is inverse of sbox
- *     - rightshift instead of leftshift
- *     - invMixColumns = barreto + mixColumns
- *
- *  No further subfunctions to save cycles for function calls no structuring
- *  with "for (....)" to save cycles
+ *   Decrypt one 16 byte block in place using the equivalent inverse cipher
+ *   so that each round is also four table lookups per column.
  *
  * Input Parameters:
- *  expanded_key expanded AES128 key
- *  state        16 bytes of cipher text and plain text
+ *  block  16 bytes of cipher text, replaced by the plain text
+ *  state  AES context holding the key schedule
  *
  * Returned Value:
  *  None
  *
- ******************************************************************************/
+ ****************************************************************************/
 
-static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
+static void aes_decr(FAR uint8_t *block, FAR const struct aes_state_s *state)
 {
-  uint8_t buf1;
-  uint8_t buf2;
-  uint8_t buf3;
-  int8_t round;
-
-  round = 9;
-
-  /* Initial addroundkey */
-
-  state[0]  ^= expanded_key[160];
-  state[1]  ^= expanded_key[161];
-  state[2]  ^= expanded_key[162];
-  state[3]  ^= expanded_key[163];
-  state[4]  ^= expanded_key[164];
-  state[5]  ^= expanded_key[165];
-  state[6]  ^= expanded_key[166];
-  state[7]  ^= expanded_key[167];
-  state[8]  ^= expanded_key[168];
-  state[9]  ^= expanded_key[169];
-  state[10] ^= expanded_key[170];
-  state[11] ^= expanded_key[171];
-  state[12] ^= expanded_key[172];
-  state[13] ^= expanded_key[173];
-  state[14] ^= expanded_key[174];
-  state[15] ^= expanded_key[175];
-
-  /* 10th round without mixcols */
-
-  state[0]   = g_rsbox[state[0]]  ^ expanded_key[(round * 16)];
-  state[4]   = g_rsbox[state[4]]  ^ expanded_key[(round * 16) +  4];
-  state[8]   = g_rsbox[state[8]]  ^ expanded_key[(round * 16) +  8];
-  state[12]  = g_rsbox[state[12]] ^ expanded_key[(round * 16) + 12];
-
-  /* Row 1 */
-
-  buf1       = g_rsbox[state[13]] ^ expanded_key[(round * 16) +  1];
-  state[13]  = g_rsbox[state[9]]  ^ expanded_key[(round * 16) + 13];
-  state[9]   = g_rsbox[state[5]]  ^ expanded_key[(round * 16) +  9];
-  state[5]   = g_rsbox[state[1]]  ^ expanded_key[(round * 16) +  5];
-  state[1]   = buf1;
-
-  /* Row 2 */
-
-  buf1       = g_rsbox[state[2]]  ^ expanded_key[(round * 16) + 10];
-  buf2       = g_rsbox[state[6]]  ^ expanded_key[(round * 16) + 14];
-  state[2]   = g_rsbox[state[10]] ^ expanded_key[(round * 16) +  2];
-  state[6]   = g_rsbox[state[14]] ^ expanded_key[(round * 16) +  6];
-  state[10]  = buf1;
-  state[14]  = buf2;
-
-  /* Row 3 */
-
-  buf1       = g_rsbox[state[3]]  ^ expanded_key[(round * 16) + 15];
-  state[3]   = g_rsbox[state[7]]  ^ expanded_key[(round * 16) +  3];
-  state[7]   = g_rsbox[state[11]] ^ expanded_key[(round * 16) +  7];
-  state[11]  = g_rsbox[state[15]] ^ expanded_key[(round * 16) + 11];
-  state[15]  = buf1;
-
-  for (round = 8; round >= 0; round--)
+  FAR const uint32_t *rk = state->dec_key;
+  uint32_t s0;
+  uint32_t s1;
+  uint32_t s2;
+  uint32_t s3;
+  uint32_t t0;
+  uint32_t t1;
+  uint32_t t2;
+  uint32_t t3;
+  int r;
+
+  s0 = GETU32(block)      ^ rk[0];
+  s1 = GETU32(block + 4)  ^ rk[1];
+  s2 = GETU32(block + 8)  ^ rk[2];
+  s3 = GETU32(block + 12) ^ rk[3];
+
+  for (r = 1; r < state->nrounds; r++)
     {
-      /* barreto */
-      /* Col1 */
-
-      buf1       = galois_mul2(galois_mul2(state[0] ^ state[2]));
-      buf2       = galois_mul2(galois_mul2(state[1] ^ state[3]));
-      state[0]  ^= buf1;
-      state[1]  ^= buf2;
-      state[2]  ^= buf1;
-      state[3]  ^= buf2;
-
-      /* Col2 */
-
-      buf1       = galois_mul2(galois_mul2(state[4] ^ state[6]));
-      buf2       = galois_mul2(galois_mul2(state[5] ^ state[7]));
-      state[4]  ^= buf1;
-      state[5]  ^= buf2;
-      state[6]  ^= buf1;
-      state[7]  ^= buf2;
-
-      /* Col3 */
-
-      buf1       = galois_mul2(galois_mul2(state[8] ^ state[10]));
-      buf2       = galois_mul2(galois_mul2(state[9] ^ state[11]));
-      state[8]  ^= buf1;
-      state[9]  ^= buf2;
-      state[10] ^= buf1;
-      state[11] ^= buf2;
-
-      /* Col4 */
-
-      buf1       = galois_mul2(galois_mul2(state[12] ^ state[14]));
-      buf2       = galois_mul2(galois_mul2(state[13] ^ state[15]));
-      state[12] ^= buf1;
-      state[13] ^= buf2;
-      state[14] ^= buf1;
-      state[15] ^= buf2;
-
-      /* mixcolums */
-      /* Col1 */
-
-      buf1 = state[0]  ^ state[1] ^ state[2] ^ state[3];
-      buf2 = state[0];
-      buf3 = state[0]  ^ state[1]; buf3 = galois_mul2(buf3); state[0] = state[0] ^ buf3 ^ buf1;
-      buf3 = state[1]  ^ state[2]; buf3 = galois_mul2(buf3); state[1] = state[1] ^ buf3 ^ buf1;
-      buf3 = state[2]  ^ state[3]; buf3 = galois_mul2(buf3); state[2] = state[2] ^ buf3 ^ buf1;
-      buf3 = state[3]  ^ buf2;     buf3 = galois_mul2(buf3); state[3] = state[3] ^ buf3 ^ buf1;
-
-      /* Col2 */
-
-      buf1 = state[4]  ^ state[5] ^ state[6] ^ state[7];
-      buf2 = state[4];
-      buf3 = state[4]  ^ state[5]; buf3 = galois_mul2(buf3); state[4] = state[4] ^ buf3 ^ buf1;
-      buf3 = state[5]  ^ state[6]; buf3 = galois_mul2(buf3); state[5] = state[5] ^ buf3 ^ buf1;
-      buf3 = state[6]  ^ state[7]; buf3 = galois_mul2(buf3); state[6] = state[6] ^ buf3 ^ buf1;
-      buf3 = state[7]  ^ buf2;     buf3 = galois_mul2(buf3); state[7] = state[7] ^ buf3 ^ buf1;
-
-      /* Col3 */
-
-      buf1 = state[8]  ^ state[9] ^ state[10] ^ state[11];
-      buf2 = state[8];
-      buf3 = state[8]  ^ state[9];  buf3 = galois_mul2(buf3); state[8] = state[8] ^ buf3 ^ buf1;
-      buf3 = state[9]  ^ state[10]; buf3 = galois_mul2(buf3); state[9] = state[9] ^ buf3 ^ buf1;
-      buf3 = state[10] ^ state[11]; buf3 = galois_mul2(buf3); state[10] = state[10] ^ buf3 ^ buf1;
-      buf3 = state[11] ^ buf2;      buf3 = galois_mul2(buf3); state[11] = state[11] ^ buf3 ^ buf1;
-
-      /* Col4 */
-
-      buf1 = state[12] ^ state[13] ^ state[14] ^ state[15];
-      buf2 = state[12];
-      buf3 = state[12] ^ state[13]; buf3 = galois_mul2(buf3); state[12] = state[12] ^ buf3 ^ buf1;
-      buf3 = state[13] ^ state[14]; buf3 = galois_mul2(buf3); state[13] = state[13] ^ buf3 ^ buf1;
-      buf3 = state[14] ^ state[15]; buf3 = galois_mul2(buf3); state[14] = state[14] ^ buf3 ^ buf1;
-      buf3 = state[15] ^ buf2;      buf3 = galois_mul2(buf3); state[15] = state[15] ^ buf3 ^ buf1;
-
-      /* addroundkey, rsbox and shiftrows */
-      /* Row 0 */
-
-      state[0]   = g_rsbox[state[0]]  ^ expanded_key[(round * 16)];
-      state[4]   = g_rsbox[state[4]]  ^ expanded_key[(round * 16) +  4];
-      state[8]   = g_rsbox[state[8]]  ^ expanded_key[(round * 16) +  8];
-      state[12]  = g_rsbox[state[12]] ^ expanded_key[(round * 16) + 12];
-
-      /* Row 1 */
-
-      buf1       = g_rsbox[state[13]] ^ expanded_key[(round * 16) +  1];
-      state[13]  = g_rsbox[state[9]]  ^ expanded_key[(round * 16) + 13];
-      state[9]   = g_rsbox[state[5]]  ^ expanded_key[(round * 16) +  9];
-      state[5]   = g_rsbox[state[1]]  ^ expanded_key[(round * 16) +  5];
-      state[1]   = buf1;
-
-      /* Row 2 */
-
-      buf1       = g_rsbox[state[2]]  ^ expanded_key[(round * 16) + 10];
-      buf2       = g_rsbox[state[6]]  ^ expanded_key[(round * 16) + 14];
-      state[2]   = g_rsbox[state[10]] ^ expanded_key[(round * 16) +  2];
-      state[6]   = g_rsbox[state[14]] ^ expanded_key[(round * 16) +  6];
-      state[10]  = buf1;
-      state[14]  = buf2;
-
-      /* Row 3 */
-
-      buf1       = g_rsbox[state[3]]  ^ expanded_key[(round * 16) + 15];
-      state[3]   = g_rsbox[state[7]]  ^ expanded_key[(round * 16) +  3];
-      state[7]   = g_rsbox[state[11]] ^ expanded_key[(round * 16) +  7];
-      state[11]  = g_rsbox[state[15]] ^ expanded_key[(round * 16) + 11];
-      state[15]  = buf1;
+      rk += 4;
+      t0 = TD0(s0 >> 24) ^ TD1(s3 >> 16) ^ TD2(s2 >> 8) ^ TD3(s1) ^ rk[0];
+      t1 = TD0(s1 >> 24) ^ TD1(s0 >> 16) ^ TD2(s3 >> 8) ^ TD3(s2) ^ rk[1];
+      t2 = TD0(s2 >> 24) ^ TD1(s1 >> 16) ^ TD2(s0 >> 8) ^ TD3(s3) ^ rk[2];
+      t3 = TD0(s3 >> 24) ^ TD1(s2 >> 16) ^ TD2(s1 >> 8) ^ TD3(s0) ^ rk[3];
+
+      s0 = t0;
+      s1 = t1;
+      s2 = t2;
+      s3 = t3;
     }
+
+  /* The last round has no InvMixColumns */
+
+  rk += 4;
+  t0 = ((uint32_t)g_rsbox[s0 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s3 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s2 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_rsbox[s1 & 0xff] ^ rk[0];
+  t1 = ((uint32_t)g_rsbox[s1 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s0 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s3 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_rsbox[s2 & 0xff] ^ rk[1];
+  t2 = ((uint32_t)g_rsbox[s2 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s1 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s0 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_rsbox[s3 & 0xff] ^ rk[2];
+  t3 = ((uint32_t)g_rsbox[s3 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s2 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s1 >> 8) & 0xff] << 8) ^
+        (uint32_t)g_rsbox[s0 & 0xff] ^ rk[3];
+
+  PUTU32(block, t0);
+  PUTU32(block + 4, t1);
+  PUTU32(block + 8, t2);
+  PUTU32(block + 12, t3);
 }
 
 /****************************************************************************
@@ -547,25 +481,24 @@ static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key, must be 16 (AES-128), 24 (AES-192) or 32
+ *         (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if len is not valid
  *
  ****************************************************************************/
 
 int aes_setupkey(FAR struct aes_state_s *state, FAR const uint8_t *key, int len)
 {
-  if (len != 16)
+  if (len != 16 && len != 24 && len != 32)
     {
       return -EINVAL;
     }
 
-  expand_key(state->expanded_key, key);
+  expand_key(state, key, len / 4);
   return 0;
 }
 
@@ -590,7 +523,7 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 
   for (i = 0; i < nblk; i++)
     {
-      aes_encr(blocks + off, state->expanded_key);
+      aes_encr(blocks + off, state);
       off += 16;
     }
 }
@@ -616,7 +549,7 @@ void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 
   for (i = 0; i < nblk; i++)
     {
-      aes_decr(blocks + off, state->expanded_key);
+      aes_decr(blocks + off, state);
       off += 16;
     }
 }
@@ -640,10 +573,10 @@ void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 
 void aes_encrypt(FAR uint8_t *state, FAR const uint8_t *key)
 {
-  /* Expand the key into 176 bytes */
+  /* Expand the key */
 
   aes_setupkey(&g_aes_state, key, 16);
-  aes_encr(state, g_aes_state.expanded_key);
+  aes_encr(state, &g_aes_state);
 }
 
 /****************************************************************************
@@ -665,8 +598,8 @@ void aes_encrypt(FAR uint8_t *state, FAR const uint8_t *key)
 
 void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key)
 {
-  /* Expand the key into 176 bytes */
+  /* Expand the key */
 
   aes_setupkey(&g_aes_state, key, 16);
-  aes_decr(state, g_aes_state.expanded_key);
+  aes_decr(state, &g_aes_state);
 }
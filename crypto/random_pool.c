@@ -49,6 +49,7 @@
 #include <errno.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/random.h>
 #include <nuttx/board.h>
 
@@ -65,6 +66,41 @@
 #define ROTL_32(x,n) ( ((x) << (n)) | ((x) >> (32-(n))) )
 #define ROTR_32(x,n) ( ((x) >> (n)) | ((x) << (32-(n))) )
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CHACHA
+#  if (CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE & 63) != 0 || \
+      CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE < 128
+#    error CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE must be a multiple of 64 >= 128
+#  endif
+
+#  ifdef CONFIG_SMP
+#    define RNG_NCPUS         CONFIG_SMP_NCPUS
+#    define rng_cpuindex()    up_cpu_index()
+#  else
+#    define RNG_NCPUS         1
+#    define rng_cpuindex()    0
+#  endif
+
+#  define CHACHA_KEYWORDS     8
+#  define CHACHA_KEYSIZE      (CHACHA_KEYWORDS * 4)
+#  define CHACHA_BLOCKSIZE    64
+
+/* Requests larger than this are generated directly into the caller's
+ * buffer using a one-time key.
+ */
+
+#  define CHACHA_BULK_SIZE    (CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE / 2)
+
+#  define CHACHA_QR(a,b,c,d) \
+  do \
+    { \
+      a += b; d ^= a; d = ROTL_32(d, 16); \
+      c += d; b ^= c; b = ROTL_32(b, 12); \
+      a += b; d ^= a; d = ROTL_32(d, 8); \
+      c += d; b ^= c; b = ROTL_32(b, 7); \
+    } \
+  while (0)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -93,6 +129,21 @@ struct rng_s
   struct blake2xs_rng_s blake2xs;
 };
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CHACHA
+/* Per-CPU ChaCha20 output generator.  Only accessed by the owning CPU with
+ * local interrupts disabled.
+ */
+
+struct rng_cpu_s
+{
+  uint32_t key[CHACHA_KEYWORDS];
+  uint32_t nrefills;     /* Batches generated since the last rekey */
+  uint16_t avail;        /* Unused bytes at the end of buf[] */
+  bool seeded;
+  uint8_t buf[CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE];
+};
+#endif
+
 enum
 {
   POOL_SIZE = ENTROPY_POOL_SIZE,
@@ -108,6 +159,10 @@ enum
 
 static struct rng_s g_rng;
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CHACHA
+static struct rng_cpu_s g_rng_cpu[RNG_NCPUS];
+#endif
+
 #ifdef CONFIG_BOARD_ENTROPY_POOL
 /* Entropy pool structure can be provided by board source. Use for this is,
  * for example, allocate entropy pool from special area of RAM which content
@@ -365,6 +420,229 @@ static void rng_buf_internal(FAR void *bytes, size_t nbytes)
     }
 }
 
+/****************************************************************************
+ * Name: rng_pool_get
+ *
+ * Description:
+ *   Get output from the BLAKE2Xs generator, serialized by rd_sem.
+ *
+ ****************************************************************************/
+
+static void rng_pool_get(FAR void *bytes, size_t nbytes)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(&g_rng.rd_sem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+
+  rng_buf_internal(bytes, nbytes);
+  nxsem_post(&g_rng.rd_sem);
+}
+
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CHACHA
+/****************************************************************************
+ * Name: chacha20_block
+ *
+ * Description:
+ *   Generate one 64 byte ChaCha20 keystream block (RFC 7539) for the given
+ *   key and block counter, with a zero nonce.
+ *
+ ****************************************************************************/
+
+static void chacha20_block(FAR const uint32_t *key, uint32_t counter,
+                           FAR uint8_t *out)
+{
+  uint32_t in[16];
+  uint32_t x[16];
+  int i;
+
+  in[0]  = 0x61707865;  /* "expand 32-byte k" */
+  in[1]  = 0x3320646e;
+  in[2]  = 0x79622d32;
+  in[3]  = 0x6b206574;
+  memcpy(&in[4], key, CHACHA_KEYSIZE);
+  in[12] = counter;
+  in[13] = 0;
+  in[14] = 0;
+  in[15] = 0;
+
+  memcpy(x, in, sizeof(x));
+
+  for (i = 0; i < 10; i++)
+    {
+      CHACHA_QR(x[0], x[4], x[8],  x[12]);
+      CHACHA_QR(x[1], x[5], x[9],  x[13]);
+      CHACHA_QR(x[2], x[6], x[10], x[14]);
+      CHACHA_QR(x[3], x[7], x[11], x[15]);
+      CHACHA_QR(x[0], x[5], x[10], x[15]);
+      CHACHA_QR(x[1], x[6], x[11], x[12]);
+      CHACHA_QR(x[2], x[7], x[8],  x[13]);
+      CHACHA_QR(x[3], x[4], x[9],  x[14]);
+    }
+
+  for (i = 0; i < 16; i++)
+    {
+      uint32_t w = x[i] + in[i];
+
+      out[4 * i]     = (uint8_t)w;
+      out[4 * i + 1] = (uint8_t)(w >> 8);
+      out[4 * i + 2] = (uint8_t)(w >> 16);
+      out[4 * i + 3] = (uint8_t)(w >> 24);
+    }
+
+  explicit_bzero(x, sizeof(x));
+  explicit_bzero(in, sizeof(in));
+}
+
+/****************************************************************************
+ * Name: chacha20_stream
+ *
+ * Description:
+ *   Fill a buffer with the ChaCha20 keystream for a one-time key.
+ *
+ ****************************************************************************/
+
+static void chacha20_stream(FAR const uint32_t *key, FAR uint8_t *bytes,
+                            size_t nbytes)
+{
+  uint8_t block[CHACHA_BLOCKSIZE];
+  uint32_t counter;
+
+  for (counter = 0; nbytes >= CHACHA_BLOCKSIZE; counter++)
+    {
+      chacha20_block(key, counter, bytes);
+      bytes  += CHACHA_BLOCKSIZE;
+      nbytes -= CHACHA_BLOCKSIZE;
+    }
+
+  if (nbytes > 0)
+    {
+      chacha20_block(key, counter, block);
+      memcpy(bytes, block, nbytes);
+      explicit_bzero(block, sizeof(block));
+    }
+}
+
+/****************************************************************************
+ * Name: rng_cpu_refill
+ *
+ * Description:
+ *   Generate a new batch into the per-CPU buffer.  The first 32 bytes of
+ *   the batch become the next key and are erased from the buffer.
+ *
+ ****************************************************************************/
+
+static void rng_cpu_refill(FAR struct rng_cpu_s *rc)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE / CHACHA_BLOCKSIZE; i++)
+    {
+      chacha20_block(rc->key, i, &rc->buf[i * CHACHA_BLOCKSIZE]);
+    }
+
+  memcpy(rc->key, rc->buf, CHACHA_KEYSIZE);
+  explicit_bzero(rc->buf, CHACHA_KEYSIZE);
+
+  rc->avail = CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE - CHACHA_KEYSIZE;
+  rc->nrefills++;
+}
+
+/****************************************************************************
+ * Name: rng_cpu_rekey
+ *
+ * Description:
+ *   Mix a fresh key from the BLAKE2Xs generator into the generator of the
+ *   CPU that we are running on (which may change while waiting for the
+ *   BLAKE2Xs generator).
+ *
+ ****************************************************************************/
+
+static void rng_cpu_rekey(void)
+{
+  FAR struct rng_cpu_s *rc;
+  uint32_t key[CHACHA_KEYWORDS];
+  irqstate_t flags;
+  int i;
+
+  rng_pool_get(key, sizeof(key));
+
+  flags = up_irq_save();
+  rc = &g_rng_cpu[rng_cpuindex()];
+
+  for (i = 0; i < CHACHA_KEYWORDS; i++)
+    {
+      rc->key[i] ^= key[i];
+    }
+
+  explicit_bzero(rc->buf, sizeof(rc->buf));
+  rc->avail    = 0;
+  rc->nrefills = 0;
+  rc->seeded   = true;
+  up_irq_restore(flags);
+
+  explicit_bzero(key, sizeof(key));
+}
+
+/****************************************************************************
+ * Name: rng_cpu_get
+ *
+ * Description:
+ *   Get output from the per-CPU generator.  Interrupts are disabled only on
+ *   this CPU so that the thread can be neither preempted nor migrated.
+ *
+ ****************************************************************************/
+
+static void rng_cpu_get(FAR uint8_t *bytes, size_t nbytes)
+{
+  FAR struct rng_cpu_s *rc;
+  irqstate_t flags;
+  size_t chunk;
+
+  flags = up_irq_save();
+  rc = &g_rng_cpu[rng_cpuindex()];
+
+  while (!rc->seeded || rc->nrefills >= CONFIG_CRYPTO_RANDOM_POOL_REKEY)
+    {
+      up_irq_restore(flags);
+      rng_cpu_rekey();
+      flags = up_irq_save();
+      rc = &g_rng_cpu[rng_cpuindex()];
+    }
+
+  while (nbytes > 0)
+    {
+      if (rc->avail == 0)
+        {
+          rng_cpu_refill(rc);
+        }
+
+      chunk = MIN(nbytes, rc->avail);
+      memcpy(bytes,
+             &rc->buf[CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE - rc->avail], chunk);
+      explicit_bzero(&rc->buf[CONFIG_CRYPTO_RANDOM_POOL_BUFSIZE - rc->avail],
+                     chunk);
+
+      rc->avail -= chunk;
+      bytes     += chunk;
+      nbytes    -= chunk;
+    }
+
+  up_irq_restore(flags);
+}
+#endif /* CONFIG_CRYPTO_RANDOM_POOL_CHACHA */
+
 static void rng_init(void)
 {
   cryptinfo("Initializing RNG\n");
@@ -521,6 +799,15 @@ void up_rngreseed(void)
     }
 
   nxsem_post(&g_rng.rd_sem);
+
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CHACHA
+  /* Have each per-CPU generator take a new key on its next use */
+
+  for (ret = 0; ret < RNG_NCPUS; ret++)
+    {
+      g_rng_cpu[ret].nrefills = CONFIG_CRYPTO_RANDOM_POOL_REKEY;
+    }
+#endif
 }
 
 /****************************************************************************
@@ -562,22 +849,22 @@ void up_randompool_initialize(void)
 
 void getrandom(FAR void *bytes, size_t nbytes)
 {
-  int ret;
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CHACHA
+  uint32_t key[CHACHA_KEYWORDS];
 
-  do
+  if (nbytes > CHACHA_BULK_SIZE)
     {
-      /* Take the semaphore (perhaps waiting) */
-
-      ret = nxsem_wait(&g_rng.rd_sem);
-
-      /* The only case that an error should occur here is if the wait was
-       * awakened by a signal.
-       */
+      /* Generate bulk requests outside of the per-CPU generator */
 
-      DEBUGASSERT(ret == OK || ret == -EINTR);
+      rng_cpu_get((FAR uint8_t *)key, sizeof(key));
+      chacha20_stream(key, bytes, nbytes);
+      explicit_bzero(key, sizeof(key));
     }
-  while (ret == -EINTR);
-
-  rng_buf_internal(bytes, nbytes);
-  nxsem_post(&g_rng.rd_sem);
+  else
+    {
+      rng_cpu_get(bytes, nbytes);
+    }
+#else
+  rng_pool_get(bytes, nbytes);
+#endif
 }
@@ -58,8 +58,10 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/analog/adc.h>
+#include <nuttx/analog/ioctl.h>
 #include <nuttx/random.h>
 
 #include <nuttx/irq.h>
@@ -75,6 +77,14 @@ static ssize_t adc_read(FAR struct file *fielp, FAR char *buffer,
 static int     adc_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
 static int     adc_receive(FAR struct adc_dev_s *dev, uint8_t ch,
                            int32_t data);
+#ifdef CONFIG_ADC_STREAM
+static int     adc_receive_block(FAR struct adc_dev_s *dev,
+                                 FAR const void *data, size_t nbytes);
+static int     adc_stream(FAR struct adc_dev_s *dev, bool enable);
+static ssize_t adc_stream_read(FAR struct file *filep,
+                               FAR struct adc_dev_s *dev,
+                               FAR char *buffer, size_t buflen);
+#endif
 static void    adc_notify(FAR struct adc_dev_s *dev);
 #ifndef CONFIG_DISABLE_POLL
 static int     adc_poll(FAR struct file *filep, struct pollfd *fds, bool setup);
@@ -102,7 +112,10 @@ static const struct file_operations g_adc_fops =
 
 static const struct adc_callback_s g_adc_callback =
 {
-  adc_receive   /* au_receive */
+  adc_receive         /* au_receive */
+#ifdef CONFIG_ADC_STREAM
+  , adc_receive_block /* au_receive_block */
+#endif
 };
 
 /****************************************************************************
@@ -214,8 +227,21 @@ static int adc_close(FAR struct file *filep)
 
           flags = enter_critical_section();       /* Disable interrupts */
           dev->ad_ops->ao_shutdown(dev);       /* Disable the ADC */
+#ifdef CONFIG_ADC_STREAM
+          dev->ad_stream.as_enabled = false;
+#endif
           leave_critical_section(flags);
 
+#ifdef CONFIG_ADC_STREAM
+          /* Release the stream buffer */
+
+          if (dev->ad_stream.as_buffer != NULL)
+            {
+              kmm_free(dev->ad_stream.as_buffer);
+              dev->ad_stream.as_buffer = NULL;
+            }
+#endif
+
           nxsem_post(&dev->ad_closesem);
         }
     }
@@ -238,6 +264,15 @@ static ssize_t adc_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
 
   ainfo("buflen: %d\n", (int)buflen);
 
+#ifdef CONFIG_ADC_STREAM
+  /* In continuous sampling mode, return raw blocks from the stream buffer */
+
+  if (dev->ad_stream.as_enabled)
+    {
+      return adc_stream_read(filep, dev, buffer, buflen);
+    }
+#endif
+
   /* Determine size of the messages to return.
    *
    * REVISIT:  What if buflen is 8 does that mean 4 messages of size 2?  Or
@@ -412,10 +447,191 @@ static int adc_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   FAR struct adc_dev_s *dev = inode->i_private;
   int ret;
 
+#ifdef CONFIG_ADC_STREAM
+  switch (cmd)
+    {
+      case ANIOC_STREAM:
+        ret = adc_stream(dev, (int)arg != 0);
+        break;
+
+      case ANIOC_OVERRUNS:
+        {
+          FAR uint32_t *overruns = (FAR uint32_t *)((uintptr_t)arg);
+          irqstate_t flags;
+
+          if (overruns == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          flags = enter_critical_section();
+          *overruns = dev->ad_stream.as_overruns;
+          dev->ad_stream.as_overruns = 0;
+          leave_critical_section(flags);
+          ret = OK;
+        }
+        break;
+
+      default:
+        ret = dev->ad_ops->ao_ioctl(dev, cmd, arg);
+        break;
+    }
+#else
   ret = dev->ad_ops->ao_ioctl(dev, cmd, arg);
+#endif
+
   return ret;
 }
 
+#ifdef CONFIG_ADC_STREAM
+/****************************************************************************
+ * Name: adc_stream
+ *
+ * Description:
+ *   Start or stop continuous sampling.  The lower half is asked to switch
+ *   its conversions (e.g. into circular DMA double buffering) with the
+ *   same ANIOC_STREAM command; it then delivers whole blocks through
+ *   au_receive_block().
+ *
+ ****************************************************************************/
+
+static int adc_stream(FAR struct adc_dev_s *dev, bool enable)
+{
+  FAR struct adc_stream_s *stream = &dev->ad_stream;
+  irqstate_t flags;
+  int ret;
+
+  if (enable == stream->as_enabled)
+    {
+      return OK;
+    }
+
+  if (enable)
+    {
+      if (stream->as_buffer == NULL)
+        {
+          stream->as_buffer = (FAR uint8_t *)
+            kmm_malloc(CONFIG_ADC_STREAM_BUFSIZE);
+          if (stream->as_buffer == NULL)
+            {
+              return -ENOMEM;
+            }
+        }
+
+      flags = enter_critical_section();
+      stream->as_head     = 0;
+      stream->as_count    = 0;
+      stream->as_overruns = 0;
+      stream->as_enabled  = true;
+      leave_critical_section(flags);
+
+      ret = dev->ad_ops->ao_ioctl(dev, ANIOC_STREAM, 1);
+      if (ret < 0)
+        {
+          aerr("ERROR: Lower half cannot stream: %d\n", ret);
+          stream->as_enabled = false;
+        }
+    }
+  else
+    {
+      ret = dev->ad_ops->ao_ioctl(dev, ANIOC_STREAM, 0);
+
+      /* Wake up readers waiting for stream data */
+
+      flags = enter_critical_section();
+      stream->as_enabled = false;
+      adc_notify(dev);
+      leave_critical_section(flags);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: adc_stream_read
+ *
+ * Description:
+ *   Copy as much buffered sample data as fits into the user buffer,
+ *   waiting for data unless O_NONBLOCK is set.  The copy is made with
+ *   interrupts enabled; the lower half only ever appends behind the data
+ *   being read.
+ *
+ ****************************************************************************/
+
+static ssize_t adc_stream_read(FAR struct file *filep,
+                               FAR struct adc_dev_s *dev,
+                               FAR char *buffer, size_t buflen)
+{
+  FAR struct adc_stream_s *stream = &dev->ad_stream;
+  irqstate_t flags;
+  size_t nread;
+  size_t chunk;
+  size_t head;
+  int ret;
+
+  ret = nxsem_wait(&stream->as_exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = enter_critical_section();
+  while (stream->as_count == 0)
+    {
+      if (!stream->as_enabled || (filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          ret = -EAGAIN;
+          goto errout_with_irqdisabled;
+        }
+
+      dev->ad_nrxwaiters++;
+      ret = nxsem_wait(&dev->ad_recv.af_sem);
+      dev->ad_nrxwaiters--;
+      if (ret < 0)
+        {
+          goto errout_with_irqdisabled;
+        }
+    }
+
+  nread = stream->as_count < buflen ? stream->as_count : buflen;
+  head  = stream->as_head;
+  leave_critical_section(flags);
+
+  /* Copy in at most two pieces around the end of the ring */
+
+  chunk = CONFIG_ADC_STREAM_BUFSIZE - head;
+  if (chunk > nread)
+    {
+      chunk = nread;
+    }
+
+  memcpy(buffer, &stream->as_buffer[head], chunk);
+  memcpy(&buffer[chunk], stream->as_buffer, nread - chunk);
+
+  /* Release the space */
+
+  flags = enter_critical_section();
+  head += nread;
+  if (head >= CONFIG_ADC_STREAM_BUFSIZE)
+    {
+      head -= CONFIG_ADC_STREAM_BUFSIZE;
+    }
+
+  stream->as_head   = head;
+  stream->as_count -= nread;
+  leave_critical_section(flags);
+
+  nxsem_post(&stream->as_exclsem);
+  return nread;
+
+errout_with_irqdisabled:
+  leave_critical_section(flags);
+  nxsem_post(&stream->as_exclsem);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: adc_receive
  ****************************************************************************/
@@ -457,6 +673,53 @@ static int adc_receive(FAR struct adc_dev_s *dev, uint8_t ch, int32_t data)
   return errcode;
 }
 
+/****************************************************************************
+ * Name: adc_receive_block
+ ****************************************************************************/
+
+#ifdef CONFIG_ADC_STREAM
+static int adc_receive_block(FAR struct adc_dev_s *dev,
+                             FAR const void *data, size_t nbytes)
+{
+  FAR struct adc_stream_s *stream = &dev->ad_stream;
+  FAR const uint8_t *src = (FAR const uint8_t *)data;
+  size_t tail;
+  size_t chunk;
+
+  if (!stream->as_enabled || stream->as_buffer == NULL)
+    {
+      return -EPERM;
+    }
+
+  /* Blocks are kept whole so that the stream stays sample aligned */
+
+  if (nbytes > CONFIG_ADC_STREAM_BUFSIZE - stream->as_count)
+    {
+      stream->as_overruns += nbytes;
+      return -ENOSPC;
+    }
+
+  tail = stream->as_head + stream->as_count;
+  if (tail >= CONFIG_ADC_STREAM_BUFSIZE)
+    {
+      tail -= CONFIG_ADC_STREAM_BUFSIZE;
+    }
+
+  chunk = CONFIG_ADC_STREAM_BUFSIZE - tail;
+  if (chunk > nbytes)
+    {
+      chunk = nbytes;
+    }
+
+  memcpy(&stream->as_buffer[tail], src, chunk);
+  memcpy(stream->as_buffer, &src[chunk], nbytes - chunk);
+  stream->as_count += nbytes;
+
+  adc_notify(dev);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: adc_pollnotify
  ****************************************************************************/
@@ -564,6 +827,12 @@ static int adc_poll(FAR struct file *filep, struct pollfd *fds, bool setup)
         {
           adc_pollnotify(dev, POLLIN);
         }
+#ifdef CONFIG_ADC_STREAM
+      else if (dev->ad_stream.as_count > 0)
+        {
+          adc_pollnotify(dev, POLLIN);
+        }
+#endif
     }
   else if (fds->priv)
     {
@@ -615,6 +884,9 @@ int adc_register(FAR const char *path, FAR struct adc_dev_s *dev)
 
   nxsem_init(&dev->ad_recv.af_sem, 0, 0);
   nxsem_init(&dev->ad_closesem, 0, 1);
+#ifdef CONFIG_ADC_STREAM
+  nxsem_init(&dev->ad_stream.as_exclsem, 0, 1);
+#endif
 
   /* The receive semaphore is used for signaling and, hence, should not have
    * priority inheritance enabled.
@@ -634,6 +906,9 @@ int adc_register(FAR const char *path, FAR struct adc_dev_s *dev)
     {
       nxsem_destroy(&dev->ad_recv.af_sem);
       nxsem_destroy(&dev->ad_closesem);
+#ifdef CONFIG_ADC_STREAM
+      nxsem_destroy(&dev->ad_stream.as_exclsem);
+#endif
     }
 
   return ret;
@@ -47,6 +47,7 @@
 #include <stdbool.h>
 #include <semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/drivers/blkcache.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -55,22 +56,53 @@
 #define bchlib_semgive(d) nxsem_post(&(d)->sem)  /* To match bchlib_semtake */
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+#ifndef CONFIG_BCH_NSECTORS
+#  define CONFIG_BCH_NSECTORS 1
+#endif
+
+/* Block driver access.  With CONFIG_DRVR_BLKCACHE this goes through the
+ * shared block cache.  Only a negative (error) return value is meaningful.
+ */
+
+#ifdef CONFIG_DRVR_BLKCACHE
+#  define bchlib_devread(b,buf,s,n) \
+     blkcache_read((b)->inode, (FAR uint8_t *)(buf), s, n, (b)->sectsize)
+#  define bchlib_devwrite(b,buf,s,n) \
+     blkcache_write((b)->inode, (FAR const uint8_t *)(buf), s, n, (b)->sectsize)
+#else
+#  define bchlib_devread(b,buf,s,n) \
+     (b)->inode->u.i_bops->read((b)->inode, (FAR uint8_t *)(buf), s, n)
+#  define bchlib_devwrite(b,buf,s,n) \
+     (b)->inode->u.i_bops->write((b)->inode, (FAR const uint8_t *)(buf), s, n)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* One entry in the sector cache */
+
+struct bchlib_sector_s
+{
+  size_t sector;           /* The sector in the buffer ((size_t)-1: none) */
+  uint32_t lru;            /* Access stamp for LRU replacement */
+  bool dirty;              /* true: Data has been written to the buffer */
+  FAR uint8_t *buffer;     /* One sector buffer */
+};
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
   sem_t sem;               /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  uint32_t lru;            /* Access counter for LRU replacement */
+  FAR uint8_t *buffer;     /* CONFIG_BCH_NSECTORS contiguous sector buffers */
+  FAR struct bchlib_sector_s *cur;  /* Entry of the last bchlib_readsector() */
+  struct bchlib_sector_s cache[CONFIG_BCH_NSECTORS];
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -98,6 +130,11 @@ EXTERN const struct file_operations bch_fops;
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN void bchlib_cacheread(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                             size_t sector, size_t nsectors);
+EXTERN void bchlib_cachewrite(FAR struct bchlib_s *bch,
+                              FAR const uint8_t *buffer, size_t sector,
+                              size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
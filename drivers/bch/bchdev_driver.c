@@ -409,6 +409,31 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_BCH_WRITEBACK
+      /* Write any modified sectors in the cache to the media, then pass
+       * the flush on to the contained block driver.
+       */
+
+      case BIOC_FLUSH:
+        {
+          FAR struct inode *bchinode = bch->inode;
+
+          bchlib_semtake(bch);
+          ret = bchlib_flushsector(bch);
+          bchlib_semgive(bch);
+
+          if (ret >= 0 && bchinode->u.i_bops->ioctl != NULL)
+            {
+              ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+              if (ret == -ENOTTY)
+                {
+                  ret = OK;
+                }
+            }
+        }
+        break;
+#endif
+
 #ifdef CONFIG_BCH_ENCRYPTION
       /* This is a request to set the encryption key? */
 
@@ -40,7 +40,9 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -74,10 +76,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch,
+                      FAR struct bchlib_sector_s *entry, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)entry->buffer;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -85,7 +88,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        entry->sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -104,68 +107,146 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bchlib_flushrun
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Write the dirty cache entry at 'index' to the media together with any
+ *   following entries that hold the next consecutive dirty sectors.  The
+ *   sector buffers are contiguous in memory so that such a run can be
+ *   written with a single multi-sector transfer.
+ *
+ * Returned Value:
+ *   The number of cache entries written on success; a negated errno value
+ *   on failure.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
  *
  ****************************************************************************/
 
-int bchlib_flushsector(FAR struct bchlib_s *bch)
+static int bchlib_flushrun(FAR struct bchlib_s *bch, int index)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  FAR struct bchlib_sector_s *first = &bch->cache[index];
+  ssize_t ret;
+  int nrun;
+  int i;
 
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
-   */
+  DEBUGASSERT(first->dirty);
 
-  if (bch->dirty)
+  for (nrun = 1; index + nrun < CONFIG_BCH_NSECTORS; nrun++)
     {
-      inode = bch->inode;
+      FAR struct bchlib_sector_s *entry = &bch->cache[index + nrun];
+
+      if (!entry->dirty || entry->sector != first->sector + nrun)
+        {
+          break;
+        }
+    }
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-      /* Encrypt data as necessary */
+  /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+  for (i = 0; i < nrun; i++)
+    {
+      bch_cypher(bch, &bch->cache[index + i], CYPHER_ENCRYPT);
+    }
 #endif
 
-      /* Write the sector to the media */
+  /* Write the sectors to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
-        {
-          ferr("Write failed: %d\n");
-        }
+  ret = bchlib_devwrite(bch, first->buffer, first->sector, nrun);
+  if (ret < 0)
+    {
+      ferr("Write failed: %d\n", (int)ret);
+    }
 
+  for (i = 0; i < nrun; i++)
+    {
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Computation overhead to save memory for extra sector buffer
        * TODO: Add configuration switch for extra sector buffer
        */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, &bch->cache[index + i], CYPHER_DECRYPT);
 #endif
 
       /* The sector is now in sync with the media */
 
-      bch->dirty = false;
+      bch->cache[index + i].dirty = false;
     }
 
-  return (int)ret;
+  return ret < 0 ? (int)ret : nrun;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the current contents of the sector cache (if dirty)
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+  int result = OK;
+  int ret;
+  int i;
+
+  /* Write each run of sectors that has been modified and is out of synch
+   * with the media.
+   */
+
+  for (i = 0; i < CONFIG_BCH_NSECTORS; )
+    {
+      if (bch->cache[i].dirty)
+        {
+          ret = bchlib_flushrun(bch, i);
+          if (ret < 0)
+            {
+              /* Remember the first error, but keep flushing */
+
+              if (result == OK)
+                {
+                  result = ret;
+                }
+
+              ret = 1;
+            }
+
+          i += ret;
+        }
+      else
+        {
+          i++;
+        }
+    }
+
+  /* Sectors written through to the shared block cache may still be held
+   * there.
+   */
+
+  ret = blkcache_flush(bch->inode);
+  if (ret < 0 && result == OK)
+    {
+      result = ret;
+    }
+
+  return result;
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Make 'sector' the current sector (bch->cur), reading it into the
+ *   least recently used cache entry if it is not already cached.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -174,26 +255,120 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
-  FAR struct inode *inode;
+  FAR struct bchlib_sector_s *entry;
+  FAR struct bchlib_sector_s *victim = NULL;
   ssize_t ret = OK;
+  int i;
+
+  /* Is the sector already in the cache?  If not, select the entry to
+   * replace:  An empty one if possible, otherwise the least recently used.
+   */
+
+  for (i = 0; i < CONFIG_BCH_NSECTORS; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->sector == sector)
+        {
+          break;
+        }
+
+      if (victim == NULL ||
+          (victim->sector != (size_t)-1 &&
+           (entry->sector == (size_t)-1 ||
+            (int32_t)(entry->lru - victim->lru) < 0)))
+        {
+          victim = entry;
+        }
+    }
 
-  if (bch->sector != sector)
+  if (i >= CONFIG_BCH_NSECTORS)
     {
-      inode = bch->inode;
+      entry = victim;
+
+      if (entry->dirty)
+        {
+          (void)bchlib_flushrun(bch, entry - bch->cache);
+        }
 
-      (void)bchlib_flushsector(bch);
-      bch->sector = (size_t)-1;
+      entry->sector = (size_t)-1;
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      ret = bchlib_devread(bch, entry->buffer, sector, 1);
       if (ret < 0)
         {
-          ferr("Read failed: %d\n");
+          ferr("Read failed: %d\n", (int)ret);
+          return (int)ret;
         }
-      bch->sector = sector;
+
+      entry->sector = sector;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, entry, CYPHER_DECRYPT);
 #endif
     }
+
+  entry->lru = ++bch->lru;
+  bch->cur   = entry;
   return (int)ret;
 }
 
+/****************************************************************************
+ * Name: bchlib_cacheread
+ *
+ * Description:
+ *   Called after full sectors have been read directly from the media into
+ *   the user buffer.  Replace any sectors that are modified in the cache
+ *   with the cached data.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_cacheread(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                      size_t sector, size_t nsectors)
+{
+  FAR struct bchlib_sector_s *entry;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_NSECTORS; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->dirty && entry->sector >= sector &&
+          entry->sector < sector + nsectors)
+        {
+          memcpy(&buffer[(entry->sector - sector) * bch->sectsize],
+                 entry->buffer, bch->sectsize);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bchlib_cachewrite
+ *
+ * Description:
+ *   Called after full sectors have been written directly from the user
+ *   buffer to the media.  Update any cached copies of those sectors.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_cachewrite(FAR struct bchlib_s *bch, FAR const uint8_t *buffer,
+                       size_t sector, size_t nsectors)
+{
+  FAR struct bchlib_sector_s *entry;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_NSECTORS; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->sector != (size_t)-1 && entry->sector >= sector &&
+          entry->sector < sector + nsectors)
+        {
+          memcpy(entry->buffer,
+                 &buffer[(entry->sector - sector) * bch->sectsize],
+                 bch->sectsize);
+          entry->dirty = false;
+        }
+    }
+}
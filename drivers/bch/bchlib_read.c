@@ -113,7 +113,11 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
     {
       /* Read the sector into the sector buffer */
 
-      bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Copy the tail end of the sector to the user buffer */
 
@@ -126,7 +130,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
           nbytes = len;
         }
 
-      memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+      memcpy(buffer, &bch->cur->buffer[sectoffset], nbytes);
 
       /* Adjust pointers and counts */
 
@@ -154,14 +158,17 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
           nsectors = bch->nsectors - sector;
         }
 
-      ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-                                       sector, nsectors);
+      ret = bchlib_devread(bch, buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Read failed: %d\n");
           return ret;
         }
 
+      /* Sectors modified in the cache are newer than the media */
+
+      bchlib_cacheread(bch, (FAR uint8_t *)buffer, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector    += nsectors;
@@ -183,11 +190,15 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
     {
       /* Read the sector into the sector buffer */
 
-      bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return bytesread > 0 ? (ssize_t)bytesread : ret;
+        }
 
       /* Copy the head end of the sector to the user buffer */
 
-      memcpy(buffer, bch->buffer, len);
+      memcpy(buffer, bch->cur->buffer, len);
 
       /* Adjust counts */
 
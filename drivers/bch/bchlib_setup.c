@@ -72,6 +72,7 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
   FAR struct bchlib_s *bch;
   struct geometry geo;
   int ret;
+  int i;
 
   DEBUGASSERT(blkdev);
 
@@ -121,12 +122,15 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
   nxsem_init(&bch->sem, 0, 1);
   bch->nsectors = geo.geo_nsectors;
   bch->sectsize = geo.geo_sectorsize;
-  bch->sector   = (size_t)-1;
   bch->readonly = readonly;
 
-  /* Allocate the sector I/O buffer */
+  /* Allocate the sector I/O buffers.  These are allocated as one
+   * contiguous region so that consecutive sectors in consecutive cache
+   * entries can be transferred together.
+   */
 
-  bch->buffer = (FAR uint8_t *)kmm_malloc(bch->sectsize);
+  bch->buffer = (FAR uint8_t *)
+    kmm_malloc(CONFIG_BCH_NSECTORS * bch->sectsize);
   if (!bch->buffer)
     {
       ferr("ERROR: Failed to allocate sector buffer\n");
@@ -134,6 +138,14 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
       goto errout_with_bch;
     }
 
+  for (i = 0; i < CONFIG_BCH_NSECTORS; i++)
+    {
+      bch->cache[i].sector = (size_t)-1;
+      bch->cache[i].buffer = &bch->buffer[i * bch->sectsize];
+    }
+
+  bch->cur = &bch->cache[0];
+
   *handle = bch;
   return OK;
 
@@ -99,7 +99,11 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
     {
       /* Read the full sector into the sector buffer */
 
-      bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Copy the tail end of the sector from the user buffer */
 
@@ -112,8 +116,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           nbytes = len;
         }
 
-      memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      memcpy(&bch->cur->buffer[sectoffset], buffer, nbytes);
+      bch->cur->dirty = true;
 
       /* Adjust pointers and counts */
 
@@ -143,14 +147,17 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
       /* Write the contiguous sectors */
 
-      ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-                                        sector, nsectors);
+      ret = bchlib_devwrite(bch, buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Write failed: %d\n", ret);
           return ret;
         }
 
+      /* Keep any cached copies of these sectors up to date */
+
+      bchlib_cachewrite(bch, (FAR const uint8_t *)buffer, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector       += nsectors;
@@ -172,18 +179,23 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
     {
       /* Read the sector into the sector buffer */
 
-      bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return byteswritten > 0 ? (ssize_t)byteswritten : ret;
+        }
 
       /* Copy the head end of the sector from the user buffer */
 
-      memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      memcpy(bch->cur->buffer, buffer, len);
+      bch->cur->dirty = true;
 
       /* Adjust counts */
 
       byteswritten += len;
     }
 
+#ifndef CONFIG_BCH_WRITEBACK
   /* Finally, flush any cached writes to the device as well */
 
   ret = bchlib_flushsector(bch);
@@ -192,6 +204,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
       ferr("ERROR: Flush failed: %d\n", ret);
       return ret;
     }
+#endif
 
   return byteswritten;
 }
@@ -0,0 +1,709 @@
+/****************************************************************************
+ * drivers/blkcache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/drivers/blkcache.h>
+
+#ifdef CONFIG_DRVR_BLKCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_DRVR_BLKCACHE_NBLOCKS
+#  define CONFIG_DRVR_BLKCACHE_NBLOCKS 32
+#endif
+
+#ifndef CONFIG_DRVR_BLKCACHE_BLOCKSIZE
+#  define CONFIG_DRVR_BLKCACHE_BLOCKSIZE 512
+#endif
+
+#ifndef CONFIG_DRVR_BLKCACHE_NBUCKETS
+#  define CONFIG_DRVR_BLKCACHE_NBUCKETS 16
+#endif
+
+#if (CONFIG_DRVR_BLKCACHE_NBUCKETS & (CONFIG_DRVR_BLKCACHE_NBUCKETS - 1)) != 0
+#  error CONFIG_DRVR_BLKCACHE_NBUCKETS must be a power of two
+#endif
+
+#if (CONFIG_DRVR_BLKCACHE_BLOCKSIZE & 3) != 0
+#  error CONFIG_DRVR_BLKCACHE_BLOCKSIZE must be a multiple of 4
+#endif
+
+/* The data buffer of cache entry 'n' */
+
+#define BLKCACHE_DATA(n)  ((FAR uint8_t *)g_blkcache_data[n])
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached block.  An entry whose inode is NULL is unused and is not
+ * linked into any hash bucket.
+ *
+ * The identity of an entry (inode, block, bucket) only changes with
+ * g_blkcache_evict held.  Its data and flags, and the bucket's chain,
+ * are protected by the bucket's lock.
+ */
+
+struct blkcache_ent_s
+{
+  FAR struct blkcache_ent_s *hnext;   /* Next entry in the same bucket */
+  FAR struct inode *inode;            /* Block driver; NULL if unused */
+  blkcnt_t block;                     /* Block number on the driver */
+  uint16_t blksize;                   /* Size of the block */
+  uint8_t bucket;                     /* Index of the hash bucket */
+  bool dirty;                         /* Newer than the media */
+  volatile bool ref;                  /* Used since the last eviction sweep */
+};
+
+struct blkcache_bucket_s
+{
+  sem_t lock;                         /* Protects the chain and its entries */
+  FAR struct blkcache_ent_s *head;    /* Chain of cached blocks */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct blkcache_ent_s g_blkcache_ent[CONFIG_DRVR_BLKCACHE_NBLOCKS];
+static uint32_t g_blkcache_data[CONFIG_DRVR_BLKCACHE_NBLOCKS]
+                               [CONFIG_DRVR_BLKCACHE_BLOCKSIZE / 4];
+static struct blkcache_bucket_s g_blkcache_bucket[CONFIG_DRVR_BLKCACHE_NBUCKETS];
+
+/* Serializes changes of entry identity: eviction, insertion, flush and
+ * invalidation.  Cache hits do not take it.
+ */
+
+static sem_t g_blkcache_evict;
+static int g_blkcache_hand;           /* CLOCK eviction hand */
+static bool g_blkcache_initialized;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_takesem
+ ****************************************************************************/
+
+static void blkcache_takesem(FAR sem_t *sem)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting).  The only expected error is
+       * EINTR.
+       */
+
+      ret = nxsem_wait(sem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+#define blkcache_givesem(s) nxsem_post(s)
+
+/****************************************************************************
+ * Name: blkcache_initialize
+ *
+ * Description:
+ *   Initialize the cache on first use.
+ *
+ ****************************************************************************/
+
+static void blkcache_initialize(void)
+{
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+  if (!g_blkcache_initialized)
+    {
+      for (i = 0; i < CONFIG_DRVR_BLKCACHE_NBUCKETS; i++)
+        {
+          nxsem_init(&g_blkcache_bucket[i].lock, 0, 1);
+          g_blkcache_bucket[i].head = NULL;
+        }
+
+      nxsem_init(&g_blkcache_evict, 0, 1);
+      g_blkcache_hand        = 0;
+      g_blkcache_initialized = true;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: blkcache_hash
+ ****************************************************************************/
+
+static inline unsigned int blkcache_hash(FAR struct inode *inode,
+                                         blkcnt_t block)
+{
+  return ((unsigned int)((uintptr_t)inode >> 4) ^ (unsigned int)block) &
+         (CONFIG_DRVR_BLKCACHE_NBUCKETS - 1);
+}
+
+/****************************************************************************
+ * Name: blkcache_find
+ *
+ * Description:
+ *   Find a block in a bucket.  The bucket must be locked.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_ent_s *
+  blkcache_find(FAR struct blkcache_bucket_s *bucket,
+                FAR struct inode *inode, blkcnt_t block, uint16_t blksize)
+{
+  FAR struct blkcache_ent_s *ent;
+
+  for (ent = bucket->head; ent != NULL; ent = ent->hnext)
+    {
+      if (ent->inode == inode && ent->block == block &&
+          ent->blksize == blksize)
+        {
+          return ent;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: blkcache_unlink
+ *
+ * Description:
+ *   Remove an entry from its bucket and mark it unused.  The caller must
+ *   hold g_blkcache_evict and the bucket lock.
+ *
+ ****************************************************************************/
+
+static void blkcache_unlink(FAR struct blkcache_ent_s *ent)
+{
+  FAR struct blkcache_ent_s **link;
+
+  link = &g_blkcache_bucket[ent->bucket].head;
+  while (*link != NULL)
+    {
+      if (*link == ent)
+        {
+          *link = ent->hnext;
+          break;
+        }
+
+      link = &(*link)->hnext;
+    }
+
+  ent->hnext = NULL;
+  ent->inode = NULL;
+  ent->dirty = false;
+  ent->ref   = false;
+}
+
+/****************************************************************************
+ * Name: blkcache_devread and blkcache_devwrite
+ *
+ * Description:
+ *   Transfer blocks directly to or from the block driver.
+ *
+ ****************************************************************************/
+
+static int blkcache_devread(FAR struct inode *inode, FAR uint8_t *buffer,
+                            blkcnt_t start, unsigned int nblocks)
+{
+  ssize_t nread;
+
+  if (inode->u.i_bops == NULL || inode->u.i_bops->read == NULL)
+    {
+      return -ENODEV;
+    }
+
+  nread = inode->u.i_bops->read(inode, buffer, start, nblocks);
+  if (nread == (ssize_t)nblocks)
+    {
+      return OK;
+    }
+
+  return nread < 0 ? (int)nread : -EIO;
+}
+
+static int blkcache_devwrite(FAR struct inode *inode,
+                             FAR const uint8_t *buffer, blkcnt_t start,
+                             unsigned int nblocks)
+{
+  ssize_t nwritten;
+
+  if (inode->u.i_bops == NULL || inode->u.i_bops->write == NULL)
+    {
+      return -EACCES;
+    }
+
+  nwritten = inode->u.i_bops->write(inode, buffer, start, nblocks);
+  if (nwritten == (ssize_t)nblocks)
+    {
+      return OK;
+    }
+
+  return nwritten < 0 ? (int)nwritten : -EIO;
+}
+
+/****************************************************************************
+ * Name: blkcache_victim
+ *
+ * Description:
+ *   Select an entry to (re-)use with the CLOCK algorithm:  Unused entries
+ *   are taken immediately, referenced entries get a second chance and the
+ *   first unreferenced entry is evicted, after writing it back if it is
+ *   dirty.  The caller must hold g_blkcache_evict.
+ *
+ * Returned Value:
+ *   An unused entry, or NULL if none could be made available.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_ent_s *blkcache_victim(void)
+{
+  FAR struct blkcache_ent_s *ent;
+  FAR struct blkcache_bucket_s *bucket;
+  int n;
+
+  for (n = 0; n < 2 * CONFIG_DRVR_BLKCACHE_NBLOCKS; n++)
+    {
+      ent = &g_blkcache_ent[g_blkcache_hand];
+      if (++g_blkcache_hand >= CONFIG_DRVR_BLKCACHE_NBLOCKS)
+        {
+          g_blkcache_hand = 0;
+        }
+
+      if (ent->inode == NULL)
+        {
+          return ent;
+        }
+
+      if (ent->ref)
+        {
+          ent->ref = false;
+          continue;
+        }
+
+      bucket = &g_blkcache_bucket[ent->bucket];
+      blkcache_takesem(&bucket->lock);
+
+      if (ent->dirty &&
+          blkcache_devwrite(ent->inode, BLKCACHE_DATA(ent - g_blkcache_ent),
+                            ent->block, 1) < 0)
+        {
+          /* Keep the dirty block and try another */
+
+          ferr("ERROR: Failed to write back block %lu\n",
+               (unsigned long)ent->block);
+          blkcache_givesem(&bucket->lock);
+          continue;
+        }
+
+      blkcache_unlink(ent);
+      blkcache_givesem(&bucket->lock);
+      return ent;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: blkcache_store
+ *
+ * Description:
+ *   Put one block into the cache.  If the block is already cached, its
+ *   copy is replaced only if 'replace' is true; a read fill must not
+ *   overwrite a newer copy that was stored while the media was read.
+ *
+ * Returned Value:
+ *   OK if the block is now cached; -ENOMEM if no entry was available.
+ *
+ ****************************************************************************/
+
+static int blkcache_store(FAR struct inode *inode, FAR const uint8_t *buffer,
+                          blkcnt_t block, uint16_t blksize, bool dirty,
+                          bool replace)
+{
+  FAR struct blkcache_bucket_s *bucket;
+  FAR struct blkcache_ent_s *ent;
+  FAR struct blkcache_ent_s *victim;
+  unsigned int ndx = blkcache_hash(inode, block);
+
+  bucket = &g_blkcache_bucket[ndx];
+
+  /* Most writes hit a block that is already cached, which only needs the
+   * bucket lock.
+   */
+
+  if (replace)
+    {
+      blkcache_takesem(&bucket->lock);
+      ent = blkcache_find(bucket, inode, block, blksize);
+      if (ent != NULL)
+        {
+          memcpy(BLKCACHE_DATA(ent - g_blkcache_ent), buffer, blksize);
+          ent->dirty = dirty;
+          ent->ref   = true;
+          blkcache_givesem(&bucket->lock);
+          return OK;
+        }
+
+      blkcache_givesem(&bucket->lock);
+    }
+
+  blkcache_takesem(&g_blkcache_evict);
+
+  victim = blkcache_victim();
+  if (victim == NULL)
+    {
+      blkcache_givesem(&g_blkcache_evict);
+      return -ENOMEM;
+    }
+
+  blkcache_takesem(&bucket->lock);
+
+  /* Somebody may have cached the block while we were not holding the
+   * bucket lock.  The victim is then simply left unused.
+   */
+
+  ent = blkcache_find(bucket, inode, block, blksize);
+  if (ent == NULL)
+    {
+      ent          = victim;
+      ent->inode   = inode;
+      ent->block   = block;
+      ent->blksize = blksize;
+      ent->bucket  = ndx;
+      ent->hnext   = bucket->head;
+      bucket->head = ent;
+    }
+  else if (!replace)
+    {
+      blkcache_givesem(&bucket->lock);
+      blkcache_givesem(&g_blkcache_evict);
+      return OK;
+    }
+
+  memcpy(BLKCACHE_DATA(ent - g_blkcache_ent), buffer, blksize);
+  ent->dirty = dirty;
+  ent->ref   = true;
+
+  blkcache_givesem(&bucket->lock);
+  blkcache_givesem(&g_blkcache_evict);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:
+ *   See include/nuttx/drivers/blkcache.h
+ *
+ ****************************************************************************/
+
+int blkcache_read(FAR struct inode *inode, FAR uint8_t *buffer,
+                  blkcnt_t start, unsigned int nblocks, uint16_t blksize)
+{
+  FAR struct blkcache_bucket_s *bucket;
+  FAR struct blkcache_ent_s *ent;
+  unsigned int i;
+  int ret;
+
+  DEBUGASSERT(inode != NULL && buffer != NULL);
+
+  if (blksize > CONFIG_DRVR_BLKCACHE_BLOCKSIZE)
+    {
+      return blkcache_devread(inode, buffer, start, nblocks);
+    }
+
+  if (!g_blkcache_initialized)
+    {
+      blkcache_initialize();
+    }
+
+  if (nblocks == 1)
+    {
+      bucket = &g_blkcache_bucket[blkcache_hash(inode, start)];
+
+      blkcache_takesem(&bucket->lock);
+      ent = blkcache_find(bucket, inode, start, blksize);
+      if (ent != NULL)
+        {
+          memcpy(buffer, BLKCACHE_DATA(ent - g_blkcache_ent), blksize);
+          ent->ref = true;
+          blkcache_givesem(&bucket->lock);
+          return OK;
+        }
+
+      blkcache_givesem(&bucket->lock);
+
+      ret = blkcache_devread(inode, buffer, start, 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Failure to cache the block is not an error for the read */
+
+      (void)blkcache_store(inode, buffer, start, blksize, false, false);
+      return OK;
+    }
+
+  /* Multi-block reads bypass the cache so that large sequential transfers
+   * do not flush it, but dirty cached blocks are newer than the media.
+   */
+
+  ret = blkcache_devread(inode, buffer, start, nblocks);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < nblocks; i++)
+    {
+      bucket = &g_blkcache_bucket[blkcache_hash(inode, start + i)];
+
+      blkcache_takesem(&bucket->lock);
+      ent = blkcache_find(bucket, inode, start + i, blksize);
+      if (ent != NULL && ent->dirty)
+        {
+          memcpy(&buffer[(size_t)i * blksize],
+                 BLKCACHE_DATA(ent - g_blkcache_ent), blksize);
+        }
+
+      blkcache_givesem(&bucket->lock);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description:
+ *   See include/nuttx/drivers/blkcache.h
+ *
+ ****************************************************************************/
+
+int blkcache_write(FAR struct inode *inode, FAR const uint8_t *buffer,
+                   blkcnt_t start, unsigned int nblocks, uint16_t blksize)
+{
+  FAR struct blkcache_bucket_s *bucket;
+  FAR struct blkcache_ent_s *ent;
+  unsigned int i;
+  int ret;
+
+  DEBUGASSERT(inode != NULL && buffer != NULL);
+
+  if (blksize > CONFIG_DRVR_BLKCACHE_BLOCKSIZE)
+    {
+      return blkcache_devwrite(inode, buffer, start, nblocks);
+    }
+
+  if (!g_blkcache_initialized)
+    {
+      blkcache_initialize();
+    }
+
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  /* Defer single block writes.  If the block cannot be cached, write it
+   * through.
+   */
+
+  if (nblocks == 1 &&
+      blkcache_store(inode, buffer, start, blksize, true, true) == OK)
+    {
+      return OK;
+    }
+#endif
+
+  ret = blkcache_devwrite(inode, buffer, start, nblocks);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (nblocks == 1)
+    {
+      (void)blkcache_store(inode, buffer, start, blksize, false, true);
+      return OK;
+    }
+
+  /* Refresh any cached copies of the blocks of a multi-block write.  They
+   * are now clean.
+   */
+
+  for (i = 0; i < nblocks; i++)
+    {
+      bucket = &g_blkcache_bucket[blkcache_hash(inode, start + i)];
+
+      blkcache_takesem(&bucket->lock);
+      ent = blkcache_find(bucket, inode, start + i, blksize);
+      if (ent != NULL)
+        {
+          memcpy(BLKCACHE_DATA(ent - g_blkcache_ent),
+                 &buffer[(size_t)i * blksize], blksize);
+          ent->dirty = false;
+        }
+
+      blkcache_givesem(&bucket->lock);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   See include/nuttx/drivers/blkcache.h
+ *
+ ****************************************************************************/
+
+int blkcache_flush(FAR struct inode *inode)
+{
+  FAR struct blkcache_bucket_s *bucket;
+  FAR struct blkcache_ent_s *ent;
+  int result = OK;
+  int ret;
+  int i;
+
+  if (!g_blkcache_initialized || inode == NULL)
+    {
+      return OK;
+    }
+
+  blkcache_takesem(&g_blkcache_evict);
+
+  for (i = 0; i < CONFIG_DRVR_BLKCACHE_NBLOCKS; i++)
+    {
+      ent = &g_blkcache_ent[i];
+      if (ent->inode != inode)
+        {
+          continue;
+        }
+
+      bucket = &g_blkcache_bucket[ent->bucket];
+      blkcache_takesem(&bucket->lock);
+
+      if (ent->dirty)
+        {
+          ret = blkcache_devwrite(inode, BLKCACHE_DATA(i), ent->block, 1);
+          if (ret < 0)
+            {
+              if (result == OK)
+                {
+                  result = ret;
+                }
+            }
+          else
+            {
+              ent->dirty = false;
+            }
+        }
+
+      blkcache_givesem(&bucket->lock);
+    }
+
+  blkcache_givesem(&g_blkcache_evict);
+  return result;
+}
+
+/****************************************************************************
+ * Name: blkcache_invalidate
+ *
+ * Description:
+ *   See include/nuttx/drivers/blkcache.h
+ *
+ ****************************************************************************/
+
+void blkcache_invalidate(FAR struct inode *inode)
+{
+  FAR struct blkcache_bucket_s *bucket;
+  FAR struct blkcache_ent_s *ent;
+  int i;
+
+  if (!g_blkcache_initialized || inode == NULL)
+    {
+      return;
+    }
+
+  blkcache_takesem(&g_blkcache_evict);
+
+  for (i = 0; i < CONFIG_DRVR_BLKCACHE_NBLOCKS; i++)
+    {
+      ent = &g_blkcache_ent[i];
+      if (ent->inode == inode)
+        {
+          bucket = &g_blkcache_bucket[ent->bucket];
+          blkcache_takesem(&bucket->lock);
+          blkcache_unlink(ent);
+          blkcache_givesem(&bucket->lock);
+        }
+    }
+
+  blkcache_givesem(&g_blkcache_evict);
+}
+
+#endif /* CONFIG_DRVR_BLKCACHE */
@@ -65,6 +65,10 @@
 #  include <nuttx/wqueue.h>
 #endif
 
+#ifdef CONFIG_CAN_TIMESTAMP
+#  include <nuttx/clock.h>
+#endif
+
 #include <nuttx/irq.h>
 
 #ifdef CONFIG_CAN
@@ -116,6 +120,17 @@
 
 static int            can_takesem(FAR sem_t *sem);
 
+/* RX FIFO helpers */
+
+static inline bool    can_rxempty(FAR struct can_dev_s *dev);
+static size_t         can_rxcopy(FAR struct can_rxfifo_s *fifo,
+                                 FAR char *buffer, size_t nread,
+                                 size_t buflen);
+static int            can_rxinput(FAR struct can_dev_s *dev,
+                                  FAR struct can_rxfifo_s *fifo,
+                                  FAR struct can_hdr_s *hdr,
+                                  FAR uint8_t *data);
+
 /* Poll helpers */
 
 #ifndef CONFIG_DISABLE_POLL
@@ -201,6 +216,76 @@ static int can_takesem(FAR sem_t *sem)
 
 #define can_givesem(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: can_rxempty
+ *
+ * Description:
+ *   Return true if no received message is waiting in any RX FIFO.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static inline bool can_rxempty(FAR struct can_dev_s *dev)
+{
+#ifdef CONFIG_CAN_RXPRIO
+  if (dev->cd_recvhi.rx_head != dev->cd_recvhi.rx_tail)
+    {
+      return false;
+    }
+#endif
+
+  return dev->cd_recv.rx_head == dev->cd_recv.rx_tail;
+}
+
+/****************************************************************************
+ * Name: can_rxcopy
+ *
+ * Description:
+ *   Move as many whole messages from one RX FIFO to the user buffer as fit
+ *   behind the 'nread' bytes already there.
+ *
+ * Returned Value:
+ *   The new number of bytes in the user buffer.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static size_t can_rxcopy(FAR struct can_rxfifo_s *fifo, FAR char *buffer,
+                         size_t nread, size_t buflen)
+{
+  while (fifo->rx_head != fifo->rx_tail)
+    {
+      /* Will the next message in the FIFO fit into the user buffer? */
+
+      FAR struct can_msg_s *msg = &fifo->rx_buffer[fifo->rx_head];
+      int nbytes = can_dlc2bytes(msg->cm_hdr.ch_dlc);
+      int msglen = CAN_MSGLEN(nbytes);
+
+      if (nread + msglen > buflen)
+        {
+          break;
+        }
+
+      /* Copy the message to the user buffer */
+
+      memcpy(&buffer[nread], msg, msglen);
+      nread += msglen;
+
+      /* Increment the head of the circular message buffer */
+
+      if (++fifo->rx_head >= CONFIG_CAN_FIFOSIZE)
+        {
+          fifo->rx_head = 0;
+        }
+    }
+
+  return nread;
+}
+
 /****************************************************************************
  * Name: can_pollnotify
  ****************************************************************************/
@@ -450,6 +535,10 @@ static int can_open(FAR struct file *filep)
               dev->cd_xmit.tx_tail  = 0;
               dev->cd_recv.rx_head  = 0;
               dev->cd_recv.rx_tail  = 0;
+#ifdef CONFIG_CAN_RXPRIO
+              dev->cd_recvhi.rx_head = 0;
+              dev->cd_recvhi.rx_tail = 0;
+#endif
 
               /* Finally, Enable the CAN RX interrupt */
 
@@ -616,7 +705,7 @@ static ssize_t can_read(FAR struct file *filep, FAR char *buffer,
         }
 #endif /* CONFIG_CAN_ERRORS */
 
-      while (dev->cd_recv.rx_head == dev->cd_recv.rx_tail)
+      while (can_rxempty(dev))
         {
           /* The receive FIFO is empty -- was non-blocking mode selected? */
 
@@ -638,37 +727,15 @@ static ssize_t can_read(FAR struct file *filep, FAR char *buffer,
             }
         }
 
-      /* The cd_recv FIFO is not empty.  Copy all buffered data that will fit
-       * in the user buffer.
+      /* The RX FIFOs are not empty.  Copy all buffered data that will fit
+       * in the user buffer, high priority messages first.
        */
 
       nread = 0;
-      do
-        {
-          /* Will the next message in the FIFO fit into the user buffer? */
-
-          FAR struct can_msg_s *msg = &dev->cd_recv.rx_buffer[dev->cd_recv.rx_head];
-          int nbytes = can_dlc2bytes(msg->cm_hdr.ch_dlc);
-          int msglen = CAN_MSGLEN(nbytes);
-
-          if (nread + msglen > buflen)
-            {
-              break;
-            }
-
-          /* Copy the message to the user buffer */
-
-          memcpy(&buffer[nread], msg, msglen);
-          nread += msglen;
-
-          /* Increment the head of the circular message buffer */
-
-          if (++dev->cd_recv.rx_head >= CONFIG_CAN_FIFOSIZE)
-            {
-              dev->cd_recv.rx_head = 0;
-            }
-        }
-      while (dev->cd_recv.rx_head != dev->cd_recv.rx_tail);
+#ifdef CONFIG_CAN_RXPRIO
+      nread = can_rxcopy(&dev->cd_recvhi, buffer, nread, buflen);
+#endif
+      nread = can_rxcopy(&dev->cd_recv, buffer, nread, buflen);
 
       /* All on the messages have bee transferred.  Return the number of bytes
        * that were read.
@@ -1101,7 +1168,7 @@ static int can_poll(FAR struct file *filep, FAR struct pollfd *fds,
       while (ret < 0);
       dev->cd_nrxwaiters--;
 
-      if (dev->cd_recv.rx_head != dev->cd_recv.rx_tail)
+      if (!can_rxempty(dev))
         {
           eventset |= fds->events & POLLIN;
         }
@@ -1169,6 +1236,9 @@ int can_register(FAR const char *path, FAR struct can_dev_s *dev)
 
   nxsem_init(&dev->cd_xmit.tx_sem, 0, 1);
   nxsem_init(&dev->cd_recv.rx_sem, 0, 1);
+#ifdef CONFIG_CAN_RXPRIO
+  nxsem_init(&dev->cd_recvhi.rx_sem, 0, 1);
+#endif
   nxsem_init(&dev->cd_closesem,    0, 1);
 #ifndef CONFIG_DISABLE_POLL
   nxsem_init(&dev->cd_pollsem,     0, 1);
@@ -1217,7 +1287,47 @@ int can_register(FAR const char *path, FAR struct can_dev_s *dev)
 int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
                 FAR uint8_t *data)
 {
-  FAR struct can_rxfifo_s *fifo = &dev->cd_recv;
+  return can_rxinput(dev, &dev->cd_recv, hdr, data);
+}
+
+/****************************************************************************
+ * Name: can_receive_prio
+ *
+ * Description:
+ *   Called from the CAN interrupt handler when new read data is available
+ *   in a hardware receive FIFO that is fed by filters of the given
+ *   priority.
+ *
+ * Assumptions:
+ *   CAN interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CAN_RXPRIO
+int can_receive_prio(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
+                     FAR uint8_t *data, uint8_t prio)
+{
+  return can_rxinput(dev, prio == CAN_MSGPRIO_HIGH ?
+                     &dev->cd_recvhi : &dev->cd_recv, hdr, data);
+}
+#endif
+
+/****************************************************************************
+ * Name: can_rxinput
+ *
+ * Description:
+ *   Common logic of can_receive() and can_receive_prio():  Complete a
+ *   pending RTR request or add the message to the given RX FIFO.
+ *
+ * Assumptions:
+ *   CAN interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static int can_rxinput(FAR struct can_dev_s *dev,
+                       FAR struct can_rxfifo_s *fifo,
+                       FAR struct can_hdr_s *hdr, FAR uint8_t *data)
+{
   FAR uint8_t             *dest;
   int                      nexttail;
   int                      errcode = -ENOMEM;
@@ -1225,6 +1335,19 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 
   caninfo("ID: %d DLC: %d\n", hdr->ch_id, hdr->ch_dlc);
 
+#ifdef CONFIG_CAN_TIMESTAMP
+  /* Stamp the message now unless the hardware has captured the time */
+
+  if (!dev->cd_hwtstamp)
+    {
+      struct timespec ts;
+
+      clock_systimespec(&ts);
+      hdr->ch_ts.tv_sec  = ts.tv_sec;
+      hdr->ch_ts.tv_usec = ts.tv_nsec / 1000;
+    }
+#endif
+
   /* Check if adding this new message would over-run the drivers ability to
    * enqueue read data.
    */
@@ -89,11 +89,13 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <debug.h>
 #include <errno.h>
 #include <nuttx/fs/fs.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/i2c/i2c_master.h>
 #include <nuttx/eeprom/i2c_xx24xx.h>
@@ -106,6 +108,20 @@
 #  define CONFIG_EE24XX_FREQUENCY 100000
 #endif
 
+#ifndef CONFIG_EE24XX_WRITE_TIMEOUT
+#  define CONFIG_EE24XX_WRITE_TIMEOUT 20
+#endif
+
+#ifdef CONFIG_EE24XX_READCACHE
+#  ifndef CONFIG_EE24XX_READCACHE_SIZE
+#    define CONFIG_EE24XX_READCACHE_SIZE 64
+#  endif
+#endif
+
+/* Write cycle timeout in clock ticks (at least one full tick) */
+
+#define EE24XX_WRITE_TICKS (MSEC2TICK(CONFIG_EE24XX_WRITE_TIMEOUT) + 1)
+
 /****************************************************************************
  * Types
  ****************************************************************************/
@@ -145,6 +161,30 @@ struct ee24xx_dev_s
   uint16_t             addrlen;    /* number of bytes in data addresses */
   uint16_t             haddrbits;  /* Number of bits in high address part */
   uint16_t             haddrshift; /* bit-shift of high address part */
+
+  /* Write cycle management.  The end of a write cycle is only waited for
+   * when the device is accessed again.
+   */
+
+  bool                 busy;       /* A write cycle may be in progress */
+  uint32_t             busyaddr;   /* Address of the last page write */
+
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+  /* Write coalescing: dirty bytes [wbstart, wbend) of the page at wbaddr */
+
+  uint32_t             wbaddr;     /* Address of the buffered page */
+  uint16_t             wbstart;    /* First dirty byte in the page */
+  uint16_t             wbend;      /* One past the last dirty byte */
+  FAR uint8_t         *wbuf;       /* Page buffer (pgsize bytes) */
+#endif
+
+#ifdef CONFIG_EE24XX_READCACHE
+  /* Read cache: one aligned block of memory content */
+
+  bool                 rcvalid;    /* The cached block is valid */
+  uint32_t             rcaddr;     /* Address of the cached block */
+  FAR uint8_t         *rcache;     /* Cached data */
+#endif
 };
 
 /****************************************************************************
@@ -220,23 +260,29 @@ static const struct file_operations ee24xx_fops =
  * Name: ee24xx_waitwritecomplete
  *
  * Use ACK polling to detect the completion of the write operation.
- * Returns TRUE if write is complete (device replies to ACK).
+ * Returns OK if write is complete (device replies to ACK).
  * Note: The device always replies an ACK for the control byte, the polling
  * shall be done using the ACK for the memory address byte. Read or write does
  * not matter.
- * Note: We should sleep a bit between retries, the write time is around 5 ms,
- * but the bus is slow, so, a few retries at most will happen.
+ * Note: The device is polled back-to-back so that the next operation can
+ * start as soon as the write cycle ends, rather than after the worst-case
+ * write time.  Nothing is done if no write cycle was started since the last
+ * call.
  *
  ****************************************************************************/
 
-static int ee24xx_waitwritecomplete(FAR struct ee24xx_dev_s *eedev,
-                                    uint32_t memaddr)
+static int ee24xx_waitwritecomplete(FAR struct ee24xx_dev_s *eedev)
 {
   struct i2c_msg_s msgs[1];
+  clock_t start;
   int ret;
-  int retries = 100;
   uint8_t adr;
-  uint32_t addr_hi = (memaddr >> (eedev->addrlen << 3));
+  uint32_t addr_hi = (eedev->busyaddr >> (eedev->addrlen << 3));
+
+  if (!eedev->busy)
+    {
+      return OK;
+    }
 
   msgs[0].frequency = eedev->freq;
   msgs[0].addr      = eedev->addr | (addr_hi & ((1 << eedev->haddrbits) - 1));
@@ -244,14 +290,23 @@ static int ee24xx_waitwritecomplete(FAR struct ee24xx_dev_s *eedev,
   msgs[0].buffer    = &adr;
   msgs[0].length    = 1;
 
-  do
+  start = clock_systimer();
+  for (; ; )
     {
-     ret = I2C_TRANSFER(eedev->i2c, msgs, 1);
-     retries--;
-    }
-  while(ret != 0 && retries > 0);
+      ret = I2C_TRANSFER(eedev->i2c, msgs, 1);
+      if (ret >= 0)
+        {
+          eedev->busy = false;
+          return OK;
+        }
 
-  return ret;
+      if ((clock_systimer() - start) > EE24XX_WRITE_TICKS)
+        {
+          ferr("ERROR: write cycle timeout at %d: %d\n",
+               eedev->busyaddr, ret);
+          return -ETIMEDOUT;
+        }
+    }
 }
 
 /****************************************************************************
@@ -293,6 +348,242 @@ static int ee24xx_writepage(FAR struct ee24xx_dev_s *eedev, uint32_t memaddr,
   return I2C_TRANSFER(eedev->i2c, msgs, 2);
 }
 
+/****************************************************************************
+ * Name: ee24xx_program
+ *
+ * Description: Start programming data that does NOT cross a page boundary.
+ * The device must first complete any previous write cycle.  This one is
+ * left running.
+ *
+ ****************************************************************************/
+
+static int ee24xx_program(FAR struct ee24xx_dev_s *eedev, uint32_t memaddr,
+                          FAR const char *buffer, size_t len)
+{
+  int ret;
+
+  ret = ee24xx_waitwritecomplete(eedev);
+  if (ret >= 0)
+    {
+      ret = ee24xx_writepage(eedev, memaddr, buffer, len);
+    }
+
+  if (ret < 0)
+    {
+#ifdef CONFIG_EE24XX_READCACHE
+      /* The cached copy may no longer match the memory */
+
+      eedev->rcvalid = false;
+#endif
+      return ret;
+    }
+
+  eedev->busy     = true;
+  eedev->busyaddr = memaddr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ee24xx_wbflush
+ *
+ * Description: Program the dirty part of the write buffer, if any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+static int ee24xx_wbflush(FAR struct ee24xx_dev_s *eedev)
+{
+  int ret = OK;
+
+  if (eedev->wbend > eedev->wbstart)
+    {
+      finfo("Flush %d bytes at %d\n", eedev->wbend - eedev->wbstart,
+            eedev->wbaddr + eedev->wbstart);
+
+      ret = ee24xx_program(eedev, eedev->wbaddr + eedev->wbstart,
+                           (FAR const char *)&eedev->wbuf[eedev->wbstart],
+                           eedev->wbend - eedev->wbstart);
+      if (ret < 0)
+        {
+          ferr("ERROR: buffered write failed, ret = %d\n", ret);
+        }
+    }
+
+  /* The data is discarded even on failure; the error is reported once */
+
+  eedev->wbstart = 0;
+  eedev->wbend   = 0;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ee24xx_wbwrite
+ *
+ * Description: Merge data that does NOT cross a page boundary into the
+ * write buffer.  The buffer is flushed first if the data is not contiguous
+ * with the buffered data and programmed immediately once the page is full.
+ *
+ ****************************************************************************/
+
+static int ee24xx_wbwrite(FAR struct ee24xx_dev_s *eedev, uint32_t memaddr,
+                          FAR const char *buffer, size_t len)
+{
+  uint32_t pgaddr = memaddr & ~((uint32_t)eedev->pgsize - 1);
+  uint16_t start  = memaddr - pgaddr;
+  uint16_t end    = start + len;
+  int ret;
+
+  if (eedev->wbend > eedev->wbstart &&
+      (pgaddr != eedev->wbaddr || start > eedev->wbend ||
+       end < eedev->wbstart))
+    {
+      ret = ee24xx_wbflush(eedev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* A full page does not need to be copied.  Any buffered data for the
+   * same page is superseded.
+   */
+
+  if (len == eedev->pgsize)
+    {
+      eedev->wbstart = 0;
+      eedev->wbend   = 0;
+      return ee24xx_program(eedev, memaddr, buffer, len);
+    }
+
+  if (eedev->wbend == eedev->wbstart)
+    {
+      eedev->wbaddr  = pgaddr;
+      eedev->wbstart = start;
+      eedev->wbend   = end;
+    }
+  else
+    {
+      if (start < eedev->wbstart)
+        {
+          eedev->wbstart = start;
+        }
+
+      if (end > eedev->wbend)
+        {
+          eedev->wbend = end;
+        }
+    }
+
+  memcpy(&eedev->wbuf[start], buffer, len);
+
+  /* Program the page as soon as all of it is dirty */
+
+  if (eedev->wbstart == 0 && eedev->wbend == eedev->pgsize)
+    {
+      return ee24xx_wbflush(eedev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: ee24xx_readbytes
+ *
+ * Description: Read data from the EEPROM.  Buffered write data in the range
+ * is programmed first and any write cycle is waited for.
+ *
+ ****************************************************************************/
+
+static int ee24xx_readbytes(FAR struct ee24xx_dev_s *eedev, uint32_t memaddr,
+                            FAR uint8_t *buffer, size_t len)
+{
+  struct i2c_msg_s msgs[2];
+  uint8_t          addr[2];
+  uint32_t         addr_hi;
+  int              ret;
+
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+  if (eedev->wbend > eedev->wbstart &&
+      eedev->wbaddr + eedev->wbstart < memaddr + len &&
+      memaddr < eedev->wbaddr + eedev->wbend)
+    {
+      ret = ee24xx_wbflush(eedev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  ret = ee24xx_waitwritecomplete(eedev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Write data address */
+
+  addr_hi           = (memaddr >> (eedev->addrlen << 3));
+
+  addr[0]           = memaddr >> 8;
+  addr[1]           = memaddr &  0xFF;
+
+  msgs[0].frequency = eedev->freq;
+  msgs[0].addr      = eedev->addr | (addr_hi & ((1 << eedev->haddrbits) - 1));
+  msgs[0].flags     = 0;
+  msgs[0].buffer    = eedev->addrlen==2 ? &addr[0] : &addr[1];
+  msgs[0].length    = eedev->addrlen;
+
+  /* Read data */
+
+  msgs[1].frequency = msgs[0].frequency;
+  msgs[1].addr      = msgs[0].addr;
+  msgs[1].flags     = I2C_M_READ;
+  msgs[1].buffer    = buffer;
+  msgs[1].length    = len;
+
+  return I2C_TRANSFER(eedev->i2c, msgs, 2);
+}
+
+/****************************************************************************
+ * Name: ee24xx_rcupdate
+ *
+ * Description: Copy written data into the overlapping part of the cached
+ * block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EE24XX_READCACHE
+static void ee24xx_rcupdate(FAR struct ee24xx_dev_s *eedev, uint32_t memaddr,
+                            FAR const char *buffer, size_t len)
+{
+  uint32_t start = memaddr;
+  uint32_t end   = memaddr + len;
+
+  if (!eedev->rcvalid)
+    {
+      return;
+    }
+
+  if (start < eedev->rcaddr)
+    {
+      start = eedev->rcaddr;
+    }
+
+  if (end > eedev->rcaddr + CONFIG_EE24XX_READCACHE_SIZE)
+    {
+      end = eedev->rcaddr + CONFIG_EE24XX_READCACHE_SIZE;
+    }
+
+  if (start < end)
+    {
+      memcpy(&eedev->rcache[start - eedev->rcaddr],
+             &buffer[start - memaddr], end - start);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: ee24xx_semtake
  *
@@ -392,6 +683,12 @@ static int ee24xx_close(FAR struct file *filep)
   else
     {
       eedev->refs -= 1;
+
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+      /* Program any data still held in the write buffer */
+
+      ret = ee24xx_wbflush(eedev);
+#endif
     }
 
   ee24xx_semgive(eedev);
@@ -476,9 +773,10 @@ static ssize_t ee24xx_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct ee24xx_dev_s *eedev;
   FAR struct inode        *inode = filep->f_inode;
-  struct i2c_msg_s         msgs[2];
-  uint8_t                  addr[2];
-  uint32_t                 addr_hi;
+#ifdef CONFIG_EE24XX_READCACHE
+  uint32_t                 blkaddr;
+  size_t                   blklen;
+#endif
   int                      ret;
 
   DEBUGASSERT(inode && inode->i_private);
@@ -501,33 +799,44 @@ static ssize_t ee24xx_read(FAR struct file *filep, FAR char *buffer,
       goto done;
     }
 
-  /* Write data address */
-
   finfo("READ %d bytes at pos %d\n", len, filep->f_pos);
 
-  addr_hi           = (filep->f_pos >> (eedev->addrlen << 3));
+#ifdef CONFIG_EE24XX_READCACHE
+  /* Serve reads that fit in one cache block from the cache */
 
-  addr[0]           = (filep->f_pos) >> 8;
-  addr[1]           = (filep->f_pos) &  0xFF;
-
-  msgs[0].frequency = eedev->freq;
-  msgs[0].addr      = eedev->addr | (addr_hi & ((1 << eedev->haddrbits) - 1));
-  msgs[0].flags     = 0;
-  msgs[0].buffer    = eedev->addrlen==2 ? &addr[0] : &addr[1];
-  msgs[0].length    = eedev->addrlen;
-
-  /* Read data */
-
-  msgs[1].frequency = msgs[0].frequency;
-  msgs[1].addr      = msgs[0].addr;
-  msgs[1].flags     = I2C_M_READ;
-  msgs[1].buffer    = (uint8_t*)buffer;
-  msgs[1].length    = len;
+  blkaddr = filep->f_pos - (filep->f_pos % CONFIG_EE24XX_READCACHE_SIZE);
+  if (filep->f_pos + len <= blkaddr + CONFIG_EE24XX_READCACHE_SIZE)
+    {
+      if (!eedev->rcvalid || eedev->rcaddr != blkaddr)
+        {
+          blklen = eedev->size - blkaddr;
+          if (blklen > CONFIG_EE24XX_READCACHE_SIZE)
+            {
+              blklen = CONFIG_EE24XX_READCACHE_SIZE;
+            }
+
+          eedev->rcvalid = false;
+          ret = ee24xx_readbytes(eedev, blkaddr, eedev->rcache, blklen);
+          if (ret < 0)
+            {
+              goto done;
+            }
+
+          eedev->rcaddr  = blkaddr;
+          eedev->rcvalid = true;
+        }
 
-  ret = I2C_TRANSFER(eedev->i2c, msgs, 2);
-  if (ret < 0)
+      memcpy(buffer, &eedev->rcache[filep->f_pos - blkaddr], len);
+    }
+  else
+#endif
     {
-      goto done;
+      ret = ee24xx_readbytes(eedev, filep->f_pos, (FAR uint8_t *)buffer,
+                             len);
+      if (ret < 0)
+        {
+          goto done;
+        }
     }
 
   ret = len;
@@ -589,66 +898,38 @@ static ssize_t ee24xx_write(FAR struct file *filep, FAR const char *buffer,
    * cannot cross page boundaries. So every time the last
    * byte of a page is programmed, a separate I2C transaction
    * required to continue writing.
+   *
+   * The write cycle of a page is only waited for when the next page is
+   * programmed (or the device is read), so the last write cycle overlaps
+   * with whatever the caller does next.
    */
 
-  /* First, write some page-unaligned data */
-
-  pageoff = filep->f_pos & (eedev->pgsize - 1);
-  cnt     = eedev->pgsize - pageoff;
-  if (cnt > len)
-    {
-      cnt = len;
-    }
-
-  if (pageoff > 0)
-    {
-      finfo("First %d unaligned bytes at %d (pageoff %d)\n", cnt, filep->f_pos,
-            pageoff);
-
-      ret = ee24xx_writepage(eedev, filep->f_pos, buffer, cnt);
-      if (ret < 0)
-        {
-          ferr("write failed, ret = %d\n", ret);
-          goto done;
-        }
-
-      ret = ee24xx_waitwritecomplete(eedev, filep->f_pos);
-      if (ret < 0)
-        {
-          ferr("writecomplete failed, ret = %d\n", ret);
-          goto done;
-        }
-
-      len          -= cnt;
-      buffer       += cnt;
-      filep->f_pos += cnt;
-    }
-
-  /* Then, write remaining bytes at page-aligned addresses */
-
   while (len > 0)
     {
-      cnt = len;
-      if (cnt > eedev->pgsize)
+      pageoff = filep->f_pos & (eedev->pgsize - 1);
+      cnt     = eedev->pgsize - pageoff;
+      if (cnt > len)
         {
-          cnt = eedev->pgsize;
+          cnt = len;
         }
 
-      finfo("Aligned page write for %d bytes at %d\n", cnt, filep->f_pos);
+      finfo("Page write for %d bytes at %d (pageoff %d)\n", cnt,
+            filep->f_pos, pageoff);
 
-      ret = ee24xx_writepage(eedev, filep->f_pos, buffer, cnt);
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+      ret = ee24xx_wbwrite(eedev, filep->f_pos, buffer, cnt);
+#else
+      ret = ee24xx_program(eedev, filep->f_pos, buffer, cnt);
+#endif
       if (ret < 0)
         {
           ferr("write failed, ret = %d\n", ret);
           goto done;
         }
 
-      ret = ee24xx_waitwritecomplete(eedev, filep->f_pos);
-      if (ret < 0)
-        {
-          ferr("writecomplete failed, ret = %d\n", ret);
-          goto done;
-        }
+#ifdef CONFIG_EE24XX_READCACHE
+      ee24xx_rcupdate(eedev, filep->f_pos, buffer, cnt);
+#endif
 
       len          -= cnt;
       buffer       += cnt;
@@ -722,8 +1003,6 @@ int ee24xx_initialize(FAR struct i2c_master_s *bus, uint8_t devaddr,
       return -ENOMEM;
     }
 
-  sem_init(&eedev->sem, 0, 1);
-
   eedev->freq     = CONFIG_EE24XX_FREQUENCY;
   eedev->i2c      = bus;
   eedev->addr     = devaddr;
@@ -765,6 +1044,29 @@ int ee24xx_initialize(FAR struct i2c_master_s *bus, uint8_t devaddr,
         }
     }
 
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+  eedev->wbuf = (FAR uint8_t *)kmm_malloc(eedev->pgsize);
+  if (eedev->wbuf == NULL)
+    {
+      kmm_free(eedev);
+      return -ENOMEM;
+    }
+#endif
+
+#ifdef CONFIG_EE24XX_READCACHE
+  eedev->rcache = (FAR uint8_t *)kmm_malloc(CONFIG_EE24XX_READCACHE_SIZE);
+  if (eedev->rcache == NULL)
+    {
+#ifdef CONFIG_EE24XX_WRITEBUFFER
+      kmm_free(eedev->wbuf);
+#endif
+      kmm_free(eedev);
+      return -ENOMEM;
+    }
+#endif
+
+  sem_init(&eedev->sem, 0, 1);
+
   finfo("EEPROM device %s, %d bytes, %d per page, addrlen %d, %s\n",
         devname, eedev->size, eedev->pgsize, eedev->addrlen,
         eedev->readonly ? "readonly" : "");
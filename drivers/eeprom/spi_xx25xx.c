@@ -117,10 +117,14 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sched.h>
 #include <debug.h>
 #include <errno.h>
 #include <nuttx/fs/fs.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/spi/spi.h>
@@ -133,6 +137,20 @@
 #  define CONFIG_EE25XX_SPIMODE 0
 #endif
 
+#ifndef CONFIG_EE25XX_WRITE_TIMEOUT
+#  define CONFIG_EE25XX_WRITE_TIMEOUT 20
+#endif
+
+#ifdef CONFIG_EE25XX_READCACHE
+#  ifndef CONFIG_EE25XX_READCACHE_SIZE
+#    define CONFIG_EE25XX_READCACHE_SIZE 64
+#  endif
+#endif
+
+/* Write cycle timeout in clock ticks (at least one full tick) */
+
+#define EE25XX_WRITE_TICKS (MSEC2TICK(CONFIG_EE25XX_WRITE_TIMEOUT) + 1)
+
 /* EEPROM commands
  * High bit of low nibble used for A8 in 25xx040/at25040 products
  */
@@ -191,6 +209,18 @@ struct ee25xx_dev_s
   sem_t            sem;      /* file access serialization */
   uint8_t          refs;     /* The number of times the device has been opened */
   uint8_t          readonly; /* Flags */
+  bool             busy;     /* A write cycle may be in progress */
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+  uint32_t         wbaddr;   /* Address of the buffered page */
+  uint16_t         wbstart;  /* First dirty byte in the page */
+  uint16_t         wbend;    /* One past the last dirty byte */
+  FAR uint8_t      *wbuf;    /* Page buffer (pgsize bytes) */
+#endif
+#ifdef CONFIG_EE25XX_READCACHE
+  bool             rcvalid;  /* The cached block is valid */
+  uint32_t         rcaddr;   /* Address of the cached block */
+  FAR uint8_t      *rcache;  /* Cached data */
+#endif
 };
 
 /****************************************************************************
@@ -345,18 +375,30 @@ static void ee25xx_sendcmd(FAR struct spi_dev_s *spi, uint8_t cmd,
 /****************************************************************************
  * Name: ee25xx_waitwritecomplete
  *
- * Description: loop until the write operation is done.
+ * Description: loop until the write operation is done.  The status is
+ * polled back-to-back so that the next operation starts as soon as the
+ * write cycle ends.  Nothing is done if no write cycle was started since
+ * the last call.
  *
  ****************************************************************************/
 
-static void ee25xx_waitwritecomplete(struct ee25xx_dev_s *priv)
+static int ee25xx_waitwritecomplete(struct ee25xx_dev_s *priv)
 {
+  clock_t start;
   uint8_t status;
 
+  if (!priv->busy)
+    {
+      return OK;
+    }
+
   /* Loop as long as the memory is busy with a write cycle */
 
-  do
+  start = clock_systimer();
+  for (; ; )
     {
+      ee25xx_lock(priv->spi);
+
       /* Select this FLASH part */
 
       SPI_SELECT(priv->spi, SPIDEV_EEPROM(0), true);
@@ -374,20 +416,26 @@ static void ee25xx_waitwritecomplete(struct ee25xx_dev_s *priv)
       /* Deselect the FLASH */
 
       SPI_SELECT(priv->spi, SPIDEV_EEPROM(0), false);
+      ee25xx_unlock(priv->spi);
 
-      /* Given that writing could take up to a few milliseconds,
-       * the following short delay in the "busy" case will allow
-       * other peripherals to access the SPI bus.
-       */
+      if ((status & EE25XX_SR_WIP) == 0)
+        {
+          priv->busy = false;
+          return OK;
+        }
 
-      if ((status & EE25XX_SR_WIP) != 0)
+      if ((clock_systimer() - start) > EE25XX_WRITE_TICKS)
         {
-          ee25xx_unlock(priv->spi);
-          nxsig_usleep(1000);
-          ee25xx_lock(priv->spi);
+          ferr("ERROR: write cycle timeout, status %02x\n", status);
+          return -ETIMEDOUT;
         }
+
+      /* Writing could take up to a few milliseconds.  The bus is unlocked
+       * between polls so that other peripherals can access it.
+       */
+
+      sched_yield();
     }
-  while ((status & EE25XX_SR_WIP) != 0);
 }
 
 /****************************************************************************
@@ -430,6 +478,229 @@ static void ee25xx_writepage(FAR struct ee25xx_dev_s *eedev, uint32_t devaddr,
   ee25xx_unlock(eedev->spi);
 }
 
+/****************************************************************************
+ * Name: ee25xx_program
+ *
+ * Description: Start programming data that does NOT cross a page boundary.
+ * The device must first complete any previous write cycle.  This one is
+ * left running.
+ *
+ ****************************************************************************/
+
+static int ee25xx_program(FAR struct ee25xx_dev_s *eedev, uint32_t devaddr,
+                          FAR const char *data, size_t len)
+{
+  int ret;
+
+  ret = ee25xx_waitwritecomplete(eedev);
+  if (ret < 0)
+    {
+#ifdef CONFIG_EE25XX_READCACHE
+      /* The cached copy may no longer match the memory */
+
+      eedev->rcvalid = false;
+#endif
+      return ret;
+    }
+
+  ee25xx_writeenable(eedev->spi, true);
+  ee25xx_writepage(eedev, devaddr, data, len);
+  eedev->busy = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ee25xx_wbflush
+ *
+ * Description: Program the dirty part of the write buffer, if any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+static int ee25xx_wbflush(FAR struct ee25xx_dev_s *eedev)
+{
+  int ret = OK;
+
+  if (eedev->wbend > eedev->wbstart)
+    {
+      finfo("Flush %d bytes at %d\n", eedev->wbend - eedev->wbstart,
+            eedev->wbaddr + eedev->wbstart);
+
+      ret = ee25xx_program(eedev, eedev->wbaddr + eedev->wbstart,
+                           (FAR const char *)&eedev->wbuf[eedev->wbstart],
+                           eedev->wbend - eedev->wbstart);
+      if (ret < 0)
+        {
+          ferr("ERROR: buffered write failed, ret = %d\n", ret);
+        }
+    }
+
+  /* The data is discarded even on failure; the error is reported once */
+
+  eedev->wbstart = 0;
+  eedev->wbend   = 0;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ee25xx_wbwrite
+ *
+ * Description: Merge data that does NOT cross a page boundary into the
+ * write buffer.  The buffer is flushed first if the data is not contiguous
+ * with the buffered data and programmed immediately once the page is full.
+ *
+ ****************************************************************************/
+
+static int ee25xx_wbwrite(FAR struct ee25xx_dev_s *eedev, uint32_t devaddr,
+                          FAR const char *data, size_t len)
+{
+  uint32_t pgaddr = devaddr & ~((uint32_t)eedev->pgsize - 1);
+  uint16_t start  = devaddr - pgaddr;
+  uint16_t end    = start + len;
+  int ret;
+
+  if (eedev->wbend > eedev->wbstart &&
+      (pgaddr != eedev->wbaddr || start > eedev->wbend ||
+       end < eedev->wbstart))
+    {
+      ret = ee25xx_wbflush(eedev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* A full page does not need to be copied.  Any buffered data for the
+   * same page is superseded.
+   */
+
+  if (len == eedev->pgsize)
+    {
+      eedev->wbstart = 0;
+      eedev->wbend   = 0;
+      return ee25xx_program(eedev, devaddr, data, len);
+    }
+
+  if (eedev->wbend == eedev->wbstart)
+    {
+      eedev->wbaddr  = pgaddr;
+      eedev->wbstart = start;
+      eedev->wbend   = end;
+    }
+  else
+    {
+      if (start < eedev->wbstart)
+        {
+          eedev->wbstart = start;
+        }
+
+      if (end > eedev->wbend)
+        {
+          eedev->wbend = end;
+        }
+    }
+
+  memcpy(&eedev->wbuf[start], data, len);
+
+  /* Program the page as soon as all of it is dirty */
+
+  if (eedev->wbstart == 0 && eedev->wbend == eedev->pgsize)
+    {
+      return ee25xx_wbflush(eedev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: ee25xx_readbytes
+ *
+ * Description: Read data from the EEPROM.  Buffered write data in the range
+ * is programmed first and any write cycle is waited for.
+ *
+ ****************************************************************************/
+
+static int ee25xx_readbytes(FAR struct ee25xx_dev_s *eedev, uint32_t devaddr,
+                            FAR uint8_t *buffer, size_t len)
+{
+  int ret;
+
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+  if (eedev->wbend > eedev->wbstart &&
+      eedev->wbaddr + eedev->wbstart < devaddr + len &&
+      devaddr < eedev->wbaddr + eedev->wbend)
+    {
+      ret = ee25xx_wbflush(eedev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  ret = ee25xx_waitwritecomplete(eedev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ee25xx_lock(eedev->spi);
+  SPI_SELECT(eedev->spi, SPIDEV_EEPROM(0), true);
+
+  /* STM32F4Disco: There is a 25 us delay here */
+
+  ee25xx_sendcmd(eedev->spi, EE25XX_CMD_READ, eedev->addrlen, devaddr);
+
+  /* STM32F4Disco: There is a 42 us delay here */
+
+  SPI_RECVBLOCK(eedev->spi, buffer, len);
+
+  /* STM32F4Disco: There is a 20 us delay here */
+
+  SPI_SELECT(eedev->spi, SPIDEV_EEPROM(0), false);
+  ee25xx_unlock(eedev->spi);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ee25xx_rcupdate
+ *
+ * Description: Copy written data into the overlapping part of the cached
+ * block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EE25XX_READCACHE
+static void ee25xx_rcupdate(FAR struct ee25xx_dev_s *eedev, uint32_t devaddr,
+                            FAR const char *data, size_t len)
+{
+  uint32_t start = devaddr;
+  uint32_t end   = devaddr + len;
+
+  if (!eedev->rcvalid)
+    {
+      return;
+    }
+
+  if (start < eedev->rcaddr)
+    {
+      start = eedev->rcaddr;
+    }
+
+  if (end > eedev->rcaddr + CONFIG_EE25XX_READCACHE_SIZE)
+    {
+      end = eedev->rcaddr + CONFIG_EE25XX_READCACHE_SIZE;
+    }
+
+  if (start < end)
+    {
+      memcpy(&eedev->rcache[start - eedev->rcaddr],
+             &data[start - devaddr], end - start);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: ee25xx_semtake
  *
@@ -534,6 +805,12 @@ static int ee25xx_close(FAR struct file *filep)
   else
     {
       eedev->refs -= 1;
+
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+      /* Program any data still held in the write buffer */
+
+      ret = ee25xx_wbflush(eedev);
+#endif
     }
 
   ee25xx_semgive(eedev);
@@ -617,6 +894,11 @@ static ssize_t ee25xx_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct ee25xx_dev_s *eedev;
   FAR struct inode        *inode = filep->f_inode;
+#ifdef CONFIG_EE25XX_READCACHE
+  uint32_t                blkaddr;
+  size_t                  blklen;
+#endif
+  ssize_t                 ret;
 
   DEBUGASSERT(inode && inode->i_private);
   eedev = (FAR struct ee25xx_dev_s *)inode->i_private;
@@ -630,27 +912,58 @@ static ssize_t ee25xx_read(FAR struct file *filep, FAR char *buffer,
       len = eedev->size - filep->f_pos;
     }
 
-  ee25xx_lock(eedev->spi);
-  SPI_SELECT(eedev->spi, SPIDEV_EEPROM(0), true);
-
-  /* STM32F4Disco: There is a 25 us delay here */
-
-  ee25xx_sendcmd(eedev->spi, EE25XX_CMD_READ, eedev->addrlen, filep->f_pos);
-
-  /* STM32F4Disco: There is a 42 us delay here */
+  ret = len;
+  if (len == 0)
+    {
+      goto done;
+    }
 
-  SPI_RECVBLOCK(eedev->spi, buffer, len);
+#ifdef CONFIG_EE25XX_READCACHE
+  /* Serve reads that fit in one cache block from the cache */
 
-  /* STM32F4Disco: There is a 20 us delay here */
+  blkaddr = filep->f_pos - (filep->f_pos % CONFIG_EE25XX_READCACHE_SIZE);
+  if (filep->f_pos + len <= blkaddr + CONFIG_EE25XX_READCACHE_SIZE)
+    {
+      if (!eedev->rcvalid || eedev->rcaddr != blkaddr)
+        {
+          blklen = eedev->size - blkaddr;
+          if (blklen > CONFIG_EE25XX_READCACHE_SIZE)
+            {
+              blklen = CONFIG_EE25XX_READCACHE_SIZE;
+            }
+
+          eedev->rcvalid = false;
+          ret = ee25xx_readbytes(eedev, blkaddr, eedev->rcache, blklen);
+          if (ret < 0)
+            {
+              goto done;
+            }
+
+          eedev->rcaddr  = blkaddr;
+          eedev->rcvalid = true;
+        }
 
-  SPI_SELECT(eedev->spi, SPIDEV_EEPROM(0), false);
-  ee25xx_unlock(eedev->spi);
+      memcpy(buffer, &eedev->rcache[filep->f_pos - blkaddr], len);
+    }
+  else
+#endif
+    {
+      ret = ee25xx_readbytes(eedev, filep->f_pos, (FAR uint8_t *)buffer,
+                             len);
+      if (ret < 0)
+        {
+          goto done;
+        }
+    }
 
   /* Update the file position */
 
+  ret           = len;
   filep->f_pos += len;
+
+done:
   ee25xx_semgive(eedev);
-  return len;
+  return ret;
 }
 
 /****************************************************************************
@@ -665,6 +978,7 @@ static ssize_t ee25xx_write(FAR struct file *filep, FAR const char *buffer,
   int                     pageoff;
   FAR struct inode        *inode = filep->f_inode;
   int                     ret    = -EACCES;
+  int                     savelen;
 
   DEBUGASSERT(inode && inode->i_private);
   eedev = (FAR struct ee25xx_dev_s *)inode->i_private;
@@ -688,11 +1002,7 @@ static ssize_t ee25xx_write(FAR struct file *filep, FAR const char *buffer,
       len = eedev->size - filep->f_pos;
     }
 
-  /* From this point no failure cannot be detected anymore.
-   * The user should verify the write by rereading memory.
-   */
-
-  ret = len; /* save number of bytes written */
+  savelen = len; /* save number of bytes written */
 
   ee25xx_semtake(eedev);
 
@@ -702,47 +1012,45 @@ static ssize_t ee25xx_write(FAR struct file *filep, FAR const char *buffer,
    * byte of a page is programmed, the SPI transaction is
    * stopped, and the status register is read until the
    * write operation has completed.
+   *
+   * The status register is only polled before the next page is
+   * programmed (or the device is read), so the last write cycle overlaps
+   * with whatever the caller does next.
    */
 
-  /* First, write some page-unaligned data */
-
-  pageoff = filep->f_pos & (eedev->pgsize - 1);
-  cnt     = eedev->pgsize - pageoff;
-  if (cnt > len)
-    {
-      cnt = len;
-    }
-
-  if (pageoff > 0)
-    {
-      ee25xx_writeenable(eedev->spi, true);
-      ee25xx_writepage(eedev, filep->f_pos, buffer, cnt);
-      ee25xx_waitwritecomplete(eedev);
-      len          -= cnt;
-      buffer       += cnt;
-      filep->f_pos += cnt;
-    }
-
-  /* Then, write remaining bytes at page-aligned addresses */
-
   while (len > 0)
     {
-      cnt = len;
-      if (cnt > eedev->pgsize)
+      pageoff = filep->f_pos & (eedev->pgsize - 1);
+      cnt     = eedev->pgsize - pageoff;
+      if (cnt > len)
+        {
+          cnt = len;
+        }
+
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+      ret = ee25xx_wbwrite(eedev, filep->f_pos, buffer, cnt);
+#else
+      ret = ee25xx_program(eedev, filep->f_pos, buffer, cnt);
+#endif
+      if (ret < 0)
         {
-          cnt = eedev->pgsize;
+          ferr("write failed, ret = %d\n", ret);
+          goto done;
         }
 
-      ee25xx_writeenable(eedev->spi, true);
-      ee25xx_writepage(eedev, filep->f_pos, buffer, cnt);
-      ee25xx_waitwritecomplete(eedev);
+#ifdef CONFIG_EE25XX_READCACHE
+      ee25xx_rcupdate(eedev, filep->f_pos, buffer, cnt);
+#endif
+
       len          -= cnt;
       buffer       += cnt;
       filep->f_pos += cnt;
     }
 
-  ee25xx_semgive(eedev);
+  ret = savelen;
 
+done:
+  ee25xx_semgive(eedev);
   return ret;
 }
 
@@ -806,8 +1114,6 @@ int ee25xx_initialize(FAR struct spi_dev_s *dev, FAR char *devname,
       return -ENOMEM;
     }
 
-  nxsem_init(&eedev->sem, 0, 1);
-
   eedev->spi      = dev;
   eedev->size     = 128 << g_ee25xx_devices[devtype].bytes;
   eedev->pgsize   =   8 << g_ee25xx_devices[devtype].pagesize;
@@ -819,6 +1125,29 @@ int ee25xx_initialize(FAR struct spi_dev_s *dev, FAR char *devname,
 
   eedev->readonly = !!readonly;
 
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+  eedev->wbuf = (FAR uint8_t *)kmm_malloc(eedev->pgsize);
+  if (eedev->wbuf == NULL)
+    {
+      kmm_free(eedev);
+      return -ENOMEM;
+    }
+#endif
+
+#ifdef CONFIG_EE25XX_READCACHE
+  eedev->rcache = (FAR uint8_t *)kmm_malloc(CONFIG_EE25XX_READCACHE_SIZE);
+  if (eedev->rcache == NULL)
+    {
+#ifdef CONFIG_EE25XX_WRITEBUFFER
+      kmm_free(eedev->wbuf);
+#endif
+      kmm_free(eedev);
+      return -ENOMEM;
+    }
+#endif
+
+  nxsem_init(&eedev->sem, 0, 1);
+
   finfo("EEPROM device %s, %d bytes, %d per page, addrlen %d, readonly %d\n",
        devname, eedev->size, eedev->pgsize, eedev->addrlen, eedev->readonly);
 
@@ -0,0 +1,387 @@
+/****************************************************************************
+ * drivers/i2c/i2c_async.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/i2c/i2c_master.h>
+#include <nuttx/i2c/i2c_async.h>
+
+#ifdef CONFIG_I2C_ASYNC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+
+/* Lower halves without asynchronous support block the worker for the
+ * duration of a batch, so prefer the low priority work queue.
+ */
+
+#if !defined(CONFIG_SCHED_WORKQUEUE)
+#  error Work queue support required in this configuration
+#elif defined(CONFIG_SCHED_LPWORK)
+#  define I2CWORK LPWORK
+#else
+#  define I2CWORK HPWORK
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void i2c_async_done(FAR void *arg, int result);
+static void i2c_async_worker(FAR void *arg);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_async_gather
+ *
+ * Description:
+ *   Move as many pending requests as fit into the message buffer to the
+ *   active list and build the message array of the batch.
+ *
+ * Returned Value:
+ *   The number of messages in the batch; zero if nothing is pending.
+ *
+ ****************************************************************************/
+
+static int i2c_async_gather(FAR struct i2c_queue_s *queue)
+{
+  FAR struct i2c_request_s *req;
+  irqstate_t flags;
+  int nmsgs = 0;
+
+  flags = enter_critical_section();
+  while ((req = (FAR struct i2c_request_s *)sq_peek(&queue->pending)) != NULL)
+    {
+      if (nmsgs + req->msgc > CONFIG_I2C_ASYNC_MAXMSGS && nmsgs > 0)
+        {
+          break;
+        }
+
+      sq_remfirst(&queue->pending);
+      sq_addlast((FAR sq_entry_t *)req, &queue->active);
+      nmsgs += req->msgc;
+
+      if (nmsgs > CONFIG_I2C_ASYNC_MAXMSGS)
+        {
+          /* Too large to be chained, perform it alone */
+
+          break;
+        }
+    }
+
+  queue->busy = (nmsgs > 0);
+  leave_critical_section(flags);
+
+  /* A single request is transferred from its own message array.  Otherwise
+   * the messages are chained in the order the requests were submitted.
+   */
+
+  req = (FAR struct i2c_request_s *)sq_peek(&queue->active);
+  if (req == NULL || req->flink == NULL)
+    {
+      queue->batch = (req != NULL) ? req->msgv : NULL;
+    }
+  else
+    {
+      nmsgs = 0;
+      for (; req != NULL; req = req->flink)
+        {
+          memcpy(&queue->msgv[nmsgs], req->msgv,
+                 req->msgc * sizeof(struct i2c_msg_s));
+          nmsgs += req->msgc;
+        }
+
+      queue->batch = queue->msgv;
+    }
+
+  queue->nmsgs = nmsgs;
+  return nmsgs;
+}
+
+/****************************************************************************
+ * Name: i2c_async_complete
+ *
+ * Description:
+ *   Set the result of every request of the finished batch, call the
+ *   completion callbacks and restart the queue if more requests are
+ *   pending.
+ *
+ ****************************************************************************/
+
+static void i2c_async_complete(FAR struct i2c_queue_s *queue, int result)
+{
+  FAR struct i2c_request_s *req;
+  FAR struct i2c_request_s *next;
+  irqstate_t flags;
+
+  req = (FAR struct i2c_request_s *)sq_peek(&queue->active);
+  if (result < 0 && req != NULL && req->flink != NULL)
+    {
+      /* The chained transfer failed, e.g. because one device did not
+       * acknowledge.  Repeat the requests one by one so that the failure is
+       * reported only for the request it belongs to.
+       */
+
+      i2cwarn("WARNING: Batch failed: %d\n", result);
+
+      for (; req != NULL; req = req->flink)
+        {
+          result      = I2C_TRANSFER(queue->i2c, req->msgv, req->msgc);
+          req->result = (result >= 0) ? OK : result;
+        }
+    }
+  else
+    {
+      for (; req != NULL; req = req->flink)
+        {
+          req->result = (result >= 0) ? OK : result;
+        }
+    }
+
+  /* Detach the batch before the callbacks may re-submit their requests */
+
+  flags = enter_critical_section();
+  req   = (FAR struct i2c_request_s *)sq_peek(&queue->active);
+  sq_init(&queue->active);
+  queue->busy = false;
+  leave_critical_section(flags);
+
+  for (; req != NULL; req = next)
+    {
+      next = req->flink;
+      if (req->callback != NULL)
+        {
+          req->callback(req);
+        }
+    }
+
+  /* Come back for requests that were submitted in the meantime */
+
+  flags = enter_critical_section();
+  if (!queue->busy && !sq_empty(&queue->pending) &&
+      work_available(&queue->work))
+    {
+      work_queue(I2CWORK, &queue->work, i2c_async_worker, queue, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: i2c_async_done
+ *
+ * Description:
+ *   Completion callback of an asynchronous lower half transfer.  Called
+ *   from interrupt level.
+ *
+ ****************************************************************************/
+
+static void i2c_async_done(FAR void *arg, int result)
+{
+  FAR struct i2c_queue_s *queue = (FAR struct i2c_queue_s *)arg;
+
+  queue->result = result;
+  work_queue(I2CWORK, &queue->work, i2c_async_worker, queue, 0);
+}
+
+/****************************************************************************
+ * Name: i2c_async_worker
+ *
+ * Description:
+ *   Finish an asynchronous batch, if one was on the bus, then start the
+ *   next one.  Lower halves without I2C_TRANSFER_ASYNC support are driven
+ *   synchronously from here.
+ *
+ ****************************************************************************/
+
+static void i2c_async_worker(FAR void *arg)
+{
+  FAR struct i2c_queue_s *queue = (FAR struct i2c_queue_s *)arg;
+  int ret;
+
+  if (queue->busy)
+    {
+      i2c_async_complete(queue, queue->result);
+      if (queue->busy || !work_available(&queue->work))
+        {
+          /* A callback has already restarted the queue */
+
+          return;
+        }
+    }
+
+  if (i2c_async_gather(queue) == 0)
+    {
+      return;
+    }
+
+  ret = I2C_TRANSFER_ASYNC(queue->i2c, queue->batch, queue->nmsgs,
+                           i2c_async_done, queue);
+  if (ret >= 0)
+    {
+      /* i2c_async_done() will bring us back */
+
+      return;
+    }
+
+  ret = I2C_TRANSFER(queue->i2c, queue->batch, queue->nmsgs);
+  i2c_async_complete(queue, ret);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Initialize the transfer queue for one I2C bus.
+ *
+ ****************************************************************************/
+
+void i2c_queue_initialize(FAR struct i2c_queue_s *queue,
+                          FAR struct i2c_master_s *i2c)
+{
+  DEBUGASSERT(queue != NULL && i2c != NULL);
+
+  memset(queue, 0, sizeof(struct i2c_queue_s));
+  queue->i2c = i2c;
+  sq_init(&queue->pending);
+  sq_init(&queue->active);
+}
+
+/****************************************************************************
+ * Name: i2c_async_submit
+ *
+ * Description:
+ *   Queue one device transaction and return immediately.
+ *
+ ****************************************************************************/
+
+int i2c_async_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(queue != NULL && req != NULL && req->msgv != NULL);
+
+  if (req->msgc <= 0 ||
+      (req->msgv[req->msgc - 1].flags & I2C_M_NOSTOP) != 0)
+    {
+      return -EINVAL;
+    }
+
+  req->result = -EINPROGRESS;
+
+  flags = enter_critical_section();
+  sq_addlast((FAR sq_entry_t *)req, &queue->pending);
+
+  if (!queue->busy && work_available(&queue->work))
+    {
+      ret = work_queue(I2CWORK, &queue->work, i2c_async_worker, queue, 0);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not yet been started.
+ *
+ ****************************************************************************/
+
+int i2c_async_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(queue != NULL && req != NULL);
+
+  flags = enter_critical_section();
+  for (entry = sq_peek(&queue->pending); entry != NULL; entry = entry->flink)
+    {
+      if (entry == (FAR sq_entry_t *)req)
+        {
+          sq_rem(entry, &queue->pending);
+          ret = OK;
+          break;
+        }
+    }
+
+  if (ret < 0)
+    {
+      for (entry = sq_peek(&queue->active); entry != NULL;
+           entry = entry->flink)
+        {
+          if (entry == (FAR sq_entry_t *)req)
+            {
+              ret = -EBUSY;
+              break;
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+#endif /* CONFIG_I2C_ASYNC */
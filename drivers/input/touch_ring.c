@@ -0,0 +1,148 @@
+/****************************************************************************
+ * drivers/input/touch_ring.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/input/touchscreen.h>
+
+#ifdef CONFIG_INPUT_TOUCHRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Flags that describe what happened, as opposed to what is valid */
+
+#define TOUCH_EVENT_MASK (TOUCH_DOWN | TOUCH_MOVE | TOUCH_UP)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: touch_ring_put
+ *
+ * Description:
+ *   Add an event to the ring.  See include/nuttx/input/touchscreen.h.
+ *
+ ****************************************************************************/
+
+bool touch_ring_put(FAR struct touch_ring_s *ring,
+                    FAR const struct touch_point_s *point)
+{
+  FAR struct touch_point_s *last;
+  int ndx;
+
+#ifdef CONFIG_INPUT_TOUCHRING_COALESCE
+  /* If the newest unread event is a contact or movement of the same point,
+   * a movement only updates its position.  Keep the event type of the
+   * unread event so that a contact is still reported as such.
+   */
+
+  if (ring->nevents > 0 && (point->flags & TOUCH_EVENT_MASK) == TOUCH_MOVE)
+    {
+      ndx  = (ring->head + ring->nevents - 1) % CONFIG_INPUT_TOUCHRING_NEVENTS;
+      last = &ring->event[ndx];
+
+      if (last->id == point->id &&
+          (last->flags & (TOUCH_DOWN | TOUCH_MOVE)) != 0)
+        {
+          last->flags    = (last->flags & TOUCH_EVENT_MASK) |
+                           (point->flags & ~TOUCH_EVENT_MASK);
+          last->x        = point->x;
+          last->y        = point->y;
+          last->h        = point->h;
+          last->w        = point->w;
+          last->pressure = point->pressure;
+          return false;
+        }
+    }
+#endif
+
+  /* Discard the oldest event if there is no room */
+
+  if (ring->nevents >= CONFIG_INPUT_TOUCHRING_NEVENTS)
+    {
+      ring->head = (ring->head + 1) % CONFIG_INPUT_TOUCHRING_NEVENTS;
+      ring->nevents--;
+    }
+
+  ndx  = (ring->head + ring->nevents) % CONFIG_INPUT_TOUCHRING_NEVENTS;
+  last = &ring->event[ndx];
+
+  memcpy(last, point, sizeof(struct touch_point_s));
+  ring->nevents++;
+  return true;
+}
+
+/****************************************************************************
+ * Name: touch_ring_read
+ *
+ * Description:
+ *   Remove queued events.  See include/nuttx/input/touchscreen.h.
+ *
+ ****************************************************************************/
+
+ssize_t touch_ring_read(FAR struct touch_ring_s *ring, FAR char *buffer,
+                        size_t buflen)
+{
+  FAR struct touch_sample_s *report;
+  ssize_t nbytes = 0;
+
+  while (ring->nevents > 0 && buflen - nbytes >= SIZEOF_TOUCH_SAMPLE_S(1))
+    {
+      report          = (FAR struct touch_sample_s *)&buffer[nbytes];
+      report->npoints = 1;
+      memcpy(&report->point[0], &ring->event[ring->head],
+             sizeof(struct touch_point_s));
+
+      ring->head = (ring->head + 1) % CONFIG_INPUT_TOUCHRING_NEVENTS;
+      ring->nevents--;
+      nbytes += SIZEOF_TOUCH_SAMPLE_S(1);
+    }
+
+  return nbytes;
+}
+
+#endif /* CONFIG_INPUT_TOUCHRING */
@@ -171,6 +171,9 @@ struct tsc2007_dev_s
   FAR struct i2c_master_s *i2c;        /* Saved I2C driver instance */
   struct work_s work;                  /* Supports the interrupt handling "bottom half" */
   struct tsc2007_sample_s sample;      /* Last sampled touch point data */
+#ifdef CONFIG_INPUT_TOUCHRING
+  struct touch_ring_s ring;            /* Events waiting to be read */
+#endif
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -187,6 +190,8 @@ struct tsc2007_dev_s
  ****************************************************************************/
 
 static void tsc2007_notify(FAR struct tsc2007_dev_s *priv);
+static void tsc2007_point(FAR const struct tsc2007_sample_s *sample,
+                          FAR struct touch_point_s *point);
 static int tsc2007_sample(FAR struct tsc2007_dev_s *priv,
                           FAR struct tsc2007_sample_s *sample);
 static int tsc2007_waitsample(FAR struct tsc2007_dev_s *priv,
@@ -287,8 +292,73 @@ static void tsc2007_notify(FAR struct tsc2007_dev_s *priv)
 #endif
 }
 
+/****************************************************************************
+ * Name: tsc2007_point
+ *
+ * Description:
+ *   Convert a sample to the touch point that is reported to the reader.
+ *
+ ****************************************************************************/
+
+static void tsc2007_point(FAR const struct tsc2007_sample_s *sample,
+                          FAR struct touch_point_s *point)
+{
+  memset(point, 0, sizeof(struct touch_point_s));
+  point->id       = sample->id;
+  point->x        = sample->x;
+  point->y        = sample->y;
+  point->pressure = sample->pressure;
+
+  /* Report the appropriate flags */
+
+  if (sample->contact == CONTACT_UP)
+    {
+      /* Pen is now up.  Is the positional data valid?  This is important to
+       * know because the release will be sent to the window based on its
+       * last positional data.
+       */
+
+      if (sample->valid)
+        {
+          point->flags  = TOUCH_UP | TOUCH_ID_VALID |
+                          TOUCH_POS_VALID | TOUCH_PRESSURE_VALID;
+        }
+      else
+        {
+          point->flags  = TOUCH_UP | TOUCH_ID_VALID;
+        }
+    }
+  else
+    {
+      if (sample->contact == CONTACT_DOWN)
+        {
+          /* First contact */
+
+          point->flags  = TOUCH_DOWN | TOUCH_ID_VALID | TOUCH_POS_VALID;
+        }
+      else /* if (sample->contact == CONTACT_MOVE) */
+        {
+          /* Movement of the same contact */
+
+          point->flags  = TOUCH_MOVE | TOUCH_ID_VALID | TOUCH_POS_VALID;
+        }
+
+      /* A pressure measurement of zero means that pressure is not available */
+
+      if (point->pressure != 0)
+        {
+          point->flags |= TOUCH_PRESSURE_VALID;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: tsc2007_sample
+ *
+ * Description:
+ *   Get the sample to report.  With CONFIG_INPUT_TOUCHRING, the events are
+ *   already queued in the ring and this only tells whether there are any.
+ *
  ****************************************************************************/
 
 static int tsc2007_sample(FAR struct tsc2007_dev_s *priv,
@@ -306,6 +376,12 @@ static int tsc2007_sample(FAR struct tsc2007_dev_s *priv,
 
   /* Is there new TSC2007 sample data available? */
 
+#ifdef CONFIG_INPUT_TOUCHRING
+  if (priv->penchange)
+    {
+      ret = OK;
+    }
+#else
   if (priv->penchange)
     {
       /* Yes.. the state has changed in some way.  Return a copy of the
@@ -336,6 +412,7 @@ static int tsc2007_sample(FAR struct tsc2007_dev_s *priv,
       priv->penchange = false;
       ret = OK;
     }
+#endif
 
   leave_critical_section(flags);
   return ret;
@@ -733,11 +810,50 @@ static void tsc2007_worker(FAR void *arg)
   /* Indicate the availability of new sample data for this ID */
 
   priv->sample.id = priv->id;
+
+#ifdef CONFIG_INPUT_TOUCHRING
+  {
+    struct touch_point_s point;
+    irqstate_t flags;
+    bool queued;
+
+    /* Queue the event now and advance the contact state as reading it
+     * would, so that a quick tap is not lost behind an unread
+     * loss-of-contact.
+     */
+
+    tsc2007_point(&priv->sample, &point);
+
+    flags = enter_critical_section();
+    if (priv->sample.contact == CONTACT_UP)
+      {
+        priv->sample.contact = CONTACT_NONE;
+        priv->sample.valid   = false;
+        priv->id++;
+      }
+    else if (priv->sample.contact == CONTACT_DOWN)
+      {
+        priv->sample.contact = CONTACT_MOVE;
+      }
+
+    queued          = touch_ring_put(&priv->ring, &point);
+    priv->penchange = true;
+    leave_critical_section(flags);
+
+    /* A movement merged into an unread event needs no new notification */
+
+    if (queued)
+      {
+        tsc2007_notify(priv);
+      }
+  }
+#else
   priv->penchange = true;
 
   /* Notify any waiters that new TSC2007 data is available */
 
   tsc2007_notify(priv);
+#endif
 
   /* Exit, re-enabling TSC2007 interrupts */
 
@@ -907,6 +1023,9 @@ static ssize_t tsc2007_read(FAR struct file *filep, FAR char *buffer, size_t len
   FAR struct tsc2007_dev_s  *priv;
   FAR struct touch_sample_s *report;
   struct tsc2007_sample_s    sample;
+#ifdef CONFIG_INPUT_TOUCHRING
+  irqstate_t                 flags;
+#endif
   int                        ret;
 
   DEBUGASSERT(filep);
@@ -971,57 +1090,22 @@ static ssize_t tsc2007_read(FAR struct file *filep, FAR char *buffer, size_t len
    * to the caller.
    */
 
-  report = (FAR struct touch_sample_s *)buffer;
-  memset(report, 0, SIZEOF_TOUCH_SAMPLE_S(1));
-  report->npoints            = 1;
-  report->point[0].id        = priv->id;
-  report->point[0].x         = sample.x;
-  report->point[0].y         = sample.y;
-  report->point[0].pressure  = sample.pressure;
+#ifdef CONFIG_INPUT_TOUCHRING
+  /* Return as many queued events as fit in the caller's buffer */
 
-  /* Report the appropriate flags */
+  UNUSED(report);
 
-  if (sample.contact == CONTACT_UP)
-    {
-      /* Pen is now up.  Is the positional data valid?  This is important to
-       * know because the release will be sent to the window based on its
-       * last positional data.
-       */
-
-      if (sample.valid)
-        {
-          report->point[0].flags  = TOUCH_UP | TOUCH_ID_VALID |
-                                    TOUCH_POS_VALID | TOUCH_PRESSURE_VALID;
-        }
-      else
-        {
-          report->point[0].flags  = TOUCH_UP | TOUCH_ID_VALID;
-        }
-    }
-  else
-    {
-      if (sample.contact == CONTACT_DOWN)
-        {
-          /* Loss of contact */
-
-          report->point[0].flags  = TOUCH_DOWN | TOUCH_ID_VALID | TOUCH_POS_VALID;
-        }
-      else /* if (sample->contact == CONTACT_MOVE) */
-        {
-          /* Movement of the same contact */
-
-          report->point[0].flags  = TOUCH_MOVE | TOUCH_ID_VALID | TOUCH_POS_VALID;
-        }
-
-      /* A pressure measurement of zero means that pressure is not available */
-
-      if (report->point[0].pressure != 0)
-        {
-          report->point[0].flags  |= TOUCH_PRESSURE_VALID;
-        }
-    }
+  flags = enter_critical_section();
+  ret   = touch_ring_read(&priv->ring, buffer, len);
+  priv->penchange = !touch_ring_empty(&priv->ring);
+  leave_critical_section(flags);
+#else
+  report = (FAR struct touch_sample_s *)buffer;
+  report->npoints = 1;
+  tsc2007_point(&sample, &report->point[0]);
 
   ret = SIZEOF_TOUCH_SAMPLE_S(1);
+#endif
 
 errout:
   nxsem_post(&priv->devsem);
@@ -389,6 +389,12 @@ struct ili9341_dev_s
 
   int (*putrun)(fb_coord_t row, fb_coord_t col,
                 FAR const uint8_t * buffer, size_t npixels);
+
+  /* Driver specific putarea function */
+
+  int (*putarea)(fb_coord_t row_start, fb_coord_t row_end,
+                 fb_coord_t col_start, fb_coord_t col_end,
+                 FAR const uint8_t *buffer, fb_coord_t stride);
 #ifndef CONFIG_LCD_NOGETRUN
   /* Driver specific getrun function */
 
@@ -430,6 +436,12 @@ static inline uint16_t ili9341_getyres(FAR struct ili9341_dev_s *dev);
 
 static int ili9341_putrun(int devno, fb_coord_t row, fb_coord_t col,
                          FAR const uint8_t * buffer, size_t npixels);
+#if defined(CONFIG_LCD_ILI9341_IFACE0) || defined(CONFIG_LCD_ILI9341_IFACE1)
+static int ili9341_putarea(int devno, fb_coord_t row_start,
+                           fb_coord_t row_end, fb_coord_t col_start,
+                           fb_coord_t col_end, FAR const uint8_t *buffer,
+                           fb_coord_t stride);
+#endif
 #ifndef CONFIG_LCD_NOGETRUN
 static int ili9341_getrun(int devno, fb_coord_t row, fb_coord_t col,
                          FAR uint8_t * buffer, size_t npixels);
@@ -448,6 +460,17 @@ static int ili9341_putrun1(fb_coord_t row, fb_coord_t col,
                             FAR const uint8_t * buffer, size_t npixsels);
 #endif
 
+#ifdef CONFIG_LCD_ILI9341_IFACE0
+static int ili9341_putarea0(fb_coord_t row_start, fb_coord_t row_end,
+                            fb_coord_t col_start, fb_coord_t col_end,
+                            FAR const uint8_t *buffer, fb_coord_t stride);
+#endif
+#ifdef CONFIG_LCD_ILI9341_IFACE1
+static int ili9341_putarea1(fb_coord_t row_start, fb_coord_t row_end,
+                            fb_coord_t col_start, fb_coord_t col_end,
+                            FAR const uint8_t *buffer, fb_coord_t stride);
+#endif
+
 #ifndef CONFIG_LCD_NOGETRUN
 # ifdef CONFIG_LCD_ILI9341_IFACE0
 static int ili9341_getrun0(fb_coord_t row, fb_coord_t col,
@@ -492,6 +515,7 @@ static struct ili9341_dev_s g_lcddev[CONFIG_LCD_ILI9341_NINTERFACES] =
   {
     .lcd              = 0,
     .putrun           = ili9341_putrun0,
+    .putarea          = ili9341_putarea0,
 # ifndef CONFIG_LCD_NOGETRUN
     .getrun           = ili9341_getrun0,
 # endif
@@ -506,6 +530,7 @@ static struct ili9341_dev_s g_lcddev[CONFIG_LCD_ILI9341_NINTERFACES] =
   {
     .lcd              = 0,
     .putrun           = ili9341_putrun1,
+    .putarea          = ili9341_putarea1,
 # ifndef CONFIG_LCD_NOGETRUN
     .getrun           = ili9341_getrun1,
 # endif
@@ -674,6 +699,83 @@ static int ili9341_putrun(int devno, fb_coord_t row, fb_coord_t col,
 }
 
 
+/****************************************************************************
+ * Name:  ili9341_putarea
+ *
+ * Description:
+ *   Write a rectangular area to the LCD.  The window is selected once and
+ *   all rows are streamed with a single memory write command.
+ *
+ * Input Parameters:
+ *   devno     - Number of lcd device
+ *   row_start - Starting row to write to
+ *   row_end   - Ending row (inclusive)
+ *   col_start - Starting column to write to
+ *   col_end   - Ending column (inclusive)
+ *   buffer    - The first pixel of the area
+ *   stride    - Distance in bytes from one row of the area to the next
+ *
+ * Returned Value:
+ *
+ *   On success - OK
+ *   On error   - -EINVAL
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_LCD_ILI9341_IFACE0) || defined(CONFIG_LCD_ILI9341_IFACE1)
+static int ili9341_putarea(int devno, fb_coord_t row_start,
+                           fb_coord_t row_end, fb_coord_t col_start,
+                           fb_coord_t col_end, FAR const uint8_t *buffer,
+                           fb_coord_t stride)
+{
+  FAR struct ili9341_dev_s *dev = &g_lcddev[devno];
+  FAR struct ili9341_lcd_s *lcd = dev->lcd;
+  size_t npixels = col_end - col_start + 1;
+  fb_coord_t row;
+
+  DEBUGASSERT(buffer && ((uintptr_t)buffer & 1) == 0 && (stride & 1) == 0);
+
+  /* Check if position outside of area */
+
+  if (row_end < row_start || col_end < col_start ||
+      col_end >= ili9341_getxres(dev) || row_end >= ili9341_getyres(dev))
+    {
+      return -EINVAL;
+    }
+
+  /* Select lcd driver */
+
+  lcd->select(lcd);
+
+  /* Select the window and start one memory write for all of it */
+
+  ili9341_selectarea(lcd, col_start, row_start, col_end, row_end);
+  lcd->sendcmd(lcd, ILI9341_MEMORY_WRITE);
+
+  if (stride == npixels * sizeof(uint16_t))
+    {
+      /* The rows are contiguous, send them as one block */
+
+      lcd->sendgram(lcd, (FAR const uint16_t *)buffer,
+                    npixels * (row_end - row_start + 1));
+    }
+  else
+    {
+      for (row = row_start; row <= row_end; row++)
+        {
+          lcd->sendgram(lcd, (FAR const uint16_t *)buffer, npixels);
+          buffer += stride;
+        }
+    }
+
+  /* Deselect the lcd driver */
+
+  lcd->deselect(lcd);
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name:  ili9341_getrun
  *
@@ -869,6 +971,33 @@ static int ili9341_putrun1(fb_coord_t row, fb_coord_t col,
 }
 #endif
 
+/****************************************************************************
+ * Name:  ili9341_putareax
+ *
+ * Description:
+ *   Write a rectangular area to the LCD.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LCD_ILI9341_IFACE0
+static int ili9341_putarea0(fb_coord_t row_start, fb_coord_t row_end,
+                            fb_coord_t col_start, fb_coord_t col_end,
+                            FAR const uint8_t *buffer, fb_coord_t stride)
+{
+  return ili9341_putarea(0, row_start, row_end, col_start, col_end,
+                         buffer, stride);
+}
+#endif
+
+#ifdef CONFIG_LCD_ILI9341_IFACE1
+static int ili9341_putarea1(fb_coord_t row_start, fb_coord_t row_end,
+                            fb_coord_t col_start, fb_coord_t col_end,
+                            FAR const uint8_t *buffer, fb_coord_t stride)
+{
+  return ili9341_putarea(1, row_start, row_end, col_start, col_end,
+                         buffer, stride);
+}
+#endif
 
 /****************************************************************************
  * Name:  ili9341_getrunx
@@ -972,9 +1101,10 @@ static int ili9341_getplaneinfo(FAR struct lcd_dev_s *dev, unsigned int planeno,
     {
       FAR struct ili9341_dev_s *priv = (FAR struct ili9341_dev_s *)dev;
 
-      pinfo->putrun = priv->putrun;
+      pinfo->putrun  = priv->putrun;
+      pinfo->putarea = priv->putarea;
 #ifndef CONFIG_LCD_NOGETRUN
-      pinfo->getrun = priv->getrun;
+      pinfo->getrun  = priv->getrun;
 #endif
       pinfo->bpp    = priv->bpp;
       pinfo->buffer = (FAR uint8_t *)priv->runbuffer;  /* Run scratch buffer */
@@ -46,12 +46,18 @@
 #include <debug.h>
 
 #include <nuttx/board.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/nx/nx.h>
 #include <nuttx/nx/nxglib.h>
 #include <nuttx/lcd/lcd.h>
 #include <nuttx/video/fb.h>
 
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+#  include <nuttx/clock.h>
+#  include <nuttx/wqueue.h>
+#endif
+
 #ifdef CONFIG_LCD_FRAMEBUFFER
 
 /****************************************************************************
@@ -62,6 +68,33 @@
 
 #define VIDEO_PLANE 0
 
+/* Deferred update */
+
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+#  ifndef CONFIG_SCHED_LPWORK
+#    error Low priority work queue support is required (CONFIG_SCHED_LPWORK)
+#  endif
+
+#  ifndef CONFIG_LCD_FBUPDATE_DELAY
+#    define CONFIG_LCD_FBUPDATE_DELAY 20
+#  endif
+
+#  ifndef CONFIG_LCD_FBUPDATE_NRECTS
+#    define CONFIG_LCD_FBUPDATE_NRECTS 4
+#  endif
+#endif
+
+/* Multiple frames */
+
+#ifdef CONFIG_FB_PANDISPLAY
+#  ifndef CONFIG_FB_NBUFFERS
+#    define CONFIG_FB_NBUFFERS 2
+#  endif
+#  define LCDFB_NFRAMES CONFIG_FB_NBUFFERS
+#else
+#  define LCDFB_NFRAMES 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -80,6 +113,17 @@ struct lcdfb_dev_s
   fb_coord_t yres;                  /* Vertical resolution in pixel rows */
   fb_coord_t stride;                /* Width of a row in bytes */
   uint8_t display;                  /* Display number */
+#ifdef CONFIG_FB_PANDISPLAY
+  fb_coord_t yoffset;               /* First row of the frame on the LCD */
+                                    /* Per frame: Where the LCD differs */
+  struct nxgl_rect_s stale[CONFIG_FB_NBUFFERS];
+#endif
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+  uint8_t ndirty;                   /* Number of entries in dirty[] */
+  struct work_s work;               /* Deferred update of the LCD */
+                                    /* Regions not yet written to the LCD */
+  struct nxgl_rect_s dirty[CONFIG_LCD_FBUPDATE_NRECTS];
+#endif
 };
 
 /****************************************************************************
@@ -90,6 +134,17 @@ struct lcdfb_dev_s
 
 static int lcdfb_update(FAR struct lcdfb_dev_s *priv,
              FAR const struct nxgl_rect_s *rect);
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+static void lcdfb_adddirty(FAR struct lcdfb_dev_s *priv,
+             FAR const struct nxgl_rect_s *rect);
+static void lcdfb_worker(FAR void *arg);
+#endif
+static void lcdfb_notify(FAR struct lcdfb_dev_s *priv,
+             FAR const struct nxgl_rect_s *rect);
+#ifdef CONFIG_FB_PANDISPLAY
+static void lcdfb_addstale(FAR struct nxgl_rect_s *stale,
+             FAR const struct nxgl_rect_s *rect);
+#endif
 
 /* Get information about the video controller configuration and the
  * configuration of each color plane.
@@ -122,6 +177,16 @@ static int lcdfb_setcursor(FAR struct fb_vtable_s *vtable,
              FAR struct fb_setcursor_s *settings);
 #endif
 
+/* Vertical sync and frame selection */
+
+#ifdef CONFIG_FB_SYNC
+static int lcdfb_waitforvsync(FAR struct fb_vtable_s *vtable);
+#endif
+#ifdef CONFIG_FB_PANDISPLAY
+static int lcdfb_pandisplay(FAR struct fb_vtable_s *vtable,
+             FAR const struct fb_planeinfo_s *pinfo);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -170,7 +235,9 @@ static FAR struct lcdfb_dev_s *lcdfb_find(int display)
  * Name: lcdfb_update
  *
  * Description:
- * Update the LCD when there is a change to the framebuffer.
+ *   Update the LCD when there is a change to the framebuffer.  The region
+ *   is in display coordinates and is taken from the frame that is on the
+ *   LCD.
  *
  ****************************************************************************/
 
@@ -229,6 +296,16 @@ static int lcdfb_update(FAR struct lcdfb_dev_s *priv,
 
   run  = priv->fbmem + starty * priv->stride;
   run += (startx * pinfo->bpp + 7) >> 3;
+#ifdef CONFIG_FB_PANDISPLAY
+  run += priv->yoffset * priv->stride;
+#endif
+
+  /* Prefer one windowed transfer of the whole area if the LCD supports it */
+
+  if (pinfo->putarea != NULL)
+    {
+      return pinfo->putarea(starty, endy, startx, endx, run, priv->stride);
+    }
 
   for (row = starty; row <= endy; row++)
     {
@@ -248,6 +325,231 @@ static int lcdfb_update(FAR struct lcdfb_dev_s *priv,
   return OK;
 }
 
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+/****************************************************************************
+ * Name: lcdfb_area
+ *
+ * Description:
+ *   Return the number of pixels in a rectangle.
+ *
+ ****************************************************************************/
+
+static uint32_t lcdfb_area(FAR const struct nxgl_rect_s *rect)
+{
+  return (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+         (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+
+/****************************************************************************
+ * Name: lcdfb_touch
+ *
+ * Description:
+ *   Return true if two rectangles overlap or share an edge.
+ *
+ ****************************************************************************/
+
+static bool lcdfb_touch(FAR const struct nxgl_rect_s *rect1,
+                        FAR const struct nxgl_rect_s *rect2)
+{
+  return rect1->pt1.x <= rect2->pt2.x + 1 &&
+         rect2->pt1.x <= rect1->pt2.x + 1 &&
+         rect1->pt1.y <= rect2->pt2.y + 1 &&
+         rect2->pt1.y <= rect1->pt2.y + 1;
+}
+
+/****************************************************************************
+ * Name: lcdfb_adddirty
+ *
+ * Description:
+ *   Add a region to the list of regions waiting to be written to the LCD.
+ *   Overlapping or adjacent regions are merged.  If the list is full, the
+ *   region is merged with the entry whose bounding box grows the least.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static void lcdfb_adddirty(FAR struct lcdfb_dev_s *priv,
+                           FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s merged;
+  uint32_t growth;
+  uint32_t best;
+  int ndx;
+  int i;
+
+  merged = *rect;
+
+  /* Absorb every entry that overlaps or touches the new region.  Each
+   * merge can make the region touch entries that it did not touch before,
+   * so start over after each one.
+   */
+
+  for (i = 0; i < priv->ndirty; )
+    {
+      if (lcdfb_touch(&merged, &priv->dirty[i]))
+        {
+          nxgl_rectunion(&merged, &merged, &priv->dirty[i]);
+          priv->dirty[i] = priv->dirty[--priv->ndirty];
+          i = 0;
+        }
+      else
+        {
+          i++;
+        }
+    }
+
+  if (priv->ndirty < CONFIG_LCD_FBUPDATE_NRECTS)
+    {
+      priv->dirty[priv->ndirty++] = merged;
+      return;
+    }
+
+  /* The list is full.  Merge with the entry that grows the least. */
+
+  ndx  = 0;
+  best = UINT32_MAX;
+
+  for (i = 0; i < priv->ndirty; i++)
+    {
+      struct nxgl_rect_s tmp;
+
+      nxgl_rectunion(&tmp, &merged, &priv->dirty[i]);
+      growth = lcdfb_area(&tmp) - lcdfb_area(&priv->dirty[i]);
+      if (growth < best)
+        {
+          best = growth;
+          ndx  = i;
+        }
+    }
+
+  nxgl_rectunion(&priv->dirty[ndx], &priv->dirty[ndx], &merged);
+}
+
+/****************************************************************************
+ * Name: lcdfb_worker
+ *
+ * Description:
+ *   Write all accumulated regions to the LCD.  Runs on the low priority
+ *   work queue CONFIG_LCD_FBUPDATE_DELAY milliseconds after the first
+ *   change, so that a burst of drawing operations results in one transfer
+ *   per merged region.
+ *
+ ****************************************************************************/
+
+static void lcdfb_worker(FAR void *arg)
+{
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)arg;
+  struct nxgl_rect_s dirty[CONFIG_LCD_FBUPDATE_NRECTS];
+  irqstate_t flags;
+  int ndirty;
+  int ret;
+  int i;
+
+  /* Take the list.  Changes made while the LCD is written are collected
+   * for the next pass.
+   */
+
+  flags  = enter_critical_section();
+  ndirty = priv->ndirty;
+  memcpy(dirty, priv->dirty, ndirty * sizeof(struct nxgl_rect_s));
+  priv->ndirty = 0;
+  leave_critical_section(flags);
+
+  for (i = 0; i < ndirty; i++)
+    {
+      ret = lcdfb_update(priv, &dirty[i]);
+      if (ret < 0)
+        {
+          lcderr("FB update failed: %d\n", ret);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: lcdfb_notify
+ *
+ * Description:
+ *   A region of the frame on the LCD has changed.  Write it to the LCD now
+ *   or, if updates are deferred, schedule the write.
+ *
+ ****************************************************************************/
+
+static void lcdfb_notify(FAR struct lcdfb_dev_s *priv,
+                         FAR const struct nxgl_rect_s *rect)
+{
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+  irqstate_t flags;
+
+  /* Just remember the region and write it to the LCD later */
+
+  flags = enter_critical_section();
+  lcdfb_adddirty(priv, rect);
+  if (work_available(&priv->work))
+    {
+      (void)work_queue(LPWORK, &priv->work, lcdfb_worker, priv,
+                       MSEC2TICK(CONFIG_LCD_FBUPDATE_DELAY));
+    }
+
+  leave_critical_section(flags);
+#else
+  int ret;
+
+  ret = lcdfb_update(priv, rect);
+  if (ret < 0)
+    {
+      lcderr("FB update failed: %d\n", ret);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: lcdfb_flush
+ *
+ * Description:
+ *   Write any deferred regions to the LCD now.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_LCD_FBUPDATE_DEFER) && \
+   (defined(CONFIG_FB_SYNC) || defined(CONFIG_FB_PANDISPLAY))
+static void lcdfb_flush(FAR struct lcdfb_dev_s *priv)
+{
+  /* REVISIT:  This does not wait for a worker that is already running, so
+   * the two may briefly write to the LCD at the same time.
+   */
+
+  (void)work_cancel(LPWORK, &priv->work);
+  lcdfb_worker(priv);
+}
+#endif
+
+/****************************************************************************
+ * Name: lcdfb_addstale
+ *
+ * Description:
+ *   Grow the region where the LCD does not match a frame.  An empty region
+ *   is represented by a null rectangle.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_PANDISPLAY
+static void lcdfb_addstale(FAR struct nxgl_rect_s *stale,
+                           FAR const struct nxgl_rect_s *rect)
+{
+  if (nxgl_nullrect(stale))
+    {
+      *stale = *rect;
+    }
+  else
+    {
+      nxgl_rectunion(stale, stale, rect);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: lcdfb_getvideoinfo
  ****************************************************************************/
@@ -304,6 +606,10 @@ static int lcdfb_getplaneinfo(FAR struct fb_vtable_s *vtable, int planeno,
       pinfo->stride  = priv->stride;
       pinfo->display = priv->display;
       pinfo->bpp     = priv->pinfo.bpp;
+#ifdef CONFIG_FB_PANDISPLAY
+      pinfo->yres_virtual = priv->yres * CONFIG_FB_NBUFFERS;
+      pinfo->yoffset      = priv->yoffset;
+#endif
 
       ret = OK;
     }
@@ -448,6 +754,112 @@ static int lcdfb_setcursor(FAR struct fb_vtable_s *vtable,
 }
 #endif
 
+/****************************************************************************
+ * Name: lcdfb_waitforvsync
+ *
+ * Description:
+ *   The LCD has no vertical sync that is visible here.  The closest
+ *   equivalent is that all changes made so far have reached the LCD.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_SYNC
+static int lcdfb_waitforvsync(FAR struct fb_vtable_s *vtable)
+{
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
+
+  DEBUGASSERT(priv != NULL);
+  lcdfb_flush(priv);
+#endif
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: lcdfb_pandisplay
+ *
+ * Description:
+ *   Put the frame starting at row pinfo->yoffset on the LCD.  Only the
+ *   region where the LCD differs from that frame is written: what was
+ *   drawn in it while it was hidden, plus what was drawn in the outgoing
+ *   frame since the new one was last shown.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_PANDISPLAY
+static int lcdfb_pandisplay(FAR struct fb_vtable_s *vtable,
+                            FAR const struct fb_planeinfo_s *pinfo)
+{
+  FAR struct lcdfb_dev_s *priv;
+  struct nxgl_rect_s stale;
+  irqstate_t flags;
+  int frame;
+  int i;
+
+  lcdinfo("vtable=%p yoffset=%d\n", vtable, pinfo->yoffset);
+
+  DEBUGASSERT(vtable != NULL && pinfo != NULL);
+  priv = (FAR struct lcdfb_dev_s *)vtable;
+
+  /* Only whole frames can be selected */
+
+  frame = pinfo->yoffset / priv->yres;
+  if (pinfo->yoffset % priv->yres != 0 || frame >= CONFIG_FB_NBUFFERS)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  if (pinfo->yoffset == priv->yoffset)
+    {
+      leave_critical_section(flags);
+      return OK;
+    }
+
+  /* After the write, the LCD matches the new frame in the stale region and
+   * so no longer matches any other frame there.
+   */
+
+  stale = priv->stale[frame];
+  if (!nxgl_nullrect(&stale))
+    {
+      for (i = 0; i < CONFIG_FB_NBUFFERS; i++)
+        {
+          if (i != frame)
+            {
+              lcdfb_addstale(&priv->stale[i], &stale);
+            }
+        }
+    }
+
+  memset(&priv->stale[frame], 0, sizeof(struct nxgl_rect_s));
+  priv->stale[frame].pt2.x = -1;
+  priv->stale[frame].pt2.y = -1;
+  priv->yoffset = pinfo->yoffset;
+
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+  /* Regions still queued for the outgoing frame were added to the stale
+   * region of every other frame when they were queued.
+   */
+
+  priv->ndirty = 0;
+  if (!nxgl_nullrect(&stale))
+    {
+      lcdfb_adddirty(priv, &stale);
+    }
+
+  leave_critical_section(flags);
+  lcdfb_flush(priv);
+  return OK;
+#else
+  leave_critical_section(flags);
+  return nxgl_nullrect(&stale) ? OK : lcdfb_update(priv, &stale);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -474,6 +886,9 @@ int up_fbinitialize(int display)
   FAR struct lcd_dev_s *lcd;
   struct fb_videoinfo_s vinfo;
   struct nxgl_rect_s rect;
+#ifdef CONFIG_FB_PANDISPLAY
+  int i;
+#endif
   int ret;
 
   lcdinfo("display=%d\n", display);
@@ -502,6 +917,12 @@ int up_fbinitialize(int display)
   priv->vtable.getcursor    = lcdfb_getcursor,
   priv->vtable.setcursor    = lcdfb_setcursor,
 #endif
+#ifdef CONFIG_FB_SYNC
+  priv->vtable.waitforvsync = lcdfb_waitforvsync,
+#endif
+#ifdef CONFIG_FB_PANDISPLAY
+  priv->vtable.pandisplay   = lcdfb_pandisplay,
+#endif
 
 #ifdef  CONFIG_LCD_EXTERNINIT
   /* Use external graphics driver initialization */
@@ -556,10 +977,12 @@ int up_fbinitialize(int display)
       goto errout_with_lcd;
     }
 
-  /* Allocate (and clear) the framebuffer */
+  /* Allocate (and clear) the framebuffer.  With CONFIG_FB_PANDISPLAY it
+   * holds CONFIG_FB_NBUFFERS frames, one after the other.
+   */
 
   priv->stride = ((size_t)priv->xres * priv->pinfo.bpp + 7) >> 3;
-  priv->fblen  = priv->stride * priv->yres;
+  priv->fblen  = priv->stride * priv->yres * LCDFB_NFRAMES;
 
   priv->fbmem  = (FAR uint8_t *)kmm_zalloc(priv->fblen);
   if (priv->fbmem == NULL)
@@ -569,6 +992,18 @@ int up_fbinitialize(int display)
       goto errout_with_lcd;
     }
 
+#ifdef CONFIG_FB_PANDISPLAY
+  /* All frames are clear and frame 0 is about to be written to the LCD, so
+   * the LCD matches every frame.
+   */
+
+  for (i = 0; i < CONFIG_FB_NBUFFERS; i++)
+    {
+      priv->stale[i].pt2.x = -1;
+      priv->stale[i].pt2.y = -1;
+    }
+#endif
+
   /* Add the state structure to the list of framebuffer interfaces */
 
   priv->flink = g_lcdfb;
@@ -686,6 +1121,12 @@ void up_fbuninitialize(int display)
           board_lcd_uninitialize();
 #endif
 
+#ifdef CONFIG_LCD_FBUPDATE_DEFER
+          /* Stop any pending update */
+
+          (void)work_cancel(LPWORK, &priv->work);
+#endif
+
           /* Free the frame buffer allocation */
 
           kmm_free(priv->fbmem);
@@ -729,7 +1170,13 @@ void nx_notify_rectangle(FAR NX_PLANEINFOTYPE *pinfo,
 {
   FAR struct fb_planeinfo_s *fpinfo = (FAR struct fb_planeinfo_s *)pinfo;
   FAR struct lcdfb_dev_s *priv;
-  int ret;
+#ifdef CONFIG_FB_PANDISPLAY
+  struct nxgl_rect_s frame;
+  struct nxgl_rect_s local;
+  irqstate_t flags;
+  int i;
+  int j;
+#endif
 
   DEBUGASSERT(fpinfo != NULL && rect != NULL);
 
@@ -742,11 +1189,55 @@ void nx_notify_rectangle(FAR NX_PLANEINFOTYPE *pinfo,
   priv = lcdfb_find(fpinfo->display);
   if (priv != NULL)
     {
-      ret = lcdfb_update(priv, rect);
-      if (ret < 0)
+#ifdef CONFIG_FB_PANDISPLAY
+      /* The rectangle is in the coordinates of the whole framebuffer and
+       * may cover several frames.  Changes to the frame on the LCD are
+       * written out; changes to hidden frames are only remembered until
+       * the frame is selected.
+       */
+
+      frame.pt1.x = 0;
+      frame.pt2.x = priv->xres - 1;
+
+      for (i = 0; i < CONFIG_FB_NBUFFERS; i++)
         {
-          lcderr("FB update failed: %d\n", ret);
+          frame.pt1.y = i * priv->yres;
+          frame.pt2.y = frame.pt1.y + priv->yres - 1;
+
+          nxgl_rectintersect(&local, rect, &frame);
+          if (nxgl_nullrect(&local))
+            {
+              continue;
+            }
+
+          local.pt1.y -= frame.pt1.y;
+          local.pt2.y -= frame.pt1.y;
+
+          flags = enter_critical_section();
+          if (frame.pt1.y == priv->yoffset)
+            {
+              /* The LCD is about to stop matching the other frames here */
+
+              for (j = 0; j < CONFIG_FB_NBUFFERS; j++)
+                {
+                  if (j != i)
+                    {
+                      lcdfb_addstale(&priv->stale[j], &local);
+                    }
+                }
+
+              leave_critical_section(flags);
+              lcdfb_notify(priv, &local);
+            }
+          else
+            {
+              lcdfb_addstale(&priv->stale[i], &local);
+              leave_critical_section(flags);
+            }
         }
+#else
+      lcdfb_notify(priv, rect);
+#endif
     }
 }
 #endif
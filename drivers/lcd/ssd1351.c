@@ -420,11 +420,16 @@ static void ssd1351_read(FAR struct ssd1351_dev_s *priv, uint8_t cmd,
 #endif
 static void ssd1351_write(FAR struct ssd1351_dev_s *priv, uint8_t cmd,
                           FAR const uint8_t *data, size_t datlen);
+static void ssd1351_wrdata(FAR struct ssd1351_dev_s *priv,
+                           FAR const uint8_t *data, size_t datlen);
 
 /* LCD Data Transfer Methods */
 
 static int ssd1351_putrun(fb_coord_t row, fb_coord_t col,
                           FAR const uint8_t *buffer, size_t npixels);
+static int ssd1351_putarea(fb_coord_t row_start, fb_coord_t row_end,
+                           fb_coord_t col_start, fb_coord_t col_end,
+                           FAR const uint8_t *buffer, fb_coord_t stride);
 static int ssd1351_getrun(fb_coord_t row, fb_coord_t col,
                           FAR uint8_t *buffer, size_t npixels);
 
@@ -659,45 +664,105 @@ static void ssd1351_write(FAR struct ssd1351_dev_s *priv, uint8_t cmd,
 #endif
 
 /****************************************************************************
- * Name: ssd1351_setcursor
+ * Name: ssd1351_wrdata
  *
  * Description:
- *   Set the cursor position.
+ *   Send datlen more data bytes for the last command.
  *
  ****************************************************************************/
 
-static void ssd1351_setcursor(FAR struct ssd1351_dev_s *priv, uint8_t col,
-                              uint8_t row)
+#ifdef CONFIG_SSD1351_PARALLEL8BIT
+static void ssd1351_wrdata(FAR struct ssd1351_dev_s *priv,
+                           FAR const uint8_t *data, size_t datlen)
+{
+  FAR struct ssd1351_lcd_s *lcd = priv->lcd;
+  size_t i;
+
+  for (i = 0; i < datlen; i++)
+    {
+      lcd->write(lcd, data[i]);
+    }
+}
+#elif defined(CONFIG_SSD1351_SPI3WIRE)
+static void ssd1351_wrdata(FAR struct ssd1351_dev_s *priv,
+                           FAR const uint8_t *data, size_t datlen)
+{
+  size_t i;
+
+  DEBUGASSERT(datlen <= SSD1351_STRIDE);
+
+  for (i = 0; i < datlen; i++)
+    {
+      priv->rowbuffer[i] = (uint16_t)data[i] | SSD1351_SPIDATA;
+    }
+
+  (void)SPI_SNDBLOCK(priv->spi, priv->rowbuffer, datlen);
+}
+#elif defined(CONFIG_SSD1351_SPI4WIRE)
+static void ssd1351_wrdata(FAR struct ssd1351_dev_s *priv,
+                           FAR const uint8_t *data, size_t datlen)
+{
+  (void)SPI_CMDDATA(priv->spi, SPIDEV_DISPLAY(0), false);
+  (void)SPI_SNDBLOCK(priv->spi, data, datlen);
+}
+#endif
+
+/****************************************************************************
+ * Name: ssd1351_setwindow
+ *
+ * Description:
+ *   Set the window for the following RAM write and put the cursor at its
+ *   top-left corner.
+ *
+ ****************************************************************************/
+
+static void ssd1351_setwindow(FAR struct ssd1351_dev_s *priv,
+                              uint8_t col_start, uint8_t row_start,
+                              uint8_t col_end, uint8_t row_end)
 {
   uint8_t buf[2];
 
 #if defined(CONFIG_LCD_LANDSCAPE) || defined(CONFIG_LCD_RLANDSCAPE)
-  /* Set the column address to the column */
+  /* Set the column address to the columns */
 
-  buf[0] = col;
-  buf[1] = SSD1351_XRES - 1;
+  buf[0] = col_start;
+  buf[1] = col_end;
   ssd1351_write(priv, SSD1351_CMD_COLADDR, buf, 2);
 
-  /* Set the row address to the row */
+  /* Set the row address to the rows */
 
-  buf[0] = row;
-  buf[1] = SSD1351_YRES - 1;
+  buf[0] = row_start;
+  buf[1] = row_end;
   ssd1351_write(priv, SSD1351_CMD_ROWADDR, buf, 2);
 #elif defined(CONFIG_LCD_PORTRAIT) || defined(CONFIG_LCD_RPORTRAIT)
-  /* Set the column address to the row */
+  /* Set the column address to the rows */
 
-  buf[0] = row;
-  buf[1] = SSD1351_YRES - 1;
+  buf[0] = row_start;
+  buf[1] = row_end;
   ssd1351_write(priv, SSD1351_CMD_COLADDR, buf, 2);
 
-  /* Set the row address to the column */
+  /* Set the row address to the columns */
 
-  buf[0] = col;
-  buf[1] = SSD1351_XRES - 1;
+  buf[0] = col_start;
+  buf[1] = col_end;
   ssd1351_write(priv, SSD1351_CMD_ROWADDR, buf, 2);
 #endif
 }
 
+/****************************************************************************
+ * Name: ssd1351_setcursor
+ *
+ * Description:
+ *   Set the cursor position.
+ *
+ ****************************************************************************/
+
+static void ssd1351_setcursor(FAR struct ssd1351_dev_s *priv, uint8_t col,
+                              uint8_t row)
+{
+  ssd1351_setwindow(priv, col, row, SSD1351_XRES - 1, SSD1351_YRES - 1);
+}
+
 /****************************************************************************
  * Name: ssd1351_putrun
  *
@@ -744,6 +809,64 @@ static int ssd1351_putrun(fb_coord_t row, fb_coord_t col,
   return OK;
 }
 
+/****************************************************************************
+ * Name: ssd1351_putarea
+ *
+ * Description:
+ *   This method can be used to write a rectangular area to the LCD in one
+ *   windowed RAM write.
+ *
+ * Input Parameters:
+ *   row_start - Starting row to write to
+ *   row_end   - Ending row (inclusive)
+ *   col_start - Starting column to write to
+ *   col_end   - Ending column (inclusive)
+ *   buffer    - The first pixel of the area
+ *   stride    - Distance in bytes from one row of the area to the next
+ *
+ ****************************************************************************/
+
+static int ssd1351_putarea(fb_coord_t row_start, fb_coord_t row_end,
+                           fb_coord_t col_start, fb_coord_t col_end,
+                           FAR const uint8_t *buffer, fb_coord_t stride)
+{
+  FAR struct ssd1351_dev_s *priv = &g_lcddev;
+  size_t rowlen = SSD1351_PIX2BYTES(col_end - col_start + 1);
+  fb_coord_t row;
+
+  /* Sanity check */
+
+  DEBUGASSERT(buffer != NULL && ((uintptr_t)buffer & 1) == 0 &&
+              col_start >= 0 && col_start <= col_end &&
+              col_end < SSD1351_XRES && row_start >= 0 &&
+              row_start <= row_end && row_end < SSD1351_YRES);
+
+  /* Select and lock the device */
+
+  ssd1351_select(priv);
+
+  /* Limit the RAM window to the area, the controller then wraps to the
+   * next row of the area by itself.
+   */
+
+  ssd1351_setwindow(priv, col_start, row_start, col_end, row_end);
+
+  /* Write all of the data */
+
+  ssd1351_write(priv, SSD1351_CMD_RAMWRITE, buffer, rowlen);
+  for (row = row_start + 1; row <= row_end; row++)
+    {
+      buffer += stride;
+      ssd1351_wrdata(priv, buffer, rowlen);
+    }
+
+  /* Unlock and de-select the device */
+
+  ssd1351_deselect(priv);
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: ssd1351_getrun
  *
@@ -833,10 +956,11 @@ static int ssd1351_getplaneinfo(FAR struct lcd_dev_s *dev,
 
   DEBUGASSERT(dev != NULL && pinfo != NULL && planeno == 0);
 
-  pinfo->putrun = ssd1351_putrun;
-  pinfo->getrun = ssd1351_getrun;
-  pinfo->buffer = (uint8_t *)priv->runbuffer;
-  pinfo->bpp    = SSD1351_BPP;
+  pinfo->putrun  = ssd1351_putrun;
+  pinfo->putarea = ssd1351_putarea;
+  pinfo->getrun  = ssd1351_getrun;
+  pinfo->buffer  = (uint8_t *)priv->runbuffer;
+  pinfo->bpp     = SSD1351_BPP;
 
   ginfo("planeno: %u bpp: %u\n", planeno, pinfo->bpp);
   return OK;
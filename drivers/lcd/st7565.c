@@ -217,6 +217,9 @@ static inline int st7565_backlight(FAR struct st7565_dev_s *priv, int level);
 
 static int st7565_putrun(fb_coord_t row, fb_coord_t col,
                          FAR const uint8_t * buffer, size_t npixels);
+static int st7565_putarea(fb_coord_t row_start, fb_coord_t row_end,
+                          fb_coord_t col_start, fb_coord_t col_end,
+                          FAR const uint8_t *buffer, fb_coord_t stride);
 static int st7565_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t * buffer,
                          size_t npixels);
 
@@ -283,6 +286,7 @@ static const struct lcd_planeinfo_s g_planeinfo =
 {
   .putrun  = st7565_putrun,           /* Put a run into LCD memory */
   .getrun  = st7565_getrun,           /* Get a run from LCD memory */
+  .putarea = st7565_putarea,          /* Put an area into LCD memory */
   .buffer  = (uint8_t *) g_runbuffer, /* Run scratch buffer */
   .bpp     = ST7565_BPP,              /* Bits-per-pixel */
 };
@@ -430,28 +434,18 @@ static inline int st7565_backlight(FAR struct st7565_dev_s *priv, int level)
 }
 
 /**************************************************************************************
- * Name:  st7565_putrun
+ * Name:  st7565_setrun
  *
  * Description:
- *   This method can be used to write a partial raster line to the LCD:
- *
- *   row     - Starting row to write to (range: 0 <= row < yres)
- *   col     - Starting column to write to (range: 0 <= col <= xres-npixels)
- *   buffer  - The buffer containing the run to be written to the LCD
- *   npixels - The number of pixels to write to the LCD
- *             (range: 0 < npixels <= xres-col)
+ *   Copy a partial raster line into the shadow frame buffer (only).  Returns the
+ *   number of pixels that are on the display.
  *
  **************************************************************************************/
 
-static int st7565_putrun(fb_coord_t row, fb_coord_t col,
-                         FAR const uint8_t * buffer, size_t npixels)
+static int st7565_setrun(FAR struct st7565_dev_s *priv, fb_coord_t row,
+                         fb_coord_t col, FAR const uint8_t *buffer,
+                         size_t npixels)
 {
-  /* Because of this line of code, we will only be able to support a single
-   * ST7565 device.
-   */
-
-  FAR struct st7565_dev_s *priv = &g_st7565dev;
-  FAR uint8_t *fbptr;
   FAR uint8_t *ptr;
   uint8_t fbmask;
   uint8_t page;
@@ -459,9 +453,6 @@ static int st7565_putrun(fb_coord_t row, fb_coord_t col,
   uint8_t i;
   int pixlen;
 
-  ginfo("row: %d col: %d npixels: %d\n", row, col, npixels);
-  DEBUGASSERT(buffer);
-
   /* Clip the run to the display */
 
   pixlen = npixels;
@@ -472,9 +463,9 @@ static int st7565_putrun(fb_coord_t row, fb_coord_t col,
 
   /* Verify that some portion of the run remains on the display */
 
-  if (pixlen <= 0 || row > ST7565_YRES)
+  if (pixlen <= 0 || row >= ST7565_YRES)
     {
-      return OK;
+      return 0;
     }
 
   /* Get the page number.  The range of 64 lines is divided up into eight pages
@@ -505,8 +496,7 @@ static int st7565_putrun(fb_coord_t row, fb_coord_t col,
    */
 
   fbmask = 1 << (row & 7);
-  fbptr = &priv->fb[page * ST7565_XRES + col];
-  ptr = fbptr;
+  ptr = &priv->fb[page * ST7565_XRES + col];
 #ifdef CONFIG_LCD_PACKEDMSFIRST
   usrmask = MS_BIT;
 #else
@@ -551,10 +541,21 @@ static int st7565_putrun(fb_coord_t row, fb_coord_t col,
 #endif
     }
 
-  /* Select and lock the device */
+  return pixlen;
+}
 
-  st7565_select(priv);
+/**************************************************************************************
+ * Name:  st7565_sendpage
+ *
+ * Description:
+ *   Write part of one page of the shadow frame buffer to the LCD.  The device must
+ *   be selected.
+ *
+ **************************************************************************************/
 
+static void st7565_sendpage(FAR struct st7565_dev_s *priv, uint8_t page,
+                            fb_coord_t col, int npixels)
+{
   /* Select command transfer */
 
   st7565_cmddata(priv, true);
@@ -571,9 +572,115 @@ static int st7565_putrun(fb_coord_t row, fb_coord_t col,
 
   /* Then transfer all of the data */
 
-  (void)st7565_send_data_buf(priv, fbptr, pixlen);
+  (void)st7565_send_data_buf(priv, &priv->fb[page * ST7565_XRES + col], npixels);
+}
 
-  /* Unlock and de-select the device */
+/**************************************************************************************
+ * Name:  st7565_putrun
+ *
+ * Description:
+ *   This method can be used to write a partial raster line to the LCD:
+ *
+ *   row     - Starting row to write to (range: 0 <= row < yres)
+ *   col     - Starting column to write to (range: 0 <= col <= xres-npixels)
+ *   buffer  - The buffer containing the run to be written to the LCD
+ *   npixels - The number of pixels to write to the LCD
+ *             (range: 0 < npixels <= xres-col)
+ *
+ **************************************************************************************/
+
+static int st7565_putrun(fb_coord_t row, fb_coord_t col,
+                         FAR const uint8_t * buffer, size_t npixels)
+{
+  /* Because of this line of code, we will only be able to support a single
+   * ST7565 device.
+   */
+
+  FAR struct st7565_dev_s *priv = &g_st7565dev;
+  int pixlen;
+
+  ginfo("row: %d col: %d npixels: %d\n", row, col, npixels);
+  DEBUGASSERT(buffer);
+
+  /* Update the shadow frame buffer */
+
+  pixlen = st7565_setrun(priv, row, col, buffer, npixels);
+  if (pixlen <= 0)
+    {
+      return OK;
+    }
+
+  /* Select and lock the device, send the page, then unlock and de-select */
+
+  st7565_select(priv);
+  st7565_sendpage(priv, row >> 3, col, pixlen);
+  st7565_deselect(priv);
+
+  return OK;
+}
+
+/**************************************************************************************
+ * Name:  st7565_putarea
+ *
+ * Description:
+ *   Write a rectangular area to the LCD.  All rows are merged into the shadow frame
+ *   buffer first, then each page covered by the area is sent once; putrun() would
+ *   send each page up to eight times.
+ *
+ *   row_start - Starting row to write to
+ *   row_end   - Ending row (inclusive)
+ *   col_start - Starting column to write to
+ *   col_end   - Ending column (inclusive)
+ *   buffer    - The first pixel of the area
+ *   stride    - Distance in bytes from one row of the area to the next
+ *
+ **************************************************************************************/
+
+static int st7565_putarea(fb_coord_t row_start, fb_coord_t row_end,
+                          fb_coord_t col_start, fb_coord_t col_end,
+                          FAR const uint8_t *buffer, fb_coord_t stride)
+{
+  FAR struct st7565_dev_s *priv = &g_st7565dev;
+  fb_coord_t row;
+  uint8_t page;
+  int pixlen = 0;
+
+  ginfo("rows: %d-%d cols: %d-%d\n", row_start, row_end, col_start, col_end);
+  DEBUGASSERT(buffer);
+
+  if (row_end >= ST7565_YRES)
+    {
+      row_end = ST7565_YRES - 1;
+    }
+
+  if (row_end < row_start || col_end < col_start)
+    {
+      return OK;
+    }
+
+  /* Update the shadow frame buffer */
+
+  for (row = row_start; row <= row_end; row++)
+    {
+      pixlen = st7565_setrun(priv, row, col_start, buffer,
+                             col_end - col_start + 1);
+      buffer += stride;
+    }
+
+  if (pixlen <= 0)
+    {
+      return OK;
+    }
+
+  /* Select and lock the device, send each page once, then unlock and
+   * de-select
+   */
+
+  st7565_select(priv);
+  for (page = row_start >> 3; page <= (row_end >> 3); page++)
+    {
+      st7565_sendpage(priv, page, col_start, pixlen);
+    }
 
   st7565_deselect(priv);
 
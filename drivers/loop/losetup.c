@@ -60,6 +60,8 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/loop.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/drivers/rwbuffer.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -68,6 +70,12 @@
 #define loop_semgive(d) nxsem_post(&(d)->sem)  /* To match loop_semtake */
 #define MAX_OPENCNT     (255)                  /* Limit of uint8_t */
 
+/* Check if read/write buffer support is needed */
+
+#if defined(CONFIG_LOOP_READAHEAD) || defined(CONFIG_LOOP_WRITEBUFFER)
+#  define LOOP_HAVE_RWBUFFER 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -83,6 +91,9 @@ struct loop_struct_s
   bool         writeenabled; /* true: can write to device */
 #endif
   struct file  devfile;      /* File struct of char device/file */
+#ifdef LOOP_HAVE_RWBUFFER
+  struct rwbuffer_s rwb;     /* Read-ahead/write buffer support */
+#endif
 };
 
 /****************************************************************************
@@ -92,6 +103,12 @@ struct loop_struct_s
 static int     loop_semtake(FAR struct loop_struct_s *dev);
 static int     loop_open(FAR struct inode *inode);
 static int     loop_close(FAR struct inode *inode);
+static ssize_t loop_reload(FAR void *priv, FAR uint8_t *buffer,
+                           off_t startblock, size_t nblocks);
+#ifdef CONFIG_FS_WRITABLE
+static ssize_t loop_flush(FAR void *priv, FAR const uint8_t *buffer,
+                          off_t startblock, size_t nblocks);
+#endif
 static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
                        size_t start_sector, unsigned int nsectors);
 #ifdef CONFIG_FS_WRITABLE
@@ -101,6 +118,10 @@ static ssize_t loop_write(FAR struct inode *inode,
 #endif
 static int     loop_geometry(FAR struct inode *inode,
                              FAR struct geometry *geometry);
+#ifdef CONFIG_LOOP_WRITEBUFFER
+static int     loop_ioctl(FAR struct inode *inode, int cmd,
+                          unsigned long arg);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -117,7 +138,11 @@ static const struct block_operations g_bops =
   NULL,          /* write */
 #endif
   loop_geometry, /* geometry */
+#ifdef CONFIG_LOOP_WRITEBUFFER
+  loop_ioctl     /* ioctl */
+#else
   NULL           /* ioctl */
+#endif
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL         /* unlink */
 #endif
@@ -194,6 +219,9 @@ static int loop_open(FAR struct inode *inode)
 static int loop_close(FAR struct inode *inode)
 {
   FAR struct loop_struct_s *dev;
+#ifdef CONFIG_LOOP_WRITEBUFFER
+  bool flush;
+#endif
   int ret;
 
   DEBUGASSERT(inode && inode->i_private);
@@ -215,111 +243,229 @@ static int loop_close(FAR struct inode *inode)
           dev->opencnt--;
         }
 
+#ifdef CONFIG_LOOP_WRITEBUFFER
+      flush = (ret == OK && dev->opencnt == 0);
+#endif
       loop_semgive(dev);
+
+#ifdef CONFIG_LOOP_WRITEBUFFER
+      /* Make sure that buffered data reaches the backing file when the
+       * last reference is closed.  The flush takes the semaphore itself.
+       */
+
+      if (flush)
+        {
+          ret = rwb_flush(&dev->rwb);
+        }
+#endif
     }
 
   return ret;
 }
 
 /****************************************************************************
- * Name: loop_read
+ * Name: loop_reload
  *
- * Description:  Read the specified number of sectors
+ * Description:
+ *   Read sectors from the backing file.  This is the read-ahead reload
+ *   callout when read-ahead buffering is enabled.  A request for several
+ *   sectors is satisfied with a single read of the backing file whenever
+ *   possible.
  *
  ****************************************************************************/
 
-static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
-                         size_t start_sector, unsigned int nsectors)
+static ssize_t loop_reload(FAR void *priv, FAR uint8_t *buffer,
+                           off_t startblock, size_t nblocks)
 {
-  FAR struct loop_struct_s *dev;
+  FAR struct loop_struct_s *dev = (FAR struct loop_struct_s *)priv;
   ssize_t nbytesread;
+  size_t remaining;
   off_t offset;
   off_t ret;
 
-  DEBUGASSERT(inode && inode->i_private);
-  dev = (FAR struct loop_struct_s *)inode->i_private;
+  /* The seek and read must not be separated by another transfer, which
+   * may be a buffer flush running on the worker thread.
+   */
 
-  if (start_sector + nsectors > dev->nsectors)
+  ret = nxsem_wait_uninterruptible(&dev->sem);
+  if (ret < 0)
     {
-      ferr("ERROR: Read past end of file\n");
-      return -EIO;
+      return ret;
     }
 
   /* Calculate the offset to read the sectors and seek to the position */
 
-  offset = start_sector * dev->sectsize + dev->offset;
+  offset = startblock * dev->sectsize + dev->offset;
   ret = file_seek(&dev->devfile, offset, SEEK_SET);
   if (ret < 0)
     {
       ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
+      loop_semgive(dev);
       return -EIO;
     }
 
-  /* Then read the requested number of sectors from that position */
+  /* Then read the requested number of sectors from that position.  The
+   * backing file may return less than requested, so continue until all
+   * of the data has been read or the end of the file is reached.
+   */
 
-  do
+  remaining = nblocks * dev->sectsize;
+  while (remaining > 0)
     {
-      nbytesread = file_read(&dev->devfile, buffer,
-                             nsectors * dev->sectsize);
-      if (nbytesread < 0 && nbytesread != -EINTR)
+      nbytesread = file_read(&dev->devfile, buffer, remaining);
+      if (nbytesread < 0)
         {
-          ferr("ERROR: Read failed: %d\n", nbytesread);
-          return (int)nbytesread;
+          if (nbytesread == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Read failed: %d\n", (int)nbytesread);
+          loop_semgive(dev);
+          return nbytesread;
         }
+      else if (nbytesread == 0)
+        {
+          break;
+        }
+
+      buffer    += nbytesread;
+      remaining -= nbytesread;
     }
-  while (nbytesread < 0);
+
+  loop_semgive(dev);
 
   /* Return the number of sectors read */
 
-  return nbytesread / dev->sectsize;
+  return nblocks - (remaining + dev->sectsize - 1) / dev->sectsize;
 }
 
 /****************************************************************************
- * Name: loop_write
+ * Name: loop_flush
  *
- * Description: Write the specified number of sectors
+ * Description:
+ *   Write sectors to the backing file.  This is the write buffer flush
+ *   callout when write buffering is enabled.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_FS_WRITABLE
-static ssize_t loop_write(FAR struct inode *inode,
-                          FAR const unsigned char *buffer,
-                          size_t start_sector, unsigned int nsectors)
+static ssize_t loop_flush(FAR void *priv, FAR const uint8_t *buffer,
+                          off_t startblock, size_t nblocks)
 {
-  FAR struct loop_struct_s *dev;
+  FAR struct loop_struct_s *dev = (FAR struct loop_struct_s *)priv;
   ssize_t nbyteswritten;
+  size_t remaining;
   off_t offset;
   off_t ret;
 
-  DEBUGASSERT(inode && inode->i_private);
-  dev = (FAR struct loop_struct_s *)inode->i_private;
+  ret = nxsem_wait_uninterruptible(&dev->sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
   /* Calculate the offset to write the sectors and seek to the position */
 
-  offset = start_sector * dev->sectsize + dev->offset;
+  offset = startblock * dev->sectsize + dev->offset;
   ret = file_seek(&dev->devfile, offset, SEEK_SET);
   if (ret < 0)
     {
       ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
+      loop_semgive(dev);
+      return -EIO;
     }
 
   /* Then write the requested number of sectors to that position */
 
-  do
+  remaining = nblocks * dev->sectsize;
+  while (remaining > 0)
     {
-      nbyteswritten = file_write(&dev->devfile, buffer,
-                                 nsectors * dev->sectsize);
-      if (nbyteswritten < 0 && nbyteswritten != -EINTR)
+      nbyteswritten = file_write(&dev->devfile, buffer, remaining);
+      if (nbyteswritten < 0)
         {
-          ferr("ERROR: nx_write failed: %d\n", nbyteswritten);
+          if (nbyteswritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: file_write failed: %d\n", (int)nbyteswritten);
+          loop_semgive(dev);
           return nbyteswritten;
         }
+      else if (nbyteswritten == 0)
+        {
+          break;
+        }
+
+      buffer    += nbyteswritten;
+      remaining -= nbyteswritten;
     }
-  while (nbyteswritten < 0);
+
+  loop_semgive(dev);
 
   /* Return the number of sectors written */
 
-  return nbyteswritten / dev->sectsize;
+  return nblocks - (remaining + dev->sectsize - 1) / dev->sectsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: loop_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         size_t start_sector, unsigned int nsectors)
+{
+  FAR struct loop_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      ferr("ERROR: Read past end of file\n");
+      return -EIO;
+    }
+
+#ifdef CONFIG_LOOP_READAHEAD
+  return rwb_read(&dev->rwb, start_sector, nsectors, buffer);
+#else
+  return loop_reload(dev, buffer, start_sector, nsectors);
+#endif
+}
+
+/****************************************************************************
+ * Name: loop_write
+ *
+ * Description: Write the specified number of sectors
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static ssize_t loop_write(FAR struct inode *inode,
+                          FAR const unsigned char *buffer,
+                          size_t start_sector, unsigned int nsectors)
+{
+  FAR struct loop_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      ferr("ERROR: Write past end of file\n");
+      return -EIO;
+    }
+
+#ifdef LOOP_HAVE_RWBUFFER
+  return rwb_write(&dev->rwb, start_sector, nsectors, buffer);
+#else
+  return loop_flush(dev, buffer, start_sector, nsectors);
+#endif
 }
 #endif
 
@@ -354,6 +500,30 @@ static int loop_geometry(FAR struct inode *inode,
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: loop_ioctl
+ *
+ * Description: Flush the write buffer on BIOC_FLUSH
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LOOP_WRITEBUFFER
+static int loop_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  FAR struct loop_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  if (cmd == BIOC_FLUSH)
+    {
+      return rwb_flush(&dev->rwb);
+    }
+
+  return -ENOTTY;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -446,18 +616,53 @@ int losetup(FAR const char *devname, FAR const char *filename,
         }
     }
 
+#ifdef LOOP_HAVE_RWBUFFER
+  /* Configure read-ahead/write buffering */
+
+  dev->rwb.blocksize   = sectsize;
+  dev->rwb.nblocks     = dev->nsectors;
+  dev->rwb.dev         = (FAR void *)dev;
+#ifdef CONFIG_FS_WRITABLE
+  dev->rwb.wrflush     = loop_flush;
+#endif
+  dev->rwb.rhreload    = loop_reload;
+
+#ifdef CONFIG_LOOP_WRITEBUFFER
+  if (dev->writeenabled)
+    {
+      dev->rwb.wrmaxblocks = CONFIG_LOOP_NBUFFERED;
+    }
+#endif
+
+#ifdef CONFIG_LOOP_READAHEAD
+  dev->rwb.rhmaxblocks = CONFIG_LOOP_NBUFFERED;
+#endif
+
+  ret = rwb_initialize(&dev->rwb);
+  if (ret < 0)
+    {
+      ferr("ERROR: rwb_initialize failed: %d\n", ret);
+      goto errout_with_file;
+    }
+#endif
+
   /* Inode private data will be reference to the loop device structure */
 
   ret = register_blockdriver(devname, &g_bops, 0, dev);
   if (ret < 0)
     {
       ferr("ERROR: register_blockdriver failed: %d\n", -ret);
-      goto errout_with_file;
+      goto errout_with_buffers;
     }
 
   return OK;
 
+errout_with_buffers:
+#ifdef LOOP_HAVE_RWBUFFER
+  rwb_uninitialize(&dev->rwb);
+
 errout_with_file:
+#endif
   file_close(&dev->devfile);
 
 errout_with_dev:
@@ -517,6 +722,15 @@ int loteardown(FAR const char *devname)
 
   ret = unregister_blockdriver(devname);
 
+#ifdef LOOP_HAVE_RWBUFFER
+  /* Write any buffered data back to the file and release the buffers */
+
+#ifdef CONFIG_LOOP_WRITEBUFFER
+  (void)rwb_flush(&dev->rwb);
+#endif
+  rwb_uninitialize(&dev->rwb);
+#endif
+
   /* Release the device structure */
 
   if (dev->devfile.f_inode != NULL)
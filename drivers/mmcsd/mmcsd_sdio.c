@@ -96,6 +96,7 @@
  */
 
 #define MMCSD_SCR_DATADELAY     (100)      /* Wait up to 100MS to get SCR */
+#define MMCSD_SWITCH_DATADELAY  (100)      /* Wait up to 100MS to get switch status */
 #define MMCSD_BLOCK_RDATADELAY  (100)      /* Wait up to 100MS to get one data block */
 #define MMCSD_BLOCK_WDATADELAY  (230)      /* Wait up to 230MS to write one data block */
 
@@ -125,6 +126,9 @@ struct mmcsd_state_s
 #ifdef CONFIG_SDIO_DMA
   uint8_t dma:1;                   /* true: hardware supports DMA */
 #endif
+  uint8_t highspeed:1;             /* true: High speed (SDR25) mode selected */
+  uint8_t cmd23:1;                 /* true: Card supports CMD23 (from SCR) */
+  uint8_t sdspec:4;                /* SD physical layer version (from SCR) */
 
   uint8_t mode:2;                  /* (See MMCSDMODE_* definitions) */
   uint8_t type:4;                  /* Card type (See MMCSD_CARDTYPE_* definitions) */
@@ -243,6 +247,11 @@ static int     mmcsd_ioctl(FAR struct inode *inode, int cmd,
 
 static void    mmcsd_mediachange(FAR void *arg);
 static int     mmcsd_widebus(FAR struct mmcsd_state_s *priv);
+#ifdef CONFIG_MMCSD_HIGHSPEED
+static int     mmcsd_switchfunc(FAR struct mmcsd_state_s *priv,
+                 uint32_t arg, FAR uint8_t *status);
+static int     mmcsd_highspeed(FAR struct mmcsd_state_s *priv);
+#endif
 #ifdef CONFIG_MMCSD_MMCSUPPORT
 static int     mmcsd_mmcinitialize(FAR struct mmcsd_state_s *priv);
 #endif
@@ -933,8 +942,12 @@ struct mmcsd_scr_s decoded;
 
 #ifdef CONFIG_ENDIAN_BIG  /* Card transfers SCR in big-endian order */
   priv->buswidth     = (scr[0] >> 16) & 15;
+  priv->sdspec       = (scr[0] >> 24) & 15;
+  priv->cmd23        = (scr[0] & MMCSD_SCR_CMDSUPPORT_CMD23) != 0;
 #else
   priv->buswidth     = (scr[0] >> 8) & 15;
+  priv->sdspec       =  scr[0]       & 15;
+  priv->cmd23        = ((scr[0] >> 24) & MMCSD_SCR_CMDSUPPORT_CMD23) != 0;
 #endif
 
 #ifdef CONFIG_DEBUG_FS_INFO
@@ -968,6 +981,7 @@ struct mmcsd_scr_s decoded;
         decoded.scrversion, decoded.sdversion);
   finfo("  DATA_STATE_AFTER_ERASE: %d SD_SECURITY: %d SD_BUS_WIDTHS: %x\n",
         decoded.erasestate, decoded.security, decoded.buswidth);
+  finfo("  CMD23 support: %d\n", priv->cmd23);
   finfo("  Manufacturing data: %08x\n",
         decoded.mfgdata);
 #endif
@@ -1528,6 +1542,24 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       SDIO_RECVSETUP(priv->dev, buffer, nbytes);
     }
 
+#ifdef CONFIG_MMCSD_CMD23
+  /* If the card supports it, send CMD23, SET_BLOCK_COUNT, so that the card
+   * ends the transfer itself after nblocks.
+   */
+
+  if (priv->cmd23)
+    {
+      mmcsd_sendcmdpoll(priv, MMC_CMD23, nblocks);
+      ret = mmcsd_recvR1(priv, MMC_CMD23);
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_recvR1 for CMD23 failed: %d\n", ret);
+          SDIO_CANCEL(priv->dev);
+          return ret;
+        }
+    }
+#endif
+
   /* Send CMD18, READ_MULT_BLOCK: Read a block of the size selected by
    * the mmcsd_setblocklen() and verify that good R1 status is returned
    */
@@ -1548,12 +1580,24 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
   if (ret != OK)
     {
       ferr("ERROR: CMD18 transfer failed: %d\n", ret);
+#ifdef CONFIG_MMCSD_CMD23
+      if (priv->cmd23)
+        {
+          /* Return the card to the transfer state */
+
+          (void)mmcsd_stoptransmission(priv);
+        }
+#endif
       return ret;
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION (unless the transfer length was pre-defined) */
 
+#ifdef CONFIG_MMCSD_CMD23
+  ret = priv->cmd23 ? OK : mmcsd_stoptransmission(priv);
+#else
   ret = mmcsd_stoptransmission(priv);
+#endif
 #ifdef CONFIG_SDIO_DMA
   SDIO_DMADELYDINVLDT(priv->dev, buffer, priv->blocksize * nblocks);
 #endif
@@ -1885,6 +1929,31 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
+#ifdef CONFIG_MMCSD_CMD23
+  /* If the card supports it, send CMD23, SET_BLOCK_COUNT, just before
+   * CMD25 (WRITE_MULTIPLE_BLOCK).  The card then knows the full length of
+   * the write in advance and ends the transfer itself.
+   */
+
+  if (priv->cmd23)
+    {
+      mmcsd_sendcmdpoll(priv, MMC_CMD23, nblocks);
+      ret = mmcsd_recvR1(priv, MMC_CMD23);
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_recvR1 for CMD23 failed: %d\n", ret);
+          return ret;
+        }
+    }
+
+  /* Otherwise, if this is an SD card, then send ACMD23 (SET_WR_BLK_ERASE_COUNT)
+   * just before sending CMD25 (WRITE_MULTIPLE_BLOCK).  This sets the number of
+   * write blocks to be pre-erased and might make the following multiple block
+   * write command faster.
+   */
+
+  else if (IS_SD(priv->type))
+#else
   /* If this is an SD card, then send ACMD23 (SET_WR_BLK_ERASE_COUNT) just
    * before sending CMD25 (WRITE_MULTIPLE_BLOCK).  This sets the number of
    * write blocks to be pre-erased and might make the following multiple block
@@ -1892,6 +1961,7 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
    */
 
   if (IS_SD(priv->type))
+#endif
     {
       /* Send CMD55, APP_CMD, a verify that good R1 status is returned */
 
@@ -1995,7 +2065,16 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
        */
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION.  With a pre-defined block count, this is only
+   * needed to recover from a failed transfer.
+   */
+
+#ifdef CONFIG_MMCSD_CMD23
+  if (priv->cmd23 && evret == OK)
+    {
+      return nblocks;
+    }
+#endif
 
   ret = mmcsd_stoptransmission(priv);
   if (evret != OK)
@@ -2543,6 +2622,130 @@ static int mmcsd_widebus(FAR struct mmcsd_state_s *priv)
   return -ENOSYS;
 }
 
+/****************************************************************************
+ * Name: mmcsd_switchfunc
+ *
+ * Description:
+ *   Send CMD6 (SWITCH_FUNC) with the provided argument and receive the
+ *   64-byte switch function status.
+ *
+ * Returned Value:
+ *   OK on success; a negated ernno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MMCSD_HIGHSPEED
+static int mmcsd_switchfunc(FAR struct mmcsd_state_s *priv, uint32_t arg,
+                            FAR uint8_t *status)
+{
+  int ret;
+
+  /* Set Block Size To 64 Bytes */
+
+  ret = mmcsd_setblocklen(priv, SD_SWITCH_STATUS_SIZE);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_setblocklen failed: %d\n", ret);
+      return ret;
+    }
+
+  /* Setup up to receive data with interrupt mode */
+
+  SDIO_BLOCKSETUP(priv->dev, SD_SWITCH_STATUS_SIZE, 1);
+  SDIO_RECVSETUP(priv->dev, status, SD_SWITCH_STATUS_SIZE);
+
+  (void)SDIO_WAITENABLE(priv->dev,
+                        SDIOWAIT_TRANSFERDONE | SDIOWAIT_TIMEOUT |
+                        SDIOWAIT_ERROR);
+
+  /* Send CMD6 SWITCH_FUNC to start data receipt */
+
+  mmcsd_sendcmdpoll(priv, MMCSD_CMD6, arg);
+  ret = mmcsd_recvR1(priv, MMCSD_CMD6);
+  if (ret != OK)
+    {
+      ferr("ERROR: RECVR1 for CMD6 failed: %d\n", ret);
+      SDIO_CANCEL(priv->dev);
+      return ret;
+    }
+
+  /* Wait for data to be transferred */
+
+  ret = mmcsd_eventwait(priv, SDIOWAIT_TIMEOUT | SDIOWAIT_ERROR,
+                        MMCSD_SWITCH_DATADELAY);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_eventwait for CMD6 DATA failed: %d\n", ret);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: mmcsd_highspeed
+ *
+ * Description:
+ *  Wide bus operation has been selected on an SD card.  If both the card
+ *  (SD version 1.10 or later, reporting the high speed function in the
+ *  CMD6 switch status) and the SDIO driver (SDIO_CAPS_HIGHSPEED) support
+ *  it, switch the card to high speed (SDR25) mode and raise the clock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MMCSD_HIGHSPEED
+static int mmcsd_highspeed(FAR struct mmcsd_state_s *priv)
+{
+  uint32_t buffer[SD_SWITCH_STATUS_SIZE / sizeof(uint32_t)];
+  FAR uint8_t *status = (FAR uint8_t *)buffer;
+  int ret;
+
+  if ((priv->caps & SDIO_CAPS_HIGHSPEED) == 0 || priv->sdspec < 1)
+    {
+      return -ENOSYS;
+    }
+
+  /* Check if the card supports the high speed function */
+
+  ret = mmcsd_switchfunc(priv, SD_CMD6_MODE_CHECK | SD_CMD6_GRP1_HIGHSPEED,
+                         status);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  if ((SD_SWITCH_GRP1SUPPORT(status) & (1 << SD_CMD6_GRP1_HIGHSPEED)) == 0)
+    {
+      return -ENOSYS;
+    }
+
+  /* Then switch to it */
+
+  ret = mmcsd_switchfunc(priv, SD_CMD6_MODE_SWITCH | SD_CMD6_GRP1_HIGHSPEED,
+                         status);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  if (SD_SWITCH_GRP1RESULT(status) != SD_CMD6_GRP1_HIGHSPEED)
+    {
+      return -EIO;
+    }
+
+  /* The card is in high speed mode after the switch status has been
+   * received.  Configure the SDIO peripheral.
+   */
+
+  finfo("High speed mode selected\n");
+  priv->highspeed = true;
+
+  SDIO_CLOCK(priv->dev, CLOCK_SD_TRANSFER_4BIT_HS);
+  up_udelay(MMCSD_CLK_DELAY);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_mmcinitialize
  *
@@ -2777,11 +2980,21 @@ static int mmcsd_sdinitialize(FAR struct mmcsd_state_s *priv)
       ferr("ERROR: Failed to set wide bus operation: %d\n", ret);
     }
 
-  /* TODO: If wide-bus selected, then send CMD6 to see if the card supports
-   * high speed mode.  A new SDIO method will be needed to set high speed
-   * mode.
+#ifdef CONFIG_MMCSD_HIGHSPEED
+  /* If wide-bus selected, then send CMD6 to see if the card supports
+   * high speed mode.
    */
 
+  else
+    {
+      ret = mmcsd_highspeed(priv);
+      if (ret != OK)
+        {
+          fwarn("WARNING: High speed mode not selected: %d\n", ret);
+        }
+    }
+#endif
+
   return OK;
 }
 
@@ -3191,6 +3404,8 @@ static int mmcsd_removed(FAR struct mmcsd_state_s *priv)
 
   SDIO_WIDEBUS(priv->dev, false);
   priv->widebus      = false;
+  priv->highspeed    = false;
+  priv->cmd23        = false;
 
   /* Disable clocking to the card */
 
@@ -180,6 +180,19 @@
 #define MMCSD_SCR_BUSWIDTH_4BIT     (4)
 #define MMCSD_SCR_BUSWIDTH_8BIT     (8)
 
+#define MMCSD_SCR_CMDSUPPORT_CMD20  (1)                    /* Speed class control */
+#define MMCSD_SCR_CMDSUPPORT_CMD23  (2)                    /* Set block count */
+
+/* CMD6 SWITCH_FUNC argument and 512-bit switch function status */
+
+#define SD_CMD6_MODE_CHECK          ((uint32_t)0x00fffff0) /* Check function, all groups "no change" */
+#define SD_CMD6_MODE_SWITCH         ((uint32_t)0x80fffff0) /* Switch function, all groups "no change" */
+#define SD_CMD6_GRP1_HIGHSPEED      (1)                    /* Group 1 (access mode), function 1 */
+
+#define SD_SWITCH_STATUS_SIZE       (64)                   /* Size of the switch function status */
+#define SD_SWITCH_GRP1SUPPORT(s)    ((s)[13])              /* Bits 407:400 group 1 functions supported */
+#define SD_SWITCH_GRP1RESULT(s)     ((s)[16] & 15)         /* Bits 379:376 group 1 function selected */
+
 /* Last 4 bytes of the 48-bit R7 response */
 
 #define MMCSD_R7VERSION_SHIFT       (28)                   /* Bits 28-31: Command version number */
@@ -473,7 +473,9 @@ static uint32_t mmcsd_sendcmd(FAR struct mmcsd_slot_s *slot,
 {
   FAR struct spi_dev_s *spi = slot->spi;
   uint32_t result;
+  uint8_t frame[7];
   uint8_t response = 0xff;
+  int nframe;
   int ret;
   int i;
 
@@ -489,32 +491,37 @@ static uint32_t mmcsd_sendcmd(FAR struct mmcsd_slot_s *slot,
       return ret;
     }
 
-  /* Send command code */
-
-  SPI_SEND(spi, cmd->cmd);
-
-  /* Send command's arguments (should be zero if there are no arguments) */
+  /* Format the command code and the command's arguments (should be zero if
+   * there are no arguments).
+   */
 
-  SPI_SEND(spi, (arg >> 24) & 0xff);
-  SPI_SEND(spi, (arg >> 16) & 0xff);
-  SPI_SEND(spi, (arg >> 8) & 0xff);
-  SPI_SEND(spi, arg & 0xff);
+  frame[0] = cmd->cmd;
+  frame[1] = (arg >> 24) & 0xff;
+  frame[2] = (arg >> 16) & 0xff;
+  frame[3] = (arg >> 8) & 0xff;
+  frame[4] = arg & 0xff;
 
-  /* Send CRC if needed.  The SPI interface is initialized in non-protected
+  /* Add CRC if needed.  The SPI interface is initialized in non-protected
    * mode.  However, the reset command (CMD0) and CMD8 are received by the
    * card while it is still in SD mode and, therefore, must have a valid
    * CRC field.
    */
 
-  SPI_SEND(spi, cmd->chksum);
+  frame[5] = cmd->chksum;
+  nframe   = 6;
 
   /* Skip stuff byte on CMD12 */
 
   if (cmd->cmd == CMD12)
     {
-      SPI_SEND(spi, 0xff);
+      frame[6] = 0xff;
+      nframe   = 7;
     }
 
+  /* Send the complete command frame as a single block transfer */
+
+  (void)SPI_SNDBLOCK(spi, frame, nframe);
+
   /* Get the response to the command.  A valid response will have bit7=0.
    * Usually, the non-response is 0xff, but I have seen 0xc0 too.
    */
@@ -925,15 +932,13 @@ static int mmcsd_getcardinfo(FAR struct mmcsd_slot_s *slot, uint8_t *buffer,
         }
       else if (response == MMCSD_SPIDT_STARTBLKSNGL)
         {
-          for (i = 0; i < 16; ++i)
-            {
-              *buffer++ = SPI_SEND(spi, 0xff);
-            }
+          uint8_t crc[2];
+
+          SPI_RECVBLOCK(spi, buffer, 16);
 
           /* CRC receive */
 
-          SPI_SEND(spi, 0xff);
-          SPI_SEND(spi, 0xff);
+          SPI_RECVBLOCK(spi, crc, 2);
           return OK;
         }
     }
@@ -971,14 +976,15 @@ static int mmcsd_recvblock(FAR struct mmcsd_slot_s *slot, uint8_t *buffer,
 
   if (token == MMCSD_SPIDT_STARTBLKSNGL)
     {
+      uint8_t crc[2];
+
       /* Receive the block */
 
       SPI_RECVBLOCK(spi, buffer, nbytes);
 
       /* Discard the CRC */
 
-      SPI_SEND(spi, 0xff);
-      SPI_SEND(spi, 0xff);
+      SPI_RECVBLOCK(spi, crc, 2);
       return OK;
     }
 
@@ -999,7 +1005,8 @@ static int mmcsd_xmitblock(FAR struct mmcsd_slot_s *slot,
                            uint8_t token)
 {
   FAR struct spi_dev_s *spi = slot->spi;
-  uint8_t response;
+  uint8_t header[2];
+  uint8_t response[3];
 
   /* Start the block transfer:
    * 1. 0xff (sync)
@@ -1007,26 +1014,24 @@ static int mmcsd_xmitblock(FAR struct mmcsd_slot_s *slot,
    * 3. Followed by the block of data and 2 byte CRC
    */
 
-  SPI_SEND(spi, 0xff);                     /* sync */
-  SPI_SEND(spi, token);                    /* data token */
+  header[0] = 0xff;                        /* sync */
+  header[1] = token;                       /* data token */
+  (void)SPI_SNDBLOCK(spi, header, 2);
 
   /* Transmit the block to the MMC/SD card */
 
   (void)SPI_SNDBLOCK(spi, buffer, nbytes);
 
   /* Add the bogus CRC.  By default, the SPI interface is initialized in
-   * non-protected mode.  However, we still have to send bogus CRC values
+   * non-protected mode.  However, we still have to send bogus CRC values.
+   * The (all ones) CRC is clocked out in the same transfer that receives
+   * the data response in the third byte.
    */
 
-  SPI_SEND(spi, 0xff);
-  SPI_SEND(spi, 0xff);
-
-  /* Now get the data response */
-
-  response = SPI_SEND(spi, 0xff);
-  if ((response & MMCSD_SPIDR_MASK) != MMCSD_SPIDR_ACCEPTED)
+  SPI_RECVBLOCK(spi, response, 3);
+  if ((response[2] & MMCSD_SPIDR_MASK) != MMCSD_SPIDR_ACCEPTED)
     {
-      ferr("ERROR: Bad data response: %02x\n", response);
+      ferr("ERROR: Bad data response: %02x\n", response[2]);
       return -EIO;
     }
 
@@ -1244,6 +1249,12 @@ static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
           if (mmcsd_recvblock(slot, buffer, SECTORSIZE(slot)) != 0)
             {
               ferr("ERROR: Failed: to receive the block\n");
+
+              /* Stop the transmission so that the card can accept the next
+               * command.
+               */
+
+              (void)mmcsd_sendcmd(slot, &g_cmd12, 0);
               goto errout_with_eio;
             }
 
@@ -1425,14 +1436,14 @@ static ssize_t mmcsd_write(FAR struct inode *inode, const unsigned char *buffer,
           if (mmcsd_xmitblock(slot, buffer, SECTORSIZE(slot), 0xfc) != 0)
             {
               ferr("ERROR: Failed: to receive the block\n");
-              goto errout_with_sem;
+              goto errout_with_stop;
             }
           buffer += SECTORSIZE(slot);
 
           if (mmcsd_waitready(slot) != OK)
             {
               ferr("ERROR: Failed: card is busy\n");
-              goto errout_with_sem;
+              goto errout_with_stop;
             }
         }
 
@@ -1452,6 +1463,14 @@ static ssize_t mmcsd_write(FAR struct inode *inode, const unsigned char *buffer,
 
   return nsectors;
 
+errout_with_stop:
+  /* Terminate the multiple block write so that the card returns to the
+   * transfer state.
+   */
+
+  SPI_SEND(spi, MMCSD_SPIDT_STOPTRANS);
+  (void)mmcsd_waitready(slot);
+
 errout_with_sem:
   SPI_SELECT(spi, SPIDEV_MMCSD(0), false);
   mmcsd_semgive(slot);
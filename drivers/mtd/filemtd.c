@@ -70,6 +70,10 @@
 #  define CONFIG_FILEMTD_ERASESTATE 0xff
 #endif
 
+#ifndef CONFIG_FILEMTD_BUFSIZE
+#  define CONFIG_FILEMTD_BUFSIZE 512
+#endif
+
 #if CONFIG_FILEMTD_ERASESTATE != 0xff && CONFIG_FILEMTD_ERASESTATE != 0x00
 #  error "Unsupported value for CONFIG_FILEMTD_ERASESTATE"
 #endif
@@ -102,6 +106,10 @@ struct file_dev_s
   size_t           offset;     /* Offset from start of file */
   size_t           erasesize;  /* Offset from start of file */
   size_t           blocksize;  /* Offset from start of file */
+
+  /* Buffer used for read-modify-write and erase transfers */
+
+  uint8_t          iobuffer[CONFIG_FILEMTD_BUFSIZE];
 };
 
 /****************************************************************************
@@ -142,80 +150,90 @@ static int     filemtd_ioctl(FAR struct mtd_dev_s *dev, int cmd,
 static ssize_t filemtd_write(FAR struct file_dev_s *priv, size_t offset,
                              FAR const void *src, size_t len)
 {
-  FAR const uint8_t *pin  = (FAR const uint8_t *)src;
+  FAR const uint8_t *pin = (FAR const uint8_t *)src;
   FAR uint8_t       *pout;
-  char               buf[128];
-  int                buflen = 0;
-  uint8_t            oldvalue;
   uint8_t            srcvalue;
   uint8_t            newvalue;
   size_t             seekpos;
+  size_t             remaining;
+  size_t             chunk;
+  size_t             i;
+  ssize_t            nread;
+  ssize_t            nwritten;
 
   /* Set the starting location in the file */
 
-  seekpos = priv->offset + offset;
+  seekpos   = priv->offset + offset;
+  remaining = len;
+
+  /* Process the data in chunks of the I/O buffer size:  Read the current
+   * content of the simulated FLASH, merge in the new data, and write the
+   * whole chunk back with one transfer.
+   */
 
-  while (len-- > 0)
+  while (remaining > 0)
     {
-      if (buflen == 0)
+      chunk = remaining;
+      if (chunk > CONFIG_FILEMTD_BUFSIZE)
         {
-          /* Read more data from the file */
+          chunk = CONFIG_FILEMTD_BUFSIZE;
+        }
 
-          file_seek(&priv->mtdfile, seekpos, SEEK_SET);
-          buflen = file_read(&priv->mtdfile, buf, sizeof(buf));
-          pout   = (FAR uint8_t *) buf;
+      (void)file_seek(&priv->mtdfile, seekpos, SEEK_SET);
+      nread = file_read(&priv->mtdfile, priv->iobuffer, chunk);
+      if (nread < 0)
+        {
+          return nread;
         }
 
-      /* Get the source and destination values */
+      /* Anything beyond the end of the file is in the erased state */
+
+      if ((size_t)nread < chunk)
+        {
+          memset(&priv->iobuffer[nread], CONFIG_FILEMTD_ERASESTATE,
+                 chunk - nread);
+        }
 
-      oldvalue = *pout;
-      srcvalue = *pin++;
+      for (i = 0, pout = priv->iobuffer; i < chunk; i++, pout++)
+        {
+          srcvalue = *pin++;
 
-      /* Get the new destination value, accounting for bits that cannot be
-       * changes because they are not in the erased state.
-       */
+          /* Get the new destination value, accounting for bits that cannot
+           * be changes because they are not in the erased state.
+           */
 
 #if CONFIG_FILEMTD_ERASESTATE == 0xff
-      newvalue = oldvalue & srcvalue; /* We can only clear bits */
+          newvalue = *pout & srcvalue; /* We can only clear bits */
 #else /* CONFIG_FILEMTD_ERASESTATE == 0x00 */
-      newvalue = oldvalue | srcvalue; /* We can only set bits */
+          newvalue = *pout | srcvalue; /* We can only set bits */
 #endif
 
-      /* Report any attempt to change the value of bits that are not in the
-       * erased state.
-       */
+          /* Report any attempt to change the value of bits that are not in
+           * the erased state.
+           */
 
 #ifdef CONFIG_DEBUG_FEATURES
-      if (newvalue != srcvalue)
-        {
-          ferr("ERROR: Bad write: source=%02x dest=%02x result=%02x\n",
-              srcvalue, oldvalue, newvalue);
-        }
+          if (newvalue != srcvalue)
+            {
+              ferr("ERROR: Bad write: source=%02x dest=%02x result=%02x\n",
+                  srcvalue, *pout, newvalue);
+            }
 #endif
 
-      /* Write the modified value to simulated FLASH */
-
-      *pout++ = newvalue;
-      buflen--;
+          *pout = newvalue;
+        }
 
-      /* If our buffer is full, then seek back to beginning of
-       * the file and write the buffer contents
-       */
+      /* Write the modified chunk back to simulated FLASH */
 
-      if (buflen == 0)
+      (void)file_seek(&priv->mtdfile, seekpos, SEEK_SET);
+      nwritten = file_write(&priv->mtdfile, priv->iobuffer, chunk);
+      if (nwritten < 0)
         {
-          file_seek(&priv->mtdfile, seekpos, SEEK_SET);
-          (void)file_write(&priv->mtdfile, buf, sizeof(buf));
-          seekpos += sizeof(buf);
+          return nwritten;
         }
-    }
-
-  /* Write remaining bytes */
 
-  if (buflen != 0)
-    {
-      file_seek(&priv->mtdfile, seekpos, SEEK_SET);
-      (void)file_write(&priv->mtdfile, buf, sizeof(buf));
+      seekpos   += chunk;
+      remaining -= chunk;
     }
 
   return len;
@@ -246,7 +264,7 @@ static int filemtd_erase(FAR struct mtd_dev_s *dev, off_t startblock,
   FAR struct file_dev_s *priv = (FAR struct file_dev_s *)dev;
   size_t    nbytes;
   size_t    offset;
-  char      buffer[128];
+  size_t    chunk;
 
   DEBUGASSERT(dev);
 
@@ -279,11 +297,17 @@ static int filemtd_erase(FAR struct mtd_dev_s *dev, off_t startblock,
   /* Then erase the data in the file */
 
   file_seek(&priv->mtdfile, priv->offset + offset, SEEK_SET);
-  memset(buffer, CONFIG_FILEMTD_ERASESTATE, sizeof(buffer));
-  while (nbytes)
+  memset(priv->iobuffer, CONFIG_FILEMTD_ERASESTATE, CONFIG_FILEMTD_BUFSIZE);
+  while (nbytes > 0)
     {
-      (void)file_write(&priv->mtdfile, buffer, sizeof(buffer));
-      nbytes -= sizeof(buffer);
+      chunk = nbytes;
+      if (chunk > CONFIG_FILEMTD_BUFSIZE)
+        {
+          chunk = CONFIG_FILEMTD_BUFSIZE;
+        }
+
+      (void)file_write(&priv->mtdfile, priv->iobuffer, chunk);
+      nbytes -= chunk;
     }
 
   return OK;
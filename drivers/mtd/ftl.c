@@ -48,10 +48,13 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <string.h>
+#include <semaphore.h>
+#include <crc32.h>
 #include <debug.h>
 #include <errno.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -73,10 +76,82 @@
 
 #define DEV_NAME_MAX    (NAME_MAX + 5)
 
+/* Log-structured FTL */
+
+#ifdef CONFIG_FTL_LOG
+#  ifndef CONFIG_FTL_LOG_NSPARE
+#    define CONFIG_FTL_LOG_NSPARE 4
+#  endif
+
+#  ifndef CONFIG_FTL_LOG_WLINTERVAL
+#    define CONFIG_FTL_LOG_WLINTERVAL 32
+#  endif
+
+#  ifndef CONFIG_FTL_LOG_WLTHRESHOLD
+#    define CONFIG_FTL_LOG_WLTHRESHOLD 64
+#  endif
+
+#  define FTL_LOG_MAGIC     0x4e46544c  /* "LTFN" */
+#  define FTL_LOG_UNMAPPED  0xffffffff  /* Logical block has no data */
+
+/* Erase block states */
+
+#  define FTL_EB_FREE       0           /* Superseded, erased on reuse */
+#  define FTL_EB_USED       1           /* Closed, summary written */
+#  define FTL_EB_OPEN       2           /* Receiving writes */
+
+/* Size of a summary describing n data blocks */
+
+#  define SIZEOF_FTL_LOGSUM(n) ((4 + (n)) * sizeof(uint32_t))
+
+/* Physical R/W block number of a slot in an erase block */
+
+#  define FTL_LOG_PSN(d,e,s) ((uint32_t)(e) * (d)->blkper + (s))
+
+#  define FTL_RELOAD ftl_log_reload
+#  define FTL_FLUSH  ftl_log_flush
+#else
+#  define FTL_RELOAD ftl_reload
+#  define FTL_FLUSH  ftl_flush
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_FTL_LOG
+/* The summary written into the last R/W block(s) of each erase block when
+ * it is closed.  The summary lists the logical block held in each data
+ * slot of the erase block.
+ */
+
+struct ftl_logsum_s
+{
+  uint32_t magic;               /* FTL_LOG_MAGIC */
+  uint32_t crc;                 /* CRC32 of the remainder of the summary */
+  uint32_t seq;                 /* Sequence number of the close */
+  uint32_t erasecount;          /* Times this erase block has been erased */
+  uint32_t lbn[1];              /* Logical block in each data slot */
+};
+
+/* RAM state of each erase block */
+
+struct ftl_eblock_s
+{
+  uint32_t erasecount;          /* Times this erase block has been erased */
+  uint16_t nvalid;              /* Number of data slots with live data */
+  uint8_t  state;               /* See FTL_EB_* definitions */
+};
+
+/* Used to replay the summaries in sequence at initialization */
+
+struct ftl_logscan_s
+{
+  uint32_t seq;                 /* Sequence number of the summary */
+  uint32_t eb;                  /* Erase block holding the summary */
+};
+#endif
+
 struct ftl_struct_s
 {
   FAR struct mtd_dev_s *mtd;     /* Contained MTD interface */
@@ -90,6 +165,21 @@ struct ftl_struct_s
 #ifdef CONFIG_FS_WRITABLE
   FAR uint8_t          *eblock;  /* One, in-memory erase block */
 #endif
+#ifdef CONFIG_FTL_LOG
+  sem_t                 exclsem; /* Exclusive access to the log state */
+  uint16_t              ndata;   /* Data slots per erase block */
+  uint16_t              nsum;    /* Summary blocks per erase block */
+  uint16_t              nextslot;/* Next free slot in the open erase block */
+  int                   open;    /* Open erase block (-1 if none) */
+  uint32_t              nfree;   /* Number of free erase blocks */
+  uint32_t              seq;     /* Next summary sequence number */
+  uint32_t              ngc;     /* Number of garbage collections */
+  size_t                nlogical;/* Number of logical blocks exported */
+  FAR uint32_t         *map;     /* Logical block -> physical R/W block */
+  FAR uint32_t         *slotlbn; /* Scratch slot -> logical block table */
+  FAR struct ftl_eblock_s *eblocks; /* State of each erase block */
+  FAR struct ftl_logsum_s *sum;  /* Summary of the open erase block */
+#endif
 };
 
 /****************************************************************************
@@ -98,18 +188,31 @@ struct ftl_struct_s
 
 static int     ftl_open(FAR struct inode *inode);
 static int     ftl_close(FAR struct inode *inode);
+#ifdef CONFIG_FTL_LOG
+static ssize_t ftl_log_reload(FAR void *priv, FAR uint8_t *buffer,
+                 off_t startblock, size_t nblocks);
+static ssize_t ftl_log_flush(FAR void *priv, FAR const uint8_t *buffer,
+                 off_t startblock, size_t nblocks);
+#else
 static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
                  off_t startblock, size_t nblocks);
+#endif
 static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
                  size_t start_sector, unsigned int nsectors);
 #ifdef CONFIG_FS_WRITABLE
+#ifndef CONFIG_FTL_LOG
 static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
                  off_t startblock, size_t nblocks);
+#endif
 static ssize_t ftl_write(FAR struct inode *inode, const unsigned char *buffer,
                  size_t start_sector, unsigned int nsectors);
 #endif
 static int     ftl_geometry(FAR struct inode *inode, struct geometry *geometry);
 static int     ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg);
+#ifdef CONFIG_FTL_LOG
+static int     ftl_log_sync(FAR struct ftl_struct_s *dev);
+static void    ftl_log_uninitialize(FAR struct ftl_struct_s *dev);
+#endif
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
 static int     ftl_unlink(FAR struct inode *inode);
 #endif
@@ -174,12 +277,18 @@ static int ftl_close(FAR struct inode *inode)
 #ifdef CONFIG_FTL_WRITEBUFFER
   rwb_flush(&dev->rwb);
 #endif
+#ifdef CONFIG_FTL_LOG
+  (void)ftl_log_sync(dev);
+#endif
 
   if (--dev->refs == 0 && dev->unlinked)
     {
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
+#ifdef CONFIG_FTL_LOG
+      ftl_log_uninitialize(dev);
+#endif
 #ifdef CONFIG_FS_WRITABLE
       if (dev->eblock)
         {
@@ -199,6 +308,7 @@ static int ftl_close(FAR struct inode *inode)
  *
  ****************************************************************************/
 
+#ifndef CONFIG_FTL_LOG
 static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
                           off_t startblock, size_t nblocks)
 {
@@ -216,6 +326,7 @@ static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
 
   return nread;
 }
+#endif
 
 /****************************************************************************
  * Name: ftl_read
@@ -237,7 +348,7 @@ static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
 #ifdef FTL_HAVE_RWBUFFER
   return rwb_read(&dev->rwb, start_sector, nsectors, buffer);
 #else
-  return ftl_reload(dev, buffer, start_sector, nsectors);
+  return FTL_RELOAD(dev, buffer, start_sector, nsectors);
 #endif
 }
 
@@ -260,7 +371,9 @@ static int ftl_alloc_eblock(FAR struct ftl_struct_s *dev)
 
    return dev->eblock != NULL ? OK : -ENOMEM;
 }
+#endif
 
+#if defined(CONFIG_FS_WRITABLE) && !defined(CONFIG_FTL_LOG)
 static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
                          off_t startblock, size_t nblocks)
 {
@@ -444,6 +557,707 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
 }
 #endif
 
+/****************************************************************************
+ * Name: ftl_log_remap
+ *
+ * Description:
+ *   Record that the current data for logical block 'lbn' is now held in
+ *   the physical R/W block 'psn'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static void ftl_log_remap(FAR struct ftl_struct_s *dev, uint32_t lbn,
+                          uint32_t psn)
+{
+  uint32_t old = dev->map[lbn];
+
+  if (old != FTL_LOG_UNMAPPED)
+    {
+      dev->eblocks[old / dev->blkper].nvalid--;
+    }
+
+  dev->map[lbn] = psn;
+  dev->eblocks[psn / dev->blkper].nvalid++;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_allocate
+ *
+ * Description:
+ *   Erase the least worn free erase block and make it the open erase
+ *   block.  Free erase blocks are not erased until they are reused.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static int ftl_log_allocate(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_eblock_s *eblk;
+  int best = -1;
+  int ret;
+  int i;
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      eblk = &dev->eblocks[i];
+      if (eblk->state == FTL_EB_FREE &&
+          (best < 0 || eblk->erasecount < dev->eblocks[best].erasecount))
+        {
+          best = i;
+        }
+    }
+
+  if (best < 0)
+    {
+      ferr("ERROR: No free erase blocks\n");
+      return -ENOSPC;
+    }
+
+  ret = MTD_ERASE(dev->mtd, best, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%d failed: %d\n", best, ret);
+      return ret;
+    }
+
+  eblk             = &dev->eblocks[best];
+  eblk->erasecount++;
+  eblk->nvalid     = 0;
+  eblk->state      = FTL_EB_OPEN;
+  dev->nfree--;
+
+  dev->open        = best;
+  dev->nextslot    = 0;
+  memset(dev->sum->lbn, 0xff, dev->ndata * sizeof(uint32_t));
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_close
+ *
+ * Description:
+ *   Write the summary of the open erase block, if anything has been written
+ *   to it.  Erase blocks whose data has all been superseded can only be
+ *   reused after this point:  Until the summary is written, the old copies
+ *   are still needed to recover from a power loss.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static int ftl_log_close(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_logsum_s *sum = dev->sum;
+  FAR struct ftl_eblock_s *eblk;
+  ssize_t nxfrd;
+  int ret = OK;
+  int i;
+
+  if (dev->open < 0 || dev->nextslot == 0)
+    {
+      return OK;
+    }
+
+  eblk            = &dev->eblocks[dev->open];
+  sum->magic      = FTL_LOG_MAGIC;
+  sum->seq        = dev->seq++;
+  sum->erasecount = eblk->erasecount;
+  sum->crc        = crc32((FAR const uint8_t *)&sum->seq,
+                          SIZEOF_FTL_LOGSUM(dev->ndata) - 2 * sizeof(uint32_t));
+
+  nxfrd = MTD_BWRITE(dev->mtd, FTL_LOG_PSN(dev, dev->open, dev->ndata),
+                     dev->nsum, (FAR const uint8_t *)sum);
+  if (nxfrd != dev->nsum)
+    {
+      ferr("ERROR: Write summary of erase block %d failed: %d\n",
+           dev->open, (int)nxfrd);
+      ret = -EIO;
+    }
+
+  eblk->state = FTL_EB_USED;
+  dev->open   = -1;
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      eblk = &dev->eblocks[i];
+      if (eblk->state == FTL_EB_USED && eblk->nvalid == 0)
+        {
+          eblk->state = FTL_EB_FREE;
+          dev->nfree++;
+        }
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_gc
+ *
+ * Description:
+ *   Relocate the live data of one erase block into the (freshly allocated)
+ *   open erase block.  The victim is normally the erase block with the
+ *   least live data; periodically it is instead the least worn block in
+ *   use so that static data also takes part in wear leveling.  The live
+ *   data of the victim always fits because the open block is empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static int ftl_log_gc(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_eblock_s *eblk;
+  FAR struct ftl_eblock_s *open = &dev->eblocks[dev->open];
+  size_t bs = dev->geo.blocksize;
+  uint32_t lbn;
+  uint32_t psn;
+  ssize_t nxfrd;
+  int victim = -1;
+  int nlive;
+  int i;
+
+  DEBUGASSERT(dev->nextslot == 0);
+
+  /* Static wear leveling:  Periodically move the data of the least worn
+   * erase block if it is much less worn than the open erase block.
+   */
+
+#if CONFIG_FTL_LOG_WLINTERVAL > 0
+  if ((++dev->ngc % CONFIG_FTL_LOG_WLINTERVAL) == 0)
+    {
+      for (i = 0; i < dev->geo.neraseblocks; i++)
+        {
+          eblk = &dev->eblocks[i];
+          if (eblk->state == FTL_EB_USED &&
+              (victim < 0 ||
+               eblk->erasecount < dev->eblocks[victim].erasecount))
+            {
+              victim = i;
+            }
+        }
+
+      if (victim >= 0 &&
+          dev->eblocks[victim].erasecount + CONFIG_FTL_LOG_WLTHRESHOLD >
+          open->erasecount)
+        {
+          victim = -1;
+        }
+    }
+#endif
+
+  /* Otherwise, reclaim the erase block with the least live data, the least
+   * worn one on a tie.
+   */
+
+  if (victim < 0)
+    {
+      for (i = 0; i < dev->geo.neraseblocks; i++)
+        {
+          eblk = &dev->eblocks[i];
+          if (eblk->state == FTL_EB_USED && eblk->nvalid < dev->ndata &&
+              (victim < 0 || eblk->nvalid < dev->eblocks[victim].nvalid ||
+               (eblk->nvalid == dev->eblocks[victim].nvalid &&
+                eblk->erasecount < dev->eblocks[victim].erasecount)))
+            {
+              victim = i;
+            }
+        }
+    }
+
+  if (victim < 0)
+    {
+      return OK;
+    }
+
+  finfo("GC: erase block=%d nvalid=%d\n",
+        victim, dev->eblocks[victim].nvalid);
+
+  /* Find the logical block held in each live slot of the victim */
+
+  memset(dev->slotlbn, 0xff, dev->ndata * sizeof(uint32_t));
+  for (lbn = 0; lbn < dev->nlogical; lbn++)
+    {
+      psn = dev->map[lbn];
+      if (psn != FTL_LOG_UNMAPPED && psn / dev->blkper == victim)
+        {
+          dev->slotlbn[psn % dev->blkper] = lbn;
+        }
+    }
+
+  /* Read the data area of the victim and pack the live blocks at the
+   * beginning of the buffer.
+   */
+
+  nxfrd = MTD_BREAD(dev->mtd, FTL_LOG_PSN(dev, victim, 0), dev->ndata,
+                    dev->eblock);
+  if (nxfrd != dev->ndata)
+    {
+      ferr("ERROR: Read erase block %d failed: %d\n", victim, (int)nxfrd);
+      return -EIO;
+    }
+
+  for (i = 0, nlive = 0; i < dev->ndata; i++)
+    {
+      if (dev->slotlbn[i] != FTL_LOG_UNMAPPED)
+        {
+          if (nlive != i)
+            {
+              memcpy(dev->eblock + nlive * bs, dev->eblock + i * bs, bs);
+            }
+
+          dev->slotlbn[nlive++] = dev->slotlbn[i];
+        }
+    }
+
+  /* And write them to the open erase block with one transfer */
+
+  if (nlive > 0)
+    {
+      psn   = FTL_LOG_PSN(dev, dev->open, 0);
+      nxfrd = MTD_BWRITE(dev->mtd, psn, nlive, dev->eblock);
+      if (nxfrd != nlive)
+        {
+          ferr("ERROR: Write erase block %d failed: %d\n",
+               dev->open, (int)nxfrd);
+          dev->nextslot = dev->ndata;
+          return -EIO;
+        }
+
+      for (i = 0; i < nlive; i++)
+        {
+          dev->sum->lbn[i] = dev->slotlbn[i];
+          ftl_log_remap(dev, dev->slotlbn[i], psn + i);
+        }
+
+      dev->nextslot = nlive;
+    }
+
+  /* The victim is reused once the open erase block has been closed */
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_newblock
+ *
+ * Description:
+ *   Close the full open erase block and open a new one, garbage collecting
+ *   if that used the last free erase block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static int ftl_log_newblock(FAR struct ftl_struct_s *dev)
+{
+  int ret;
+
+  ret = ftl_log_close(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = ftl_log_allocate(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (dev->nfree == 0)
+    {
+      ret = ftl_log_gc(dev);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_reload
+ *
+ * Description:  Read the specified number of logical sectors
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static ssize_t ftl_log_reload(FAR void *priv, FAR uint8_t *buffer,
+                              off_t startblock, size_t nblocks)
+{
+  FAR struct ftl_struct_s *dev = (FAR struct ftl_struct_s *)priv;
+  size_t remaining;
+  size_t nrun;
+  ssize_t nxfrd;
+  uint32_t psn;
+
+  if (startblock < 0 || startblock + nblocks > dev->nlogical)
+    {
+      return -EINVAL;
+    }
+
+  (void)nxsem_wait_uninterruptible(&dev->exclsem);
+
+  for (remaining = nblocks; remaining > 0; remaining -= nrun)
+    {
+      psn = dev->map[startblock];
+      if (psn == FTL_LOG_UNMAPPED)
+        {
+          /* Never written:  Return the erased state */
+
+          nrun = 1;
+          memset(buffer, 0xff, dev->geo.blocksize);
+        }
+      else
+        {
+          /* Read physically consecutive blocks with one transfer */
+
+          for (nrun = 1;
+               nrun < remaining && dev->map[startblock + nrun] == psn + nrun;
+               nrun++);
+
+          nxfrd = MTD_BREAD(dev->mtd, psn, nrun, buffer);
+          if (nxfrd != nrun)
+            {
+              ferr("ERROR: Read %d blocks starting at block %d failed: %d\n",
+                   (int)nrun, (int)psn, (int)nxfrd);
+              nxsem_post(&dev->exclsem);
+              return -EIO;
+            }
+        }
+
+      startblock += nrun;
+      buffer     += nrun * dev->geo.blocksize;
+    }
+
+  nxsem_post(&dev->exclsem);
+  return nblocks;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_flush
+ *
+ * Description:
+ *   Write the specified number of logical sectors by appending them to the
+ *   open erase block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static ssize_t ftl_log_flush(FAR void *priv, FAR const uint8_t *buffer,
+                             off_t startblock, size_t nblocks)
+{
+  FAR struct ftl_struct_s *dev = (FAR struct ftl_struct_s *)priv;
+  size_t remaining;
+  size_t nrun;
+  size_t i;
+  ssize_t nxfrd;
+  uint32_t psn;
+  int ret;
+
+  if (startblock < 0 || startblock + nblocks > dev->nlogical)
+    {
+      return -EINVAL;
+    }
+
+  (void)nxsem_wait_uninterruptible(&dev->exclsem);
+
+  for (remaining = nblocks; remaining > 0; remaining -= nrun)
+    {
+      if (dev->open < 0 || dev->nextslot >= dev->ndata)
+        {
+          ret = ftl_log_newblock(dev);
+          if (ret < 0)
+            {
+              nxsem_post(&dev->exclsem);
+              return ret;
+            }
+
+          /* Garbage collection may have filled the new erase block */
+
+          nrun = 0;
+          continue;
+        }
+
+      /* Write as many blocks as fit in the open erase block */
+
+      nrun = dev->ndata - dev->nextslot;
+      if (nrun > remaining)
+        {
+          nrun = remaining;
+        }
+
+      psn   = FTL_LOG_PSN(dev, dev->open, dev->nextslot);
+      nxfrd = MTD_BWRITE(dev->mtd, psn, nrun, buffer);
+      if (nxfrd != nrun)
+        {
+          ferr("ERROR: Write %d blocks starting at block %d failed: %d\n",
+               (int)nrun, (int)psn, (int)nxfrd);
+
+          /* Don't reuse the slots that may have been partially written */
+
+          dev->nextslot += nrun;
+          nxsem_post(&dev->exclsem);
+          return -EIO;
+        }
+
+      for (i = 0; i < nrun; i++)
+        {
+          dev->sum->lbn[dev->nextslot + i] = startblock + i;
+          ftl_log_remap(dev, startblock + i, psn + i);
+        }
+
+      dev->nextslot += nrun;
+      startblock    += nrun;
+      buffer        += nrun * dev->geo.blocksize;
+    }
+
+  nxsem_post(&dev->exclsem);
+  return nblocks;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_sync
+ *
+ * Description:
+ *   Make everything written so far recoverable by closing the open erase
+ *   block.  The unused slots of that erase block are reclaimed by garbage
+ *   collection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static int ftl_log_sync(FAR struct ftl_struct_s *dev)
+{
+  int ret;
+
+  (void)nxsem_wait_uninterruptible(&dev->exclsem);
+  ret = ftl_log_close(dev);
+  nxsem_post(&dev->exclsem);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_initialize
+ *
+ * Description:
+ *   Determine the log layout, allocate the remap tables, and rebuild them
+ *   by replaying the erase block summaries in the order they were written.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static int ftl_log_scancompare(FAR const void *a, FAR const void *b)
+{
+  uint32_t seqa = ((FAR const struct ftl_logscan_s *)a)->seq;
+  uint32_t seqb = ((FAR const struct ftl_logscan_s *)b)->seq;
+
+  return seqa < seqb ? -1 : seqa > seqb ? 1 : 0;
+}
+
+static int ftl_log_initialize(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_logscan_s *scan;
+  FAR struct ftl_logsum_s *sum;
+  size_t sumsize;
+  ssize_t nxfrd;
+  uint32_t nused;
+  uint32_t eb;
+  uint32_t crc;
+  int slot;
+  int ret;
+  int i;
+
+  /* Reserve enough R/W blocks at the end of each erase block to hold its
+   * summary.
+   */
+
+  for (dev->nsum = 1; dev->nsum < dev->blkper; dev->nsum++)
+    {
+      if (SIZEOF_FTL_LOGSUM(dev->blkper - dev->nsum) <=
+          dev->nsum * dev->geo.blocksize)
+        {
+          break;
+        }
+    }
+
+  if (dev->nsum >= dev->blkper ||
+      dev->geo.neraseblocks <= CONFIG_FTL_LOG_NSPARE)
+    {
+      ferr("ERROR: Geometry not supported by the log-structured FTL\n");
+      return -EINVAL;
+    }
+
+  dev->ndata    = dev->blkper - dev->nsum;
+  dev->nlogical = (size_t)(dev->geo.neraseblocks - CONFIG_FTL_LOG_NSPARE) *
+                  dev->ndata;
+  dev->open     = -1;
+  sumsize       = dev->nsum * dev->geo.blocksize;
+
+  nxsem_init(&dev->exclsem, 0, 1);
+
+  ret = ftl_alloc_eblock(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  dev->map     = (FAR uint32_t *)kmm_malloc(dev->nlogical * sizeof(uint32_t));
+  dev->slotlbn = (FAR uint32_t *)kmm_malloc(dev->ndata * sizeof(uint32_t));
+  dev->sum     = (FAR struct ftl_logsum_s *)kmm_malloc(sumsize);
+  dev->eblocks = (FAR struct ftl_eblock_s *)
+    kmm_zalloc(dev->geo.neraseblocks * sizeof(struct ftl_eblock_s));
+  scan         = (FAR struct ftl_logscan_s *)
+    kmm_malloc(dev->geo.neraseblocks * sizeof(struct ftl_logscan_s));
+
+  if (dev->map == NULL || dev->slotlbn == NULL || dev->sum == NULL ||
+      dev->eblocks == NULL || scan == NULL)
+    {
+      ferr("ERROR: Failed to allocate the log-structured FTL tables\n");
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  memset(dev->map, 0xff, dev->nlogical * sizeof(uint32_t));
+  memset(dev->sum, 0xff, sumsize);
+
+  /* Find all erase blocks with a valid summary.  The others are free (and
+   * will be erased when they are reused).
+   */
+
+  sum   = (FAR struct ftl_logsum_s *)dev->eblock;
+  nused = 0;
+
+  for (eb = 0; eb < dev->geo.neraseblocks; eb++)
+    {
+      nxfrd = MTD_BREAD(dev->mtd, FTL_LOG_PSN(dev, eb, dev->ndata),
+                        dev->nsum, dev->eblock);
+      if (nxfrd == dev->nsum && sum->magic == FTL_LOG_MAGIC)
+        {
+          crc = crc32((FAR const uint8_t *)&sum->seq,
+                      SIZEOF_FTL_LOGSUM(dev->ndata) - 2 * sizeof(uint32_t));
+          if (crc == sum->crc)
+            {
+              dev->eblocks[eb].erasecount = sum->erasecount;
+              dev->eblocks[eb].state      = FTL_EB_USED;
+              scan[nused].seq             = sum->seq;
+              scan[nused].eb              = eb;
+              nused++;
+
+              if (sum->seq >= dev->seq)
+                {
+                  dev->seq = sum->seq + 1;
+                }
+
+              continue;
+            }
+        }
+
+      dev->eblocks[eb].state = FTL_EB_FREE;
+      dev->nfree++;
+    }
+
+  /* Replay the summaries, oldest first, so that the newest copy of each
+   * logical block wins.
+   */
+
+  qsort(scan, nused, sizeof(struct ftl_logscan_s), ftl_log_scancompare);
+
+  for (i = 0; i < nused; i++)
+    {
+      eb    = scan[i].eb;
+      nxfrd = MTD_BREAD(dev->mtd, FTL_LOG_PSN(dev, eb, dev->ndata),
+                        dev->nsum, dev->eblock);
+      if (nxfrd != dev->nsum)
+        {
+          ferr("ERROR: Read summary of erase block %d failed: %d\n",
+               (int)eb, (int)nxfrd);
+          ret = -EIO;
+          goto errout;
+        }
+
+      for (slot = 0; slot < dev->ndata; slot++)
+        {
+          if (sum->lbn[slot] < dev->nlogical)
+            {
+              ftl_log_remap(dev, sum->lbn[slot], FTL_LOG_PSN(dev, eb, slot));
+            }
+        }
+    }
+
+  /* Erase blocks with no live data left are free */
+
+  for (eb = 0; eb < dev->geo.neraseblocks; eb++)
+    {
+      if (dev->eblocks[eb].state == FTL_EB_USED &&
+          dev->eblocks[eb].nvalid == 0)
+        {
+          dev->eblocks[eb].state = FTL_EB_FREE;
+          dev->nfree++;
+        }
+    }
+
+  finfo("Log: nlogical=%lu ndata=%d nsum=%d nused=%lu nfree=%lu\n",
+        (unsigned long)dev->nlogical, dev->ndata, dev->nsum,
+        (unsigned long)nused, (unsigned long)dev->nfree);
+
+  kmm_free(scan);
+  return OK;
+
+errout:
+  if (scan != NULL)
+    {
+      kmm_free(scan);
+    }
+
+  ftl_log_uninitialize(dev);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_uninitialize
+ *
+ * Description:
+ *   Free the log-structured FTL tables
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+static void ftl_log_uninitialize(FAR struct ftl_struct_s *dev)
+{
+  if (dev->map)
+    {
+      kmm_free(dev->map);
+      dev->map = NULL;
+    }
+
+  if (dev->slotlbn)
+    {
+      kmm_free(dev->slotlbn);
+      dev->slotlbn = NULL;
+    }
+
+  if (dev->sum)
+    {
+      kmm_free(dev->sum);
+      dev->sum = NULL;
+    }
+
+  if (dev->eblocks)
+    {
+      kmm_free(dev->eblocks);
+      dev->eblocks = NULL;
+    }
+
+  nxsem_destroy(&dev->exclsem);
+}
+#endif
+
 /****************************************************************************
  * Name: ftl_write
  *
@@ -464,7 +1278,7 @@ static ssize_t ftl_write(FAR struct inode *inode, const unsigned char *buffer,
 #ifdef FTL_HAVE_RWBUFFER
   return rwb_write(&dev->rwb, start_sector, nsectors, buffer);
 #else
-  return ftl_flush(dev, buffer, start_sector, nsectors);
+  return FTL_FLUSH(dev, buffer, start_sector, nsectors);
 #endif
 }
 #endif
@@ -493,7 +1307,11 @@ static int ftl_geometry(FAR struct inode *inode, struct geometry *geometry)
 #else
       geometry->geo_writeenabled  = false;
 #endif
+#ifdef CONFIG_FTL_LOG
+      geometry->geo_nsectors      = dev->nlogical;
+#else
       geometry->geo_nsectors      = dev->geo.neraseblocks * dev->blkper;
+#endif
       geometry->geo_sectorsize    = dev->geo.blocksize;
 
       finfo("available: true mediachanged: false writeenabled: %s\n",
@@ -531,6 +1349,12 @@ static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 
   if (cmd == BIOC_XIPBASE)
     {
+#ifdef CONFIG_FTL_LOG
+      /* Logical blocks are not at fixed locations in the FLASH */
+
+      return -ENOTTY;
+#endif
+
       /* The argument accompanying the BIOC_XIPBASE should be non-NULL.  If
        * DEBUG is enabled, we will catch it here instead of in the MTD
        * driver.
@@ -548,10 +1372,20 @@ static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 
       cmd = MTDIOC_XIPBASE;
     }
-#ifdef CONFIG_FTL_WRITEBUFFER
+#if defined(CONFIG_FTL_WRITEBUFFER) || defined(CONFIG_FTL_LOG)
   else if (cmd == BIOC_FLUSH)
     {
-      return rwb_flush(&dev->rwb);
+#ifdef CONFIG_FTL_WRITEBUFFER
+      ret = rwb_flush(&dev->rwb);
+      if (ret < 0)
+        {
+          return ret;
+        }
+#endif
+#ifdef CONFIG_FTL_LOG
+      ret = ftl_log_sync(dev);
+#endif
+      return ret;
     }
 #endif
 
@@ -590,6 +1424,9 @@ static int ftl_unlink(FAR struct inode *inode)
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
+#ifdef CONFIG_FTL_LOG
+      ftl_log_uninitialize(dev);
+#endif
 #ifdef CONFIG_FS_WRITABLE
       if (dev->eblock)
         {
@@ -658,14 +1495,35 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
       DEBUGASSERT(dev->blkper * dev->geo.blocksize == dev->geo.erasesize);
 
+#ifdef CONFIG_FTL_LOG
+      /* Rebuild the logical-to-physical map from the FLASH */
+
+      ret = ftl_log_initialize(dev);
+      if (ret < 0)
+        {
+          ferr("ERROR: ftl_log_initialize failed: %d\n", ret);
+          if (dev->eblock)
+            {
+              kmm_free(dev->eblock);
+            }
+
+          kmm_free(dev);
+          return ret;
+        }
+#endif
+
       /* Configure read-ahead/write buffering */
 
 #ifdef FTL_HAVE_RWBUFFER
       dev->rwb.blocksize   = dev->geo.blocksize;
+#ifdef CONFIG_FTL_LOG
+      dev->rwb.nblocks     = dev->nlogical;
+#else
       dev->rwb.nblocks     = dev->geo.neraseblocks * dev->blkper;
+#endif
       dev->rwb.dev         = (FAR void *)dev;
-      dev->rwb.wrflush     = ftl_flush;
-      dev->rwb.rhreload    = ftl_reload;
+      dev->rwb.wrflush     = FTL_FLUSH;
+      dev->rwb.rhreload    = FTL_RELOAD;
 
 #if defined(CONFIG_FS_WRITABLE) && defined(CONFIG_FTL_WRITEBUFFER)
       dev->rwb.wrmaxblocks = dev->blkper;
@@ -679,6 +1537,10 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       if (ret < 0)
         {
           ferr("ERROR: rwb_initialize failed: %d\n", ret);
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(dev);
+          kmm_free(dev->eblock);
+#endif
           kmm_free(dev);
           return ret;
         }
@@ -692,6 +1554,10 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
           ferr("ERROR: register_blockdriver failed: %d\n", -ret);
 #ifdef FTL_HAVE_RWBUFFER
           rwb_uninitialize(&dev->rwb);
+#endif
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(dev);
+          kmm_free(dev->eblock);
 #endif
           kmm_free(dev);
         }
@@ -53,38 +53,33 @@
 #include <nuttx/mtd/hamming.h>
 
 /****************************************************************************
- * Private Functions
+ * Pre-processor Definitions
  ****************************************************************************/
 
+/* The number of bits set to '1' in the given byte, taken from a nibble
+ * table.  The parity of the byte is the low bit of the count of its two
+ * nibbles folded together.
+ */
+
+#define hamming_bitsinbyte(b) \
+  (g_nibblebits[(b) & 15] + g_nibblebits[((b) >> 4) & 15])
+#define hamming_parity(b) \
+  (g_nibblebits[((b) ^ ((b) >> 4)) & 15] & 1)
+
 /****************************************************************************
- * Name: hamming_bitsinbyte
- *
- * Description:
- *   Counts the number of bits set to '1' in the given byte.
- *
- * Input Parameters:
- *   bytes - The byte to use.
- *
- * Returned Value:
- *   Returns the number of bits set to '1' in the given byte.
- *
+ * Private Data
  ****************************************************************************/
 
-static unsigned int hamming_bitsinbyte(uint8_t byte)
-{
-  unsigned int count = 0;
+/* Number of bits set in each 4-bit value */
 
-  while (byte != 0)
-    {
-      if ((byte & 1) != 0)
-        {
-          count++;
-        }
-      byte >>= 1;
-    }
+static const uint8_t g_nibblebits[16] =
+{
+  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
 
-  return count;
-}
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
 
 /****************************************************************************
  * Name: hamming_bitsincode256
@@ -129,6 +124,7 @@ static void hamming_compute256(FAR const uint8_t *data, FAR uint8_t *code)
   uint8_t oddline = 0;
   uint8_t evencol = 0;
   uint8_t oddcol = 0;
+  uint8_t nodd = 0;
   int i;
 
   /* Xor all bytes together to get the column sum;
@@ -137,13 +133,15 @@ static void hamming_compute256(FAR const uint8_t *data, FAR uint8_t *code)
 
   for (i = 0; i < 256; i++)
     {
-      colsum ^= data[i];
+      uint8_t byte = data[i];
+
+      colsum ^= byte;
 
       /* If the xor sum of the byte is 0, then this byte has no incidence on
        * the computed code; so check if the sum is 1.
        */
 
-      if ((hamming_bitsinbyte(data[i]) & 1) == 1)
+      if (hamming_parity(byte) != 0)
         {
           /* Parity groups are formed by forcing a particular index bit to 0
            * (even) or 1 (odd).
@@ -172,13 +170,19 @@ static void hamming_compute256(FAR const uint8_t *data, FAR uint8_t *code)
            * same time in two variables, evenline and oddline, such as
            *     evenline bits: P128  P64  P32  P16  P8  P4  P2  P1
            *     oddline  bits: P128' P64' P32' P16' P8' P4' P2' P1'
+           *
+           * Since (255 - i) == ~i, evenline is just oddline inverted once
+           * for each odd parity byte.  So only oddline and the count of
+           * odd parity bytes are accumulated here.
            */
 
-          evenline ^= (255 - i);
           oddline ^= i;
+          nodd++;
         }
     }
 
+  evenline = (nodd & 1) != 0 ? (uint8_t)~oddline : oddline;
+
   /* At this point, we have the line parities, and the column sum. First, We
    * must caculate the parity group values on the column sum.
    */
@@ -262,14 +266,15 @@ static void hamming_compute256(FAR const uint8_t *data, FAR uint8_t *code)
 }
 
 /****************************************************************************
- * Name: hamming_verify256
+ * Name: hamming_correct256
  *
  * Description:
- *   Verifies and corrects a 256-bytes block of data using the given 22-bits
- *   hamming code.
+ *   Corrects a 256-bytes block of data by comparing the 22-bits hamming code
+ *   computed on the data with the original code.
  *
  * Input Parameters:
  *   data     - Data buffer to check
+ *   computed - Hamming code computed on the data
  *   original - Hamming code to use for verifying the data
  *
  * Returned Value:
@@ -277,15 +282,11 @@ static void hamming_compute256(FAR const uint8_t *data, FAR uint8_t *code)
  *
  ****************************************************************************/
 
-static int hamming_verify256(FAR uint8_t *data, FAR const uint8_t *original)
+static int hamming_correct256(FAR uint8_t *data, FAR const uint8_t *computed,
+                              FAR const uint8_t *original)
 {
-  /* Calculate new code */
-
-  uint8_t computed[3];
   uint8_t correction[3];
 
-  hamming_compute256(data, computed);
-
   /* Xor both codes together */
 
   correction[0] = computed[0] ^ original[0];
@@ -356,6 +357,32 @@ static int hamming_verify256(FAR uint8_t *data, FAR const uint8_t *original)
     }
 }
 
+/****************************************************************************
+ * Name: hamming_verify256
+ *
+ * Description:
+ *   Verifies and corrects a 256-bytes block of data using the given 22-bits
+ *   hamming code.
+ *
+ * Input Parameters:
+ *   data     - Data buffer to check
+ *   original - Hamming code to use for verifying the data
+ *
+ * Returned Value:
+ *   Zero on success, otherwise returns a HAMMING_ERROR_ code.
+ *
+ ****************************************************************************/
+
+static int hamming_verify256(FAR uint8_t *data, FAR const uint8_t *original)
+{
+  uint8_t computed[3];
+
+  /* Calculate new code */
+
+  hamming_compute256(data, computed);
+  return hamming_correct256(data, computed, original);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -419,7 +446,7 @@ int hamming_verify256x(FAR uint8_t *data, size_t size, FAR const uint8_t *code)
 {
   ssize_t remaining = (ssize_t)size;
   int result = HAMMING_SUCCESS;
-  int ret;
+  int ret = HAMMING_SUCCESS;
 
   DEBUGASSERT((size & 0xff) == 0);
 
@@ -457,3 +484,58 @@ int hamming_verify256x(FAR uint8_t *data, size_t size, FAR const uint8_t *code)
 
   return ret;
 }
+
+/****************************************************************************
+ * Name: hamming_correct256x
+ *
+ * Description:
+ *   Like hamming_verify256x(), but the 3-bytes hamming codes of the data
+ *   have already been computed (for example, by a hardware ECC engine).
+ *   Each 256-bytes block is corrected with its own code.
+ *
+ * Input Parameters:
+ *   data     - Data buffer to verify
+ *   size     - Size of the data in bytes
+ *   computed - Codes computed on the data
+ *   code     - Original codes
+ *
+ * Returned Value:
+ *   Same as hamming_verify256x().
+ *
+ ****************************************************************************/
+
+int hamming_correct256x(FAR uint8_t *data, size_t size,
+                        FAR const uint8_t *computed, FAR const uint8_t *code)
+{
+  ssize_t remaining = (ssize_t)size;
+  int result;
+  int ret = HAMMING_SUCCESS;
+
+  DEBUGASSERT((size & 0xff) == 0);
+
+  /* Loop, correcting each 256 byte chunk of data */
+
+  while (remaining > 0)
+    {
+      result = hamming_correct256(data, computed, code);
+      if (result == HAMMING_ERROR_SINGLEBIT)
+        {
+          /* Report the error, but continue verifying */
+
+          ret = HAMMING_ERROR_SINGLEBIT;
+        }
+      else if (result != HAMMING_SUCCESS)
+        {
+          return result;
+        }
+
+      /* Setup for the next 256 byte chunk */
+
+      data      += 256;
+      computed  += 3;
+      code      += 3;
+      remaining -= 256;
+    }
+
+  return ret;
+}
@@ -59,6 +59,8 @@
 #include <nuttx/fs/fs.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/mtd/configdata.h>
@@ -85,10 +87,39 @@
 
 #define MTD_ERASED_FLAGS  CONFIG_MTD_CONFIG_ERASEDVALUE
 
+/* Index and background consolidation */
+
+#ifndef CONFIG_MTD_CONFIG_INDEX_NENTRIES
+#  define CONFIG_MTD_CONFIG_INDEX_NENTRIES 32
+#endif
+
+#define MTD_BGCONSOLIDATE_DELAY MSEC2TICK(100)
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+#  define mtdconfig_ndxinvalidate(d) do { (d)->ndxvalid = false; } while (0)
+#else
+#  define mtdconfig_ndxinvalidate(d)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* One entry of the in-RAM index of active config items */
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+struct mtdconfig_ndxent_s
+{
+#ifdef CONFIG_MTD_CONFIG_NAMED
+  uint32_t     hash;          /* Hash of the item name */
+#else
+  uint16_t     id;            /* ID of the config data item */
+  uint8_t      instance;      /* Instance of the item */
+#endif
+  off_t        offset;        /* Offset of the item header */
+};
+#endif
+
 struct mtdconfig_struct_s
 {
   FAR struct mtd_dev_s *mtd;  /* Contained MTD interface */
@@ -99,6 +130,19 @@ struct mtdconfig_struct_s
   size_t       neraseblocks;  /* Number of erase blocks available */
   off_t        readoff;       /* Read offset (for hexdump) */
   FAR uint8_t *buffer;        /* Temp block read buffer */
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+  bool         ndxvalid;      /* True: ndx[] reflects the device contents */
+  bool         ndxfull;       /* True: Some active items are not in ndx[] */
+  uint16_t     nndx;          /* Number of entries used in ndx[] */
+  struct mtdconfig_ndxent_s ndx[CONFIG_MTD_CONFIG_INDEX_NENTRIES];
+#endif
+
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+  bool         released;      /* True: Items released since consolidation */
+  bool         pending;       /* True: Consolidate when the device is idle */
+  struct work_s work;         /* Background consolidation work */
+#endif
 };
 
 begin_packed_struct struct mtdconfig_header_s
@@ -127,6 +171,9 @@ static int     mtdconfig_ioctl(FAR struct file *filep, int cmd,
 static int     mtdconfig_poll(FAR struct file *filep, FAR struct pollfd *fds,
                   bool setup);
 #endif
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+static void    mtdconfig_bgconsolidate(FAR void *arg);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -1048,6 +1095,17 @@ static int  mtdconfig_close(FAR struct file *filep)
   /* Release exclusive access to the device */
 
   nxsem_post(&dev->exclsem);
+
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+  /* Reclaim released items now that the device is idle */
+
+  if (dev->pending && work_available(&dev->work))
+    {
+      (void)work_queue(LPWORK, &dev->work, mtdconfig_bgconsolidate, dev,
+                       MTD_BGCONSOLIDATE_DELAY);
+    }
+#endif
+
   return OK;
 }
 
@@ -1155,6 +1213,296 @@ static int mtdconfig_findentry(FAR struct mtdconfig_struct_s *dev,
   return offset;
 }
 
+/****************************************************************************
+ * Name: mtdconfig_ndxhash
+ ****************************************************************************/
+
+#if defined(CONFIG_MTD_CONFIG_INDEX) && defined(CONFIG_MTD_CONFIG_NAMED)
+static uint32_t mtdconfig_ndxhash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+  int i;
+
+  /* FNV-1a hash of the item name */
+
+  for (i = 0; i < CONFIG_MTD_CONFIG_NAME_LEN && name[i] != '\0'; i++)
+    {
+      hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: mtdconfig_ndxadd
+ *
+ *    Adds the active item with header phdr at offset to the index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+static void mtdconfig_ndxadd(FAR struct mtdconfig_struct_s *dev,
+                             FAR const struct mtdconfig_header_s *phdr,
+                             off_t offset)
+{
+  FAR struct mtdconfig_ndxent_s *ent;
+
+  if (!dev->ndxvalid)
+    {
+      return;
+    }
+
+  if (dev->nndx >= CONFIG_MTD_CONFIG_INDEX_NENTRIES)
+    {
+      /* No room.  Lookups of items missing from the index must now scan
+       * the device.
+       */
+
+      dev->ndxfull = true;
+      return;
+    }
+
+  ent = &dev->ndx[dev->nndx++];
+#ifdef CONFIG_MTD_CONFIG_NAMED
+  ent->hash     = mtdconfig_ndxhash(phdr->name);
+#else
+  ent->id       = phdr->id;
+  ent->instance = phdr->instance;
+#endif
+  ent->offset   = offset;
+}
+#endif
+
+/****************************************************************************
+ * Name: mtdconfig_ndxremove
+ *
+ *    Removes the item with the header at offset from the index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+static void mtdconfig_ndxremove(FAR struct mtdconfig_struct_s *dev,
+                                off_t offset)
+{
+  int i;
+
+  if (!dev->ndxvalid)
+    {
+      return;
+    }
+
+  for (i = 0; i < dev->nndx; i++)
+    {
+      if (dev->ndx[i].offset == offset)
+        {
+          /* Keep the remaining entries in device order */
+
+          dev->nndx--;
+          memmove(&dev->ndx[i], &dev->ndx[i + 1],
+                  (dev->nndx - i) * sizeof(struct mtdconfig_ndxent_s));
+          return;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: mtdconfig_ndxbuild
+ *
+ *    Builds the index by walking all active items once, in the same order
+ *    as mtdconfig_findentry() visits them.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+static void mtdconfig_ndxbuild(FAR struct mtdconfig_struct_s *dev)
+{
+  struct mtdconfig_header_s hdr;
+  uint16_t  endblock;
+  off_t     offset;
+  int       ret;
+
+#ifdef CONFIG_MTD_CONFIG_RAM_CONSOLIDATE
+  endblock = dev->neraseblocks;
+#else
+  if (dev->neraseblocks == 1)
+    {
+      endblock = 1;
+    }
+  else
+    {
+      endblock = dev->neraseblocks - 1;
+    }
+#endif
+
+  dev->nndx     = 0;
+  dev->ndxfull  = false;
+
+  offset        = mtdconfig_findfirstentry(dev, &hdr);
+  dev->ndxvalid = (offset > 0);
+
+  while (offset > 0)
+    {
+#ifdef CONFIG_MTD_CONFIG_NAMED
+      if (hdr.name[0] == CONFIG_MTD_CONFIG_ERASEDVALUE)
+#else
+      if (hdr.id == MTD_ERASED_ID)
+#endif
+        {
+          /* End of the entries in this block.  Continue with the first
+           * header of the next block.
+           */
+
+          offset = (offset + dev->erasesize) / dev->erasesize;
+          offset = offset * dev->erasesize + CONFIGDATA_BLOCK_HDR_SIZE;
+          if (offset >= endblock * dev->erasesize)
+            {
+              break;
+            }
+
+          ret = mtdconfig_readbytes(dev, offset, (FAR uint8_t *)&hdr,
+                                    sizeof(hdr));
+          if (ret != OK)
+            {
+              dev->ndxvalid = false;
+              break;
+            }
+
+          if (hdr.flags == MTD_ERASED_FLAGS)
+            {
+              continue;
+            }
+        }
+      else
+        {
+          mtdconfig_ndxadd(dev, &hdr, offset);
+        }
+
+      offset = mtdconfig_findnextentry(dev, offset, &hdr, 0);
+    }
+
+  finfo("Indexed %d items%s\n", dev->nndx, dev->ndxfull ? " (full)" : "");
+}
+#endif
+
+/****************************************************************************
+ * Name: mtdconfig_ndxfind
+ *
+ * Returned Value:
+ *   The offset of the item header (also returned in phdr) if found, zero if
+ *   the item does not exist, or -ENOENT if the index cannot tell and the
+ *   device must be scanned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_CONFIG_INDEX
+static off_t mtdconfig_ndxfind(FAR struct mtdconfig_struct_s *dev,
+                               FAR struct config_data_s *pdata,
+                               FAR struct mtdconfig_header_s *phdr)
+{
+  FAR struct mtdconfig_ndxent_s *ent;
+  struct mtdconfig_header_s hdr;
+#ifdef CONFIG_MTD_CONFIG_NAMED
+  uint32_t hash;
+#endif
+  int i;
+  int ret;
+
+  if (!dev->ndxvalid)
+    {
+      mtdconfig_ndxbuild(dev);
+      if (!dev->ndxvalid)
+        {
+          return -ENOENT;
+        }
+    }
+
+#ifdef CONFIG_MTD_CONFIG_NAMED
+  hash = mtdconfig_ndxhash(pdata->name);
+#endif
+
+  for (i = 0; i < dev->nndx; i++)
+    {
+      ent = &dev->ndx[i];
+#ifdef CONFIG_MTD_CONFIG_NAMED
+      if (ent->hash != hash)
+#else
+      if (ent->id != pdata->id || ent->instance != pdata->instance)
+#endif
+        {
+          continue;
+        }
+
+      /* Verify the header on the device */
+
+      ret = mtdconfig_readbytes(dev, ent->offset, (FAR uint8_t *)&hdr,
+                                sizeof(hdr));
+      if (ret != OK || hdr.flags != MTD_ERASED_FLAGS)
+        {
+          break;
+        }
+
+#ifdef CONFIG_MTD_CONFIG_NAMED
+      if (strcmp(pdata->name, hdr.name) != 0)
+        {
+          /* Hash collision */
+
+          continue;
+        }
+#else
+      if (pdata->id != hdr.id || pdata->instance != hdr.instance)
+        {
+          break;
+        }
+#endif
+
+      memcpy(phdr, &hdr, sizeof(hdr));
+      return ent->offset;
+    }
+
+  if (i < dev->nndx)
+    {
+      /* The index is stale.  Rebuild it on the next lookup. */
+
+      dev->ndxvalid = false;
+      return -ENOENT;
+    }
+
+  /* If every active item is in the index, the item does not exist */
+
+  return dev->ndxfull ? -ENOENT : 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: mtdconfig_locate
+ *
+ *    Locates the item pdata given the offset and header of the first entry
+ *    from mtdconfig_findfirstentry().  The index is used when possible.
+ *
+ ****************************************************************************/
+
+static off_t mtdconfig_locate(FAR struct mtdconfig_struct_s *dev,
+                              off_t offset, FAR struct config_data_s *pdata,
+                              FAR struct mtdconfig_header_s *phdr)
+{
+#ifdef CONFIG_MTD_CONFIG_INDEX
+  off_t ret;
+
+  if (offset > 0)
+    {
+      ret = mtdconfig_ndxfind(dev, pdata, phdr);
+      if (ret >= 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  return mtdconfig_findentry(dev, offset, pdata, phdr);
+}
+
 /****************************************************************************
  * Name: mtdconfig_setconfig
  ****************************************************************************/
@@ -1196,6 +1544,7 @@ retry:
 
       /* Try to format the config partition */
 
+      mtdconfig_ndxinvalidate(dev);
       ret = MTD_IOCTL(dev->mtd, MTDIOC_BULKERASE, 0);
       if (ret < 0)
         {
@@ -1228,7 +1577,7 @@ retry:
    * is, we must mark it as obsolete before creating a new entry.
    */
 
-  offset = mtdconfig_findentry(dev, offset, pdata, &hdr);
+  offset = mtdconfig_locate(dev, offset, pdata, &hdr);
 
   /* Test if the header was found. */
 
@@ -1243,6 +1592,12 @@ retry:
 
       hdr.flags = (uint8_t)~MTD_ERASED_FLAGS;
       mtdconfig_writebytes(dev, offset, &hdr.flags, sizeof(hdr.flags));
+#ifdef CONFIG_MTD_CONFIG_INDEX
+      mtdconfig_ndxremove(dev, offset);
+#endif
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+      dev->released = true;
+#endif
     }
 
   /* Test if the new length is zero.  If it is, then we are
@@ -1317,6 +1672,10 @@ retry_find:
                 }
 
               mtdconfig_ramconsolidate(dev);
+              mtdconfig_ndxinvalidate(dev);
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+              dev->released = false;
+#endif
               retrycount++;
               goto retry_find;
             }
@@ -1332,6 +1691,10 @@ retry_find:
                 }
 
               mtdconfig_consolidate(dev);
+              mtdconfig_ndxinvalidate(dev);
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+              dev->released = false;
+#endif
               retrycount++;
               goto retry_find;
             }
@@ -1376,6 +1739,33 @@ retry_find:
           goto errout;
         }
 
+#ifdef CONFIG_MTD_CONFIG_INDEX
+      mtdconfig_ndxadd(dev, &hdr, offset);
+#endif
+
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+      /* If the item went into the last usable erase block and less than
+       * half of that block is left, reclaim the released items when the
+       * device is next idle rather than in the middle of a later write.
+       */
+
+      block = offset / dev->erasesize;
+      bytes_left_in_block = (block + 1) * dev->erasesize -
+                            (offset + sizeof(hdr) + pdata->len);
+
+#ifdef CONFIG_MTD_CONFIG_RAM_CONSOLIDATE
+      ram_consolidate = 1;
+#else
+      ram_consolidate = dev->neraseblocks == 1;
+#endif
+      if (dev->released &&
+          block + (ram_consolidate ? 1 : 2) >= dev->neraseblocks &&
+          bytes_left_in_block < dev->erasesize / 2)
+        {
+          dev->pending = true;
+        }
+#endif
+
       ret = OK;
     }
 
@@ -1412,7 +1802,7 @@ static int mtdconfig_getconfig(FAR struct mtdconfig_struct_s *dev,
    */
 
   offset = mtdconfig_findfirstentry(dev, &hdr);
-  offset = mtdconfig_findentry(dev, offset, pdata, &hdr);
+  offset = mtdconfig_locate(dev, offset, pdata, &hdr);
 
   /* Test if the header was found. */
 
@@ -1479,7 +1869,7 @@ static int mtdconfig_deleteconfig(FAR struct mtdconfig_struct_s *dev,
    */
 
   offset = mtdconfig_findfirstentry(dev, &hdr);
-  offset = mtdconfig_findentry(dev, offset, pdata, &hdr);
+  offset = mtdconfig_locate(dev, offset, pdata, &hdr);
 
   /* Test if the header was found. */
 
@@ -1493,6 +1883,12 @@ static int mtdconfig_deleteconfig(FAR struct mtdconfig_struct_s *dev,
 
       hdr.flags = (uint8_t)~MTD_ERASED_FLAGS;
       mtdconfig_writebytes(dev, offset, &hdr.flags, sizeof(hdr.flags));
+#ifdef CONFIG_MTD_CONFIG_INDEX
+      mtdconfig_ndxremove(dev, offset);
+#endif
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+      dev->released = true;
+#endif
 
       ret = OK;
     }
@@ -1503,6 +1899,62 @@ static int mtdconfig_deleteconfig(FAR struct mtdconfig_struct_s *dev,
   return ret;
 }
 
+/****************************************************************************
+ * Name: mtdconfig_bgconsolidate
+ *
+ *    Work queue function that consolidates released items while the device
+ *    is not open.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_CONFIG_BGCONSOLIDATE
+static void mtdconfig_bgconsolidate(FAR void *arg)
+{
+  FAR struct mtdconfig_struct_s *dev = (FAR struct mtdconfig_struct_s *)arg;
+  uint8_t ram_consolidate;
+
+  /* Don't wait for the device.  If it has been opened again, the work will
+   * be rescheduled when it is closed.
+   */
+
+  if (nxsem_trywait(&dev->exclsem) < 0)
+    {
+      return;
+    }
+
+  if (dev->pending)
+    {
+      dev->buffer = (FAR uint8_t *)kmm_malloc(dev->blocksize);
+      if (dev->buffer != NULL)
+        {
+#ifdef CONFIG_MTD_CONFIG_RAM_CONSOLIDATE
+          ram_consolidate = 1;
+#else
+          ram_consolidate = dev->neraseblocks == 1;
+#endif
+          if (ram_consolidate)
+            {
+              mtdconfig_ramconsolidate(dev);
+            }
+#ifndef CONFIG_MTD_CONFIG_RAM_CONSOLIDATE
+          else
+            {
+              mtdconfig_consolidate(dev);
+            }
+#endif
+
+          kmm_free(dev->buffer);
+          mtdconfig_ndxinvalidate(dev);
+          dev->released = false;
+        }
+
+      dev->pending = false;
+    }
+
+  nxsem_post(&dev->exclsem);
+}
+#endif
+
 /****************************************************************************
  * Name: mtdconfig_ioctl
  ****************************************************************************/
@@ -1513,8 +1965,10 @@ static int mtdconfig_ioctl(FAR struct file *filep, int cmd,
   FAR struct inode *inode = filep->f_inode;
   FAR struct mtdconfig_struct_s *dev = inode->i_private;
   FAR struct config_data_s *pdata;
+  FAR struct config_batch_s *pbatch;
   struct mtdconfig_header_s hdr;
   off_t bytes_to_read;
+  size_t i;
   int ret = -ENOSYS;
 
   switch (cmd)
@@ -1542,6 +1996,39 @@ static int mtdconfig_ioctl(FAR struct file *filep, int cmd,
         ret = mtdconfig_deleteconfig(dev, pdata);
         break;
 
+      case CFGDIOC_GETCONFIGS:
+        /* Get a list of config items */
+
+        pbatch = (FAR struct config_batch_s *)arg;
+        for (i = 0, ret = OK; i < pbatch->nitems; i++)
+          {
+            ret = mtdconfig_getconfig(dev, &pbatch->items[i]);
+            if (ret == -ENOSYS)
+              {
+                /* The item does not exist */
+
+                pbatch->items[i].len = 0;
+                ret = OK;
+              }
+            else if (ret < 0)
+              {
+                break;
+              }
+          }
+
+        break;
+
+      case CFGDIOC_SETCONFIGS:
+        /* Set a list of config items */
+
+        pbatch = (FAR struct config_batch_s *)arg;
+        for (i = 0, ret = OK; i < pbatch->nitems && ret >= 0; i++)
+          {
+            ret = mtdconfig_setconfig(dev, &pbatch->items[i]);
+          }
+
+        break;
+
       case CFGDIOC_FIRSTCONFIG:
         /* Get the the first config item */
 
@@ -1648,6 +2135,7 @@ static int mtdconfig_ioctl(FAR struct file *filep, int cmd,
 
         if (dev->mtd->ioctl)
           {
+             mtdconfig_ndxinvalidate(dev);
              dev->mtd->ioctl(dev->mtd, cmd, arg);
           }
 
@@ -1697,7 +2185,7 @@ int mtdconfig_register(FAR struct mtd_dev_s *mtd)
   struct mtd_geometry_s geo;      /* Device geometry */
 
   dev = (struct mtdconfig_struct_s *)
-    kmm_malloc(sizeof(struct mtdconfig_struct_s));
+    kmm_zalloc(sizeof(struct mtdconfig_struct_s));
   if (dev != NULL)
     {
       /* Initialize the mtdconfig device structure */
@@ -54,6 +54,10 @@
 #include <errno.h>
 #include <debug.h>
 
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+#  include <crc32.h>
+#endif
+
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -76,10 +80,41 @@
 
 #define NAND_BLOCKSTATUS_BAD 0xba
 
+/* Bad block table.  NAND_NBLOCKS is the number of blocks available to the
+ * MTD user.  With a persistent table, the table is kept in the block that
+ * follows those.
+ */
+
+#ifdef CONFIG_MTD_NAND_BBT
+#  define NAND_NBLOCKS(n)    ((n)->nblocks)
+#  define NAND_ISBAD(n,b)    (((n)->bbt[(b) >> 3] & (1 << ((b) & 7))) != 0)
+#  define NAND_SETBAD(n,b)   ((n)->bbt[(b) >> 3] |= (1 << ((b) & 7)))
+#  ifdef CONFIG_MTD_NAND_BBT_PERSIST
+#    define NAND_BBTBLOCK(n) ((n)->nblocks)
+#    define NAND_BBTSIZE(n)  (((n)->nblocks + 1 + 7) >> 3)
+#    define NAND_BBT_MAGIC   "NBBT"
+#  endif
+#else
+#  define NAND_NBLOCKS(n)    nandmodel_getdevblocks(&(n)->raw->model)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+/* This is the header of the bad block table in page 0 of the table block.
+ * The table itself follows the header.
+ */
+
+struct nand_bbthdr_s
+{
+  uint8_t  magic[4];         /* NAND_BBT_MAGIC */
+  uint32_t nblocks;          /* Number of blocks described by the table */
+  uint32_t crc;              /* CRC32 of the table */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -91,9 +126,24 @@ static int      nand_lock(FAR struct nand_dev_s *nand);
 /* Bad block checking */
 
 #ifdef CONFIG_MTD_NAND_BLOCKCHECK
-static int     nand_checkblock(FAR struct nand_dev_s *nand, off_t block);
+static int     nand_checkmarker(FAR struct nand_dev_s *nand, off_t block);
+#ifdef CONFIG_MTD_NAND_BBT
+#  define      nand_checkblock(n,b) (NAND_ISBAD(n,b) ? BADBLOCK : GOODBLOCK)
+static void    nand_markbad(FAR struct nand_dev_s *nand, off_t block);
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+static int     nand_bbtload(FAR struct nand_dev_s *nand);
+static int     nand_bbtsave(FAR struct nand_dev_s *nand);
+#endif
+#else
+#  define      nand_checkblock(n,b) nand_checkmarker(n,b)
+#endif
+#if defined(CONFIG_MTD_NAND_BBT) || \
+   (defined(CONFIG_DEBUG_INFO) && defined(CONFIG_DEBUG_FS))
 static int     nand_devscan(FAR struct nand_dev_s *nand);
 #else
+#  define      nand_devscan(n) (0)
+#endif
+#else
 #  define      nand_checkblock(n,b) (GOODBLOCK)
 #  define      nand_devscan(n) (0)
 #endif
@@ -144,7 +194,6 @@ static int     nand_ioctl(struct mtd_dev_s *dev, int cmd,
 
 static int nand_lock(FAR struct nand_dev_s *nand)
 {
-  int errcode;
   int ret;
 
   ret = nxsem_wait(&nand->exclsem);
@@ -153,10 +202,10 @@ static int nand_lock(FAR struct nand_dev_s *nand)
 }
 
 /****************************************************************************
- * Name: nand_checkblock
+ * Name: nand_checkmarker
  *
  * Description:
- *   Read and check for a bad block.
+ *   Read and check the bad block markers of a block.
  *
  * Input Parameters:
  *   nand  - Pointer to a struct nand_dev_s instance.
@@ -170,7 +219,7 @@ static int nand_lock(FAR struct nand_dev_s *nand)
  ****************************************************************************/
 
 #ifdef CONFIG_MTD_NAND_BLOCKCHECK
-static int nand_checkblock(FAR struct nand_dev_s *nand, off_t block)
+static int nand_checkmarker(FAR struct nand_dev_s *nand, off_t block)
 {
   uint8_t spare[CONFIG_MTD_NAND_MAXPAGESPARESIZE];
   FAR const struct nand_scheme_s *scheme;
@@ -223,16 +272,176 @@ static int nand_checkblock(FAR struct nand_dev_s *nand, off_t block)
 }
 #endif /* CONFIG_MTD_NAND_BLOCKCHECK */
 
+/****************************************************************************
+ * Name: nand_markbad
+ *
+ * Description:
+ *   Mark a block as bad in the bad block table and update the table in
+ *   FLASH, if so configured.
+ *
+ * Input Parameters:
+ *   nand  - Pointer to a struct nand_dev_s instance.
+ *   block - Number of the bad block
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_BBT
+static void nand_markbad(FAR struct nand_dev_s *nand, off_t block)
+{
+  NAND_SETBAD(nand, block);
+
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+  if (nand_bbtsave(nand) < 0)
+    {
+      ferr("ERROR: Failed to save the bad block table\n");
+    }
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: nand_bbtload
+ *
+ * Description:
+ *   Load the bad block table from the table block.
+ *
+ * Input Parameters:
+ *   nand - Pointer to a struct nand_dev_s instance.
+ *
+ * Returned Value:
+ *   OK if a valid table was loaded; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+static int nand_bbtload(FAR struct nand_dev_s *nand)
+{
+  FAR struct nand_raw_s *raw = nand->raw;
+  FAR struct nand_bbthdr_s *hdr;
+  FAR uint8_t *buffer;
+  unsigned int pagesize;
+  size_t tblsize;
+  int ret;
+
+  pagesize = nandmodel_getpagesize(&raw->model);
+  tblsize  = NAND_BBTSIZE(nand);
+
+  if (sizeof(struct nand_bbthdr_s) + tblsize > pagesize)
+    {
+      return -ENOSPC;
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(pagesize);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The table is written without ECC.  Any bit error is caught by the CRC
+   * and just causes the markers to be scanned again.
+   */
+
+  ret = NAND_RAWREAD(raw, NAND_BBTBLOCK(nand), 0, buffer, NULL);
+  if (ret >= 0)
+    {
+      hdr = (FAR struct nand_bbthdr_s *)buffer;
+      if (memcmp(hdr->magic, NAND_BBT_MAGIC, 4) != 0 ||
+          hdr->nblocks != NAND_BBTBLOCK(nand) + 1 ||
+          hdr->crc != crc32(&buffer[sizeof(struct nand_bbthdr_s)], tblsize))
+        {
+          ret = -ENOENT;
+        }
+      else
+        {
+          memcpy(nand->bbt, &buffer[sizeof(struct nand_bbthdr_s)], tblsize);
+          ret = OK;
+        }
+    }
+
+  kmm_free(buffer);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: nand_bbtsave
+ *
+ * Description:
+ *   Erase the table block and write the current bad block table into it.
+ *
+ * Input Parameters:
+ *   nand - Pointer to a struct nand_dev_s instance.
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+static int nand_bbtsave(FAR struct nand_dev_s *nand)
+{
+  FAR struct nand_raw_s *raw = nand->raw;
+  FAR struct nand_bbthdr_s *hdr;
+  FAR uint8_t *buffer;
+  unsigned int pagesize;
+  size_t tblsize;
+  int ret;
+
+  pagesize = nandmodel_getpagesize(&raw->model);
+  tblsize  = NAND_BBTSIZE(nand);
+
+  /* The table can only be saved if it fits in one page and if the table
+   * block is itself good.
+   */
+
+  if (sizeof(struct nand_bbthdr_s) + tblsize > pagesize ||
+      NAND_ISBAD(nand, NAND_BBTBLOCK(nand)))
+    {
+      return -ENOSPC;
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(pagesize);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(buffer, 0xff, pagesize);
+  hdr          = (FAR struct nand_bbthdr_s *)buffer;
+  memcpy(hdr->magic, NAND_BBT_MAGIC, 4);
+  hdr->nblocks = NAND_BBTBLOCK(nand) + 1;
+  hdr->crc     = crc32(nand->bbt, tblsize);
+  memcpy(&buffer[sizeof(struct nand_bbthdr_s)], nand->bbt, tblsize);
+
+  /* Use the raw interfaces so that a failure here does not try to mark the
+   * table block as bad.
+   */
+
+  ret = NAND_ERASEBLOCK(raw, NAND_BBTBLOCK(nand));
+  if (ret >= 0)
+    {
+      ret = NAND_RAWWRITE(raw, NAND_BBTBLOCK(nand), 0, buffer, NULL);
+    }
+
+  kmm_free(buffer);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: nand_devscan
  *
  * Description:
  *   Scans the device to retrieve or create block status information.
  *
- *   Currently, this functin does nothing but scan the NAND and eat up time.
- *   This is a goot thing to do if you are debugging NAND, but otherwise,
- *   just a waste of time.  This logic could, however, be integrated into
- *   some bad block checking logic at sometime in the future.
+ *   Without CONFIG_MTD_NAND_BBT, this functin does nothing but scan the NAND
+ *   and eat up time.  This is a goot thing to do if you are debugging NAND,
+ *   but otherwise, just a waste of time.  With CONFIG_MTD_NAND_BBT, this
+ *   builds the bad block table (unless a valid table can be loaded from
+ *   FLASH).
  *
  * Input Parameters:
  *   nand - Pointer to a struct nand_dev_s instance.
@@ -242,8 +451,8 @@ static int nand_checkblock(FAR struct nand_dev_s *nand, off_t block)
  *
  ****************************************************************************/
 
-#if defined(CONFIG_MTD_NAND_BLOCKCHECK) && defined(CONFIG_DEBUG_INFO) && \
-    defined(CONFIG_DEBUG_FS)
+#if defined(CONFIG_MTD_NAND_BLOCKCHECK) && (defined(CONFIG_MTD_NAND_BBT) || \
+    (defined(CONFIG_DEBUG_INFO) && defined(CONFIG_DEBUG_FS)))
 static int nand_devscan(FAR struct nand_dev_s *nand)
 {
   FAR struct nand_raw_s *raw;
@@ -265,6 +474,24 @@ static int nand_devscan(FAR struct nand_dev_s *nand)
 
   nblocks = nandmodel_getdevblocks(model);
 
+#ifdef CONFIG_MTD_NAND_BBT
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+  /* Use the table in FLASH if there is a valid one */
+
+  if (nand_bbtload(nand) == OK)
+    {
+      finfo("Loaded bad block table\n");
+      return OK;
+    }
+
+  nblocks = NAND_BBTBLOCK(nand) + 1;
+#else
+  nblocks = NAND_NBLOCKS(nand);
+#endif
+
+  memset(nand->bbt, 0, sizeof(nand->bbt));
+#endif
+
   /* Initialize block statuses */
 
   finfo("Retrieving bad block information. nblocks=%d\n", nblocks);
@@ -279,9 +506,14 @@ static int nand_devscan(FAR struct nand_dev_s *nand)
     {
       /* Read spare of first page */
 
-      ret = nand_checkblock(nand, block);
+      ret = nand_checkmarker(nand, block);
       if (ret != GOODBLOCK)
         {
+#ifdef CONFIG_MTD_NAND_BBT
+          /* Blocks that cannot be checked are not used either */
+
+          NAND_SETBAD(nand, block);
+#endif
 #if defined(CONFIG_DEBUG_INFO) && defined(CONFIG_DEBUG_FS)
           if (ngood > 0)
             {
@@ -319,9 +551,19 @@ static int nand_devscan(FAR struct nand_dev_s *nand)
     }
 #endif
 
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+  /* Save the new table so that the scan is not needed next time */
+
+  ret = nand_bbtsave(nand);
+  if (ret < 0)
+    {
+      fwarn("WARNING: Bad block table not saved: %d\n", ret);
+    }
+#endif
+
   return OK;
 }
-#endif /* CONFIG_MTD_NAND_BLOCKCHECK &&  CONFIG_DEBUG_INFO && CONFIG_DEBUG_FS */
+#endif /* CONFIG_MTD_NAND_BLOCKCHECK && (CONFIG_MTD_NAND_BBT || DEBUG) */
 
 /****************************************************************************
  * Name: nand_chipid
@@ -426,6 +668,14 @@ static int nand_eraseblock(FAR struct nand_dev_s *nand, off_t block,
         {
           ferr("ERROR: Failed bo marke block %ld as BAD\n", (long)block);
         }
+
+#ifdef CONFIG_MTD_NAND_BBT
+      /* Don't use the block again, even if the marker could not be
+       * written.
+       */
+
+      nand_markbad(nand, block);
+#endif
     }
 
   return ret;
@@ -556,6 +806,12 @@ static int nand_erase(struct mtd_dev_s *dev, off_t startblock,
 
   finfo("startblock: %08lx nblocks: %d\n", (long)startblock, (int)nblocks);
 
+  if (startblock + nblocks > NAND_NBLOCKS(nand))
+    {
+      ferr("ERROR: Erase beyond the end of FLASH\n");
+      return -ESPIPE;
+    }
+
   /* Lock access to the NAND until we complete the erase */
 
   nand_lock(nand);
@@ -615,7 +871,7 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
 
   pagesperblock = nandmodel_pagesperblock(model);
   pagesize      = nandmodel_getpagesize(model);
-  maxblock      = nandmodel_getdevblocks(model);
+  maxblock      = NAND_NBLOCKS(nand);
 
   /* Get the block and page offset associated with the startpage */
 
@@ -632,7 +888,7 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
     {
       /* Check for attempt to read beyond the end of NAND */
 
-      if (block > maxblock)
+      if (block >= maxblock)
         {
           ferr("ERROR: Read beyond the end of FLASH, block=%ld\n",
                (long)block);
@@ -711,7 +967,7 @@ static ssize_t nand_bwrite(struct mtd_dev_s *dev, off_t startpage,
 
   pagesperblock = nandmodel_pagesperblock(model);
   pagesize      = nandmodel_getpagesize(model);
-  maxblock      = nandmodel_getdevblocks(model);
+  maxblock      = NAND_NBLOCKS(nand);
 
   /* Get the block and page offset associated with the startpage */
 
@@ -728,7 +984,7 @@ static ssize_t nand_bwrite(struct mtd_dev_s *dev, off_t startpage,
     {
       /* Check for attempt to write beyond the end of NAND */
 
-      if (block > maxblock)
+      if (block >= maxblock)
         {
           ferr("ERROR: Write beyond the end of FLASH, block=%ld\n",
                (long)block);
@@ -803,7 +1059,7 @@ static int nand_ioctl(struct mtd_dev_s *dev, int cmd, unsigned long arg)
 
               geo->blocksize    = model->pagesize;
               geo->erasesize    = nandmodel_getbyteblocksize(model);
-              geo->neraseblocks = nandmodel_getdevblocks(model);
+              geo->neraseblocks = NAND_NBLOCKS(nand);
               ret               = OK;
           }
         }
@@ -813,7 +1069,7 @@ static int nand_ioctl(struct mtd_dev_s *dev, int cmd, unsigned long arg)
         {
           /* Erase the entire device */
 
-          ret = nand_erase(dev, 0, nandmodel_getdevblocks(model));
+          ret = nand_erase(dev, 0, NAND_NBLOCKS(nand));
         }
         break;
 
@@ -961,6 +1217,24 @@ FAR struct mtd_dev_s *nand_initialize(FAR struct nand_raw_s *raw)
 
   nxsem_init(&nand->exclsem, 0, 1);
 
+#ifdef CONFIG_MTD_NAND_BBT
+  /* Size the bad block table */
+
+  nand->nblocks = nandmodel_getdevblocks(&raw->model);
+  if (nand->nblocks > CONFIG_MTD_NAND_MAXNUMBLOCKS)
+    {
+      fwarn("WARNING: Only %d of %ld blocks used\n",
+            CONFIG_MTD_NAND_MAXNUMBLOCKS, (long)nand->nblocks);
+      nand->nblocks = CONFIG_MTD_NAND_MAXNUMBLOCKS;
+    }
+
+#ifdef CONFIG_MTD_NAND_BBT_PERSIST
+  /* Reserve the last block for the table */
+
+  nand->nblocks--;
+#endif
+#endif
+
   /* Scan the device for bad blocks */
 
   (void)nand_devscan(nand);
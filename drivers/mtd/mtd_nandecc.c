@@ -143,9 +143,29 @@ int nandecc_readpage(FAR struct nand_dev_s *nand, off_t block,
   scheme = nandmodel_getscheme(model);
   nandscheme_readecc(scheme, spare, raw->ecc);
 
-  /* Use the ECC data to verify the page */
+  /* Use the ECC data to verify the page.  If the lower half has an ECC
+   * engine, let it compute the codes of the data and then just correct the
+   * data here.
+   */
+
+  if (raw->calcecc != NULL)
+    {
+      uint8_t computed[CONFIG_MTD_NAND_MAXSPAREECCBYTES];
+
+      ret = NAND_CALCECC(raw, data, pagesize, computed);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to compute ECC: %d\n", ret);
+          return ret;
+        }
+
+      ret = hamming_correct256x(data, pagesize, computed, raw->ecc);
+    }
+  else
+    {
+      ret = hamming_verify256x(data, pagesize, raw->ecc);
+    }
 
-  ret = hamming_verify256x(data, pagesize, raw->ecc);
   if (ret && (ret != HAMMING_ERROR_SINGLEBIT))
     {
       ferr("ERROR: Block=%d page=%d Unrecoverable error: %d\n",
@@ -210,9 +230,23 @@ int nandecc_writepage(FAR struct nand_dev_s *nand, off_t block,
 
   if (data)
     {
-      /* Compute hamming code on data */
-
-      hamming_compute256x(data, pagesize, raw->ecc);
+      /* Compute hamming code on data, using the ECC engine if there is
+       * one.
+       */
+
+      if (raw->calcecc != NULL)
+        {
+          ret = NAND_CALCECC(raw, data, pagesize, raw->ecc);
+          if (ret < 0)
+            {
+              ferr("ERROR: Failed to compute ECC: %d\n", ret);
+              return ret;
+            }
+        }
+      else
+        {
+          hamming_compute256x(data, pagesize, raw->ecc);
+        }
     }
 
   /* Store code in spare buffer, either the buffer provided by the caller or
@@ -59,6 +59,8 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -131,6 +133,22 @@
 #  define CONFIG_MTD_SMART_SECTOR_SIZE 1024
 #endif
 
+#ifdef CONFIG_MTD_SMART_BGGC
+#  ifndef CONFIG_MTD_SMART_BGGC_LOWATER
+#    define CONFIG_MTD_SMART_BGGC_LOWATER 10
+#  endif
+#  ifndef CONFIG_MTD_SMART_BGGC_HIWATER
+#    define CONFIG_MTD_SMART_BGGC_HIWATER 20
+#  endif
+
+/* Free sector watermarks at which background collection starts and stops */
+
+#  define SMART_BGGC_LOWATER(d) \
+     ((uint32_t)(d)->totalsectors * CONFIG_MTD_SMART_BGGC_LOWATER / 100)
+#  define SMART_BGGC_HIWATER(d) \
+     ((uint32_t)(d)->totalsectors * CONFIG_MTD_SMART_BGGC_HIWATER / 100)
+#endif
+
 #ifndef offsetof
 #define offsetof(type, member) ( (size_t) &( ( (type *) 0)->member))
 #endif
@@ -275,6 +293,10 @@ struct smart_struct_s
   size_t                bytesalloc;
   struct smart_alloc_s  alloc[SMART_MAX_ALLOCS];   /* Array of memory allocations */
 #endif
+#ifdef CONFIG_MTD_SMART_BGGC
+  sem_t                 exclsem;          /* Serializes foreground and background access */
+  struct work_s         gcwork;           /* Background garbage collection work */
+#endif
 };
 
 #define SMART_WEARFLAGS_FORCE_REORG    0x01
@@ -373,6 +395,15 @@ static ssize_t smart_write(FAR struct inode *inode, const unsigned char *buffer,
 #endif
 static int     smart_geometry(FAR struct inode *inode, struct geometry *geometry);
 static int     smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg);
+#ifdef CONFIG_MTD_SMART_BGGC
+static ssize_t smart_lockedread(FAR struct inode *inode, unsigned char *buffer,
+                 size_t start_sector, unsigned int nsectors);
+static ssize_t smart_lockedwrite(FAR struct inode *inode,
+                 const unsigned char *buffer, size_t start_sector,
+                 unsigned int nsectors);
+static int     smart_lockedioctl(FAR struct inode *inode, int cmd,
+                 unsigned long arg);
+#endif
 
 static int smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t canrelocate);
 
@@ -405,16 +436,23 @@ static int     smart_loop_ioctl(FAR struct file *filep, int cmd, unsigned long a
 
 static const struct block_operations g_bops =
 {
-  smart_open,     /* open     */
-  smart_close,    /* close    */
-  smart_read,     /* read     */
+  smart_open,        /* open     */
+  smart_close,       /* close    */
+#ifdef CONFIG_MTD_SMART_BGGC
+  smart_lockedread,  /* read     */
+  smart_lockedwrite, /* write    */
+  smart_geometry,    /* geometry */
+  smart_lockedioctl  /* ioctl    */
+#else
+  smart_read,        /* read     */
 #ifdef CONFIG_FS_WRITABLE
-  smart_write,    /* write    */
+  smart_write,       /* write    */
 #else
-  NULL,           /* write    */
+  NULL,              /* write    */
+#endif
+  smart_geometry,    /* geometry */
+  smart_ioctl        /* ioctl    */
 #endif
-  smart_geometry, /* geometry */
-  smart_ioctl     /* ioctl    */
 };
 
 #ifdef CONFIG_SMART_DEV_LOOP
@@ -3735,30 +3773,121 @@ retry:
 }
 
 /****************************************************************************
- * Name: smart_garbagecollect
+ * Name: smart_collectblock
  *
- * Description:  Performs garbage collection if needed.  This is determined
- *               by the count of released sectors relative to free and
- *               total sectors.
+ * Description:  Selects the erase block with the most released sectors and
+ *               relocates its active sectors so that the block can be
+ *               erased and its sectors returned to the free pool.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_FS_WRITABLE
-static int smart_garbagecollect(FAR struct smart_struct_s *dev)
+static int smart_collectblock(FAR struct smart_struct_s *dev)
 {
   uint16_t  collectblock;
   uint16_t  releasemax;
-  bool      collect = TRUE;
   int       x;
   int       ret;
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
   uint8_t   count;
 #endif
 
+  /* Find the block with the most released sectors */
+
+  collectblock = 0xffff;
+  releasemax = 0;
+  for (x = 0; x < dev->neraseblocks; x++)
+    {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      /* Don't collect blocks that have been worn completely */
+
+      if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
+        {
+          continue;
+        }
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      count = smart_get_count(dev, dev->releasecount, x);
+      if (count > releasemax)
+        {
+          releasemax = count;
+          collectblock = x;
+        }
+#else
+      if (dev->releasecount[x] > releasemax)
+        {
+          releasemax = dev->releasecount[x];
+          collectblock = x;
+        }
+#endif
+    }
+
+  //releasemax = smart_get_count(dev, dev->releasecount, collectblock);
+
+  if (collectblock == 0xffff)
+    {
+      /* Need to collect, but no sectors with released blocks! */
+
+      return -ENOSPC;
+    }
+
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+  if (smart_checkfree(dev, __LINE__) != OK)
+    {
+      fwarn("   ...before collecting block %d\n", collectblock);
+    }
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+  finfo("Collecting block %d, free=%d released=%d, totalfree=%d, totalrelease=%d\n",
+      collectblock, smart_get_count(dev, dev->freecount, collectblock),
+      smart_get_count(dev, dev->releasecount, collectblock), dev->freesectors, dev->releasesectors);
+#else
+  finfo("Collecting block %d, free=%d released=%d\n",
+      collectblock, dev->freecount[collectblock],
+      dev->releasecount[collectblock]);
+#endif
+
+  /* Relocate the active data in the collection block */
+
+  ret = smart_relocate_block(dev, collectblock);
+
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+  if (smart_checkfree(dev, __LINE__) != OK)
+    {
+      fwarn("   ...while collecting block %d\n", collectblock);
+    }
+#endif
+
+  return ret;
+}
+#endif /* CONFIG_FS_WRITABLE */
+
+/****************************************************************************
+ * Name: smart_garbagecollect
+ *
+ * Description:  Performs garbage collection if needed.  This is determined
+ *               by the count of released sectors relative to free and
+ *               total sectors.
+ *
+ *               With CONFIG_MTD_SMART_BGGC, routine collection is left to
+ *               the background worker and only the reserve limit causes
+ *               collection here.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static int smart_garbagecollect(FAR struct smart_struct_s *dev)
+{
+  bool      collect = TRUE;
+  int       ret;
+
   while (collect)
     {
       collect = FALSE;
 
+#ifndef CONFIG_MTD_SMART_BGGC
       /* Test if the released sectors count is greater than the
        * free sectors.  If it is, then we will do garbage collection.
        */
@@ -3768,6 +3897,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
         {
           collect = TRUE;
         }
+#endif
 
       /* Test if we have more reached our reserved free sector limit */
 
@@ -3780,88 +3910,73 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 
       if (collect)
         {
-          /* Find the block with the most released sectors */
-
-          collectblock = 0xffff;
-          releasemax = 0;
-          for (x = 0; x < dev->neraseblocks; x++)
+          ret = smart_collectblock(dev);
+          if (ret != OK)
             {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-              /* Don't collect blocks that have been worn completely */
-
-              if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
-                {
-                  continue;
-                }
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-              count = smart_get_count(dev, dev->releasecount, x);
-              if (count > releasemax)
-                {
-                  releasemax = count;
-                  collectblock = x;
-                }
-#else
-              if (dev->releasecount[x] > releasemax)
-                {
-                  releasemax = dev->releasecount[x];
-                  collectblock = x;
-                }
-#endif
+              return ret;
             }
+        }
+    }
 
-          //releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-
-          if (collectblock == 0xffff)
-            {
-              /* Need to collect, but no sectors with released blocks! */
-
-              ret = -ENOSPC;
-              goto errout;
-            }
+  return OK;
+}
+#endif /* CONFIG_FS_WRITABLE */
 
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-          if (smart_checkfree(dev, __LINE__) != OK)
-            {
-              fwarn("   ...before collecting block %d\n", collectblock);
-            }
-#endif
+/****************************************************************************
+ * Name: smart_bggc_worker
+ *
+ * Description:  Background garbage collection.  Runs on the low priority
+ *               work queue and collects one erase block per pass so that
+ *               the device lock is never held for longer than a single
+ *               block relocation.  The work requeues itself until the high
+ *               watermark is reached or nothing more can be reclaimed.
+ *
+ ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-          finfo("Collecting block %d, free=%d released=%d, totalfree=%d, totalrelease=%d\n",
-              collectblock, smart_get_count(dev, dev->freecount, collectblock),
-              smart_get_count(dev, dev->releasecount, collectblock), dev->freesectors, dev->releasesectors);
-#else
-          finfo("Collecting block %d, free=%d released=%d\n",
-              collectblock, dev->freecount[collectblock],
-              dev->releasecount[collectblock]);
-#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_bggc_worker(FAR void *arg)
+{
+  FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+  bool again = false;
 
-          /* Relocate the active data in the collection block */
+  nxsem_wait_uninterruptible(&dev->exclsem);
 
-          ret = smart_relocate_block(dev, collectblock);
+  if (dev->formatstatus == SMART_FMT_STAT_FORMATTED &&
+      dev->releasesectors > 0 &&
+      dev->freesectors < SMART_BGGC_HIWATER(dev))
+    {
+      if (smart_collectblock(dev) == OK)
+        {
+          again = dev->freesectors < SMART_BGGC_HIWATER(dev);
+        }
+    }
 
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-          if (smart_checkfree(dev, __LINE__) != OK)
-            {
-              fwarn("   ...while collecting block %d\n", collectblock);
-            }
-#endif
+  nxsem_post(&dev->exclsem);
 
-          if (ret != OK)
-            {
-              goto errout;
-            }
-        }
+  if (again)
+    {
+      (void)work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev, 0);
     }
+}
 
-  return OK;
+/****************************************************************************
+ * Name: smart_bggc_schedule
+ *
+ * Description:  Start background garbage collection if the free sectors
+ *               have dropped below the low watermark.  Called with the
+ *               device lock held.
+ *
+ ****************************************************************************/
 
-errout:
-  return ret;
+static void smart_bggc_schedule(FAR struct smart_struct_s *dev)
+{
+  if (dev->freesectors < SMART_BGGC_LOWATER(dev) &&
+      dev->releasesectors > 0 && work_available(&dev->gcwork))
+    {
+      (void)work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev, 0);
+    }
 }
-#endif /* CONFIG_FS_WRITABLE */
+#endif /* CONFIG_MTD_SMART_BGGC */
 
 /****************************************************************************
  * Name: smart_write_wearstatus
@@ -5355,6 +5470,102 @@ ok_out:
   return ret;
 }
 
+/****************************************************************************
+ * Name: smart_lockeddev
+ *
+ * Description: Return the SMART device of a block driver inode with the
+ *              device lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static FAR struct smart_struct_s *smart_lockeddev(FAR struct inode *inode)
+{
+  FAR struct smart_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+  dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+  nxsem_wait_uninterruptible(&dev->exclsem);
+  return dev;
+}
+
+/****************************************************************************
+ * Name: smart_lockedread
+ *
+ * Description: smart_read() serialized against background collection
+ *
+ ****************************************************************************/
+
+static ssize_t smart_lockedread(FAR struct inode *inode, unsigned char *buffer,
+                                size_t start_sector, unsigned int nsectors)
+{
+  FAR struct smart_struct_s *dev = smart_lockeddev(inode);
+  ssize_t ret;
+
+  ret = smart_read(inode, buffer, start_sector, nsectors);
+  nxsem_post(&dev->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: smart_lockedwrite
+ *
+ * Description: smart_write() serialized against background collection
+ *
+ ****************************************************************************/
+
+static ssize_t smart_lockedwrite(FAR struct inode *inode,
+                                 const unsigned char *buffer,
+                                 size_t start_sector, unsigned int nsectors)
+{
+  FAR struct smart_struct_s *dev = smart_lockeddev(inode);
+  ssize_t ret;
+
+  ret = smart_write(inode, buffer, start_sector, nsectors);
+  smart_bggc_schedule(dev);
+  nxsem_post(&dev->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: smart_lockedioctl
+ *
+ * Description: smart_ioctl() serialized against background collection.
+ *              Sector writes, allocations and releases may start background
+ *              collection.
+ *
+ ****************************************************************************/
+
+static int smart_lockedioctl(FAR struct inode *inode, int cmd,
+                             unsigned long arg)
+{
+  FAR struct smart_struct_s *dev = smart_lockeddev(inode);
+  int ret;
+
+  ret = smart_ioctl(inode, cmd, arg);
+
+  switch (cmd)
+    {
+    case BIOC_WRITESECT:
+    case BIOC_ALLOCSECT:
+    case BIOC_FREESECT:
+      smart_bggc_schedule(dev);
+      break;
+
+    default:
+      break;
+    }
+
+  nxsem_post(&dev->exclsem);
+  return ret;
+}
+#endif /* CONFIG_MTD_SMART_BGGC */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -5399,6 +5610,9 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
       /* Initialize the SMART device structure */
 
       dev->mtd = mtd;
+#ifdef CONFIG_MTD_SMART_BGGC
+      nxsem_init(&dev->exclsem, 0, 1);
+#endif
 
       /* Get the device geometry. (casting to uintptr_t first eliminates
        * complaints on some architectures where the sizeof long is different
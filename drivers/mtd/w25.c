@@ -51,6 +51,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -96,6 +97,9 @@
 #define W25_PURDID                 0xab    /* Release PD, Device ID                 */
 #define W25_RDMFID                 0x90    /* Read Manufacturer / Device            */
 #define W25_JEDEC_ID               0x9f    /* JEDEC ID read                         */
+#define W25_RDSR2                  0x35    /* Read status register 2 (W25Q only)    */
+#define W25_EPS                    0x75    /* Erase/program suspend (W25Q only)     */
+#define W25_EPR                    0x7a    /* Erase/program resume (W25Q only)      */
 
 /* W25 Registers ********************************************************************/
 /* Read ID (RDID) register values */
@@ -176,6 +180,15 @@
                                              /* Bit 6: Reserved */
 #define W25_SR_SRP                 (1 << 7)  /* Bit 7: Status register write protect */
 
+#define W25_SR2_SUS                (1 << 7)  /* Bit 7: Erase/program suspended */
+
+/* Time from a suspend instruction to the part being ready for a read (tSUS).  The
+ * same interval must elapse after a resume before the next suspend so that the
+ * erase makes progress.
+ */
+
+#define W25_TSUS_USEC              20
+
 #define W25_DUMMY                  0xa5
 
 /* Chip Geometries ******************************************************************/
@@ -227,6 +240,11 @@ struct w25_dev_s
   uint16_t              nsectors;    /* Number of erase sectors */
   uint8_t               prev_instr;  /* Previous instruction given to W25 device */
 
+#ifdef CONFIG_W25_ERASESUSPEND
+  bool                  suspend;     /* True: Part supports erase suspend */
+  off_t                 eaddr;       /* Address of the sector being erased */
+#endif
+
 #if defined(CONFIG_W25_SECTOR512) && !defined(CONFIG_W25_READONLY)
   uint8_t               flags;       /* Buffered sector flags */
   uint16_t              esectno;     /* Erase sector number in the cache*/
@@ -249,6 +267,12 @@ static void w25_unprotect(FAR struct w25_dev_s *priv);
 static uint8_t w25_waitwritecomplete(FAR struct w25_dev_s *priv);
 static inline void w25_wren(FAR struct w25_dev_s *priv);
 static inline void w25_wrdi(FAR struct w25_dev_s *priv);
+#ifdef CONFIG_W25_ERASESUSPEND
+static uint8_t w25_rdsr(FAR struct w25_dev_s *priv, uint8_t cmd);
+static bool w25_erasesuspend(FAR struct w25_dev_s *priv, off_t address,
+                             size_t nbytes);
+static void w25_eraseresume(FAR struct w25_dev_s *priv);
+#endif
 static bool w25_is_erased(struct w25_dev_s *priv, off_t address, off_t size);
 static void w25_sectorerase(FAR struct w25_dev_s *priv, off_t offset);
 static inline int w25_chiperase(FAR struct w25_dev_s *priv);
@@ -433,6 +457,11 @@ static inline int w25_readid(struct w25_dev_s *priv)
           return -ENODEV;
         }
 
+#ifdef CONFIG_W25_ERASESUSPEND
+      /* Only the W25Q parts support the erase suspend/resume instructions */
+
+      priv->suspend = (memory != W25X_JEDEC_MEMORY_TYPE);
+#endif
       return OK;
     }
 
@@ -569,6 +598,97 @@ static inline void w25_wrdi(struct w25_dev_s *priv)
   SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
 }
 
+/************************************************************************************
+ * Name:  w25_rdsr
+ ************************************************************************************/
+
+#ifdef CONFIG_W25_ERASESUSPEND
+static uint8_t w25_rdsr(FAR struct w25_dev_s *priv, uint8_t cmd)
+{
+  uint8_t status;
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  (void)SPI_SEND(priv->spi, cmd);
+  status = SPI_SEND(priv->spi, W25_DUMMY);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+  return status;
+}
+#endif
+
+/************************************************************************************
+ * Name:  w25_erasesuspend
+ *
+ * Description:
+ *   A sector erase takes tens of milliseconds.  If one is still in progress and
+ *   the caller wants to read outside of the sector being erased, suspend the
+ *   erase rather than waiting for it to complete.  Returns true if the erase was
+ *   suspended; w25_eraseresume() must then be called after the read.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_W25_ERASESUSPEND
+static bool w25_erasesuspend(FAR struct w25_dev_s *priv, off_t address,
+                             size_t nbytes)
+{
+  /* Only sector erases are suspended.  Reads from the sector being erased must
+   * wait for the erase to complete.
+   */
+
+  if (!priv->suspend || priv->prev_instr != W25_SE ||
+      (address < priv->eaddr + W25_SECTOR_SIZE &&
+       address + (off_t)nbytes > priv->eaddr))
+    {
+      return false;
+    }
+
+  /* Nothing to do if the erase has already completed */
+
+  if ((w25_rdsr(priv, W25_RDSR) & W25_SR_BUSY) == 0)
+    {
+      priv->prev_instr = W25_RDSR;
+      return false;
+    }
+
+  /* Send the "Erase/Program Suspend" instruction */
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  (void)SPI_SEND(priv->spi, W25_EPS);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+  priv->prev_instr = W25_EPS;
+
+  /* BUSY clears within tSUS once the erase is suspended (or has completed) */
+
+  while ((w25_rdsr(priv, W25_RDSR) & W25_SR_BUSY) != 0);
+
+  /* The erase may have completed before the suspend was accepted */
+
+  return (w25_rdsr(priv, W25_RDSR2) & W25_SR2_SUS) != 0;
+}
+#endif
+
+/************************************************************************************
+ * Name:  w25_eraseresume
+ ************************************************************************************/
+
+#ifdef CONFIG_W25_ERASESUSPEND
+static void w25_eraseresume(FAR struct w25_dev_s *priv)
+{
+  /* Send the "Erase/Program Resume" instruction.  The erase is in progress again
+   * so the next operation must wait for it (or suspend it again).
+   */
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  (void)SPI_SEND(priv->spi, W25_EPR);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+  priv->prev_instr = W25_SE;
+
+  /* Let the erase make progress before it can be suspended again */
+
+  up_udelay(W25_TSUS_USEC);
+}
+#endif
+
 /************************************************************************************
  * Name:  w25_is_erased
  ************************************************************************************/
@@ -653,6 +773,9 @@ static void w25_sectorerase(struct w25_dev_s *priv, off_t sector)
 
   (void)SPI_SEND(priv->spi, W25_SE);
   priv->prev_instr = W25_SE;
+#ifdef CONFIG_W25_ERASESUSPEND
+  priv->eaddr      = address;
+#endif
 
   /* Send the sector address high byte first. Only the most significant bits (those
    * corresponding to the sector) have any meaning.
@@ -707,17 +830,28 @@ static void w25_byteread(FAR struct w25_dev_s *priv, FAR uint8_t *buffer,
                            off_t address, size_t nbytes)
 {
   uint8_t status;
+#ifdef CONFIG_W25_ERASESUSPEND
+  bool suspended;
+#endif
 
   finfo("address: %08lx nbytes: %d\n", (long)address, (int)nbytes);
 
-  /* Wait for any preceding write or erase operation to complete. */
+#ifdef CONFIG_W25_ERASESUSPEND
+  /* Suspend an erase in progress elsewhere on the part instead of waiting */
+
+  suspended = w25_erasesuspend(priv, address, nbytes);
+  if (!suspended)
+#endif
+    {
+      /* Wait for any preceding write or erase operation to complete. */
 
-  status = w25_waitwritecomplete(priv);
-  DEBUGASSERT((status & (W25_SR_WEL | W25_SR_BP_MASK)) == 0);
+      status = w25_waitwritecomplete(priv);
+      DEBUGASSERT((status & (W25_SR_WEL | W25_SR_BP_MASK)) == 0);
 
-  /* Make sure that writing is disabled */
+      /* Make sure that writing is disabled */
 
-  w25_wrdi(priv);
+      w25_wrdi(priv);
+    }
 
   /* Select this FLASH part */
 
@@ -752,6 +886,15 @@ static void w25_byteread(FAR struct w25_dev_s *priv, FAR uint8_t *buffer,
   /* Deselect the FLASH */
 
   SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+#ifdef CONFIG_W25_ERASESUSPEND
+  /* Resume the suspended erase */
+
+  if (suspended)
+    {
+      w25_eraseresume(priv);
+    }
+#endif
 }
 
 /************************************************************************************
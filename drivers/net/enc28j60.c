@@ -52,6 +52,7 @@
 #include <string.h>
 #include <debug.h>
 #include <errno.h>
+#include <limits.h>
 
 #include <arpa/inet.h>
 
@@ -64,6 +65,7 @@
 #include <nuttx/net/enc28j60.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/arp.h>
+#include <nuttx/net/napi.h>
 #include <nuttx/net/netdev.h>
 
 #ifdef CONFIG_NET_PKT
@@ -249,7 +251,11 @@ struct enc_driver_s
    * interrupt handler.
    */
 
+#ifdef CONFIG_NETDEV_NAPI
+  struct napi_s         napi;          /* Budgeted polling of interrupt work */
+#else
   struct work_s         irqwork;       /* Interrupt continuation work queue support */
+#endif
   struct work_s         towork;        /* Tx timeout work queue support */
   struct work_s         pollwork;      /* Poll timeout work queue support */
 
@@ -329,7 +335,13 @@ static void enc_txerif(FAR struct enc_driver_s *priv);
 static void enc_rxerif(FAR struct enc_driver_s *priv);
 static void enc_rxdispatch(FAR struct enc_driver_s *priv);
 static void enc_pktif(FAR struct enc_driver_s *priv);
+static int  enc_interrupt_process(FAR struct enc_driver_s *priv, int budget);
+#ifdef CONFIG_NETDEV_NAPI
+static int  enc_napi_poll(FAR struct napi_s *napi, int budget);
+static void enc_napi_irqctl(FAR struct napi_s *napi, bool enable);
+#else
 static void enc_irqworker(FAR void *arg);
+#endif
 static int  enc_interrupt(int irq, FAR void *context, FAR void *arg);
 
 /* Watchdog timer expirations */
@@ -390,7 +402,8 @@ static inline void enc_configspi(FAR struct spi_dev_s *spi)
  * Name: enc_lock
  *
  * Description:
- *   Select the SPI, locking and  re-configuring if necessary
+ *   Take the device lock, then select the SPI, locking and re-configuring
+ *   if necessary
  *
  * Input Parameters:
  *   spi  - Reference to the SPI driver structure
@@ -399,11 +412,20 @@ static inline void enc_configspi(FAR struct spi_dev_s *spi)
  *   None
  *
  * Assumptions:
+ *   The device lock nests inside of the network lock:  The caller must not
+ *   call net_lock() before enc_unlock() unless it already held the network
+ *   lock.
  *
  ****************************************************************************/
 
 static void enc_lock(FAR struct enc_driver_s *priv)
 {
+  /* Serialize with the network's use of d_buf (devif_poll()) and with the
+   * other work on this device.
+   */
+
+  netdev_lock(&priv->dev);
+
   /* Lock the SPI bus in case there are multiple devices competing for the SPI
    * bus.
    */
@@ -424,7 +446,7 @@ static void enc_lock(FAR struct enc_driver_s *priv)
  * Name: enc_unlock
  *
  * Description:
- *   De-select the SPI
+ *   De-select the SPI and release the device lock
  *
  * Input Parameters:
  *   spi  - Reference to the SPI driver structure
@@ -438,9 +460,10 @@ static void enc_lock(FAR struct enc_driver_s *priv)
 
 static inline void enc_unlock(FAR struct enc_driver_s *priv)
 {
-  /* Relinquish the lock on the bus. */
+  /* Relinquish the lock on the bus and on the device. */
 
   SPI_LOCK(priv->spi, false);
+  netdev_unlock(&priv->dev);
 }
 
 /****************************************************************************
@@ -1602,51 +1625,37 @@ static void enc_pktif(FAR struct enc_driver_s *priv)
 }
 
 /****************************************************************************
- * Name: enc_irqworker
+ * Name: enc_interrupt_process
  *
  * Description:
- *   Perform interrupt handling logic outside of the interrupt handler (on
- *   the work queue thread).
+ *   Service pending interrupts until none remain or until 'budget' packets
+ *   have been received.
  *
  * Input Parameters:
- *   arg     - The reference to the driver structure (case to void*)
+ *   priv   - Reference to the driver state structure
+ *   budget - The maximum number of packets to receive
  *
  * Returned Value:
- *   None
+ *   The number of packets received
  *
  * Assumptions:
+ *   The network and the SPI bus are locked.  The global interrupt enable
+ *   bit has been cleared.
  *
  ****************************************************************************/
 
-static void enc_irqworker(FAR void *arg)
+static int enc_interrupt_process(FAR struct enc_driver_s *priv, int budget)
 {
-  FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)arg;
   uint8_t eir;
+  int npkts = 0;
 
-  DEBUGASSERT(priv);
-
-  /* Get exclusive access to both the network and the SPI bus. */
-
-  net_lock();
-  enc_lock(priv);
-
-  /* Disable further interrupts by clearing the global interrupt enable bit.
-   * "After an interrupt occurs, the host controller should clear the global
-   * enable bit for the interrupt pin before servicing the interrupt. Clearing
-   * the enable bit will cause the interrupt pin to return to the non-asserted
-   * state (high). Doing so will prevent the host controller from missing a
-   * falling edge should another interrupt occur while the immediate interrupt
-   * is being serviced."
+  /* Loop until all interrupts have been processed (EIR==0) or until the
+   * receive budget is used up.  Note that there is no infinite loop check...
+   * if there are always pending interrupts, we are just broken.
    */
 
-  enc_bfcgreg(priv, ENC_EIE, EIE_INTIE);
-
-  /* Loop until all interrupts have been processed (EIR==0).  Note that
-   * there is no infinite loop check... if there are always pending interrupts,
-   * we are just broken.
-   */
-
-  while ((eir = enc_rdgreg(priv, ENC_EIR) & EIR_ALLINTS) != 0)
+  while (npkts < budget &&
+         (eir = enc_rdgreg(priv, ENC_EIR) & EIR_ALLINTS) != 0)
     {
       /* Handle interrupts according to interrupt register register bit
        * settings.
@@ -1777,6 +1786,7 @@ static void enc_irqworker(FAR void *arg)
               /* Handle packet receipt */
 
               enc_pktif(priv);
+              npkts++;
             }
         }
 
@@ -1807,6 +1817,135 @@ static void enc_irqworker(FAR void *arg)
         }
     }
 
+  return npkts;
+}
+
+#ifdef CONFIG_NETDEV_NAPI
+/****************************************************************************
+ * Name: enc_napi_poll
+ *
+ * Description:
+ *   NAPI poll method:  Service up to 'budget' received packets.
+ *
+ * Input Parameters:
+ *   napi   - The NAPI instance of the interface
+ *   budget - The maximum number of packets to receive
+ *
+ * Returned Value:
+ *   The number of packets received
+ *
+ * Assumptions:
+ *   Runs on a worker thread with the network locked.
+ *
+ ****************************************************************************/
+
+static int enc_napi_poll(FAR struct napi_s *napi, int budget)
+{
+  FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)napi->priv;
+  int npkts;
+
+  /* Get exclusive access to the SPI bus. */
+
+  enc_lock(priv);
+
+  /* Keep the interrupt pin deasserted while polling by clearing the global
+   * interrupt enable bit.  enc_napi_irqctl() sets it again when the device
+   * goes idle.
+   */
+
+  enc_bfcgreg(priv, ENC_EIE, EIE_INTIE);
+
+  npkts = enc_interrupt_process(priv, budget);
+
+  enc_unlock(priv);
+  return npkts;
+}
+
+/****************************************************************************
+ * Name: enc_napi_irqctl
+ *
+ * Description:
+ *   NAPI interrupt control method.  Masking only disables the GPIO
+ *   interrupt because the SPI bus cannot be used from the interrupt
+ *   handler; the poll method clears the global interrupt enable bit.
+ *   Unmasking restores both.
+ *
+ * Input Parameters:
+ *   napi   - The NAPI instance of the interface
+ *   enable - True: unmask the interrupt; false: mask it
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void enc_napi_irqctl(FAR struct napi_s *napi, bool enable)
+{
+  FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)napi->priv;
+
+  if (enable)
+    {
+      enc_lock(priv);
+
+      /* Enable GPIO interrupts */
+
+      priv->lower->enable(priv->lower);
+
+      /* Enable Ethernet interrupts */
+
+      enc_bfsgreg(priv, ENC_EIE, EIE_INTIE);
+      enc_unlock(priv);
+    }
+  else
+    {
+      priv->lower->disable(priv->lower);
+    }
+}
+
+#else
+/****************************************************************************
+ * Name: enc_irqworker
+ *
+ * Description:
+ *   Perform interrupt handling logic outside of the interrupt handler (on
+ *   the work queue thread).
+ *
+ * Input Parameters:
+ *   arg     - The reference to the driver structure (case to void*)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+static void enc_irqworker(FAR void *arg)
+{
+  FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)arg;
+
+  DEBUGASSERT(priv);
+
+  /* Get exclusive access to both the network and the SPI bus. */
+
+  net_lock();
+  enc_lock(priv);
+
+  /* Disable further interrupts by clearing the global interrupt enable bit.
+   * "After an interrupt occurs, the host controller should clear the global
+   * enable bit for the interrupt pin before servicing the interrupt. Clearing
+   * the enable bit will cause the interrupt pin to return to the non-asserted
+   * state (high). Doing so will prevent the host controller from missing a
+   * falling edge should another interrupt occur while the immediate interrupt
+   * is being serviced."
+   */
+
+  enc_bfcgreg(priv, ENC_EIE, EIE_INTIE);
+
+  /* Process all pending interrupts */
+
+  (void)enc_interrupt_process(priv, INT_MAX);
+
   /* Enable GPIO interrupts */
 
   priv->lower->enable(priv->lower);
@@ -1820,6 +1959,7 @@ static void enc_irqworker(FAR void *arg)
   enc_unlock(priv);
   net_unlock();
 }
+#endif /* CONFIG_NETDEV_NAPI */
 
 /****************************************************************************
  * Name: enc_interrupt
@@ -1852,6 +1992,14 @@ static int enc_interrupt(int irq, FAR void *context, FAR void *arg)
    * a good thing to do in any event.
    */
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Mask the GPIO interrupt and poll the device from the worker thread
+   * until it is idle.
+   */
+
+  napi_schedule(&priv->napi);
+  return OK;
+#else
   DEBUGASSERT(work_available(&priv->irqwork));
 
   /* Notice that further GPIO interrupts are disabled until the work is
@@ -1861,6 +2009,7 @@ static int enc_interrupt(int irq, FAR void *context, FAR void *arg)
 
   priv->lower->disable(priv->lower);
   return work_queue(ENCWORK, &priv->irqwork, enc_irqworker, (FAR void *)priv, 0);
+#endif
 }
 
 /****************************************************************************
@@ -1976,34 +2125,48 @@ static void enc_txtimeout(int argc, uint32_t arg, ...)
 static void enc_pollworker(FAR void *arg)
 {
   FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)arg;
+  bool txidle;
 
   DEBUGASSERT(priv);
 
-  /* Get exclusive access to both the network and the SPI bus. */
-
-  net_lock();
-  enc_lock(priv);
-
   /* Verify that the hardware is ready to send another packet.  The driver
    * start a transmission process by setting ECON1.TXRTS. When the packet is
    * finished transmitting or is aborted due to an error/cancellation, the
    * ECON1.TXRTS bit will be cleared.
+   *
+   * Only the device and the SPI bus are needed for this, so that a busy
+   * transmitter does not hold up the rest of the network.
    */
 
-  if ((enc_rdgreg(priv, ENC_ECON1) & ECON1_TXRTS) == 0)
+  enc_lock(priv);
+  txidle = (enc_rdgreg(priv, ENC_ECON1) & ECON1_TXRTS) == 0;
+  enc_unlock(priv);
+
+  if (txidle)
     {
-      /* Yes.. update TCP timing states and poll the network for new XMIT data. Hmmm..
-       * looks like a bug here to me.  Does this mean if there is a transmit
-       * in progress, we will missing TCP time state updates?
+      /* Get exclusive access to both the network and the SPI bus.  A
+       * transmission may have been started while the device was unlocked.
        */
 
-      (void)devif_timer(&priv->dev, enc_txpoll);
-    }
+      net_lock();
+      enc_lock(priv);
 
-  /* Release lock on the SPI bus and the network */
+      if ((enc_rdgreg(priv, ENC_ECON1) & ECON1_TXRTS) == 0)
+        {
+          /* Yes.. update TCP timing states and poll the network for new XMIT
+           * data. Hmmm.. looks like a bug here to me.  Does this mean if
+           * there is a transmit in progress, we will missing TCP time state
+           * updates?
+           */
 
-  enc_unlock(priv);
-  net_unlock();
+          (void)devif_timer(&priv->dev, enc_txpoll);
+        }
+
+      /* Release lock on the SPI bus and the network */
+
+      enc_unlock(priv);
+      net_unlock();
+    }
 
   /* Setup the watchdog poll timer again */
 
@@ -2163,6 +2326,12 @@ static int enc_ifdown(struct net_driver_s *dev)
   wd_cancel(priv->txpoll);
   wd_cancel(priv->txtimeout);
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Cancel any pending receive poll */
+
+  napi_cancel(&priv->napi);
+#endif
+
   /* Reset the device and leave in the power save state */
 
   ret = enc_reset(priv);
@@ -2645,6 +2814,10 @@ int enc_initialize(FAR struct spi_dev_s *spi,
   priv->txtimeout    = wd_create();   /* Create TX timeout timer */
   priv->spi          = spi;           /* Save the SPI instance */
   priv->lower        = lower;         /* Save the low-level MCU interface */
+#ifdef CONFIG_NETDEV_NAPI
+  napi_initialize(&priv->napi, &priv->dev, ENCWORK, 0, enc_napi_poll,
+                  enc_napi_irqctl, priv);
+#endif
 
   /* The interface should be in the down state.  However, this function is called
    * too early in initialization to perform the ENC28J60 reset in enc_ifdown.  We
@@ -42,6 +42,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <limits.h>
 
 #include <nuttx/arch.h>
 #include <nuttx/irq.h>
@@ -51,6 +52,7 @@
 
 #include <nuttx/net/arp.h>
 #include <nuttx/net/lan91c111.h>
+#include <nuttx/net/napi.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/pkt.h>
 
@@ -105,7 +107,11 @@ struct lan91c111_driver_s
   int       irq;            /* IRQ number */
   uint16_t  bank;           /* Current bank */
   WDOG_ID txpoll;           /* TX poll timer */
+#ifdef CONFIG_NETDEV_NAPI
+  struct napi_s napi;       /* Budgeted polling of interrupt work */
+#else
   struct work_s irqwork;    /* For deferring interrupt work to the work queue */
+#endif
   struct work_s pollwork;   /* For deferring poll work to the work queue */
   uint8_t pktbuf[MAX_NETDEV_PKTSIZE + 4]; /* +4 due to getregs32/putregs32 */
 
@@ -129,7 +135,14 @@ static void lan91c111_reply(FAR struct net_driver_s *dev);
 static void lan91c111_receive(FAR struct net_driver_s *dev);
 static void lan91c111_txdone(FAR struct net_driver_s *dev);
 
+static int  lan91c111_interrupt_process(FAR struct net_driver_s *dev,
+                                        int budget);
+#ifdef CONFIG_NETDEV_NAPI
+static int  lan91c111_napi_poll(FAR struct napi_s *napi, int budget);
+static void lan91c111_napi_irqctl(FAR struct napi_s *napi, bool enable);
+#else
 static void lan91c111_interrupt_work(FAR void *arg);
+#endif
 static int  lan91c111_interrupt(int irq, FAR void *context, FAR void *arg);
 
 /* Watchdog timer expirations */
@@ -854,39 +867,34 @@ static void lan91c111_phy_notify(FAR struct net_driver_s *dev)
 }
 
 /****************************************************************************
- * Name: lan91c111_interrupt_work
+ * Name: lan91c111_interrupt_process
  *
  * Description:
- *   Perform interrupt related work from the worker thread
+ *   Service pending Ethernet interrupts until none remain or until 'budget'
+ *   packets have been received.
  *
  * Parameters:
- *   arg - The argument passed when work_queue() was called.
+ *   dev    - Reference to the NuttX driver state structure
+ *   budget - The maximum number of packets to receive
  *
  * Returned Value:
- *   OK on success
+ *   The number of packets received
  *
  * Assumptions:
- *   Runs on a worker thread.
+ *   The network is locked.
  *
  ****************************************************************************/
 
-static void lan91c111_interrupt_work(FAR void *arg)
+static int lan91c111_interrupt_process(FAR struct net_driver_s *dev,
+                                       int budget)
 {
-  FAR struct net_driver_s *dev = arg;
   FAR struct lan91c111_driver_s *priv = dev->d_private;
   uint8_t status;
-
-  /* Lock the network and serialize driver operations if necessary.
-   * NOTE: Serialization is only required in the case where the driver work
-   * is performed on an LP worker thread and where more than one LP worker
-   * thread has been configured.
-   */
-
-  net_lock();
+  int npkts = 0;
 
   /* Process pending Ethernet interrupts */
 
-  while (1)
+  while (npkts < budget)
     {
       /* Get interrupt status bits */
 
@@ -904,6 +912,7 @@ static void lan91c111_interrupt_work(FAR void *arg)
       if (status & IM_RCV_INT)
         {
           lan91c111_receive(dev);
+          npkts++;
         }
 
       if (status & IM_RX_OVRN_INT)
@@ -937,12 +946,103 @@ static void lan91c111_interrupt_work(FAR void *arg)
         }
     }
 
+  return npkts;
+}
+
+#ifdef CONFIG_NETDEV_NAPI
+/****************************************************************************
+ * Name: lan91c111_napi_poll
+ *
+ * Description:
+ *   NAPI poll method:  Service up to 'budget' received packets.
+ *
+ * Parameters:
+ *   napi   - The NAPI instance of the interface
+ *   budget - The maximum number of packets to receive
+ *
+ * Returned Value:
+ *   The number of packets received
+ *
+ * Assumptions:
+ *   Runs on a worker thread with the network locked.
+ *
+ ****************************************************************************/
+
+static int lan91c111_napi_poll(FAR struct napi_s *napi, int budget)
+{
+  return lan91c111_interrupt_process(napi->dev, budget);
+}
+
+/****************************************************************************
+ * Name: lan91c111_napi_irqctl
+ *
+ * Description:
+ *   NAPI interrupt control method:  Mask or unmask the Ethernet interrupt.
+ *
+ * Parameters:
+ *   napi   - The NAPI instance of the interface
+ *   enable - True: unmask the interrupt; false: mask it
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void lan91c111_napi_irqctl(FAR struct napi_s *napi, bool enable)
+{
+  FAR struct lan91c111_driver_s *priv = napi->priv;
+
+  if (enable)
+    {
+      up_enable_irq(priv->irq);
+    }
+  else
+    {
+      up_disable_irq(priv->irq);
+    }
+}
+
+#else
+/****************************************************************************
+ * Name: lan91c111_interrupt_work
+ *
+ * Description:
+ *   Perform interrupt related work from the worker thread
+ *
+ * Parameters:
+ *   arg - The argument passed when work_queue() was called.
+ *
+ * Returned Value:
+ *   OK on success
+ *
+ * Assumptions:
+ *   Runs on a worker thread.
+ *
+ ****************************************************************************/
+
+static void lan91c111_interrupt_work(FAR void *arg)
+{
+  FAR struct net_driver_s *dev = arg;
+  FAR struct lan91c111_driver_s *priv = dev->d_private;
+
+  /* Lock the network and serialize driver operations if necessary.
+   * NOTE: Serialization is only required in the case where the driver work
+   * is performed on an LP worker thread and where more than one LP worker
+   * thread has been configured.
+   */
+
+  net_lock();
+
+  /* Process all pending Ethernet interrupts */
+
+  (void)lan91c111_interrupt_process(dev, INT_MAX);
   net_unlock();
 
   /* Re-enable Ethernet interrupts */
 
   up_enable_irq(priv->irq);
 }
+#endif /* CONFIG_NETDEV_NAPI */
 
 /****************************************************************************
  * Name: lan91c111_interrupt
@@ -968,6 +1068,13 @@ static int lan91c111_interrupt(int irq, FAR void *context, FAR void *arg)
   FAR struct net_driver_s *dev = arg;
   FAR struct lan91c111_driver_s *priv = dev->d_private;
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Mask the interrupt and poll the device from the worker thread until
+   * it is idle.
+   */
+
+  napi_schedule(&priv->napi);
+#else
   /* Disable further Ethernet interrupts. */
 
   up_disable_irq(priv->irq);
@@ -975,6 +1082,7 @@ static int lan91c111_interrupt(int irq, FAR void *context, FAR void *arg)
   /* Schedule to perform the interrupt processing on the worker thread. */
 
   work_queue(LAN91C111_WORK, &priv->irqwork, lan91c111_interrupt_work, dev, 0);
+#endif
   return OK;
 }
 
@@ -1168,7 +1276,11 @@ static int lan91c111_ifdown(FAR struct net_driver_s *dev)
 
   wd_cancel(priv->txpoll);
 
+#ifdef CONFIG_NETDEV_NAPI
+  napi_cancel(&priv->napi);
+#else
   work_cancel(LAN91C111_WORK, &priv->irqwork);
+#endif
   work_cancel(LAN91C111_WORK, &priv->pollwork);
 
   /* Put the EMAC in its reset, non-operational state.  This should be
@@ -1565,6 +1677,11 @@ int lan91c111_initialize(uintptr_t base, int irq)
   priv->base = base;
   priv->irq  = irq;
 
+#ifdef CONFIG_NETDEV_NAPI
+  napi_initialize(&priv->napi, dev, LAN91C111_WORK, 0, lan91c111_napi_poll,
+                  lan91c111_napi_irqctl, priv);
+#endif
+
   /* Check if a Ethernet chip is recognized at its I/O base */
 
   macrev = getreg16(priv, REV_REG);
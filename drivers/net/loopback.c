@@ -517,6 +517,14 @@ int localhost_initialize(void)
 #ifdef CONFIG_NET_MCASTGROUP
   priv->lo_dev.d_addmac  = lo_addmac;    /* Add multicast MAC address */
   priv->lo_dev.d_rmmac   = lo_rmmac;     /* Remove multicast MAC address */
+#endif
+#ifdef CONFIG_NETDEV_LOOPBACK_NOCSUM
+  /* Looped back packets never leave memory:  There is nothing for a
+   * checksum to protect.
+   */
+
+  priv->lo_dev.d_txcsum  = NETDEV_CSUM_ALL;
+  priv->lo_dev.d_rxcsum  = NETDEV_CSUM_ALL;
 #endif
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
@@ -0,0 +1,252 @@
+/****************************************************************************
+ * drivers/net/napi.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/napi.h>
+
+#ifdef CONFIG_NETDEV_NAPI
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void napi_work(FAR void *arg);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: napi_queue
+ *
+ * Description:
+ *   Queue the poll work.  With CONFIG_NETDEV_NAPI_STEERING, the poll of
+ *   each device is steered by its hash to one of the per-CPU work queues.
+ *
+ ****************************************************************************/
+
+static void napi_queue(FAR struct napi_s *napi, clock_t delay)
+{
+#ifdef CONFIG_NETDEV_NAPI_STEERING
+  int qid = work_cpuqid(napi->hash);
+
+  napi->wqid = qid >= 0 ? qid : napi->qid;
+#endif
+
+  (void)work_queue(NAPI_WQID(napi), &napi->work, napi_work, napi, delay);
+}
+
+/****************************************************************************
+ * Name: napi_work
+ *
+ * Description:
+ *   Poll the device from the worker thread and decide whether to keep
+ *   polling or to re-enable the device interrupt.
+ *
+ * Input Parameters:
+ *   arg - The NAPI instance (cast to void *)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Runs on a worker thread.
+ *
+ ****************************************************************************/
+
+static void napi_work(FAR void *arg)
+{
+  FAR struct napi_s *napi = (FAR struct napi_s *)arg;
+  FAR struct net_driver_s *dev = napi->dev;
+  int npkts;
+
+  net_lock();
+
+  npkts = napi->poll(napi, napi->budget);
+  DEBUGASSERT(npkts >= 0 && npkts <= napi->budget);
+  NETDEV_NAPIPOLLS(dev);
+
+  if (npkts >= napi->budget)
+    {
+      /* Still busy.  Poll again as soon as the worker is free and leave the
+       * interrupt masked.
+       */
+
+      NETDEV_NAPIEXHAUSTED(dev);
+      napi->busy = true;
+      napi_queue(napi, 0);
+    }
+  else if (napi->busy && npkts > 0)
+    {
+      /* A burst is tapering off.  Collect the tail with one more poll a
+       * little later rather than taking an interrupt per frame.
+       */
+
+      NETDEV_NAPIHOLDOFFS(dev);
+      napi_queue(napi, CONFIG_NETDEV_NAPI_HOLDOFF);
+    }
+  else
+    {
+      /* Idle.  Return to interrupt driven operation */
+
+      napi->busy  = false;
+      napi->sched = false;
+      napi->irqctl(napi, true);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: napi_initialize
+ *
+ * Description:
+ *   Initialize a NAPI instance for a network device.
+ *
+ * Input Parameters:
+ *   napi   - The NAPI instance to initialize
+ *   dev    - The network device that will be polled
+ *   qid    - The work queue on which the poll runs (normally LPWORK).
+ *            With CONFIG_NETDEV_NAPI_STEERING, this is used only until
+ *            the per-CPU work queues have been started.
+ *   budget - Maximum frames per poll; zero selects
+ *            CONFIG_NETDEV_NAPI_BUDGET
+ *   poll   - The driver poll method
+ *   irqctl - The driver interrupt control method
+ *   priv   - Driver private data, available as napi->priv
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void napi_initialize(FAR struct napi_s *napi, FAR struct net_driver_s *dev,
+                     int qid, uint16_t budget, napi_poll_t poll,
+                     napi_irqctl_t irqctl, FAR void *priv)
+{
+  DEBUGASSERT(napi != NULL && dev != NULL && poll != NULL &&
+              irqctl != NULL);
+
+  memset(napi, 0, sizeof(struct napi_s));
+  napi->dev    = dev;
+  napi->poll   = poll;
+  napi->irqctl = irqctl;
+  napi->priv   = priv;
+  napi->qid    = qid;
+  napi->budget = budget > 0 ? budget : CONFIG_NETDEV_NAPI_BUDGET;
+
+#ifdef CONFIG_NETDEV_NAPI_STEERING
+  /* Multiplicative (Fibonacci) hash of the device so that the devices are
+   * spread evenly across the CPUs.
+   */
+
+  napi->wqid   = qid;
+  napi->hash   = ((uint32_t)(uintptr_t)dev * 2654435761u) >> 16;
+#endif
+}
+
+/****************************************************************************
+ * Name: napi_schedule
+ *
+ * Description:
+ *   Mask the device interrupt and schedule a poll.  This is normally called
+ *   from the device interrupt handler.  Nothing is done if a poll is
+ *   already pending.
+ *
+ * Input Parameters:
+ *   napi - The NAPI instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void napi_schedule(FAR struct napi_s *napi)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!napi->sched)
+    {
+      napi->sched = true;
+      napi->irqctl(napi, false);
+
+      NETDEV_NAPISCHEDS(napi->dev);
+      napi_queue(napi, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: napi_cancel
+ *
+ * Description:
+ *   Cancel any pending poll.  This is normally called when the interface is
+ *   brought down, after the device interrupt has been disabled.
+ *
+ * Input Parameters:
+ *   napi - The NAPI instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void napi_cancel(FAR struct napi_s *napi)
+{
+  (void)work_cancel(NAPI_WQID(napi), &napi->work);
+  napi->sched = false;
+  napi->busy  = false;
+}
+
+#endif /* CONFIG_NETDEV_NAPI */
@@ -56,6 +56,10 @@
 #include <nuttx/net/arp.h>
 #include <nuttx/net/netdev.h>
 
+#ifdef CONFIG_NETDEV_TXIOB
+#  include <nuttx/mm/iob.h>
+#endif
+
 #ifdef CONFIG_NET_PKT
 #  include <nuttx/net/pkt.h>
 #endif
@@ -224,6 +228,10 @@ static int  skel_ioctl(FAR struct net_driver_s *dev, int cmd,
 
 static int skel_transmit(FAR struct skel_driver_s *priv)
 {
+#ifdef CONFIG_NETDEV_TXIOB
+  FAR struct net_driver_s *dev = &priv->sk_dev;
+#endif
+
   /* Verify that the hardware is ready to send another packet.  If we get
    * here, then we are committed to sending a packet; Higher level logic
    * must have assured that there is no transmission in progress.
@@ -233,7 +241,51 @@ static int skel_transmit(FAR struct skel_driver_s *priv)
 
   NETDEV_TXPACKETS(priv->sk_dev);
 
-  /* Send the packet: address=priv->sk_dev.d_buf, length=priv->sk_dev.d_len */
+#ifdef CONFIG_NETDEV_TXIOB
+  if (dev->d_iob != NULL)
+    {
+      FAR struct iob_s *iob = dev->d_iob;
+      unsigned int offset = dev->d_iobofs;
+      unsigned int remaining = dev->d_sndlen;
+      unsigned int seglen;
+
+      /* Send the headers as the first segment of the packet:
+       * address=dev->d_buf, length=dev->d_len - dev->d_sndlen
+       */
+
+      /* Then add one segment for each I/O buffer holding payload */
+
+      for (; iob != NULL && remaining > 0; iob = iob->io_flink)
+        {
+          if (offset >= iob->io_len)
+            {
+              offset -= iob->io_len;
+              continue;
+            }
+
+          seglen = iob->io_len - offset;
+          if (seglen > remaining)
+            {
+              seglen = remaining;
+            }
+
+          /* Add the segment:
+           * address=&iob->io_data[iob->io_offset + offset], length=seglen
+           */
+
+          remaining -= seglen;
+          offset     = 0;
+        }
+
+      /* The chain must not be referenced after the transfer completes */
+    }
+  else
+#endif
+    {
+      /* Send the packet: address=priv->sk_dev.d_buf,
+       * length=priv->sk_dev.d_len
+       */
+    }
 
   /* Enable Tx interrupts */
 
@@ -608,6 +660,12 @@ static int skel_interrupt(int irq, FAR void *context, FAR void *arg)
 
   up_disable_irq(CONFIG_skeleton_IRQ);
 
+  /* TODO: If a packet was received, time stamp it so that the time spent
+   * in the worker thread is included in the network latency trace:
+   *
+   *   NETDEV_RXSTAMP(&priv->sk_dev);
+   */
+
   /* TODO: Determine if a TX transfer just completed */
 
     {
@@ -1173,6 +1231,9 @@ int skel_initialize(int intf)
   priv->sk_dev.d_ifup    = skel_ifup;     /* I/F up (new IP address) callback */
   priv->sk_dev.d_ifdown  = skel_ifdown;   /* I/F down callback */
   priv->sk_dev.d_txavail = skel_txavail;  /* New TX data callback */
+#ifdef CONFIG_NETDEV_TXIOB
+  priv->sk_dev.d_txiob   = true;          /* Supports scatter-gather TX */
+#endif
 #ifdef CONFIG_NET_MCASTGROUP
   priv->sk_dev.d_addmac  = skel_addmac;   /* Add multicast MAC address */
   priv->sk_dev.d_rmmac   = skel_rmmac;    /* Remove multicast MAC address */
@@ -137,9 +137,9 @@ struct telnet_dev_s
 {
   sem_t             td_exclsem;   /* Enforces mutually exclusive access */
   uint8_t           td_state;     /* (See telnet_state_e) */
-  uint8_t           td_pending;   /* Number of valid, pending bytes in the rxbuffer */
-  uint8_t           td_offset;    /* Offset to the valid, pending bytes in the rxbuffer */
   uint8_t           td_crefs;     /* The number of open references to the session */
+  uint16_t          td_pending;   /* Number of valid, pending bytes in the rxbuffer */
+  uint16_t          td_offset;    /* Offset to the valid, pending bytes in the rxbuffer */
   int               td_minor;     /* Minor device number */
 #ifdef CONFIG_TELNET_SUPPORT_NAWS
   uint16_t          td_rows;      /* Number of NAWS rows */
@@ -175,10 +175,12 @@ static inline void telnet_dumpbuffer(FAR const char *msg,
 #endif
 static void    telnet_getchar(FAR struct telnet_dev_s *priv, uint8_t ch,
                  FAR char *dest, int *nread);
+static size_t  telnet_copyrun(FAR const char *src, size_t srclen,
+                 FAR char *dest, size_t destlen);
 static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                  FAR const char *src, size_t srclen, FAR char *dest,
                  size_t destlen);
-static bool    telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
+static void    telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
                  int *nwritten);
 static void    telnet_sendopt(FAR struct telnet_dev_s *priv, uint8_t option,
                  uint8_t value);
@@ -305,6 +307,44 @@ static void telnet_getchar(FAR struct telnet_dev_s *priv, uint8_t ch,
     }
 }
 
+/****************************************************************************
+ * Name: telnet_copyrun
+ *
+ * Description:
+ *   Copy the run of ordinary data bytes at the beginning of 'src' directly
+ *   to the user buffer.  The run ends at the first byte that needs the
+ *   attention of the telnet parser (IAC or, in line mode, a carriage
+ *   return) or when either buffer is exhausted.
+ *
+ * Returned Value:
+ *   The number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t telnet_copyrun(FAR const char *src, size_t srclen,
+                             FAR char *dest, size_t destlen)
+{
+  size_t maxrun = srclen < destlen ? srclen : destlen;
+  size_t nrun;
+  uint8_t ch;
+
+  for (nrun = 0; nrun < maxrun; nrun++)
+    {
+      ch = (uint8_t)src[nrun];
+#ifndef CONFIG_TELNET_CHARACTER_MODE
+      if (ch == TELNET_IAC || ch == ISO_cr)
+#else
+      if (ch == TELNET_IAC)
+#endif
+        {
+          break;
+        }
+    }
+
+  memcpy(dest, src, nrun);
+  return nrun;
+}
+
 /****************************************************************************
  * Name: telnet_receive
  *
@@ -317,6 +357,7 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                               FAR const char *src, size_t srclen,
                               FAR char *dest, size_t destlen)
 {
+  size_t nrun;
   int nread;
   uint8_t ch;
 
@@ -445,6 +486,16 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
             else
               {
                 telnet_getchar(priv, ch, dest, &nread);
+
+                /* Then copy the run of ordinary data that follows in bulk.
+                 * (the loop accounts for 'ch' when it decrements srclen).
+                 */
+
+                nrun = telnet_copyrun(src, srclen - 1, &dest[nread],
+                                      destlen - nread);
+                src    += nrun;
+                srclen -= nrun;
+                nread  += nrun;
               }
             break;
 
@@ -529,15 +580,15 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
  * Name: telnet_putchar
  *
  * Description:
- *   Put another character from the user buffer to the TX buffer.
+ *   Put another character from the user buffer to the TX buffer.  At most
+ *   three bytes are added to the TX buffer.
  *
  ****************************************************************************/
 
-static bool telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
+static void telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
                            int *nread)
 {
   register int index;
-  bool ret = false;
 
   /* Ignore carriage returns (we will put these in automatically as necesary) */
 
@@ -556,16 +607,17 @@ static bool telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
 
           priv->td_txbuffer[index++] = ISO_cr;
           priv->td_txbuffer[index++] = '\0';
+        }
 
-          /* End of line */
+      /* A data byte with the value of IAC must be doubled */
 
-          ret = true;
+      else if (ch == TELNET_IAC)
+        {
+          priv->td_txbuffer[index++] = TELNET_IAC;
         }
 
       *nread = index;
     }
-
-  return ret;
 }
 
 /****************************************************************************
@@ -838,31 +890,54 @@ static ssize_t telnet_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct inode *inode = filep->f_inode;
   FAR struct telnet_dev_s *priv = inode->i_private;
   FAR const char *src = buffer;
-  ssize_t nsent;
+  size_t nsent;
+  size_t nrun;
+  size_t room;
   ssize_t ret;
   int ncopied;
-  char ch;
-  bool eol;
+  uint8_t ch;
 
   ninfo("len: %d\n", len);
 
-  /* Process each character from the user buffer */
+  /* Process the user buffer.  Output is coalesced in the TX buffer and is
+   * only sent when the TX buffer fills or when the user buffer has been
+   * consumed, rather than once per line.
+   */
 
-  for (nsent = 0, ncopied = 0; nsent < len; nsent++)
+  for (nsent = 0, ncopied = 0; nsent < len; )
     {
-      /* Get the next character from the user buffer */
+      /* Copy the run of bytes that need no translation directly into the
+       * TX buffer.  There is always room for at least one more byte here.
+       */
 
-      ch = *src++;
+      room = CONFIG_TELNET_TXBUFFER_SIZE - 3 - ncopied;
+      for (nrun = 0; nrun < len - nsent && nrun < room; nrun++)
+        {
+          ch = (uint8_t)src[nrun];
+          if (ch == ISO_cr || ch == ISO_nl || ch == TELNET_IAC)
+            {
+              break;
+            }
+        }
+
+      memcpy(&priv->td_txbuffer[ncopied], src, nrun);
+      ncopied += nrun;
+      nsent   += nrun;
+      src     += nrun;
 
-      /* Add the character to the TX buffer */
+      /* Then add the character that ended the run to the TX buffer */
 
-      eol = telnet_putchar(priv, ch, &ncopied);
+      if (nsent < len && nrun < room)
+        {
+          telnet_putchar(priv, (uint8_t)*src++, &ncopied);
+          nsent++;
+        }
 
-      /* Was that the end of a line? Or is the buffer too full to hold the
-       * next largest character sequence ("\r\n\0")?
+      /* Is the buffer too full to hold the next largest character sequence
+       * ("\n\r\0")?
        */
 
-      if (eol || ncopied > CONFIG_TELNET_TXBUFFER_SIZE-3)
+      if (ncopied >= CONFIG_TELNET_TXBUFFER_SIZE - 3)
         {
           /* Yes... send the data now */
 
@@ -894,8 +969,8 @@ static ssize_t telnet_write(FAR struct file *filep, FAR const char *buffer,
 
   /* Notice that we don't actually return the number of bytes sent, but
    * rather, the number of bytes that the caller asked us to send.  We may
-   * have sent more bytes (because of CR-LF expansion and because of NULL
-   * termination). But it confuses some logic if you report that you sent
+   * have sent more bytes (because of CR-LF expansion, IAC doubling, and
+   * because of NULL termination). But it confuses some logic if you report that you sent
    * more than you were requested to.
    */
 
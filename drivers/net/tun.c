@@ -52,6 +52,7 @@
 #  include <poll.h>
 #endif
 
+#include <sys/uio.h>
 #include <arpa/inet.h>
 
 #include <net/if.h>
@@ -102,6 +103,19 @@
 #  define CONFIG_TUN_NINTERFACES 1
 #endif
 
+/* CONFIG_TUN_NQUEUES is the number of files that may be attached to one
+ * interface and CONFIG_TUN_QUEUE_DEPTH the number of outgoing packets that
+ * each of them can hold until they are read.
+ */
+
+#ifndef CONFIG_TUN_NQUEUES
+#  define CONFIG_TUN_NQUEUES 1
+#endif
+
+#ifndef CONFIG_TUN_QUEUE_DEPTH
+#  define CONFIG_TUN_QUEUE_DEPTH 1
+#endif
+
 /* TX poll delay = 1 seconds. CLK_TCK is the number of clock ticks per
  * second
  */
@@ -123,6 +137,38 @@
  * Private Types
  ****************************************************************************/
 
+/* One outgoing packet waiting to be read */
+
+struct tun_pkt_s
+{
+  uint16_t          len;     /* Length of the packet */
+  uint8_t           buf[CONFIG_NET_TUN_PKTSIZE];
+};
+
+/* Each file attached to an interface has its own queue of outgoing
+ * packets.  Packets written to any of the files are received on the same
+ * interface.
+ */
+
+struct tun_device_s;
+
+struct tun_queue_s
+{
+  FAR struct tun_device_s *priv; /* The interface of the queue */
+  FAR struct file  *filep;       /* The attached file; NULL if unused */
+
+#ifndef CONFIG_DISABLE_POLL
+  FAR struct pollfd *poll_fds;
+#endif
+
+  bool              read_wait;
+  sem_t             read_wait_sem;
+
+  uint8_t           head;        /* Index of the oldest queued packet */
+  uint8_t           count;       /* Number of queued packets */
+  struct tun_pkt_s  pkts[CONFIG_TUN_QUEUE_DEPTH];
+};
+
 /* The tun_device_s encapsulates all state information for a single hardware
  * interface
  */
@@ -130,24 +176,21 @@
 struct tun_device_s
 {
   bool              bifup;   /* true:ifup false:ifdown */
+  bool              multiqueue; /* Created with IFF_MULTI_QUEUE */
+  uint8_t           nqueues; /* Number of attached queues */
   WDOG_ID           txpoll;  /* TX poll timer */
   struct work_s     work;    /* For deferring poll work to the work queue */
 
-  FAR struct file  *filep;
-
-#ifndef CONFIG_DISABLE_POLL
-  FAR struct pollfd *poll_fds;
-#endif
-
-  bool              read_wait;
+  /* The queue whose next free packet is d_buf.  If NULL, d_buf is
+   * write_buf and the packet is copied to a queue once it is complete.
+   */
 
-  uint8_t           read_buf[CONFIG_NET_TUN_PKTSIZE];
-  size_t            read_d_len;
+  FAR struct tun_queue_s *txq;
   uint8_t           write_buf[CONFIG_NET_TUN_PKTSIZE];
-  size_t            write_d_len;
 
   sem_t             waitsem;
-  sem_t             read_wait_sem;
+
+  struct tun_queue_s queues[CONFIG_TUN_NQUEUES];
 
   /* This holds the information visible to the NuttX network */
 
@@ -167,6 +210,14 @@ struct tun_driver_s
 static void tun_lock(FAR struct tun_device_s *priv);
 static void tun_unlock(FAR struct tun_device_s *priv);
 
+/* Packet queues */
+
+static bool tun_txsetup(FAR struct tun_device_s *priv);
+static ssize_t tun_dequeue(FAR struct tun_queue_s *q, FAR struct iovec *iov,
+                           int iovcnt, bool nonblock);
+static ssize_t tun_inject(FAR struct tun_device_s *priv,
+                          FAR const struct iovec *iov, int iovcnt);
+
 /* Common TX logic */
 
 static int  tun_fd_transmit(FAR struct tun_device_s *priv);
@@ -207,6 +258,9 @@ static void tun_ipv6multicast(FAR struct tun_device_s *priv);
 static int tun_dev_init(FAR struct tun_device_s *priv, FAR struct file *filep,
                         FAR const char *devfmt, bool tun);
 static int tun_dev_uninit(FAR struct tun_device_s *priv);
+static void tun_queue_attach(FAR struct tun_device_s *priv,
+                             FAR struct tun_queue_s *q,
+                             FAR struct file *filep);
 
 /* File interface */
 
@@ -315,9 +369,9 @@ static void tun_unlock(FAR struct tun_device_s *priv)
  ****************************************************************************/
 
 #ifndef CONFIG_DISABLE_POLL
-static void tun_pollnotify(FAR struct tun_device_s *priv, pollevent_t eventset)
+static void tun_pollnotify(FAR struct tun_queue_s *q, pollevent_t eventset)
 {
-  FAR struct pollfd *fds = priv->poll_fds;
+  FAR struct pollfd *fds = q->poll_fds;
 
   if (fds == NULL)
     {
@@ -333,9 +387,184 @@ static void tun_pollnotify(FAR struct tun_device_s *priv, pollevent_t eventset)
     }
 }
 #else
-#  define tun_pollnotify(dev, event)
+#  define tun_pollnotify(q, event)
 #endif
 
+/****************************************************************************
+ * Name: tun_queue_tail
+ *
+ * Description:
+ *   Return the next free packet of a queue.  The queue must not be full.
+ *
+ ****************************************************************************/
+
+static FAR struct tun_pkt_s *tun_queue_tail(FAR struct tun_queue_s *q)
+{
+  unsigned int ndx = q->head + q->count;
+
+  if (ndx >= CONFIG_TUN_QUEUE_DEPTH)
+    {
+      ndx -= CONFIG_TUN_QUEUE_DEPTH;
+    }
+
+  return &q->pkts[ndx];
+}
+
+/****************************************************************************
+ * Name: tun_flowhash
+ *
+ * Description:
+ *   Hash the IP addresses and, for TCP and UDP, the port numbers of the
+ *   packet in d_buf.  The hash is the same for both directions of a flow.
+ *
+ ****************************************************************************/
+
+#if CONFIG_TUN_NQUEUES > 1
+static uint32_t tun_flowhash(FAR struct tun_device_s *priv)
+{
+  FAR uint8_t *l4hdr = NULL;
+  uint32_t hash = 0;
+  int i;
+
+#ifdef CONFIG_NET_ETHERNET
+  if (priv->dev.d_lltype == NET_LL_ETHERNET &&
+      BUF->type != HTONS(ETHTYPE_IP) && BUF->type != HTONS(ETHTYPE_IP6))
+    {
+      return 0;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+  if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      hash = net_ip4addr_conv32(ipv4->srcipaddr) ^
+             net_ip4addr_conv32(ipv4->destipaddr);
+
+      if (ipv4->proto == IP_PROTO_TCP || ipv4->proto == IP_PROTO_UDP)
+        {
+          l4hdr = (FAR uint8_t *)ipv4 + ((ipv4->vhl & 0x0f) << 2);
+        }
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      for (i = 0; i < 8; i++)
+        {
+          hash ^= (uint32_t)(ipv6->srcipaddr[i] ^ ipv6->destipaddr[i]) <<
+                  ((i & 1) << 4);
+        }
+
+      if (ipv6->proto == IP_PROTO_TCP || ipv6->proto == IP_PROTO_UDP)
+        {
+          l4hdr = (FAR uint8_t *)ipv6 + IPv6_HDRLEN;
+        }
+    }
+  else
+#endif
+    {
+      return 0;
+    }
+
+  /* The port numbers are the first four bytes of both headers */
+
+  if (l4hdr != NULL)
+    {
+      hash ^= ((uint32_t)l4hdr[0] << 8 | l4hdr[1]) ^
+              ((uint32_t)l4hdr[2] << 8 | l4hdr[3]);
+    }
+
+  UNUSED(i);
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: tun_selectqueue
+ *
+ * Description:
+ *   Select the queue for the outgoing packet in d_buf:  All packets of one
+ *   flow go to the same queue.
+ *
+ ****************************************************************************/
+
+static FAR struct tun_queue_s *tun_selectqueue(FAR struct tun_device_s *priv)
+{
+  unsigned int n = 0;
+  int i;
+
+#if CONFIG_TUN_NQUEUES > 1
+  if (priv->nqueues > 1)
+    {
+      n = tun_flowhash(priv) % priv->nqueues;
+    }
+#endif
+
+  for (i = 0; i < CONFIG_TUN_NQUEUES; i++)
+    {
+      if (priv->queues[i].filep != NULL && n-- == 0)
+        {
+          return &priv->queues[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tun_txsetup
+ *
+ * Description:
+ *   Set up d_buf for the next outgoing packet.  With a single queue, the
+ *   packet is built directly in the queue.  Otherwise, the queue depends on
+ *   the finished packet, so it is built in write_buf.
+ *
+ * Returned Value:
+ *   true if there is room for another outgoing packet.
+ *
+ ****************************************************************************/
+
+static bool tun_txsetup(FAR struct tun_device_s *priv)
+{
+  FAR struct tun_queue_s *q;
+  bool room = false;
+  int i;
+
+  priv->txq = NULL;
+
+  if (priv->nqueues == 1)
+    {
+      q = tun_selectqueue(priv);
+      if (q->count >= CONFIG_TUN_QUEUE_DEPTH)
+        {
+          return false;
+        }
+
+      priv->txq       = q;
+      priv->dev.d_buf = tun_queue_tail(q)->buf;
+      return true;
+    }
+
+  for (i = 0; i < CONFIG_TUN_NQUEUES; i++)
+    {
+      q = &priv->queues[i];
+      if (q->filep != NULL && q->count < CONFIG_TUN_QUEUE_DEPTH)
+        {
+          room = true;
+        }
+    }
+
+  priv->dev.d_buf = priv->write_buf;
+  return room;
+}
+
 /****************************************************************************
  * Name: tun_fd_transmit
  *
@@ -358,20 +587,46 @@ static void tun_pollnotify(FAR struct tun_device_s *priv, pollevent_t eventset)
 
 static int tun_fd_transmit(FAR struct tun_device_s *priv)
 {
+  FAR struct tun_queue_s *q = priv->txq;
+  FAR struct tun_pkt_s *pkt;
+
   NETDEV_TXPACKETS(&priv->dev);
 
-  /* Verify that the hardware is ready to send another packet.  If we get
-   * here, then we are committed to sending a packet; Higher level logic
-   * must have assured that there is no transmission in progress.
-   */
+  if (q != NULL)
+    {
+      /* The packet was built in the queue */
+
+      pkt = tun_queue_tail(q);
+      DEBUGASSERT(pkt->buf == priv->dev.d_buf);
+    }
+  else
+    {
+      /* Copy the packet to the queue of its flow, if there is room */
+
+      q = tun_selectqueue(priv);
+      if (q == NULL || q->count >= CONFIG_TUN_QUEUE_DEPTH)
+        {
+          NETDEV_TXERRORS(&priv->dev);
+          return -EBUSY;
+        }
 
-  if (priv->read_wait)
+      pkt = tun_queue_tail(q);
+      memcpy(pkt->buf, priv->dev.d_buf, priv->dev.d_len);
+    }
+
+  pkt->len  = priv->dev.d_len;
+  q->count++;
+  priv->txq = NULL;
+
+  /* Wake up a reader only when the queue was empty */
+
+  if (q->read_wait)
     {
-      priv->read_wait = false;
-      nxsem_post(&priv->read_wait_sem);
+      q->read_wait = false;
+      nxsem_post(&q->read_wait_sem);
     }
 
-  tun_pollnotify(priv, POLLIN);
+  tun_pollnotify(q, POLLIN);
   return OK;
 }
 
@@ -474,12 +729,12 @@ static int tun_txpoll_tap(struct net_driver_s *dev)
 
       if (!devif_loopback(dev))
         {
-          /* Send the packet */
+          /* Send the packet and continue polling while there is room for
+           * another.
+           */
 
-          priv->read_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
-
-          return 1;
+          return tun_txsetup(priv) ? 0 : 1;
         }
     }
 
@@ -528,12 +783,12 @@ static int tun_txpoll_tun(struct net_driver_s *dev)
     {
       if (!devif_loopback(dev))
         {
-          /* Send the packet */
+          /* Send the packet and continue polling while there is room for
+           * another.
+           */
 
-          priv->read_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
-
-          return 1;
+          return tun_txsetup(priv) ? 0 : 1;
         }
     }
 
@@ -643,7 +898,6 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
 
           /* And send the packet */
 
-          priv->write_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
         }
     }
@@ -680,7 +934,6 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
             }
 #endif
 
-          priv->write_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
         }
     }
@@ -698,7 +951,6 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
 
       if (priv->dev.d_len > 0)
         {
-          priv->write_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
         }
     }
@@ -779,7 +1031,6 @@ static void tun_net_receive_tun(FAR struct tun_device_s *priv)
 
   if (priv->dev.d_len > 0)
     {
-      priv->write_d_len = priv->dev.d_len;
       tun_fd_transmit(priv);
     }
 }
@@ -803,14 +1054,12 @@ static void tun_net_receive_tun(FAR struct tun_device_s *priv)
 
 static void tun_txdone(FAR struct tun_device_s *priv)
 {
-  /* Check for errors and update statistics */
+  /* Then poll the network for new XMIT data if there is room for it */
 
-  NETDEV_TXDONE(&priv->dev);
-
-  /* Then poll the network for new XMIT data */
-
-  priv->dev.d_buf = priv->read_buf;
-  (void)devif_poll(&priv->dev, tun_txpoll);
+  if (tun_txsetup(priv))
+    {
+      (void)devif_poll(&priv->dev, tun_txpoll);
+    }
 }
 
 /****************************************************************************
@@ -843,11 +1092,10 @@ static void tun_poll_work(FAR void *arg)
    * the TX poll if he are unable to accept another packet for transmission.
    */
 
-  if (priv->read_d_len == 0)
+  if (tun_txsetup(priv))
     {
       /* If so, poll the network for new XMIT data. */
 
-      priv->dev.d_buf = priv->read_buf;
       (void)devif_timer(&priv->dev, tun_txpoll);
     }
 
@@ -1000,7 +1248,7 @@ static void tun_txavail_work(FAR void *arg)
 
   /* Check if there is room to hold another network packet. */
 
-  if (priv->read_d_len != 0)
+  if (!tun_txsetup(priv))
     {
       tun_unlock(priv);
       return;
@@ -1011,7 +1259,6 @@ static void tun_txavail_work(FAR void *arg)
     {
       /* Poll the network for new XMIT data */
 
-      priv->dev.d_buf = priv->read_buf;
       (void)devif_poll(&priv->dev, tun_txpoll);
     }
 
@@ -1160,16 +1407,9 @@ static int tun_dev_init(FAR struct tun_device_s *priv, FAR struct file *filep,
 #endif
   priv->dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
 
-  /* Initialize the mutual exlcusion and wait semaphore */
+  /* Initialize the mutual exlcusion semaphore */
 
   nxsem_init(&priv->waitsem, 0, 1);
-  nxsem_init(&priv->read_wait_sem, 0, 0);
-
-  /* The wait semaphore is used for signaling and, hence, should not have
-   * priority inheritance enabled.
-   */
-
-  nxsem_setprotocol(&priv->read_wait_sem, SEM_PRIO_NONE);
 
   /* Create a watchdog for timing polling for and timing of transmissions */
 
@@ -1188,13 +1428,12 @@ static int tun_dev_init(FAR struct tun_device_s *priv, FAR struct file *filep,
   if (ret != OK)
     {
       nxsem_destroy(&priv->waitsem);
-      nxsem_destroy(&priv->read_wait_sem);
       return ret;
     }
 
-  priv->filep         = filep;        /* Set link to file */
-  filep->f_priv       = priv;         /* Set link to TUN device */
+  /* Attach the file as the first queue */
 
+  tun_queue_attach(priv, &priv->queues[0], filep);
   return ret;
 }
 
@@ -1213,172 +1452,277 @@ static int tun_dev_uninit(FAR struct tun_device_s *priv)
   (void)netdev_unregister(&priv->dev);
 
   nxsem_destroy(&priv->waitsem);
-  nxsem_destroy(&priv->read_wait_sem);
 
   return OK;
 }
 
 /****************************************************************************
- * Name: tun_open
+ * Name: tun_queue_attach
+ *
+ * Description:
+ *   Attach a file to an unused queue of the interface.
+ *
  ****************************************************************************/
 
-static int tun_open(FAR struct file *filep)
+static void tun_queue_attach(FAR struct tun_device_s *priv,
+                             FAR struct tun_queue_s *q,
+                             FAR struct file *filep)
 {
-  filep->f_priv = 0;
+  q->priv      = priv;
+  q->filep     = filep;              /* Set link to file */
+  q->head      = 0;
+  q->count     = 0;
+  q->read_wait = false;
 
-  return OK;
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&q->read_wait_sem, 0, 0);
+  nxsem_setprotocol(&q->read_wait_sem, SEM_PRIO_NONE);
+
+  priv->nqueues++;
+  filep->f_priv = q;                 /* Set link to TUN queue */
 }
 
 /****************************************************************************
- * Name: tun_close
+ * Name: tun_dequeue
+ *
+ * Description:
+ *   Read the outgoing packets of a queue, one packet into each entry of the
+ *   I/O vector, waiting for the first one unless nonblock is true.  The
+ *   length of each filled entry is set to the length of its packet.
+ *
+ * Returned Value:
+ *   The number of packets read; a negated errno on failure.
+ *
  ****************************************************************************/
 
-static int tun_close(FAR struct file *filep)
+static ssize_t tun_dequeue(FAR struct tun_queue_s *q, FAR struct iovec *iov,
+                           int iovcnt, bool nonblock)
 {
-  FAR struct inode *inode       = filep->f_inode;
-  FAR struct tun_driver_s *tun  = inode->i_private;
-  FAR struct tun_device_s *priv = filep->f_priv;
-  int intf;
+  FAR struct tun_device_s *priv = q->priv;
+  FAR struct tun_pkt_s *pkt;
+  ssize_t npkts = 0;
+  int ret;
+
+  tun_lock(priv);
 
-  if (priv == NULL)
+  while (q->count == 0)
     {
-      return OK;
+      if (nonblock)
+        {
+          tun_unlock(priv);
+          return -EAGAIN;
+        }
+
+      q->read_wait = true;
+      tun_unlock(priv);
+      ret = nxsem_wait(&q->read_wait_sem);
+      tun_lock(priv);
+
+      if (ret < 0)
+        {
+          q->read_wait = false;
+          tun_unlock(priv);
+          return ret;
+        }
     }
 
-  intf = priv - g_tun_devices;
-  tundev_lock(tun);
+  while (q->count > 0 && npkts < iovcnt)
+    {
+      pkt = &q->pkts[q->head];
+      if (iov[npkts].iov_len < pkt->len)
+        {
+          /* A packet that does not fit is discarded if it is the first,
+           * otherwise it is left for the next read.
+           */
 
-  tun->free_tuns |= (1 << intf);
-  (void)tun_dev_uninit(priv);
+          if (npkts == 0)
+            {
+              npkts = -EINVAL;
+            }
+          else
+            {
+              break;
+            }
+        }
+      else
+        {
+          memcpy(iov[npkts].iov_base, pkt->buf, pkt->len);
+          iov[npkts].iov_len = pkt->len;
+          npkts++;
+        }
 
-  tundev_unlock(tun);
+      if (++q->head >= CONFIG_TUN_QUEUE_DEPTH)
+        {
+          q->head = 0;
+        }
 
-  return OK;
+      q->count--;
+      NETDEV_TXDONE(&priv->dev);
+
+      if (npkts < 0)
+        {
+          break;
+        }
+    }
+
+  /* Poll the network for more packets now that there is room */
+
+  net_lock();
+  tun_txdone(priv);
+  net_unlock();
+
+  tun_unlock(priv);
+  return npkts;
 }
 
 /****************************************************************************
- * Name: tun_write
+ * Name: tun_inject
+ *
+ * Description:
+ *   Receive the packets written by user space, one packet from each entry
+ *   of the I/O vector.
+ *
+ * Returned Value:
+ *   The number of packets received; a negated errno on failure.
+ *
  ****************************************************************************/
 
-static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
-                         size_t buflen)
+static ssize_t tun_inject(FAR struct tun_device_s *priv,
+                          FAR const struct iovec *iov, int iovcnt)
 {
-  FAR struct tun_device_s *priv = filep->f_priv;
-  ssize_t ret;
-
-  if (priv == NULL)
-    {
-      return -EINVAL;
-    }
+  ssize_t npkts;
 
   tun_lock(priv);
+  net_lock();
 
-  if (priv->write_d_len > 0)
+  for (npkts = 0; npkts < iovcnt; npkts++)
     {
-      tun_unlock(priv);
-      return -EBUSY;
-    }
+      if (iov[npkts].iov_len > CONFIG_NET_TUN_PKTSIZE)
+        {
+          if (npkts == 0)
+            {
+              npkts = -EINVAL;
+            }
 
-  net_lock();
+          break;
+        }
 
-  if (buflen > CONFIG_NET_TUN_PKTSIZE)
-    {
-      ret = -EINVAL;
-    }
-  else
-    {
-      memcpy(priv->write_buf, buffer, buflen);
+      memcpy(priv->write_buf, iov[npkts].iov_base, iov[npkts].iov_len);
 
+      priv->txq       = NULL;
       priv->dev.d_buf = priv->write_buf;
-      priv->dev.d_len = buflen;
+      priv->dev.d_len = iov[npkts].iov_len;
 
       tun_net_receive(priv);
-
-      ret = (ssize_t)buflen;
     }
 
   net_unlock();
   tun_unlock(priv);
 
-  return ret;
+  return npkts;
 }
 
 /****************************************************************************
- * Name: tun_read
+ * Name: tun_open
  ****************************************************************************/
 
-static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
-                        size_t buflen)
+static int tun_open(FAR struct file *filep)
 {
-  FAR struct tun_device_s *priv = filep->f_priv;
-  ssize_t ret;
-  size_t write_d_len;
-  size_t read_d_len;
+  filep->f_priv = 0;
 
-  if (priv == NULL)
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tun_close
+ ****************************************************************************/
+
+static int tun_close(FAR struct file *filep)
+{
+  FAR struct inode *inode       = filep->f_inode;
+  FAR struct tun_driver_s *tun  = inode->i_private;
+  FAR struct tun_queue_s *q     = filep->f_priv;
+  FAR struct tun_device_s *priv;
+  int intf;
+
+  if (q == NULL)
     {
-      return -EINVAL;
+      return OK;
     }
 
+  priv = q->priv;
+  intf = priv - g_tun_devices;
+  tundev_lock(tun);
+
+  /* Detach the queue and discard any packets that were not read */
+
   tun_lock(priv);
+  q->filep = NULL;
+  q->count = 0;
+  nxsem_destroy(&q->read_wait_sem);
+  priv->nqueues--;
+  tun_unlock(priv);
 
-  /* Check if there are data to read in write buffer */
+  /* The interface goes away with its last queue */
 
-  write_d_len = priv->write_d_len;
-  if (write_d_len > 0)
+  if (priv->nqueues == 0)
     {
-      if (buflen < write_d_len)
-        {
-          ret = -EINVAL;
-          goto out;
-        }
+      tun->free_tuns |= (1 << intf);
+      (void)tun_dev_uninit(priv);
+    }
 
-      memcpy(buffer, priv->write_buf, write_d_len);
-      ret = (ssize_t)write_d_len;
+  tundev_unlock(tun);
 
-      priv->write_d_len = 0;
-      NETDEV_TXDONE(&priv->dev);
-      tun_pollnotify(priv, POLLOUT);
+  return OK;
+}
 
-      goto out;
-    }
+/****************************************************************************
+ * Name: tun_write
+ ****************************************************************************/
 
-  if (priv->read_d_len == 0)
-    {
-      if ((filep->f_oflags & O_NONBLOCK) != 0)
-        {
-          ret = -EAGAIN;
-          goto out;
-        }
+static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
+                         size_t buflen)
+{
+  FAR struct tun_queue_s *q = filep->f_priv;
+  struct iovec iov;
+  ssize_t ret;
 
-      priv->read_wait = true;
-      tun_unlock(priv);
-      (void)nxsem_wait(&priv->read_wait_sem);
-      tun_lock(priv);
+  if (q == NULL)
+    {
+      return -EINVAL;
     }
 
-  net_lock();
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = buflen;
 
-  read_d_len = priv->read_d_len;
-  if (buflen < read_d_len)
-    {
-      ret = -EINVAL;
-    }
-  else
-    {
-      memcpy(buffer, priv->read_buf, read_d_len);
-      ret = (ssize_t)read_d_len;
-    }
+  ret = tun_inject(q->priv, &iov, 1);
+  return ret < 0 ? ret : (ssize_t)buflen;
+}
 
-  priv->read_d_len = 0;
-  tun_txdone(priv);
+/****************************************************************************
+ * Name: tun_read
+ ****************************************************************************/
 
-  net_unlock();
+static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
+                        size_t buflen)
+{
+  FAR struct tun_queue_s *q = filep->f_priv;
+  struct iovec iov;
+  ssize_t ret;
 
-out:
-  tun_unlock(priv);
+  if (q == NULL)
+    {
+      return -EINVAL;
+    }
 
-  return ret;
+  iov.iov_base = buffer;
+  iov.iov_len  = buflen;
+
+  ret = tun_dequeue(q, &iov, 1, (filep->f_oflags & O_NONBLOCK) != 0);
+  return ret < 0 ? ret : (ssize_t)iov.iov_len;
 }
 
 /****************************************************************************
@@ -1388,55 +1732,50 @@ out:
 #ifndef CONFIG_DISABLE_POLL
 int tun_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 {
-  FAR struct tun_device_s *priv = filep->f_priv;
+  FAR struct tun_queue_s *q = filep->f_priv;
+  FAR struct tun_device_s *priv;
   pollevent_t eventset;
   int ret = OK;
 
   /* Some sanity checking */
 
-  if (priv == NULL || fds == NULL)
+  if (q == NULL || fds == NULL)
     {
       return -EINVAL;
     }
 
+  priv = q->priv;
   tun_lock(priv);
 
   if (setup)
     {
-      if (priv->poll_fds)
+      if (q->poll_fds)
         {
           ret = -EBUSY;
           goto errout;
         }
 
-      priv->poll_fds = fds;
-
-      eventset = 0;
+      q->poll_fds = fds;
 
-      /* If write buffer is empty notify App.  */
-
-      if (priv->write_d_len == 0)
-        {
-          eventset |= (fds->events & POLLOUT);
-        }
-
-      /* The write buffer sometimes could be used for TX.
-       * So check it too.
+      /* Writes never wait for room: A packet that cannot be queued is
+       * dropped like on a real network.
        */
 
-      if (priv->read_d_len != 0 || priv->write_d_len != 0)
+      eventset = (fds->events & POLLOUT);
+
+      if (q->count != 0)
         {
           eventset |= (fds->events & POLLIN);
         }
 
       if (eventset)
         {
-          tun_pollnotify(priv, eventset);
+          tun_pollnotify(q, eventset);
         }
     }
   else
     {
-      priv->poll_fds = 0;
+      q->poll_fds = 0;
     }
 
 errout:
@@ -1454,14 +1793,18 @@ static int tun_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   FAR struct inode *inode       = filep->f_inode;
   FAR struct tun_driver_s *tun  = inode->i_private;
-  FAR struct tun_device_s *priv = filep->f_priv;
+  FAR struct tun_queue_s *q     = filep->f_priv;
+  FAR struct tun_device_s *priv;
+  FAR struct tun_batch_s *batch;
   int ret = OK;
 
-  if (cmd == TUNSETIFF && priv == NULL)
+  if (cmd == TUNSETIFF && q == NULL)
     {
       uint8_t free_tuns;
       int intf;
+      int i;
       FAR struct ifreq *ifr = (FAR struct ifreq *)arg;
+      bool tun_mode;
 
       if (ifr  == NULL ||
          ((ifr->ifr_flags & IFF_MASK) != IFF_TUN &&
@@ -1470,8 +1813,44 @@ static int tun_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           return -EINVAL;
         }
 
+      tun_mode = (ifr->ifr_flags & IFF_MASK) == IFF_TUN;
       tundev_lock(tun);
 
+      /* Attach another queue to an existing multi-queue interface */
+
+      if ((ifr->ifr_flags & IFF_MULTI_QUEUE) != 0 && *ifr->ifr_name)
+        {
+          for (intf = 0; intf < CONFIG_TUN_NINTERFACES; intf++)
+            {
+              priv = &g_tun_devices[intf];
+              if ((tun->free_tuns & (1 << intf)) == 0 && priv->multiqueue &&
+                  (priv->dev.d_lltype == NET_LL_TUN) == tun_mode &&
+                  strncmp(priv->dev.d_ifname, ifr->ifr_name, IFNAMSIZ) == 0)
+                {
+                  break;
+                }
+            }
+
+          if (intf < CONFIG_TUN_NINTERFACES)
+            {
+              ret = -EBUSY;
+              tun_lock(priv);
+              for (i = 0; i < CONFIG_TUN_NQUEUES; i++)
+                {
+                  if (priv->queues[i].filep == NULL)
+                    {
+                      tun_queue_attach(priv, &priv->queues[i], filep);
+                      ret = OK;
+                      break;
+                    }
+                }
+
+              tun_unlock(priv);
+              tundev_unlock(tun);
+              return ret;
+            }
+        }
+
       free_tuns = tun->free_tuns;
 
       if (free_tuns == 0)
@@ -1485,8 +1864,7 @@ static int tun_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
            intf++, free_tuns >>= 1);
 
       ret = tun_dev_init(&g_tun_devices[intf], filep,
-                         *ifr->ifr_name ? ifr->ifr_name : 0,
-                         (ifr->ifr_flags & IFF_MASK) == IFF_TUN);
+                         *ifr->ifr_name ? ifr->ifr_name : 0, tun_mode);
       if (ret != OK)
         {
           tundev_unlock(tun);
@@ -1495,14 +1873,50 @@ static int tun_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
       tun->free_tuns &= ~(1 << intf);
 
-      priv = filep->f_priv;
+      priv = &g_tun_devices[intf];
+      priv->multiqueue = (ifr->ifr_flags & IFF_MULTI_QUEUE) != 0;
       strncpy(ifr->ifr_name, priv->dev.d_ifname, IFNAMSIZ);
       tundev_unlock(tun);
 
       return OK;
     }
 
-  return -EBADFD;
+  if (q == NULL)
+    {
+      return -EBADFD;
+    }
+
+  switch (cmd)
+    {
+      /* Read or write several packets, one per I/O vector entry */
+
+      case TUNREADV:
+        batch = (FAR struct tun_batch_s *)((uintptr_t)arg);
+        if (batch == NULL || batch->tb_iovcnt <= 0)
+          {
+            return -EINVAL;
+          }
+
+        ret = (int)tun_dequeue(q, batch->tb_iov, batch->tb_iovcnt,
+                               (filep->f_oflags & O_NONBLOCK) != 0);
+        break;
+
+      case TUNWRITEV:
+        batch = (FAR struct tun_batch_s *)((uintptr_t)arg);
+        if (batch == NULL || batch->tb_iovcnt <= 0)
+          {
+            return -EINVAL;
+          }
+
+        ret = (int)tun_inject(q->priv, batch->tb_iov, batch->tb_iovcnt);
+        break;
+
+      default:
+        ret = -EBADFD;
+        break;
+    }
+
+  return ret;
 }
 
 /****************************************************************************
@@ -61,6 +61,12 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#ifdef CONFIG_DEV_PIPE_SPSC
+#  include <nuttx/spinlock.h>
+#endif
+#ifdef CONFIG_DEV_PIPE_SPLICE
+#  include <nuttx/drivers/drivers.h>
+#endif
 
 #include "pipe_common.h"
 
@@ -80,6 +86,26 @@
 #  define pipe_dumpbuffer(m,a,n)
 #endif
 
+/* In SPSC mode the ring data must be visible before the index that
+ * publishes it (and consumed before the index that releases it).  The
+ * barrier after publishing an index also orders that store before the
+ * re-read of the peer's index that decides whether to wake the peer.
+ */
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+#  if defined(CONFIG_SMP)
+#    define pipe_barrier() SP_DSB()
+#  elif defined(__GNUC__)
+#    define pipe_barrier() __asm__ __volatile__ ("" : : : "memory")
+#  else
+#    define pipe_barrier()
+#  endif
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -155,6 +181,403 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
 #  define pipecommon_pollnotify(dev,event)
 #endif
 
+
+/****************************************************************************
+ * Name: pipecommon_wakeup
+ *
+ * Description:
+ *   Post a wait semaphore without letting its count grow beyond one.
+ *   Waiters always re-check the ring state after they are awakened, so an
+ *   extra count only costs one spurious pass.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_DEV_PIPE_SPSC) || defined(CONFIG_DEV_PIPE_SPLICE)
+static void pipecommon_wakeup(FAR sem_t *sem)
+{
+  int sval;
+
+  if (nxsem_getvalue(sem, &sval) == 0 && sval < 1)
+    {
+      nxsem_post(sem);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: pipecommon_spsc_read
+ *
+ * Description:
+ *   read() in SPSC mode.  Only the reader modifies d_rdndx, so no lock is
+ *   needed to consume data.  The writer is woken only if the ring was full
+ *   when the new d_rdndx was published.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+static ssize_t pipecommon_spsc_read(FAR struct file *filep,
+                                    FAR struct pipe_dev_s *dev,
+                                    FAR char *buffer, size_t len)
+{
+  pipe_ndx_t oldrdndx;
+  pipe_ndx_t wrndx;
+  pipe_ndx_t rdndx;
+  size_t avail;
+  size_t nread;
+  size_t ncopy;
+  int ret;
+
+  /* Wait until the ring is not empty */
+
+  for (; ; )
+    {
+      wrndx = dev->d_wrndx;
+      rdndx = dev->d_rdndx;
+      if (wrndx != rdndx)
+        {
+          break;
+        }
+
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          return -EAGAIN;
+        }
+
+      if (dev->d_nwriters <= 0)
+        {
+          return 0;
+        }
+
+      ret = nxsem_wait(&dev->d_rdsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  pipe_barrier();
+
+  avail = (wrndx > rdndx) ? (size_t)(wrndx - rdndx) :
+                            (size_t)(dev->d_bufsize - rdndx + wrndx);
+  nread = MIN(len, avail);
+
+  /* Copy out in at most two pieces */
+
+  ncopy = MIN(nread, (size_t)(dev->d_bufsize - rdndx));
+  memcpy(buffer, &dev->d_buffer[rdndx], ncopy);
+  if (ncopy < nread)
+    {
+      memcpy(buffer + ncopy, dev->d_buffer, nread - ncopy);
+    }
+
+  pipe_barrier();
+
+  rdndx += nread;
+  if (rdndx >= dev->d_bufsize)
+    {
+      rdndx -= dev->d_bufsize;
+    }
+
+  oldrdndx     = dev->d_rdndx;
+  dev->d_rdndx = rdndx;
+  pipe_barrier();
+
+  /* Full -> non-full transition:  Wake up the writer.  The writer's index
+   * must be re-read after publishing d_rdndx.  A snapshot taken before the
+   * copy could miss a writer that filled the ring and went to sleep in the
+   * meantime.  If the writer has not seen the new d_rdndx, it still stops
+   * one slot short of the old one.
+   */
+
+  wrndx = dev->d_wrndx + 1;
+  if (wrndx >= dev->d_bufsize)
+    {
+      wrndx = 0;
+    }
+
+  if (wrndx == oldrdndx)
+    {
+      pipecommon_wakeup(&dev->d_wrsem);
+
+#ifndef CONFIG_DISABLE_POLL
+      pipecommon_semtake(&dev->d_bfsem);
+      pipecommon_pollnotify(dev, POLLOUT);
+      nxsem_post(&dev->d_bfsem);
+#endif
+    }
+
+  pipe_dumpbuffer("From PIPE:", (FAR uint8_t *)buffer, nread);
+  return nread;
+}
+#endif
+
+/****************************************************************************
+ * Name: pipecommon_spsc_write
+ *
+ * Description:
+ *   write() in SPSC mode.  Only the writer modifies d_wrndx, so no lock is
+ *   needed to add data.  The reader is woken only if the ring was empty
+ *   when the new d_wrndx was published.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+static ssize_t pipecommon_spsc_write(FAR struct file *filep,
+                                     FAR struct pipe_dev_s *dev,
+                                     FAR const char *buffer, size_t len)
+{
+  pipe_ndx_t wrndx;
+  pipe_ndx_t rdndx;
+  size_t nwritten = 0;
+  size_t space;
+  size_t nxfer;
+  size_t ncopy;
+  int ret;
+
+  while (nwritten < len)
+    {
+      wrndx = dev->d_wrndx;
+      rdndx = dev->d_rdndx;
+
+      space = (rdndx > wrndx) ? (size_t)(rdndx - wrndx - 1) :
+                                (size_t)(dev->d_bufsize - wrndx + rdndx - 1);
+
+      if (space == 0)
+        {
+          /* The ring is full */
+
+          if (dev->d_nreaders <= 0)
+            {
+              return nwritten > 0 ? (ssize_t)nwritten : -EPIPE;
+            }
+
+          if (filep->f_oflags & O_NONBLOCK)
+            {
+              return nwritten > 0 ? (ssize_t)nwritten : -EAGAIN;
+            }
+
+          ret = nxsem_wait(&dev->d_wrsem);
+          if (ret < 0)
+            {
+              return nwritten > 0 ? (ssize_t)nwritten : ret;
+            }
+
+          continue;
+        }
+
+      pipe_barrier();
+
+      /* Copy in at most two pieces */
+
+      nxfer = MIN(len - nwritten, space);
+      ncopy = MIN(nxfer, (size_t)(dev->d_bufsize - wrndx));
+      memcpy(&dev->d_buffer[wrndx], buffer + nwritten, ncopy);
+      if (ncopy < nxfer)
+        {
+          memcpy(dev->d_buffer, buffer + nwritten + ncopy, nxfer - ncopy);
+        }
+
+      pipe_barrier();
+
+      dev->d_wrndx = (wrndx + nxfer) % dev->d_bufsize;
+      nwritten += nxfer;
+      pipe_barrier();
+
+      /* Empty -> non-empty transition:  Wake up the reader.  The reader's
+       * index must be re-read after publishing d_wrndx.  A snapshot taken
+       * before the copy could miss a reader that drained the ring and went
+       * to sleep in the meantime.
+       */
+
+      if (dev->d_rdndx == wrndx)
+        {
+          pipecommon_wakeup(&dev->d_rdsem);
+
+#ifndef CONFIG_DISABLE_POLL
+          pipecommon_semtake(&dev->d_bfsem);
+          pipecommon_pollnotify(dev, POLLIN);
+          nxsem_post(&dev->d_bfsem);
+#endif
+        }
+    }
+
+  return nwritten;
+}
+#endif
+
+/****************************************************************************
+ * Name: pipecommon_spliceout
+ *
+ * Description:
+ *   Move data from the pipe ring buffer directly to another file or socket
+ *   descriptor.  The pipe is locked while the data is written so that the
+ *   bytes being sent cannot be consumed by a concurrent read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPLICE
+static int pipecommon_spliceout(FAR struct file *filep,
+                                FAR struct pipe_dev_s *dev,
+                                FAR const struct pipe_splice_s *splice)
+{
+  size_t total = 0;
+  size_t nseg;
+  ssize_t nxfer = 0;
+  int ret;
+
+  ret = nxsem_wait(&dev->d_bfsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* If the pipe is empty, then wait for something to be written to it */
+
+  while (dev->d_wrndx == dev->d_rdndx)
+    {
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return -EAGAIN;
+        }
+
+      if (dev->d_nwriters <= 0)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return 0;
+        }
+
+      sched_lock();
+      nxsem_post(&dev->d_bfsem);
+      ret = nxsem_wait(&dev->d_rdsem);
+      sched_unlock();
+
+      if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Write the contiguous pieces of buffered data straight from the ring */
+
+  while (total < splice->ps_len && dev->d_wrndx != dev->d_rdndx)
+    {
+      if (dev->d_wrndx > dev->d_rdndx)
+        {
+          nseg = dev->d_wrndx - dev->d_rdndx;
+        }
+      else
+        {
+          nseg = dev->d_bufsize - dev->d_rdndx;
+        }
+
+      nseg  = MIN(nseg, splice->ps_len - total);
+      nxfer = nx_write(splice->ps_fd, &dev->d_buffer[dev->d_rdndx], nseg);
+      if (nxfer <= 0)
+        {
+          break;
+        }
+
+      dev->d_rdndx = (dev->d_rdndx + nxfer) % dev->d_bufsize;
+      total += nxfer;
+
+      if ((size_t)nxfer < nseg)
+        {
+          break;
+        }
+    }
+
+  if (total > 0)
+    {
+      pipecommon_wakeup(&dev->d_wrsem);
+      pipecommon_pollnotify(dev, POLLOUT);
+    }
+
+  nxsem_post(&dev->d_bfsem);
+  return total > 0 ? (int)total : (int)nxfer;
+}
+#endif
+
+/****************************************************************************
+ * Name: pipecommon_splicein
+ *
+ * Description:
+ *   Move data from another file or socket descriptor directly into the
+ *   free space of the pipe ring buffer.  At most one read is performed on
+ *   the source descriptor; the pipe is locked while it is in progress.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPLICE
+static int pipecommon_splicein(FAR struct file *filep,
+                               FAR struct pipe_dev_s *dev,
+                               FAR const struct pipe_splice_s *splice)
+{
+  size_t nseg;
+  ssize_t nxfer;
+  int ret;
+
+  if (dev->d_nreaders <= 0)
+    {
+      return -EPIPE;
+    }
+
+  ret = nxsem_wait(&dev->d_bfsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait for space in the ring */
+
+  for (; ; )
+    {
+      if (dev->d_rdndx > dev->d_wrndx)
+        {
+          nseg = dev->d_rdndx - dev->d_wrndx - 1;
+        }
+      else
+        {
+          /* Up to the end of the buffer, keeping one slot empty if the
+           * read index is at the start.
+           */
+
+          nseg = dev->d_bufsize - dev->d_wrndx - (dev->d_rdndx == 0 ? 1 : 0);
+        }
+
+      if (nseg > 0)
+        {
+          break;
+        }
+
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return -EAGAIN;
+        }
+
+      sched_lock();
+      nxsem_post(&dev->d_bfsem);
+      pipecommon_semtake(&dev->d_wrsem);
+      sched_unlock();
+      pipecommon_semtake(&dev->d_bfsem);
+    }
+
+  nseg  = MIN(nseg, splice->ps_len);
+  nxfer = nx_read(splice->ps_fd, &dev->d_buffer[dev->d_wrndx], nseg);
+  if (nxfer > 0)
+    {
+      dev->d_wrndx = (dev->d_wrndx + nxfer) % dev->d_bufsize;
+
+      pipecommon_wakeup(&dev->d_rdsem);
+      pipecommon_pollnotify(dev, POLLIN);
+    }
+
+  nxsem_post(&dev->d_bfsem);
+  return (int)nxfer;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -359,6 +782,17 @@ int pipecommon_close(FAR struct file *filep)
                   nxsem_post(&dev->d_rdsem);
                 }
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+              /* An SPSC reader checks d_nwriters without the lock and may be
+               * just about to wait.
+               */
+
+              if (PIPE_IS_SPSC(dev->d_flags))
+                {
+                  pipecommon_wakeup(&dev->d_rdsem);
+                }
+#endif
+
               /* Inform poll readers that other end closed. */
 
               pipecommon_pollnotify(dev, POLLHUP);
@@ -373,6 +807,15 @@ int pipecommon_close(FAR struct file *filep)
         {
           if (--dev->d_nreaders <= 0)
             {
+#ifdef CONFIG_DEV_PIPE_SPSC
+              /* Let an SPSC writer waiting for space see EPIPE */
+
+              if (PIPE_IS_SPSC(dev->d_flags))
+                {
+                  pipecommon_wakeup(&dev->d_wrsem);
+                }
+#endif
+
               if (PIPE_IS_POLICY_0(dev->d_flags))
                 {
                   /* Inform poll writers that other end closed. */
@@ -404,6 +847,19 @@ int pipecommon_close(FAR struct file *filep)
       dev->d_nwriters = 0;
       dev->d_nreaders = 0;
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+      /* SPSC mode lasts until the last close.  Drop any wakeup counts that
+       * were left over by the transition-only signaling.
+       */
+
+      if (PIPE_IS_SPSC(dev->d_flags))
+        {
+          PIPE_SPSC_OFF(dev->d_flags);
+          (void)nxsem_reset(&dev->d_rdsem, 0);
+          (void)nxsem_reset(&dev->d_wrsem, 0);
+        }
+#endif
+
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
       /* If, in addition, we have been unlinked, then also need to free the
        * device structure as well to prevent a memory leak.
@@ -443,6 +899,13 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
       return 0;
     }
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+  if (PIPE_IS_SPSC(dev->d_flags))
+    {
+      return pipecommon_spsc_read(filep, dev, buffer, len);
+    }
+#endif
+
   /* Make sure that we have exclusive access to the device structure */
 
   ret = nxsem_wait(&dev->d_bfsem);
@@ -565,6 +1028,13 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
 
   DEBUGASSERT(up_interrupt_context() == false);
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+  if (PIPE_IS_SPSC(dev->d_flags))
+    {
+      return pipecommon_spsc_write(filep, dev, buffer, len);
+    }
+#endif
+
   /* Make sure that we have exclusive access to the device structure */
 
   ret = nxsem_wait(&dev->d_bfsem);
@@ -804,10 +1274,53 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     }
 #endif
 
+#ifdef CONFIG_DEV_PIPE_SPLICE
+  /* The splice commands manage the device semaphore themselves */
+
+  if (cmd == PIPEIOC_SPLICEIN || cmd == PIPEIOC_SPLICEOUT)
+    {
+      FAR const struct pipe_splice_s *splice =
+        (FAR const struct pipe_splice_s *)((uintptr_t)arg);
+
+      if (splice == NULL)
+        {
+          return -EINVAL;
+        }
+
+      if (cmd == PIPEIOC_SPLICEIN)
+        {
+          return (filep->f_oflags & O_WROK) != 0 ?
+                 pipecommon_splicein(filep, dev, splice) : -EBADF;
+        }
+      else
+        {
+          return (filep->f_oflags & O_RDOK) != 0 ?
+                 pipecommon_spliceout(filep, dev, splice) : -EBADF;
+        }
+    }
+#endif
+
   pipecommon_semtake(&dev->d_bfsem);
 
   switch (cmd)
     {
+#ifdef CONFIG_DEV_PIPE_SPSC
+      case PIPEIOC_SPSC:
+        {
+          if (arg != 0)
+            {
+              PIPE_SPSC_ON(dev->d_flags);
+            }
+          else
+            {
+              PIPE_SPSC_OFF(dev->d_flags);
+            }
+
+          ret = OK;
+        }
+        break;
+#endif
+
       case PIPEIOC_POLICY:
         {
           if (arg != 0)
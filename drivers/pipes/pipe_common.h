@@ -98,6 +98,7 @@
 
 #define PIPE_FLAG_POLICY    (1 << 0) /* Bit 0: Policy=Free buffer when empty */
 #define PIPE_FLAG_UNLINKED  (1 << 1) /* Bit 1: The driver has been unlinked */
+#define PIPE_FLAG_SPSC      (1 << 2) /* Bit 2: Lock-free single reader/writer */
 
 #define PIPE_POLICY_0(f)    do { (f) &= ~PIPE_FLAG_POLICY; } while (0)
 #define PIPE_POLICY_1(f)    do { (f) |= PIPE_FLAG_POLICY; } while (0)
@@ -107,6 +108,14 @@
 #define PIPE_UNLINK(f)      do { (f) |= PIPE_FLAG_UNLINKED; } while (0)
 #define PIPE_IS_UNLINKED(f) (((f) & PIPE_FLAG_UNLINKED) != 0)
 
+#define PIPE_SPSC_ON(f)     do { (f) |= PIPE_FLAG_SPSC; } while (0)
+#define PIPE_SPSC_OFF(f)    do { (f) &= ~PIPE_FLAG_SPSC; } while (0)
+#ifdef CONFIG_DEV_PIPE_SPSC
+#  define PIPE_IS_SPSC(f)   (((f) & PIPE_FLAG_SPSC) != 0)
+#else
+#  define PIPE_IS_SPSC(f)   (false)
+#endif
+
 
 /****************************************************************************
  * Public Types
@@ -132,8 +141,8 @@ struct pipe_dev_s
   sem_t      d_bfsem;       /* Used to serialize access to d_buffer and indices */
   sem_t      d_rdsem;       /* Empty buffer - Reader waits for data write */
   sem_t      d_wrsem;       /* Full buffer - Writer waits for data read */
-  pipe_ndx_t d_wrndx;       /* Index in d_buffer to save next byte written */
-  pipe_ndx_t d_rdndx;       /* Index in d_buffer to return the next byte read */
+  volatile pipe_ndx_t d_wrndx; /* Index in d_buffer to save next byte written */
+  volatile pipe_ndx_t d_rdndx; /* Index in d_buffer to return the next byte read */
   pipe_ndx_t d_bufsize;     /* allocated size of d_buffer in bytes */
   uint8_t    d_refs;        /* References counts on pipe (limited to 255) */
   uint8_t    d_nwriters;    /* Number of reference counts for write access */
@@ -144,6 +144,17 @@ struct pm_domain_s
   /* Timer to decrease state */
 
   WDOG_ID wdog;
+
+#ifdef CONFIG_PM_GOVERNOR
+  /* latency   - Exit latency and residency of each state (may be NULL)
+   * etime     - The time (in ticks) that the current state was entered
+   * residency - Residency statistics of each state
+   */
+
+  FAR const struct pm_latency_s *latency;
+  clock_t etime;
+  struct pm_residency_s residency[PM_COUNT];
+#endif
 };
 
 /* This structure encapsulates all of the global data used by the PM module */
@@ -213,6 +224,51 @@ EXTERN struct pm_global_s g_pmglobals;
 
 void pm_update(int domain, int16_t accum);
 
+#ifdef CONFIG_PM_GOVERNOR
+/****************************************************************************
+ * Name: pm_governor
+ *
+ * Description:
+ *   This internal function is called by pm_checkstate() to limit the state
+ *   recommended from the activity to one that can be left before the next
+ *   watchdog timer expires.
+ *
+ * Input Parameters:
+ *   domain - The PM domain
+ *   state  - The state recommended from the activity of the domain
+ *
+ * Returned Value:
+ *   The deepest state, not deeper than 'state', that is worth entering.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+enum pm_state_e pm_governor(int domain, enum pm_state_e state);
+
+/****************************************************************************
+ * Name: pm_account
+ *
+ * Description:
+ *   This internal function is called by pm_changestate() to update the
+ *   residency statistics when the state of a domain changes.
+ *
+ * Input Parameters:
+ *   domain   - The PM domain
+ *   newstate - The state being entered
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled, before the new state is set.
+ *
+ ****************************************************************************/
+
+void pm_account(int domain, enum pm_state_e newstate);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
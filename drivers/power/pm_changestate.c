@@ -310,6 +310,9 @@ int pm_changestate(int domain, enum pm_state_e newstate)
   pm_changeall(domain, newstate);
   if (newstate != PM_RESTORE)
     {
+#ifdef CONFIG_PM_GOVERNOR
+      pm_account(domain, newstate);
+#endif
       g_pmglobals.domain[domain].state = newstate;
 
       /* Start PM timer to decrease PM state */
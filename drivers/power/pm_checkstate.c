@@ -87,6 +87,7 @@
 enum pm_state_e pm_checkstate(int domain)
 {
   FAR struct pm_domain_s *pdom;
+  enum pm_state_e state;
   clock_t now, elapsed;
   irqstate_t flags;
   int index;
@@ -140,9 +141,18 @@ enum pm_state_e pm_checkstate(int domain)
         }
     }
 
-  leave_critical_section(flags);
+  state = pdom->recommended;
+
+#ifdef CONFIG_PM_GOVERNOR
+  /* Do not go deeper than the next timer deadline allows.  This does not
+   * change the recommendation of the activity algorithm.
+   */
 
-  return pdom->recommended;
+  state = pm_governor(domain, state);
+#endif
+
+  leave_critical_section(flags);
+  return state;
 }
 
 #endif /* CONFIG_PM */
@@ -0,0 +1,209 @@
+/****************************************************************************
+ * drivers/power/pm_governor.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include <nuttx/power/pm.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/wdog.h>
+
+#include "pm.h"
+
+#ifdef CONFIG_PM_GOVERNOR
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pm_setlatency
+ *
+ * Description:
+ *   Provide the exit latency and the target residency of each power state
+ *   of a domain.  Until this is called, pm_checkstate() recommends states
+ *   based only on the activity of the domain.
+ *
+ * Input Parameters:
+ *   domain  - The PM domain
+ *   latency - An array of PM_COUNT entries indexed by enum pm_state_e.
+ *             The array must persist.  NULL disables the governor.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_setlatency(int domain, FAR const struct pm_latency_s *latency)
+{
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS);
+  g_pmglobals.domain[domain].latency = latency;
+}
+
+/****************************************************************************
+ * Name: pm_residency
+ *
+ * Description:
+ *   Return the residency statistics of one power state of a domain.  The
+ *   time spent in the current state so far is included.
+ *
+ * Input Parameters:
+ *   domain - The PM domain
+ *   state  - The power state
+ *   res    - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_residency(int domain, enum pm_state_e state,
+                  FAR struct pm_residency_s *res)
+{
+  FAR struct pm_domain_s *pdom;
+  irqstate_t flags;
+
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS);
+  DEBUGASSERT(state >= PM_NORMAL && state < PM_COUNT && res != NULL);
+  pdom = &g_pmglobals.domain[domain];
+
+  flags = enter_critical_section();
+  *res = pdom->residency[state];
+
+  if (pdom->state == state)
+    {
+      res->ticks += clock_systimer() - pdom->etime;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: pm_governor
+ *
+ * Description:
+ *   This internal function is called by pm_checkstate() to limit the state
+ *   recommended from the activity to one that can be left before the next
+ *   watchdog timer expires.
+ *
+ * Input Parameters:
+ *   domain - The PM domain
+ *   state  - The state recommended from the activity of the domain
+ *
+ * Returned Value:
+ *   The deepest state, not deeper than 'state', that is worth entering.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+enum pm_state_e pm_governor(int domain, enum pm_state_e state)
+{
+  FAR const struct pm_latency_s *latency;
+  uint64_t idle;
+  int next;
+
+  latency = g_pmglobals.domain[domain].latency;
+  if (latency == NULL || state <= PM_NORMAL)
+    {
+      return state;
+    }
+
+  /* The system must be back in PM_NORMAL when the next watchdog expires.
+   * With no active watchdog, only an external event can end the IDLE
+   * period and any state is acceptable.
+   */
+
+  next = wd_nexttime();
+  if (next == INT_MAX)
+    {
+      return state;
+    }
+
+  idle = TICK2USEC((uint64_t)next);
+
+  while (state > PM_NORMAL &&
+         (uint64_t)latency[state].exit_us + latency[state].residency_us > idle)
+    {
+      state--;
+    }
+
+  return state;
+}
+
+/****************************************************************************
+ * Name: pm_account
+ *
+ * Description:
+ *   This internal function is called by pm_changestate() to update the
+ *   residency statistics when the state of a domain changes.
+ *
+ * Input Parameters:
+ *   domain   - The PM domain
+ *   newstate - The state being entered
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled, before the new state is set.
+ *
+ ****************************************************************************/
+
+void pm_account(int domain, enum pm_state_e newstate)
+{
+  FAR struct pm_domain_s *pdom = &g_pmglobals.domain[domain];
+  clock_t now;
+
+  if (newstate != pdom->state)
+    {
+      now = clock_systimer();
+
+      pdom->residency[pdom->state].ticks += now - pdom->etime;
+      pdom->residency[newstate].count++;
+      pdom->etime = now;
+    }
+}
+
+#endif /* CONFIG_PM_GOVERNOR */
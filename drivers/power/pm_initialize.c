@@ -99,6 +99,10 @@ void pm_initialize(void)
       pdom = &g_pmglobals.domain[i];
       pdom->stime = clock_systimer();
       pdom->btime = clock_systimer();
+#ifdef CONFIG_PM_GOVERNOR
+      pdom->etime = pdom->btime;
+      pdom->residency[PM_NORMAL].count = 1;
+#endif
     }
 }
 
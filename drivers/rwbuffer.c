@@ -44,6 +44,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <assert.h>
@@ -52,7 +53,9 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/drivers/rwbuffer.h>
 
 #if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
@@ -71,6 +74,31 @@
 #  error "Worker thread support is required (CONFIG_SCHED_WORKQUEUE)"
 #endif
 
+#ifndef CONFIG_DRVR_WRITEBEHIND_PRIORITY
+#  define CONFIG_DRVR_WRITEBEHIND_PRIORITY 100
+#endif
+
+#ifndef CONFIG_DRVR_WRITEBEHIND_STACKSIZE
+#  define CONFIG_DRVR_WRITEBEHIND_STACKSIZE 1024
+#endif
+
+/* Asynchronous prefetch of the next read-ahead window runs on the low
+ * priority work queue.
+ */
+
+#undef RWB_PREFETCH
+#if defined(CONFIG_DRVR_READAHEAD_ADAPTIVE) && defined(CONFIG_SCHED_LPWORK)
+#  define RWB_PREFETCH 1
+#endif
+
+/* The number of blocks to load into the read-ahead buffer on a miss */
+
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+#  define RWB_RHWINDOW(r) ((r)->rhwindow)
+#else
+#  define RWB_RHWINDOW(r) ((r)->rhmaxblocks)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -154,19 +182,148 @@ static inline void rwb_resetwrbuffer(struct rwbuffer_s *rwb)
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_wbstart
+ *
+ * Description:
+ *   Hand the contents of the write buffer off to the write-behind thread.
+ *   If a previous write-behind transfer is still in progress, this waits
+ *   for it to complete.  The buffers are then swapped so that the caller
+ *   may continue to fill the (now empty) write buffer while the media
+ *   write proceeds.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+static void rwb_wbstart(FAR struct rwbuffer_s *rwb)
+{
+  FAR uint8_t *buffer;
+
+  if (rwb->wrnblocks > 0)
+    {
+      finfo("Write-behind: blockstart=0x%08lx nblocks=%d\n",
+            (long)rwb->wrblockstart, rwb->wrnblocks);
+
+      /* Wait for the write-behind thread to become idle */
+
+      (void)nxsem_wait_uninterruptible(&rwb->wbdonesem);
+
+      /* Swap the buffers */
+
+      buffer             = rwb->wbbuffer;
+      rwb->wbbuffer      = rwb->wrbuffer;
+      rwb->wrbuffer      = buffer;
+      rwb->wbblockstart  = rwb->wrblockstart;
+      rwb->wbnblocks     = rwb->wrnblocks;
+
+      rwb_resetwrbuffer(rwb);
+
+      /* And start the transfer */
+
+      rwb_semgive(&rwb->wbreqsem);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wbwait
+ *
+ * Description:
+ *   Wait for any write-behind transfer in progress to complete.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+static void rwb_wbwait(FAR struct rwbuffer_s *rwb)
+{
+  (void)nxsem_wait_uninterruptible(&rwb->wbdonesem);
+  rwb_semgive(&rwb->wbdonesem);
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wbthread
+ *
+ * Description:
+ *   The write-behind thread.  Writes the buffers handed off by
+ *   rwb_wbstart() to the media.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+static int rwb_wbthread(int argc, FAR char *argv[])
+{
+  FAR struct rwbuffer_s *rwb;
+  ssize_t ret;
+
+  /* The rwbuffer instance is passed as a hexadecimal address in argv[1] */
+
+  DEBUGASSERT(argc == 2);
+  rwb = (FAR struct rwbuffer_s *)((uintptr_t)strtoul(argv[1], NULL, 16));
+  DEBUGASSERT(rwb != NULL);
+
+  for (; ; )
+    {
+      (void)nxsem_wait_uninterruptible(&rwb->wbreqsem);
+      if (rwb->wbstop)
+        {
+          break;
+        }
+
+      ret = rwb->wrflush(rwb->dev, rwb->wbbuffer, rwb->wbblockstart,
+                         rwb->wbnblocks);
+      if (ret != rwb->wbnblocks)
+        {
+          ferr("ERROR: Error writing behind: %d\n", (int)ret);
+
+          /* Keep the first error until it is reported by rwb_flush() */
+
+          if (rwb->wbresult == OK)
+            {
+              rwb->wbresult = ret < 0 ? (int)ret : -EIO;
+            }
+        }
+
+      rwb->wbnblocks = 0;
+      rwb_semgive(&rwb->wbdonesem);
+    }
+
+  /* Let rwb_uninitialize() know that we are exiting */
+
+  rwb_semgive(&rwb->wbdonesem);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_wrflush
  *
+ * Description:
+ *   Synchronously flush the write buffer to the media.  Returns OK or, if
+ *   write-behind is enabled, the first error reported by the write-behind
+ *   thread since the last flush.
+ *
  * Assumptions:
  *   The caller holds the wrsem semaphore.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(struct rwbuffer_s *rwb)
+static int rwb_wrflush(struct rwbuffer_s *rwb)
 {
   int ret;
 
+#ifdef CONFIG_DRVR_WRITEBEHIND
+  rwb_wbstart(rwb);
+  rwb_wbwait(rwb);
+
+  ret           = rwb->wbresult;
+  rwb->wbresult = OK;
+  return ret;
+#else
   if (rwb->wrnblocks > 0)
     {
       finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
@@ -186,6 +343,8 @@ static void rwb_wrflush(struct rwbuffer_s *rwb)
       rwb_resetwrbuffer(rwb);
     }
 
+  return OK;
+#endif
 }
 #endif
 
@@ -209,7 +368,11 @@ static void rwb_wrtimeout(FAR void *arg)
    */
 
   rwb_semtake(&rwb->wrsem);
-  rwb_wrflush(rwb);
+#ifdef CONFIG_DRVR_WRITEBEHIND
+  rwb_wbstart(rwb);
+#else
+  (void)rwb_wrflush(rwb);
+#endif
   rwb_semgive(&rwb->wrsem);
 }
 #endif
@@ -254,7 +417,9 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
                                off_t startblock, uint32_t nblocks,
                                FAR const uint8_t *wrbuffer)
 {
+#ifndef CONFIG_DRVR_WRITEBEHIND
   int ret;
+#endif
 
   /* Write writebuffer Logic */
 
@@ -271,6 +436,11 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
       finfo("writebuffer miss, expected: %08x, given: %08x\n",
             rwb->wrexpectedblock, startblock);
 
+#ifdef CONFIG_DRVR_WRITEBEHIND
+      /* Hand the write buffer off to the write-behind thread */
+
+      rwb_wbstart(rwb);
+#else
       /* Flush the write buffer */
 
       ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart, rwb->wrnblocks);
@@ -281,6 +451,7 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
         }
 
       rwb_resetwrbuffer(rwb);
+#endif
     }
 
   /* writebuffer is empty? Then initialize it */
@@ -359,7 +530,8 @@ rwb_bufferread(struct rwbuffer_s *rwb,  off_t startblock,
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock,
+                        size_t maxblocks)
 {
   off_t  endblock;
   size_t nblocks;
@@ -376,7 +548,12 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
    * read-ahead buffer
    */
 
-  endblock = startblock + rwb->rhmaxblocks;
+  if (maxblocks == 0 || maxblocks > rwb->rhmaxblocks)
+    {
+      maxblocks = rwb->rhmaxblocks;
+    }
+
+  endblock = startblock + maxblocks;
 
   /* Make sure that we don't read past the end of the device */
 
@@ -410,6 +587,95 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_rhprefetch
+ *
+ * Description:
+ *   Prefetch the next read-ahead window of a sequential read stream.  This
+ *   runs on the low priority work queue so that the media transfer
+ *   overlaps with the caller's processing of the previous window.
+ *
+ ****************************************************************************/
+
+#ifdef RWB_PREFETCH
+static void rwb_rhprefetch(FAR void *arg)
+{
+  FAR struct rwbuffer_s *rwb = (FAR struct rwbuffer_s *)arg;
+  off_t startblock;
+  size_t nblocks;
+
+  DEBUGASSERT(rwb != NULL);
+
+  /* Take the semaphores in the same order as rwb_read() */
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  if (rwb->wrmaxblocks > 0)
+    {
+      rwb_semtake(&rwb->wrsem);
+    }
+#endif
+
+  rwb_semtake(&rwb->rhsem);
+
+  /* Is the prefetch still wanted?  The stream may have moved on or the
+   * data may already have been loaded by the reader.
+   */
+
+  startblock = rwb->rhprefetch;
+  nblocks    = rwb->rhwindow;
+
+  if (startblock == rwb->rhexpected && startblock < rwb->nblocks &&
+      (rwb->rhnblocks == 0 || startblock < rwb->rhblockstart ||
+       startblock >= rwb->rhblockstart + rwb->rhnblocks))
+    {
+#ifdef CONFIG_DRVR_WRITEBUFFER
+      if (rwb->wrmaxblocks > 0)
+        {
+#ifdef CONFIG_DRVR_WRITEBEHIND
+          /* Don't read media that is still being written behind */
+
+          if (rwb->wbnblocks > 0 &&
+              rwb_overlap(rwb->wbblockstart, rwb->wbnblocks,
+                          startblock, nblocks))
+            {
+              rwb_wbwait(rwb);
+            }
+#endif
+
+          /* Don't read stale media data for blocks that are still in the
+           * write buffer.
+           */
+
+          if (rwb->wrnblocks > 0 &&
+              rwb_overlap(rwb->wrblockstart, rwb->wrnblocks,
+                          startblock, nblocks))
+            {
+              nblocks = rwb->wrblockstart > startblock ?
+                        rwb->wrblockstart - startblock : 0;
+            }
+        }
+#endif
+
+      if (nblocks > 0)
+        {
+          finfo("Prefetch: startblock=%ld nblocks=%ld\n",
+                (long)startblock, (long)nblocks);
+          (void)rwb_rhreload(rwb, startblock, nblocks);
+        }
+    }
+
+  rwb->rhprefetch = (off_t)-1;
+  rwb_semgive(&rwb->rhsem);
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  if (rwb->wrmaxblocks > 0)
+    {
+      rwb_semgive(&rwb->wrsem);
+    }
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_invalidate_writebuffer
  *
@@ -672,6 +938,10 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 int rwb_initialize(FAR struct rwbuffer_s *rwb)
 {
   uint32_t allocsize;
+#ifdef CONFIG_DRVR_WRITEBEHIND
+  FAR char *argv[2];
+  char arg1[16];
+#endif
 
   /* Sanity checking */
 
@@ -686,6 +956,10 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
   DEBUGASSERT(rwb->wrflush != NULL);
   rwb->wrbuffer = NULL;
 #endif
+#ifdef CONFIG_DRVR_WRITEBEHIND
+  rwb->wbbuffer = NULL;
+  rwb->wbpid    = -1;
+#endif
 #ifdef CONFIG_DRVR_READAHEAD
   DEBUGASSERT(rwb->rhreload != NULL);
   rwb->rhbuffer = NULL;
@@ -719,6 +993,50 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
         }
 
       finfo("Write buffer size: %d bytes\n", allocsize);
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+      /* Allocate the second buffer used for write-behind */
+
+      rwb->wbbuffer = kmm_malloc(allocsize);
+      if (!rwb->wbbuffer)
+        {
+          ferr("Write-behind buffer kmm_malloc(%d) failed\n", allocsize);
+          return -ENOMEM;
+        }
+
+      /* wbdonesem and wbreqsem are used for signaling and, hence, should
+       * not have priority inheritance enabled.
+       */
+
+      nxsem_init(&rwb->wbreqsem, 0, 0);
+      nxsem_setprotocol(&rwb->wbreqsem, SEM_PRIO_NONE);
+      nxsem_init(&rwb->wbdonesem, 0, 1);
+      nxsem_setprotocol(&rwb->wbdonesem, SEM_PRIO_NONE);
+
+      rwb->wbstop       = false;
+      rwb->wbresult     = OK;
+      rwb->wbnblocks    = 0;
+      rwb->wbblockstart = (off_t)-1;
+
+      /* Start the write-behind thread.  The rwbuffer instance is passed
+       * to the thread as a hexadecimal address.
+       */
+
+      snprintf(arg1, sizeof(arg1), "%lx", (unsigned long)((uintptr_t)rwb));
+      argv[0] = arg1;
+      argv[1] = NULL;
+
+      rwb->wbpid = kthread_create("rwb", CONFIG_DRVR_WRITEBEHIND_PRIORITY,
+                                  CONFIG_DRVR_WRITEBEHIND_STACKSIZE,
+                                  (main_t)rwb_wbthread,
+                                  (FAR char * const *)argv);
+      if (rwb->wbpid < 0)
+        {
+          ferr("ERROR: Failed to start the write-behind thread: %d\n",
+               rwb->wbpid);
+          return rwb->wbpid;
+        }
+#endif
     }
 #endif /* CONFIG_DRVR_WRITEBUFFER */
 
@@ -735,6 +1053,16 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
       rwb_resetrhbuffer(rwb);
 
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+      /* The read-ahead window starts small and grows on sequential access */
+
+      rwb->rhwindow   = 1;
+      rwb->rhexpected = (off_t)-1;
+#ifdef RWB_PREFETCH
+      rwb->rhprefetch = (off_t)-1;
+#endif
+#endif
+
       /* Allocate the read-ahead buffer */
 
       rwb->rhbuffer = NULL;
@@ -766,6 +1094,29 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
   if (rwb->wrmaxblocks > 0)
     {
       rwb_wrcanceltimeout(rwb);
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+      if (rwb->wbpid > 0)
+        {
+          /* Wait for the write-behind thread to become idle, then ask it
+           * to exit and wait for it to do so.
+           */
+
+          (void)nxsem_wait_uninterruptible(&rwb->wbdonesem);
+          rwb->wbstop = true;
+          rwb_semgive(&rwb->wbreqsem);
+          (void)nxsem_wait_uninterruptible(&rwb->wbdonesem);
+          rwb->wbpid = -1;
+        }
+
+      nxsem_destroy(&rwb->wbreqsem);
+      nxsem_destroy(&rwb->wbdonesem);
+      if (rwb->wbbuffer)
+        {
+          kmm_free(rwb->wbbuffer);
+        }
+#endif
+
       nxsem_destroy(&rwb->wrsem);
       if (rwb->wrbuffer)
         {
@@ -777,6 +1128,9 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
+#ifdef RWB_PREFETCH
+      (void)work_cancel(LPWORK, &rwb->rhwork);
+#endif
       nxsem_destroy(&rwb->rhsem);
       if (rwb->rhbuffer)
         {
@@ -803,6 +1157,32 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
       /* Loop until we have read all of the requested blocks */
 
       rwb_semtake(&rwb->rhsem);
+
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+      /* Ramp up the read-ahead window while the access pattern is
+       * sequential; drop back to the size of the request otherwise.
+       */
+
+      if (startblock == rwb->rhexpected)
+        {
+          if (rwb->rhwindow < rwb->rhmaxblocks)
+            {
+              rwb->rhwindow <<= 1;
+            }
+        }
+      else
+        {
+          rwb->rhwindow = nblocks > 0 ? nblocks : 1;
+        }
+
+      if (rwb->rhwindow > rwb->rhmaxblocks)
+        {
+          rwb->rhwindow = rwb->rhmaxblocks;
+        }
+
+      rwb->rhexpected = startblock + nblocks;
+#endif
+
       for (remaining = nblocks; remaining > 0; )
         {
           /* Is there anything in the read-ahead buffer? */
@@ -834,9 +1214,29 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
            * to refill the buffer and try again.
            */
 
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+          /* The remainder would not fit in the read-ahead buffer anyway.
+           * Read it directly into the caller's buffer.
+           */
+
+          if (remaining >= rwb->rhmaxblocks)
+            {
+              ret = rwb->rhreload(rwb->dev, rdbuffer, startblock, remaining);
+              if (ret != remaining)
+                {
+                  ferr("ERROR: Failed to read %ld blocks: %d\n",
+                       (long)remaining, ret);
+                  rwb_semgive(&rwb->rhsem);
+                  return ret < 0 ? (ssize_t)ret : -EIO;
+                }
+
+              break;
+            }
+#endif
+
           if (remaining > 0)
             {
-              ret = rwb_rhreload(rwb, startblock);
+              ret = rwb_rhreload(rwb, startblock, RWB_RHWINDOW(rwb));
               if (ret < 0)
                 {
                   ferr("ERROR: Failed to fill the read-ahead buffer: %d\n", ret);
@@ -846,6 +1246,24 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
             }
         }
 
+#ifdef RWB_PREFETCH
+      /* If a sequential stream has consumed the read-ahead buffer, start
+       * loading the next window now so that it is ready by the time the
+       * next request arrives.
+       */
+
+      if (rwb->rhwindow > nblocks &&
+          (rwb->rhnblocks == 0 ||
+           rwb->rhexpected >= rwb->rhblockstart + rwb->rhnblocks) &&
+          rwb->rhexpected < rwb->nblocks &&
+          work_available(&rwb->rhwork))
+        {
+          rwb->rhprefetch = rwb->rhexpected;
+          (void)work_queue(LPWORK, &rwb->rhwork, rwb_rhprefetch,
+                           (FAR void *)rwb, 0);
+        }
+#endif
+
       /* On success, return the number of blocks that we were requested to
        * read. This is for compatibility with the normal return of a block
        * driver read method
@@ -890,6 +1308,18 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
       /* If the write buffer overlaps the block(s) requested */
 
       rwb_semtake(&rwb->wrsem);
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+      /* Don't read media that is still being written behind */
+
+      if (rwb->wbnblocks > 0 &&
+          rwb_overlap(rwb->wbblockstart, rwb->wbnblocks,
+                      startblock, nblocks))
+        {
+          rwb_wbwait(rwb);
+        }
+#endif
+
       if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock, nblocks))
         {
           size_t rdblocks = 0;
@@ -991,7 +1421,8 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
           /* First flush the cache */
 
           rwb_semtake(&rwb->wrsem);
-          rwb_wrflush(rwb);
+          rwb_wrcanceltimeout(rwb);
+          (void)rwb_wrflush(rwb);
           rwb_semgive(&rwb->wrsem);
 
           /* Then transfer the data directly to the media */
@@ -1069,6 +1500,10 @@ int rwb_mediaremoved(FAR struct rwbuffer_s *rwb)
   if (rwb->wrmaxblocks > 0)
     {
       rwb_semtake(&rwb->wrsem);
+#ifdef CONFIG_DRVR_WRITEBEHIND
+      rwb_wbwait(rwb);
+      rwb->wbresult = OK;
+#endif
       rwb_resetwrbuffer(rwb);
       rwb_semgive(&rwb->wrsem);
     }
@@ -1101,6 +1536,13 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
 {
   int ret;
 
+#ifdef CONFIG_DRVR_WRITEBEHIND
+  if (rwb->wrmaxblocks > 0)
+    {
+      rwb_wbwait(rwb);
+    }
+#endif
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   ret = rwb_invalidate_writebuffer(rwb, startblock, blockcount);
   if (ret < 0)
@@ -1134,12 +1576,14 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
 #ifdef CONFIG_DRVR_WRITEBUFFER
 int rwb_flush(FAR struct rwbuffer_s *rwb)
 {
+  int ret;
+
   rwb_semtake(&rwb->wrsem);
   rwb_wrcanceltimeout(rwb);
-  rwb_wrflush(rwb);
+  ret = rwb_wrflush(rwb);
   rwb_semgive(&rwb->wrsem);
 
-  return OK;
+  return ret;
 }
 #endif
 
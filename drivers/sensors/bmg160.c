@@ -43,6 +43,7 @@
 
 #include <errno.h>
 #include <debug.h>
+#include <fcntl.h>
 #include <string.h>
 #include <semaphore.h>
 
@@ -51,16 +52,38 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/sensors/bmg160.h>
+#include <nuttx/sensors/sensor_fifo.h>
 #include <nuttx/random.h>
 
 #if defined(CONFIG_SPI) && defined(CONFIG_SENSORS_BMG160)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_BMG160_FIFO
+#  define BMG160_FIFO_DEPTH   100   /* Frames in the hardware FIFO */
+#  define BMG160_FRAME_SIZE   6     /* Bytes per X, Y, Z frame */
+#  define BMG160_ODR_PERIOD   500   /* Sample period in us at ODR 2000 Hz */
+
+#  ifndef CONFIG_BMG160_FIFO_WATERMARK
+#    define CONFIG_BMG160_FIFO_WATERMARK 50
+#  endif
+
+#  ifndef CONFIG_BMG160_NSAMPLES
+#    define CONFIG_BMG160_NSAMPLES 400
+#  endif
+#endif
+
 /****************************************************************************
  * Private
  ****************************************************************************/
 
 struct bmg160_sensor_data_s
 {
+#ifdef CONFIG_BMG160_FIFO
+  uint64_t timestamp;         /* Sample time in microseconds */
+#endif
   int16_t x_gyr;              /* Measurement result for x axis */
   int16_t y_gyr;              /* Measurement result for y axis */
   int16_t z_gyr;              /* Measurement result for z axis */
@@ -80,6 +103,11 @@ struct bmg160_dev_s
                                        * retrieving the data from the sensor
                                        * after the arrival of new data was
                                        * signalled in an interrupt */
+#ifdef CONFIG_BMG160_FIFO
+  uint8_t fifobuf[BMG160_FIFO_DEPTH * BMG160_FRAME_SIZE];
+  struct bmg160_sensor_data_s batch[BMG160_FIFO_DEPTH];
+  struct sensor_fifo_s fifo;          /* Timestamped samples for read() */
+#endif
 };
 
 /****************************************************************************
@@ -96,6 +124,9 @@ static void bmg160_read_measurement_data(FAR struct bmg160_dev_s *dev);
 static void bmg160_read_gyroscope_data(FAR struct bmg160_dev_s *dev,
                                        uint16_t * x_gyr, uint16_t * y_gyr,
                                        uint16_t * z_gyr);
+#ifdef CONFIG_BMG160_FIFO
+static void bmg160_read_fifo(FAR struct bmg160_dev_s *dev);
+#endif
 static int bmg160_interrupt_handler(int irq, FAR void *context);
 static void bmg160_worker(FAR void *arg);
 
@@ -293,6 +324,96 @@ static void bmg160_read_gyroscope_data(FAR struct bmg160_dev_s *dev,
   SPI_LOCK(dev->spi, false);
 }
 
+/****************************************************************************
+ * Name: bmg160_read_fifo
+ *
+ * Description:
+ *   Drain the hardware FIFO in one SPI burst and push the timestamped
+ *   samples to the sample queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BMG160_FIFO
+static void bmg160_read_fifo(FAR struct bmg160_dev_s *dev)
+{
+  FAR uint8_t *frame;
+  uint64_t timestamp;
+  uint8_t status;
+  int count;
+  int i;
+
+  /* Lock the SPI bus so that only one device can access it at the same time */
+
+  SPI_LOCK(dev->spi, true);
+
+  /* Read the number of frames in the FIFO */
+
+  SPI_SELECT(dev->spi, dev->config->spi_devid, true);
+  SPI_SEND(dev->spi, BMG160_FIFO_STATUS_REG | 0x80);
+  status = SPI_SEND(dev->spi, 0);
+  SPI_SELECT(dev->spi, dev->config->spi_devid, false);
+
+  count = status & BMG160_FIFO_STATUS_REG_COUNT_bm;
+  if (count > BMG160_FIFO_DEPTH)
+    {
+      count = BMG160_FIFO_DEPTH;
+    }
+
+  /* Burst read all frames.  The FIFO data register does not auto-increment
+   * the address, each further byte is taken from the FIFO.
+   */
+
+  if (count > 0)
+    {
+      SPI_SELECT(dev->spi, dev->config->spi_devid, true);
+      SPI_SEND(dev->spi, BMG160_FIFO_DATA_REG | 0x80);
+      SPI_RECVBLOCK(dev->spi, dev->fifobuf, count * BMG160_FRAME_SIZE);
+      SPI_SELECT(dev->spi, dev->config->spi_devid, false);
+    }
+
+  /* Unlock the SPI bus */
+
+  SPI_LOCK(dev->spi, false);
+
+  if ((status & BMG160_FIFO_STATUS_REG_OVERRUN_bm) != 0)
+    {
+      snwarn("WARNING: FIFO overrun\n");
+    }
+
+  if (count == 0)
+    {
+      return;
+    }
+
+  /* The newest frame was sampled just before the FIFO was read, the older
+   * ones one sample period apart.
+   */
+
+  timestamp = sensor_fifo_timestamp();
+
+  for (i = 0, frame = dev->fifobuf; i < count;
+       i++, frame += BMG160_FRAME_SIZE)
+    {
+      dev->batch[i].timestamp =
+        timestamp - (uint64_t)(count - 1 - i) * BMG160_ODR_PERIOD;
+      dev->batch[i].x_gyr = (int16_t)(frame[0] | (frame[1] << 8));
+      dev->batch[i].y_gyr = (int16_t)(frame[2] | (frame[3] << 8));
+      dev->batch[i].z_gyr = (int16_t)(frame[4] | (frame[5] << 8));
+    }
+
+  if (sensor_fifo_push(&dev->fifo, dev->batch, count) > 0)
+    {
+      snwarn("WARNING: Samples dropped, read() is too slow\n");
+    }
+
+  /* Feed sensor data to entropy pool */
+
+  add_sensor_randomness((dev->batch[count - 1].x_gyr << 16) ^
+                        (dev->batch[count - 1].y_gyr << 8) ^
+                        dev->batch[count - 1].z_gyr);
+}
+#endif
+
 /****************************************************************************
  * Name: bmg160_interrupt_handler
  ****************************************************************************/
@@ -300,7 +421,8 @@ static void bmg160_read_gyroscope_data(FAR struct bmg160_dev_s *dev,
 static int bmg160_interrupt_handler(int irq, FAR void *context)
 {
   /* This function should be called upon a rising edge on the BMG160 new data
-   * interrupt pin since it signals that new data has been measured.
+   * (or FIFO watermark) interrupt pin since it signals that new data has
+   * been measured.
    */
 
   FAR struct bmg160_dev_s *priv = 0;
@@ -337,9 +459,15 @@ static void bmg160_worker(FAR void *arg)
   FAR struct bmg160_dev_s *priv = (FAR struct bmg160_dev_s *)(arg);
   DEBUGASSERT(priv != NULL);
 
+#ifdef CONFIG_BMG160_FIFO
+  /* Drain the FIFO */
+
+  bmg160_read_fifo(priv);
+#else
   /* Read out the latest sensor data */
 
   bmg160_read_measurement_data(priv);
+#endif
 }
 
 /****************************************************************************
@@ -373,16 +501,45 @@ static int bmg160_open(FAR struct file *filep)
 
   bmg160_write_register(priv, BMG160_BW_REG, BMG160_BW_REG_ODR_0_bm);
 
+#ifdef CONFIG_BMG160_FIFO
+  /* Discard samples of a previous session */
+
+  sensor_fifo_reset(&priv->fifo);
+
+  /* Enable - FIFO in stream mode with X, Y and Z data and the configured
+   * watermark.  Writing FIFO_CONFIG_1 also clears the FIFO.
+   */
+
+  bmg160_write_register(priv, BMG160_FIFO_CONFIG_0_REG,
+                        CONFIG_BMG160_FIFO_WATERMARK);
+  bmg160_write_register(priv, BMG160_FIFO_CONFIG_1_REG,
+                        BMG160_FIFO_CONFIG_1_REG_MODE_1_bm);
+
+  /* Enable - FIFO watermark interrupt 1 */
+
+  bmg160_write_register(priv, BMG160_INT_FOUR_REG,
+                        BMG160_INT_FOUR_REG_FIFO_WM_EN_bm);
+  bmg160_write_register(priv,
+                        BMG160_INT_EN_0_REG, BMG160_INT_EN_0_REG_FIFO_EN_bm);
+#else
   /* Enable - new data interrupt 1 */
 
   bmg160_write_register(priv,
                         BMG160_INT_EN_0_REG, BMG160_INT_EN_0_REG_DATA_EN_bm);
+#endif
 
   /* Enable - active high level interrupt 1 - push-pull interrupt */
 
   bmg160_write_register(priv,
                         BMG160_INT_EN_1_REG, BMG160_INT_EN_1_REG_INT1_LVL_bm);
 
+#ifdef CONFIG_BMG160_FIFO
+  /* Enable - map FIFO interrupt to INT1 */
+
+  bmg160_write_register(priv,
+                        BMG160_INT_MAP_1_REG,
+                        BMG160_INT_MAP_1_REG_INT1_FIFO_bm);
+#else
   /* Enable - map new data interrupt to INT1 */
 
   bmg160_write_register(priv,
@@ -392,6 +549,7 @@ static int bmg160_open(FAR struct file *filep)
   /* Read measurement data to ensure DRDY is low */
 
   bmg160_read_measurement_data(priv);
+#endif
 
 #ifdef CONFIG_DEBUG_SENSORS_INFO
   /* Read back the content of all control registers for debug purposes */
@@ -448,6 +606,15 @@ static ssize_t bmg160_read(FAR struct file *filep, FAR char *buffer,
 
   DEBUGASSERT(priv != NULL);
 
+#ifdef CONFIG_BMG160_FIFO
+  /* Return as many queued samples as fit, waiting for at least one */
+
+  UNUSED(data);
+  UNUSED(ret);
+
+  return sensor_fifo_read(&priv->fifo, buffer, buflen,
+                          (filep->f_oflags & O_NONBLOCK) != 0);
+#else
   /* Check if enough memory was provided for the read call */
 
   if (buflen < sizeof(FAR struct bmg160_sensor_data_s))
@@ -480,6 +647,7 @@ static ssize_t bmg160_read(FAR struct file *filep, FAR char *buffer,
   nxsem_post(&priv->datasem);
 
   return sizeof(FAR struct bmg160_sensor_data_s);
+#endif
 }
 
 /****************************************************************************
@@ -563,6 +731,21 @@ int bmg160_register(FAR const char *devpath, FAR struct spi_dev_s *spi,
 
   nxsem_init(&priv->datasem, 0, 1);
 
+#ifdef CONFIG_BMG160_FIFO
+  /* Initialize the sample queue */
+
+  ret = sensor_fifo_initialize(&priv->fifo,
+                               sizeof(struct bmg160_sensor_data_s),
+                               CONFIG_BMG160_NSAMPLES);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to allocate sample queue\n");
+      nxsem_destroy(&priv->datasem);
+      kmm_free(priv);
+      return ret;
+    }
+#endif
+
   /* Setup SPI frequency and mode */
 
   SPI_SETFREQUENCY(spi, BMG160_SPI_FREQUENCY);
@@ -583,8 +766,11 @@ int bmg160_register(FAR const char *devpath, FAR struct spi_dev_s *spi,
   if (ret < 0)
     {
       snerr("ERROR: Failed to register driver: %d\n", ret);
-      kmm_free(priv);
+#ifdef CONFIG_BMG160_FIFO
+      sensor_fifo_uninitialize(&priv->fifo);
+#endif
       nxsem_destroy(&priv->datasem);
+      kmm_free(priv);
       return ret;
     }
 
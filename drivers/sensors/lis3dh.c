@@ -41,6 +41,7 @@
 
 #include <errno.h>
 #include <debug.h>
+#include <fcntl.h>
 #include <string.h>
 #include <semaphore.h>
 
@@ -51,6 +52,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/sensors/lis3dh.h>
 #include <nuttx/sensors/ioctl.h>
+#include <nuttx/sensors/sensor_fifo.h>
 
 #if defined(CONFIG_SPI) && defined(CONFIG_LIS3DH)
 
@@ -58,8 +60,12 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define LIS3DH_QUEUE_MAX 32
-#define LIS3DH_FIFOBUF_SIZE ((32 * 6) + 1)
+#ifndef CONFIG_LIS3DH_NSAMPLES
+#  define CONFIG_LIS3DH_NSAMPLES 128
+#endif
+
+#define LIS3DH_FIFO_DEPTH   32
+#define LIS3DH_FIFOBUF_SIZE ((LIS3DH_FIFO_DEPTH * 6) + 1)
 
 /****************************************************************************
  * Private Types
@@ -72,13 +78,9 @@ struct lis3dh_dev_s
   struct work_s work;                   /* Work Queue */
   uint8_t power_mode;                   /* The power mode used to determine mg/digit */
   uint8_t odr;                          /* The current output data rate */
-  sem_t readsem;                        /* Read notification semaphore */
   uint8_t fifobuf[LIS3DH_FIFOBUF_SIZE]; /* Raw FIFO buffer */
-  struct lis3dh_sensor_data_s queue[LIS3DH_QUEUE_MAX];
-  sem_t queuesem;                       /* Queue exclusive lock */
-  uint8_t queue_rpos;                   /* Queue read position */
-  uint8_t queue_wpos;                   /* Queue write position */
-  uint8_t queue_count;                  /* Number of elements in the queue */
+  struct lis3dh_sensor_data_s batch[LIS3DH_FIFO_DEPTH];
+  struct sensor_fifo_s fifo;            /* Timestamped samples for read() */
 };
 
 struct lis3dh_sample_s
@@ -263,114 +265,45 @@ static int lis3dh_ident(FAR struct lis3dh_dev_s *dev)
 }
 
 /****************************************************************************
- * Name: lis3dh_queue_lock
+ * Name: lis3dh_sample_period
  *
  * Description:
- *   Locks exclusive access to the ring buffer queue
+ *   Returns the time between two samples at the current output data rate.
  *
  * Input Parameters:
  *   dev - Pointer to device driver instance
  *
- ****************************************************************************/
-
-static void lis3dh_queue_lock(FAR struct lis3dh_dev_s *dev)
-{
-  int ret;
-
-  ret = nxsem_wait(&dev->queuesem);
-  if (ret < 0)
-    {
-      snerr("ERROR: queuesem wait error: %d\n", ret);
-      return;
-    }
-}
-
-/****************************************************************************
- * Name: lis3dh_queue_unlock
- *
- * Description:
- *   Unlocks exclusive acccess to the ring buffer queue
- *
- * Input Parameters:
- *   dev - Pointer to device driver instance
+ * Returned Value:
+ *   The sample period in microseconds; zero if the sensor is powered down.
  *
  ****************************************************************************/
 
-static void lis3dh_queue_unlock(FAR struct lis3dh_dev_s *dev)
+static uint32_t lis3dh_sample_period(FAR struct lis3dh_dev_s *dev)
 {
-  nxsem_post(&dev->queuesem);
-}
-
-/****************************************************************************
- * Name: lis3dh_queue_push
- *
- * Description:
- *   Push a sensor measurement into the queue
- *
- * Input Parameters:
- *   dev - Pointer to device driver instance
- *
- ****************************************************************************/
+  static const uint16_t rates[] =
+  {
+    0, 1, 10, 25, 50, 100, 200, 400, 1600, 1344
+  };
 
-static int lis3dh_queue_push(FAR struct lis3dh_dev_s *dev,
-                             struct lis3dh_sensor_data_s *data)
-{
-  lis3dh_queue_lock(dev);
-  if (dev->queue_count >= LIS3DH_QUEUE_MAX)
+  if (dev->odr == LIS3DH_ODR_LP_5376HZ && dev->power_mode == LIS3DH_POWER_LOW)
     {
-      lis3dh_queue_unlock(dev);
-      return -ENOMEM;
+      return 1000000 / 5376;
     }
 
-  dev->queue_wpos++;
-  dev->queue[dev->queue_wpos % LIS3DH_QUEUE_MAX] = *data;
-
-  dev->queue_count++;
-  lis3dh_queue_unlock(dev);
-
-  return OK;
-}
-
-/****************************************************************************
- * Name: lis3dh_queue_pop
- *
- * Description:
- *   Pops a sensor measurement from the queue
- *
- * Input Parameters:
- *   dev - Pointer to device driver instance
- *
- * Returned Value:
- *   OK if a measurement was successfully dequeued
- *   -EAGAIN if the queue is empty
- *
- ****************************************************************************/
-
-static int lis3dh_queue_pop(FAR struct lis3dh_dev_s *dev,
-                            struct lis3dh_sensor_data_s *data)
-{
-  lis3dh_queue_lock(dev);
-  if (dev->queue_count == 0)
+  if (dev->odr == 0 || dev->odr >= sizeof(rates) / sizeof(rates[0]))
     {
-      lis3dh_queue_unlock(dev);
-      return -EAGAIN;
+      return 0;
     }
 
-  dev->queue_rpos++;
-  *data = dev->queue[dev->queue_rpos % LIS3DH_QUEUE_MAX];
-
-  dev->queue_count--;
-
-  lis3dh_queue_unlock(dev);
-
-  return OK;
+  return 1000000 / rates[dev->odr];
 }
 
 /****************************************************************************
  * Name: lis3dh_read_fifo
  *
  * Description:
- *   Reads the FIFO from the LIS3DH sensor, and pushes to the internal queue.
+ *   Reads the FIFO from the LIS3DH sensor in one SPI transfer and pushes
+ *   the timestamped samples to the internal queue.
  *
  * Input Parameters:
  *   dev - Pointer to device driver instance
@@ -381,6 +314,8 @@ static int lis3dh_queue_pop(FAR struct lis3dh_dev_s *dev,
 
 static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
 {
+  uint64_t timestamp;
+  uint32_t period;
   uint8_t fifosrc;
   uint8_t count;
   int i;
@@ -401,6 +336,11 @@ static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
   fifosrc = dev->fifobuf[1];
 
   count = fifosrc & 0x1f;
+  if (count == 0)
+    {
+      SPI_LOCK(dev->spi, false);
+      return OK;
+    }
 
   if (fifosrc & LIS3DH_FIFO_SRC_REG_OVRN_FIFO)
     {
@@ -418,9 +358,16 @@ static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
 
   SPI_LOCK(dev->spi, false);
 
+  /* The newest sample was taken just before the FIFO was read, the older
+   * ones one sample period apart.
+   */
+
+  timestamp = sensor_fifo_timestamp();
+  period    = lis3dh_sample_period(dev);
+
   for (i = 0; i < count; i++)
     {
-      struct lis3dh_sensor_data_s data;
+      FAR struct lis3dh_sensor_data_s *data = &dev->batch[i];
       uint16_t x_raw;
       uint16_t y_raw;
       uint16_t z_raw;
@@ -449,9 +396,9 @@ static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
             y_acc = (int16_t)y_raw >> 8;
             z_acc = (int16_t)z_raw >> 8;
 
-            data.x_acc = (float)x_acc * 0.016;
-            data.y_acc = (float)y_acc * 0.016;
-            data.z_acc = (float)z_acc * 0.016;
+            data->x_acc = (float)x_acc * 0.016;
+            data->y_acc = (float)y_acc * 0.016;
+            data->z_acc = (float)z_acc * 0.016;
             break;
 
           case LIS3DH_POWER_NORMAL:  /* 10 bit measurements */
@@ -459,9 +406,9 @@ static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
             y_acc = (int16_t)y_raw >> 6;
             z_acc = (int16_t)z_raw >> 6;
 
-            data.x_acc = (float)x_acc * 0.004;
-            data.y_acc = (float)y_acc * 0.004;
-            data.z_acc = (float)z_acc * 0.004;
+            data->x_acc = (float)x_acc * 0.004;
+            data->y_acc = (float)y_acc * 0.004;
+            data->z_acc = (float)z_acc * 0.004;
             break;
 
           case LIS3DH_POWER_HIGH:    /* 12 bit measurements */
@@ -469,9 +416,9 @@ static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
             y_acc = (int16_t)y_raw >> 4;
             z_acc = (int16_t)z_raw >> 4;
 
-            data.x_acc = (float)x_acc * 0.001;
-            data.y_acc = (float)y_acc * 0.001;
-            data.z_acc = (float)z_acc * 0.001;
+            data->x_acc = (float)x_acc * 0.001;
+            data->y_acc = (float)y_acc * 0.001;
+            data->z_acc = (float)z_acc * 0.001;
             break;
 
           default:
@@ -479,10 +426,12 @@ static int lis3dh_read_fifo(FAR struct lis3dh_dev_s *dev)
             return -EINVAL;
         }
 
-      if (lis3dh_queue_push(dev, &data) == OK)
-        {
-          nxsem_post(&dev->readsem);
-        }
+      data->timestamp = timestamp - (uint64_t)(count - 1 - i) * period;
+    }
+
+  if (sensor_fifo_push(&dev->fifo, dev->batch, count) > 0)
+    {
+      snwarn("WARNING: Samples dropped, read() is too slow\n");
     }
 
   return OK;
@@ -775,9 +724,11 @@ static int lis3dh_open(FAR struct file *filep)
 
   DEBUGASSERT(priv != NULL);
 
-  /* Perform a reset */
+  /* Perform a reset and discard samples of a previous session */
 
   lis3dh_reset(priv);
+  sensor_fifo_reset(&priv->fifo);
+
   if (lis3dh_ident(priv) < 0)
     {
       snerr("ERROR: Failed to identify LIS3DH on SPI bus\n");
@@ -839,7 +790,8 @@ static int lis3dh_close(FAR struct file *filep)
  * Name: lis3dh_read
  *
  * Description:
- *   Character device read call. Blocks until requested buffer size is full.
+ *   Character device read call.  Blocks until at least one sample is
+ *   available, then returns as many queued samples as fit into the buffer.
  *
  * Input Parameters:
  *   filep - Pointer to struct file
@@ -849,6 +801,7 @@ static int lis3dh_close(FAR struct file *filep)
  * Returned Value:
  *   Returns the number of bytes written to the buffer.
  *   -EINVAL - Supplied buffer length invalid
+ *   -EAGAIN - No sample available and O_NONBLOCK is set
  *
  ****************************************************************************/
 
@@ -857,9 +810,6 @@ static ssize_t lis3dh_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct lis3dh_dev_s *priv = inode->i_private;
-  FAR struct lis3dh_sensor_data_s *data;
-  int count;
-  int remain;
 
   DEBUGASSERT(priv != NULL);
 
@@ -869,29 +819,8 @@ static ssize_t lis3dh_read(FAR struct file *filep, FAR char *buffer,
       return -EINVAL;
     }
 
-  /* Get the number of samples the user has requested */
-
-  count = buflen / sizeof(struct lis3dh_sensor_data_s);
-
-  /* Cast a pointer into the user buffer */
-
-  data = (FAR struct lis3dh_sensor_data_s *)buffer;
-
-  for (remain=count;remain > 0;remain--)
-    {
-
-      /* Wait for data to be available in the queue */
-
-      nxsem_wait(&priv->readsem);
-
-      /* Pop a sample off of the queue */
-
-      lis3dh_queue_pop(priv, data);
-
-      data++;
-    }
-
-  return count * sizeof(struct lis3dh_sensor_data_s);
+  return sensor_fifo_read(&priv->fifo, buffer, buflen,
+                          (filep->f_oflags & O_NONBLOCK) != 0);
 }
 
 /****************************************************************************
@@ -998,16 +927,18 @@ int lis3dh_register(FAR const char *devpath, FAR struct spi_dev_s *spi,
   priv->config = config;
   priv->spi = spi;
   priv->work.worker = NULL;
-  priv->queue_count = 0;
-
-  /* Initialize queue semaphore */
-
-  nxsem_init(&priv->queuesem, 0, 1);
 
-  /* Initialize read notification semaphore */
+  /* Initialize the sample queue */
 
-  nxsem_init(&priv->readsem, 0, 0);
-  nxsem_setprotocol(&priv->readsem, SEM_PRIO_NONE);
+  ret = sensor_fifo_initialize(&priv->fifo,
+                               sizeof(struct lis3dh_sensor_data_s),
+                               CONFIG_LIS3DH_NSAMPLES);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to allocate sample queue\n");
+      kmm_free(priv);
+      return ret;
+    }
 
   /* Setup SPI frequency and mode */
 
@@ -1020,9 +951,8 @@ int lis3dh_register(FAR const char *devpath, FAR struct spi_dev_s *spi,
   if (ret < 0)
     {
       snerr("ERROR: Failed to register driver: %d\n", ret);
+      sensor_fifo_uninitialize(&priv->fifo);
       kmm_free(priv);
-      nxsem_destroy(&priv->queuesem);
-      nxsem_destroy(&priv->readsem);
       return ret;
     }
 
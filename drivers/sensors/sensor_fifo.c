@@ -0,0 +1,300 @@
+/****************************************************************************
+ * drivers/sensors/sensor_fifo.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/sensors/sensor_fifo.h>
+
+#ifdef CONFIG_SENSORS_FIFO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_fifo_takesem
+ ****************************************************************************/
+
+static int sensor_fifo_takesem(FAR sem_t *sem)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(sem);
+      DEBUGASSERT(ret == OK || ret == -EINTR || ret == -ECANCELED);
+    }
+  while (ret == -EINTR);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_fifo_initialize
+ ****************************************************************************/
+
+int sensor_fifo_initialize(FAR struct sensor_fifo_s *fifo, size_t esize,
+                           unsigned int nslots)
+{
+  DEBUGASSERT(fifo != NULL && esize > 0 && esize <= UINT16_MAX &&
+              nslots > 0 && nslots <= UINT16_MAX);
+
+  memset(fifo, 0, sizeof(struct sensor_fifo_s));
+
+  fifo->buffer = (FAR uint8_t *)kmm_malloc(esize * nslots);
+  if (fifo->buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  fifo->esize  = esize;
+  fifo->nslots = nslots;
+
+  nxsem_init(&fifo->exclsem, 0, 1);
+  nxsem_init(&fifo->waitsem, 0, 0);
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_setprotocol(&fifo->waitsem, SEM_PRIO_NONE);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sensor_fifo_uninitialize
+ ****************************************************************************/
+
+void sensor_fifo_uninitialize(FAR struct sensor_fifo_s *fifo)
+{
+  nxsem_destroy(&fifo->exclsem);
+  nxsem_destroy(&fifo->waitsem);
+
+  if (fifo->buffer != NULL)
+    {
+      kmm_free(fifo->buffer);
+      fifo->buffer = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: sensor_fifo_reset
+ ****************************************************************************/
+
+void sensor_fifo_reset(FAR struct sensor_fifo_s *fifo)
+{
+  if (sensor_fifo_takesem(&fifo->exclsem) == OK)
+    {
+      fifo->head  = 0;
+      fifo->count = 0;
+      nxsem_post(&fifo->exclsem);
+    }
+}
+
+/****************************************************************************
+ * Name: sensor_fifo_push
+ ****************************************************************************/
+
+unsigned int sensor_fifo_push(FAR struct sensor_fifo_s *fifo,
+                              FAR const void *samples,
+                              unsigned int nsamples)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)samples;
+  unsigned int overwritten = 0;
+  unsigned int tail;
+  unsigned int n;
+
+  if (nsamples == 0 || sensor_fifo_takesem(&fifo->exclsem) < 0)
+    {
+      return 0;
+    }
+
+  /* If the batch alone exceeds the ring, only its newest part is kept */
+
+  if (nsamples > fifo->nslots)
+    {
+      overwritten  = nsamples - fifo->nslots;
+      src         += overwritten * fifo->esize;
+      nsamples     = fifo->nslots;
+    }
+
+  /* Drop the oldest samples to make room */
+
+  if (fifo->count + nsamples > fifo->nslots)
+    {
+      n            = fifo->count + nsamples - fifo->nslots;
+      fifo->head   = (fifo->head + n) % fifo->nslots;
+      fifo->count -= n;
+      overwritten += n;
+    }
+
+  /* Copy the batch in at most two runs */
+
+  tail = (fifo->head + fifo->count) % fifo->nslots;
+  n    = fifo->nslots - tail;
+  if (n > nsamples)
+    {
+      n = nsamples;
+    }
+
+  memcpy(&fifo->buffer[tail * fifo->esize], src, n * fifo->esize);
+  memcpy(fifo->buffer, src + n * fifo->esize, (nsamples - n) * fifo->esize);
+  fifo->count += nsamples;
+
+  /* Wake up all waiting readers */
+
+  while (fifo->nwaiters > 0)
+    {
+      fifo->nwaiters--;
+      nxsem_post(&fifo->waitsem);
+    }
+
+  nxsem_post(&fifo->exclsem);
+  return overwritten;
+}
+
+/****************************************************************************
+ * Name: sensor_fifo_read
+ ****************************************************************************/
+
+ssize_t sensor_fifo_read(FAR struct sensor_fifo_s *fifo, FAR char *buffer,
+                         size_t buflen, bool nonblock)
+{
+  unsigned int nsamples;
+  unsigned int n;
+  int ret;
+
+  nsamples = buflen / fifo->esize;
+  if (nsamples == 0)
+    {
+      return -EINVAL;
+    }
+
+  ret = sensor_fifo_takesem(&fifo->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (fifo->count == 0)
+    {
+      if (nonblock)
+        {
+          nxsem_post(&fifo->exclsem);
+          return -EAGAIN;
+        }
+
+      fifo->nwaiters++;
+      nxsem_post(&fifo->exclsem);
+
+      ret = nxsem_wait(&fifo->waitsem);
+      if (ret < 0)
+        {
+          /* The pusher may already have counted us out; the extra count
+           * left on waitsem only causes a spurious wakeup later.
+           */
+
+          if (sensor_fifo_takesem(&fifo->exclsem) == OK)
+            {
+              if (fifo->nwaiters > 0)
+                {
+                  fifo->nwaiters--;
+                }
+
+              nxsem_post(&fifo->exclsem);
+            }
+
+          return ret;
+        }
+
+      ret = sensor_fifo_takesem(&fifo->exclsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Copy out the oldest samples in at most two runs */
+
+  if (nsamples > fifo->count)
+    {
+      nsamples = fifo->count;
+    }
+
+  n = fifo->nslots - fifo->head;
+  if (n > nsamples)
+    {
+      n = nsamples;
+    }
+
+  memcpy(buffer, &fifo->buffer[fifo->head * fifo->esize], n * fifo->esize);
+  memcpy(buffer + n * fifo->esize, fifo->buffer,
+         (nsamples - n) * fifo->esize);
+
+  fifo->head   = (fifo->head + nsamples) % fifo->nslots;
+  fifo->count -= nsamples;
+
+  nxsem_post(&fifo->exclsem);
+  return nsamples * fifo->esize;
+}
+
+/****************************************************************************
+ * Name: sensor_fifo_timestamp
+ ****************************************************************************/
+
+uint64_t sensor_fifo_timestamp(void)
+{
+  struct timespec ts;
+
+  (void)clock_systimespec(&ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+#endif /* CONFIG_SENSORS_FIFO */
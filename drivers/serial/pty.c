@@ -459,10 +459,11 @@ static ssize_t pty_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR struct pty_dev_s *dev;
   ssize_t ntotal;
 #ifdef CONFIG_SERIAL_TERMIOS
+  FAR char *src;
+  FAR char *dest;
   ssize_t nread;
-  size_t i;
+  ssize_t i;
   char ch;
-  int ret;
 #endif
 
   DEBUGASSERT(filep != NULL && filep->f_inode != NULL);
@@ -484,130 +485,73 @@ static ssize_t pty_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   if (dev->pd_iflag & (INLCR | IGNCR | ICRNL))
     {
-      /* We will transfer one byte at a time, making the appropriate
-       * translations.
+      /* Read directly into the user buffer and then make the appropriate
+       * translations in place.  The pipe read() method will block if the
+       * pipe is empty and will return early if the pipe becomes empty after
+       * any data has been read.
        */
 
       ntotal = 0;
-      for (i = 0; i < len; i++)
+      do
         {
-#ifndef CONFIG_PSEUDOTERM_FULLBLOCKS
-          /* This logic should return if the pipe becomes empty after some
-           * bytes were read from the pipe.  If we have already read some
-           * data, we use the FIONREAD ioctl to test if there are more bytes
-           * in the pipe.
-           *
-           * REVISIT:  An alternative design might be to (1) configure the
-           * source file as non-blocking, then (2) wait using poll() for the
-           * first byte to be received.  (3) Subsequent bytes would
-           * use file_read() without polling and would (4) terminate when no
-           * data is returned.
+          /* REVISIT: Should not block if the oflags include O_NONBLOCK.
+           * How would we ripple the O_NONBLOCK characteristic to the
+           * contained soruce pipe?  file_vfcntl()?  Or FIONREAD? See the
+           * TODO comment at the top of this file.
            */
 
-          if (ntotal > 0)
+          nread = file_read(&dev->pd_src, &buffer[ntotal], len - ntotal);
+          if (nread <= 0)
             {
-              int nsrc;
-
-              /* There are inherent race conditions in this test.  We lock
-               * the scheduler before the test and after the file_read()
-               * below to eliminate one race:  (a) We detect that there is
-               * data in the source file, (b) we are suspended and another
-               * thread reads the data, emptying the fifo, then (c) we
-               * resume and call file_read(), blocking indefinitely.
-               */
-
-              sched_lock();
-
-              /* Check how many bytes are waiting in the pipe */
+              /* Report an error only if nothing has been transferred */
 
-              ret = file_ioctl(&dev->pd_src, FIONREAD,
-                               (unsigned long)((uintptr_t)&nsrc));
-              if (ret < 0)
+              if (nread < 0 && ntotal == 0)
                 {
-                  sched_unlock();
-                  ntotal = ret;
-                  break;
+                  ntotal = nread;
                 }
 
-              /* Break out of the loop and return ntotal if the pipe is
-               * empty.  This is another race:  There fifo was empty when we
-               * called file_ioctl() above, but it might not be empty right
-               * now.  Losing that race should not lead to any bad behaviors,
-               * however, we the caller will get those bytes on the next
-               * read.
-               */
-
-              if (nsrc < 1)
-                {
-                  sched_unlock();
-                  break;
-                }
-
-              /* Read one byte from the source the byte.  This should not
-               * block.
-               */
-
-              nread = file_read(&dev->pd_src, &ch, 1);
-              sched_unlock();
-            }
-          else
-#else
-          /* If we wanted to return full blocks of data, then file_read()
-           * may need to be called repeatedly.  That is because the pipe
-           * read() method will return early if the fifo becomes empty
-           * after any data has been read.
-           */
-
-# error Missing logic
-#endif
-            {
-              /* Read one byte from the source the byte.  This call will
-               * block if the source pipe is empty.
-               *
-               * REVISIT: Should not block if the oflags include O_NONBLOCK.
-               * How would we ripple the O_NONBLOCK characteristic to the
-               * contained soruce pipe?  file_vfcntl()?  Or FIONREAD? See the
-               * TODO comment at the top of this file.
-               */
-
-              nread = file_read(&dev->pd_src, &ch, 1);
-            }
-
-          /* Check if file_read was successful */
-
-          if (nread < 0)
-            {
-              ntotal = nread;
               break;
             }
 
-          /* Perform input processing */
-          /* \n -> \r or \r -> \n translation? */
+          /* Perform input processing.  Bytes are only moved if a discarded
+           * \r has opened a gap in the buffer.
+           */
 
-          if (ch == '\n' && (dev->pd_iflag & INLCR) != 0)
-            {
-               ch = '\r';
-            }
-          else if (ch == '\r' && (dev->pd_iflag & ICRNL) != 0)
+          src  = &buffer[ntotal];
+          dest = src;
+
+          for (i = 0; i < nread; i++)
             {
-              ch = '\n';
-            }
+              ch = *src++;
 
-          /* Discarding \r ?  Print character if (1) character is not \r or
-           * if (2) we were not asked to ignore \r.
-           */
+              /* \n -> \r or \r -> \n translation? */
 
-          if (ch != '\r' || (dev->pd_iflag & IGNCR) == 0)
-            {
+              if (ch == '\n' && (dev->pd_iflag & INLCR) != 0)
+                {
+                  ch = '\r';
+                }
+              else if (ch == '\r' && (dev->pd_iflag & ICRNL) != 0)
+                {
+                  ch = '\n';
+                }
 
-              /* Transfer the (possibly translated) character and update the
-               * count of bytes transferred.
+              /* Discarding \r ?  Keep the character if (1) character is
+               * not \r or if (2) we were not asked to ignore \r.
                */
 
-              *buffer++ = ch;
-              ntotal++;
+              if (ch != '\r' || (dev->pd_iflag & IGNCR) == 0)
+                {
+                  *dest++ = ch;
+                }
             }
+
+          ntotal = dest - buffer;
         }
+#ifdef CONFIG_PSEUDOTERM_FULLBLOCKS
+      while ((size_t)ntotal < len);
+#else
+      while (ntotal == 0);
+#endif
     }
   else
 #endif
@@ -640,7 +584,9 @@ static ssize_t pty_write(FAR struct file *filep, FAR const char *buffer, size_t
   ssize_t ntotal;
 #ifdef CONFIG_SERIAL_TERMIOS
   ssize_t nwritten;
-  size_t i;
+  size_t nrun;
+  size_t nxlat;
+  char xlat[2];
   char ch;
 #endif
 
@@ -654,64 +600,84 @@ static ssize_t pty_write(FAR struct file *filep, FAR const char *buffer, size_t
 
   if ((dev->pd_oflag & OPOST) != 0)
     {
-      /* We will transfer one byte at a time, making the appropriae
-       * translations.  Specifically not handled:
+      /* We will transfer runs of bytes that need no translation with a
+       * single write, handling only \r and \n individually.  Specifically
+       * not handled:
        *
        *   OXTABS - primarily a full-screen terminal optimisation
        *   ONOEOT - Unix interoperability hack
        *   OLCUC  - Not specified by POSIX
        *   ONOCR  - low-speed interactive optimisation
+       *
+       * REVISIT: Should not block if the oflags include O_NONBLOCK.
+       * How would we ripple the O_NONBLOCK characteristic to the
+       * contained sink pipe?  file_vfcntl()?  Or FIONSPACE?  See the
+       * TODO comment at the top of this file.
        */
 
       ntotal = 0;
-      for (i = 0; i < len; i++)
+      while (len > 0)
         {
-          ch = *buffer++;
+          /* Find the end of the run of bytes that need no translation */
 
-          /* Mapping CR to NL? */
-
-          if (ch == '\r' && (dev->pd_oflag & OCRNL) != 0)
+          for (nrun = 0; nrun < len; nrun++)
             {
-              ch = '\n';
+              if (buffer[nrun] == '\r' || buffer[nrun] == '\n')
+                {
+                  break;
+                }
             }
 
-          /* Are we interested in newline processing? */
+          /* Transfer the run.  This will block if the sink pipe is full. */
 
-          if ((ch == '\n') && (dev->pd_oflag & (ONLCR | ONLRET)) != 0)
+          if (nrun > 0)
             {
-              char cr = '\r';
-
-              /* Transfer the carriage return.  This will block if the
-               * sink pipe is full.
-               *
-               * REVISIT: Should not block if the oflags include O_NONBLOCK.
-               * How would we ripple the O_NONBLOCK characteristic to the
-               * contained sink pipe?  file_vfcntl()?  Or FIONSPACE?  See the
-               * TODO comment at the top of this file.
-               */
-
-              nwritten = file_write(&dev->pd_sink, &cr, 1);
+              nwritten = file_write(&dev->pd_sink, buffer, nrun);
               if (nwritten < 0)
                 {
                   ntotal = nwritten;
                   break;
                 }
 
-              /* Update the count of bytes transferred */
+              ntotal += nrun;
+              buffer += nrun;
+              len    -= nrun;
 
-              ntotal++;
+              if (len == 0)
+                {
+                  break;
+                }
             }
 
-          /* Transfer the (possibly translated) character..  This will block
-           * if the sink pipe is full
-           *
-           * REVISIT: Should not block if the oflags include O_NONBLOCK.
-           * How would we ripple the O_NONBLOCK characteristic to the
-           * contained sink pipe?  file_vfcntl()?  Or FIONSPACe?  See the
-           * TODO comment at the top of this file.
+          ch = *buffer++;
+          len--;
+
+          /* Mapping CR to NL? */
+
+          if (ch == '\r' && (dev->pd_oflag & OCRNL) != 0)
+            {
+              ch = '\n';
+            }
+
+          /* Are we interested in newline processing?  If so, transfer the
+           * carriage return together with the newline.
+           */
+
+          xlat[0] = ch;
+          nxlat   = 1;
+
+          if ((ch == '\n') && (dev->pd_oflag & (ONLCR | ONLRET)) != 0)
+            {
+              xlat[0] = '\r';
+              xlat[1] = '\n';
+              nxlat   = 2;
+            }
+
+          /* Transfer the (possibly translated) character(s).  This will
+           * block if the sink pipe is full
            */
 
-          nwritten = file_write(&dev->pd_sink, &ch, 1);
+          nwritten = file_write(&dev->pd_sink, xlat, nxlat);
           if (nwritten < 0)
             {
               ntotal = nwritten;
@@ -720,7 +686,7 @@ static ssize_t pty_write(FAR struct file *filep, FAR const char *buffer, size_t
 
           /* Update the count of bytes transferred */
 
-          ntotal++;
+          ntotal += nxlat;
         }
     }
   else
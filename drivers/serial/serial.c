@@ -101,6 +101,13 @@ static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
 /* Write support */
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock);
+static inline unsigned int uart_nbuffered(FAR struct uart_buffer_s *buf);
+static size_t  uart_rawcount(FAR uart_dev_t *dev, FAR const char *buffer,
+                             size_t buflen);
+static size_t  uart_putxmitblock(FAR uart_dev_t *dev, FAR const char *buffer,
+                                 size_t buflen);
+static size_t  uart_getrecvblock(FAR uart_dev_t *dev, FAR char *buffer,
+                                 size_t buflen);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev, FAR const char *buffer,
                                     size_t buflen);
 static int     uart_tcdrain(FAR uart_dev_t *dev, clock_t timeout);
@@ -351,6 +358,181 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
   return OK;
 }
 
+/************************************************************************************
+ * Name: uart_nbuffered
+ *
+ * Description:
+ *   Return the number of bytes in a circular buffer.
+ *
+ ************************************************************************************/
+
+static inline unsigned int uart_nbuffered(FAR struct uart_buffer_s *buf)
+{
+  int16_t head = buf->head;
+  int16_t tail = buf->tail;
+
+  return head >= tail ? head - tail : buf->size - tail + head;
+}
+
+/************************************************************************************
+ * Name: uart_rawcount
+ *
+ * Description:
+ *   Return the number of leading bytes in 'buffer' that need no output
+ *   post-processing and so may be copied directly into the TX buffer.
+ *
+ ************************************************************************************/
+
+static size_t uart_rawcount(FAR uart_dev_t *dev, FAR const char *buffer,
+                            size_t buflen)
+{
+#ifdef CONFIG_SERIAL_TERMIOS
+  bool mapcr;
+  bool mapnl;
+  size_t i;
+
+  if ((dev->tc_oflag & OPOST) == 0)
+    {
+      return buflen;
+    }
+
+  mapcr = (dev->tc_oflag & OCRNL) != 0;
+  mapnl = (dev->tc_oflag & (ONLCR | ONLRET)) != 0;
+
+  if (!mapcr && !mapnl)
+    {
+      return buflen;
+    }
+
+  for (i = 0; i < buflen; i++)
+    {
+      if ((buffer[i] == '\n' && mapnl) || (buffer[i] == '\r' && mapcr))
+        {
+          break;
+        }
+    }
+
+  return i;
+
+#else
+  FAR const char *nl;
+
+  if (!dev->isconsole)
+    {
+      return buflen;
+    }
+
+  nl = memchr(buffer, '\n', buflen);
+  return nl != NULL ? (size_t)(nl - buffer) : buflen;
+#endif
+}
+
+/************************************************************************************
+ * Name: uart_putxmitblock
+ *
+ * Description:
+ *   Copy as much of 'buffer' as will fit into the TX buffer.  This never
+ *   blocks.  Returns the number of bytes copied.
+ *
+ ************************************************************************************/
+
+static size_t uart_putxmitblock(FAR uart_dev_t *dev, FAR const char *buffer,
+                                size_t buflen)
+{
+  FAR struct uart_buffer_s *txbuf = &dev->xmit;
+  size_t nbytes = 0;
+  size_t ncopy;
+  int16_t head = txbuf->head;
+  int16_t tail = txbuf->tail;
+
+  /* The interrupt level logic may advance the tail asynchronously, but that
+   * only frees more space.  One slot is always left empty so that a full
+   * buffer may be distinguished from an empty one.
+   */
+
+  while (nbytes < buflen)
+    {
+      if (head >= tail)
+        {
+          ncopy = txbuf->size - head;
+          if (tail == 0)
+            {
+              ncopy--;
+            }
+        }
+      else
+        {
+          ncopy = tail - head - 1;
+        }
+
+      if (ncopy == 0)
+        {
+          break;
+        }
+
+      if (ncopy > buflen - nbytes)
+        {
+          ncopy = buflen - nbytes;
+        }
+
+      memcpy(&txbuf->buffer[head], &buffer[nbytes], ncopy);
+      nbytes += ncopy;
+      head   += ncopy;
+
+      if (head >= txbuf->size)
+        {
+          head = 0;
+        }
+    }
+
+  txbuf->head = head;
+  return nbytes;
+}
+
+/************************************************************************************
+ * Name: uart_getrecvblock
+ *
+ * Description:
+ *   Copy up to 'buflen' bytes from the RX buffer without any input
+ *   processing.  This never blocks.  Returns the number of bytes copied.
+ *
+ ************************************************************************************/
+
+static size_t uart_getrecvblock(FAR uart_dev_t *dev, FAR char *buffer,
+                                size_t buflen)
+{
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  size_t nbytes = 0;
+  size_t ncopy;
+  int16_t head = rxbuf->head;
+  int16_t tail = rxbuf->tail;
+
+  /* The interrupt level logic may advance the head asynchronously, but that
+   * only adds more data which will be taken on the next call.
+   */
+
+  while (nbytes < buflen && head != tail)
+    {
+      ncopy = (head > tail ? head : rxbuf->size) - tail;
+      if (ncopy > buflen - nbytes)
+        {
+          ncopy = buflen - nbytes;
+        }
+
+      memcpy(&buffer[nbytes], &rxbuf->buffer[tail], ncopy);
+      nbytes += ncopy;
+      tail   += ncopy;
+
+      if (tail >= rxbuf->size)
+        {
+          tail = 0;
+        }
+    }
+
+  rxbuf->tail = tail;
+  return nbytes;
+}
+
 /************************************************************************************
  * Name: uart_putc
  ************************************************************************************/
@@ -727,10 +909,63 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
+  size_t minread;
+  size_t maxwait;
+  size_t nread;
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+  uint32_t timeout;
+  bool timedout = false;
+#endif
+#ifdef CONFIG_SERIAL_TERMIOS
   int16_t tail;
   char ch;
+#endif
   int ret;
 
+  /* How many bytes must be read before we return?  Normally, read()
+   * returns as soon as any data is available.
+   */
+
+#if defined(CONFIG_DEV_SERIAL_FULLBLOCKS)
+  minread = buflen;
+#elif defined(CONFIG_SERIAL_TERMIOS_MINTIME)
+  /* VMIN=0 means that read() returns immediately (VTIME=0) or when the
+   * first byte arrives or VTIME expires (VTIME>0).
+   */
+
+  minread = dev->tc_vmin;
+  if (minread == 0 && dev->tc_vtime > 0)
+    {
+      minread = 1;
+    }
+#else
+  minread = 1;
+#endif
+
+  if (minread > buflen)
+    {
+      minread = buflen;
+    }
+
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+  timeout = MSEC2TICK(100 * (uint32_t)dev->tc_vtime);
+#endif
+
+  /* Never wait for more data than the RX buffer can hold before the RX
+   * interrupt logic stops accepting it.
+   */
+
+#ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+  maxwait = (CONFIG_SERIAL_IFLOWCONTROL_UPPER_WATERMARK * rxbuf->size) / 100;
+#else
+  maxwait = rxbuf->size - 1;
+#endif
+
+  if (maxwait < 1)
+    {
+      maxwait = 1;
+    }
+
   /* Only one user can access rxbuf->tail at a time */
 
   ret = uart_takesem(&rxbuf->sem, true);
@@ -778,12 +1013,27 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
        * 8-bit accesses to obtain the 16-bit head index.
        */
 
-      tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+      if (rxbuf->head != rxbuf->tail)
         {
+#ifdef CONFIG_SERIAL_TERMIOS
+          if ((dev->tc_iflag & (INLCR | IGNCR | ICRNL)) == 0)
+#endif
+            {
+              /* No input processing is needed.  Copy all of the data that
+               * we can directly from the circular buffer.
+               */
+
+              nread   = uart_getrecvblock(dev, buffer, buflen - recvd);
+              buffer += nread;
+              recvd  += nread;
+              continue;
+            }
+
+#ifdef CONFIG_SERIAL_TERMIOS
           /* Take the next character from the tail of the buffer */
 
-          ch = rxbuf->buffer[tail];
+          tail = rxbuf->tail;
+          ch   = rxbuf->buffer[tail];
 
           /* Increment the tail index.  Most operations are done using the
            * local variable 'tail' so that the final rxbuf->tail update
@@ -797,28 +1047,22 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 
           rxbuf->tail = tail;
 
-#ifdef CONFIG_SERIAL_TERMIOS
-          /* Do input processing if any is enabled */
+          /* \n -> \r or \r -> \n translation? */
 
-          if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
+          if ((ch == '\n') && (dev->tc_iflag & INLCR))
             {
-              /* \n -> \r or \r -> \n translation? */
-
-              if ((ch == '\n') && (dev->tc_iflag & INLCR))
-                {
-                  ch = '\r';
-                }
-              else if ((ch == '\r') && (dev->tc_iflag & ICRNL))
-                {
-                  ch = '\n';
-                }
+              ch = '\r';
+            }
+          else if ((ch == '\r') && (dev->tc_iflag & ICRNL))
+            {
+              ch = '\n';
+            }
 
-              /* Discarding \r ? */
+          /* Discarding \r ? */
 
-              if ((ch == '\r') & (dev->tc_iflag & IGNCR))
-                {
-                  continue;
-                }
+          if ((ch == '\r') & (dev->tc_iflag & IGNCR))
+            {
+              continue;
             }
 
           /* Specifically not handled:
@@ -829,39 +1073,23 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
            * IUCLC - Not Posix
            * IXON/OXOFF - no xon/xoff flow control.
            */
-#endif
 
           /* Store the received character */
 
           *buffer++ = ch;
           recvd++;
+#endif
         }
 
-#ifdef CONFIG_DEV_SERIAL_FULLBLOCKS
-      /* No... then we would have to wait to get receive more data.
-       * If the user has specified the O_NONBLOCK option, then just
-       * return what we have.
-       */
-
-      else if ((filep->f_oflags & O_NONBLOCK) != 0)
-        {
-          /* If nothing was transferred, then return the -EAGAIN
-           * error (not zero which means end of file).
-           */
-
-          if (recvd < 1)
-            {
-              recvd = -EAGAIN;
-            }
-
-          break;
-       }
-#else
-      /* No... the circular buffer is empty.  Have we returned anything
+      /* No... the circular buffer is empty.  Have we returned enough
        * to the caller?
        */
 
-      else if (recvd > 0)
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+      else if ((size_t)recvd >= minread || timedout)
+#else
+      else if ((size_t)recvd >= minread)
+#endif
        {
           /* Yes.. break out of the loop and return the number of bytes
            * received up to the wait condition.
@@ -870,19 +1098,25 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
           break;
        }
 
-      /* No... then we would have to wait to get receive some data.
-       * If the user has specified the O_NONBLOCK option, then do not
-       * wait.
+      /* No... then we would have to wait to get receive more data.
+       * If the user has specified the O_NONBLOCK option, then just
+       * return what we have.
        */
 
       else if ((filep->f_oflags & O_NONBLOCK) != 0)
         {
-          /* Break out of the loop returning -EAGAIN */
+          /* If nothing was transferred, then return the -EAGAIN
+           * error (not zero which means end of file).
+           */
+
+          if (recvd < 1)
+            {
+              recvd = -EAGAIN;
+            }
 
-          recvd = -EAGAIN;
           break;
         }
-#endif
+
       /* Otherwise we are going to have to wait for data to arrive */
 
       else
@@ -945,8 +1179,39 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
                    * thread goes to sleep.
                    */
 
+                  /* Do not wake up until all of the data that we need
+                   * has been buffered, unless an inter-byte timer must be
+                   * restarted as each byte arrives.
+                   */
+
+                  dev->minrecv = minread - recvd;
+                  if (dev->minrecv > maxwait)
+                    {
+                      dev->minrecv = maxwait;
+                    }
+
                   dev->recvwaiting = true;
-                  ret = uart_takesem(&dev->recvsem, true);
+
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+                  if (timeout > 0 && (recvd > 0 || dev->tc_vmin == 0))
+                    {
+                      dev->minrecv = 1;
+                      ret = nxsem_tickwait(&dev->recvsem, clock_systimer(),
+                                           timeout);
+                      if (ret == -ETIMEDOUT)
+                        {
+                          /* Return whatever has been received */
+
+                          dev->recvwaiting = false;
+                          timedout = true;
+                          ret = OK;
+                        }
+                    }
+                  else
+#endif
+                    {
+                      ret = uart_takesem(&dev->recvsem, true);
+                    }
                 }
 
               leave_critical_section(flags);
@@ -1065,6 +1330,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct inode *inode    = filep->f_inode;
   FAR uart_dev_t   *dev      = inode->i_private;
   ssize_t           nwritten = buflen;
+  size_t            nbytes;
   bool              oktoblock;
   int               ret;
   char              ch;
@@ -1135,8 +1401,28 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
    */
 
   uart_disabletxint(dev);
-  for (; buflen; buflen--)
+  while (buflen > 0)
     {
+      /* Copy the longest run of bytes that need no post-processing directly
+       * into the TX buffer, as far as there is space for them.
+       */
+
+      nbytes = uart_rawcount(dev, buffer, buflen);
+      if (nbytes > 0)
+        {
+          nbytes = uart_putxmitblock(dev, buffer, nbytes);
+          if (nbytes > 0)
+            {
+              buffer += nbytes;
+              buflen -= nbytes;
+              continue;
+            }
+
+          /* The TX buffer is full.  Fall through and let
+           * uart_putxmitchar() wait for space (or fail).
+           */
+        }
+
       ch  = *buffer++;
       ret = OK;
 
@@ -1220,6 +1506,8 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
 
           break;
         }
+
+      buflen--;
     }
 
   if (dev->xmit.head != dev->xmit.tail)
@@ -1417,6 +1705,10 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               termiosp->c_iflag = dev->tc_iflag;
               termiosp->c_oflag = dev->tc_oflag;
               termiosp->c_lflag = dev->tc_lflag;
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+              termiosp->c_cc[VMIN]  = dev->tc_vmin;
+              termiosp->c_cc[VTIME] = dev->tc_vtime;
+#endif
             }
             break;
 
@@ -1435,6 +1727,10 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               dev->tc_iflag = termiosp->c_iflag;
               dev->tc_oflag = termiosp->c_oflag;
               dev->tc_lflag = termiosp->c_lflag;
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+              dev->tc_vmin  = termiosp->c_cc[VMIN];
+              dev->tc_vtime = termiosp->c_cc[VTIME];
+#endif
 
 #if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGSTP)
               /* If the ISIG flag has been cleared in c_lflag, then un-
@@ -1630,6 +1926,13 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
 
       dev->tc_oflag = OPOST | ONLCR;
     }
+
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+  /* read() returns as soon as any data is available */
+
+  dev->tc_vmin  = 1;
+  dev->tc_vtime = 0;
+#endif
 #endif
 
   /* Initialize semaphores */
@@ -1668,9 +1971,12 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
 
 void uart_datareceived(FAR uart_dev_t *dev)
 {
-  /* Is there a thread waiting for read data?  */
+  /* Is there a thread waiting for read data?  Don't wake it up until
+   * enough data has been buffered to satisfy it.
+   */
 
-  if (dev->recvwaiting)
+  if (dev->recvwaiting &&
+      (dev->minrecv <= 1 || uart_nbuffered(&dev->recv) >= dev->minrecv))
     {
       /* Yes... wake it up */
 
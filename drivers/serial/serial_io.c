@@ -65,6 +65,42 @@ void uart_xmitchars(FAR uart_dev_t *dev)
 {
   uint16_t nbytes = 0;
 
+#ifdef CONFIG_SERIAL_BLOCKOPS
+  /* If the lower half can fill its FIFO in one call, pass it each
+   * contiguous region of the TX buffer until the FIFO stops accepting data.
+   */
+
+  if (dev->ops->sendblock != NULL)
+    {
+      FAR struct uart_buffer_s *txbuf = &dev->xmit;
+      size_t nsent;
+      size_t ncopy;
+      int16_t head;
+
+      while ((head = txbuf->head) != txbuf->tail)
+        {
+          ncopy = (head > txbuf->tail ? head : txbuf->size) - txbuf->tail;
+          nsent = uart_sendblock(dev, &txbuf->buffer[txbuf->tail], ncopy);
+          if (nsent == 0)
+            {
+              break;
+            }
+
+          nbytes += nsent;
+          txbuf->tail += nsent;
+          if (txbuf->tail >= txbuf->size)
+            {
+              txbuf->tail = 0;
+            }
+
+          if (nsent < ncopy)
+            {
+              break;
+            }
+        }
+    }
+#endif
+
   /* Send while we still have data in the TX buffer & room in the fifo */
 
   while (dev->xmit.head != dev->xmit.tail && uart_txready(dev))
@@ -141,6 +177,96 @@ void uart_recvchars(FAR uart_dev_t *dev)
   watermark = (CONFIG_SERIAL_IFLOWCONTROL_UPPER_WATERMARK * rxbuf->size) / 100;
 #endif
 
+#ifdef CONFIG_SERIAL_BLOCKOPS
+  /* If the lower half can empty its FIFO in one call, let it copy directly
+   * into each contiguous free region of the RX buffer.  This is not possible
+   * if received characters must be checked for signal generation.  Any data
+   * that remains (for example, because the RX buffer is full) is handled by
+   * the character-at-a-time loop below.
+   */
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGSTP)
+  if (dev->ops->receiveblock != NULL && dev->pid < 0)
+#else
+  if (dev->ops->receiveblock != NULL)
+#endif
+    {
+      size_t nrecvd;
+      size_t ncopy;
+      int16_t head = rxbuf->head;
+      int16_t tail;
+
+      for (; ; )
+        {
+          /* Leave one slot empty so that a full buffer can be distinguished
+           * from an empty buffer.
+           */
+
+          tail = rxbuf->tail;
+          if (head >= tail)
+            {
+              ncopy = rxbuf->size - head - (tail == 0 ? 1 : 0);
+            }
+          else
+            {
+              ncopy = tail - head - 1;
+            }
+
+#ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+          /* Do not go past the watermark level without telling the lower
+           * half.  The loop below will report the crossing.
+           */
+
+          {
+            unsigned int nbuffered = head >= tail ? head - tail :
+                                     rxbuf->size - tail + head;
+
+            if (nbuffered >= watermark)
+              {
+                break;
+              }
+
+            if (ncopy > watermark - nbuffered)
+              {
+                ncopy = watermark - nbuffered;
+              }
+          }
+#endif
+
+          if (ncopy == 0)
+            {
+              break;
+            }
+
+          nrecvd = uart_receiveblock(dev, &rxbuf->buffer[head], ncopy);
+          if (nrecvd == 0)
+            {
+              break;
+            }
+
+          nbytes += nrecvd;
+          head   += nrecvd;
+          if (head >= rxbuf->size)
+            {
+              head = 0;
+            }
+
+          rxbuf->head = head;
+
+          if (nrecvd < ncopy)
+            {
+              break;
+            }
+        }
+
+      nexthead = head + 1;
+      if (nexthead >= rxbuf->size)
+        {
+          nexthead = 0;
+        }
+    }
+#endif
+
   /* Loop putting characters into the receive buffer until there are no further
    * characters to available.
    */
@@ -63,6 +63,16 @@
  * Pre-processor definitions
  ****************************************************************************/
 
+/* Depth of the TX FIFO.  If the FIFOs are not configured by this driver,
+ * then we cannot assume that they are enabled.
+ */
+
+#ifdef CONFIG_16550_SUPRESS_CONFIG
+#  define UART_TXFIFO_DEPTH 1
+#else
+#  define UART_TXFIFO_DEPTH 16
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -113,6 +123,12 @@ static void u16550_send(FAR struct uart_dev_s *dev, int ch);
 static void u16550_txint(FAR struct uart_dev_s *dev, bool enable);
 static bool u16550_txready(FAR struct uart_dev_s *dev);
 static bool u16550_txempty(FAR struct uart_dev_s *dev);
+#ifdef CONFIG_SERIAL_BLOCKOPS
+static size_t u16550_sendblock(FAR struct uart_dev_s *dev,
+                               FAR const char *buffer, size_t buflen);
+static size_t u16550_receiveblock(FAR struct uart_dev_s *dev,
+                                  FAR char *buffer, size_t buflen);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -141,6 +157,10 @@ static const struct uart_ops_s g_uart_ops =
   .txint          = u16550_txint,
   .txready        = u16550_txready,
   .txempty        = u16550_txempty,
+#ifdef CONFIG_SERIAL_BLOCKOPS
+  .sendblock      = u16550_sendblock,
+  .receiveblock   = u16550_receiveblock,
+#endif
 };
 
 /* I/O buffers */
@@ -1258,6 +1278,69 @@ static bool u16550_txempty(struct uart_dev_s *dev)
   return ((u16550_serialin(priv, UART_LSR_OFFSET) & UART_LSR_TEMT) != 0);
 }
 
+/****************************************************************************
+ * Name: u16550_sendblock
+ *
+ * Description:
+ *   Fill the TX FIFO from the buffer.  THRE only says that the FIFO is
+ *   empty, so a full FIFO's worth may be written once it is set.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_BLOCKOPS
+static size_t u16550_sendblock(FAR struct uart_dev_s *dev,
+                               FAR const char *buffer, size_t buflen)
+{
+  FAR struct u16550_s *priv = (FAR struct u16550_s *)dev->priv;
+  size_t nsent;
+
+  if ((u16550_serialin(priv, UART_LSR_OFFSET) & UART_LSR_THRE) == 0)
+    {
+      return 0;
+    }
+
+  if (buflen > UART_TXFIFO_DEPTH)
+    {
+      buflen = UART_TXFIFO_DEPTH;
+    }
+
+  for (nsent = 0; nsent < buflen; nsent++)
+    {
+      u16550_serialout(priv, UART_THR_OFFSET,
+                       (uart_datawidth_t)(uint8_t)buffer[nsent]);
+    }
+
+  return nsent;
+}
+
+/****************************************************************************
+ * Name: u16550_receiveblock
+ *
+ * Description:
+ *   Empty the RX FIFO into the buffer.
+ *
+ ****************************************************************************/
+
+static size_t u16550_receiveblock(FAR struct uart_dev_s *dev,
+                                  FAR char *buffer, size_t buflen)
+{
+  FAR struct u16550_s *priv = (FAR struct u16550_s *)dev->priv;
+  size_t nrecvd;
+
+  for (nrecvd = 0; nrecvd < buflen; nrecvd++)
+    {
+      if ((u16550_serialin(priv, UART_LSR_OFFSET) & UART_LSR_DR) == 0)
+        {
+          break;
+        }
+
+      buffer[nrecvd] = (char)u16550_serialin(priv, UART_RBR_OFFSET);
+    }
+
+  return nrecvd;
+}
+#endif
+
 /****************************************************************************
  * Name: u16550_putc
  *
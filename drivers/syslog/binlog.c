@@ -0,0 +1,335 @@
+/****************************************************************************
+ * drivers/syslog/binlog.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/syslog/binlog.h>
+
+#ifdef CONFIG_BINLOG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The circular buffer holds BINLOG_NWORDS words.  One word is always left
+ * unused so that a full buffer can be distinguished from an empty one.
+ */
+
+#define BINLOG_NWORDS (CONFIG_BINLOG_BUFSIZE / sizeof(uintptr_t))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct binlog_info_s
+{
+  volatile unsigned int bl_head;       /* Index of the next word to write */
+  volatile unsigned int bl_tail;       /* Index of the next word to read */
+  uintptr_t bl_dropped;                /* Records lost since the last report */
+  uintptr_t bl_buffer[BINLOG_NWORDS];  /* Circular buffer of records */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static ssize_t binlog_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct binlog_info_s g_binlog;
+
+#ifdef CONFIG_SMP
+static volatile spinlock_t g_binlog_lock;
+#endif
+
+static const struct file_operations binlog_fops =
+{
+  0,             /* open */
+  0,             /* close */
+  binlog_read,   /* read */
+  0,             /* write */
+  0,             /* seek */
+  0              /* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+  , 0            /* poll */
+#endif
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , 0            /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: binlog_lock and binlog_unlock
+ ****************************************************************************/
+
+static inline irqstate_t binlog_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock(&g_binlog_lock);
+#endif
+  return flags;
+}
+
+static inline void binlog_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&g_binlog_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: binlog_space
+ *
+ * Description:
+ *   Return the number of free words in the buffer.  Called with the lock
+ *   held.
+ *
+ ****************************************************************************/
+
+static inline unsigned int binlog_space(void)
+{
+  unsigned int head = g_binlog.bl_head;
+  unsigned int tail = g_binlog.bl_tail;
+
+  if (head < tail)
+    {
+      return tail - head - 1;
+    }
+
+  return BINLOG_NWORDS - (head - tail) - 1;
+}
+
+/****************************************************************************
+ * Name: binlog_put
+ *
+ * Description:
+ *   Append one word to the buffer.  The caller has verified that there is
+ *   space.
+ *
+ ****************************************************************************/
+
+static inline void binlog_put(uintptr_t word)
+{
+  unsigned int head = g_binlog.bl_head;
+
+  g_binlog.bl_buffer[head] = word;
+  if (++head >= BINLOG_NWORDS)
+    {
+      head = 0;
+    }
+
+  g_binlog.bl_head = head;
+}
+
+/****************************************************************************
+ * Name: binlog_read
+ ****************************************************************************/
+
+static ssize_t binlog_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  irqstate_t flags;
+  unsigned int tail;
+  unsigned int nwords;
+  unsigned int i;
+  size_t nread = 0;
+
+  DEBUGASSERT(filep != NULL && buffer != NULL);
+
+  /* Transfer as many complete records as will fit into the user buffer.
+   * The lock is taken once per record so that interrupts are not held off
+   * for the whole transfer.
+   */
+
+  for (; ; )
+    {
+      flags = binlog_lock();
+
+      tail = g_binlog.bl_tail;
+      if (tail == g_binlog.bl_head)
+        {
+          binlog_unlock(flags);
+          break;
+        }
+
+      nwords = BINLOG_HDRWORDS + BINLOG_NARGS(g_binlog.bl_buffer[tail]);
+      if (nread + nwords * sizeof(uintptr_t) > buflen)
+        {
+          binlog_unlock(flags);
+          break;
+        }
+
+      for (i = 0; i < nwords; i++)
+        {
+          memcpy(&buffer[nread], &g_binlog.bl_buffer[tail],
+                 sizeof(uintptr_t));
+          nread += sizeof(uintptr_t);
+
+          if (++tail >= BINLOG_NWORDS)
+            {
+              tail = 0;
+            }
+        }
+
+      g_binlog.bl_tail = tail;
+      binlog_unlock(flags);
+    }
+
+  return nread;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: binlog_record
+ *
+ * Description:
+ *   Add one record to the binary log.  This is the back end of binlog()
+ *   and may be called from any context, including interrupt handlers.  If
+ *   the buffer is full, the record is dropped and counted.
+ *
+ * Input Parameters:
+ *   nargs - The number of arguments following the format string
+ *   words - The address of the format string followed by the arguments
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void binlog_record(unsigned int nargs, FAR const uintptr_t *words)
+{
+  irqstate_t flags;
+  uintptr_t systime;
+  unsigned int needed;
+  unsigned int cpu;
+  unsigned int i;
+
+  DEBUGASSERT(nargs <= BINLOG_MAXARGS && words != NULL);
+
+  systime = (uintptr_t)clock_systimer();
+#ifdef CONFIG_SMP
+  cpu     = up_cpu_index();
+#else
+  cpu     = 0;
+#endif
+
+  flags = binlog_lock();
+
+  /* A pending report of lost records is emitted ahead of the next record
+   * that fits, so that the reader sees where the gap is.
+   */
+
+  needed = BINLOG_HDRWORDS + nargs;
+  if (g_binlog.bl_dropped > 0)
+    {
+      needed += BINLOG_HDRWORDS + 1;
+    }
+
+  if (binlog_space() < needed)
+    {
+      g_binlog.bl_dropped++;
+    }
+  else
+    {
+      if (g_binlog.bl_dropped > 0)
+        {
+          binlog_put(BINLOG_HEADER(1, cpu));
+          binlog_put(systime);
+          binlog_put(0);
+          binlog_put(g_binlog.bl_dropped);
+          g_binlog.bl_dropped = 0;
+        }
+
+      binlog_put(BINLOG_HEADER(nargs, cpu));
+      binlog_put(systime);
+
+      for (i = 0; i <= nargs; i++)
+        {
+          binlog_put(words[i]);
+        }
+    }
+
+  binlog_unlock(flags);
+}
+
+/****************************************************************************
+ * Name: binlog_register
+ *
+ * Description:
+ *   Register a character driver at /dev/binlog that can be used by an
+ *   application to read the binary log.  Each read() returns as many
+ *   complete records as will fit in the user buffer.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int binlog_register(void)
+{
+  return register_driver("/dev/binlog", &binlog_fops, 0444, NULL);
+}
+
+#endif /* CONFIG_BINLOG */
@@ -0,0 +1,175 @@
+/****************************************************************************
+ * drivers/syslog/profile_driver.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched_profile.h>
+#include <nuttx/fs/fs.h>
+
+#if defined(CONFIG_SCHED_PROFILE) && defined(CONFIG_DRIVER_PROFILE)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     profile_open(FAR struct file *filep);
+static int     profile_close(FAR struct file *filep);
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations profile_fops =
+{
+  profile_open,  /* open */
+  profile_close, /* close */
+  profile_read,  /* read */
+  0,             /* write */
+  0,             /* seek */
+  0              /* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+  , 0            /* poll */
+#endif
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , 0            /* unlink */
+#endif
+};
+
+/* The number of open references.  Samples are taken while it is non-zero. */
+
+static unsigned int g_profile_nopen;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_open
+ ****************************************************************************/
+
+static int profile_open(FAR struct file *filep)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (g_profile_nopen++ == 0)
+    {
+      sched_profile_enable(true);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_close
+ ****************************************************************************/
+
+static int profile_close(FAR struct file *filep)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  DEBUGASSERT(g_profile_nopen > 0);
+
+  if (--g_profile_nopen == 0)
+    {
+      sched_profile_enable(false);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_read
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  size_t nsamples;
+
+  DEBUGASSERT(filep != 0 && buffer != NULL && buflen > 0);
+
+  /* Only complete samples are returned */
+
+  nsamples = buflen / sizeof(struct profile_sample_s);
+  if (nsamples == 0)
+    {
+      return -EFBIG;
+    }
+
+  nsamples = sched_profile_getbuf((FAR uint8_t *)buffer, nsamples);
+  return nsamples * sizeof(struct profile_sample_s);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_register
+ *
+ * Description:
+ *   Register a character driver at /dev/profile that can be used by an
+ *   application to read the profile samples.  Profiling is enabled while
+ *   the driver is open.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int profile_register(void)
+{
+  return register_driver("/dev/profile", &profile_fops, 0444, NULL);
+}
+
+#endif /* CONFIG_SCHED_PROFILE && CONFIG_DRIVER_PROFILE */
@@ -254,6 +254,51 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
                            bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_add_deferred
+ *
+ * Description:
+ *   Add data to the deferred SYSLOG buffer of this CPU and schedule the
+ *   drain work.  This never waits.  If there is not room for all of the
+ *   data, then it is dropped and counted.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   The number of bytes accepted (always buflen).
+ *
+ * Assumptions:
+ *   May be called from any context once the OS is initialized.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+ssize_t syslog_add_deferred(FAR const char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Send all data in the deferred SYSLOG buffers to the SYSLOG channel,
+ *   preceded by a count of any data that had to be dropped.
+ *
+ * Input Parameters:
+ *   channel - The syslog channel to use in performing the flush operation.
+ *   force   - Use the force() method of the channel vs. the putc() method.
+ *
+ * Returned Value:
+ *   Zero (OK) is always returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_flush_deferred(FAR const struct syslog_channel_s *channel,
+                          bool force);
+#endif
+
 /****************************************************************************
  * Name: syslog_putc
  *
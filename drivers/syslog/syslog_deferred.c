@@ -0,0 +1,310 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/init.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define SYSLOG_NBUFFERS CONFIG_SMP_NCPUS
+#else
+#  define SYSLOG_NBUFFERS 1
+#endif
+
+#define SYSLOG_BUFSIZE CONFIG_SYSLOG_DEFERRED_BUFSIZE
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One single-producer, single-consumer circular buffer per CPU.  Only code
+ * running on the owning CPU, with local interrupts disabled, writes to the
+ * buffer and advances sd_head; only the drain logic advances sd_tail.  So
+ * no lock is ever held across CPUs and a producer never waits.
+ */
+
+struct syslog_deferred_s
+{
+  volatile uint16_t sd_head;     /* Index of the next byte to write */
+  volatile uint16_t sd_tail;     /* Index of the next byte to drain */
+  volatile uint32_t sd_dropped;  /* Total bytes dropped (producer only) */
+  uint32_t sd_reported;          /* Dropped bytes already reported */
+  char sd_buffer[SYSLOG_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_deferred_s g_syslog_deferred[SYSLOG_NBUFFERS];
+
+/* Work used to drain the buffers on the low-priority work queue */
+
+static struct work_s g_syslog_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred_output
+ *
+ * Description:
+ *   Send data to the SYSLOG channel.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_output(FAR const struct syslog_channel_s *channel,
+                                   FAR const char *buffer, size_t buflen,
+                                   bool force)
+{
+  size_t i;
+
+#ifdef CONFIG_SYSLOG_WRITE
+  if (!force && channel->sc_write != NULL)
+    {
+      (void)channel->sc_write(buffer, buflen);
+      return;
+    }
+#endif
+
+  for (i = 0; i < buflen; i++)
+    {
+      if (force)
+        {
+          DEBUGASSERT(channel->sc_force != NULL);
+          (void)channel->sc_force(buffer[i]);
+        }
+      else
+        {
+          DEBUGASSERT(channel->sc_putc != NULL);
+          (void)channel->sc_putc(buffer[i]);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_worker
+ *
+ * Description:
+ *   Drain the deferred SYSLOG buffers from the low-priority work queue.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_worker(FAR void *arg)
+{
+  (void)syslog_flush_deferred(g_syslog_channel, false);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_add_deferred
+ *
+ * Description:
+ *   Add data to the deferred SYSLOG buffer of this CPU and schedule the
+ *   drain work.  This never waits.  If there is not room for all of the
+ *   data, then all of it is dropped and counted so that a partial message
+ *   is never output; the number of dropped bytes is reported the next time
+ *   that the buffer is drained.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   The number of bytes accepted (always buflen).
+ *
+ * Assumptions:
+ *   May be called from any context once the OS is initialized.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_add_deferred(FAR const char *buffer, size_t buflen)
+{
+  FAR struct syslog_deferred_s *sd;
+  irqstate_t flags;
+  unsigned int head;
+  unsigned int nfree;
+  size_t ncopy;
+
+  /* Disable local interrupts only.  This keeps us on this CPU and excludes
+   * all other producers of this CPU's buffer.
+   */
+
+  flags = up_irq_save();
+  sd    = &g_syslog_deferred[up_cpu_index()];
+  head  = sd->sd_head;
+  nfree = (sd->sd_tail + SYSLOG_BUFSIZE - head - 1) % SYSLOG_BUFSIZE;
+
+  if (buflen > nfree)
+    {
+      sd->sd_dropped += buflen;
+    }
+  else
+    {
+      ncopy = SYSLOG_BUFSIZE - head;
+      if (ncopy > buflen)
+        {
+          ncopy = buflen;
+        }
+
+      memcpy(&sd->sd_buffer[head], buffer, ncopy);
+      memcpy(sd->sd_buffer, &buffer[ncopy], buflen - ncopy);
+
+      /* Make sure that the data is visible before the new head index */
+
+      SP_DMB();
+      sd->sd_head = (head + buflen) % SYSLOG_BUFSIZE;
+    }
+
+  up_irq_restore(flags);
+
+  /* Schedule the drain if it is not already pending */
+
+  if (work_available(&g_syslog_work))
+    {
+      (void)work_queue(LPWORK, &g_syslog_work, syslog_deferred_worker,
+                       NULL, 0);
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Send all data in the deferred SYSLOG buffers to the SYSLOG channel,
+ *   preceded by a count of any data that had to be dropped.
+ *
+ * Input Parameters:
+ *   channel - The syslog channel to use in performing the flush operation.
+ *   force   - Use the force() method of the channel vs. the putc() method.
+ *
+ * Returned Value:
+ *   Zero (OK) is always returned.
+ *
+ * Assumptions:
+ *   Called only from the drain work or from crash handling logic, so there
+ *   is only one consumer at a time.
+ *
+ ****************************************************************************/
+
+int syslog_flush_deferred(FAR const struct syslog_channel_s *channel,
+                          bool force)
+{
+  FAR struct syslog_deferred_s *sd;
+  unsigned int head;
+  unsigned int tail;
+  uint32_t dropped;
+  char msg[40];
+  int cpu;
+  int len;
+
+  for (cpu = 0; cpu < SYSLOG_NBUFFERS; cpu++)
+    {
+      sd = &g_syslog_deferred[cpu];
+
+      /* Output each contiguous region of the buffer */
+
+      while ((head = sd->sd_head) != (tail = sd->sd_tail))
+        {
+          SP_DMB();
+
+          if (head < tail)
+            {
+              head = SYSLOG_BUFSIZE;
+            }
+
+          syslog_deferred_output(channel, &sd->sd_buffer[tail],
+                                 head - tail, force);
+
+          /* Release the space only after the data has been consumed */
+
+          SP_DMB();
+          sd->sd_tail = head % SYSLOG_BUFSIZE;
+        }
+
+      /* Report any drops since the last report */
+
+      dropped = sd->sd_dropped;
+      if (dropped != sd->sd_reported)
+        {
+          len = snprintf(msg, sizeof(msg), "[syslog: %lu bytes dropped]\n",
+                         (unsigned long)(dropped - sd->sd_reported));
+          sd->sd_reported = dropped;
+
+          if (len > 0)
+            {
+              syslog_deferred_output(channel, msg, len, force);
+            }
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
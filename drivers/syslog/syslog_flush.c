@@ -81,6 +81,12 @@ int syslog_flush(void)
 {
   DEBUGASSERT(g_syslog_channel != NULL);
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Output any data still waiting in the deferred buffers */
+
+  (void)syslog_flush_deferred(g_syslog_channel, true);
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
   /* Flush any characters that may have been added to the interrupt
    * buffer.
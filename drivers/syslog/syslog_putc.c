@@ -44,6 +44,7 @@
 #include <errno.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/init.h>
 #include <nuttx/sched.h>
 #include <nuttx/syslog/syslog.h>
 
@@ -72,6 +73,18 @@ int syslog_putc(int ch)
 {
   DEBUGASSERT(g_syslog_channel != NULL);
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Once the OS is running, all output is deferred to the work queue */
+
+  if (OSINIT_OS_READY())
+    {
+      char byte = (char)ch;
+
+      (void)syslog_add_deferred(&byte, 1);
+      return ch;
+    }
+#endif
+
   /* Is this an attempt to do SYSLOG output from an interrupt handler? */
 
   if (up_interrupt_context() || sched_idletask())
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <assert.h>
 #include <errno.h>
@@ -188,6 +189,55 @@ static void syslogstream_putc(FAR struct lib_outstream_s *this, int ch)
     }
 }
 
+/****************************************************************************
+ * Name: syslogstream_puts
+ *
+ * Description:
+ *   Copy runs of characters into the IOB.  Carriage returns and linefeeds
+ *   still go through syslogstream_putc for translation.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BUFFER
+static void syslogstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_syslogstream_s *stream =
+    (FAR struct lib_syslogstream_s *)this;
+  FAR struct iob_s *iob = stream->iob;
+
+  while (len > 0)
+    {
+      int ncopy;
+
+      if (iob == NULL || *buf == '\r' || *buf == '\n')
+        {
+          syslogstream_putc(this, *buf++);
+          len--;
+          continue;
+        }
+
+      for (ncopy = 1;
+           ncopy < len && buf[ncopy] != '\r' && buf[ncopy] != '\n' &&
+           iob->io_len + ncopy < CONFIG_IOB_BUFSIZE;
+           ncopy++)
+        {
+        }
+
+      memcpy(&iob->io_data[iob->io_len], buf, ncopy);
+      iob->io_len         += ncopy;
+      stream->public.nput += ncopy;
+      buf                 += ncopy;
+      len                 -= ncopy;
+
+      if (iob->io_len >= CONFIG_IOB_BUFSIZE)
+        {
+          syslogstream_flush(stream);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -219,6 +269,11 @@ void syslogstream_create(FAR struct lib_syslogstream_s *stream)
   /* Initialize the common fields */
 
   stream->public.put   = syslogstream_putc;
+#ifdef CONFIG_SYSLOG_BUFFER
+  stream->public.puts  = syslogstream_puts;
+#else
+  stream->public.puts  = NULL;
+#endif
   stream->public.flush = lib_noflush;
   stream->public.nput  = 0;
 
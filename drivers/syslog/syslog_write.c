@@ -42,6 +42,7 @@
 #include <sys/types.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/init.h>
 #include <nuttx/sched.h>
 #include <nuttx/syslog/syslog.h>
 
@@ -130,6 +131,15 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
 
 ssize_t syslog_write(FAR const char *buffer, size_t buflen)
 {
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Once the OS is running, all output is deferred to the work queue */
+
+  if (OSINIT_OS_READY())
+    {
+      return syslog_add_deferred(buffer, buflen);
+    }
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
   if (!up_interrupt_context() && !sched_idletask())
     {
@@ -321,23 +321,42 @@ static uint16_t cdcacm_fillrequest(FAR struct cdcacm_dev_s *priv,
   FAR struct uart_buffer_s *xmit = &serdev->xmit;
   irqstate_t flags;
   uint16_t nbytes = 0;
+  uint16_t ncopy;
 
   /* Disable interrupts */
 
   flags = enter_critical_section();
 
   /* Transfer bytes while we have bytes available and there is room in the
-   * request.
+   * request.  The buffered data is copied as (at most) two contiguous
+   * blocks:  From the tail to the head or to the end of the buffer, then
+   * from the beginning of the buffer after the wrap-around.
    */
 
   while (xmit->head != xmit->tail && nbytes < reqlen)
     {
-      *reqbuf++ = xmit->buffer[xmit->tail];
-      nbytes++;
+      if (xmit->head > xmit->tail)
+        {
+          ncopy = xmit->head - xmit->tail;
+        }
+      else
+        {
+          ncopy = xmit->size - xmit->tail;
+        }
+
+      if (ncopy > reqlen - nbytes)
+        {
+          ncopy = reqlen - nbytes;
+        }
+
+      memcpy(reqbuf, &xmit->buffer[xmit->tail], ncopy);
+      reqbuf += ncopy;
+      nbytes += ncopy;
 
       /* Increment the tail pointer */
 
-      if (++(xmit->tail) >= xmit->size)
+      xmit->tail += ncopy;
+      if (xmit->tail >= xmit->size)
         {
           xmit->tail = 0;
         }
@@ -374,6 +393,11 @@ static uint16_t cdcacm_fillrequest(FAR struct cdcacm_dev_s *priv,
  *   continues until either (1) there are no further packets available, or
  *   (2) there is no further data to send.
  *
+ *   While other write requests are in flight, less than one maxpacket of
+ *   data is left in the TX buffer.  The next write completion will call
+ *   this function again and by then more data may have been buffered so
+ *   that full packets are sent.
+ *
  ****************************************************************************/
 
 static int cdcacm_sndpacket(FAR struct cdcacm_dev_s *priv)
@@ -381,8 +405,11 @@ static int cdcacm_sndpacket(FAR struct cdcacm_dev_s *priv)
   FAR struct usbdev_ep_s *ep;
   FAR struct usbdev_req_s *req;
   FAR struct cdcacm_wrreq_s *wrcontainer;
+  FAR struct uart_buffer_s *xmit;
   uint16_t reqlen;
   irqstate_t flags;
+  int nbuffered;
+  int holdback;
   int len;
   int ret = OK;
 
@@ -413,8 +440,29 @@ static int cdcacm_sndpacket(FAR struct cdcacm_dev_s *priv)
 
   reqlen = MAX(CONFIG_CDCACM_BULKIN_REQLEN, ep->maxpacket);
 
+  /* Get the amount of data that is held back while other requests are in
+   * flight:  One maxpacket, but no more than half of the TX buffer so that
+   * writers are not blocked waiting for the buffer to fill.
+   */
+
+  xmit     = &priv->serdev.xmit;
+  holdback = MIN(ep->maxpacket, xmit->size / 2);
+
   while (!sq_empty(&priv->txfree))
     {
+      /* Hold back a partial packet if another request is still in flight */
+
+      nbuffered = xmit->head - xmit->tail;
+      if (nbuffered < 0)
+        {
+          nbuffered += xmit->size;
+        }
+
+      if (priv->nwrq < CONFIG_CDCACM_NWRREQS && nbuffered < holdback)
+        {
+          break;
+        }
+
       /* Peek at the request in the container at the head of the list */
 
       wrcontainer = (FAR struct cdcacm_wrreq_s *)sq_peek(&priv->txfree);
@@ -430,11 +478,16 @@ static int cdcacm_sndpacket(FAR struct cdcacm_dev_s *priv)
           (void)sq_remfirst(&priv->txfree);
           priv->nwrq--;
 
-          /* Then submit the request to the endpoint */
+          /* Then submit the request to the endpoint.  A NULL packet is
+           * needed to terminate a transfer of a multiple of the maxpacket
+           * size only if no more data follows; otherwise the next request
+           * continues the transfer.
+           */
 
           req->len     = len;
           req->priv    = wrcontainer;
-          req->flags   = USBDEV_REQFLAGS_NULLPKT;
+          req->flags   = xmit->head == xmit->tail ?
+                         USBDEV_REQFLAGS_NULLPKT : 0;
           ret          = EP_SUBMIT(ep, req);
           if (ret != OK)
             {
@@ -476,8 +529,9 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   unsigned int watermark;
 #endif
+  unsigned int nbuffered;
+  unsigned int ncopy;
   uint16_t reqlen;
-  uint16_t nexthead;
   uint16_t nbytes = 0;
 
   DEBUGASSERT(priv != NULL && rdcontainer != NULL);
@@ -500,17 +554,6 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
   serdev = &priv->serdev;
   recv   = &serdev->recv;
 
-  /* Pre-calculate the head index and check for wrap around.  We need to do
-   * this so that we can determine if the circular buffer will overrun
-   * BEFORE we overrun the buffer!
-   */
-
-  nexthead = recv->head + 1;
-  if (nexthead >= recv->size)
-    {
-      nexthead = 0;
-    }
-
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   /* Pre-calcuate the watermark level that we will need to test against.
    * Note that the range of the the upper watermark is from 1 to 99 percent
@@ -534,12 +577,8 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
    * proper way to throttle a serial device.
    */
 
-  while (nexthead != recv->tail && nbytes < reqlen)
+  while (nbytes < reqlen)
     {
-#if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
-    defined(CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS)
-      unsigned int nbuffered;
-
       /* How many bytes are buffered */
 
       if (recv->head >= recv->tail)
@@ -551,6 +590,37 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
           nbuffered = recv->size - recv->tail + recv->head;
         }
 
+      /* Stop if the RX buffer is full */
+
+      if (nbuffered >= recv->size - 1)
+        {
+          break;
+        }
+
+      /* Copy as much as fits in one contiguous block:  Up to the end of the
+       * buffer, but leaving one byte free ahead of the tail.
+       */
+
+      if (recv->head >= recv->tail)
+        {
+          ncopy = recv->size - recv->head;
+          if (recv->tail == 0)
+            {
+              ncopy--;
+            }
+        }
+      else
+        {
+          ncopy = recv->tail - recv->head - 1;
+        }
+
+      if (ncopy > reqlen - nbytes)
+        {
+          ncopy = reqlen - nbytes;
+        }
+
+#if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
+    defined(CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS)
       /* Is the level now above the watermark level that we need to report? */
 
       if (nbuffered >= watermark)
@@ -566,19 +636,26 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
               break;
             }
         }
+      else if (ncopy > watermark - nbuffered)
+        {
+          /* Stop the block at the watermark so that it is reported */
+
+          ncopy = watermark - nbuffered;
+        }
 #endif
 
-      /* Copy one byte to the head of the circular RX buffer */
+      /* Copy the block to the head of the circular RX buffer */
 
-      recv->buffer[recv->head] = *reqbuf++;
-      nbytes++;
+      memcpy(&recv->buffer[recv->head], reqbuf, ncopy);
+      reqbuf += ncopy;
+      nbytes += ncopy;
 
       /* Increment the head index and check for wrap around */
 
-      recv->head = nexthead;
-      if (++nexthead >= recv->size)
+      recv->head += ncopy;
+      if (recv->head >= recv->size)
         {
-          nexthead = 0;
+          recv->head = 0;
         }
     }
 
@@ -589,7 +666,7 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
    * control when there are no watermarks.
    */
 
- if (nexthead == recv->tail)
+ if ((recv->head + 1 == recv->size ? 0 : recv->head + 1) == recv->tail)
    {
      (void)cdcuart_rxflowcontrol(&priv->serdev, recv->size - 1, true);
    }
@@ -642,7 +719,7 @@ static int cdcacm_requeue_rdrequest(FAR struct cdcacm_dev_s *priv,
   /* Requeue the read request */
 
   ep       = priv->epbulkout;
-  req->len = ep->maxpacket;
+  req->len = MAX(CONFIG_CDCACM_BULKOUT_REQLEN, ep->maxpacket);
   ret      = EP_SUBMIT(ep, req);
   if (ret != OK)
     {
@@ -1389,7 +1466,10 @@ static int cdcacm_bind(FAR struct usbdevclass_driver_s *driver,
 
   priv->epbulkout->priv = priv;
 
-  /* Pre-allocate read requests.  The buffer size is one full packet. */
+  /* Pre-allocate read requests.  The buffer size is at least one full
+   * packet and larger if the controller should chain packets into one
+   * request.
+   */
 
 #ifdef CONFIG_USBDEV_DUALSPEED
   reqlen = CONFIG_CDCACM_EPBULKOUT_HSSIZE;
@@ -1397,6 +1477,11 @@ static int cdcacm_bind(FAR struct usbdevclass_driver_s *driver,
   reqlen = CONFIG_CDCACM_EPBULKOUT_FSSIZE;
 #endif
 
+  if (CONFIG_CDCACM_BULKOUT_REQLEN > reqlen)
+    {
+      reqlen = CONFIG_CDCACM_BULKOUT_REQLEN;
+    }
+
   for (i = 0; i < CONFIG_CDCACM_NRDREQS; i++)
     {
       rdcontainer      = &priv->rdreqs[i];
@@ -111,6 +111,12 @@
 #  define CONFIG_CDCECM_NINTERFACES 1
 #endif
 
+/* CONFIG_CDCECM_NWRREQS determines the number of bulk IN write requests */
+
+#ifndef CONFIG_CDCECM_NWRREQS
+#  define CONFIG_CDCECM_NWRREQS 4
+#endif
+
 /* TX poll delay = 1 seconds. CLK_TCK is the number of clock ticks per second */
 
 #define CDCECM_WDDELAY   (1*CLK_TCK)
@@ -127,6 +133,14 @@
  * Private Types
  ****************************************************************************/
 
+/* Container to support a list of write requests */
+
+struct cdcecm_req_s
+{
+  FAR struct cdcecm_req_s     *flink;       /* Implements a singly linked list */
+  FAR struct usbdev_req_s     *req;         /* The contained request */
+};
+
 /* The cdcecm_driver_s encapsulates all state information for a single hardware
  * interface
  */
@@ -148,8 +162,10 @@ struct cdcecm_driver_s
   struct usbdev_req_s         *rdreq;       /* Single read request */
   bool                         rxpending;   /* Packet available in rdreq */
 
-  struct usbdev_req_s         *wrreq;       /* Single write request */
-  sem_t                        wrreq_idle;  /* Is the wrreq available? */
+  struct cdcecm_req_s          wrreqs[CONFIG_CDCECM_NWRREQS];
+  struct sq_queue_s            wrreqlist;   /* List of free write requests */
+  sem_t                        wrreq_idle;  /* Number of free write requests */
+  FAR struct cdcecm_req_s     *netreq;      /* Write request holding d_buf */
   bool                         txdone;      /* Did a write request complete? */
 
   /* Network device */
@@ -303,6 +319,122 @@ static const struct usb_devdesc_s g_devdesc =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cdcecm_allocwrreq
+ *
+ * Description:
+ *   Take a write request from the list of free requests.
+ *
+ * Input Parameters:
+ *   self - Reference to the driver state structure
+ *   wait - True: wait until a request becomes available
+ *
+ * Returned Value:
+ *   The write request or NULL if none is available and wait is false
+ *
+ ****************************************************************************/
+
+static FAR struct cdcecm_req_s *
+cdcecm_allocwrreq(FAR struct cdcecm_driver_s *self, bool wait)
+{
+  FAR struct cdcecm_req_s *wrreq;
+  irqstate_t flags;
+
+  if (wait)
+    {
+      while (nxsem_wait(&self->wrreq_idle) != OK)
+        {
+        }
+    }
+  else if (nxsem_trywait(&self->wrreq_idle) != OK)
+    {
+      return NULL;
+    }
+
+  flags = enter_critical_section();
+  wrreq = (FAR struct cdcecm_req_s *)sq_remfirst(&self->wrreqlist);
+  leave_critical_section(flags);
+
+  DEBUGASSERT(wrreq != NULL);
+  return wrreq;
+}
+
+/****************************************************************************
+ * Name: cdcecm_freewrreq
+ *
+ * Description:
+ *   Return a write request to the list of free requests.  May be called
+ *   from the write completion interrupt.
+ *
+ ****************************************************************************/
+
+static void cdcecm_freewrreq(FAR struct cdcecm_driver_s *self,
+                             FAR struct cdcecm_req_s *wrreq)
+{
+  irqstate_t flags;
+  int rc;
+
+  flags = enter_critical_section();
+  sq_addlast((FAR sq_entry_t *)wrreq, &self->wrreqlist);
+  leave_critical_section(flags);
+
+  rc = nxsem_post(&self->wrreq_idle);
+  if (rc != OK)
+    {
+      nerr("nxsem_post failed! rc: %d\n", rc);
+    }
+}
+
+/****************************************************************************
+ * Name: cdcecm_allocnetreq
+ *
+ * Description:
+ *   Make the buffer of a free write request the network packet buffer so
+ *   that outgoing packets are built in place.  If no request is free, the
+ *   driver packet buffer is used and cdcecm_transmit() will copy.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void cdcecm_allocnetreq(FAR struct cdcecm_driver_s *self)
+{
+  DEBUGASSERT(self->netreq == NULL);
+
+  self->netreq = cdcecm_allocwrreq(self, false);
+  if (self->netreq != NULL)
+    {
+      self->dev.d_buf = self->netreq->req->buf;
+    }
+  else
+    {
+      self->dev.d_buf = self->pktbuf;
+    }
+}
+
+/****************************************************************************
+ * Name: cdcecm_freenetreq
+ *
+ * Description:
+ *   Release the write request held by the network at the end of a poll.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void cdcecm_freenetreq(FAR struct cdcecm_driver_s *self)
+{
+  if (self->netreq != NULL)
+    {
+      cdcecm_freewrreq(self, self->netreq);
+      self->netreq = NULL;
+    }
+
+  self->dev.d_buf = self->pktbuf;
+}
+
 /****************************************************************************
  * Name: cdcecm_transmit
  *
@@ -323,24 +455,48 @@ static const struct usb_devdesc_s g_devdesc =
 
 static int cdcecm_transmit(FAR struct cdcecm_driver_s *self)
 {
-  /* Wait until the USB device request for Ethernet frame transmissions becomes
-   * available.
-   */
+  FAR struct cdcecm_req_s *wrreq;
+
+  /* Increment statistics */
+
+  NETDEV_TXPACKETS(self->dev);
 
-  while (nxsem_wait(&self->wrreq_idle) != OK)
+  if (self->netreq != NULL && self->dev.d_buf == self->netreq->req->buf)
     {
+      /* The packet was built in the write request buffer */
+
+      wrreq        = self->netreq;
+      self->netreq = NULL;
     }
+  else
+    {
+      /* Wait until a USB device request for Ethernet frame transmissions
+       * becomes available.
+       */
 
-  /* Increment statistics */
+      wrreq = cdcecm_allocwrreq(self, true);
 
-  NETDEV_TXPACKETS(self->dev);
+#ifndef CONFIG_USBDEV_DMA
+      if (self->dev.d_buf == self->rdreq->buf)
+        {
+          /* A reply built in the read request buffer.  Exchange the
+           * buffers instead of copying the packet.
+           */
 
-  /* Send the packet: address=priv->dev.d_buf, length=priv->dev.d_len */
+          self->rdreq->buf = wrreq->req->buf;
+          wrreq->req->buf  = self->dev.d_buf;
+        }
+      else
+#endif
+        {
+          memcpy(wrreq->req->buf, self->dev.d_buf, self->dev.d_len);
+        }
+    }
 
-  memcpy(self->wrreq->buf, self->dev.d_buf, self->dev.d_len);
-  self->wrreq->len = self->dev.d_len;
+  /* Send the packet: address=priv->dev.d_buf, length=priv->dev.d_len */
 
-  return EP_SUBMIT(self->epbulkin, self->wrreq);
+  wrreq->req->len = self->dev.d_len;
+  return EP_SUBMIT(self->epbulkin, wrreq->req);
 }
 
 /****************************************************************************
@@ -409,7 +565,8 @@ static int cdcecm_txpoll(FAR struct net_driver_s *dev)
            * not, return a non-zero value to terminate the poll.
            */
 
-          return 1;
+          cdcecm_allocnetreq(priv);
+          return priv->netreq == NULL ? 1 : 0;
         }
     }
 
@@ -502,11 +659,11 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
    * configuration.
    */
 
-  /* Copy the data data from the hardware to self->dev.d_buf.  Set
-   * amount of data in self->dev.d_len
+  /* The received frame is processed in place in the read request buffer.
+   * Set amount of data in self->dev.d_len
    */
 
-  memcpy(self->dev.d_buf, self->rdreq->buf, self->rdreq->xfrd);
+  self->dev.d_buf = self->rdreq->buf;
   self->dev.d_len = self->rdreq->xfrd;
 
 #ifdef CONFIG_NET_PKT
@@ -574,6 +731,8 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
     {
       NETDEV_RXDROPPED(&self->dev);
     }
+
+  self->dev.d_buf = self->pktbuf;
 }
 
 /****************************************************************************
@@ -601,7 +760,9 @@ static void cdcecm_txdone(FAR struct cdcecm_driver_s *priv)
 
   /* In any event, poll the network for new TX data */
 
+  cdcecm_allocnetreq(priv);
   (void)devif_poll(&priv->dev, cdcecm_txpoll);
+  cdcecm_freenetreq(priv);
 }
 
 /****************************************************************************
@@ -699,7 +860,9 @@ static void cdcecm_poll_work(FAR void *arg)
    * become available.
    */
 
+  cdcecm_allocnetreq(self);
   (void)devif_timer(&self->dev, cdcecm_txpoll);
+  cdcecm_freenetreq(self);
 
   /* Setup the watchdog poll timer again */
 
@@ -867,7 +1030,9 @@ static void cdcecm_txavail_work(FAR void *arg)
 
   if (self->bifup)
     {
+      cdcecm_allocnetreq(self);
       (void)devif_poll(&self->dev, cdcecm_txpoll);
+      cdcecm_freenetreq(self);
     }
 
   net_unlock();
@@ -1156,20 +1321,15 @@ static void cdcecm_wrcomplete(FAR struct usbdev_ep_s *ep,
                               FAR struct usbdev_req_s *req)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)ep->priv;
-  int rc;
 
   uinfo("buf: %p, flags 0x%hhx, len %hu, xfrd %hu, result %hd\n",
         req->buf, req->flags, req->len, req->xfrd, req->result);
 
-  /* The single USB device write request is available for upcoming
-   * transmissions again. */
-
-  rc = nxsem_post(&self->wrreq_idle);
+  /* The USB device write request is available for upcoming transmissions
+   * again.
+   */
 
-  if (rc != OK)
-    {
-      nerr("nxsem_post failed! rc: %d\n", rc);
-    }
+  cdcecm_freewrreq(self, (FAR struct cdcecm_req_s *)req->priv);
 
   /* Inform the network layer that an Ethernet frame was transmitted. */
 
@@ -1800,6 +1960,7 @@ static int cdcecm_bind(FAR struct usbdevclass_driver_s *driver,
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)driver;
   int ret = OK;
+  int i;
 
   uinfo("\n");
 
@@ -1848,22 +2009,32 @@ static int cdcecm_bind(FAR struct usbdevclass_driver_s *driver,
 
   self->rdreq->callback = cdcecm_rdcomplete;
 
-  /* Pre-allocate a single write request.  Buffer size is one full packet. */
+  /* Pre-allocate write requests.  Buffer size is one full packet, the same
+   * as the read request so that buffers can be exchanged.
+   */
+
+  sq_init(&self->wrreqlist);
 
-  self->wrreq = cdcecm_allocreq(self->epbulkin,
-                                CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
-  if (self->wrreq == NULL)
+  for (i = 0; i < CONFIG_CDCECM_NWRREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
-    }
+      self->wrreqs[i].req =
+        cdcecm_allocreq(self->epbulkin,
+                        CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
+      if (self->wrreqs[i].req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
 
-  self->wrreq->callback = cdcecm_wrcomplete;
+      self->wrreqs[i].req->priv     = &self->wrreqs[i];
+      self->wrreqs[i].req->callback = cdcecm_wrcomplete;
+      sq_addlast((FAR sq_entry_t *)&self->wrreqs[i], &self->wrreqlist);
+    }
 
-  /* The single write request just allocated is available now. */
+  /* The write requests just allocated are available now. */
 
-  ret = nxsem_init(&self->wrreq_idle, 0, 1);
+  ret = nxsem_init(&self->wrreq_idle, 0, CONFIG_CDCECM_NWRREQS);
 
   if (ret != OK)
     {
@@ -1897,6 +2068,7 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
                           FAR struct usbdev_s *dev)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)driver;
+  int i;
 
 #ifdef CONFIG_DEBUG_FEATURES
   if (!driver || !dev)
@@ -1954,10 +2126,13 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
    * of them)
    */
 
-  if (self->wrreq != NULL)
+  for (i = 0; i < CONFIG_CDCECM_NWRREQS; i++)
     {
-      cdcecm_freereq(self->epbulkin, self->wrreq);
-      self->wrreq = NULL;
+      if (self->wrreqs[i].req != NULL)
+        {
+          cdcecm_freereq(self->epbulkin, self->wrreqs[i].req);
+          self->wrreqs[i].req = NULL;
+        }
     }
 
   /* Free the bulk IN endpoint */
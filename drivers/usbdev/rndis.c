@@ -69,12 +69,27 @@
 
 #define CONFIG_RNDIS_EP0MAXPACKET 64
 
-#define CONFIG_RNDIS_NWRREQS    (2)
+#ifndef CONFIG_RNDIS_NWRREQS
+#  define CONFIG_RNDIS_NWRREQS  (2)
+#endif
+
+#ifndef CONFIG_RNDIS_TXPACKETS
+#  define CONFIG_RNDIS_TXPACKETS (1)
+#endif
+
+/* Each RNDIS packet message is padded to a 32-bit boundary so that the
+ * next message of an aggregated bulk IN transfer starts aligned.  All
+ * request buffers have the same size, a multiple of the high-speed bulk
+ * packet size, so that a whole OUT message completes in one transfer and
+ * buffers may be exchanged between the bulk OUT and IN requests.
+ */
 
 #define RNDIS_PACKET_HDR_SIZE   (sizeof(struct rndis_packet_msg))
-#define CONFIG_RNDIS_BULKIN_REQLEN \
-  (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE + RNDIS_PACKET_HDR_SIZE)
-#define CONFIG_RNDIS_BULKOUT_REQLEN CONFIG_RNDIS_BULKIN_REQLEN
+#define RNDIS_PACKET_MSG_SIZE \
+  ((RNDIS_PACKET_HDR_SIZE + CONFIG_NET_ETH_PKTSIZE + \
+    CONFIG_NET_GUARDSIZE + 3) & ~3)
+#define RNDIS_REQLEN \
+  ((CONFIG_RNDIS_TXPACKETS * RNDIS_PACKET_MSG_SIZE + 511) & ~511)
 
 #define RNDIS_NCONFIGS          (1)
 #define RNDIS_CONFIGID          (1)
@@ -154,6 +169,8 @@ struct rndis_dev_s
   bool registered;                       /* Has netdev_register() been called */
 
   uint8_t config;                        /* USB Configuration number */
+  uint8_t net_npackets;                  /* Number of messages queued in net_req */
+  uint16_t net_offset;                   /* Offset of the next message in net_req */
   FAR struct rndis_req_s *net_req;       /* Pointer to request whose buffer is assigned to network */
   FAR struct rndis_req_s *rx_req;        /* Pointer request container that holds RX buffer */
   size_t current_rx_received;            /* Number of bytes of current RX datagram received over USB */
@@ -167,6 +184,7 @@ struct rndis_dev_s
   uint32_t rndis_packet_filter;          /* RNDIS packet filter value */
   uint32_t rndis_host_tx_count;          /* TX packet counter */
   uint32_t rndis_host_rx_count;          /* RX packet counter */
+  uint32_t host_xfrsize;                 /* Host MaxTransferSize for bulk IN */
   uint8_t host_mac_address[6];           /* Host side MAC address */
 };
 
@@ -478,7 +496,7 @@ static int rndis_submit_rdreq(FAR struct rndis_dev_s *priv)
 
   if (!priv->rdreq_submitted && !priv->rx_blocked)
     {
-      priv->rdreq->len = priv->epbulkout->maxpacket;
+      priv->rdreq->len = RNDIS_REQLEN;
       ret = EP_SUBMIT(priv->epbulkout, priv->rdreq);
       if (ret != OK)
         {
@@ -688,6 +706,8 @@ static void rndis_sendnetreq(FAR struct rndis_dev_s *priv)
   EP_SUBMIT(priv->epbulkin, priv->net_req->req);
 
   priv->net_req            = NULL;
+  priv->net_offset         = 0;
+  priv->net_npackets       = 0;
   priv->netdev.d_buf       = NULL;
   priv->netdev.d_len       = 0;
   leave_critical_section(flags);
@@ -713,11 +733,44 @@ static void rndis_freenetreq(FAR struct rndis_dev_s *priv)
 
   rndis_freewrreq(priv, priv->net_req);
   priv->net_req      = NULL;
+  priv->net_offset   = 0;
+  priv->net_npackets = 0;
   priv->netdev.d_buf = NULL;
   priv->netdev.d_len = 0;
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Name: rndis_flushnetreq
+ *
+ * Description:
+ *   Releases the request buffer held by the network at the end of a poll
+ *   cycle.  The request is submitted if packet messages were collected into
+ *   it; otherwise it is returned to the free list.
+ *
+ * Input Parameters:
+ *   priv: pointer to RNDIS device driver structure
+ *
+ * Assumptions:
+ *   Caller holds the network lock
+ *
+ ****************************************************************************/
+
+static void rndis_flushnetreq(FAR struct rndis_dev_s *priv)
+{
+  if (priv->net_req != NULL)
+    {
+      if (priv->net_npackets > 0)
+        {
+          rndis_sendnetreq(priv);
+        }
+      else
+        {
+          rndis_freenetreq(priv);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: rndis_allocrxreq
  *
@@ -775,7 +828,8 @@ static void rndis_giverxreq(FAR struct rndis_dev_s *priv)
  * Name: rndis_fillrequest
  *
  * Description:
- *   Fills the RNDIS header to the request buffer
+ *   Fills the RNDIS header of the packet in the network buffer and appends
+ *   the message to the messages already collected in the request buffer.
  *
  * Input Parameters:
  *   priv: pointer to RNDIS device driver structure
@@ -793,25 +847,41 @@ static uint16_t rndis_fillrequest(FAR struct rndis_dev_s *priv,
                                   FAR struct usbdev_req_s *req)
 {
   size_t datalen;
+  size_t msglen;
 
-  req->len = 0;
+  req->len = priv->net_offset;
 
   datalen = min(priv->netdev.d_len,
-                CONFIG_RNDIS_BULKIN_REQLEN - RNDIS_PACKET_HDR_SIZE);
+                RNDIS_PACKET_MSG_SIZE - RNDIS_PACKET_HDR_SIZE);
   if (datalen > 0)
     {
       /* Send the required headers */
 
-      FAR struct rndis_packet_msg *msg = (FAR struct rndis_packet_msg *)req->buf;
+      FAR struct rndis_packet_msg *msg =
+        (FAR struct rndis_packet_msg *)&req->buf[priv->net_offset];
       memset(msg, 0, RNDIS_PACKET_HDR_SIZE);
 
+      /* The message length includes the padding up to the next message */
+
+      msglen = RNDIS_PACKET_HDR_SIZE + datalen;
+      if (CONFIG_RNDIS_TXPACKETS > 1)
+        {
+          while ((msglen & 3) != 0)
+            {
+              req->buf[priv->net_offset + msglen++] = 0;
+            }
+        }
+
       msg->msgtype    = RNDIS_PACKET_MSG;
-      msg->msglen     = RNDIS_PACKET_HDR_SIZE + datalen;
+      msg->msglen     = msglen;
       msg->dataoffset = RNDIS_PACKET_HDR_SIZE - 8;
       msg->datalen    = datalen;
 
+      priv->net_offset += msglen;
+      priv->net_npackets++;
+
       req->flags      = USBDEV_REQFLAGS_NULLPKT;
-      req->len        = datalen + RNDIS_PACKET_HDR_SIZE;
+      req->len        = priv->net_offset;
     }
 
   return req->len;
@@ -937,11 +1007,7 @@ static void rndis_rxdispatch(FAR void *arg)
 
   priv->current_rx_datagram_size = 0;
   rndis_unblock_rx(priv);
-
-  if (priv->net_req != NULL)
-    {
-      rndis_freenetreq(priv);
-    }
+  rndis_flushnetreq(priv);
 
   net_unlock();
 }
@@ -1028,6 +1094,20 @@ static int rndis_transmit(FAR struct rndis_dev_s *priv)
   /* Queue the packet */
 
   rndis_fillrequest(priv, priv->net_req->req);
+
+  /* Keep collecting packets into the same request while another full
+   * message fits both the request and the host's maximum transfer size.
+   */
+
+  if (priv->net_npackets < CONFIG_RNDIS_TXPACKETS &&
+      priv->net_offset + RNDIS_PACKET_MSG_SIZE <= priv->host_xfrsize)
+    {
+      priv->netdev.d_buf =
+        &priv->net_req->req->buf[priv->net_offset + RNDIS_PACKET_HDR_SIZE];
+      priv->netdev.d_len = CONFIG_NET_ETH_PKTSIZE;
+      return OK;
+    }
+
   rndis_sendnetreq(priv);
 
   if (!rndis_allocnetreq(priv))
@@ -1057,11 +1137,7 @@ static void rndis_pollworker(FAR void *arg)
   if (rndis_allocnetreq(priv))
     {
       devif_timer(&priv->netdev, rndis_txpoll);
-
-      if (priv->net_req != NULL)
-        {
-          rndis_freenetreq(priv);
-        }
+      rndis_flushnetreq(priv);
     }
 
   net_unlock();
@@ -1144,10 +1220,7 @@ static void rndis_txavail_work(FAR void *arg)
   if (rndis_allocnetreq(priv))
     {
       devif_poll(&priv->netdev, rndis_txpoll);
-      if (priv->net_req != NULL)
-        {
-          rndis_freenetreq(priv);
-        }
+      rndis_flushnetreq(priv);
     }
 
   net_unlock();
@@ -1231,11 +1304,29 @@ static inline int rndis_recvpacket(FAR struct rndis_dev_s *priv,
                */
 
               priv->current_rx_datagram_offset = msg->dataoffset + 8;
+
+#ifndef CONFIG_USBDEV_DMA
+              /* If the whole message arrived in this transfer with the
+               * payload where the network expects it, exchange the request
+               * buffers instead of copying the payload.
+               */
+
+              if (reqlen >= priv->current_rx_msglen &&
+                  priv->current_rx_datagram_offset == RNDIS_PACKET_HDR_SIZE)
+                {
+                  priv->rdreq->buf       = priv->rx_req->req->buf;
+                  priv->rx_req->req->buf = reqbuf;
+                }
+              else
+#endif
               if (priv->current_rx_datagram_offset < reqlen)
                 {
+                  size_t copysize = min(reqlen - priv->current_rx_datagram_offset,
+                                        RNDIS_REQLEN - RNDIS_PACKET_HDR_SIZE);
+
                   memcpy(&priv->rx_req->req->buf[RNDIS_PACKET_HDR_SIZE],
                          &reqbuf[priv->current_rx_datagram_offset],
-                         reqlen - priv->current_rx_datagram_offset);
+                         copysize);
                 }
             }
           else
@@ -1392,6 +1483,9 @@ static int rndis_handle_control_message(FAR struct rndis_dev_s *priv,
           resp->minor      = RNDIS_MINOR_VERSION;
           resp->devflags   = RNDIS_DEVICEFLAGS;
           resp->medium     = RNDIS_MEDIUM_802_3;
+          priv->host_xfrsize =
+            ((FAR struct rndis_initialize_msg *)dataout)->xfrsize;
+
           resp->pktperxfer = 1;
           resp->xfrsize    = (4 + 44 + 22) + RNDIS_BUFFER_SIZE;
           resp->pktalign   = 2;
@@ -1979,14 +2073,11 @@ static int usbclass_bind(FAR struct usbdevclass_driver_s *driver,
 
   priv->epbulkout->priv = priv;
 
-  /* Pre-allocate read requests.  The buffer size is one full packet. */
-
-  reqlen = 64;
+  /* Pre-allocate read requests.  The buffer holds one full message so
+   * that it can be received in a single transfer.
+   */
 
-  if (CONFIG_RNDIS_BULKOUT_REQLEN > reqlen)
-    {
-      reqlen = CONFIG_RNDIS_BULKOUT_REQLEN;
-    }
+  reqlen = RNDIS_REQLEN;
 
   priv->rdreq = usbclass_allocreq(priv->epbulkout, reqlen);
   if (priv->rdreq == NULL)
@@ -2002,16 +2093,11 @@ static int usbclass_bind(FAR struct usbdevclass_driver_s *driver,
    * The buffer size should be larger than a full packet.  Otherwise,
    * we will send a bogus null packet at the end of each packet.
    *
-   * Pick the larger of the max packet size and the configured request
-   * size.
+   * The buffers have the same size as the read request buffer so that
+   * received packets can be exchanged without copying.
    */
 
-  reqlen = 64;
-
-  if (CONFIG_RNDIS_BULKIN_REQLEN > reqlen)
-    {
-      reqlen = CONFIG_RNDIS_BULKIN_REQLEN;
-    }
+  reqlen = RNDIS_REQLEN;
 
   for (i = 0; i < CONFIG_RNDIS_NWRREQS; i++)
     {
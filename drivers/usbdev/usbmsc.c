@@ -1458,6 +1458,7 @@ int usbmsc_bindlun(FAR void *handle, FAR const char *drvrpath,
   FAR struct usbmsc_lun_s *lun;
   FAR struct inode *inode;
   struct geometry geo;
+  uint32_t iosize;
   int ret;
 
 #ifdef CONFIG_DEBUG_FEATURES
@@ -1533,28 +1534,29 @@ int usbmsc_bindlun(FAR void *handle, FAR const char *drvrpath,
 
   memset(lun, 0, sizeof(struct usbmsc_lun_s));
 
-  /* Allocate an I/O buffer big enough to hold one hardware sector.  SCSI
-   * commands are processed one at a time so all LUNs may share a single I/O
-   * buffer.  The I/O buffer will be allocated so that is it as large as the
-   * largest block device sector size
+  /* Allocate an I/O buffer big enough to hold CONFIG_USBMSC_IOBUFSECTORS
+   * hardware sectors.  SCSI commands are processed one at a time so all
+   * LUNs may share a single I/O buffer.  The I/O buffer will be allocated so
+   * that is it as large as needed for the largest block device sector size
    */
 
+  iosize = geo.geo_sectorsize * CONFIG_USBMSC_IOBUFSECTORS;
   if (!priv->iobuffer)
     {
-      priv->iobuffer = (FAR uint8_t *)kmm_malloc(geo.geo_sectorsize);
+      priv->iobuffer = (FAR uint8_t *)kmm_malloc(iosize);
       if (!priv->iobuffer)
         {
           usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_ALLOCIOBUFFER), geo.geo_sectorsize);
           return -ENOMEM;
         }
 
-      priv->iosize = geo.geo_sectorsize;
+      priv->iosize = iosize;
     }
-  else if (priv->iosize < geo.geo_sectorsize)
+  else if (priv->iosize < iosize)
     {
       FAR void *tmp;
 
-      tmp = (FAR void *)kmm_realloc(priv->iobuffer, geo.geo_sectorsize);
+      tmp = (FAR void *)kmm_realloc(priv->iobuffer, iosize);
       if (!tmp)
         {
           usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_REALLOCIOBUFFER), geo.geo_sectorsize);
@@ -1562,7 +1564,14 @@ int usbmsc_bindlun(FAR void *handle, FAR const char *drvrpath,
         }
 
       priv->iobuffer = (FAR uint8_t *)tmp;
-      priv->iosize   = geo.geo_sectorsize;
+      priv->iosize   = iosize;
+    }
+
+  /* Forget any sectors buffered for this LUN by a previous binding */
+
+  if (priv->ralun == lun)
+    {
+      priv->ransectors = 0;
     }
 
   lun->inode       = inode;
@@ -1639,9 +1648,14 @@ int usbmsc_unbindlun(FAR void *handle, unsigned int lunno)
   else
 #endif
    {
-      /* Close the block driver */
+      /* Close the block driver and forget any sectors buffered from it */
 
      usbmsc_lununinitialize(lun);
+     if (priv->ralun == lun)
+       {
+         priv->ransectors = 0;
+       }
+
      ret = OK;
    }
 
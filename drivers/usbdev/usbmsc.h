@@ -165,6 +165,12 @@
 #  endif
 #endif
 
+/* Number of sectors in the I/O buffer */
+
+#ifndef CONFIG_USBMSC_IOBUFSECTORS
+#  define CONFIG_USBMSC_IOBUFSECTORS 1
+#endif
+
 /* Vendor and product IDs and strings */
 
 #ifndef CONFIG_USBMSC_COMPOSITE
@@ -429,9 +435,10 @@ struct usbmsc_dev_s
   uint8_t           cbwdir:2;         /* Direction from CBW. See USBMSC_FLAGS_DIR* definitions */
   uint8_t           cdblen;           /* Length of cdb[] from CBW */
   uint8_t           cbwlun;           /* LUN from the CBW */
-  uint16_t          nsectbytes;       /* Bytes buffered in iobuffer[] */
   uint16_t          nreqbytes;        /* Bytes buffered in head write requests */
-  uint16_t          iosize;           /* Size of iobuffer[] */
+  uint32_t          nsectbytes;       /* Bytes buffered in iobuffer[] */
+  uint32_t          iooffset;         /* Read: Offset of the next byte in iobuffer[] */
+  uint32_t          iosize;           /* Size of iobuffer[] */
   uint32_t          cbwlen;           /* Length of data from CBW */
   uint32_t          cbwtag;           /* Tag from the CBW */
   union
@@ -443,6 +450,14 @@ struct usbmsc_dev_s
   uint32_t          residue;          /* Untransferred amount reported in the CSW */
   uint8_t          *iobuffer;         /* Buffer for data transfers */
 
+  /* Sectors held in iobuffer[] by the last read.  With CONFIG_USBMSC_READAHEAD
+   * these may satisfy the next, sequential read command.
+   */
+
+  FAR struct usbmsc_lun_s *ralun;     /* LUN of the buffered sectors */
+  uint32_t          rasector;         /* First buffered sector */
+  uint32_t          ransectors;       /* Number of buffered sectors.  0: None */
+
   /* Write request list */
 
   struct sq_queue_s wrreqlist;        /* List of empty write request containers */
@@ -139,6 +139,13 @@ static void     usbmsc_putle16(uint8_t * buf, uint16_t val);
 #endif
 static void     usbmsc_putle32(uint8_t *buf, uint32_t val);
 
+/* Sector I/O ***************************************************************/
+
+static inline uint32_t usbmsc_iosectors(FAR struct usbmsc_dev_s *priv,
+                FAR struct usbmsc_lun_s *lun);
+static int    usbmsc_writesectors(FAR struct usbmsc_dev_s *priv,
+                uint32_t nsectors);
+
 /* SCSI Command Processing **************************************************/
 
 static inline int usbmsc_cmdtestunitready(FAR struct usbmsc_dev_s *priv);
@@ -404,6 +411,56 @@ static void usbmsc_scsi_wait(FAR struct usbmsc_dev_s *priv)
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Sector I/O
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: usbmsc_iosectors
+ *
+ * Description:
+ *   Return the number of sectors of the LUN that fit in iobuffer[]
+ *
+ ****************************************************************************/
+
+static inline uint32_t usbmsc_iosectors(FAR struct usbmsc_dev_s *priv,
+                                        FAR struct usbmsc_lun_s *lun)
+{
+  return priv->iosize / lun->sectorsize;
+}
+
+/****************************************************************************
+ * Name: usbmsc_writesectors
+ *
+ * Description:
+ *   Write the first nsectors sectors in iobuffer[] to the block driver at
+ *   the current sector and update the write state variables.  On failure,
+ *   the sense data of the LUN is set and a negated errno is returned.
+ *
+ ****************************************************************************/
+
+static int usbmsc_writesectors(FAR struct usbmsc_dev_s *priv,
+                               uint32_t nsectors)
+{
+  FAR struct usbmsc_lun_s *lun = priv->lun;
+  ssize_t nwritten;
+
+  nwritten = USBMSC_DRVR_WRITE(lun, priv->iobuffer, priv->sector, nsectors);
+  if (nwritten < (ssize_t)nsectors)
+    {
+      usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDWRITEWRITEFAIL), -nwritten);
+      lun->sd     = SCSI_KCQME_WRITEFAULTAUTOREALLOCFAILED;
+      lun->sdinfo = priv->sector + (nwritten > 0 ? nwritten : 0);
+      return nwritten < 0 ? (int)nwritten : -EIO;
+    }
+
+  priv->nsectbytes = 0;
+  priv->residue   -= nsectors * lun->sectorsize;
+  priv->u.xfrlen  -= nsectors;
+  priv->sector    += nsectors;
+  return OK;
+}
+
 /****************************************************************************
  * Name: usbmsc_cmdtestunitready
  *
@@ -1194,7 +1251,11 @@ static inline int usbmsc_cmdverify10(FAR struct usbmsc_dev_s *priv)
         }
       else
         {
-          /* Try to read the requested blocks */
+          /* Try to read the requested blocks.  This overwrites any sectors
+           * that were buffered by a previous read.
+           */
+
+          priv->ransectors = 0;
 
           for (i = 0, sector = lba + lun->startsector; i < blocks; i++, sector++)
             {
@@ -1829,6 +1890,12 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
   priv->nsectbytes   = 0;
   priv->nreqbytes    = 0;
 
+#ifndef CONFIG_USBMSC_READAHEAD
+  /* Sectors read by previous commands are only reused with read-ahead */
+
+  priv->ransectors   = 0;
+#endif
+
   /* Get exclusive access to the block driver */
 
   usbmsc_scsi_lock(priv);
@@ -2106,10 +2173,16 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be read.
  *   sector     - holds the sector number of the next sector to be read
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   nsectbytes - holds the number of bytes in iobuffer[] not yet sent
+ *   iooffset   - holds the offset of those bytes in iobuffer[]
  *   nreqbytes  - holds the number of bytes currently buffered in the request
  *                at the head of the wrreqlist.
  *
+ *   Up to usbmsc_iosectors() sectors are read from the block driver at a
+ *   time.  The block driver is accessed while the USB controller is still
+ *   sending the requests that were filled from the previous sectors, so
+ *   the queued write requests act as the second buffer.
+ *
  ****************************************************************************/
 
 static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
@@ -2119,6 +2192,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
   FAR struct usbdev_req_s *req;
   irqstate_t flags;
   ssize_t nread;
+  uint32_t nsectors;
   uint8_t *src;
   uint8_t *dest;
   int nbytes;
@@ -2137,20 +2211,64 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
 
       if (priv->nsectbytes <= 0)
         {
-          /* Yes.. read the next sector */
+          /* Yes.. Are the next sectors already buffered? */
 
-          nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector, 1);
-          if (nread < 0)
+          if (priv->ralun != lun || priv->ransectors == 0 ||
+              priv->sector < priv->rasector ||
+              priv->sector >= priv->rasector + priv->ransectors)
             {
-              usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL), -nread);
-              lun->sd     = SCSI_KCQME_UNRRE1;
-              lun->sdinfo = priv->sector;
-              break;
+              /* No.. read as many of the next sectors as will fit in the
+               * I/O buffer.  With read-ahead, the buffer is filled even
+               * beyond the end of this command in anticipation of a
+               * sequential read.
+               */
+
+              nsectors = usbmsc_iosectors(priv, lun);
+#ifndef CONFIG_USBMSC_READAHEAD
+              nsectors = MIN(nsectors, priv->u.xfrlen);
+#endif
+              if (priv->sector < lun->nsectors)
+                {
+                  nsectors = MIN(nsectors, lun->nsectors - priv->sector);
+                }
+
+              priv->ransectors = 0;
+
+              nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector,
+                                       nsectors);
+#ifdef CONFIG_USBMSC_READAHEAD
+              if (nread <= 0 && nsectors > priv->u.xfrlen)
+                {
+                  /* The failure may be in the read-ahead sectors.  Retry
+                   * with only the sectors needed by this command.
+                   */
+
+                  nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector,
+                                           priv->u.xfrlen);
+                }
+#endif
+              if (nread <= 0)
+                {
+                  usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL), -nread);
+                  lun->sd     = SCSI_KCQME_UNRRE1;
+                  lun->sdinfo = priv->sector;
+                  break;
+                }
+
+              priv->ralun      = lun;
+              priv->rasector   = priv->sector;
+              priv->ransectors = nread;
             }
 
-          priv->nsectbytes = lun->sectorsize;
-          priv->u.xfrlen--;
-          priv->sector++;
+          /* Send the buffered sectors that this command needs */
+
+          nsectors = MIN(priv->u.xfrlen,
+                         priv->rasector + priv->ransectors - priv->sector);
+
+          priv->iooffset   = (priv->sector - priv->rasector) * lun->sectorsize;
+          priv->nsectbytes = nsectors * lun->sectorsize;
+          priv->u.xfrlen  -= nsectors;
+          priv->sector    += nsectors;
         }
 
       /* Check if there is a request in the wrreqlist that we will be able to
@@ -2178,7 +2296,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * all of the data available in the sector buffer.
        */
 
-      src    = &priv->iobuffer[lun->sectorsize - priv->nsectbytes];
+      src    = &priv->iobuffer[priv->iooffset];
       dest   = &req->buf[priv->nreqbytes];
 
       nbytes = MIN(CONFIG_USBMSC_BULKINREQLEN - priv->nreqbytes, priv->nsectbytes);
@@ -2188,6 +2306,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
       memcpy(dest, src, nbytes);
       priv->nreqbytes  += nbytes;
       priv->nsectbytes -= nbytes;
+      priv->iooffset   += nbytes;
 
       /* If (1) the request buffer is full OR (2) this is the final request full of data,
        * then submit the request
@@ -2253,10 +2372,15 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be written.
  *   sector     - holds the sector number of the next sector to write
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   nsectbytes - holds the number of bytes buffered in iobuffer[]
  *   nreqbytes  - holds the number of untransferred bytes currently in the
  *                request at the head of the rdreqlist.
  *
+ *   Data is collected in iobuffer[] and written to the block driver up to
+ *   usbmsc_iosectors() sectors at a time.  Read requests are returned to the
+ *   endpoint as soon as they have been copied, so the host keeps sending
+ *   into them while the block driver is being written.
+ *
  ****************************************************************************/
 
 static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
@@ -2264,13 +2388,18 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
   FAR struct usbmsc_lun_s *lun = priv->lun;
   FAR struct usbmsc_req_s *privreq;
   FAR struct usbdev_req_s *req;
-  ssize_t nwritten;
+  uint32_t nsectors;
+  uint32_t iolen;
   uint16_t xfrd;
   uint8_t *src;
   uint8_t *dest;
   int nbytes;
   int ret;
 
+  /* iobuffer[] no longer holds any sectors that were read */
+
+  priv->ransectors = 0;
+
   /* Loop transferring data until either (1) all of the data has been
    * transferred, or (2) we have written all of the data in the available
    * read requests.
@@ -2311,12 +2440,19 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
       while (priv->nreqbytes > 0 && priv->u.xfrlen > 0)
         {
+          /* The I/O buffer is written when it holds either as many sectors
+           * as it can or all of the remaining sectors of the command.
+           */
+
+          nsectors = MIN(usbmsc_iosectors(priv, lun), priv->u.xfrlen);
+          iolen    = nsectors * lun->sectorsize;
+
           /* Copy the data received in the read request into the sector I/O buffer */
 
           src  = &req->buf[xfrd - priv->nreqbytes];
           dest = &priv->iobuffer[priv->nsectbytes];
 
-          nbytes = MIN(lun->sectorsize - priv->nsectbytes, priv->nreqbytes);
+          nbytes = MIN(iolen - priv->nsectbytes, priv->nreqbytes);
 
           /* Copy the data from the sector buffer to the USB request and update counts */
 
@@ -2326,23 +2462,14 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
           /* Is the I/O buffer full? */
 
-          if (priv->nsectbytes >= lun->sectorsize)
+          if (priv->nsectbytes >= iolen)
             {
-              /* Yes.. Write the next sector */
+              /* Yes.. Write the buffered sectors */
 
-              nwritten = USBMSC_DRVR_WRITE(lun, priv->iobuffer, priv->sector, 1);
-              if (nwritten < 0)
+              if (usbmsc_writesectors(priv, nsectors) < 0)
                 {
-                  usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDWRITEWRITEFAIL), -nwritten);
-                  lun->sd     = SCSI_KCQME_WRITEFAULTAUTOREALLOCFAILED;
-                  lun->sdinfo = priv->sector;
                   goto errout;
                 }
-
-              priv->nsectbytes = 0;
-              priv->residue   -= lun->sectorsize;
-              priv->u.xfrlen--;
-              priv->sector++;
             }
         }
 
@@ -2365,6 +2492,14 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
       if (xfrd != CONFIG_USBMSC_BULKOUTREQLEN)
         {
+          /* Write the complete sectors that were received */
+
+          nsectors = priv->nsectbytes / lun->sectorsize;
+          if (nsectors > 0)
+            {
+              (void)usbmsc_writesectors(priv, nsectors);
+            }
+
           priv->shortpacket = 1;
           goto errout;
         }
@@ -90,6 +90,14 @@
 #  error "Currently limited to 26 devices /dev/sda-z"
 #endif
 
+/* The largest data transfer performed by a single READ(10) or WRITE(10)
+ * command.  Larger block driver requests are split into several commands.
+ */
+
+#ifndef CONFIG_USBHOST_MSC_MAXTRANSFER
+#  define CONFIG_USBHOST_MSC_MAXTRANSFER (240 * 512)
+#endif
+
 /* Driver support ***********************************************************/
 /* This format is used to construct the /dev/sd[n] device driver path.  It
  * defined here so that it will be used consistently in all places.
@@ -131,6 +139,7 @@ struct usbhost_state_s
   int16_t                 crefs;        /* Reference count on the driver instance */
   uint16_t                blocksize;    /* Block size of USB mass storage device */
   uint32_t                nblocks;      /* Number of blocks on the USB mass storage device */
+  uint16_t                maxsectors;   /* Max number of blocks per READ/WRITE command */
   sem_t                   exclsem;      /* Used to maintain mutual exclusive access */
   struct work_s           work;         /* For interacting with the worker thread */
   FAR uint8_t            *tbuffer;      /* The allocated transfer buffer */
@@ -196,6 +205,9 @@ static inline int usbhost_testunitready(FAR struct usbhost_state_s *priv);
 static inline int usbhost_requestsense(FAR struct usbhost_state_s *priv);
 static inline int usbhost_readcapacity(FAR struct usbhost_state_s *priv);
 static inline int usbhost_inquiry(FAR struct usbhost_state_s *priv);
+static ssize_t usbhost_sectorxfer(FAR struct usbhost_state_s *priv,
+                                  FAR uint8_t *buffer, size_t startsector,
+                                  unsigned int nsectors, bool out);
 
 /* Worker thread actions */
 
@@ -901,6 +913,101 @@ static inline int usbhost_inquiry(FAR struct usbhost_state_s *priv)
   return nbytes < 0 ? (int)nbytes : OK;
 }
 
+/****************************************************************************
+ * Name: usbhost_sectorxfer
+ *
+ * Description:
+ *   Perform one READ(10) or WRITE(10) command: Send the CBW, transfer the
+ *   sector data directly to or from the caller's buffer and receive the
+ *   CSW.  The command is retried if the transaction was NAKed.
+ *
+ * Input Parameters:
+ *   priv        - A reference to the class instance.
+ *   buffer      - The sector data.
+ *   startsector - The first sector to transfer.
+ *   nsectors    - The number of sectors; at most priv->maxsectors.
+ *   out         - True: write to the device; false: read from the device.
+ *
+ * Returned Value:
+ *   The non-negative result of the last transfer on success; a negated
+ *   errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds exclsem.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_sectorxfer(FAR struct usbhost_state_s *priv,
+                                  FAR uint8_t *buffer, size_t startsector,
+                                  unsigned int nsectors, bool out)
+{
+  FAR struct usbhost_hubport_s *hport = priv->usbclass.hport;
+  FAR struct usbmsc_cbw_s *cbw;
+  ssize_t nbytes;
+
+  DEBUGASSERT(nsectors > 0 && nsectors <= priv->maxsectors);
+
+  /* Initialize a CBW (re-using the allocated transfer buffer) */
+
+  cbw = usbhost_cbwalloc(priv);
+  if (cbw == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Loop in the event that EAGAIN is returned (mean that the transaction
+   * was NAKed and we should try again.
+   */
+
+  do
+    {
+      /* Construct and send the CBW */
+
+      if (out)
+        {
+          usbhost_writecbw(startsector, priv->blocksize, nsectors, cbw);
+        }
+      else
+        {
+          usbhost_readcbw(startsector, priv->blocksize, nsectors, cbw);
+        }
+
+      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
+                             (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
+      if (nbytes >= 0)
+        {
+          /* Send or receive the user data */
+
+          nbytes = DRVR_TRANSFER(hport->drvr,
+                                 out ? priv->bulkout : priv->bulkin,
+                                 buffer, priv->blocksize * nsectors);
+          if (nbytes >= 0)
+            {
+              /* Receive the CSW */
+
+              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
+                                     priv->tbuffer, USBMSC_CSW_SIZEOF);
+              if (nbytes >= 0)
+                {
+                  FAR struct usbmsc_csw_s *csw;
+
+                  /* Check the CSW status */
+
+                  csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
+                  if (csw->status != 0)
+                    {
+                      uerr("ERROR: CSW status error: %d\n", csw->status);
+                      nbytes = -ENODEV;
+                    }
+                }
+            }
+        }
+    }
+  while (nbytes == -EAGAIN);
+
+  return nbytes;
+}
+
 /****************************************************************************
  * Name: usbhost_destroy
  *
@@ -1316,6 +1423,32 @@ static inline int usbhost_initvolume(FAR struct usbhost_state_s *priv)
               uerr("ERROR: CSW status error: %d\n", csw->status);
               ret = -ENODEV;
             }
+          else if (priv->blocksize == 0)
+            {
+              uerr("ERROR: Invalid block size\n");
+              ret = -ENODEV;
+            }
+          else
+            {
+              /* Limit the size of each READ(10)/WRITE(10) data transfer.
+               * The transfer length field of these commands is 16 bits.
+               */
+
+              uint32_t maxsectors = CONFIG_USBHOST_MSC_MAXTRANSFER /
+                                    priv->blocksize;
+
+              if (maxsectors < 1)
+                {
+                  maxsectors = 1;
+                }
+              else if (maxsectors > UINT16_MAX)
+                {
+                  maxsectors = UINT16_MAX;
+                }
+
+              priv->maxsectors = (uint16_t)maxsectors;
+              uinfo("Max sectors per command: %d\n", priv->maxsectors);
+            }
         }
     }
 
@@ -1983,14 +2116,11 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
                             size_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
   ssize_t nbytes = 0;
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
-
   DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
 
   uinfo("startsector: %d nsectors: %d sectorsize: %d\n",
         startsector, nsectors, priv->blocksize);
@@ -2008,64 +2138,33 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
     }
   else if (nsectors > 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
+      unsigned int remaining = nsectors;
+      unsigned int nxfer;
 
       usbhost_takesem(&priv->exclsem);
 
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
+      /* Read up to maxsectors with each command */
 
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
-
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
+      do
         {
-          /* Loop in the event that EAGAIN is returned (mean that the
-           * transaction was NAKed and we should try again.
-           */
-
-          do
+          nxfer = remaining;
+          if (nxfer > priv->maxsectors)
             {
-              /* Assume some device failure */
-
-              nbytes = -ENODEV;
-
-              /* Construct and send the CBW */
-
-              usbhost_readcbw(startsector, priv->blocksize, nsectors, cbw);
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-              if (nbytes >= 0)
-                {
-                  /* Receive the user data */
+              nxfer = priv->maxsectors;
+            }
 
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         buffer, priv->blocksize * nsectors);
-                  if (nbytes >= 0)
-                    {
-                      /* Receive the CSW */
-
-                      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                             priv->tbuffer, USBMSC_CSW_SIZEOF);
-                      if (nbytes >= 0)
-                        {
-                          FAR struct usbmsc_csw_s *csw;
-
-                          /* Check the CSW status */
-
-                          csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                          if (csw->status != 0)
-                            {
-                              uerr("ERROR: CSW status error: %d\n", csw->status);
-                              nbytes = -ENODEV;
-                            }
-                        }
-                    }
-                }
+          nbytes = usbhost_sectorxfer(priv, buffer, startsector, nxfer,
+                                      false);
+          if (nbytes < 0)
+            {
+              break;
             }
-          while (nbytes == -EAGAIN);
+
+          buffer      += (size_t)priv->blocksize * nxfer;
+          startsector += nxfer;
+          remaining   -= nxfer;
         }
+      while (remaining > 0);
 
       usbhost_givesem(&priv->exclsem);
     }
@@ -2089,16 +2188,14 @@ static ssize_t usbhost_write(FAR struct inode *inode, const unsigned char *buffe
                            size_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
-  ssize_t nbytes;
-
-  uinfo("sector: %d nsectors: %d sectorsize: %d\n");
+  ssize_t nbytes = 0;
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
-
   DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
+
+  uinfo("sector: %d nsectors: %d sectorsize: %d\n",
+        startsector, nsectors, priv->blocksize);
 
   /* Check if the mass storage device is still connected */
 
@@ -2111,58 +2208,35 @@ static ssize_t usbhost_write(FAR struct inode *inode, const unsigned char *buffe
 
       nbytes = -ENODEV;
     }
-  else
+  else if (nsectors > 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
+      unsigned int remaining = nsectors;
+      unsigned int nxfer;
 
       usbhost_takesem(&priv->exclsem);
 
-     /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
+      /* Write up to maxsectors with each command */
 
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
+      do
         {
-          /* Assume some device failure */
-
-          nbytes = -ENODEV;
-
-          /* Construct and send the CBW */
-
-          usbhost_writecbw(startsector, priv->blocksize, nsectors, cbw);
-          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-          if (nbytes >= 0)
+          nxfer = remaining;
+          if (nxfer > priv->maxsectors)
             {
-              /* Send the user data */
-
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)buffer, priv->blocksize * nsectors);
-              if (nbytes >= 0)
-                {
-                  /* Receive the CSW */
-
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
-                  if (nbytes >= 0)
-                    {
-                      FAR struct usbmsc_csw_s *csw;
-
-                      /* Check the CSW status */
+              nxfer = priv->maxsectors;
+            }
 
-                      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                      if (csw->status != 0)
-                        {
-                          uerr("ERROR: CSW status error: %d\n", csw->status);
-                          nbytes = -ENODEV;
-                        }
-                    }
-                }
+          nbytes = usbhost_sectorxfer(priv, (FAR uint8_t *)buffer,
+                                      startsector, nxfer, true);
+          if (nbytes < 0)
+            {
+              break;
             }
+
+          buffer      += (size_t)priv->blocksize * nxfer;
+          startsector += nxfer;
+          remaining   -= nxfer;
         }
+      while (remaining > 0);
 
       usbhost_givesem(&priv->exclsem);
     }
@@ -353,7 +353,21 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           DEBUGASSERT(pinfo != 0 && fb->vtable != NULL &&
                       fb->vtable->getplaneinfo != NULL);
+#ifdef CONFIG_FB_PANDISPLAY
+          /* Drivers that do not support panning leave the virtual size
+           * unset.  Report it as a single frame.
+           */
+
+          pinfo->yres_virtual = 0;
+          pinfo->yoffset      = 0;
+#endif
           ret = fb->vtable->getplaneinfo(fb->vtable, fb->plane, pinfo);
+#ifdef CONFIG_FB_PANDISPLAY
+          if (ret >= 0 && pinfo->yres_virtual == 0 && pinfo->stride > 0)
+            {
+              pinfo->yres_virtual = pinfo->fblen / pinfo->stride;
+            }
+#endif
         }
         break;
 
@@ -424,7 +438,34 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 #ifdef CONFIG_FB_SYNC
       case FBIO_WAITFORVSYNC:  /* Wait upon vertical sync */
         {
-          ret = fb->vtable->waitforvsync(fb->vtable);
+          DEBUGASSERT(fb->vtable != NULL);
+          if (fb->vtable->waitforvsync != NULL)
+            {
+              ret = fb->vtable->waitforvsync(fb->vtable);
+            }
+          else
+            {
+              ret = -ENOTTY;
+            }
+        }
+        break;
+#endif
+
+#ifdef CONFIG_FB_PANDISPLAY
+      case FBIOPAN_DISPLAY:  /* Select the visible frame */
+        {
+          FAR const struct fb_planeinfo_s *pinfo =
+            (FAR const struct fb_planeinfo_s *)((uintptr_t)arg);
+
+          DEBUGASSERT(pinfo != NULL && fb->vtable != NULL);
+          if (fb->vtable->pandisplay != NULL)
+            {
+              ret = fb->vtable->pandisplay(fb->vtable, pinfo);
+            }
+          else
+            {
+              ret = -ENOTTY;
+            }
         }
         break;
 #endif
@@ -78,6 +78,40 @@
 #  error AIO needs file and/or socket descriptors
 #endif
 
+/* Dedicated AIO worker threads ("lanes") */
+
+#ifndef CONFIG_FS_AIO_NLANES
+#  define CONFIG_FS_AIO_NLANES 0
+#endif
+
+#if CONFIG_FS_AIO_NLANES > 0
+#  ifndef CONFIG_FS_AIO_PRIORITY
+#    define CONFIG_FS_AIO_PRIORITY 50
+#  endif
+#  ifndef CONFIG_FS_AIO_STACKSIZE
+#    define CONFIG_FS_AIO_STACKSIZE 2048
+#  endif
+#  if !defined(CONFIG_FS_AIO_NMERGE) || CONFIG_FS_AIO_NMERGE < 1
+#    undef CONFIG_FS_AIO_NMERGE
+#    define CONFIG_FS_AIO_NMERGE 1
+#  endif
+#  define AIO_NMERGE CONFIG_FS_AIO_NMERGE
+#else
+#  define AIO_NMERGE 1
+#endif
+
+/* The priority of the low priority work queue is restored by the worker
+ * when each request completes.  AIO worker threads restore their own
+ * priority when their queue becomes empty.
+ */
+
+#if defined(CONFIG_PRIORITY_INHERITANCE) && CONFIG_FS_AIO_NLANES == 0
+#  define AIO_HAVE_LPPRIO
+#  define aio_restorepriority(p) lpwork_restorepriority(p)
+#else
+#  define aio_restorepriority(p)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -87,6 +121,7 @@
  */
 
 struct file;
+struct aio_lane_s;
 struct aio_container_s
 {
   dq_entry_t aioc_link;            /* Supports a doubly linked list */
@@ -101,13 +136,37 @@ struct aio_container_s
 #endif
     FAR void *ptr;                 /* Generic pointer to FAR data */
   } u;
+#if CONFIG_FS_AIO_NLANES > 0
+  dq_entry_t aioc_qlink;           /* Link in the queue of an AIO lane */
+  FAR struct aio_lane_s *aioc_lane; /* Lane queued on or NULL if dequeued */
+  worker_t aioc_worker;            /* Worker that performs the I/O */
+#else
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+#endif
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
 #endif
 };
 
+/* This structure describes a run of one or more decanted requests that are
+ * performed as one transfer.  The requests are adjacent both in the file
+ * and in memory so the transfer starts at the offset and buffer of the
+ * first request and spans 'nbytes', the sum of their lengths.
+ */
+
+struct aio_run_s
+{
+  FAR void *ptr;                   /* File or socket structure */
+  size_t nbytes;                   /* Total length of the transfer */
+  int nreqs;                       /* Number of requests in the run */
+  FAR struct aiocb *aiocbp[AIO_NMERGE]; /* The requests, in file order */
+  pid_t pid[AIO_NMERGE];           /* The waiting tasks */
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  uint8_t prio;                    /* Priority of the first waiting task */
+#endif
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -240,6 +299,27 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp);
 
 FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
+/****************************************************************************
+ * Name: aioc_decantrun
+ *
+ * Description:
+ *   Decant the AIO control block from the container like aioc_decant().
+ *   In addition, any requests that are still queued behind it and that can
+ *   be performed in the same transfer are removed from their queue and
+ *   decanted as well.
+ *
+ * Input Parameters:
+ *   aioc - Pointer to the AIO control block container
+ *   run  - Location to return the description of the transfer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aioc_decantrun(FAR struct aio_container_s *aioc,
+                    FAR struct aio_run_s *run);
+
 /****************************************************************************
  * Name: aio_queue
  *
@@ -258,6 +338,48 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove an AIO request that has not yet been started from its queue.
+ *
+ * Input Parameters:
+ *   aioc - The AIO control block container
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was dequeued; -ENOENT if it has already been
+ *   started.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc);
+
+/****************************************************************************
+ * Name: aio_merge
+ *
+ * Description:
+ *   Remove the next queued request from the lane of 'aioc' if that request
+ *   is performed by the same worker on the same file at the offset and
+ *   buffer immediately following 'aiocbp'.
+ *
+ * Input Parameters:
+ *   aioc   - The container of the first request of the run
+ *   aiocbp - The last request of the run
+ *
+ * Returned Value:
+ *   The container of the adjacent request or NULL if there is none.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_AIO_NLANES > 0 && AIO_NMERGE > 1
+FAR struct aio_container_s *aio_merge(FAR struct aio_container_s *aioc,
+                                      FAR struct aiocb *aiocbp);
+#endif
+
 /****************************************************************************
  * Name: aio_signal
  *
@@ -277,6 +399,24 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
 int aio_signal(pid_t pid, FAR struct aiocb *aiocbp);
 
+/****************************************************************************
+ * Name: aio_signalrun
+ *
+ * Description:
+ *   Distribute the result of a transfer over the requests of the run and
+ *   signal each client.
+ *
+ * Input Parameters:
+ *   run    - The run of requests performed by the transfer
+ *   result - The number of bytes transferred or a negated errno value
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_signalrun(FAR struct aio_run_s *run, ssize_t result);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -76,8 +76,9 @@ static void aio_fsync_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPPRIO
   uint8_t prio;
 #endif
   int ret;
@@ -89,14 +90,15 @@ static void aio_fsync_worker(FAR void *arg)
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+  filep  = aioc->u.aioc_filep;
+#ifdef AIO_HAVE_LPPRIO
   prio   = aioc->aioc_prio;
 #endif
   aiocbp = aioc_decant(aioc);
 
   /* Perform the fsync using u.aioc_filep */
 
-  ret = file_fsync(aioc->u.aioc_filep);
+  ret = file_fsync(filep);
   if (ret < 0)
     {
       ferr("ERROR: file_fsync failed: %d\n", ret);
@@ -111,7 +113,7 @@ static void aio_fsync_worker(FAR void *arg)
 
   (void)aio_signal(pid, aiocbp);
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPPRIO
   /* Restore the low priority worker thread default priority */
 
   lpwork_restorepriority(prio);
@@ -39,26 +39,294 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <sched.h>
 #include <aio.h>
+#include <queue.h>
+#include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 
 #include "aio/aio.h"
 
 #ifdef CONFIG_FS_AIO
 
+#if CONFIG_FS_AIO_NLANES > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Convert a lane queue link back to its container */
+
+#define AIO_QLINK2AIOC(e) \
+  ((FAR struct aio_container_s *) \
+   ((FAR char *)(e) - offsetof(struct aio_container_s, aioc_qlink)))
+
+/* Sockets have no file offset and are neither sorted nor merged */
+
+#if defined(AIO_HAVE_FILEP) && defined(AIO_HAVE_PSOCK)
+#  define AIO_ISFILE(a) \
+     ((a)->aioc_aiocbp->aio_fildes < CONFIG_NFILE_DESCRIPTORS)
+#elif defined(AIO_HAVE_FILEP)
+#  define AIO_ISFILE(a) true
+#else
+#  define AIO_ISFILE(a) false
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one AIO lane:  A dedicated worker thread and
+ * its queue of requests.
+ */
+
+struct aio_lane_s
+{
+  dq_queue_t queue;                /* Requests waiting for the worker */
+  sem_t sem;                       /* Posted for each request queued */
+  pid_t pid;                       /* ID of the worker thread */
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  uint8_t prio;                    /* Current priority of the worker */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct aio_lane_s g_aio_lanes[CONFIG_FS_AIO_NLANES];
+static bool g_aio_started;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_lane_select
+ *
+ * Description:
+ *   Select the lane that serves a request.  File I/O is keyed by the inode
+ *   which, for files in a mounted volume, is the mountpoint inode.  So all
+ *   of the I/O for one volume or device goes to the same lane.
+ *
+ ****************************************************************************/
+
+static FAR struct aio_lane_s *
+aio_lane_select(FAR struct aio_container_s *aioc)
+{
+  uintptr_t key = (uintptr_t)aioc->u.ptr;
+
+#ifdef AIO_HAVE_FILEP
+  if (AIO_ISFILE(aioc))
+    {
+      key = (uintptr_t)aioc->u.aioc_filep->f_inode;
+    }
+#endif
+
+  return &g_aio_lanes[(key >> 4) % CONFIG_FS_AIO_NLANES];
+}
+
+/****************************************************************************
+ * Name: aio_lane_thread
+ *
+ * Description:
+ *   The AIO worker thread.  Performs the requests of its lane in order.
+ *
+ ****************************************************************************/
+
+static int aio_lane_thread(int argc, FAR char *argv[])
+{
+  FAR struct aio_lane_s *lane;
+  FAR struct aio_container_s *aioc;
+  FAR dq_entry_t *entry;
+  worker_t worker = NULL;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  struct sched_param param;
+#endif
+  int ret;
+
+  DEBUGASSERT(argc > 1);
+  lane = &g_aio_lanes[atoi(argv[1])];
+
+  for (; ; )
+    {
+      /* Wait for a request.  Canceled and merged requests leave counts
+       * behind so the queue may turn out to be empty.
+       */
+
+      do
+        {
+          ret = nxsem_wait(&lane->sem);
+          DEBUGASSERT(ret == OK || ret == -EINTR);
+        }
+      while (ret == -EINTR);
+
+      aio_lock();
+      entry = dq_remfirst(&lane->queue);
+      if (entry != NULL)
+        {
+          aioc = AIO_QLINK2AIOC(entry);
+          aioc->aioc_lane = NULL;
+          worker = aioc->aioc_worker;
+        }
+
+      aio_unlock();
+
+      /* Perform the I/O */
+
+      if (entry != NULL)
+        {
+          worker(aioc);
+        }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Drop back to the base priority once the last waiter is served */
+
+      aio_lock();
+      if (dq_empty(&lane->queue) && lane->prio != CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = CONFIG_FS_AIO_PRIORITY;
+          (void)nxsched_setparam(lane->pid, &param);
+          lane->prio = CONFIG_FS_AIO_PRIORITY;
+        }
+
+      aio_unlock();
+#endif
+    }
+
+  return OK; /* To keep some compilers happy */
+}
+
+/****************************************************************************
+ * Name: aio_lane_start
+ *
+ * Description:
+ *   Start the AIO worker threads.  This is deferred until the first
+ *   request so that no resources are used unless AIO is used.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+static int aio_lane_start(void)
+{
+  FAR char *argv[2];
+  char arg[8];
+  int ndx;
+  int pid;
+
+  for (ndx = 0; ndx < CONFIG_FS_AIO_NLANES; ndx++)
+    {
+      FAR struct aio_lane_s *lane = &g_aio_lanes[ndx];
+
+      if (lane->pid > 0)
+        {
+          continue;
+        }
+
+      dq_init(&lane->queue);
+      (void)nxsem_init(&lane->sem, 0, 0);
+      (void)nxsem_setprotocol(&lane->sem, SEM_PRIO_NONE);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      lane->prio = CONFIG_FS_AIO_PRIORITY;
+#endif
+
+      snprintf(arg, sizeof(arg), "%d", ndx);
+      argv[0] = arg;
+      argv[1] = NULL;
+
+      pid = kthread_create("aio", CONFIG_FS_AIO_PRIORITY,
+                           CONFIG_FS_AIO_STACKSIZE,
+                           (main_t)aio_lane_thread,
+                           (FAR char * const *)argv);
+      if (pid < 0)
+        {
+          ferr("ERROR: kthread_create %d failed: %d\n", ndx, pid);
+          (void)nxsem_destroy(&lane->sem);
+          return pid;
+        }
+
+      lane->pid = pid;
+    }
+
+  g_aio_started = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_lane_queue
+ *
+ * Description:
+ *   Add a request to its lane.  Requests are served first-come, first-
+ *   served except that a read (or write) of a file is moved ahead of the
+ *   queued reads (or writes) of the same file at higher offsets that it
+ *   directly follows in the queue.  Adjacent requests thereby end up next
+ *   to each other where they can be merged.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+static void aio_lane_queue(FAR struct aio_lane_s *lane,
+                           FAR struct aio_container_s *aioc)
+{
+  FAR dq_entry_t *prev = dq_tail(&lane->queue);
+
+  if (AIO_ISFILE(aioc))
+    {
+      while (prev != NULL)
+        {
+          FAR struct aio_container_s *peer = AIO_QLINK2AIOC(prev);
+
+          if (peer->u.ptr != aioc->u.ptr ||
+              peer->aioc_worker != aioc->aioc_worker ||
+              peer->aioc_aiocbp->aio_offset <=
+              aioc->aioc_aiocbp->aio_offset)
+            {
+              break;
+            }
+
+          prev = dq_prev(prev);
+        }
+    }
+
+  if (prev != NULL)
+    {
+      dq_addafter(prev, &aioc->aioc_qlink, &lane->queue);
+    }
+  else
+    {
+      dq_addfirst(&aioc->aioc_qlink, &lane->queue);
+    }
+
+  aioc->aioc_lane = lane;
+}
+
+#endif /* CONFIG_FS_AIO_NLANES > 0 */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue or, if
+ *   CONFIG_FS_AIO_NLANES is non-zero, on a dedicated AIO worker thread.
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -72,6 +340,59 @@
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 {
+#if CONFIG_FS_AIO_NLANES > 0
+  FAR struct aio_lane_s *lane;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  struct sched_param param;
+#endif
+  int ret = OK;
+
+  aio_lock();
+
+  if (!g_aio_started)
+    {
+      ret = aio_lane_start();
+    }
+
+  if (ret >= 0)
+    {
+      lane = aio_lane_select(aioc);
+      aioc->aioc_worker = worker;
+      aio_lane_queue(lane, aioc);
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Make sure that the worker thread is running at at least the
+       * priority of the waiting thread.
+       */
+
+      if (aioc->aioc_prio > lane->prio)
+        {
+          param.sched_priority = aioc->aioc_prio;
+          (void)nxsched_setparam(lane->pid, &param);
+          lane->prio = aioc->aioc_prio;
+        }
+#endif
+    }
+
+  aio_unlock();
+
+  if (ret >= 0)
+    {
+      nxsem_post(&lane->sem);
+    }
+  else
+    {
+      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+      DEBUGASSERT(aiocbp);
+
+      aiocbp->aio_result = ret;
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+
+#else
   int ret;
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -108,6 +429,95 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
   sched_unlock();
 #endif
   return ret;
+#endif /* CONFIG_FS_AIO_NLANES > 0 */
+}
+
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove an AIO request that has not yet been started from its queue.
+ *
+ * Input Parameters:
+ *   aioc - The AIO control block container
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was dequeued; -ENOENT if it has already been
+ *   started.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+#if CONFIG_FS_AIO_NLANES > 0
+  FAR struct aio_lane_s *lane;
+  int ret = -ENOENT;
+
+  aio_lock();
+  lane = aioc->aioc_lane;
+  if (lane != NULL)
+    {
+      dq_rem(&aioc->aioc_qlink, &lane->queue);
+      aioc->aioc_lane = NULL;
+      ret = OK;
+    }
+
+  aio_unlock();
+  return ret;
+#else
+  return work_cancel(LPWORK, &aioc->aioc_work);
+#endif
 }
 
+/****************************************************************************
+ * Name: aio_merge
+ *
+ * Description:
+ *   Remove the next queued request from the lane of 'aioc' if that request
+ *   is performed by the same worker on the same file at the offset and
+ *   buffer immediately following 'aiocbp'.
+ *
+ * Input Parameters:
+ *   aioc   - The container of the first request of the run
+ *   aiocbp - The last request of the run
+ *
+ * Returned Value:
+ *   The container of the adjacent request or NULL if there is none.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_AIO_NLANES > 0 && AIO_NMERGE > 1
+FAR struct aio_container_s *aio_merge(FAR struct aio_container_s *aioc,
+                                      FAR struct aiocb *aiocbp)
+{
+  FAR struct aio_lane_s *lane = aio_lane_select(aioc);
+  FAR struct aio_container_s *next;
+  FAR dq_entry_t *entry;
+
+  entry = dq_peek(&lane->queue);
+  if (entry == NULL || !AIO_ISFILE(aioc))
+    {
+      return NULL;
+    }
+
+  next = AIO_QLINK2AIOC(entry);
+  if (next->u.ptr != aioc->u.ptr ||
+      next->aioc_worker != aioc->aioc_worker ||
+      next->aioc_aiocbp->aio_offset !=
+      aiocbp->aio_offset + (off_t)aiocbp->aio_nbytes ||
+      next->aioc_aiocbp->aio_buf !=
+      (FAR volatile uint8_t *)aiocbp->aio_buf + aiocbp->aio_nbytes)
+    {
+      return NULL;
+    }
+
+  dq_rem(entry, &lane->queue);
+  next->aioc_lane = NULL;
+  return next;
+}
+#endif
+
 #endif /* CONFIG_FS_AIO */
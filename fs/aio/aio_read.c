@@ -76,23 +76,18 @@ static void aio_read_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
+  struct aio_run_s run;
   ssize_t nread = 0;
 
   /* Get the information from the container, decant the AIO control block,
    * and free the container before starting any I/O.  That will minimize
    * the delays by any other threads waiting for a pre-allocated container.
+   * Adjacent reads queued behind this one are decanted too and performed
+   * in the same transfer.
    */
 
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
+  aioc_decantrun(aioc, &run);
+  aiocbp = run.aiocbp[0];
 
 #if defined(AIO_HAVE_FILEP) && defined(AIO_HAVE_PSOCK)
   if (aiocbp->aio_fildes < CONFIG_NFILE_DESCRIPTORS)
@@ -101,14 +96,15 @@ static void aio_read_worker(FAR void *arg)
     {
       /* Perform the file read using:
        *
-       *   u.aioc_filep - File structure pointer
-       *   aio_buf      - Location of buffer
-       *   aio_nbytes   - Length of transfer
-       *   aio_offset   - File offset
+       *   run.ptr    - File structure pointer
+       *   aio_buf    - Location of buffer
+       *   run.nbytes - Length of transfer
+       *   aio_offset - File offset
        */
 
-     nread = file_pread(aioc->u.aioc_filep, (FAR void *)aiocbp->aio_buf,
-                        aiocbp->aio_nbytes, aiocbp->aio_offset);
+     nread = file_pread((FAR struct file *)run.ptr,
+                        (FAR void *)aiocbp->aio_buf,
+                        run.nbytes, aiocbp->aio_offset);
     }
 #endif
 #if defined(AIO_HAVE_FILEP) && defined(AIO_HAVE_PSOCK)
@@ -118,12 +114,13 @@ static void aio_read_worker(FAR void *arg)
     {
       /* Perform the socket receive using:
        *
-       *   u.aioc_psock - Socket structure pointer
-       *   aio_buf      - Location of buffer
-       *   aio_nbytes   - Length of transfer
+       *   run.ptr    - Socket structure pointer
+       *   aio_buf    - Location of buffer
+       *   aio_nbytes - Length of transfer
        */
 
-      nread = psock_recv(aioc->u.aioc_psock, (FAR void *)aiocbp->aio_buf,
+      nread = psock_recv((FAR struct socket *)run.ptr,
+                         (FAR void *)aiocbp->aio_buf,
                          aiocbp->aio_nbytes, 0);
     }
 #endif
@@ -137,17 +134,9 @@ static void aio_read_worker(FAR void *arg)
     }
 #endif
 
-  aiocbp->aio_result = nread;
-
-  /* Signal the client */
+  /* Set the results and signal the clients */
 
-  (void)aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
+  aio_signalrun(&run, nread);
 }
 
 /****************************************************************************
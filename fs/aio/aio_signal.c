@@ -128,4 +128,50 @@ int aio_signal(pid_t pid, FAR struct aiocb *aiocbp)
   return OK;
 }
 
+/****************************************************************************
+ * Name: aio_signalrun
+ *
+ * Description:
+ *   Distribute the result of a transfer over the requests of the run and
+ *   signal each client.
+ *
+ * Input Parameters:
+ *   run    - The run of requests performed by the transfer
+ *   result - The number of bytes transferred or a negated errno value
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_signalrun(FAR struct aio_run_s *run, ssize_t result)
+{
+  int i;
+
+  for (i = 0; i < run->nreqs; i++)
+    {
+      FAR struct aiocb *aiocbp = run->aiocbp[i];
+
+      /* A failure fails every request.  Otherwise the bytes are credited
+       * to the requests in order so a short transfer completes the tail
+       * requests short (or empty).
+       */
+
+      if (result < 0)
+        {
+          aiocbp->aio_result = result;
+        }
+      else
+        {
+          aiocbp->aio_result = (size_t)result < aiocbp->aio_nbytes ?
+                               result : (ssize_t)aiocbp->aio_nbytes;
+          result -= aiocbp->aio_result;
+        }
+
+      (void)aio_signal(run->pid[i], aiocbp);
+    }
+
+  aio_restorepriority(run->prio);
+}
+
 #endif /* CONFIG_FS_AIO */
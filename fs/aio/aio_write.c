@@ -76,10 +76,7 @@ static void aio_write_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
+  struct aio_run_s run;
   ssize_t nwritten = 0;
 #ifdef AIO_HAVE_FILEP
   int oflags;
@@ -88,36 +85,36 @@ static void aio_write_worker(FAR void *arg)
   /* Get the information from the container, decant the AIO control block,
    * and free the container before starting any I/O.  That will minimize
    * the delays by any other threads waiting for a pre-allocated container.
+   * Adjacent writes queued behind this one are decanted too and performed
+   * in the same transfer.
    */
 
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
+  aioc_decantrun(aioc, &run);
+  aiocbp = run.aiocbp[0];
 
 #if defined(AIO_HAVE_FILEP) && defined(AIO_HAVE_PSOCK)
   if (aiocbp->aio_fildes < CONFIG_NFILE_DESCRIPTORS)
 #endif
 #ifdef AIO_HAVE_FILEP
     {
+      FAR struct file *filep = (FAR struct file *)run.ptr;
+
       /* Call fcntl(F_GETFL) to get the file open mode. */
 
-      oflags = file_fcntl(aioc->u.aioc_filep, F_GETFL);
+      oflags = file_fcntl(filep, F_GETFL);
       if (oflags < 0)
         {
           ferr("ERROR: file_fcntl failed: %d\n", oflags);
-          aiocbp->aio_result = oflags;
+          nwritten = oflags;
           goto errout;
         }
 
       /* Perform the write using:
        *
-       *   u.aioc_filep - File structure pointer
-       *   aio_buf      - Location of buffer
-       *   aio_nbytes   - Length of transfer
-       *   aio_offset   - File offset
+       *   run.ptr    - File structure pointer
+       *   aio_buf    - Location of buffer
+       *   run.nbytes - Length of transfer
+       *   aio_offset - File offset
        */
 
       /* Check if O_APPEND is set in the file open flags */
@@ -126,16 +123,13 @@ static void aio_write_worker(FAR void *arg)
         {
           /* Append to the current file position */
 
-          nwritten = file_write(aioc->u.aioc_filep,
-                                (FAR const void *)aiocbp->aio_buf,
-                                aiocbp->aio_nbytes);
+          nwritten = file_write(filep, (FAR const void *)aiocbp->aio_buf,
+                                run.nbytes);
         }
       else
         {
-          nwritten = file_pwrite(aioc->u.aioc_filep,
-                                 (FAR const void *)aiocbp->aio_buf,
-                                 aiocbp->aio_nbytes,
-                                 aiocbp->aio_offset);
+          nwritten = file_pwrite(filep, (FAR const void *)aiocbp->aio_buf,
+                                 run.nbytes, aiocbp->aio_offset);
         }
     }
 #endif
@@ -146,12 +140,12 @@ static void aio_write_worker(FAR void *arg)
     {
       /* Perform the send using:
        *
-       *   u.aioc_psock - Socket structure pointer
-       *   aio_buf      - Location of buffer
-       *   aio_nbytes   - Length of transfer
+       *   run.ptr    - Socket structure pointer
+       *   aio_buf    - Location of buffer
+       *   aio_nbytes - Length of transfer
        */
 
-      nwritten = psock_send(aioc->u.aioc_psock,
+      nwritten = psock_send((FAR struct socket *)run.ptr,
                             (FAR const void *)aiocbp->aio_buf,
                             aiocbp->aio_nbytes, 0);
     }
@@ -162,23 +156,13 @@ static void aio_write_worker(FAR void *arg)
       ferr("ERROR: write/pwrite/send failed: %d\n", nwritten);
     }
 
-  /* Save the result of the write */
-
-  aiocbp->aio_result = nwritten;
-
 #ifdef AIO_HAVE_FILEP
 errout:
 #endif
 
-  /* Signal the client */
-
-  (void)aio_signal(pid, aiocbp);
+  /* Set the results and signal the clients */
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
+  aio_signalrun(&run, nwritten);
 }
 
 /****************************************************************************
@@ -191,4 +191,63 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc)
   return aiocbp;
 }
 
+/****************************************************************************
+ * Name: aioc_decantrun
+ *
+ * Description:
+ *   Decant the AIO control block from the container like aioc_decant().
+ *   In addition, any requests that are still queued behind it and that can
+ *   be performed in the same transfer are removed from their queue and
+ *   decanted as well.
+ *
+ * Input Parameters:
+ *   aioc - Pointer to the AIO control block container
+ *   run  - Location to return the description of the transfer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aioc_decantrun(FAR struct aio_container_s *aioc,
+                    FAR struct aio_run_s *run)
+{
+#if CONFIG_FS_AIO_NLANES > 0 && AIO_NMERGE > 1
+  FAR struct aio_container_s *next;
+#endif
+
+  DEBUGASSERT(aioc && aioc->aioc_aiocbp && run);
+
+  aio_lock();
+
+  run->ptr       = aioc->u.ptr;
+  run->nbytes    = aioc->aioc_aiocbp->aio_nbytes;
+  run->nreqs     = 1;
+  run->aiocbp[0] = aioc->aioc_aiocbp;
+  run->pid[0]    = aioc->aioc_pid;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  run->prio      = aioc->aioc_prio;
+#endif
+
+#if CONFIG_FS_AIO_NLANES > 0 && AIO_NMERGE > 1
+  /* Collect the adjacent requests while the first one is still contained
+   * and so still identifies the queue and the file.
+   */
+
+  while (run->nreqs < AIO_NMERGE &&
+         (next = aio_merge(aioc, run->aiocbp[run->nreqs - 1])) != NULL)
+    {
+      run->aiocbp[run->nreqs] = next->aioc_aiocbp;
+      run->pid[run->nreqs]    = next->aioc_pid;
+      run->nbytes            += next->aioc_aiocbp->aio_nbytes;
+      run->nreqs++;
+
+      (void)aioc_decant(next);
+    }
+#endif
+
+  (void)aioc_decant(aioc);
+  aio_unlock();
+}
+
 #endif /* CONFIG_FS_AIO */
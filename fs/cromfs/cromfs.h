@@ -43,6 +43,14 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values for the cn_flags field of struct cromfs_node_s */
+
+#define CROMFS_NODE_INDEXED (1 << 0) /* File data is preceded by a block index */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -115,12 +123,19 @@ struct cromfs_volume_s
  *                Return 0
  *   st_ctime   - Time of last status change
  *                Return 0
+ *
+ * If CROMFS_NODE_INDEXED is set in cn_flags for a file node, the compressed
+ * data blocks are preceded by a block index:  An array of uint32_t offsets,
+ * one to each compressed block, that ends at u.cn_blocks.  Every block but
+ * the last then holds cv_bsize bytes of uncompressed data so that the
+ * block containing any file offset can be found without walking the blocks
+ * that precede it.
  */
 
 struct cromfs_node_s
 {
   uint16_t cn_mode;      /* File type, attributes, and access mode bits */
-  uint16_t cn_pad;       /* Not used */
+  uint16_t cn_flags;     /* See CROMFS_NODE_* definitions */
   uint32_t cn_name;      /* Offset from the beginning of the volume header to the
                           * node name string.  NUL-terminated. */
   uint32_t cn_size;      /* Size of the uncompressed data (in bytes) */
@@ -656,6 +656,29 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   nexthdr   = (FAR struct lzf_header_s *)
                cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
 
+  /* If the file has a block index, then start with the block containing the
+   * current offset instead of the first block.
+   */
+
+  if ((ff->ff_node->cn_flags & CROMFS_NODE_INDEXED) != 0 && fpos > 0)
+    {
+      FAR const uint8_t *index;
+      uint32_t nblocks;
+      uint32_t blkno;
+      uint32_t blkaddr;
+
+      nblocks = (ff->ff_node->cn_size + fs->cv_bsize - 1) / fs->cv_bsize;
+      blkno   = fpos / fs->cv_bsize;
+      index   = (FAR const uint8_t *)nexthdr - nblocks * sizeof(uint32_t);
+
+      /* The index is not necessarily aligned in the image */
+
+      memcpy(&blkaddr, &index[blkno * sizeof(uint32_t)], sizeof(uint32_t));
+
+      nexthdr = (FAR struct lzf_header_s *)cromfs_offset2addr(fs, blkaddr);
+      blkoffs = blkno * fs->cv_bsize;
+    }
+
   /* Look until we find the compressed block containing the start of the
    * requested data.
    */
@@ -751,16 +774,25 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
                 {
                   unsigned int decomplen;
 
+                  /* Not cached.  Decompress directly into the user buffer.
+                   * The cache still holds the other block.
+                   */
+
                   decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
+                  UNUSED(decomplen);
+                  DEBUGASSERT(decomplen >= copysize);
+                }
+              else
+                {
+                  /* The block is in the cache.  Just copy it. */
 
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  DEBUGASSERT(ff->ff_ulen >= copysize);
+                  memcpy(dest, ff->ff_buffer, copysize);
                 }
 
               finfo("voloffs=%lu blkoffs=%lu ulen=%u ff_offset=%u copysize=%u\n",
                     (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
                     ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
             }
           else
             {
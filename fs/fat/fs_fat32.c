@@ -64,6 +64,8 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
 #include <nuttx/fs/dirent.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/drivers/blkcache.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
@@ -75,6 +77,12 @@
 static int     fat_open(FAR struct file *filep, FAR const char *relpath,
                  int oflags, mode_t mode);
 static int     fat_close(FAR struct file *filep);
+#ifndef CONFIG_FAT_FORCE_INDIRECT
+static unsigned int fat_contiguous(FAR struct fat_mountpt_s *fs,
+                 FAR struct fat_file_s *ff, off_t position,
+                 unsigned int nsectors, bool extend,
+                 FAR uint32_t *lastcluster, FAR unsigned int *remaining);
+#endif
 static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
 static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
@@ -82,6 +90,8 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
 static off_t   fat_seek(FAR struct file *filep, off_t offset, int whence);
 static int     fat_ioctl(FAR struct file *filep, int cmd,
                  unsigned long arg);
+static int     fat_mmap(FAR struct fat_mountpt_s *fs,
+                 FAR struct fat_file_s *ff, FAR void **ppv);
 
 static int     fat_sync(FAR struct file *filep);
 static int     fat_dup(FAR const struct file *oldp, FAR struct file *newp);
@@ -162,6 +172,88 @@ const struct mountpt_operations fat_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: fat_contiguous
+ *
+ * Description:
+ *   Determine how many of the next 'nsectors' sectors of the file, starting
+ *   at ff_currentsector, are physically contiguous on the media.  The
+ *   cluster chain is followed beyond the current cluster for as long as
+ *   each next cluster immediately follows the previous one, so that a
+ *   single multi-sector transfer can span several clusters.  If 'extend'
+ *   is true, the chain is extended with new clusters as needed (for
+ *   writes).
+ *
+ *   The file position is not changed.  On return, *lastcluster is the last
+ *   cluster touched by the run and *remaining is the number of sectors
+ *   left in that cluster after the run.
+ *
+ * Returned Value:
+ *   The number of contiguous sectors (at least one, at most 'nsectors').
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_FAT_FORCE_INDIRECT
+static unsigned int fat_contiguous(FAR struct fat_mountpt_s *fs,
+                                   FAR struct fat_file_s *ff, off_t position,
+                                   unsigned int nsectors, bool extend,
+                                   FAR uint32_t *lastcluster,
+                                   FAR unsigned int *remaining)
+{
+  uint32_t cluster = ff->ff_currentcluster;
+  unsigned int run = ff->ff_sectorsincluster;
+  int32_t next;
+
+  while (run < nsectors)
+    {
+      if (extend)
+        {
+          next = fat_extendchain(fs, cluster);
+        }
+      else
+        {
+          next = fat_getcluster(fs, cluster);
+        }
+
+      /* Stop at the end of the chain, on any error (to be reported by the
+       * non-contiguous path), or when the next cluster is elsewhere.
+       */
+
+      if (next != cluster + 1 || next >= fs->fs_nclusters)
+        {
+          break;
+        }
+
+      cluster = next;
+      run    += fs->fs_fatsecperclus;
+    }
+
+#if CONFIG_FAT_NEXTENTS > 0
+  if (cluster != ff->ff_currentcluster)
+    {
+      /* Remember the run for lseek() */
+
+      fat_extentadd(ff, SEC_NSECTORS(fs, position) / fs->fs_fatsecperclus,
+                    ff->ff_currentcluster,
+                    cluster - ff->ff_currentcluster + 1);
+    }
+#endif
+
+  *lastcluster = cluster;
+  if (run > nsectors)
+    {
+      *remaining = run - nsectors;
+      run        = nsectors;
+    }
+  else
+    {
+      *remaining = 0;
+    }
+
+  return run;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_open
  ****************************************************************************/
@@ -198,6 +290,13 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
       goto errout_with_semaphore;
     }
 
+  /* Clusters released by O_TRUNC must not be in use by unlocked reads */
+
+  if ((oflags & O_TRUNC) != 0)
+    {
+      fat_waitreaders(fs);
+    }
+
   /* Initialize the directory info structure */
 
   memset(&dirinfo, 0, sizeof(struct fat_dirinfo_s));
@@ -356,6 +455,10 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
   ff->ff_sectorsincluster = fs->fs_fatsecperclus;
   ff->ff_size             = DIR_GETFILESIZE(direntry);
 
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  nxsem_init(&ff->ff_sem, 0, 1);
+#endif
+
   /* Attach the private date to the struct file instance */
 
   filep->f_priv = ff;
@@ -468,6 +571,9 @@ static int fat_close(FAR struct file *filep)
 
   /* Then free the file structure itself. */
 
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  nxsem_destroy(&ff->ff_sem);
+#endif
   kmm_free(ff);
   filep->f_priv = NULL;
   return ret;
@@ -493,6 +599,8 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
   unsigned int nsectors;
+  unsigned int remaining;
+  uint32_t lastcluster;
   bool force_indirect = false;
 #endif
 
@@ -518,7 +626,7 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
 
   /* Make sure that the mount is still healthy */
 
-  fat_semtake(fs);
+  fat_filetake(fs, ff);
   ret = fat_checkmount(fs);
   if (ret != OK)
     {
@@ -612,14 +720,12 @@ fat_read_restart:
            * buffer without using our tiny read buffer.
            *
            * Limit the number of sectors that we read on this time
-           * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * through the loop to the remaining physically contiguous
+           * sectors, which may extend over several clusters.
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
-            {
-              nsectors = ff->ff_sectorsincluster;
-            }
+          nsectors = fat_contiguous(fs, ff, filep->f_pos, nsectors, false,
+                                    &lastcluster, &remaining);
 
           /* We are not sure of the state of the file buffer so
            * the safest thing to do is just invalidate it
@@ -629,7 +735,19 @@ fat_read_restart:
 
           /* Read all of the sectors directly into user memory */
 
+#ifdef CONFIG_FAT_CONCURRENT_READS
+          /* The sectors to be read are known now and the clusters that
+           * hold them cannot be released until fat_rdend() is called.  So
+           * the volume can be unlocked while the data is transferred; the
+           * file itself remains locked.
+           */
+
+          fat_rdbegin(fs);
+          ret = fat_blkread(fs, userbuffer, ff->ff_currentsector, nsectors);
+          fat_rdend(fs);
+#else
           ret = fat_hwread(fs, userbuffer, ff->ff_currentsector, nsectors);
+#endif
           if (ret < 0)
             {
 #ifdef CONFIG_FAT_DIRECT_RETRY
@@ -652,7 +770,8 @@ fat_read_restart:
               goto errout_with_semaphore;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
+          ff->ff_currentcluster    = lastcluster;
+          ff->ff_sectorsincluster  = remaining;
           ff->ff_currentsector    += nsectors;
           bytesread                = nsectors * fs->fs_hwsectorsize;
         }
@@ -700,11 +819,11 @@ fat_read_restart:
       sectorindex   = filep->f_pos & SEC_NDXMASK(fs);
     }
 
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return readsize;
 
 errout_with_semaphore:
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return ret;
 }
 
@@ -727,6 +846,8 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
   unsigned int nsectors;
+  unsigned int remaining;
+  uint32_t lastcluster;
   bool force_indirect = false;
 #endif
 
@@ -764,7 +885,7 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
 
   /* Make sure that the mount is still healthy */
 
-  fat_semtake(fs);
+  fat_filetake(fs, ff);
   ret = fat_checkmount(fs);
   if (ret != OK)
     {
@@ -871,14 +992,12 @@ fat_write_restart:
            * buffer without using our tiny read buffer.
            *
            * Limit the number of sectors that we write on this time
-           * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * through the loop to the remaining physically contiguous
+           * sectors, extending the cluster chain as necessary.
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
-            {
-              nsectors = ff->ff_sectorsincluster;
-            }
+          nsectors = fat_contiguous(fs, ff, filep->f_pos, nsectors, true,
+                                    &lastcluster, &remaining);
 
           /* We are not sure of the state of the sector cache so the
            * safest thing to do is write back any dirty, cached sector
@@ -912,7 +1031,8 @@ fat_write_restart:
               goto errout_with_semaphore;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
+          ff->ff_currentcluster    = lastcluster;
+          ff->ff_sectorsincluster  = remaining;
           ff->ff_currentsector    += nsectors;
           writesize                = nsectors * fs->fs_hwsectorsize;
           ff->ff_bflags           |= FFBUFF_MODIFIED;
@@ -1007,11 +1127,11 @@ fat_write_restart:
       ff->ff_size = filep->f_pos;
     }
 
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return byteswritten;
 
 errout_with_semaphore:
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return ret;
 }
 
@@ -1027,6 +1147,11 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
   int32_t cluster;
   off_t position;
   unsigned int clustersize;
+#if CONFIG_FAT_NEXTENTS > 0
+  uint32_t runfileclus;
+  uint32_t runcluster;
+  uint32_t runcount;
+#endif
   int ret;
 
   /* Sanity checks */
@@ -1090,7 +1215,7 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Make sure that the mount is still healthy */
 
-  fat_semtake(fs);
+  fat_filetake(fs, ff);
   ret = fat_checkmount(fs);
   if (ret != OK)
     {
@@ -1152,6 +1277,23 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+
+#if CONFIG_FAT_NEXTENTS > 0
+      /* Start from the closest cluster already known from the extent
+       * cache rather than from the beginning of the chain.
+       */
+
+      if (fat_extentlookup(ff, position / clustersize, &runfileclus,
+                           &runcluster))
+        {
+          cluster       = runcluster;
+          filep->f_pos  = (off_t)runfileclus * clustersize;
+          position     -= filep->f_pos;
+        }
+
+      runcount = 0;
+#endif
+
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1159,6 +1301,27 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
            */
 
           ff->ff_currentcluster = cluster;
+
+#if CONFIG_FAT_NEXTENTS > 0
+          /* Track the run of contiguous clusters that is being followed */
+
+          if (runcount > 0 && cluster == runcluster + runcount)
+            {
+              runcount++;
+            }
+          else
+            {
+              if (runcount > 1)
+                {
+                  fat_extentadd(ff, runfileclus, runcluster, runcount);
+                }
+
+              runfileclus = filep->f_pos / clustersize;
+              runcluster  = cluster;
+              runcount    = 1;
+            }
+#endif
+
           if (position < clustersize)
             {
               break;
@@ -1224,6 +1387,13 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
           position     -= clustersize;
         }
 
+#if CONFIG_FAT_NEXTENTS > 0
+      if (runcount > 1)
+        {
+          fat_extentadd(ff, runfileclus, runcluster, runcount);
+        }
+
+#endif
       /* We get here after we have found the sector containing
        * the requested position.
        *
@@ -1258,14 +1428,106 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
       ff->ff_bflags |= FFBUFF_MODIFIED;
     }
 
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return OK;
 
 errout_with_semaphore:
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_mmap
+ *
+ * Description: Return the address of the file data if the block driver
+ *   supports BIOC_XIPBASE and the whole file lies in one run of contiguous
+ *   clusters.
+ *
+ ****************************************************************************/
+
+static int fat_mmap(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
+                    FAR void **ppv)
+{
+  FAR struct inode *inode = fs->fs_blkdriver;
+  FAR uint8_t *xipbase = NULL;
+  off_t clustersize;
+  off_t nclusters;
+  off_t cluster;
+  off_t sector;
+  int ret;
+
+  if (ppv == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* An empty file has no clusters to map */
+
+  if (ff->ff_startcluster < 2 || ff->ff_size == 0 ||
+      inode == NULL || inode->u.i_bops == NULL ||
+      inode->u.i_bops->ioctl == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  ret = inode->u.i_bops->ioctl(inode, BIOC_XIPBASE,
+                               (unsigned long)((uintptr_t)&xipbase));
+  if (ret < 0 || xipbase == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  /* Follow the cluster chain over the length of the file */
+
+  clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+  nclusters   = (ff->ff_size + clustersize - 1) / clustersize;
+  cluster     = ff->ff_startcluster;
+
+  while (--nclusters > 0)
+    {
+      off_t next = fat_getcluster(fs, cluster);
+      if (next != cluster + 1)
+        {
+          return next < 0 ? next : -ENOTTY;
+        }
+
+      cluster = next;
+    }
+
+  /* The media will be accessed directly so any data that is still buffered
+   * must reach it first.
+   */
+
+  ret = fat_ffcacheflush(fs, ff);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#if CONFIG_FAT_NSECTORCACHE > 0
+  ret = fat_cacheflush(fs);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
+  ret = blkcache_flush(fs->fs_blkdriver);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  sector = fat_cluster2sector(fs, ff->ff_startcluster);
+  if (sector < 0)
+    {
+      return sector;
+    }
+
+  *ppv = (FAR void *)(xipbase + sector * fs->fs_hwsectorsize);
+  return OK;
+}
+
 /****************************************************************************
  * Name: fat_ioctl
  ****************************************************************************/
@@ -1306,6 +1568,18 @@ static int fat_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       return ret;
     }
 
+  /* Return the address of the file on the media if the file is stored in
+   * physically contiguous clusters on media that is directly addressable.
+   * This lets mmap() map the file in place rather than copying it into RAM.
+   */
+
+  if (cmd == FIOC_MMAP)
+    {
+      ret = fat_mmap(fs, ff, (FAR void **)((uintptr_t)arg));
+      fat_semgive(fs);
+      return ret;
+    }
+
   /* ioctl calls are just passed through to the contained block driver */
 
   fat_semgive(fs);
@@ -1350,7 +1624,7 @@ static int fat_sync(FAR struct file *filep)
 
   /* Make sure that the mount is still healthy */
 
-  fat_semtake(fs);
+  fat_filetake(fs, ff);
   ret = fat_checkmount(fs);
   if (ret != OK)
     {
@@ -1412,8 +1686,30 @@ static int fat_sync(FAR struct file *filep)
       ret          = fat_updatefsinfo(fs);
     }
 
+#if CONFIG_FAT_NSECTORCACHE > 0
+  /* Write back the sector cache, even if this file was not modified:  Its
+   * directory or FAT sectors may have been modified through another file.
+   */
+
+  if (ret >= 0)
+    {
+      ret = fat_fscacheflush(fs);
+      if (ret >= 0)
+        {
+          ret = fat_cacheflush(fs);
+        }
+    }
+
+#endif
+  /* The same applies to the shared block cache */
+
+  if (ret >= 0)
+    {
+      ret = blkcache_flush(fs->fs_blkdriver);
+    }
+
 errout_with_semaphore:
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return ret;
 }
 
@@ -1458,7 +1754,7 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
 
   /* Check if the mount is still healthy */
 
-  fat_semtake(fs);
+  fat_filetake(fs, oldff);
   ret = fat_checkmount(fs);
   if (ret != OK)
     {
@@ -1514,6 +1810,9 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  nxsem_init(&newff->ff_sem, 0, 1);                        /* Open file lock */
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -1528,7 +1827,7 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_next = fs->fs_head;
   fs->fs_head = newff;
 
-  fat_semgive(fs);
+  fat_filegive(fs, oldff);
   return OK;
 
   /* Error exits -- goto's are nasty things, but they sure can make error
@@ -1539,7 +1838,7 @@ errout_with_struct:
   kmm_free(newff);
 
 errout_with_semaphore:
-  fat_semgive(fs);
+  fat_filegive(fs, oldff);
   return ret;
 }
 
@@ -1736,7 +2035,7 @@ static int fat_truncate(FAR struct file *filep, off_t length)
 
   /* Make sure that the mount is still healthy */
 
-  fat_semtake(fs);
+  fat_filetake(fs, ff);
   ret = fat_checkmount(fs);
   if (ret != OK)
     {
@@ -1751,6 +2050,10 @@ static int fat_truncate(FAR struct file *filep, off_t length)
       goto errout_with_semaphore;
     }
 
+  /* Clusters released by shrinking must not be in use by unlocked reads */
+
+  fat_waitreaders(fs);
+
   /* Are we shrinking the file?  Or extending it? */
 
   oldsize = ff->ff_size;
@@ -1798,6 +2101,12 @@ static int fat_truncate(FAR struct file *filep, off_t length)
           ret = fat_dirshrink(fs, direntry, length);
         }
 
+#if CONFIG_FAT_NEXTENTS > 0
+      /* Part of the cluster chain is gone */
+
+      fat_extentinvalidate(ff);
+#endif
+
       if (ret >= 0)
         {
           /* The truncation has completed without error.  Update the file
@@ -1828,7 +2137,7 @@ static int fat_truncate(FAR struct file *filep, off_t length)
     }
 
 errout_with_semaphore:
-  fat_semgive(fs);
+  fat_filegive(fs, ff);
   return ret;
 }
 
@@ -2097,6 +2406,10 @@ static int fat_bind(FAR struct inode *blkdriver, FAR const void *data,
 
   fs->fs_blkdriver = blkdriver;   /* Save the block driver reference */
   nxsem_init(&fs->fs_sem, 0, 0);  /* Initialize the semaphore that controls access */
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  nxsem_init(&fs->fs_rdsem, 0, 0); /* Wakes threads waiting for unlocked reads */
+  (void)nxsem_setprotocol(&fs->fs_rdsem, SEM_PRIO_NONE);
+#endif
 
   /* Then get information about the FAT32 filesystem on the devices managed
    * by this block driver.
@@ -2106,6 +2419,9 @@ static int fat_bind(FAR struct inode *blkdriver, FAR const void *data,
   if (ret != 0)
     {
       nxsem_destroy(&fs->fs_sem);
+#ifdef CONFIG_FAT_CONCURRENT_READS
+      nxsem_destroy(&fs->fs_rdsem);
+#endif
       kmm_free(fs);
       return ret;
     }
@@ -2136,6 +2452,7 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
   /* Check if there are sill any files opened on the filesystem. */
 
   fat_semtake(fs);
+  fat_waitreaders(fs);
   if (fs->fs_head)
     {
       /* There are open files.  We umount now unless we are forced with the
@@ -2170,6 +2487,26 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+#if CONFIG_FAT_NSECTORCACHE > 0
+  /* Write back any dirty sectors that are still held in the sector cache
+   * and release the cache.
+   */
+
+  (void)fat_cacheflush(fs);
+  fat_cacherelease(fs);
+
+#endif
+  /* The shared block cache must not keep blocks of the driver after its
+   * inode is released below.
+   */
+
+  (void)blkcache_flush(fs->fs_blkdriver);
+  blkcache_invalidate(fs->fs_blkdriver);
+
+#ifdef CONFIG_FAT_FREEBITMAP
+  fat_freemap_release(fs);
+
+#endif
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2203,6 +2540,9 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
     }
 
   nxsem_destroy(&fs->fs_sem);
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  nxsem_destroy(&fs->fs_rdsem);
+#endif
   kmm_free(fs);
   return OK;
 }
@@ -2290,6 +2630,8 @@ static int fat_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   ret = fat_checkmount(fs);
   if (ret == OK)
     {
+      fat_waitreaders(fs);
+
       /* If the file is open, the correct behavior is to remove the file
        * name, but to keep the file cluster chain in place until the last
        * open reference to the file is closed.
@@ -2549,6 +2891,8 @@ int fat_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
   ret = fat_checkmount(fs);
   if (ret == OK)
     {
+      fat_waitreaders(fs);
+
       /* If the directory is open, the correct behavior is to remove the directory
        * name, but to keep the directory cluster chain in place until the last
        * open reference to the directory is closed.
@@ -56,6 +56,25 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_FAT_NSECTORCACHE
+#  define CONFIG_FAT_NSECTORCACHE 0
+#endif
+
+#ifndef CONFIG_FAT_NEXTENTS
+#  define CONFIG_FAT_NEXTENTS 0
+#endif
+
+/* Free cluster bitmap:  One bit per cluster, set if the cluster is in use */
+
+#ifdef CONFIG_FAT_FREEBITMAP
+#  define FAT_FREEMAP_SIZE(fs)    ((((fs)->fs_nclusters + 31) >> 5) * sizeof(uint32_t))
+#  define FAT_FREEMAP_SET(m,c)    ((m)[(c) >> 5] |= (1ul << ((c) & 31)))
+#  define FAT_FREEMAP_CLR(m,c)    ((m)[(c) >> 5] &= ~(1ul << ((c) & 31)))
+#  define FAT_FREEMAP_TEST(m,c)   (((m)[(c) >> 5] & (1ul << ((c) & 31))) != 0)
+#endif
+
 /****************************************************************************
  * These offsets describes the master boot record (MBR).
  *
@@ -867,6 +886,29 @@
  * Public Types
  ****************************************************************************/
 
+/* One entry of the per-volume sector cache */
+
+/* A run of physically contiguous clusters of a file */
+
+#if CONFIG_FAT_NEXTENTS > 0
+struct fat_extent_s
+{
+  uint32_t fe_fileclus;            /* Index of the first cluster in the file */
+  uint32_t fe_cluster;             /* First cluster of the run on the media */
+  uint32_t fe_count;               /* Number of clusters in the run (0: unused) */
+};
+#endif
+
+#if CONFIG_FAT_NSECTORCACHE > 0
+struct fat_cacheent_s
+{
+  off_t    ce_sector;              /* The sector held by this entry */
+  uint32_t ce_stamp;               /* LRU time stamp of the last access */
+  bool     ce_valid;               /* true: The entry holds a sector */
+  bool     ce_dirty;               /* true: Not yet written to the media */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a fat32 filesystem.
@@ -879,6 +921,11 @@ struct fat_mountpt_s
   struct fat_file_s *fs_head;      /* A list to all files opened on this mountpoint */
 
   sem_t    fs_sem;                 /* Used to assume thread-safe access */
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  sem_t    fs_rdsem;               /* Wakes threads waiting in fat_waitreaders() */
+  uint16_t fs_nreaders;            /* Reads transferring data without fs_sem */
+  uint16_t fs_rdwaiters;           /* Threads waiting for fs_nreaders == 0 */
+#endif
   off_t    fs_hwsectorsize;        /* HW: Sector size reported by block driver*/
   off_t    fs_hwnsectors;          /* HW: The number of sectors reported by the hardware */
   off_t    fs_fatbase;             /* Logical block of start of filesystem (past resd sectors) */
@@ -901,6 +948,14 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one sector
                                     * from the device */
+#ifdef CONFIG_FAT_FREEBITMAP
+  uint32_t *fs_freemap;            /* Free cluster bitmap (NULL: not yet built) */
+#endif
+#if CONFIG_FAT_NSECTORCACHE > 0
+  uint8_t *fs_cachebuf;            /* Sector data of the sector cache (NULL: no cache) */
+  uint32_t fs_cachestamp;          /* Sector cache LRU clock */
+  struct fat_cacheent_s fs_cache[CONFIG_FAT_NSECTORCACHE];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -922,6 +977,13 @@ struct fat_file_s
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#ifdef CONFIG_FAT_CONCURRENT_READS
+  sem_t    ff_sem;                 /* Serializes operations on this open file */
+#endif
+#if CONFIG_FAT_NEXTENTS > 0
+  uint8_t  ff_nextextent;          /* Next extent entry to be replaced */
+  struct fat_extent_s ff_extents[CONFIG_FAT_NEXTENTS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1028,6 +1090,23 @@ EXTERN void   fat_putuint32(uint8_t *ptr, uint32_t value32);
 EXTERN void   fat_semtake(struct fat_mountpt_s *fs);
 EXTERN void   fat_semgive(struct fat_mountpt_s *fs);
 
+/* Manage the per-file lock that is held in addition to the per-mount
+ * semaphore by operations on an open file, and the unlocked data transfers
+ * of fat_read().
+ */
+
+#ifdef CONFIG_FAT_CONCURRENT_READS
+EXTERN void   fat_filetake(struct fat_mountpt_s *fs, struct fat_file_s *ff);
+EXTERN void   fat_filegive(struct fat_mountpt_s *fs, struct fat_file_s *ff);
+EXTERN void   fat_rdbegin(struct fat_mountpt_s *fs);
+EXTERN void   fat_rdend(struct fat_mountpt_s *fs);
+EXTERN void   fat_waitreaders(struct fat_mountpt_s *fs);
+#else
+#  define fat_filetake(fs,ff) fat_semtake(fs)
+#  define fat_filegive(fs,ff) fat_semgive(fs)
+#  define fat_waitreaders(fs)
+#endif
+
 /* Get the current time for FAT creation and write times */
 
 EXTERN uint32_t fat_systime2fattime(void);
@@ -1038,12 +1117,35 @@ EXTERN time_t fat_fattime2systime(uint16_t fattime, uint16_t fatdate);
 EXTERN int    fat_mount(struct fat_mountpt_s *fs, bool writeable);
 EXTERN int    fat_checkmount(struct fat_mountpt_s *fs);
 
+/* Free cluster bitmap */
+
+#ifdef CONFIG_FAT_FREEBITMAP
+EXTERN void   fat_freemap_release(struct fat_mountpt_s *fs);
+#endif
+
 /* low-level hardware access */
 
 EXTERN int    fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,
                          off_t sector, unsigned int nsectors);
 EXTERN int    fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer,
                           off_t sector, unsigned int nsectors);
+EXTERN int    fat_blkread(struct fat_mountpt_s *fs, uint8_t *buffer,
+                          off_t sector, unsigned int nsectors);
+EXTERN int    fat_blkwrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                           off_t sector, unsigned int nsectors);
+
+/* Sector cache */
+
+#if CONFIG_FAT_NSECTORCACHE > 0
+EXTERN int    fat_cacheinit(struct fat_mountpt_s *fs);
+EXTERN void   fat_cacherelease(struct fat_mountpt_s *fs);
+EXTERN void   fat_cacheinvalidate(struct fat_mountpt_s *fs);
+EXTERN int    fat_cacheflush(struct fat_mountpt_s *fs);
+EXTERN int    fat_cacheread(struct fat_mountpt_s *fs, uint8_t *buffer,
+                            off_t sector, unsigned int nsectors);
+EXTERN int    fat_cachewrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                             off_t sector, unsigned int nsectors);
+#endif
 
 /* Cluster / cluster chain access helpers */
 
@@ -1092,6 +1194,16 @@ EXTERN int    fat_updatefsinfo(struct fat_mountpt_s *fs);
 EXTERN int    fat_nfreeclusters(struct fat_mountpt_s *fs, off_t *pfreeclusters);
 EXTERN int    fat_currentsector(struct fat_mountpt_s *fs, struct fat_file_s *ff, off_t position);
 
+/* Per-file cluster extent cache */
+
+#if CONFIG_FAT_NEXTENTS > 0
+EXTERN void   fat_extentinvalidate(struct fat_file_s *ff);
+EXTERN void   fat_extentadd(struct fat_file_s *ff, uint32_t fileclus,
+                            uint32_t cluster, uint32_t count);
+EXTERN bool   fat_extentlookup(struct fat_file_s *ff, uint32_t fileclus,
+                               uint32_t *foundclus, uint32_t *cluster);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
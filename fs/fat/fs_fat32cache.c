@@ -0,0 +1,466 @@
+/****************************************************************************
+ * fs/fat/fs_fat32cache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/fat.h>
+
+#include "inode/inode.h"
+#include "fs_fat32.h"
+
+#if CONFIG_FAT_NSECTORCACHE > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The sector data held by cache entry 'n' */
+
+#define FAT_CACHEDATA(fs,n) \
+  (&(fs)->fs_cachebuf[(size_t)(n) * (fs)->fs_hwsectorsize])
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cachetouch
+ *
+ * Description:
+ *   Mark a cache entry as the most recently used.
+ *
+ ****************************************************************************/
+
+static inline void fat_cachetouch(struct fat_mountpt_s *fs, int ndx)
+{
+  fs->fs_cache[ndx].ce_stamp = ++fs->fs_cachestamp;
+}
+
+/****************************************************************************
+ * Name: fat_cachefind
+ *
+ * Description:
+ *   Return the index of the cache entry holding 'sector' or -ENOENT if the
+ *   sector is not cached.
+ *
+ ****************************************************************************/
+
+static int fat_cachefind(struct fat_mountpt_s *fs, off_t sector)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_NSECTORCACHE; i++)
+    {
+      if (fs->fs_cache[i].ce_valid && fs->fs_cache[i].ce_sector == sector)
+        {
+          return i;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: fat_cachewriteback
+ *
+ * Description:
+ *   Write a dirty cache entry to the media.
+ *
+ ****************************************************************************/
+
+static int fat_cachewriteback(struct fat_mountpt_s *fs, int ndx)
+{
+  FAR struct fat_cacheent_s *ce = &fs->fs_cache[ndx];
+  int ret;
+
+  if (ce->ce_valid && ce->ce_dirty)
+    {
+      ret = fat_blkwrite(fs, FAT_CACHEDATA(fs, ndx), ce->ce_sector, 1);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to write back sector %ld: %d\n",
+               (long)ce->ce_sector, ret);
+          return ret;
+        }
+
+      ce->ce_dirty = false;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachevictim
+ *
+ * Description:
+ *   Select a cache entry to (re-)use:  An unused entry if there is one,
+ *   otherwise the least recently used entry.  A dirty victim is written
+ *   back first.
+ *
+ * Returned Value:
+ *   The index of the free entry or a negated errno value if the victim
+ *   could not be written back.
+ *
+ ****************************************************************************/
+
+static int fat_cachevictim(struct fat_mountpt_s *fs)
+{
+  uint32_t maxage = 0;
+  uint32_t age;
+  int victim = 0;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_NSECTORCACHE; i++)
+    {
+      if (!fs->fs_cache[i].ce_valid)
+        {
+          return i;
+        }
+
+      /* The age is computed relative to the current LRU clock so that
+       * wrap-around of the clock does no harm.
+       */
+
+      age = fs->fs_cachestamp - fs->fs_cache[i].ce_stamp;
+      if (age > maxage)
+        {
+          maxage = age;
+          victim = i;
+        }
+    }
+
+  ret = fat_cachewriteback(fs, victim);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  fs->fs_cache[victim].ce_valid = false;
+  return victim;
+}
+
+/****************************************************************************
+ * Name: fat_cacheinsert
+ *
+ * Description:
+ *   Copy one sector into the cache.
+ *
+ * Returned Value:
+ *   The index of the cache entry or a negated errno value if no entry
+ *   could be made available.
+ *
+ ****************************************************************************/
+
+static int fat_cacheinsert(struct fat_mountpt_s *fs, FAR const uint8_t *buffer,
+                           off_t sector)
+{
+  FAR struct fat_cacheent_s *ce;
+  int ndx;
+
+  ndx = fat_cachefind(fs, sector);
+  if (ndx < 0)
+    {
+      ndx = fat_cachevictim(fs);
+      if (ndx < 0)
+        {
+          return ndx;
+        }
+    }
+
+  ce            = &fs->fs_cache[ndx];
+  ce->ce_sector = sector;
+  ce->ce_valid  = true;
+  ce->ce_dirty  = false;
+
+  memcpy(FAT_CACHEDATA(fs, ndx), buffer, fs->fs_hwsectorsize);
+  fat_cachetouch(fs, ndx);
+  return ndx;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cacheinit
+ *
+ * Description:
+ *   Allocate the sector cache of a volume.  Called when the volume is
+ *   mounted, after the hardware sector size is known.
+ *
+ ****************************************************************************/
+
+int fat_cacheinit(struct fat_mountpt_s *fs)
+{
+  memset(fs->fs_cache, 0, sizeof(fs->fs_cache));
+  fs->fs_cachestamp = 0;
+
+  fs->fs_cachebuf = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_NSECTORCACHE * fs->fs_hwsectorsize);
+
+  if (fs->fs_cachebuf == NULL)
+    {
+      fwarn("WARNING: No memory for the sector cache\n");
+      return -ENOMEM;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cacherelease
+ *
+ * Description:
+ *   Free the sector cache of a volume.  Any dirty sectors are discarded;
+ *   fat_cacheflush() must be called first if they are to be kept.
+ *
+ ****************************************************************************/
+
+void fat_cacherelease(struct fat_mountpt_s *fs)
+{
+  if (fs->fs_cachebuf != NULL)
+    {
+      fat_io_free(fs->fs_cachebuf,
+                  CONFIG_FAT_NSECTORCACHE * fs->fs_hwsectorsize);
+      fs->fs_cachebuf = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cacheinvalidate
+ *
+ * Description:
+ *   Discard the content of the sector cache, including any dirty sectors.
+ *   This is used when the media has been removed or changed.
+ *
+ ****************************************************************************/
+
+void fat_cacheinvalidate(struct fat_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_NSECTORCACHE; i++)
+    {
+      fs->fs_cache[i].ce_valid = false;
+      fs->fs_cache[i].ce_dirty = false;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cacheflush
+ *
+ * Description:
+ *   Write all dirty sectors in the sector cache to the media.
+ *
+ * Returned Value:
+ *   OK on success; the first write failure otherwise.  Sectors that could
+ *   not be written remain dirty.
+ *
+ ****************************************************************************/
+
+int fat_cacheflush(struct fat_mountpt_s *fs)
+{
+  int result = OK;
+  int ret;
+  int i;
+
+  if (fs->fs_cachebuf == NULL)
+    {
+      return OK;
+    }
+
+  for (i = 0; i < CONFIG_FAT_NSECTORCACHE; i++)
+    {
+      ret = fat_cachewriteback(fs, i);
+      if (ret < 0 && result == OK)
+        {
+          result = ret;
+        }
+    }
+
+  return result;
+}
+
+/****************************************************************************
+ * Name: fat_cacheread
+ *
+ * Description:
+ *   Read sectors through the sector cache.  Single sector reads are served
+ *   from the cache when possible and are added to the cache otherwise.
+ *   Multi-sector (direct) reads go to the media, but any newer, dirty
+ *   copies of the sectors in the cache are merged into the result.
+ *
+ ****************************************************************************/
+
+int fat_cacheread(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
+                  unsigned int nsectors)
+{
+  FAR struct fat_cacheent_s *ce;
+  int ndx;
+  int ret;
+  int i;
+
+  if (nsectors == 1)
+    {
+      ndx = fat_cachefind(fs, sector);
+      if (ndx >= 0)
+        {
+          memcpy(buffer, FAT_CACHEDATA(fs, ndx), fs->fs_hwsectorsize);
+          fat_cachetouch(fs, ndx);
+          return OK;
+        }
+
+      ret = fat_blkread(fs, buffer, sector, 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Failure to cache the sector is not an error for the read */
+
+      (void)fat_cacheinsert(fs, buffer, sector);
+      return OK;
+    }
+
+  ret = fat_blkread(fs, buffer, sector, nsectors);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < CONFIG_FAT_NSECTORCACHE; i++)
+    {
+      ce = &fs->fs_cache[i];
+      if (ce->ce_valid && ce->ce_dirty && ce->ce_sector >= sector &&
+          ce->ce_sector < sector + nsectors)
+        {
+          memcpy(&buffer[(size_t)(ce->ce_sector - sector) *
+                         fs->fs_hwsectorsize],
+                 FAT_CACHEDATA(fs, i), fs->fs_hwsectorsize);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachewrite
+ *
+ * Description:
+ *   Write sectors through the sector cache.  Single sector writes update
+ *   the cache and, unless CONFIG_FAT_SECTORCACHE_WRBACK is selected, are
+ *   also written to the media.  Multi-sector (direct) writes go to the
+ *   media and update any cached copies of the sectors.
+ *
+ ****************************************************************************/
+
+int fat_cachewrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
+                   unsigned int nsectors)
+{
+  FAR struct fat_cacheent_s *ce;
+  int ndx;
+  int ret;
+  int i;
+
+  if (nsectors == 1)
+    {
+      ndx = fat_cacheinsert(fs, buffer, sector);
+      if (ndx < 0)
+        {
+          /* No entry could be freed.  Write directly to the media. */
+
+          return fat_blkwrite(fs, buffer, sector, 1);
+        }
+
+#ifdef CONFIG_FAT_SECTORCACHE_WRBACK
+      fs->fs_cache[ndx].ce_dirty = true;
+      return OK;
+#else
+      ret = fat_blkwrite(fs, buffer, sector, 1);
+      if (ret < 0)
+        {
+          fs->fs_cache[ndx].ce_valid = false;
+        }
+
+      return ret;
+#endif
+    }
+
+  ret = fat_blkwrite(fs, buffer, sector, nsectors);
+
+  for (i = 0; i < CONFIG_FAT_NSECTORCACHE; i++)
+    {
+      ce = &fs->fs_cache[i];
+      if (ce->ce_valid && ce->ce_sector >= sector &&
+          ce->ce_sector < sector + nsectors)
+        {
+          if (ret >= 0)
+            {
+              /* The media now holds the newest copy */
+
+              memcpy(FAT_CACHEDATA(fs, i),
+                     &buffer[(size_t)(ce->ce_sector - sector) *
+                             fs->fs_hwsectorsize],
+                     fs->fs_hwsectorsize);
+              ce->ce_dirty = false;
+            }
+          else if (!ce->ce_dirty)
+            {
+              /* The media content of the sector is now unknown */
+
+              ce->ce_valid = false;
+            }
+        }
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_FAT_NSECTORCACHE > 0 */
@@ -60,6 +60,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
+#include <nuttx/drivers/blkcache.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
@@ -275,6 +276,274 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_freemap_build
+ *
+ * Description:
+ *   Allocate the free cluster bitmap and fill it by scanning the whole FAT
+ *   once.  The exact number of free clusters is a by-product of the scan
+ *   and replaces the (possibly unknown or stale) FSINFO free count.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREEBITMAP
+static int fat_freemap_build(struct fat_mountpt_s *fs)
+{
+  FAR uint32_t *freemap;
+  uint32_t nfreeclusters;
+  uint32_t cluster;
+  off_t    next;
+
+  freemap = (FAR uint32_t *)kmm_zalloc(FAT_FREEMAP_SIZE(fs));
+  if (freemap == NULL)
+    {
+      fwarn("WARNING: No memory for the free cluster bitmap\n");
+      return -ENOMEM;
+    }
+
+  /* Clusters 0 and 1 are reserved */
+
+  freemap[0]    = 3;
+  nfreeclusters = 0;
+
+  if (fs->fs_type == FSTYPE_FAT12)
+    {
+      for (cluster = 2; cluster < fs->fs_nclusters; cluster++)
+        {
+          next = fat_getcluster(fs, cluster);
+          if (next < 0)
+            {
+              kmm_free(freemap);
+              return (int)next;
+            }
+
+          if (next == 0)
+            {
+              nfreeclusters++;
+            }
+          else
+            {
+              FAT_FREEMAP_SET(freemap, cluster);
+            }
+        }
+    }
+  else
+    {
+      off_t        fatsector = fs->fs_fatbase;
+      unsigned int offset    = fs->fs_hwsectorsize;
+      int          ret;
+
+      /* FAT16 and FAT32 entries never straddle sectors, so the FAT can be
+       * read one sector at a time.
+       */
+
+      for (cluster = 0; cluster < fs->fs_nclusters; cluster++)
+        {
+          if (offset >= fs->fs_hwsectorsize)
+            {
+              ret = fat_fscacheread(fs, fatsector++);
+              if (ret < 0)
+                {
+                  kmm_free(freemap);
+                  return ret;
+                }
+
+              offset = 0;
+            }
+
+          if (fs->fs_type == FSTYPE_FAT16)
+            {
+              next    = FAT_GETFAT16(fs->fs_buffer, offset);
+              offset += 2;
+            }
+          else
+            {
+              next    = FAT_GETFAT32(fs->fs_buffer, offset) & 0x0fffffff;
+              offset += 4;
+            }
+
+          if (cluster < 2)
+            {
+              continue;
+            }
+
+          if (next == 0)
+            {
+              nfreeclusters++;
+            }
+          else
+            {
+              FAT_FREEMAP_SET(freemap, cluster);
+            }
+        }
+    }
+
+  fs->fs_freemap = freemap;
+
+  if (fs->fs_fsifreecount != nfreeclusters)
+    {
+      fs->fs_fsifreecount = nfreeclusters;
+      if (fs->fs_type == FSTYPE_FAT32)
+        {
+          fs->fs_fsidirty = true;
+        }
+    }
+
+  finfo("Free cluster bitmap: %lu free clusters\n",
+        (unsigned long)nfreeclusters);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_freemap_find
+ *
+ * Description:
+ *   Find the first free cluster after 'startcluster' in the bitmap,
+ *   wrapping around to cluster 2.  Whole words of in-use clusters are
+ *   skipped at once.
+ *
+ * Returned Value:
+ *   0: no free cluster, >=2: free cluster number
+ *
+ ****************************************************************************/
+
+static int32_t fat_freemap_find(struct fat_mountpt_s *fs,
+                                uint32_t startcluster)
+{
+  FAR uint32_t *freemap = fs->fs_freemap;
+  uint32_t cluster;
+  uint32_t end;
+  int pass;
+
+  cluster = startcluster + 1;
+  end     = fs->fs_nclusters;
+
+  for (pass = 0; pass < 2; pass++)
+    {
+      while (cluster < end)
+        {
+          if ((cluster & 31) == 0 && freemap[cluster >> 5] == 0xffffffff)
+            {
+              cluster += 32;
+              continue;
+            }
+
+          if (!FAT_FREEMAP_TEST(freemap, cluster))
+            {
+              return (int32_t)cluster;
+            }
+
+          cluster++;
+        }
+
+      /* Wrap around and search up to the start cluster */
+
+      cluster = 2;
+      end     = startcluster + 1;
+      if (end > fs->fs_nclusters)
+        {
+          end = fs->fs_nclusters;
+        }
+    }
+
+  return 0;
+}
+#endif /* CONFIG_FAT_FREEBITMAP */
+
+/****************************************************************************
+ * Name: fat_findfreecluster
+ *
+ * Description:
+ *   Find the first free cluster after 'startcluster', wrapping around to
+ *   the beginning of the FAT.
+ *
+ * Returned Value:
+ *   <0:error, 0: no free cluster, >=2: free cluster number
+ *
+ ****************************************************************************/
+
+static int32_t fat_findfreecluster(struct fat_mountpt_s *fs,
+                                   uint32_t startcluster)
+{
+  uint32_t newcluster;
+  off_t    startsector;
+
+#ifdef CONFIG_FAT_FREEBITMAP
+  /* Build the free cluster bitmap the first time that a cluster is
+   * allocated.  If there is not enough memory for it, fall back to
+   * scanning the FAT.
+   */
+
+  if (fs->fs_freemap == NULL)
+    {
+      (void)fat_freemap_build(fs);
+    }
+
+  if (fs->fs_freemap != NULL)
+    {
+      return fat_freemap_find(fs, startcluster);
+    }
+
+#endif
+  /* Loop until (1) we discover that there are not free clusters
+   * (return 0), an errors occurs (return -errno), or (3) we find
+   * the next cluster (return the new cluster number).
+   */
+
+  newcluster = startcluster;
+  for (; ; )
+    {
+      /* Examine the next cluster in the FAT */
+
+      newcluster++;
+      if (newcluster >= fs->fs_nclusters)
+        {
+          /* If we hit the end of the available clusters, then
+           * wrap back to the beginning because we might have
+           * started at a non-optimal place.  But don't continue
+           * past the start cluster.
+           */
+
+          newcluster = 2;
+          if (newcluster > startcluster)
+            {
+              /* We are back past the starting cluster, then there
+               * is no free cluster.
+               */
+
+              return 0;
+            }
+        }
+
+      /* We have a candidate cluster.  Check if the cluster number is
+       * mapped to a group of sectors.
+       */
+
+      startsector = fat_getcluster(fs, newcluster);
+      if (startsector == 0)
+        {
+          /* Found have found a free cluster */
+
+          return newcluster;
+        }
+      else if (startsector < 0)
+        {
+          /* Some error occurred, return the error number */
+
+          return startsector;
+        }
+
+      /* We wrap all the back to the starting cluster?  If so, then
+       * there are no free clusters.
+       */
+
+      if (newcluster == startcluster)
+        {
+          return 0;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -391,6 +660,103 @@ void fat_semgive(struct fat_mountpt_s *fs)
    nxsem_post(&fs->fs_sem);
 }
 
+/****************************************************************************
+ * Name: fat_filetake
+ *
+ * Description:
+ *   Lock an open file and then the volume.  The file lock is retained
+ *   while fat_read() releases the volume to transfer data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_CONCURRENT_READS
+void fat_filetake(struct fat_mountpt_s *fs, struct fat_file_s *ff)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(&ff->ff_sem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+
+  fat_semtake(fs);
+}
+
+/****************************************************************************
+ * Name: fat_filegive
+ ****************************************************************************/
+
+void fat_filegive(struct fat_mountpt_s *fs, struct fat_file_s *ff)
+{
+  fat_semgive(fs);
+  nxsem_post(&ff->ff_sem);
+}
+
+/****************************************************************************
+ * Name: fat_rdbegin
+ *
+ * Description:
+ *   Called with the volume locked before the sectors of a read are
+ *   transferred.  Registers the transfer and unlocks the volume.
+ *
+ ****************************************************************************/
+
+void fat_rdbegin(struct fat_mountpt_s *fs)
+{
+  fs->fs_nreaders++;
+  fat_semgive(fs);
+}
+
+/****************************************************************************
+ * Name: fat_rdend
+ *
+ * Description:
+ *   Called after the transfer started by fat_rdbegin().  Locks the volume
+ *   again and wakes up any thread that waits for the transfers to finish.
+ *
+ ****************************************************************************/
+
+void fat_rdend(struct fat_mountpt_s *fs)
+{
+  fat_semtake(fs);
+
+  DEBUGASSERT(fs->fs_nreaders > 0);
+  if (--fs->fs_nreaders == 0)
+    {
+      while (fs->fs_rdwaiters > 0)
+        {
+          fs->fs_rdwaiters--;
+          nxsem_post(&fs->fs_rdsem);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_waitreaders
+ *
+ * Description:
+ *   Called with the volume locked.  Waits until no read is transferring
+ *   data without the volume lock.  This must precede anything that could
+ *   hand the sectors of such a read to another file.
+ *
+ ****************************************************************************/
+
+void fat_waitreaders(struct fat_mountpt_s *fs)
+{
+  while (fs->fs_nreaders > 0)
+    {
+      fs->fs_rdwaiters++;
+      fat_semgive(fs);
+
+      while (nxsem_wait(&fs->fs_rdsem) == -EINTR);
+
+      fat_semtake(fs);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: fat_systime2fattime
  *
@@ -660,6 +1026,14 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       }
   }
 
+#if CONFIG_FAT_NSECTORCACHE > 0
+  /* Allocate the sector cache.  The volume is still usable (but slower)
+   * without it.
+   */
+
+  (void)fat_cacheinit(fs);
+
+#endif
   /* We did it! */
 
   finfo("FAT%d:\n", fs->fs_type == 0 ? 12 : fs->fs_type == 1  ? 16 : 32);
@@ -729,11 +1103,41 @@ int fat_checkmount(struct fat_mountpt_s *fs)
       /* If we get here, the mount is NOT healthy */
 
       fs->fs_mounted = false;
+
+#if CONFIG_FAT_NSECTORCACHE > 0
+      /* Whatever is in the sector cache belongs to the old media */
+
+      fat_cacheinvalidate(fs);
+#endif
+      blkcache_invalidate(fs->fs_blkdriver);
+#ifdef CONFIG_FAT_FREEBITMAP
+      fat_freemap_release(fs);
+#endif
     }
 
   return -ENODEV;
 }
 
+/****************************************************************************
+ * Name: fat_freemap_release
+ *
+ * Description:
+ *   Free the free cluster bitmap.  It will be rebuilt from the FAT the next
+ *   time that it is needed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREEBITMAP
+void fat_freemap_release(struct fat_mountpt_s *fs)
+{
+  if (fs->fs_freemap != NULL)
+    {
+      kmm_free(fs->fs_freemap);
+      fs->fs_freemap = NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: fat_hwread
  *
@@ -744,8 +1148,61 @@ int fat_checkmount(struct fat_mountpt_s *fs)
 
 int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
                unsigned int nsectors)
+{
+#if CONFIG_FAT_NSECTORCACHE > 0
+  if (fs && fs->fs_cachebuf)
+    {
+      return fat_cacheread(fs, buffer, sector, nsectors);
+    }
+#endif
+
+  return fat_blkread(fs, buffer, sector, nsectors);
+}
+
+/****************************************************************************
+ * Name: fat_hwwrite
+ *
+ * Description:
+ *   Write the sector buffer to the specified sector
+ *
+ ****************************************************************************/
+
+int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
+                unsigned int nsectors)
+{
+#if CONFIG_FAT_NSECTORCACHE > 0
+  if (fs && fs->fs_cachebuf)
+    {
+      return fat_cachewrite(fs, buffer, sector, nsectors);
+    }
+#endif
+
+  return fat_blkwrite(fs, buffer, sector, nsectors);
+}
+
+/****************************************************************************
+ * Name: fat_blkread
+ *
+ * Description:
+ *   Read the specified sectors directly from the block driver, bypassing
+ *   the sector cache.  With CONFIG_DRVR_BLKCACHE the access still goes
+ *   through the shared block cache.
+ *
+ ****************************************************************************/
+
+int fat_blkread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
+                unsigned int nsectors)
 {
   int ret = -ENODEV;
+
+#ifdef CONFIG_DRVR_BLKCACHE
+  if (fs && fs->fs_blkdriver)
+    {
+      return blkcache_read(fs->fs_blkdriver, buffer, sector, nsectors,
+                           fs->fs_hwsectorsize);
+    }
+
+#endif
   if (fs && fs->fs_blkdriver)
     {
       struct inode *inode = fs->fs_blkdriver;
@@ -768,17 +1225,28 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
 }
 
 /****************************************************************************
- * Name: fat_hwwrite
+ * Name: fat_blkwrite
  *
  * Description:
- *   Write the sector buffer to the specified sector
+ *   Write the specified sectors directly to the block driver, bypassing the
+ *   sector cache.  With CONFIG_DRVR_BLKCACHE the access still goes through
+ *   the shared block cache.
  *
  ****************************************************************************/
 
-int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
-                unsigned int nsectors)
+int fat_blkwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
+                 unsigned int nsectors)
 {
   int ret = -ENODEV;
+
+#ifdef CONFIG_DRVR_BLKCACHE
+  if (fs && fs->fs_blkdriver)
+    {
+      return blkcache_write(fs->fs_blkdriver, buffer, sector, nsectors,
+                            fs->fs_hwsectorsize);
+    }
+
+#endif
   if (fs && fs->fs_blkdriver)
     {
       struct inode *inode = fs->fs_blkdriver;
@@ -1107,6 +1575,22 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
             return -EINVAL;
         }
 
+#ifdef CONFIG_FAT_FREEBITMAP
+      /* Keep the free cluster bitmap in step with the FAT */
+
+      if (fs->fs_freemap != NULL && clusterno >= 2)
+        {
+          if (nextcluster == 0)
+            {
+              FAT_FREEMAP_CLR(fs->fs_freemap, clusterno);
+            }
+          else
+            {
+              FAT_FREEMAP_SET(fs->fs_freemap, clusterno);
+            }
+        }
+
+#endif
       /* Mark the modified sector as "dirty" and return success */
 
       fs->fs_dirty = true;
@@ -1122,6 +1606,9 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
  * Description:
  *   Remove an entire chain of clusters, starting with 'cluster'
  *
+ *   With CONFIG_FAT_CONCURRENT_READS, the caller must have called
+ *   fat_waitreaders() before looking up the chain.
+ *
  ****************************************************************************/
 
 int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
@@ -1233,66 +1720,20 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
-  /* Loop until (1) we discover that there are not free clusters
-   * (return 0), an errors occurs (return -errno), or (3) we find
-   * the next cluster (return the new cluster number).
-   */
+  /* Find a free cluster following the start cluster */
 
-  newcluster = startcluster;
-  for (; ; )
+  ret = fat_findfreecluster(fs, startcluster);
+  if (ret <= 0)
     {
-      /* Examine the next cluster in the FAT */
-
-      newcluster++;
-      if (newcluster >= fs->fs_nclusters)
-        {
-          /* If we hit the end of the available clusters, then
-           * wrap back to the beginning because we might have
-           * started at a non-optimal place.  But don't continue
-           * past the start cluster.
-           */
-
-          newcluster = 2;
-          if (newcluster > startcluster)
-            {
-              /* We are back past the starting cluster, then there
-               * is no free cluster.
-               */
-
-              return 0;
-            }
-        }
+      /* No free cluster (0) or an error (-errno) */
 
-      /* We have a candidate cluster.  Check if the cluster number is
-       * mapped to a group of sectors.
-       */
-
-      startsector = fat_getcluster(fs, newcluster);
-      if (startsector == 0)
-        {
-          /* Found have found a free cluster break out */
-
-          break;
-        }
-      else if (startsector < 0)
-        {
-          /* Some error occurred, return the error number */
-
-          return startsector;
-        }
-
-      /* We wrap all the back to the starting cluster?  If so, then
-       * there are no free clusters.
-       */
-
-      if (newcluster == startcluster)
-        {
-          return 0;
-        }
+      return ret;
     }
 
-  /* We get here only if we break out with an available cluster
-   * number in 'newcluster'  Now mark that cluster as in-use.
+  newcluster = (uint32_t)ret;
+
+  /* We get here only if we found an available cluster number in
+   * 'newcluster'  Now mark that cluster as in-use.
    */
 
   ret = fat_putcluster(fs, newcluster, 0x0fffffff);
@@ -1551,11 +1992,11 @@ int fat_dirshrink(struct fat_mountpt_s *fs, FAR uint8_t *direntry,
 
       if (remaining <= clustersize)
         {
-          /* No.. then nullify next cluster -- removing it from the
-           * chain.
+          /* No.. then terminate the chain at the last cluster that is
+           * kept.
            */
 
-          ret = fat_putcluster(fs, lastcluster, 0);
+          ret = fat_putcluster(fs, lastcluster, 0x0fffffff);
           if (ret < 0)
             {
               return ret;
@@ -2041,6 +2482,15 @@ int fat_nfreeclusters(struct fat_mountpt_s *fs, off_t *pfreeclusters)
 {
   uint32_t nfreeclusters;
 
+#ifdef CONFIG_FAT_FREEBITMAP
+  /* Building the free cluster bitmap also counts the free clusters */
+
+  if (fs->fs_freemap == NULL)
+    {
+      (void)fat_freemap_build(fs);
+    }
+
+#endif
   /* If number of the first free cluster is valid, then just return that value. */
 
   if (fs->fs_fsifreecount <= fs->fs_nclusters - 2)
@@ -2093,12 +2543,11 @@ int fat_nfreeclusters(struct fat_mountpt_s *fs, off_t *pfreeclusters)
                   return ret;
                 }
 
-              /* Reset the offset to the next FAT entry.
-               * Increment the sector number to read next time around.
+              /* Reset the offset to the next FAT entry.  The sector number
+               * to read next time around has already been incremented.
                */
 
               offset = 0;
-              fatsector++;
             }
 
           /* FAT16 and FAT32 differ only on the size of each cluster start
@@ -2177,3 +2626,120 @@ int fat_currentsector(struct fat_mountpt_s *fs, struct fat_file_s *ff,
 
   return -ENOSPC;
 }
+
+/****************************************************************************
+ * Name: fat_extentinvalidate
+ *
+ * Description:
+ *   Forget all cached cluster extents of a file.  This must be called
+ *   whenever the cluster chain of the file is shortened.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FAT_NEXTENTS > 0
+void fat_extentinvalidate(struct fat_file_s *ff)
+{
+  memset(ff->ff_extents, 0, sizeof(ff->ff_extents));
+  ff->ff_nextextent = 0;
+}
+
+/****************************************************************************
+ * Name: fat_extentadd
+ *
+ * Description:
+ *   Remember that the 'count' clusters of the file starting at cluster
+ *   index 'fileclus' are the physically contiguous clusters starting at
+ *   'cluster'.  An extent that is a prefix of the new one is grown in
+ *   place; otherwise the oldest entry is replaced.
+ *
+ ****************************************************************************/
+
+void fat_extentadd(struct fat_file_s *ff, uint32_t fileclus,
+                   uint32_t cluster, uint32_t count)
+{
+  FAR struct fat_extent_s *fe;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_NEXTENTS; i++)
+    {
+      fe = &ff->ff_extents[i];
+      if (fe->fe_count > 0 && fe->fe_fileclus <= fileclus &&
+          fileclus <= fe->fe_fileclus + fe->fe_count &&
+          cluster - fe->fe_cluster == fileclus - fe->fe_fileclus)
+        {
+          /* The new run continues (or overlaps) this extent */
+
+          if (fileclus + count > fe->fe_fileclus + fe->fe_count)
+            {
+              fe->fe_count = fileclus + count - fe->fe_fileclus;
+            }
+
+          return;
+        }
+    }
+
+  fe              = &ff->ff_extents[ff->ff_nextextent];
+  fe->fe_fileclus = fileclus;
+  fe->fe_cluster  = cluster;
+  fe->fe_count    = count;
+
+  if (++ff->ff_nextextent >= CONFIG_FAT_NEXTENTS)
+    {
+      ff->ff_nextextent = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_extentlookup
+ *
+ * Description:
+ *   Find the cached cluster closest to (but not after) the cluster with
+ *   index 'fileclus' in the file.
+ *
+ * Returned Value:
+ *   true if an extent was found.  In that case, *foundclus is the index of
+ *   the returned cluster in the file (fileclus if that cluster lies in a
+ *   cached extent) and *cluster is its number on the media.
+ *
+ ****************************************************************************/
+
+bool fat_extentlookup(struct fat_file_s *ff, uint32_t fileclus,
+                      uint32_t *foundclus, uint32_t *cluster)
+{
+  FAR struct fat_extent_s *best = NULL;
+  FAR struct fat_extent_s *fe;
+  uint32_t bestreach = 0;
+  uint32_t reach;
+  int i;
+
+  /* Find the extent that gets closest to 'fileclus' */
+
+  for (i = 0; i < CONFIG_FAT_NEXTENTS; i++)
+    {
+      fe = &ff->ff_extents[i];
+      if (fe->fe_count > 0 && fe->fe_fileclus <= fileclus)
+        {
+          reach = fe->fe_fileclus + fe->fe_count - 1;
+          if (reach > fileclus)
+            {
+              reach = fileclus;
+            }
+
+          if (best == NULL || reach > bestreach)
+            {
+              best      = fe;
+              bestreach = reach;
+            }
+        }
+    }
+
+  if (best == NULL)
+    {
+      return false;
+    }
+
+  *foundclus = bestreach;
+  *cluster   = best->fe_cluster + (bestreach - best->fe_fileclus);
+  return true;
+}
+#endif /* CONFIG_FAT_NEXTENTS > 0 */
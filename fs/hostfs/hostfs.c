@@ -53,6 +53,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/clock.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
 #include <nuttx/fs/dirent.h>
@@ -261,6 +262,95 @@ static void hostfs_mkpath(FAR struct hostfs_mountpt_s  *fs,
     }
 }
 
+/****************************************************************************
+ * Name: hostfs_attrflush
+ *
+ * Description: Discard all cached file attributes.  Called whenever
+ *   anything on the mountpoint may have been changed by hostfs.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_HOSTFS_NATTRCACHE > 0
+static void hostfs_attrflush(FAR struct hostfs_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_NATTRCACHE; i++)
+    {
+      fs->fs_attr[i].path[0] = '\0';
+    }
+}
+#else
+#  define hostfs_attrflush(fs)
+#endif
+
+/****************************************************************************
+ * Name: hostfs_raread
+ *
+ * Description: Read from a file opened read-only through its read-ahead
+ *   buffer.  At most one host read is performed per call.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_HOSTFS_RABUFSIZE > 0
+static ssize_t hostfs_raread(FAR struct hostfs_ofile_s *hf,
+                             FAR char *buffer, size_t buflen)
+{
+  size_t nread = 0;
+  size_t ncopy;
+  ssize_t ret;
+
+  /* First return whatever is already buffered */
+
+  ncopy = MIN((size_t)(hf->ralen - hf->raoff), buflen);
+  if (ncopy > 0)
+    {
+      memcpy(buffer, &hf->rabuf[hf->raoff], ncopy);
+      hf->raoff += ncopy;
+      nread     += ncopy;
+    }
+
+  if (nread >= buflen)
+    {
+      return nread;
+    }
+
+  /* The buffer is now empty.  Large requests bypass it and go directly to
+   * the host.
+   */
+
+  if (buflen - nread >= CONFIG_FS_HOSTFS_RABUFSIZE)
+    {
+      ret = host_read(hf->fd, &buffer[nread], buflen - nread);
+      if (ret < 0)
+        {
+          return nread > 0 ? (ssize_t)nread : ret;
+        }
+
+      return nread + ret;
+    }
+
+  /* Otherwise refill the buffer with one host read */
+
+  hf->ralen = 0;
+  hf->raoff = 0;
+
+  ret = host_read(hf->fd, hf->rabuf, CONFIG_FS_HOSTFS_RABUFSIZE);
+  if (ret <= 0)
+    {
+      return nread > 0 ? (ssize_t)nread : ret;
+    }
+
+  hf->ralen = ret;
+
+  ncopy = MIN((size_t)ret, buflen - nread);
+  memcpy(&buffer[nread], hf->rabuf, ncopy);
+  hf->raoff = ncopy;
+
+  return nread + ncopy;
+}
+#endif
+
 /****************************************************************************
  * Name: hostfs_open
  ****************************************************************************/
@@ -333,6 +423,28 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
         }
     }
 
+#if CONFIG_FS_HOSTFS_RABUFSIZE > 0
+  /* Files that are only read use a read-ahead buffer.  Failure to allocate
+   * it is not an error, the file is then just read unbuffered.
+   */
+
+  hf->ralen = 0;
+  hf->raoff = 0;
+  hf->rabuf = NULL;
+
+  if ((oflags & O_WROK) == 0)
+    {
+      hf->rabuf = (FAR uint8_t *)kmm_malloc(CONFIG_FS_HOSTFS_RABUFSIZE);
+    }
+#endif
+
+  /* Opening for write may create or truncate the file */
+
+  if ((oflags & (O_WROK | O_CREAT | O_TRUNC)) != 0)
+    {
+      hostfs_attrflush(fs);
+    }
+
   /* Attach the private date to the struct file instance */
 
   filep->f_priv = hf;
@@ -439,6 +551,13 @@ static int hostfs_close(FAR struct file *filep)
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#if CONFIG_FS_HOSTFS_RABUFSIZE > 0
+  if (hf->rabuf != NULL)
+    {
+      kmm_free(hf->rabuf);
+    }
+#endif
+
   kmm_free(hf);
 
 okout:
@@ -476,7 +595,17 @@ static ssize_t hostfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
-  ret = host_read(hf->fd, buffer, buflen);
+#if CONFIG_FS_HOSTFS_RABUFSIZE > 0
+  if (hf->rabuf != NULL)
+    {
+      ret = hostfs_raread(hf, buffer, buflen);
+    }
+  else
+#endif
+    {
+      ret = host_read(hf->fd, buffer, buflen);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -538,6 +667,7 @@ static ssize_t hostfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
+  hostfs_attrflush(fs);
   ret = host_write(hf->fd, buffer, buflen);
   if (ret > 0)
     {
@@ -576,6 +706,24 @@ static off_t hostfs_seek(FAR struct file *filep, off_t offset, int whence)
 
   hostfs_semtake(fs);
 
+#if CONFIG_FS_HOSTFS_RABUFSIZE > 0
+  /* The host file position is ahead of f_pos by whatever is still buffered.
+   * Make relative seeks absolute and discard the buffer.
+   */
+
+  if (hf->rabuf != NULL)
+    {
+      if (whence == SEEK_CUR)
+        {
+          offset += filep->f_pos;
+          whence  = SEEK_SET;
+        }
+
+      hf->ralen = 0;
+      hf->raoff = 0;
+    }
+#endif
+
   /* Call our internal routine to perform the seek */
 
   ret = host_lseek(hf->fd, offset, whence);
@@ -766,6 +914,7 @@ static int hostfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
+  hostfs_attrflush(fs);
   ret = host_ftruncate(hf->fd, length);
 
   hostfs_semgive(fs);
@@ -1112,6 +1261,7 @@ static int hostfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host fs to perform the unlink */
 
+  hostfs_attrflush(fs);
   ret = host_unlink(path);
 
   hostfs_semgive(fs);
@@ -1148,6 +1298,7 @@ static int hostfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_attrflush(fs);
   ret = host_mkdir(path, mode);
 
   hostfs_semgive(fs);
@@ -1185,6 +1336,7 @@ int hostfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_attrflush(fs);
   ret = host_rmdir(path);
 
   hostfs_semgive(fs);
@@ -1225,6 +1377,7 @@ int hostfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_attrflush(fs);
   ret = host_rename(oldpath, newpath);
 
   hostfs_semgive(fs);
@@ -1242,6 +1395,11 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
                        FAR struct stat *buf)
 {
   FAR struct hostfs_mountpt_s *fs;
+#if CONFIG_FS_HOSTFS_NATTRCACHE > 0
+  FAR struct hostfs_attr_s *attr;
+  clock_t now;
+  int i;
+#endif
   char path[HOSTFS_MAX_PATH];
   int ret;
 
@@ -1259,10 +1417,44 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   hostfs_mkpath(fs, relpath, path, sizeof(path));
 
+#if CONFIG_FS_HOSTFS_NATTRCACHE > 0
+  /* Check for an unexpired cached result first */
+
+  now = clock_systimer();
+  for (i = 0; i < CONFIG_FS_HOSTFS_NATTRCACHE; i++)
+    {
+      attr = &fs->fs_attr[i];
+      if (attr->path[0] != '\0' && (int32_t)(attr->expire - now) > 0 &&
+          strcmp(attr->path, path) == 0)
+        {
+          memcpy(buf, &attr->buf, sizeof(struct stat));
+          ret = attr->ret;
+          goto errout_with_semaphore;
+        }
+    }
+#endif
+
   /* Call the host FS to do the stat operation */
 
   ret = host_stat(path, buf);
 
+#if CONFIG_FS_HOSTFS_NATTRCACHE > 0
+  /* Remember the result, replacing the entries in round-robin order */
+
+  attr = &fs->fs_attr[fs->fs_attrnext];
+  if (++fs->fs_attrnext >= CONFIG_FS_HOSTFS_NATTRCACHE)
+    {
+      fs->fs_attrnext = 0;
+    }
+
+  strncpy(attr->path, path, HOSTFS_MAX_PATH);
+  attr->path[HOSTFS_MAX_PATH - 1] = '\0';
+  memcpy(&attr->buf, buf, sizeof(struct stat));
+  attr->ret    = ret;
+  attr->expire = now + MSEC2TICK(CONFIG_FS_HOSTFS_ATTRCACHE_MSEC);
+
+errout_with_semaphore:
+#endif
   hostfs_semgive(fs);
   return ret;
 }
@@ -43,9 +43,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <semaphore.h>
+#include <time.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -63,6 +65,20 @@
 
 #define HOSTFS_MAX_PATH     256
 
+/* Configuration */
+
+#ifndef CONFIG_FS_HOSTFS_RABUFSIZE
+#  define CONFIG_FS_HOSTFS_RABUFSIZE 0
+#endif
+
+#ifndef CONFIG_FS_HOSTFS_NATTRCACHE
+#  define CONFIG_FS_HOSTFS_NATTRCACHE 0
+#endif
+
+#ifndef CONFIG_FS_HOSTFS_ATTRCACHE_MSEC
+#  define CONFIG_FS_HOSTFS_ATTRCACHE_MSEC 1000
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -77,8 +93,27 @@ struct hostfs_ofile_s
   int16_t                   crefs;      /* Reference count */
   mode_t                    oflags;     /* Open mode */
   int                       fd;
+#if CONFIG_FS_HOSTFS_RABUFSIZE > 0
+  FAR uint8_t              *rabuf;      /* Read-ahead buffer (read-only files) */
+  uint16_t                  ralen;      /* Number of valid bytes in rabuf */
+  uint16_t                  raoff;      /* Offset of next unread byte in rabuf */
+#endif
 };
 
+#if CONFIG_FS_HOSTFS_NATTRCACHE > 0
+/* One cached stat() result.  An empty path means that the entry is unused.
+ * Failed lookups are cached too.
+ */
+
+struct hostfs_attr_s
+{
+  clock_t                   expire;     /* Time when the entry becomes stale */
+  int                       ret;        /* Result of host_stat() */
+  struct stat               buf;        /* The attributes */
+  char                      path[HOSTFS_MAX_PATH];
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a hostfs filesystem.
@@ -89,6 +124,10 @@ struct hostfs_mountpt_s
   sem_t                      *fs_sem;       /* Used to assure thread-safe access */
   FAR struct hostfs_ofile_s  *fs_head;      /* A singly-linked list of open files */
   char                        fs_root[HOSTFS_MAX_PATH];
+#if CONFIG_FS_HOSTFS_NATTRCACHE > 0
+  uint8_t                     fs_attrnext;  /* Next attribute cache slot to replace */
+  struct hostfs_attr_s        fs_attr[CONFIG_FS_HOSTFS_NATTRCACHE];
+#endif
 };
 
 /****************************************************************************
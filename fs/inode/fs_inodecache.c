@@ -0,0 +1,251 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODECACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached path lookup.  A NULL node is a negative entry recording that
+ * the path does not exist in the pseudo file system.  Entries from older
+ * generations are stale and treated as empty.
+ */
+
+struct inode_cacheent_s
+{
+  uint32_t gen;                /* Generation the entry was created in */
+  FAR struct inode *node;      /* Inode found or NULL if not found */
+  uint16_t reloff;             /* Offset of relpath into the path */
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+  bool nofollow;               /* Value of nofollow in the search */
+#endif
+  char path[CONFIG_FS_INODECACHE_PATHLEN]; /* Full path searched for */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_cacheent_s g_inode_cache[CONFIG_FS_INODECACHE_NENTRIES];
+static uint32_t g_inode_cachegen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cachehash
+ *
+ * Description:
+ *   Hash a path to a cache slot.  Returns NULL if the path is too long to be
+ *   cached.
+ *
+ ****************************************************************************/
+
+static FAR struct inode_cacheent_s *inode_cachehash(FAR const char *path)
+{
+  uint32_t hash = 2166136261u;
+  size_t len;
+
+  for (len = 0; path[len] != '\0'; len++)
+    {
+      if (len >= CONFIG_FS_INODECACHE_PATHLEN - 1)
+        {
+          return NULL;
+        }
+
+      hash = (hash ^ (uint8_t)path[len]) * 16777619u;
+    }
+
+  return &g_inode_cache[hash % CONFIG_FS_INODECACHE_NENTRIES];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cachelookup
+ *
+ * Description:
+ *   Look up the result of a previous inode_search() on the same path.  On
+ *   a hit the node and relpath of 'desc' are set up and the result of that
+ *   search is returned in 'result'.  The peer and parent nodes are not
+ *   cached so this may only be used when those are not needed.
+ *
+ * Returned Value:
+ *   true on a cache hit; false if inode_search() must be called.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+bool inode_cachelookup(FAR struct inode_search_s *desc, FAR int *result)
+{
+  FAR struct inode_cacheent_s *ent;
+
+  DEBUGASSERT(desc != NULL && desc->path != NULL && result != NULL);
+
+  ent = inode_cachehash(desc->path);
+  if (ent == NULL || ent->gen != g_inode_cachegen ||
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+      ent->nofollow != desc->nofollow ||
+#endif
+      strcmp(ent->path, desc->path) != 0)
+    {
+      return false;
+    }
+
+  if (ent->node == NULL)
+    {
+      *result = -ENOENT;
+    }
+  else
+    {
+      desc->path    += ent->reloff;
+      desc->node     = ent->node;
+      desc->relpath  = desc->path;
+      *result        = OK;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_cacheadd
+ *
+ * Description:
+ *   Remember the outcome of inode_search() on 'path'.  Only searches that
+ *   found the node or found that it does not exist are cached, and then
+ *   only if no soft link was followed: The relpath must point into the
+ *   original path.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cacheadd(FAR const struct inode_search_s *desc,
+                    FAR const char *path, int result)
+{
+  FAR struct inode_cacheent_s *ent;
+
+  if (result != OK && result != -ENOENT)
+    {
+      return;
+    }
+
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+  if (desc->linktgt != NULL || desc->buffer != NULL)
+    {
+      return;
+    }
+#endif
+
+  ent = inode_cachehash(path);
+  if (ent == NULL)
+    {
+      return;
+    }
+
+  if (result == OK)
+    {
+      DEBUGASSERT(desc->relpath >= path &&
+                  desc->relpath - path < CONFIG_FS_INODECACHE_PATHLEN);
+
+      ent->node   = desc->node;
+      ent->reloff = desc->relpath - path;
+    }
+  else
+    {
+      ent->node   = NULL;
+      ent->reloff = 0;
+    }
+
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+  ent->nofollow = desc->nofollow;
+#endif
+  strcpy(ent->path, path);
+  ent->gen = g_inode_cachegen;
+}
+
+/****************************************************************************
+ * Name: inode_cacheinvalidate
+ *
+ * Description:
+ *   Discard all cached lookups.  This must be called whenever the shape of
+ *   the inode tree changes or an inode becomes or stops being a mountpoint
+ *   or a soft link.
+ *
+ ****************************************************************************/
+
+void inode_cacheinvalidate(void)
+{
+  inode_semtake();
+
+  /* Entries carry the generation they were created in, so advancing the
+   * generation empties the whole cache.  Only on wrap-around does the
+   * table need to be cleared.
+   */
+
+  if (++g_inode_cachegen == 0)
+    {
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cachegen = 1;
+    }
+
+  inode_semgive();
+}
+
+#endif /* CONFIG_FS_INODECACHE */
@@ -64,6 +64,9 @@
 
 int inode_find(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODECACHE
+  FAR const char *path = desc->path;
+#endif
   int ret;
 
   /* Find the node matching the path.  If found, increment the count of
@@ -71,7 +74,19 @@ int inode_find(FAR struct inode_search_s *desc)
    */
 
   inode_semtake();
+
+#ifdef CONFIG_FS_INODECACHE
+  /* Try the lookup cache before walking the inode tree */
+
+  if (!inode_cachelookup(desc, &ret))
+    {
+      ret = inode_search(desc);
+      inode_cacheadd(desc, path, ret);
+    }
+#else
   ret = inode_search(desc);
+#endif
+
   if (ret >= 0)
     {
       /* Found it */
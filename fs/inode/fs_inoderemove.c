@@ -117,6 +117,10 @@ FAR struct inode *inode_unlink(FAR const char *path)
         }
 
       node->i_peer = NULL;
+
+      /* Cached lookups may no longer be valid */
+
+      inode_cacheinvalidate();
     }
 
   RELEASE_SEARCH(&desc);
@@ -240,6 +240,28 @@ int inode_search(FAR struct inode_search_s *desc);
 
 int inode_find(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cachelookup, inode_cacheadd, and inode_cacheinvalidate
+ *
+ * Description:
+ *   Hashed cache of full path lookups used by inode_find().  Both found and
+ *   not found results are cached.  The cache is invalidated whenever the
+ *   inode tree is modified.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore for lookups and additions.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODECACHE
+bool inode_cachelookup(FAR struct inode_search_s *desc, FAR int *result);
+void inode_cacheadd(FAR const struct inode_search_s *desc,
+                    FAR const char *path, int result);
+void inode_cacheinvalidate(void);
+#else
+#  define inode_cacheinvalidate()
+#endif
+
 /****************************************************************************
  * Name: inode_stat
  *
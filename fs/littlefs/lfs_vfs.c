@@ -52,6 +52,8 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <nuttx/fs/dirent.h>
@@ -65,6 +67,22 @@
 #include "lfs.h"
 #include "lfs_util.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_LITTLEFS_READ_SIZE
+#  define CONFIG_FS_LITTLEFS_READ_SIZE 0
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_PROG_SIZE
+#  define CONFIG_FS_LITTLEFS_PROG_SIZE 0
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_LOOKAHEAD
+#  define CONFIG_FS_LITTLEFS_LOOKAHEAD 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -767,6 +785,16 @@ static int littlefs_read_block(FAR const struct lfs_config_s *c,
   FAR struct inode *drv = fs->drv;
   int ret;
 
+  if (INODE_IS_MTD(drv) &&
+      ((off | size) % geo->blocksize) != 0)
+    {
+      /* Sub-block access, only possible with byte oriented reads */
+
+      ret = MTD_READ(drv->u.i_mtd, (off_t)block * c->block_size + off,
+                     size, buffer);
+      return ret >= 0 ? OK : ret;
+    }
+
   block = (block * c->block_size + off) / geo->blocksize;
   size  = size / geo->blocksize;
 
@@ -795,6 +823,18 @@ static int littlefs_write_block(FAR const struct lfs_config_s *c,
   FAR struct inode *drv = fs->drv;
   int ret;
 
+#ifdef CONFIG_MTD_BYTE_WRITE
+  if (INODE_IS_MTD(drv) &&
+      ((off | size) % geo->blocksize) != 0)
+    {
+      /* Sub-block access, only possible with byte oriented writes */
+
+      ret = MTD_WRITE(drv->u.i_mtd, (off_t)block * c->block_size + off,
+                      size, buffer);
+      return ret >= 0 ? OK : ret;
+    }
+#endif
+
   block = (block * c->block_size + off) / geo->blocksize;
   size  = size / geo->blocksize;
 
@@ -855,6 +895,142 @@ static int littlefs_sync_block(FAR const struct lfs_config_s *c)
   return ret == -ENOTTY ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_parseoptions
+ *
+ * Description:
+ *   Parse the comma separated list of mount options: "forceformat",
+ *   "autoformat", "read_size=<n>", "prog_size=<n>" and "lookahead=<n>".
+ *
+ ****************************************************************************/
+
+static int littlefs_parseoptions(FAR const char *data,
+                                 FAR struct lfs_config_s *cfg,
+                                 FAR bool *forceformat,
+                                 FAR bool *autoformat)
+{
+  while (data != NULL && *data != '\0')
+    {
+      FAR const char *end = strchr(data, ',');
+      FAR lfs_size_t *value = NULL;
+      FAR char *last;
+      size_t len;
+
+      len = end != NULL ? end - data : strlen(data);
+
+      if (len == 11 && strncmp(data, "forceformat", 11) == 0)
+        {
+          *forceformat = true;
+        }
+      else if (len == 10 && strncmp(data, "autoformat", 10) == 0)
+        {
+          *autoformat = true;
+        }
+      else if (strncmp(data, "read_size=", 10) == 0)
+        {
+          value = &cfg->read_size;
+          data += 10;
+        }
+      else if (strncmp(data, "prog_size=", 10) == 0)
+        {
+          value = &cfg->prog_size;
+          data += 10;
+        }
+      else if (strncmp(data, "lookahead=", 10) == 0)
+        {
+          value = &cfg->lookahead;
+          data += 10;
+        }
+      else
+        {
+          return -EINVAL;
+        }
+
+      if (value != NULL)
+        {
+          *value = strtoul(data, &last, 0);
+          if (last == data || (*last != ',' && *last != '\0'))
+            {
+              return -EINVAL;
+            }
+        }
+
+      data = end != NULL ? end + 1 : NULL;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: littlefs_setupsizes
+ *
+ * Description:
+ *   Resolve the read, program and lookahead sizes against the geometry of
+ *   the underlying device.  The littlefs read and program caches are sized
+ *   by the read and program sizes.
+ *
+ ****************************************************************************/
+
+static int littlefs_setupsizes(FAR struct littlefs_mountpt_s *fs)
+{
+  FAR struct lfs_config_s *cfg = &fs->cfg;
+  lfs_size_t blocksize = fs->geo.blocksize;
+  bool byteread = false;
+  bool bytewrite = false;
+
+  if (INODE_IS_MTD(fs->drv))
+    {
+      byteread  = fs->drv->u.i_mtd->read != NULL;
+#ifdef CONFIG_MTD_BYTE_WRITE
+      bytewrite = fs->drv->u.i_mtd->write != NULL;
+#endif
+    }
+
+  /* Zero selects the device block size.  Sub-block sizes need byte
+   * oriented access, so round them up when the device lacks it.
+   */
+
+  if (cfg->read_size == 0 ||
+      (!byteread && cfg->read_size % blocksize != 0))
+    {
+      cfg->read_size = cfg->read_size + blocksize - 1;
+      cfg->read_size = cfg->read_size - cfg->read_size % blocksize;
+      if (cfg->read_size == 0)
+        {
+          cfg->read_size = blocksize;
+        }
+    }
+
+  if (cfg->prog_size == 0 ||
+      (!bytewrite && cfg->prog_size % blocksize != 0))
+    {
+      cfg->prog_size = cfg->prog_size + blocksize - 1;
+      cfg->prog_size = cfg->prog_size - cfg->prog_size % blocksize;
+      if (cfg->prog_size == 0)
+        {
+          cfg->prog_size = blocksize;
+        }
+    }
+
+  if (cfg->prog_size % cfg->read_size != 0 ||
+      cfg->block_size % cfg->prog_size != 0)
+    {
+      return -EINVAL;
+    }
+
+  /* The allocator never scans more than block_count blocks at a time, so
+   * a larger lookahead buffer would only waste memory.
+   */
+
+  if (cfg->lookahead == 0 || cfg->lookahead > cfg->block_count)
+    {
+      cfg->lookahead = cfg->block_count;
+    }
+
+  cfg->lookahead = (cfg->lookahead + 31) & ~31;
+  return OK;
+}
+
 /****************************************************************************
  * Name: littlefs_bind
  ****************************************************************************/
@@ -863,6 +1039,8 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
                          FAR void **handle)
 {
   FAR struct littlefs_mountpt_s *fs;
+  bool forceformat = false;
+  bool autoformat = false;
   int ret;
 
   /* Open the block driver */
@@ -936,15 +1114,24 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.prog        = littlefs_write_block;
   fs->cfg.erase       = littlefs_erase_block;
   fs->cfg.sync        = littlefs_sync_block;
-  fs->cfg.read_size   = fs->geo.blocksize;
-  fs->cfg.prog_size   = fs->geo.blocksize;
+  fs->cfg.read_size   = CONFIG_FS_LITTLEFS_READ_SIZE;
+  fs->cfg.prog_size   = CONFIG_FS_LITTLEFS_PROG_SIZE;
   fs->cfg.block_size  = fs->geo.erasesize;
   fs->cfg.block_count = fs->geo.neraseblocks;
-  fs->cfg.lookahead   = 4 * ((fs->cfg.block_count + 31) / 32);
+  fs->cfg.lookahead   = CONFIG_FS_LITTLEFS_LOOKAHEAD;
 
-  if (fs->cfg.lookahead > fs->cfg.read_size)
+  /* Mount options override the configured sizes */
+
+  ret = littlefs_parseoptions(data, &fs->cfg, &forceformat, &autoformat);
+  if (ret < 0)
     {
-      fs->cfg.lookahead = fs->cfg.read_size;
+      goto errout_with_fs;
+    }
+
+  ret = littlefs_setupsizes(fs);
+  if (ret < 0)
+    {
+      goto errout_with_fs;
     }
 
   /* Then get information about the littlefs filesystem on the devices
@@ -953,7 +1140,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
 
   /* Force format the device if -o forceformat */
 
-  if (data && strcmp(data, "forceformat") == 0)
+  if (forceformat)
     {
       ret = lfs_format(&fs->lfs, &fs->cfg);
       if (ret < 0)
@@ -967,8 +1154,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
     {
       /* Auto format the device if -o autoformat */
 
-      if (ret != LFS_ERR_CORRUPT ||
-          !data || strcmp(data, "autoformat"))
+      if (ret != LFS_ERR_CORRUPT || !autoformat)
         {
           goto errout_with_fs;
         }
@@ -66,8 +66,9 @@
  *     a. The filesystem supports the FIOC_MMAP ioctl command.  Any file
  *        system that maps files contiguously on the media should support
  *        this ioctl. (vs. file system that scatter files over the media
- *        in non-contiguous sectors).  As of this writing, ROMFS is the
- *        only file system that meets this requirement.
+ *        in non-contiguous sectors).  As of this writing, ROMFS meets this
+ *        requirement.  FAT supports it for files whose clusters happen to
+ *        be contiguous on the media.
  *     b. The underlying block driver supports the BIOC_XIPBASE ioctl
  *        command that maps the underlying media to a randomly accessible
  *        address. At  present, only the RAM/ROM disk driver does this.
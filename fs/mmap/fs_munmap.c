@@ -51,8 +51,9 @@
 
 #include "inode/inode.h"
 #include "fs_rammap.h"
+#include "shm/shmfs.h"
 
-#ifdef CONFIG_FS_RAMMAP
+#if defined(CONFIG_FS_RAMMAP) || defined(CONFIG_FS_SHM)
 
 /****************************************************************************
  * Public Functions
@@ -95,6 +96,11 @@
  *      into RAM.  munmap() is required in this case to free the allocated
  *      memory holding the shared copy of the file.
  *
+ *   3. If CONFIG_FS_SHM is defined in the configuration, then mmap() of a
+ *      shared memory object (see shm_open() and memfd_create()) takes a
+ *      reference on the object.  munmap() drops that reference so that the
+ *      object can be freed once it is unlinked, closed and unmapped.
+ *
  * Input Parameters:
  *   start   The start address of the mapping to delete.  For this
  *           simplified munmap() implementation, the *must* be the start
@@ -110,13 +116,32 @@
 
 int munmap(FAR void *start, size_t length)
 {
+#ifdef CONFIG_FS_RAMMAP
   FAR struct fs_rammap_s *prev;
   FAR struct fs_rammap_s *curr;
   FAR void *newaddr;
   unsigned int offset;
+#endif
   int ret;
   int errcode;
 
+#ifdef CONFIG_FS_SHM
+  /* Is this a mapping of a shared memory object? */
+
+  ret = shmfs_munmap(start, length);
+  if (ret != -ENOENT)
+    {
+      if (ret < 0)
+        {
+          errcode = -ret;
+          goto errout;
+        }
+
+      return OK;
+    }
+#endif
+
+#ifdef CONFIG_FS_RAMMAP
   /* Find a region containing this start and length in the list of regions */
 
   rammap_initialize();
@@ -206,10 +231,14 @@ int munmap(FAR void *start, size_t length)
 
 errout_with_semaphore:
   nxsem_post(&g_rammaps.exclsem);
+#else
+  ferr("ERROR: Region not found\n");
+  errcode = EINVAL;
+#endif
 
 errout:
   set_errno(errcode);
   return ERROR;
 }
 
-#endif /* CONFIG_FS_RAMMAP */
+#endif /* CONFIG_FS_RAMMAP || CONFIG_FS_SHM */
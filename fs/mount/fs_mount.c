@@ -467,6 +467,7 @@ int mount(FAR const char *source, FAR const char *target,
   /* We have it, now populate it with driver specific information. */
 
   INODE_SET_MOUNTPT(mountpt_inode);
+  inode_cacheinvalidate();
 
   mountpt_inode->u.i_mops  = mops;
 #ifdef CONFIG_FILE_MODE
@@ -135,6 +135,15 @@ EXTERN int nfs_finddir(FAR struct nfsmount *nmp, FAR const char *relpath,
               FAR struct nfs_fattr *attributes, FAR char *filename);
 EXTERN void nfs_attrupdate(FAR struct nfsnode *np,
               FAR struct nfs_fattr *attributes);
+EXTERN int  nfs_sendrequest(FAR struct nfsmount *nmp, int procnum,
+              FAR void *request, size_t reqlen, FAR uint32_t *xid);
+EXTERN int  nfs_getreply(FAR struct nfsmount *nmp, FAR void *response,
+              size_t resplen, FAR uint32_t *xid);
+#ifdef CONFIG_NFS_ATTRCACHE
+EXTERN void nfs_lcache_flush(FAR struct nfsmount *nmp);
+#else
+#  define nfs_lcache_flush(nmp)
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
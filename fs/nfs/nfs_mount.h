@@ -49,6 +49,8 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <limits.h>
+#include <time.h>
 
 #include "rpc.h"
 
@@ -60,6 +62,19 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_NFS_ATTRCACHE
+/* One cached LOOKUP result.  An entry is unused if lc_name[0] is '\0'. */
+
+struct nfs_lcache_s
+{
+  clock_t            lc_time;               /* Time the entry was filled (ticks) */
+  struct file_handle lc_dir;                /* Handle of the containing directory */
+  struct file_handle lc_fhandle;            /* Handle of the object */
+  struct nfs_fattr   lc_fattr;              /* Attributes of the object */
+  char               lc_name[NAME_MAX + 1]; /* Name of the object in lc_dir */
+};
+#endif
+
 /* Mount structure. One mount structure is allocated for each NFS mount. This
  * structure holds NFS specific information for mount.
  */
@@ -83,6 +98,10 @@ struct nfsmount
   uint16_t         nm_wsize;                  /* Max size of write RPC */
   uint16_t         nm_readdirsize;            /* Size of a readdir RPC */
   uint16_t         nm_buflen;                 /* Size of I/O buffer */
+#ifdef CONFIG_NFS_ATTRCACHE
+  uint8_t          nm_lcnext;                 /* Next lookup cache entry to replace */
+  struct nfs_lcache_s nm_lcache[CONFIG_NFS_ATTRCACHE_NENTRIES];
+#endif
 
   /* Set aside memory on the stack to hold the largest call message.  NOTE
    * that for the case of the write call message, it is the reply message that
@@ -104,6 +123,7 @@ struct nfsmount
     struct rpc_call_fs      fsstat;
     struct rpc_call_setattr setattr;
     struct rpc_call_fs      fs;
+    struct rpc_call_commit  commit;
     struct rpc_reply_write  write;
   } nm_msgbuffer;
 
@@ -58,6 +58,8 @@
 
 #define NFSNODE_OPEN           (1 << 0) /* File is still open */
 #define NFSNODE_MODIFIED       (1 << 1) /* Might have a modified buffer */
+#define NFSNODE_UNSTABLE       (1 << 2) /* UNSTABLE writes awaiting COMMIT */
+#define NFSNODE_VERFERR        (1 << 3) /* Server write verifier changed */
 
 /****************************************************************************
  * Public Types
@@ -79,6 +81,15 @@ struct nfsnode
   time_t             n_ctime;       /* File creation time */
   nfsfh_t            n_fhandle;     /* NFS File Handle */
   uint64_t           n_size;        /* Current size of file */
+#ifdef CONFIG_NFS_READAHEAD
+  FAR uint8_t       *n_rabuf;       /* Read-ahead buffer (allocated on demand) */
+  off_t              n_raoffset;    /* File offset of the data in n_rabuf */
+  size_t             n_ralen;       /* Number of valid bytes in n_rabuf */
+  off_t              n_seqpos;      /* Offset expected by a sequential read */
+#endif
+#ifdef CONFIG_NFS_WRITEBEHIND
+  uint8_t            n_verf[NFSX_V3WRITEVERF]; /* Verifier of UNSTABLE writes */
+#endif
 };
 
 #endif /* __FS_NFS_NFS_NODE_H */
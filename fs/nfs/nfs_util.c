@@ -52,6 +52,7 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/dirent.h>
 
@@ -118,6 +119,82 @@ static inline int nfs_pathsegment(FAR const char **path, FAR char *buffer,
     }
 }
 
+/****************************************************************************
+ * Name: nfs_lcache_find
+ *
+ * Description:
+ *   Find the cached result of looking up 'filename' in the directory
+ *   'dir'.  Expired entries are discarded as they are encountered.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+static FAR struct nfs_lcache_s *
+nfs_lcache_find(FAR struct nfsmount *nmp, FAR const struct file_handle *dir,
+                FAR const char *filename)
+{
+  FAR struct nfs_lcache_s *lc;
+  clock_t now = clock_systimer();
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      lc = &nmp->nm_lcache[i];
+      if (lc->lc_name[0] == '\0')
+        {
+          continue;
+        }
+
+      if (now - lc->lc_time >= SEC2TICK(CONFIG_NFS_ATTRCACHE_TIMEO))
+        {
+          lc->lc_name[0] = '\0';
+          continue;
+        }
+
+      if (lc->lc_dir.length == dir->length &&
+          memcmp(&lc->lc_dir.handle, &dir->handle, dir->length) == 0 &&
+          strcmp(lc->lc_name, filename) == 0)
+        {
+          return lc;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: nfs_lcache_add
+ *
+ * Description:
+ *   Remember the result of a LOOKUP RPC, replacing the oldest entry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+static void nfs_lcache_add(FAR struct nfsmount *nmp,
+                           FAR const struct file_handle *dir,
+                           FAR const char *filename,
+                           FAR const struct file_handle *fhandle,
+                           FAR const struct nfs_fattr *fattr)
+{
+  FAR struct nfs_lcache_s *lc;
+
+  lc = &nmp->nm_lcache[nmp->nm_lcnext];
+  if (++nmp->nm_lcnext >= CONFIG_NFS_ATTRCACHE_NENTRIES)
+    {
+      nmp->nm_lcnext = 0;
+    }
+
+  lc->lc_time = clock_systimer();
+  memcpy(&lc->lc_dir, dir, sizeof(struct file_handle));
+  memcpy(&lc->lc_fhandle, fhandle, sizeof(struct file_handle));
+  memcpy(&lc->lc_fattr, fattr, sizeof(struct nfs_fattr));
+  strncpy(lc->lc_name, filename, NAME_MAX);
+  lc->lc_name[NAME_MAX] = '\0';
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -252,6 +329,62 @@ tryagain:
   return OK;
 }
 
+/****************************************************************************
+ * Name: nfs_sendrequest
+ *
+ * Description:
+ *   Send an NFS CALL message without waiting for the reply.  See
+ *   rpcclnt_sendrequest() for the meaning of 'xid'.
+ *
+ * Returned Value:
+ *   Zero on success; a positive errno value on failure.
+ *
+ ****************************************************************************/
+
+int nfs_sendrequest(FAR struct nfsmount *nmp, int procnum,
+                    FAR void *request, size_t reqlen, FAR uint32_t *xid)
+{
+  return rpcclnt_sendrequest(nmp->nm_rpcclnt, procnum, NFS_PROG, NFS_VER3,
+                             request, reqlen, xid);
+}
+
+/****************************************************************************
+ * Name: nfs_getreply
+ *
+ * Description:
+ *   Receive the next NFS reply and verify its RPC and NFS status.  The xid
+ *   of the reply is returned in *xid (zero if no reply was received).
+ *
+ * Returned Value:
+ *   Zero on success; a positive errno value on failure.
+ *
+ ****************************************************************************/
+
+int nfs_getreply(FAR struct nfsmount *nmp, FAR void *response,
+                 size_t resplen, FAR uint32_t *xid)
+{
+  FAR struct nfs_reply_header *replyh;
+  uint32_t status;
+  int error;
+
+  error = rpcclnt_getreply(nmp->nm_rpcclnt, response, resplen, xid);
+  if (error != OK)
+    {
+      return error;
+    }
+
+  /* NFS_ERRORS are the same as NuttX errno values */
+
+  replyh = (FAR struct nfs_reply_header *)response;
+  status = fxdr_unsigned(uint32_t, replyh->nfs_status);
+  if (status != 0)
+    {
+      return status > 32 ? EOPNOTSUPP : (int)status;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: nfs_lookup
  *
@@ -276,6 +409,10 @@ int nfs_lookup(struct nfsmount *nmp, FAR const char *filename,
   int reqlen;
   int namelen;
   int error = 0;
+#ifdef CONFIG_NFS_ATTRCACHE
+  FAR struct nfs_lcache_s *lc;
+  struct file_handle dir;
+#endif
 
   DEBUGASSERT(nmp && filename && fhandle);
 
@@ -288,6 +425,30 @@ int nfs_lookup(struct nfsmount *nmp, FAR const char *filename,
       return E2BIG;
     }
 
+#ifdef CONFIG_NFS_ATTRCACHE
+  /* Check if the result of this LOOKUP is still in the cache.  Directory
+   * attributes are not cached.
+   */
+
+  if (dir_attributes == NULL)
+    {
+      lc = nfs_lcache_find(nmp, fhandle, filename);
+      if (lc != NULL)
+        {
+          memcpy(fhandle, &lc->lc_fhandle, sizeof(struct file_handle));
+          if (obj_attributes)
+            {
+              memcpy(obj_attributes, &lc->lc_fattr,
+                     sizeof(struct nfs_fattr));
+            }
+
+          return OK;
+        }
+    }
+
+  memcpy(&dir, fhandle, sizeof(struct file_handle));
+#endif
+
   /* Initialize the request */
 
   ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.lookup.lookup;
@@ -357,6 +518,11 @@ int nfs_lookup(struct nfsmount *nmp, FAR const char *filename,
         {
           memcpy(obj_attributes, ptr, sizeof(struct nfs_fattr));
         }
+
+#ifdef CONFIG_NFS_ATTRCACHE
+      nfs_lcache_add(nmp, &dir, filename, fhandle,
+                     (FAR struct nfs_fattr *)ptr);
+#endif
       ptr += uint32_increment(sizeof(struct nfs_fattr));
     }
 
@@ -571,6 +737,27 @@ int nfs_finddir(struct nfsmount *nmp, FAR const char *relpath,
     }
 }
 
+/****************************************************************************
+ * Name: nfs_lcache_flush
+ *
+ * Description:
+ *   Discard all cached LOOKUP results.  Called whenever this client
+ *   modifies the server's namespace or file attributes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+void nfs_lcache_flush(FAR struct nfsmount *nmp)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      nmp->nm_lcache[i].lc_name[0] = '\0';
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nfs_attrupdate
  *
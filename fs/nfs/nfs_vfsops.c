@@ -103,6 +103,18 @@
 #  error "Length of cookie verify in fs_dirent_s is incorrect"
 #endif
 
+#ifndef CONFIG_NFS_MAX_OUTSTANDING
+#  define CONFIG_NFS_MAX_OUTSTANDING 1
+#endif
+
+/* With write-behind, WRITEs are not committed until close or fsync */
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+#  define NFS_WRITE_STABLE    NFSV3WRITE_UNSTABLE
+#else
+#  define NFS_WRITE_STABLE    NFSV3WRITE_FILESYNC
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -119,6 +131,18 @@ struct nfs_statinfo_s
   time_t   ns_ctime;   /* Time of last status change */
 };
 
+/* Describes one of several outstanding READ or WRITE RPCs */
+
+struct nfs_rpcslot_s
+{
+  uint32_t xid;        /* Transaction ID (zero until first sent) */
+  off_t    offset;     /* File offset of the transfer */
+  size_t   len;        /* Number of bytes requested */
+  size_t   xfrd;       /* Number of bytes actually transferred */
+  bool     done;       /* True: The reply has been received */
+  bool     eof;        /* True: READ reached the end of the file */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -147,9 +171,26 @@ static int     nfs_fileopen(FAR struct nfsmount *nmp,
 static int     nfs_open(FAR struct file *filep, const char *relpath,
                    int oflags, mode_t mode);
 static int     nfs_close(FAR struct file *filep);
+static int     nfs_nextreply(FAR struct nfsmount *nmp,
+                   FAR struct nfs_rpcslot_s *slots, int nslots,
+                   FAR void *response, size_t resplen, FAR int *index);
+static int     nfs_readsend(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                   FAR struct nfs_rpcslot_s *slot);
+static int     nfs_readrpcs(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                   off_t offset, FAR char *buffer, size_t buflen,
+                   FAR uint8_t *rabuf, size_t ralen, FAR size_t *nread);
 static ssize_t nfs_read(FAR struct file *filep, char *buffer, size_t buflen);
+static int     nfs_writesend(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                   FAR struct nfs_rpcslot_s *slot, FAR const char *data);
+static int     nfs_writerpcs(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                   off_t offset, FAR const char *buffer, size_t buflen,
+                   FAR size_t *nwritten);
 static ssize_t nfs_write(FAR struct file *filep, const char *buffer,
                    size_t buflen);
+#ifdef CONFIG_NFS_WRITEBEHIND
+static int     nfs_commit(FAR struct nfsmount *nmp, FAR struct nfsnode *np);
+static int     nfs_sync(FAR struct file *filep);
+#endif
 static int     nfs_dup(FAR const struct file *oldp, FAR struct file *newp);
 static int     nfs_fstat(FAR const struct file *filep, FAR struct stat *buf);
 static int     nfs_truncate(FAR struct file *filep, off_t length);
@@ -194,7 +235,11 @@ const struct mountpt_operations nfs_operations =
   NULL,                         /* seek */
   NULL,                         /* ioctl */
 
+#ifdef CONFIG_NFS_WRITEBEHIND
+  nfs_sync,                     /* sync */
+#else
   NULL,                         /* sync */
+#endif
   nfs_dup,                      /* dup */
   nfs_fstat,                    /* fstat */
   nfs_truncate,                 /* truncate */
@@ -347,6 +392,7 @@ static int nfs_filecreate(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
   do
     {
       nfs_statistics(NFSPROC_CREATE);
+      nfs_lcache_flush(nmp);
       error = nfs_request(nmp, NFSPROC_CREATE,
                           (FAR void *)&nmp->nm_msgbuffer.create, reqlen,
                           (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
@@ -453,6 +499,7 @@ static int nfs_filetruncate(FAR struct nfsmount *nmp,
   /* Perform the SETATTR RPC */
 
   nfs_statistics(NFSPROC_SETATTR);
+  nfs_lcache_flush(nmp);
   error = nfs_request(nmp, NFSPROC_SETATTR,
                       (FAR void *)&nmp->nm_msgbuffer.setattr, reqlen,
                       (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
@@ -741,6 +788,12 @@ static int nfs_close(FAR struct file *filep)
 
   else
     {
+#ifdef CONFIG_NFS_WRITEBEHIND
+      /* Commit any UNSTABLE writes before the file is forgotten */
+
+      int error = nfs_commit(nmp, np);
+#endif
+
       /* Assume file structure will not be found.  This should never happen. */
 
       ret = -EINVAL;
@@ -770,11 +823,25 @@ static int nfs_close(FAR struct file *filep)
 
               /* Then deallocate the file structure and return success */
 
+#ifdef CONFIG_NFS_READAHEAD
+              if (np->n_rabuf != NULL)
+                {
+                  kmm_free(np->n_rabuf);
+                }
+#endif
+
               kmm_free(np);
               ret = OK;
               break;
             }
         }
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+      if (ret == OK && error != OK)
+        {
+          ret = -error;
+        }
+#endif
     }
 
   filep->f_priv = NULL;
@@ -782,6 +849,272 @@ static int nfs_close(FAR struct file *filep)
   return ret;
 }
 
+/****************************************************************************
+ * Name: nfs_nextreply
+ *
+ * Description:
+ *   Receive replies until one arrives for an outstanding RPC in 'slots'.
+ *   Replies to RPCs that are not outstanding (for example, duplicates
+ *   caused by retransmission) are discarded.
+ *
+ * Returned Value:
+ *   Zero on success with the index of the matching slot in *index.
+ *   ETIMEDOUT if no reply arrived before the socket timeout; outstanding
+ *   RPCs should then be retransmitted.  Any other positive errno value is
+ *   the error reported for the matching slot or by the socket.
+ *
+ ****************************************************************************/
+
+static int nfs_nextreply(FAR struct nfsmount *nmp,
+                         FAR struct nfs_rpcslot_s *slots, int nslots,
+                         FAR void *response, size_t resplen,
+                         FAR int *index)
+{
+  uint32_t xid;
+  int error;
+  int i;
+
+  for (; ; )
+    {
+      error = nfs_getreply(nmp, response, resplen, &xid);
+      if (xid != 0)
+        {
+          for (i = 0; i < nslots; i++)
+            {
+              if (slots[i].xid == xid && !slots[i].done)
+                {
+                  *index = i;
+                  return error;
+                }
+            }
+
+          finfo("Discarding reply xid=%08x\n", xid);
+        }
+      else if (nmp->nm_rpcclnt->rc_timeout)
+        {
+          return ETIMEDOUT;
+        }
+      else if (error != OK && error != EPROTO)
+        {
+          return error;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nfs_readsend
+ *
+ * Description:
+ *   Send (or re-send) the READ RPC described by 'slot'.
+ *
+ * Returned Value:
+ *   0 on success; a positive errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_readsend(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                        FAR struct nfs_rpcslot_s *slot)
+{
+  FAR uint32_t *ptr;
+  size_t reqlen;
+
+  /* Initialize the request */
+
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += (int)np->n_fhsize;
+  ptr    += uint32_increment((int)np->n_fhsize);
+
+  /* Copy the file offset */
+
+  txdr_hyper((uint64_t)slot->offset, ptr);
+  ptr += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Set the readsize */
+
+  *ptr = txdr_unsigned(slot->len);
+  reqlen += sizeof(uint32_t);
+
+  finfo("Reading %d bytes at %d\n", slot->len, slot->offset);
+  nfs_statistics(NFSPROC_READ);
+  return nfs_sendrequest(nmp, NFSPROC_READ,
+                         (FAR void *)&nmp->nm_msgbuffer.read, reqlen,
+                         &slot->xid);
+}
+
+/****************************************************************************
+ * Name: nfs_readrpcs
+ *
+ * Description:
+ *   Read 'buflen' bytes at 'offset' into 'buffer' followed by 'ralen' bytes
+ *   into the read-ahead buffer 'rabuf'.  Up to CONFIG_NFS_MAX_OUTSTANDING
+ *   READ RPCs are kept in flight.  The number of contiguous bytes read from
+ *   'offset' is returned in *nread; this is short on end-of-file or if the
+ *   server returns less than was asked for.
+ *
+ * Returned Value:
+ *   0 on success; a positive errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_readrpcs(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                        off_t offset, FAR char *buffer, size_t buflen,
+                        FAR uint8_t *rabuf, size_t ralen,
+                        FAR size_t *nread)
+{
+  struct nfs_rpcslot_s slots[CONFIG_NFS_MAX_OUTSTANDING];
+  FAR struct nfs_rpcslot_s *slot;
+  FAR uint32_t *ptr;
+  size_t total = buflen + ralen;
+  size_t chunk;
+  size_t pos;
+  size_t len;
+  size_t ncopy;
+  uint32_t tmp;
+  int nslots;
+  int ndone;
+  int retries;
+  int error;
+  int i;
+
+  /* Make sure that the read size does not exceed the RPC maximum or the
+   * IO buffer size.
+   */
+
+  chunk = nmp->nm_rsize;
+  tmp   = SIZEOF_rpc_reply_read(chunk);
+  if (tmp > nmp->nm_buflen)
+    {
+      chunk -= (tmp - nmp->nm_buflen);
+    }
+
+  *nread = 0;
+  while (*nread < total)
+    {
+      /* Issue READs for the next part of the request */
+
+      for (nslots = 0, pos = *nread;
+           nslots < CONFIG_NFS_MAX_OUTSTANDING && pos < total;
+           nslots++)
+        {
+          slot         = &slots[nslots];
+          slot->xid    = 0;
+          slot->offset = offset + pos;
+          slot->len    = total - pos > chunk ? chunk : total - pos;
+          slot->xfrd   = 0;
+          slot->done   = false;
+          slot->eof    = false;
+          pos         += slot->len;
+
+          error = nfs_readsend(nmp, np, slot);
+          if (error != OK)
+            {
+              ferr("ERROR: nfs_readsend failed: %d\n", error);
+              return error;
+            }
+        }
+
+      /* Collect the replies in whatever order they arrive */
+
+      for (ndone = 0, retries = 0; ndone < nslots; )
+        {
+          error = nfs_nextreply(nmp, slots, nslots, nmp->nm_iobuffer,
+                                nmp->nm_buflen, &i);
+          if (error == ETIMEDOUT && retries++ < nmp->nm_retry)
+            {
+              for (i = 0; i < nslots; i++)
+                {
+                  if (!slots[i].done &&
+                      (error = nfs_readsend(nmp, np, &slots[i])) != OK)
+                    {
+                      return error;
+                    }
+                }
+
+              continue;
+            }
+          else if (error != OK)
+            {
+              ferr("ERROR: READ failed: %d\n", error);
+              return error;
+            }
+
+          slot = &slots[i];
+
+          /* Get a pointer to the beginning of the READ response data.
+           * Update the cached file attributes if they were included.
+           */
+
+          ptr = (FAR uint32_t *)
+                &((FAR struct rpc_reply_read *)nmp->nm_iobuffer)->read;
+
+          if (*ptr++ != 0)
+            {
+              nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+              ptr += uint32_increment(sizeof(struct nfs_fattr));
+            }
+
+          /* Skip the count (it repeats the data length), then get the EOF
+           * indication and the length of the read data.
+           */
+
+          ptr++;
+          slot->eof = (*ptr++ != 0);
+          len       = fxdr_unsigned(uint32_t, *ptr);
+          ptr++;
+
+          if (len > slot->len)
+            {
+              return EIO;
+            }
+
+          /* Copy the data to the user buffer and/or the read-ahead buffer */
+
+          pos = slot->offset - offset;
+          if (pos < buflen)
+            {
+              ncopy = buflen - pos > len ? len : buflen - pos;
+              memcpy(buffer + pos, ptr, ncopy);
+            }
+          else
+            {
+              ncopy = 0;
+            }
+
+          if (ncopy < len)
+            {
+              memcpy(rabuf + (pos + ncopy - buflen),
+                     (FAR uint8_t *)ptr + ncopy, len - ncopy);
+            }
+
+          slot->xfrd = len;
+          slot->done = true;
+          ndone++;
+        }
+
+      /* Accept the data in file order up to the first short read */
+
+      for (i = 0; i < nslots; i++)
+        {
+          *nread += slots[i].xfrd;
+          if (slots[i].eof || slots[i].xfrd < slots[i].len)
+            {
+              return OK;
+            }
+        }
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: nfs_read
  *
@@ -795,12 +1128,15 @@ static ssize_t nfs_read(FAR struct file *filep, char *buffer, size_t buflen)
 {
   FAR struct nfsmount       *nmp;
   FAR struct nfsnode        *np;
-  ssize_t                    readsize;
-  ssize_t                    tmp;
-  ssize_t                    bytesread;
-  size_t                     reqlen;
-  FAR uint32_t              *ptr;
+  FAR uint8_t               *rabuf = NULL;
+  size_t                     ralen = 0;
+  size_t                     bytesread = 0;
+  size_t                     nread;
   int                        error = 0;
+#ifdef CONFIG_NFS_READAHEAD
+  bool                       sequential;
+  size_t                     tmp;
+#endif
 
   finfo("Read %d bytes from offset %d\n", buflen, filep->f_pos);
 
@@ -829,129 +1165,338 @@ static ssize_t nfs_read(FAR struct file *filep, char *buffer, size_t buflen)
    * it does not exceed the number of bytes left in the file.
    */
 
-  tmp = np->n_size - filep->f_pos;
-  if (buflen > tmp)
+  if (filep->f_pos >= np->n_size)
     {
-      buflen = tmp;
+      buflen = 0;
+    }
+  else if (buflen > np->n_size - filep->f_pos)
+    {
+      buflen = np->n_size - filep->f_pos;
       finfo("Read size truncated to %d\n", buflen);
     }
 
-  /* Now loop until we fill the user buffer (or hit the end of the file) */
+#ifdef CONFIG_NFS_READAHEAD
+  /* Take what we can from the read-ahead buffer */
 
-  for (bytesread = 0; bytesread < buflen; )
+  sequential = (filep->f_pos == np->n_seqpos);
+  if (np->n_ralen > 0 && filep->f_pos >= np->n_raoffset &&
+      filep->f_pos < np->n_raoffset + np->n_ralen)
     {
-      /* Make sure that the attempted read size does not exceed the RPC maximum */
+      tmp = np->n_raoffset + np->n_ralen - filep->f_pos;
+      if (tmp > buflen)
+        {
+          tmp = buflen;
+        }
 
-      readsize = buflen - bytesread;
-      if (readsize > nmp->nm_rsize)
+      memcpy(buffer, np->n_rabuf + (filep->f_pos - np->n_raoffset), tmp);
+      filep->f_pos += tmp;
+      bytesread    += tmp;
+    }
+
+  /* If the file is being read sequentially and the request is not yet
+   * satisfied, then refill the read-ahead buffer in the same RPC window
+   * that fetches the rest of the request.
+   */
+
+  if (bytesread < buflen && sequential)
+    {
+      if (np->n_rabuf == NULL)
+        {
+          np->n_rabuf = (FAR uint8_t *)kmm_malloc(CONFIG_NFS_READAHEAD_SIZE);
+        }
+
+      np->n_ralen = 0;
+      if (np->n_rabuf != NULL)
         {
-          readsize = nmp->nm_rsize;
+          rabuf = np->n_rabuf;
+          ralen = CONFIG_NFS_READAHEAD_SIZE;
+
+          /* Don't read ahead beyond the (last known) end of the file */
+
+          tmp = np->n_size - (filep->f_pos + (buflen - bytesread));
+          if (ralen > tmp)
+            {
+              ralen = tmp;
+            }
         }
+    }
+#endif
 
-      /* Make sure that the attempted read size does not exceed the IO buffer size */
+  /* Read the rest of the request from the server */
 
-      tmp = SIZEOF_rpc_reply_read(readsize);
-      if (tmp > nmp->nm_buflen)
+  if (bytesread < buflen)
+    {
+      error = nfs_readrpcs(nmp, np, filep->f_pos, buffer + bytesread,
+                           buflen - bytesread, rabuf, ralen, &nread);
+      if (error != OK)
         {
-          readsize -= (tmp - nmp->nm_buflen);
+          ferr("ERROR: nfs_readrpcs failed: %d\n", error);
+          if (bytesread == 0)
+            {
+              goto errout_with_semaphore;
+            }
+
+          nread = 0;
         }
 
-      /* Initialize the request */
+#ifdef CONFIG_NFS_READAHEAD
+      /* Anything beyond the request was read ahead */
 
-      ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
-      reqlen  = 0;
+      if (nread > buflen - bytesread)
+        {
+          np->n_raoffset = filep->f_pos + (buflen - bytesread);
+          np->n_ralen    = nread - (buflen - bytesread);
+          nread          = buflen - bytesread;
+        }
+#endif
 
-      /* Copy the variable length, file handle */
+      filep->f_pos += nread;
+      bytesread    += nread;
+    }
 
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
+#ifdef CONFIG_NFS_READAHEAD
+  np->n_seqpos = filep->f_pos;
+#endif
 
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += (int)np->n_fhsize;
-      ptr    += uint32_increment((int)np->n_fhsize);
+  finfo("Read %d bytes\n", bytesread);
+  nfs_semgive(nmp);
+  return bytesread;
 
-      /* Copy the file offset */
+errout_with_semaphore:
+  nfs_semgive(nmp);
+  return -error;
+}
 
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr += 2;
-      reqlen += 2*sizeof(uint32_t);
+/****************************************************************************
+ * Name: nfs_writesend
+ *
+ * Description:
+ *   Send (or re-send) the WRITE RPC described by 'slot'.  Write is unique
+ *   among the RPC calls in that the call message lies in the I/O buffer.
+ *   The call is rebuilt from the user data on a retransmission so that only
+ *   one I/O buffer is needed however many WRITEs are outstanding.
+ *
+ * Returned Value:
+ *   0 on success; a positive errno value on failure.
+ *
+ ****************************************************************************/
 
-      /* Set the readsize */
+static int nfs_writesend(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                         FAR struct nfs_rpcslot_s *slot,
+                         FAR const char *data)
+{
+  FAR uint32_t *ptr;
+  size_t reqlen;
 
-      *ptr = txdr_unsigned(readsize);
-      reqlen += sizeof(uint32_t);
+  /* Initialize the request.  Here we need an offset pointer to the write
+   * arguments, skipping over the RPC header.
+   */
 
-      /* Perform the read */
+  ptr     = (FAR uint32_t *)&((FAR struct rpc_call_write *)nmp->nm_iobuffer)->write;
+  reqlen  = 0;
 
-      finfo("Reading %d bytes\n", readsize);
-      nfs_statistics(NFSPROC_READ);
-      error = nfs_request(nmp, NFSPROC_READ,
-                          (FAR void *)&nmp->nm_msgbuffer.read, reqlen,
-                          (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
-      if (error)
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += (int)np->n_fhsize;
+  ptr    += uint32_increment((int)np->n_fhsize);
+
+  /* Copy the file offset */
+
+  txdr_hyper((uint64_t)slot->offset, ptr);
+  ptr    += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Copy the count and stable values */
+
+  *ptr++  = txdr_unsigned(slot->len);
+  *ptr++  = txdr_unsigned(NFS_WRITE_STABLE);
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Copy a chunk of the user data into the I/O buffer */
+
+  *ptr++  = txdr_unsigned(slot->len);
+  reqlen += sizeof(uint32_t);
+  memcpy(ptr, data, slot->len);
+  reqlen += uint32_alignup(slot->len);
+
+  nfs_statistics(NFSPROC_WRITE);
+  return nfs_sendrequest(nmp, NFSPROC_WRITE, (FAR void *)nmp->nm_iobuffer,
+                         reqlen, &slot->xid);
+}
+
+/****************************************************************************
+ * Name: nfs_writerpcs
+ *
+ * Description:
+ *   Write 'buflen' bytes from 'buffer' at 'offset', keeping up to
+ *   CONFIG_NFS_MAX_OUTSTANDING WRITE RPCs in flight.  The number of
+ *   contiguous bytes written from 'offset' is returned in *nwritten.
+ *
+ * Returned Value:
+ *   0 on success; a positive errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_writerpcs(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                         off_t offset, FAR const char *buffer, size_t buflen,
+                         FAR size_t *nwritten)
+{
+  struct nfs_rpcslot_s slots[CONFIG_NFS_MAX_OUTSTANDING];
+  FAR struct nfs_rpcslot_s *slot;
+  FAR uint32_t *ptr;
+  size_t chunk;
+  size_t pos;
+  uint32_t tmp;
+  int nslots;
+  int ndone;
+  int retries;
+  int error;
+  int i;
+
+  /* Make sure that the write size does not exceed the RPC maximum or the
+   * IO buffer size.
+   */
+
+  chunk = nmp->nm_wsize;
+  tmp   = SIZEOF_rpc_call_write(chunk);
+  if (tmp > nmp->nm_buflen)
+    {
+      chunk -= (tmp - nmp->nm_buflen);
+    }
+
+  *nwritten = 0;
+  while (*nwritten < buflen)
+    {
+      /* Issue WRITEs for the next part of the user buffer */
+
+      for (nslots = 0, pos = *nwritten;
+           nslots < CONFIG_NFS_MAX_OUTSTANDING && pos < buflen;
+           nslots++)
         {
-          ferr("ERROR: nfs_request failed: %d\n", error);
-          goto errout_with_semaphore;
+          slot         = &slots[nslots];
+          slot->xid    = 0;
+          slot->offset = offset + pos;
+          slot->len    = buflen - pos > chunk ? chunk : buflen - pos;
+          slot->xfrd   = 0;
+          slot->done   = false;
+          slot->eof    = false;
+          pos         += slot->len;
+
+          error = nfs_writesend(nmp, np, slot,
+                                buffer + (slot->offset - offset));
+          if (error != OK)
+            {
+              ferr("ERROR: nfs_writesend failed: %d\n", error);
+              return error;
+            }
         }
 
-      /* The read was successful.  Get a pointer to the beginning of the NFS
-       * response data.
-       */
+      /* Collect the replies in whatever order they arrive */
 
-      ptr = (FAR uint32_t *)&((FAR struct rpc_reply_read *)nmp->nm_iobuffer)->read;
+      for (ndone = 0, retries = 0; ndone < nslots; )
+        {
+          error = nfs_nextreply(nmp, slots, nslots,
+                                &nmp->nm_msgbuffer.write,
+                                sizeof(struct rpc_reply_write), &i);
+          if (error == ETIMEDOUT && retries++ < nmp->nm_retry)
+            {
+              for (i = 0; i < nslots; i++)
+                {
+                  slot = &slots[i];
+                  if (!slot->done &&
+                      (error = nfs_writesend(nmp, np, slot,
+                               buffer + (slot->offset - offset))) != OK)
+                    {
+                      return error;
+                    }
+                }
 
-      /* Check if attributes are included in the responses */
+              continue;
+            }
+          else if (error != OK)
+            {
+              ferr("ERROR: WRITE failed: %d\n", error);
+              return error;
+            }
 
-      tmp = *ptr++;
-      if (*ptr != 0)
-        {
-          /* Yes... just skip over the attributes for now */
+          slot = &slots[i];
 
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
-        }
+          /* Get a pointer to the WRITE reply data */
 
-      /* This is followed by the count of data read.  Isn't this
-       * the same as the length that is included in the read data?
-       *
-       * Just skip over if for now.
-       */
+          ptr = (FAR uint32_t *)&nmp->nm_msgbuffer.write.write;
 
-      ptr++;
+          /* Parse file_wcc.  First, check if WCC attributes follow. */
 
-      /* Next comes an EOF indication.  Save that in tmp for now. */
+          if (*ptr++ != 0)
+            {
+              /* Yes.. WCC attributes follow.  But we just skip over them. */
 
-      tmp = *ptr++;
+              ptr += uint32_increment(sizeof(struct wcc_attr));
+            }
 
-      /* Then the length of the read data followed by the read data itself */
+          /* Check if normal file attributes follow */
 
-      readsize = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
+          if (*ptr++ != 0)
+            {
+              /* Yes.. Update the cached file status in the file structure. */
 
-      /* Copy the read data into the user buffer */
+              nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+              ptr += uint32_increment(sizeof(struct nfs_fattr));
+            }
 
-      memcpy(buffer, ptr, readsize);
+          /* Get the count of bytes actually written */
 
-      /* Update the read state data */
+          tmp = fxdr_unsigned(uint32_t, *ptr);
+          ptr++;
 
-      filep->f_pos += readsize;
-      bytesread    += readsize;
-      buffer       += readsize;
+          if (tmp < 1 || tmp > slot->len)
+            {
+              return EIO;
+            }
 
-      /* Check if we hit the end of file */
+#ifdef CONFIG_NFS_WRITEBEHIND
+          /* If the data is not yet on stable storage, remember the write
+           * verifier.  A different verifier means that the server has
+           * rebooted and may have lost earlier UNSTABLE writes.
+           */
 
-      if (tmp != 0)
+          if (fxdr_unsigned(uint32_t, *ptr) != NFSV3WRITE_FILESYNC)
+            {
+              ptr++;
+              if ((np->n_flags & NFSNODE_UNSTABLE) == 0)
+                {
+                  memcpy(np->n_verf, ptr, NFSX_V3WRITEVERF);
+                  np->n_flags |= NFSNODE_UNSTABLE;
+                }
+              else if (memcmp(np->n_verf, ptr, NFSX_V3WRITEVERF) != 0)
+                {
+                  np->n_flags |= NFSNODE_VERFERR;
+                }
+            }
+#endif
+
+          slot->xfrd = tmp;
+          slot->done = true;
+          ndone++;
+        }
+
+      /* Accept the writes in file order up to the first short write */
+
+      for (i = 0; i < nslots; i++)
         {
-          break;
+          *nwritten += slots[i].xfrd;
+          if (slots[i].xfrd < slots[i].len)
+            {
+              return OK;
+            }
         }
     }
 
-  finfo("Read %d bytes\n", bytesread);
-  nfs_semgive(nmp);
-  return bytesread;
-
-errout_with_semaphore:
-  nfs_semgive(nmp);
-  return -error;
+  return OK;
 }
 
 /****************************************************************************
@@ -968,14 +1513,7 @@ static ssize_t nfs_write(FAR struct file *filep, const char *buffer,
 {
   struct nfsmount       *nmp;
   struct nfsnode        *np;
-  ssize_t                writesize;
-  ssize_t                bufsize;
-  ssize_t                byteswritten;
-  size_t                 reqlen;
-  FAR uint32_t          *ptr;
-  uint32_t               tmp;
-  int                    commit = 0;
-  int                    committed = NFSV3WRITE_FILESYNC;
+  size_t                 byteswritten;
   int                    error;
 
   finfo("Write %d bytes to offset %d\n", buflen, filep->f_pos);
@@ -1009,140 +1547,166 @@ static ssize_t nfs_write(FAR struct file *filep, const char *buffer,
       goto errout_with_semaphore;
     }
 
-  /* Now loop until we send the entire user buffer */
+  /* Any read-ahead data and cached attributes are now stale */
 
-  writesize = 0;
-  for (byteswritten = 0; byteswritten < buflen; )
-    {
-      /* Make sure that the attempted write size does not exceed the RPC maximum */
-
-      writesize = buflen;
-      if (writesize > nmp->nm_wsize)
-        {
-          writesize = nmp->nm_wsize;
-        }
+#ifdef CONFIG_NFS_READAHEAD
+  np->n_ralen = 0;
+#endif
+  nfs_lcache_flush(nmp);
 
-      /* Make sure that the attempted read size does not exceed the IO buffer size */
+  /* Send the entire user buffer */
 
-      bufsize = SIZEOF_rpc_call_write(writesize);
-      if (bufsize > nmp->nm_buflen)
+  error = nfs_writerpcs(nmp, np, filep->f_pos, buffer, buflen,
+                        &byteswritten);
+  if (error != OK)
+    {
+      ferr("ERROR: nfs_writerpcs failed: %d\n", error);
+      if (byteswritten == 0)
         {
-          writesize -= (bufsize - nmp->nm_buflen);
+          goto errout_with_semaphore;
         }
+    }
 
-      /* Initialize the request.  Here we need an offset pointer to the write
-       * arguments, skipping over the RPC header.  Write is unique among the
-       * RPC calls in that the entry RPC calls messasge lies in the I/O buffer
-       */
+  /* Update the file position and, if the file was extended, its size */
 
-      ptr     = (FAR uint32_t *)&((FAR struct rpc_call_write *)nmp->nm_iobuffer)->write;
-      reqlen  = 0;
+  filep->f_pos += byteswritten;
+  if (filep->f_pos > np->n_size)
+    {
+      np->n_size = filep->f_pos;
+    }
 
-      /* Copy the variable length, file handle */
+  nfs_semgive(nmp);
+  return byteswritten;
 
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
+errout_with_semaphore:
+  nfs_semgive(nmp);
+  return -error;
+}
 
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += (int)np->n_fhsize;
-      ptr    += uint32_increment((int)np->n_fhsize);
+#ifdef CONFIG_NFS_WRITEBEHIND
+/****************************************************************************
+ * Name: nfs_commit
+ *
+ * Description:
+ *   Commit all UNSTABLE writes to the file to stable storage on the server
+ *   with a single COMMIT RPC.
+ *
+ * Returned Value:
+ *   0 on success; a positive errno value on failure.  EIO is returned if
+ *   the server's write verifier changed, meaning that data written since
+ *   the last commit may have been lost.
+ *
+ ****************************************************************************/
 
-      /* Copy the file offset */
+static int nfs_commit(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  FAR uint32_t *ptr;
+  size_t reqlen;
+  int error;
 
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr    += 2;
-      reqlen += 2*sizeof(uint32_t);
+  if ((np->n_flags & NFSNODE_UNSTABLE) == 0)
+    {
+      return OK;
+    }
 
-      /* Copy the count and stable values */
+  /* Initialize the request */
 
-      *ptr++  = txdr_unsigned(buflen);
-      *ptr++  = txdr_unsigned(committed);
-      reqlen += 2*sizeof(uint32_t);
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.commit.commit;
+  reqlen  = 0;
 
-      /* Copy a chunk of the user data into the I/O buffer */
+  /* Copy the variable length, file handle */
 
-      *ptr++  = txdr_unsigned(buflen);
-      reqlen += sizeof(uint32_t);
-      memcpy(ptr, buffer, writesize);
-      reqlen += uint32_alignup(writesize);
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
 
-      /* Perform the write */
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += (int)np->n_fhsize;
+  ptr    += uint32_increment((int)np->n_fhsize);
 
-      nfs_statistics(NFSPROC_WRITE);
-      error = nfs_request(nmp, NFSPROC_WRITE,
-                          (FAR void *)nmp->nm_iobuffer, reqlen,
-                          (FAR void *)&nmp->nm_msgbuffer.write, sizeof(struct rpc_reply_write));
-      if (error)
-        {
-          ferr("ERROR: nfs_request failed: %d\n", error);
-          goto errout_with_semaphore;
-        }
+  /* An offset and count of zero commit the entire file */
 
-      /* Get a pointer to the WRITE reply data */
+  txdr_hyper((uint64_t)0, ptr);
+  ptr    += 2;
+  reqlen += 2*sizeof(uint32_t);
 
-      ptr = (FAR uint32_t *)&nmp->nm_msgbuffer.write.write;
+  *ptr    = 0;
+  reqlen += sizeof(uint32_t);
 
-      /* Parse file_wcc.  First, check if WCC attributes follow. */
+  nfs_statistics(NFSPROC_COMMIT);
+  error = nfs_request(nmp, NFSPROC_COMMIT,
+                      (FAR void *)&nmp->nm_msgbuffer.commit, reqlen,
+                      (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
+  if (error != OK)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", error);
+      return error;
+    }
 
-      tmp = *ptr++;
-      if (tmp != 0)
-        {
-          /* Yes.. WCC attributes follow.  But we just skip over them. */
+  /* Skip over file_wcc to get the verifier */
 
-          ptr += uint32_increment(sizeof(struct wcc_attr));
-        }
+  ptr = (FAR uint32_t *)&((FAR struct rpc_reply_commit *)nmp->nm_iobuffer)->commit;
 
-      /* Check if normal file attributes follow */
+  if (*ptr++ != 0)
+    {
+      ptr += uint32_increment(sizeof(struct wcc_attr));
+    }
 
-      tmp = *ptr++;
-      if (tmp != 0)
-        {
-          /* Yes.. Update the cached file status in the file structure. */
+  if (*ptr++ != 0)
+    {
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
+    }
 
-          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
-        }
+  if ((np->n_flags & NFSNODE_VERFERR) != 0 ||
+      memcmp(np->n_verf, ptr, NFSX_V3WRITEVERF) != 0)
+    {
+      ferr("ERROR: Write verifier changed; data may have been lost\n");
+      error = EIO;
+    }
 
-      /* Get the count of bytes actually written */
+  np->n_flags &= ~(NFSNODE_UNSTABLE | NFSNODE_VERFERR);
+  return error;
+}
 
-      tmp = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
+/****************************************************************************
+ * Name: nfs_sync
+ *
+ * Description:
+ *   Synchronize the file state on disk to match internal, in-memory state.
+ *
+ * Returned Value:
+ *   0 on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
 
-      if (tmp < 1 || tmp > writesize)
-        {
-           error = EIO;
-           goto errout_with_semaphore;
-        }
+static int nfs_sync(FAR struct file *filep)
+{
+  FAR struct nfsmount *nmp;
+  FAR struct nfsnode  *np;
+  int error;
 
-      writesize = tmp;
+  DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
 
-      /* Determine the lowest committment level obtained by any of the RPCs. */
+  /* Recover our private data from the struct file instance */
 
-      commit = *ptr++;
-      if (committed == NFSV3WRITE_FILESYNC)
-        {
-          committed = commit;
-        }
-      else if (committed == NFSV3WRITE_DATASYNC &&
-               commit == NFSV3WRITE_UNSTABLE)
-        {
-          committed = commit;
-        }
+  nmp = (FAR struct nfsmount *)filep->f_inode->i_private;
+  np  = (FAR struct nfsnode *)filep->f_priv;
 
-      /* Update the read state data */
+  DEBUGASSERT(nmp != NULL);
 
-      filep->f_pos += writesize;
-      byteswritten += writesize;
-      buffer       += writesize;
-    }
+  /* Make sure that the mount is still healthy */
 
-  nfs_semgive(nmp);
-  return writesize;
+  nfs_semtake(nmp);
+  error = nfs_checkmount(nmp);
+  if (error == OK)
+    {
+      error = nfs_commit(nmp, np);
+    }
 
-errout_with_semaphore:
   nfs_semgive(nmp);
   return -error;
 }
+#endif
 
 /****************************************************************************
  * Name: nfs_dup
@@ -1315,6 +1879,9 @@ static int nfs_truncate(FAR struct file *filep, off_t length)
 
   /* Then perform the SETATTR RPC to set the new file size */
 
+#ifdef CONFIG_NFS_READAHEAD
+  np->n_ralen = 0;
+#endif
   error = nfs_filetruncate(nmp, np, length);
 
 errout_with_semaphore:
@@ -2322,6 +2889,7 @@ static int nfs_remove(struct inode *mountpt, const char *relpath)
   /* Perform the REMOVE RPC call */
 
   nfs_statistics(NFSPROC_REMOVE);
+  nfs_lcache_flush(nmp);
   error = nfs_request(nmp, NFSPROC_REMOVE,
                       (FAR void *)&nmp->nm_msgbuffer.removef, reqlen,
                       (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
@@ -2445,6 +3013,7 @@ static int nfs_mkdir(struct inode *mountpt, const char *relpath, mode_t mode)
   /* Perform the MKDIR RPC */
 
   nfs_statistics(NFSPROC_MKDIR);
+  nfs_lcache_flush(nmp);
   error = nfs_request(nmp, NFSPROC_MKDIR,
                       (FAR void *)&nmp->nm_msgbuffer.mkdir, reqlen,
                       (FAR void *)&nmp->nm_iobuffer, nmp->nm_buflen);
@@ -2534,6 +3103,7 @@ static int nfs_rmdir(struct inode *mountpt, const char *relpath)
   /* Perform the RMDIR RPC */
 
   nfs_statistics(NFSPROC_RMDIR);
+  nfs_lcache_flush(nmp);
   error = nfs_request(nmp, NFSPROC_RMDIR,
                           (FAR void *)&nmp->nm_msgbuffer.rmdir, reqlen,
                           (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
@@ -2651,6 +3221,7 @@ static int nfs_rename(struct inode *mountpt, const char *oldrelpath,
   /* Perform the RENAME RPC */
 
   nfs_statistics(NFSPROC_RENAME);
+  nfs_lcache_flush(nmp);
   error = nfs_request(nmp, NFSPROC_RENAME,
                       (FAR void *)&nmp->nm_msgbuffer.renamef, reqlen,
                       (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
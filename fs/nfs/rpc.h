@@ -294,6 +294,12 @@ struct rpc_call_write
 };
 #define SIZEOF_rpc_call_write(n) (sizeof(struct rpc_call_header) + SIZEOF_WRITE3args(n))
 
+struct rpc_call_commit
+{
+  struct rpc_call_header ch;
+  struct COMMIT3args commit;
+};
+
 struct rpc_call_remove
 {
   struct rpc_call_header ch;
@@ -395,6 +401,13 @@ struct rpc_reply_write
   struct WRITE3resok write;      /* Variable length */
 };
 
+struct rpc_reply_commit
+{
+  struct rpc_reply_header rh;
+  uint32_t status;
+  struct COMMIT3resok commit;
+};
+
 struct rpc_reply_read
 {
   struct rpc_reply_header rh;
@@ -500,5 +513,10 @@ void rpcclnt_safedisconnect(FAR struct rpcclnt *rpc);
 int  rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog, int version,
                      FAR void *request, size_t reqlen,
                      FAR void *response, size_t resplen);
+int  rpcclnt_sendrequest(FAR struct rpcclnt *rpc, int procnum, int prog,
+                         int version, FAR void *request, size_t reqlen,
+                         FAR uint32_t *xid);
+int  rpcclnt_getreply(FAR struct rpcclnt *rpc, FAR void *response,
+                      size_t resplen, FAR uint32_t *xid);
 
 #endif /* __FS_NFS_RPC_H */
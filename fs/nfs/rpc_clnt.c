@@ -139,6 +139,7 @@ static int rpcclnt_receive(FAR struct rpcclnt *rpc, struct sockaddr *aname,
                            int proc, int program, void *reply, size_t resplen);
 static int rpcclnt_reply(FAR struct rpcclnt *rpc, int procid, int prog,
                          void *reply, size_t resplen);
+static int rpcclnt_checkreply(FAR struct rpc_reply_header *replymsg);
 static uint32_t rpcclnt_newxid(void);
 static void rpcclnt_fmtheader(FAR struct rpc_call_header *ch,
                               uint32_t xid, int procid, int prog, int vers);
@@ -258,6 +259,63 @@ static int rpcclnt_reply(FAR struct rpcclnt *rpc, int procid, int prog,
   return error;
 }
 
+/****************************************************************************
+ * Name: rpcclnt_checkreply
+ *
+ * Description:
+ *   Break down the RPC header of a received reply and check if it is OK.
+ *
+ * Returned Value:
+ *   Returns zero on success or a (positive) errno value on failure.
+ *
+ ****************************************************************************/
+
+static int rpcclnt_checkreply(FAR struct rpc_reply_header *replymsg)
+{
+  uint32_t tmp;
+
+  tmp = fxdr_unsigned(uint32_t, replymsg->type);
+  if (tmp == RPC_MSGDENIED)
+    {
+      tmp = fxdr_unsigned(uint32_t, replymsg->status);
+      switch (tmp)
+        {
+        case RPC_MISMATCH:
+          ferr("ERROR: RPC_MSGDENIED: RPC_MISMATCH error\n");
+          return EOPNOTSUPP;
+
+        case RPC_AUTHERR:
+          ferr("ERROR: RPC_MSGDENIED: RPC_AUTHERR error\n");
+          return EACCES;
+
+        default:
+          return EOPNOTSUPP;
+        }
+    }
+  else if (tmp != RPC_MSGACCEPTED)
+    {
+      return EOPNOTSUPP;
+    }
+
+  tmp = fxdr_unsigned(uint32_t, replymsg->status);
+  if (tmp == RPC_SUCCESS)
+    {
+      finfo("RPC_SUCCESS\n");
+    }
+  else if (tmp == RPC_PROGMISMATCH)
+    {
+      ferr("ERROR: RPC_MSGACCEPTED: RPC_PROGMISMATCH error\n");
+      return EOPNOTSUPP;
+    }
+  else if (tmp > 5)
+    {
+      ferr("ERROR: Unsupported RPC type: %d\n", tmp);
+      return EOPNOTSUPP;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: rpcclnt_newxid
  *
@@ -695,8 +753,6 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
                     int version, FAR void *request, size_t reqlen,
                     FAR void *response, size_t resplen)
 {
-  struct rpc_reply_header *replymsg;
-  uint32_t tmp;
   uint32_t xid;
   int retries;
   int error = 0;
@@ -737,15 +793,24 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
           finfo("ERROR rpcclnt_send failed: %d\n", error);
         }
 
-      /* Wait for the reply from our send */
+      /* Wait for the reply from our send.  Replies to earlier, timed-out
+       * transmissions may still be queued on the socket; discard any reply
+       * that does not carry our xid.
+       */
 
       else
         {
-          error = rpcclnt_reply(rpc, procnum, prog, response, resplen);
-          if (error != OK)
+          do
             {
-              finfo("ERROR rpcclnt_reply failed: %d\n", error);
+              error = rpcclnt_reply(rpc, procnum, prog, response, resplen);
+              if (error != OK)
+                {
+                  finfo("ERROR rpcclnt_reply failed: %d\n", error);
+                  break;
+                }
             }
+          while (((FAR struct rpc_reply_header *)response)->rp_xid !=
+                 txdr_unsigned(xid));
         }
 
       retries++;
@@ -760,46 +825,77 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
 
   /* Break down the RPC header and check if it is OK */
 
-  replymsg = (FAR struct rpc_reply_header *)response;
-
-  tmp = fxdr_unsigned(uint32_t, replymsg->type);
-  if (tmp == RPC_MSGDENIED)
-    {
-      tmp = fxdr_unsigned(uint32_t, replymsg->status);
-      switch (tmp)
-        {
-        case RPC_MISMATCH:
-          ferr("ERROR: RPC_MSGDENIED: RPC_MISMATCH error\n");
-          return EOPNOTSUPP;
+  return rpcclnt_checkreply((FAR struct rpc_reply_header *)response);
+}
 
-        case RPC_AUTHERR:
-          ferr("ERROR: RPC_MSGDENIED: RPC_AUTHERR error\n");
-          return EACCES;
+/****************************************************************************
+ * Name: rpcclnt_sendrequest
+ *
+ * Description:
+ *   Format and send an RPC CALL message without waiting for the reply.
+ *   This allows several calls to be outstanding at the same time; the
+ *   replies are then collected with rpcclnt_getreply() and matched to the
+ *   calls by their xid.
+ *
+ *   If *xid is zero, a new xid is assigned and returned in *xid.
+ *   Otherwise, the call is a retransmission and the given xid is re-used
+ *   so that a late reply to the original transmission is still accepted.
+ *
+ * Returned Value:
+ *   Returns zero on success or a (positive) errno value on failure.
+ *
+ ****************************************************************************/
 
-        default:
-          return EOPNOTSUPP;
-        }
-    }
-  else if (tmp != RPC_MSGACCEPTED)
+int rpcclnt_sendrequest(FAR struct rpcclnt *rpc, int procnum, int prog,
+                        int version, FAR void *request, size_t reqlen,
+                        FAR uint32_t *xid)
+{
+  if (*xid == 0)
     {
-      return EOPNOTSUPP;
+      *xid = rpcclnt_newxid();
     }
 
-  tmp = fxdr_unsigned(uint32_t, replymsg->status);
-  if (tmp == RPC_SUCCESS)
-    {
-      finfo("RPC_SUCCESS\n");
-    }
-  else if (tmp == RPC_PROGMISMATCH)
-    {
-      ferr("ERROR: RPC_MSGACCEPTED: RPC_PROGMISMATCH error\n");
-      return EOPNOTSUPP;
-    }
-  else if (tmp > 5)
+  rpcclnt_fmtheader((FAR struct rpc_call_header *)request,
+                    *xid, prog, version, procnum);
+
+  rpc_statistics(rpcrequests);
+  return rpcclnt_send(rpc, procnum, prog, request,
+                      reqlen + sizeof(struct rpc_call_header));
+}
+
+/****************************************************************************
+ * Name: rpcclnt_getreply
+ *
+ * Description:
+ *   Receive the next RPC reply from the socket, whichever call it belongs
+ *   to, and return its xid in *xid.  rc_timeout is set if no reply was
+ *   received before the socket timeout expired; the caller is then
+ *   responsible for retransmitting any calls that are still outstanding.
+ *
+ * Returned Value:
+ *   Returns zero on success or a (positive) errno value on failure.  *xid
+ *   is valid whenever a reply was received, even if that reply reports an
+ *   RPC-level error.
+ *
+ ****************************************************************************/
+
+int rpcclnt_getreply(FAR struct rpcclnt *rpc, FAR void *response,
+                     size_t resplen, FAR uint32_t *xid)
+{
+  FAR struct rpc_reply_header *replymsg;
+  int error;
+
+  rpc->rc_timeout = false;
+  *xid            = 0;
+
+  error = rpcclnt_reply(rpc, 0, 0, response, resplen);
+  if (error != OK)
     {
-      ferr("ERROR: Unsupported RPC type: %d\n", tmp);
-      return EOPNOTSUPP;
+      return error;
     }
 
-  return OK;
+  replymsg = (FAR struct rpc_reply_header *)response;
+  *xid     = fxdr_unsigned(uint32_t, replymsg->rp_xid);
+
+  return rpcclnt_checkreply(replymsg);
 }
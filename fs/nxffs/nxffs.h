@@ -52,6 +52,9 @@
 
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/fs/nxffs.h>
+#ifdef CONFIG_NXFFS_BGPACK
+#  include <nuttx/wqueue.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -302,6 +305,13 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+  bool                      cdirty;    /* Cache holds data not yet written to FLASH */
+#endif
+#ifdef CONFIG_NXFFS_BGPACK
+  bool                      pkpend;    /* Deleted inodes may be reclaimed by packing */
+  struct work_s             pkwork;    /* Supports background packing */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -508,6 +518,29 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block);
 
 int nxffs_wrcache(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_flushcache
+ *
+ * Description:
+ *   Write the volume cache memory to FLASH if it holds partial data block
+ *   content that has not yet been written (CONFIG_NXFFS_WRITEBUFFER).
+ *
+ * Input Parameters:
+ *   volume - Describes the current volume
+ *
+ * Returned Value:
+ *   Negated errnos are returned only in the case of MTD reported failures.
+ *
+ * Defined in nxffs_cache.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+int nxffs_flushcache(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_flushcache(v) (OK)
+#endif
+
 /****************************************************************************
  * Name: nxffs_ioseek
  *
@@ -1082,6 +1115,29 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name);
 
 int nxffs_pack(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_bgpack
+ *
+ * Description:
+ *   Schedule packing on the low priority work queue if inodes have been
+ *   deleted and the free FLASH space has dropped below
+ *   CONFIG_NXFFS_BGPACK_THRESHOLD.  The caller must hold the volume
+ *   exclsem.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BGPACK
+void nxffs_bgpack(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_bgpack(v)
+#endif
+
 /****************************************************************************
  * Standard mountpoint operation methods
  *
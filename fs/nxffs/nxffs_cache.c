@@ -88,11 +88,24 @@
 int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block)
 {
   size_t nxfrd;
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+  int ret;
+#endif
 
   /* Check if the requested data is already in the cache */
 
   if (block != volume->cblock)
     {
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+      /* Write back any partial data block before the cache is re-used */
+
+      ret = nxffs_flushcache(volume);
+      if (ret < 0)
+        {
+          return ret;
+        }
+#endif
+
       /* Read the specified blocks into cache */
 
       nxfrd = MTD_BREAD(volume->mtd, block, 1, volume->cache);
@@ -139,9 +152,39 @@ int nxffs_wrcache(FAR struct nxffs_volume_s *volume)
 
   /* Write was successful */
 
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+  volume->cdirty = false;
+#endif
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxffs_flushcache
+ *
+ * Description:
+ *   Write the volume cache memory to FLASH if it holds partial data block
+ *   content that has not yet been written.
+ *
+ * Input Parameters:
+ *   volume - Describes the current volume
+ *
+ * Returned Value:
+ *   Negated errnos are returned only in the case of MTD reported failures.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+int nxffs_flushcache(FAR struct nxffs_volume_s *volume)
+{
+  if (volume->cdirty)
+    {
+      return nxffs_wrcache(volume);
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: nxffs_ioseek
  *
@@ -870,6 +870,18 @@ static inline int nxffs_wrclose(FAR struct nxffs_volume_s *volume,
 
   if (wrfile->datlen > 0)
     {
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+      /* Make sure that the partial data block is in the cache */
+
+      nxffs_ioseek(volume, wrfile->doffset);
+      ret = nxffs_rdcache(volume, volume->ioblock);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to read the final block of the file: %d\n", -ret);
+          goto errout;
+        }
+#endif
+
       /* Yes.. Write the final file block header */
 
       ret = nxffs_wrblkhdr(volume, wrfile);
@@ -902,6 +914,14 @@ static inline int nxffs_wrclose(FAR struct nxffs_volume_s *volume,
   /* Write the inode header to FLASH */
 
   ret = nxffs_wrinode(volume, &wrfile->ofile.entry);
+#ifdef CONFIG_NXFFS_BGPACK
+  if (ret == OK)
+    {
+      /* Packing may have been deferred while this file was open */
+
+      nxffs_bgpack(volume);
+    }
+#endif
 
   /* The volume is now available for other writers */
 
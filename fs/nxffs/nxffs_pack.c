@@ -48,6 +48,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 
 #include "nxffs.h"
 
@@ -1243,6 +1244,47 @@ static inline int nxffs_packwriter(FAR struct nxffs_volume_s *volume,
   return -ENOSYS;
 }
 
+/****************************************************************************
+ * Name: nxffs_pkworker
+ *
+ * Description:
+ *   Pack the volume on the low priority work queue.  Packing is skipped
+ *   while a file is open for writing; closing that file will schedule the
+ *   work again.
+ *
+ * Input Parameters:
+ *   arg - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BGPACK
+static void nxffs_pkworker(FAR void *arg)
+{
+  FAR struct nxffs_volume_s *volume = (FAR struct nxffs_volume_s *)arg;
+  int ret;
+
+  nxsem_wait_uninterruptible(&volume->exclsem);
+
+  if (nxffs_findwriter(volume) == NULL)
+    {
+      finfo("Background packing\n");
+
+      ret = nxffs_pack(volume);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to pack the volume: %d\n", -ret);
+        }
+
+      volume->pkpend = false;
+    }
+
+  nxsem_post(&volume->exclsem);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1274,6 +1316,17 @@ int nxffs_pack(FAR struct nxffs_volume_s *volume)
   int i;
   int ret = OK;
 
+  /* Packing reads the media directly, so any partial data block held in
+   * the cache must be on FLASH first.
+   */
+
+  ret = nxffs_flushcache(volume);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to flush the cache: %d\n", -ret);
+      return ret;
+    }
+
   /* Get the offset to the first valid inode entry */
 
   wrfile = NULL;
@@ -1601,3 +1654,33 @@ errout_with_pack:
   nxffs_freeentry(&pack.dest.entry);
   return ret;
 }
+
+/****************************************************************************
+ * Name: nxffs_bgpack
+ *
+ * Description:
+ *   Schedule packing on the low priority work queue if inodes have been
+ *   deleted and the free FLASH space has dropped below
+ *   CONFIG_NXFFS_BGPACK_THRESHOLD.  The caller must hold the volume
+ *   exclsem.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BGPACK
+void nxffs_bgpack(FAR struct nxffs_volume_s *volume)
+{
+  off_t total = volume->nblocks * volume->geo.blocksize;
+
+  if (volume->pkpend && work_available(&volume->pkwork) &&
+      total - volume->froffset < total / 100 * CONFIG_NXFFS_BGPACK_THRESHOLD)
+    {
+      (void)work_queue(LPWORK, &volume->pkwork, nxffs_pkworker, volume, 0);
+    }
+}
+#endif
@@ -130,6 +130,15 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name)
       ferr("ERROR: Failed to write block %d: %d\n",
            volume->ioblock, ret);
     }
+#ifdef CONFIG_NXFFS_BGPACK
+  else
+    {
+      /* The deleted inode can now be reclaimed by packing */
+
+      volume->pkpend = true;
+      nxffs_bgpack(volume);
+    }
+#endif
 
 errout_with_entry:
   nxffs_freeentry(&entry);
@@ -387,12 +387,21 @@ static inline ssize_t nxffs_wrappend(FAR struct nxffs_volume_s *volume,
 
       if (nbytesleft > 0)
         {
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+          /* Just leave the partial block in the cache.  It is written when
+           * the data block fills, when the file is closed, or when the
+           * cache is needed for some other block.
+           */
+
+          volume->cdirty = true;
+#else
           ret = nxffs_wrcache(volume);
           if (ret < 0)
             {
               ferr("ERROR: nxffs_wrcache failed: %d\n", -ret);
               return ret;
             }
+#endif
         }
     }
 
@@ -591,6 +600,20 @@ ssize_t nxffs_write(FAR struct file *filep, FAR const char *buffer, size_t bufle
 
       nxffs_ioseek(volume, wrfile->doffset);
 
+#ifdef CONFIG_NXFFS_WRITEBUFFER
+      /* Other accesses may have re-used the cache since the last write.  If
+       * so, the partial data block was written back and must be re-read.
+       */
+
+      ret = nxffs_rdcache(volume, volume->ioblock);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to read data block %d: %d\n",
+               volume->ioblock, -ret);
+          goto errout_with_semaphore;
+        }
+#endif
+
       /* Verify that the FLASH data that was previously written is still intact */
 
       ret = nxffs_reverify(volume, wrfile);
@@ -78,10 +78,14 @@
 
 extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
+extern const struct procfs_operations bootphase_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations iobinfo_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations objpool_operations;
+extern const struct procfs_operations taskstats_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 
@@ -122,6 +126,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "[0-9]*",        &proc_operations,            PROCFS_DIR_TYPE    },
 #endif
 
+#if defined(CONFIG_SCHED_BOOTPHASE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BOOTPHASE)
+  { "bootphase",     &bootphase_operations,       PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CPULOAD)
   { "cpuload",       &cpuload_operations,         PROCFS_FILE_TYPE   },
 #endif
@@ -130,6 +138,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "critmon",       &critmon_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_IOB_QUOTAS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  { "iobinfo",       &iobinfo_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #ifdef CONFIG_SCHED_IRQMONITOR
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
 #endif
@@ -167,6 +179,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "net/**",        &net_procfsoperations,       PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_MM_OBJPOOL) && !defined(CONFIG_FS_PROCFS_EXCLUDE_OBJPOOL)
+  { "objpool",       &objpool_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MTD_PARTITION) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PARTITIONS)
   { "partitions",    &part_procfsoperations,      PROCFS_FILE_TYPE   },
 #endif
@@ -176,6 +192,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "self/**",       &proc_operations,            PROCFS_UNKOWN_TYPE },
 #endif
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_TASKSTATS
+  { "taskstats",     &taskstats_operations,       PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -0,0 +1,325 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsbootphase.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/init.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_BOOTPHASE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BOOTPHASE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define BOOTPHASE_LINELEN 64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct bootphase_file_s
+{
+  struct procfs_file_s  base;        /* Base open file structure */
+  char line[BOOTPHASE_LINELEN];      /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     bootphase_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     bootphase_close(FAR struct file *filep);
+static ssize_t bootphase_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     bootphase_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     bootphase_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations bootphase_operations =
+{
+  bootphase_open,    /* open */
+  bootphase_close,   /* close */
+  bootphase_read,    /* read */
+  NULL,              /* write */
+
+  bootphase_dup,     /* dup */
+
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+
+  bootphase_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bootphase_open
+ ****************************************************************************/
+
+static int bootphase_open(FAR struct file *filep, FAR const char *relpath,
+                          int oflags, mode_t mode)
+{
+  FAR struct bootphase_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "bootphase" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "bootphase") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct bootphase_file_s *)
+    kmm_zalloc(sizeof(struct bootphase_file_s));
+
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bootphase_close
+ ****************************************************************************/
+
+static int bootphase_close(FAR struct file *filep)
+{
+  FAR struct bootphase_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct bootphase_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bootphase_read
+ *
+ * Description:
+ *   Return one line per recorded boot phase:  The time in microseconds from
+ *   entry into os_start() to the end of the phase, the CPU that recorded
+ *   it, and the name of the phase.  The phases are never modified once
+ *   recorded, so the output is stable across partial reads.
+ *
+ ****************************************************************************/
+
+static ssize_t bootphase_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct bootphase_file_s *attr;
+  FAR const char *name;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  uint32_t usec;
+  int cpu;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct bootphase_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  linesize  = snprintf(attr->line, BOOTPHASE_LINELEN, "%10s %3s  %s\n",
+                       "usec", "cpu", "phase");
+  copysize  = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+  totalsize = copysize;
+
+  for (i = 0;
+       totalsize < buflen && os_bootphase_get(i, &name, &usec, &cpu) == OK;
+       i++)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(attr->line, BOOTPHASE_LINELEN, "%10lu %3d  %s\n",
+                            (unsigned long)usec, cpu, name);
+      copysize   = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: bootphase_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int bootphase_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct bootphase_file_s *oldattr;
+  FAR struct bootphase_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct bootphase_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct bootphase_file_s *)
+    kmm_malloc(sizeof(struct bootphase_file_s));
+
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct bootphase_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bootphase_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int bootphase_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "bootphase" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "bootphase") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "bootphase" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_SCHED_BOOTPHASE && !CONFIG_FS_PROCFS_EXCLUDE_BOOTPHASE */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -55,6 +55,7 @@
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -70,7 +71,13 @@
  * to handle the longest line generated by this logic.
  */
 
-#define CRITMON_LINELEN 64
+#define CRITMON_LINELEN 80
+
+#ifdef CONFIG_SMP_NCPUS
+#  define CRITMON_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define CRITMON_NCPUS 1
+#endif
 
 /****************************************************************************
  * Private Types
@@ -83,6 +90,10 @@ struct critmon_file_s
   struct procfs_file_s  base;   /* Base open file structure */
   unsigned int linesize;        /* Number of valid characters in line[] */
   char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+  struct critmon_hotspots_s premp[CRITMON_NCPUS]; /* Snapshot at offset 0 */
+  struct critmon_hotspots_s crit[CRITMON_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -196,6 +207,141 @@ static int critmon_close(FAR struct file *filep)
   return OK;
 }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+/****************************************************************************
+ * Name: critmon_sort
+ *
+ * Description:
+ *   Sort a hot spot table by descending maximum time (longest == true) or
+ *   by descending count.
+ *
+ ****************************************************************************/
+
+static void critmon_sort(FAR struct critmon_hotspot_s *table, bool longest)
+{
+  struct critmon_hotspot_s tmp;
+  int i;
+  int j;
+
+  for (i = 1; i < CONFIG_SCHED_CRITMONITOR_NHOTSPOTS; i++)
+    {
+      tmp = table[i];
+      for (j = i;
+           j > 0 && (longest ? table[j - 1].max < tmp.max :
+                               table[j - 1].count < tmp.count);
+           j--)
+        {
+          table[j] = table[j - 1];
+        }
+
+      table[j] = tmp;
+    }
+}
+
+/****************************************************************************
+ * Name: critmon_snapshot
+ *
+ * Description:
+ *   Take a sorted snapshot of the hot spot tables and reset them.  This is
+ *   done when the file is read from the beginning so that the tables do not
+ *   change between the partial reads of the same output.
+ *
+ ****************************************************************************/
+
+static void critmon_snapshot(FAR struct critmon_file_s *attr)
+{
+  irqstate_t flags;
+  int cpu;
+
+  flags = enter_critical_section();
+  memcpy(attr->premp, g_premp_hotspots, sizeof(attr->premp));
+  memcpy(attr->crit, g_crit_hotspots, sizeof(attr->crit));
+  memset(g_premp_hotspots, 0, sizeof(g_premp_hotspots));
+  memset(g_crit_hotspots, 0, sizeof(g_crit_hotspots));
+  leave_critical_section(flags);
+
+  for (cpu = 0; cpu < CRITMON_NCPUS; cpu++)
+    {
+      critmon_sort(attr->premp[cpu].longest, true);
+      critmon_sort(attr->premp[cpu].frequent, false);
+      critmon_sort(attr->crit[cpu].longest, true);
+      critmon_sort(attr->crit[cpu].frequent, false);
+    }
+}
+
+/****************************************************************************
+ * Name: critmon_read_table
+ *
+ * Description:
+ *   Generate one line for each used entry of a hot spot table:
+ *
+ *     <cpu>,<type>,<caller>,<count>,<max time>
+ *
+ ****************************************************************************/
+
+static ssize_t critmon_read_table(FAR struct critmon_file_s *attr,
+                                  FAR char *buffer, size_t buflen,
+                                  FAR off_t *offset, int cpu,
+                                  FAR const char *type,
+                                  FAR const struct critmon_hotspot_s *table)
+{
+  struct timespec maxtime;
+  size_t totalsize = 0;
+  size_t linesize;
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_NHOTSPOTS && totalsize < buflen;
+       i++)
+    {
+      if (table[i].count == 0)
+        {
+          continue;
+        }
+
+      up_critmon_convert(table[i].max, &maxtime);
+
+      linesize = snprintf(attr->line, CRITMON_LINELEN,
+                          "%d,%s,%p,%lu,%lu.%09lu\n",
+                          cpu, type, table[i].caller,
+                          (unsigned long)table[i].count,
+                          (unsigned long)maxtime.tv_sec,
+                          (unsigned long)maxtime.tv_nsec);
+      totalsize += procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, offset);
+    }
+
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: critmon_read_hotspots
+ ****************************************************************************/
+
+static ssize_t critmon_read_hotspots(FAR struct critmon_file_s *attr,
+                                     FAR char *buffer, size_t buflen,
+                                     FAR off_t *offset, int cpu)
+{
+  size_t totalsize;
+
+  totalsize  = critmon_read_table(attr, buffer, buflen, offset, cpu,
+                                  "premp-longest",
+                                  attr->premp[cpu].longest);
+  totalsize += critmon_read_table(attr, buffer + totalsize,
+                                  buflen - totalsize, offset, cpu,
+                                  "premp-frequent",
+                                  attr->premp[cpu].frequent);
+  totalsize += critmon_read_table(attr, buffer + totalsize,
+                                  buflen - totalsize, offset, cpu,
+                                  "crit-longest",
+                                  attr->crit[cpu].longest);
+  totalsize += critmon_read_table(attr, buffer + totalsize,
+                                  buflen - totalsize, offset, cpu,
+                                  "crit-frequent",
+                                  attr->crit[cpu].frequent);
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_read_cpu
  ****************************************************************************/
@@ -266,7 +412,7 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   linesize = snprintf(attr->line, CRITMON_LINELEN, "%lu.%09lu\n",
                      (unsigned long)maxtime.tv_sec,
                      (unsigned long)maxtime.tv_nsec);
-  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, offset);
+  copysize = procfs_memcpy(attr->line, linesize, buffer, remaining, offset);
 
   totalsize += copysize;
   return totalsize;
@@ -296,6 +442,13 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   ret    = 0;
   offset = filep->f_pos;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+  if (offset == 0)
+    {
+      critmon_snapshot(attr);
+    }
+#endif
+
 #ifdef CONFIG_SMP
   /* Get the status for each CPU  */
 
@@ -305,18 +458,34 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
                                         &offset, cpu);
 
       ret += nbytes;
-      if (ret > buflen)
+      if (ret >= buflen)
         {
           break;
         }
+    }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+  /* Then the hot spots of each CPU */
 
-      offset += nbytes;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && ret < buflen; cpu++)
+    {
+      ret += critmon_read_hotspots(attr, buffer + ret, buflen - ret,
+                                   &offset, cpu);
     }
+#endif
 
 #else
   /* Get status for the single CPU */
 
   ret = critmon_read_cpu(attr, buffer + ret, buflen -ret, &offset, 0);
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+  if (ret < buflen)
+    {
+      ret += critmon_read_hotspots(attr, buffer + ret, buflen - ret,
+                                   &offset, 0);
+    }
+#endif
 #endif
 
   if (ret > 0)
@@ -0,0 +1,354 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsiobinfo.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_IOB_QUOTAS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define IOBINFO_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct iobinfo_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  char line[IOBINFO_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/* The state of one iobinfo_read() */
+
+struct iobinfo_read_s
+{
+  FAR struct iobinfo_file_s *attr; /* The open file */
+  FAR char *buffer;                /* Remaining user buffer */
+  size_t buflen;                   /* Size of the remaining user buffer */
+  size_t totalsize;                /* Bytes copied to the user buffer */
+  off_t offset;                    /* Remaining file offset to skip */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     iobinfo_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     iobinfo_close(FAR struct file *filep);
+static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     iobinfo_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     iobinfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations iobinfo_operations =
+{
+  iobinfo_open,       /* open */
+  iobinfo_close,      /* close */
+  iobinfo_read,       /* read */
+  NULL,               /* write */
+
+  iobinfo_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  iobinfo_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iobinfo_open
+ ****************************************************************************/
+
+static int iobinfo_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct iobinfo_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "iobinfo" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "iobinfo") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct iobinfo_file_s *)kmm_zalloc(sizeof(struct iobinfo_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: iobinfo_close
+ ****************************************************************************/
+
+static int iobinfo_close(FAR struct file *filep)
+{
+  FAR struct iobinfo_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct iobinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: iobinfo_copyline
+ ****************************************************************************/
+
+static void iobinfo_copyline(FAR struct iobinfo_read_s *rd, size_t linesize)
+{
+  size_t copysize;
+
+  if (rd->totalsize < rd->buflen)
+    {
+      copysize       = procfs_memcpy(rd->attr->line, linesize,
+                                     rd->buffer + rd->totalsize,
+                                     rd->buflen - rd->totalsize,
+                                     &rd->offset);
+      rd->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: iobinfo_read
+ ****************************************************************************/
+
+static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  struct iobinfo_read_s rd;
+  size_t linesize;
+  int user;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rd.attr      = (FAR struct iobinfo_file_s *)filep->f_priv;
+  rd.buffer    = buffer;
+  rd.buflen    = buflen;
+  rd.totalsize = 0;
+  rd.offset    = filep->f_pos;
+  DEBUGASSERT(rd.attr);
+
+  /* The first line is the state of the whole pool */
+
+  linesize = snprintf(rd.attr->line, IOBINFO_LINELEN,
+                      "%-12s %7u %7u\n", "pool",
+                      (unsigned int)CONFIG_IOB_NBUFFERS,
+                      (unsigned int)iob_navail(false));
+  iobinfo_copyline(&rd, linesize);
+
+  /* Then the headers */
+
+  linesize = snprintf(rd.attr->line, IOBINFO_LINELEN,
+                      "%-12s %7s %7s %7s %10s %7s\n",
+                      "user", "used", "peak", "quota", "allocs", "denied");
+  iobinfo_copyline(&rd, linesize);
+
+  /* Followed by one line for each consumer */
+
+  for (user = IOB_USER_OTHER + 1; user < IOB_NUSERS; user++)
+    {
+      struct iob_userinfo_s info;
+      FAR const char *name;
+
+      if (iob_userinfo((enum iob_user_e)user, &info, &name) < 0)
+        {
+          continue;
+        }
+
+      linesize = snprintf(rd.attr->line, IOBINFO_LINELEN,
+                          "%-12s %7u %7u %7u %10lu %7lu\n",
+                          name, info.nused, info.npeak, info.quota,
+                          (unsigned long)info.nalloc,
+                          (unsigned long)info.ndenied);
+      iobinfo_copyline(&rd, linesize);
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += rd.totalsize;
+  return rd.totalsize;
+}
+
+/****************************************************************************
+ * Name: iobinfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int iobinfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct iobinfo_file_s *oldattr;
+  FAR struct iobinfo_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct iobinfo_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct iobinfo_file_s *)kmm_malloc(sizeof(struct iobinfo_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct iobinfo_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: iobinfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int iobinfo_stat(const char *relpath, struct stat *buf)
+{
+  /* "iobinfo" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "iobinfo") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "iobinfo" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_IOB_QUOTAS */
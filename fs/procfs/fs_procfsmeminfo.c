@@ -52,6 +52,11 @@
 #include <errno.h>
 #include <debug.h>
 
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+#  include <time.h>
+#  include <nuttx/arch.h>
+#endif
+
 #include <nuttx/kmalloc.h>
 #include <nuttx/pgalloc.h>
 #include <nuttx/progmem.h>
@@ -101,6 +106,10 @@ struct progmem_info_s
 #if defined(CONFIG_ARCH_HAVE_PROGMEM) && defined(CONFIG_FS_PROCFS_INCLUDE_PROGMEM)
 static void    meminfo_progmem(FAR struct progmem_info_s *progmem);
 #endif
+#ifdef CONFIG_MM_HEAPSTAT
+static size_t  meminfo_heapstat(FAR struct meminfo_file_s *procfile,
+                 FAR char *buffer, size_t buflen, FAR off_t *offset);
+#endif
 
 /* File system methods */
 
@@ -202,6 +211,122 @@ static void meminfo_progmem(FAR struct progmem_info_s *progmem)
 }
 #endif
 
+/****************************************************************************
+ * Name: meminfo_heapstat
+ *
+ * Description:
+ *   Generate the allocation statistics of the user heap:  The allocation
+ *   counts followed by the non-empty bins of the chunk size and allocation
+ *   latency histograms.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAPSTAT
+static size_t meminfo_heapstat(FAR struct meminfo_file_s *procfile,
+                               FAR char *buffer, size_t buflen,
+                               FAR off_t *offset)
+{
+  struct mm_heapstat_s stat;
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+  struct timespec ts;
+#endif
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+
+  (void)umm_heapstat(&stat);
+
+  linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
+                       "            allocs      frees      fails\n");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            offset);
+  totalsize = copysize;
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Heap:  %11lu%11lu%11lu\n",
+                            (unsigned long)stat.hs_nalloc,
+                            (unsigned long)stat.hs_nfree,
+                            (unsigned long)stat.hs_nfail);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 offset);
+      totalsize += copysize;
+    }
+
+  /* Chunk size histogram.  Bin i holds chunks of 2^(MM_MIN_SHIFT + i)
+   * bytes and more.
+   */
+
+  for (i = 0; i < MM_NNODES && totalsize < buflen; i++)
+    {
+      if (stat.hs_size[i] == 0)
+        {
+          continue;
+        }
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Size:  >=%9lu%11lu\n",
+                            1ul << (MM_MIN_SHIFT + i),
+                            (unsigned long)stat.hs_size[i]);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 offset);
+      totalsize += copysize;
+    }
+
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+  /* Allocation latency histogram.  Bin i holds latencies below 2^(i + 1)
+   * timer units, shown here in seconds.
+   */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      up_critmon_convert(stat.hs_maxlatency, &ts);
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Lat:  max %lu.%09lu\n",
+                            (unsigned long)ts.tv_sec,
+                            (unsigned long)ts.tv_nsec);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < MM_HEAPSTAT_NLATENCY && totalsize < buflen; i++)
+    {
+      if (stat.hs_latency[i] == 0)
+        {
+          continue;
+        }
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      up_critmon_convert((uint32_t)2 << i, &ts);
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Lat:  <%lu.%09lu%11lu\n",
+                            (unsigned long)ts.tv_sec,
+                            (unsigned long)ts.tv_nsec,
+                            (unsigned long)stat.hs_latency[i]);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 offset);
+      totalsize += copysize;
+    }
+#endif
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_open
  ****************************************************************************/
@@ -410,6 +535,19 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_MM_HEAPSTAT
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show user heap allocation statistics */
+
+      copysize   = meminfo_heapstat(procfile, buffer, buflen, &offset);
+      totalsize += copysize;
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
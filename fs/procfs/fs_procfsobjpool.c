@@ -0,0 +1,349 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsobjpool.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/objpool.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_MM_OBJPOOL) && !defined(CONFIG_FS_PROCFS_EXCLUDE_OBJPOOL)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define OBJPOOL_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct objpool_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  char line[OBJPOOL_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/* The state of one objpool_read() while the pools are visited */
+
+struct objpool_read_s
+{
+  FAR struct objpool_file_s *attr; /* The open file */
+  FAR char *buffer;                /* Remaining user buffer */
+  size_t buflen;                   /* Size of the remaining user buffer */
+  size_t totalsize;                /* Bytes copied to the user buffer */
+  off_t offset;                    /* Remaining file offset to skip */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     objpool_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     objpool_close(FAR struct file *filep);
+static ssize_t objpool_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     objpool_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     objpool_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations objpool_operations =
+{
+  objpool_open,       /* open */
+  objpool_close,      /* close */
+  objpool_read,       /* read */
+  NULL,               /* write */
+
+  objpool_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  objpool_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objpool_open
+ ****************************************************************************/
+
+static int objpool_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct objpool_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "objpool" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "objpool") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct objpool_file_s *)kmm_zalloc(sizeof(struct objpool_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: objpool_close
+ ****************************************************************************/
+
+static int objpool_close(FAR struct file *filep)
+{
+  FAR struct objpool_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct objpool_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: objpool_copyline
+ ****************************************************************************/
+
+static void objpool_copyline(FAR struct objpool_read_s *rd, size_t linesize)
+{
+  size_t copysize;
+
+  if (rd->totalsize < rd->buflen)
+    {
+      copysize       = procfs_memcpy(rd->attr->line, linesize,
+                                     rd->buffer + rd->totalsize,
+                                     rd->buflen - rd->totalsize,
+                                     &rd->offset);
+      rd->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: objpool_readpool
+ ****************************************************************************/
+
+static void objpool_readpool(FAR const struct objpool_info_s *info,
+                             FAR void *arg)
+{
+  FAR struct objpool_read_s *rd = (FAR struct objpool_read_s *)arg;
+  size_t linesize;
+
+  linesize = snprintf(rd->attr->line, OBJPOOL_LINELEN,
+                      "%-12s %7lu %7u %7u %7u %10lu %7lu\n",
+                      info->name, (unsigned long)info->objsize,
+                      info->nobjs, info->nused, info->npeak,
+                      (unsigned long)info->nalloc,
+                      (unsigned long)info->nfail);
+  objpool_copyline(rd, linesize);
+}
+
+/****************************************************************************
+ * Name: objpool_read
+ ****************************************************************************/
+
+static ssize_t objpool_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  struct objpool_read_s rd;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rd.attr      = (FAR struct objpool_file_s *)filep->f_priv;
+  rd.buffer    = buffer;
+  rd.buflen    = buflen;
+  rd.totalsize = 0;
+  rd.offset    = filep->f_pos;
+  DEBUGASSERT(rd.attr);
+
+  /* The first line is the headers */
+
+  linesize = snprintf(rd.attr->line, OBJPOOL_LINELEN,
+                      "%-12s %7s %7s %7s %7s %10s %7s\n",
+                      "name", "objsize", "total", "used", "peak",
+                      "allocs", "fails");
+  objpool_copyline(&rd, linesize);
+
+  /* Followed by one line for each pool */
+
+  objpool_foreach(objpool_readpool, &rd);
+
+  /* Update the file offset */
+
+  filep->f_pos += rd.totalsize;
+  return rd.totalsize;
+}
+
+/****************************************************************************
+ * Name: objpool_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int objpool_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct objpool_file_s *oldattr;
+  FAR struct objpool_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct objpool_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct objpool_file_s *)kmm_malloc(sizeof(struct objpool_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct objpool_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: objpool_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int objpool_stat(const char *relpath, struct stat *buf)
+{
+  /* "objpool" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "objpool") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "objpool" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_MM_OBJPOOL */
@@ -62,6 +62,9 @@
 #include <nuttx/sched.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/environ.h>
+#ifdef CONFIG_MM_HEAPSTAT
+#  include <nuttx/mm/mm.h>
+#endif
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
 #include <nuttx/fs/dirent.h>
@@ -114,6 +117,9 @@ enum proc_node_e
   PROC_CRITMON,                       /* Critical section monitor */
 #endif
   PROC_STACK,                         /* Task stack info */
+#ifdef CONFIG_MM_HEAPSTAT
+  PROC_HEAP,                          /* Task heap usage */
+#endif
   PROC_GROUP,                         /* Group directory */
   PROC_GROUP_STATUS,                  /* Task group status */
   PROC_GROUP_FD                       /* Group file descriptors */
@@ -169,9 +175,9 @@ struct proc_envinfo_s
  * Private Data
  ****************************************************************************/
 
-static FAR const char *g_policy[4] =
+static FAR const char *g_policy[5] =
 {
-  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_OTHER"
+  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_OTHER", "SCHED_DEADLINE"
 };
 
 /****************************************************************************
@@ -201,6 +207,11 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
+#ifdef CONFIG_MM_HEAPSTAT
+static ssize_t proc_heap(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_groupstatus(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
@@ -298,6 +309,13 @@ static const struct proc_node_s g_stack =
   "stack",        "stack",   (uint8_t)PROC_STACK,        DTYPE_FILE        /* Task stack info */
 };
 
+#ifdef CONFIG_MM_HEAPSTAT
+static const struct proc_node_s g_heap =
+{
+  "heap",         "heap",    (uint8_t)PROC_HEAP,         DTYPE_FILE        /* Task heap usage */
+};
+#endif
+
 static const struct proc_node_s g_group =
 {
   "group",        "group",   (uint8_t)PROC_GROUP,        DTYPE_DIRECTORY   /* Group directory */
@@ -334,6 +352,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
   &g_critmon,      /* Critical section Monitor */
 #endif
   &g_stack,        /* Task stack info */
+#ifdef CONFIG_MM_HEAPSTAT
+  &g_heap,         /* Task heap usage */
+#endif
   &g_group,        /* Group directory */
   &g_groupstatus,  /* Task group status */
   &g_groupfd       /* Group file descriptors */
@@ -357,6 +378,9 @@ static const struct proc_node_s * const g_level0info[] =
   &g_critmon,      /* Critical section monitor */
 #endif
   &g_stack,        /* Task stack info */
+#ifdef CONFIG_MM_HEAPSTAT
+  &g_heap,         /* Task heap usage */
+#endif
   &g_group,        /* Group directory */
 };
 #define PROC_NLEVEL0NODES (sizeof(g_level0info)/sizeof(FAR const struct proc_node_s * const))
@@ -450,7 +474,8 @@ static FAR const struct proc_node_s *proc_findnode(FAR const char *relpath)
  *                                  {Unlock, Semaphore, Signal, MQ empty, MQ full}
  *   Flags:      xxx                N,P,X
  *   Priority:   nnn                Decimal, 0-255
- *   Scheduler:  xxxxxxxxxxxxxx     {SCHED_FIFO, SCHED_RR, SCHED_SPORADIC, SCHED_OTHER}
+ *   Scheduler:  xxxxxxxxxxxxxx     {SCHED_FIFO, SCHED_RR, SCHED_SPORADIC, SCHED_OTHER,
+ *                                                 SCHED_DEADLINE}
  *   Sigmask:    nnnnnnnn           Hexadecimal, 32-bit
  *
  ****************************************************************************/
@@ -908,6 +933,87 @@ static ssize_t proc_stack(FAR struct proc_file_s *procfile,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: proc_heap
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAPSTAT
+static ssize_t proc_heap(FAR struct proc_file_s *procfile,
+                         FAR struct tcb_s *tcb, FAR char *buffer,
+                         size_t buflen, off_t offset)
+{
+  struct mm_pidstat_s stat;
+  size_t remaining;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+
+  remaining = buflen;
+  totalsize = 0;
+
+  /* Nothing has been allocated yet if there are no statistics */
+
+  if (umm_pidstat(tcb->pid, &stat) < 0)
+    {
+      memset(&stat, 0, sizeof(struct mm_pidstat_s));
+    }
+
+  /* Show the number of allocations */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                        "Allocs:", (unsigned long)stat.ps_nalloc);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  /* Show the number of frees */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                        "Frees:", (unsigned long)stat.ps_nfree);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  /* Show the bytes currently allocated */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                        "Used:", (unsigned long)stat.ps_used);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  /* Show the peak of the bytes allocated */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                        "Peak:", (unsigned long)stat.ps_peak);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+  totalsize += copysize;
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_groupstatus
  ****************************************************************************/
@@ -1430,6 +1536,12 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 
+#ifdef CONFIG_MM_HEAPSTAT
+    case PROC_HEAP: /* Task heap usage */
+      ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
+
     case PROC_GROUP_STATUS: /* Task group status */
       ret = proc_groupstatus(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
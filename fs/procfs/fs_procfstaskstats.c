@@ -0,0 +1,465 @@
+/****************************************************************************
+ * fs/procfs/fs_procfstaskstats.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#ifdef CONFIG_MM_HEAPSTAT
+#  include <nuttx/mm/mm.h>
+#endif
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_TASKSTATS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Some statistics cannot be collected from within sched_foreach() */
+
+#undef HAVE_TASKSTATS_DEFERRED
+#if defined(CONFIG_SCHED_CPULOAD) || defined(CONFIG_STACK_COLORATION) || \
+    defined(CONFIG_MM_HEAPSTAT)
+#  define HAVE_TASKSTATS_DEFERRED 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One snapshot:  The header followed by up to CONFIG_MAX_TASKS entries */
+
+struct taskstats_snapshot_s
+{
+  struct procfs_taskstats_s hdr;
+  struct procfs_taskstat_s task[CONFIG_MAX_TASKS];
+};
+
+/* This structure describes one open "file" */
+
+struct taskstats_file_s
+{
+  struct procfs_file_s  base;        /* Base open file structure */
+  size_t size;                       /* Number of valid bytes in snapshot */
+  struct taskstats_snapshot_s snap;  /* The last snapshot */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Helpers */
+
+static void    taskstats_sample(FAR struct tcb_s *tcb, FAR void *arg);
+static void    taskstats_snapshot(FAR struct taskstats_file_s *statfile);
+
+/* File system methods */
+
+static int     taskstats_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     taskstats_close(FAR struct file *filep);
+static ssize_t taskstats_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     taskstats_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     taskstats_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations taskstats_operations =
+{
+  taskstats_open,    /* open */
+  taskstats_close,   /* close */
+  taskstats_read,    /* read */
+  NULL,              /* write */
+
+  taskstats_dup,     /* dup */
+
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+
+  taskstats_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: taskstats_sample
+ *
+ * Description:
+ *   sched_foreach() callback:  Save the fields of the TCB that can be
+ *   sampled quickly within the critical section.
+ *
+ ****************************************************************************/
+
+static void taskstats_sample(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  FAR struct taskstats_snapshot_s *snap;
+  FAR struct procfs_taskstat_s *entry;
+
+  snap = (FAR struct taskstats_snapshot_s *)arg;
+
+  if (snap->hdr.ts_ntasks >= CONFIG_MAX_TASKS)
+    {
+      return;
+    }
+
+  entry               = &snap->task[snap->hdr.ts_ntasks++];
+  memset(entry, 0, sizeof(struct procfs_taskstat_s));
+
+  entry->tt_pid       = tcb->pid;
+  entry->tt_state     = tcb->task_state;
+  entry->tt_priority  = tcb->sched_priority;
+  entry->tt_flags     = tcb->flags;
+  entry->tt_stacksize = tcb->adj_stack_size;
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  strncpy(entry->tt_name, tcb->name, CONFIG_TASK_NAME_SIZE);
+#endif
+}
+
+/****************************************************************************
+ * Name: taskstats_snapshot
+ *
+ * Description:
+ *   Take a new snapshot of all tasks.
+ *
+ ****************************************************************************/
+
+static void taskstats_snapshot(FAR struct taskstats_file_s *statfile)
+{
+  FAR struct taskstats_snapshot_s *snap = &statfile->snap;
+#ifdef HAVE_TASKSTATS_DEFERRED
+  FAR struct procfs_taskstat_s *entry;
+  int i;
+#endif
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+#endif
+#ifdef CONFIG_STACK_COLORATION
+  FAR struct tcb_s *tcb;
+#endif
+#ifdef CONFIG_MM_HEAPSTAT
+  struct mm_pidstat_s stat;
+#endif
+#if !defined(CONFIG_BUILD_KERNEL)
+  struct mallinfo mem;
+#endif
+
+  memset(&snap->hdr, 0, sizeof(struct procfs_taskstats_s));
+  snap->hdr.ts_version = PROCFS_TASKSTATS_VERSION;
+  snap->hdr.ts_hdrsize = offsetof(struct taskstats_snapshot_s, task);
+  snap->hdr.ts_entsize = sizeof(struct procfs_taskstat_s);
+  snap->hdr.ts_systime = clock_systimer();
+
+  /* First collect the TCB fields of all tasks */
+
+  sched_foreach(taskstats_sample, snap);
+
+#ifdef HAVE_TASKSTATS_DEFERRED
+  /* Then the statistics that take longer to gather, outside of the
+   * critical section.  A task that exits in the meantime just keeps zero
+   * values.
+   */
+
+  for (i = 0; i < snap->hdr.ts_ntasks; i++)
+    {
+      entry = &snap->task[i];
+
+#ifdef CONFIG_SCHED_CPULOAD
+      if (clock_cpuload(entry->tt_pid, &cpuload) == OK)
+        {
+          entry->tt_cpuactive   = cpuload.active;
+          snap->hdr.ts_cputotal = cpuload.total;
+        }
+#endif
+
+#ifdef CONFIG_STACK_COLORATION
+      sched_lock();
+      tcb = sched_gettcb(entry->tt_pid);
+      if (tcb != NULL)
+        {
+          entry->tt_stackused = up_check_tcbstack(tcb);
+        }
+
+      sched_unlock();
+#endif
+
+#ifdef CONFIG_MM_HEAPSTAT
+      if (umm_pidstat(entry->tt_pid, &stat) >= 0)
+        {
+          entry->tt_heapused = stat.ps_used;
+          entry->tt_heappeak = stat.ps_peak;
+        }
+#endif
+    }
+#endif /* HAVE_TASKSTATS_DEFERRED */
+
+#if !defined(CONFIG_BUILD_KERNEL)
+  /* And the user heap */
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+  mem = kumm_mallinfo();
+#else
+  (void)kumm_mallinfo(&mem);
+#endif
+
+  snap->hdr.ts_heapsize = mem.arena;
+  snap->hdr.ts_heapfree = mem.fordblks;
+#endif
+
+  statfile->size = snap->hdr.ts_hdrsize +
+                   snap->hdr.ts_ntasks * sizeof(struct procfs_taskstat_s);
+}
+
+/****************************************************************************
+ * Name: taskstats_open
+ ****************************************************************************/
+
+static int taskstats_open(FAR struct file *filep, FAR const char *relpath,
+                          int oflags, mode_t mode)
+{
+  FAR struct taskstats_file_s *statfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "taskstats" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "taskstats") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the snapshot.  It is allocated once here
+   * so that the tasks can be sampled without any allocation.
+   */
+
+  statfile = (FAR struct taskstats_file_s *)
+    kmm_zalloc(sizeof(struct taskstats_file_s));
+  if (!statfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)statfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: taskstats_close
+ ****************************************************************************/
+
+static int taskstats_close(FAR struct file *filep)
+{
+  FAR struct taskstats_file_s *statfile;
+
+  /* Recover our private data from the struct file instance */
+
+  statfile = (FAR struct taskstats_file_s *)filep->f_priv;
+  DEBUGASSERT(statfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(statfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: taskstats_read
+ ****************************************************************************/
+
+static ssize_t taskstats_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct taskstats_file_s *statfile;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  statfile = (FAR struct taskstats_file_s *)filep->f_priv;
+  DEBUGASSERT(statfile);
+
+  /* If f_pos is zero, then take a new snapshot.  Otherwise, continue with
+   * the snapshot from the previous read() so that the data stays
+   * consistent if it is read in pieces.  A sampler can lseek() back to zero
+   * (or use pread() at offset zero) to get a new snapshot without
+   * re-opening the file.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      taskstats_snapshot(statfile);
+    }
+
+  /* Transfer the snapshot to user receive buffer */
+
+  offset = filep->f_pos;
+  ret    = procfs_memcpy((FAR const char *)&statfile->snap, statfile->size,
+                         buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: taskstats_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int taskstats_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct taskstats_file_s *oldattr;
+  FAR struct taskstats_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct taskstats_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct taskstats_file_s *)
+    kmm_malloc(sizeof(struct taskstats_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct taskstats_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: taskstats_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int taskstats_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "taskstats" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "taskstats") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "taskstats" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_PROCFS_EXCLUDE_TASKSTATS */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
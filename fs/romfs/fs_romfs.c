@@ -62,6 +62,7 @@
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/mtd/mtd.h>
+#include <nuttx/drivers/blkcache.h>
 
 #include "fs_romfs.h"
 
@@ -404,6 +405,17 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = bytesleft;
     }
 
+  /* In XIP mode, the file data can be copied from the media in one step */
+
+  if (rm->rm_xipbase)
+    {
+      memcpy(userbuffer, rm->rm_xipbase + rf->rf_startoffset + filep->f_pos,
+             buflen);
+      filep->f_pos += buflen;
+      romfs_semgive(rm);
+      return buflen;
+    }
+
   /* Loop until either (1) all data has been transferred, or (2) an
    * error occurs.
    */
@@ -1019,6 +1031,18 @@ static int romfs_bind(FAR struct inode *blkdriver, FAR const void *data,
       goto errout_with_buffer;
     }
 
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+  /* Index the directory tree.  Without the index, lookups just search the
+   * directories in the image.
+   */
+
+  ret = romfs_buildindex(rm);
+  if (ret < 0)
+    {
+      fwarn("WARNING: romfs_buildindex failed: %d\n", ret);
+    }
+
+#endif
   /* Mounted! */
 
   *handle = (FAR void *)rm;
@@ -1084,6 +1108,13 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
           struct inode *inode = rm->rm_blkdriver;
           if (inode)
             {
+              if (INODE_IS_BLOCK(inode))
+                {
+                  /* Drop the blocks held in the shared block cache */
+
+                  blkcache_invalidate(inode);
+                }
+
               if (INODE_IS_BLOCK(inode) && inode->u.i_bops->close != NULL)
                 {
                   (void)inode->u.i_bops->close(inode);
@@ -1109,6 +1140,9 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
           kmm_free(rm->rm_buffer);
         }
 
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+      romfs_freeindex(rm);
+#endif
       nxsem_destroy(&rm->rm_sem);
       kmm_free(rm);
       return OK;
@@ -125,6 +125,10 @@
 
 #define ROMF_MAX_LINKS 64
 
+/* Terminates a hash chain of the directory index */
+
+#define ROMFS_NOENTRY  0xffffffff
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -134,6 +138,24 @@
  * mounted with a fat32 filesystem.
  */
 
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+/* This structure describes one file or directory in the directory index.
+ * de_next, de_info and de_size are the values that romfs_parsedirentry()
+ * returns for the entry.
+ */
+
+struct romfs_indexent_s
+{
+  uint32_t de_parent;               /* Offset to the first entry of the directory */
+  uint32_t de_hash;                 /* Hash of de_parent and the name */
+  uint32_t de_offset;               /* Offset to the file header */
+  uint32_t de_next;                 /* Offset of the next file header+flags */
+  uint32_t de_info;                 /* First entry if directory */
+  uint32_t de_size;                 /* Size (if file) */
+  uint32_t de_chain;                /* Next entry in the hash chain */
+};
+#endif
+
 struct romfs_file_s;
 struct romfs_mountpt_s
 {
@@ -149,6 +171,11 @@ struct romfs_mountpt_s
   uint32_t rm_cachesector;          /* Current sector in the rm_buffer */
   uint8_t *rm_xipbase;              /* Base address of directly accessible media */
   uint8_t *rm_buffer;               /* Device sector buffer, allocated if rm_xipbase==0 */
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+  struct romfs_indexent_s *rm_dirindex; /* Directory index (NULL: not available) */
+  uint32_t *rm_dirbuckets;          /* Heads of the hash chains in rm_dirindex */
+  uint32_t rm_nbuckets;             /* Number of hash chains (a power of two) */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -223,6 +250,10 @@ int  romfs_parsefilename(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR char *pname);
 int  romfs_datastart(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR uint32_t *start);
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+int  romfs_buildindex(FAR struct romfs_mountpt_s *rm);
+void romfs_freeindex(FAR struct romfs_mountpt_s *rm);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
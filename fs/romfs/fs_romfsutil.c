@@ -55,6 +55,7 @@
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/mtd/mtd.h>
+#include <nuttx/drivers/blkcache.h>
 
 #include "fs_romfs.h"
 
@@ -81,6 +82,33 @@ static uint32_t romfs_devread32(struct romfs_mountpt_s *rm, int ndx)
            ((uint32_t)rm->rm_buffer[ndx + 3] & 0xff));
 }
 
+/****************************************************************************
+ * Name: romfs_setdirinfo
+ *
+ * Description:
+ *   Save the description of a matching directory entry in dirinfo
+ *
+ ****************************************************************************/
+
+static void romfs_setdirinfo(struct romfs_dirinfo_s *dirinfo,
+                             uint32_t offset, uint32_t next, uint32_t info,
+                             uint32_t size)
+{
+  if (IS_DIRECTORY(next))
+    {
+      dirinfo->rd_dir.fr_firstoffset = info;
+      dirinfo->rd_dir.fr_curroffset  = info;
+      dirinfo->rd_size               = 0;
+    }
+  else
+    {
+      dirinfo->rd_dir.fr_curroffset  = offset;
+      dirinfo->rd_size               = size;
+    }
+
+  dirinfo->rd_next                   = next;
+}
+
 /****************************************************************************
  * Name: romfs_checkentry
  *
@@ -135,19 +163,7 @@ static inline int romfs_checkentry(struct romfs_mountpt_s *rm,
         {
           /* Found it -- save the component info and return success */
 
-          if (IS_DIRECTORY(next))
-            {
-              dirinfo->rd_dir.fr_firstoffset = info;
-              dirinfo->rd_dir.fr_curroffset  = info;
-              dirinfo->rd_size               = 0;
-            }
-          else
-            {
-              dirinfo->rd_dir.fr_curroffset  = offset;
-              dirinfo->rd_size               = size;
-            }
-
-          dirinfo->rd_next                   = next;
+          romfs_setdirinfo(dirinfo, offset, next, info, size);
           return OK;
         }
     }
@@ -256,6 +272,82 @@ static int romfs_followhardlinks(struct romfs_mountpt_s *rm, uint32_t offset,
   return -ELOOP;
 }
 
+/****************************************************************************
+ * Name: romfs_namehash
+ *
+ * Description:
+ *   Hash the name of an entry together with its directory (FNV-1a)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+static uint32_t romfs_namehash(uint32_t parent, const char *name, int len)
+{
+  uint32_t hash = 2166136261u ^ parent;
+
+  while (len-- > 0)
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: romfs_searchindex
+ *
+ * Description:
+ *   This is the romfs_searchdir() logic when the directory index is
+ *   available.  Only the entries with the same hash are examined.
+ *
+ ****************************************************************************/
+
+static int romfs_searchindex(struct romfs_mountpt_s *rm,
+                             const char *entryname, int entrylen,
+                             struct romfs_dirinfo_s *dirinfo)
+{
+  struct romfs_indexent_s *entry;
+  char name[NAME_MAX+1];
+  uint32_t parent;
+  uint32_t hash;
+  uint32_t i;
+  int ret;
+
+  parent = dirinfo->rd_dir.fr_firstoffset;
+  hash   = romfs_namehash(parent, entryname, entrylen);
+
+  for (i = rm->rm_dirbuckets[hash & (rm->rm_nbuckets - 1)];
+       i != ROMFS_NOENTRY;
+       i = entry->de_chain)
+    {
+      entry = &rm->rm_dirindex[i];
+      if (entry->de_hash != hash || entry->de_parent != parent)
+        {
+          continue;
+        }
+
+      /* The hash matches.  Compare the name in the image. */
+
+      ret = romfs_parsefilename(rm, entry->de_offset, name);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (memcmp(entryname, name, entrylen) == 0 &&
+          strlen(name) == entrylen)
+        {
+          romfs_setdirinfo(dirinfo, entry->de_offset, entry->de_next,
+                           entry->de_info, entry->de_size);
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_searchdir
  *
@@ -274,6 +366,13 @@ static inline int romfs_searchdir(struct romfs_mountpt_s *rm,
   int16_t  ndx;
   int      ret;
 
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+  if (rm->rm_dirindex)
+    {
+      return romfs_searchindex(rm, entryname, entrylen, dirinfo);
+    }
+
+#endif
   /* Then loop through the current directory until the directory
    * with the matching name is found.  Or until all of the entries
    * the directory have been examined.
@@ -393,11 +492,19 @@ int romfs_hwread(struct romfs_mountpt_s *rm, uint8_t *buffer, uint32_t sector,
           nsectorsread =
             MTD_BREAD(inode->u.i_mtd, sector, nsectors, buffer);
         }
+#ifdef CONFIG_DRVR_BLKCACHE
+      else
+        {
+          return blkcache_read(inode, buffer, sector, nsectors,
+                               rm->rm_hwsectorsize);
+        }
+#else
       else if (inode->u.i_bops->read)
         {
           nsectorsread =
             inode->u.i_bops->read(inode, buffer, sector, nsectors);
         }
+#endif
 
       if (nsectorsread == (ssize_t)nsectors)
         {
@@ -988,3 +1095,209 @@ int romfs_datastart(struct romfs_mountpt_s *rm, uint32_t offset,
 
   return -EINVAL; /* Won't get here */
 }
+
+/****************************************************************************
+ * Name: romfs_buildindex
+ *
+ * Description:
+ *   Scan the whole directory tree and build the hashed index of all files
+ *   and directories.  Directories are scanned in the order in which they
+ *   are added to the index, so no recursion is needed.  Hard-linked
+ *   directories (such as "." and "..") are indexed but not scanned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRINDEX
+int romfs_buildindex(struct romfs_mountpt_s *rm)
+{
+  struct romfs_indexent_s *index = NULL;
+  struct romfs_indexent_s *newindex;
+  struct romfs_indexent_s *entry;
+  char name[NAME_MAX+1];
+  uint32_t maxentries;
+  uint32_t nvisited = 0;
+  uint32_t nentries = 0;
+  uint32_t nalloc = 0;
+  uint32_t nbuckets;
+  uint32_t parent;
+  uint32_t offset;
+  uint32_t linkoffset;
+  uint32_t next;
+  uint32_t info;
+  uint32_t size;
+  uint32_t ndir;
+  uint32_t i;
+  int16_t  ndx;
+  int      ret;
+
+  /* Every file header occupies at least 32 bytes.  More headers than that
+   * can only be the result of a loop in a corrupted image.
+   */
+
+  maxentries = rm->rm_volsize / (2 * ROMFS_ALIGNMENT);
+  parent     = rm->rm_rootoffset;
+  ndir       = 0;
+
+  for (; ; )
+    {
+      /* Add the files and directories in the directory at 'parent' */
+
+      for (offset = parent; offset != 0; offset = next & RFNEXT_OFFSETMASK)
+        {
+          if (++nvisited > maxentries)
+            {
+              ret = -ELOOP;
+              goto errout;
+            }
+
+          ret = romfs_parsedirentry(rm, offset, &linkoffset, &next, &info,
+                                    &size);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          if (!IS_DIRECTORY(next) && !IS_FILE(next))
+            {
+              continue;
+            }
+
+          if (nentries >= nalloc)
+            {
+              nalloc   = nalloc ? 2 * nalloc : 32;
+              newindex = (FAR struct romfs_indexent_s *)
+                kmm_realloc(index, nalloc * sizeof(struct romfs_indexent_s));
+              if (!newindex)
+                {
+                  ret = -ENOMEM;
+                  goto errout;
+                }
+
+              index = newindex;
+            }
+
+          ret = romfs_parsefilename(rm, offset, name);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          entry            = &index[nentries++];
+          entry->de_parent = parent;
+          entry->de_hash   = romfs_namehash(parent, name, strlen(name));
+          entry->de_offset = offset;
+          entry->de_next   = next;
+          entry->de_info   = info;
+          entry->de_size   = size;
+        }
+
+      /* Find the next directory that has not been scanned yet */
+
+      for (; ndir < nentries; ndir++)
+        {
+          entry = &index[ndir];
+          if (IS_DIRECTORY(entry->de_next))
+            {
+              ndx = romfs_devcacheread(rm, entry->de_offset);
+              if (ndx < 0)
+                {
+                  ret = ndx;
+                  goto errout;
+                }
+
+              if (!IS_HARDLINK(romfs_devread32(rm, ndx + ROMFS_FHDR_NEXT)))
+                {
+                  break;
+                }
+            }
+        }
+
+      if (ndir >= nentries)
+        {
+          break;
+        }
+
+      parent = index[ndir++].de_info;
+    }
+
+  if (nentries == 0)
+    {
+      ret = -ENOENT;
+      goto errout;
+    }
+
+  /* Chain the entries into the hash buckets.  The entries are chained in
+   * reverse so that the first one of duplicate names is found, as with
+   * the directory search.
+   */
+
+  for (nbuckets = 1; nbuckets < nentries; nbuckets <<= 1);
+
+  rm->rm_dirbuckets = (FAR uint32_t *)kmm_malloc(nbuckets * sizeof(uint32_t));
+  if (!rm->rm_dirbuckets)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  for (i = 0; i < nbuckets; i++)
+    {
+      rm->rm_dirbuckets[i] = ROMFS_NOENTRY;
+    }
+
+  for (i = nentries; i-- > 0; )
+    {
+      entry           = &index[i];
+      ndir            = entry->de_hash & (nbuckets - 1);
+      entry->de_chain = rm->rm_dirbuckets[ndir];
+      rm->rm_dirbuckets[ndir] = i;
+    }
+
+  /* Release the unused part of the index */
+
+  newindex = (FAR struct romfs_indexent_s *)
+    kmm_realloc(index, nentries * sizeof(struct romfs_indexent_s));
+  if (newindex)
+    {
+      index = newindex;
+    }
+
+  finfo("Indexed %lu entries in %lu buckets\n",
+        (unsigned long)nentries, (unsigned long)nbuckets);
+
+  rm->rm_dirindex = index;
+  rm->rm_nbuckets = nbuckets;
+  return OK;
+
+errout:
+  if (index)
+    {
+      kmm_free(index);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: romfs_freeindex
+ *
+ * Description:
+ *   Release the directory index
+ *
+ ****************************************************************************/
+
+void romfs_freeindex(struct romfs_mountpt_s *rm)
+{
+  if (rm->rm_dirindex)
+    {
+      kmm_free(rm->rm_dirindex);
+      rm->rm_dirindex = NULL;
+    }
+
+  if (rm->rm_dirbuckets)
+    {
+      kmm_free(rm->rm_dirbuckets);
+      rm->rm_dirbuckets = NULL;
+    }
+}
+#endif
@@ -0,0 +1,114 @@
+/****************************************************************************
+ * fs/shm/memfd_create.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mman.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <errno.h>
+
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Used to give each anonymous object a unique, temporary name */
+
+static uint16_t g_memfd_seqno;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memfd_create
+ *
+ * Description:
+ *   Create an anonymous shared memory object and return a file descriptor
+ *   that refers to it.  The object behaves like one created by shm_open()
+ *   except that it has no name:  It can be shared only by passing the
+ *   descriptor (e.g. to a child task) or the address returned by mmap(),
+ *   and it is freed when the last descriptor and mapping are gone.
+ *
+ * Input Parameters:
+ *   name  - A name used only for debug purposes
+ *   flags - MFD_* flags.  MFD_CLOEXEC is accepted but ignored.
+ *
+ * Returned Value:
+ *   A non-negative file descriptor on success; -1 (ERROR) on failure with
+ *   the errno variable set appropriately.
+ *
+ ****************************************************************************/
+
+int memfd_create(FAR const char *name, unsigned int flags)
+{
+  char tmpname[MAX_SHM_PATH];
+  int fd;
+
+  if (name == NULL || (flags & ~MFD_CLOEXEC) != 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* Create the object under a unique name and then remove the name at
+   * once, leaving the descriptor as the only reference.
+   */
+
+  sched_lock();
+  snprintf(tmpname, MAX_SHM_PATH, "memfd:%s.%u", name,
+           (unsigned int)g_memfd_seqno++);
+
+  fd = shm_open(tmpname, O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd >= 0)
+    {
+      shm_unlink(tmpname);
+    }
+
+  sched_unlock();
+  return fd;
+}
+
+#endif /* CONFIG_FS_SHM */
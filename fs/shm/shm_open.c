@@ -0,0 +1,191 @@
+/****************************************************************************
+ * fs/shm/shm_open.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shm_open
+ *
+ * Description:
+ *   Establish a connection between the shared memory object named by 'name'
+ *   and a file descriptor.  A new object has size zero; use ftruncate() to
+ *   size it and mmap() to attach to it.  Every mmap() of the object returns
+ *   the same address so that data is shared without copying.
+ *
+ * Input Parameters:
+ *   name  - Name of the shared memory object.  All names are relative to
+ *           CONFIG_FS_SHMPATH.
+ *   oflag - O_RDONLY or O_RDWR, optionally with O_CREAT, O_EXCL and O_TRUNC
+ *   mode  - Access privileges of a new object (not used)
+ *
+ * Returned Value:
+ *   A non-negative file descriptor on success; -1 (ERROR) on failure with
+ *   the errno variable set appropriately.
+ *
+ ****************************************************************************/
+
+int shm_open(FAR const char *name, int oflag, mode_t mode)
+{
+  FAR struct shmfs_object_s *object;
+  struct inode_search_s desc;
+  char fullpath[MAX_SHM_PATH];
+  int errcode;
+  int ret;
+  int fd;
+
+  /* Make sure that a non-NULL name is supplied */
+
+  if (name == NULL || *name == '\0')
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  /* Skip over any leading '/'.  All shared memory object paths are relative
+   * to CONFIG_FS_SHMPATH.
+   */
+
+  while (*name == '/')
+    {
+      name++;
+    }
+
+  snprintf(fullpath, MAX_SHM_PATH, CONFIG_FS_SHMPATH "/%s", name);
+
+  /* Make the check for an existing object and the creation of a new one
+   * atomic with respect to other tasks executing shm_open().
+   */
+
+  sched_lock();
+
+  SETUP_SEARCH(&desc, fullpath, false);
+
+  ret = inode_find(&desc);
+  if (ret >= 0)
+    {
+      /* The name exists.  Is it a shared memory object? */
+
+      DEBUGASSERT(desc.node != NULL);
+
+      if (!INODE_IS_DRIVER(desc.node) || desc.node->u.i_ops != &g_shmfs_fops)
+        {
+          errcode = ENXIO;
+          goto errout_with_inode;
+        }
+
+      if ((oflag & (O_CREAT | O_EXCL)) == (O_CREAT | O_EXCL))
+        {
+          errcode = EEXIST;
+          goto errout_with_inode;
+        }
+
+      inode_release(desc.node);
+    }
+  else
+    {
+      if ((oflag & O_CREAT) == 0)
+        {
+          errcode = ENOENT;
+          goto errout_with_search;
+        }
+
+      object = shmfs_alloc();
+      if (object == NULL)
+        {
+          errcode = ENOMEM;
+          goto errout_with_search;
+        }
+
+      ret = register_driver(fullpath, &g_shmfs_fops, mode, object);
+      if (ret < 0)
+        {
+          /* Nothing else can have found the object yet */
+
+          shmfs_release(object);
+          errcode = -ret;
+          goto errout_with_search;
+        }
+    }
+
+  RELEASE_SEARCH(&desc);
+
+  /* Now open the object as any other character driver */
+
+  fd = open(fullpath, oflag & ~(O_CREAT | O_EXCL | O_TRUNC));
+  if (fd >= 0 && (oflag & O_TRUNC) != 0 && (oflag & O_WROK) != 0)
+    {
+      ftruncate(fd, 0);
+    }
+
+  sched_unlock();
+  return fd;
+
+errout_with_inode:
+  inode_release(desc.node);
+
+errout_with_search:
+  RELEASE_SEARCH(&desc);
+  sched_unlock();
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_SHM */
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * fs/shm/shm_unlink.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mman.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shm_unlink
+ *
+ * Description:
+ *   Remove the name of the shared memory object named by 'name'.  If one or
+ *   more tasks still have the object open or mapped, the object itself is
+ *   not freed until all of those references have been released.
+ *
+ * Input Parameters:
+ *   name - Name of the shared memory object
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with the errno variable set
+ *   appropriately.
+ *
+ ****************************************************************************/
+
+int shm_unlink(FAR const char *name)
+{
+  struct inode_search_s desc;
+  char fullpath[MAX_SHM_PATH];
+  int errcode;
+  int ret;
+
+  if (name == NULL || *name == '\0')
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  while (*name == '/')
+    {
+      name++;
+    }
+
+  snprintf(fullpath, MAX_SHM_PATH, CONFIG_FS_SHMPATH "/%s", name);
+
+  /* Verify that what we found is, indeed, a shared memory object */
+
+  sched_lock();
+
+  SETUP_SEARCH(&desc, fullpath, false);
+
+  ret = inode_find(&desc);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_search;
+    }
+
+  DEBUGASSERT(desc.node != NULL);
+
+  if (!INODE_IS_DRIVER(desc.node) || desc.node->u.i_ops != &g_shmfs_fops)
+    {
+      inode_release(desc.node);
+      errcode = ENXIO;
+      goto errout_with_search;
+    }
+
+  inode_release(desc.node);
+  RELEASE_SEARCH(&desc);
+
+  /* unlink() removes the inode and calls the unlink method of the object
+   * which drops the reference held by the name.
+   */
+
+  ret = unlink(fullpath);
+  sched_unlock();
+  return ret;
+
+errout_with_search:
+  RELEASE_SEARCH(&desc);
+  sched_unlock();
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_SHM */
@@ -0,0 +1,529 @@
+/****************************************************************************
+ * fs/shm/shmfs.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* All live shared memory objects.  The list is only searched by munmap(),
+ * every other operation reaches its object through the inode.
+ */
+
+struct shmfs_list_s
+{
+  sem_t exclsem;                    /* Protects all objects and the list */
+  FAR struct shmfs_object_s *head;  /* The list of live objects */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     shmfs_open(FAR struct file *filep);
+static int     shmfs_close(FAR struct file *filep);
+static ssize_t shmfs_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t shmfs_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static off_t   shmfs_seek(FAR struct file *filep, off_t offset, int whence);
+static int     shmfs_ioctl(FAR struct file *filep, int cmd,
+                 unsigned long arg);
+static int     shmfs_unlink(FAR struct inode *inode);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct file_operations g_shmfs_fops =
+{
+  shmfs_open,    /* open */
+  shmfs_close,   /* close */
+  shmfs_read,    /* read */
+  shmfs_write,   /* write */
+  shmfs_seek,    /* seek */
+  shmfs_ioctl    /* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+  , NULL         /* poll */
+#endif
+  , shmfs_unlink /* unlink */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct shmfs_list_s g_shmfs =
+{
+  SEM_INITIALIZER(1),
+  NULL
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmfs_unref
+ *
+ * Description:
+ *   Drop one reference to a shared memory object, freeing the object if
+ *   that was the last one.  Called with the list locked.
+ *
+ ****************************************************************************/
+
+static void shmfs_unref(FAR struct shmfs_object_s *object)
+{
+  FAR struct shmfs_object_s *prev;
+  FAR struct shmfs_object_s *curr;
+
+  DEBUGASSERT(object->crefs > 0);
+  if (--object->crefs > 0)
+    {
+      return;
+    }
+
+  for (prev = NULL, curr = g_shmfs.head;
+       curr != NULL && curr != object;
+       prev = curr, curr = curr->flink);
+
+  DEBUGASSERT(curr == object);
+  if (prev != NULL)
+    {
+      prev->flink = object->flink;
+    }
+  else
+    {
+      g_shmfs.head = object->flink;
+    }
+
+  if (object->paddr != NULL)
+    {
+      kumm_free(object->paddr);
+    }
+
+  kmm_free(object);
+}
+
+/****************************************************************************
+ * Name: shmfs_open
+ ****************************************************************************/
+
+static int shmfs_open(FAR struct file *filep)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+
+  DEBUGASSERT(object != NULL);
+
+  /* Each open file description is a reference.  This also catches dup()
+   * which re-opens the inode.
+   */
+
+  nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+  object->crefs++;
+  nxsem_post(&g_shmfs.exclsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmfs_close
+ ****************************************************************************/
+
+static int shmfs_close(FAR struct file *filep)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+
+  DEBUGASSERT(object != NULL);
+
+  shmfs_release(object);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmfs_read
+ ****************************************************************************/
+
+static ssize_t shmfs_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  ssize_t nread = 0;
+
+  nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+  if (filep->f_pos < object->length)
+    {
+      nread = object->length - filep->f_pos;
+      if (nread > buflen)
+        {
+          nread = buflen;
+        }
+
+      memcpy(buffer, (FAR uint8_t *)object->paddr + filep->f_pos, nread);
+      filep->f_pos += nread;
+    }
+
+  nxsem_post(&g_shmfs.exclsem);
+  return nread;
+}
+
+/****************************************************************************
+ * Name: shmfs_write
+ *
+ * Description:
+ *   Writes are limited to the current size of the object.  Use ftruncate()
+ *   to size the object first, as with any POSIX shared memory object.
+ *
+ ****************************************************************************/
+
+static ssize_t shmfs_write(FAR struct file *filep, FAR const char *buffer,
+                           size_t buflen)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  ssize_t nwritten;
+
+  nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+  if (filep->f_pos >= object->length)
+    {
+      nwritten = buflen > 0 ? -EFBIG : 0;
+    }
+  else
+    {
+      nwritten = object->length - filep->f_pos;
+      if (nwritten > buflen)
+        {
+          nwritten = buflen;
+        }
+
+      memcpy((FAR uint8_t *)object->paddr + filep->f_pos, buffer, nwritten);
+      filep->f_pos += nwritten;
+    }
+
+  nxsem_post(&g_shmfs.exclsem);
+  return nwritten;
+}
+
+/****************************************************************************
+ * Name: shmfs_seek
+ ****************************************************************************/
+
+static off_t shmfs_seek(FAR struct file *filep, off_t offset, int whence)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  off_t position;
+
+  switch (whence)
+    {
+      case SEEK_SET:
+        position = offset;
+        break;
+
+      case SEEK_CUR:
+        position = filep->f_pos + offset;
+        break;
+
+      case SEEK_END:
+        position = object->length + offset;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  if (position < 0)
+    {
+      return -EINVAL;
+    }
+
+  filep->f_pos = position;
+  return position;
+}
+
+/****************************************************************************
+ * Name: shmfs_ioctl
+ ****************************************************************************/
+
+static int shmfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  int ret;
+
+  switch (cmd)
+    {
+      /* Return the base address of the object.  This is a new mapping
+       * reference which is dropped again by munmap().
+       */
+
+      case FIOC_MMAP:
+        {
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+
+          if (ppv == NULL)
+            {
+              return -EINVAL;
+            }
+
+          nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+          if (object->length == 0)
+            {
+              ret = -ENXIO;
+            }
+          else
+            {
+              object->crefs++;
+              object->nmaps++;
+              *ppv = object->paddr;
+              ret = OK;
+            }
+
+          nxsem_post(&g_shmfs.exclsem);
+        }
+        break;
+
+      case FIOC_TRUNCATE:
+        {
+          if ((filep->f_oflags & O_WROK) == 0)
+            {
+              return -EBADF;
+            }
+
+          ret = shmfs_truncate(object, (off_t)arg);
+        }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: shmfs_unlink
+ *
+ * Description:
+ *   The name is being removed from the namespace;  drop its reference.
+ *   Open descriptors and mappings keep the object alive.
+ *
+ ****************************************************************************/
+
+static int shmfs_unlink(FAR struct inode *inode)
+{
+  FAR struct shmfs_object_s *object = inode->i_private;
+
+  DEBUGASSERT(object != NULL);
+
+  shmfs_release(object);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmfs_alloc
+ *
+ * Description:
+ *   Allocate a new, empty shared memory object.  The object is returned
+ *   holding the single reference of its name.
+ *
+ ****************************************************************************/
+
+FAR struct shmfs_object_s *shmfs_alloc(void)
+{
+  FAR struct shmfs_object_s *object;
+
+  object = (FAR struct shmfs_object_s *)
+    kmm_zalloc(sizeof(struct shmfs_object_s));
+
+  if (object != NULL)
+    {
+      object->crefs = 1;
+
+      nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+      object->flink = g_shmfs.head;
+      g_shmfs.head  = object;
+      nxsem_post(&g_shmfs.exclsem);
+    }
+
+  return object;
+}
+
+/****************************************************************************
+ * Name: shmfs_release
+ *
+ * Description:
+ *   Drop one reference to a shared memory object, freeing the object if
+ *   that was the last one.
+ *
+ ****************************************************************************/
+
+void shmfs_release(FAR struct shmfs_object_s *object)
+{
+  nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+  shmfs_unref(object);
+  nxsem_post(&g_shmfs.exclsem);
+}
+
+/****************************************************************************
+ * Name: shmfs_truncate
+ *
+ * Description:
+ *   Set the size of a shared memory object.  Any extended area is zero
+ *   filled.  The size cannot be changed while the object is mapped.
+ *
+ ****************************************************************************/
+
+int shmfs_truncate(FAR struct shmfs_object_s *object, off_t length)
+{
+  FAR void *paddr;
+  int ret = OK;
+
+  if (length < 0)
+    {
+      return -EINVAL;
+    }
+
+  nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+  if ((size_t)length == object->length)
+    {
+      goto errout_with_lock;
+    }
+
+  /* The backing store cannot move under an existing mapping */
+
+  if (object->nmaps > 0)
+    {
+      ret = -EBUSY;
+      goto errout_with_lock;
+    }
+
+  if (length == 0)
+    {
+      kumm_free(object->paddr);
+      object->paddr = NULL;
+    }
+  else
+    {
+      /* The backing store comes from the user heap so that it is
+       * accessible to user tasks in the protected build.
+       */
+
+      paddr = kumm_realloc(object->paddr, length);
+      if (paddr == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_lock;
+        }
+
+      if ((size_t)length > object->length)
+        {
+          memset((FAR uint8_t *)paddr + object->length, 0,
+                 length - object->length);
+        }
+
+      object->paddr = paddr;
+    }
+
+  object->length = length;
+
+errout_with_lock:
+  nxsem_post(&g_shmfs.exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: shmfs_munmap
+ *
+ * Description:
+ *   Drop the mapping reference of the shared memory object that contains
+ *   'start'.  Returns -ENOENT if 'start' is not within any object so that
+ *   munmap() may try other kinds of mappings.
+ *
+ ****************************************************************************/
+
+int shmfs_munmap(FAR void *start, size_t length)
+{
+  FAR struct shmfs_object_s *curr;
+  int ret = -ENOENT;
+
+  nxsem_wait_uninterruptible(&g_shmfs.exclsem);
+  for (curr = g_shmfs.head; curr != NULL; curr = curr->flink)
+    {
+      if (curr->nmaps > 0 &&
+          (uintptr_t)start >= (uintptr_t)curr->paddr &&
+          (uintptr_t)start <  (uintptr_t)curr->paddr + curr->length)
+        {
+          /* Each mmap() is a reference; expect one munmap() for each and
+           * treat any part of the object as naming the whole mapping.
+           */
+
+          curr->nmaps--;
+          shmfs_unref(curr);
+          ret = OK;
+          break;
+        }
+    }
+
+  nxsem_post(&g_shmfs.exclsem);
+  return ret;
+}
+
+#endif /* CONFIG_FS_SHM */
@@ -0,0 +1,165 @@
+/****************************************************************************
+ * fs/shm/shmfs.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __FS_SHM_SHMFS_H
+#define __FS_SHM_SHMFS_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/fs.h>
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_FS_SHMPATH
+#  define CONFIG_FS_SHMPATH "/var/shm"
+#endif
+
+/* Sizes of things */
+
+#define MAX_SHM_PATH 64
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes one shared memory object.  The object is a
+ * character driver inode under CONFIG_FS_SHMPATH whose private data is this
+ * structure.  The backing store is a single contiguous allocation so that
+ * mmap() returns the same address to every caller:  Attaching is just a
+ * reference count increment and no data is ever copied.
+ *
+ * The object is freed when the last reference is dropped.  References are
+ * held by:
+ *
+ * - The name in CONFIG_FS_SHMPATH until shm_unlink() (or, for memfd_create(),
+ *   immediately),
+ * - Each open file description, and
+ * - Each mapping returned by mmap() until munmap().
+ */
+
+struct shmfs_object_s
+{
+  FAR struct shmfs_object_s *flink; /* Implements a singly linked list */
+  FAR void *paddr;                  /* Start of the backing store */
+  size_t length;                    /* Length of the backing store */
+  uint16_t crefs;                   /* Number of references */
+  uint16_t nmaps;                   /* Number of those that are mappings */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* The file operations of every shared memory object inode */
+
+EXTERN const struct file_operations g_shmfs_fops;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmfs_alloc
+ *
+ * Description:
+ *   Allocate a new, empty shared memory object.  The object is returned
+ *   holding the single reference of its name.
+ *
+ ****************************************************************************/
+
+FAR struct shmfs_object_s *shmfs_alloc(void);
+
+/****************************************************************************
+ * Name: shmfs_release
+ *
+ * Description:
+ *   Drop one reference to a shared memory object, freeing the object if
+ *   that was the last one.
+ *
+ ****************************************************************************/
+
+void shmfs_release(FAR struct shmfs_object_s *object);
+
+/****************************************************************************
+ * Name: shmfs_truncate
+ *
+ * Description:
+ *   Set the size of a shared memory object.  Any extended area is zero
+ *   filled.  The size cannot be changed while the object is mapped.
+ *
+ ****************************************************************************/
+
+int shmfs_truncate(FAR struct shmfs_object_s *object, off_t length);
+
+/****************************************************************************
+ * Name: shmfs_munmap
+ *
+ * Description:
+ *   Drop the mapping reference of the shared memory object that contains
+ *   'start'.  Returns -ENOENT if 'start' is not within any object so that
+ *   munmap() may try other kinds of mappings.
+ *
+ ****************************************************************************/
+
+int shmfs_munmap(FAR void *start, size_t length);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FS_SHM */
+#endif /* __FS_SHM_SHMFS_H */
@@ -122,6 +122,7 @@ struct spiffs_sem_s
 /* This structure represents the current state of an SPIFFS volume */
 
 struct spiffs_file_s;               /* Forward reference */
+struct spiffs_hdrndx_s;             /* Forward reference */
 
 struct spiffs_s
 {
@@ -133,6 +134,9 @@ struct spiffs_s
   FAR uint8_t *work;                /* Secondary work buffer, size of a logical page */
   FAR uint8_t *mtd_work;            /* MTD I/O buffer for read-modify-write */
   FAR void *cache;                  /* Cache memory */
+#ifdef CONFIG_SPIFFS_HDRNDX
+  FAR struct spiffs_hdrndx_s *hdrndx; /* In-RAM object header index */
+#endif
 #ifdef CONFIG_HAVE_LONG_LONG
   off64_t media_size;               /* Physical size of the SPI flash */
 #else
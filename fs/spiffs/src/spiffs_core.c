@@ -54,6 +54,7 @@
 #include "spiffs_gc.h"
 #include "spiffs_cache.h"
 #include "spiffs_core.h"
+#include "spiffs_hdrndx.h"
 
 /****************************************************************************
  * Private Types
@@ -1526,6 +1527,25 @@ void spiffs_fobj_event(FAR struct spiffs_s *fs,
   finfo("Event=%s objid=%04x spndx=%04x npgndx=%04x nsz=%d\n",
         evname[MIN(ev, 5)], objid_raw, spndx, new_pgndx, new_size);
 
+#ifdef CONFIG_SPIFFS_HDRNDX
+  /* Keep the in-RAM object header index up to date.  When an object index
+   * header is given, it carries the (possibly new) object name.
+   */
+
+  if (spndx == 0)
+    {
+      if (ev == SPIFFS_EV_NDXDEL)
+        {
+          spiffs_hdrndx_remove(fs, objid);
+        }
+      else
+        {
+          spiffs_hdrndx_update(fs, objid, new_pgndx, objndx == NULL ? NULL :
+                  ((FAR struct spiffs_pgobj_ndxheader_s *)objndx)->name);
+        }
+    }
+#endif
+
   /* Update index caches in all file descriptors */
 
   for (fobj  = (FAR struct spiffs_file_s *)dq_peek(&fs->objq);
@@ -2676,6 +2696,22 @@ int spiffs_find_objhdr_pgndx(FAR struct spiffs_s *fs,
   int entry;
   int ret;
 
+#ifdef CONFIG_SPIFFS_HDRNDX
+  int16_t hdr_pgndx;
+
+  /* Try the in-RAM index first; this avoids scanning the lookup pages */
+
+  if (spiffs_hdrndx_find(fs, name, &hdr_pgndx) == OK)
+    {
+      if (pgndx != NULL)
+        {
+          *pgndx = hdr_pgndx;
+        }
+
+      return OK;
+    }
+#endif
+
   ret = spiffs_foreach_objlu(fs, fs->lu_blkndx, fs->lu_entry,
                              0, 0, spiffs_find_objhdr_pgndx_callback,
                              name, 0, &blkndx, &entry);
@@ -2690,6 +2726,14 @@ int spiffs_find_objhdr_pgndx(FAR struct spiffs_s *fs,
       return ret;
     }
 
+#ifdef CONFIG_SPIFFS_HDRNDX
+  if (ret >= 0)
+    {
+      spiffs_hdrndx_add(fs, SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry),
+                        name);
+    }
+#endif
+
   if (pgndx != NULL)
     {
       *pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
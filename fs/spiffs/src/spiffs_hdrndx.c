@@ -0,0 +1,394 @@
+/****************************************************************************
+ * fs/spiffs/src/spiffs_hdrndx.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "spiffs.h"
+#include "spiffs_core.h"
+#include "spiffs_cache.h"
+#include "spiffs_hdrndx.h"
+
+#ifdef CONFIG_SPIFFS_HDRNDX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SPIFFS_CACHE_HITSCORE
+#  define CONFIG_SPIFFS_CACHE_HITSCORE 4
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_hash
+ *
+ * Description:
+ *   Hash an object name (djb2).
+ *
+ ****************************************************************************/
+
+static uint32_t spiffs_hdrndx_hash(FAR const uint8_t *name)
+{
+  uint32_t hash = 5381;
+  int i;
+
+  for (i = 0; i < CONFIG_SPIFFS_NAME_MAX && name[i] != '\0'; i++)
+    {
+      hash = (hash << 5) + hash + name[i];
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_readhdr
+ *
+ * Description:
+ *   Read the page header at 'pgndx' and check that it is the object index
+ *   header of a live object.
+ *
+ ****************************************************************************/
+
+static int spiffs_hdrndx_readhdr(FAR struct spiffs_s *fs, int16_t pgndx,
+                                 FAR struct spiffs_pgobj_ndxheader_s *objhdr)
+{
+  int ret;
+
+  ret = spiffs_cache_read(fs, SPIFFS_OP_T_OBJ_LU2 | SPIFFS_OP_C_READ,
+                          0, SPIFFS_PAGE_TO_PADDR(fs, pgndx),
+                          sizeof(struct spiffs_pgobj_ndxheader_s),
+                          (FAR uint8_t *)objhdr);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((objhdr->phdr.objid & SPIFFS_OBJID_NDXFLAG) == 0 ||
+      objhdr->phdr.objid == SPIFFS_OBJID_FREE ||
+      objhdr->phdr.spndx != 0 ||
+      (objhdr->phdr.flags & (SPIFFS_PH_FLAG_DELET | SPIFFS_PH_FLAG_FINAL |
+                             SPIFFS_PH_FLAG_NDXDELE)) !=
+      (SPIFFS_PH_FLAG_DELET | SPIFFS_PH_FLAG_NDXDELE))
+    {
+      return -ENOENT;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_lookup
+ *
+ * Description:
+ *   Return the index entry for 'objid' or, if there is none, the entry that
+ *   should be replaced to make room for it.
+ *
+ ****************************************************************************/
+
+static FAR struct spiffs_hdrndx_s *
+spiffs_hdrndx_lookup(FAR struct spiffs_s *fs, int16_t objid,
+                     FAR struct spiffs_hdrndx_s **victim)
+{
+  FAR struct spiffs_hdrndx_s *entry;
+  int i;
+
+  *victim = &fs->hdrndx[0];
+  for (i = 0; i < CONFIG_SPIFFS_HDRNDX_NENTRIES; i++)
+    {
+      entry = &fs->hdrndx[i];
+      if (entry->objid == objid)
+        {
+          return entry;
+        }
+
+      /* Prefer an unused entry, then the one with the lowest score */
+
+      if ((*victim)->objid != 0 &&
+          (entry->objid == 0 || entry->score < (*victim)->score))
+        {
+          *victim = entry;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_set
+ *
+ * Description:
+ *   Add or refresh the index entry for an object.
+ *
+ ****************************************************************************/
+
+static void spiffs_hdrndx_set(FAR struct spiffs_s *fs, int16_t objid,
+                              int16_t pgndx, uint32_t hash)
+{
+  FAR struct spiffs_hdrndx_s *victim;
+  FAR struct spiffs_hdrndx_s *entry;
+
+  entry = spiffs_hdrndx_lookup(fs, objid, &victim);
+  if (entry == NULL)
+    {
+      entry        = victim;
+      entry->objid = objid;
+      entry->score = CONFIG_SPIFFS_CACHE_HITSCORE;
+    }
+
+  entry->pgndx = pgndx;
+  entry->hash  = hash;
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_callback
+ *
+ * Description:
+ *   Object lookup visitor used to populate the index at mount time.
+ *
+ ****************************************************************************/
+
+static int spiffs_hdrndx_callback(FAR struct spiffs_s *fs, int16_t objid,
+                                  int16_t blkndx, int entry,
+                                  FAR const void *user_const,
+                                  FAR void *user_var)
+{
+  struct spiffs_pgobj_ndxheader_s objhdr;
+  int16_t pgndx;
+
+  if (objid == SPIFFS_OBJID_FREE || objid == SPIFFS_OBJID_DELETED ||
+      (objid & SPIFFS_OBJID_NDXFLAG) == 0)
+    {
+      return SPIFFS_VIS_COUNTINUE;
+    }
+
+  pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+  if (spiffs_hdrndx_readhdr(fs, pgndx, &objhdr) == OK)
+    {
+      spiffs_hdrndx_set(fs, objid & ~SPIFFS_OBJID_NDXFLAG, pgndx,
+                        spiffs_hdrndx_hash(objhdr.name));
+    }
+
+  return SPIFFS_VIS_COUNTINUE;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_initialize
+ ****************************************************************************/
+
+int spiffs_hdrndx_initialize(FAR struct spiffs_s *fs)
+{
+  int ret;
+
+  fs->hdrndx = (FAR struct spiffs_hdrndx_s *)
+    kmm_zalloc(CONFIG_SPIFFS_HDRNDX_NENTRIES * sizeof(struct spiffs_hdrndx_s));
+
+  if (fs->hdrndx == NULL)
+    {
+      ferr("ERROR: Failed to allocate object header index\n");
+      return -ENOMEM;
+    }
+
+  ret = spiffs_foreach_objlu(fs, 0, 0, 0, 0, spiffs_hdrndx_callback,
+                             NULL, NULL, NULL, NULL);
+  if (ret == SPIFFS_VIS_END)
+    {
+      ret = OK;
+    }
+  else if (ret < 0)
+    {
+      ferr("ERROR: spiffs_foreach_objlu() failed: %d\n", ret);
+      spiffs_hdrndx_release(fs);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_release
+ ****************************************************************************/
+
+void spiffs_hdrndx_release(FAR struct spiffs_s *fs)
+{
+  if (fs->hdrndx != NULL)
+    {
+      kmm_free(fs->hdrndx);
+      fs->hdrndx = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_find
+ ****************************************************************************/
+
+int spiffs_hdrndx_find(FAR struct spiffs_s *fs, FAR const uint8_t *name,
+                       FAR int16_t *pgndx)
+{
+  struct spiffs_pgobj_ndxheader_s objhdr;
+  FAR struct spiffs_hdrndx_s *entry;
+  FAR struct spiffs_hdrndx_s *found = NULL;
+  uint32_t hash;
+  int i;
+
+  if (fs->hdrndx == NULL)
+    {
+      return -ENOENT;
+    }
+
+  /* Every lookup ages all entries; a hit gains CONFIG_SPIFFS_CACHE_HITSCORE
+   * points so that frequently opened files stay in the index.
+   */
+
+  hash = spiffs_hdrndx_hash(name);
+  for (i = 0; i < CONFIG_SPIFFS_HDRNDX_NENTRIES; i++)
+    {
+      entry = &fs->hdrndx[i];
+      if (entry->objid == 0)
+        {
+          continue;
+        }
+
+      if (entry->score > 0)
+        {
+          entry->score--;
+        }
+
+      if (found == NULL && entry->hash == hash &&
+          spiffs_hdrndx_readhdr(fs, entry->pgndx, &objhdr) == OK &&
+          (objhdr.phdr.objid & ~SPIFFS_OBJID_NDXFLAG) == entry->objid &&
+          strncmp((FAR const char *)objhdr.name, (FAR const char *)name,
+                  CONFIG_SPIFFS_NAME_MAX) == 0)
+        {
+          found = entry;
+        }
+    }
+
+  if (found == NULL)
+    {
+      return -ENOENT;
+    }
+
+  found->score = found->score > 255 - CONFIG_SPIFFS_CACHE_HITSCORE ?
+                 255 : found->score + CONFIG_SPIFFS_CACHE_HITSCORE;
+
+  *pgndx = found->pgndx;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_add
+ ****************************************************************************/
+
+void spiffs_hdrndx_add(FAR struct spiffs_s *fs, int16_t pgndx,
+                       FAR const uint8_t *name)
+{
+  struct spiffs_pgobj_ndxheader_s objhdr;
+
+  if (fs->hdrndx != NULL && spiffs_hdrndx_readhdr(fs, pgndx, &objhdr) == OK)
+    {
+      spiffs_hdrndx_set(fs, objhdr.phdr.objid & ~SPIFFS_OBJID_NDXFLAG, pgndx,
+                        spiffs_hdrndx_hash(name));
+    }
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_update
+ ****************************************************************************/
+
+void spiffs_hdrndx_update(FAR struct spiffs_s *fs, int16_t objid,
+                          int16_t pgndx, FAR const uint8_t *name)
+{
+  FAR struct spiffs_hdrndx_s *victim;
+  FAR struct spiffs_hdrndx_s *entry;
+
+  if (fs->hdrndx == NULL)
+    {
+      return;
+    }
+
+  objid &= ~SPIFFS_OBJID_NDXFLAG;
+  if (name != NULL)
+    {
+      spiffs_hdrndx_set(fs, objid, pgndx, spiffs_hdrndx_hash(name));
+    }
+  else
+    {
+      entry = spiffs_hdrndx_lookup(fs, objid, &victim);
+      if (entry != NULL)
+        {
+          entry->pgndx = pgndx;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_remove
+ ****************************************************************************/
+
+void spiffs_hdrndx_remove(FAR struct spiffs_s *fs, int16_t objid)
+{
+  FAR struct spiffs_hdrndx_s *victim;
+  FAR struct spiffs_hdrndx_s *entry;
+
+  if (fs->hdrndx == NULL)
+    {
+      return;
+    }
+
+  entry = spiffs_hdrndx_lookup(fs, objid & ~SPIFFS_OBJID_NDXFLAG, &victim);
+  if (entry != NULL)
+    {
+      entry->objid = 0;
+    }
+}
+
+#endif /* CONFIG_SPIFFS_HDRNDX */
@@ -0,0 +1,199 @@
+/****************************************************************************
+ * fs/spiffs/src/spiffs_hdrndx.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __FS_SPIFFS_SRC_SPIFFS_HDRNDX_H
+#define __FS_SPIFFS_SRC_SPIFFS_HDRNDX_H
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#ifdef CONFIG_SPIFFS_HDRNDX
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One entry in the in-RAM object header index.  The index maps a hash of
+ * the file name to the object ID and the FLASH page of the object index
+ * header so that a file can be found without scanning the object lookup
+ * pages.  The index is only a hint:  an entry is always verified against
+ * the header page on FLASH before it is used.
+ */
+
+struct spiffs_hdrndx_s
+{
+  uint32_t hash;             /* Hash of the object name */
+  int16_t objid;             /* Object ID (without SPIFFS_OBJID_NDXFLAG), 0=unused */
+  int16_t pgndx;             /* Page index of the object index header */
+  uint8_t score;             /* Replacement score (see CONFIG_SPIFFS_CACHE_HITSCORE) */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+struct spiffs_s;  /* Forward reference */
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_initialize
+ *
+ * Description:
+ *   Allocate the object header index and populate it by scanning the object
+ *   lookup pages once.  Called when the volume is mounted.
+ *
+ * Input Parameters:
+ *   fs - A reference to the SPIFFS volume object instance
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; A negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int spiffs_hdrndx_initialize(FAR struct spiffs_s *fs);
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_release
+ *
+ * Description:
+ *   Free the object header index.  Called when the volume is unmounted.
+ *
+ * Input Parameters:
+ *   fs - A reference to the SPIFFS volume object instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_hdrndx_release(FAR struct spiffs_s *fs);
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_find
+ *
+ * Description:
+ *   Find the object index header page of the object with the given name
+ *   using only the in-RAM index and a read of the candidate header page.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   name  - The name of the object
+ *   pgndx - The location to return the header page index
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if the object is
+ *   not in the index.  The caller must then fall back to a full scan.
+ *
+ ****************************************************************************/
+
+int spiffs_hdrndx_find(FAR struct spiffs_s *fs, FAR const uint8_t *name,
+                       FAR int16_t *pgndx);
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_add
+ *
+ * Description:
+ *   Add the object whose index header is at 'pgndx' to the index.  Used
+ *   after an object was found by a full scan.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   pgndx - The page index of the object index header
+ *   name  - The name of the object
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_hdrndx_add(FAR struct spiffs_s *fs, int16_t pgndx,
+                       FAR const uint8_t *name);
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_update
+ *
+ * Description:
+ *   Record that the object index header of 'objid' has moved to 'pgndx'.
+ *   If 'name' is not NULL, the name hash is updated too and the object is
+ *   added if it is not yet in the index.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   objid - The object ID (with or without SPIFFS_OBJID_NDXFLAG)
+ *   pgndx - The new page index of the object index header
+ *   name  - The name of the object or NULL if unknown
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_hdrndx_update(FAR struct spiffs_s *fs, int16_t objid,
+                          int16_t pgndx, FAR const uint8_t *name);
+
+/****************************************************************************
+ * Name: spiffs_hdrndx_remove
+ *
+ * Description:
+ *   Remove a deleted object from the index.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   objid - The object ID (with or without SPIFFS_OBJID_NDXFLAG)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_hdrndx_remove(FAR struct spiffs_s *fs, int16_t objid);
+
+#endif /* CONFIG_SPIFFS_HDRNDX */
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif  /* __FS_SPIFFS_SRC_SPIFFS_HDRNDX_H */
@@ -67,6 +67,7 @@
 #include "spiffs_cache.h"
 #include "spiffs_gc.h"
 #include "spiffs_check.h"
+#include "spiffs_hdrndx.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -1477,6 +1478,19 @@ static int spiffs_bind(FAR struct inode *mtdinode, FAR const void *data,
     }
 #endif
 
+#ifdef CONFIG_SPIFFS_HDRNDX
+  /* Build the in-RAM object header index so that open() does not need to
+   * scan the object lookup pages.  The index is only an accelerator; the
+   * volume is still usable without it.
+   */
+
+  ret = spiffs_hdrndx_initialize(fs);
+  if (ret < 0)
+    {
+      fwarn("WARNING: spiffs_hdrndx_initialize() failed: %d\n", ret);
+    }
+#endif
+
   /* Return the new file system handle */
 
   *handle = (FAR void *)fs;
@@ -1542,6 +1556,10 @@ static int spiffs_unbind(FAR void *handle, FAR struct inode **mtdinode,
       kmm_free(fs->cache);
     }
 
+#ifdef CONFIG_SPIFFS_HDRNDX
+  spiffs_hdrndx_release(fs);
+#endif
+
    /* Free the volume memory (note that the semaphore is now stale!) */
 
   nxsem_destroy(&fs->exclsem.sem);
@@ -42,6 +42,7 @@
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 #include <dirent.h>
@@ -51,6 +52,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/fs/ioctl.h>
@@ -71,6 +73,32 @@
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+#  ifndef CONFIG_FS_TMPFS_FILE_BLOCKSIZE
+#    define CONFIG_FS_TMPFS_FILE_BLOCKSIZE 512
+#  endif
+#  ifndef CONFIG_FS_TMPFS_FILE_BLOCKPOOL
+#    define CONFIG_FS_TMPFS_FILE_BLOCKPOOL 8
+#  endif
+#  ifndef CONFIG_FS_TMPFS_MAXSIZE
+#    define CONFIG_FS_TMPFS_MAXSIZE 0
+#  endif
+
+#  if CONFIG_FS_TMPFS_FILE_BLOCKSIZE < 16
+#    error CONFIG_FS_TMPFS_FILE_BLOCKSIZE is too small
+#  endif
+
+#  define TMPFS_BLOCKSIZE      CONFIG_FS_TMPFS_FILE_BLOCKSIZE
+
+/* The number of blocks needed to hold n bytes */
+
+#  define TMPFS_NBLOCKS(n)     (((n) + TMPFS_BLOCKSIZE - 1) / TMPFS_BLOCKSIZE)
+
+#  ifndef MIN
+#    define MIN(a,b)           ((a) < (b) ? (a) : (b))
+#  endif
+#endif
+
 #define tmpfs_lock_file(tfo) \
            (tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -95,6 +123,14 @@ static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
               unsigned int nentries);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
               size_t newsize);
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+static int  tmpfs_alloc_block(FAR struct tmpfs_s *fs, FAR uint8_t **block);
+static void tmpfs_free_block(FAR struct tmpfs_s *fs, FAR uint8_t *block);
+static int  tmpfs_grow_blocks(FAR struct tmpfs_file_s *tfo, size_t nblocks);
+static void tmpfs_free_blocks(FAR struct tmpfs_file_s *tfo, size_t first);
+static int  tmpfs_parse_options(FAR struct tmpfs_s *fs,
+              FAR const char *options);
+#endif
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -375,6 +411,41 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
  * Name: tmpfs_realloc_file
  ****************************************************************************/
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
+                              size_t newsize)
+{
+  FAR struct tmpfs_file_s *tmptfo = *tfo;
+  size_t nblocks;
+  size_t offset;
+
+  /* The file object itself never moves.  Growing the file just creates a
+   * hole that reads as zero.  Shrinking the file releases every block that
+   * lies wholly beyond the new end of the file.
+   */
+
+  if (newsize < tmptfo->tfo_size)
+    {
+      nblocks = TMPFS_NBLOCKS(newsize);
+      tmpfs_free_blocks(tmptfo, nblocks);
+
+      /* Bytes beyond the end of the file in the final block must read as
+       * zero if the file is extended again.
+       */
+
+      offset = newsize % TMPFS_BLOCKSIZE;
+      if (offset > 0 && nblocks <= tmptfo->tfo_nblocks &&
+          tmptfo->tfo_blocks[nblocks - 1] != NULL)
+        {
+          memset(&tmptfo->tfo_blocks[nblocks - 1][offset], 0,
+                 TMPFS_BLOCKSIZE - offset);
+        }
+    }
+
+  tmptfo->tfo_size = newsize;
+  return OK;
+}
+#else
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
                               size_t newsize)
 {
@@ -439,6 +510,218 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
   *tfo              = newtfo;
   return OK;
 }
+#endif
+
+/****************************************************************************
+ * Name: tmpfs_alloc_block
+ *
+ * Description:
+ *   Get one file data block, from the free block pool if possible.  The
+ *   content of the block is not initialized.  -ENOSPC is returned if the
+ *   size limit of the file system has been reached.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+static int tmpfs_alloc_block(FAR struct tmpfs_s *fs, FAR uint8_t **block)
+{
+  FAR struct tmpfs_freeblock_s *tfb;
+
+  nxsem_wait_uninterruptible(&fs->tfs_blksem);
+
+  if (fs->tfs_maxblocks > 0 && fs->tfs_nblocks >= fs->tfs_maxblocks)
+    {
+      nxsem_post(&fs->tfs_blksem);
+      return -ENOSPC;
+    }
+
+  tfb = fs->tfs_pool;
+  if (tfb != NULL)
+    {
+      fs->tfs_pool = tfb->tfb_flink;
+      fs->tfs_npool--;
+    }
+
+  /* Account for the block now so that the limit holds while the heap
+   * allocation is performed below without the lock.
+   */
+
+  fs->tfs_nblocks++;
+  nxsem_post(&fs->tfs_blksem);
+
+  if (tfb == NULL)
+    {
+      tfb = (FAR struct tmpfs_freeblock_s *)kmm_malloc(TMPFS_BLOCKSIZE);
+      if (tfb == NULL)
+        {
+          nxsem_wait_uninterruptible(&fs->tfs_blksem);
+          fs->tfs_nblocks--;
+          nxsem_post(&fs->tfs_blksem);
+          return -ENOMEM;
+        }
+    }
+
+  *block = (FAR uint8_t *)tfb;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_block
+ *
+ * Description:
+ *   Return one file data block to the free block pool or, if the pool is
+ *   full, to the heap.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_block(FAR struct tmpfs_s *fs, FAR uint8_t *block)
+{
+  FAR struct tmpfs_freeblock_s *tfb = (FAR struct tmpfs_freeblock_s *)block;
+
+  nxsem_wait_uninterruptible(&fs->tfs_blksem);
+
+  DEBUGASSERT(fs->tfs_nblocks > 0);
+  fs->tfs_nblocks--;
+
+  if (fs->tfs_npool < CONFIG_FS_TMPFS_FILE_BLOCKPOOL)
+    {
+      tfb->tfb_flink = fs->tfs_pool;
+      fs->tfs_pool   = tfb;
+      fs->tfs_npool++;
+      tfb            = NULL;
+    }
+
+  nxsem_post(&fs->tfs_blksem);
+
+  if (tfb != NULL)
+    {
+      kmm_free(tfb);
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_grow_blocks
+ *
+ * Description:
+ *   Make sure that the block table of the file has at least 'nblocks'
+ *   entries.  The table grows geometrically so that appending to a file
+ *   is amortized O(1).  New entries are holes.
+ *
+ ****************************************************************************/
+
+static int tmpfs_grow_blocks(FAR struct tmpfs_file_s *tfo, size_t nblocks)
+{
+  FAR uint8_t **newblocks;
+  size_t newsize;
+
+  if (nblocks <= tfo->tfo_nblocks)
+    {
+      return OK;
+    }
+
+  newsize = tfo->tfo_nblocks > 0 ? 2 * tfo->tfo_nblocks : 8;
+  if (newsize < nblocks)
+    {
+      newsize = nblocks;
+    }
+
+  newblocks = (FAR uint8_t **)
+    kmm_realloc(tfo->tfo_blocks, newsize * sizeof(FAR uint8_t *));
+  if (newblocks == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(&newblocks[tfo->tfo_nblocks], 0,
+         (newsize - tfo->tfo_nblocks) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_alloc  += (newsize - tfo->tfo_nblocks) * sizeof(FAR uint8_t *);
+  tfo->tfo_blocks  = newblocks;
+  tfo->tfo_nblocks = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_blocks
+ *
+ * Description:
+ *   Release all data blocks of the file starting with block 'first'.  The
+ *   block table itself is freed too if 'first' is zero.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_blocks(FAR struct tmpfs_file_s *tfo, size_t first)
+{
+  size_t i;
+
+  for (i = first; i < tfo->tfo_nblocks; i++)
+    {
+      if (tfo->tfo_blocks[i] != NULL)
+        {
+          tmpfs_free_block(tfo->tfo_fs, tfo->tfo_blocks[i]);
+          tfo->tfo_blocks[i] = NULL;
+          tfo->tfo_alloc    -= TMPFS_BLOCKSIZE;
+        }
+    }
+
+  if (first == 0 && tfo->tfo_blocks != NULL)
+    {
+      kmm_free(tfo->tfo_blocks);
+      tfo->tfo_blocks  = NULL;
+      tfo->tfo_nblocks = 0;
+      tfo->tfo_alloc   = SIZEOF_TMPFS_FILE(0);
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_parse_options
+ *
+ * Description:
+ *   Parse the mount options.  The only option is "size=<bytes>[k|m]" that
+ *   limits the amount of file data in the file system.  Other strings are
+ *   ignored as before.
+ *
+ ****************************************************************************/
+
+static int tmpfs_parse_options(FAR struct tmpfs_s *fs,
+                               FAR const char *options)
+{
+  FAR char *endptr;
+  unsigned long size;
+
+  if (options == NULL || strncmp(options, "size=", 5) != 0)
+    {
+      return OK;
+    }
+
+  size = strtoul(options + 5, &endptr, 10);
+  switch (*endptr)
+    {
+      case 'k':
+      case 'K':
+        size <<= 10;
+        endptr++;
+        break;
+
+      case 'm':
+      case 'M':
+        size <<= 20;
+        endptr++;
+        break;
+
+      default:
+        break;
+    }
+
+  if (endptr == options + 5 || *endptr != '\0')
+    {
+      return -EINVAL;
+    }
+
+  fs->tfs_maxblocks = TMPFS_NBLOCKS(size);
+  return OK;
+}
+#endif /* CONFIG_FS_TMPFS_FILE_BLOCKS */
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -475,6 +758,9 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
 
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+      tmpfs_free_blocks(tfo, 0);
+#endif
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
       kmm_free(tfo);
     }
@@ -642,6 +928,11 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
   tfo->tfo_refs  = 1;
   tfo->tfo_flags = 0;
   tfo->tfo_size  = 0;
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  tfo->tfo_fs      = NULL;
+  tfo->tfo_blocks  = NULL;
+  tfo->tfo_nblocks = 0;
+#endif
 
   tfo->tfo_exclsem.ts_holder = getpid();
   tfo->tfo_exclsem.ts_count  = 1;
@@ -735,6 +1026,10 @@ static int tmpfs_create_file(FAR struct tmpfs_s *fs,
       goto errout_with_parent;
     }
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  newtfo->tfo_fs = fs;
+#endif
+
   /* Then add the new, empty file to the directory */
 
   ret = tmpfs_add_dirent(&parent, (FAR struct tmpfs_object_s *)newtfo, name);
@@ -1275,6 +1570,10 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           tfo->tfo_flags |= TFO_FLAG_UNLINKED;
           return TMPFS_UNLINKED;
         }
+
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+      tmpfs_free_blocks(tfo, 0);
+#endif
     }
 
   /* Free the object now */
@@ -1543,6 +1842,9 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+      tmpfs_free_blocks(tfo, 0);
+#endif
       kmm_free(tfo);
       return OK;
     }
@@ -1564,6 +1866,13 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   ssize_t nread;
   off_t startpos;
   off_t endpos;
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  FAR uint8_t *block;
+  size_t blkno;
+  size_t offset;
+  size_t nbytes;
+  size_t ncopied;
+#endif
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
         filep, buffer, (unsigned long)buflen);
@@ -1589,9 +1898,37 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
       nread  = endpos - startpos;
     }
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  if (nread < 0)
+    {
+      nread = 0;
+    }
+
+  /* Copy data from the file blocks to the user buffer.  Holes read as
+   * zero.
+   */
+
+  for (ncopied = 0; ncopied < nread; ncopied += nbytes)
+    {
+      blkno  = (startpos + ncopied) / TMPFS_BLOCKSIZE;
+      offset = (startpos + ncopied) % TMPFS_BLOCKSIZE;
+      nbytes = MIN(TMPFS_BLOCKSIZE - offset, nread - ncopied);
+
+      block  = blkno < tfo->tfo_nblocks ? tfo->tfo_blocks[blkno] : NULL;
+      if (block != NULL)
+        {
+          memcpy(&buffer[ncopied], &block[offset], nbytes);
+        }
+      else
+        {
+          memset(&buffer[ncopied], 0, nbytes);
+        }
+    }
+#else
   /* Copy data from the memory object to the user buffer */
 
   memcpy(buffer, &tfo->tfo_data[startpos], nread);
+#endif
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1612,6 +1949,12 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
   off_t startpos;
   off_t endpos;
   int ret;
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  FAR uint8_t *block;
+  size_t blkno;
+  size_t offset;
+  size_t nbytes;
+#endif
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
         filep, buffer, (unsigned long)buflen);
@@ -1625,6 +1968,64 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 
   tmpfs_lock_file(tfo);
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  startpos = filep->f_pos;
+  endpos   = startpos + buflen;
+
+  /* Make sure that the block table can reference every block touched by
+   * the write.
+   */
+
+  ret = tmpfs_grow_blocks(tfo, TMPFS_NBLOCKS((size_t)endpos));
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+
+  /* Copy data from the user buffer into the file blocks, allocating blocks
+   * to fill any holes that are written.  A write that is cut short by the
+   * size limit or by lack of memory returns the amount already written.
+   */
+
+  for (nwritten = 0; nwritten < buflen; nwritten += nbytes)
+    {
+      blkno  = (startpos + nwritten) / TMPFS_BLOCKSIZE;
+      offset = (startpos + nwritten) % TMPFS_BLOCKSIZE;
+      nbytes = MIN(TMPFS_BLOCKSIZE - offset, buflen - nwritten);
+
+      block  = tfo->tfo_blocks[blkno];
+      if (block == NULL)
+        {
+          ret = tmpfs_alloc_block(tfo->tfo_fs, &block);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          /* Parts of the block that are not written must read as zero */
+
+          if (nbytes < TMPFS_BLOCKSIZE)
+            {
+              memset(block, 0, TMPFS_BLOCKSIZE);
+            }
+
+          tfo->tfo_blocks[blkno] = block;
+          tfo->tfo_alloc += TMPFS_BLOCKSIZE;
+        }
+
+      memcpy(&block[offset], &buffer[nwritten], nbytes);
+    }
+
+  if (nwritten == 0 && ret < 0)
+    {
+      goto errout_with_lock;
+    }
+
+  if (startpos + nwritten > tfo->tfo_size)
+    {
+      tfo->tfo_size = startpos + nwritten;
+    }
+#else
   /* Handle attempts to write beyond the end of the file */
 
   startpos = filep->f_pos;
@@ -1647,6 +2048,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
   /* Copy data from the memory object to the user buffer */
 
   memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
+#endif
   filep->f_pos += nwritten;
 
   /* Release the lock on the file */
@@ -1741,11 +2143,24 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   if (cmd == FIOC_MMAP && ppv != NULL)
     {
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+      /* Only a file that fits in one block is contiguous in memory */
+
+      if (tfo->tfo_size > TMPFS_BLOCKSIZE || tfo->tfo_nblocks == 0 ||
+          tfo->tfo_blocks[0] == NULL)
+        {
+          ferr("ERROR: File is not contiguous in memory\n");
+          return -ENOSYS;
+        }
+
+      *ppv = (FAR void *)tfo->tfo_blocks[0];
+#else
       /* Return the address on the media corresponding to the start of
        * the file.
        */
 
       *ppv = (FAR void *)tfo->tfo_data;
+#endif
       return OK;
     }
 
@@ -1858,14 +2273,16 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
 
       filep->f_priv = tfo;
 
+#ifndef CONFIG_FS_TMPFS_FILE_BLOCKS
       /* If the size has increased, then we need to zero the newly added
-       * memory.
+       * memory.  With block storage, the new region is a hole.
        */
 
       if (length > oldsize)
         {
           memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
         }
+#endif
 
       ret = OK;
     }
@@ -2048,6 +2465,9 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 {
   FAR struct tmpfs_directory_s *tdo;
   FAR struct tmpfs_s *fs;
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  int ret;
+#endif
 
   finfo("blkdriver: %p data: %p handle: %p\n", blkdriver, data, handle);
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
@@ -2060,6 +2480,19 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
       return -ENOMEM;
     }
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  /* Set up the file data size limit */
+
+  fs->tfs_maxblocks = TMPFS_NBLOCKS(CONFIG_FS_TMPFS_MAXSIZE);
+
+  ret = tmpfs_parse_options(fs, (FAR const char *)data);
+  if (ret < 0)
+    {
+      kmm_free(fs);
+      return ret;
+    }
+#endif
+
   /* Create a root file system.  This is like a single directory entry in
    * the file system structure.
    */
@@ -2083,6 +2516,9 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
   fs->tfs_exclsem.ts_holder = TMPFS_NO_HOLDER;
   fs->tfs_exclsem.ts_count  = 0;
   nxsem_init(&fs->tfs_exclsem.ts_sem, 0, 1);
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  nxsem_init(&fs->tfs_blksem, 0, 1);
+#endif
 
   /* Return the new file system handle */
 
@@ -2119,6 +2555,20 @@ static int tmpfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
   nxsem_destroy(&tdo->tdo_exclsem.ts_sem);
   kmm_free(tdo);
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  /* Return the pooled data blocks to the heap */
+
+  while (fs->tfs_pool != NULL)
+    {
+      FAR struct tmpfs_freeblock_s *tfb = fs->tfs_pool;
+
+      fs->tfs_pool = tfb->tfb_flink;
+      kmm_free(tfb);
+    }
+
+  nxsem_destroy(&fs->tfs_blksem);
+#endif
+
   nxsem_destroy(&fs->tfs_exclsem.ts_sem);
   kmm_free(fs);
   return ret;
@@ -2179,6 +2629,20 @@ static int tmpfs_statfs(FAR struct inode *mountpt, FAR struct statfs *buf)
   blkused         = (tmpbuf.tsf_inuse + CONFIG_FS_TMPFS_BLOCKSIZE - 1) /
                      CONFIG_FS_TMPFS_BLOCKSIZE;
 
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  /* With a size limit, report the capacity as the limit and the usage as
+   * the file data blocks in use.
+   */
+
+  if (fs->tfs_maxblocks > 0)
+    {
+      blkalloc    = ((off_t)fs->tfs_maxblocks * TMPFS_BLOCKSIZE) /
+                    CONFIG_FS_TMPFS_BLOCKSIZE;
+      blkused     = ((off_t)fs->tfs_nblocks * TMPFS_BLOCKSIZE) /
+                    CONFIG_FS_TMPFS_BLOCKSIZE;
+    }
+#endif
+
   buf->f_type     = TMPFS_MAGIC;
   buf->f_namelen  = NAME_MAX;
   buf->f_bsize    = CONFIG_FS_TMPFS_BLOCKSIZE;
@@ -2275,6 +2739,9 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
   else
     {
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+      tmpfs_free_blocks(tfo, 0);
+#endif
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
       kmm_free(tfo);
     }
@@ -154,10 +154,29 @@ struct tmpfs_file_s
 
   uint8_t  tfo_flags;    /* See TFO_FLAG_* definitions */
   size_t   tfo_size;     /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  FAR struct tmpfs_s *tfo_fs; /* File system that owns the data blocks */
+  FAR uint8_t **tfo_blocks;   /* Block table.  NULL entries are holes */
+  size_t   tfo_nblocks;  /* Number of entries in the block table */
+#else
   uint8_t  tfo_data[1];  /* File data starts here */
+#endif
 };
 
-#define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+#  define SIZEOF_TMPFS_FILE(n) sizeof(struct tmpfs_file_s)
+#else
+#  define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
+#endif
+
+/* The form of a file data block in the free block pool */
+
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+struct tmpfs_freeblock_s
+{
+  FAR struct tmpfs_freeblock_s *tfb_flink;
+};
+#endif
 
 /* This structure represents one instance of a TMPFS file system */
 
@@ -167,6 +186,18 @@ struct tmpfs_s
 
   FAR struct tmpfs_dirent_s tfs_root;
   struct tmpfs_sem_s tfs_exclsem;
+
+#ifdef CONFIG_FS_TMPFS_FILE_BLOCKS
+  /* File data blocks.  These are protected by tfs_blksem rather than
+   * tfs_exclsem because they are allocated with only the file locked.
+   */
+
+  sem_t    tfs_blksem;   /* Protects the block pool and counts */
+  FAR struct tmpfs_freeblock_s *tfs_pool; /* Free blocks kept for re-use */
+  uint16_t tfs_npool;    /* Number of blocks in tfs_pool */
+  size_t   tfs_nblocks;  /* Number of data blocks in use */
+  size_t   tfs_maxblocks; /* Data block limit (0 = no limit) */
+#endif
 };
 
 /* This is the type used the tmpfs_statfs_callout to accumulate memory usage */
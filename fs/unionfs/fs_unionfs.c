@@ -75,6 +75,23 @@
 #define MIN(a,b) (((a) < (b)) ? (a) : (b))
 #define MAX(a,b) (((a) > (b)) ? (a) : (b))
 
+/* Lookup cache configuration */
+
+#ifndef CONFIG_FS_UNIONFS_LOOKUPCACHE
+#  define CONFIG_FS_UNIONFS_LOOKUPCACHE 0
+#endif
+
+#ifndef CONFIG_FS_UNIONFS_LOOKUPPATH
+#  define CONFIG_FS_UNIONFS_LOOKUPPATH 48
+#endif
+
+/* Lookup cache results.  0 and 1 are the index of the file system that
+ * holds the path.
+ */
+
+#define UNIONFS_LOOKUP_NONE    2   /* Neither file system holds the path */
+#define UNIONFS_LOOKUP_UNKNOWN 3   /* The path is not in the cache */
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -86,11 +103,24 @@ struct unionfs_mountpt_s
   FAR char *um_prefix;               /* Path prefix to filesystem */
 };
 
+#if CONFIG_FS_UNIONFS_LOOKUPCACHE > 0
+/* This structure describes one entry of the lookup cache */
+
+struct unionfs_lookup_s
+{
+  uint8_t ul_result;                 /* File system index or UNIONFS_LOOKUP_NONE */
+  char ul_path[CONFIG_FS_UNIONFS_LOOKUPPATH]; /* Relative path ("": unused) */
+};
+#endif
+
 /* This structure describes the union file system */
 
 struct unionfs_inode_s
 {
   struct unionfs_mountpt_s ui_fs[2]; /* Contained file systems */
+#if CONFIG_FS_UNIONFS_LOOKUPCACHE > 0
+  struct unionfs_lookup_s ui_lookup[CONFIG_FS_UNIONFS_LOOKUPCACHE];
+#endif
   sem_t ui_exclsem;                  /* Enforces mutually exclusive access */
   int16_t ui_nopen;                  /* Number of open references */
   bool ui_unmounted;                 /* File system has been unmounted */
@@ -142,6 +172,20 @@ static int     unionfs_trystatfile(FAR struct inode *inode,
 static FAR char *unionfs_relpath(FAR const char *path,
                  FAR const char *name);
 
+#if CONFIG_FS_UNIONFS_LOOKUPCACHE > 0
+static FAR struct unionfs_lookup_s *
+               unionfs_lookupentry(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath);
+static int     unionfs_lookup(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath);
+static void    unionfs_remember(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath, int result);
+static void    unionfs_forget(FAR struct unionfs_inode_s *ui);
+#else
+#  define      unionfs_lookup(ui,relpath) UNIONFS_LOOKUP_UNKNOWN
+#  define      unionfs_remember(ui,relpath,result)
+#  define      unionfs_forget(ui)
+#endif
 static int     unionfs_unbind_child(FAR struct unionfs_mountpt_s *um);
 static void    unionfs_destroy(FAR struct unionfs_inode_s *ui);
 
@@ -733,6 +777,100 @@ static FAR char *unionfs_relpath(FAR const char *path, FAR const char *name)
     }
 }
 
+/****************************************************************************
+ * Name: unionfs_lookupentry
+ *
+ * Description:
+ *   Return the lookup cache entry that relpath maps to, or NULL if relpath
+ *   cannot be cached.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_UNIONFS_LOOKUPCACHE > 0
+static FAR struct unionfs_lookup_s *
+unionfs_lookupentry(FAR struct unionfs_inode_s *ui, FAR const char *relpath)
+{
+  FAR const char *ptr;
+  uint32_t hash = 2166136261u;
+
+  if (relpath[0] == '\0' ||
+      strlen(relpath) >= CONFIG_FS_UNIONFS_LOOKUPPATH)
+    {
+      return NULL;
+    }
+
+  for (ptr = relpath; *ptr != '\0'; ptr++)
+    {
+      hash ^= (uint8_t)*ptr;
+      hash *= 16777619u;
+    }
+
+  return &ui->ui_lookup[hash % CONFIG_FS_UNIONFS_LOOKUPCACHE];
+}
+
+/****************************************************************************
+ * Name: unionfs_lookup
+ *
+ * Description:
+ *   Return the file system that held relpath when it was last looked up,
+ *   UNIONFS_LOOKUP_NONE if neither did, or UNIONFS_LOOKUP_UNKNOWN.
+ *
+ ****************************************************************************/
+
+static int unionfs_lookup(FAR struct unionfs_inode_s *ui,
+                          FAR const char *relpath)
+{
+  FAR struct unionfs_lookup_s *ul = unionfs_lookupentry(ui, relpath);
+
+  if (ul != NULL && strcmp(ul->ul_path, relpath) == 0)
+    {
+      return ul->ul_result;
+    }
+
+  return UNIONFS_LOOKUP_UNKNOWN;
+}
+
+/****************************************************************************
+ * Name: unionfs_remember
+ *
+ * Description:
+ *   Record which file system holds relpath.  A colliding entry is
+ *   replaced.
+ *
+ ****************************************************************************/
+
+static void unionfs_remember(FAR struct unionfs_inode_s *ui,
+                             FAR const char *relpath, int result)
+{
+  FAR struct unionfs_lookup_s *ul = unionfs_lookupentry(ui, relpath);
+
+  if (ul != NULL)
+    {
+      strcpy(ul->ul_path, relpath);
+      ul->ul_result = result;
+    }
+}
+
+/****************************************************************************
+ * Name: unionfs_forget
+ *
+ * Description:
+ *   Discard the lookup cache.  Called by every operation that may add or
+ *   remove a path on one of the file systems.
+ *
+ ****************************************************************************/
+
+static void unionfs_forget(FAR struct unionfs_inode_s *ui)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_UNIONFS_LOOKUPCACHE; i++)
+    {
+      ui->ui_lookup[i].ul_path[0] = '\0';
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: unionfs_unbind_child
  ****************************************************************************/
@@ -840,6 +978,8 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
   FAR struct unionfs_inode_s *ui;
   FAR struct unionfs_file_s *uf;
   FAR struct unionfs_mountpt_s *um;
+  bool cache;
+  int lookup;
   int ret;
 
   /* Recover the open file data from the struct file instance */
@@ -857,6 +997,27 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
       return ret;
     }
 
+  /* Check where the path was found the last time.  An open that may create
+   * the path invalidates what is known.
+   */
+
+  if ((oflags & O_CREAT) != 0)
+    {
+      unionfs_forget(ui);
+      lookup = UNIONFS_LOOKUP_UNKNOWN;
+    }
+  else
+    {
+      lookup = unionfs_lookup(ui, relpath);
+      if (lookup == UNIONFS_LOOKUP_NONE)
+        {
+          ret = -ENOENT;
+          goto errout_with_semaphore;
+        }
+    }
+
+  cache = (lookup == UNIONFS_LOOKUP_UNKNOWN && (oflags & O_CREAT) == 0);
+
   /* Allocate a container to hold the open file system information */
 
   uf = (FAR struct unionfs_file_s *)kmm_malloc(sizeof(struct unionfs_file_s));
@@ -876,7 +1037,13 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
   uf->uf_file.f_inode  = um->um_node;
   uf->uf_file.f_priv   = NULL;
 
-  ret = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags, mode);
+  ret = -ENOENT;
+  if (lookup != 1)
+    {
+      ret = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags,
+                            mode);
+    }
+
   if (ret >= 0)
     {
       /* Successfully opened on file system 1 */
@@ -885,6 +1052,13 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
     }
   else
     {
+      /* Only a path that does not exist on file system 1 can be cached */
+
+      if (ret != -ENOENT)
+        {
+          cache = false;
+        }
+
       /* Try to open the file on file system 1 */
 
       um  = &ui->ui_fs[1];
@@ -897,12 +1071,22 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
       ret = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags, mode);
       if (ret < 0)
         {
+          if (ret == -ENOENT && cache)
+            {
+              unionfs_remember(ui, relpath, UNIONFS_LOOKUP_NONE);
+            }
+
+          kmm_free(uf);
           goto errout_with_semaphore;
         }
 
       /* Successfully opened on file system 1 */
 
       uf->uf_ndx = 1;
+      if (cache)
+        {
+          unionfs_remember(ui, relpath, 1);
+        }
     }
 
   /* Increment the open reference count */
@@ -2187,6 +2371,10 @@ static int unionfs_unlink(FAR struct inode *mountpt,
       return ret;
     }
 
+  /* Paths may be added or removed */
+
+  unionfs_forget(ui);
+
   /* Check if some exists at this path on file system 1.  This might be
    * a file or a directory
    */
@@ -2259,6 +2447,10 @@ static int unionfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
       return ret;
     }
 
+  /* Paths may be added or removed */
+
+  unionfs_forget(ui);
+
   /* Is there anything with this name on either file system? */
 
   um  = &ui->ui_fs[0];
@@ -2332,6 +2524,10 @@ static int unionfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
       return ret;
     }
 
+  /* Paths may be added or removed */
+
+  unionfs_forget(ui);
+
   ret = -ENOENT;
 
   /* We really don't know any better so we will try to remove the directory
@@ -2407,6 +2603,10 @@ static int unionfs_rename(FAR struct inode *mountpt,
       return ret;
     }
 
+  /* Paths may be added or removed */
+
+  unionfs_forget(ui);
+
   DEBUGASSERT(oldrelpath != NULL && oldrelpath != NULL);
 
   /* Is there a file with this name on file system 1 */
@@ -2464,6 +2664,8 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 {
   FAR struct unionfs_inode_s *ui;
   FAR struct unionfs_mountpt_s *um;
+  bool cache;
+  int lookup;
   int ret;
 
   finfo("relpath: %s\n", relpath);
@@ -2481,18 +2683,39 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
       return ret;
     }
 
+  /* Check where the path was found the last time */
+
+  lookup = unionfs_lookup(ui, relpath);
+  if (lookup == UNIONFS_LOOKUP_NONE)
+    {
+      unionfs_semgive(ui);
+      return -ENOENT;
+    }
+
+  cache = (lookup == UNIONFS_LOOKUP_UNKNOWN);
+
   /* stat this path on file system 1 */
 
-  um  = &ui->ui_fs[0];
-  ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, buf);
-  if (ret >= 0)
+  if (lookup != 1)
     {
-      /* Return on the first success.  The first instance of the file will
-       * shadow the second anyway.
-       */
+      um  = &ui->ui_fs[0];
+      ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, buf);
+      if (ret >= 0)
+        {
+          /* Return on the first success.  The first instance of the file
+           * will shadow the second anyway.
+           */
 
-      unionfs_semgive(ui);
-      return OK;
+          unionfs_semgive(ui);
+          return OK;
+        }
+
+      /* Only a path that does not exist on file system 1 can be cached */
+
+      if (ret != -ENOENT)
+        {
+          cache = false;
+        }
     }
 
   /* stat failed on the file system 1.  Try again on file system 2. */
@@ -2505,6 +2728,11 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
        * shadow the second anyway.
        */
 
+      if (cache)
+        {
+          unionfs_remember(ui, relpath, 1);
+        }
+
       unionfs_semgive(ui);
       return OK;
     }
@@ -2538,6 +2766,11 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
         }
     }
 
+  if (ret == -ENOENT && cache)
+    {
+      unionfs_remember(ui, relpath, UNIONFS_LOOKUP_NONE);
+    }
+
   unionfs_semgive(ui);
   return ret;
 }
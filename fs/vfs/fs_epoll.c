@@ -33,6 +33,7 @@
  *
  ****************************************************************************/
 
+
 /****************************************************************************
  * Included Files
  ****************************************************************************/
@@ -42,15 +43,282 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
+#include <queue.h>
+#include <assert.h>
 #include <errno.h>
-#include <string.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
 
 #ifndef CONFIG_DISABLE_POLL
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The subset of the requested events that is passed to the driver */
+
+#define EPOLL_PFDEVENTS (POLLIN | POLLOUT | POLLERR | POLLHUP)
+
+#define epoll_givesem(sem) nxsem_post(sem)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One registered descriptor.  The embedded pollfd remains set up with the
+ * driver for as long as the node is armed so that epoll_wait() does not
+ * repeat the setup and teardown that poll() performs on every call.
+ */
+
+struct epoll_node_s
+{
+  dq_entry_t         link;     /* Link in the ready list (must be first) */
+  struct pollfd      pfd;      /* Persistent poll descriptor */
+  struct epoll_event ev;       /* Registered events and user data */
+  bool               inuse;    /* The node holds a registration */
+  bool               armed;    /* pfd is set up with the driver */
+  bool               ready;    /* The node is in the ready list */
+};
+
+struct epoll_head
+{
+  int                size;     /* Number of nodes */
+  int                occupied; /* Number of registered descriptors */
+  sem_t              exclsem;  /* Serializes epoll_ctl() and epoll_wait() */
+  sem_t              waitsem;  /* Posted by the drivers on any event */
+  dq_queue_t         readyq;   /* Nodes with pending events */
+  FAR struct epoll_node_s *nodes;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_takesem
+ ****************************************************************************/
+
+static void epoll_takesem(FAR sem_t *sem)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(sem);
+
+      /* The only case that an error should occur here is if the wait were
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: epoll_fdsetup
+ *
+ * Description:
+ *   Set up or tear down the poll on one file or socket descriptor.
+ *
+ ****************************************************************************/
+
+static int epoll_fdsetup(FAR struct pollfd *fds, bool setup)
+{
+  int fd = fds->fd;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+      if ((unsigned int)fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS))
+        {
+          return net_poll(fd, fds, setup);
+        }
+      else
+#endif
+        {
+          return -EBADF;
+        }
+    }
+
+  return fdesc_poll(fd, fds, setup);
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   Set up the persistent poll on a node.  The driver posts waitsem, now if
+ *   the descriptor is already ready or later when an event occurs.
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_head *eph,
+                     FAR struct epoll_node_s *node)
+{
+  int ret;
+
+  DEBUGASSERT(!node->armed && !node->ready);
+
+  node->pfd.sem     = &eph->waitsem;
+  node->pfd.events  = (pollevent_t)(node->ev.events & EPOLL_PFDEVENTS) |
+                      POLLERR | POLLHUP;
+  node->pfd.revents = 0;
+  node->pfd.priv    = NULL;
+
+  ret = epoll_fdsetup(&node->pfd, true);
+  if (ret >= 0)
+    {
+      node->armed = true;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_disarm
+ *
+ * Description:
+ *   Tear down the persistent poll on a node and drop it from the ready
+ *   list.
+ *
+ ****************************************************************************/
+
+static void epoll_disarm(FAR struct epoll_head *eph,
+                         FAR struct epoll_node_s *node)
+{
+  if (node->ready)
+    {
+      dq_rem(&node->link, &eph->readyq);
+      node->ready = false;
+    }
+
+  if (node->armed)
+    {
+      (void)epoll_fdsetup(&node->pfd, false);
+      node->armed = false;
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ ****************************************************************************/
+
+static FAR struct epoll_node_s *epoll_find(FAR struct epoll_head *eph,
+                                           int fd)
+{
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->nodes[i].inuse && eph->nodes[i].pfd.fd == fd)
+        {
+          return &eph->nodes[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_harvest
+ *
+ * Description:
+ *   Move every armed node that the driver has marked with events into the
+ *   ready list.  The drivers only provide notification through the shared
+ *   semaphore, so this is a scan of the revents fields; the expensive
+ *   per-descriptor setup and teardown is not repeated.
+ *
+ ****************************************************************************/
+
+static void epoll_harvest(FAR struct epoll_head *eph)
+{
+  FAR struct epoll_node_s *node;
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      node = &eph->nodes[i];
+      if (node->armed && !node->ready && node->pfd.revents != 0)
+        {
+          dq_addlast(&node->link, &eph->readyq);
+          node->ready = true;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_consume
+ *
+ * Description:
+ *   Return up to maxevents entries from the ready list.  Level-triggered
+ *   nodes are re-armed so that the driver re-evaluates (and re-posts) any
+ *   condition that still holds; edge-triggered nodes stay armed and are
+ *   reported again only on the next event; one-shot nodes are disarmed
+ *   until re-enabled with EPOLL_CTL_MOD.
+ *
+ ****************************************************************************/
+
+static int epoll_consume(FAR struct epoll_head *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node_s *node;
+  irqstate_t flags;
+  pollevent_t revents;
+  int nevents = 0;
+  int ret;
+
+  while (nevents < maxevents &&
+         (node = (FAR struct epoll_node_s *)dq_remfirst(&eph->readyq)) != NULL)
+    {
+      node->ready = false;
+
+      /* The driver may be updating revents concurrently */
+
+      flags = enter_critical_section();
+      revents = node->pfd.revents;
+      node->pfd.revents = 0;
+      leave_critical_section(flags);
+
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[nevents].events = revents;
+      evs[nevents].data   = node->ev.data;
+      nevents++;
+
+      if ((node->ev.events & EPOLLONESHOT) != 0)
+        {
+          epoll_disarm(eph, node);
+        }
+      else if ((node->ev.events & EPOLLET) == 0)
+        {
+          epoll_disarm(eph, node);
+
+          ret = epoll_arm(eph, node);
+          if (ret < 0)
+            {
+              ferr("ERROR: fd=%d re-arm failed: %d\n", node->pfd.fd, ret);
+            }
+        }
+    }
+
+  return nevents;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,21 +327,52 @@
  * Name: epoll_create
  *
  * Description:
+ *   Create an epoll instance able to hold up to 'size' descriptors.
  *
  * Input Parameters:
+ *   size - The maximum number of registered descriptors
  *
  * Returned Value:
+ *   The epoll descriptor on success; -1 (ERROR) on failure with errno set.
  *
  ****************************************************************************/
 
 int epoll_create(int size)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  FAR struct epoll_head *eph;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  eph = (FAR struct epoll_head *)kmm_zalloc(sizeof(struct epoll_head));
+  if (eph == NULL)
+    {
+      set_errno(ENOMEM);
+      return ERROR;
+    }
+
+  eph->nodes = (FAR struct epoll_node_s *)
+    kmm_zalloc(sizeof(struct epoll_node_s) * size);
+  if (eph->nodes == NULL)
+    {
+      kmm_free(eph);
+      set_errno(ENOMEM);
+      return ERROR;
+    }
 
   eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  dq_init(&eph->readyq);
+  nxsem_init(&eph->exclsem, 0, 1);
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_setprotocol(&eph->waitsem, SEM_PRIO_NONE);
 
   /* REVISIT: This will not work on machines where:
    * sizeof(struct epoll_head *) > sizeof(int)
@@ -86,10 +385,13 @@ int epoll_create(int size)
  * Name: epoll_close
  *
  * Description:
+ *   Tear down every registration and free the epoll instance.
  *
  * Input Parameters:
+ *   epfd - The epoll descriptor returned by epoll_create()
  *
  * Returned Value:
+ *   None
  *
  ****************************************************************************/
 
@@ -100,8 +402,19 @@ void epoll_close(int epfd)
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  int i;
+
+  epoll_takesem(&eph->exclsem);
+  for (i = 0; i < eph->size; i++)
+    {
+      epoll_disarm(eph, &eph->nodes[i]);
+    }
+
+  epoll_givesem(&eph->exclsem);
 
-  kmm_free(eph->evs);
+  nxsem_destroy(&eph->waitsem);
+  nxsem_destroy(&eph->exclsem);
+  kmm_free(eph->nodes);
   kmm_free(eph);
 }
 
@@ -109,10 +422,23 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a descriptor in the interest list.  The poll is
+ *   set up with the driver here, once, rather than on every epoll_wait().
  *
  * Input Parameters:
+ *   epfd - The epoll descriptor returned by epoll_create()
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The file or socket descriptor
+ *   ev   - The requested events and user data (unused for EPOLL_CTL_DEL)
  *
  * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with errno set:
+ *
+ *   EEXIST - EPOLL_CTL_ADD of a descriptor that is already registered
+ *   ENOENT - EPOLL_CTL_MOD or EPOLL_CTL_DEL of an unregistered descriptor
+ *   ENOMEM - The interest list is full
+ *   EINVAL - Invalid op or missing ev
+ *   Any error returned by the driver poll setup
  *
  ****************************************************************************/
 
@@ -123,6 +449,18 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  FAR struct epoll_node_s *node;
+  int ret = OK;
+  int i;
+
+  if (op != EPOLL_CTL_DEL && ev == NULL)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  epoll_takesem(&eph->exclsem);
+  node = epoll_find(eph, fd);
 
   switch (op)
     {
@@ -130,63 +468,103 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
         finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
               epfd, eph->occupied, fd, ev->events);
 
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+        if (node != NULL)
+          {
+            ret = -EEXIST;
+            break;
+          }
+
+        for (i = 0; i < eph->size && eph->nodes[i].inuse; i++)
+          {
+          }
+
+        if (i >= eph->size)
+          {
+            ret = -ENOMEM;
+            break;
+          }
+
+        node         = &eph->nodes[i];
+        node->ev     = *ev;
+        node->pfd.fd = fd;
+
+        ret = epoll_arm(eph, node);
+        if (ret >= 0)
+          {
+            node->inuse = true;
+            eph->occupied++;
+          }
+        break;
 
       case EPOLL_CTL_DEL:
-        {
-          int i;
+        finfo("%08x CTL DEL(%d): fd=%d\n", epfd, eph->occupied, fd);
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  if (i != eph->occupied-1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
+        if (node == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          return -ENOENT;
-        }
+        epoll_disarm(eph, node);
+        node->inuse = false;
+        eph->occupied--;
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
+              epfd, eph->occupied, fd, ev->events);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+        if (node == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
-            }
+        /* Re-arming also re-enables an EPOLLONESHOT descriptor */
 
-          return -ENOENT;
-        }
+        epoll_disarm(eph, node);
+        node->ev = *ev;
+
+        ret = epoll_arm(eph, node);
+        if (ret < 0)
+          {
+            node->inuse = false;
+            eph->occupied--;
+          }
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
     }
 
-  return -EINVAL;
+  epoll_givesem(&eph->exclsem);
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  return OK;
 }
 
 /****************************************************************************
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on the registered descriptors.  Only descriptors that
+ *   the drivers have flagged are visited when collecting the results.
  *
  * Input Parameters:
+ *   epfd      - The epoll descriptor returned by epoll_create()
+ *   evs       - The array that receives the events
+ *   maxevents - The size of the evs array
+ *   timeout   - The timeout in milliseconds; negative waits forever
  *
  * Returned Value:
+ *   The number of events returned in evs, zero on timeout, or -1 (ERROR)
+ *   with errno set on failure.
  *
  ****************************************************************************/
 
@@ -198,41 +576,83 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  clock_t start = 0;
+  clock_t ticks = 0;
+  bool expired = false;
+  int ret;
+
+  if (evs == NULL || maxevents <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* epoll_wait() is a cancellation point */
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  (void)enter_cancellation_point();
+
+  if (timeout > 0)
+    {
+      /* Round timeout up to next full tick (see poll()) */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) + (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) / MSEC_PER_TICK;
+#endif
+      start = clock_systimer();
+    }
 
-  if (rc <= 0)
+  for (; ; )
     {
-      if (rc < 0)
+      epoll_takesem(&eph->exclsem);
+      epoll_harvest(eph);
+      ret = epoll_consume(eph, evs, maxevents);
+      epoll_givesem(&eph->exclsem);
+
+      if (ret > 0 || timeout == 0 || expired)
         {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+          break;
+        }
+
+      /* Wait for a driver to post an event.  The semaphore count may be
+       * left over from events that were already collected, in which case
+       * the wait returns immediately and the loop simply finds nothing.
+       */
 
-          for (i = 0; i < eph->occupied; i++)
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&eph->waitsem, start, ticks);
+          if (ret == -ETIMEDOUT)
             {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
+              /* Collect anything that raced with the timeout, then return */
+
+              expired = true;
+              ret = OK;
             }
         }
+      else
+        {
+          ret = nxsem_wait(&eph->waitsem);
+        }
 
-      return rc;
+      if (ret < 0)
+        {
+          break;
+        }
     }
 
-  /* Iterate over non NULL event fds */
+  leave_cancellation_point();
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
+  if (ret < 0)
     {
-      if (eph->evs[counter].revents != 0)
-        {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
-        }
+      set_errno(-ret);
+      return ERROR;
     }
 
-  return i;
+  return ret;
 }
 
 #endif /* CONFIG_DISABLE_POLL */
@@ -0,0 +1,572 @@
+/****************************************************************************
+ * fs/vfs/fs_eventfd.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/eventfd.h>
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+
+#ifdef CONFIG_EVENT_FD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest value that the counter may hold */
+
+#define EVENTFD_MAX  (UINT64_MAX - 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct eventfd_priv_s
+{
+  sem_t exclsem;           /* Enforces exclusive access to the counter */
+  sem_t rdsem;             /* Readers wait here for a non-zero counter */
+  sem_t wrsem;             /* Writers wait here for room in the counter */
+  eventfd_t counter;       /* The event counter */
+  uint8_t crefs;           /* References counts on the eventfd */
+  uint8_t flags;           /* EFD_SEMAPHORE */
+  uint8_t nrdwaiters;      /* Number of readers waiting on rdsem */
+  uint8_t nwrwaiters;      /* Number of writers waiting on wrsem */
+#ifndef CONFIG_DISABLE_POLL
+  FAR struct pollfd *fds[CONFIG_EVENT_FD_NPOLLWAITERS];
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     eventfd_dev_open(FAR struct file *filep);
+static int     eventfd_dev_close(FAR struct file *filep);
+static ssize_t eventfd_dev_read(FAR struct file *filep, FAR char *buffer,
+                                size_t len);
+static ssize_t eventfd_dev_write(FAR struct file *filep,
+                                 FAR const char *buffer, size_t len);
+#ifndef CONFIG_DISABLE_POLL
+static int     eventfd_dev_poll(FAR struct file *filep,
+                                FAR struct pollfd *fds, bool setup);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_eventfd_fops =
+{
+  eventfd_dev_open,  /* open */
+  eventfd_dev_close, /* close */
+  eventfd_dev_read,  /* read */
+  eventfd_dev_write, /* write */
+  0,                 /* seek */
+  0,                 /* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+  eventfd_dev_poll,  /* poll */
+#endif
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  0                  /* unlink */
+#endif
+};
+
+/* Used to generate unique, transient names for the eventfd drivers */
+
+static uint32_t g_eventfd_no;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: eventfd_wakeup
+ *
+ * Description:
+ *   Wake up all tasks waiting on 'sem'
+ *
+ ****************************************************************************/
+
+static void eventfd_wakeup(FAR sem_t *sem, FAR uint8_t *nwaiters)
+{
+  for (; *nwaiters > 0; (*nwaiters)--)
+    {
+      (void)nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: eventfd_wait
+ *
+ * Description:
+ *   Release the exclusive access semaphore and wait on 'sem', then retake
+ *   the exclusive access semaphore.  Returns a negated errno value if the
+ *   wait was interrupted.
+ *
+ ****************************************************************************/
+
+static int eventfd_wait(FAR struct eventfd_priv_s *dev, FAR sem_t *sem,
+                        FAR uint8_t *nwaiters)
+{
+  int ret;
+
+  (*nwaiters)++;
+  (void)nxsem_post(&dev->exclsem);
+
+  ret = nxsem_wait(sem);
+  if (ret < 0)
+    {
+      /* The stale count, if any, left on 'sem' by a later wakeup is
+       * harmless:  Waiters always re-check the counter.
+       */
+
+      return ret;
+    }
+
+  return nxsem_wait(&dev->exclsem);
+}
+
+/****************************************************************************
+ * Name: eventfd_pollnotify
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+static void eventfd_pollnotify(FAR struct eventfd_priv_s *dev,
+                               pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_EVENT_FD_NPOLLWAITERS; i++)
+    {
+      FAR struct pollfd *fds = dev->fds[i];
+
+      if (fds)
+        {
+          fds->revents |= eventset & fds->events;
+          if (fds->revents != 0)
+            {
+              finfo("Report events: %02x\n", fds->revents);
+              (void)nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+#else
+#  define eventfd_pollnotify(dev,e)
+#endif
+
+/****************************************************************************
+ * Name: eventfd_dev_open
+ ****************************************************************************/
+
+static int eventfd_dev_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct eventfd_priv_s *dev = inode->i_private;
+  int ret;
+
+  ret = nxsem_wait(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  dev->crefs++;
+  (void)nxsem_post(&dev->exclsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: eventfd_dev_close
+ ****************************************************************************/
+
+static int eventfd_dev_close(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct eventfd_priv_s *dev = inode->i_private;
+
+  (void)nxsem_wait_uninterruptible(&dev->exclsem);
+
+  if (--dev->crefs > 0)
+    {
+      (void)nxsem_post(&dev->exclsem);
+      return OK;
+    }
+
+  /* This was the last reference.  The driver was unregistered when the
+   * eventfd was created so the inode goes away with this close; only the
+   * private state remains to be freed.
+   */
+
+  (void)nxsem_destroy(&dev->rdsem);
+  (void)nxsem_destroy(&dev->wrsem);
+  (void)nxsem_destroy(&dev->exclsem);
+  kmm_free(dev);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: eventfd_dev_read
+ ****************************************************************************/
+
+static ssize_t eventfd_dev_read(FAR struct file *filep, FAR char *buffer,
+                                size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct eventfd_priv_s *dev = inode->i_private;
+  eventfd_t value;
+  int ret;
+
+  if (buffer == NULL || len < sizeof(eventfd_t))
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait for the counter to become non-zero */
+
+  while (dev->counter == 0)
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          (void)nxsem_post(&dev->exclsem);
+          return -EAGAIN;
+        }
+
+      ret = eventfd_wait(dev, &dev->rdsem, &dev->nrdwaiters);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  value = (dev->flags & EFD_SEMAPHORE) != 0 ? 1 : dev->counter;
+  dev->counter -= value;
+
+  /* There is now room in the counter for writers */
+
+  eventfd_wakeup(&dev->wrsem, &dev->nwrwaiters);
+  eventfd_pollnotify(dev, POLLOUT);
+
+  (void)nxsem_post(&dev->exclsem);
+
+  memcpy(buffer, &value, sizeof(eventfd_t));
+  return sizeof(eventfd_t);
+}
+
+/****************************************************************************
+ * Name: eventfd_dev_write
+ ****************************************************************************/
+
+static ssize_t eventfd_dev_write(FAR struct file *filep,
+                                 FAR const char *buffer, size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct eventfd_priv_s *dev = inode->i_private;
+  eventfd_t value;
+  int ret;
+
+  if (buffer == NULL || len < sizeof(eventfd_t))
+    {
+      return -EINVAL;
+    }
+
+  memcpy(&value, buffer, sizeof(eventfd_t));
+  if (value > EVENTFD_MAX)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait until the value can be added without overflowing the counter */
+
+  while (EVENTFD_MAX - dev->counter < value)
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          (void)nxsem_post(&dev->exclsem);
+          return -EAGAIN;
+        }
+
+      ret = eventfd_wait(dev, &dev->wrsem, &dev->nwrwaiters);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  dev->counter += value;
+
+  if (dev->counter > 0)
+    {
+      eventfd_wakeup(&dev->rdsem, &dev->nrdwaiters);
+      eventfd_pollnotify(dev, POLLIN);
+    }
+
+  (void)nxsem_post(&dev->exclsem);
+  return sizeof(eventfd_t);
+}
+
+/****************************************************************************
+ * Name: eventfd_dev_poll
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+static int eventfd_dev_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                            bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct eventfd_priv_s *dev = inode->i_private;
+  pollevent_t eventset;
+  int ret;
+  int i;
+
+  ret = nxsem_wait(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (setup)
+    {
+      /* Find an available slot for the poll structure reference */
+
+      for (i = 0; i < CONFIG_EVENT_FD_NPOLLWAITERS; i++)
+        {
+          if (dev->fds[i] == NULL)
+            {
+              dev->fds[i] = fds;
+              fds->priv   = &dev->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_EVENT_FD_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto errout;
+        }
+
+      /* Notify immediately if the eventfd is already readable or
+       * writable.
+       */
+
+      eventset = 0;
+      if (dev->counter > 0)
+        {
+          eventset |= POLLIN;
+        }
+
+      if (dev->counter < EVENTFD_MAX)
+        {
+          eventset |= POLLOUT;
+        }
+
+      if (eventset != 0)
+        {
+          eventfd_pollnotify(dev, eventset);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      /* This is a request to tear down the poll. */
+
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  (void)nxsem_post(&dev->exclsem);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: eventfd
+ *
+ * Description:
+ *   Create a file descriptor for event notification.  The new descriptor
+ *   holds a 64-bit counter initialized to 'initval'.
+ *
+ *   The descriptor is backed by a character driver that is registered
+ *   under a transient name in /dev, opened, and then immediately
+ *   unregistered.  The driver therefore never appears in the pseudo file
+ *   system after eventfd() returns and disappears with the last close.
+ *
+ * Input Parameters:
+ *   initval - The initial value of the counter
+ *   flags   - Zero or more of EFD_NONBLOCK, EFD_SEMAPHORE and EFD_CLOEXEC
+ *
+ * Returned Value:
+ *   A new file descriptor on success.  -1 (ERROR) is returned on failure
+ *   and the errno value is set appropriately.
+ *
+ ****************************************************************************/
+
+int eventfd(unsigned int initval, int flags)
+{
+  FAR struct eventfd_priv_s *dev;
+  irqstate_t irqflags;
+  char devname[16];
+  uint32_t devno;
+  int errcode;
+  int fd;
+  int ret;
+
+  if ((flags & ~(EFD_NONBLOCK | EFD_SEMAPHORE | EFD_CLOEXEC)) != 0)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  dev = (FAR struct eventfd_priv_s *)kmm_zalloc(sizeof(*dev));
+  if (dev == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout;
+    }
+
+  (void)nxsem_init(&dev->exclsem, 0, 1);
+  (void)nxsem_init(&dev->rdsem, 0, 0);
+  (void)nxsem_init(&dev->wrsem, 0, 0);
+
+  /* The read and write semaphores are used for signaling and, hence,
+   * should not have priority inheritance enabled.
+   */
+
+  (void)nxsem_setprotocol(&dev->rdsem, SEM_PRIO_NONE);
+  (void)nxsem_setprotocol(&dev->wrsem, SEM_PRIO_NONE);
+
+  dev->counter = initval;
+  dev->flags   = flags & EFD_SEMAPHORE;
+
+  irqflags = enter_critical_section();
+  devno    = g_eventfd_no++;
+  leave_critical_section(irqflags);
+
+  snprintf(devname, sizeof(devname), "/dev/efd%lu", (unsigned long)devno);
+
+  ret = register_driver(devname, &g_eventfd_fops, 0666, dev);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_dev;
+    }
+
+  fd = nx_open(devname, O_RDWR | (flags & EFD_NONBLOCK));
+
+  /* The open file keeps the inode alive; remove the name now */
+
+  (void)unregister_driver(devname);
+
+  if (fd < 0)
+    {
+      errcode = -fd;
+      goto errout_with_dev;
+    }
+
+  return fd;
+
+errout_with_dev:
+  (void)nxsem_destroy(&dev->rdsem);
+  (void)nxsem_destroy(&dev->wrsem);
+  (void)nxsem_destroy(&dev->exclsem);
+  kmm_free(dev);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: eventfd_read and eventfd_write
+ *
+ * Description:
+ *   Convenience wrappers that read or write the eventfd counter.
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  -1 (ERROR) is returned on failure and the errno
+ *   value is set appropriately.
+ *
+ ****************************************************************************/
+
+int eventfd_read(int fd, FAR eventfd_t *value)
+{
+  return read(fd, value, sizeof(eventfd_t)) == sizeof(eventfd_t) ?
+         OK : ERROR;
+}
+
+int eventfd_write(int fd, eventfd_t value)
+{
+  return write(fd, &value, sizeof(eventfd_t)) == sizeof(eventfd_t) ?
+         OK : ERROR;
+}
+
+#endif /* CONFIG_EVENT_FD */
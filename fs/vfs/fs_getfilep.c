@@ -100,7 +100,14 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  /* And return the file pointer from the list */
+  /* And return the file pointer from the list.  No lock is needed:  The
+   * list is embedded in the task group and never reallocated, so the
+   * address of a slot is stable for the life of the group.  The file list
+   * semaphore only serializes allocation and release of the slots.
+   *
+   * NOTE: The table cannot simply be grown on demand because descriptors
+   * at and above CONFIG_NFILE_DESCRIPTORS are socket descriptors.
+   */
 
   *filep = &list->fl_files[fd];
   return OK;
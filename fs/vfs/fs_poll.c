@@ -127,7 +127,8 @@ static int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup)
  * Name: poll_setup
  *
  * Description:
- *   Setup the poll operation for each descriptor in the list.
+ *   Setup the poll operation for each descriptor in the list.  Returns the
+ *   number of descriptors that were already ready when they were set up.
  *
  ****************************************************************************/
 
@@ -136,6 +137,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds, sem_t *sem)
 {
   unsigned int i;
   unsigned int j;
+  int nready = 0;
   int ret = OK;
 
   /* Process each descriptor in the list */
@@ -223,9 +225,14 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds, sem_t *sem)
           fds[i].revents |= POLLERR;
           return ret;
         }
+
+      if (fds[i].revents != 0)
+        {
+          nready++;
+        }
     }
 
-  return OK;
+  return nready;
 }
 #endif
 
@@ -467,9 +474,13 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
   ret = poll_setup(fds, nfds, &sem);
   if (ret >= 0)
     {
-      if (timeout == 0)
+      if (ret > 0 || timeout == 0)
         {
-          /* Poll returns immediately whether we have a poll event or not. */
+          /* Poll returns immediately if any descriptor was already ready
+           * when it was set up, without going through the semaphore wait.
+           * If timeout is zero, it returns immediately whether we have a
+           * poll event or not.
+           */
 
           ret = OK;
         }
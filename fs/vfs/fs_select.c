@@ -42,6 +42,7 @@
 #include <sys/select.h>
 #include <sys/time.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <poll.h>
 #include <errno.h>
@@ -60,10 +61,52 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_FS_SELECT_NSTACKFDS
+#  define CONFIG_FS_SELECT_NSTACKFDS 8
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: select_word
+ *
+ * Description:
+ *   Return the union of the three descriptor sets for the 32 descriptors
+ *   beginning at 32 * ndx, ignoring any descriptors at or above nfds.  This
+ *   lets select() skip over empty words instead of testing every bit.
+ *
+ ****************************************************************************/
+
+static inline uint32_t select_word(FAR fd_set *readfds, FAR fd_set *writefds,
+                                   FAR fd_set *exceptfds, int ndx, int nfds)
+{
+  uint32_t bits = 0;
+
+  if (readfds)
+    {
+      bits |= readfds->arr[ndx];
+    }
+
+  if (writefds)
+    {
+      bits |= writefds->arr[ndx];
+    }
+
+  if (exceptfds)
+    {
+      bits |= exceptfds->arr[ndx];
+    }
+
+  if ((ndx << 5) + 32 > nfds)
+    {
+      bits &= ((uint32_t)1 << _FD_BIT(nfds)) - 1;
+    }
+
+  return bits;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -103,8 +146,14 @@
 int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
            FAR fd_set *exceptfds, FAR struct timeval *timeout)
 {
+#if CONFIG_FS_SELECT_NSTACKFDS > 0
+  struct pollfd stackset[CONFIG_FS_SELECT_NSTACKFDS];
+#endif
   struct pollfd *pollset = NULL;
+  uint32_t bits;
   int errcode = OK;
+  int nwords;
+  int word;
   int fd;
   int npfds;
   int msec;
@@ -115,26 +164,39 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
 
   (void)enter_cancellation_point();
 
-  /* How many pollfd structures do we need to allocate? */
+  if (nfds < 0 || nfds > FD_SETSIZE)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
 
-  /* Initialize the descriptor list for poll() */
+  /* How many pollfd structures do we need? */
 
-  for (fd = 0, npfds = 0; fd < nfds; fd++)
+  nwords = (nfds + 31) >> 5;
+  for (word = 0, npfds = 0; word < nwords; word++)
     {
-      /* Check if any monitor operation is requested on this fd */
+      /* Count the descriptors with any monitor operation requested */
 
-      if ((readfds   && FD_ISSET(fd, readfds))  ||
-          (writefds  && FD_ISSET(fd, writefds)) ||
-          (exceptfds && FD_ISSET(fd, exceptfds)))
+      for (bits = select_word(readfds, writefds, exceptfds, word, nfds);
+           bits != 0;
+           bits &= bits - 1)
         {
-          /* Yes.. increment the count of pollfds structures needed */
-
           npfds++;
         }
     }
 
-  /* Allocate the descriptor list for poll() */
+  /* Use the on-stack descriptor list for small sets and only allocate the
+   * descriptor list for poll() if it will not fit.
+   */
 
+#if CONFIG_FS_SELECT_NSTACKFDS > 0
+  if (npfds <= CONFIG_FS_SELECT_NSTACKFDS)
+    {
+      pollset = stackset;
+      memset(pollset, 0, npfds * sizeof(struct pollfd));
+    }
+  else
+#endif
   if (npfds > 0)
     {
       pollset = (FAR struct pollfd *)
@@ -149,44 +211,48 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
 
   /* Initialize the descriptor list for poll() */
 
-  for (fd = 0, ndx = 0; fd < nfds; fd++)
+  for (word = 0, ndx = 0; word < nwords; word++)
     {
-      int incr = 0;
+      bits = select_word(readfds, writefds, exceptfds, word, nfds);
+      for (fd = word << 5; bits != 0; fd++, bits >>= 1)
+        {
+          if ((bits & 1) == 0)
+            {
+              continue;
+            }
 
-      /* The readfs set holds the set of FDs that the caller can be assured
-       * of reading from without blocking.  Note that POLLHUP is included as
-       * a read-able condition.  POLLHUP will be reported at the end-of-file
-       * or when a connection is lost.  In either case, the read() can then
-       * be performed without blocking.
-       */
+          /* This descriptor is in at least one of the sets */
 
-      if (readfds && FD_ISSET(fd, readfds))
-        {
-          pollset[ndx].fd      = fd;
-          pollset[ndx].events |= POLLIN;
-          incr                 = 1;
-        }
+          pollset[ndx].fd = fd;
 
-      /* The writefds set holds the set of FDs that the caller can be assured
-       * of writing to without blocking.
-       */
+          /* The readfs set holds the set of FDs that the caller can be
+           * assured of reading from without blocking.  Note that POLLHUP is
+           * included as a read-able condition.  POLLHUP will be reported at
+           * the end-of-file or when a connection is lost.  In either case,
+           * the read() can then be performed without blocking.
+           */
 
-      if (writefds && FD_ISSET(fd, writefds))
-        {
-          pollset[ndx].fd      = fd;
-          pollset[ndx].events |= POLLOUT;
-          incr                 = 1;
-        }
+          if (readfds && FD_ISSET(fd, readfds))
+            {
+              pollset[ndx].events |= POLLIN;
+            }
 
-      /* The exceptfds set holds the set of FDs that are watched for exceptions */
+          /* The writefds set holds the set of FDs that the caller can be
+           * assured of writing to without blocking.
+           */
 
-      if (exceptfds && FD_ISSET(fd, exceptfds))
-        {
-          pollset[ndx].fd      = fd;
-          incr                  = 1;
-        }
+          if (writefds && FD_ISSET(fd, writefds))
+            {
+              pollset[ndx].events |= POLLOUT;
+            }
+
+          /* The exceptfds set holds the set of FDs that are watched for
+           * exceptions.  POLLERR is always reported, so there is nothing to
+           * add to the events.
+           */
 
-      ndx += incr;
+          ndx++;
+        }
     }
 
   DEBUGASSERT(ndx == npfds);
@@ -279,7 +345,12 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
         }
     }
 
-  kmm_free(pollset);
+#if CONFIG_FS_SELECT_NSTACKFDS > 0
+  if (pollset != stackset)
+#endif
+    {
+      kmm_free(pollset);
+    }
 
   /* Did poll() fail above? */
 
@@ -0,0 +1,598 @@
+/****************************************************************************
+ * fs/vfs/fs_timerfd.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/timerfd.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+
+#ifdef CONFIG_TIMER_FD
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* All fields except the timer are protected by the critical section because
+ * the expiration callback runs in the context of the timer interrupt.
+ */
+
+struct timerfd_priv_s
+{
+  sem_t rdsem;             /* Readers wait here for an expiration */
+  timer_t timerid;         /* The underlying POSIX timer */
+  timerfd_t expirations;   /* Expirations since the last read */
+  uint8_t crefs;           /* References counts on the timerfd */
+  uint8_t nrdwaiters;      /* Number of readers waiting on rdsem */
+  clockid_t clockid;       /* The clock of timerfd_create() */
+#ifndef CONFIG_DISABLE_POLL
+  FAR struct pollfd *fds[CONFIG_TIMER_FD_NPOLLWAITERS];
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     timerfd_dev_open(FAR struct file *filep);
+static int     timerfd_dev_close(FAR struct file *filep);
+static ssize_t timerfd_dev_read(FAR struct file *filep, FAR char *buffer,
+                                size_t len);
+#ifndef CONFIG_DISABLE_POLL
+static int     timerfd_dev_poll(FAR struct file *filep,
+                                FAR struct pollfd *fds, bool setup);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_timerfd_fops =
+{
+  timerfd_dev_open,  /* open */
+  timerfd_dev_close, /* close */
+  timerfd_dev_read,  /* read */
+  0,                 /* write */
+  0,                 /* seek */
+  0,                 /* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+  timerfd_dev_poll,  /* poll */
+#endif
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  0                  /* unlink */
+#endif
+};
+
+/* Used to generate unique, transient names for the timerfd drivers */
+
+static uint32_t g_timerfd_no;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: timerfd_pollnotify
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+static void timerfd_pollnotify(FAR struct timerfd_priv_s *dev,
+                               pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_TIMER_FD_NPOLLWAITERS; i++)
+    {
+      FAR struct pollfd *fds = dev->fds[i];
+
+      if (fds)
+        {
+          fds->revents |= eventset & fds->events;
+          if (fds->revents != 0)
+            {
+              (void)nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+#else
+#  define timerfd_pollnotify(dev,e)
+#endif
+
+/****************************************************************************
+ * Name: timerfd_expired
+ *
+ * Description:
+ *   The POSIX timer expired.  Count the expiration and wake up readers and
+ *   pollers.
+ *
+ * Assumptions:
+ *   This function executes in the context of the timer interrupt.
+ *
+ ****************************************************************************/
+
+static void timerfd_expired(FAR void *arg)
+{
+  FAR struct timerfd_priv_s *dev = (FAR struct timerfd_priv_s *)arg;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  dev->expirations++;
+  for (; dev->nrdwaiters > 0; dev->nrdwaiters--)
+    {
+      (void)nxsem_post(&dev->rdsem);
+    }
+
+  timerfd_pollnotify(dev, POLLIN);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: timerfd_getdev
+ *
+ * Description:
+ *   Return the timerfd instance behind a file descriptor.
+ *
+ ****************************************************************************/
+
+static int timerfd_getdev(int fd, FAR struct timerfd_priv_s **dev)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (filep->f_inode == NULL || filep->f_inode->u.i_ops != &g_timerfd_fops)
+    {
+      return -EINVAL;
+    }
+
+  *dev = (FAR struct timerfd_priv_s *)filep->f_inode->i_private;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: timerfd_dev_open
+ ****************************************************************************/
+
+static int timerfd_dev_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct timerfd_priv_s *dev = inode->i_private;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  dev->crefs++;
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: timerfd_dev_close
+ ****************************************************************************/
+
+static int timerfd_dev_close(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct timerfd_priv_s *dev = inode->i_private;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (--dev->crefs > 0)
+    {
+      leave_critical_section(flags);
+      return OK;
+    }
+
+  leave_critical_section(flags);
+
+  /* This was the last reference.  Deleting the timer also cancels it, so
+   * the callback cannot run once the private state is freed.
+   */
+
+  (void)timer_delete(dev->timerid);
+  (void)nxsem_destroy(&dev->rdsem);
+  kmm_free(dev);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: timerfd_dev_read
+ ****************************************************************************/
+
+static ssize_t timerfd_dev_read(FAR struct file *filep, FAR char *buffer,
+                                size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct timerfd_priv_s *dev = inode->i_private;
+  irqstate_t flags;
+  timerfd_t value;
+  int ret;
+
+  if (buffer == NULL || len < sizeof(timerfd_t))
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  /* Wait for an expiration */
+
+  while (dev->expirations == 0)
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          leave_critical_section(flags);
+          return -EAGAIN;
+        }
+
+      dev->nrdwaiters++;
+      ret = nxsem_wait(&dev->rdsem);
+      if (ret < 0)
+        {
+          /* The stale count, if any, left on rdsem by a later wakeup is
+           * harmless:  Waiters always re-check the expirations.
+           */
+
+          leave_critical_section(flags);
+          return ret;
+        }
+    }
+
+  value            = dev->expirations;
+  dev->expirations = 0;
+  leave_critical_section(flags);
+
+  memcpy(buffer, &value, sizeof(timerfd_t));
+  return sizeof(timerfd_t);
+}
+
+/****************************************************************************
+ * Name: timerfd_dev_poll
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+static int timerfd_dev_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                            bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct timerfd_priv_s *dev = inode->i_private;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  flags = enter_critical_section();
+
+  if (setup)
+    {
+      /* Find an available slot for the poll structure reference */
+
+      for (i = 0; i < CONFIG_TIMER_FD_NPOLLWAITERS; i++)
+        {
+          if (dev->fds[i] == NULL)
+            {
+              dev->fds[i] = fds;
+              fds->priv   = &dev->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_TIMER_FD_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto errout;
+        }
+
+      /* Notify immediately if an expiration is already pending */
+
+      if (dev->expirations > 0)
+        {
+          timerfd_pollnotify(dev, POLLIN);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      /* This is a request to tear down the poll. */
+
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: timerfd_create
+ *
+ * Description:
+ *   Create a file descriptor that delivers the expirations of a new,
+ *   disarmed timer.  Use timerfd_settime() to arm it.
+ *
+ *   Like eventfd(), the descriptor is backed by a character driver that is
+ *   registered under a transient name in /dev, opened, and then immediately
+ *   unregistered.
+ *
+ * Input Parameters:
+ *   clockid - CLOCK_REALTIME or CLOCK_MONOTONIC
+ *   flags   - Zero or more of TFD_NONBLOCK and TFD_CLOEXEC
+ *
+ * Returned Value:
+ *   A new file descriptor on success.  -1 (ERROR) is returned on failure
+ *   and the errno value is set appropriately.
+ *
+ ****************************************************************************/
+
+int timerfd_create(int clockid, int flags)
+{
+  FAR struct timerfd_priv_s *dev;
+  irqstate_t irqflags;
+  char devname[16];
+  uint32_t devno;
+  int errcode;
+  int fd;
+  int ret;
+
+  if ((flags & ~(TFD_NONBLOCK | TFD_CLOEXEC)) != 0)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+  if (clockid != CLOCK_REALTIME && clockid != CLOCK_MONOTONIC)
+#else
+  if (clockid != CLOCK_REALTIME)
+#endif
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  dev = (FAR struct timerfd_priv_s *)kmm_zalloc(sizeof(*dev));
+  if (dev == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout;
+    }
+
+  /* The read semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  (void)nxsem_init(&dev->rdsem, 0, 0);
+  (void)nxsem_setprotocol(&dev->rdsem, SEM_PRIO_NONE);
+  dev->clockid = clockid;
+
+  ret = nxtimer_create(timerfd_expired, dev, &dev->timerid);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_dev;
+    }
+
+  irqflags = enter_critical_section();
+  devno    = g_timerfd_no++;
+  leave_critical_section(irqflags);
+
+  snprintf(devname, sizeof(devname), "/dev/tfd%lu", (unsigned long)devno);
+
+  ret = register_driver(devname, &g_timerfd_fops, 0444, dev);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_timer;
+    }
+
+  fd = nx_open(devname, O_RDONLY | (flags & TFD_NONBLOCK));
+
+  /* The open file keeps the inode alive; remove the name now */
+
+  (void)unregister_driver(devname);
+
+  if (fd < 0)
+    {
+      errcode = -fd;
+      goto errout_with_timer;
+    }
+
+  return fd;
+
+errout_with_timer:
+  (void)timer_delete(dev->timerid);
+
+errout_with_dev:
+  (void)nxsem_destroy(&dev->rdsem);
+  kmm_free(dev);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: timerfd_settime
+ *
+ * Description:
+ *   Arm or disarm the timer of a timerfd, as timer_settime() does for a
+ *   POSIX timer.  Any expirations not yet read are discarded.
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  -1 (ERROR) is returned on failure and the errno
+ *   value is set appropriately.
+ *
+ ****************************************************************************/
+
+int timerfd_settime(int fd, int flags,
+                    FAR const struct itimerspec *new_value,
+                    FAR struct itimerspec *old_value)
+{
+  FAR struct timerfd_priv_s *dev;
+  struct itimerspec value;
+  irqstate_t irqflags;
+  int ret;
+
+  if (new_value == NULL || (flags & ~TFD_TIMER_ABSTIME) != 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  ret = timerfd_getdev(fd, &dev);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  if (old_value != NULL && timer_gettime(dev->timerid, old_value) < 0)
+    {
+      return ERROR;
+    }
+
+  value = *new_value;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+  /* POSIX timers take absolute times on CLOCK_REALTIME only.  Convert an
+   * absolute CLOCK_MONOTONIC time to a relative one.
+   */
+
+  if (dev->clockid == CLOCK_MONOTONIC && (flags & TFD_TIMER_ABSTIME) != 0 &&
+      (value.it_value.tv_sec > 0 || value.it_value.tv_nsec > 0))
+    {
+      struct timespec now;
+
+      (void)clock_gettime(CLOCK_MONOTONIC, &now);
+      if (value.it_value.tv_sec < now.tv_sec ||
+          (value.it_value.tv_sec == now.tv_sec &&
+           value.it_value.tv_nsec <= now.tv_nsec))
+        {
+          /* Already in the past:  Expire as soon as possible */
+
+          value.it_value.tv_sec  = 0;
+          value.it_value.tv_nsec = 1;
+        }
+      else
+        {
+          value.it_value.tv_sec -= now.tv_sec;
+          value.it_value.tv_nsec -= now.tv_nsec;
+          if (value.it_value.tv_nsec < 0)
+            {
+              value.it_value.tv_sec--;
+              value.it_value.tv_nsec += NSEC_PER_SEC;
+            }
+        }
+
+      flags &= ~TFD_TIMER_ABSTIME;
+    }
+#endif
+
+  irqflags = enter_critical_section();
+  dev->expirations = 0;
+  leave_critical_section(irqflags);
+
+  return timer_settime(dev->timerid,
+                       (flags & TFD_TIMER_ABSTIME) != 0 ? TIMER_ABSTIME : 0,
+                       &value, NULL);
+}
+
+/****************************************************************************
+ * Name: timerfd_gettime
+ *
+ * Description:
+ *   Return the time until the next expiration and the reload value of the
+ *   timer of a timerfd.
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  -1 (ERROR) is returned on failure and the errno
+ *   value is set appropriately.
+ *
+ ****************************************************************************/
+
+int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
+{
+  FAR struct timerfd_priv_s *dev;
+  int ret;
+
+  if (curr_value == NULL)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  ret = timerfd_getdev(fd, &dev);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  return timer_gettime(dev->timerid, curr_value);
+}
+
+#endif /* CONFIG_TIMER_FD */
@@ -45,6 +45,7 @@
 #include <assert.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 
 #include "inode/inode.h"
 
@@ -82,6 +83,20 @@ int file_truncate(FAR struct file *filep, off_t length)
    */
 
   inode = filep->f_inode;
+
+#ifdef CONFIG_FS_SHM
+  /* Character drivers, such as shared memory objects, may support
+   * truncation through the FIOC_TRUNCATE ioctl command.
+   */
+
+  if (inode != NULL && INODE_IS_DRIVER(inode) && inode->u.i_ops != NULL &&
+      inode->u.i_ops->ioctl != NULL)
+    {
+      return inode->u.i_ops->ioctl(filep, FIOC_TRUNCATE,
+                                   (unsigned long)length);
+    }
+#endif
+
   if (inode == NULL || !INODE_IS_MOUNTPT(inode) || inode->u.i_mops == NULL)
     {
       fwarn("WARNING:  Not a (regular) file on a mounted file system.\n");
@@ -0,0 +1,246 @@
+/****************************************************************************
+ * fs/vfs/fs_writev.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+# include <sys/socket.h>
+#endif
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_writev
+ *
+ * Description:
+ *   Write each entry of the I/O vector to an open file in order.  The file
+ *   structure is looked up only once for the whole vector.  The transfer
+ *   stops at the first short write.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+static ssize_t file_writev(FAR struct file *filep,
+                           FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ntotal = 0;
+  ssize_t nwritten;
+  int i;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      /* Ignore zero-length writes */
+
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nwritten = file_write(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nwritten < 0)
+        {
+          /* Errors are reported only if nothing was written */
+
+          return ntotal > 0 ? ntotal : nwritten;
+        }
+
+      ntotal += nwritten;
+      if ((size_t)nwritten < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_writev
+ *
+ * Description:
+ *  nx_writev() gathers output from the 'iovcnt' buffers of 'iov' and writes
+ *  it to the file or socket referenced by 'fd'.  nx_writev() is an
+ *  internal OS function.  It is functionally equivalent to writev() except
+ *  that:
+ *
+ *  - It does not modify the errno variable, and
+ *  - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - file descriptor (or socket descriptor) to write to
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *  On success, the number of bytes written are returned (zero indicates
+ *  nothing was written).  On any failure, a negated errno value is returned
+ *  (see comments with writev() for a description of the appropriate errno
+ *  values).
+ *
+ ****************************************************************************/
+
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  FAR struct file *filep;
+#endif
+  ssize_t ret;
+
+  if (iovcnt < 0 || (iov == NULL && iovcnt > 0))
+    {
+      return -EINVAL;
+    }
+
+  /* Did we get a valid file descriptor? */
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+#endif
+    {
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+      struct msghdr msg;
+
+      /* Write to a socket descriptor is equivalent to sendmsg() with
+       * flags == 0.  This lets a stream socket queue the whole vector
+       * at once.
+       */
+
+      memset(&msg, 0, sizeof(struct msghdr));
+      msg.msg_iov    = (FAR struct iovec *)iov;
+      msg.msg_iovlen = (unsigned long)iovcnt;
+
+      ret = psock_sendmsg(sockfd_socket(fd), &msg, 0);
+#else
+      ret = -EBADF;
+#endif
+    }
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  else
+    {
+      /* The descriptor is in the right range to be a file descriptor..
+       * write to the file.
+       */
+
+      ret = (ssize_t)fs_getfilep(fd, &filep);
+      if (ret >= 0)
+        {
+          ret = file_writev(filep, iov, iovcnt);
+        }
+    }
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: writev
+ *
+ * Description:
+ *   The writev() function is equivalent to write(), except as described
+ *   below. The writev() function will gather output data from the 'iovcnt'
+ *   buffers specified by the members of the 'iov' array: iov[0], iov[1], ...,
+ *   iov[iovcnt-1]. The 'iovcnt' argument is valid if greater than or equal
+ *   to 0 and less than or equal to IOV_MAX, as defined in limits.h.
+ *
+ *   Each iovec entry specifies the base address and length of an area in
+ *   memory from which data should be written. The writev() function always
+ *   writes a complete area before proceeding to the next.
+ *
+ *   The whole vector is handled in a single call into the OS:  On a stream
+ *   socket the entries are queued together; on a file the data is written
+ *   entry by entry without re-validating the descriptor.
+ *
+ * Input Parameters:
+ *   fildes  - The open file descriptor for the file to be written
+ *   iov     - Array of write buffer descriptors
+ *   iovcnt  - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   Upon successful completion, writev() shall return the number of bytes
+ *   actually written.  If some data was written before an error occurred,
+ *   that count is returned and the error is reported by the next call.
+ *   Otherwise, it shall return a value of -1 and errno shall be set to
+ *   indicate an error.  See write for the list of returned errno values.
+ *   In addition, the writev() function will fail if:
+ *
+ *    EINVAL.
+ *      The 'iovcnt' argument was less than 0.
+ *
+ ****************************************************************************/
+
+ssize_t writev(int fildes, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* writev() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Let nx_writev() do all of the work */
+
+  ret = nx_writev(fildes, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -84,7 +84,18 @@ void NXGL_FUNCNAME(nxgl_fillrectangle, NXGLIB_SUFFIX)
 
   NXGL_FUNCNAME(nxgl_fillrun, NXGLIB_SUFFIX)((NXGLIB_RUNTYPE *)pinfo->buffer, color, ncols);
 
-  /* Then fill the rectangle line-by-line */
+  /* If the LCD supports windowed writes, repeat the run buffer for every
+   * row in a single transfer.
+   */
+
+  if (pinfo->putarea != NULL)
+    {
+      (void)pinfo->putarea(rect->pt1.y, rect->pt2.y, rect->pt1.x,
+                           rect->pt2.x, pinfo->buffer, 0);
+      return;
+    }
+
+  /* Otherwise, fill the rectangle line-by-line */
 
   for (row = rect->pt1.y; row <= rect->pt2.y; row++)
     {
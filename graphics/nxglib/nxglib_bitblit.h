@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -141,32 +142,35 @@
        } \
    }
 
-#elif NXGLIB_BITSPERPIXEL == 24
+#else /* NXGLIB_BITSPERPIXEL >= 8 */
 
-#  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr  = (FAR uint8_t*)(dest); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-         *_ptr++ = (value) >> 8; \
-         *_ptr++ = (value) >> 16; \
-       } \
-   }
+/* Whole runs of 8-bit or wider pixels are copied with memcpy() and
+ * memmove() so that any architecture-optimized versions are used.  Fills
+ * are done a 32-bit word at a time by the nxgl_fill*() helpers below.
+ */
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+     memcpy((dest), (src), NXGL_SCALEX(width))
+
+#  define NXGL_MEMMOVE(dest,src,width) \
+     memmove((dest), (src), NXGL_SCALEX(width))
+
+#endif
+
+#if NXGLIB_BITSPERPIXEL == 8
+
+#  define NXGL_MEMSET(dest,value,width) \
+     memset((dest), (value), (width))
+
+#elif NXGLIB_BITSPERPIXEL == 16
+
+#  define NXGL_MEMSET(dest,value,width) \
+     nxgl_fill16((FAR uint16_t *)(dest), (value), (width))
+
+#elif NXGLIB_BITSPERPIXEL == 24
+
+#  define NXGL_MEMSET(dest,value,width) \
+     nxgl_fill24((FAR uint8_t *)(dest), (value), (width))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -185,28 +189,13 @@
    }
 
 #endif /* CONFIG_NX_ANTIALIASING */
-#else /* NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32 */
+#elif NXGLIB_BITSPERPIXEL == 32
 
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR NXGL_PIXEL_T *_ptr = (FAR NXGL_PIXEL_T*)(dest); \
-     nxgl_coord_t     _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+     nxgl_fill32((FAR uint32_t *)(dest), (value), (width))
+#endif
 
-#  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR NXGL_PIXEL_T *_dptr = (FAR NXGL_PIXEL_T*)(dest); \
-     FAR NXGL_PIXEL_T *_sptr = (FAR NXGL_PIXEL_T*)(src); \
-     nxgl_coord_t      _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+#if NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -233,6 +222,145 @@
  * Public Data
  ****************************************************************************/
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_fill16, nxgl_fill24, and nxgl_fill32
+ *
+ * Description:
+ *   Fill a run of npixels pixels with one color using aligned 32-bit
+ *   stores.  dest must be aligned to the size of one pixel (16- and 32-bit)
+ *   or may have any alignment (24-bit).
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL == 16
+static inline void nxgl_fill16(FAR uint16_t *dest, uint16_t color,
+                               size_t npixels)
+{
+  FAR uint32_t *wdest;
+  uint32_t wide;
+
+  /* Get to a 32-bit boundary */
+
+  if (((uintptr_t)dest & 2) != 0 && npixels > 0)
+    {
+      *dest++ = color;
+      npixels--;
+    }
+
+  /* Then store two pixels at a time */
+
+  wide  = (uint32_t)color << 16 | color;
+  wdest = (FAR uint32_t *)dest;
+
+  while (npixels >= 8)
+    {
+      wdest[0] = wide;
+      wdest[1] = wide;
+      wdest[2] = wide;
+      wdest[3] = wide;
+      wdest   += 4;
+      npixels -= 8;
+    }
+
+  while (npixels >= 2)
+    {
+      *wdest++ = wide;
+      npixels -= 2;
+    }
+
+  /* And the odd, final pixel */
+
+  if (npixels > 0)
+    {
+      *(FAR uint16_t *)wdest = color;
+    }
+}
+#endif
+
+#if NXGLIB_BITSPERPIXEL == 24
+static inline void nxgl_fill24(FAR uint8_t *dest, uint32_t color,
+                               size_t npixels)
+{
+  union
+  {
+    uint8_t  b[12];
+    uint32_t w[3];
+  } pattern;
+
+  FAR uint32_t *wdest;
+  int i;
+
+  /* Get to a 32-bit boundary, this takes at most three pixels */
+
+  while (((uintptr_t)dest & 3) != 0 && npixels > 0)
+    {
+      *dest++ = color;
+      *dest++ = color >> 8;
+      *dest++ = color >> 16;
+      npixels--;
+    }
+
+  /* Then store four pixels as three words at a time */
+
+  if (npixels >= 4)
+    {
+      for (i = 0; i < 12; i += 3)
+        {
+          pattern.b[i]     = color;
+          pattern.b[i + 1] = color >> 8;
+          pattern.b[i + 2] = color >> 16;
+        }
+
+      wdest = (FAR uint32_t *)dest;
+      do
+        {
+          wdest[0] = pattern.w[0];
+          wdest[1] = pattern.w[1];
+          wdest[2] = pattern.w[2];
+          wdest   += 3;
+          npixels -= 4;
+        }
+      while (npixels >= 4);
+
+      dest = (FAR uint8_t *)wdest;
+    }
+
+  /* And the final pixels */
+
+  while (npixels-- > 0)
+    {
+      *dest++ = color;
+      *dest++ = color >> 8;
+      *dest++ = color >> 16;
+    }
+}
+#endif
+
+#if NXGLIB_BITSPERPIXEL == 24 || NXGLIB_BITSPERPIXEL == 32
+static inline void nxgl_fill32(FAR uint32_t *dest, uint32_t color,
+                               size_t npixels)
+{
+  while (npixels >= 4)
+    {
+      dest[0] = color;
+      dest[1] = color;
+      dest[2] = color;
+      dest[3] = color;
+      dest    += 4;
+      npixels -= 4;
+    }
+
+  while (npixels-- > 0)
+    {
+      *dest++ = color;
+    }
+}
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
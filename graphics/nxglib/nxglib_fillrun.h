@@ -44,6 +44,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "nxglib_bitblit.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -159,12 +161,9 @@ static inline void nxgl_fillrun_8bpp(FAR uint8_t *run, nxgl_mxpixel_t color,
 static inline void nxgl_fillrun_16bpp(FAR uint16_t *run, nxgl_mxpixel_t color,
                                       size_t npixels)
 {
-  /* Fill the run with the color (it is okay to run a fractional byte overy the end */
+  /* Fill the run with the color, two pixels per 32-bit store */
 
-  while (npixels-- > 0)
-    {
-      *run++ = (uint16_t)color;
-    }
+  nxgl_fill16(run, (uint16_t)color, npixels);
 }
 
 #elif NXGLIB_BITSPERPIXEL == 24
@@ -172,21 +171,15 @@ static inline void nxgl_fillrun_24bpp(FAR uint32_t *run, nxgl_mxpixel_t color, s
 {
   /* Fill the run with the color (it is okay to run a fractional byte overy the end */
 #warning "Assuming 24-bit color is not packed"
-  while (npixels-- > 0)
-    {
-      *run++ = (uint32_t)color;
-    }
+  nxgl_fill32(run, (uint32_t)color, npixels);
 }
 
 #elif NXGLIB_BITSPERPIXEL == 32
 static inline void nxgl_fillrun_32bpp(FAR uint32_t *run, nxgl_mxpixel_t color, size_t npixels)
 {
-  /* Fill the run with the color (it is okay to run a fractional byte overy the end */
+  /* Fill the run with the color */
 
-  while (npixels-- > 0)
-    {
-      *run++ = (uint32_t)color;
-    }
+  nxgl_fill32(run, (uint32_t)color, npixels);
 }
 #else
 #  error "Unsupported value of NXGLIB_BITSPERPIXEL"
@@ -257,6 +257,22 @@ int nxmu_mousein(FAR struct nxfe_state_s *fe,
                  FAR const struct nxgl_point_s *pos, int button);
 #endif
 
+/****************************************************************************
+ * Name: nxmu_mousepend and nxmu_mouseflush
+ *
+ * Description:
+ *   nxmu_mousepend() is nxmu_mousein() except that a report that does not
+ *   change the buttons is only remembered, replacing any earlier one.
+ *   nxmu_mouseflush() routes the remembered report, if any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_XYINPUT_COALESCE
+int nxmu_mousepend(FAR struct nxfe_state_s *fe,
+                   FAR const struct nxgl_point_s *pos, int buttons);
+void nxmu_mouseflush(FAR struct nxfe_state_s *fe);
+#endif
+
 /****************************************************************************
  * Name: nxmu_kbdin
  *
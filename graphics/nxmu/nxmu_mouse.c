@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -59,6 +60,11 @@ static struct nxgl_point_s       g_mrange;
 static uint8_t                   g_mbutton;
 static FAR struct nxbe_window_s *g_mwnd;
 
+#ifdef CONFIG_NX_XYINPUT_COALESCE
+static struct nxgl_point_s       g_mpend;    /* Position held back */
+static bool                      g_mpending; /* True: g_mpend is valid */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -262,4 +268,52 @@ int nxmu_mousein(FAR struct nxfe_state_s *fe,
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxmu_mousepend
+ *
+ * Description:
+ *   Like nxmu_mousein(), but a report that only moves the mouse is held
+ *   back so that it can be replaced by a later one.  nxmu_mouseflush()
+ *   routes the held report.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_XYINPUT_COALESCE
+int nxmu_mousepend(FAR struct nxfe_state_s *fe,
+                   FAR const struct nxgl_point_s *pos, int buttons)
+{
+  if (buttons != g_mbutton)
+    {
+      /* A button change must be seen at its own position */
+
+      nxmu_mouseflush(fe);
+      return nxmu_mousein(fe, pos, buttons);
+    }
+
+  g_mpend.x  = pos->x;
+  g_mpend.y  = pos->y;
+  g_mpending = true;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmu_mouseflush
+ *
+ * Description:
+ *   Route any mouse report held back by nxmu_mousepend().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_XYINPUT_COALESCE
+void nxmu_mouseflush(FAR struct nxfe_state_s *fe)
+{
+  if (g_mpending)
+    {
+      g_mpending = false;
+      (void)nxmu_mousein(fe, &g_mpend, g_mbutton);
+    }
+}
+#endif
+
 #endif /* CONFIG_NX_XYINPUT */
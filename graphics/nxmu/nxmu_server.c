@@ -327,6 +327,18 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
        msg = (FAR struct nxsvrmsg_s *)buffer;
 
        ginfo("Received opcode=%d nbytes=%d\n", msg->msgid, nbytes);
+
+#ifdef CONFIG_NX_XYINPUT_COALESCE
+       /* Motion that was held back must be routed before anything else can
+        * change the windows under the mouse.
+        */
+
+       if (msg->msgid != NX_SVRMSG_MOUSEIN)
+         {
+           nxmu_mouseflush(&fe);
+         }
+#endif
+
        switch (msg->msgid)
          {
          /* Messages sent from clients to the NX server *********************/
@@ -486,7 +498,21 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
          case NX_SVRMSG_MOUSEIN: /* New mouse report from mouse client */
            {
              FAR struct nxsvrmsg_mousein_s *mousemsg = (FAR struct nxsvrmsg_mousein_s *)buffer;
+#ifdef CONFIG_NX_XYINPUT_COALESCE
+             struct mq_attr attr;
+
+             /* Hold back motion while more messages are queued; the next
+              * report (or the next other message) supersedes it.
+              */
+
+             nxmu_mousepend(&fe, &mousemsg->pt, mousemsg->buttons);
+             if (mq_getattr(fe.conn.crdmq, &attr) < 0 || attr.mq_curmsgs == 0)
+               {
+                 nxmu_mouseflush(&fe);
+               }
+#else
              nxmu_mousein(&fe, &mousemsg->pt, mousemsg->buttons);
+#endif
            }
            break;
 #endif
@@ -138,6 +138,8 @@ struct nxterm_state_s
 
   uint16_t maxchars;                        /* Size of the bm[] array */
   uint16_t nchars;                          /* Number of chars in the bm[] array */
+  uint16_t ndrawn;                          /* Number of bm[] chars on the display */
+  nxgl_coord_t scrollpend;                  /* Pending scroll distance in rows */
 
   struct nxgl_point_s fpos;                 /* Next display position */
 
@@ -227,8 +229,9 @@ void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch);
 void nxterm_showcursor(FAR struct nxterm_state_s *priv);
 void nxterm_hidecursor(FAR struct nxterm_state_s *priv);
 
-/* Scrolling support */
+/* Scrolling and deferred display update support */
 
 void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight);
+void nxterm_flush(FAR struct nxterm_state_s *priv);
 
 #endif /* __GRAPHICS_NXTERM_NXTERM_H */
@@ -207,8 +207,11 @@ int nxterm_backspace(FAR struct nxterm_state_s *priv)
       ndx = priv->nchars - 1;
       bm  = &priv->bm[ndx];
 
-      /* Erase the character from the display */
+      /* Bring the display up to date, then erase the character from the
+       * display.
+       */
 
+      nxterm_flush(priv);
       ret = nxterm_hidechar(priv, bm);
 
       /* The current position to the location where the last character was */
@@ -219,6 +222,7 @@ int nxterm_backspace(FAR struct nxterm_state_s *priv)
       /* Decrement nchars to discard this character */
 
       priv->nchars = ndx;
+      priv->ndrawn = ndx;
     }
 
   return ret;
@@ -288,6 +292,17 @@ void nxterm_fillchar(FAR struct nxterm_state_s *priv,
       return;
     }
 
+  /* Quickly discard characters on rows that lie entirely outside of the
+   * redraw region.  Redraw and scroll operations visit every character on
+   * the display, so avoid the font lookups for these.
+   */
+
+  if (rect != NULL &&
+      (bm->pos.y > rect->pt2.y || bm->pos.y + priv->fheight <= rect->pt1.y))
+    {
+      return;
+    }
+
   /* Get the size of the font glyph (which may not have been created yet) */
 
   ret = nxterm_fontsize(priv, bm->code, &fsize);
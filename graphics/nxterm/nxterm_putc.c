@@ -51,13 +51,13 @@
  * Name: nxterm_putc
  *
  * Description:
- *   Render the specified character at the current display position.
+ *   Add the specified character at the current display position.  The
+ *   character is rendered onto the display by the next nxterm_flush().
  *
  ****************************************************************************/
 
 void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch)
 {
-  FAR const struct nxterm_bitmap_s *bm;
   int lineheight;
 
   /* Ignore carriage returns */
@@ -118,15 +118,12 @@ void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch)
       nxterm_scroll(priv, lineheight);
     }
 
-  /* Find the glyph associated with the character and render it onto the
-   * display.
+  /* Find the glyph associated with the character.  The character is not
+   * rendered onto the display here; all new characters are rendered
+   * together by nxterm_flush() when the display is next updated.
    */
 
-  bm = nxterm_addchar(priv, ch);
-  if (bm)
-    {
-      nxterm_fillchar(priv, NULL, bm);
-    }
+  (void)nxterm_addchar(priv, ch);
 }
 
 /****************************************************************************
@@ -162,7 +159,11 @@ void nxterm_showcursor(FAR struct nxterm_state_s *priv)
       nxterm_scroll(priv, lineheight);
     }
 
-  /* Render the cursor glyph onto the display. */
+  /* Bring the display up to date, then render the cursor glyph onto the
+   * display.
+   */
+
+  nxterm_flush(priv);
 
   priv->cursor.pos.x = priv->fpos.x;
   priv->cursor.pos.y = priv->fpos.y;
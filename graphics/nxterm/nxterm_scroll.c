@@ -133,38 +133,39 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
   struct nxgl_point_s offset;
   int ret;
 
-  /* Add the line separation value to the scroll height */
-
-  scrollheight += CONFIG_NXTERM_LINESEPARATION;
-
-  /* Move the display in the range of 0-height up one scrollheight.  The
-   * line at the bottom will be reset to the background color automatically.
-   *
-   * The source rectangle to be moved.
-   */
-
   rect.pt1.x = 0;
-  rect.pt1.y = scrollheight;
+  rect.pt1.y = 0;
   rect.pt2.x = priv->wndo.wsize.w - 1;
   rect.pt2.y = priv->wndo.wsize.h - 1;
 
-  /* The offset that determines how far to move the source rectangle */
+  /* Move the display in the range of 0-height up one scrollheight.  If the
+   * whole display has scrolled off, then there is nothing to move.
+   */
 
-  offset.x   = 0;
-  offset.y   = -scrollheight;
+  if (scrollheight < priv->wndo.wsize.h)
+    {
+      /* The source rectangle to be moved. */
 
-  /* Move the source rectangle upward by the scrollheight */
+      rect.pt1.y = scrollheight;
 
-  ret = priv->ops->move(priv, &rect, &offset);
-  if (ret < 0)
-    {
-      gerr("ERROR: Move failed: %d\n", errno);
+      /* The offset that determines how far to move the source rectangle */
+
+      offset.x   = 0;
+      offset.y   = -scrollheight;
+
+      /* Move the source rectangle upward by the scrollheight */
+
+      ret = priv->ops->move(priv, &rect, &offset);
+      if (ret < 0)
+        {
+          gerr("ERROR: Move failed: %d\n", errno);
+        }
+
+      rect.pt1.y = priv->wndo.wsize.h - scrollheight;
     }
 
   /* Finally, clear the vacated bottom part of the display */
 
-  rect.pt1.y = priv->wndo.wsize.h - scrollheight;
-
   ret = priv->ops->fill(priv, &rect, priv->wndo.wcolor);
   if (ret < 0)
     {
@@ -183,32 +184,33 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
 
 void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight)
 {
+  FAR struct nxterm_bitmap_s *bm;
+  uint16_t ndrawn;
   int i;
   int j;
 
-  /* Adjust the vertical position of each character */
+  /* Adjust the vertical position of each character, compacting the bm[]
+   * array in a single pass.
+   */
+
+  ndrawn = priv->ndrawn;
 
-  for (i = 0; i < priv->nchars; )
+  for (i = 0, j = 0; i < priv->nchars; i++)
     {
-      FAR struct nxterm_bitmap_s *bm = &priv->bm[i];
+      bm = &priv->bm[i];
 
       /* Has any part of this character scrolled off the screen? */
 
       if (bm->pos.y < scrollheight + CONFIG_NXTERM_LINESEPARATION)
         {
-          /* Yes... Delete the character by moving all of the data */
+          /* Yes... Delete the character by not copying it.  It is no longer
+           * one of the characters on the display, if it ever was.
+           */
 
-          for (j = i; j < priv->nchars-1; j++)
+          if (i < priv->ndrawn)
             {
-              memcpy(&priv->bm[j], &priv->bm[j+1],
-                     sizeof(struct nxterm_bitmap_s));
+              ndrawn--;
             }
-
-          /* Decrement the number of cached characters ('i' is not incremented
-           * in this case because it already points to the next character)
-           */
-
-          priv->nchars--;
         }
 
       /* No.. just decrement its vertical position (moving it "up" the
@@ -219,17 +221,84 @@ void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight)
         {
           bm->pos.y -= scrollheight;
 
-          /* We are keeping this one so increment to the next character */
+          /* We are keeping this one */
 
-          i++;
+          if (j != i)
+            {
+              memcpy(&priv->bm[j], bm, sizeof(struct nxterm_bitmap_s));
+            }
+
+          j++;
         }
     }
 
+  priv->nchars = j;
+  priv->ndrawn = ndrawn;
+
   /* And move the next display position up by one line as well */
 
   priv->fpos.y -= scrollheight;
 
-  /* Move the display in the range of 0-height up one scrollheight. */
+  /* The display is not moved here.  Scrolls are accumulated and performed
+   * with a single move by nxterm_flush() so that printing many lines costs
+   * one display update instead of one per line.
+   */
+
+  priv->scrollpend += scrollheight;
+}
+
+/****************************************************************************
+ * Name: nxterm_flush
+ *
+ * Description:
+ *   Bring the display up to date:  Perform any scrolling accumulated by
+ *   nxterm_scroll() and render all characters added by nxterm_putc() that
+ *   are not yet on the display.  This must be called before any operation
+ *   that draws directly to the display and before relinquishing the
+ *   driver.
+ *
+ ****************************************************************************/
+
+void nxterm_flush(FAR struct nxterm_state_s *priv)
+{
+  int i;
+
+  if (priv->scrollpend > 0)
+    {
+#ifdef CONFIG_NX_WRITEONLY
+      int lineheight = priv->fheight + CONFIG_NXTERM_LINESEPARATION;
+
+      /* Re-draw the display above the current line (this includes any of
+       * the new characters that lie there), then the current line.
+       */
+
+      nxterm_movedisplay(priv, priv->fpos.y, lineheight);
+
+      for (i = 0; i < priv->nchars; i++)
+        {
+          if (priv->bm[i].pos.y >= priv->fpos.y)
+            {
+              nxterm_fillchar(priv, NULL, &priv->bm[i]);
+            }
+        }
+
+      priv->scrollpend = 0;
+      priv->ndrawn     = priv->nchars;
+      return;
+#else
+      /* Move the display up by the total scroll distance */
+
+      nxterm_movedisplay(priv, priv->fpos.y, priv->scrollpend);
+      priv->scrollpend = 0;
+#endif
+    }
+
+  /* Render the new characters */
+
+  for (i = priv->ndrawn; i < priv->nchars; i++)
+    {
+      nxterm_fillchar(priv, NULL, &priv->bm[i]);
+    }
 
-  nxterm_movedisplay(priv, priv->fpos.y, scrollheight);
+  priv->ndrawn = priv->nchars;
 }
@@ -97,9 +97,9 @@ uint16_t vnc_convert_rgb16_555(lfb_color_t rgb)
    * .RRR..GG G..BB...
    */
 
-  return (uint8_t)((((uint16_t)rgb << 8) & 0x7000)  |
-                   (((uint16_t)rgb << 5) & 0x0380)  |
-                   (((uint16_t)rgb << 3) & 0x0018));
+  return (uint16_t)((((uint16_t)rgb << 7) & 0x7000)  |
+                    (((uint16_t)rgb << 5) & 0x0380)  |
+                    (((uint16_t)rgb << 3) & 0x0018));
 }
 
 uint16_t vnc_convert_rgb16_565(lfb_color_t rgb)
@@ -111,9 +111,9 @@ uint16_t vnc_convert_rgb16_565(lfb_color_t rgb)
    * RRR..GGG ...BB...
    */
 
-  return (uint8_t)((((uint16_t)rgb << 8) & 0xe000)  |
-                   (((uint16_t)rgb << 6) & 0x0700)  |
-                   (((uint16_t)rgb << 3) & 0x0018));
+  return (uint16_t)((((uint16_t)rgb << 8) & 0xe000)  |
+                    (((uint16_t)rgb << 6) & 0x0700)  |
+                    (((uint16_t)rgb << 3) & 0x0018));
 }
 
 uint32_t vnc_convert_rgb32_888(lfb_color_t rgb)
@@ -155,7 +155,7 @@ uint8_t vnc_convert_rgb8_332(lfb_color_t rgb)
    *          RRRGGGBB
    */
 
-  return (uint8_t)(((rgb >> 8) & 0x0070)  |
+  return (uint8_t)(((rgb >> 8) & 0x00e0)  |
                    ((rgb >> 6) & 0x001c)  |
                    ((rgb >> 3) & 0x0003));
 }
@@ -206,7 +206,7 @@ uint8_t vnc_convert_rgb8_222(lfb_color_t rgb)
 
   return (uint8_t)(((rgb >> 18) & 0x00000030)  |
                    ((rgb >> 12) & 0x0000000c)  |
-                    (rgb >> 6)  & 0x00000003));
+                   ((rgb >> 6)  & 0x00000003));
 }
 
 uint8_t vnc_convert_rgb8_332(lfb_color_t rgb)
@@ -218,9 +218,9 @@ uint8_t vnc_convert_rgb8_332(lfb_color_t rgb)
    *                            RRRGGGBB
    */
 
-  return (uint8_t)(((rgb >> 16) & 0x00000070)  |
+  return (uint8_t)(((rgb >> 16) & 0x000000e0)  |
                    ((rgb >> 11) & 0x0000001c)  |
-                    (rgb >> 6)  & 0x00000003));
+                   ((rgb >> 6)  & 0x00000003));
 }
 
 uint16_t vnc_convert_rgb16_555(lfb_color_t rgb)
@@ -299,6 +299,7 @@ int vnc_colors(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect,
   nxgl_coord_t x;
   nxgl_coord_t y;
   int ncolors = 0;
+  int lastndx = 0;
   int pixndx;
   int maxndx;
   int cmpndx;
@@ -319,9 +320,19 @@ int vnc_colors(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect,
       pixptr = rowstart;
       for (x = rect->pt1.x; x <= rect->pt2.x; x++)
         {
-          /* Compare this pix to all of the others we have seen */
+          /* Runs of one color are common, so check the color of the last
+           * pixel first.
+           */
 
           pixel = *pixptr++;
+          if (ncolors > 0 && pixel == colors[lastndx])
+            {
+              counts[lastndx]++;
+              continue;
+            }
+
+          /* Compare this pix to all of the others we have seen */
+
           for (pixndx = 0; pixndx < ncolors; pixndx++)
             {
               if (colors[pixndx] == pixel)
@@ -339,6 +350,7 @@ int vnc_colors(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect,
                */
 
               counts[pixndx]++;
+              lastndx = pixndx;
             }
 
            /* Do we have space for another color? */
@@ -358,6 +370,7 @@ int vnc_colors(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect,
             {
               colors[ncolors] = pixel;
               counts[ncolors] = 1;
+              lastndx         = ncolors;
               ncolors++;
             }
         }
@@ -0,0 +1,599 @@
+/****************************************************************************
+ * graphics/vnc/server/vnc_hextile.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_FEATURES
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  define CONFIG_DEBUG_FEATURES 1
+#  define CONFIG_DEBUG_ERROR    1
+#  define CONFIG_DEBUG_WARN     1
+#  define CONFIG_DEBUG_INFO     1
+#  define CONFIG_DEBUG_GRAPHICS 1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of distinct colors counted when picking a tile background */
+
+#define HEXTILE_NCOLORS 8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* State of one Hextile rectangle as it is being encoded */
+
+struct vnc_hextile_s
+{
+  FAR struct vnc_session_s *session;
+  FAR uint8_t *dest;           /* Next free byte in the update buffer */
+  uint8_t bytesperpixel;       /* Size of one remote pixel */
+  bool bigendian;              /* Remote pixel byte order */
+  bool bgvalid;                /* True: bg carries over to the next tile */
+  bool fgvalid;                /* True: fg carries over to the next tile */
+  uint32_t bg;                 /* Current background (remote format) */
+  uint32_t fg;                 /* Current foreground (remote format) */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile_putpixel
+ *
+ * Description:
+ *   Append one pixel in the remote format to the update buffer.
+ *
+ ****************************************************************************/
+
+static void vnc_hextile_putpixel(FAR struct vnc_hextile_s *hex,
+                                 uint32_t pixel)
+{
+  FAR uint8_t *dest = hex->dest;
+
+  if (hex->bytesperpixel == 1)
+    {
+      *dest = (uint8_t)pixel;
+    }
+  else if (hex->bytesperpixel == 2)
+    {
+      if (hex->bigendian)
+        {
+          rfb_putbe16(dest, pixel);
+        }
+      else
+        {
+          rfb_putle16(dest, pixel);
+        }
+    }
+  else
+    {
+      if (hex->bigendian)
+        {
+          rfb_putbe32(dest, pixel);
+        }
+      else
+        {
+          rfb_putle32(dest, pixel);
+        }
+    }
+
+  hex->dest += hex->bytesperpixel;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_flush
+ *
+ * Description:
+ *   Send everything in the update buffer.
+ *
+ ****************************************************************************/
+
+static int vnc_hextile_flush(FAR struct vnc_hextile_s *hex)
+{
+  FAR struct vnc_session_s *session = hex->session;
+  FAR const uint8_t *src = session->outbuf;
+  size_t size = (size_t)(hex->dest - session->outbuf);
+  ssize_t nsent;
+
+  while (size > 0)
+    {
+      nsent = psock_send(&session->connect, src, size, 0);
+      if (nsent < 0)
+        {
+          gerr("ERROR: Send Hextile FrameBufferUpdate failed: %d\n",
+               (int)nsent);
+          return (int)nsent;
+        }
+
+      DEBUGASSERT(nsent <= size);
+      src  += nsent;
+      size -= nsent;
+    }
+
+  hex->dest = session->outbuf;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_encode
+ *
+ * Description:
+ *   Encode the tile in session->tile (width x height remote pixels with a
+ *   stride of VNC_TILESIZE) into the update buffer.
+ *
+ ****************************************************************************/
+
+static void vnc_hextile_encode(FAR struct vnc_hextile_s *hex,
+                               unsigned int width, unsigned int height)
+{
+  FAR const uint32_t *tile = hex->session->tile;
+  FAR uint8_t *start = hex->dest;
+  FAR uint8_t *nsubrects;
+  FAR uint8_t *limit;
+  uint32_t colors[HEXTILE_NCOLORS];
+  unsigned int counts[HEXTILE_NCOLORS];
+  uint16_t covered[VNC_TILESIZE];
+  unsigned int ncolors;
+  unsigned int count;
+  unsigned int x;
+  unsigned int y;
+  unsigned int x2;
+  unsigned int y2;
+  unsigned int i;
+  uint32_t pixel;
+  uint32_t bg;
+  uint32_t fg;
+  uint16_t mask;
+  uint8_t subenc;
+  bool many;
+
+  /* Find the most frequent color (among the first few seen) to use as the
+   * background.
+   */
+
+  ncolors = 0;
+  many    = false;
+
+  for (y = 0; y < height; y++)
+    {
+      for (x = 0; x < width; x++)
+        {
+          pixel = tile[y * VNC_TILESIZE + x];
+          for (i = 0; i < ncolors && colors[i] != pixel; i++)
+            {
+            }
+
+          if (i < ncolors)
+            {
+              counts[i]++;
+            }
+          else if (ncolors < HEXTILE_NCOLORS)
+            {
+              colors[ncolors] = pixel;
+              counts[ncolors] = 1;
+              ncolors++;
+            }
+          else
+            {
+              many = true;
+            }
+        }
+    }
+
+  for (bg = colors[0], count = counts[0], i = 1; i < ncolors; i++)
+    {
+      if (counts[i] > count)
+        {
+          bg    = colors[i];
+          count = counts[i];
+        }
+    }
+
+  /* Solid tile: at most the background pixel */
+
+  if (ncolors == 1)
+    {
+      if (hex->bgvalid && hex->bg == bg)
+        {
+          *hex->dest++ = 0;
+        }
+      else
+        {
+          *hex->dest++ = RFB_SUBENCODING_BACK;
+          vnc_hextile_putpixel(hex, bg);
+        }
+
+      hex->bg      = bg;
+      hex->bgvalid = true;
+      return;
+    }
+
+  /* Otherwise, sub-rectangles on the background.  With exactly two colors
+   * they all have the foreground color, else each carries its own color.
+   */
+
+  fg     = (colors[0] == bg) ? colors[1] : colors[0];
+  subenc = RFB_SUBENCODING_ANY;
+
+  if (!hex->bgvalid || hex->bg != bg)
+    {
+      subenc |= RFB_SUBENCODING_BACK;
+    }
+
+  if (ncolors > 2 || many)
+    {
+      subenc |= RFB_SUBENCODING_COLORED;
+    }
+  else if (!hex->fgvalid || hex->fg != fg)
+    {
+      subenc |= RFB_SUBENCODING_FORE;
+    }
+
+  *hex->dest++ = subenc;
+  if ((subenc & RFB_SUBENCODING_BACK) != 0)
+    {
+      vnc_hextile_putpixel(hex, bg);
+    }
+
+  if ((subenc & RFB_SUBENCODING_FORE) != 0)
+    {
+      vnc_hextile_putpixel(hex, fg);
+    }
+
+  nsubrects = hex->dest++;
+  count     = 0;
+
+  /* Give up on sub-rectangles as soon as they are no smaller than the raw
+   * tile would be.
+   */
+
+  limit = start + 1 + width * height * hex->bytesperpixel;
+  memset(covered, 0, sizeof(covered));
+
+  for (y = 0; y < height; y++)
+    {
+      for (x = 0; x < width; x++)
+        {
+          pixel = tile[y * VNC_TILESIZE + x];
+          if (pixel == bg || (covered[y] & (1 << x)) != 0)
+            {
+              continue;
+            }
+
+          /* Grow the sub-rectangle to the right, then downward while each
+           * row matches.
+           */
+
+          for (x2 = x + 1;
+               x2 < width && tile[y * VNC_TILESIZE + x2] == pixel &&
+               (covered[y] & (1 << x2)) == 0;
+               x2++)
+            {
+            }
+
+          mask = (uint16_t)(((1 << x2) - 1) & ~((1 << x) - 1));
+
+          for (y2 = y + 1; y2 < height && (covered[y2] & mask) == 0; y2++)
+            {
+              for (i = x; i < x2 && tile[y2 * VNC_TILESIZE + i] == pixel;
+                   i++)
+                {
+                }
+
+              if (i < x2)
+                {
+                  break;
+                }
+            }
+
+          for (i = y; i < y2; i++)
+            {
+              covered[i] |= mask;
+            }
+
+          if ((subenc & RFB_SUBENCODING_COLORED) != 0)
+            {
+              if (hex->dest + hex->bytesperpixel + 2 > limit)
+                {
+                  goto rawtile;
+                }
+
+              vnc_hextile_putpixel(hex, pixel);
+            }
+          else if (hex->dest + 2 > limit)
+            {
+              goto rawtile;
+            }
+
+          *hex->dest++ = (uint8_t)(x << 4 | y);
+          *hex->dest++ = (uint8_t)((x2 - x - 1) << 4 | (y2 - y - 1));
+          count++;
+        }
+    }
+
+  *nsubrects   = (uint8_t)count;
+  hex->bg      = bg;
+  hex->bgvalid = true;
+
+  if ((subenc & RFB_SUBENCODING_COLORED) != 0)
+    {
+      hex->fgvalid = false;
+    }
+  else
+    {
+      hex->fg      = fg;
+      hex->fgvalid = true;
+    }
+
+  return;
+
+rawtile:
+
+  /* Start over and send the tile raw.  Neither color carries over a raw
+   * tile.
+   */
+
+  hex->dest    = start;
+  *hex->dest++ = RFB_SUBENCODING_RAW;
+
+  for (y = 0; y < height; y++)
+    {
+      for (x = 0; x < width; x++)
+        {
+          vnc_hextile_putpixel(hex, tile[y * VNC_TILESIZE + x]);
+        }
+    }
+
+  hex->bgvalid = false;
+  hex->fgvalid = false;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding.  The update is
+ *  sent as a single rectangle, streamed through the update buffer one
+ *  group of tiles at a time.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect    - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.  A failure is only returned
+ *   in cases of a network failure and unexpected internal failures.
+ *
+ ****************************************************************************/
+
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect)
+{
+  FAR struct rfb_framebufferupdate_s *update;
+  FAR const lfb_color_t *srcrow;
+  FAR const lfb_color_t *src;
+  FAR uint32_t *dest;
+  struct vnc_hextile_s hex;
+  nxgl_coord_t tx;
+  nxgl_coord_t ty;
+  unsigned int width;
+  unsigned int height;
+  unsigned int x;
+  unsigned int y;
+  lfb_color_t last;
+  uint32_t pixel;
+  uint8_t colorfmt;
+  int ret;
+
+  union
+  {
+    vnc_convert8_t bpp8;
+    vnc_convert16_t bpp16;
+    vnc_convert32_t bpp32;
+  } convert;
+
+  DEBUGASSERT(rect->pt1.x <= rect->pt2.x && rect->pt1.y <= rect->pt2.y);
+
+  /* Capture the client pixel format.  Once the update message is started
+   * it must be completed in that format, even if a SetPixelFormat is
+   * received asynchronously.
+   */
+
+  colorfmt = session->colorfmt;
+  switch (colorfmt)
+    {
+      case FB_FMT_RGB8_222:
+        convert.bpp8 = vnc_convert_rgb8_222;
+        break;
+
+      case FB_FMT_RGB8_332:
+        convert.bpp8 = vnc_convert_rgb8_332;
+        break;
+
+      case FB_FMT_RGB16_555:
+        convert.bpp16 = vnc_convert_rgb16_555;
+        break;
+
+      case FB_FMT_RGB16_565:
+        convert.bpp16 = vnc_convert_rgb16_565;
+        break;
+
+      case FB_FMT_RGB32:
+        convert.bpp32 = vnc_convert_rgb32_888;
+        break;
+
+      default:
+        gerr("ERROR: Unrecognized color format: %d\n", session->colorfmt);
+        return -EINVAL;
+    }
+
+  hex.session       = session;
+  hex.bytesperpixel = (session->bpp + 7) >> 3;
+  hex.bigendian     = session->bigendian;
+  hex.bgvalid       = false;
+  hex.fgvalid       = false;
+
+  /* Format the FramebufferUpdate message with one Hextile rectangle */
+
+  update          = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+  update->msgtype = RFB_FBUPDATE_MSG;
+  update->padding = 0;
+  rfb_putbe16(update->nrect, 1);
+
+  rfb_putbe16(update->rect[0].xpos, rect->pt1.x);
+  rfb_putbe16(update->rect[0].ypos, rect->pt1.y);
+  rfb_putbe16(update->rect[0].width, rect->pt2.x - rect->pt1.x + 1);
+  rfb_putbe16(update->rect[0].height, rect->pt2.y - rect->pt1.y + 1);
+  rfb_putbe32(update->rect[0].encoding, RFB_ENCODING_HEXTILE);
+
+  hex.dest = session->outbuf +
+             SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0));
+
+  /* Then each tile, left-to-right and top-to-bottom */
+
+  for (ty = rect->pt1.y; ty <= rect->pt2.y; ty += VNC_TILESIZE)
+    {
+      height = MIN(VNC_TILESIZE, rect->pt2.y - ty + 1);
+
+      for (tx = rect->pt1.x; tx <= rect->pt2.x; tx += VNC_TILESIZE)
+        {
+          width = MIN(VNC_TILESIZE, rect->pt2.x - tx + 1);
+
+          /* Convert the tile to the remote color format.  Runs of one
+           * color are common, so remember the last conversion.
+           */
+
+          srcrow = (FAR const lfb_color_t *)
+            (session->fb + RFB_STRIDE * ty + RFB_BYTESPERPIXEL * tx);
+          dest   = session->tile;
+          last   = *srcrow;
+
+          switch (hex.bytesperpixel)
+            {
+              case 1:
+                pixel = convert.bpp8(last);
+                break;
+
+              case 2:
+                pixel = convert.bpp16(last);
+                break;
+
+              default:
+                pixel = convert.bpp32(last);
+                break;
+            }
+
+          for (y = 0; y < height; y++)
+            {
+              src = srcrow;
+              for (x = 0; x < width; x++, src++)
+                {
+                  if (*src != last)
+                    {
+                      last = *src;
+                      switch (hex.bytesperpixel)
+                        {
+                          case 1:
+                            pixel = convert.bpp8(last);
+                            break;
+
+                          case 2:
+                            pixel = convert.bpp16(last);
+                            break;
+
+                          default:
+                            pixel = convert.bpp32(last);
+                            break;
+                        }
+                    }
+
+                  dest[x] = pixel;
+                }
+
+              dest  += VNC_TILESIZE;
+              srcrow = (FAR const lfb_color_t *)
+                ((uintptr_t)srcrow + RFB_STRIDE);
+            }
+
+          /* Make room for the worst case tile, then encode it */
+
+          if (hex.dest + VNC_HEXTILE_MAXTILE >
+              session->outbuf + VNCSERVER_UPDATE_BUFSIZE)
+            {
+              ret = vnc_hextile_flush(&hex);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+            }
+
+          vnc_hextile_encode(&hex, width, height);
+        }
+    }
+
+  ret = vnc_hextile_flush(&hex);
+  if (ret >= 0)
+    {
+      updinfo("Sent {(%d, %d),(%d, %d)}\n",
+              rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+    }
+
+  return ret;
+}
@@ -525,6 +525,12 @@ int vnc_client_pixelformat(FAR struct vnc_session_s *session,
       return -ENOSYS;
     }
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+  /* Everything the client has is now in the wrong format */
+
+  vnc_tile_invalidate(session, NULL);
+#endif
+
   session->change = true;
   return OK;
 }
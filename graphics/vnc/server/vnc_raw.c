@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -58,10 +59,64 @@
 
 #include "vnc_server.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Byte order of the local framebuffer pixels */
+
+#ifdef CONFIG_ENDIAN_BIG
+#  define LFB_BIGENDIAN true
+#else
+#  define LFB_BIGENDIAN false
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: vnc_copyraw
+ *
+ * Description:
+ *   Copy pixels from the source rectangle when the remote framebuffer uses
+ *   exactly the local color format and byte order.
+ *
+ * Input Parameters:
+ *   session      - A reference to the VNC session structure.
+ *   row,col      - The upper left X/Y (pixel/row) position of the rectangle
+ *   width,height - The width (pixels) and height (rows of the rectangle)
+ *
+ * Returned Value:
+ *   The size of the transfer in bytes.
+ *
+ ****************************************************************************/
+
+static size_t vnc_copyraw(FAR struct vnc_session_s *session,
+                          nxgl_coord_t row, nxgl_coord_t col,
+                          nxgl_coord_t height, nxgl_coord_t width)
+{
+  FAR struct rfb_framebufferupdate_s *update;
+  FAR const uint8_t *src;
+  FAR uint8_t *dest;
+  size_t nbytes;
+  nxgl_coord_t y;
+
+  update = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+  dest   = (FAR uint8_t *)update->rect[0].data;
+  src    = session->fb + RFB_STRIDE * row + RFB_BYTESPERPIXEL * col;
+  nbytes = RFB_BYTESPERPIXEL * width;
+
+  for (y = 0; y < height; y++)
+    {
+      memcpy(dest, src, nbytes);
+      dest += nbytes;
+      src  += RFB_STRIDE;
+    }
+
+  return nbytes * height;
+}
+
 /****************************************************************************
  * Name: vnc_copy8
  *
@@ -90,6 +145,8 @@ static size_t vnc_copy8(FAR struct vnc_session_s *session,
   FAR const lfb_color_t *srcleft;
   FAR const lfb_color_t *src;
   FAR uint8_t *dest;
+  lfb_color_t last;
+  uint8_t pixel;
   nxgl_coord_t x;
   nxgl_coord_t y;
 
@@ -103,14 +160,25 @@ static size_t vnc_copy8(FAR struct vnc_session_s *session,
   srcleft = (FAR lfb_color_t *)
     (session->fb + RFB_STRIDE * row + RFB_BYTESPERPIXEL * col);
 
-  /* Transfer each row from the source buffer into the update buffer */
+  /* Transfer each row from the source buffer into the update buffer.
+   * Runs of one color are common, so only convert when the color changes.
+   */
+
+  last  = *srcleft;
+  pixel = convert(last);
 
   for (y = 0; y < height; y++)
     {
       src = srcleft;
       for (x = 0; x < width; x++)
         {
-          *dest++ = convert(*src);
+          if (*src != last)
+            {
+              last  = *src;
+              pixel = convert(last);
+            }
+
+          *dest++ = pixel;
           src++;
         }
 
@@ -148,6 +216,7 @@ static size_t vnc_copy16(FAR struct vnc_session_s *session,
   FAR const lfb_color_t *srcleft;
   FAR const lfb_color_t *src;
   FAR uint8_t *dest;
+  lfb_color_t last;
   uint16_t pixel;
   nxgl_coord_t x;
   nxgl_coord_t y;
@@ -164,13 +233,20 @@ static size_t vnc_copy16(FAR struct vnc_session_s *session,
 
   /* Transfer each row from the source buffer into the update buffer */
 
+  last      = *srcleft;
+  pixel     = convert(last);
   bigendian = session->bigendian;
+
   for (y = 0; y < height; y++)
     {
       src = srcleft;
       for (x = 0; x < width; x++)
         {
-          pixel = convert(*src);
+          if (*src != last)
+            {
+              last  = *src;
+              pixel = convert(last);
+            }
 
           if (bigendian)
             {
@@ -221,6 +297,7 @@ static size_t vnc_copy32(FAR struct vnc_session_s *session,
   FAR uint8_t *dest;
   nxgl_coord_t x;
   nxgl_coord_t y;
+  lfb_color_t last;
   uint32_t pixel;
   bool bigendian;
 
@@ -235,13 +312,20 @@ static size_t vnc_copy32(FAR struct vnc_session_s *session,
 
   /* Transfer each row from the source buffer into the update buffer */
 
+  last      = *srcleft;
+  pixel     = convert(last);
   bigendian = session->bigendian;
+
   for (y = 0; y < height; y++)
     {
       src = srcleft;
       for (x = 0; x < width; x++)
         {
-          pixel = convert(*src);
+          if (*src != last)
+            {
+              last  = *src;
+              pixel = convert(last);
+            }
 
           if (bigendian)
             {
@@ -259,7 +343,7 @@ static size_t vnc_copy32(FAR struct vnc_session_s *session,
       srcleft = (FAR lfb_color_t *)((uintptr_t)srcleft + RFB_STRIDE);
     }
 
-  return (size_t)((uintptr_t)srcleft - (uintptr_t)update->rect[0].data);
+  return (size_t)((uintptr_t)dest - (uintptr_t)update->rect[0].data);
 }
 
 /****************************************************************************
@@ -303,6 +387,7 @@ int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
   size_t size;
   ssize_t nsent;
   uint8_t colorfmt;
+  bool identity;
 
   union
   {
@@ -349,6 +434,11 @@ int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
         return -EINVAL;
     }
 
+  /* If the client uses the local pixel format, copy the pixels as is */
+
+  identity = (colorfmt == RFB_COLORFMT &&
+              (RFB_BYTESPERPIXEL == 1 || session->bigendian == LFB_BIGENDIAN));
+
   /* Get with width and height of the source and destination rectangles.
    * The source rectangle many be larger than the destination rectangle.
    * In that case, we will have to emit multiple rectangles.
@@ -430,7 +520,11 @@ int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
            * performing the necessary color conversions.
            */
 
-          if (bytesperpixel == 1)
+          if (identity)
+            {
+              size = vnc_copyraw(session, y, x, updheight, updwidth);
+            }
+          else if (bytesperpixel == 1)
             {
               size = vnc_copy8(session, y, x, updheight, updwidth,
                                convert.bpp8);
@@ -297,6 +297,17 @@ int vnc_receiver(FAR struct vnc_session_s *session)
                   rect.pt2.x = rect.pt1.x + rfb_getbe16(update->width);
                   rect.pt2.y = rect.pt1.y + rfb_getbe16(update->height);
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+                  /* A non-incremental request wants the whole region,
+                   * whatever the client had before.
+                   */
+
+                  if (update->incremental == 0)
+                    {
+                      vnc_tile_invalidate(session, &rect);
+                    }
+#endif
+
                   ret = vnc_update_rectangle(session, &rect, false);
                   if (ret < 0)
                     {
@@ -466,6 +477,9 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
   /* Assume that there are no common encodings (other than RAW) */
 
   session->rre = false;
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  session->hextile = false;
+#endif
 
   /* Loop for each client supported encoding */
 
@@ -482,6 +496,12 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
         {
           session->rre = true;
         }
+#ifdef CONFIG_VNCSERVER_HEXTILE
+      else if (encoding == RFB_ENCODING_HEXTILE)
+        {
+          session->hextile = true;
+        }
+#endif
     }
 
   session->change = true;
@@ -160,6 +160,23 @@
 #define VNCSERVER_UPDATE_BUFSIZE \
   (CONFIG_VNCSERVER_UPDATE_BUFSIZE + SIZEOF_RFB_FRAMEBUFFERUPDATE_S(0))
 
+/* Tiles used for Hextile encoding and for change detection.  For Hextile,
+ * the update buffer must hold at least one raw tile at 32 bits per pixel.
+ */
+
+#define VNC_TILESIZE        16
+#define VNC_NTILESX         \
+  ((CONFIG_VNCSERVER_SCREENWIDTH + VNC_TILESIZE - 1) / VNC_TILESIZE)
+#define VNC_NTILESY         \
+  ((CONFIG_VNCSERVER_SCREENHEIGHT + VNC_TILESIZE - 1) / VNC_TILESIZE)
+#define VNC_NTILES          (VNC_NTILESX * VNC_NTILESY)
+#define VNC_HEXTILE_MAXTILE (1 + VNC_TILESIZE * VNC_TILESIZE * 4)
+
+#if defined(CONFIG_VNCSERVER_HEXTILE) && \
+    CONFIG_VNCSERVER_UPDATE_BUFSIZE < VNC_HEXTILE_MAXTILE
+#  error CONFIG_VNCSERVER_UPDATE_BUFSIZE is too small for Hextile encoding
+#endif
+
 /* Local framebuffer characteristics in bytes */
 
 #define RFB_BYTESPERPIXEL   ((RFB_BITSPERPIXEL + 7) >> 3)
@@ -251,8 +268,23 @@ struct vnc_session_s
   volatile uint8_t bpp;        /* Remote bits per pixel */
   volatile bool bigendian;     /* True: Remote expect data in big-endian format */
   volatile bool rre;           /* True: Remote supports RRE encoding */
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  volatile bool hextile;       /* True: Remote supports Hextile encoding */
+#endif
   FAR uint8_t *fb;             /* Allocated local frame buffer */
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+  /* Hash of each tile as last sent to the client (zero: unknown) */
+
+  uint32_t tilehash[VNC_NTILES];
+#endif
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  /* One tile converted to the remote color format */
+
+  uint32_t tile[VNC_TILESIZE * VNC_TILESIZE];
+#endif
+
   /* VNC client input support */
 
   vnc_kbdout_t kbdout;         /* Callout when keyboard input is received */
@@ -459,6 +491,27 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
                          FAR const struct nxgl_rect_s *rect,
                          bool change);
 
+/****************************************************************************
+ * Name: vnc_tile_invalidate
+ *
+ * Description:
+ *  Forget the hashes of all tiles that intersect a rectangle so that the
+ *  next update of the region is sent in full, whether it changed or not.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect    - The region to invalidate, or NULL for the whole screen.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+void vnc_tile_invalidate(FAR struct vnc_session_s *session,
+                         FAR const struct nxgl_rect_s *rect);
+#endif
+
 /****************************************************************************
  * Name: vnc_receiver
  *
@@ -518,6 +571,30 @@ int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
 int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding.  The update is
+ *  sent as a single rectangle, streamed through the update buffer one
+ *  group of tiles at a time.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect    - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.  A failure is only returned
+ *   in cases of a network failure and unexpected internal failures.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect);
+#endif
+
 /****************************************************************************
  * Name: vnc_key_map
  *
@@ -381,6 +381,190 @@ static void vnc_add_queue(FAR struct vnc_session_s *session,
   sched_unlock();
 }
 
+/****************************************************************************
+ * Name: vnc_send_rectangle
+ *
+ * Description:
+ *   Send one rectangle of the local framebuffer to the client using the
+ *   best encoding that the client supports.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The rectangle to be sent.
+ *
+ * Returned Value:
+ *   Zero or a positive value on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int vnc_send_rectangle(FAR struct vnc_session_s *session,
+                              FAR struct nxgl_rect_s *rect)
+{
+  int ret;
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  /* Hextile already handles solid regions as well as RRE does */
+
+  if (session->hextile)
+    {
+      return vnc_hextile(session, rect);
+    }
+#endif
+
+  /* Attempt to use RRE encoding */
+
+  ret = vnc_rre(session, rect);
+  if (ret == 0)
+    {
+      /* Perform the framebuffer update using the default RAW encoding */
+
+      ret = vnc_raw(session, rect);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: vnc_tile_hash
+ *
+ * Description:
+ *   Hash the content of one tile of the local framebuffer.  Zero is never
+ *   returned; it marks a tile whose content at the client is unknown.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+static uint32_t vnc_tile_hash(FAR struct vnc_session_s *session,
+                              FAR const struct nxgl_rect_s *tile)
+{
+  FAR const uint8_t *row;
+  FAR const uint8_t *src;
+  unsigned int nbytes;
+  unsigned int i;
+  nxgl_coord_t y;
+  uint32_t hash = 2166136261u;
+
+  nbytes = RFB_BYTESPERPIXEL * (tile->pt2.x - tile->pt1.x + 1);
+  row    = session->fb + RFB_STRIDE * tile->pt1.y +
+           RFB_BYTESPERPIXEL * tile->pt1.x;
+
+  /* FNV-1a over the bytes of each row */
+
+  for (y = tile->pt1.y; y <= tile->pt2.y; y++, row += RFB_STRIDE)
+    {
+      for (src = row, i = 0; i < nbytes; i++)
+        {
+          hash = (hash ^ *src++) * 16777619u;
+        }
+    }
+
+  return hash != 0 ? hash : 1;
+}
+#endif
+
+/****************************************************************************
+ * Name: vnc_send_changes
+ *
+ * Description:
+ *   Send the tiles of an update rectangle whose content differs from what
+ *   was last sent.  Tiles of the rectangle are compared a row of tiles at a
+ *   time and each horizontal run of changed tiles is sent as one
+ *   rectangle.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The update rectangle.
+ *
+ * Returned Value:
+ *   Zero or a positive value on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+static int vnc_send_changes(FAR struct vnc_session_s *session,
+                            FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s tile;
+  struct nxgl_rect_s run;
+  FAR uint32_t *hashp;
+  uint32_t hash;
+  nxgl_coord_t tx;
+  nxgl_coord_t ty;
+  bool inrun;
+  int ret = OK;
+
+  /* Loop for each row of tiles touched by the rectangle */
+
+  for (ty = rect->pt1.y / VNC_TILESIZE;
+       ty <= rect->pt2.y / VNC_TILESIZE;
+       ty++)
+    {
+      tile.pt1.y = ty * VNC_TILESIZE;
+      tile.pt2.y = MIN(tile.pt1.y + VNC_TILESIZE,
+                       CONFIG_VNCSERVER_SCREENHEIGHT) - 1;
+      inrun      = false;
+
+      for (tx = rect->pt1.x / VNC_TILESIZE;
+           tx <= rect->pt2.x / VNC_TILESIZE;
+           tx++)
+        {
+          tile.pt1.x = tx * VNC_TILESIZE;
+          tile.pt2.x = MIN(tile.pt1.x + VNC_TILESIZE,
+                           CONFIG_VNCSERVER_SCREENWIDTH) - 1;
+
+          /* The whole tile is hashed and, if changed, sent.  Any change
+           * outside of rect but inside the tile is then already sent when
+           * its own update is dequeued.
+           */
+
+          hashp = &session->tilehash[ty * VNC_NTILESX + tx];
+          hash  = vnc_tile_hash(session, &tile);
+
+          if (hash != *hashp)
+            {
+              *hashp = hash;
+
+              if (!inrun)
+                {
+                  nxgl_rectcopy(&run, &tile);
+                  inrun = true;
+                }
+              else
+                {
+                  run.pt2.x = tile.pt2.x;
+                }
+
+              continue;
+            }
+
+          /* An unchanged tile ends the current run of changes */
+
+          if (inrun)
+            {
+              ret = vnc_send_rectangle(session, &run);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              inrun = false;
+            }
+        }
+
+      if (inrun)
+        {
+          ret = vnc_send_rectangle(session, &run);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: vnc_updater
  *
@@ -424,15 +608,13 @@ static FAR void *vnc_updater(FAR void *arg)
               srcrect->rect.pt1.x, srcrect->rect.pt1.y,
               srcrect->rect.pt2.x, srcrect->rect.pt2.y);
 
-      /* Attempt to use RRE encoding */
+      /* Send the update, or only the parts of it that changed */
 
-      ret = vnc_rre(session, &srcrect->rect);
-      if (ret == 0)
-        {
-          /* Perform the framebuffer update using the default RAW encoding */
-
-          ret = vnc_raw(session, &srcrect->rect);
-        }
+#ifdef CONFIG_VNCSERVER_TILEHASH
+      ret = vnc_send_changes(session, &srcrect->rect);
+#else
+      ret = vnc_send_rectangle(session, &srcrect->rect);
+#endif
 
       /* Release the update structure */
 
@@ -544,6 +726,56 @@ int vnc_stop_updater(FAR struct vnc_session_s *session)
   return OK;
 }
 
+/****************************************************************************
+ * Name: vnc_tile_invalidate
+ *
+ * Description:
+ *  Forget the hashes of all tiles that intersect a rectangle so that the
+ *  next update of the region is sent in full, whether it changed or not.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect    - The region to invalidate, or NULL for the whole screen.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+void vnc_tile_invalidate(FAR struct vnc_session_s *session,
+                         FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s intersection;
+  nxgl_coord_t tx;
+  nxgl_coord_t ty;
+
+  if (rect == NULL)
+    {
+      memset(session->tilehash, 0, sizeof(session->tilehash));
+      return;
+    }
+
+  nxgl_rectintersect(&intersection, rect, &g_wholescreen);
+  if (nxgl_nullrect(&intersection))
+    {
+      return;
+    }
+
+  for (ty = intersection.pt1.y / VNC_TILESIZE;
+       ty <= intersection.pt2.y / VNC_TILESIZE;
+       ty++)
+    {
+      for (tx = intersection.pt1.x / VNC_TILESIZE;
+           tx <= intersection.pt2.x / VNC_TILESIZE;
+           tx++)
+        {
+          session->tilehash[ty * VNC_NTILESX + tx] = 0;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: vnc_update_rectangle
  *
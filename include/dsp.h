@@ -102,6 +102,24 @@
 #define MOTOR_ANGLE_M_MIN    (0.0f)
 #define MOTOR_ANGLE_M_RANGE  (MOTOR_ANGLE_M_MAX - MOTOR_ANGLE_M_MIN)
 
+/* Fixed-point constants and conversions ************************************/
+
+/* Q15 and Q31 numbers are signed fractions in the range <-1.0, 1.0) */
+
+#define Q15_MAX              (INT16_MAX)
+#define Q15_MIN              (INT16_MIN)
+#define Q31_MAX              (INT32_MAX)
+#define Q31_MIN              (INT32_MIN)
+
+#define FLOAT_TO_Q15(x)      ((q15_t)((x) >= 1.0f ? Q15_MAX : \
+                                      (x) <= -1.0f ? Q15_MIN : \
+                                      (int32_t)((x) * 32768.0f)))
+#define FLOAT_TO_Q31(x)      ((q31_t)((x) >= 1.0f ? Q31_MAX : \
+                                      (x) <= -1.0f ? Q31_MIN : \
+                                      (int32_t)((x) * 2147483648.0f)))
+#define Q15_TO_FLOAT(x)      ((float)(x) * (1.0f / 32768.0f))
+#define Q31_TO_FLOAT(x)      ((float)(x) * (1.0f / 2147483648.0f))
+
 /* Some useful macros ***************************************************************/
 
 /****************************************************************************
@@ -245,6 +263,143 @@ struct dq_frame_s
 
 typedef struct dq_frame_s dq_frame_t;
 
+/* Fixed-point numbers and frames */
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+struct phase_angle_q15_s
+{
+  q15_t sin;                   /* Phase angle sine */
+  q15_t cos;                   /* Phase angle cosine */
+};
+
+typedef struct phase_angle_q15_s phase_angle_q15_t;
+
+struct abc_frame_q15_s
+{
+  q15_t a;                     /* A component */
+  q15_t b;                     /* B component */
+  q15_t c;                     /* C component */
+};
+
+typedef struct abc_frame_q15_s abc_frame_q15_t;
+
+struct ab_frame_q15_s
+{
+  q15_t a;                     /* Alpha component */
+  q15_t b;                     /* Beta component */
+};
+
+typedef struct ab_frame_q15_s ab_frame_q15_t;
+
+struct dq_frame_q15_s
+{
+  q15_t d;                     /* Direct component */
+  q15_t q;                     /* Quadrature component */
+};
+
+typedef struct dq_frame_q15_s dq_frame_q15_t;
+
+struct phase_angle_q31_s
+{
+  q31_t sin;                   /* Phase angle sine */
+  q31_t cos;                   /* Phase angle cosine */
+};
+
+typedef struct phase_angle_q31_s phase_angle_q31_t;
+
+struct abc_frame_q31_s
+{
+  q31_t a;                     /* A component */
+  q31_t b;                     /* B component */
+  q31_t c;                     /* C component */
+};
+
+typedef struct abc_frame_q31_s abc_frame_q31_t;
+
+struct ab_frame_q31_s
+{
+  q31_t a;                     /* Alpha component */
+  q31_t b;                     /* Beta component */
+};
+
+typedef struct ab_frame_q31_s ab_frame_q31_t;
+
+struct dq_frame_q31_s
+{
+  q31_t d;                     /* Direct component */
+  q31_t q;                     /* Quadrature component */
+};
+
+typedef struct dq_frame_q31_s dq_frame_q31_t;
+
+/* FIR filter.  The delay line is kept twice (state holds 2 * ntaps
+ * samples) so that the newest ntaps samples are always contiguous.
+ */
+
+struct fir_f32_s
+{
+  FAR const float *coeffs;     /* ntaps coefficients, b[0] first */
+  FAR float       *state;      /* 2 * ntaps delay line samples */
+  uint16_t         ntaps;      /* Number of filter taps */
+  uint16_t         pos;        /* Current delay line position */
+};
+
+struct fir_q15_s
+{
+  FAR const q15_t *coeffs;     /* ntaps Q15 coefficients, b[0] first */
+  FAR q15_t       *state;      /* 2 * ntaps delay line samples */
+  uint16_t         ntaps;      /* Number of filter taps */
+  uint16_t         pos;        /* Current delay line position */
+};
+
+struct fir_q31_s
+{
+  FAR const q31_t *coeffs;     /* ntaps Q31 coefficients, b[0] first */
+  FAR q31_t       *state;      /* 2 * ntaps delay line samples */
+  uint16_t         ntaps;      /* Number of filter taps */
+  uint16_t         pos;        /* Current delay line position */
+};
+
+/* Cascade of second order IIR sections.  Each stage uses five
+ * coefficients {b0, b1, b2, a1, a2}:
+ *
+ *   y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ */
+
+struct biquad_f32_s
+{
+  FAR const float *coeffs;     /* 5 * nstages coefficients */
+  FAR float       *state;      /* 2 * nstages samples (direct form II T) */
+  uint8_t          nstages;    /* Number of second order sections */
+};
+
+struct biquad_q31_s
+{
+  FAR const q31_t *coeffs;     /* 5 * nstages coefficients in Q(31-shift) */
+  FAR q31_t       *state;      /* 4 * nstages samples (direct form I) */
+  uint8_t          nstages;    /* Number of second order sections */
+  uint8_t          shift;      /* Coefficient post-shift, 1 allows |a1| < 2 */
+};
+
+/* Real FFT of n points (n is a power of two, at least 4).  The twiddle
+ * table holds the n/2 complex factors exp(-j*2*PI*k/n) as {real, imag}
+ * pairs and is filled by the init function.
+ */
+
+struct rfft_f32_s
+{
+  FAR float       *twiddle;    /* n floats */
+  uint16_t         n;          /* FFT length */
+};
+
+struct rfft_q15_s
+{
+  FAR q15_t       *twiddle;    /* n Q15 numbers */
+  uint16_t         n;          /* FFT length */
+};
+
 /* Space Vector Modulation data for 3-phase system */
 
 struct svm3_state_s
@@ -423,6 +578,59 @@ void park_transform(FAR phase_angle_t *angle, FAR ab_frame_t *ab,
 void inv_park_transform(FAR phase_angle_t *angle, FAR dq_frame_t *dq,
                         FAR ab_frame_t *ab);
 
+/* Fixed-point transformation functions */
+
+void clarke_transform_q15(FAR abc_frame_q15_t *abc, FAR ab_frame_q15_t *ab);
+void inv_clarke_transform_q15(FAR ab_frame_q15_t *ab,
+                              FAR abc_frame_q15_t *abc);
+void park_transform_q15(FAR phase_angle_q15_t *angle,
+                        FAR ab_frame_q15_t *ab, FAR dq_frame_q15_t *dq);
+void inv_park_transform_q15(FAR phase_angle_q15_t *angle,
+                            FAR dq_frame_q15_t *dq, FAR ab_frame_q15_t *ab);
+
+void clarke_transform_q31(FAR abc_frame_q31_t *abc, FAR ab_frame_q31_t *ab);
+void inv_clarke_transform_q31(FAR ab_frame_q31_t *ab,
+                              FAR abc_frame_q31_t *abc);
+void park_transform_q31(FAR phase_angle_q31_t *angle,
+                        FAR ab_frame_q31_t *ab, FAR dq_frame_q31_t *dq);
+void inv_park_transform_q31(FAR phase_angle_q31_t *angle,
+                            FAR dq_frame_q31_t *dq, FAR ab_frame_q31_t *ab);
+
+/* FIR filters */
+
+void fir_init_f32(FAR struct fir_f32_s *fir, FAR const float *coeffs,
+                  FAR float *state, uint16_t ntaps);
+void fir_f32(FAR struct fir_f32_s *fir, FAR const float *in,
+             FAR float *out, size_t n);
+void fir_init_q15(FAR struct fir_q15_s *fir, FAR const q15_t *coeffs,
+                  FAR q15_t *state, uint16_t ntaps);
+void fir_q15(FAR struct fir_q15_s *fir, FAR const q15_t *in,
+             FAR q15_t *out, size_t n);
+void fir_init_q31(FAR struct fir_q31_s *fir, FAR const q31_t *coeffs,
+                  FAR q31_t *state, uint16_t ntaps);
+void fir_q31(FAR struct fir_q31_s *fir, FAR const q31_t *in,
+             FAR q31_t *out, size_t n);
+
+/* Biquad (second order IIR) filters */
+
+void biquad_init_f32(FAR struct biquad_f32_s *bq, FAR const float *coeffs,
+                     FAR float *state, uint8_t nstages);
+void biquad_f32(FAR struct biquad_f32_s *bq, FAR const float *in,
+                FAR float *out, size_t n);
+void biquad_init_q31(FAR struct biquad_q31_s *bq, FAR const q31_t *coeffs,
+                     FAR q31_t *state, uint8_t nstages, uint8_t shift);
+void biquad_q31(FAR struct biquad_q31_s *bq, FAR const q31_t *in,
+                FAR q31_t *out, size_t n);
+
+/* Real FFT */
+
+void rfft_init_f32(FAR struct rfft_f32_s *fft, FAR float *twiddle,
+                   uint16_t n);
+void rfft_f32(FAR struct rfft_f32_s *fft, FAR float *buf);
+void rfft_init_q15(FAR struct rfft_q15_s *fft, FAR q15_t *twiddle,
+                   uint16_t n);
+void rfft_q15(FAR struct rfft_q15_s *fft, FAR q15_t *buf);
+
 /* Phase angle related functions */
 
 void angle_norm(FAR float *angle, float per, float bottom, float top);
@@ -31,6 +31,16 @@
 #ifndef __INCLUDE_LZF_H
 #define __INCLUDE_LZF_H 1
 
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -47,6 +57,14 @@
 #define LZF_MAX_HDR_SIZE   7
 #define LZF_MIN_HDR_SIZE   5
 
+/* Uncompressed size of the blocks of the streaming interface */
+
+#ifndef CONFIG_LIBC_LZF_BLOCKSIZE
+#  define CONFIG_LIBC_LZF_BLOCKSIZE 1024
+#endif
+
+#define LZF_BLOCKSIZE      CONFIG_LIBC_LZF_BLOCKSIZE
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -76,7 +94,10 @@ struct lzf_type1_header_s   /* Compressed data header */
 
 /* LZF hash table */
 
-#if LZF_USE_OFFSETS
+#if defined(CONFIG_LIBC_LZF_SMALLMEM)
+# define LZF_HSLOT_BIAS ((const uint8_t *)in_data)
+  typedef uint16_t lzf_hslot_t;
+#elif LZF_USE_OFFSETS
 # define LZF_HSLOT_BIAS ((const uint8_t *)in_data)
   typedef unsigned int lzf_hslot_t;
 #else
@@ -86,6 +107,57 @@ struct lzf_type1_header_s   /* Compressed data header */
 
 typedef lzf_hslot_t lzf_state_t[1 << HLOG];
 
+/* Streaming compression state.  The caller sets next_in/avail_in and
+ * next_out/avail_out before each call to lzf_cstream(), which advances
+ * them.  Input is collected into blocks of LZF_BLOCKSIZE bytes and every
+ * block is emitted as one ZV frame (the same LZF_TYPE0/1 header + data
+ * format that lzf_compress() produces), so a stream is just a sequence of
+ * frames and can be decoded with lzf_dstream() or frame by frame with
+ * lzf_decompress().
+ */
+
+struct lzf_cstream_s
+{
+  FAR const uint8_t *next_in;    /* Next input byte */
+  size_t             avail_in;   /* Number of bytes available at next_in */
+  FAR uint8_t       *next_out;   /* Next output byte */
+  size_t             avail_out;  /* Free space at next_out */
+
+  /* Private data */
+
+  FAR lzf_hslot_t   *htab;       /* Hash table, reused for every block */
+  FAR const uint8_t *frame;      /* Frame bytes not yet output */
+  uint16_t           framelen;   /* Number of bytes at frame */
+  uint16_t           inlen;      /* Bytes collected in the current block */
+  uint8_t            inbuf[LZF_TYPE0_HDR_SIZE + LZF_BLOCKSIZE];
+  uint8_t            outbuf[LZF_TYPE1_HDR_SIZE + LZF_BLOCKSIZE];
+};
+
+/* Streaming decompression state.  Usage is the same as for struct
+ * lzf_cstream_s.  Input may be split at any byte.
+ */
+
+struct lzf_dstream_s
+{
+  FAR const uint8_t *next_in;    /* Next input byte */
+  size_t             avail_in;   /* Number of bytes available at next_in */
+  FAR uint8_t       *next_out;   /* Next output byte */
+  size_t             avail_out;  /* Free space at next_out */
+
+  /* Private data */
+
+  FAR const uint8_t *out;        /* Decompressed bytes not yet output */
+  uint16_t           outlen;     /* Number of bytes at out */
+  uint16_t           remain;     /* Frame data bytes still to be received */
+  uint16_t           clen;       /* Compressed length of the current frame */
+  uint16_t           ulen;       /* Uncompressed length of the current frame */
+  uint8_t            state;      /* Parser state */
+  uint8_t            hdrlen;     /* Header bytes received */
+  uint8_t            hdr[LZF_MAX_HDR_SIZE];
+  uint8_t            inbuf[LZF_BLOCKSIZE];
+  uint8_t            outbuf[LZF_BLOCKSIZE];
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -150,4 +222,63 @@ unsigned int lzf_decompress(FAR const void *const in_data,
                             unsigned int in_len, FAR void *out_data,
                             unsigned int out_len);
 
+/****************************************************************************
+ * Name: lzf_cstream_init
+ *
+ * Description:
+ *   Initialize a streaming compressor.  htab is used for every block of
+ *   the stream and must stay valid for the life of the stream; it needs no
+ *   initialization.
+ *
+ ****************************************************************************/
+
+void lzf_cstream_init(FAR struct lzf_cstream_s *strm, lzf_state_t htab);
+
+/****************************************************************************
+ * Name: lzf_cstream
+ *
+ * Description:
+ *   Consume as much of next_in/avail_in as possible and write compressed
+ *   frames to next_out/avail_out.  A block is compressed when it is full
+ *   or, if flush is true, when the input is used up, so that all input
+ *   given so far is output.
+ *
+ * Returned Value:
+ *   Zero when all input has been consumed and every completed frame has
+ *   been output.  Otherwise the number of frame bytes that are waiting for
+ *   output space; call again with more output space.
+ *
+ ****************************************************************************/
+
+size_t lzf_cstream(FAR struct lzf_cstream_s *strm, bool flush);
+
+/****************************************************************************
+ * Name: lzf_dstream_init
+ *
+ * Description:
+ *   Initialize a streaming decompressor.
+ *
+ ****************************************************************************/
+
+void lzf_dstream_init(FAR struct lzf_dstream_s *strm);
+
+/****************************************************************************
+ * Name: lzf_dstream
+ *
+ * Description:
+ *   Consume as much of next_in/avail_in as possible and write the
+ *   decompressed data to next_out/avail_out.
+ *
+ * Returned Value:
+ *   Zero when all input has been consumed and all data decoded so far has
+ *   been output.  A positive value when output space ran out first; call
+ *   again with more output space.  A negated errno value on failure:
+ *
+ *   -EINVAL - The input is not a sequence of ZV frames or is corrupted
+ *   -E2BIG  - A compressed frame is larger than LZF_BLOCKSIZE
+ *
+ ****************************************************************************/
+
+ssize_t lzf_dstream(FAR struct lzf_dstream_s *strm);
+
 #endif /* __INCLUDE_LZF_H */
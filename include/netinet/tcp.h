@@ -69,4 +69,11 @@
 #define TCP_KEEPCNT   (__SO_PROTOCOL + 3) /* Number of keepalives before death
                                            * Argument: max retry count */
 
+/* Congestion control and segment coalescing: */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 4) /* Congestion control algorithm
+                                            * Argument: name string */
+#define TCP_CORK      (__SO_PROTOCOL + 5) /* Send only full-sized segments
+                                           * Argument: 0 or 1 */
+
 #endif /* __INCLUDE_NETINET_TCP_H */
@@ -47,6 +47,37 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Packet socket options (SOL_PACKET, see include/sys/socket.h):
+ *
+ *   PACKET_RX_RING - Set up an mmap-able receive ring.
+ *     Argument: struct tpacket_req
+ */
+
+#define PACKET_RX_RING     (__SO_PROTOCOL + 0)
+
+/* Values of tpacket_hdr::tp_status.  A frame belongs to the network stack
+ * while its status is TP_STATUS_KERNEL.  The stack fills the frame and then
+ * sets TP_STATUS_USER; the application must set the status back to
+ * TP_STATUS_KERNEL when it is finished with the frame.
+ */
+
+#define TP_STATUS_KERNEL   0
+#define TP_STATUS_USER     (1 << 0)
+#define TP_STATUS_COPY     (1 << 1)  /* Frame was truncated to tp_frame_size */
+#define TP_STATUS_LOSING   (1 << 2)  /* Frames were dropped since the last one */
+
+/* Each ring frame starts with a struct tpacket_hdr.  The frame data starts
+ * at offset tp_mac from the start of the frame header.
+ */
+
+#define TPACKET_ALIGNMENT  16
+#define TPACKET_ALIGN(x)   (((x) + TPACKET_ALIGNMENT - 1) & ~(TPACKET_ALIGNMENT - 1))
+#define TPACKET_HDRLEN     TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -58,4 +89,32 @@ struct sockaddr_ll
   int16_t  sll_ifindex;
 };
 
+/* Argument of the PACKET_RX_RING socket option.  The ring is tp_block_nr
+ * contiguous blocks of tp_block_size bytes, each holding
+ * (tp_block_size / tp_frame_size) frames.  The ring is released when the
+ * socket is closed or when the option is set again with tp_block_nr == 0.
+ * The ring is located with mmap() on the socket descriptor.
+ */
+
+struct tpacket_req
+{
+  unsigned int tp_block_size;  /* Minimal size of contiguous block */
+  unsigned int tp_block_nr;    /* Number of blocks */
+  unsigned int tp_frame_size;  /* Size of frame */
+  unsigned int tp_frame_nr;    /* Total number of frames */
+};
+
+/* Header at the start of each ring frame */
+
+struct tpacket_hdr
+{
+  unsigned long  tp_status;    /* TP_STATUS_* flags */
+  unsigned int   tp_len;       /* Length of the frame on the wire */
+  unsigned int   tp_snaplen;   /* Length of the frame data in the ring */
+  unsigned short tp_mac;       /* Offset of the frame data */
+  unsigned short tp_net;       /* Offset of the network header */
+  unsigned int   tp_sec;       /* Time stamp of reception */
+  unsigned int   tp_usec;
+};
+
 #endif  /* __INCLUDE_NETPACKET_PACKET_H */
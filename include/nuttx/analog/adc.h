@@ -78,6 +78,10 @@
 #  define CONFIG_ADC_NPOLLWAITERS 2
 #endif
 
+#if defined(CONFIG_ADC_STREAM) && !defined(CONFIG_ADC_STREAM_BUFSIZE)
+#  define CONFIG_ADC_STREAM_BUFSIZE 8192
+#endif
+
 #define ADC_RESET(dev)         ((dev)->ad_ops->ao_reset((dev)))
 #define ADC_SETUP(dev)         ((dev)->ad_ops->ao_setup((dev)))
 #define ADC_SHUTDOWN(dev)      ((dev)->ad_ops->ao_shutdown((dev)))
@@ -105,6 +109,28 @@ struct adc_callback_s
    */
 
   CODE int (*au_receive)(FAR struct adc_dev_s *dev, uint8_t ch, int32_t data);
+
+#ifdef CONFIG_ADC_STREAM
+  /* This method is called from the lower half when a block of samples is
+   * complete in continuous sampling mode (ANIOC_STREAM), typically from the
+   * DMA half-transfer and transfer-complete interrupts of a double buffer.
+   * The data is copied, so the lower half may immediately reuse the block.
+   * The layout of the samples is defined by the lower half.
+   *
+   * Input Parameters:
+   *   dev    - The ADC device structure that was previously registered by
+   *            adc_register()
+   *   data   - The completed block of raw sample data
+   *   nbytes - The size of the block in bytes
+   *
+   * Returned Value:
+   *   Zero on success; -ENOSPC if the stream buffer is full and the block
+   *   was dropped (and counted as an overrun).
+   */
+
+  CODE int (*au_receive_block)(FAR struct adc_dev_s *dev,
+                               FAR const void *data, size_t nbytes);
+#endif
 };
 
 /* This describes on ADC message */
@@ -126,6 +152,22 @@ struct adc_fifo_s
   struct adc_msg_s af_buffer[CONFIG_ADC_FIFOSIZE];
 };
 
+#ifdef CONFIG_ADC_STREAM
+/* This describes the ring of raw sample data used in continuous sampling
+ * mode.
+ */
+
+struct adc_stream_s
+{
+  sem_t        as_exclsem;               /* Serializes stream readers */
+  FAR uint8_t *as_buffer;                /* CONFIG_ADC_STREAM_BUFSIZE bytes */
+  size_t       as_head;                  /* Index of the oldest byte */
+  size_t       as_count;                 /* Number of bytes in the ring */
+  uint32_t     as_overruns;              /* Bytes dropped since last query */
+  bool         as_enabled;               /* Continuous sampling is active */
+};
+#endif
+
 /* This structure defines all of the operations providd by the architecture specific
  * logic.  All fields must be provided with non-NULL function pointers by the
  * caller of can_register().
@@ -189,6 +231,9 @@ struct adc_dev_s
   sem_t                       ad_closesem;   /* Locks out new opens while close is in progress */
   sem_t                       ad_recvsem;    /* Used to wakeup user waiting for space in ad_recv.buffer */
   struct adc_fifo_s           ad_recv;       /* Describes receive FIFO */
+#ifdef CONFIG_ADC_STREAM
+  struct adc_stream_s         ad_stream;     /* Continuous sampling buffer */
+#endif
 
   /* The following is a list of poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -64,9 +64,19 @@
 #define ANIOC_WDOG_LOWER  _ANIOC(0x0003)  /* Set lower threshold for watchdog
                                            * IN: Threshold value
                                            * OUT: None */
+#define ANIOC_STREAM      _ANIOC(0x0004)  /* Start (non-zero) or stop (zero)
+                                           * continuous sampling into the
+                                           * ADC stream buffer
+                                           * IN: int
+                                           * OUT: None */
+#define ANIOC_OVERRUNS    _ANIOC(0x0005)  /* Get and clear the number of
+                                           * stream bytes dropped because
+                                           * the buffer was full
+                                           * IN: None
+                                           * OUT: FAR uint32_t * */
 
 #define AN_FIRST          0x0001          /* First common command */
-#define AN_NCMDS          3               /* Number of common commands */
+#define AN_NCMDS          5               /* Number of common commands */
 
 /* User defined ioctl commands are also supported. These will be forwarded
  * by the upper-half QE driver to the lower-half QE driver via the ioctl()
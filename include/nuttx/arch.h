@@ -117,6 +117,7 @@
 
 typedef CODE void (*sig_deliver_t)(FAR struct tcb_s *tcb);
 typedef CODE void (*phy_enable_t)(bool enable);
+typedef CODE void (*cpu_call_t)(FAR void *arg);
 
 /****************************************************************************
  * Public Data
@@ -1962,6 +1963,38 @@ int up_cpu_paused(int cpu);
 int up_cpu_resume(int cpu);
 #endif
 
+/****************************************************************************
+ * Name: up_cpu_call
+ *
+ * Description:
+ *   Queue a function call to be executed on another CPU.  The function is
+ *   called from the inter-CPU interrupt handler of the target CPU, that is,
+ *   in interrupt context on that CPU.  Unlike up_cpu_pause(), the target
+ *   CPU is not stopped and this CPU does not wait for the call to execute.
+ *   Calls queued by one CPU for another are executed in order.
+ *
+ *   This is intended for short operations that must be performed on a
+ *   particular CPU such as a reschedule request or cache maintenance.
+ *   nxsched and other common logic must still use up_cpu_pause() when the
+ *   g_assignedtasks[cpu] list of another CPU is modified.
+ *
+ * Input Parameters:
+ *   cpu  - The index of the CPU that will execute the function.  This must
+ *          not be the current CPU.
+ *   func - The function to be called
+ *   arg  - The argument passed to the function
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBUSY if the mailbox of the target CPU is full.
+ *   The call is never blocked, even if interrupts are disabled on the
+ *   target CPU.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && defined(CONFIG_ARCH_HAVE_CPU_CALL)
+int up_cpu_call(int cpu, cpu_call_t func, FAR void *arg);
+#endif
+
 /****************************************************************************
  * Name: up_romgetc
  *
@@ -2424,6 +2457,64 @@ uint32_t up_critmon_gettime(void);
 void up_critmon_convert(uint32_t elapsed, FAR struct timespec *ts);
 #endif
 
+/********************************************************************************
+ * Name: up_note_gettime
+ *
+ * Description:
+ *   Return a high resolution time stamp for a scheduler instrumentation note,
+ *   such as a CPU cycle counter.  The value must be monotonically increasing
+ *   (modulo 32-bit wraparound) on each CPU, but need not be synchronized
+ *   between CPUs.
+ *
+ *   This function is called with interrupts disabled from the scheduler note
+ *   hooks and must not itself generate notes (e.g., by taking spinlocks).
+ *
+ ********************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_ARCH_TIME
+uint32_t up_note_gettime(void);
+#endif
+
+/********************************************************************************
+ * Name: up_perf_gettime, up_perf_getfreq
+ *
+ * Description:
+ *   up_perf_gettime() returns the value of a free running, high resolution
+ *   counter such as a CPU cycle counter.  The counter wraps at 32 bits.  On
+ *   multi-CPU systems each CPU may have its own counter and the counters
+ *   need not be synchronized, but they must all run at the frequency, in
+ *   Hz, returned by up_perf_getfreq().
+ *
+ ********************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+uint32_t up_perf_gettime(void);
+uint32_t up_perf_getfreq(void);
+#endif
+
+/********************************************************************************
+ * Name: up_irq_asserttime
+ *
+ * Description:
+ *   Return the up_critmon_gettime() time at which the hardware asserted the
+ *   interrupt request that is now being dispatched.  This is called from
+ *   irq_dispatch() before the interrupt handler runs and is used to measure
+ *   the interrupt latency.
+ *
+ * Input Parameters:
+ *   irq   - The IRQ number being dispatched
+ *   stamp - The location to return the assertion time
+ *
+ * Returned Value:
+ *   true if the assertion time of this interrupt source is known; false if
+ *   it is not and no latency sample should be taken.
+ *
+ ********************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+bool up_irq_asserttime(int irq, FAR uint32_t *stamp);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -104,6 +104,12 @@
  * AUDIOIOC_STOP - Stop Audio streaming
  *
  *   ioctl argument:  None
+ *
+ * AUDIOIOC_GETLATENCY - Get the output latency
+ *
+ *   ioctl argument:  Pointer to a uint32_t to receive the playback time (in
+ *                    microseconds) of the audio data that has been enqueued
+ *                    to the device but not yet returned.
  */
 
 #define AUDIOIOC_GETCAPS            _AUDIOIOC(1)
@@ -123,6 +129,7 @@
 #define AUDIOIOC_UNREGISTERMQ       _AUDIOIOC(15)
 #define AUDIOIOC_HWRESET            _AUDIOIOC(16)
 #define AUDIOIOC_SETBUFFERINFO      _AUDIOIOC(17)
+#define AUDIOIOC_GETLATENCY         _AUDIOIOC(18)
 
 /* Audio Device Types *******************************************************/
 /* The NuttX audio interface support different types of audio devices for
@@ -239,6 +239,48 @@
 #define I2S_SEND(d,b,c,a,t) \
   ((d)->ops->i2s_send ? (d)->ops->i2s_send(d,b,c,a,t) : -ENOTTY)
 
+/****************************************************************************
+ * Name: I2S_RXRING and I2S_TXRING
+ *
+ * Description:
+ *   Start (or stop) continuous, circular DMA reception or transmission
+ *   using a ring buffer provided by the caller.  The DMA transfers the
+ *   ring buffer repeatedly without software intervention.  Each time that
+ *   one half of the ring buffer has been transferred, the callback is
+ *   invoked with a pointer to that half:  For TX, that half may now be
+ *   refilled with the next audio data; for RX, that half contains newly
+ *   received audio data.  The caller must finish with that half before the
+ *   DMA completes the other half.
+ *
+ *   The callback is performed from the DMA interrupt handler so that the
+ *   caller has the maximum time to service the buffer.  It must not block.
+ *
+ *   While a ring transfer is active, I2S_RECEIVE (I2S_SEND) may not be
+ *   used in the same direction.
+ *
+ * Input Parameters:
+ *   dev      - Device-specific state data
+ *   buffer   - The ring buffer.  It must be suitably aligned for DMA and
+ *              the sample size.  NULL stops a ring transfer in progress.
+ *   nbytes   - The size of the ring buffer in bytes.  It must be
+ *              divisible into two halves of whole samples.
+ *   callback - The function to call as each half of the ring buffer is
+ *              completed.
+ *   arg      - An opaque argument that will be provided to the callback.
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.  -ENOTTY is returned
+ *   if the lower half does not support ring buffer mode.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2S_RING
+#  define I2S_RXRING(d,b,n,c,a) \
+  ((d)->ops->i2s_rxring ? (d)->ops->i2s_rxring(d,b,n,c,a) : -ENOTTY)
+#  define I2S_TXRING(d,b,n,c,a) \
+  ((d)->ops->i2s_txring ? (d)->ops->i2s_txring(d,b,n,c,a) : -ENOTTY)
+#endif
+
 /****************************************************************************
  * Name: I2S_IOCTL
  *
@@ -267,6 +309,19 @@ struct i2s_dev_s;
 typedef CODE void (*i2s_callback_t)(FAR struct i2s_dev_s *dev,
                    FAR struct ap_buffer_s *apb, FAR void *arg, int result);
 
+#ifdef CONFIG_I2S_RING
+/* Ring buffer half complete callback.  'half' and 'nbytes' describe the
+ * half of the ring buffer that was just completed; 'ts' is the time (from
+ * clock_systimespec()) when the DMA completed it.  A negative 'result'
+ * reports a DMA failure; the ring transfer is then stopped.
+ */
+
+struct timespec;
+typedef CODE void (*i2s_ringcallback_t)(FAR struct i2s_dev_s *dev,
+                   FAR uint8_t *half, size_t nbytes,
+                   FAR const struct timespec *ts, FAR void *arg, int result);
+#endif
+
 /* The I2S vtable */
 
 struct i2s_ops_s
@@ -294,6 +349,16 @@ struct i2s_ops_s
   CODE int      (*i2s_ioctl)(FAR struct i2s_dev_s *dev,
                              int cmd, unsigned long arg);
 
+#ifdef CONFIG_I2S_RING
+  /* Circular DMA (ring buffer) methods */
+
+  CODE int      (*i2s_rxring)(FAR struct i2s_dev_s *dev,
+                  FAR uint8_t *buffer, size_t nbytes,
+                  i2s_ringcallback_t callback, FAR void *arg);
+  CODE int      (*i2s_txring)(FAR struct i2s_dev_s *dev,
+                  FAR uint8_t *buffer, size_t nbytes,
+                  i2s_ringcallback_t callback, FAR void *arg);
+#endif
 };
 
 /* I2S private data.  This structure only defines the initial fields of the
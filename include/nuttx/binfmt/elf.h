@@ -72,6 +72,10 @@
 #  define CONFIG_ELF_BUFFERINCR 32
 #endif
 
+#ifndef CONFIG_ELF_HDRCACHE
+#  define CONFIG_ELF_HDRCACHE 0
+#endif
+
 /* Allocation array size and indices */
 
 #define LIBELF_ELF_ALLOC     0
@@ -110,6 +114,14 @@ struct elf_loadinfo_s
   size_t            textsize;    /* Size of the ELF .text memory allocation */
   size_t            datasize;    /* Size of the ELF .bss/.data memory allocation */
   off_t             filelen;     /* Length of the entire ELF file */
+#if CONFIG_ELF_HDRCACHE > 0
+  FAR const char    *filename;   /* Path of the ELF file (header cache key) */
+  time_t            filetime;    /* Modification time of the ELF file */
+#endif
+#ifdef CONFIG_ELF_XIP
+  uintptr_t         xipbase;     /* Address of the file if executed in place */
+  uintptr_t         xipentry;    /* Entry point address if executed in place */
+#endif
   Elf32_Ehdr        ehdr;        /* Buffered ELF file header */
   FAR Elf32_Shdr    *shdr;       /* Buffered ELF section headers */
   uint8_t           *iobuffer;   /* File I/O buffer */
@@ -47,6 +47,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <semaphore.h>
+#ifdef CONFIG_CAN_TIMESTAMP
+#  include <sys/time.h>
+#endif
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
@@ -407,6 +410,11 @@
  *               Bit 7:      Unused
  *   Bytes 5-12: CAN data    Size determined by DLC
  *
+ * If CONFIG_CAN_TIMESTAMP is selected, the header is followed by a struct timeval
+ * (ch_ts) with the time of reception.  It is taken from the CAN hardware if the
+ * lower half sets cd_hwtstamp, otherwise it is sampled by the upper half in
+ * can_receive() (system time since boot).  It is ignored on transmission.
+ *
  * NOTE: The error indication if valid only on message reports received from the
  * CAN driver; it is ignored on transmission.  When the error bit is set, the
  * message ID is an encoded set of error indications (see CAN_ERROR_* definitions).
@@ -430,6 +438,9 @@ begin_packed_struct struct can_hdr_s
 #endif
   uint8_t      ch_extid  : 1; /* Extended ID indication */
   uint8_t      ch_unused : 1; /* Unused */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* Time of reception */
+#endif
 } end_packed_struct;
 #else
 begin_packed_struct struct can_hdr_s
@@ -441,6 +452,9 @@ begin_packed_struct struct can_hdr_s
   uint8_t      ch_error  : 1; /* 1=ch_id is an error report */
 #endif
   uint8_t      ch_unused : 2; /* Unused */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* Time of reception */
+#endif
 } end_packed_struct;
 #endif
 
@@ -558,6 +572,10 @@ struct can_dev_s
   volatile uint8_t     cd_nrxwaiters;    /* Number of threads waiting to receive a message */
 #ifdef CONFIG_CAN_ERRORS
   uint8_t              cd_error;         /* Flags to indicate internal device errors */
+#endif
+#ifdef CONFIG_CAN_TIMESTAMP
+  bool                 cd_hwtstamp;      /* Set by the lower half if it provides
+                                          * ch_ts of received messages */
 #endif
   sem_t                cd_closesem;      /* Locks out new opens while close is in progress */
 #ifndef CONFIG_DISABLE_POLL
@@ -565,6 +583,10 @@ struct can_dev_s
 #endif
   struct can_txfifo_s  cd_xmit;          /* Describes transmit FIFO */
   struct can_rxfifo_s  cd_recv;          /* Describes receive FIFO */
+#ifdef CONFIG_CAN_RXPRIO
+  struct can_rxfifo_s  cd_recvhi;        /* Receive FIFO for messages matching
+                                          * CAN_MSGPRIO_HIGH filters */
+#endif
 #ifdef CONFIG_CAN_TXREADY
   struct work_s        cd_work;          /* Use to manage can_txready() work */
 #endif
@@ -688,6 +710,32 @@ int can_register(FAR const char *path, FAR struct can_dev_s *dev);
 int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
                 FAR uint8_t *data);
 
+/************************************************************************************
+ * Name: can_receive_prio
+ *
+ * Description:
+ *   Same as can_receive(), for CAN hardware that routes messages into separate
+ *   receive FIFOs according to the priority of the acceptance filter that
+ *   matched (see sf_prio/xf_prio).  CAN_MSGPRIO_HIGH messages are queued
+ *   separately and returned by read() before any normal message, so that they
+ *   are not stuck behind a full queue of bulk traffic.
+ *
+ * Input Parameters:
+ *   dev  - The specific CAN device
+ *   hdr  - The 16-bit CAN header
+ *   data - An array contain the CAN data.
+ *   prio - CAN_MSGPRIO_LOW or CAN_MSGPRIO_HIGH
+ *
+ * Returned Value:
+ *   OK on success; a negated errno on failure.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_CAN_RXPRIO
+int can_receive_prio(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
+                     FAR uint8_t *data, uint8_t prio);
+#endif
+
 /************************************************************************************
  * Name: can_txdone
  *
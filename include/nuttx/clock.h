@@ -239,6 +239,22 @@ typedef int64_t sclock_t;
 typedef int32_t sclock_t;
 #endif
 
+/* This structure is the user-space clock page used with CONFIG_CLOCK_VDSO.
+ * It resides in user memory and is written only by the kernel.  seq is
+ * odd while the kernel is updating the other fields; a reader must retry
+ * if seq is odd or if it changed while the fields were being read.
+ */
+
+#ifdef CONFIG_CLOCK_VDSO
+struct clock_vdso_s
+{
+  volatile uint32_t seq;        /* Update sequence count */
+  volatile clock_t ticks;       /* Value of the system timer */
+  volatile time_t base_sec;     /* Time-of-day base time (seconds) */
+  volatile long base_nsec;      /* Time-of-day base time (nanoseconds) */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -266,6 +282,12 @@ EXTERN volatile clock_t g_system_timer;
 #endif
 #endif
 
+/* The user-space clock page (see struct clock_vdso_s) */
+
+#if defined(CONFIG_CLOCK_VDSO) && !defined(__KERNEL__)
+EXTERN struct clock_vdso_s g_clock_vdso;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -432,6 +454,55 @@ struct oneshot_lowerhalf_s;
 void sched_oneshot_extclk(FAR struct oneshot_lowerhalf_s *lower);
 #endif
 
+/****************************************************************************
+ * Name:  timer_hires_initialize
+ *
+ * Description:
+ *   Drive POSIX timers from a oneshot timer as described in
+ *   include/nuttx/timers/oneshot.h.  The oneshot timer must support the
+ *   current() method.  Timers armed after this call have the resolution of
+ *   the oneshot timer instead of the system tick.
+ *
+ * Input Parameters:
+ *   lower - An instance of the oneshot timer interface as defined in
+ *           include/nuttx/timers/oneshot.h
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TIMER_HIRES
+struct oneshot_lowerhalf_s;
+int timer_hires_initialize(FAR struct oneshot_lowerhalf_s *lower);
+#endif
+
+/****************************************************************************
+ * Name:  nxtimer_create
+ *
+ * Description:
+ *   Create a POSIX timer for use inside the OS.  Instead of delivering a
+ *   signal, the timer calls 'callback' on each expiration.  The callback
+ *   runs in the context of the timer interrupt.  The timer is not owned by
+ *   the calling task and must be deleted with timer_delete().
+ *
+ * Input Parameters:
+ *   callback - The function to call on each expiration
+ *   arg      - The argument that accompanies the callback
+ *   timerid  - The location to return the new timer
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POSIX_TIMERS
+typedef CODE void (*nxtimer_callback_t)(FAR void *arg);
+
+int nxtimer_create(nxtimer_callback_t callback, FAR void *arg,
+                   FAR timer_t *timerid);
+#endif
+
 /****************************************************************************
  * Name:  sched_period_extclk
  *
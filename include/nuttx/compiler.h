@@ -143,6 +143,12 @@
 #  define inline_function __attribute__ ((always_inline,no_instrument_function))
 #  define noinline_function __attribute__ ((noinline))
 
+/* return_address() is the address to which the current function will
+ * return, i.e., its call site.
+ */
+
+#  define return_address() __builtin_return_address(0)
+
 /* GCC does not use storage classes to qualify addressing */
 
 #  define FAR
@@ -356,6 +362,7 @@
 
 #  define inline_function
 #  define noinline_function
+#  define return_address() ((FAR void *)0)
 
 /* The reentrant attribute informs SDCC that the function
  * must be reentrant.  In this case, SDCC will store input
@@ -489,6 +496,7 @@
 #  define naked_function
 #  define inline_function
 #  define noinline_function
+#  define return_address() ((FAR void *)0)
 
 /* REVISIT: */
 
@@ -594,6 +602,7 @@
 #  define naked_function
 #  define inline_function
 #  define noinline_function
+#  define return_address() ((FAR void *)0)
 
 #  define FAR
 #  define NEAR
@@ -643,6 +652,7 @@
 #  define naked_function
 #  define inline_function
 #  define noinline_function
+#  define return_address() ((FAR void *)0)
 
 #  define FAR
 #  define NEAR
@@ -49,6 +49,7 @@
  ****************************************************************************/
 
 #define AES128_KEY_SIZE    16
+#define AES_MAX_ROUNDS     14
 
 /****************************************************************************
  * Public Types
@@ -56,7 +57,9 @@
 
 struct aes_state_s
 {
-  uint8_t expanded_key[176];
+  uint32_t enc_key[4 * (AES_MAX_ROUNDS + 1)]; /* Encryption round keys */
+  uint32_t dec_key[4 * (AES_MAX_ROUNDS + 1)]; /* Decryption round keys */
+  int nrounds;                                /* 10, 12 or 14 */
 };
 
 /****************************************************************************
@@ -118,14 +121,13 @@ void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key);
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key, must be 16 (AES-128), 24 (AES-192) or 32
+ *         (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if len is not valid
  *
  ****************************************************************************/
 
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * include/nuttx/drivers/blkcache.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H
+#define __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* When the shared block cache is not enabled, flushing and invalidating it
+ * are no-ops so that callers do not need conditional logic for them.
+ */
+
+#ifndef CONFIG_DRVR_BLKCACHE
+#  define blkcache_flush(inode)      (0)
+#  define blkcache_invalidate(inode)
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_BLKCACHE
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+struct inode;
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:
+ *   Read blocks from a block driver through the shared block cache.  A
+ *   single block read is served from the cache if the block is present and
+ *   is added to the cache otherwise.  Multi-block reads are passed to the
+ *   driver in one transfer; any newer, dirty cached copies of the blocks
+ *   are then merged into the result.
+ *
+ * Input Parameters:
+ *   inode   - The block driver inode.  Together with the block number this
+ *             is the cache key.
+ *   buffer  - Receives nblocks * blksize bytes.
+ *   start   - The first block to read.
+ *   nblocks - The number of blocks to read.
+ *   blksize - The driver's block size.  Blocks larger than
+ *             CONFIG_DRVR_BLKCACHE_BLOCKSIZE are never cached.
+ *
+ * Returned Value:
+ *   OK if all of the blocks were read; a negated errno value otherwise.
+ *
+ ****************************************************************************/
+
+int blkcache_read(FAR struct inode *inode, FAR uint8_t *buffer,
+                  blkcnt_t start, unsigned int nblocks, uint16_t blksize);
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description:
+ *   Write blocks to a block driver through the shared block cache.  With
+ *   CONFIG_DRVR_BLKCACHE_WRITEBACK, single block writes are only stored in
+ *   the cache and reach the driver when the block is evicted or flushed.
+ *   All other writes go to the driver immediately and refresh any cached
+ *   copies.
+ *
+ * Input Parameters:
+ *   As for blkcache_read()
+ *
+ * Returned Value:
+ *   OK if all of the blocks were written (or cached); a negated errno value
+ *   otherwise.
+ *
+ ****************************************************************************/
+
+int blkcache_write(FAR struct inode *inode, FAR const uint8_t *buffer,
+                   blkcnt_t start, unsigned int nblocks, uint16_t blksize);
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   Write all dirty cached blocks of one block driver to the driver.
+ *
+ * Returned Value:
+ *   OK on success; the first write failure otherwise.  Blocks that could
+ *   not be written remain dirty.
+ *
+ ****************************************************************************/
+
+int blkcache_flush(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: blkcache_invalidate
+ *
+ * Description:
+ *   Discard all cached blocks of one block driver, including any dirty
+ *   blocks.  This must be called when the media is changed and before the
+ *   caller's last reference to the inode is released; call
+ *   blkcache_flush() first if dirty blocks are to be kept.
+ *
+ ****************************************************************************/
+
+void blkcache_invalidate(FAR struct inode *inode);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_DRVR_BLKCACHE */
+#endif /* __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H */
@@ -45,6 +45,18 @@
 #include <sys/types.h>
 #include <stdbool.h>
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Argument of the PIPEIOC_SPLICEIN and PIPEIOC_SPLICEOUT ioctl commands */
+
+struct pipe_splice_s
+{
+  int    ps_fd;              /* The file or socket descriptor */
+  size_t ps_len;             /* Maximum number of bytes to move */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
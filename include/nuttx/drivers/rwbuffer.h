@@ -44,6 +44,7 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <semaphore.h>
 #include <nuttx/wqueue.h>
 
@@ -144,6 +145,19 @@ struct rwbuffer_s
   off_t         wrexpectedblock; /* Next block expected */
 #endif
 
+  /* This is the state of the write-behind thread */
+
+#ifdef CONFIG_DRVR_WRITEBEHIND
+  sem_t         wbreqsem;        /* Posted to start a write-behind transfer */
+  sem_t         wbdonesem;       /* Available when write-behind is idle */
+  pid_t         wbpid;           /* Write-behind thread ID */
+  volatile bool wbstop;          /* Request write-behind thread exit */
+  int           wbresult;        /* First write-behind error (sticky) */
+  uint8_t      *wbbuffer;        /* Buffer being written behind */
+  volatile uint16_t wbnblocks;   /* Number of blocks being written behind */
+  off_t         wbblockstart;    /* First block being written behind */
+#endif
+
   /* This is the state of the read-ahead buffering */
 
 #ifdef CONFIG_DRVR_READAHEAD
@@ -151,6 +165,17 @@ struct rwbuffer_s
   uint8_t      *rhbuffer;        /* Allocated read-ahead buffer */
   uint16_t      rhnblocks;       /* Number of blocks in read-ahead buffer */
   off_t         rhblockstart;    /* First block in read-ahead buffer */
+#endif
+
+  /* This is the state of the adaptive read-ahead */
+
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+  uint16_t      rhwindow;        /* Current read-ahead window in blocks */
+  off_t         rhexpected;      /* Next block of a sequential stream */
+#ifdef CONFIG_SCHED_LPWORK
+  struct work_s rhwork;          /* Asynchronous prefetch of the next window */
+  off_t         rhprefetch;      /* Start of pending prefetch (-1: none) */
+#endif
 #endif
 };
 
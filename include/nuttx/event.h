@@ -0,0 +1,221 @@
+/****************************************************************************
+ * include/nuttx/event.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_EVENT_H
+#define __INCLUDE_NUTTX_EVENT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+
+#ifdef CONFIG_SCHED_EVENTS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Flags that may be passed to nxevent_wait() and nxevent_tickwait() */
+
+#define NXEVENT_WAIT_ANY         0         /* Wake when any event is set */
+#define NXEVENT_WAIT_ALL         (1 << 0)  /* Wake when all events are set */
+#define NXEVENT_WAIT_NOCLEAR     (1 << 1)  /* Leave the events set on wake */
+
+/* Initializer for statically allocated event groups */
+
+#define NXEVENT_INITIALIZER(e)   { (e), { NULL, NULL } }
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+typedef uint32_t nxevent_mask_t;
+
+/* An event group.  Each bit of the 'events' mask is a separate event flag.
+ * Tasks wait for some combination of flags; interrupt handlers or other
+ * tasks set flags with nxevent_post().  Only the waiters whose condition
+ * is satisfied by a post are awakened.
+ */
+
+struct nxevent_s
+{
+  volatile nxevent_mask_t events;  /* Currently set events */
+  dq_queue_t waitlist;             /* List of struct nxevent_wait_s */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nxevent_init
+ *
+ * Description:
+ *   Initialize an event group.
+ *
+ * Input Parameters:
+ *   event  - The event group to be initialized
+ *   events - The initial set of events
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxevent_init(FAR struct nxevent_s *event, nxevent_mask_t events);
+
+/****************************************************************************
+ * Name: nxevent_destroy
+ *
+ * Description:
+ *   Destroy an event group.  Any tasks still waiting on the event group are
+ *   awakened with -ECANCELED.
+ *
+ * Input Parameters:
+ *   event - The event group to be destroyed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxevent_destroy(FAR struct nxevent_s *event);
+
+/****************************************************************************
+ * Name: nxevent_post
+ *
+ * Description:
+ *   Set events in an event group and wake up every waiter whose condition
+ *   is now satisfied.  Unless a waiter specified NXEVENT_WAIT_NOCLEAR, the
+ *   events that satisfied it are cleared after all waiters are examined.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to be set
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void nxevent_post(FAR struct nxevent_s *event, nxevent_mask_t events);
+
+/****************************************************************************
+ * Name: nxevent_clear
+ *
+ * Description:
+ *   Clear events in an event group.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to be cleared
+ *
+ * Returned Value:
+ *   The set of events before they were cleared.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+nxevent_mask_t nxevent_clear(FAR struct nxevent_s *event,
+                             nxevent_mask_t events);
+
+/****************************************************************************
+ * Name: nxevent_wait
+ *
+ * Description:
+ *   Wait until any (or, with NXEVENT_WAIT_ALL, all) of the requested events
+ *   are set.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to wait for
+ *   eflags - NXEVENT_WAIT_* flags
+ *   result - Location to return the requested events that were set when
+ *            the wait was satisfied.  May be NULL.
+ *
+ * Returned Value:
+ *   This is an internal OS interface and should not be used by applications.
+ *   It follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned on success.  A negated errno value is returned on failure:
+ *   -EINTR if the wait was interrupted by a signal or -ECANCELED if the
+ *   event group was destroyed.
+ *
+ ****************************************************************************/
+
+int nxevent_wait(FAR struct nxevent_s *event, nxevent_mask_t events,
+                 uint8_t eflags, FAR nxevent_mask_t *result);
+
+/****************************************************************************
+ * Name: nxevent_tickwait
+ *
+ * Description:
+ *   Like nxevent_wait() but give up after 'delay' system clock ticks.  If
+ *   'delay' is zero, the events are only polled.
+ *
+ * Returned Value:
+ *   As for nxevent_wait().  In addition, -EAGAIN is returned if 'delay' is
+ *   zero and the events are not set and -ETIMEDOUT is returned if the
+ *   delay expires.
+ *
+ ****************************************************************************/
+
+int nxevent_tickwait(FAR struct nxevent_s *event, nxevent_mask_t events,
+                     uint8_t eflags, uint32_t delay,
+                     FAR nxevent_mask_t *result);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_EVENTS */
+#endif /* __INCLUDE_NUTTX_EVENT_H */
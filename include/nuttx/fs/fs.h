@@ -1133,6 +1133,25 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes);
 
 ssize_t nx_write(int fd, FAR const void *buf, size_t nbytes);
 
+/****************************************************************************
+ * Name: nx_readv and nx_writev
+ *
+ * Description:
+ *  nx_readv() and nx_writev() transfer data between the file or socket
+ *  referenced by fd and the 'iovcnt' buffers of 'iov' in a single call.
+ *  They are functionally equivalent to readv() and writev() except that
+ *  they do not modify the errno variable and are not cancellation points.
+ *
+ * Returned Value:
+ *  On success, the number of bytes transferred is returned.  On any
+ *  failure, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+struct iovec;
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt);
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt);
+
 /****************************************************************************
  * Name: file_pread
  *
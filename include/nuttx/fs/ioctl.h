@@ -167,6 +167,11 @@
                                            * OUT: Instance number is returned on
                                            *      success.
                                            */
+#define FIOC_TRUNCATE   _FIOC(0x000b)     /* IN:  The new length of the file
+                                           *      (for character drivers that
+                                           *      support ftruncate())
+                                           * OUT: None
+                                           */
 
 /* NuttX file system ioctl definitions **************************************/
 
@@ -375,6 +380,25 @@
                                              *       (default)
                                              *     1=fre when empty
                                              * OUT: None */
+#define PIPEIOC_SPSC      _PIPEIOC(0x0002)  /* Lock-free single reader/writer
+                                             * mode (CONFIG_DEV_PIPE_SPSC)
+                                             * IN: unsigned long integer
+                                             *     0=off (default), 1=on.
+                                             *     Reverts to off on the
+                                             *     last close.
+                                             * OUT: None */
+#define PIPEIOC_SPLICEIN  _PIPEIOC(0x0003)  /* Move data from another
+                                             * descriptor into the pipe
+                                             * (CONFIG_DEV_PIPE_SPLICE)
+                                             * IN: Pointer to struct
+                                             *     pipe_splice_s
+                                             * OUT: Bytes moved (returned) */
+#define PIPEIOC_SPLICEOUT _PIPEIOC(0x0004)  /* Move data from the pipe to
+                                             * another descriptor
+                                             * (CONFIG_DEV_PIPE_SPLICE)
+                                             * IN: Pointer to struct
+                                             *     pipe_splice_s
+                                             * OUT: Bytes moved (returned) */
 
 /* RTC driver ioctl definitions *********************************************/
 /* (see nuttx/include/rtc.h */
@@ -133,6 +133,44 @@ struct procfs_dir_priv_s
   FAR const struct procfs_entry_s *procfsentry; /* Pointer to procfs handler entry */
 };
 
+/* Binary task statistics.  A read of /proc/taskstats from offset zero takes
+ * a snapshot of all tasks.  The snapshot is one struct procfs_taskstats_s
+ * header followed by ts_ntasks instances of struct procfs_taskstat_s.  The
+ * first entry is at offset ts_hdrsize and each entry is ts_entsize bytes
+ * long so that fields may be appended in future versions.
+ */
+
+#define PROCFS_TASKSTATS_VERSION 1
+
+struct procfs_taskstats_s
+{
+  uint16_t ts_version;     /* PROCFS_TASKSTATS_VERSION */
+  uint16_t ts_ntasks;      /* Number of task entries that follow */
+  uint16_t ts_hdrsize;     /* Offset to the first task entry */
+  uint16_t ts_entsize;     /* Size of one task entry */
+  uint32_t ts_systime;     /* System timer (ticks) when sampled */
+  uint32_t ts_cputotal;    /* Total CPU load ticks (CONFIG_SCHED_CPULOAD) */
+  uint32_t ts_heapsize;    /* Total size of the user heap */
+  uint32_t ts_heapfree;    /* Free bytes in the user heap */
+};
+
+struct procfs_taskstat_s
+{
+  int16_t  tt_pid;         /* Task/thread ID */
+  uint8_t  tt_state;       /* Task state (enum tstate_e) */
+  uint8_t  tt_priority;    /* Current priority */
+  uint16_t tt_flags;       /* TCB flags (TCB_FLAG_*) */
+  uint16_t tt_pad;
+  uint32_t tt_cpuactive;   /* CPU load ticks while active, of ts_cputotal */
+  uint32_t tt_stacksize;   /* Size of the stack */
+  uint32_t tt_stackused;   /* Stack high water mark */
+  uint32_t tt_heapused;    /* Heap bytes in use (CONFIG_MM_HEAPSTAT) */
+  uint32_t tt_heappeak;    /* Peak heap bytes in use (CONFIG_MM_HEAPSTAT) */
+#if CONFIG_TASK_NAME_SIZE > 0
+  char     tt_name[CONFIG_TASK_NAME_SIZE + 1]; /* Task name */
+#endif
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
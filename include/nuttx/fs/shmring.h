@@ -0,0 +1,279 @@
+/****************************************************************************
+ * include/nuttx/fs/shmring.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_SHMRING_H
+#define __INCLUDE_NUTTX_FS_SHMRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Single-producer, single-consumer byte ring for use inside a shared memory
+ * object (see shm_open() and memfd_create()).  The ring header lives at the
+ * start of the mapping so that the producer and consumer need share nothing
+ * but the address returned by mmap().
+ *
+ * The reserve/commit and peek/release pairs give direct access to the ring
+ * storage so that a producer can build a frame in place and the consumer
+ * can process it in place;  shmring_write() and shmring_read() are copying
+ * conveniences built on them.
+ *
+ * The head is only written by the producer and the tail only by the
+ * consumer.  Both are free running and the capacity is a power of two.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct shmring_s
+{
+  volatile uint32_t head;   /* Total bytes committed by the producer */
+  volatile uint32_t tail;   /* Total bytes released by the consumer */
+  uint32_t size;            /* Capacity of data[] (a power of two) */
+  uint32_t reserved;
+  uint8_t data[1];          /* Start of the ring storage */
+};
+
+#define SIZEOF_SHMRING_S(n) (sizeof(struct shmring_s) + (n) - 1)
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_initialize
+ *
+ * Description:
+ *   Format a ring in the 'length' bytes at 'base' (normally the start of a
+ *   mapped shared memory object).  Only one side should do this.
+ *
+ * Returned Value:
+ *   The ring or NULL if 'length' is too small for any storage.
+ *
+ ****************************************************************************/
+
+static inline FAR struct shmring_s *shmring_initialize(FAR void *base,
+                                                       size_t length)
+{
+  FAR struct shmring_s *ring = (FAR struct shmring_s *)base;
+  uint32_t size;
+
+  if (length < SIZEOF_SHMRING_S(1))
+    {
+      return NULL;
+    }
+
+  length -= SIZEOF_SHMRING_S(0);
+  for (size = 1; (size << 1) != 0 && (size << 1) <= length; size <<= 1);
+
+  ring->head     = 0;
+  ring->tail     = 0;
+  ring->size     = size;
+  ring->reserved = 0;
+  return ring;
+}
+
+/****************************************************************************
+ * Name: shmring_used / shmring_space
+ *
+ * Description:
+ *   Return the number of bytes available to the consumer / producer.
+ *
+ ****************************************************************************/
+
+static inline size_t shmring_used(FAR struct shmring_s *ring)
+{
+  return ring->head - ring->tail;
+}
+
+static inline size_t shmring_space(FAR struct shmring_s *ring)
+{
+  return ring->size - (ring->head - ring->tail);
+}
+
+/****************************************************************************
+ * Name: shmring_reserve
+ *
+ * Description:
+ *   Return in 'ptr' the contiguous free space at the head of the ring and
+ *   return its length.  The producer fills (part of) it and then passes the
+ *   number of bytes written to shmring_commit().
+ *
+ ****************************************************************************/
+
+static inline size_t shmring_reserve(FAR struct shmring_s *ring,
+                                     FAR void **ptr)
+{
+  uint32_t head = ring->head;
+  uint32_t index = head & (ring->size - 1);
+  size_t space = ring->size - (head - ring->tail);
+
+  if (space > ring->size - index)
+    {
+      space = ring->size - index;
+    }
+
+  *ptr = &ring->data[index];
+  return space;
+}
+
+static inline void shmring_commit(FAR struct shmring_s *ring, size_t nbytes)
+{
+  /* The data must be visible before the new head */
+
+  SP_DMB();
+  ring->head += nbytes;
+}
+
+/****************************************************************************
+ * Name: shmring_peek
+ *
+ * Description:
+ *   Return in 'ptr' the contiguous data at the tail of the ring and return
+ *   its length.  The consumer processes (part of) it and then passes the
+ *   number of bytes consumed to shmring_release().
+ *
+ ****************************************************************************/
+
+static inline size_t shmring_peek(FAR struct shmring_s *ring, FAR void **ptr)
+{
+  uint32_t tail = ring->tail;
+  uint32_t index = tail & (ring->size - 1);
+  size_t used = ring->head - tail;
+
+  /* Do not read the data before the head that covers it */
+
+  SP_DMB();
+
+  if (used > ring->size - index)
+    {
+      used = ring->size - index;
+    }
+
+  *ptr = &ring->data[index];
+  return used;
+}
+
+static inline void shmring_release(FAR struct shmring_s *ring,
+                                   size_t nbytes)
+{
+  /* Finish with the data before handing the space back */
+
+  SP_DMB();
+  ring->tail += nbytes;
+}
+
+/****************************************************************************
+ * Name: shmring_write
+ *
+ * Description:
+ *   Copy up to 'len' bytes into the ring.  Returns the number copied which
+ *   is less than 'len' only if the ring is full.
+ *
+ ****************************************************************************/
+
+static inline size_t shmring_write(FAR struct shmring_s *ring,
+                                   FAR const void *buffer, size_t len)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)buffer;
+  FAR void *dest;
+  size_t total = 0;
+  size_t nbytes;
+
+  while (total < len && (nbytes = shmring_reserve(ring, &dest)) > 0)
+    {
+      if (nbytes > len - total)
+        {
+          nbytes = len - total;
+        }
+
+      memcpy(dest, src + total, nbytes);
+      shmring_commit(ring, nbytes);
+      total += nbytes;
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: shmring_read
+ *
+ * Description:
+ *   Copy up to 'len' bytes out of the ring.  Returns the number copied which
+ *   is less than 'len' only if the ring is empty.
+ *
+ ****************************************************************************/
+
+static inline size_t shmring_read(FAR struct shmring_s *ring,
+                                  FAR void *buffer, size_t len)
+{
+  FAR uint8_t *dest = (FAR uint8_t *)buffer;
+  FAR void *src;
+  size_t total = 0;
+  size_t nbytes;
+
+  while (total < len && (nbytes = shmring_peek(ring, &src)) > 0)
+    {
+      if (nbytes > len - total)
+        {
+          nbytes = len - total;
+        }
+
+      memcpy(dest + total, src, nbytes);
+      shmring_release(ring, nbytes);
+      total += nbytes;
+    }
+
+  return total;
+}
+
+#endif /* __INCLUDE_NUTTX_FS_SHMRING_H */
@@ -0,0 +1,183 @@
+/****************************************************************************
+ * include/nuttx/i2c/i2c_async.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_I2C_I2C_ASYNC_H
+#define __INCLUDE_NUTTX_I2C_I2C_ASYNC_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <queue.h>
+
+#include <nuttx/wqueue.h>
+#include <nuttx/i2c/i2c_master.h>
+
+#ifdef CONFIG_I2C_ASYNC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+
+/* CONFIG_I2C_ASYNC_MAXMSGS - The maximum number of messages that are
+ *   gathered from queued requests into one lower half transfer.  A request
+ *   with more messages than this is still performed, but alone.
+ */
+
+#ifndef CONFIG_I2C_ASYNC_MAXMSGS
+#  define CONFIG_I2C_ASYNC_MAXMSGS 16
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Called on the work queue when a request has completed.  req->result
+ * holds OK or a negated errno value.  The request may be re-submitted
+ * from the callback.
+ */
+
+struct i2c_request_s;
+typedef CODE void (*i2c_callback_t)(FAR struct i2c_request_s *req);
+
+/* One device transaction, i.e. the set of messages that would otherwise be
+ * passed to I2C_TRANSFER().  The request and the message array belong to
+ * the caller and must stay valid until the callback runs.  The last
+ * message must end with a STOP (I2C_M_NOSTOP not set) so that requests
+ * from different devices can be chained.
+ */
+
+struct i2c_request_s
+{
+  FAR struct i2c_request_s *flink; /* Supports a singly linked list */
+  FAR struct i2c_msg_s *msgv;      /* Array of I2C messages */
+  int msgc;                        /* Number of messages in the array */
+  i2c_callback_t callback;         /* Completion callback */
+  FAR void *arg;                   /* Caller private data */
+  int result;                      /* OK or negated errno on completion */
+};
+
+/* Transfer queue for one I2C bus */
+
+struct i2c_queue_s
+{
+  FAR struct i2c_master_s *i2c;    /* The lower half I2C driver */
+  sq_queue_t pending;              /* Submitted, not yet started */
+  sq_queue_t active;               /* Requests in the current batch */
+  struct work_s work;              /* For deferring work to the work queue */
+  bool busy;                       /* A batch is on the bus */
+  int nmsgs;                       /* Number of messages in msgv[] */
+  int result;                      /* Result of an asynchronous lower half */
+  FAR struct i2c_msg_s *batch;     /* Messages of the current batch */
+  struct i2c_msg_s msgv[CONFIG_I2C_ASYNC_MAXMSGS];
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Initialize the transfer queue for one I2C bus.
+ *
+ * Input Parameters:
+ *   queue - The queue to initialize
+ *   i2c   - An instance of the lower half I2C driver
+ *
+ ****************************************************************************/
+
+void i2c_queue_initialize(FAR struct i2c_queue_s *queue,
+                          FAR struct i2c_master_s *i2c);
+
+/****************************************************************************
+ * Name: i2c_async_submit
+ *
+ * Description:
+ *   Queue one device transaction and return immediately.  All requests
+ *   pending when the bus becomes free are performed back-to-back in a
+ *   single lower half transfer; the callback of each then runs on the
+ *   work queue.  May be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   queue - The bus transfer queue
+ *   req   - The request to queue
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int i2c_async_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+
+/****************************************************************************
+ * Name: i2c_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not yet been started.  The callback is not
+ *   called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -EBUSY if it is already on the
+ *   bus; -ENOENT if it is not queued.
+ *
+ ****************************************************************************/
+
+int i2c_async_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_I2C_ASYNC */
+#endif /* __INCLUDE_NUTTX_I2C_I2C_ASYNC_H */
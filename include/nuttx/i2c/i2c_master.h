@@ -184,6 +184,36 @@
 #  define I2C_RESET(d) ((d)->ops->reset(d))
 #endif
 
+/****************************************************************************
+ * Name: I2C_TRANSFER_ASYNC
+ *
+ * Description:
+ *   Start a sequence of I2C transfers and return without waiting for it to
+ *   complete, e.g. by programming DMA.  The lower half calls 'done' (from
+ *   interrupt level) when the last transfer has completed or failed.  This
+ *   method is optional; lower halves that do not provide it leave it NULL
+ *   and are driven through I2C_TRANSFER from the work queue instead.
+ *
+ * Input Parameters:
+ *   dev   - Device-specific state data
+ *   msgs  - A pointer to a set of message descriptors.  These remain valid
+ *           until 'done' is called.
+ *   count - The number of transfers to perform
+ *   done  - Completion callback, receives 'arg' and OK or a negated errno
+ *   arg   - Argument passed to 'done'
+ *
+ * Returned Value:
+ *   Zero (OK) if the transfer was started; a negated errno value on
+ *   failure, in which case 'done' is not called.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2C_ASYNC
+#  define I2C_TRANSFER_ASYNC(d,m,c,f,a) \
+     ((d)->ops->transfer_async ? \
+      (d)->ops->transfer_async(d,m,c,f,a) : -ENOSYS)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -192,6 +222,10 @@
 
 struct i2c_master_s;
 struct i2c_msg_s;
+#ifdef CONFIG_I2C_ASYNC
+typedef CODE void (*i2c_done_t)(FAR void *arg, int result);
+#endif
+
 struct i2c_ops_s
 {
   CODE int (*transfer)(FAR struct i2c_master_s *dev,
@@ -199,6 +233,11 @@ struct i2c_ops_s
 #ifdef CONFIG_I2C_RESET
   CODE int (*reset)(FAR struct i2c_master_s *dev);
 #endif
+#ifdef CONFIG_I2C_ASYNC
+  CODE int (*transfer_async)(FAR struct i2c_master_s *dev,
+                             FAR struct i2c_msg_s *msgs, int count,
+                             i2c_done_t done, FAR void *arg);
+#endif
 };
 
 /* This structure contains the full state of I2C as needed for a specific
@@ -115,6 +115,45 @@ int CONFIG_USER_ENTRYPOINT(int argc, char *argv[]);
 
 void os_start(void) noreturn_function;
 
+/* Functions contained in os_bootphase.c ************************************/
+/****************************************************************************
+ * Name: os_bootphase
+ *
+ * Description:
+ *   Record the end of the named phase of the boot-up sequence.  The name
+ *   is not copied and must persist.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_BOOTPHASE
+void os_bootphase(FAR const char *name);
+#else
+#  define os_bootphase(n)
+#endif
+
+/****************************************************************************
+ * Name: os_bootphase_get
+ *
+ * Description:
+ *   Return the recorded boot phase at 'index'.
+ *
+ * Input Parameters:
+ *   index - The index of the boot phase, zero being the first.
+ *   name  - Location to return the name of the phase.
+ *   usec  - Location to return the time in microseconds from the entry
+ *           into os_start() to the end of the phase.
+ *   cpu   - Location to return the CPU that recorded the phase.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no phase at 'index'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_BOOTPHASE
+int os_bootphase_get(int index, FAR const char **name, FAR uint32_t *usec,
+                     FAR int *cpu);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -50,6 +50,11 @@
  ************************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
 #include <nuttx/fs/ioctl.h>
 
 #ifdef CONFIG_INPUT
@@ -145,6 +150,19 @@ struct touch_sample_s
 };
 #define SIZEOF_TOUCH_SAMPLE_S(n) (sizeof(struct touch_sample_s) + ((n)-1)*sizeof(struct touch_point_s))
 
+/* A queue of touch events waiting to be read.  Drivers that use it keep one
+ * instance per device and access it only with interrupts disabled.
+ */
+
+#ifdef CONFIG_INPUT_TOUCHRING
+struct touch_ring_s
+{
+  uint8_t head;                  /* Index of the oldest event */
+  uint8_t nevents;               /* Number of events in the ring */
+  struct touch_point_s event[CONFIG_INPUT_TOUCHRING_NEVENTS];
+};
+#endif
+
 /************************************************************************************
  * Public Function Prototypes
  ************************************************************************************/
@@ -157,6 +175,49 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_INPUT_TOUCHRING
+/************************************************************************************
+ * Name: touch_ring_put
+ *
+ * Description:
+ *   Add an event to the ring.  With CONFIG_INPUT_TOUCHRING_COALESCE, a movement
+ *   is merged into an unread contact or movement event of the same touch point.
+ *   If the ring is full, the oldest event is discarded.
+ *
+ * Returned Value:
+ *   True if a new event was queued and readers should be notified; false if the
+ *   event was merged into one that readers already know about.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ************************************************************************************/
+
+bool touch_ring_put(FAR struct touch_ring_s *ring,
+                    FAR const struct touch_point_s *point);
+
+/************************************************************************************
+ * Name: touch_ring_read
+ *
+ * Description:
+ *   Remove as many events as fit in the buffer, each returned as a single point
+ *   struct touch_sample_s.
+ *
+ * Returned Value:
+ *   The number of bytes returned; zero if the ring is empty or the buffer cannot
+ *   hold one sample.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ************************************************************************************/
+
+ssize_t touch_ring_read(FAR struct touch_ring_s *ring, FAR char *buffer,
+                        size_t buflen);
+
+#define touch_ring_empty(r) ((r)->nevents == 0)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -60,6 +60,12 @@
 
 #  define irq_detach(irq) irq_attach(irq, NULL, NULL)
 
+/* Value returned by the interrupt level handler of a threaded interrupt to
+ * request that the thread level handler be run.
+ */
+
+#  define IRQ_WAKE_THREAD 1
+
 /* Maximum/minimum values of IRQ integer types */
 
 #  if NR_IRQS <= 256
@@ -170,6 +176,44 @@ int irqchain_detach(int irq, xcpt_t isr, FAR void *arg);
 #  define irqchain_detach(irq, isr, arg) irq_detach(irq)
 #endif
 
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Attach a threaded interrupt handler to IRQ number 'irq'.  A kernel
+ *   thread dedicated to this IRQ is created with the given priority and
+ *   stack size and, with CONFIG_SMP, is restricted to 'cpu' unless 'cpu'
+ *   is negative.
+ *
+ *   When the interrupt occurs, 'isr' is called in the interrupt context.
+ *   It should quiet the interrupt source and return IRQ_WAKE_THREAD to
+ *   have 'isrthread' run on the thread.  If 'isr' is NULL the thread is
+ *   always woken up.  Interrupts that occur before the thread has run
+ *   result in a single call to 'isrthread', which is passed a NULL
+ *   context.
+ *
+ * Returned Value:
+ *   The process ID of the thread on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IRQ_THREAD
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size, int cpu);
+
+/****************************************************************************
+ * Name: irq_detach_thread
+ *
+ * Description:
+ *   Detach the threaded interrupt handler from IRQ number 'irq' and stop
+ *   its thread.
+ *
+ ****************************************************************************/
+
+int irq_detach_thread(int irq);
+#endif
+
 /****************************************************************************
  * Name: enter_critical_section
  *
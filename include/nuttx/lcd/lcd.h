@@ -94,6 +94,28 @@ struct lcd_planeinfo_s
   int (*getrun)(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
                 size_t npixels);
 
+  /* This optional method can be used to write a rectangular area to the LCD
+   * in one windowed transfer instead of one putrun() per raster line.  It
+   * may be NULL.  The driver selects the window once and then streams all
+   * of the pixel data, so that a DMA-capable bus can move whole blocks.
+   * A stride of zero writes the same row to every line of the area, which
+   * is how rectangles are filled.  As with putrun(), the data has been
+   * written (or copied by the driver) when the method returns, so the
+   * caller may reuse the buffer.
+   *
+   *  row_start - Starting row to write to (range: 0 <= row_start < yres)
+   *  row_end   - Ending row (inclusive, range: row_start <= row_end < yres)
+   *  col_start - Starting column (range: 0 <= col_start < xres)
+   *  col_end   - Ending column (inclusive, range: col_start <= col_end < xres)
+   *  buffer    - The first pixel of the area
+   *  stride    - Distance in bytes from one row of the area in buffer to
+   *              the next (may be zero)
+   */
+
+  int (*putarea)(fb_coord_t row_start, fb_coord_t row_end,
+                 fb_coord_t col_start, fb_coord_t col_end,
+                 FAR const uint8_t *buffer, fb_coord_t stride);
+
   /* Plane color characteristics ********************************************/
 
   /* This is working memory allocated by the LCD driver for each LCD device
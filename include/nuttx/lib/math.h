@@ -123,6 +123,7 @@
 
 #define M_PI_F     ((float)M_PI)
 #define M_PI_2_F   ((float)M_PI_2)
+#define M_PI_4_F   ((float)M_PI_4)
 
 /****************************************************************************
  * Public Function Prototypes
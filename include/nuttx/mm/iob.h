@@ -45,6 +45,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef CONFIG_NET_LATENCY
+#  include <nuttx/net/netlatency.h>
+#endif
+
 #ifdef CONFIG_IOB_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
@@ -84,10 +88,32 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* An optional pool of small I/O buffers may be used at the end of chains */
+
+#ifndef CONFIG_IOB_SMALL_NBUFFERS
+#  define CONFIG_IOB_SMALL_NBUFFERS 0
+#endif
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+#  ifndef CONFIG_IOB_SMALL_BUFSIZE
+#    define CONFIG_IOB_SMALL_BUFSIZE 128
+#  endif
+#  if CONFIG_IOB_SMALL_BUFSIZE >= CONFIG_IOB_BUFSIZE
+#    error CONFIG_IOB_SMALL_BUFSIZE >= CONFIG_IOB_BUFSIZE
+#  endif
+#endif
+
 /* IOB helpers */
 
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+#  define IOB_BUFSIZE(p) \
+     (iob_issmall(p) ? CONFIG_IOB_SMALL_BUFSIZE : CONFIG_IOB_BUFSIZE)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -96,10 +122,47 @@
 #  define IOB_QEMPTY(q)  ((q)->qh_head == NULL)
 #endif
 
+/* The consumer that owns an I/O buffer */
+
+#ifdef CONFIG_IOB_QUOTAS
+#  define IOB_USER(p)    ((enum iob_user_e)(p)->io_user)
+#else
+#  define IOB_USER(p)    IOB_USER_OTHER
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* Identifies the consumer of an I/O buffer.  With CONFIG_IOB_QUOTAS, the
+ * number of I/O buffers held by each consumer is accounted and may be
+ * limited so that one consumer cannot exhaust the shared pool.
+ */
+
+enum iob_user_e
+{
+  IOB_USER_OTHER = 0,   /* Not classified and never limited */
+  IOB_USER_TCP_RX,      /* TCP read-ahead buffering */
+  IOB_USER_TCP_WRB,     /* TCP write buffering */
+  IOB_USER_UDP,         /* UDP read-ahead and write buffering */
+  IOB_USER_6LOWPAN,     /* 6LoWPAN frames */
+  IOB_USER_BLUETOOTH,   /* Bluetooth frames */
+  IOB_NUSERS
+};
+
+#ifdef CONFIG_IOB_QUOTAS
+/* Accounting for one I/O buffer consumer as returned by iob_userinfo() */
+
+struct iob_userinfo_s
+{
+  uint16_t nused;       /* Number of I/O buffers now held */
+  uint16_t npeak;       /* Largest number of I/O buffers ever held */
+  uint16_t quota;       /* Limit on nused.  Zero means no limit */
+  uint32_t nalloc;      /* Number of successful allocations */
+  uint32_t ndenied;     /* Number of allocations denied by the quota */
+};
+#endif
+
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
@@ -121,6 +184,12 @@ struct iob_s
   uint16_t io_offset;   /* Data begins at this offset */
 #endif
   uint16_t io_pktlen;   /* Total length of the packet */
+#ifdef CONFIG_IOB_QUOTAS
+  uint8_t  io_user;     /* Owning consumer (see enum iob_user_e) */
+#endif
+#ifdef CONFIG_NET_LATENCY
+  struct net_latency_s io_latency; /* Trace of the packet (head IOB only) */
+#endif
 
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
 };
@@ -187,6 +256,73 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_issmall
+ *
+ * Description:
+ *   Return true if the I/O buffer was taken from the pool of small I/O
+ *   buffers and holds only CONFIG_IOB_SMALL_BUFSIZE bytes of payload.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+bool iob_issmall(FAR const struct iob_s *iob);
+#endif
+
+/****************************************************************************
+ * Name: iob_alloc_user and iob_tryalloc_user
+ *
+ * Description:
+ *   The same as iob_alloc() and iob_tryalloc() except that the I/O buffer
+ *   is charged to the consumer 'user'.  If that consumer already holds its
+ *   quota of I/O buffers, iob_tryalloc_user() fails and iob_alloc_user()
+ *   waits until one of that consumer's I/O buffers is freed.  I/O buffers
+ *   added to the chain by iob_copyin(), iob_trycopyin() and iob_clone() are
+ *   charged to the consumer of the I/O buffer at the head of the chain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+FAR struct iob_s *iob_alloc_user(bool throttled, enum iob_user_e user);
+FAR struct iob_s *iob_tryalloc_user(bool throttled, enum iob_user_e user);
+#else
+#  define iob_alloc_user(t,u)    iob_alloc(t)
+#  define iob_tryalloc_user(t,u) iob_tryalloc(t)
+#endif
+
+/****************************************************************************
+ * Name: iob_navail_user
+ *
+ * Description:
+ *   Return the number of IOBs that could be allocated (unthrottled) by the
+ *   consumer 'user':  The number of available IOBs limited by what remains
+ *   of that consumer's quota.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+int iob_navail_user(enum iob_user_e user);
+#else
+#  define iob_navail_user(u)     iob_navail(false)
+#endif
+
+/****************************************************************************
+ * Name: iob_userinfo
+ *
+ * Description:
+ *   Return the accounting information for the consumer 'user'.  The name
+ *   of the consumer is returned if 'name' is not NULL.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if 'user' is not a valid consumer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+int iob_userinfo(enum iob_user_e user, FAR struct iob_userinfo_s *info,
+                 FAR const char **name);
+#endif
+
 /****************************************************************************
  * Name: iob_navail
  *
@@ -249,6 +385,25 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob);
 int iob_notifier_setup(int qid, worker_t worker, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: iob_notifier_setup_user
+ *
+ * Description:
+ *   The same as iob_notifier_setup() except that the notification is
+ *   scoped to the consumer 'user':  The worker runs only when an IOB is
+ *   available AND that consumer is below its quota.  Use this when an
+ *   allocation by iob_tryalloc_user() or iob_navail_user() has failed.  The
+ *   notification is torn down with iob_notifier_teardown().
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_IOB_NOTIFIER) && defined(CONFIG_IOB_QUOTAS)
+int iob_notifier_setup_user(int qid, worker_t worker, FAR void *arg,
+                            enum iob_user_e user);
+#elif defined(CONFIG_IOB_NOTIFIER)
+#  define iob_notifier_setup_user(q,w,a,u) iob_notifier_setup(q,w,a)
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_teardown
  *
@@ -177,6 +177,37 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0))
 
+/* Two-level segregated fit definitions (CONFIG_MM_TLSF).  The first level
+ * index is the power of two of the chunk size (as with the default free
+ * list indices), the second level divides each power of two range into
+ * MM_TLSF_SLCOUNT equal sub-ranges.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  define MM_TLSF_SLSHIFT    CONFIG_MM_TLSF_SLSHIFT
+#  define MM_TLSF_SLCOUNT    (1 << MM_TLSF_SLSHIFT)
+#  define MM_TLSF_SLMASK     (MM_TLSF_SLCOUNT - 1)
+
+#  if MM_TLSF_SLSHIFT > MM_MIN_SHIFT
+#    error CONFIG_MM_TLSF_SLSHIFT is larger than MM_MIN_SHIFT
+#  endif
+#endif
+
+/* Small allocation cache definitions (CONFIG_MM_CACHE).  Cache size class
+ * 'ndx' holds chunks of exactly (ndx + 1) << MM_MIN_SHIFT bytes
+ * (including the chunk header).
+ */
+
+#ifdef CONFIG_MM_CACHE
+#  ifdef CONFIG_SMP
+#    define MM_CACHE_NCPUS   CONFIG_SMP_NCPUS
+#  else
+#    define MM_CACHE_NCPUS   1
+#  endif
+#  define MM_CACHE_MAXCHUNK  (CONFIG_MM_CACHE_NCLASSES << MM_MIN_SHIFT)
+#  define MM_CACHE_NDX(s)    (((s) >> MM_MIN_SHIFT) - 1)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -200,14 +231,24 @@ struct mm_allocnode_s
 {
   mmsize_t size;           /* Size of this chunk */
   mmsize_t preceding;      /* Size of the preceding chunk */
+#ifdef CONFIG_MM_HEAPSTAT
+  mmsize_t pid;            /* PID of the owner of an allocated chunk */
+  mmsize_t reserved;       /* Keeps the payload aligned */
+#endif
 };
 
 /* What is the size of the allocnode? */
 
-#ifdef CONFIG_MM_SMALL
-# define SIZEOF_MM_ALLOCNODE   4
+#ifdef CONFIG_MM_HEAPSTAT
+#  ifdef CONFIG_MM_SMALL
+#    define SIZEOF_MM_ALLOCNODE 8
+#  else
+#    define SIZEOF_MM_ALLOCNODE 16
+#  endif
+#elif defined(CONFIG_MM_SMALL)
+#  define SIZEOF_MM_ALLOCNODE   4
 #else
-# define SIZEOF_MM_ALLOCNODE   8
+#  define SIZEOF_MM_ALLOCNODE   8
 #endif
 
 #define CHECK_ALLOCNODE_SIZE \
@@ -219,6 +260,10 @@ struct mm_freenode_s
 {
   mmsize_t size;                   /* Size of this chunk */
   mmsize_t preceding;              /* Size of the preceding chunk */
+#ifdef CONFIG_MM_HEAPSTAT
+  mmsize_t pid;                    /* Unused in a free chunk */
+  mmsize_t reserved;
+#endif
   FAR struct mm_freenode_s *flink; /* Supports a doubly linked list */
   FAR struct mm_freenode_s *blink;
 };
@@ -231,6 +276,61 @@ struct mm_freenode_s
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+#ifdef CONFIG_MM_CACHE
+/* A free chunk in a small allocation cache.  The chunk is still marked as
+ * allocated in the heap; the link is kept in the chunk payload.
+ */
+
+struct mm_cachenode_s
+{
+  struct mm_allocnode_s      hdr;  /* The allocated chunk header */
+  FAR struct mm_cachenode_s *flink;
+};
+
+/* The small allocation cache of one CPU */
+
+struct mm_cache_s
+{
+  FAR struct mm_cachenode_s *mc_list[CONFIG_MM_CACHE_NCLASSES];
+  uint16_t mc_count[CONFIG_MM_CACHE_NCLASSES];
+};
+#endif
+
+#ifdef CONFIG_MM_HEAPSTAT
+/* Number of bins of the allocation latency histogram */
+
+#  define MM_HEAPSTAT_NLATENCY 24
+
+/* Chunk owner when no valid PID was available */
+
+#  define MM_HEAPSTAT_NOPID    ((mmsize_t)-1)
+
+/* Heap-wide allocation statistics */
+
+struct mm_heapstat_s
+{
+  uint32_t hs_nalloc;                        /* Successful allocations */
+  uint32_t hs_nfree;                         /* Frees */
+  uint32_t hs_nfail;                         /* Failed allocations */
+  uint32_t hs_size[MM_NNODES];               /* Chunk size histogram */
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+  uint32_t hs_maxlatency;                    /* Longest mm_malloc() */
+  uint32_t hs_latency[MM_HEAPSTAT_NLATENCY]; /* mm_malloc() histogram */
+#endif
+};
+
+/* Allocation statistics of one PID */
+
+struct mm_pidstat_s
+{
+  pid_t    ps_pid;                           /* Owner of the statistics */
+  uint32_t ps_nalloc;                        /* Chunks allocated */
+  uint32_t ps_nfree;                         /* Chunks freed */
+  size_t   ps_used;                          /* Bytes currently in use */
+  size_t   ps_peak;                          /* Peak bytes in use */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -256,12 +356,36 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* Free nodes are kept in MM_NNODES x MM_TLSF_SLCOUNT unordered, doubly
+   * linked lists.  A bit is set in mm_slbitmap[fl] for each non-empty
+   * list on first level 'fl' and bit 'fl' of mm_flbitmap is set if any
+   * of these lists is non-empty.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_NNODES];
+  FAR struct mm_freenode_s *mm_freelist[MM_NNODES][MM_TLSF_SLCOUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_CACHE
+  /* Per-CPU caches of small free chunks */
+
+  struct mm_cache_s mm_cache[MM_CACHE_NCPUS];
+#endif
+#ifdef CONFIG_MM_HEAPSTAT
+  /* Allocation statistics, protected by the MM semaphore */
+
+  struct mm_heapstat_s mm_stat;
+  struct mm_pidstat_s mm_pidstat[CONFIG_MAX_TASKS];
+#endif
 };
 
 /****************************************************************************
@@ -367,6 +491,7 @@ void kmm_givesemaphore(void);
 /* Functions contained in mm_malloc.c ***************************************/
 
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
+FAR void *mm_mallocchunk(FAR struct mm_heap_s *heap, size_t alignsize);
 
 /* Functions contained in kmm_malloc.c **************************************/
 
@@ -377,6 +502,17 @@ FAR void *kmm_malloc(size_t size);
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_freechunk(FAR struct mm_heap_s *heap,
+                  FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_CACHE
+void mm_cache_initialize(FAR struct mm_heap_s *heap);
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cache_free(FAR struct mm_heap_s *heap,
+                   FAR struct mm_allocnode_s *node);
+#endif
 
 /* Functions contained in kmm_free.c ****************************************/
 
@@ -503,19 +639,55 @@ int kmm_mallinfo(struct mallinfo *info);
 #endif /* CONFIG_CAN_PASS_STRUCTS */
 #endif /* CONFIG_MM_KERNEL_HEAP */
 
+/* Functions contained in mm_heapstat.c *************************************/
+
+#ifdef CONFIG_MM_HEAPSTAT
+void mm_heapstat_alloc(FAR struct mm_heap_s *heap,
+                       FAR struct mm_allocnode_s *node);
+void mm_heapstat_free(FAR struct mm_heap_s *heap,
+                      FAR struct mm_allocnode_s *node);
+void mm_heapstat_resize(FAR struct mm_heap_s *heap,
+                        FAR struct mm_allocnode_s *node, size_t oldsize);
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+void mm_heapstat_latency(FAR struct mm_heap_s *heap, uint32_t elapsed);
+#endif
+int mm_heapstat(FAR struct mm_heap_s *heap, FAR struct mm_heapstat_s *stat);
+int mm_pidstat(FAR struct mm_heap_s *heap, pid_t pid,
+               FAR struct mm_pidstat_s *stat);
+#endif
+
+/* Functions contained in umm_heapstat.c ************************************/
+
+#ifdef CONFIG_MM_HEAPSTAT
+int umm_heapstat(FAR struct mm_heapstat_s *stat);
+int umm_pidstat(pid_t pid, FAR struct mm_pidstat_s *stat);
+#endif
+
 /* Functions contained in mm_shrinkchunk.c **********************************/
 
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c *******************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c or mm_tlsf.c *******************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c or mm_tlsf.c ******************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
+#ifndef CONFIG_MM_TLSF
 int mm_size2ndx(size_t size);
+#endif
 
 #undef EXTERN
 #ifdef __cplusplus
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * include/nuttx/mm/objpool.h
+ * Fixed-size object pool allocator.
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_OBJPOOL_H
+#define __INCLUDE_NUTTX_MM_OBJPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+
+#include <nuttx/mm/gran.h>
+
+#ifdef CONFIG_MM_OBJPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+/* CONFIG_MM_OBJPOOL - Enable fixed-size object pool support.  Selects
+ *   CONFIG_GRAN.
+ * CONFIG_MM_OBJPOOL_MAGAZINE - Keep a small per-CPU stack (a "magazine")
+ *   of free objects in front of the shared free list of each pool.
+ * CONFIG_MM_OBJPOOL_MAGSIZE - The maximum number of objects in one
+ *   magazine.
+ */
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+#  ifdef CONFIG_SMP
+#    define OBJPOOL_NMAGAZINES CONFIG_SMP_NCPUS
+#  else
+#    define OBJPOOL_NMAGAZINES 1
+#  endif
+#endif
+
+/* Create a pool for objects of a given type */
+
+#define OBJPOOL_CREATE(name, type, nobjs) \
+  objpool_create(name, sizeof(type), nobjs)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+/* The free objects cached for one CPU */
+
+struct objpool_mag_s
+{
+  sq_queue_t om_free;          /* Free objects of this magazine */
+  uint16_t   om_count;         /* Number of objects in om_free */
+  uint32_t   om_nalloc;        /* Allocations from this magazine */
+  uint32_t   om_nfree;         /* Frees to this magazine */
+};
+#endif
+
+/* This describes one object pool.  The memory of the pool is managed by
+ * a granule allocator.  Objects are carved from it on demand and are then
+ * recycled through the free lists of the pool; they are only returned to
+ * the granule allocator when the pool is destroyed.
+ */
+
+struct objpool_s
+{
+  FAR struct objpool_s *op_flink; /* Supports a singly linked list of pools */
+  FAR const char *op_name;        /* Name of the pool (for procfs) */
+  GRAN_HANDLE op_gran;            /* Granule allocator of the pool memory */
+  FAR uint8_t *op_start;          /* Start of the pool memory */
+  FAR uint8_t *op_end;            /* End of the pool memory */
+  size_t op_objsize;              /* Size of one object */
+  uint16_t op_nobjs;              /* Capacity of the pool */
+  uint16_t op_ncarved;            /* Objects carved from the pool memory */
+  sq_queue_t op_free;             /* Shared list of free objects */
+  uint32_t op_nalloc;             /* Allocations from op_free or carved */
+  uint32_t op_nrelease;           /* Frees to op_free */
+  uint32_t op_nfail;              /* Allocations failed (pool exhausted) */
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  struct objpool_mag_s op_mag[OBJPOOL_NMAGAZINES];
+#endif
+};
+
+/* Form in which the state of an object pool is returned */
+
+struct objpool_info_s
+{
+  FAR const char *name;        /* Name of the pool */
+  size_t   objsize;            /* Size of one object */
+  uint16_t nobjs;              /* Capacity of the pool */
+  uint16_t nused;              /* Objects currently allocated */
+  uint16_t npeak;              /* Largest number of objects ever carved */
+  uint32_t nalloc;             /* Total number of allocations */
+  uint32_t nfail;              /* Allocations failed (pool exhausted) */
+};
+
+/* Callback used by objpool_foreach() */
+
+typedef CODE void (*objpool_handler_t)(FAR const struct objpool_info_s *info,
+                                       FAR void *arg);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: objpool_create
+ *
+ * Description:
+ *   Create a pool of 'nobjs' objects of 'objsize' bytes each.  The memory
+ *   of the pool is allocated once from the kernel heap and is then managed
+ *   by a granule allocator; allocating or freeing objects never touches
+ *   the heap again.
+ *
+ *   This should be done early in the initialization sequence.
+ *
+ * Input Parameters:
+ *   name    - Name of the pool.  The string must persist for the life of
+ *             the pool.
+ *   objsize - Size of one object in bytes
+ *   nobjs   - The number of objects in the pool
+ *
+ * Returned Value:
+ *   On success, a reference to the new pool is returned; NULL is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+FAR struct objpool_s *objpool_create(FAR const char *name, size_t objsize,
+                                     unsigned int nobjs);
+
+/****************************************************************************
+ * Name: objpool_destroy
+ *
+ * Description:
+ *   Destroy a pool and release its memory.  All objects must have been
+ *   freed.
+ *
+ * Input Parameters:
+ *   pool - The pool previously returned by objpool_create()
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBUSY if objects of the pool are still in use.
+ *
+ ****************************************************************************/
+
+int objpool_destroy(FAR struct objpool_s *pool);
+
+/****************************************************************************
+ * Name: objpool_alloc and objpool_zalloc
+ *
+ * Description:
+ *   Allocate one object from the pool.  objpool_zalloc() also clears the
+ *   object.
+ *
+ *   These may be called from interrupt handlers.  Interrupt handlers will,
+ *   however, only get objects that were already carved from the pool
+ *   memory unless CONFIG_GRAN_INTR is selected.
+ *
+ * Input Parameters:
+ *   pool - The pool previously returned by objpool_create()
+ *
+ * Returned Value:
+ *   A pointer to the object; NULL if the pool is exhausted.
+ *
+ ****************************************************************************/
+
+FAR void *objpool_alloc(FAR struct objpool_s *pool);
+FAR void *objpool_zalloc(FAR struct objpool_s *pool);
+
+/****************************************************************************
+ * Name: objpool_free
+ *
+ * Description:
+ *   Return an object to the pool.  This may be called from interrupt
+ *   handlers.
+ *
+ * Input Parameters:
+ *   pool - The pool previously returned by objpool_create()
+ *   obj  - An object previously allocated from the same pool
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void objpool_free(FAR struct objpool_s *pool, FAR void *obj);
+
+/****************************************************************************
+ * Name: objpool_member
+ *
+ * Description:
+ *   Return true if 'obj' lies in the memory of the pool.  This lets callers
+ *   that fall back to the heap when the pool is exhausted decide how an
+ *   object must be freed.
+ *
+ ****************************************************************************/
+
+bool objpool_member(FAR struct objpool_s *pool, FAR const void *obj);
+
+/****************************************************************************
+ * Name: objpool_info
+ *
+ * Description:
+ *   Return information about the pool.
+ *
+ ****************************************************************************/
+
+void objpool_info(FAR struct objpool_s *pool,
+                  FAR struct objpool_info_s *info);
+
+/****************************************************************************
+ * Name: objpool_foreach
+ *
+ * Description:
+ *   Call 'handler' with the information of every pool in the system.  The
+ *   handler is called from within a critical section and must not block.
+ *
+ ****************************************************************************/
+
+void objpool_foreach(objpool_handler_t handler, FAR void *arg);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_MM_OBJPOOL */
+#endif /* __INCLUDE_NUTTX_MM_OBJPOOL_H */
@@ -132,6 +132,23 @@ struct mq_des
   int oflags;                      /* Flags set when message queue was opened */
 };
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/* A zero-copy message carries only this descriptor.  The payload remains
+ * in a buffer from the zero-copy buffer pool whose ownership passes from
+ * the sender to the receiver.  A message queue used for zero-copy messages
+ * must be created with an mq_msgsize of MQ_ZCMSGSIZE.
+ */
+
+struct mq_zcmsg_s
+{
+  uint32_t magic;                  /* Identifies a zero-copy message */
+  FAR void *buffer;                /* Buffer from the zero-copy pool */
+  size_t buflen;                   /* Number of valid bytes in the buffer */
+};
+
+#  define MQ_ZCMSGSIZE sizeof(struct mq_zcmsg_s)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -295,6 +312,75 @@ ssize_t nxmq_receive(mqd_t mqdes, FAR char *msg, size_t msglen,
 ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
                         FAR int *prio, FAR const struct timespec *abstime);
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/****************************************************************************
+ * Name: nxmq_zcalloc and nxmq_zcfree
+ *
+ * Description:
+ *   Allocate a buffer of CONFIG_MQ_ZCBUFSIZE bytes from the zero-copy
+ *   buffer pool or return one to the pool.  Both may be called from
+ *   interrupt handlers.
+ *
+ * Input Parameters:
+ *   buffer - The buffer to be freed (nxmq_zcfree only)
+ *
+ * Returned Value:
+ *   nxmq_zcalloc() returns the buffer or NULL if the pool is exhausted.
+ *
+ ****************************************************************************/
+
+FAR void *nxmq_zcalloc(void);
+void nxmq_zcfree(FAR void *buffer);
+
+/****************************************************************************
+ * Name: nxmq_zcsend
+ *
+ * Description:
+ *   Send a buffer from the zero-copy pool without copying its content.
+ *   Only a descriptor of the buffer is queued; it is ordered by priority
+ *   and triggers mq_notify() exactly as a message sent by nxmq_send().  On
+ *   success, ownership of the buffer passes to the receiver.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor created with mq_msgsize MQ_ZCMSGSIZE
+ *   buffer - Buffer obtained from nxmq_zcalloc()
+ *   buflen - Number of valid bytes in the buffer
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned on
+ *   failure, in which case the caller still owns the buffer.
+ *
+ ****************************************************************************/
+
+int nxmq_zcsend(mqd_t mqdes, FAR void *buffer, size_t buflen, int prio);
+
+/****************************************************************************
+ * Name: nxmq_zcreceive and nxmq_zctimedreceive
+ *
+ * Description:
+ *   Receive the oldest of the highest priority zero-copy messages.  The
+ *   receiver becomes the owner of the returned buffer and must release it
+ *   with nxmq_zcfree() when done.
+ *
+ * Input Parameters:
+ *   mqdes   - Message queue descriptor created with mq_msgsize MQ_ZCMSGSIZE
+ *   buffer  - Location to return the buffer
+ *   prio    - If not NULL, the location to store message priority.
+ *   abstime - The absolute time to wait until a timeout is declared
+ *             (nxmq_zctimedreceive only).
+ *
+ * Returned Value:
+ *   The number of valid bytes in the buffer is returned on success.  A
+ *   negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_zcreceive(mqd_t mqdes, FAR void **buffer, FAR int *prio);
+ssize_t nxmq_zctimedreceive(mqd_t mqdes, FAR void **buffer, FAR int *prio,
+                            FAR const struct timespec *abstime);
+#endif
+
 /****************************************************************************
  * Name: nxmq_free_msgq
  *
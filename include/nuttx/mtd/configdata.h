@@ -69,6 +69,20 @@
  *   ioctl argument:  Pointer to a config_data_s structure to receive the
  *                    config data.  All fields of the strucure must be
  *                    specified (i.e. id, instance, pointer and len).
+ *
+ * CFGDIOC_GETCONFIGS - Get a list of Config Data items in one call
+ *
+ *   ioctl argument:  Pointer to a config_batch_s structure describing an
+ *                    array of config_data_s structures, each set up as for
+ *                    CFGDIOC_GETCONFIG.  Items that do not exist are
+ *                    returned with len set to zero.
+ *
+ * CFGDIOC_SETCONFIGS - Set a list of Config Data items in one call
+ *
+ *   ioctl argument:  Pointer to a config_batch_s structure describing an
+ *                    array of config_data_s structures, each set up as for
+ *                    CFGDIOC_SETCONFIG.  Items are written in order and
+ *                    processing stops at the first failure.
  */
 
 #define CFGDIOC_GETCONFIG    _CFGDIOC(1)
@@ -77,6 +91,8 @@
 #define CFGDIOC_FINDCONFIG   _CFGDIOC(4)
 #define CFGDIOC_FIRSTCONFIG  _CFGDIOC(5)
 #define CFGDIOC_NEXTCONFIG   _CFGDIOC(6)
+#define CFGDIOC_GETCONFIGS   _CFGDIOC(7)
+#define CFGDIOC_SETCONFIGS   _CFGDIOC(8)
 
 /****************************************************************************
  * Public Types
@@ -96,6 +112,14 @@ struct config_data_s
   size_t      len;          /* Length of the config data buffer */
 };
 
+/* Argument of CFGDIOC_GETCONFIGS and CFGDIOC_SETCONFIGS */
+
+struct config_batch_s
+{
+  FAR struct config_data_s *items; /* Array of config data items */
+  size_t      nitems;       /* Number of items in the array */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -136,6 +136,28 @@ void hamming_compute256x(FAR const uint8_t *data, size_t size, uint8_t *code);
 
 int hamming_verify256x(FAR uint8_t *data, size_t size, FAR const uint8_t *code);
 
+/****************************************************************************
+ * Name: hamming_correct256x
+ *
+ * Description:
+ *   Like hamming_verify256x(), but the 3-bytes hamming codes of the data
+ *   have already been computed (for example, by a hardware ECC engine).
+ *   Each 256-bytes block is corrected with its own code.
+ *
+ * Input Parameters:
+ *   data     - Data buffer to verify
+ *   size     - Size of the data in bytes
+ *   computed - Codes computed on the data
+ *   code     - Original codes
+ *
+ * Returned Value:
+ *   Same as hamming_verify256x().
+ *
+ ****************************************************************************/
+
+int hamming_correct256x(FAR uint8_t *data, size_t size,
+                        FAR const uint8_t *computed, FAR const uint8_t *code);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
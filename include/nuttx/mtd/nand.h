@@ -73,6 +73,13 @@ struct nand_dev_s
   struct mtd_dev_s mtd;       /* Externally visible part of the driver */
   FAR struct nand_raw_s *raw; /* Retained reference to the lower half */
   sem_t exclsem;              /* For exclusive access to the NAND FLASH */
+#ifdef CONFIG_MTD_NAND_BBT
+  off_t nblocks;              /* Number of blocks available to the MTD user */
+
+  /* Bad block table:  One bit per block, set if the block is bad */
+
+  uint8_t bbt[(CONFIG_MTD_NAND_MAXNUMBLOCKS + 7) / 8];
+#endif
 };
 
 /****************************************************************************
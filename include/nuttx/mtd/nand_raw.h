@@ -232,6 +232,31 @@
 #  define NAND_WRITEPAGE(r,b,p,d,s) ((r)->rawwrite(r,b,p,d,s))
 #endif
 
+/****************************************************************************
+ * Name: NAND_CALCECC
+ *
+ * Description:
+ *   Compute the 3-byte Hamming codes of each 256 byte chunk of a page using
+ *   ECC hardware.  This is only used with software ECC (NANDECC_SWECC) and
+ *   only if the lower half provides the optional calcecc method; otherwise
+ *   the codes are computed in software.  The codes must be in the format
+ *   produced by hamming_compute256x().
+ *
+ * Input Parameters:
+ *   raw  - Lower-half, raw NAND FLASH interface
+ *   data - The page data
+ *   size - The size of the data in bytes (a multiple of 256)
+ *   code - Buffer to receive the codes (3 bytes per 256 bytes of data)
+ *
+ * Returned Value:
+ *   OK is returned in succes; a negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_SWECC
+#  define NAND_CALCECC(r,d,s,c) ((r)->calcecc(r,d,s,c))
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -268,6 +293,15 @@ struct nand_raw_s
                         FAR const void *spare);
 #endif
 
+#ifdef CONFIG_MTD_NAND_SWECC
+  /* Optional ECC engine used to compute the software ECC codes (may be
+   * NULL).
+   */
+
+  CODE int (*calcecc)(FAR struct nand_raw_s *raw, FAR const uint8_t *data,
+                      size_t size, FAR uint8_t *code);
+#endif
+
 #if defined(CONFIG_MTD_NAND_SWECC) || defined(CONFIG_MTD_NAND_HWECC)
   /* ECC working buffers*/
 
@@ -116,6 +116,10 @@
 /* TUN/TAP driver ***********************************************************/
 
 #define TUNSETIFF        _SIOC(0x0028)  /* Set TUN/TAP interface */
+#define TUNREADV         _SIOC(0x002a)  /* Read several packets.
+                                         * See include/nuttx/net/tun.h */
+#define TUNWRITEV        _SIOC(0x002b)  /* Write several packets.
+                                         * See include/nuttx/net/tun.h */
 
 /* Telnet driver ************************************************************/
 
@@ -383,6 +383,9 @@ struct mld_mcast_listen_done_s
 struct mld_netdev_s
 {
   sq_queue_t grplist;                /* MLD group list */
+#ifdef CONFIG_NET_MLD_GRPHASH
+  FAR struct mld_group_s *grphash[CONFIG_NET_MLD_GRPHASH_NBUCKETS];
+#endif
   WDOG_ID gendog;                    /* General query timer */
   WDOG_ID v1dog;                     /* MLDv1 compatibility timer */
   uint8_t flags;                     /* See MLD_ flags definitions */
@@ -0,0 +1,214 @@
+/****************************************************************************
+ * include/nuttx/net/napi.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NET_NAPI_H
+#define __INCLUDE_NUTTX_NET_NAPI_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/wqueue.h>
+
+#ifdef CONFIG_NETDEV_NAPI
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_NETDEV_NAPI_BUDGET
+#  define CONFIG_NETDEV_NAPI_BUDGET 16
+#endif
+
+#ifndef CONFIG_NETDEV_NAPI_HOLDOFF
+#  define CONFIG_NETDEV_NAPI_HOLDOFF 1
+#endif
+
+/* The work queue that the poll is queued on */
+
+#ifdef CONFIG_NETDEV_NAPI_STEERING
+#  define NAPI_WQID(napi) ((napi)->wqid)
+#else
+#  define NAPI_WQID(napi) ((napi)->qid)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* NAPI-style polled receive.
+ *
+ * A driver that opts in no longer drains its hardware from one work item
+ * per interrupt.  Instead its interrupt handler calls napi_schedule(),
+ * which masks the device interrupt and schedules a poll.  The poll method
+ * then processes at most 'budget' received frames with the network locked.
+ *
+ *  - If the budget was exhausted the device is still busy:  the poll is
+ *    rescheduled immediately and the interrupt stays masked.
+ *  - If some frames were received after a busy period, the interrupt stays
+ *    masked for CONFIG_NETDEV_NAPI_HOLDOFF more ticks and is then polled
+ *    again.  This coalesces the interrupts of a tapering burst.
+ *  - Only a poll that finds the device idle (or a single short poll when
+ *    the device was not busy) re-enables the interrupt.
+ *
+ * The poll method must also service any other interrupt sources that share
+ * the masked interrupt (TX done, PHY, ...).  Level-triggered interrupt
+ * sources will reassert when re-enabled if more work arrived in between;
+ * drivers with edge-triggered interrupts must check for pending work before
+ * returning less than the budget.
+ */
+
+struct napi_s;   /* Forward reference */
+
+/* Poll the device.  Called on the NAPI work queue with the network locked.
+ * Returns the number of frames received, at most 'budget'.
+ */
+
+typedef int (*napi_poll_t)(FAR struct napi_s *napi, int budget);
+
+/* Mask (enable == false) or unmask (enable == true) the device interrupt.
+ * Masking is called from interrupt level; unmasking from the work queue
+ * with the network locked.
+ */
+
+typedef void (*napi_irqctl_t)(FAR struct napi_s *napi, bool enable);
+
+struct net_driver_s;   /* Forward reference */
+
+struct napi_s
+{
+  struct work_s work;               /* Poll work */
+  FAR struct net_driver_s *dev;     /* The polled network device */
+  napi_poll_t poll;                 /* Driver poll method */
+  napi_irqctl_t irqctl;             /* Driver interrupt control method */
+  FAR void *priv;                   /* Driver private data */
+  int16_t qid;                      /* Work queue that performs the poll */
+#ifdef CONFIG_NETDEV_NAPI_STEERING
+  int16_t wqid;                     /* Work queue that the poll is queued on */
+  uint32_t hash;                    /* Selects the per-CPU work queue */
+#endif
+  uint16_t budget;                  /* Maximum frames per poll */
+  volatile bool sched;              /* True: Interrupt masked, poll pending */
+  bool busy;                        /* True: Recent poll exhausted the budget */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: napi_initialize
+ *
+ * Description:
+ *   Initialize a NAPI instance for a network device.
+ *
+ * Input Parameters:
+ *   napi   - The NAPI instance to initialize
+ *   dev    - The network device that will be polled
+ *   qid    - The work queue on which the poll runs (normally LPWORK).
+ *            With CONFIG_NETDEV_NAPI_STEERING, this is used only until
+ *            the per-CPU work queues have been started.
+ *   budget - Maximum frames per poll; zero selects
+ *            CONFIG_NETDEV_NAPI_BUDGET
+ *   poll   - The driver poll method
+ *   irqctl - The driver interrupt control method
+ *   priv   - Driver private data, available as napi->priv
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void napi_initialize(FAR struct napi_s *napi, FAR struct net_driver_s *dev,
+                     int qid, uint16_t budget, napi_poll_t poll,
+                     napi_irqctl_t irqctl, FAR void *priv);
+
+/****************************************************************************
+ * Name: napi_schedule
+ *
+ * Description:
+ *   Mask the device interrupt and schedule a poll.  This is normally called
+ *   from the device interrupt handler.  Nothing is done if a poll is
+ *   already pending.
+ *
+ * Input Parameters:
+ *   napi - The NAPI instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void napi_schedule(FAR struct napi_s *napi);
+
+/****************************************************************************
+ * Name: napi_cancel
+ *
+ * Description:
+ *   Cancel any pending poll.  This is normally called when the interface is
+ *   brought down, after the device interrupt has been disabled.
+ *
+ * Input Parameters:
+ *   napi - The NAPI instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void napi_cancel(FAR struct napi_s *napi);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_NETDEV_NAPI */
+#endif /* __INCLUDE_NUTTX_NET_NAPI_H */
@@ -44,12 +44,17 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <sys/types.h>
 #include <sys/socket.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdarg.h>
 #include <semaphore.h>
 
+#ifdef CONFIG_MM_IOB
+#  include <nuttx/mm/iob.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -144,6 +149,18 @@ typedef uint16_t socktimeo_t;
 
 typedef uint8_t sockcaps_t;
 
+/* A re-entrant network lock.  The global network lock taken by net_lock()
+ * is one instance; finer grained locks such as the per-device lock of
+ * CONFIG_NETDEV_LOCK are others.
+ */
+
+struct net_rlock_s
+{
+  sem_t        rl_sem;      /* Mutual exclusion */
+  pid_t        rl_holder;   /* Thread holding the lock */
+  unsigned int rl_count;    /* Number of times the holder took the lock */
+};
+
 /* This callbacks are socket operations that may be performed on a socket of
  * a given address family.
  */
@@ -151,6 +168,7 @@ typedef uint8_t sockcaps_t;
 struct file;    /* Forward reference */
 struct socket;  /* Forward reference */
 struct pollfd;  /* Forward reference */
+struct iovec;   /* Forward reference */
 
 struct sock_intf_s
 {
@@ -190,6 +208,9 @@ struct sock_intf_s
   CODE int        (*si_ioctl)(FAR struct socket *psock, int cmd,
                     FAR void *arg, size_t arglen);
 #endif
+  CODE ssize_t    (*si_sendv)(FAR struct socket *psock,
+                    FAR const struct iovec *iov, int iovcnt, int flags);
+                                   /* Optional.  NULL: send each entry */
 };
 
 /* This is the internal representation of a socket reference by a file
@@ -287,6 +308,9 @@ void net_initialize(void);
  *
  *   net_lock()        - Locks the network via a re-entrant mutex.
  *   net_unlock()      - Unlocks the network.
+ *   net_rlock_take()  - Take some other re-entrant network lock, for
+ *                       example the lock of one network device.
+ *   net_rlock_give()  - Release that lock.
  *   net_lockedwait()  - Like pthread_cond_wait() except releases the
  *                       network momentarily to wait on another semaphore.
  *   net_ioballoc()    - Like iob_alloc() except releases the network
@@ -327,6 +351,30 @@ void net_lock(void);
 
 void net_unlock(void);
 
+/****************************************************************************
+ * Name: net_rlock_init, net_rlock_take, and net_rlock_give
+ *
+ * Description:
+ *   Initialize, take, or release a re-entrant network lock.  The same
+ *   thread may take a lock that it already holds; the lock is released
+ *   when each take has been matched by a give.  net_lock() and
+ *   net_unlock() are these operations applied to the global network lock.
+ *
+ *   Finer grained locks are always taken after (inside of) the global
+ *   network lock:  A thread holding one must not then call net_lock().
+ *
+ * Input Parameters:
+ *   lock - The lock to operate on.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_rlock_init(FAR struct net_rlock_s *lock);
+void net_rlock_take(FAR struct net_rlock_s *lock);
+void net_rlock_give(FAR struct net_rlock_s *lock);
+
 /****************************************************************************
  * Name: net_timedwait
  *
@@ -388,6 +436,7 @@ int net_lockedwait(sem_t *sem);
  *
  * Input Parameters:
  *   throttled - An indication of the IOB allocation is "throttled"
+ *   user      - The consumer that the IOB is charged to
  *
  * Returned Value:
  *   A pointer to the newly allocated IOB is returned on success.  NULL is
@@ -396,8 +445,7 @@ int net_lockedwait(sem_t *sem);
  ****************************************************************************/
 
 #ifdef CONFIG_MM_IOB
-struct iob_s;  /* Forward reference */
-FAR struct iob_s *net_ioballoc(bool throttled);
+FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e user);
 #endif
 
 /****************************************************************************
@@ -967,6 +1015,105 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket in one
+ *   call.  It is functionally equivalent to recvmmsg() except that it is
+ *   not a cancellation point, does not modify errno, and accepts the
+ *   internal socket structure as input.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message descriptions
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Receive flags
+ *   timeout - Time limit for the batch (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If the first
+ *   message could not be received, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+struct mmsghdr;
+struct timespec;
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' messages on a socket in one call.
+ *   It is functionally equivalent to sendmmsg() except that it is not a
+ *   cancellation point, does not modify errno, and accepts the internal
+ *   socket structure as input.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message descriptions
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  If the first message
+ *   could not be sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives data into all of the I/O vector entries of
+ *   'msg'.  It is functionally equivalent to recvmsg() except that it is
+ *   not a cancellation point, does not modify errno, and accepts the
+ *   internal socket structure as input.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msg     - The message description to receive into
+ *   flags   - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On failure, a
+ *   negated errno value is returned.
+ *
+ ****************************************************************************/
+
+struct msghdr;
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends the data of all of the I/O vector entries of
+ *   'msg'.  It is functionally equivalent to sendmsg() except that it is
+ *   not a cancellation point, does not modify errno, and accepts the
+ *   internal socket structure as input.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msg     - The message to send
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On failure, a
+ *   negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
@@ -363,6 +363,15 @@
 #  endif
 #endif
 
+/* The number of TCP connections added to the pool at a time when all of
+ * the CONFIG_NET_TCP_CONNS pre-allocated connections are in use.  Zero
+ * disables dynamic allocation of TCP connections.
+ */
+
+#ifndef CONFIG_NET_TCP_ALLOC_CONNS
+#  define CONFIG_NET_TCP_ALLOC_CONNS 0
+#endif
+
 /* The maximum number of simultaneously listening TCP ports.
  *
  * Each listening TCP port requires 2 bytes of memory.
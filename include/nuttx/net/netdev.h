@@ -51,6 +51,7 @@
 
 #include <sys/ioctl.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef CONFIG_NET_MCASTGROUP
 #  include <queue.h>
@@ -61,7 +62,11 @@
 #include <arpa/inet.h>
 
 #include <nuttx/net/netconfig.h>
+#include <nuttx/net/netlatency.h>
 #include <nuttx/net/ip.h>
+#ifdef CONFIG_NETDEV_LOCK
+#  include <nuttx/net/net.h>
+#endif
 
 #ifdef CONFIG_NET_IGMP
 #  include <nuttx/net/igmp.h>
@@ -95,6 +100,33 @@
 #  define RADIO_MAX_ADDRLEN CONFIG_PKTRADIO_ADDRLEN
 #endif
 
+/* Checksum offload capabilities.  These are the bits of the d_txcsum and
+ * d_rxcsum fields of struct net_driver_s.  For transmission, the network
+ * leaves the corresponding checksum field zero and the MAC inserts it.  On
+ * reception, the driver only passes frames up whose corresponding checksums
+ * the MAC has verified; frames with bad checksums are discarded by the
+ * driver.  The TCP and UDP checksums over IPv6 have separate bits because
+ * the hardware must also support the IPv6 pseudo-header.
+ */
+
+#define NETDEV_CSUM_IPV4     (1 << 0)  /* IPv4 header checksum */
+#define NETDEV_CSUM_TCPV4    (1 << 1)  /* TCP checksum over IPv4 */
+#define NETDEV_CSUM_UDPV4    (1 << 2)  /* UDP checksum over IPv4 */
+#define NETDEV_CSUM_TCPV6    (1 << 3)  /* TCP checksum over IPv6 */
+#define NETDEV_CSUM_UDPV6    (1 << 4)  /* UDP checksum over IPv6 */
+
+#define NETDEV_CSUM_ALL      (NETDEV_CSUM_IPV4  | NETDEV_CSUM_TCPV4 | \
+                              NETDEV_CSUM_UDPV4 | NETDEV_CSUM_TCPV6 | \
+                              NETDEV_CSUM_UDPV6)
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+#  define NETDEV_TXCSUM(dev,f) (((dev)->d_txcsum & (f)) != 0)
+#  define NETDEV_RXCSUM(dev,f) (((dev)->d_rxcsum & (f)) != 0)
+#else
+#  define NETDEV_TXCSUM(dev,f) (false)
+#  define NETDEV_RXCSUM(dev,f) (false)
+#endif
+
 /* Helper macros for network device statistics */
 
 #ifdef CONFIG_NETDEV_STATISTICS
@@ -137,6 +169,18 @@
 
 #  define NETDEV_ERRORS(dev)      _NETDEV_STATISTIC(dev,errors)
 
+#  ifdef CONFIG_NETDEV_NAPI
+#    define NETDEV_NAPISCHEDS(dev)    _NETDEV_STATISTIC(dev,napi_scheds)
+#    define NETDEV_NAPIPOLLS(dev)     _NETDEV_STATISTIC(dev,napi_polls)
+#    define NETDEV_NAPIEXHAUSTED(dev) _NETDEV_STATISTIC(dev,napi_exhausted)
+#    define NETDEV_NAPIHOLDOFFS(dev)  _NETDEV_STATISTIC(dev,napi_holdoffs)
+#  else
+#    define NETDEV_NAPISCHEDS(dev)
+#    define NETDEV_NAPIPOLLS(dev)
+#    define NETDEV_NAPIEXHAUSTED(dev)
+#    define NETDEV_NAPIHOLDOFFS(dev)
+#  endif
+
 #else
 #  define NETDEV_RESET_STATISTICS(dev)
 #  define NETDEV_RXPACKETS(dev)
@@ -153,6 +197,11 @@
 #  define NETDEV_TXTIMEOUTS(dev)
 
 #  define NETDEV_ERRORS(dev)
+
+#  define NETDEV_NAPISCHEDS(dev)
+#  define NETDEV_NAPIPOLLS(dev)
+#  define NETDEV_NAPIEXHAUSTED(dev)
+#  define NETDEV_NAPIHOLDOFFS(dev)
 #endif
 
 /****************************************************************************
@@ -190,6 +239,15 @@ struct netdev_statistics_s
   uint32_t tx_errors;      /* Number of receive errors (incl timeouts) */
   uint32_t tx_timeouts;    /* Number of Tx timeout errors */
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* NAPI polled receive */
+
+  uint32_t napi_scheds;    /* Interrupts that entered polled mode */
+  uint32_t napi_polls;     /* Number of polls performed */
+  uint32_t napi_exhausted; /* Polls that used the entire budget */
+  uint32_t napi_holdoffs;  /* Interrupt re-enables deferred under load */
+#endif
+
   /* Other status */
 
   uint32_t errors;         /* Total umber of errors */
@@ -223,6 +281,7 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference See iob.h */
 
 struct net_driver_s
 {
@@ -340,10 +399,38 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NETDEV_TXIOB
+  /* Scatter-gather transmit.  A driver that can transmit a packet from
+   * d_buf followed by an I/O buffer chain sets d_txiob before registering
+   * the device.  The payload of buffered TCP segments will then not be
+   * copied to d_appdata:  Instead, d_buf holds only the first
+   * d_len - d_sndlen bytes of the packet (the link layer, IP and TCP
+   * headers) and the d_sndlen bytes of payload follow in the chain d_iob,
+   * beginning at offset d_iobofs.  d_iob is NULL if the whole packet is in
+   * d_buf.
+   */
+
+  bool d_txiob;                 /* Driver supports scatter-gather transmit */
+  FAR struct iob_s *d_iob;      /* I/O buffer chain with the TCP payload */
+  uint16_t d_iobofs;            /* Offset to the payload in d_iob */
+#endif
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  /* Checksum offload capabilities (NETDEV_CSUM_* bits), set by the driver
+   * before registering the device.
+   */
+
+  uint8_t d_txcsum;             /* Checksums inserted by the MAC */
+  uint8_t d_rxcsum;             /* Checksums verified by the MAC */
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
   sq_queue_t d_igmp_grplist;    /* IGMP group list */
+#ifdef CONFIG_NET_IGMP_GRPHASH
+  FAR struct igmp_group_s *d_igmp_grphash[CONFIG_NET_IGMP_GRPHASH_NBUCKETS];
+#endif
 #endif
 #ifdef CONFIG_NET_MLD
   struct mld_netdev_s d_mld;    /* MLD state information */
@@ -358,6 +445,16 @@ struct net_driver_s
   struct netdev_statistics_s d_statistics;
 #endif
 
+#ifdef CONFIG_NET_LATENCY
+  /* Packet latency tracing.  d_rxstamp is the RX time stamp provided by the
+   * driver for the next packet (see NETDEV_RXSTAMP()) or zero.  d_latency
+   * holds the trace of the packet that is currently being processed.
+   */
+
+  uint32_t d_rxstamp;
+  struct net_latency_s d_latency;
+#endif
+
   /* Application callbacks:
    *
    * Network device event handlers are retained in a 'list' and are called
@@ -396,6 +493,12 @@ struct net_driver_s
                  unsigned long arg);
 #endif
 
+#ifdef CONFIG_NETDEV_LOCK
+  /* Per-device lock.  See netdev_lock() */
+
+  struct net_rlock_s d_lock;
+#endif
+
   /* Drivers may attached device-specific, private information */
 
   void *d_private;
@@ -482,7 +585,6 @@ int ipv6_input(FAR struct net_driver_s *dev);
 
 #ifdef CONFIG_NET_6LOWPAN
 struct radio_driver_s;   /* Forward reference.  See radiodev.h */
-struct iob_s;            /* Forward reference See iob.h */
 
 int sixlowpan_input(FAR struct radio_driver_s *ieee,
                     FAR struct iob_s *framelist, FAR const void *metadata);
@@ -760,4 +862,29 @@ uint16_t ipv6_chksum(FAR struct net_driver_s *dev);
 
 int netdev_lladdrsize(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_lock / netdev_unlock
+ *
+ * Description:
+ *   Take or release the re-entrant lock of one network device.  The device
+ *   lock nests inside of the global network lock:  It may be taken while
+ *   holding net_lock(), but never the reverse.  Without
+ *   CONFIG_NETDEV_LOCK, these fall back to the global network lock.
+ *
+ * Input Parameters:
+ *   dev - A reference to the device to lock or unlock
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_LOCK
+#  define netdev_lock(dev)   net_rlock_take(&(dev)->d_lock)
+#  define netdev_unlock(dev) net_rlock_give(&(dev)->d_lock)
+#else
+#  define netdev_lock(dev)   net_lock()
+#  define netdev_unlock(dev) net_unlock()
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
@@ -0,0 +1,211 @@
+/****************************************************************************
+ * include/nuttx/net/netlatency.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NET_NETLATENCY_H
+#define __INCLUDE_NUTTX_NET_NETLATENCY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#ifdef CONFIG_NET_LATENCY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each histogram has NET_LATENCY_NBUCKETS power-of-two buckets in units of
+ * microseconds:  Bucket 0 counts latencies below 2 usec, bucket n counts
+ * latencies in [2^n, 2^(n+1)) usec, and the last bucket counts everything
+ * longer.
+ */
+
+#define NET_LATENCY_NBUCKETS 16
+
+/* A network driver may record the time that the hardware received the
+ * packet (typically in its RX interrupt handler) so that the time spent in
+ * the driver and its work queue is included in the trace.  The time stamp
+ * applies to the next packet passed to ipv4_input() or ipv6_input().
+ */
+
+#define NETDEV_RXSTAMP(dev)  ((dev)->d_rxstamp = net_latency_now())
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* These are the stages of a received packet whose latencies are measured */
+
+enum net_latency_stage_e
+{
+  NET_LATENCY_DRIVER = 0,      /* RX interrupt to IP input */
+  NET_LATENCY_IP,              /* IP input to TCP input */
+  NET_LATENCY_TCP,             /* TCP input to delivery to the socket */
+  NET_LATENCY_RECV,            /* Delivery to recv() returning the data */
+  NET_LATENCY_TOTAL,           /* First time stamp to recv() returning */
+  NET_LATENCY_NSTAGES
+};
+
+/* The time stamps of one traced packet.  A zero lt_start means that the
+ * packet is not being traced.
+ */
+
+struct net_latency_s
+{
+  uint32_t lt_start;           /* Time of the first time stamp */
+  uint32_t lt_last;            /* Time that the last stage was reached */
+};
+
+/* The latency histogram of one stage */
+
+struct net_lathist_s
+{
+  uint32_t lh_count;           /* Number of samples */
+  uint32_t lh_max;             /* Longest latency (usec) */
+  uint64_t lh_total;           /* Sum of all latencies (usec) */
+  uint32_t lh_bucket[NET_LATENCY_NBUCKETS];
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* The latency histograms of each stage, since boot */
+
+EXTERN struct net_lathist_s g_netlatency[NET_LATENCY_NSTAGES];
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_latency_now
+ *
+ * Description:
+ *   Return the current time in the units used by the packet time stamps.
+ *   This is the up_perf_gettime() counter if the architecture has one,
+ *   otherwise the system timer.  Zero is never returned.
+ *
+ ****************************************************************************/
+
+uint32_t net_latency_now(void);
+
+/****************************************************************************
+ * Name: net_latency_input
+ *
+ * Description:
+ *   Start the trace of a packet received on 'dev'.  This is called on
+ *   entry to ipv4_input() and ipv6_input().  If the driver provided an RX
+ *   time stamp, the driver stage is recorded and the time stamp consumed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+struct net_driver_s;
+void net_latency_input(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: net_latency_stage
+ *
+ * Description:
+ *   Record the time since the last stage of the traced packet 'lat' in the
+ *   histogram of 'stage'.  Nothing is done if the packet is not traced.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_latency_stage(FAR struct net_latency_s *lat, int stage);
+
+/****************************************************************************
+ * Name: net_latency_deliver
+ *
+ * Description:
+ *   The TCP data of the packet being processed on 'dev' has been delivered
+ *   to a socket.  Record the TCP stage and move the trace to 'dest', which
+ *   is kept with the data until recv() returns it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_latency_deliver(FAR struct net_driver_s *dev,
+                         FAR struct net_latency_s *dest);
+
+/****************************************************************************
+ * Name: net_latency_done
+ *
+ * Description:
+ *   recv() is about to return the data of the traced packet 'lat'.  Record
+ *   the final stage and the total latency and end the trace.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_latency_done(FAR struct net_latency_s *lat);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#else /* CONFIG_NET_LATENCY */
+
+#  define NETDEV_RXSTAMP(dev)
+#  define net_latency_input(dev)
+#  define net_latency_stage(lat,stage)
+#  define net_latency_deliver(dev,dest)
+#  define net_latency_done(lat)
+
+#endif /* CONFIG_NET_LATENCY */
+#endif /* __INCLUDE_NUTTX_NET_NETLATENCY_H */
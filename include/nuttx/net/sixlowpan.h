@@ -384,6 +384,10 @@ struct sixlowpan_reassbuf_s
 
   FAR struct sixlowpan_reassbuf_s *rb_flink;
 
+  /* Supports the singly linked hash chain used for reassembly lookup */
+
+  FAR struct sixlowpan_reassbuf_s *rb_hlink;
+
   /* Fragmentation is handled frame by frame and requires that certain
    * state information be retained from frame to frame.  That additional
    * information follows the externally visible packet buffer.
@@ -44,6 +44,7 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <sys/uio.h>
 #include <nuttx/net/ioctl.h>
 
 #ifdef CONFIG_NET_TUN
@@ -56,13 +57,25 @@
 
 #define IFF_TUN          0x01
 #define IFF_TAP          0x02
-#define IFF_MASK         0x7f
+#define IFF_MASK         0x3f
+#define IFF_MULTI_QUEUE  0x40   /* Attach another queue to the interface */
 #define IFF_NO_PI        0x80
 
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
+/* Argument of the TUNREADV and TUNWRITEV ioctls.  Each entry of the I/O
+ * vector holds one packet.  TUNREADV sets iov_len of each filled entry to
+ * the length of its packet.  Both return the number of packets.
+ */
+
+struct tun_batch_s
+{
+  FAR struct iovec *tb_iov;      /* One packet per entry */
+  int               tb_iovcnt;   /* Number of entries in tb_iov */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -669,6 +669,23 @@ NXHANDLE nxf_cache_getfonthandle(FCACHE fhandle);
 
 FAR const struct nxfonts_glyph_s *nxf_cache_getglyph(FCACHE fhandle, uint8_t ch);
 
+/****************************************************************************
+ * Name: nxf_cache_getglyphs
+ *
+ * Description:
+ *   Get the font glyphs for each of the 'nchars' character codes in 'str'
+ *   from the font cache, rendering any glyphs that are not yet cached.  The
+ *   font cache is locked only once for the whole string.  An entry in
+ *   'glyphs' is set to NULL if there is no glyph for that character.
+ *
+ * Returned Value:
+ *   The number of non-NULL glyphs returned in 'glyphs'.
+ *
+ ****************************************************************************/
+
+int nxf_cache_getglyphs(FCACHE fhandle, FAR const uint8_t *str, int nchars,
+                        FAR const struct nxfonts_glyph_s **glyphs);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -70,8 +70,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <queue.h>
 
+#include <nuttx/clock.h>
+
 #ifdef CONFIG_PM
 
 /****************************************************************************
@@ -274,6 +277,28 @@ enum pm_state_e
   PM_COUNT,
 };
 
+#ifdef CONFIG_PM_GOVERNOR
+/* The board describes the cost of each power state with an array of these
+ * (one entry per state, see pm_setlatency()):  With CONFIG_PM_GOVERNOR,
+ * pm_checkstate() will not recommend a state unless the next watchdog
+ * expires more than exit_us + residency_us after now.
+ */
+
+struct pm_latency_s
+{
+  uint32_t exit_us;      /* Time needed to resume PM_NORMAL from the state */
+  uint32_t residency_us; /* Minimum time in the state to save any energy */
+};
+
+/* Residency statistics of one power state (see pm_residency()) */
+
+struct pm_residency_s
+{
+  uint32_t count;        /* Number of times that the state was entered */
+  clock_t  ticks;        /* Total time spent in the state */
+};
+#endif
+
 /* This structure contain pointers callback functions in the driver.  These
  * callback functions can be used to provide power management information
  * to the driver.
@@ -590,6 +615,48 @@ int pm_changestate(int domain, enum pm_state_e newstate);
 
 enum pm_state_e pm_querystate(int domain);
 
+#ifdef CONFIG_PM_GOVERNOR
+/****************************************************************************
+ * Name: pm_setlatency
+ *
+ * Description:
+ *   Provide the exit latency and the target residency of each power state
+ *   of a domain.  Until this is called, pm_checkstate() recommends states
+ *   based only on the activity of the domain.
+ *
+ * Input Parameters:
+ *   domain  - The PM domain
+ *   latency - An array of PM_COUNT entries indexed by enum pm_state_e.
+ *             The array must persist.  NULL disables the governor.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_setlatency(int domain, FAR const struct pm_latency_s *latency);
+
+/****************************************************************************
+ * Name: pm_residency
+ *
+ * Description:
+ *   Return the residency statistics of one power state of a domain.  The
+ *   time spent in the current state so far is included.
+ *
+ * Input Parameters:
+ *   domain - The PM domain
+ *   state  - The power state
+ *   res    - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_residency(int domain, enum pm_state_e state,
+                  FAR struct pm_residency_s *res);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -616,6 +683,7 @@ enum pm_state_e pm_querystate(int domain);
 #  define pm_checkstate(domain)        (0)
 #  define pm_changestate(domain,state) (0)
 #  define pm_querystate(domain)        (0)
+#  define pm_setlatency(domain,lat)
 
 #endif /* CONFIG_PM */
 #endif /* __INCLUDE_NUTTX_POWER_PM_H */
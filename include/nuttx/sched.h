@@ -123,6 +123,13 @@
 #  define CONFIG_SCHED_SPORADIC_MAXREPL 3
 #endif
 
+/* Preallocated signal actions per thread */
+
+#if defined(CONFIG_DISABLE_SIGNALS) || !defined(CONFIG_SIG_PREALLOC_TCB)
+#  undef CONFIG_SIG_PREALLOC_TCB
+#  define CONFIG_SIG_PREALLOC_TCB 0
+#endif
+
 /* Task Management Definitions **************************************************/
 /* Special task IDS.  Any negative PID is invalid. */
 
@@ -143,15 +150,18 @@
 #define TCB_FLAG_NONCANCELABLE     (1 << 2) /* Bit 2: Pthread is non-cancelable */
 #define TCB_FLAG_CANCEL_DEFERRED   (1 << 3) /* Bit 3: Deferred (vs asynch) cancellation type */
 #define TCB_FLAG_CANCEL_PENDING    (1 << 4) /* Bit 4: Pthread cancel is pending */
-#define TCB_FLAG_POLICY_SHIFT      (5) /* Bit 5-6: Scheduling policy */
-#define TCB_FLAG_POLICY_MASK       (3 << TCB_FLAG_POLICY_SHIFT)
+#define TCB_FLAG_POLICY_SHIFT      (5) /* Bit 5-7: Scheduling policy */
+#define TCB_FLAG_POLICY_MASK       (7 << TCB_FLAG_POLICY_SHIFT)
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT) /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT) /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT) /* Sporadic scheding policy */
 #  define TCB_FLAG_SCHED_OTHER     (3 << TCB_FLAG_POLICY_SHIFT) /* Other scheding policy */
-#define TCB_FLAG_CPU_LOCKED        (1 << 7) /* Bit 7: Locked to this CPU */
-#define TCB_FLAG_EXIT_PROCESSING   (1 << 8) /* Bit 8: Exitting */
-                                            /* Bits 9-15: Available */
+#  define TCB_FLAG_SCHED_DEADLINE  (4 << TCB_FLAG_POLICY_SHIFT) /* Deadline scheding policy */
+#define TCB_FLAG_CPU_LOCKED        (1 << 8) /* Bit 8: Locked to this CPU */
+#define TCB_FLAG_EXIT_PROCESSING   (1 << 9) /* Bit 9: Exitting */
+#define TCB_FLAG_STACK_CACHED      (1 << 10) /* Bit 10: Stack may be cached for re-use */
+#define TCB_FLAG_COND_MORPHED      (1 << 11) /* Bit 11: Moved from condition to mutex wait */
+                                            /* Bits 12-15: Available */
 
 /* Values for struct task_group tg_flags */
 
@@ -348,6 +358,26 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s *************************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* This structure holds the SCHED_DEADLINE parameters and state of a thread.
+ * The remaining budget of the current period is kept in the timeslice field
+ * of the TCB.
+ */
+
+struct deadline_s
+{
+  int32_t   runtime;                /* Execution budget per period (ticks)      */
+  int32_t   reldeadline;            /* Relative deadline (ticks)                */
+  int32_t   period;                 /* Period (ticks)                           */
+  uint32_t  density;                /* runtime / min(deadline, period) in ppm   */
+  clock_t   absdeadline;            /* Absolute deadline of the current period  */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s *********************************************************/
 /* This structure is used to maintain information about child tasks.  pthreads
  * work differently, they have join information.  This is only for child tasks.
@@ -553,6 +583,11 @@ struct task_group_s
 
   size_t     tg_envsize;            /* Size of environment string allocation    */
   FAR char  *tg_envp;               /* Allocated environment strings            */
+#ifdef CONFIG_ENV_INDEX
+  FAR uint16_t *tg_envndx;          /* Hash index: offset+1 of each variable    */
+  uint16_t   tg_envndxmask;         /* Number of index slots minus one          */
+  uint16_t   tg_envndxused;         /* Number of used index slots               */
+#endif
 #endif
 
   /* PIC data space and address environments ************************************/
@@ -659,13 +694,17 @@ struct tcb_s
   int16_t  cpcount;                      /* Nested cancellation point count     */
 #endif
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
-  int32_t  timeslice;                    /* RR timeslice OR Sporadic budget     */
-                                         /* interval remaining                  */
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
+  int32_t  timeslice;                    /* RR timeslice OR Sporadic/Deadline   */
+                                         /* budget interval remaining           */
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters      */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  struct deadline_s deadline;            /* Deadline scheduling parameters      */
+#endif
 
   FAR struct wdog_s *waitdog;            /* All timed waits use this timer      */
 
@@ -697,6 +736,13 @@ struct tcb_s
   sq_queue_t sigpendactionq;             /* List of pending signal actions      */
   sq_queue_t sigpostedq;                 /* List of posted signals              */
   siginfo_t  sigunbinfo;                 /* Signal info when task unblocked     */
+#if CONFIG_SIG_PREALLOC_TCB > 0
+  sq_queue_t sigactfree;                 /* Free preallocated signal actions    */
+  FAR void  *sigactpool;                 /* Preallocated signal actions         */
+#endif
+#ifdef CONFIG_SIG_COALESCE
+  sigset_t   sigactpend;                 /* Pending non-queued signal actions   */
+#endif
 #endif
 
   /* POSIX Named Message Queue Fields *******************************************/
@@ -718,6 +764,16 @@ struct tcb_s
   uint32_t premp_max;                    /* Max time preemption disabled        */
   uint32_t crit_start;                   /* Time critical section entered       */
   uint32_t crit_max;                     /* Max time in critical section        */
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+  FAR void *premp_caller;                /* Caller of sched_lock()              */
+  FAR void *crit_caller;                 /* Caller of enter_critical_section()  */
+#endif
+#endif
+
+  /* CPU time accounting support ************************************************/
+
+#ifdef CONFIG_SCHED_CPUTIME
+  uint64_t cputime;                      /* Run time in up_perf_gettime() units */
 #endif
 
   /* Library related fields *****************************************************/
@@ -803,6 +859,25 @@ struct pthread_tcb_s
 };
 #endif /* !CONFIG_DISABLE_PTHREAD */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+/* One call site of enter_critical_section() or sched_lock() */
+
+struct critmon_hotspot_s
+{
+  FAR void *caller;                      /* Return address of the call          */
+  uint32_t count;                        /* Number of times held                */
+  uint32_t max;                          /* Max time held (critmon units)       */
+};
+
+/* The longest and the most frequent holders of one CPU */
+
+struct critmon_hotspots_s
+{
+  struct critmon_hotspot_s longest[CONFIG_SCHED_CRITMONITOR_NHOTSPOTS];
+  struct critmon_hotspot_s frequent[CONFIG_SCHED_CRITMONITOR_NHOTSPOTS];
+};
+#endif
+
 /* This is the callback type used by sched_foreach() */
 
 typedef void (*sched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
@@ -833,6 +908,18 @@ EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_premp_max[1];
 EXTERN uint32_t g_crit_max[1];
 #endif
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+/* Call sites that kept pre-emption disabled or held the critical section */
+
+#ifdef CONFIG_SMP_NCPUS
+EXTERN struct critmon_hotspots_s g_premp_hotspots[CONFIG_SMP_NCPUS];
+EXTERN struct critmon_hotspots_s g_crit_hotspots[CONFIG_SMP_NCPUS];
+#else
+EXTERN struct critmon_hotspots_s g_premp_hotspots[1];
+EXTERN struct critmon_hotspots_s g_crit_hotspots[1];
+#endif
+#endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
 /********************************************************************************
@@ -45,6 +45,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdarg.h>
 
 #include <nuttx/sched.h>
 
@@ -66,6 +67,23 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+#ifndef CONFIG_SCHED_NOTE_DUMP_MAXLEN
+#  define CONFIG_SCHED_NOTE_DUMP_MAXLEN 64
+#endif
+
+#ifndef CONFIG_SCHED_NOTE_CATEGORIES
+#  define CONFIG_SCHED_NOTE_CATEGORIES 0xffffffff
+#endif
+
+/* True if user notes of category 'c' (0-31) are currently being recorded.
+ * Callers may use this to avoid preparing the arguments of a note that
+ * will be discarded.
+ */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+#  define sched_note_enabled(c) ((g_note_categories & (1ul << (c))) != 0)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -106,6 +124,13 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+  ,
+  NOTE_DUMP_STRING     = 18,
+  NOTE_DUMP_BEGIN      = 19,
+  NOTE_DUMP_END        = 20,
+  NOTE_DUMP_PRINTF     = 21
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -234,8 +259,51 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+/* This is the specific form of the NOTE_DUMP_STRING/BEGIN/END notes */
+
+struct note_string_s
+{
+  struct note_common_s nst_cmn; /* Common note parameters */
+  uint8_t nst_category;         /* User category (0-31) */
+  char    nst_data[1];          /* Start of the NUL terminated string */
+};
+
+/* This is the specific form of the NOTE_DUMP_PRINTF note.  The format
+ * string is followed immediately by the arguments, packed in order without
+ * padding in little endian byte order:
+ *
+ *   - Integers with no length modifier (or h, hh) and '*' widths and
+ *     precisions:  4 bytes
+ *   - Integers with an l, ll, j, z, or t modifier, pointers, and floating
+ *     point (as double):  8 bytes
+ *   - Strings:  The NUL terminated string itself.
+ *
+ * The note ends where the arguments were truncated, if they did not fit.
+ * The format is rendered on the host (see tools/note2trace.c).
+ */
+
+struct note_printf_s
+{
+  struct note_common_s npt_cmn; /* Common note parameters */
+  uint8_t npt_category;         /* User category (0-31) */
+  uint8_t npt_fmtlen;           /* Length of the format string (no NUL) */
+  uint8_t npt_data[1];          /* Format string followed by arguments */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_DUMP */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+/* Mask of user note categories that are being recorded */
+
+extern volatile uint32_t g_note_categories;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -348,6 +416,30 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen);
 ssize_t sched_note_size(void);
 #endif
 
+/****************************************************************************
+ * Name: sched_note_getbuf
+ *
+ * Description:
+ *   Remove as many complete notes as will fit from the circular buffer(s)
+ *   and copy them to the user buffer.  The notes from each CPU are in
+ *   order, but notes from different CPUs are not merged by time.
+ *
+ * Input Parameters:
+ *   buffer - Location to return the notes
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   On success, the total length of the returned notes is provided.  Zero
+ *   is returned only if the circular buffer is empty.  -EFBIG is returned
+ *   (and the note is discarded) if not even the first note will fit.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
+    defined(CONFIG_SCHED_NOTE_GET)
+ssize_t sched_note_getbuf(FAR uint8_t *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: note_register
  *
@@ -369,7 +461,82 @@ ssize_t sched_note_size(void);
 int note_register(void);
 #endif
 
-#else /* CONFIG_SCHED_INSTRUMENTATION */
+/****************************************************************************
+ * Name: sched_note_string, sched_note_begin, sched_note_end
+ *
+ * Description:
+ *   Add a user note to the note stream so that application and driver
+ *   events can be correlated with scheduler events.  sched_note_string()
+ *   records a single event; sched_note_begin() and sched_note_end() bracket
+ *   a duration (e.g., a FLASH erase) and must be called by the same thread
+ *   with the same name.  Strings longer than CONFIG_SCHED_NOTE_DUMP_MAXLEN
+ *   are truncated.
+ *
+ *   The note is discarded if 'category' is not enabled in the category
+ *   mask (see sched_note_filter()).
+ *
+ * Input Parameters:
+ *   category - The user category of the note (0-31)
+ *   str/name - The string recorded with the note
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_note_printf and sched_note_vprintf
+ *
+ * Description:
+ *   Add a printf-style user note.  The format is not rendered on the
+ *   target:  The format string is copied and the arguments are packed in
+ *   binary (see struct note_printf_s), which is much cheaper than
+ *   formatting.  Conversions are interpreted as by printf(); %n is not
+ *   supported.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_note_filter
+ *
+ * Description:
+ *   Set the mask of user note categories that are recorded.  Bit n enables
+ *   category n.  The initial mask is CONFIG_SCHED_NOTE_CATEGORIES.
+ *
+ * Returned Value:
+ *   The previous mask.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+void sched_note_string(uint8_t category, FAR const char *str);
+void sched_note_begin(uint8_t category, FAR const char *name);
+void sched_note_end(uint8_t category, FAR const char *name);
+void sched_note_printf(uint8_t category, FAR const char *fmt, ...);
+void sched_note_vprintf(uint8_t category, FAR const char *fmt, va_list ap);
+uint32_t sched_note_filter(uint32_t categories);
+#endif
+
+#endif /* CONFIG_SCHED_INSTRUMENTATION */
+
+#ifndef CONFIG_SCHED_INSTRUMENTATION_DUMP
+#  define sched_note_enabled(c)        (false)
+#  define sched_note_string(c,s)
+#  define sched_note_begin(c,n)
+#  define sched_note_end(c,n)
+#  define sched_note_vprintf(c,f,a)
+#  define sched_note_filter(c)         (0)
+#  ifdef CONFIG_CPP_HAVE_VARARGS
+#    define sched_note_printf(c,f,...)
+#  else
+#    define sched_note_printf          (void)
+#  endif
+#endif
+
+#ifndef CONFIG_SCHED_INSTRUMENTATION
 
 #  define sched_note_start(t)
 #  define sched_note_stop(t)
@@ -388,5 +555,5 @@ int note_register(void);
 #  define sched_note_spinunlock(t,s)
 #  define sched_note_spinabort(t,s)
 
-#endif /* CONFIG_SCHED_INSTRUMENTATION */
+#endif /* !CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
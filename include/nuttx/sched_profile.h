@@ -0,0 +1,179 @@
+/****************************************************************************
+ * include/nuttx/sched_profile.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SCHED_PROFILE_H
+#define __INCLUDE_NUTTX_SCHED_PROFILE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SCHED_PROFILE_BUFSIZE
+#  define CONFIG_SCHED_PROFILE_BUFSIZE 1024
+#endif
+
+#ifndef CONFIG_SCHED_PROFILE_INTERVAL
+#  define CONFIG_SCHED_PROFILE_INTERVAL 1
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This is the binary format of one profile sample as returned by
+ * sched_profile_getbuf() and read from /dev/profile.  Multi-byte values are
+ * in the native byte order of the target.  tools/profile2folded depends on
+ * this layout.
+ */
+
+struct profile_sample_s
+{
+  uint32_t ps_pc;          /* The interrupted program counter */
+  uint16_t ps_pid;         /* ID of the thread that was running */
+  uint8_t  ps_cpu;         /* CPU that took the sample */
+  uint8_t  ps_pad;         /* Reserved, always zero */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: sched_profile_sample
+ *
+ * Description:
+ *   Take one profile sample.  This must be called from the system timer
+ *   interrupt handler of each CPU with the program counter that was
+ *   interrupted, i.e., from the saved register state of the interrupt.
+ *   Only every CONFIG_SCHED_PROFILE_INTERVAL'th call takes a sample, and
+ *   only while profiling is enabled.  The sample is discarded if the buffer
+ *   of the CPU is full.
+ *
+ * Input Parameters:
+ *   pc - The interrupted program counter
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_profile_sample(uintptr_t pc);
+
+/****************************************************************************
+ * Name: sched_profile_enable
+ *
+ * Description:
+ *   Start or stop profiling.  Starting discards any old samples.
+ *
+ * Input Parameters:
+ *   enable - True to start taking samples; false to stop.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_profile_enable(bool enable);
+
+/****************************************************************************
+ * Name: sched_profile_getbuf
+ *
+ * Description:
+ *   Remove as many samples as will fit from the per-CPU sample buffers and
+ *   copy them to the user buffer.  The buffers of the CPUs are drained in
+ *   turn, so the samples of different CPUs are not merged by time.
+ *
+ * Input Parameters:
+ *   buffer   - Location to return the samples.  It need not be aligned.
+ *   nsamples - The number of samples that will fit in the buffer
+ *
+ * Returned Value:
+ *   The number of samples returned.  Zero if no samples are available.
+ *
+ ****************************************************************************/
+
+size_t sched_profile_getbuf(FAR uint8_t *buffer, size_t nsamples);
+
+/****************************************************************************
+ * Name: profile_register
+ *
+ * Description:
+ *   Register a character driver at /dev/profile that can be used by an
+ *   application to read the profile samples.  Profiling is enabled while
+ *   the driver is open.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVER_PROFILE
+int profile_register(void);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#else /* CONFIG_SCHED_PROFILE */
+
+#  define sched_profile_sample(pc)
+
+#endif /* CONFIG_SCHED_PROFILE */
+#endif /* __INCLUDE_NUTTX_SCHED_PROFILE_H */
@@ -421,6 +421,7 @@
 #define SDIO_CAPS_1BIT_ONLY       0x01 /* Bit 0=1: Supports only 1-bit operation */
 #define SDIO_CAPS_DMASUPPORTED    0x02 /* Bit 1=1: Supports DMA data transfers */
 #define SDIO_CAPS_DMABEFOREWRITE  0x04 /* Bit 2=1: Executes DMA before write command */
+#define SDIO_CAPS_HIGHSPEED       0x08 /* Bit 3=1: Supports CLOCK_SD_TRANSFER_4BIT_HS */
 
 /****************************************************************************
  * Name: SDIO_STATUS
@@ -876,7 +877,8 @@ enum sdio_clock_e
   CLOCK_IDMODE,            /* Initial ID mode clocking (<400KHz) */
   CLOCK_MMC_TRANSFER,      /* MMC normal operation clocking */
   CLOCK_SD_TRANSFER_1BIT,  /* SD normal operation clocking (narrow 1-bit mode) */
-  CLOCK_SD_TRANSFER_4BIT   /* SD normal operation clocking (wide 4-bit mode) */
+  CLOCK_SD_TRANSFER_4BIT,  /* SD normal operation clocking (wide 4-bit mode) */
+  CLOCK_SD_TRANSFER_4BIT_HS /* SD high speed clocking (wide 4-bit, 50MHz) */
 };
 
 /* Event set.  A uint8_t is big enough to hold a set of 8-events.  If more are
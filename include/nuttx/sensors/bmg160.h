@@ -350,6 +350,11 @@
 
 /* FIFO Register Definitions ****************************************************************/
 
+/* BMG160 FIFO_STATUS_REG */
+
+#define BMG160_FIFO_STATUS_REG_OVERRUN_bm      (1 << 7)  /* FIFO overrun condition */
+#define BMG160_FIFO_STATUS_REG_COUNT_bm        (0x7f)    /* Number of frames in the FIFO */
+
 /* BMG160 FIFO_CONFIG_0_REG */
 
 #define BMG160_FIFO_CONFIG_0_REG_TAG_bm        (1 << 7)  /* Enables FIFO tag (interrupt) */
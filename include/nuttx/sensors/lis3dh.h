@@ -241,6 +241,7 @@
 
 struct lis3dh_sensor_data_s
 {
+  uint64_t timestamp;                /* Sample time in microseconds */
   float x_acc;                       /* X axis acceleration */
   float y_acc;                       /* Y axis acceleration */
   float z_acc;                       /* Z axis acceleration */
@@ -0,0 +1,175 @@
+/****************************************************************************
+ * include/nuttx/sensors/sensor_fifo.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SENSORS_SENSOR_FIFO_H
+#define __INCLUDE_NUTTX_SENSORS_SENSOR_FIFO_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <semaphore.h>
+
+#ifdef CONFIG_SENSORS_FIFO
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A sensor FIFO is a ring of fixed size samples in the upper half of a
+ * sensor driver.  The lower half drains the hardware FIFO of the sensor
+ * on its watermark interrupt and pushes the whole batch at once; read()
+ * then returns as many samples as fit into the user buffer.  When the
+ * ring is full, the oldest samples are overwritten.
+ *
+ * The sample layout is owned by the driver.  Drivers that provide
+ * timestamps keep them inside the sample, typically computed with
+ * sensor_fifo_timestamp() for the newest sample of a batch and spaced by
+ * the output data rate for the older ones.
+ */
+
+struct sensor_fifo_s
+{
+  sem_t exclsem;              /* Exclusive access to the ring */
+  sem_t waitsem;              /* Signalled when samples are pushed */
+  FAR uint8_t *buffer;        /* Ring storage, nslots * esize bytes */
+  uint16_t esize;             /* Size of one sample in bytes */
+  uint16_t nslots;            /* Capacity of the ring in samples */
+  uint16_t head;              /* Slot of the oldest sample */
+  uint16_t count;             /* Number of samples in the ring */
+  uint8_t nwaiters;           /* Number of readers waiting on waitsem */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: sensor_fifo_initialize
+ *
+ * Description:
+ *   Allocate the ring storage for 'nslots' samples of 'esize' bytes.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int sensor_fifo_initialize(FAR struct sensor_fifo_s *fifo, size_t esize,
+                           unsigned int nslots);
+
+/****************************************************************************
+ * Name: sensor_fifo_uninitialize
+ *
+ * Description:
+ *   Free the resources of a sensor FIFO.
+ *
+ ****************************************************************************/
+
+void sensor_fifo_uninitialize(FAR struct sensor_fifo_s *fifo);
+
+/****************************************************************************
+ * Name: sensor_fifo_reset
+ *
+ * Description:
+ *   Discard all samples in the ring, e.g. when the sensor is reconfigured.
+ *
+ ****************************************************************************/
+
+void sensor_fifo_reset(FAR struct sensor_fifo_s *fifo);
+
+/****************************************************************************
+ * Name: sensor_fifo_push
+ *
+ * Description:
+ *   Append 'nsamples' consecutive samples to the ring and wake up waiting
+ *   readers.  Must be called from thread context, normally the worker that
+ *   drains the hardware FIFO.
+ *
+ * Returned Value:
+ *   The number of old samples that were overwritten.
+ *
+ ****************************************************************************/
+
+unsigned int sensor_fifo_push(FAR struct sensor_fifo_s *fifo,
+                              FAR const void *samples,
+                              unsigned int nsamples);
+
+/****************************************************************************
+ * Name: sensor_fifo_read
+ *
+ * Description:
+ *   Copy as many whole samples as are available and fit into 'buffer'.
+ *   Unless 'nonblock' is set, wait until at least one sample is available.
+ *
+ * Returned Value:
+ *   The number of bytes copied; -EINVAL if 'buflen' is smaller than one
+ *   sample; -EAGAIN if 'nonblock' is set and the ring is empty.
+ *
+ ****************************************************************************/
+
+ssize_t sensor_fifo_read(FAR struct sensor_fifo_s *fifo, FAR char *buffer,
+                         size_t buflen, bool nonblock);
+
+/****************************************************************************
+ * Name: sensor_fifo_timestamp
+ *
+ * Description:
+ *   Return the current system time in microseconds.
+ *
+ ****************************************************************************/
+
+uint64_t sensor_fifo_timestamp(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SENSORS_FIFO */
+#endif /* __INCLUDE_NUTTX_SENSORS_SENSOR_FIFO_H */
@@ -120,6 +120,14 @@
 
 #endif
 
+#ifdef CONFIG_SERIAL_BLOCKOPS
+#define uart_sendblock(dev,b,n)  \
+  ((dev)->ops->sendblock ? (dev)->ops->sendblock(dev,b,n) : 0)
+
+#define uart_receiveblock(dev,b,n) \
+  ((dev)->ops->receiveblock ? (dev)->ops->receiveblock(dev,b,n) : 0)
+#endif
+
 #ifdef CONFIG_SERIAL_IFLOWCONTROL
 #  define uart_rxflowcontrol(dev,n,u) \
     (dev->ops->rxflowcontrol && dev->ops->rxflowcontrol(dev,n,u))
@@ -265,6 +273,20 @@ struct uart_ops_s
    */
 
   CODE bool (*txempty)(FAR struct uart_dev_s *dev);
+
+#ifdef CONFIG_SERIAL_BLOCKOPS
+  /* Optional methods for UARTs with FIFOs.  sendblock() writes as many of
+   * the 'buflen' bytes as the TX FIFO will accept without waiting and
+   * returns the number written.  receiveblock() reads up to 'buflen' bytes
+   * from the RX FIFO and returns the number read.  Either may be NULL.
+   * Both are called from the interrupt level.
+   */
+
+  CODE size_t (*sendblock)(FAR struct uart_dev_s *dev,
+                           FAR const char *buffer, size_t buflen);
+  CODE size_t (*receiveblock)(FAR struct uart_dev_s *dev, FAR char *buffer,
+                              size_t buflen);
+#endif
 };
 
 /* This is the device structure used by the driver.  The caller of
@@ -284,6 +306,7 @@ struct uart_dev_s
   uint8_t              open_count;   /* Number of times the device has been opened */
   volatile bool        xmitwaiting;  /* true: User waiting for space in xmit.buffer */
   volatile bool        recvwaiting;  /* true: User waiting for data in recv.buffer */
+  uint16_t             minrecv;      /* Buffered bytes needed to wake the reader */
 #ifdef CONFIG_SERIAL_REMOVABLE
   volatile bool        disconnected; /* true: Removable device is not connected */
 #endif
@@ -295,6 +318,10 @@ struct uart_dev_s
   tcflag_t             tc_iflag;     /* Input modes */
   tcflag_t             tc_oflag;     /* Output modes */
   tcflag_t             tc_lflag;     /* Local modes */
+#ifdef CONFIG_SERIAL_TERMIOS_MINTIME
+  cc_t                 tc_vmin;      /* VMIN: Minimum number of bytes per read */
+  cc_t                 tc_vtime;     /* VTIME: Read timeout (deciseconds) */
+#endif
 #if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGSTP)
   pid_t                pid;          /* Thread PID to receive signals (-1 if none) */
 #endif
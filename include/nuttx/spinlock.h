@@ -45,6 +45,8 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+#include <nuttx/irq.h>
+
 #ifdef CONFIG_SPINLOCK
 
 /* The architecture specific spinlock.h header file must also provide the
@@ -96,6 +98,14 @@
 #  define SP_SECTION
 #endif
 
+/* Static initializer for a re-entrant spinlock (struct spinlock_s) */
+
+#ifdef CONFIG_SMP
+#  define SP_INITIALIZER { SP_UNLOCKED, 0xff, 0 }
+#else
+#  define SP_INITIALIZER { SP_UNLOCKED }
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -333,6 +343,51 @@ void spin_unlock_wo_note(FAR volatile spinlock_t *lock);
 
 void spin_unlockr(FAR struct spinlock_s *lock);
 
+/****************************************************************************
+ * Name: spin_lockr_irqsave
+ *
+ * Description:
+ *   Disable interrupts on this CPU and take a subsystem-scoped, re-entrant
+ *   spinlock.  This is a light-weight alternative to
+ *   enter_critical_section() for data that is private to one subsystem:
+ *   Other CPUs are stalled only if they attempt to take the same lock.
+ *
+ *   Unlike spin_lockr(), this function never yields while waiting and so
+ *   may be called from interrupt handlers.  The same CPU may take the lock
+ *   multiple times; spin_unlockr_irqrestore() must be called the same
+ *   number of times.
+ *
+ *   In the single CPU case, this reduces to up_irq_save().
+ *
+ * Input Parameters:
+ *   lock - A reference to the subsystem spinlock to lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lockr_irqsave().
+ *
+ ****************************************************************************/
+
+irqstate_t spin_lockr_irqsave(FAR struct spinlock_s *lock);
+
+/****************************************************************************
+ * Name: spin_unlockr_irqrestore
+ *
+ * Description:
+ *   Release one count on a subsystem-scoped spinlock taken by
+ *   spin_lockr_irqsave() and restore the interrupt state.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the subsystem spinlock to unlock.
+ *   flags - The value returned by the matching spin_lockr_irqsave().
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spin_unlockr_irqrestore(FAR struct spinlock_s *lock, irqstate_t flags);
+
 /****************************************************************************
  * Name: spin_islocked
  *
@@ -367,6 +422,7 @@ void spin_unlockr(FAR struct spinlock_s *lock);
 /* bool spin_islockedr(FAR struct spinlock_s *lock); */
 #define spin_islockedr(l) ((l)->sp_lock == SP_LOCKED)
 
+#ifdef CONFIG_SMP
 /****************************************************************************
  * Name: spin_setbit
  *
@@ -408,6 +464,7 @@ void spin_setbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *setlock,
                  FAR volatile spinlock_t *orlock);
+#endif /* CONFIG_SMP */
 
 #endif /* CONFIG_SPINLOCK */
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
@@ -43,6 +43,10 @@
 #include <nuttx/config.h>
 #include <stdio.h>
 
+#ifdef CONFIG_LIBC_LZF
+#  include <lzf.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -58,6 +62,8 @@ typedef int  (*lib_getc_t)(FAR struct lib_instream_s *this);
 
 struct lib_outstream_s;
 typedef void (*lib_putc_t)(FAR struct lib_outstream_s *this, int ch);
+typedef void (*lib_puts_t)(FAR struct lib_outstream_s *this,
+                           FAR const char *buf, int len);
 typedef int  (*lib_flush_t)(FAR struct lib_outstream_s *this);
 
 struct lib_instream_s
@@ -70,6 +76,8 @@ struct lib_instream_s
 struct lib_outstream_s
 {
   lib_putc_t             put;     /* Put one character to the outstream */
+  lib_puts_t             puts;    /* Put a run of characters to the outstream.
+                                   * Optional: NULL means use put */
   lib_flush_t            flush;   /* Flush any buffered characters in the outstream */
   int                    nput;    /* Total number of characters put.  Written
                                    * by put method, readable by user */
@@ -204,6 +212,49 @@ struct lib_syslogstream_s
 #endif
 };
 
+/* LZF compressing output stream.  Characters written to the stream are
+ * compressed in blocks and the resulting ZV frames are written to another
+ * output stream.
+ */
+
+#ifdef CONFIG_LIBC_LZF
+struct lib_lzfoutstream_s
+{
+  struct lib_outstream_s      public;
+  FAR struct lib_outstream_s *backend;  /* Receives the compressed frames */
+  struct lzf_cstream_s        lzf;      /* Compression state */
+};
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_stream_puts
+ *
+ * Description:
+ *   Put a run of characters to an outstream, using its puts method if it
+ *   has one or its put method one character at a time if not.
+ *
+ ****************************************************************************/
+
+static inline void lib_stream_puts(FAR struct lib_outstream_s *stream,
+                                   FAR const char *buf, int len)
+{
+  if (stream->puts != NULL)
+    {
+      stream->puts(stream, buf, len);
+    }
+  else
+    {
+      while (len-- > 0)
+        {
+          stream->put(stream, *buf++);
+        }
+    }
+}
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -258,6 +309,8 @@ void lib_memsostream(FAR struct lib_memsostream_s *outstream,
  * Description:
  *   Initializes a stream for use with a FILE instance.
  *   Defined in lib/stdio/lib_stdinstream.c and lib/stdio/lib_stdoutstream.c
+ *   The lib_stdoutstream outstream does not lock the FILE; the caller must
+ *   hold the FILE lock (flockfile()) while using it.
  *
  * Input Parameters:
  *   instream  - User allocated, uninitialized instance of struct
@@ -359,6 +412,37 @@ void lib_zeroinstream(FAR struct lib_instream_s *zeroinstream);
 void lib_nullinstream(FAR struct lib_instream_s *nullinstream);
 void lib_nulloutstream(FAR struct lib_outstream_s *nulloutstream);
 
+/****************************************************************************
+ * Name: lib_lzfoutstream
+ *
+ * Description:
+ *   Initializes a stream that LZF compresses everything written to it and
+ *   writes the compressed frames to the backend stream.  Data is compressed
+ *   whenever CONFIG_LIBC_LZF_BLOCKSIZE bytes have been collected; flushing
+ *   the stream compresses the partial block and then flushes the backend.
+ *   The output can be decoded with lzf_dstream().
+ *
+ *   Defined in lib/lzf/lib_lzfoutstream.c
+ *
+ * Input Parameters:
+ *   outstream - User allocated, uninitialized instance of struct
+ *               lib_lzfoutstream_s to be initialized.
+ *   backend   - The stream that receives the compressed data, for example
+ *               a lib_stdoutstream or lib_rawoutstream.
+ *   htab      - The compression hash table.  It must stay valid for the
+ *               life of the stream.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZF
+void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *outstream,
+                      FAR struct lib_outstream_s *backend,
+                      lzf_state_t htab);
+#endif
+
 /****************************************************************************
  * Name: syslogstream_create
  *
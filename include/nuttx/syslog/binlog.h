@@ -0,0 +1,195 @@
+/****************************************************************************
+ * include/nuttx/syslog/binlog.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/* The binary log is a low overhead alternative to syslog() for hot paths.
+ * Instead of formatting the message on the target, binlog() records only
+ * the address of the format string and the raw argument values in a
+ * circular buffer in RAM.  The strings themselves stay in the read-only
+ * data of the program image.  Records are read from /dev/binlog and
+ * tools/binlog2text formats them on the host against the ELF file of the
+ * image that produced them.
+ *
+ * This driver is built when CONFIG_BINLOG is defined in the NuttX
+ * configuration.
+ */
+
+#ifndef __INCLUDE_NUTTX_SYSLOG_BINLOG_H
+#define __INCLUDE_NUTTX_SYSLOG_BINLOG_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Configuration ************************************************************/
+/* CONFIG_BINLOG - Enables the binary log
+ * CONFIG_BINLOG_BUFSIZE - The size of the circular buffer in bytes
+ */
+
+/* Record format ************************************************************/
+/* Each record is a sequence of uintptr_t words in the native byte order of
+ * the target:
+ *
+ *   Word 0:  Header.  Bits 0-7 hold BINLOG_MAGIC, bits 8-15 the number of
+ *            arguments and bits 16-23 the CPU that made the record.
+ *   Word 1:  The system timer (clock_systimer()) when the record was made.
+ *   Word 2:  The address of the format string.  Zero in the record that
+ *            reports lost records; its single argument is the number of
+ *            records that were dropped because the buffer was full.
+ *   Word 3+: The arguments, each converted to uintptr_t.
+ *
+ * Because the arguments are converted to uintptr_t, only integer and
+ * pointer arguments no wider than a pointer are supported.  %s arguments
+ * can be rendered on the host only if the string lies in the program
+ * image, as string literals do; otherwise the address is shown.
+ */
+
+#define BINLOG_MAGIC              0xb7
+#define BINLOG_MAXARGS            8
+#define BINLOG_HDRWORDS           3
+
+#define BINLOG_HEADER(n,cpu)      ((uintptr_t)BINLOG_MAGIC | \
+                                   ((uintptr_t)(n) << 8) | \
+                                   ((uintptr_t)(cpu) << 16))
+#define BINLOG_NARGS(hdr)         (((hdr) >> 8) & 0xff)
+#define BINLOG_CPU(hdr)           (((hdr) >> 16) & 0xff)
+
+/* Argument counting and conversion helpers for binlog() */
+
+#define __BINLOG_COUNT(_0,_1,_2,_3,_4,_5,_6,_7,_8,n,...) n
+#define __BINLOG_NARGS(...) \
+  __BINLOG_COUNT(__VA_ARGS__,8,7,6,5,4,3,2,1,0,-1)
+
+#define __BINLOG_W1(a)      (uintptr_t)(a)
+#define __BINLOG_W2(a,...)  (uintptr_t)(a), __BINLOG_W1(__VA_ARGS__)
+#define __BINLOG_W3(a,...)  (uintptr_t)(a), __BINLOG_W2(__VA_ARGS__)
+#define __BINLOG_W4(a,...)  (uintptr_t)(a), __BINLOG_W3(__VA_ARGS__)
+#define __BINLOG_W5(a,...)  (uintptr_t)(a), __BINLOG_W4(__VA_ARGS__)
+#define __BINLOG_W6(a,...)  (uintptr_t)(a), __BINLOG_W5(__VA_ARGS__)
+#define __BINLOG_W7(a,...)  (uintptr_t)(a), __BINLOG_W6(__VA_ARGS__)
+#define __BINLOG_W8(a,...)  (uintptr_t)(a), __BINLOG_W7(__VA_ARGS__)
+#define __BINLOG_W9(a,...)  (uintptr_t)(a), __BINLOG_W8(__VA_ARGS__)
+#define __BINLOG_WORDS(...) \
+  __BINLOG_COUNT(__VA_ARGS__,__BINLOG_W9,__BINLOG_W8,__BINLOG_W7, \
+                 __BINLOG_W6,__BINLOG_W5,__BINLOG_W4,__BINLOG_W3, \
+                 __BINLOG_W2,__BINLOG_W1,)(__VA_ARGS__)
+
+/****************************************************************************
+ * Name: binlog
+ *
+ * Description:
+ *   Record a printf-style message in the binary log.  The first argument
+ *   must be a string literal (or other string in the program image),
+ *   followed by at most BINLOG_MAXARGS integer or pointer arguments.  No
+ *   formatting is done on the target.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BINLOG
+#  define binlog(...) \
+     binlog_record(__BINLOG_NARGS(__VA_ARGS__), \
+                   (FAR const uintptr_t []){ __BINLOG_WORDS(__VA_ARGS__) })
+#else
+#  define binlog(...)
+#endif
+
+#ifndef __ASSEMBLY__
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_BINLOG
+
+/****************************************************************************
+ * Name: binlog_record
+ *
+ * Description:
+ *   Add one record to the binary log.  This is the back end of binlog()
+ *   and may be called from any context, including interrupt handlers.  If
+ *   the buffer is full, the record is dropped and counted.
+ *
+ * Input Parameters:
+ *   nargs - The number of arguments following the format string
+ *   words - The address of the format string followed by the arguments
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void binlog_record(unsigned int nargs, FAR const uintptr_t *words);
+
+/****************************************************************************
+ * Name: binlog_register
+ *
+ * Description:
+ *   Register a character driver at /dev/binlog that can be used by an
+ *   application to read the binary log.  Each read() returns as many
+ *   complete records as will fit in the user buffer.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int binlog_register(void);
+
+#endif /* CONFIG_BINLOG */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ASSEMBLY__ */
+#endif /* __INCLUDE_NUTTX_SYSLOG_BINLOG_H */
@@ -80,6 +80,10 @@
  * CONFIG_CDCACM_EPBULKIN_HSSIZE
  *   Max package size for the bulk IN endpoint if high speed mode.
  *   Default 512.
+ * CONFIG_CDCACM_BULKOUT_REQLEN
+ *   The size of one read request buffer.  A request larger than the max
+ *   packet size lets the USB device controller driver chain several
+ *   packets into one request.  Default: the bulk OUT max packet size.
  * CONFIG_CDCACM_NWRREQS and CONFIG_CDCACM_NRDREQS
  *   The number of write/read requests that can be in flight.
  *   CONFIG_CDCACM_NWRREQS includes write requests used for both the
@@ -172,7 +176,7 @@
  * bulk endpoint.  NOTE that difference sizes may be selected for full (FS)
  * or high speed (HS) modes.
  *
- * NOTE:  The BULKOUT request buffer size is always the same as the
+ * NOTE:  The BULKOUT request buffer size is never smaller than the
  * maxpacket size.
  */
 
@@ -190,6 +194,14 @@
 #  define CONFIG_CDCACM_EPBULKOUT_HSSIZE 512
 #endif
 
+#ifndef CONFIG_CDCACM_BULKOUT_REQLEN
+#  ifdef CONFIG_USBDEV_DUALSPEED
+#    define CONFIG_CDCACM_BULKOUT_REQLEN CONFIG_CDCACM_EPBULKOUT_HSSIZE
+#  else
+#    define CONFIG_CDCACM_BULKOUT_REQLEN CONFIG_CDCACM_EPBULKOUT_FSSIZE
+#  endif
+#endif
+
 /* Number of requests in the write queue.  This includes write requests used
  * for both the interrupt and bulk IN endpoints.
  */
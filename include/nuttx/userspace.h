@@ -88,6 +88,7 @@
  ****************************************************************************/
 
 struct mm_heaps_s; /* Forward reference */
+struct clock_vdso_s; /* Forward reference */
 
  /* Every user-space blob starts with a header that provides information about
  * the blob.  The form of that header is provided by struct userspace_s.  An
@@ -132,6 +133,12 @@ struct userspace_s
 #ifdef CONFIG_LIB_USRWORK
   int (*work_usrstart)(void);
 #endif
+
+  /* User-space clock page (may be NULL) */
+
+#ifdef CONFIG_CLOCK_VDSO
+  FAR struct clock_vdso_s *us_vdso;
+#endif
 };
 
 /****************************************************************************
@@ -255,6 +255,12 @@
 #  define FBIO_WAITFORVSYNC   _FBIOC(0x0008)  /* Wait for vertical sync */
 #endif
 
+#ifdef CONFIG_FB_PANDISPLAY
+#  define FBIOPAN_DISPLAY     _FBIOC(0x0012)  /* Select the visible frame
+                                               * Argument: read-only struct
+                                               *           fb_planeinfo_s */
+#endif
+
 #ifdef CONFIG_FB_OVERLAY
 #  define FBIOGET_OVERLAYINFO _FBIOC(0x0009)  /* Get video overlay info */
                                               /* Argument: writable struct
@@ -321,6 +327,11 @@ struct fb_planeinfo_s
   fb_coord_t stride;      /* Length of a line in bytes */
   uint8_t    display;     /* Display number */
   uint8_t    bpp;         /* Bits per pixel */
+#ifdef CONFIG_FB_PANDISPLAY
+  fb_coord_t yres_virtual; /* Rows in fbmem; a multiple of yres if the
+                            * plane holds several frames */
+  fb_coord_t yoffset;      /* First row of fbmem that is visible */
+#endif
 };
 
 #ifdef CONFIG_FB_OVERLAY
@@ -516,6 +527,16 @@ struct fb_vtable_s
   int (*waitforvsync)(FAR struct fb_vtable_s *vtable);
 #endif
 
+#ifdef CONFIG_FB_PANDISPLAY
+  /* The following is provided only if the plane holds more than one frame.
+   * It makes the rows starting at pinfo->yoffset visible.  The change is
+   * complete when the method returns.
+   */
+
+  int (*pandisplay)(FAR struct fb_vtable_s *vtable,
+                    FAR const struct fb_planeinfo_s *pinfo);
+#endif
+
 #ifdef CONFIG_FB_OVERLAY
   /* Get information about the video controller configuration and the
    * configuration of each overlay.
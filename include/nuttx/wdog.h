@@ -144,6 +144,9 @@ struct wdog_s
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+  FAR struct wdog_s *prev;       /* Back link in the timing wheel slot */
+#endif
 };
 
 /* Watchdog 'handle' */
@@ -280,6 +283,25 @@ int wd_cancel(WDOG_ID wdog);
 
 int wd_gettime(WDOG_ID wdog);
 
+/****************************************************************************
+ * Name: wd_nexttime
+ *
+ * Description:
+ *   This function returns the time remaining before the next active
+ *   watchdog timer expires.  The power management logic uses this to avoid
+ *   power states that cannot be left in time.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the next watchdog expires.
+ *   INT_MAX is returned if no watchdog is active.
+ *
+ ****************************************************************************/
+
+int wd_nexttime(void);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -62,9 +62,16 @@
 
 struct ieee802154_txdesc_s
 {
-  /* Support a singly linked list of tx descriptors */
+  /* Support a singly linked list of tx descriptors.  The backward link is
+   * only used while the descriptor is on the MAC's indirect queue.
+   */
 
   FAR struct ieee802154_txdesc_s *flink;
+  FAR struct ieee802154_txdesc_s *blink;
+
+  /* Link in the MAC's indirect transaction destination index */
+
+  FAR struct ieee802154_txdesc_s *hlink;
 
   /* Destination Address */
 
@@ -50,6 +50,10 @@
 
 #include <nuttx/clock.h>
 
+#ifdef CONFIG_SCHED_WORKQUEUE_WDOG
+#  include <nuttx/wdog.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -254,6 +258,15 @@
 
 #endif /* CONFIG_LIB_USRWORK && !__KERNEL__ */
 
+/* Work pools:
+ *   Additional kernel work queues created with work_pool_create() have
+ *   IDs starting at WORKPOOL_BASE.
+ */
+
+#if defined(CONFIG_SCHED_WORKPOOLS) && CONFIG_SCHED_WORKPOOLS > 0
+#  define WORKPOOL_BASE 3     /* ID of the first work pool */
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -276,8 +289,29 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   clock_t qtime;         /* Time work queued */
   clock_t delay;         /* Delay until work performed */
+#ifdef CONFIG_SCHED_WORKITEM_PRIO
+  uint8_t prio;          /* Work priority.  Higher priority work runs first */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_WDOG
+  struct wdog_s timer;   /* Times the delay of delayed work */
+#endif
 };
 
+#if defined(CONFIG_SCHED_WORKPOOLS) && CONFIG_SCHED_WORKPOOLS > 0
+/* Describes a work pool to be created by work_pool_create() */
+
+struct work_poolattr_s
+{
+  FAR const char *name;  /* Name of the worker threads */
+  uint8_t priority;      /* Priority of the worker threads */
+  uint8_t nthreads;      /* Number of worker threads */
+  size_t stacksize;      /* Stack size of each worker thread */
+#ifdef CONFIG_SMP
+  cpu_set_t affinity;    /* CPUs the worker threads may use; zero: any */
+#endif
+};
+#endif
+
 /* This is an enumeration of the various events that may be
  * notified via work_notifier_signal().
  */
@@ -403,6 +437,81 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_prio
+ *
+ * Description:
+ *   Queue work like work_queue(), but with a priority.  Work that is ready
+ *   is performed in order of decreasing priority and in FIFO order among
+ *   work of the same priority.  work_queue() queues work with priority
+ *   zero.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *   prio   - The priority of the work
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKITEM_PRIO) && defined(__KERNEL__)
+int work_queue_prio(int qid, FAR struct work_s *work, worker_t worker,
+                    FAR void *arg, clock_t delay, uint8_t prio);
+#endif
+
+/****************************************************************************
+ * Name: work_pool_create
+ *
+ * Description:
+ *   Create a named pool of kernel worker threads serving their own work
+ *   queue.  Work that must not be delayed by unrelated, slow work (or that
+ *   is slow itself) can be given a pool of its own.  The pool remains for
+ *   the life of the system.
+ *
+ * Input Parameters:
+ *   attr - Describes the pool
+ *
+ * Returned Value:
+ *   The work queue ID of the new pool is returned on success.  It may be
+ *   used with work_queue(), work_cancel() and work_signal().  A negated
+ *   errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKPOOLS) && CONFIG_SCHED_WORKPOOLS > 0
+int work_pool_create(FAR const struct work_poolattr_s *attr);
+#endif
+
+/****************************************************************************
+ * Name: work_cpuqid
+ *
+ * Description:
+ *   Return the ID of one of the per-CPU work queues.  Each is served by a
+ *   single worker thread that only runs on its CPU.  The queue is selected
+ *   by a hash so that the work for one object is always performed on the
+ *   same CPU while the work for different objects is spread across the
+ *   CPUs.  This may be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   hash - A hash of the object that the work is for
+ *
+ * Returned Value:
+ *   The work queue ID is returned on success.  It may be used with
+ *   work_queue(), work_cancel() and work_signal().  -EAGAIN is returned if
+ *   the per-CPU work queues have not been started yet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+int work_cpuqid(uint32_t hash);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
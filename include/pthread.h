@@ -54,6 +54,11 @@
 
 #include <nuttx/semaphore.h> /* For sem_t and SEM_PRIO_* defines */
 
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) || \
+   (defined(CONFIG_PTHREAD_RWLOCK_FASTPATH) && defined(CONFIG_SMP))
+#  include <arch/spinlock.h>  /* For spinlock_t and SP_* defines */
+#endif
+
 /********************************************************************************
  * Pre-processor Definitions
  ********************************************************************************/
@@ -255,9 +260,13 @@ typedef int pthread_condattr_t;
 #define __PTHREAD_CONDATTR_T_DEFINED 1
 #endif
 
+struct pthread_mutex_s; /* Forward reference */
 struct pthread_cond_s
 {
   sem_t sem;
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+  FAR struct pthread_mutex_s *mutex; /* Mutex used by pthread_cond_wait() */
+#endif
 };
 
 #ifndef __PTHREAD_COND_T_DEFINED
@@ -265,7 +274,11 @@ typedef struct pthread_cond_s pthread_cond_t;
 #define __PTHREAD_COND_T_DEFINED 1
 #endif
 
-#define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0)}
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+#  define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0), NULL}
+#else
+#  define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0)}
+#endif
 
 struct pthread_mutexattr_s
 {
@@ -279,6 +292,9 @@ struct pthread_mutexattr_s
 #ifdef CONFIG_PTHREAD_MUTEX_BOTH
   uint8_t robust  : 1;  /* PTHREAD_MUTEX_STALLED or PTHREAD_MUTEX_ROBUST */
 #endif
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+  uint8_t adaptive : 1; /* Spin while the holder runs on another CPU */
+#endif
 };
 
 #ifndef __PTHREAD_MUTEXATTR_T_DEFINED
@@ -305,6 +321,19 @@ struct pthread_mutex_s
   uint8_t type;     /* Type of the mutex.  See PTHREAD_MUTEX_* definitions */
   int16_t nlocks;   /* The number of recursive locks held */
 #endif
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* Uncontended fast path.  The semaphore is then only used to wait for
+   * the lock when it is contended.
+   */
+
+  volatile spinlock_t lock;  /* SP_LOCKED if the mutex is held */
+  volatile int16_t nwaiters; /* Number of threads waiting for the lock */
+#endif
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+  /* Must be last:  Static initializers leave it zero (not adaptive) */
+
+  uint8_t adaptive; /* Spin while the holder runs on another CPU */
+#endif
 };
 
 #ifndef __PTHREAD_MUTEX_T_DEFINED
@@ -320,18 +349,37 @@ typedef struct pthread_mutex_s pthread_mutex_t;
 #  endif
 #endif
 
+/* Mutexes using the fast path start with no count on the semaphore.  With
+ * priority inheritance, statically initialized mutexes use the priority
+ * inheritance protocol and do not use the fast path.
+ */
+
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && !defined(CONFIG_PRIORITY_INHERITANCE)
+#  define __PTHREAD_MUTEX_SEMINIT  SEM_INITIALIZER(0)
+#else
+#  define __PTHREAD_MUTEX_SEMINIT  SEM_INITIALIZER(1)
+#endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#  define __PTHREAD_MUTEX_FASTINIT , SP_UNLOCKED, 0
+#else
+#  define __PTHREAD_MUTEX_FASTINIT
+#endif
+
 #if defined(CONFIG_PTHREAD_MUTEX_TYPES) && !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
 #  define PTHREAD_MUTEX_INITIALIZER {NULL, SEM_INITIALIZER(1), -1, \
                                      __PTHREAD_MUTEX_DEFAULT_FLAGS, \
                                      PTHREAD_MUTEX_DEFAULT, 0}
 #elif defined(CONFIG_PTHREAD_MUTEX_TYPES)
-#  define PTHREAD_MUTEX_INITIALIZER {SEM_INITIALIZER(1), -1, \
-                                     PTHREAD_MUTEX_DEFAULT, 0}
+#  define PTHREAD_MUTEX_INITIALIZER {__PTHREAD_MUTEX_SEMINIT, -1, \
+                                     PTHREAD_MUTEX_DEFAULT, 0 \
+                                     __PTHREAD_MUTEX_FASTINIT}
 #elif !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
 #  define PTHREAD_MUTEX_INITIALIZER {NULL, SEM_INITIALIZER(1), -1,\
                                      __PTHREAD_MUTEX_DEFAULT_FLAGS}
 #else
-#  define PTHREAD_MUTEX_INITIALIZER {SEM_INITIALIZER(1), -1}
+#  define PTHREAD_MUTEX_INITIALIZER {__PTHREAD_MUTEX_SEMINIT, -1 \
+                                     __PTHREAD_MUTEX_FASTINIT}
 #endif
 
 struct pthread_barrierattr_s
@@ -360,6 +408,26 @@ typedef bool pthread_once_t;
 #define __PTHREAD_ONCE_T_DEFINED 1
 #endif
 
+#ifdef CONFIG_PTHREAD_RWLOCK_FASTPATH
+/* The lock state is modified with interrupts disabled (and, on SMP, under
+ * the spinlock); the semaphores are only used when a thread has to wait.
+ * The writer holds wrsem for as long as it is pending or writing so that
+ * blocked threads boost the writer's priority.
+ */
+
+struct pthread_rwlock_s
+{
+    sem_t wrsem;                 /* Held by the pending or active writer */
+    sem_t rdsem;                 /* Posted by the last reader to leave */
+#ifdef CONFIG_SMP
+    spinlock_t spin;             /* Protects the lock state */
+#endif
+    unsigned int num_readers;    /* Number of readers holding the lock */
+    uint8_t wrstate;             /* See _PTHREAD_RWLOCK_WR* definitions */
+    uint8_t kind;                /* See PTHREAD_RWLOCK_PREFER_* definitions */
+    bool wrwaiting;              /* Writer is waiting on rdsem */
+};
+#else
 struct pthread_rwlock_s
 {
     pthread_mutex_t lock;
@@ -368,14 +436,58 @@ struct pthread_rwlock_s
     unsigned int num_writers;
     bool write_in_progress;
 };
+#endif
 
 typedef struct pthread_rwlock_s pthread_rwlock_t;
 
 typedef int pthread_rwlockattr_t;
 
-#define PTHREAD_RWLOCK_INITIALIZER  {PTHREAD_MUTEX_INITIALIZER, \
-                                     PTHREAD_COND_INITIALIZER, \
-                                     0, 0, false}
+/* Values for pthread_rwlockattr_setkind_np().  These are non-standard */
+
+#define PTHREAD_RWLOCK_PREFER_READER_NP  0 /* Writers may starve */
+#define PTHREAD_RWLOCK_PREFER_WRITER_NP  1 /* New readers wait for writers */
+
+#ifdef CONFIG_PTHREAD_RWLOCK_FASTPATH
+/* Values for struct pthread_rwlock_s wrstate (internal use only) */
+
+#  define _PTHREAD_RWLOCK_WRNONE     0 /* No writer */
+#  define _PTHREAD_RWLOCK_WRPENDING  1 /* Writer waiting for readers */
+#  define _PTHREAD_RWLOCK_WRACTIVE   2 /* Writer holds the lock */
+
+#  ifdef CONFIG_SMP
+#    define __PTHREAD_RWLOCK_SPININIT SP_UNLOCKED,
+#  else
+#    define __PTHREAD_RWLOCK_SPININIT
+#  endif
+
+/* rdsem is a signaling semaphore (readers post it, the writer waits on it)
+ * so priority inheritance must be disabled, as pthread_rwlock_init() does.
+ */
+
+#  ifdef CONFIG_PRIORITY_INHERITANCE
+#    if CONFIG_SEM_PREALLOCHOLDERS > 0
+#      define __PTHREAD_RWLOCK_RDSEMINIT \
+         {0, SEM_WAITLIST_INITIALIZER, PRIOINHERIT_FLAGS_DISABLE, NULL}
+#    else
+#      define __PTHREAD_RWLOCK_RDSEMINIT \
+         {0, SEM_WAITLIST_INITIALIZER, PRIOINHERIT_FLAGS_DISABLE, \
+          {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}}
+#    endif
+#  else
+#    define __PTHREAD_RWLOCK_RDSEMINIT SEM_INITIALIZER(0)
+#  endif
+
+#  define PTHREAD_RWLOCK_INITIALIZER  {SEM_INITIALIZER(1), \
+                                       __PTHREAD_RWLOCK_RDSEMINIT, \
+                                       __PTHREAD_RWLOCK_SPININIT \
+                                       0, _PTHREAD_RWLOCK_WRNONE, \
+                                       PTHREAD_RWLOCK_PREFER_WRITER_NP, \
+                                       false}
+#else
+#  define PTHREAD_RWLOCK_INITIALIZER  {PTHREAD_MUTEX_INITIALIZER, \
+                                       PTHREAD_COND_INITIALIZER, \
+                                       0, 0, false}
+#endif
 
 #ifdef CONFIG_PTHREAD_CLEANUP
 /* This type describes the pthread cleanup callback (non-standard) */
@@ -532,6 +644,12 @@ int pthread_mutexattr_getrobust(FAR const pthread_mutexattr_t *attr,
                                 FAR int *robust);
 int pthread_mutexattr_setrobust(FAR pthread_mutexattr_t *attr,
                                 int robust);
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+int pthread_mutexattr_getadaptive_np(FAR const pthread_mutexattr_t *attr,
+                                     FAR int *adaptive);
+int pthread_mutexattr_setadaptive_np(FAR pthread_mutexattr_t *attr,
+                                     int adaptive);
+#endif
 
 /* The following routines create, delete, lock and unlock mutexes. */
 
@@ -597,6 +715,12 @@ int pthread_once(FAR pthread_once_t *once_control,
 
 /* Pthread rwlock */
 
+int pthread_rwlockattr_init(FAR pthread_rwlockattr_t *attr);
+int pthread_rwlockattr_destroy(FAR pthread_rwlockattr_t *attr);
+int pthread_rwlockattr_getkind_np(FAR const pthread_rwlockattr_t *attr,
+                                  FAR int *pref);
+int pthread_rwlockattr_setkind_np(FAR pthread_rwlockattr_t *attr, int pref);
+
 int pthread_rwlock_destroy(FAR pthread_rwlock_t *rw_lock);
 int pthread_rwlock_init(FAR pthread_rwlock_t *rw_lock,
                         FAR const pthread_rwlockattr_t *attr);
@@ -44,6 +44,7 @@
 
 #include <stdint.h>
 #include <limits.h>
+#include <queue.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -69,14 +70,15 @@ struct tcb_s; /* Forward reference */
 struct semholder_s
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  struct semholder_s *flink;     /* Implements singly linked list */
+  struct semholder_s *flink;     /* Implements doubly linked list */
+  struct semholder_s *blink;
 #endif
   FAR struct tcb_s *htcb;        /* Holder TCB */
   int16_t counts;                /* Number of counts owned by this holder */
 };
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#  define SEMHOLDER_INITIALIZER {NULL, NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, NULL, 0}
 #else
 #  define SEMHOLDER_INITIALIZER {NULL, 0}
 #endif
@@ -88,6 +90,8 @@ struct sem_s
 {
   volatile int16_t semcount;     /* >0 -> Num counts available */
                                  /* <0 -> Num tasks waiting for semaphore */
+  dq_queue_t waitlist;           /* Prioritized list of waiting tasks */
+
   /* If priority inheritance is enabled, then we have to keep track of which
    * tasks hold references to the semaphore.
    */
@@ -106,17 +110,20 @@ typedef struct sem_s sem_t;
 
 /* Initializers */
 
+#define SEM_WAITLIST_INITIALIZER {NULL, NULL}
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
 #  define SEM_INITIALIZER(c) \
-    {(c), 0, NULL}               /* semcount, flags, hhead */
+    {(c), SEM_WAITLIST_INITIALIZER, 0, NULL} /* semcount, waitlist, flags, hhead */
 # else
 #  define SEM_INITIALIZER(c) \
-    {(c), 0, {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}} /* semcount, flags, holder[2] */
+    {(c), SEM_WAITLIST_INITIALIZER, 0, \
+     {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}} /* semcount, waitlist, flags, holder[2] */
 # endif
 #else
 #  define SEM_INITIALIZER(c) \
-    {(c)}                        /* semcount */
+    {(c), SEM_WAITLIST_INITIALIZER} /* semcount, waitlist */
 #endif
 
 /****************************************************************************
@@ -48,6 +48,7 @@
 #include <sched.h>
 #include <semaphore.h>
 #include <time.h>
+#include <fcntl.h>
 
 #include <nuttx/fs/fs.h>
 
@@ -93,6 +94,19 @@
 #define getchar()  fgetc(stdin)
 #define rewind(s)  ((void)fseek((s),0,SEEK_SET))
 
+/* Unlocked character I/O.  With stream buffering, getc_unlocked() and
+ * putc_unlocked() are inline functions that access the stream buffer
+ * directly (see below).
+ */
+
+#ifdef CONFIG_STDIO_DISABLE_BUFFERING
+#  define getc_unlocked(s)   fgetc_unlocked(s)
+#  define putc_unlocked(c,s) fputc_unlocked((c),(s))
+#endif
+
+#define getchar_unlocked()   getc_unlocked(stdin)
+#define putchar_unlocked(c)  putc_unlocked((c), stdout)
+
 /* Path to the directory where temporary files can be created */
 
 #ifndef CONFIG_LIBC_TMPDIR
@@ -169,6 +183,23 @@ void   setbuf(FAR FILE *stream, FAR char *buf);
 int    setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size);
 int    ungetc(int c, FAR FILE *stream);
 
+/* Explicit stream locking and the unlocked I/O variants.  The unlocked
+ * variants do not take the stream lock; the caller must hold it (see
+ * flockfile()) or otherwise have exclusive access to the stream.
+ * fgetc_unlocked, fputc_unlocked, fread_unlocked, and fwrite_unlocked are
+ * non-standard (GNU) extensions.
+ */
+
+void   flockfile(FAR FILE *stream);
+int    ftrylockfile(FAR FILE *stream);
+void   funlockfile(FAR FILE *stream);
+int    fgetc_unlocked(FAR FILE *stream);
+int    fputc_unlocked(int c, FAR FILE *stream);
+size_t fread_unlocked(FAR void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
+size_t fwrite_unlocked(FAR const void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
+
 /* Operations on the stdout stream, buffers, paths, and the whole printf-family */
 
 int    printf(FAR const IPTR char *format, ...);
@@ -216,6 +247,59 @@ FILE *popen(FAR const char *command, FAR const char *mode);
 int pclose(FILE *stream);
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+/****************************************************************************
+ * Name: getc_unlocked
+ *
+ * Description:
+ *   Return the next character directly from the stream buffer if one is
+ *   available; fall back to fgetc_unlocked() otherwise.
+ *
+ ****************************************************************************/
+
+static inline int getc_unlocked(FAR FILE *stream)
+{
+  if (stream->fs_bufpos < stream->fs_bufread
+#if CONFIG_NUNGET_CHARS > 0
+      && stream->fs_nungotten == 0
+#endif
+     )
+    {
+      return *stream->fs_bufpos++;
+    }
+
+  return fgetc_unlocked(stream);
+}
+
+/****************************************************************************
+ * Name: putc_unlocked
+ *
+ * Description:
+ *   Store the character directly into the stream buffer if the buffer is
+ *   in write mode and will not become full; fall back to fputc_unlocked()
+ *   otherwise.  Newlines always take the fall back so that line buffering
+ *   is honored.
+ *
+ ****************************************************************************/
+
+static inline int putc_unlocked(int c, FAR FILE *stream)
+{
+  if (c != '\n' && stream->fs_bufread == stream->fs_bufstart &&
+      stream->fs_bufpos + 1 < stream->fs_bufend &&
+      (stream->fs_oflags & O_WROK) != 0)
+    {
+      *stream->fs_bufpos++ = (unsigned char)c;
+      return (unsigned char)c;
+    }
+
+  return fputc_unlocked(c, stream);
+}
+#endif /* CONFIG_STDIO_DISABLE_BUFFERING */
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -278,6 +278,15 @@ int      mkstemp(FAR char *path_template);
 void     qsort(FAR void *base, size_t nel, size_t width,
                CODE int (*compar)(FAR const void *, FAR const void *));
 
+/* Stable radix sorts on an unsigned integer key (non-standard) */
+
+int      radixsort32(FAR void *base, size_t nel, size_t width,
+                     size_t keyoffset, FAR void *scratch);
+#ifdef CONFIG_HAVE_LONG_LONG
+int      radixsort64(FAR void *base, size_t nel, size_t width,
+                     size_t keyoffset, FAR void *scratch);
+#endif
+
 /* Binary search */
 
 FAR void *bsearch(FAR const void *key, FAR const void *base, size_t nel,
@@ -40,6 +40,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdint.h>
 #include <poll.h>
 
 /****************************************************************************
@@ -50,6 +51,13 @@
 #define EPOLL_CTL_DEL 2 /* Remove a file descriptor from the interface.  */
 #define EPOLL_CTL_MOD 3 /* Change file descriptor epoll_event structure.  */
 
+/* Input-only flags that may be OR'ed into epoll_event.events.  These lie
+ * outside of the range of pollevent_t.
+ */
+
+#define EPOLLONESHOT  (1u << 30) /* Disarm after one event (re-arm with MOD) */
+#define EPOLLET       (1u << 31) /* Edge-triggered notification */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -78,23 +86,16 @@ enum EPOLL_EVENTS
 
 typedef union poll_data
 {
+  FAR void    *ptr;      /* Opaque user data */
   int          fd;       /* The descriptor being polled */
+  uint32_t     u32;
 } epoll_data_t;
 
 struct epoll_event
 {
-  epoll_data_t data;
-  FAR sem_t   *sem;      /* Pointer to semaphore used to post output event */
-  pollevent_t  events;   /* The input event flags */
-  pollevent_t  revents;  /* The output event flags */
-  FAR void    *priv;     /* For use by drivers */
-};
-
-struct epoll_head
-{
-  int size;
-  int occupied;
-  FAR struct epoll_event *evs;
+  uint32_t     events;   /* Requested (epoll_ctl) or returned (epoll_wait)
+                          * event flags */
+  epoll_data_t data;     /* User data returned with the events */
 };
 
 /****************************************************************************
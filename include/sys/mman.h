@@ -132,6 +132,12 @@
 #define POSIX_TYPED_MEM_ALLOCATE_CONTIG  (1)
 #define POSIX_TYPED_MEM_MAP_ALLOCATABLE  (2)
 
+/* The following flags are used with memfd_create() (Linux-specific).
+ * Accepted for compatibility; NuttX has no exec() to close over.
+ */
+
+#define MFD_CLOEXEC     0x0001          /* Close the descriptor on exec() */
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -168,7 +174,7 @@ int msync(FAR void *addr, size_t len, int flags);
 int munlock(FAR const void *addr, size_t len);
 int munlockall(void);
 
-#ifdef CONFIG_FS_RAMMAP
+#if defined(CONFIG_FS_RAMMAP) || defined(CONFIG_FS_SHM)
 int munmap(FAR void *start, size_t length);
 #else
 #  define munmap(start, length)
@@ -181,6 +187,7 @@ int posix_typed_mem_get_info(int fildes, FAR struct posix_typed_mem_info *info);
 int posix_typed_mem_open(FAR const char *name, int oflag, int tflag);
 int shm_open(FAR const char *name, int oflag, mode_t mode);
 int shm_unlink(FAR const char *name);
+int memfd_create(FAR const char *name, unsigned int flags);
 
 #undef EXTERN
 #if defined(__cplusplus)
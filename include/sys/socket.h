@@ -124,6 +124,7 @@
 #define MSG_ERRQUEUE   0x2000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
+#define MSG_WAITFORONE 0x10000 /* Wait only for the first message.  */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -208,6 +209,7 @@
 #define SOL_L2CAP       6 /* See options in include/netpacket/bluetooth.h */
 #define SOL_SCO         7 /* See options in include/netpacket/bluetooth.h */
 #define SOL_RFCOMM      8 /* See options in include/netpacket/bluetooth.h */
+#define SOL_PACKET      9 /* See options in include/netpacket/packet.h */
 
 /* Protocol-level socket options may begin with this value */
 
@@ -303,6 +305,16 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* Used with sendmmsg() and recvmmsg() to transfer several datagrams per
+ * call.
+ */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* Message header */
+  unsigned int msg_len;         /* Number of bytes transferred */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -378,6 +390,12 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+struct timespec;
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -286,14 +286,16 @@
 #  define SYS_write                    (__SYS_descriptors + 3)
 #  define SYS_pread                    (__SYS_descriptors + 4)
 #  define SYS_pwrite                   (__SYS_descriptors + 5)
+#  define SYS_readv                    (__SYS_descriptors + 6)
+#  define SYS_writev                   (__SYS_descriptors + 7)
 #  ifdef CONFIG_FS_AIO
-#    define SYS_aio_read               (__SYS_descriptors + 6)
-#    define SYS_aio_write              (__SYS_descriptors + 7)
-#    define SYS_aio_fsync              (__SYS_descriptors + 8)
-#    define SYS_aio_cancel             (__SYS_descriptors + 9)
-#    define __SYS_poll                 (__SYS_descriptors + 10)
+#    define SYS_aio_read               (__SYS_descriptors + 8)
+#    define SYS_aio_write              (__SYS_descriptors + 9)
+#    define SYS_aio_fsync              (__SYS_descriptors + 10)
+#    define SYS_aio_cancel             (__SYS_descriptors + 11)
+#    define __SYS_poll                 (__SYS_descriptors + 12)
 #  else
-#    define __SYS_poll                 (__SYS_descriptors + 6)
+#    define __SYS_poll                 (__SYS_descriptors + 8)
 #  endif
 #  ifndef CONFIG_DISABLE_POLL
 #    define SYS_poll                   __SYS_poll
@@ -418,9 +420,21 @@
 #    define SYS_shmat                  (__SYS_shm + 1)
 #    define SYS_shmctl                 (__SYS_shm + 2)
 #    define SYS_shmdt                  (__SYS_shm + 3)
-#    define __SYS_pthread              (__SYS_shm + 4)
+#    define __SYS_shmfs                (__SYS_shm + 4)
 #else
-#  define __SYS_pthread                __SYS_shm
+#  define __SYS_shmfs                  __SYS_shm
+#endif
+
+/* Shared memory objects */
+
+#ifdef CONFIG_FS_SHM
+#    define SYS_shm_open               (__SYS_shmfs + 0)
+#    define SYS_shm_unlink             (__SYS_shmfs + 1)
+#    define SYS_memfd_create           (__SYS_shmfs + 2)
+#    define SYS_munmap                 (__SYS_shmfs + 3)
+#    define __SYS_pthread              (__SYS_shmfs + 4)
+#else
+#  define __SYS_pthread                __SYS_shmfs
 #endif
 
 /* The following are defined if pthreads are enabled */
@@ -540,7 +554,11 @@
 #  define SYS_send                     (__SYS_network + 9)
 #  define SYS_sendto                   (__SYS_network + 10)
 #  define SYS_setsockopt               (__SYS_network + 11)
-#  define SYS_socket                   (__SYS_network + 12)
+#  define SYS_recvmmsg                 (__SYS_network + 12)
+#  define SYS_sendmmsg                 (__SYS_network + 13)
+#  define SYS_recvmsg                  (__SYS_network + 14)
+#  define SYS_sendmsg                  (__SYS_network + 15)
+#  define SYS_socket                   (__SYS_network + 16)
 #else
 #  define SYS_socket                    __SYS_network
 #endif
@@ -558,9 +576,18 @@
 
 #ifdef CONFIG_CRYPTO_RANDOM_POOL
 #  define SYS_getrandom                (SYS_prctl + 1)
-#  define SYS_maxsyscall               (SYS_prctl + 2)
+#  define __SYS_batch                  (SYS_prctl + 2)
+#else
+#  define __SYS_batch                  (SYS_prctl + 1)
+#endif
+
+/* The following is defined only if batched system calls are enabled */
+
+#ifdef CONFIG_LIB_SYSCALL_BATCH
+#  define SYS_syscall_batch            __SYS_batch
+#  define SYS_maxsyscall               (__SYS_batch + 1)
 #else
-#  define SYS_maxsyscall               (SYS_prctl + 1)
+#  define SYS_maxsyscall               __SYS_batch
 #endif
 
 /* Note that the reported number of system calls does *NOT* include the
@@ -574,12 +601,23 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifndef __ASSEMBLY__
+#ifdef CONFIG_LIB_SYSCALL_BATCH
+/* One operation of a syscall_batch() request */
+
+struct syscall_batch_s
+{
+  uintptr_t sb_nbr;       /* System call number (SYS_*) */
+  uintptr_t sb_parm[6];   /* Parameters (unused ones are ignored) */
+  uintptr_t sb_result;    /* Returned: Value returned by the system call */
+  int       sb_errno;     /* Returned: errno value after the system call */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-#ifndef __ASSEMBLY__
-
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
@@ -619,6 +657,29 @@ EXTERN const uint8_t g_funcnparms[SYS_nsyscalls];
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: syscall_batch
+ *
+ * Description:
+ *   Perform 'nbatch' system calls with a single trap into the kernel.  The
+ *   calls are made in order; the return value and errno of each call are
+ *   returned in its entry.  A batch cannot contain SYS_syscall_batch or
+ *   SYS_vfork; such an entry fails with ENOSYS.
+ *
+ * Input Parameters:
+ *   batch  - The array of operations
+ *   nbatch - The number of entries in batch
+ *
+ * Returned Value:
+ *   The number of operations performed.  On failure, -1 is returned and
+ *   errno is set to EINVAL.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIB_SYSCALL_BATCH
+int syscall_batch(FAR struct syscall_batch_s *batch, int nbatch);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
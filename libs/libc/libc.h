@@ -64,6 +64,10 @@
 # define CONFIG_LIB_HOMEDIR "/"
 #endif
 
+#ifndef CONFIG_SYMTAB_CACHE_SIZE
+#  define CONFIG_SYMTAB_CACHE_SIZE 0
+#endif
+
 /* If C std I/O buffering is not supported, then we don't need its semaphore
  * protection.
  */
@@ -71,6 +75,7 @@
 #ifdef CONFIG_STDIO_DISABLE_BUFFERING
 #  define lib_sem_initialize(s)
 #  define lib_take_semaphore(s)
+#  define lib_trytake_semaphore(s) (OK)
 #  define lib_give_semaphore(s)
 #endif
 
@@ -163,10 +168,13 @@ int lib_mode2oflags(FAR const char *mode);
 /* Defined in lib_libfwrite.c */
 
 ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream);
 
 /* Defined in lib_libfread.c */
 
 ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfgets.c */
 
@@ -190,6 +198,7 @@ int lib_wrflush(FAR FILE *stream);
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 void lib_sem_initialize(FAR struct file_struct *stream);
 void lib_take_semaphore(FAR struct file_struct *stream);
+int  lib_trytake_semaphore(FAR struct file_struct *stream);
 void lib_give_semaphore(FAR struct file_struct *stream);
 #endif
 
@@ -216,12 +225,28 @@ float  lib_expif(size_t n);
 double lib_expi(size_t n);
 #endif
 
+/* Defined in lib_libsincosf.c */
+
+#ifdef CONFIG_LIBM
+float lib_sincosf(float x, bool cosine);
+#endif
+
 /* Defined in lib_libsqrtapprox.c */
 
 #ifdef CONFIG_LIBM
 float lib_sqrtapprox(float x);
 #endif
 
+/* Defined in symtab_cache.c */
+
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+struct symtab_s;
+FAR const struct symtab_s *
+symtab_cachefind(FAR const struct symtab_s *symtab, FAR const char *name,
+                 int nsyms, FAR unsigned int *index);
+void symtab_cacheadd(unsigned int index, FAR const struct symtab_s *symbol);
+#endif
+
 /* Defined in lib_parsehostfile.c */
 
 #ifdef CONFIG_NETDB_HOSTFILE
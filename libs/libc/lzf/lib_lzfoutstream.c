@@ -0,0 +1,186 @@
+/****************************************************************************
+ * libs/libc/lzf/lib_lzfoutstream.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/streams.h>
+
+#include "lzf/lzf.h"
+
+#ifdef CONFIG_LIBC_LZF
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Compressed data is handed to the backend in chunks of this size */
+
+#define LZFOUTSTREAM_CHUNK 64
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzfoutstream_compress
+ *
+ * Description:
+ *   Feed len bytes to the compressor and pass all completed frames on to
+ *   the backend stream.
+ *
+ ****************************************************************************/
+
+static void lzfoutstream_compress(FAR struct lib_lzfoutstream_s *zthis,
+                                  FAR const uint8_t *buf, size_t len,
+                                  bool flush)
+{
+  uint8_t chunk[LZFOUTSTREAM_CHUNK];
+  size_t pending;
+
+  zthis->lzf.next_in  = buf;
+  zthis->lzf.avail_in = len;
+
+  do
+    {
+      zthis->lzf.next_out  = chunk;
+      zthis->lzf.avail_out = LZFOUTSTREAM_CHUNK;
+
+      pending = lzf_cstream(&zthis->lzf, flush);
+
+      if (zthis->lzf.avail_out < LZFOUTSTREAM_CHUNK)
+        {
+          lib_stream_puts(zthis->backend, (FAR const char *)chunk,
+                          LZFOUTSTREAM_CHUNK - zthis->lzf.avail_out);
+        }
+    }
+  while (pending > 0);
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_putc
+ ****************************************************************************/
+
+static void lzfoutstream_putc(FAR struct lib_outstream_s *this, int ch)
+{
+  FAR struct lib_lzfoutstream_s *zthis =
+    (FAR struct lib_lzfoutstream_s *)this;
+  uint8_t byte = (uint8_t)ch;
+
+  DEBUGASSERT(this);
+
+  lzfoutstream_compress(zthis, &byte, 1, false);
+  this->nput++;
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_puts
+ ****************************************************************************/
+
+static void lzfoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_lzfoutstream_s *zthis =
+    (FAR struct lib_lzfoutstream_s *)this;
+
+  DEBUGASSERT(this);
+
+  if (len > 0)
+    {
+      lzfoutstream_compress(zthis, (FAR const uint8_t *)buf, len, false);
+      this->nput += len;
+    }
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_flush
+ ****************************************************************************/
+
+static int lzfoutstream_flush(FAR struct lib_outstream_s *this)
+{
+  FAR struct lib_lzfoutstream_s *zthis =
+    (FAR struct lib_lzfoutstream_s *)this;
+
+  DEBUGASSERT(this);
+
+  lzfoutstream_compress(zthis, NULL, 0, true);
+  return zthis->backend->flush(zthis->backend);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lzfoutstream
+ *
+ * Description:
+ *   Initializes a stream that LZF compresses everything written to it and
+ *   writes the compressed frames to the backend stream.
+ *
+ * Input Parameters:
+ *   outstream - User allocated, uninitialized instance of struct
+ *               lib_lzfoutstream_s to be initialized.
+ *   backend   - The stream that receives the compressed data
+ *   htab      - The compression hash table
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *outstream,
+                      FAR struct lib_outstream_s *backend,
+                      lzf_state_t htab)
+{
+  DEBUGASSERT(outstream != NULL && backend != NULL);
+
+  outstream->public.put   = lzfoutstream_putc;
+  outstream->public.puts  = lzfoutstream_puts;
+  outstream->public.flush = lzfoutstream_flush;
+  outstream->public.nput  = 0;
+  outstream->backend      = backend;
+
+  lzf_cstream_init(&outstream->lzf, htab);
+}
+
+#endif /* CONFIG_LIBC_LZF */
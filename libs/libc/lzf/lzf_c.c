@@ -74,7 +74,9 @@
 #endif
 
 #define MAX_LIT     (1 <<  5)
-#define MAX_OFF     (1 << HLOG)
+/* Back references carry a 13-bit offset, independent of the hash size */
+
+#define MAX_OFF     (1 << 13)
 #define MAX_REF     ((1 << 8) + (1 << 3))
 
 #if __GNUC__ >= 3
@@ -0,0 +1,383 @@
+/****************************************************************************
+ * libs/libc/lzf/lzf_stream.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include "lzf/lzf.h"
+
+#ifdef CONFIG_LIBC_LZF
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* lzf_dstream() parser states */
+
+#define LZF_STATE_HDR     0   /* Collecting a frame header */
+#define LZF_STATE_RAW     1   /* Passing through uncompressed frame data */
+#define LZF_STATE_DATA    2   /* Collecting compressed frame data */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzf_copyout
+ *
+ * Description:
+ *   Copy up to len bytes from src to the output of a stream and return the
+ *   number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t lzf_copyout(FAR uint8_t **next_out, FAR size_t *avail_out,
+                          FAR const uint8_t *src, size_t len)
+{
+  if (len > *avail_out)
+    {
+      len = *avail_out;
+    }
+
+  memcpy(*next_out, src, len);
+  *next_out  += len;
+  *avail_out -= len;
+  return len;
+}
+
+/****************************************************************************
+ * Name: lzf_copyin
+ *
+ * Description:
+ *   Copy up to len bytes from the input of a stream to dest and return the
+ *   number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t lzf_copyin(FAR const uint8_t **next_in, FAR size_t *avail_in,
+                         FAR uint8_t *dest, size_t len)
+{
+  if (len > *avail_in)
+    {
+      len = *avail_in;
+    }
+
+  memcpy(dest, *next_in, len);
+  *next_in  += len;
+  *avail_in -= len;
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzf_cstream_init
+ *
+ * Description:
+ *   Initialize a streaming compressor.  htab is used for every block of
+ *   the stream and must stay valid for the life of the stream; it needs no
+ *   initialization.
+ *
+ ****************************************************************************/
+
+void lzf_cstream_init(FAR struct lzf_cstream_s *strm, lzf_state_t htab)
+{
+  DEBUGASSERT(strm != NULL && htab != NULL);
+
+  strm->next_in   = NULL;
+  strm->avail_in  = 0;
+  strm->next_out  = NULL;
+  strm->avail_out = 0;
+  strm->htab      = htab;
+  strm->frame     = NULL;
+  strm->framelen  = 0;
+  strm->inlen     = 0;
+}
+
+/****************************************************************************
+ * Name: lzf_cstream
+ *
+ * Description:
+ *   Consume as much of next_in/avail_in as possible and write compressed
+ *   frames to next_out/avail_out.  A block is compressed when it is full
+ *   or, if flush is true, when the input is used up, so that all input
+ *   given so far is output.
+ *
+ * Returned Value:
+ *   Zero when all input has been consumed and every completed frame has
+ *   been output.  Otherwise the number of frame bytes that are waiting for
+ *   output space; call again with more output space.
+ *
+ ****************************************************************************/
+
+size_t lzf_cstream(FAR struct lzf_cstream_s *strm, bool flush)
+{
+  FAR struct lzf_header_s *header;
+  FAR uint8_t *block;
+  size_t nbytes;
+
+  DEBUGASSERT(strm != NULL);
+
+  block = &strm->inbuf[LZF_TYPE0_HDR_SIZE];
+
+  for (; ; )
+    {
+      /* Output what is left of the last frame first */
+
+      if (strm->framelen > 0)
+        {
+          nbytes = lzf_copyout(&strm->next_out, &strm->avail_out,
+                               strm->frame, strm->framelen);
+
+          strm->frame    += nbytes;
+          strm->framelen -= nbytes;
+
+          if (strm->framelen > 0)
+            {
+              return strm->framelen;
+            }
+        }
+
+      /* Collect input into the block */
+
+      strm->inlen += lzf_copyin(&strm->next_in, &strm->avail_in,
+                                &block[strm->inlen],
+                                LZF_BLOCKSIZE - strm->inlen);
+
+      if (strm->inlen == 0 || (strm->inlen < LZF_BLOCKSIZE && !flush))
+        {
+          return 0;
+        }
+
+      /* Compress the block.  Limiting the output to one byte less than the
+       * input makes lzf_compress() fall back to an uncompressed frame,
+       * built in place in front of the block, whenever compression would
+       * not save anything.
+       */
+
+      strm->framelen = lzf_compress(block, strm->inlen,
+                                    &strm->outbuf[LZF_TYPE1_HDR_SIZE],
+                                    strm->inlen - 1, strm->htab, &header);
+      strm->frame    = (FAR const uint8_t *)header;
+      strm->inlen    = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: lzf_dstream_init
+ *
+ * Description:
+ *   Initialize a streaming decompressor.
+ *
+ ****************************************************************************/
+
+void lzf_dstream_init(FAR struct lzf_dstream_s *strm)
+{
+  DEBUGASSERT(strm != NULL);
+
+  /* Clear everything but the data buffers */
+
+  memset(strm, 0, offsetof(struct lzf_dstream_s, inbuf));
+  strm->state = LZF_STATE_HDR;
+}
+
+/****************************************************************************
+ * Name: lzf_dstream
+ *
+ * Description:
+ *   Consume as much of next_in/avail_in as possible and write the
+ *   decompressed data to next_out/avail_out.
+ *
+ * Returned Value:
+ *   Zero when all input has been consumed and all data decoded so far has
+ *   been output.  A positive value when output space ran out first; call
+ *   again with more output space.  A negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t lzf_dstream(FAR struct lzf_dstream_s *strm)
+{
+  unsigned int hdrsize;
+  size_t nbytes;
+
+  DEBUGASSERT(strm != NULL);
+
+  for (; ; )
+    {
+      /* Output what is left of the last frame first */
+
+      if (strm->outlen > 0)
+        {
+          nbytes = lzf_copyout(&strm->next_out, &strm->avail_out,
+                               strm->out, strm->outlen);
+
+          strm->out    += nbytes;
+          strm->outlen -= nbytes;
+
+          if (strm->outlen > 0)
+            {
+              return strm->outlen;
+            }
+        }
+
+      if (strm->avail_in == 0)
+        {
+          return 0;
+        }
+
+      switch (strm->state)
+        {
+          case LZF_STATE_HDR:
+
+            /* The frame type (third byte) tells the header size */
+
+            hdrsize = LZF_MIN_HDR_SIZE;
+            if (strm->hdrlen >= 3 && strm->hdr[2] == LZF_TYPE1_HDR)
+              {
+                hdrsize = LZF_TYPE1_HDR_SIZE;
+              }
+
+            strm->hdrlen += lzf_copyin(&strm->next_in, &strm->avail_in,
+                                       &strm->hdr[strm->hdrlen],
+                                       (strm->hdrlen < 3 ? 3 : hdrsize) -
+                                       strm->hdrlen);
+
+            if (strm->hdrlen < 3)
+              {
+                break;
+              }
+
+            if (strm->hdr[0] != 'Z' || strm->hdr[1] != 'V' ||
+                strm->hdr[2] > LZF_TYPE1_HDR)
+              {
+                return -EINVAL;
+              }
+
+            hdrsize = strm->hdr[2] == LZF_TYPE1_HDR ?
+                      LZF_TYPE1_HDR_SIZE : LZF_TYPE0_HDR_SIZE;
+
+            if (strm->hdrlen < hdrsize)
+              {
+                break;
+              }
+
+            strm->hdrlen = 0;
+            strm->clen   = ((uint16_t)strm->hdr[3] << 8) | strm->hdr[4];
+
+            if (strm->hdr[2] == LZF_TYPE0_HDR)
+              {
+                strm->remain = strm->clen;
+                strm->state  = LZF_STATE_RAW;
+              }
+            else
+              {
+                strm->ulen = ((uint16_t)strm->hdr[5] << 8) | strm->hdr[6];
+                if (strm->clen > LZF_BLOCKSIZE || strm->ulen > LZF_BLOCKSIZE)
+                  {
+                    return -E2BIG;
+                  }
+
+                strm->remain = strm->clen;
+                strm->state  = LZF_STATE_DATA;
+              }
+            break;
+
+          case LZF_STATE_RAW:
+
+            /* Uncompressed data is passed straight through */
+
+            nbytes = strm->remain;
+            if (nbytes > strm->avail_in)
+              {
+                nbytes = strm->avail_in;
+              }
+
+            nbytes = lzf_copyout(&strm->next_out, &strm->avail_out,
+                                 strm->next_in, nbytes);
+
+            strm->next_in  += nbytes;
+            strm->avail_in -= nbytes;
+            strm->remain   -= nbytes;
+
+            if (strm->remain == 0)
+              {
+                strm->state = LZF_STATE_HDR;
+              }
+            else if (strm->avail_out == 0)
+              {
+                return strm->remain;
+              }
+            break;
+
+          case LZF_STATE_DATA:
+            strm->remain -= lzf_copyin(&strm->next_in, &strm->avail_in,
+                                       &strm->inbuf[strm->clen -
+                                                    strm->remain],
+                                       strm->remain);
+
+            if (strm->remain > 0)
+              {
+                break;
+              }
+
+            nbytes = lzf_decompress(strm->inbuf, strm->clen,
+                                    strm->outbuf, strm->ulen);
+            if (nbytes != strm->ulen)
+              {
+                return -EINVAL;
+              }
+
+            strm->out    = strm->outbuf;
+            strm->outlen = nbytes;
+            strm->state  = LZF_STATE_HDR;
+            break;
+        }
+    }
+}
+
+#endif /* CONFIG_LIBC_LZF */
@@ -37,31 +37,45 @@
 
 float atan2f(float y, float x)
 {
-  if (x > 0)
-    {
-      return atanf(y / x);
-    }
-  else if (y >= 0 && x < 0)
+  float z;
+
+  if (isnan(x) || isnan(y))
     {
-      return atanf(y / x) + M_PI_F;
+      return NAN_F;
     }
-  else if (y < 0)
+
+  /* atan2(+-0, +0) = +-0, atan2(+-0, -0) = +-pi */
+
+  if (x == 0.0F)
     {
-      if (x == 0)
-        {
-          return -M_PI_2_F;
-        }
-      else /* Can only be x < 0 */
+      if (y == 0.0F)
         {
-          return atanf(y / x) - M_PI_F;
+          return copysignf(1.0F, x) < 0.0F ? copysignf(M_PI_F, y) : y;
         }
+
+      return y > 0.0F ? M_PI_2_F : -M_PI_2_F;
     }
-  else if (y > 0 && x == 0)
+
+  if (isinf_f(x))
     {
-      return M_PI_2_F;
+      if (isinf_f(y))
+        {
+          return copysignf(x > 0.0F ? M_PI_4_F : 3.0F * M_PI_4_F, y);
+        }
+
+      return x > 0.0F ? copysignf(0.0F, y) : copysignf(M_PI_F, y);
     }
-  else /* if (y == 0 && x == 0) Undefined but returns normally 0 */
+
+  z = atanf(y / x);
+
+  /* Move the result into the left half-plane, keeping the sign of y
+   * (including -0) for the choice between +pi and -pi.
+   */
+
+  if (x < 0.0F)
     {
-      return 0;
+      z += copysignf(M_PI_F, y);
     }
+
+  return z;
 }
@@ -29,15 +29,67 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdbool.h>
 #include <math.h>
-#include <stddef.h>
-#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define T3P8      2.414213562373095F   /* tan(3*pi/8) */
+#define TP8       0.4142135623730950F  /* tan(pi/8) */
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: atanf
+ *
+ * Description:
+ *   |x| is reduced to [0, tan(pi/8)] using atan(x) = pi/2 - atan(1/x) and
+ *   atan(x) = pi/4 + atan((x - 1)/(x + 1)).  The remainder is evaluated
+ *   with the single precision minimax polynomial of the Cephes library
+ *   (S. L. Moshier).  The error is below 2 ULP.
+ *
+ ****************************************************************************/
+
 float atanf(float x)
 {
-  return asinf(x / sqrtf(x * x + 1.0F));
+  bool neg;
+  float y;
+  float z;
+
+  if (isnan(x))
+    {
+      return x;
+    }
+
+  neg = false;
+  if (x < 0.0F)
+    {
+      neg = true;
+      x   = -x;
+    }
+
+  if (x > T3P8)
+    {
+      y = M_PI_2_F;
+      x = -1.0F / x;
+    }
+  else if (x > TP8)
+    {
+      y = M_PI_4_F;
+      x = (x - 1.0F) / (x + 1.0F);
+    }
+  else
+    {
+      y = 0.0F;
+    }
+
+  z  = x * x;
+  y += (((8.05374449538e-2F * z - 1.38776856032E-1F) * z +
+          1.99777106478E-1F) * z - 3.33329491539E-1F) * z * x + x;
+
+  return neg ? -y : y;
 }
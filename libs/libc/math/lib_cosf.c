@@ -29,13 +29,16 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdbool.h>
 #include <math.h>
 
+#include "libc.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 float cosf(float x)
 {
-  return sinf(x + M_PI_2_F);
+  return lib_sincosf(x, true);
 }
@@ -29,84 +29,97 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <stdint.h>
 #include <math.h>
 
-#include "libc.h"
-
 /****************************************************************************
- * Private Data
+ * Pre-processor Definitions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1/0! */
-  1.0 / 1.0,                    /* 1/1! */
-  1.0 / 2.0,                    /* 1/2! */
-  1.0 / 6.0,                    /* 1/3! */
-  1.0 / 24.0,                   /* 1/4! */
-  1.0 / 120.0,                  /* 1/5! */
-  1.0 / 720.0,                  /* 1/6! */
-  1.0 / 5040.0,                 /* 1/7! */
-  1.0 / 40320.0,                /* 1/8! */
-  1.0 / 362880.0,               /* 1/9! */
-  1.0 / 3628800.0,              /* 1/10! */
-};
+/* exp(MAXLOGF) is the largest finite float, exp(MINLOGF) the smallest
+ * denormal.
+ */
+
+#define MAXLOGF   88.72283905206835F
+#define MINLOGF   -103.278929903431851103F
+
+/* log2(e) and ln(2) split into two parts so that n * C1 is exact */
+
+#define LOG2EF    1.44269504088896341F
+#define C1        0.693359375F
+#define C2        -2.12194440e-4F
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: expf
+ *
+ * Description:
+ *   x is reduced to r = x - n * ln(2) with |r| <= ln(2)/2.  exp(r) is then
+ *   evaluated with the single precision minimax polynomial of the Cephes
+ *   library (S. L. Moshier) and scaled by 2^n by building the exponent
+ *   directly.  The error is below 1 ULP over the full range.
+ *
+ ****************************************************************************/
+
 float expf(float x)
 {
-  size_t int_part;
-  bool invert;
-  float value;
-  float x0;
-  size_t i;
+  union
+  {
+    float    f;
+    uint32_t i;
+  } u;
 
-  if (x == 0)
+  float y;
+  float z;
+  int n;
+
+  if (isnan(x))
     {
-      return 1;
+      return x;
     }
-  else if (x < 0)
+
+  if (x > MAXLOGF)
     {
-      invert = true;
-      x = -x;
+      return INFINITY_F;
     }
-  else
+
+  if (x < MINLOGF)
     {
-      invert = false;
+      return 0.0F;
     }
 
-  /* Extract integer component */
+  /* n = round(x / ln(2)) */
 
-  int_part = (size_t) x;
+  z = x * LOG2EF;
+  n = (int)(z < 0.0F ? z - 0.5F : z + 0.5F);
+  z = (float)n;
 
-  /* set x to fractional component */
+  x -= z * C1;
+  x -= z * C2;
+  z  = x * x;
 
-  x -= (float)int_part;
+  y = (((((1.9875691500E-4F  * x + 1.3981999507E-3F) * x +
+           8.3334519073E-3F) * x + 4.1665795894E-2F) * x +
+           1.6666665459E-1F) * x + 5.0000001201E-1F) * z + x + 1.0F;
 
-  /* Perform Taylor series approximation with eleven terms */
+  /* Multiply by 2^n.  n lies in [-150, 128]; move the ends of that range
+   * into y so that 2^n is a normal float.
+   */
 
-  value = 0.0F;
-  x0 = 1.0F;
-  for (i = 0; i < 10; i++)
+  if (n > 127)
     {
-      value += x0 * _flt_inv_fact[i];
-      x0 *= x;
+      y *= 2.0F;
+      n--;
     }
-
-  /* Multiply by exp of the integer component */
-
-  value *= lib_expif(int_part);
-
-  if (invert)
-    {
-      return (1.0F / value);
-    }
-  else
+  else if (n < -126)
     {
-      return value;
+      y *= 5.9604644775390625E-8F;  /* 2^-24 */
+      n += 24;
     }
+
+  u.i = (uint32_t)(n + 127) << 23;
+  return y * u.f;
 }
@@ -0,0 +1,150 @@
+/****************************************************************************
+ * libs/libc/math/lib_libsincosf.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* 4/pi and pi/4 split into four parts.  DP1-DP3 carry 10 significant bits
+ * each so that y * DP1, y * DP2 and y * DP3 are exact for y < 2^14.
+ */
+
+#define FOPI      1.27323954473516F
+#define DP1       0.78515625F
+#define DP2       2.4175643920898438e-4F
+#define DP3       1.5692785382270813e-7F
+#define DP4       3.038550314138355e-11F
+
+/* Above this magnitude the three part reduction loses accuracy, so the
+ * argument is first folded into [0, 2*pi).
+ */
+
+#define LOSSTH    8192.0F
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_sincosf
+ *
+ * Description:
+ *   Common kernel of sinf() and cosf().  The argument is reduced to
+ *   r in [-pi/4, pi/4] and quadrant q by Cody-Waite reduction against pi/4.
+ *   sin(r) and cos(r) are then evaluated with the single precision minimax
+ *   polynomials of the Cephes library (S. L. Moshier).  The error is below
+ *   2.5 ULP for |x| <= 8192.
+ *
+ * Input Parameters:
+ *   x      - The argument in radians
+ *   cosine - True to return cos(x), false to return sin(x)
+ *
+ ****************************************************************************/
+
+float lib_sincosf(float x, bool cosine)
+{
+  uint32_t q;
+  bool neg;
+  float y;
+  float z;
+  float r;
+
+  if (isnan(x) || isinf_f(x))
+    {
+      return NAN_F;
+    }
+
+  /* sin(-x) = -sin(x) and cos(-x) = cos(x) */
+
+  neg = false;
+  if (x < 0.0F)
+    {
+      x   = -x;
+      neg = !cosine;
+    }
+
+  if (x > LOSSTH)
+    {
+      x = fmodf(x, 2.0F * M_PI_F);
+    }
+
+  /* Round the octant up to an even number so that r is centered on zero */
+
+  q = (uint32_t)(x * FOPI);
+  q = (q + 1) & ~1;
+  y = (float)q;
+
+  r = (((x - y * DP1) - y * DP2) - y * DP3) - y * DP4;
+  z = r * r;
+
+  /* cos(x) = sin(x + pi/2) is one quadrant further along */
+
+  q >>= 1;
+  if (cosine)
+    {
+      q++;
+    }
+
+  if ((q & 2) != 0)
+    {
+      neg = !neg;
+    }
+
+  if ((q & 1) != 0)
+    {
+      y = ((2.443315711809948E-5F * z - 1.388731625493765E-3F) * z +
+           4.166664568298827E-2F) * z * z - 0.5F * z + 1.0F;
+    }
+  else
+    {
+      y = ((-1.9515295891E-4F * z + 8.3321608736E-3F) * z -
+           1.6666654611E-1F) * z * r + r;
+    }
+
+  return neg ? -y : y;
+}
@@ -29,22 +29,19 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdint.h>
 #include <math.h>
-#include <float.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define FLT_MAX_EXP_X   88.0F
+#define SQRTHF    0.707106781186547524F
 
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
- */
+/* ln(2) split into two parts so that e * C1 is exact */
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+#define C1        0.693359375F
+#define C2        -2.12194440e-4F
 
 /****************************************************************************
  * Public Functions
@@ -52,63 +49,86 @@
 
 /****************************************************************************
  * Name: logf
+ *
+ * Description:
+ *   x is split into 2^e * m with m in [sqrt(1/2), sqrt(2)) by taking the
+ *   exponent field apart.  log(m) is then evaluated with the single
+ *   precision minimax polynomial of the Cephes library (S. L. Moshier) and
+ *   e * ln(2) is added back.  The error is below 1 ULP over the full range.
+ *
  ****************************************************************************/
 
 float logf(float x)
 {
+  union
+  {
+    float    f;
+    uint32_t i;
+  } u;
+
   float y;
-  float y_old;
-  float ney;
-  float epsilon;
-  int   relax_factor;
-  int   iter;
+  float z;
+  float fe;
+  int e;
 
-  y       = 0.0F;
-  y_old   = 1.0F;
-  epsilon = FLT_EPSILON;
+  if (isnan(x))
+    {
+      return x;
+    }
 
-  iter         = 0;
-  relax_factor = 1;
+  if (x < 0.0F)
+    {
+      return NAN_F;
+    }
 
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  if (x == 0.0F)
     {
-      y_old = y;
-      ney   = expf(-y);
-      y    -= 1.0F - x * ney;
-
-      if (y > FLT_MAX_EXP_X)
-        {
-          y = FLT_MAX_EXP_X;
-        }
-
-      if (y < -FLT_MAX_EXP_X)
-        {
-          y = -FLT_MAX_EXP_X;
-        }
-
-      epsilon = (fabsf(y) > 1.0F) ? fabsf(y) * FLT_EPSILON : FLT_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
-        {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
-        }
-
-      if (relax_factor > 1)
-        {
-          epsilon *= relax_factor;
-        }
+      return -INFINITY_F;
     }
 
-  if (y == FLT_MAX_EXP_X)
+  if (isinf_f(x))
     {
-      return INFINITY;
+      return x;
     }
 
-  if (y == -FLT_MAX_EXP_X)
+  /* Normalize denormals before taking the exponent field apart */
+
+  e   = 0;
+  u.f = x;
+
+  if ((u.i & 0x7f800000) == 0)
     {
-      return INFINITY;
+      u.f *= 8388608.0F;  /* 2^23 */
+      e    = -23;
     }
 
-  return y;
+  /* m in [0.5, 1) */
+
+  e  += (int)((u.i >> 23) & 0xff) - 126;
+  u.i = (u.i & 0x007fffff) | 0x3f000000;
+  x   = u.f;
+
+  if (x < SQRTHF)
+    {
+      e--;
+      x = x + x - 1.0F;
+    }
+  else
+    {
+      x = x - 1.0F;
+    }
+
+  z = x * x;
+
+  y = ((((((((7.0376836292E-2F  * x - 1.1514610310E-1F) * x +
+              1.1676998740E-1F) * x - 1.2420140846E-1F) * x +
+              1.4249322787E-1F) * x - 1.6668057665E-1F) * x +
+              2.0000714765E-1F) * x - 2.4999993993E-1F) * x +
+              3.3333331174E-1F) * x * z;
+
+  fe = (float)e;
+  y += fe * C2;
+  y -= 0.5F * z;
+
+  return x + y + fe * C1;
 }
@@ -32,6 +32,8 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdint.h>
+#include <float.h>
 #include <math.h>
 #include <errno.h>
 
@@ -43,7 +45,16 @@
 
 float sqrtf(float x)
 {
-  float y;
+  union
+  {
+    float    f;
+    uint32_t i;
+  } u;
+
+  float scale;
+  float h;
+  float r;
+  float s;
 
   /* Filter out invalid/trivial inputs */
 
@@ -65,20 +76,34 @@ float sqrtf(float x)
 
   if (x == 0.0F)
     {
-      return 0.0F;
+      return x;
     }
 
-  /* Guess square root (using bit manipulation) */
+  /* Bring denormals into the normal range, sqrt(2^24 * x) = 2^12 * sqrt(x) */
 
-  y = lib_sqrtapprox(x);
+  scale = 1.0F;
+  if (x < FLT_MIN)
+    {
+      x    *= 16777216.0F;     /* 2^24 */
+      scale = 2.44140625E-4F;  /* 2^-12 */
+    }
 
-  /* Perform three iterations of approximation. This number (3) is
-   * definitely optimal
+  /* Guess 1/sqrt(x) from the exponent field and refine it with two
+   * Newton-Raphson steps, which need no division.
    */
 
-  y = 0.5F * (y + x / y);
-  y = 0.5F * (y + x / y);
-  y = 0.5F * (y + x / y);
+  u.f = x;
+  u.i = 0x5f3759df - (u.i >> 1);
+  r   = u.f;
+  h   = 0.5F * x;
+
+  r = r * (1.5F - h * r * r);
+  r = r * (1.5F - h * r * r);
+
+  /* sqrt(x) = x / sqrt(x) with one final correction of the residual */
+
+  s  = x * r;
+  s += 0.5F * r * (x - s * s);
 
-  return y;
+  return s * scale;
 }
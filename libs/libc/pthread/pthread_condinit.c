@@ -92,6 +92,14 @@ int pthread_cond_init(FAR pthread_cond_t *cond, FAR const pthread_condattr_t *at
        */
 
       sem_setprotocol(&cond->sem, SEM_PRIO_NONE);
+
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+      /* No mutex is associated with the condition variable until the first
+       * wait.
+       */
+
+      cond->mutex = NULL;
+#endif
     }
 
   sinfo("Returning %d\n", ret);
@@ -1,7 +1,7 @@
 /****************************************************************************
- * libc/net/lib_sendmsg.c
+ * libs/libc/pthread/pthread_mutexattr_getadaptive.c
  *
- *   Copyright (C) 2007, 2008, 2012, 2018 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -38,11 +38,7 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
-
-#ifdef CONFIG_NET
-
-#include <sys/types.h>
-#include <sys/socket.h>
+#include <pthread.h>
 #include <errno.h>
 
 /****************************************************************************
@@ -50,40 +46,32 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Function: sendmsg
+ * Name: pthread_mutexattr_getadaptive_np
  *
  * Description:
- *   The sendmsg() call is identical to sendto() with a NULL from parameter.
+ *   Return the adaptive spinning setting from the mutex attributes.  This
+ *   is a non-standard interface.
  *
- * Parameters:
- *   sockfd   Socket descriptor of socket
- *   buf      Buffer to send data
- *   len      Length of buffer
- *   flags    Receive flags
+ * Input Parameters:
+ *   attr     - The mutex attributes to query
+ *   adaptive - Location to return the adaptive setting (0 or 1)
  *
  * Returned Value:
- *  (see sendto)
+ *   0, if the setting was successfully return in 'adaptive', or
+ *   EINVAL, if any NULL pointers provided.
  *
  * Assumptions:
  *
  ****************************************************************************/
 
-ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+int pthread_mutexattr_getadaptive_np(FAR const pthread_mutexattr_t *attr,
+                                     FAR int *adaptive)
 {
-  FAR void *buf           = msg->msg_iov->iov_base;
-  FAR struct sockaddr *to = msg->msg_name;
-  socklen_t tolen         = msg->msg_namelen;
-  size_t len              = msg->msg_iov->iov_len;
-
-  if (msg->msg_iovlen == 1)
+  if (attr != NULL && adaptive != NULL)
     {
-      return sendto(sockfd, buf, len, flags, to, tolen);
+      *adaptive = attr->adaptive;
+      return 0;
     }
-  else
-    {
-      set_errno(ENOTSUP);
-      return ERROR;
-    }
-}
 
-#endif /* CONFIG_NET */
+  return EINVAL;
+}
@@ -91,6 +91,10 @@ int pthread_mutexattr_init(FAR pthread_mutexattr_t *attr)
 #else
       attr->robust  = PTHREAD_MUTEX_ROBUST;
 #endif
+#endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+      attr->adaptive = 0;
 #endif
     }
 
@@ -55,7 +55,9 @@ int pthread_rwlock_init(FAR pthread_rwlock_t *lock,
 {
   int err;
 
-  if (attr != NULL)
+  /* Only writer preference is supported by this implementation */
+
+  if (attr != NULL && *attr != PTHREAD_RWLOCK_PREFER_WRITER_NP)
     {
       return -ENOSYS;
     }
@@ -0,0 +1,455 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_rwlock_fast.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_PTHREAD_RWLOCK_FASTPATH
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwlock_enter and rwlock_leave
+ *
+ * Description:
+ *   Enter and leave the very short section in which the lock state is
+ *   examined and modified.
+ *
+ ****************************************************************************/
+
+static inline irqstate_t rwlock_enter(FAR pthread_rwlock_t *rw_lock)
+{
+  irqstate_t flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock(&rw_lock->spin);
+#endif
+  return flags;
+}
+
+static inline void rwlock_leave(FAR pthread_rwlock_t *rw_lock,
+                                irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&rw_lock->spin);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: rwlock_wait
+ *
+ * Description:
+ *   Wait on one of the rwlock semaphores.  Read/write lock waits are not
+ *   interrupted by signals.
+ *
+ ****************************************************************************/
+
+static int rwlock_wait(FAR sem_t *sem, FAR const struct timespec *ts)
+{
+  int ret;
+
+  do
+    {
+      ret = (ts != NULL) ? sem_timedwait(sem, ts) : sem_wait(sem);
+      if (ret == OK)
+        {
+          return OK;
+        }
+
+      ret = get_errno();
+    }
+  while (ret == EINTR);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: tryrdlock
+ *
+ * Description:
+ *   Take a read lock if no writer prevents it.  With writer preference a
+ *   pending writer blocks new readers; with reader preference only an
+ *   active writer does.
+ *
+ ****************************************************************************/
+
+static int tryrdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  irqstate_t flags;
+  int err;
+
+  flags = rwlock_enter(rw_lock);
+  if (rw_lock->wrstate == _PTHREAD_RWLOCK_WRACTIVE ||
+      (rw_lock->wrstate == _PTHREAD_RWLOCK_WRPENDING &&
+       rw_lock->kind == PTHREAD_RWLOCK_PREFER_WRITER_NP))
+    {
+      err = EBUSY;
+    }
+  else if (rw_lock->num_readers == UINT_MAX)
+    {
+      err = EAGAIN;
+    }
+  else
+    {
+      rw_lock->num_readers++;
+      err = OK;
+    }
+
+  rwlock_leave(rw_lock, flags);
+  return err;
+}
+
+/****************************************************************************
+ * Name: wrunlock
+ *
+ * Description:
+ *   Withdraw a pending or active writer and let blocked threads proceed.
+ *
+ ****************************************************************************/
+
+static void wrunlock(FAR pthread_rwlock_t *rw_lock)
+{
+  irqstate_t flags;
+
+  flags = rwlock_enter(rw_lock);
+  rw_lock->wrstate   = _PTHREAD_RWLOCK_WRNONE;
+  rw_lock->wrwaiting = false;
+  rwlock_leave(rw_lock, flags);
+
+  (void)sem_post(&rw_lock->wrsem);
+}
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+static void wrlock_cleanup(FAR void *arg)
+{
+  wrunlock((FAR pthread_rwlock_t *)arg);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_rwlock_init
+ *
+ * Description:
+ *   Initialize a read/write lock.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_init(FAR pthread_rwlock_t *lock,
+                        FAR const pthread_rwlockattr_t *attr)
+{
+  int kind = PTHREAD_RWLOCK_PREFER_WRITER_NP;
+
+  if (attr != NULL)
+    {
+      kind = *attr;
+      if (kind != PTHREAD_RWLOCK_PREFER_READER_NP &&
+          kind != PTHREAD_RWLOCK_PREFER_WRITER_NP)
+        {
+          return EINVAL;
+        }
+    }
+
+  /* The writer semaphore provides priority inheritance for writers.  The
+   * reader semaphore is only used for signaling.
+   */
+
+  (void)sem_init(&lock->wrsem, 0, 1);
+  (void)sem_init(&lock->rdsem, 0, 0);
+  sem_setprotocol(&lock->rdsem, SEM_PRIO_NONE);
+
+#ifdef CONFIG_SMP
+  spin_initialize(&lock->spin, SP_UNLOCKED);
+#endif
+  lock->num_readers = 0;
+  lock->wrstate     = _PTHREAD_RWLOCK_WRNONE;
+  lock->kind        = kind;
+  lock->wrwaiting   = false;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_rwlock_destroy
+ ****************************************************************************/
+
+int pthread_rwlock_destroy(FAR pthread_rwlock_t *lock)
+{
+  if (lock->num_readers > 0 || lock->wrstate != _PTHREAD_RWLOCK_WRNONE)
+    {
+      return EBUSY;
+    }
+
+  (void)sem_destroy(&lock->wrsem);
+  (void)sem_destroy(&lock->rdsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_rwlock_rdlock
+ *
+ * Description:
+ *   Locks a read/write lock for reading.  If no writer prevents it, the
+ *   read lock is taken without blocking.  Otherwise the caller waits on the
+ *   writer semaphore, boosting the priority of the writer.  Holding that
+ *   semaphore guarantees that there is no writer.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_tryrdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return tryrdlock(rw_lock);
+}
+
+int pthread_rwlock_timedrdlock(FAR pthread_rwlock_t *rw_lock,
+                               FAR const struct timespec *ts)
+{
+  irqstate_t flags;
+  int err;
+
+  err = tryrdlock(rw_lock);
+  if (err != EBUSY)
+    {
+      return err;
+    }
+
+  err = rwlock_wait(&rw_lock->wrsem, ts);
+  if (err != OK)
+    {
+      return err;
+    }
+
+  flags = rwlock_enter(rw_lock);
+  if (rw_lock->num_readers == UINT_MAX)
+    {
+      err = EAGAIN;
+    }
+  else
+    {
+      rw_lock->num_readers++;
+    }
+
+  rwlock_leave(rw_lock, flags);
+
+  (void)sem_post(&rw_lock->wrsem);
+  return err;
+}
+
+int pthread_rwlock_rdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return pthread_rwlock_timedrdlock(rw_lock, NULL);
+}
+
+/****************************************************************************
+ * Name: pthread_rwlock_wrlock
+ *
+ * Description:
+ *   Locks a read/write lock for writing.  The writer first takes the
+ *   writer semaphore, then waits until the readers holding the lock have
+ *   left.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_trywrlock(FAR pthread_rwlock_t *rw_lock)
+{
+  irqstate_t flags;
+  int err = OK;
+
+  if (sem_trywait(&rw_lock->wrsem) != OK)
+    {
+      return EBUSY;
+    }
+
+  flags = rwlock_enter(rw_lock);
+  if (rw_lock->num_readers > 0)
+    {
+      err = EBUSY;
+    }
+  else
+    {
+      rw_lock->wrstate = _PTHREAD_RWLOCK_WRACTIVE;
+    }
+
+  rwlock_leave(rw_lock, flags);
+
+  if (err != OK)
+    {
+      (void)sem_post(&rw_lock->wrsem);
+    }
+
+  return err;
+}
+
+int pthread_rwlock_timedwrlock(FAR pthread_rwlock_t *rw_lock,
+                               FAR const struct timespec *ts)
+{
+  irqstate_t flags;
+  bool active;
+  int err;
+
+  err = rwlock_wait(&rw_lock->wrsem, ts);
+  if (err != OK)
+    {
+      return err;
+    }
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+  pthread_cleanup_push(&wrlock_cleanup, rw_lock);
+#endif
+
+  /* Wait for the readers to leave.  With reader preference, new readers
+   * may still enter while we wait so the state must be checked again
+   * after every wakeup.  A count left on rdsem by an abandoned wait only
+   * causes an extra pass.
+   */
+
+  for (; ; )
+    {
+      flags = rwlock_enter(rw_lock);
+      active = (rw_lock->num_readers == 0);
+      if (active)
+        {
+          rw_lock->wrstate   = _PTHREAD_RWLOCK_WRACTIVE;
+          rw_lock->wrwaiting = false;
+        }
+      else
+        {
+          rw_lock->wrstate   = _PTHREAD_RWLOCK_WRPENDING;
+          rw_lock->wrwaiting = true;
+        }
+
+      rwlock_leave(rw_lock, flags);
+
+      if (active)
+        {
+          break;
+        }
+
+      err = rwlock_wait(&rw_lock->rdsem, ts);
+      if (err != OK)
+        {
+          break;
+        }
+    }
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+  pthread_cleanup_pop(0);
+#endif
+
+  if (err != OK)
+    {
+      /* Give up:  Let blocked readers and writers proceed */
+
+      wrunlock(rw_lock);
+    }
+
+  return err;
+}
+
+int pthread_rwlock_wrlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return pthread_rwlock_timedwrlock(rw_lock, NULL);
+}
+
+/****************************************************************************
+ * Name: pthread_rwlock_unlock
+ *
+ * Description:
+ *   Release a read or write lock.  The last reader to leave wakes up a
+ *   writer that is waiting for the readers to drain.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
+{
+  irqstate_t flags;
+  bool wrrelease = false;
+  bool wakeup = false;
+  int err = OK;
+
+  flags = rwlock_enter(rw_lock);
+  if (rw_lock->wrstate == _PTHREAD_RWLOCK_WRACTIVE)
+    {
+      /* There are no readers while a writer is active */
+
+      wrrelease = true;
+    }
+  else if (rw_lock->num_readers > 0)
+    {
+      rw_lock->num_readers--;
+      if (rw_lock->num_readers == 0 && rw_lock->wrwaiting)
+        {
+          rw_lock->wrwaiting = false;
+          wakeup = true;
+        }
+    }
+  else
+    {
+      err = EINVAL;
+    }
+
+  rwlock_leave(rw_lock, flags);
+
+  if (wrrelease)
+    {
+      wrunlock(rw_lock);
+    }
+  else if (wakeup)
+    {
+      (void)sem_post(&rw_lock->rdsem);
+    }
+
+  return err;
+}
+
+#endif /* CONFIG_PTHREAD_RWLOCK_FASTPATH */
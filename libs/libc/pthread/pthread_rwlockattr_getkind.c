@@ -1,7 +1,7 @@
 /****************************************************************************
- * libc/net/lib_recvmsg.c
+ * libs/libc/pthread/pthread_rwlockattr_getkind.c
  *
- *   Copyright (C) 2007, 2008, 2012, 2008 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -39,10 +39,7 @@
 
 #include <nuttx/config.h>
 
-#ifdef CONFIG_NET
-
-#include <sys/types.h>
-#include <sys/socket.h>
+#include <pthread.h>
 #include <errno.h>
 
 /****************************************************************************
@@ -50,40 +47,31 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Function: recvmsg
+ * Name:  pthread_rwlockattr_getkind_np
  *
  * Description:
- *   The recvmsg() call is identical to recvfrom() with a NULL from parameter.
+ *   Return the reader/writer preference from the read/write lock
+ *   attributes.  This is a non-standard interface.
  *
- * Parameters:
- *   sockfd   Socket descriptor of socket
- *   buf      Buffer to receive data
- *   len      Length of buffer
- *   flags    Receive flags
+ * Input Parameters:
+ *   attr - The read/write lock attributes to query
+ *   pref - Location to return the PTHREAD_RWLOCK_PREFER_* value
  *
  * Returned Value:
- *  (see recvfrom)
+ *   0 on success or EINVAL if any NULL pointers are provided.
  *
  * Assumptions:
  *
  ****************************************************************************/
 
-ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+int pthread_rwlockattr_getkind_np(FAR const pthread_rwlockattr_t *attr,
+                                  FAR int *pref)
 {
-  FAR void *buf             = msg->msg_iov->iov_base;
-  FAR struct sockaddr *from = msg->msg_name;
-  FAR socklen_t *fromlen    = (FAR socklen_t *)&msg->msg_namelen;
-  size_t len                = msg->msg_iov->iov_len;
-
-  if (msg->msg_iovlen == 1)
-    {
-      return recvfrom(sockfd, buf, len, flags, from, fromlen);
-    }
-  else
+  if (attr == NULL || pref == NULL)
     {
-      set_errno(ENOTSUP);
-      return ERROR;
+      return EINVAL;
     }
-}
 
-#endif /* CONFIG_NET */
+  *pref = *attr;
+  return OK;
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_rwlockattr_setkind.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <pthread.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  pthread_rwlockattr_setkind_np
+ *
+ * Description:
+ *   Select reader or writer preference in the read/write lock attributes.
+ *   With reader preference, readers may take the lock while a writer is
+ *   waiting; with writer preference, they wait until the writer has had
+ *   its turn.  Reader preference requires CONFIG_PTHREAD_RWLOCK_FASTPATH.
+ *   This is a non-standard interface.
+ *
+ * Input Parameters:
+ *   attr - The read/write lock attributes to modify
+ *   pref - PTHREAD_RWLOCK_PREFER_READER_NP or
+ *          PTHREAD_RWLOCK_PREFER_WRITER_NP
+ *
+ * Returned Value:
+ *   0 on success or EINVAL if 'attr' is NULL or 'pref' is not supported.
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+int pthread_rwlockattr_setkind_np(FAR pthread_rwlockattr_t *attr, int pref)
+{
+  if (attr == NULL)
+    {
+      return EINVAL;
+    }
+
+#ifdef CONFIG_PTHREAD_RWLOCK_FASTPATH
+  if (pref != PTHREAD_RWLOCK_PREFER_READER_NP &&
+      pref != PTHREAD_RWLOCK_PREFER_WRITER_NP)
+#else
+  if (pref != PTHREAD_RWLOCK_PREFER_WRITER_NP)
+#endif
+    {
+      return EINVAL;
+    }
+
+  *attr = pref;
+  return OK;
+}
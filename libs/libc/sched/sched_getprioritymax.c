@@ -67,6 +67,6 @@
 
 int sched_get_priority_max(int policy)
 {
-  DEBUGASSERT(policy >= SCHED_FIFO && policy <= SCHED_OTHER);
+  DEBUGASSERT(policy >= SCHED_FIFO && policy <= SCHED_DEADLINE);
   return SCHED_PRIORITY_MAX;
 }
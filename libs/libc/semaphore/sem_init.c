@@ -87,6 +87,10 @@ int nxsem_init(FAR sem_t *sem, int pshared, unsigned int value)
 
       sem->semcount         = (int16_t)value;
 
+      /* No threads are waiting for the semaphore yet */
+
+      dq_init(&sem->waitlist);
+
       /* Initialize to support priority inheritance */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
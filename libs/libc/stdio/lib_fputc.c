@@ -74,3 +74,34 @@ int fputc(int c, FAR FILE *stream)
       return EOF;
     }
 }
+
+/****************************************************************************
+ * Name: fputc_unlocked
+ ****************************************************************************/
+
+int fputc_unlocked(int c, FAR FILE *stream)
+{
+  unsigned char buf = (unsigned char)c;
+  int ret;
+
+  ret = lib_fwrite_unlocked(&buf, 1, stream);
+  if (ret > 0)
+    {
+      /* Flush the buffer if a newline is output */
+
+      if (c == '\n' && (stream->fs_flags & __FS_FLAG_LBF) != 0)
+        {
+          ret = lib_fflush(stream, true);
+          if (ret < 0)
+            {
+              return EOF;
+            }
+        }
+
+      return c;
+    }
+  else
+    {
+      return EOF;
+    }
+}
@@ -71,3 +71,23 @@ size_t fwrite(FAR const void *ptr, size_t size, size_t n_items,
 
   return items_written;
 }
+
+/****************************************************************************
+ * Name: fwrite_unlocked
+ ****************************************************************************/
+
+size_t fwrite_unlocked(FAR const void *ptr, size_t size, size_t n_items,
+                       FAR FILE *stream)
+{
+  size_t  full_size = n_items * (size_t)size;
+  ssize_t bytes_written;
+  size_t  items_written = 0;
+
+  bytes_written = lib_fwrite_unlocked(ptr, full_size, stream);
+  if (bytes_written > 0)
+    {
+      items_written = bytes_written / size;
+    }
+
+  return items_written;
+}
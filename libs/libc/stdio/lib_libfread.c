@@ -55,10 +55,16 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fread
+ * Name: lib_fread_unlocked
+ *
+ * Description:
+ *   Read from a stream without taking the stream semaphore.  The caller must
+ *   hold the stream lock (see flockfile()) or otherwise guarantee exclusive
+ *   access to the stream.
+ *
  ****************************************************************************/
 
-ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream)
 {
   FAR unsigned char *dest  = (FAR unsigned char*)ptr;
   ssize_t bytes_read;
@@ -76,10 +82,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
     }
   else
     {
-      /* The stream must be stable until we complete the read */
-
-      lib_take_semaphore(stream);
-
 #if CONFIG_NUNGET_CHARS > 0
       /* First, re-read any previously ungotten characters */
 
@@ -109,11 +111,14 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
            * buffered read/write access.
            */
 
-          ret = lib_wrflush(stream);
-          if (ret < 0)
+          if (stream->fs_bufread == stream->fs_bufstart &&
+              stream->fs_bufpos != stream->fs_bufstart)
             {
-              lib_give_semaphore(stream);
-              return ret;
+              ret = lib_wrflush(stream);
+              if (ret < 0)
+                {
+                  return ret;
+                }
             }
 
           /* Now get any other needed chars from the buffer or the file. */
@@ -280,8 +285,6 @@ shortread:
         {
           stream->fs_flags |= __FS_FLAG_EOF;
         }
-
-      lib_give_semaphore(stream);
     }
 
   return count - remaining;
@@ -290,6 +293,28 @@ shortread:
 
 errout_with_errno:
   stream->fs_flags |= __FS_FLAG_ERROR;
-  lib_give_semaphore(stream);
   return -get_errno();
 }
+
+/****************************************************************************
+ * Name: lib_fread
+ ****************************************************************************/
+
+ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return -1;
+    }
+
+  /* The stream must be stable until we complete the read */
+
+  lib_take_semaphore(stream);
+  ret = lib_fread_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -184,6 +184,8 @@ static int  getllusize(uint8_t fmt, FAR uint8_t flags,
                        FAR unsigned long long lln);
 #endif
 
+static void putpad(FAR struct lib_outstream_s *obj, FAR const char *pad,
+                   int npad);
 static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
                        uint8_t justify, uint8_t flags, int fieldwidth,
                        int valwidth, int trunc);
@@ -197,6 +199,27 @@ static void postjustify(FAR struct lib_outstream_s *obj, uint8_t justify,
 
 static const char g_nullstring[] = "(null)";
 
+/* Conversion tables.  g_decpairs holds the two digit strings "00".."99" so
+ * that decimal conversion needs only one division per two digits.
+ */
+
+static const char g_decpairs[] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+static const char g_hexlower[] = "0123456789abcdef";
+static const char g_hexupper[] = "0123456789ABCDEF";
+
+/* Runs of padding are output from these in blocks */
+
+#define PAD_BLOCK 16
+
+static const char g_padspaces[PAD_BLOCK + 1] = "                ";
+static const char g_padzeros[PAD_BLOCK + 1]  = "0000000000000000";
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -270,20 +293,33 @@ static int getpsize(uint8_t flags, FAR void *p)
 
 static void utodec(FAR struct lib_outstream_s *obj, unsigned int n)
 {
-  char buf[16];
-  int i = 0;
+  char buf[3 * sizeof(unsigned int)];
+  int i = sizeof(buf);
 
-  do
+  /* Convert two digits per division using the digit pair table */
+
+  while (n >= 100)
     {
-      buf[i++] = n % 10 + '0';
-      n /= 10;
+      int r = (int)(n % 100);
+      n /= 100;
+
+      i -= 2;
+      buf[i]     = g_decpairs[2 * r];
+      buf[i + 1] = g_decpairs[2 * r + 1];
     }
-  while (n > 0);
 
-  while (i > 0)
+  if (n >= 10)
+    {
+      i -= 2;
+      buf[i]     = g_decpairs[2 * n];
+      buf[i + 1] = g_decpairs[2 * n + 1];
+    }
+  else
     {
-      obj->put(obj, buf[--i]);
+      buf[--i] = (char)n + '0';
     }
+
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -293,31 +329,18 @@ static void utodec(FAR struct lib_outstream_s *obj, unsigned int n)
 static void utohex(FAR struct lib_outstream_s *obj, unsigned int n,
                    uint8_t a)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  FAR const char *digits = (a == 'A') ? g_hexupper : g_hexlower;
+  char buf[2 * sizeof(unsigned int)];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned int); bits > 0; bits -= 4)
+  do
     {
-      uint8_t nibble = (uint8_t)((n >> (bits - 4)) & 0xf);
-      if (nibble || nonzero)
-        {
-          nonzero = true;
-
-          if (nibble < 10)
-            {
-              obj->put(obj, nibble + '0');
-            }
-          else
-            {
-              obj->put(obj, nibble + a - 10);
-            }
-        }
+      buf[--i] = digits[n & 0xf];
+      n >>= 4;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -326,23 +349,17 @@ static void utohex(FAR struct lib_outstream_s *obj, unsigned int n,
 
 static void utooct(FAR struct lib_outstream_s *obj, unsigned int n)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  char buf[(CHAR_BIT * sizeof(unsigned int) + 2) / 3];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned int); bits > 0; bits -= 3)
+  do
     {
-      uint8_t tribit = (uint8_t)((n >> (bits - 3)) & 0x7);
-      if (tribit || nonzero)
-        {
-          nonzero = true;
-          obj->put(obj, (tribit + '0'));
-        }
+      buf[--i] = (char)(n & 7) + '0';
+      n >>= 3;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -351,23 +368,17 @@ static void utooct(FAR struct lib_outstream_s *obj, unsigned int n)
 
 static void utobin(FAR struct lib_outstream_s *obj, unsigned int n)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  char buf[CHAR_BIT * sizeof(unsigned int)];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned int); bits > 0; bits -= 1)
+  do
     {
-      uint8_t unibit = (uint8_t)((n >> (bits - 1)) & 0x1);
-      if (unibit || nonzero)
-        {
-          nonzero = true;
-          obj->put(obj, (unibit + '0'));
-        }
+      buf[--i] = (char)(n & 1) + '0';
+      n >>= 1;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -519,20 +530,33 @@ static int getdblsize(uint8_t fmt, int trunc, uint8_t flags, double n)
 
 static void lutodec(FAR struct lib_outstream_s *obj, unsigned long n)
 {
-  char buf[32];
-  int i = 0;
+  char buf[3 * sizeof(unsigned long)];
+  int i = sizeof(buf);
 
-  do
+  /* Convert two digits per division using the digit pair table */
+
+  while (n >= 100)
     {
-      buf[i++] = n % 10 + '0';
-      n /= 10;
+      int r = (int)(n % 100);
+      n /= 100;
+
+      i -= 2;
+      buf[i]     = g_decpairs[2 * r];
+      buf[i + 1] = g_decpairs[2 * r + 1];
     }
-  while (n > 0);
 
-  while (i > 0)
+  if (n >= 10)
+    {
+      i -= 2;
+      buf[i]     = g_decpairs[2 * n];
+      buf[i + 1] = g_decpairs[2 * n + 1];
+    }
+  else
     {
-      obj->put(obj, buf[--i]);
+      buf[--i] = (char)n + '0';
     }
+
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -542,31 +566,18 @@ static void lutodec(FAR struct lib_outstream_s *obj, unsigned long n)
 static void lutohex(FAR struct lib_outstream_s *obj, unsigned long n,
                     uint8_t a)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  FAR const char *digits = (a == 'A') ? g_hexupper : g_hexlower;
+  char buf[2 * sizeof(unsigned long)];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned long); bits > 0; bits -= 4)
+  do
     {
-      uint8_t nibble = (uint8_t)((n >> (bits - 4)) & 0xf);
-      if (nibble || nonzero)
-        {
-          nonzero = true;
-
-          if (nibble < 10)
-            {
-              obj->put(obj, nibble + '0');
-            }
-          else
-            {
-              obj->put(obj, nibble + a - 10);
-            }
-        }
+      buf[--i] = digits[n & 0xf];
+      n >>= 4;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -575,23 +586,17 @@ static void lutohex(FAR struct lib_outstream_s *obj, unsigned long n,
 
 static void lutooct(FAR struct lib_outstream_s *obj, unsigned long n)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  char buf[(CHAR_BIT * sizeof(unsigned long) + 2) / 3];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned long); bits > 0; bits -= 3)
+  do
     {
-      uint8_t tribit = (uint8_t)((n >> (bits - 3)) & 0x7);
-      if (tribit || nonzero)
-        {
-          nonzero = true;
-          obj->put(obj, (tribit + '0'));
-        }
+      buf[--i] = (char)(n & 7) + '0';
+      n >>= 3;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -600,23 +605,17 @@ static void lutooct(FAR struct lib_outstream_s *obj, unsigned long n)
 
 static void lutobin(FAR struct lib_outstream_s *obj, unsigned long n)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  char buf[CHAR_BIT * sizeof(unsigned long)];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned long); bits > 0; bits -= 1)
+  do
     {
-      uint8_t unibit = (uint8_t)((n >> (bits - 1)) & 0x1);
-      if (unibit || nonzero)
-        {
-          nonzero = true;
-          obj->put(obj, (unibit + '0'));
-        }
+      buf[--i] = (char)(n & 1) + '0';
+      n >>= 1;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -749,20 +748,33 @@ static int getlusize(uint8_t fmt, uint8_t flags, unsigned long ln)
 
 static void llutodec(FAR struct lib_outstream_s *obj, unsigned long long n)
 {
-  char buf[32];
-  int i = 0;
+  char buf[3 * sizeof(unsigned long long)];
+  int i = sizeof(buf);
 
-  do
+  /* Convert two digits per division using the digit pair table */
+
+  while (n >= 100)
     {
-      buf[i++] = n % 10 + '0';
-      n /= 10;
+      int r = (int)(n % 100);
+      n /= 100;
+
+      i -= 2;
+      buf[i]     = g_decpairs[2 * r];
+      buf[i + 1] = g_decpairs[2 * r + 1];
     }
-  while (n > 0);
 
-  while (i > 0)
+  if (n >= 10)
     {
-      obj->put(obj, buf[--i]);
+      i -= 2;
+      buf[i]     = g_decpairs[2 * n];
+      buf[i + 1] = g_decpairs[2 * n + 1];
     }
+  else
+    {
+      buf[--i] = (char)n + '0';
+    }
+
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -772,31 +784,18 @@ static void llutodec(FAR struct lib_outstream_s *obj, unsigned long long n)
 static void llutohex(FAR struct lib_outstream_s *obj, unsigned long long n,
                      uint8_t a)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  FAR const char *digits = (a == 'A') ? g_hexupper : g_hexlower;
+  char buf[2 * sizeof(unsigned long long)];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT*sizeof(unsigned long long); bits > 0; bits -= 4)
+  do
     {
-      uint8_t nibble = (uint8_t)((n >> (bits - 4)) & 0xf);
-      if (nibble || nonzero)
-        {
-          nonzero = true;
-
-          if (nibble < 10)
-            {
-              obj->put(obj, (nibble + '0'));
-            }
-          else
-            {
-              obj->put(obj, (nibble + a - 10));
-            }
-        }
+      buf[--i] = digits[n & 0xf];
+      n >>= 4;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -805,23 +804,17 @@ static void llutohex(FAR struct lib_outstream_s *obj, unsigned long long n,
 
 static void llutooct(FAR struct lib_outstream_s *obj, unsigned long long n)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  char buf[(CHAR_BIT * sizeof(unsigned long long) + 2) / 3];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned long long); bits > 0; bits -= 3)
+  do
     {
-      uint8_t tribit = (uint8_t)((n >> (bits - 3)) & 0x7);
-      if (tribit || nonzero)
-        {
-          nonzero = true;
-          obj->put(obj, (tribit + '0'));
-        }
+      buf[--i] = (char)(n & 7) + '0';
+      n >>= 3;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -830,23 +823,17 @@ static void llutooct(FAR struct lib_outstream_s *obj, unsigned long long n)
 
 static void llutobin(FAR struct lib_outstream_s *obj, unsigned long long n)
 {
-  bool    nonzero = false;
-  uint8_t bits;
+  char buf[CHAR_BIT * sizeof(unsigned long long)];
+  int i = sizeof(buf);
 
-  for (bits = CHAR_BIT * sizeof(unsigned long long); bits > 0; bits -= 1)
+  do
     {
-      uint8_t unibit = (uint8_t)((n >> (bits - 1)) & 0x1);
-      if (unibit || nonzero)
-        {
-          nonzero = true;
-          obj->put(obj, (unibit + '0'));
-        }
+      buf[--i] = (char)(n & 1) + '0';
+      n >>= 1;
     }
+  while (n > 0);
 
-  if (!nonzero)
-    {
-      obj->put(obj, '0');
-    }
+  lib_stream_puts(obj, &buf[i], sizeof(buf) - i);
 }
 
 /****************************************************************************
@@ -972,6 +959,22 @@ static int getllusize(uint8_t fmt, uint8_t flags, unsigned long long lln)
 
 #endif /* CONFIG_HAVE_LONG_LONG */
 
+/****************************************************************************
+ * Name: putpad
+ ****************************************************************************/
+
+static void putpad(FAR struct lib_outstream_s *obj, FAR const char *pad,
+                   int npad)
+{
+  while (npad > 0)
+    {
+      int nput = npad < PAD_BLOCK ? npad : PAD_BLOCK;
+
+      lib_stream_puts(obj, pad, nput);
+      npad -= nput;
+    }
+}
+
 /****************************************************************************
  * Name: prejustify
  ****************************************************************************/
@@ -982,7 +985,6 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
 {
   bool althex = (fmt == 'x' || fmt == 'X' || fmt == 'p' || fmt == 'P')
                 && IS_ALTFORM(flags);
-  int i;
 
   /* If there is integer precision, then use FMT_RJUST vs FMT_RJUST0 */
 
@@ -1018,10 +1020,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
                   padlen -= 2;
                 }
 
-              for (i = padlen; i > 0; i--)
-                {
-                  obj->put(obj, ' ');
-                }
+              putpad(obj, g_padspaces, padlen);
 
               if (IS_NEGATE(flags))
                 {
@@ -1038,10 +1037,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
                   obj->put(obj, 'x');
                 }
 
-              for (i = trunc - valwidth; i > 0; i--)
-                {
-                  obj->put(obj, '0');
-                }
+              putpad(obj, g_padzeros, trunc - valwidth);
             }
           else
             {
@@ -1057,10 +1053,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
                   valwidth += 2;
                 }
 
-              for (i = fieldwidth - valwidth; i > 0; i--)
-                {
-                  obj->put(obj, ' ');
-                }
+              putpad(obj, g_padspaces, fieldwidth - valwidth);
 
               if (IS_NEGATE(flags))
                 {
@@ -1100,10 +1093,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
               valwidth += 2;
             }
 
-          for (i = fieldwidth - valwidth; i > 0; i--)
-            {
-              obj->put(obj, '0');
-            }
+          putpad(obj, g_padzeros, fieldwidth - valwidth);
         }
         break;
 
@@ -1126,10 +1116,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
 
           /* Pad with zeros up to the size of the value width. */
 
-          for (i = trunc - valwidth; i > 0; i--)
-            {
-              obj->put(obj, '0');
-            }
+          putpad(obj, g_padzeros, trunc - valwidth);
         }
         break;
     }
@@ -1143,8 +1130,6 @@ static void postjustify(FAR struct lib_outstream_s *obj, uint8_t justify,
                         uint8_t flags, int fieldwidth, int valwidth,
                         int trunc)
 {
-  int i;
-
   /* Apply field justification to the integer value. */
 
   switch (justify)
@@ -1165,10 +1150,7 @@ static void postjustify(FAR struct lib_outstream_s *obj, uint8_t justify,
 
           width = valwidth < trunc ? trunc : valwidth;
 
-          for (i = fieldwidth - width; i > 0; i--)
-            {
-              obj->put(obj, ' ');
-            }
+          putpad(obj, g_padspaces, fieldwidth - width);
         }
         break;
     }
@@ -1200,9 +1182,24 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const IPTR char *src,
 
       if (FMT_CHAR != '%')
         {
+#ifdef CONFIG_ARCH_ROMGETC
            /* Output the character */
 
            obj->put(obj, FMT_CHAR);
+#else
+           FAR const IPTR char *run = src;
+
+           /* Output the run of literal characters up to the next format
+            * specifier or through the next newline in one put.
+            */
+
+           while (src[1] != '\0' && src[1] != '%' && *src != '\n')
+             {
+               src++;
+             }
+
+           lib_stream_puts(obj, run, src - run + 1);
+#endif
 
            /* Flush the buffer if a newline is encountered */
 
@@ -1348,7 +1345,6 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const IPTR char *src,
       if (FMT_CHAR == 's')
         {
           int swidth;
-          int left;
 
           /* Get the string to output */
 
@@ -1365,20 +1361,10 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const IPTR char *src,
           swidth = (IS_HASDOT(flags) && trunc >= 0)
                       ? strnlen(ptmp, trunc) : strlen(ptmp);
           prejustify(obj, FMT_CHAR, justify, 0, width, swidth, 0);
-          left = swidth;
 
           /* Concatenate the string into the output */
 
-          while (*ptmp)
-            {
-              if (left-- <= 0)
-                {
-                  break;
-                }
-
-              obj->put(obj, *ptmp);
-              ptmp++;
-            }
+          lib_stream_puts(obj, ptmp, swidth);
 
           /* Perform left-justification operations. */
 
@@ -37,6 +37,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <string.h>
 #include <assert.h>
 
 #include "libc.h"
@@ -68,6 +69,34 @@ static void memoutstream_putc(FAR struct lib_outstream_s *this, int ch)
     }
 }
 
+/****************************************************************************
+ * Name: memoutstream_puts
+ ****************************************************************************/
+
+static void memoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_memoutstream_s *mthis = (FAR struct lib_memoutstream_s *)this;
+  int ncopy;
+
+  DEBUGASSERT(this);
+
+  /* Copy as much as will fit, truncating just as memoutstream_putc does */
+
+  ncopy = mthis->buflen - this->nput;
+  if (ncopy > len)
+    {
+      ncopy = len;
+    }
+
+  if (ncopy > 0)
+    {
+      memcpy(&mthis->buffer[this->nput], buf, ncopy);
+      this->nput += ncopy;
+      mthis->buffer[this->nput] = '\0';
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,6 +122,7 @@ void lib_memoutstream(FAR struct lib_memoutstream_s *outstream,
                       FAR char *bufstart, int buflen)
 {
   outstream->public.put   = memoutstream_putc;
+  outstream->public.puts  = memoutstream_puts;
   outstream->public.flush = lib_noflush;
   outstream->public.nput  = 0;          /* Will be buffer index */
   outstream->buffer       = bufstart;   /* Start of buffer */
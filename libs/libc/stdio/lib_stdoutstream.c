@@ -64,20 +64,57 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 
   do
     {
-      result = fputc(ch, sthis->stream);
+      result = fputc_unlocked(ch, sthis->stream);
       if (result != EOF)
         {
           this->nput++;
           return;
         }
 
-      /* EINTR (meaning that fputc was interrupted by a signal) is the only
-       * recoverable error.
+      /* EINTR (meaning that fputc_unlocked was interrupted by a signal) is
+       * the only recoverable error.
        */
     }
   while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_puts
+ ****************************************************************************/
+
+static void stdoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_stdoutstream_s *sthis = (FAR struct lib_stdoutstream_s *)this;
+  ssize_t result;
+
+  DEBUGASSERT(this && sthis->stream);
+
+  /* Loop until all of the characters are transferred or an irrecoverable
+   * error occurs.
+   */
+
+  while (len > 0)
+    {
+      result = lib_fwrite_unlocked(buf, len, sthis->stream);
+      if (result > 0)
+        {
+          this->nput += result;
+          buf        += result;
+          len        -= result;
+        }
+
+      /* EINTR (meaning that lib_fwrite was interrupted by a signal) is the
+       * only recoverable error.
+       */
+
+      else if (result == 0 || get_errno() != EINTR)
+        {
+          break;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -100,7 +137,9 @@ static int stdoutstream_flush(FAR struct lib_outstream_s *this)
  * Name: lib_stdoutstream
  *
  * Description:
- *   Initializes a stream for use with a FILE instance.
+ *   Initializes a stream for use with a FILE instance.  The stream is
+ *   accessed with the unlocked I/O variants so the caller must hold the
+ *   stream lock while the outstream is in use.
  *
  * Input Parameters:
  *   outstream - User allocated, uninitialized instance of struct
@@ -118,7 +157,8 @@ void lib_stdoutstream(FAR struct lib_stdoutstream_s *outstream,
 {
   /* Select the put operation */
 
-  outstream->public.put = stdoutstream_putc;
+  outstream->public.put  = stdoutstream_putc;
+  outstream->public.puts = stdoutstream_puts;
 
   /* Select the correct flush operation.  This flush is only called when
    * a newline is encountered in the output stream.  However, we do not
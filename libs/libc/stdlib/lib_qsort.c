@@ -1,7 +1,7 @@
 /****************************************************************************
  * libs/libc/stdlib/lib_qsort.c
  *
- *   Copyright (C) 2007, 2009, 2011 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2007, 2009, 2011, 2018 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Leveraged from:
@@ -47,72 +47,132 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define min(a, b)  (a) < (b) ? a : b
+/* Partitions this small or smaller are finished by insertion sort */
 
-#define swapcode(TYPE, parmi, parmj, n) \
-  { \
-    long i = (n) / sizeof (TYPE); \
-    register TYPE *pi = (TYPE *)(parmi); \
-    register TYPE *pj = (TYPE *)(parmj); \
-    do { \
-      register TYPE  t = *pi; \
-      *pi++ = *pj; \
-      *pj++ = t; \
-    } while (--i > 0); \
-  }
+#define INSERTION_CUTOFF  12
+
+/* Partitions larger than this use the median of three medians (ninther)
+ * as the pivot.
+ */
+
+#define NINTHER_CUTOFF    40
+
+/* A partition pass that swaps nothing suggests presorted input.  An
+ * insertion sort is then attempted, but it is abandoned after this many
+ * element moves so that it cannot go quadratic.
+ */
+
+#define PARTIAL_LIMIT     8
+
+#define min(a, b)  ((a) < (b) ? (a) : (b))
+
+/* Swap strategies.  Elements of 4 and 8 bytes that are word aligned are
+ * swapped in registers, other word multiples a word at a time and
+ * everything else a byte at a time.
+ */
+
+#define SWAP_WORD         0  /* One aligned 32-bit word */
+#define SWAP_DWORD        1  /* Two aligned 32-bit words */
+#define SWAP_WORDS        2  /* Multiple aligned 32-bit words */
+#define SWAP_BYTES        3  /* Unaligned or odd sized */
 
 #define SWAPINIT(a, width) \
-  swaptype = ((FAR char *)a - (FAR char *)0) % sizeof(long) || \
-  width % sizeof(long) ? 2 : width == sizeof(long)? 0 : 1;
+  swaptype = (((uintptr_t)(a) | (width)) % sizeof(uint32_t)) != 0 ? \
+             SWAP_BYTES : (width) == sizeof(uint32_t) ? SWAP_WORD : \
+             (width) == 2 * sizeof(uint32_t) ? SWAP_DWORD : SWAP_WORDS
 
 #define swap(a, b) \
-  if (swaptype == 0) \
+  do \
     { \
-      long t = *(long *)(a); \
-      *(long *)(a) = *(long *)(b); \
-      *(long *)(b) = t; \
+      if (swaptype == SWAP_WORD) \
+        { \
+          uint32_t t = *(FAR uint32_t *)(a); \
+          *(FAR uint32_t *)(a) = *(FAR uint32_t *)(b); \
+          *(FAR uint32_t *)(b) = t; \
+        } \
+      else \
+        { \
+          swapfunc(a, b, width, swaptype); \
+        } \
     } \
-  else \
-    { \
-      swapfunc(a, b, width, swaptype); \
-    }
+  while (0)
 
-#define vecswap(a, b, n) if ((n) > 0) swapfunc(a, b, n, swaptype)
+#define vecswap(a, b, n) \
+  do \
+    { \
+      if ((n) > 0) \
+        { \
+          swapfunc(a, b, n, swaptype == SWAP_BYTES ? SWAP_BYTES : SWAP_WORDS); \
+        } \
+    } \
+  while (0)
 
 /****************************************************************************
- * Private Function Prototypes
+ * Private Types
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype);
-static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *));
+typedef CODE int (*compar_t)(FAR const void *, FAR const void *);
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype)
+/****************************************************************************
+ * Name: swapfunc
+ ****************************************************************************/
+
+static inline void swapfunc(FAR char *a, FAR char *b, size_t n,
+                            int swaptype)
 {
-  if (swaptype <= 1)
+  if (swaptype == SWAP_DWORD)
     {
-      swapcode(long, a, b, n)
+      FAR uint32_t *pa = (FAR uint32_t *)a;
+      FAR uint32_t *pb = (FAR uint32_t *)b;
+      uint32_t t0 = pa[0];
+      uint32_t t1 = pa[1];
+
+      pa[0] = pb[0];
+      pa[1] = pb[1];
+      pb[0] = t0;
+      pb[1] = t1;
+    }
+  else if (swaptype != SWAP_BYTES)
+    {
+      FAR uint32_t *pa = (FAR uint32_t *)a;
+      FAR uint32_t *pb = (FAR uint32_t *)b;
+
+      for (n /= sizeof(uint32_t); n > 0; n--)
+        {
+          uint32_t t = *pa;
+          *pa++ = *pb;
+          *pb++ = t;
+        }
     }
   else
     {
-      swapcode(char, a, b, n)
+      for (; n > 0; n--)
+        {
+          char t = *a;
+          *a++ = *b;
+          *b++ = t;
+        }
     }
 }
 
+/****************************************************************************
+ * Name: med3
+ ****************************************************************************/
+
 static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *))
+                             compar_t compar)
 {
   return compar(a, b) < 0 ?
          (compar(b, c) < 0 ? b : (compar(a, c) < 0 ? c : a)) :
@@ -120,50 +180,116 @@ static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
 }
 
 /****************************************************************************
- * Public Function
+ * Name: insertion_sort
  ****************************************************************************/
 
+static void insertion_sort(FAR char *base, size_t nel, size_t width,
+                           int swaptype, compar_t compar)
+{
+  FAR char *end = base + nel * width;
+  FAR char *pm;
+  FAR char *pl;
+
+  for (pm = base + width; pm < end; pm += width)
+    {
+      for (pl = pm; pl > base && compar(pl - width, pl) > 0; pl -= width)
+        {
+          swap(pl, pl - width);
+        }
+    }
+}
+
 /****************************************************************************
- * Name: qsort
+ * Name: partial_insertion_sort
  *
  * Description:
- *   The qsort() function will sort an array of 'nel' objects, the initial
- *   element of which is pointed to by 'base'. The size of each object, in
- *   bytes, is specified by the 'width" argument. If the 'nel' argument has
- *   the value zero, the comparison function pointed to by 'compar' will not
- *   be called and no rearrangement will take place.
- *
- *   The application will ensure that the comparison function pointed to by
- *   'compar' does not alter the contents of the array. The implementation
- *   may reorder elements of the array between calls to the comparison
- *   function, but will not alter the contents of any individual element.
- *
- *   When the same objects (consisting of 'width" bytes, irrespective of
- *   their current positions in the array) are passed more than once to
- *   the comparison function, the results will be consistent with one
- *   another. That is, they will define a total ordering on the array.
- *
- *   The contents of the array will be sorted in ascending order according
- *   to a comparison function. The 'compar' argument is a pointer to the
- *   comparison function, which is called with two arguments that point to
- *   the elements being compared. The application will ensure that the
- *   function returns an integer less than, equal to, or greater than 0,
- *   if the first argument is considered respectively less than, equal to,
- *   or greater than the second. If two members compare as equal, their
- *   order in the sorted array is unspecified.
- *
- *   (Based on description from OpenGroup.org).
+ *   Insertion sort that gives up after PARTIAL_LIMIT element moves.
+ *   Returns true if the range was completely sorted.
  *
- * Returned Value:
- *   The qsort() function will not return a value.
+ ****************************************************************************/
+
+static bool partial_insertion_sort(FAR char *base, size_t nel, size_t width,
+                                   int swaptype, compar_t compar)
+{
+  FAR char *end = base + nel * width;
+  FAR char *pm;
+  FAR char *pl;
+  int moves = 0;
+
+  for (pm = base + width; pm < end; pm += width)
+    {
+      for (pl = pm; pl > base && compar(pl - width, pl) > 0; pl -= width)
+        {
+          if (++moves > PARTIAL_LIMIT)
+            {
+              return false;
+            }
+
+          swap(pl, pl - width);
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: heap_sort
  *
- * Notes from the original BSD version:
- *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ * Description:
+ *   Heap sort fallback used when the quicksort recursion gets too deep.
+ *   This bounds the worst case at O(n log n).
  *
  ****************************************************************************/
 
-void qsort(FAR void *base, size_t nel, size_t width,
-           CODE int(*compar)(FAR const void *, FAR const void *))
+static void heap_sort(FAR char *base, size_t nel, size_t width,
+                      int swaptype, compar_t compar)
+{
+  size_t start;
+  size_t end;
+
+  /* Build a max heap, then repeatedly move the maximum to the end */
+
+  for (start = nel / 2, end = nel; end > 1; )
+    {
+      size_t root;
+      size_t child;
+
+      if (start > 0)
+        {
+          start--;
+        }
+      else
+        {
+          end--;
+          swap(base, base + end * width);
+        }
+
+      /* Sift the element at 'start' down into the heap [start, end) */
+
+      for (root = start; (child = 2 * root + 1) < end; root = child)
+        {
+          if (child + 1 < end &&
+              compar(base + child * width, base + (child + 1) * width) < 0)
+            {
+              child++;
+            }
+
+          if (compar(base + root * width, base + child * width) >= 0)
+            {
+              break;
+            }
+
+          swap(base + root * width, base + child * width);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: intro_sort
+ ****************************************************************************/
+
+static void intro_sort(FAR char *base, size_t nel, size_t width,
+                       int swaptype, compar_t compar, int depth)
 {
   FAR char *pa;
   FAR char *pb;
@@ -172,38 +298,30 @@ void qsort(FAR void *base, size_t nel, size_t width,
   FAR char *pl;
   FAR char *pm;
   FAR char *pn;
-  int swaptype;
-  int swap_cnt;
-  int d;
-  int r;
-
-loop:
-  SWAPINIT(base, width);
-  swap_cnt = 0;
-
-  if (nel < 7)
+  size_t nlo;
+  size_t nhi;
+  size_t d;
+  size_t r;
+  bool swapped;
+  int cmp;
+
+  while (nel > INSERTION_CUTOFF)
     {
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      if (depth-- <= 0)
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
+          heap_sort(base, nel, width, swaptype, compar);
+          return;
         }
 
-      return;
-  }
+      /* Select the pivot:  Median of three or, for large partitions, the
+       * median of three medians.
+       */
 
-  pm = (FAR char *)base + (nel / 2) * width;
-  if (nel > 7)
-    {
       pl = base;
-      pn = (FAR char *)base + (nel - 1) * width;
-      if (nel > 40)
+      pm = base + (nel / 2) * width;
+      pn = base + (nel - 1) * width;
+
+      if (nel > NINTHER_CUTOFF)
         {
           d  = (nel / 8) * width;
           pl = med3(pl, pl + d, pl + 2 * d, compar);
@@ -212,86 +330,151 @@ loop:
         }
 
       pm = med3(pl, pm, pn, compar);
-    }
+      swap(base, pm);
 
-  swap(base, pm);
-  pa = pb = (FAR char *)base + width;
+      /* Bentley-McIlroy three way partition:  Elements equal to the pivot
+       * are collected at both ends and then swapped into the middle.
+       */
 
-  pc = pd = (FAR char *)base + (nel - 1) * width;
-  for (; ; )
-    {
-      while (pb <= pc && (r = compar(pb, base)) <= 0)
+      pa = pb = base + width;
+      pc = pd = base + (nel - 1) * width;
+      swapped = false;
+
+      for (; ; )
         {
-          if (r == 0)
+          while (pb <= pc && (cmp = compar(pb, base)) <= 0)
             {
-              swap_cnt = 1;
-              swap(pa, pb);
-              pa += width;
+              if (cmp == 0)
+                {
+                  swap(pa, pb);
+                  pa += width;
+                }
+
+              pb += width;
             }
 
-          pb += width;
-        }
+          while (pb <= pc && (cmp = compar(pc, base)) >= 0)
+            {
+              if (cmp == 0)
+                {
+                  swap(pc, pd);
+                  pd -= width;
+                }
 
-      while (pb <= pc && (r = compar(pc, base)) >= 0)
-        {
-          if (r == 0)
+              pc -= width;
+            }
+
+          if (pb > pc)
             {
-              swap_cnt = 1;
-              swap(pc, pd);
-              pd -= width;
+              break;
             }
 
+          swap(pb, pc);
+          swapped = true;
+          pb += width;
           pc -= width;
         }
 
-      if (pb > pc)
+      pn = base + nel * width;
+      r  = min((size_t)(pa - base), (size_t)(pb - pa));
+      vecswap(base, pb - r, r);
+
+      r  = min((size_t)(pd - pc), (size_t)(pn - pd) - width);
+      vecswap(pb, pn - r, r);
+
+      if (!swapped &&
+          partial_insertion_sort(base, nel, width, swaptype, compar))
         {
-          break;
+          return;
         }
 
-      swap(pb, pc);
-      swap_cnt = 1;
-      pb      += width;
-      pc      -= width;
-    }
+      /* Recurse into the smaller partition and iterate on the larger one
+       * so that the stack depth stays O(log n).
+       */
 
-  if (swap_cnt == 0)
-    {
-      /* Switch to insertion sort */
+      nlo = (size_t)(pb - pa) / width;
+      nhi = (size_t)(pd - pc) / width;
 
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      if (nlo < nhi)
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
+          intro_sort(base, nlo, width, swaptype, compar, depth);
+          base = pn - nhi * width;
+          nel  = nhi;
+        }
+      else
+        {
+          intro_sort(pn - nhi * width, nhi, width, swaptype, compar, depth);
+          nel  = nlo;
         }
-
-      return;
     }
 
-  pn = (FAR char *)base + nel * width;
-  r  = min(pa - (FAR char *)base, pb - pa);
-  vecswap(base, pb - r, r);
+  insertion_sort(base, nel, width, swaptype, compar);
+}
 
-  r  = min(pd - pc, pn - pd - width);
-  vecswap(pb, pn - r, r);
+/****************************************************************************
+ * Public Function
+ ****************************************************************************/
 
-  if ((r = pb - pa) > width)
+/****************************************************************************
+ * Name: qsort
+ *
+ * Description:
+ *   The qsort() function will sort an array of 'nel' objects, the initial
+ *   element of which is pointed to by 'base'. The size of each object, in
+ *   bytes, is specified by the 'width" argument. If the 'nel' argument has
+ *   the value zero, the comparison function pointed to by 'compar' will not
+ *   be called and no rearrangement will take place.
+ *
+ *   The application will ensure that the comparison function pointed to by
+ *   'compar' does not alter the contents of the array. The implementation
+ *   may reorder elements of the array between calls to the comparison
+ *   function, but will not alter the contents of any individual element.
+ *
+ *   When the same objects (consisting of 'width" bytes, irrespective of
+ *   their current positions in the array) are passed more than once to
+ *   the comparison function, the results will be consistent with one
+ *   another. That is, they will define a total ordering on the array.
+ *
+ *   The contents of the array will be sorted in ascending order according
+ *   to a comparison function. The 'compar' argument is a pointer to the
+ *   comparison function, which is called with two arguments that point to
+ *   the elements being compared. The application will ensure that the
+ *   function returns an integer less than, equal to, or greater than 0,
+ *   if the first argument is considered respectively less than, equal to,
+ *   or greater than the second. If two members compare as equal, their
+ *   order in the sorted array is unspecified.
+ *
+ *   (Based on description from OpenGroup.org).
+ *
+ * Returned Value:
+ *   The qsort() function will not return a value.
+ *
+ * Notes:
+ *   This is an introsort:  Quicksort with the pivot selection and three way
+ *   partitioning of Bentley & McIlroy's "Engineering a Sort Function",
+ *   insertion sort for small partitions, and a heap sort fallback once the
+ *   recursion depth exceeds 2 * log2(nel).  The worst case is O(n log n).
+ *
+ ****************************************************************************/
+
+void qsort(FAR void *base, size_t nel, size_t width,
+           CODE int(*compar)(FAR const void *, FAR const void *))
+{
+  size_t n;
+  int swaptype;
+  int depth;
+
+  if (nel < 2 || width == 0)
     {
-      qsort(base, r / width, width, compar);
+      return;
     }
 
-  if ((r = pd - pc) > width)
-    {
-      /* Iterate rather than recurse to save stack space */
+  SWAPINIT(base, width);
 
-      base = pn - r;
-      nel = r / width;
-      goto loop;
+  for (depth = 0, n = nel; n > 1; n >>= 1)
+    {
+      depth += 2;
     }
+
+  intro_sort((FAR char *)base, nel, width, swaptype, compar, depth);
 }
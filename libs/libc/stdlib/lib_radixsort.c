@@ -0,0 +1,233 @@
+/****************************************************************************
+ * libs/libc/stdlib/lib_radixsort.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define RADIX_BITS   8
+#define RADIX_SIZE   (1 << RADIX_BITS)
+#define RADIX_MASK   (RADIX_SIZE - 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: radix_digit
+ ****************************************************************************/
+
+static inline unsigned int radix_digit(FAR const char *elem, size_t keyoffset,
+                                       int keysize, int shift)
+{
+#ifdef CONFIG_HAVE_LONG_LONG
+  if (keysize == sizeof(uint64_t))
+    {
+      uint64_t key;
+
+      memcpy(&key, elem + keyoffset, sizeof(uint64_t));
+      return (unsigned int)(key >> shift) & RADIX_MASK;
+    }
+  else
+#endif
+    {
+      uint32_t key;
+
+      memcpy(&key, elem + keyoffset, sizeof(uint32_t));
+      return (unsigned int)(key >> shift) & RADIX_MASK;
+    }
+}
+
+/****************************************************************************
+ * Name: radix_sort
+ *
+ * Description:
+ *   Least significant digit first radix sort, eight bits per pass.  Passes
+ *   in which every key has the same digit are skipped.
+ *
+ ****************************************************************************/
+
+static int radix_sort(FAR void *base, size_t nel, size_t width,
+                      size_t keyoffset, int keysize, FAR void *scratch)
+{
+  size_t count[RADIX_SIZE];
+  FAR char *src = base;
+  FAR char *dst;
+  FAR char *alloc = NULL;
+  int shift;
+
+  if (width < keyoffset + keysize)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  if (nel < 2)
+    {
+      return OK;
+    }
+
+  dst = scratch;
+  if (dst == NULL)
+    {
+      alloc = lib_malloc(nel * width);
+      if (alloc == NULL)
+        {
+          set_errno(ENOMEM);
+          return ERROR;
+        }
+
+      dst = alloc;
+    }
+
+  for (shift = 0; shift < 8 * keysize; shift += RADIX_BITS)
+    {
+      FAR const char *elem;
+      FAR char *tmp;
+      size_t offset;
+      size_t n;
+      size_t i;
+
+      /* Histogram the digit */
+
+      memset(count, 0, sizeof(count));
+      for (elem = src, i = 0; i < nel; elem += width, i++)
+        {
+          count[radix_digit(elem, keyoffset, keysize, shift)]++;
+        }
+
+      /* Nothing to do if all keys have the same digit */
+
+      if (count[radix_digit(src, keyoffset, keysize, shift)] == nel)
+        {
+          continue;
+        }
+
+      /* Convert the counts into starting offsets */
+
+      for (offset = 0, i = 0; i < RADIX_SIZE; i++)
+        {
+          n        = count[i];
+          count[i] = offset;
+          offset  += n * width;
+        }
+
+      /* Scatter the elements stably into the other buffer */
+
+      for (elem = src, i = 0; i < nel; elem += width, i++)
+        {
+          unsigned int digit = radix_digit(elem, keyoffset, keysize, shift);
+
+          memcpy(dst + count[digit], elem, width);
+          count[digit] += width;
+        }
+
+      tmp = src;
+      src = dst;
+      dst = tmp;
+    }
+
+  /* Copy back if the last pass left the result in the scratch buffer */
+
+  if (src != base)
+    {
+      memcpy(base, src, nel * width);
+    }
+
+  if (alloc != NULL)
+    {
+      lib_free(alloc);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: radixsort32 and radixsort64
+ *
+ * Description:
+ *   Sort an array of 'nel' elements of 'width' bytes by the unsigned 32-
+ *   or 64-bit integer key (in native byte order) found 'keyoffset' bytes
+ *   into each element.  The sort is stable and takes O(nel) time
+ *   independent of the key distribution.  Signed keys may be sorted by
+ *   inverting their sign bit.
+ *
+ *   These are non-standard interfaces.
+ *
+ * Input Parameters:
+ *   base      - The array to be sorted
+ *   nel       - The number of elements in the array
+ *   width     - The size of one element in bytes
+ *   keyoffset - Byte offset of the key within each element
+ *   scratch   - A buffer of nel * width bytes, or NULL to allocate one
+ *
+ * Returned Value:
+ *   Zero (OK) on success; ERROR (-1) with errno set on failure:
+ *   EINVAL if the key does not lie within an element, or ENOMEM if no
+ *   scratch buffer could be allocated.
+ *
+ ****************************************************************************/
+
+int radixsort32(FAR void *base, size_t nel, size_t width, size_t keyoffset,
+                FAR void *scratch)
+{
+  return radix_sort(base, nel, width, keyoffset, sizeof(uint32_t), scratch);
+}
+
+#ifdef CONFIG_HAVE_LONG_LONG
+int radixsort64(FAR void *base, size_t nel, size_t width, size_t keyoffset,
+                FAR void *scratch)
+{
+  return radix_sort(base, nel, width, keyoffset, sizeof(uint64_t), scratch);
+}
+#endif
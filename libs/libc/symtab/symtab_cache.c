@@ -0,0 +1,162 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_cache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/symtab.h>
+
+#include "libc.h"
+
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* A direct-mapped cache of previous lookups, indexed by a hash of the
+ * symbol name.  Entries are only hints:  Each is validated against the
+ * symbol table being searched and the name before it is used.  Pointer
+ * size stores are atomic so no locking is needed; at worst, a concurrent
+ * lookup will miss and search the table.
+ */
+
+static FAR const struct symtab_s *g_symcache[CONFIG_SYMTAB_CACHE_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Return the cache index for the symbol name (the ELF SysV hash).
+ *
+ ****************************************************************************/
+
+static unsigned int symtab_hash(FAR const char *name)
+{
+  uint32_t hash = 0;
+  uint32_t g;
+
+  while (*name != '\0')
+    {
+      hash = (hash << 4) + (uint8_t)*name++;
+      g    = hash & 0xf0000000;
+      if (g != 0)
+        {
+          hash ^= g >> 24;
+        }
+
+      hash &= ~g;
+    }
+
+  return hash % CONFIG_SYMTAB_CACHE_SIZE;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_cachefind
+ *
+ * Description:
+ *   Check if a symbol with the matching name in the symbol table was found
+ *   by a previous lookup.
+ *
+ * Input Parameters:
+ *   symtab - The symbol table being searched
+ *   name   - The name of the symbol
+ *   nsyms  - The number of entries in the symbol table
+ *   index  - The location to return the cache index for the name.  This
+ *            should be passed to symtab_cacheadd() if the lookup misses.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if found in the cache; NULL
+ *   otherwise.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_cachefind(FAR const struct symtab_s *symtab, FAR const char *name,
+                 int nsyms, FAR unsigned int *index)
+{
+  FAR const struct symtab_s *symbol;
+
+  DEBUGASSERT(index != NULL);
+
+  *index = symtab_hash(name);
+  symbol = g_symcache[*index];
+
+  if (symbol != NULL && symbol >= symtab && symbol < &symtab[nsyms] &&
+      strcmp(name, symbol->sym_name) == 0)
+    {
+      return symbol;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: symtab_cacheadd
+ *
+ * Description:
+ *   Remember the result of a symbol table lookup.
+ *
+ * Input Parameters:
+ *   index  - The cache index returned by symtab_cachefind()
+ *   symbol - The symbol table entry that was found
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void symtab_cacheadd(unsigned int index, FAR const struct symtab_s *symbol)
+{
+  DEBUGASSERT(index < CONFIG_SYMTAB_CACHE_SIZE);
+  g_symcache[index] = symbol;
+}
+
+#endif /* CONFIG_SYMTAB_CACHE_SIZE > 0 */
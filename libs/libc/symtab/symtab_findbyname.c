@@ -46,6 +46,8 @@
 
 #include <nuttx/symtab.h>
 
+#include "libc.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -56,7 +58,8 @@
  * Description:
  *   Find the symbol in the symbol table with the matching name.
  *   This version assumes that table is not ordered with respect to symbol
- *   name and, hence, access time will be linear with respect to nsyms.
+ *   name and, hence, access time will be linear with respect to nsyms
+ *   (unless the symbol is found in the symbol lookup cache).
  *
  * Returned Value:
  *   A reference to the symbol table entry if an entry with the matching
@@ -68,13 +71,31 @@ FAR const struct symtab_s *
 symtab_findbyname(FAR const struct symtab_s *symtab,
                   FAR const char *name, int nsyms)
 {
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+  FAR const struct symtab_s *symbol;
+  unsigned int index;
+#endif
+
   DEBUGASSERT(symtab != NULL && name != NULL);
+
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+  symbol = symtab_cachefind(symtab, name, nsyms, &index);
+  if (symbol != NULL)
+    {
+      return symbol;
+    }
+#endif
+
   for (; nsyms > 0; symtab++, nsyms--)
     {
       if (strcmp(name, symtab->sym_name) == 0)
         {
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+          symtab_cacheadd(index, symtab);
+#endif
           return symtab;
         }
     }
+
   return NULL;
 }
@@ -46,6 +46,8 @@
 
 #include <nuttx/symtab.h>
 
+#include "libc.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -75,12 +77,30 @@ symtab_findorderedbyname(FAR const struct symtab_s *symtab,
   int high = nsyms - 1;
   int mid;
   int cmp;
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+  FAR const struct symtab_s *symbol;
+  unsigned int index;
+#endif
 
   /* Loop until the range has been isolated to a single symbol table
    * entry that may or may not match the search name.
    */
 
   DEBUGASSERT(symtab != NULL && name != NULL);
+
+  if (nsyms <= 0)
+    {
+      return NULL;
+    }
+
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+  symbol = symtab_cachefind(symtab, name, nsyms, &index);
+  if (symbol != NULL)
+    {
+      return symbol;
+    }
+#endif
+
   while (low < high)
     {
       /* Compare the name to the one in the middle.  (or just below
@@ -109,6 +129,9 @@ symtab_findorderedbyname(FAR const struct symtab_s *symtab,
         {
           /* symtab[mid].sym_name == name */
 
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+          symtab_cacheadd(index, &symtab[mid]);
+#endif
           return &symtab[mid];
         }
     }
@@ -121,5 +144,13 @@ symtab_findorderedbyname(FAR const struct symtab_s *symtab,
    *   low = 2, high = 2, but symtab[2].sym_name was never tested.
    */
 
-  return strcmp(name, symtab[low].sym_name) == 0 ? &symtab[low] : NULL;
+  if (strcmp(name, symtab[low].sym_name) != 0)
+    {
+      return NULL;
+    }
+
+#if CONFIG_SYMTAB_CACHE_SIZE > 0
+  symtab_cacheadd(index, &symtab[low]);
+#endif
+  return &symtab[low];
 }
@@ -0,0 +1,171 @@
+/****************************************************************************
+ * libs/libc/time/lib_clockgettime.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <syscall.h>
+
+#include <nuttx/clock.h>
+
+#if defined(CONFIG_CLOCK_VDSO) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The user-space clock page.  The kernel finds this through the us_vdso
+ * field of the struct userspace_s header and updates it on each timer tick.
+ */
+
+struct clock_vdso_s g_clock_vdso;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_vdso_read
+ *
+ * Description:
+ *   Take a consistent snapshot of the user-space clock page and return the
+ *   tick count as a struct timespec and, optionally, the base time.
+ *
+ ****************************************************************************/
+
+static void clock_vdso_read(FAR struct timespec *ts,
+                            FAR struct timespec *base)
+{
+  FAR struct clock_vdso_s *vdso = &g_clock_vdso;
+  clock_t ticks;
+  uint32_t seq;
+
+  /* Retry if the kernel was (or started) updating the page while we read
+   * it.  The timer interrupt can preempt us at any point.
+   */
+
+  for (; ; )
+    {
+      seq = vdso->seq;
+      if ((seq & 1) == 0)
+        {
+          ticks = vdso->ticks;
+          if (base != NULL)
+            {
+              base->tv_sec  = vdso->base_sec;
+              base->tv_nsec = vdso->base_nsec;
+            }
+
+          if (vdso->seq == seq)
+            {
+              break;
+            }
+        }
+    }
+
+#if (USEC_PER_SEC % USEC_PER_TICK) == 0
+  /* The tick rate divides one second exactly */
+
+  ts->tv_sec  = (time_t)(ticks / TICK_PER_SEC);
+  ts->tv_nsec = (long)(ticks % TICK_PER_SEC) * NSEC_PER_TICK;
+#else
+  {
+    uint64_t usecs = (uint64_t)TICK2USEC((uint64_t)ticks);
+    uint64_t secs  = usecs / USEC_PER_SEC;
+
+    ts->tv_sec  = (time_t)secs;
+    ts->tv_nsec = (long)((usecs - secs * USEC_PER_SEC) * NSEC_PER_USEC);
+  }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_gettime
+ *
+ * Description:
+ *   User-space clock_gettime() for the PROTECTED build.  CLOCK_REALTIME and
+ *   CLOCK_MONOTONIC are computed from the user-space clock page without a
+ *   system call; any other clock is passed to the kernel.  This replaces
+ *   the clock_gettime() system call proxy.
+ *
+ ****************************************************************************/
+
+int clock_gettime(clockid_t clock_id, FAR struct timespec *tp)
+{
+  struct timespec base;
+  uint32_t carry;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+  if (clock_id == CLOCK_MONOTONIC)
+    {
+      clock_vdso_read(tp, NULL);
+      return OK;
+    }
+#endif
+
+  if (clock_id == CLOCK_REALTIME)
+    {
+      clock_vdso_read(tp, &base);
+
+      tp->tv_sec  += base.tv_sec;
+      tp->tv_nsec += base.tv_nsec;
+
+      /* Handle carry to seconds. */
+
+      if (tp->tv_nsec >= NSEC_PER_SEC)
+        {
+          carry        = tp->tv_nsec / NSEC_PER_SEC;
+          tp->tv_sec  += carry;
+          tp->tv_nsec -= (carry * NSEC_PER_SEC);
+        }
+
+      return OK;
+    }
+
+  return (int)sys_call2(SYS_clock_gettime, (uintptr_t)clock_id,
+                        (uintptr_t)tp);
+}
+
+#endif /* CONFIG_CLOCK_VDSO && !__KERNEL__ */
@@ -314,6 +314,14 @@ static const char g_wildabbr[] = WILDABBR;
 
 static char g_lcl_tzname[MY_TZNAME_MAX + 1];
 static int g_lcl_isset;
+
+/* Index of the transition interval found by the last localsub() lookup.
+ * Successive conversions nearly always fall into the same interval, so
+ * this is checked before falling back to the binary search.  It is only a
+ * hint:  It is validated against the current transition table before use.
+ */
+
+static int g_lcl_lastidx;
 static int g_gmt_isset;
 
 /* Section 4.12.3 of X3.159-1989 requires that
@@ -1727,9 +1735,17 @@ static struct tm *localsub(FAR const time_t * const timep,
     }
   else
     {
-      int lo = 1;
+      int lo = g_lcl_lastidx;
       int hi = sp->timecnt;
 
+      if (lo >= 1 && lo <= hi && t >= sp->ats[lo - 1] &&
+          (lo == hi || t < sp->ats[lo]))
+        {
+          i = (int)sp->types[lo - 1];
+          goto found;
+        }
+
+      lo = 1;
       while (lo < hi)
         {
           int mid = (lo + hi) >> 1;
@@ -1744,9 +1760,11 @@ static struct tm *localsub(FAR const time_t * const timep,
             }
         }
 
+      g_lcl_lastidx = lo;
       i = (int)sp->types[lo - 1];
     }
 
+found:
   ttisp = &sp->ttis[i];
 
   /* To get (wrong) behavior that's compatible with System V Release 2.0
@@ -0,0 +1,261 @@
+/****************************************************************************
+ * libs/libdsp/lib_biquad.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "lib_fixed.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: biquad_init_f32
+ *
+ * Description:
+ *   Initialize float biquad cascade
+ *
+ * Input Parameters:
+ *   bq      - (out) pointer to the biquad cascade instance
+ *   coeffs  - (in) pointer to 5 * nstages coefficients {b0, b1, b2, a1, a2}
+ *   state   - (in) pointer to 2 * nstages state variables
+ *   nstages - (in) number of second order sections
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_init_f32(FAR struct biquad_f32_s *bq, FAR const float *coeffs,
+                     FAR float *state, uint8_t nstages)
+{
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(nstages > 0);
+
+  bq->coeffs  = coeffs;
+  bq->state   = state;
+  bq->nstages = nstages;
+
+  memset(state, 0, 2 * nstages * sizeof(float));
+}
+
+/****************************************************************************
+ * Name: biquad_f32
+ *
+ * Description:
+ *   Filter a block of float samples with a direct form II transposed
+ *   biquad cascade.  Each stage runs over the whole block, so its
+ *   coefficients and state stay in registers.  in and out may be the same
+ *   buffer.
+ *
+ * Input Parameters:
+ *   bq  - (in/out) pointer to the biquad cascade instance
+ *   in  - (in) pointer to the input samples
+ *   out - (out) pointer to the output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_f32(FAR struct biquad_f32_s *bq, FAR const float *in,
+                FAR float *out, size_t n)
+{
+  FAR const float *c;
+  FAR float *st;
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+  float d1;
+  float d2;
+  float x;
+  float y;
+  uint8_t stage;
+  size_t i;
+
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(in != NULL);
+  DEBUGASSERT(out != NULL);
+
+  c  = bq->coeffs;
+  st = bq->state;
+
+  for (stage = 0; stage < bq->nstages; stage++, c += 5, st += 2)
+    {
+      b0 = c[0];
+      b1 = c[1];
+      b2 = c[2];
+      a1 = c[3];
+      a2 = c[4];
+      d1 = st[0];
+      d2 = st[1];
+
+      for (i = 0; i < n; i++)
+        {
+          x      = in[i];
+          y      = b0 * x + d1;
+          d1     = b1 * x - a1 * y + d2;
+          d2     = b2 * x - a2 * y;
+          out[i] = y;
+        }
+
+      st[0] = d1;
+      st[1] = d2;
+
+      /* The next stage filters the output of this one */
+
+      in = out;
+    }
+}
+
+/****************************************************************************
+ * Name: biquad_init_q31
+ *
+ * Description:
+ *   Initialize Q31 biquad cascade
+ *
+ * Input Parameters:
+ *   bq      - (out) pointer to the biquad cascade instance
+ *   coeffs  - (in) pointer to 5 * nstages coefficients {b0, b1, b2, a1, a2}
+ *             in Q(31 - shift) format
+ *   state   - (in) pointer to 4 * nstages state variables
+ *   nstages - (in) number of second order sections
+ *   shift   - (in) coefficient post-shift.  Use 1 when any |a1| or |b1|
+ *             is equal to or above 1.0
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_init_q31(FAR struct biquad_q31_s *bq, FAR const q31_t *coeffs,
+                     FAR q31_t *state, uint8_t nstages, uint8_t shift)
+{
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(nstages > 0);
+  DEBUGASSERT(shift < 31);
+
+  bq->coeffs  = coeffs;
+  bq->state   = state;
+  bq->nstages = nstages;
+  bq->shift   = shift;
+
+  memset(state, 0, 4 * nstages * sizeof(q31_t));
+}
+
+/****************************************************************************
+ * Name: biquad_q31
+ *
+ * Description:
+ *   Filter a block of Q31 samples with a direct form I biquad cascade.
+ *   The five products are summed in 64 bits (SMLAL on ARM), which keeps
+ *   the recursive part free of intermediate rounding.  in and out may be
+ *   the same buffer.
+ *
+ * Input Parameters:
+ *   bq  - (in/out) pointer to the biquad cascade instance
+ *   in  - (in) pointer to the input samples
+ *   out - (out) pointer to the output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_q31(FAR struct biquad_q31_s *bq, FAR const q31_t *in,
+                FAR q31_t *out, size_t n)
+{
+  FAR const q31_t *c;
+  FAR q31_t *st;
+  int64_t acc;
+  q31_t x1;
+  q31_t x2;
+  q31_t y1;
+  q31_t y2;
+  q31_t x;
+  uint8_t rshift;
+  uint8_t stage;
+  size_t i;
+
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(in != NULL);
+  DEBUGASSERT(out != NULL);
+
+  c      = bq->coeffs;
+  st     = bq->state;
+  rshift = 31 - bq->shift;
+
+  for (stage = 0; stage < bq->nstages; stage++, c += 5, st += 4)
+    {
+      x1 = st[0];
+      x2 = st[1];
+      y1 = st[2];
+      y2 = st[3];
+
+      for (i = 0; i < n; i++)
+        {
+          x   = in[i];
+          acc = (int64_t)c[0] * x + (int64_t)c[1] * x1 +
+                (int64_t)c[2] * x2 - (int64_t)c[3] * y1 -
+                (int64_t)c[4] * y2;
+
+          x2     = x1;
+          x1     = x;
+          y2     = y1;
+          y1     = dsp_sat_q31((acc + ((int64_t)1 << (rshift - 1))) >>
+                               rshift);
+          out[i] = y1;
+        }
+
+      st[0] = x1;
+      st[1] = x2;
+      st[2] = y1;
+      st[3] = y2;
+
+      in = out;
+    }
+}
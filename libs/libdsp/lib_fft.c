@@ -0,0 +1,429 @@
+/****************************************************************************
+ * libs/libdsp/lib_fft.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with dr without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/dr other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse dr promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "lib_fixed.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Swap the complex samples i and j of an interleaved {re, im} buffer */
+
+#define CPLX_SWAP(type, buf, i, j) \
+  do \
+    { \
+      type _t; \
+      _t = (buf)[2 * (i)];     (buf)[2 * (i)]     = (buf)[2 * (j)]; \
+      (buf)[2 * (j)]     = _t; \
+      _t = (buf)[2 * (i) + 1]; (buf)[2 * (i) + 1] = (buf)[2 * (j) + 1]; \
+      (buf)[2 * (j) + 1] = _t; \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bitrev_next
+ *
+ * Description:
+ *   Advance j to the bit reversed successor for an m point transform.
+ *
+ ****************************************************************************/
+
+static inline uint16_t bitrev_next(uint16_t j, uint16_t m)
+{
+  uint16_t bit = m >> 1;
+
+  while ((j & bit) != 0)
+    {
+      j  ^= bit;
+      bit >>= 1;
+    }
+
+  return j | bit;
+}
+
+/****************************************************************************
+ * Name: cfft_f32
+ *
+ * Description:
+ *   In place radix-2 decimation in time complex FFT of m points.  The
+ *   twiddle factors of the m point transform are every stride'th entry of
+ *   the table.
+ *
+ ****************************************************************************/
+
+static void cfft_f32(FAR float *z, uint16_t m, FAR const float *tw,
+                     uint16_t stride)
+{
+  FAR float *p;
+  FAR float *q;
+  uint16_t half;
+  uint16_t step;
+  uint16_t i;
+  uint16_t j;
+  float wr;
+  float wi;
+  float tr;
+  float ti;
+
+  for (i = 0, j = 0; i < m - 1; i++)
+    {
+      if (i < j)
+        {
+          CPLX_SWAP(float, z, i, j);
+        }
+
+      j = bitrev_next(j, m);
+    }
+
+  for (half = 1, step = (m >> 1) * stride; half < m;
+       half <<= 1, step >>= 1)
+    {
+      for (j = 0; j < half; j++)
+        {
+          wr = tw[2 * j * step];
+          wi = tw[2 * j * step + 1];
+
+          for (i = j; i < m; i += 2 * half)
+            {
+              p  = &z[2 * i];
+              q  = &z[2 * (i + half)];
+
+              tr = wr * q[0] - wi * q[1];
+              ti = wr * q[1] + wi * q[0];
+
+              q[0] = p[0] - tr;
+              q[1] = p[1] - ti;
+              p[0] = p[0] + tr;
+              p[1] = p[1] + ti;
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: cfft_q15
+ *
+ * Description:
+ *   Q15 version of cfft_f32().  Every stage is scaled by 1/2, so the
+ *   result is the transform divided by m.
+ *
+ ****************************************************************************/
+
+static void cfft_q15(FAR q15_t *z, uint16_t m, FAR const q15_t *tw,
+                     uint16_t stride)
+{
+  FAR q15_t *p;
+  FAR q15_t *q;
+  uint16_t half;
+  uint16_t step;
+  uint16_t i;
+  uint16_t j;
+  int32_t wr;
+  int32_t wi;
+  int32_t tr;
+  int32_t ti;
+
+  for (i = 0, j = 0; i < m - 1; i++)
+    {
+      if (i < j)
+        {
+          CPLX_SWAP(q15_t, z, i, j);
+        }
+
+      j = bitrev_next(j, m);
+    }
+
+  for (half = 1, step = (m >> 1) * stride; half < m;
+       half <<= 1, step >>= 1)
+    {
+      for (j = 0; j < half; j++)
+        {
+          wr = tw[2 * j * step];
+          wi = tw[2 * j * step + 1];
+
+          for (i = j; i < m; i += 2 * half)
+            {
+              p  = &z[2 * i];
+              q  = &z[2 * (i + half)];
+
+              /* t = w * q in Q15, p and t halved for the butterfly */
+
+              tr = (wr * q[0] - wi * q[1] + Q15_ROUND) >> 15;
+              ti = (wr * q[1] + wi * q[0] + Q15_ROUND) >> 15;
+
+              q[0] = dsp_sat_q15((p[0] - tr) >> 1);
+              q[1] = dsp_sat_q15((p[1] - ti) >> 1);
+              p[0] = dsp_sat_q15((p[0] + tr) >> 1);
+              p[1] = dsp_sat_q15((p[1] + ti) >> 1);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rfft_init_f32
+ *
+ * Description:
+ *   Initialize float real FFT
+ *
+ * Input Parameters:
+ *   fft     - (out) pointer to the FFT instance
+ *   twiddle - (in) pointer to n floats for the twiddle table
+ *   n       - (in) FFT length, a power of two and at least 4
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rfft_init_f32(FAR struct rfft_f32_s *fft, FAR float *twiddle,
+                   uint16_t n)
+{
+  float angle;
+  uint16_t k;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(twiddle != NULL);
+  DEBUGASSERT(n >= 4 && (n & (n - 1)) == 0);
+
+  for (k = 0; k < n / 2; k++)
+    {
+      angle              = 2.0f * M_PI_F * k / n;
+      twiddle[2 * k]     = cosf(angle);
+      twiddle[2 * k + 1] = -sinf(angle);
+    }
+
+  fft->twiddle = twiddle;
+  fft->n       = n;
+}
+
+/****************************************************************************
+ * Name: rfft_f32
+ *
+ * Description:
+ *   In place FFT of n real float samples.  The n samples are transformed
+ *   as n/2 complex samples and the spectrum of the real sequence is then
+ *   split out of the result.
+ *
+ *   The output is packed into the same n floats:
+ *
+ *     buf[0]          - X[0] (real)
+ *     buf[1]          - X[n/2] (real)
+ *     buf[2k], buf[2k + 1] - real and imaginary part of X[k], 0 < k < n/2
+ *
+ * Input Parameters:
+ *   fft - (in) pointer to the FFT instance
+ *   buf - (in/out) pointer to n samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rfft_f32(FAR struct rfft_f32_s *fft, FAR float *buf)
+{
+  FAR const float *tw;
+  uint16_t m;
+  uint16_t k;
+  float sr;
+  float si;
+  float dr;
+  float di;
+  float tr;
+  float ti;
+  float wr;
+  float wi;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(buf != NULL);
+
+  tw = fft->twiddle;
+  m  = fft->n / 2;
+
+  cfft_f32(buf, m, tw, 2);
+
+  /* X[0] and X[n/2] are real */
+
+  sr     = buf[0];
+  si     = buf[1];
+  buf[0] = sr + si;
+  buf[1] = sr - si;
+
+  /* With A = Z[k], B = conj(Z[m - k]), S = (A + B)/2, D = (A - B)/2:
+   *
+   *   X[k]     = S - j*W^k*D
+   *   X[m - k] = conj(S + j*W^k*D)
+   */
+
+  for (k = 1; k <= m / 2; k++)
+    {
+      sr = 0.5f * (buf[2 * k]     + buf[2 * (m - k)]);
+      si = 0.5f * (buf[2 * k + 1] - buf[2 * (m - k) + 1]);
+      dr = 0.5f * (buf[2 * k]     - buf[2 * (m - k)]);
+      di = 0.5f * (buf[2 * k + 1] + buf[2 * (m - k) + 1]);
+
+      wr = tw[2 * k];
+      wi = tw[2 * k + 1];
+
+      /* t = W^k * D */
+
+      tr = wr * dr - wi * di;
+      ti = wr * di + wi * dr;
+
+      buf[2 * k]           = sr + ti;
+      buf[2 * k + 1]       = si - tr;
+      buf[2 * (m - k)]     = sr - ti;
+      buf[2 * (m - k) + 1] = -(si + tr);
+    }
+}
+
+/****************************************************************************
+ * Name: rfft_init_q15
+ *
+ * Description:
+ *   Initialize Q15 real FFT
+ *
+ * Input Parameters:
+ *   fft     - (out) pointer to the FFT instance
+ *   twiddle - (in) pointer to n Q15 numbers for the twiddle table
+ *   n       - (in) FFT length, a power of two and at least 4
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rfft_init_q15(FAR struct rfft_q15_s *fft, FAR q15_t *twiddle,
+                   uint16_t n)
+{
+  float angle;
+  uint16_t k;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(twiddle != NULL);
+  DEBUGASSERT(n >= 4 && (n & (n - 1)) == 0);
+
+  for (k = 0; k < n / 2; k++)
+    {
+      angle              = 2.0f * M_PI_F * k / n;
+      twiddle[2 * k]     = FLOAT_TO_Q15(cosf(angle));
+      twiddle[2 * k + 1] = FLOAT_TO_Q15(-sinf(angle));
+    }
+
+  fft->twiddle = twiddle;
+  fft->n       = n;
+}
+
+/****************************************************************************
+ * Name: rfft_q15
+ *
+ * Description:
+ *   Q15 version of rfft_f32().  The output has the same packing and is
+ *   scaled by 1/n, so it cannot overflow.
+ *
+ * Input Parameters:
+ *   fft - (in) pointer to the FFT instance
+ *   buf - (in/out) pointer to n samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rfft_q15(FAR struct rfft_q15_s *fft, FAR q15_t *buf)
+{
+  FAR const q15_t *tw;
+  uint16_t m;
+  uint16_t k;
+  int32_t sr;
+  int32_t si;
+  int32_t dr;
+  int32_t di;
+  int32_t tr;
+  int32_t ti;
+  int32_t wr;
+  int32_t wi;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(buf != NULL);
+
+  tw = fft->twiddle;
+  m  = fft->n / 2;
+
+  cfft_q15(buf, m, tw, 2);
+
+  sr     = buf[0];
+  si     = buf[1];
+  buf[0] = dsp_sat_q15((sr + si) >> 1);
+  buf[1] = dsp_sat_q15((sr - si) >> 1);
+
+  for (k = 1; k <= m / 2; k++)
+    {
+      /* Same as above with S and D left unhalved.  The final shift by 2
+       * applies both the 1/2 of S and D and the last 1/2 of the 1/n
+       * output scaling.
+       */
+
+      sr = buf[2 * k]     + buf[2 * (m - k)];
+      si = buf[2 * k + 1] - buf[2 * (m - k) + 1];
+      dr = buf[2 * k]     - buf[2 * (m - k)];
+      di = buf[2 * k + 1] + buf[2 * (m - k) + 1];
+
+      wr = tw[2 * k];
+      wi = tw[2 * k + 1];
+
+      tr = (wr * dr - wi * di + Q15_ROUND) >> 15;
+      ti = (wr * di + wi * dr + Q15_ROUND) >> 15;
+
+      buf[2 * k]           = dsp_sat_q15((sr + ti + 2) >> 2);
+      buf[2 * k + 1]       = dsp_sat_q15((si - tr + 2) >> 2);
+      buf[2 * (m - k)]     = dsp_sat_q15((sr - ti + 2) >> 2);
+      buf[2 * (m - k) + 1] = dsp_sat_q15((-(si + tr) + 2) >> 2);
+    }
+}
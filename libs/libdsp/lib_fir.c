@@ -0,0 +1,322 @@
+/****************************************************************************
+ * libs/libdsp/lib_fir.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "lib_fixed.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_push
+ *
+ * Description:
+ *   Store a new sample in the doubled delay line and return the position
+ *   of the newest sample.  state[pos .. pos + ntaps - 1] then holds the
+ *   last ntaps samples, newest first.  x is evaluated twice.
+ *
+ ****************************************************************************/
+
+#define fir_push(fir, x) \
+  do \
+    { \
+      (fir)->pos = ((fir)->pos == 0) ? (fir)->ntaps - 1 : (fir)->pos - 1; \
+      (fir)->state[(fir)->pos]               = (x); \
+      (fir)->state[(fir)->pos + (fir)->ntaps] = (x); \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_init_f32
+ *
+ * Description:
+ *   Initialize float FIR filter
+ *
+ * Input Parameters:
+ *   fir    - (out) pointer to the FIR filter instance
+ *   coeffs - (in) pointer to ntaps filter coefficients
+ *   state  - (in) pointer to the 2 * ntaps samples delay line
+ *   ntaps  - (in) number of filter taps
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_init_f32(FAR struct fir_f32_s *fir, FAR const float *coeffs,
+                  FAR float *state, uint16_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  fir->coeffs = coeffs;
+  fir->state  = state;
+  fir->ntaps  = ntaps;
+  fir->pos    = 0;
+
+  memset(state, 0, 2 * ntaps * sizeof(float));
+}
+
+/****************************************************************************
+ * Name: fir_f32
+ *
+ * Description:
+ *   Filter a block of float samples.  in and out may be the same buffer.
+ *
+ * Input Parameters:
+ *   fir - (in/out) pointer to the FIR filter instance
+ *   in  - (in) pointer to the input samples
+ *   out - (out) pointer to the output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_f32(FAR struct fir_f32_s *fir, FAR const float *in,
+             FAR float *out, size_t n)
+{
+  FAR const float *c;
+  FAR const float *s;
+  float acc0;
+  float acc1;
+  float acc2;
+  float acc3;
+  uint16_t k;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(in != NULL);
+  DEBUGASSERT(out != NULL);
+
+  for (; n > 0; n--)
+    {
+      fir_push(fir, *in);
+      in++;
+
+      c = fir->coeffs;
+      s = &fir->state[fir->pos];
+
+      /* Four independent sums hide the FPU multiply-add latency */
+
+      acc0 = 0.0f;
+      acc1 = 0.0f;
+      acc2 = 0.0f;
+      acc3 = 0.0f;
+
+      for (k = fir->ntaps; k >= 4; k -= 4, c += 4, s += 4)
+        {
+          acc0 += c[0] * s[0];
+          acc1 += c[1] * s[1];
+          acc2 += c[2] * s[2];
+          acc3 += c[3] * s[3];
+        }
+
+      for (; k > 0; k--)
+        {
+          acc0 += *c++ * *s++;
+        }
+
+      *out++ = (acc0 + acc1) + (acc2 + acc3);
+    }
+}
+
+/****************************************************************************
+ * Name: fir_init_q15
+ *
+ * Description:
+ *   Initialize Q15 FIR filter
+ *
+ * Input Parameters:
+ *   fir    - (out) pointer to the FIR filter instance
+ *   coeffs - (in) pointer to ntaps Q15 filter coefficients
+ *   state  - (in) pointer to the 2 * ntaps samples delay line
+ *   ntaps  - (in) number of filter taps
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_init_q15(FAR struct fir_q15_s *fir, FAR const q15_t *coeffs,
+                  FAR q15_t *state, uint16_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  fir->coeffs = coeffs;
+  fir->state  = state;
+  fir->ntaps  = ntaps;
+  fir->pos    = 0;
+
+  memset(state, 0, 2 * ntaps * sizeof(q15_t));
+}
+
+/****************************************************************************
+ * Name: fir_q15
+ *
+ * Description:
+ *   Filter a block of Q15 samples.  Products are summed exactly in 64 bits
+ *   and the result is rounded and saturated to Q15.  in and out may be the
+ *   same buffer.
+ *
+ * Input Parameters:
+ *   fir - (in/out) pointer to the FIR filter instance
+ *   in  - (in) pointer to the input samples
+ *   out - (out) pointer to the output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_q15(FAR struct fir_q15_s *fir, FAR const q15_t *in,
+             FAR q15_t *out, size_t n)
+{
+  int64_t acc;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(in != NULL);
+  DEBUGASSERT(out != NULL);
+
+  for (; n > 0; n--)
+    {
+      fir_push(fir, *in);
+      in++;
+
+      acc = dsp_dot_q15(fir->coeffs, &fir->state[fir->pos], fir->ntaps);
+      acc = (acc + Q15_ROUND) >> 15;
+
+      *out++ = dsp_sat_q15(dsp_sat_q31(acc));
+    }
+}
+
+/****************************************************************************
+ * Name: fir_init_q31
+ *
+ * Description:
+ *   Initialize Q31 FIR filter
+ *
+ * Input Parameters:
+ *   fir    - (out) pointer to the FIR filter instance
+ *   coeffs - (in) pointer to ntaps Q31 filter coefficients
+ *   state  - (in) pointer to the 2 * ntaps samples delay line
+ *   ntaps  - (in) number of filter taps
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_init_q31(FAR struct fir_q31_s *fir, FAR const q31_t *coeffs,
+                  FAR q31_t *state, uint16_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  fir->coeffs = coeffs;
+  fir->state  = state;
+  fir->ntaps  = ntaps;
+  fir->pos    = 0;
+
+  memset(state, 0, 2 * ntaps * sizeof(q31_t));
+}
+
+/****************************************************************************
+ * Name: fir_q31
+ *
+ * Description:
+ *   Filter a block of Q31 samples.  Only the upper 32 bits of each Q62
+ *   product are kept (a single MULSH on Xtensa, SMULL on ARM), so that
+ *   the Q30 sum cannot overflow 64 bits.  in and out may be the same
+ *   buffer.
+ *
+ * Input Parameters:
+ *   fir - (in/out) pointer to the FIR filter instance
+ *   in  - (in) pointer to the input samples
+ *   out - (out) pointer to the output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_q31(FAR struct fir_q31_s *fir, FAR const q31_t *in,
+             FAR q31_t *out, size_t n)
+{
+  FAR const q31_t *c;
+  FAR const q31_t *s;
+  int64_t acc;
+  uint16_t k;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(in != NULL);
+  DEBUGASSERT(out != NULL);
+
+  for (; n > 0; n--)
+    {
+      fir_push(fir, *in);
+      in++;
+
+      c   = fir->coeffs;
+      s   = &fir->state[fir->pos];
+      acc = 0;
+
+      for (k = fir->ntaps; k > 0; k--)
+        {
+          acc += (int32_t)(((int64_t)*c++ * *s++) >> 32);
+        }
+
+      *out++ = dsp_sat_q31(acc * 2);
+    }
+}
@@ -0,0 +1,188 @@
+/****************************************************************************
+ * libs/libdsp/lib_fixed.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBDSP_LIB_FIXED_H
+#define __LIBS_LIBDSP_LIB_FIXED_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* ARMv7E-M (Cortex-M4/M7) and ARMv8-M Mainline with the DSP extension
+ * provide single cycle saturation (SSAT) and dual 16x16 multiply
+ * accumulate into a 64-bit accumulator (SMLALD).
+ *
+ * The Xtensa MAC16 accumulator is not part of the saved task context, so
+ * it cannot be used from thread level code.  The portable C below is
+ * written so that xtensa-gcc emits MUL16S for Q15 and MULSH for Q31
+ * products instead.
+ */
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#  define DSP_HAVE_ARM_DSP 1
+#endif
+
+/* Constants of the fixed-point transformations */
+
+#define ONE_BY_SQRT3_Q15     (18919)         /* 0.57735 */
+#define SQRT3_BY_TWO_Q15     (28378)         /* 0.866025 */
+#define ONE_BY_SQRT3_Q31     (1239850262)    /* 0.57735 */
+#define SQRT3_BY_TWO_Q31     (1859775393)    /* 0.866025 */
+
+/* Rounding constants for the conversion of Q30 and Q62 products */
+
+#define Q15_ROUND            (1 << 14)
+#define Q31_ROUND            ((int64_t)1 << 30)
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dsp_sat_q15
+ *
+ * Description:
+ *   Saturate a 32-bit intermediate to the Q15 range.
+ *
+ ****************************************************************************/
+
+static inline q15_t dsp_sat_q15(int32_t x)
+{
+#ifdef DSP_HAVE_ARM_DSP
+  __asm__ ("ssat %0, #16, %1" : "=r" (x) : "r" (x));
+  return (q15_t)x;
+#else
+  if (x > Q15_MAX)
+    {
+      return Q15_MAX;
+    }
+  else if (x < Q15_MIN)
+    {
+      return Q15_MIN;
+    }
+
+  return (q15_t)x;
+#endif
+}
+
+/****************************************************************************
+ * Name: dsp_sat_q31
+ *
+ * Description:
+ *   Saturate a 64-bit intermediate to the Q31 range.
+ *
+ ****************************************************************************/
+
+static inline q31_t dsp_sat_q31(int64_t x)
+{
+  if (x > Q31_MAX)
+    {
+      return Q31_MAX;
+    }
+  else if (x < Q31_MIN)
+    {
+      return Q31_MIN;
+    }
+
+  return (q31_t)x;
+}
+
+/****************************************************************************
+ * Name: dsp_mul_q15
+ *
+ * Description:
+ *   Rounded and saturated Q15 multiplication.
+ *
+ ****************************************************************************/
+
+static inline q15_t dsp_mul_q15(q15_t a, q15_t b)
+{
+  return dsp_sat_q15(((int32_t)a * b + Q15_ROUND) >> 15);
+}
+
+/****************************************************************************
+ * Name: dsp_dot_q15
+ *
+ * Description:
+ *   Dot product of two Q15 vectors.  The result is the exact Q30 sum.
+ *
+ ****************************************************************************/
+
+static inline int64_t dsp_dot_q15(FAR const q15_t *a, FAR const q15_t *b,
+                                  size_t n)
+{
+  int64_t acc = 0;
+
+#ifdef DSP_HAVE_ARM_DSP
+  uint32_t x;
+  uint32_t y;
+
+  /* Two products per SMLALD.  memcpy() lets the compiler use an unaligned
+   * LDR, which Cortex-M supports.
+   */
+
+  for (; n >= 2; n -= 2, a += 2, b += 2)
+    {
+      memcpy(&x, a, sizeof(x));
+      memcpy(&y, b, sizeof(y));
+      __asm__ ("smlald %Q0, %R0, %1, %2" : "+r" (acc) : "r" (x), "r" (y));
+    }
+#else
+  /* A single full scale product is 2^30, so the sum must be kept in 64
+   * bits.
+   */
+
+  for (; n >= 2; n -= 2, a += 2, b += 2)
+    {
+      acc += (int32_t)a[0] * b[0];
+      acc += (int32_t)a[1] * b[1];
+    }
+#endif
+
+  if (n > 0)
+    {
+      acc += (int32_t)*a * *b;
+    }
+
+  return acc;
+}
+
+#endif /* __LIBS_LIBDSP_LIB_FIXED_H */
@@ -0,0 +1,313 @@
+/****************************************************************************
+ * libs/libdsp/lib_transform_fixed.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "lib_fixed.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clarke_transform_q15
+ *
+ * Description:
+ *   Q15 version of clarke_transform().
+ *
+ *   i_alpha = i_a
+ *   i_beta  = (i_a + 2*i_b) / sqrt(3)
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frame
+ *   ab  - (out) pointer to the alpha-beta frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_q15(FAR abc_frame_q15_t *abc,
+                          FAR ab_frame_q15_t *ab)
+{
+  int32_t tmp;
+
+  DEBUGASSERT(abc != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  tmp   = (int32_t)abc->a + 2 * (int32_t)abc->b;
+
+  ab->a = abc->a;
+  ab->b = dsp_sat_q15((tmp * ONE_BY_SQRT3_Q15 + Q15_ROUND) >> 15);
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_q15
+ *
+ * Description:
+ *   Q15 version of inv_clarke_transform().
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frame
+ *   abc - (out) pointer to the abc frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_q15(FAR ab_frame_q15_t *ab,
+                              FAR abc_frame_q15_t *abc)
+{
+  int32_t tmp;
+
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(abc != NULL);
+
+  /* Assume non-power-invariant transform and balanced system */
+
+  tmp    = (int32_t)ab->b * SQRT3_BY_TWO_Q15 - (int32_t)ab->a * 16384;
+
+  abc->a = ab->a;
+  abc->b = dsp_sat_q15((tmp + Q15_ROUND) >> 15);
+  abc->c = dsp_sat_q15(-(int32_t)abc->a - abc->b);
+}
+
+/****************************************************************************
+ * Name: park_transform_q15
+ *
+ * Description:
+ *   Q15 version of park_transform().
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle sine and cosine
+ *   ab    - (in) pointer to the alpha-beta frame
+ *   dq    - (out) pointer to the direct-quadrature frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_q15(FAR phase_angle_q15_t *angle,
+                        FAR ab_frame_q15_t *ab,
+                        FAR dq_frame_q15_t *dq)
+{
+  int32_t d;
+  int32_t q;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(dq != NULL);
+
+  d = (int32_t)angle->cos * ab->a + (int32_t)angle->sin * ab->b;
+  q = (int32_t)angle->cos * ab->b - (int32_t)angle->sin * ab->a;
+
+  dq->d = dsp_sat_q15((d + Q15_ROUND) >> 15);
+  dq->q = dsp_sat_q15((q + Q15_ROUND) >> 15);
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_q15
+ *
+ * Description:
+ *   Q15 version of inv_park_transform().
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle sine and cosine
+ *   dq    - (in) pointer to the direct-quadrature frame
+ *   ab    - (out) pointer to the alpha-beta frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_q15(FAR phase_angle_q15_t *angle,
+                            FAR dq_frame_q15_t *dq,
+                            FAR ab_frame_q15_t *ab)
+{
+  int32_t a;
+  int32_t b;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(dq != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  a = (int32_t)angle->cos * dq->d - (int32_t)angle->sin * dq->q;
+  b = (int32_t)angle->cos * dq->q + (int32_t)angle->sin * dq->d;
+
+  ab->a = dsp_sat_q15((a + Q15_ROUND) >> 15);
+  ab->b = dsp_sat_q15((b + Q15_ROUND) >> 15);
+}
+
+/****************************************************************************
+ * Name: clarke_transform_q31
+ *
+ * Description:
+ *   Q31 version of clarke_transform().
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frame
+ *   ab  - (out) pointer to the alpha-beta frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_q31(FAR abc_frame_q31_t *abc,
+                          FAR ab_frame_q31_t *ab)
+{
+  int64_t tmp;
+
+  DEBUGASSERT(abc != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  /* a + 2*b needs 33 bits; drop one bit before the multiplication so that
+   * the product stays within 64 bits.
+   */
+
+  tmp   = ((int64_t)abc->a + 2 * (int64_t)abc->b) >> 1;
+
+  ab->a = abc->a;
+  ab->b = dsp_sat_q31((tmp * ONE_BY_SQRT3_Q31 + (Q31_ROUND >> 1)) >> 30);
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_q31
+ *
+ * Description:
+ *   Q31 version of inv_clarke_transform().
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frame
+ *   abc - (out) pointer to the abc frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_q31(FAR ab_frame_q31_t *ab,
+                              FAR abc_frame_q31_t *abc)
+{
+  int64_t tmp;
+
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(abc != NULL);
+
+  /* Assume non-power-invariant transform and balanced system */
+
+  tmp    = (int64_t)ab->b * SQRT3_BY_TWO_Q31 - ((int64_t)ab->a << 30);
+
+  abc->a = ab->a;
+  abc->b = dsp_sat_q31((tmp + Q31_ROUND) >> 31);
+  abc->c = dsp_sat_q31(-(int64_t)abc->a - abc->b);
+}
+
+/****************************************************************************
+ * Name: park_transform_q31
+ *
+ * Description:
+ *   Q31 version of park_transform().
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle sine and cosine
+ *   ab    - (in) pointer to the alpha-beta frame
+ *   dq    - (out) pointer to the direct-quadrature frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_q31(FAR phase_angle_q31_t *angle,
+                        FAR ab_frame_q31_t *ab,
+                        FAR dq_frame_q31_t *dq)
+{
+  int64_t d;
+  int64_t q;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(dq != NULL);
+
+  /* sin^2 + cos^2 = 1, so the sum of the two Q62 products fits in 64 bits */
+
+  d = (int64_t)angle->cos * ab->a + (int64_t)angle->sin * ab->b;
+  q = (int64_t)angle->cos * ab->b - (int64_t)angle->sin * ab->a;
+
+  dq->d = dsp_sat_q31((d + Q31_ROUND) >> 31);
+  dq->q = dsp_sat_q31((q + Q31_ROUND) >> 31);
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_q31
+ *
+ * Description:
+ *   Q31 version of inv_park_transform().
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle sine and cosine
+ *   dq    - (in) pointer to the direct-quadrature frame
+ *   ab    - (out) pointer to the alpha-beta frame
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_q31(FAR phase_angle_q31_t *angle,
+                            FAR dq_frame_q31_t *dq,
+                            FAR ab_frame_q31_t *ab)
+{
+  int64_t a;
+  int64_t b;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(dq != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  a = (int64_t)angle->cos * dq->d - (int64_t)angle->sin * dq->q;
+  b = (int64_t)angle->cos * dq->q + (int64_t)angle->sin * dq->d;
+
+  ab->a = dsp_sat_q31((a + Q31_ROUND) >> 31);
+  ab->b = dsp_sat_q31((b + Q31_ROUND) >> 31);
+}
@@ -333,6 +333,7 @@ nxf_findglyph(FAR struct nxfonts_fcache_s *priv, uint8_t ch)
            */
 
           nxf_removeglyph(priv, glyph, prev);
+          lib_free(glyph);
           return NULL;
         }
     }
@@ -621,6 +622,43 @@ nxf_findcache(enum nx_fontid_e fontid, nxgl_mxpixel_t fgcolor,
   return NULL;
 }
 
+/****************************************************************************
+ * Name: nxf_getglyph
+ *
+ * Description:
+ *   Find the glyph for the character code 'ch' in the font cache or, if is
+ *   not cached, render it and add it to the font cache.
+ *
+ * Assumptions:
+ *   The caller holds the font cache semaphore.
+ *
+ ****************************************************************************/
+
+static FAR struct nxfonts_glyph_s *
+nxf_getglyph(FAR struct nxfonts_fcache_s *priv, uint8_t ch)
+{
+  FAR struct nxfonts_glyph_s *glyph;
+  FAR const struct nx_fontbitmap_s *fbm;
+
+  /* First, try to find the glyph in the cache of pre-rendered glyphs */
+
+  glyph = nxf_findglyph(priv, ch);
+  if (glyph == NULL)
+    {
+      /* No, it is not cached... Does the code map to a font? */
+
+      fbm = nxf_getbitmap(priv->font, ch);
+      if (fbm)
+        {
+          /* Yes.. render the glyph for the font */
+
+          glyph = nxf_renderglyph(priv, fbm, ch);
+        }
+    }
+
+  return glyph;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -816,6 +854,13 @@ void nxf_cache_disconnect(FCACHE fhandle)
 
   DEBUGASSERT(priv != NULL && priv->fclients > 0);
 
+  /* Get exclusive access to the font cache list first so that no other
+   * client can find and connect to the font cache while we are deciding
+   * whether or not to free it.
+   */
+
+  nxf_list_lock();
+
   /* Get exclusive access to the font cache */
 
   nxf_cache_lock(priv);
@@ -824,17 +869,13 @@ void nxf_cache_disconnect(FCACHE fhandle)
 
   if (priv->fclients <= 1)
     {
-      /* Get exclusive access to the font cache list */
-
-      nxf_list_lock();
-
       /* Remove the font cache from the list of caches.  This is a singly
        * linked list, so we must do this the hard way.
        */
 
       for (prev = NULL, fcache = g_fcaches;
            fcache != priv && fcache != NULL;
-           fcache = fcache->flink);
+           prev = fcache, fcache = fcache->flink);
 
       DEBUGASSERT(fcache == priv);
       nxf_removecache(fcache, prev);
@@ -864,6 +905,7 @@ void nxf_cache_disconnect(FCACHE fhandle)
 
       priv->fclients--;
       nxf_cache_unlock(priv);
+      nxf_list_unlock();
     }
 }
 
@@ -911,7 +953,6 @@ FAR const struct nxfonts_glyph_s *nxf_cache_getglyph(FCACHE fhandle, uint8_t ch)
 {
   FAR struct nxfonts_fcache_s *priv = (FAR struct nxfonts_fcache_s *)fhandle;
   FAR struct nxfonts_glyph_s *glyph;
-  FAR const struct nx_fontbitmap_s *fbm;
 
   ginfo("ch=%c (%02x)\n", (ch >= 32 && ch < 128) ? ch : '.', ch);
 
@@ -919,22 +960,59 @@ FAR const struct nxfonts_glyph_s *nxf_cache_getglyph(FCACHE fhandle, uint8_t ch)
 
   nxf_cache_lock(priv);
 
-  /* First, try to find the glyph in the cache of pre-rendered glyphs */
+  /* Find or render the glyph */
 
-  glyph = nxf_findglyph(priv, ch);
-  if (glyph == NULL)
-    {
-      /* No, it is not cached... Does the code map to a font? */
+  glyph = nxf_getglyph(priv, ch);
 
-      fbm = nxf_getbitmap(priv->font, ch);
-      if (fbm)
-        {
-          /* Yes.. render the glyph for the font */
+  nxf_cache_unlock(priv);
+  return glyph;
+}
 
-          glyph = nxf_renderglyph(priv, fbm, ch);
+/****************************************************************************
+ * Name: nxf_cache_getglyphs
+ *
+ * Description:
+ *   Get the font glyphs for each of the 'nchars' character codes in 'str'
+ *   from the font cache, rendering any glyphs that are not yet cached.
+ *   This is equivalent to calling nxf_cache_getglyph() for each character
+ *   but the font cache is locked only once for the whole string.
+ *
+ *   Glyphs are returned in 'glyphs'; an entry is set to NULL if there is no
+ *   glyph for the character (such as for a space).  The cache should be
+ *   connected with 'maxglyphs' at least as large as the number of distinct
+ *   characters in the string; otherwise glyphs returned earlier in the
+ *   string may be evicted by glyphs rendered later.
+ *
+ * Returned Value:
+ *   The number of non-NULL glyphs returned in 'glyphs'.
+ *
+ ****************************************************************************/
+
+int nxf_cache_getglyphs(FCACHE fhandle, FAR const uint8_t *str, int nchars,
+                        FAR const struct nxfonts_glyph_s **glyphs)
+{
+  FAR struct nxfonts_fcache_s *priv = (FAR struct nxfonts_fcache_s *)fhandle;
+  int nglyphs = 0;
+  int i;
+
+  DEBUGASSERT(priv != NULL && str != NULL && glyphs != NULL);
+  ginfo("str=%p nchars=%d\n", str, nchars);
+
+  /* Get exclusive access to the font cache */
+
+  nxf_cache_lock(priv);
+
+  /* Find or render the glyph for each character of the string */
+
+  for (i = 0; i < nchars; i++)
+    {
+      glyphs[i] = nxf_getglyph(priv, str[i]);
+      if (glyphs[i] != NULL)
+        {
+          nglyphs++;
         }
     }
 
   nxf_cache_unlock(priv);
-  return glyph;
+  return nglyphs;
 }
@@ -41,6 +41,7 @@
 //***************************************************************************
 
 #include <nuttx/config.h>
+#include <sys/types.h>
 
 //***************************************************************************
 // Definitions
@@ -85,4 +86,9 @@ extern "C" FAR void *__dso_handle;
 
 extern "C" int __cxa_atexit(__cxa_exitfunc_t func, void *arg, void *dso_handle);
 
+#ifdef CONFIG_CXX_NEWPOOL
+FAR void *libxx_pool_alloc(size_t nbytes);
+bool libxx_pool_free(FAR void *ptr, size_t nbytes);
+#endif
+
 #endif // __LIBXX_LIBXX_HXX
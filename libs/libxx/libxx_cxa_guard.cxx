@@ -37,8 +37,12 @@
 // Included Files
 //***************************************************************************
 
+#include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <sched.h>
+#include <unistd.h>
+
 //***************************************************************************
 // Pre-processor Definitions
 //***************************************************************************
@@ -50,16 +54,30 @@
 #ifdef __ARM_EABI__
 // The 32-bit ARM C++ ABI specifies that the guard is a 32-bit
 // variable and the least significant bit contains 0 prior to
-// initialization, and 1 after.
+// initialization, and 1 after.  Bit 1 is used here to mark an
+// initialization in progress.
 
 typedef int __guard;
 
+#  define GUARD_DONE(g)       (__atomic_load_n(g, __ATOMIC_ACQUIRE) & 1)
+#  define GUARD_SETDONE(g)    __atomic_store_n(g, 1, __ATOMIC_RELEASE)
+#  define GUARD_BUSY(g)       (*(g) & 2)
+#  define GUARD_SETBUSY(g)    (*(g) |= 2)
+#  define GUARD_CLRBUSY(g)    (*(g) &= ~2)
+
 #else
 // The "standard" C++ ABI specifies that the guard is a 64-bit
 // variable and the first byte contains 0 prior to initialization, and
-// 1 after.
+// 1 after.  The second byte is used here to mark an initialization in
+// progress.
 
 __extension__ typedef int __guard __attribute__((mode(__DI__)));
+
+#  define GUARD_DONE(g)       __atomic_load_n((FAR char *)(g), __ATOMIC_ACQUIRE)
+#  define GUARD_SETDONE(g)    __atomic_store_n((FAR char *)(g), 1, __ATOMIC_RELEASE)
+#  define GUARD_BUSY(g)       (((FAR char *)(g))[1])
+#  define GUARD_SETBUSY(g)    (((FAR char *)(g))[1] = 1)
+#  define GUARD_CLRBUSY(g)    (((FAR char *)(g))[1] = 0)
 #endif
 
 //***************************************************************************
@@ -78,11 +96,38 @@ extern "C"
 
   int __cxa_guard_acquire(FAR __guard *g)
   {
-#ifdef __ARM_EABI__
-    return !(*g & 1);
-#else
-    return !*(char *)g;
-#endif
+    // Fast path:  The object is already initialized.  This is only a load
+    // and needs no lock.
+
+    if (GUARD_DONE(g))
+      {
+        return 0;
+      }
+
+    // Otherwise, claim the initialization unless another thread is
+    // already running it.  In that case, wait until it has finished (or
+    // aborted) and check again.
+
+    for (; ; )
+      {
+        sched_lock();
+
+        if (GUARD_DONE(g))
+          {
+            sched_unlock();
+            return 0;
+          }
+
+        if (!GUARD_BUSY(g))
+          {
+            GUARD_SETBUSY(g);
+            sched_unlock();
+            return 1;
+          }
+
+        sched_unlock();
+        (void)usleep(1);
+      }
   }
 
   //*************************************************************************
@@ -91,18 +136,20 @@ extern "C"
 
   void __cxa_guard_release(FAR __guard *g)
   {
-#ifdef __ARM_EABI__
-    *g = 1;
-#else
-    *(char *)g = 1;
-#endif
+    sched_lock();
+    GUARD_SETDONE(g);
+    GUARD_CLRBUSY(g);
+    sched_unlock();
   }
 
   //*************************************************************************
   // Name: __cxa_guard_abort
   //*************************************************************************
 
-  void __cxa_guard_abort(FAR __guard *)
+  void __cxa_guard_abort(FAR __guard *g)
   {
+    sched_lock();
+    GUARD_CLRBUSY(g);
+    sched_unlock();
   }
 }
@@ -68,6 +68,13 @@ void operator delete(FAR void *ptr, unsigned long size)
 void operator delete(FAR void *ptr, unsigned int size)
 #endif
 {
+#ifdef CONFIG_CXX_NEWPOOL
+  if (libxx_pool_free(ptr, size))
+    {
+      return;
+    }
+#endif
+
   lib_free(ptr);
 }
 
@@ -51,5 +51,12 @@
 
 void operator delete[](void *ptr)
 {
+#ifdef CONFIG_CXX_NEWPOOL
+  if (libxx_pool_free(ptr, 0))
+    {
+      return;
+    }
+#endif
+
   lib_free(ptr);
 }
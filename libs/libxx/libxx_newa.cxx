@@ -83,9 +83,18 @@ void *operator new[](unsigned int nbytes)
       nbytes = 1;
     }
 
-  // Perform the allocation
+  // Perform the allocation.  Small objects come from the pools if
+  // possible.
 
+#ifdef CONFIG_CXX_NEWPOOL
+  void *alloc = libxx_pool_alloc(nbytes);
+  if (alloc == 0)
+    {
+      alloc = lib_malloc(nbytes);
+    }
+#else
   void *alloc = lib_malloc(nbytes);
+#endif
 
 #ifdef CONFIG_DEBUG_ERROR
   if (alloc == 0)
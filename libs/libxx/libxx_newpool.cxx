@@ -0,0 +1,211 @@
+//***************************************************************************
+// libs/libxx/libxx_newpool.cxx
+//
+//   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+//   Author: Gregory Nutt <gnutt@nuttx.org>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+// 3. Neither the name NuttX nor the names of its contributors may be
+//    used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//***************************************************************************
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sched.h>
+
+#include <nuttx/mm/objpool.h>
+
+#include "libxx.hxx"
+
+#ifdef CONFIG_CXX_NEWPOOL
+
+//***************************************************************************
+// Pre-processor Definitions
+//***************************************************************************
+
+// Size class 'i' holds objects of up to (LIBXX_POOL_MINSIZE << i) bytes
+
+#define LIBXX_POOL_MINSIZE  16
+#define LIBXX_POOL_MAXSIZE  (LIBXX_POOL_MINSIZE << (CONFIG_CXX_NEWPOOL_NCLASSES - 1))
+
+//***************************************************************************
+// Private Data
+//***************************************************************************
+
+static FAR struct objpool_s *g_newpool[CONFIG_CXX_NEWPOOL_NCLASSES];
+
+static FAR const char * const g_newpool_name[] =
+{
+  "new16", "new32", "new64", "new128", "new256", "new512", "new1k", "new2k"
+};
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: libxx_pool_class
+//
+// Description:
+//   Return the smallest size class that holds 'nbytes'.  'nbytes' must not
+//   exceed LIBXX_POOL_MAXSIZE.
+//
+//***************************************************************************
+
+static inline int libxx_pool_class(size_t nbytes)
+{
+  size_t size = LIBXX_POOL_MINSIZE;
+  int ndx = 0;
+
+  while (size < nbytes)
+    {
+      size <<= 1;
+      ndx++;
+    }
+
+  return ndx;
+}
+
+//***************************************************************************
+// Name: libxx_pool_get
+//
+// Description:
+//   Return the pool of a size class, creating it on first use.  Creation is
+//   done only once so it is not worth a lock of its own.
+//
+//***************************************************************************
+
+static FAR struct objpool_s *libxx_pool_get(int ndx)
+{
+  FAR struct objpool_s *pool = g_newpool[ndx];
+
+  if (pool == NULL)
+    {
+      sched_lock();
+      pool = g_newpool[ndx];
+      if (pool == NULL)
+        {
+          pool = objpool_create(g_newpool_name[ndx],
+                                LIBXX_POOL_MINSIZE << ndx,
+                                CONFIG_CXX_NEWPOOL_NOBJS);
+          g_newpool[ndx] = pool;
+        }
+
+      sched_unlock();
+    }
+
+  return pool;
+}
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: libxx_pool_alloc
+//
+// Description:
+//   Allocate the memory for operator new from the pool of its size class.
+//   NULL is returned if the size is too large for the pools or if the pool
+//   is exhausted; the caller must then use the heap.
+//
+//***************************************************************************
+
+FAR void *libxx_pool_alloc(size_t nbytes)
+{
+  FAR struct objpool_s *pool;
+
+  if (nbytes > LIBXX_POOL_MAXSIZE)
+    {
+      return NULL;
+    }
+
+  pool = libxx_pool_get(libxx_pool_class(nbytes));
+  if (pool == NULL)
+    {
+      return NULL;
+    }
+
+  return objpool_alloc(pool);
+}
+
+//***************************************************************************
+// Name: libxx_pool_free
+//
+// Description:
+//   Return memory allocated by libxx_pool_alloc() to its pool.  'nbytes' is
+//   the size passed to a sized operator delete or zero if the size is not
+//   known.  False is returned if 'ptr' does not belong to any pool and must
+//   be freed to the heap.
+//
+//***************************************************************************
+
+bool libxx_pool_free(FAR void *ptr, size_t nbytes)
+{
+  FAR struct objpool_s *pool;
+  int ndx;
+
+  if (nbytes > 0)
+    {
+      // The size class is known; only its pool can hold the object
+
+      if (nbytes > LIBXX_POOL_MAXSIZE)
+        {
+          return false;
+        }
+
+      ndx  = libxx_pool_class(nbytes);
+      pool = g_newpool[ndx];
+
+      if (pool != NULL && objpool_member(pool, ptr))
+        {
+          objpool_free(pool, ptr);
+          return true;
+        }
+
+      return false;
+    }
+
+  for (ndx = 0; ndx < CONFIG_CXX_NEWPOOL_NCLASSES; ndx++)
+    {
+      pool = g_newpool[ndx];
+      if (pool != NULL && objpool_member(pool, ptr))
+        {
+          objpool_free(pool, ptr);
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#endif // CONFIG_CXX_NEWPOOL
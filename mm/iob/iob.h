@@ -53,6 +53,11 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#if !defined(CONFIG_SMP) || !defined(CONFIG_IOB_PERCPU_CACHE)
+#  undef  CONFIG_IOB_PERCPU_CACHE
+#  define CONFIG_IOB_PERCPU_CACHE 0
+#endif
+
 #if defined(CONFIG_DEBUG_FEATURES) && defined(CONFIG_IOB_DEBUG)
 #ifdef CONFIG_CPP_HAVE_VARARGS
 
@@ -95,6 +100,12 @@ extern FAR struct iob_s *g_iob_freelist;
 
 extern FAR struct iob_s *g_iob_committed;
 
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+/* A list of all free, unallocated small I/O buffers */
+
+extern FAR struct iob_s *g_iob_small_freelist;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -115,6 +126,12 @@ extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
 extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
 #endif
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/* The number of threads waiting in iob_allocwait() */
+
+extern volatile int16_t g_iob_nwaiters;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -154,6 +171,56 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_alloc_tail
+ *
+ * Description:
+ *   Allocate an I/O buffer that will be added to the end of a chain to hold
+ *   the final 'len' bytes of a packet.  A small I/O buffer is used if one
+ *   is available and 'len' will fit; otherwise this is the same as
+ *   iob_alloc_user() or, if 'can_block' is false, iob_tryalloc_user().
+ *   Small I/O buffers are not charged to any consumer.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_tail(unsigned int len, bool throttled,
+                                 bool can_block, enum iob_user_e user);
+
+/****************************************************************************
+ * Name: iob_free_global
+ *
+ * Description:
+ *   Return an I/O buffer to the global free list (or to the committed list
+ *   if there is a thread waiting for it), bypassing the per-CPU cache.
+ *   Unlike iob_free(), the packet length is not propagated.
+ *
+ ****************************************************************************/
+
+void iob_free_global(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_cache_get, iob_cache_put, iob_cache_flush, and iob_cache_count
+ *
+ * Description:
+ *   Manage the per-CPU caches of free I/O buffers.  Cached I/O buffers are
+ *   still counted as allocated by g_iob_sem.
+ *
+ *   iob_cache_get() removes an I/O buffer from the cache of the current CPU
+ *   returning NULL if the cache is empty.  iob_cache_put() adds an I/O
+ *   buffer to that cache returning false if the cache is full.
+ *   iob_cache_flush() returns the contents of all caches to the global free
+ *   list and returns the number of I/O buffers that were flushed.
+ *   iob_cache_count() returns the number of I/O buffers in all caches.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+FAR struct iob_s *iob_cache_get(void);
+bool iob_cache_put(FAR struct iob_s *iob);
+int iob_cache_flush(void);
+int iob_cache_count(void);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
@@ -178,5 +245,56 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 void iob_notifier_signal(void);
 #endif
 
+/****************************************************************************
+ * Name: iob_notifier_signal_user
+ *
+ * Description:
+ *   The consumer 'user' has dropped below its quota.  Signal the workers
+ *   set up with iob_notifier_setup_user() for that consumer.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_IOB_NOTIFIER) && defined(CONFIG_IOB_QUOTAS)
+void iob_notifier_signal_user(enum iob_user_e user);
+#endif
+
+/****************************************************************************
+ * Name: iob_quota_initialize
+ *
+ * Description:
+ *   Set up the per-consumer quotas.  Called once from iob_initialize().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+void iob_quota_initialize(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_quota_release
+ *
+ * Description:
+ *   Return the quota count of an I/O buffer that has been freed to its
+ *   consumer 'user'.  If the consumer was at its quota, a notification
+ *   scoped to that consumer is signalled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+void iob_quota_release(enum iob_user_e user);
+#endif
+
+/****************************************************************************
+ * Name: iob_quota_avail
+ *
+ * Description:
+ *   Return true if the consumer 'user' is below its quota.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+bool iob_quota_avail(enum iob_user_e user);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __MM_IOB_IOB_H */
@@ -89,6 +89,9 @@ static FAR struct iob_s *iob_alloc_committed(void)
       iob->io_len    = 0;    /* Length of the data in the entry */
       iob->io_offset = 0;    /* Offset to the beginning of data */
       iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NET_LATENCY
+      iob->io_latency.lt_start = 0; /* Not traced */
+#endif
     }
 
   leave_critical_section(flags);
@@ -127,6 +130,14 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
 
   flags = enter_critical_section();
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Stop caching freed I/O buffers while we are waiting.  This must be done
+   * before iob_tryalloc() flushes the per-CPU caches.
+   */
+
+  g_iob_nwaiters++;
+#endif
+
   /* Try to get an I/O buffer.  If successful, the semaphore count will be
    * decremented atomically.
    */
@@ -193,9 +204,55 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
         }
     }
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  g_iob_nwaiters--;
+#endif
+
+  leave_critical_section(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_alloc_small
+ *
+ * Description:
+ *   Try to allocate a small I/O buffer by taking the buffer at the head of
+ *   the small free list.  Small I/O buffers are not counted by any
+ *   semaphore and this function never waits.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+static FAR struct iob_s *iob_alloc_small(void)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  iob = g_iob_small_freelist;
+  if (iob != NULL)
+    {
+      g_iob_small_freelist = iob->io_flink;
+    }
+
   leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NET_LATENCY
+      iob->io_latency.lt_start = 0; /* Not traced */
+#endif
+    }
+
   return iob;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -244,6 +301,28 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   FAR sem_t *sem;
 #endif
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Unthrottled allocations are satisfied from the cache of this CPU if
+   * possible.  Cached I/O buffers are already counted as allocated.
+   */
+
+  if (!throttled)
+    {
+      iob = iob_cache_get();
+      if (iob != NULL)
+        {
+          iob->io_flink  = NULL; /* Not in a chain */
+          iob->io_len    = 0;    /* Length of the data in the entry */
+          iob->io_offset = 0;    /* Offset to the beginning of data */
+          iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NET_LATENCY
+          iob->io_latency.lt_start = 0; /* Not traced */
+#endif
+          return iob;
+        }
+    }
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
   /* Select the semaphore count to check. */
 
@@ -300,10 +379,55 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
           iob->io_len    = 0;    /* Length of the data in the entry */
           iob->io_offset = 0;    /* Offset to the beginning of data */
           iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NET_LATENCY
+          iob->io_latency.lt_start = 0; /* Not traced */
+#endif
           return iob;
         }
     }
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* The free list is empty but there may still be free I/O buffers in the
+   * per-CPU caches.  Return those to the free list and try again.
+   */
+
+  if (iob_cache_flush() > 0)
+    {
+      leave_critical_section(flags);
+      return iob_tryalloc(throttled);
+    }
+#endif
+
   leave_critical_section(flags);
   return NULL;
 }
+
+/****************************************************************************
+ * Name: iob_alloc_tail
+ *
+ * Description:
+ *   Allocate an I/O buffer that will be added to the end of a chain to hold
+ *   the final 'len' bytes of a packet.  A small I/O buffer is used if one
+ *   is available and 'len' will fit; otherwise this is the same as
+ *   iob_alloc_user() or, if 'can_block' is false, iob_tryalloc_user().
+ *   Small I/O buffers are not charged to any consumer.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_tail(unsigned int len, bool throttled,
+                                 bool can_block, enum iob_user_e user)
+{
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+  if (len <= CONFIG_IOB_SMALL_BUFSIZE)
+    {
+      FAR struct iob_s *iob = iob_alloc_small();
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+#endif
+
+  return can_block ? iob_alloc_user(throttled, user) :
+                     iob_tryalloc_user(throttled, user);
+}
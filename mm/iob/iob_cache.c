@@ -0,0 +1,245 @@
+/****************************************************************************
+ * mm/iob/iob_cache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes the cache of free I/O buffers of one CPU.  The
+ * cache is normally accessed only by its own CPU so the spinlock is almost
+ * never contended; it is needed only for iob_cache_flush().
+ */
+
+struct iob_cache_s
+{
+  spinlock_t lock;               /* Protects the following */
+  uint8_t ncached;               /* Number of I/O buffers in the cache */
+  FAR struct iob_s *head;        /* List of cached I/O buffers */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_cache_s g_iob_cache[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The number of threads in iob_allocwait().  The caches are bypassed while
+ * this is non-zero so that freed I/O buffers reach the waiting threads.
+ */
+
+volatile int16_t g_iob_nwaiters;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_get
+ *
+ * Description:
+ *   Remove an I/O buffer from the cache of the current CPU.  NULL is
+ *   returned if the cache is empty.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_get(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  /* Disable local interrupts so that we stay on this CPU and so that there
+   * are no conflicts with interrupt level I/O buffer frees.
+   */
+
+  flags = up_irq_save();
+  cache = &g_iob_cache[up_cpu_index()];
+
+  spin_lock(&cache->lock);
+  iob = cache->head;
+  if (iob != NULL)
+    {
+      cache->head = iob->io_flink;
+      cache->ncached--;
+    }
+
+  spin_unlock(&cache->lock);
+  up_irq_restore(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cache_put
+ *
+ * Description:
+ *   Add a free I/O buffer to the cache of the current CPU.  false is
+ *   returned if the I/O buffer was not cached because the cache is full or
+ *   because a thread is waiting for an I/O buffer.
+ *
+ ****************************************************************************/
+
+bool iob_cache_put(FAR struct iob_s *iob)
+{
+  FAR struct iob_cache_s *cache;
+  irqstate_t flags;
+  bool cached = false;
+
+  if (g_iob_nwaiters > 0)
+    {
+      return false;
+    }
+
+  flags = up_irq_save();
+  cache = &g_iob_cache[up_cpu_index()];
+
+  spin_lock(&cache->lock);
+  if (cache->ncached < CONFIG_IOB_PERCPU_CACHE)
+    {
+      iob->io_flink = cache->head;
+      cache->head   = iob;
+      cache->ncached++;
+      cached        = true;
+    }
+
+  spin_unlock(&cache->lock);
+  up_irq_restore(flags);
+
+  /* A thread may have started waiting after the test above but before its
+   * own flush could see this I/O buffer.  iob_allocwait() increments
+   * g_iob_nwaiters before it flushes the caches, so checking again here
+   * guarantees that one side or the other will flush the I/O buffer.
+   */
+
+  if (cached && g_iob_nwaiters > 0)
+    {
+      (void)iob_cache_flush();
+    }
+
+  return cached;
+}
+
+/****************************************************************************
+ * Name: iob_cache_flush
+ *
+ * Description:
+ *   Return all of the I/O buffers in all of the per-CPU caches to the
+ *   global free list.  The number of I/O buffers flushed is returned.
+ *
+ ****************************************************************************/
+
+int iob_cache_flush(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  FAR struct iob_s *next;
+  irqstate_t flags;
+  int nflushed = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      /* Detach the list of cached I/O buffers */
+
+      cache = &g_iob_cache[cpu];
+
+      flags = up_irq_save();
+      spin_lock(&cache->lock);
+
+      iob            = cache->head;
+      cache->head    = NULL;
+      cache->ncached = 0;
+
+      spin_unlock(&cache->lock);
+      up_irq_restore(flags);
+
+      /* And free each of them.  This will also wake up any waiters */
+
+      for (; iob != NULL; iob = next)
+        {
+          next = iob->io_flink;
+          iob_free_global(iob);
+          nflushed++;
+        }
+    }
+
+  return nflushed;
+}
+
+/****************************************************************************
+ * Name: iob_cache_count
+ *
+ * Description:
+ *   Return the number of I/O buffers in all of the per-CPU caches.  The
+ *   value is only a snapshot since the caches are not locked.
+ *
+ ****************************************************************************/
+
+int iob_cache_count(void)
+{
+  int ncached = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      ncached += g_iob_cache[cpu].ncached;
+    }
+
+  return ncached;
+}
+
+#endif /* CONFIG_IOB_PERCPU_CACHE > 0 */
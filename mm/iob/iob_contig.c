@@ -98,6 +98,20 @@ int iob_contig(FAR struct iob_s *iob, unsigned int len)
 
   else if (len <= iob->io_pktlen)
     {
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+      /* A small I/O buffer can become the head of the chain when everything
+       * in front of it has been trimmed away.  It cannot hold more than its
+       * own, smaller payload.
+       */
+
+      if (len > IOB_BUFSIZE(iob))
+        {
+          ioberr("ERROR: small I/O buffer at head, requested len=%u\n",
+                 len);
+          return -ENOSPC;
+        }
+#endif
+
       /* Yes.. First eliminate any leading offset */
 
       if (iob->io_offset > 0)
@@ -134,7 +134,7 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
               /* Yes.. We can extend this buffer to the up to the very end. */
 
-              maxlen = CONFIG_IOB_BUFSIZE - iob->io_offset;
+              maxlen = IOB_BUFSIZE(iob) - iob->io_offset;
 
               /* This is the new buffer length that we need.  Of course,
                * clipped to the maximum possible size in this buffer.
@@ -182,20 +182,13 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       if (len > 0 && !next)
         {
-          /* Yes.. allocate a new buffer.
+          /* Yes.. allocate a new buffer, a small one if all of the remaining
+           * bytes will fit.
            *
            * Copy as many bytes as possible. Block if we're allowed.
            */
 
-          if (can_block)
-            {
-              next = iob_alloc(throttled);
-            }
-          else
-            {
-              next = iob_tryalloc(throttled);
-            }
-
+          next = iob_alloc_tail(len, throttled, can_block, IOB_USER(head));
           if (next == NULL)
             {
               ioberr("ERROR: Failed to allocate I/O buffer\n");
@@ -73,58 +73,58 @@
 #define IOB_MASK      (IOB_DIVIDER - 1)
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: iob_free
+ * Name: iob_notify
  *
  * Description:
- *   Free the I/O buffer at the head of a buffer chain returning it to the
- *   free list.  The link to  the next I/O buffer in the chain is return.
+ *   Signal any threads that have requested a notification when an IOB
+ *   becomes available.
  *
  ****************************************************************************/
 
-FAR struct iob_s *iob_free(FAR struct iob_s *iob)
-{
-  FAR struct iob_s *next = iob->io_flink;
-  irqstate_t flags;
 #ifdef CONFIG_IOB_NOTIFIER
+static void iob_notify(void)
+{
   int16_t navail;
-#endif
-
-  iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
-          iob, iob->io_pktlen, iob->io_len, next);
 
-  /* Copy the data that only exists in the head of a I/O buffer chain into
-   * the next entry.
+  /* Check if the IOB was claimed by a thread that is blocked waiting
+   * for an IOB.
    */
 
-  if (next != NULL)
+  navail = iob_navail(false);
+  if (navail > 0 && (navail & IOB_MASK) == 0)
     {
-      /* Copy and decrement the total packet length, being careful to
-       * do nothing too crazy.
+      /* Signal any threads that have requested a signal notification
+       * when an IOB becomes available.
        */
 
-      if (iob->io_pktlen > iob->io_len)
-        {
-          /* Adjust packet length and move it to the next entry */
+      iob_notifier_signal();
+    }
+}
+#else
+#  define iob_notify()
+#endif
 
-          next->io_pktlen = iob->io_pktlen - iob->io_len;
-          DEBUGASSERT(next->io_pktlen >= next->io_len);
-        }
-      else
-        {
-          /* This can only happen if the free entry isn't first entry in the
-           * chain...
-           */
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
 
-          next->io_pktlen = 0;
-        }
+/****************************************************************************
+ * Name: iob_free_global
+ *
+ * Description:
+ *   Return an I/O buffer to the global free list (or to the committed list
+ *   if there is a thread waiting for it), bypassing the per-CPU cache.
+ *   Unlike iob_free(), the packet length is not propagated.
+ *
+ ****************************************************************************/
 
-      iobinfo("next=%p io_pktlen=%u io_len=%u\n",
-              next, next->io_pktlen, next->io_len);
-    }
+void iob_free_global(FAR struct iob_s *iob)
+{
+  irqstate_t flags;
 
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
@@ -165,23 +165,105 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
   DEBUGASSERT(g_throttle_sem.semcount <= (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
 #endif
 
-#ifdef CONFIG_IOB_NOTIFIER
-  /* Check if the IOB was claimed by a thread that is blocked waiting
-   * for an IOB.
+  iob_notify();
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: iob_free
+ *
+ * Description:
+ *   Free the I/O buffer at the head of a buffer chain returning it to the
+ *   free list.  The link to  the next I/O buffer in the chain is return.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *next = iob->io_flink;
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+  irqstate_t flags;
+#endif
+#ifdef CONFIG_IOB_QUOTAS
+  enum iob_user_e user;
+#endif
+
+  iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
+          iob, iob->io_pktlen, iob->io_len, next);
+
+  /* Copy the data that only exists in the head of a I/O buffer chain into
+   * the next entry.
    */
 
-  navail = iob_navail(false);
-  if (navail > 0 && (navail & IOB_MASK) == 0)
+  if (next != NULL)
     {
-      /* Signal any threads that have requested a signal notification
-       * when an IOB becomes available.
+      /* Copy and decrement the total packet length, being careful to
+       * do nothing too crazy.
        */
 
-      iob_notifier_signal();
+      if (iob->io_pktlen > iob->io_len)
+        {
+          /* Adjust packet length and move it to the next entry */
+
+          next->io_pktlen = iob->io_pktlen - iob->io_len;
+          DEBUGASSERT(next->io_pktlen >= next->io_len);
+        }
+      else
+        {
+          /* This can only happen if the free entry isn't first entry in the
+           * chain...
+           */
+
+          next->io_pktlen = 0;
+        }
+
+      iobinfo("next=%p io_pktlen=%u io_len=%u\n",
+              next, next->io_pktlen, next->io_len);
     }
+
+#ifdef CONFIG_IOB_QUOTAS
+  /* Remember the consumer.  Its quota is returned only after the I/O
+   * buffer is back in the pool so that any notification finds it there.
+   */
+
+  user         = IOB_USER(iob);
+  iob->io_user = IOB_USER_OTHER;
 #endif
 
-  leave_critical_section(flags);
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+  /* Small I/O buffers simply go back to the small free list.  Nothing can
+   * be waiting for them.
+   */
+
+  if (iob_issmall(iob))
+    {
+      flags = enter_critical_section();
+      iob->io_flink        = g_iob_small_freelist;
+      g_iob_small_freelist = iob;
+      leave_critical_section(flags);
+      return next;
+    }
+#endif
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Keep the I/O buffer in the cache of this CPU if there is space */
+
+  if (iob_cache_put(iob))
+    {
+      iob_notify();
+    }
+  else
+#endif
+    {
+      iob_free_global(iob);
+    }
+
+#ifdef CONFIG_IOB_QUOTAS
+  if (user != IOB_USER_OTHER)
+    {
+      iob_quota_release(user);
+    }
+#endif
 
   /* And return the I/O buffer after the one that was freed */
 
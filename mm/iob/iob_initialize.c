@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
@@ -54,6 +55,17 @@
 #  define NULL ((FAR void *)0)
 #endif
 
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+/* The size of one small I/O buffer in units of uintptr_t:  The I/O buffer
+ * header followed by only CONFIG_IOB_SMALL_BUFSIZE bytes of payload.
+ * io_data[] is the last member of struct iob_s.
+ */
+
+#  define IOB_SMALL_NWORDS \
+     ((sizeof(struct iob_s) - CONFIG_IOB_BUFSIZE + \
+       CONFIG_IOB_SMALL_BUFSIZE + sizeof(uintptr_t) - 1) / sizeof(uintptr_t))
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -61,6 +73,9 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+static uintptr_t g_iob_small_pool[CONFIG_IOB_SMALL_NBUFFERS][IOB_SMALL_NWORDS];
+#endif
 #if CONFIG_IOB_NCHAINS > 0
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
@@ -77,6 +92,12 @@ FAR struct iob_s *g_iob_freelist;
 
 FAR struct iob_s *g_iob_committed;
 
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+/* A list of all free, unallocated small I/O buffers */
+
+FAR struct iob_s *g_iob_small_freelist;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -132,6 +153,18 @@ void iob_initialize(void)
 
       g_iob_committed = NULL;
 
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+      /* Add each small I/O buffer to the small free list */
+
+      for (i = 0; i < CONFIG_IOB_SMALL_NBUFFERS; i++)
+        {
+          FAR struct iob_s *iob = (FAR struct iob_s *)g_iob_small_pool[i];
+
+          iob->io_flink        = g_iob_small_freelist;
+          g_iob_small_freelist = iob;
+        }
+#endif
+
       nxsem_init(&g_iob_sem, 0, CONFIG_IOB_NBUFFERS);
 #if CONFIG_IOB_THROTTLE > 0
       nxsem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
@@ -155,6 +188,29 @@ void iob_initialize(void)
       nxsem_init(&g_qentry_sem, 0, CONFIG_IOB_NCHAINS);
 #endif
 
+#ifdef CONFIG_IOB_QUOTAS
+      iob_quota_initialize();
+#endif
+
       initialized = true;
     }
 }
+
+/****************************************************************************
+ * Name: iob_issmall
+ *
+ * Description:
+ *   Return true if the I/O buffer was taken from the pool of small I/O
+ *   buffers and holds only CONFIG_IOB_SMALL_BUFSIZE bytes of payload.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+bool iob_issmall(FAR const struct iob_s *iob)
+{
+  FAR const uintptr_t *addr = (FAR const uintptr_t *)iob;
+
+  return addr >= g_iob_small_pool[0] &&
+         addr <  g_iob_small_pool[CONFIG_IOB_SMALL_NBUFFERS];
+}
+#endif
@@ -71,6 +71,12 @@ int iob_navail(bool throttled)
     {
       ret = navail;
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+      /* I/O buffers in the per-CPU caches are free too */
+
+      ret += iob_cache_count();
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
       /* Subtract the throttle value is so requested */
 
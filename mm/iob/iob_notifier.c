@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <assert.h>
 
 #include <nuttx/wqueue.h>
@@ -119,6 +120,37 @@ int iob_notifier_teardown(int key)
   return work_notifier_teardown(key);
 }
 
+/****************************************************************************
+ * Name: iob_notifier_setup_user
+ *
+ * Description:
+ *   The same as iob_notifier_setup() except that the notification is
+ *   scoped to the consumer 'user':  The worker runs only when an IOB is
+ *   available AND that consumer is below its quota.
+ *
+ *   The consumer is used as the notification qualifier.  IOB_USER_OTHER is
+ *   zero so its notifications are the same as iob_notifier_setup().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+int iob_notifier_setup_user(int qid, worker_t worker, FAR void *arg,
+                            enum iob_user_e user)
+{
+  struct work_notifier_s info;
+
+  DEBUGASSERT(worker != NULL && (unsigned int)user < IOB_NUSERS);
+
+  info.evtype    = WORK_IOB_AVAIL;
+  info.qid       = qid;
+  info.qualifier = (FAR void *)((uintptr_t)user);
+  info.arg       = arg;
+  info.worker    = worker;
+
+  return work_notifier_setup(&info);
+}
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
@@ -141,9 +173,45 @@ int iob_notifier_teardown(int key)
 
 void iob_notifier_signal(void)
 {
+#ifdef CONFIG_IOB_QUOTAS
+  int user;
+
+  /* Consumers that are already at their quota are not signalled here.
+   * They will be signalled by iob_notifier_signal_user() when they drop
+   * below their quota.
+   */
+
+  for (user = IOB_USER_OTHER + 1; user < IOB_NUSERS; user++)
+    {
+      if (iob_quota_avail((enum iob_user_e)user))
+        {
+          work_notifier_signal(WORK_IOB_AVAIL, (FAR void *)((uintptr_t)user));
+        }
+    }
+#endif
+
   /* This is just a simple wrapper around work_notifier_signal(). */
 
-  return work_notifier_signal(WORK_IOB_AVAIL, NULL);
+  work_notifier_signal(WORK_IOB_AVAIL, NULL);
+}
+
+/****************************************************************************
+ * Name: iob_notifier_signal_user
+ *
+ * Description:
+ *   The consumer 'user' has dropped below its quota.  Signal the workers
+ *   set up with iob_notifier_setup_user() for that consumer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTAS
+void iob_notifier_signal_user(enum iob_user_e user)
+{
+  if (iob_navail(false) > 0)
+    {
+      work_notifier_signal(WORK_IOB_AVAIL, (FAR void *)((uintptr_t)user));
+    }
 }
+#endif
 
 #endif /* CONFIG_IOB_NOTIFIER */
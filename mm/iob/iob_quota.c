@@ -0,0 +1,411 @@
+/****************************************************************************
+ * mm/iob/iob_quota.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_QUOTAS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_IOB_QUOTA_TCP_RX
+#  define CONFIG_IOB_QUOTA_TCP_RX 0
+#endif
+
+#ifndef CONFIG_IOB_QUOTA_TCP_WRB
+#  define CONFIG_IOB_QUOTA_TCP_WRB 0
+#endif
+
+#ifndef CONFIG_IOB_QUOTA_UDP
+#  define CONFIG_IOB_QUOTA_UDP 0
+#endif
+
+#ifndef CONFIG_IOB_QUOTA_6LOWPAN
+#  define CONFIG_IOB_QUOTA_6LOWPAN 0
+#endif
+
+#ifndef CONFIG_IOB_QUOTA_BLUETOOTH
+#  define CONFIG_IOB_QUOTA_BLUETOOTH 0
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one I/O buffer consumer */
+
+struct iob_quota_s
+{
+  sem_t sem;                    /* Counts I/O buffers left in the quota */
+  struct iob_userinfo_s info;   /* Accounting */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_quota_s g_iob_quota[IOB_NUSERS];
+
+static FAR const char * const g_iob_username[IOB_NUSERS] =
+{
+  "other",
+  "tcp_rx",
+  "tcp_wrb",
+  "udp",
+  "6lowpan",
+  "bluetooth"
+};
+
+static const uint16_t g_iob_quotasize[IOB_NUSERS] =
+{
+  0,
+  CONFIG_IOB_QUOTA_TCP_RX,
+  CONFIG_IOB_QUOTA_TCP_WRB,
+  CONFIG_IOB_QUOTA_UDP,
+  CONFIG_IOB_QUOTA_6LOWPAN,
+  CONFIG_IOB_QUOTA_BLUETOOTH
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_quota_charge
+ *
+ * Description:
+ *   Charge a newly allocated I/O buffer to a consumer.  The quota count (if
+ *   any) must already have been taken.  Called in a critical section.
+ *   IOB_USER_OTHER is not accounted since plain iob_alloc() is not either.
+ *
+ ****************************************************************************/
+
+static void iob_quota_charge(FAR struct iob_s *iob, enum iob_user_e user)
+{
+  FAR struct iob_userinfo_s *info = &g_iob_quota[user].info;
+
+  if (user == IOB_USER_OTHER)
+    {
+      return;
+    }
+
+  iob->io_user = (uint8_t)user;
+  info->nalloc++;
+  if (++info->nused > info->npeak)
+    {
+      info->npeak = info->nused;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_quota_initialize
+ *
+ * Description:
+ *   Set up the per-consumer quotas.  Called once from iob_initialize().
+ *
+ ****************************************************************************/
+
+void iob_quota_initialize(void)
+{
+  int i;
+
+  for (i = 0; i < IOB_NUSERS; i++)
+    {
+      g_iob_quota[i].info.quota = g_iob_quotasize[i];
+      nxsem_init(&g_iob_quota[i].sem, 0, g_iob_quotasize[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_user
+ *
+ * Description:
+ *   The same as iob_tryalloc() except that the I/O buffer is charged to the
+ *   consumer 'user'.  NULL is returned if that consumer already holds its
+ *   quota of I/O buffers.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_user(bool throttled, enum iob_user_e user)
+{
+  FAR struct iob_quota_s *quota;
+  FAR struct iob_s *iob = NULL;
+  irqstate_t flags;
+
+  DEBUGASSERT((unsigned int)user < IOB_NUSERS);
+  quota = &g_iob_quota[user];
+
+  flags = enter_critical_section();
+  if (quota->info.quota > 0 && quota->sem.semcount <= 0)
+    {
+      /* This consumer is at its quota */
+
+      quota->info.ndenied++;
+    }
+  else
+    {
+      iob = iob_tryalloc(throttled);
+      if (iob != NULL)
+        {
+          /* Take a quota count.  As in iob_tryalloc(), this is a simple
+           * decrement because we may be called from an interrupt handler.
+           */
+
+          if (quota->info.quota > 0)
+            {
+              quota->sem.semcount--;
+            }
+
+          iob_quota_charge(iob, user);
+        }
+    }
+
+  leave_critical_section(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_alloc_user
+ *
+ * Description:
+ *   The same as iob_alloc() except that the I/O buffer is charged to the
+ *   consumer 'user'.  If that consumer already holds its quota of I/O
+ *   buffers, this waits until one of them is freed.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_user(bool throttled, enum iob_user_e user)
+{
+  FAR struct iob_quota_s *quota;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int ret;
+
+  /* Were we called from the interrupt level? */
+
+  if (up_interrupt_context() || sched_idletask())
+    {
+      /* Yes, then try to allocate an I/O buffer without waiting */
+
+      return iob_tryalloc_user(throttled, user);
+    }
+
+  DEBUGASSERT((unsigned int)user < IOB_NUSERS);
+  quota = &g_iob_quota[user];
+
+  /* Take a count from the quota first, waiting if necessary.  This is
+   * where a consumer that holds too many I/O buffers is pushed back.
+   */
+
+  if (quota->info.quota > 0)
+    {
+      do
+        {
+          ret = nxsem_wait(&quota->sem);
+        }
+      while (ret == -EINTR);
+
+      if (ret < 0)
+        {
+          return NULL;
+        }
+    }
+
+  /* Then allocate the I/O buffer, waiting as necessary */
+
+  iob = iob_alloc(throttled);
+
+  flags = enter_critical_section();
+  if (iob != NULL)
+    {
+      iob_quota_charge(iob, user);
+    }
+  else if (quota->info.quota > 0)
+    {
+      nxsem_post(&quota->sem);
+    }
+
+  leave_critical_section(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_quota_release
+ *
+ * Description:
+ *   Return the quota count of an I/O buffer that has been freed to its
+ *   consumer 'user'.  If the consumer was at its quota, a notification
+ *   scoped to that consumer is signalled.
+ *
+ ****************************************************************************/
+
+void iob_quota_release(enum iob_user_e user)
+{
+  FAR struct iob_quota_s *quota;
+  irqstate_t flags;
+#ifdef CONFIG_IOB_NOTIFIER
+  bool atquota;
+#endif
+
+  DEBUGASSERT((unsigned int)user < IOB_NUSERS);
+  quota = &g_iob_quota[user];
+
+  flags = enter_critical_section();
+  DEBUGASSERT(quota->info.nused > 0);
+  quota->info.nused--;
+
+  if (quota->info.quota > 0)
+    {
+#ifdef CONFIG_IOB_NOTIFIER
+      atquota = (quota->sem.semcount <= 0);
+#endif
+      nxsem_post(&quota->sem);
+
+#ifdef CONFIG_IOB_NOTIFIER
+      if (atquota)
+        {
+          iob_notifier_signal_user(user);
+        }
+#endif
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: iob_quota_avail
+ *
+ * Description:
+ *   Return true if the consumer 'user' is below its quota.
+ *
+ ****************************************************************************/
+
+bool iob_quota_avail(enum iob_user_e user)
+{
+  FAR struct iob_quota_s *quota = &g_iob_quota[user];
+
+  return quota->info.quota == 0 || quota->sem.semcount > 0;
+}
+
+/****************************************************************************
+ * Name: iob_navail_user
+ *
+ * Description:
+ *   Return the number of IOBs that could be allocated (unthrottled) by the
+ *   consumer 'user':  The number of available IOBs limited by what remains
+ *   of that consumer's quota.
+ *
+ ****************************************************************************/
+
+int iob_navail_user(enum iob_user_e user)
+{
+  FAR struct iob_quota_s *quota;
+  int navail;
+  int nquota;
+
+  DEBUGASSERT((unsigned int)user < IOB_NUSERS);
+  quota  = &g_iob_quota[user];
+  navail = iob_navail(false);
+
+  if (quota->info.quota > 0)
+    {
+      nquota = quota->sem.semcount;
+      if (nquota < navail)
+        {
+          navail = nquota < 0 ? 0 : nquota;
+        }
+    }
+
+  return navail;
+}
+
+/****************************************************************************
+ * Name: iob_userinfo
+ *
+ * Description:
+ *   Return the accounting information for the consumer 'user'.  The name
+ *   of the consumer is returned if 'name' is not NULL.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if 'user' is not a valid consumer.
+ *
+ ****************************************************************************/
+
+int iob_userinfo(enum iob_user_e user, FAR struct iob_userinfo_s *info,
+                 FAR const char **name)
+{
+  irqstate_t flags;
+
+  if ((unsigned int)user >= IOB_NUSERS)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  *info = g_iob_quota[user].info;
+  leave_critical_section(flags);
+
+  if (name != NULL)
+    {
+      *name = g_iob_username[user];
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_IOB_QUOTAS */
@@ -0,0 +1,274 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The cache of the current CPU.  Interrupts must be disabled on the local
+ * CPU while the cache is used so that the thread cannot migrate and the
+ * cache cannot be modified by a preempting thread.
+ */
+
+#ifdef CONFIG_SMP
+#  define mm_cache(h) (&(h)->mm_cache[up_cpu_index()])
+#else
+#  define mm_cache(h) (&(h)->mm_cache[0])
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_push
+ *
+ * Description:
+ *   Add a list of chunks of the same size class to the cache of the
+ *   current CPU.  The caller must disable interrupts.
+ *
+ ****************************************************************************/
+
+static void mm_cache_push(FAR struct mm_cache_s *cache, int ndx,
+                          FAR struct mm_cachenode_s *head,
+                          FAR struct mm_cachenode_s *tail, int count)
+{
+  tail->flink          = cache->mc_list[ndx];
+  cache->mc_list[ndx]  = head;
+  cache->mc_count[ndx] += count;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_initialize
+ *
+ * Description:
+ *   Initialize the small allocation caches of a heap.
+ *
+ ****************************************************************************/
+
+void mm_cache_initialize(FAR struct mm_heap_s *heap)
+{
+  memset(heap->mm_cache, 0, sizeof(heap->mm_cache));
+}
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Allocate a chunk of exactly 'alignsize' bytes (including the chunk
+ *   header) from the cache of the current CPU.  If the cache is empty,
+ *   refill it with up to CONFIG_MM_CACHE_BATCH chunks from the heap while
+ *   holding the MM semaphore only once.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cache_s *cache;
+  FAR struct mm_cachenode_s *node;
+  FAR struct mm_cachenode_s *head = NULL;
+  FAR struct mm_cachenode_s *tail = NULL;
+  FAR void *ret;
+  irqstate_t flags;
+  int ndx = MM_CACHE_NDX(alignsize);
+  int count = 0;
+
+  DEBUGASSERT(ndx >= 0 && ndx < CONFIG_MM_CACHE_NCLASSES);
+
+  /* Fast path:  Take a chunk from the cache of this CPU */
+
+  flags = up_irq_save();
+  cache = mm_cache(heap);
+  node  = cache->mc_list[ndx];
+  if (node != NULL)
+    {
+      cache->mc_list[ndx] = node->flink;
+      cache->mc_count[ndx]--;
+      up_irq_restore(flags);
+
+      return (FAR char *)node + SIZEOF_MM_ALLOCNODE;
+    }
+
+  up_irq_restore(flags);
+
+  /* The cache is empty.  Allocate one chunk for the caller and a batch of
+   * chunks for the cache.
+   */
+
+  mm_takesemaphore(heap);
+
+  ret = mm_mallocchunk(heap, alignsize);
+  while (ret != NULL && count < CONFIG_MM_CACHE_BATCH - 1)
+    {
+      FAR void *mem = mm_mallocchunk(heap, alignsize);
+      if (mem == NULL)
+        {
+          break;
+        }
+
+      node = (FAR struct mm_cachenode_s *)
+        ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+      /* mm_mallocchunk() may carry a few wasted bytes at the end of the
+       * chunk.  Such a chunk does not belong to this size class.
+       */
+
+      if (node->hdr.size != alignsize)
+        {
+          mm_freechunk(heap, (FAR struct mm_freenode_s *)node);
+          break;
+        }
+
+      node->flink = head;
+      head        = node;
+      if (tail == NULL)
+        {
+          tail = node;
+        }
+
+      count++;
+    }
+
+  mm_givesemaphore(heap);
+
+  /* Add the batch to the cache of the CPU that we are running on now */
+
+  if (head != NULL)
+    {
+      flags = up_irq_save();
+      mm_cache_push(mm_cache(heap), ndx, head, tail, count);
+      up_irq_restore(flags);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Return a small chunk to the cache of the current CPU.  If that size
+ *   class then holds more than CONFIG_MM_CACHE_DEPTH chunks, half of them
+ *   are returned to the heap while holding the MM semaphore only once.
+ *
+ * Returned Value:
+ *   true if the chunk was taken by the cache; false if the chunk is too
+ *   large for the cache and must be freed to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap,
+                   FAR struct mm_allocnode_s *node)
+{
+  FAR struct mm_cachenode_s *cnode = (FAR struct mm_cachenode_s *)node;
+  FAR struct mm_cachenode_s *drain = NULL;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  int ndx;
+
+  /* Sanity check against double-frees.  The chunk header is still ours. */
+
+  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
+
+  if (node->size > MM_CACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  ndx = MM_CACHE_NDX(node->size);
+
+  flags = up_irq_save();
+  cache = mm_cache(heap);
+  mm_cache_push(cache, ndx, cnode, cnode, 1);
+
+  if (cache->mc_count[ndx] > CONFIG_MM_CACHE_DEPTH)
+    {
+      FAR struct mm_cachenode_s *last;
+      int i;
+
+      /* Detach the oldest half of the list */
+
+      for (i = 1, last = cache->mc_list[ndx];
+           i < CONFIG_MM_CACHE_DEPTH / 2;
+           i++, last = last->flink);
+
+      drain       = last->flink;
+      last->flink = NULL;
+      cache->mc_count[ndx] = CONFIG_MM_CACHE_DEPTH / 2;
+    }
+
+  up_irq_restore(flags);
+
+  /* Return the drained chunks to the heap */
+
+  if (drain != NULL)
+    {
+      mm_takesemaphore(heap);
+
+      while (drain != NULL)
+        {
+          cnode = drain;
+          drain = drain->flink;
+          mm_freechunk(heap, (FAR struct mm_freenode_s *)cnode);
+        }
+
+      mm_givesemaphore(heap);
+    }
+
+  return true;
+}
+
+#endif /* CONFIG_MM_CACHE */
@@ -117,6 +117,15 @@ void mm_extend(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
   newnode->preceding = oldnode->size | MM_ALLOC_BIT;
 
   heap->mm_heapend[region] = newnode;
+
+#ifdef CONFIG_MM_HEAPSTAT
+  /* The old terminal node becomes an ordinary allocated chunk.  Account
+   * for it so that the mm_free() below is balanced.
+   */
+
+  mm_heapstat_alloc(heap, oldnode);
+#endif
+
   mm_givesemaphore(heap);
 
   /* Finally "free" the new block of memory where the old terminal node was
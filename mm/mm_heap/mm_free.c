@@ -49,43 +49,30 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_free
+ * Name: mm_freechunk
  *
  * Description:
- *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   Return the allocated chunk 'node' to the nodelist, merging it with
+ *   its free neighbors.
+ *
+ * Assumptions:
+ *   The caller holds the MM semaphore.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 {
-  FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
   FAR struct mm_freenode_s *next;
 
-  minfo("Freeing %p\n", mem);
-
-  /* Protect against attempts to free a NULL reference */
-
-  if (!mem)
-    {
-      return;
-    }
-
-  /* We need to hold the MM semaphore while we muck with the
-   * nodelist.
-   */
-
-  mm_takesemaphore(heap);
-
-  /* Map the memory chunk into a free node */
-
-  node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
-
   /* Sanity check against double-frees */
 
   DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
 
+#ifdef CONFIG_MM_HEAPSTAT
+  mm_heapstat_free(heap, (FAR struct mm_allocnode_s *)node);
+#endif
+
   node->preceding &= ~MM_ALLOC_BIT;
 
   /* Check if the following node is free and, if so, merge it */
@@ -103,16 +90,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
       andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -129,16 +109,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -150,5 +123,49 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_freenode_s *node;
+
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+  /* Map the memory chunk into a free node */
+
+  node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+#ifdef CONFIG_MM_CACHE
+  /* Small chunks go to the cache of this CPU */
+
+  if (mm_cache_free(heap, (FAR struct mm_allocnode_s *)node))
+    {
+      return;
+    }
+#endif
+
+  /* We need to hold the MM semaphore while we muck with the
+   * nodelist.
+   */
+
+  mm_takesemaphore(heap);
+  mm_freechunk(heap, node);
   mm_givesemaphore(heap);
 }
+
@@ -0,0 +1,308 @@
+/****************************************************************************
+ * mm/mm_heap/mm_heapstat.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_HEAPSTAT
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The per-PID slots are selected like the entries of the PID hash table */
+
+#define HEAPSTAT_SLOT(p)  ((p) & (CONFIG_MAX_TASKS - 1))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_heapstat_log2
+ *
+ * Description:
+ *   Return the position of the most significant bit of 'value'.
+ *
+ ****************************************************************************/
+
+static int mm_heapstat_log2(size_t value)
+{
+  int log2 = 0;
+
+  while (value > 1)
+    {
+      value >>= 1;
+      log2++;
+    }
+
+  return log2;
+}
+
+/****************************************************************************
+ * Name: mm_heapstat_slot
+ *
+ * Description:
+ *   Return the statistics of the owner of 'node' or NULL if the owner is
+ *   unknown or its slot was taken over by another PID.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_pidstat_s *
+mm_heapstat_slot(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+  FAR struct mm_pidstat_s *slot;
+
+  if (node->pid == MM_HEAPSTAT_NOPID)
+    {
+      return NULL;
+    }
+
+  slot = &heap->mm_pidstat[HEAPSTAT_SLOT(node->pid)];
+  return (mmsize_t)slot->ps_pid == node->pid ? slot : NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_heapstat_alloc
+ *
+ * Description:
+ *   Account for a newly allocated chunk.  The chunk is owned by the holder
+ *   of the MM semaphore.
+ *
+ * Assumptions:
+ *   The caller holds the MM semaphore.
+ *
+ ****************************************************************************/
+
+void mm_heapstat_alloc(FAR struct mm_heap_s *heap,
+                       FAR struct mm_allocnode_s *node)
+{
+  FAR struct mm_pidstat_s *slot;
+  pid_t pid = heap->mm_holder;
+  int ndx;
+
+  heap->mm_stat.hs_nalloc++;
+
+  ndx = mm_heapstat_log2(node->size) - MM_MIN_SHIFT;
+  if (ndx < 0)
+    {
+      ndx = 0;
+    }
+  else if (ndx >= MM_NNODES)
+    {
+      ndx = MM_NNODES - 1;
+    }
+
+  heap->mm_stat.hs_size[ndx]++;
+
+  /* The holder may be invalid during context switches (see mm_sem.c) */
+
+  if (pid < 0)
+    {
+      node->pid = MM_HEAPSTAT_NOPID;
+      return;
+    }
+
+  /* Take over the slot if it still holds the statistics of an older PID */
+
+  slot = &heap->mm_pidstat[HEAPSTAT_SLOT(pid)];
+  if (slot->ps_pid != pid)
+    {
+      memset(slot, 0, sizeof(struct mm_pidstat_s));
+      slot->ps_pid = pid;
+    }
+
+  node->pid = (mmsize_t)pid;
+
+  slot->ps_nalloc++;
+  slot->ps_used += node->size;
+  if (slot->ps_used > slot->ps_peak)
+    {
+      slot->ps_peak = slot->ps_used;
+    }
+}
+
+/****************************************************************************
+ * Name: mm_heapstat_free
+ *
+ * Description:
+ *   Account for an allocated chunk that is about to be freed.
+ *
+ * Assumptions:
+ *   The caller holds the MM semaphore.
+ *
+ ****************************************************************************/
+
+void mm_heapstat_free(FAR struct mm_heap_s *heap,
+                      FAR struct mm_allocnode_s *node)
+{
+  FAR struct mm_pidstat_s *slot;
+
+  heap->mm_stat.hs_nfree++;
+
+  slot = mm_heapstat_slot(heap, node);
+  if (slot != NULL)
+    {
+      DEBUGASSERT(slot->ps_used >= node->size);
+      slot->ps_nfree++;
+      slot->ps_used -= node->size;
+    }
+}
+
+/****************************************************************************
+ * Name: mm_heapstat_resize
+ *
+ * Description:
+ *   Account for an allocated chunk whose size changed from 'oldsize' to
+ *   node->size.  The owner of the chunk is unchanged.
+ *
+ * Assumptions:
+ *   The caller holds the MM semaphore.
+ *
+ ****************************************************************************/
+
+void mm_heapstat_resize(FAR struct mm_heap_s *heap,
+                        FAR struct mm_allocnode_s *node, size_t oldsize)
+{
+  FAR struct mm_pidstat_s *slot;
+
+  slot = mm_heapstat_slot(heap, node);
+  if (slot != NULL)
+    {
+      DEBUGASSERT(slot->ps_used >= oldsize);
+      slot->ps_used = slot->ps_used - oldsize + node->size;
+      if (slot->ps_used > slot->ps_peak)
+        {
+          slot->ps_peak = slot->ps_used;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_heapstat_latency
+ *
+ * Description:
+ *   Add the duration of one mm_malloc() call (in up_critmon_gettime()
+ *   units) to the latency histogram.
+ *
+ * Assumptions:
+ *   The caller holds the MM semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+void mm_heapstat_latency(FAR struct mm_heap_s *heap, uint32_t elapsed)
+{
+  int ndx = mm_heapstat_log2(elapsed);
+
+  if (ndx >= MM_HEAPSTAT_NLATENCY)
+    {
+      ndx = MM_HEAPSTAT_NLATENCY - 1;
+    }
+
+  heap->mm_stat.hs_latency[ndx]++;
+  if (elapsed > heap->mm_stat.hs_maxlatency)
+    {
+      heap->mm_stat.hs_maxlatency = elapsed;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: mm_heapstat
+ *
+ * Description:
+ *   Return a copy of the heap-wide allocation statistics.
+ *
+ ****************************************************************************/
+
+int mm_heapstat(FAR struct mm_heap_s *heap, FAR struct mm_heapstat_s *stat)
+{
+  DEBUGASSERT(stat != NULL);
+
+  mm_takesemaphore(heap);
+  memcpy(stat, &heap->mm_stat, sizeof(struct mm_heapstat_s));
+  mm_givesemaphore(heap);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mm_pidstat
+ *
+ * Description:
+ *   Return a copy of the allocation statistics of 'pid'.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if nothing was allocated by 'pid' since its slot
+ *   was last reused.
+ *
+ ****************************************************************************/
+
+int mm_pidstat(FAR struct mm_heap_s *heap, pid_t pid,
+               FAR struct mm_pidstat_s *stat)
+{
+  FAR struct mm_pidstat_s *slot;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(stat != NULL && pid >= 0);
+
+  mm_takesemaphore(heap);
+
+  slot = &heap->mm_pidstat[HEAPSTAT_SLOT(pid)];
+  if (slot->ps_pid == pid)
+    {
+      memcpy(stat, slot, sizeof(struct mm_pidstat_s));
+      ret = OK;
+    }
+
+  mm_givesemaphore(heap);
+  return ret;
+}
+
+#endif /* CONFIG_MM_HEAPSTAT */
@@ -155,7 +155,9 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
                    size_t heapsize)
 {
+#if !defined(CONFIG_MM_TLSF) || defined(CONFIG_MM_HEAPSTAT)
   int i;
+#endif
 
   minfo("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -177,6 +179,13 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_nregions = 0;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* Initialize the free lists and bitmaps (all empty) */
+
+  heap->mm_flbitmap = 0;
+  memset(heap->mm_slbitmap, 0, sizeof(heap->mm_slbitmap));
+  memset(heap->mm_freelist, 0, sizeof(heap->mm_freelist));
+#else
   /* Initialize the node array */
 
   memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
@@ -185,6 +194,7 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
       heap->mm_nodelist[i-1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink   = &heap->mm_nodelist[i-1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
@@ -192,6 +202,23 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   mm_seminitialize(heap);
 
+#ifdef CONFIG_MM_CACHE
+  /* Initialize the small allocation caches (all empty) */
+
+  mm_cache_initialize(heap);
+#endif
+
+#ifdef CONFIG_MM_HEAPSTAT
+  /* Clear the allocation statistics.  No PID owns a slot yet. */
+
+  memset(&heap->mm_stat, 0, sizeof(struct mm_heapstat_s));
+  memset(heap->mm_pidstat, 0, sizeof(heap->mm_pidstat));
+  for (i = 0; i < CONFIG_MAX_TASKS; i++)
+    {
+      heap->mm_pidstat[i].ps_pid = -1;
+    }
+#endif
+
   /* Add the initial region of memory to the heap */
 
   mm_addregion(heap, heapstart, heapsize);
@@ -46,6 +46,10 @@
 
 #include <nuttx/mm/mm.h>
 
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+#  include <nuttx/arch.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -59,86 +63,35 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_mallocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
+ *  Find the smallest chunk of at least 'alignsize' bytes (including the
+ *  chunk header).  Take the memory from that chunk, save the remaining,
+ *  smaller chunk (if any).
  *
- *  8-byte alignment of the allocated data is assured.
+ * Assumptions:
+ *  The caller holds the MM semaphore.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+FAR void *mm_mallocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
   void *ret = NULL;
-  int ndx;
-
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
-   */
-
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
 
-  mm_takesemaphore(heap);
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
-
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES-1;
-    }
-  else
-    {
-      /* Convert the request size into a nodelist index */
-
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink);
-
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
-   */
+  /* Find a large enough chunk in the free lists */
 
+  node = mm_findfreechunk(heap, alignsize);
   if (node)
     {
       FAR struct mm_freenode_s *remainder;
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -181,9 +134,83 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
       node->preceding |= MM_ALLOC_BIT;
       ret = (void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+
+#ifdef CONFIG_MM_HEAPSTAT
+      mm_heapstat_alloc(heap, (FAR struct mm_allocnode_s *)node);
+#endif
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+  uint32_t start;
+#endif
+  size_t alignsize;
+  void *ret = NULL;
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
     }
 
-  mm_givesemaphore(heap);
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+  /* The latency includes the time waiting for the MM semaphore */
+
+  start = up_critmon_gettime();
+#endif
+
+#ifdef CONFIG_MM_CACHE
+  /* Try the small allocation cache of this CPU first */
+
+  if (alignsize <= MM_CACHE_MAXCHUNK)
+    {
+      ret = mm_cache_alloc(heap, alignsize);
+    }
+  else
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the
+       * nodelist.
+       */
+
+      mm_takesemaphore(heap);
+      ret = mm_mallocchunk(heap, alignsize);
+
+#ifdef CONFIG_MM_HEAPSTAT
+      if (ret == NULL)
+        {
+          heap->mm_stat.hs_nfail++;
+        }
+#endif
+#ifdef CONFIG_MM_HEAPSTAT_LATENCY
+      mm_heapstat_latency(heap, up_critmon_gettime() - start);
+#endif
+
+      mm_givesemaphore(heap);
+    }
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
@@ -163,6 +163,13 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       newnode->size = (size_t)next - (size_t)newnode;
       newnode->preceding = precedingsize | MM_ALLOC_BIT;
 
+#ifdef CONFIG_MM_HEAPSTAT
+      /* The new node keeps the owner of the original chunk */
+
+      newnode->pid = node->pid;
+      mm_heapstat_resize(heap, newnode, node->size);
+#endif
+
       /* Reduce the size of the original chunk and mark it not allocated, */
 
       node->size = precedingsize;
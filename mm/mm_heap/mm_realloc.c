@@ -158,6 +158,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
       size_t needed   = newsize - oldsize;
       size_t takeprev = 0;
       size_t takenext = 0;
+#ifdef CONFIG_MM_HEAPSTAT
+      size_t origsize = oldsize;
+#endif
 
       /* Check if we can extend into the previous chunk and if the
        * previous chunk is smaller than the next chunk.
@@ -220,20 +223,16 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           FAR struct mm_allocnode_s *newnode;
 
-          /* Remove the previous node.  There must be a predecessor, but
-           * there may not be a successor node.
-           */
+          /* Remove the previous node from the free list */
 
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          mm_delfreechunk(heap, prev);
 
           /* Extend the node into the previous free chunk */
 
           newnode = (FAR struct mm_allocnode_s *)((FAR char *)oldnode - takeprev);
+#ifdef CONFIG_MM_HEAPSTAT
+          newnode->pid = oldnode->pid;
+#endif
 
           /* Did we consume the entire preceding chunk? */
 
@@ -287,16 +286,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
           andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + nextsize);
 
-          /* Remove the next node.  There must be a predecessor, but there
-           * may not be a successor node.
-           */
+          /* Remove the next node from the free list */
 
-          DEBUGASSERT(next->blink);
-          next->blink->flink = next->flink;
-          if (next->flink)
-            {
-              next->flink->blink = next->blink;
-            }
+          mm_delfreechunk(heap, next);
 
           /* Extend the node into the next chunk */
 
@@ -327,6 +319,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
             }
         }
 
+#ifdef CONFIG_MM_HEAPSTAT
+      mm_heapstat_resize(heap, oldnode, origsize);
+#endif
+
       mm_givesemaphore(heap);
       return newmem;
     }
@@ -66,6 +66,9 @@ void  mm_shrinkchunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_allocnode_s *node, size_t size)
 {
   FAR struct mm_freenode_s *next;
+#ifdef CONFIG_MM_HEAPSTAT
+  size_t oldsize = node->size;
+#endif
 
   DEBUGASSERT((size & MM_GRAN_MASK) == 0);
 
@@ -84,16 +87,9 @@ void  mm_shrinkchunk(FAR struct mm_heap_s *heap,
 
       andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the next node from the free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Create a new chunk that will hold both the next chunk and the
        * tailing memory from the aligned chunk.
@@ -138,4 +134,11 @@ void  mm_shrinkchunk(FAR struct mm_heap_s *heap,
 
       mm_addfreechunk(heap, newnode);
     }
+
+#ifdef CONFIG_MM_HEAPSTAT
+  if (node->size != oldsize)
+    {
+      mm_heapstat_resize(heap, node, oldsize);
+    }
+#endif
 }
@@ -0,0 +1,223 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_mapping
+ *
+ * Description:
+ *   Map a chunk size to its first and second level free list indices.  All
+ *   chunks of MM_MAX_CHUNK bytes or more share the first list of the last
+ *   first level.  Free chunks smaller than MM_MIN_CHUNK (these may be left
+ *   over by mm_memalign()) go to the very first list.
+ *
+ ****************************************************************************/
+
+static inline void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  int msb;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      *fl = MM_NNODES - 1;
+      *sl = 0;
+    }
+  else if (size < MM_MIN_CHUNK)
+    {
+      *fl = 0;
+      *sl = 0;
+    }
+  else
+    {
+      msb = fls((int)size) - 1;
+      *fl = msb - MM_MIN_SHIFT;
+      *sl = (int)(size >> (msb - MM_TLSF_SLSHIFT)) & MM_TLSF_SLMASK;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of its free list.  It is assumed that the
+ *   caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *head;
+  int fl;
+  int sl;
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  head        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = head;
+
+  if (head)
+    {
+      head->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_slbitmap[fl]    |= (1 << sl);
+  heap->mm_flbitmap        |= (1 << fl);
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its free list.  The chunk size must not have
+ *   been modified since the chunk was added.  It is assumed that the
+ *   caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+      heap->mm_freelist[fl][sl] = node->flink;
+    }
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  /* Clear the bitmap bits if the list is now empty */
+
+  if (heap->mm_freelist[fl][sl] == NULL)
+    {
+      heap->mm_slbitmap[fl] &= ~(1 << sl);
+      if (heap->mm_slbitmap[fl] == 0)
+        {
+          heap->mm_flbitmap &= ~(1 << fl);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes.  The request is rounded up
+ *   to the next second level boundary so that any chunk on the first non-
+ *   empty list found in the bitmaps is large enough.  This is a good fit,
+ *   not necessarily the best fit, but takes constant time.  Only the lists
+ *   of the largest and of the smallest chunks may need to be searched.
+ *
+ *   The chunk is not removed from its free list.  It is assumed that the
+ *   caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  uint32_t bitmap;
+  size_t roundsize = size;
+  int fl;
+  int sl;
+
+  if (size < MM_MAX_CHUNK)
+    {
+      roundsize += (1 << (fls((int)size) - 1 - MM_TLSF_SLSHIFT)) - 1;
+    }
+
+  mm_tlsf_mapping(roundsize, &fl, &sl);
+
+  /* Look for a non-empty list on the same first level ... */
+
+  bitmap = heap->mm_slbitmap[fl] & (~(uint32_t)0 << sl);
+  if (bitmap == 0)
+    {
+      /* ... otherwise on the next non-empty first level */
+
+      bitmap = heap->mm_flbitmap & (~(uint32_t)0 << (fl + 1));
+      if (bitmap == 0)
+        {
+          return NULL;
+        }
+
+      fl     = ffs((int)bitmap) - 1;
+      bitmap = heap->mm_slbitmap[fl];
+    }
+
+  sl = ffs((int)bitmap) - 1;
+
+  /* Every chunk on the list is large enough, except on the lists of the
+   * largest and of the smallest chunks (which are not sorted into second
+   * levels).
+   */
+
+  for (node = heap->mm_freelist[fl][sl];
+       node && node->size < size;
+       node = node->flink);
+
+  return node;
+}
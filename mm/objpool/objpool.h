@@ -0,0 +1,78 @@
+/****************************************************************************
+ * mm/objpool/objpool.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MM_OBJPOOL_OBJPOOL_H
+#define __MM_OBJPOOL_OBJPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/mm/objpool.h>
+
+#ifdef CONFIG_MM_OBJPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The smallest granule used for pool memory.  Objects are aligned to the
+ * granule size so this must provide the strictest alignment of any type.
+ */
+
+#define OBJPOOL_MIN_LOG2GRAN  3
+
+/* The number of objects moved between a magazine and the shared free list
+ * at a time.
+ */
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+#  define OBJPOOL_MAGBATCH    ((CONFIG_MM_OBJPOOL_MAGSIZE + 1) / 2)
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* A singly linked list of all object pools (for objpool_foreach()).  It is
+ * protected by a critical section.
+ */
+
+extern FAR struct objpool_s *g_objpools;
+
+#endif /* CONFIG_MM_OBJPOOL */
+#endif /* __MM_OBJPOOL_OBJPOOL_H */
@@ -0,0 +1,224 @@
+/****************************************************************************
+ * mm/objpool/objpool_alloc.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/gran.h>
+#include <nuttx/mm/objpool.h>
+
+#include "objpool/objpool.h"
+
+#ifdef CONFIG_MM_OBJPOOL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objpool_carve
+ *
+ * Description:
+ *   Take a new object from the granule allocator of the pool memory.
+ *
+ ****************************************************************************/
+
+static FAR void *objpool_carve(FAR struct objpool_s *pool)
+{
+  FAR void *obj = NULL;
+  irqstate_t flags;
+
+#ifndef CONFIG_GRAN_INTR
+  /* The granule allocator may not be used from interrupt handlers */
+
+  if (!up_interrupt_context())
+#endif
+    {
+      obj = gran_alloc(pool->op_gran, pool->op_objsize);
+    }
+
+  flags = enter_critical_section();
+  if (obj != NULL)
+    {
+      pool->op_ncarved++;
+      pool->op_nalloc++;
+    }
+  else
+    {
+      pool->op_nfail++;
+    }
+
+  leave_critical_section(flags);
+  return obj;
+}
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+/****************************************************************************
+ * Name: objpool_refill
+ *
+ * Description:
+ *   Move up to OBJPOOL_MAGBATCH objects from the shared free list to an
+ *   empty magazine
+ *
+ * Assumptions:
+ *   Interrupts are disabled on the local CPU
+ *
+ ****************************************************************************/
+
+static void objpool_refill(FAR struct objpool_s *pool,
+                           FAR struct objpool_mag_s *mag)
+{
+  FAR sq_entry_t *obj;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < OBJPOOL_MAGBATCH; i++)
+    {
+      obj = sq_remfirst(&pool->op_free);
+      if (obj == NULL)
+        {
+          break;
+        }
+
+      sq_addfirst(obj, &mag->om_free);
+      mag->om_count++;
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objpool_alloc
+ *
+ * Description:
+ *   Allocate one object from the pool.  Free objects are taken from the
+ *   magazine of this CPU (if any), then from the shared free list.  Only
+ *   if both are empty is a new object taken from the pool memory.
+ *
+ * Input Parameters:
+ *   pool - The pool previously returned by objpool_create()
+ *
+ * Returned Value:
+ *   A pointer to the object; NULL if the pool is exhausted.
+ *
+ ****************************************************************************/
+
+FAR void *objpool_alloc(FAR struct objpool_s *pool)
+{
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  FAR struct objpool_mag_s *mag;
+#endif
+  FAR sq_entry_t *obj;
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL);
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  /* Disabling local interrupts keeps us on this CPU and protects its
+   * magazine.
+   */
+
+  flags = up_irq_save();
+  mag   = &pool->op_mag[up_cpu_index()];
+
+  if (mag->om_count == 0)
+    {
+      objpool_refill(pool, mag);
+    }
+
+  obj = sq_remfirst(&mag->om_free);
+  if (obj != NULL)
+    {
+      mag->om_count--;
+      mag->om_nalloc++;
+    }
+
+  up_irq_restore(flags);
+#else
+  flags = enter_critical_section();
+
+  obj = sq_remfirst(&pool->op_free);
+  if (obj != NULL)
+    {
+      pool->op_nalloc++;
+    }
+
+  leave_critical_section(flags);
+#endif
+
+  if (obj == NULL)
+    {
+      obj = (FAR sq_entry_t *)objpool_carve(pool);
+    }
+
+  return obj;
+}
+
+/****************************************************************************
+ * Name: objpool_zalloc
+ *
+ * Description:
+ *   Allocate one object from the pool and clear it.
+ *
+ ****************************************************************************/
+
+FAR void *objpool_zalloc(FAR struct objpool_s *pool)
+{
+  FAR void *obj = objpool_alloc(pool);
+
+  if (obj != NULL)
+    {
+      memset(obj, 0, pool->op_objsize);
+    }
+
+  return obj;
+}
+
+#endif /* CONFIG_MM_OBJPOOL */
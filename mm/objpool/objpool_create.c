@@ -0,0 +1,231 @@
+/****************************************************************************
+ * mm/objpool/objpool_create.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/gran.h>
+#include <nuttx/mm/objpool.h>
+
+#include "objpool/objpool.h"
+
+#ifdef CONFIG_MM_OBJPOOL
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+FAR struct objpool_s *g_objpools;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objpool_create
+ *
+ * Description:
+ *   Create a pool of 'nobjs' objects of 'objsize' bytes each.  The memory
+ *   of the pool is allocated once from the kernel heap and is then managed
+ *   by a granule allocator; allocating or freeing objects never touches
+ *   the heap again.
+ *
+ * Input Parameters:
+ *   name    - Name of the pool.  The string must persist for the life of
+ *             the pool.
+ *   objsize - Size of one object in bytes
+ *   nobjs   - The number of objects in the pool
+ *
+ * Returned Value:
+ *   On success, a reference to the new pool is returned; NULL is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+FAR struct objpool_s *objpool_create(FAR const char *name, size_t objsize,
+                                     unsigned int nobjs)
+{
+  FAR struct objpool_s *pool;
+  irqstate_t flags;
+  size_t heapsize;
+  uint8_t log2gran;
+
+  DEBUGASSERT(objsize > 0 && nobjs > 0 && nobjs <= UINT16_MAX);
+
+  /* Free objects are linked through their first bytes */
+
+  if (objsize < sizeof(sq_entry_t))
+    {
+      objsize = sizeof(sq_entry_t);
+    }
+
+  /* Select the smallest granule size that can hold an object in no more
+   * than 32 granules (the limit of gran_alloc()).  Then round the object
+   * size up to whole granules.
+   */
+
+  log2gran = OBJPOOL_MIN_LOG2GRAN;
+  while (objsize > ((size_t)32 << log2gran))
+    {
+      log2gran++;
+    }
+
+  objsize = (objsize + (1 << log2gran) - 1) & ~((1 << log2gran) - 1);
+
+  /* The pool memory must hold all objects after alignment to the granule
+   * size.
+   */
+
+  heapsize = objsize * nobjs + (1 << log2gran) - 1;
+
+  pool = (FAR struct objpool_s *)kmm_zalloc(sizeof(struct objpool_s));
+  if (pool == NULL)
+    {
+      merr("ERROR: Failed to allocate pool '%s'\n", name);
+      return NULL;
+    }
+
+  pool->op_start = (FAR uint8_t *)kmm_malloc(heapsize);
+  if (pool->op_start == NULL)
+    {
+      merr("ERROR: Failed to allocate %lu bytes for pool '%s'\n",
+           (unsigned long)heapsize, name);
+      goto errout_with_pool;
+    }
+
+  pool->op_gran = gran_initialize(pool->op_start, heapsize, log2gran,
+                                  log2gran);
+  if (pool->op_gran == NULL)
+    {
+      goto errout_with_memory;
+    }
+
+  pool->op_end     = pool->op_start + heapsize;
+  pool->op_name    = name;
+  pool->op_objsize = objsize;
+  pool->op_nobjs   = (uint16_t)nobjs;
+  sq_init(&pool->op_free);
+
+  /* Add the pool to the list of all pools */
+
+  flags          = enter_critical_section();
+  pool->op_flink = g_objpools;
+  g_objpools     = pool;
+  leave_critical_section(flags);
+
+  return pool;
+
+errout_with_memory:
+  kmm_free(pool->op_start);
+
+errout_with_pool:
+  kmm_free(pool);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: objpool_destroy
+ *
+ * Description:
+ *   Destroy a pool and release its memory.  All objects must have been
+ *   freed.
+ *
+ * Input Parameters:
+ *   pool - The pool previously returned by objpool_create()
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBUSY if objects of the pool are still in use.
+ *
+ ****************************************************************************/
+
+int objpool_destroy(FAR struct objpool_s *pool)
+{
+  FAR struct objpool_s *prev;
+  struct objpool_info_s info;
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL);
+
+  flags = enter_critical_section();
+
+  objpool_info(pool, &info);
+  if (info.nused > 0)
+    {
+      leave_critical_section(flags);
+      return -EBUSY;
+    }
+
+  /* Remove the pool from the list of all pools */
+
+  if (g_objpools == pool)
+    {
+      g_objpools = pool->op_flink;
+    }
+  else
+    {
+      for (prev = g_objpools;
+           prev != NULL && prev->op_flink != pool;
+           prev = prev->op_flink);
+
+      DEBUGASSERT(prev != NULL);
+      if (prev != NULL)
+        {
+          prev->op_flink = pool->op_flink;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  /* The objects were never returned to the granule allocator.  Just
+   * release it together with the pool memory.
+   */
+
+  gran_release(pool->op_gran);
+  kmm_free(pool->op_start);
+  kmm_free(pool);
+  return OK;
+}
+
+#endif /* CONFIG_MM_OBJPOOL */
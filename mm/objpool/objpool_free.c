@@ -0,0 +1,159 @@
+/****************************************************************************
+ * mm/objpool/objpool_free.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/objpool.h>
+
+#include "objpool/objpool.h"
+
+#ifdef CONFIG_MM_OBJPOOL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+/****************************************************************************
+ * Name: objpool_drain
+ *
+ * Description:
+ *   Move OBJPOOL_MAGBATCH objects from a full magazine to the shared free
+ *   list.
+ *
+ * Assumptions:
+ *   Interrupts are disabled on the local CPU
+ *
+ ****************************************************************************/
+
+static void objpool_drain(FAR struct objpool_s *pool,
+                          FAR struct objpool_mag_s *mag)
+{
+  FAR sq_entry_t *obj;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < OBJPOOL_MAGBATCH; i++)
+    {
+      obj = sq_remfirst(&mag->om_free);
+      DEBUGASSERT(obj != NULL);
+
+      mag->om_count--;
+      sq_addfirst(obj, &pool->op_free);
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objpool_free
+ *
+ * Description:
+ *   Return an object to the pool.  The object is put on the magazine of
+ *   this CPU (if any) or on the shared free list.
+ *
+ * Input Parameters:
+ *   pool - The pool previously returned by objpool_create()
+ *   obj  - An object previously allocated from the same pool
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void objpool_free(FAR struct objpool_s *pool, FAR void *obj)
+{
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  FAR struct objpool_mag_s *mag;
+#endif
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && objpool_member(pool, obj));
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  flags = up_irq_save();
+  mag   = &pool->op_mag[up_cpu_index()];
+
+  if (mag->om_count >= CONFIG_MM_OBJPOOL_MAGSIZE)
+    {
+      objpool_drain(pool, mag);
+    }
+
+  sq_addfirst((FAR sq_entry_t *)obj, &mag->om_free);
+  mag->om_count++;
+  mag->om_nfree++;
+
+  up_irq_restore(flags);
+#else
+  flags = enter_critical_section();
+
+  sq_addfirst((FAR sq_entry_t *)obj, &pool->op_free);
+  pool->op_nrelease++;
+
+  leave_critical_section(flags);
+#endif
+}
+
+/****************************************************************************
+ * Name: objpool_member
+ *
+ * Description:
+ *   Return true if 'obj' lies in the memory of the pool.
+ *
+ ****************************************************************************/
+
+bool objpool_member(FAR struct objpool_s *pool, FAR const void *obj)
+{
+  return (FAR const uint8_t *)obj >= pool->op_start &&
+         (FAR const uint8_t *)obj <  pool->op_end;
+}
+
+#endif /* CONFIG_MM_OBJPOOL */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * mm/objpool/objpool_info.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/objpool.h>
+
+#include "objpool/objpool.h"
+
+#ifdef CONFIG_MM_OBJPOOL
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objpool_info
+ *
+ * Description:
+ *   Return information about the pool.
+ *
+ ****************************************************************************/
+
+void objpool_info(FAR struct objpool_s *pool,
+                  FAR struct objpool_info_s *info)
+{
+  irqstate_t flags;
+  uint32_t nalloc;
+  uint32_t nfree;
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  int i;
+#endif
+
+  DEBUGASSERT(pool != NULL && info != NULL);
+
+  flags  = enter_critical_section();
+
+  nalloc = pool->op_nalloc;
+  nfree  = pool->op_nrelease;
+
+#ifdef CONFIG_MM_OBJPOOL_MAGAZINE
+  for (i = 0; i < OBJPOOL_NMAGAZINES; i++)
+    {
+      nalloc += pool->op_mag[i].om_nalloc;
+      nfree  += pool->op_mag[i].om_nfree;
+    }
+#endif
+
+  info->name    = pool->op_name;
+  info->objsize = pool->op_objsize;
+  info->nobjs   = pool->op_nobjs;
+  info->nused   = (uint16_t)(nalloc - nfree);
+  info->npeak   = pool->op_ncarved;
+  info->nalloc  = nalloc;
+  info->nfail   = pool->op_nfail;
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: objpool_foreach
+ *
+ * Description:
+ *   Call 'handler' with the information of every pool in the system.
+ *
+ ****************************************************************************/
+
+void objpool_foreach(objpool_handler_t handler, FAR void *arg)
+{
+  FAR struct objpool_s *pool;
+  struct objpool_info_s info;
+  irqstate_t flags;
+
+  /* The list of pools is protected by a critical section.  The handler
+   * must not block.
+   */
+
+  flags = enter_critical_section();
+  for (pool = g_objpools; pool != NULL; pool = pool->op_flink)
+    {
+      objpool_info(pool, &info);
+      handler(&info, arg);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_MM_OBJPOOL */
@@ -326,6 +326,53 @@ void arp_notify(in_addr_t ipaddr);
 #  define arp_notify(i)
 #endif
 
+/****************************************************************************
+ * Name: arp_hold
+ *
+ * Description:
+ *   Save a copy of the outgoing IPv4 packet in d_buf before arp_out()
+ *   overwrites it with an ARP request.
+ *
+ * Input Parameters:
+ *   dev    - The device that will send the packet
+ *   ipaddr - The IPv4 address being resolved (the next hop)
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_HOLD
+void arp_hold(FAR struct net_driver_s *dev, in_addr_t ipaddr);
+#else
+#  define arp_hold(d,i)
+#endif
+
+/****************************************************************************
+ * Name: arp_hold_flush
+ *
+ * Description:
+ *   Called from arp_arpin() when an ARP reply has been processed.  If a
+ *   packet is held for the resolved address, it is placed in d_buf with
+ *   an Ethernet header and d_len is set so that the driver will send it.
+ *
+ * Input Parameters:
+ *   dev     - The device that received the ARP reply
+ *   ipaddr  - The IPv4 address that was resolved
+ *   ethaddr - The resolved MAC address (may refer to d_buf)
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_HOLD
+void arp_hold_flush(FAR struct net_driver_s *dev, in_addr_t ipaddr,
+                    FAR const uint8_t *ethaddr);
+#else
+#  define arp_hold_flush(d,i,e)
+#endif
+
 /****************************************************************************
  * Name: arp_lookup
  *
@@ -456,6 +503,8 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_wait_cancel(n) (0)
 #  define arp_wait(n,t) (0)
 #  define arp_notify(i)
+#  define arp_hold(d,i)
+#  define arp_hold_flush(d,i,e)
 #  define arp_find(i,e) (-ENOSYS)
 #  define arp_delete(i)
 #  define arp_update(i,m);
@@ -83,7 +83,8 @@
  *   the packet is set in the d_len field.
  *
  *   When the function returns, the value of the field d_len indicates
- *   whether the device driver should send out the ARP reply packet or not.
+ *   whether the device driver should send out the ARP reply packet (or,
+ *   after an ARP reply, a packet held waiting for it) or not.
  *   If d_len is zero, no packet should be sent; If d_len is non-zero, it
  *   contains the length of the outbound packet that is present in the
  *   d_buf buffer.
@@ -155,6 +156,11 @@ void arp_arpin(FAR struct net_driver_s *dev)
             /* Then notify any logic waiting for the ARP result */
 
             arp_notify(net_ip4addr_conv32(arp->ah_sipaddr));
+
+            /* And send any packet that was held waiting for this reply */
+
+            arp_hold_flush(dev, net_ip4addr_conv32(arp->ah_sipaddr),
+                           arp->ah_shwaddr);
           }
         break;
     }
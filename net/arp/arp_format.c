@@ -104,6 +104,12 @@ void arp_format(FAR struct net_driver_s *dev, in_addr_t ipaddr)
 
   eth->type        = HTONS(ETHTYPE_ARP);
   dev->d_len       = sizeof(struct arp_hdr_s) + ETH_HDRLEN;
+
+#ifdef CONFIG_NETDEV_TXIOB
+  /* The ARP request replaces any packet with payload in an IOB chain */
+
+  dev->d_iob       = NULL;
+#endif
 }
 
 #endif /* CONFIG_NET_ARP */
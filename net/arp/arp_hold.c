@@ -0,0 +1,344 @@
+/****************************************************************************
+ * net/arp/arp_hold.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+#include <net/ethernet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/arp.h>
+
+#include "arp/arp.h"
+
+#ifdef CONFIG_NET_ARP_HOLD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ETHBUF  ((struct eth_hdr_s *)&dev->d_buf[0])
+
+/* A held packet is discarded if the address is not resolved within this
+ * time.  By then the higher level protocol will have retransmitted it.
+ */
+
+#define ARP_HOLD_MAXAGE_TICK SEC2TICK(1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One packet waiting for address resolution */
+
+struct arp_hold_s
+{
+  FAR struct net_driver_s *ah_dev;     /* Device that will send the packet */
+  FAR struct iob_s        *ah_iob;     /* The held IP packet */
+  in_addr_t                ah_ipaddr;  /* The address being resolved */
+  clock_t                  ah_time;    /* Time the packet was held */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Packets waiting for address resolution.  Protected by the network lock. */
+
+static struct arp_hold_s g_arp_hold[CONFIG_NET_ARP_NHOLD];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arp_hold_release
+ *
+ * Description:
+ *   Free the packet held in a slot.
+ *
+ ****************************************************************************/
+
+static void arp_hold_release(FAR struct arp_hold_s *hold)
+{
+  if (hold->ah_iob != NULL)
+    {
+      iob_free_chain(hold->ah_iob);
+      hold->ah_iob = NULL;
+    }
+
+  hold->ah_dev = NULL;
+}
+
+/****************************************************************************
+ * Name: arp_hold_copyin
+ *
+ * Description:
+ *   Copy the outgoing IPv4 packet into an I/O buffer chain.  With
+ *   scatter-gather transmit, only the headers are in d_buf and the payload
+ *   is copied from the d_iob chain.
+ *
+ ****************************************************************************/
+
+static int arp_hold_copyin(FAR struct net_driver_s *dev,
+                           FAR struct iob_s *iob)
+{
+  unsigned int hdrlen = dev->d_len;
+  int ret;
+
+#ifdef CONFIG_NETDEV_TXIOB
+  if (dev->d_iob != NULL)
+    {
+      DEBUGASSERT(dev->d_len >= dev->d_sndlen);
+      hdrlen = dev->d_len - dev->d_sndlen;
+    }
+#endif
+
+  ret = iob_trycopyin(iob, &dev->d_buf[ETH_HDRLEN], hdrlen, 0, false);
+
+#ifdef CONFIG_NETDEV_TXIOB
+  if (ret >= 0 && dev->d_iob != NULL)
+    {
+      FAR struct iob_s *src = dev->d_iob;
+      unsigned int offset = dev->d_iobofs;
+      unsigned int remaining = dev->d_sndlen;
+      unsigned int pktlen = hdrlen;
+      unsigned int seglen;
+
+      /* Append the payload, one I/O buffer of the chain at a time */
+
+      for (; src != NULL && remaining > 0 && ret >= 0; src = src->io_flink)
+        {
+          if (offset >= src->io_len)
+            {
+              offset -= src->io_len;
+              continue;
+            }
+
+          seglen = src->io_len - offset;
+          if (seglen > remaining)
+            {
+              seglen = remaining;
+            }
+
+          ret = iob_trycopyin(iob, IOB_DATA(src) + offset,
+                              seglen, pktlen, false);
+
+          pktlen    += seglen;
+          remaining -= seglen;
+          offset     = 0;
+        }
+
+      if (ret >= 0 && remaining > 0)
+        {
+          ret = -EINVAL;
+        }
+    }
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arp_hold
+ *
+ * Description:
+ *   Save a copy of the outgoing IPv4 packet in d_buf before arp_out()
+ *   overwrites it with an ARP request.  Only the most recent packet is
+ *   held for each address; older ones are dropped as they would have been
+ *   without this feature.
+ *
+ * Input Parameters:
+ *   dev    - The device that will send the packet
+ *   ipaddr - The IPv4 address being resolved (the next hop)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.  d_buf holds the IPv4 packet after space for
+ *   the Ethernet header and d_len is the length of the IPv4 packet.  With
+ *   CONFIG_NETDEV_TXIOB, the last d_sndlen bytes may instead be in d_iob.
+ *
+ ****************************************************************************/
+
+void arp_hold(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+  FAR struct arp_hold_s *hold = NULL;
+  FAR struct iob_s *iob;
+  clock_t now = clock_systimer();
+  int i;
+
+  if (dev->d_len == 0)
+    {
+      return;
+    }
+
+  /* Find the slot already used for this address, else a free slot, else
+   * the oldest slot.
+   */
+
+  for (i = 0; i < CONFIG_NET_ARP_NHOLD; i++)
+    {
+      FAR struct arp_hold_s *curr = &g_arp_hold[i];
+
+      if (curr->ah_iob != NULL && curr->ah_dev == dev &&
+          net_ipv4addr_cmp(curr->ah_ipaddr, ipaddr))
+        {
+          hold = curr;
+          break;
+        }
+
+      if (hold == NULL || (hold->ah_iob != NULL &&
+          (curr->ah_iob == NULL ||
+           (int)(curr->ah_time - hold->ah_time) < 0)))
+        {
+          hold = curr;
+        }
+    }
+
+  arp_hold_release(hold);
+
+  /* Copy the packet into an I/O buffer chain without waiting */
+
+  iob = iob_tryalloc(false);
+  if (iob == NULL)
+    {
+      ninfo("No IOB to hold packet for %08lx\n", (unsigned long)ipaddr);
+      return;
+    }
+
+  if (arp_hold_copyin(dev, iob) < 0)
+    {
+      ninfo("No IOB to hold packet for %08lx\n", (unsigned long)ipaddr);
+      iob_free_chain(iob);
+      return;
+    }
+
+  hold->ah_dev    = dev;
+  hold->ah_iob    = iob;
+  hold->ah_time   = now;
+  net_ipv4addr_copy(hold->ah_ipaddr, ipaddr);
+}
+
+/****************************************************************************
+ * Name: arp_hold_flush
+ *
+ * Description:
+ *   Called when an ARP reply has been processed.  If a packet is held for
+ *   the resolved address, it is copied into d_buf with an Ethernet header
+ *   so that the driver sends it in place of the (absent) ARP response.
+ *
+ * Input Parameters:
+ *   dev     - The device that received the ARP reply
+ *   ipaddr  - The IPv4 address that was resolved
+ *   ethaddr - The resolved MAC address (may refer to d_buf)
+ *
+ * Returned Value:
+ *   None.  On return, d_len is non-zero if d_buf holds a frame to send.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void arp_hold_flush(FAR struct net_driver_s *dev, in_addr_t ipaddr,
+                    FAR const uint8_t *ethaddr)
+{
+  FAR struct eth_hdr_s *eth = ETHBUF;
+  FAR struct arp_hold_s *hold;
+  uint8_t dest[ETHER_ADDR_LEN];
+  int len;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARP_NHOLD; i++)
+    {
+      hold = &g_arp_hold[i];
+      if (hold->ah_iob == NULL || hold->ah_dev != dev ||
+          !net_ipv4addr_cmp(hold->ah_ipaddr, ipaddr))
+        {
+          continue;
+        }
+
+      /* Drop the packet if it has been held too long */
+
+      if (clock_systimer() - hold->ah_time > ARP_HOLD_MAXAGE_TICK)
+        {
+          arp_hold_release(hold);
+          return;
+        }
+
+      /* The MAC address may lie in the part of d_buf that is about to be
+       * overwritten.
+       */
+
+      memcpy(dest, ethaddr, ETHER_ADDR_LEN);
+
+      len = iob_copyout(&dev->d_buf[ETH_HDRLEN], hold->ah_iob,
+                        hold->ah_iob->io_pktlen, 0);
+      arp_hold_release(hold);
+
+      if (len <= 0)
+        {
+          return;
+        }
+
+      ninfo("Sending held packet to %08lx\n", (unsigned long)ipaddr);
+
+      memcpy(eth->dest, dest, ETHER_ADDR_LEN);
+      memcpy(eth->src, dev->d_mac.ether.ether_addr_octet, ETHER_ADDR_LEN);
+      eth->type  = HTONS(ETHTYPE_IP);
+      dev->d_len = len + ETH_HDRLEN;
+      return;
+    }
+}
+
+#endif /* CONFIG_NET_ARP_HOLD */
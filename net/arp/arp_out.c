@@ -127,7 +127,8 @@ static const uint8_t g_multicast_ethaddr[3] =
  *   packet in the d_buf is replaced by an ARP request packet for the
  *   IP address. The IP packet is dropped and it is assumed that the
  *   higher level protocols (e.g., TCP) eventually will retransmit the
- *   dropped packet.
+ *   dropped packet.  With CONFIG_NET_ARP_HOLD, a copy of the packet is
+ *   kept and sent by arp_arpin() when the ARP reply arrives.
  *
  *   Upon return in either the case, a packet to be sent is present in the
  *   d_buf buffer and the d_len field holds the length of the Ethernet
@@ -257,9 +258,11 @@ void arp_out(FAR struct net_driver_s *dev)
       ninfo("ARP request for IP %08lx\n", (unsigned long)ipaddr);
 
       /* The destination address was not in our ARP table, so we overwrite
-       * the IP packet with an ARP request.
+       * the IP packet with an ARP request (after saving a copy of the IP
+       * packet to be sent when the reply arrives, if so configured).
        */
 
+      arp_hold(dev, ipaddr);
       arp_format(dev, ipaddr);
       arp_dump(ARPBUF);
       return;
@@ -72,10 +72,35 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+/* ARP table hashing.  Entries are chained by their index plus one so that
+ * zero (ARP_HASH_NONE) marks the end of a chain.
+ */
+
+#ifndef CONFIG_NET_ARPTAB_NHASH
+#  define CONFIG_NET_ARPTAB_NHASH 8
+#endif
+
+#if (CONFIG_NET_ARPTAB_NHASH & (CONFIG_NET_ARPTAB_NHASH - 1)) != 0
+#  error CONFIG_NET_ARPTAB_NHASH must be a power of two
+#endif
+
+#define ARP_HASH_NONE     0
+#define ARP_HASH_NDX(e)   ((arp_index_t)((e) - g_arptable) + 1)
+#define ARP_HASH_ENTRY(n) (&g_arptable[(n) - 1])
+#define ARP_HASH_NEXT(n)  g_arpnext[(n) - 1]
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* Link to an ARP table entry in a hash chain */
+
+#if CONFIG_NET_ARPTAB_SIZE >= UINT8_MAX
+typedef uint16_t arp_index_t;
+#else
+typedef uint8_t arp_index_t;
+#endif
+
 struct arp_table_info_s
 {
   in_addr_t              ai_ipaddr;   /* IP address for lookup */
@@ -90,6 +115,13 @@ struct arp_table_info_s
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+/* Hash chains over g_arptable[].  g_arphash[] links to the first entry in
+ * each chain and g_arpnext[] to the next entry.
+ */
+
+static arp_index_t g_arphash[CONFIG_NET_ARPTAB_NHASH];
+static arp_index_t g_arpnext[CONFIG_NET_ARPTAB_SIZE];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -170,6 +202,88 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
     }
 }
 
+/****************************************************************************
+ * Name: arp_hash
+ *
+ * Description:
+ *   Return the hash chain for an IPv4 address.
+ *
+ ****************************************************************************/
+
+static FAR arp_index_t *arp_hash(in_addr_t ipaddr)
+{
+  uint32_t hash = (uint32_t)ipaddr;
+
+  /* IPv4 addresses on a LAN differ mostly in the host part which is in the
+   * last octet (network order), so fold all of the octets together.
+   */
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+
+  return &g_arphash[hash & (CONFIG_NET_ARPTAB_NHASH - 1)];
+}
+
+/****************************************************************************
+ * Name: arp_hash_find
+ *
+ * Description:
+ *   Find the ARP table entry for an IPv4 address, regardless of its age.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_hash_find(in_addr_t ipaddr)
+{
+  arp_index_t ndx;
+
+  if (ipaddr == 0)
+    {
+      return NULL;
+    }
+
+  for (ndx = *arp_hash(ipaddr);
+       ndx != ARP_HASH_NONE;
+       ndx = ARP_HASH_NEXT(ndx))
+    {
+      if (net_ipv4addr_cmp(ipaddr, ARP_HASH_ENTRY(ndx)->at_ipaddr))
+        {
+          return ARP_HASH_ENTRY(ndx);
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_hash_remove
+ *
+ * Description:
+ *   Remove an ARP table entry from its hash chain and mark it unused.
+ *
+ ****************************************************************************/
+
+static void arp_hash_remove(FAR struct arp_entry_s *tabptr)
+{
+  arp_index_t ndx = ARP_HASH_NDX(tabptr);
+  FAR arp_index_t *link;
+
+  if (tabptr->at_ipaddr != 0)
+    {
+      for (link = arp_hash(tabptr->at_ipaddr);
+           *link != ARP_HASH_NONE;
+           link = &ARP_HASH_NEXT(*link))
+        {
+          if (*link == ndx)
+            {
+              *link = ARP_HASH_NEXT(ndx);
+              break;
+            }
+        }
+    }
+
+  tabptr->at_ipaddr = 0;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -196,34 +310,35 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  FAR struct arp_entry_s *tabptr;
+  FAR arp_index_t *bucket;
   int i;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Try to find an entry to update in the hash chain for this address.  If
+   * none is found, the IP -> MAC address mapping is inserted in the ARP
+   * table.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_hash_find(ipaddr);
+  if (tabptr == NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
+      /* Replace the first unused entry or the least recently updated
+       * entry.
        */
 
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
+      tabptr = &g_arptable[0];
+      for (i = 1; i < CONFIG_NET_ARPTAB_SIZE && tabptr->at_ipaddr != 0; ++i)
         {
-          /* Record the oldest entry. */
-
           tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
         }
+
+      arp_hash_remove(tabptr);
+
+      /* And link it into the hash chain for its new address */
+
+      bucket = arp_hash(ipaddr);
+      ARP_HASH_NEXT(ARP_HASH_NDX(tabptr)) = *bucket;
+      *bucket = ARP_HASH_NDX(tabptr);
     }
 
   /* Now, tabptr is the ARP table entry which we will fill with the new
@@ -283,18 +398,14 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
   FAR struct arp_entry_s *tabptr;
-  int i;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_hash_find(ipaddr);
+  if (tabptr != NULL &&
+      clock_systimer() - tabptr->at_time <= ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systimer() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      return tabptr;
     }
 
   /* Not found */
@@ -388,9 +499,9 @@ void arp_delete(in_addr_t ipaddr)
   tabptr = arp_lookup(ipaddr);
   if (tabptr != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Unlink it and set the IP address to zero to "delete" it */
 
-      tabptr->at_ipaddr = 0;
+      arp_hash_remove(tabptr);
     }
 }
 
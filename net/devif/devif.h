@@ -495,6 +495,28 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
                     unsigned int len, unsigned int offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_iob_sendref
+ *
+ * Description:
+ *   Like devif_iob_send(), but drivers that support scatter-gather
+ *   transmit (d_txiob) receive a reference to the I/O buffer chain instead
+ *   of a copy of the data in d_buf.  The caller must keep the chain intact
+ *   until the data has been transmitted.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXIOB
+void devif_iob_sendref(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
+                       unsigned int len, unsigned int offset);
+#elif defined(CONFIG_MM_IOB)
+#  define devif_iob_sendref(dev,buf,len,offset) \
+     devif_iob_send(dev,buf,len,offset)
+#endif
+
 /****************************************************************************
  * Name: devif_pkt_send
  *
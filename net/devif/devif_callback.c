@@ -46,6 +46,7 @@
 #include <debug.h>
 #include <assert.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -202,6 +203,39 @@ static bool devif_event_trigger(uint16_t events, uint16_t triggers)
   return false;
 }
 
+/****************************************************************************
+ * Name: devif_callback_grow
+ *
+ * Description:
+ *   Add CONFIG_NET_TCP_ALLOC_CONNS callback structures from the heap to the
+ *   free list so that connections from a grown TCP connection pool can
+ *   also register callbacks.  The memory is never returned to the heap.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP) && CONFIG_NET_TCP_ALLOC_CONNS > 0
+static void devif_callback_grow(void)
+{
+  FAR struct devif_callback_s *cb;
+  int i;
+
+  cb = (FAR struct devif_callback_s *)
+    kmm_zalloc(CONFIG_NET_TCP_ALLOC_CONNS * sizeof(struct devif_callback_s));
+
+  if (cb != NULL)
+    {
+      for (i = 0; i < CONFIG_NET_TCP_ALLOC_CONNS; i++)
+        {
+          cb[i].nxtconn = g_cbfreelist;
+          g_cbfreelist  = &cb[i];
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -254,6 +288,16 @@ FAR struct devif_callback_s *
   /* Check  the head of the free list */
 
   net_lock();
+
+#if defined(CONFIG_NET_TCP) && CONFIG_NET_TCP_ALLOC_CONNS > 0
+  /* Grow the free list if it is empty */
+
+  if (g_cbfreelist == NULL)
+    {
+      devif_callback_grow();
+    }
+#endif
+
   ret  = g_cbfreelist;
   if (ret)
     {
@@ -84,5 +84,47 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
 #endif
 }
 
+/****************************************************************************
+ * Name: devif_iob_sendref
+ *
+ * Description:
+ *   Like devif_iob_send(), but if the driver supports scatter-gather
+ *   transmit, the data is left in the I/O buffer chain and only a reference
+ *   to it is passed to the driver.
+ *
+ *   The caller must keep the I/O buffer chain intact until the data has
+ *   been transmitted (for TCP, until it has been acknowledged).
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXIOB
+void devif_iob_sendref(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
+                       unsigned int len, unsigned int offset)
+{
+  DEBUGASSERT(dev && len > 0 && len < NETDEV_PKTSIZE(dev));
+
+  if (!dev->d_txiob)
+    {
+      devif_iob_send(dev, iob, len, offset);
+      return;
+    }
+
+  /* The payload stays in the I/O buffer chain */
+
+  dev->d_iob    = iob;
+  dev->d_iobofs = offset;
+  dev->d_sndlen = len;
+
+#ifdef CONFIG_NET_TCP_WRBUFFER_DUMP
+  /* Dump the outgoing I/O buffer chain */
+
+  iob_dump("devif_iob_sendref", iob, len, offset);
+#endif
+}
+#endif
+
 #endif /* CONFIG_MM_IOB */
 
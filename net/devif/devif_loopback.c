@@ -100,11 +100,25 @@ static bool is_loopback(FAR struct net_driver_s *dev)
 
 int devif_loopback(FAR struct net_driver_s *dev)
 {
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  uint8_t rxcsum;
+#endif
+
   if (!is_loopback(dev))
     {
       return 0;
     }
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  /* The packets were built by this network stack and never leave memory,
+   * so there is no need to verify their checksums.  They may not even have
+   * checksums if the device inserts them on transmission.
+   */
+
+  rxcsum        = dev->d_rxcsum;
+  dev->d_rxcsum = NETDEV_CSUM_ALL;
+#endif
+
   /* Loop while if there is data "sent" to ourself.
    * Sending, of course, just means relaying back through the network.
    */
@@ -157,6 +171,10 @@ int devif_loopback(FAR struct net_driver_s *dev)
     }
   while (dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  dev->d_rxcsum = rxcsum;
+#endif
+
   return 1;
 }
 
@@ -525,6 +525,12 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
       /* Call back into the driver */
 
       bstop = callback(dev);
+
+#ifdef CONFIG_NETDEV_TXIOB
+      /* The driver is done with any IOB chain referenced by the packet */
+
+      dev->d_iob = NULL;
+#endif
     }
 
   return bstop;
@@ -569,6 +575,12 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
       /* Call back into the driver */
 
       bstop = callback(dev);
+
+#ifdef CONFIG_NETDEV_TXIOB
+      /* The driver is done with any IOB chain referenced by the packet */
+
+      dev->d_iob = NULL;
+#endif
     }
 
   return bstop;
@@ -602,7 +614,7 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
- *   locked.
+ *   locked.  The device lock is held while the output is built in d_buf.
  *
  ****************************************************************************/
 
@@ -610,6 +622,18 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 {
   int bstop = false;
 
+  /* The device packet buffer is shared with the driver's receive path */
+
+  netdev_lock(dev);
+
+#ifdef CONFIG_NETDEV_TXIOB
+  /* Only TCP output may refer to an IOB chain.  Make sure that nothing
+   * stale is left over from a previous packet.
+   */
+
+  dev->d_iob = NULL;
+#endif
+
   /* Traverse all of the active packet connections and perform the poll
    * action.
    */
@@ -718,6 +742,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
       /* Nothing more to do */
     }
 
+  netdev_unlock(dev);
   return bstop;
 }
 
@@ -741,7 +766,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
- *   locked.
+ *   locked.  The device lock is held while the output is built in d_buf.
  *
  ****************************************************************************/
 
@@ -751,6 +776,8 @@ int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   clock_t elapsed;
   int bstop = false;
 
+  netdev_lock(dev);
+
   /* Get the elapsed time since the last poll in units of half seconds
    * (truncating).
    */
@@ -804,6 +831,7 @@ int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
       bstop = devif_poll(dev, callback);
     }
 
+  netdev_unlock(dev);
   return bstop;
 }
 
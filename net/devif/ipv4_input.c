@@ -342,6 +342,16 @@ int ipv4_input(FAR struct net_driver_s *dev)
   g_netstats.ipv4.recv++;
 #endif
 
+  /* Start the latency trace of the packet */
+
+  net_latency_input(dev);
+
+#ifdef CONFIG_NETDEV_TXIOB
+  /* Any response is built in d_buf until the TCP layer attaches payload */
+
+  dev->d_iob = NULL;
+#endif
+
   /* Start of IP input header processing code. */
   /* Check validity of the IP header. */
 
@@ -514,7 +524,7 @@ int ipv4_input(FAR struct net_driver_s *dev)
         }
     }
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM(dev, NETDEV_CSUM_IPV4) && ipv4_chksum(dev) != 0xffff)
     {
       /* Compute and check the IP header checksum. */
 
@@ -289,6 +289,16 @@ int ipv6_input(FAR struct net_driver_s *dev)
   g_netstats.ipv6.recv++;
 #endif
 
+  /* Start the latency trace of the packet */
+
+  net_latency_input(dev);
+
+#ifdef CONFIG_NETDEV_TXIOB
+  /* Any response is built in d_buf until the TCP layer attaches payload */
+
+  dev->d_iob = NULL;
+#endif
+
   /* Start of IP input header processing code. */
   /* Check validity of the IP header. */
 
@@ -164,6 +164,12 @@ void icmpv6_solicit(FAR struct net_driver_s *dev,
 
   dev->d_len    = IPv6_HDRLEN + l3size;
 
+#ifdef CONFIG_NETDEV_TXIOB
+  /* The solicitation replaces any packet with payload in an IOB chain */
+
+  dev->d_iob    = NULL;
+#endif
+
   ninfo("Outgoing ICMPv6 Neighbor Solicitation length: %d (%d)\n",
           dev->d_len, (ipv6->len[0] << 8) | ipv6->len[1]);
 
@@ -124,6 +124,9 @@ typedef FAR struct wdog_s *WDOG_ID;
 struct igmp_group_s
 {
   struct igmp_group_s *next;    /* Implements a singly-linked list */
+#ifdef CONFIG_NET_IGMP_GRPHASH
+  struct igmp_group_s *hnext;   /* Next group in the same hash chain */
+#endif
   struct work_s        work;    /* For deferred timeout operations */
   in_addr_t            grpaddr; /* Group IPv4 address */
   WDOG_ID              wdog;    /* WDOG used to detect timeouts */
@@ -217,6 +220,17 @@ FAR struct igmp_group_s *igmp_grpfind(FAR struct net_driver_s *dev,
 FAR struct igmp_group_s *igmp_grpallocfind(FAR struct net_driver_s *dev,
                                            FAR const in_addr_t *addr);
 
+/****************************************************************************
+ * Name:  igmp_grpmacshared
+ *
+ * Description:
+ *   Return true if some group other than 'addr' maps to the same multicast
+ *   MAC address as 'addr'.
+ *
+ ****************************************************************************/
+
+bool igmp_grpmacshared(FAR struct net_driver_s *dev, in_addr_t addr);
+
 /****************************************************************************
  * Name:  igmp_grpfree
  *
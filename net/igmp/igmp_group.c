@@ -95,6 +95,39 @@
 #  endif
 #endif
 
+/* The 23 low-order bits of the group address that are carried in the
+ * multicast MAC address (RFC 1112).  Groups with equal MAC bits share one
+ * MAC filter entry.
+ */
+
+#define IGMP_MACBITS(a) \
+  (((uint32_t)(ip4_addr2(a) & 0x7f) << 16) | \
+   ((uint32_t)ip4_addr3(a) << 8) | (uint32_t)ip4_addr4(a))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  igmp_grphash
+ *
+ * Description:
+ *   Return the hash chain for a group address.  Only the MAC bits are
+ *   hashed so that all groups that alias to the same MAC address are found
+ *   on a single chain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IGMP_GRPHASH
+static inline unsigned int igmp_grphash(in_addr_t addr)
+{
+  uint32_t key = IGMP_MACBITS(addr);
+
+  key ^= (key >> 8) ^ (key >> 16);
+  return key % CONFIG_NET_IGMP_GRPHASH_NBUCKETS;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -147,6 +180,17 @@ FAR struct igmp_group_s *igmp_grpalloc(FAR struct net_driver_s *dev,
       /* Add the group structure to the list in the device structure */
 
       sq_addfirst((FAR sq_entry_t *)group, &dev->d_igmp_grplist);
+
+#ifdef CONFIG_NET_IGMP_GRPHASH
+      /* And to the head of its hash chain */
+
+      {
+        unsigned int ndx = igmp_grphash(group->grpaddr);
+
+        group->hnext             = dev->d_igmp_grphash[ndx];
+        dev->d_igmp_grphash[ndx] = group;
+      }
+#endif
     }
 
   return group;
@@ -170,9 +214,15 @@ FAR struct igmp_group_s *igmp_grpfind(FAR struct net_driver_s *dev,
 
   grpinfo("Searching for addr %08x\n", (int)*addr);
 
+#ifdef CONFIG_NET_IGMP_GRPHASH
+  for (group = dev->d_igmp_grphash[igmp_grphash(*addr)];
+       group;
+       group = group->hnext)
+#else
   for (group = (FAR struct igmp_group_s *)dev->d_igmp_grplist.head;
        group;
        group = group->next)
+#endif
     {
       grpinfo("Compare: %08x vs. %08x\n", group->grpaddr, *addr);
       if (net_ipv4addr_cmp(group->grpaddr, *addr))
@@ -213,6 +263,44 @@ FAR struct igmp_group_s *igmp_grpallocfind(FAR struct net_driver_s *dev,
   return group;
 }
 
+/****************************************************************************
+ * Name:  igmp_grpmacshared
+ *
+ * Description:
+ *   Return true if some group other than 'addr' maps to the same multicast
+ *   MAC address as 'addr'.  In that case the device MAC filter entry is
+ *   already present and must be retained.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool igmp_grpmacshared(FAR struct net_driver_s *dev, in_addr_t addr)
+{
+  FAR struct igmp_group_s *group;
+  uint32_t macbits = IGMP_MACBITS(addr);
+
+#ifdef CONFIG_NET_IGMP_GRPHASH
+  for (group = dev->d_igmp_grphash[igmp_grphash(addr)];
+       group;
+       group = group->hnext)
+#else
+  for (group = (FAR struct igmp_group_s *)dev->d_igmp_grplist.head;
+       group;
+       group = group->next)
+#endif
+    {
+      if (!net_ipv4addr_cmp(group->grpaddr, addr) &&
+          IGMP_MACBITS(group->grpaddr) == macbits)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Name:  igmp_grpfree
  *
@@ -236,6 +324,25 @@ void igmp_grpfree(FAR struct net_driver_s *dev, FAR struct igmp_group_s *group)
 
   sq_rem((FAR sq_entry_t *)group, &dev->d_igmp_grplist);
 
+#ifdef CONFIG_NET_IGMP_GRPHASH
+  /* And from its hash chain */
+
+  {
+    FAR struct igmp_group_s **link;
+
+    for (link = &dev->d_igmp_grphash[igmp_grphash(group->grpaddr)];
+         *link != NULL;
+         link = &(*link)->hnext)
+      {
+        if (*link == group)
+          {
+            *link = group->hnext;
+            break;
+          }
+      }
+  }
+#endif
+
   /* Destroy the wait semaphore */
 
   (void)nxsem_destroy(&group->sem);
@@ -44,6 +44,7 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -96,6 +97,10 @@ void igmp_devinit(struct net_driver_s *dev)
   ninfo("IGMP initializing dev %p\n", dev);
   DEBUGASSERT(dev->d_igmp_grplist.head == NULL);
 
+#ifdef CONFIG_NET_IGMP_GRPHASH
+  memset(dev->d_igmp_grphash, 0, sizeof(dev->d_igmp_grphash));
+#endif
+
   /* Add the all systems address to the group */
 
   (void)igmp_grpalloc(dev, &g_ipv4_allsystems);
@@ -43,6 +43,7 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -100,6 +101,17 @@ void igmp_addmcastmac(FAR struct net_driver_s *dev, FAR in_addr_t *ip)
   uint8_t mcastmac[6];
 
   ninfo("Adding: IP %08x\n", *ip);
+
+  /* Nothing to do if another group already holds the same filter entry.
+   * Up to 32 IPv4 groups alias to each multicast MAC address.
+   */
+
+  if (igmp_grpmacshared(dev, *ip))
+    {
+      ninfo("MAC filter entry already present\n");
+      return;
+    }
+
   if (dev->d_addmac)
     {
       igmp_mcastmac(ip, mcastmac);
@@ -118,12 +130,29 @@ void igmp_addmcastmac(FAR struct net_driver_s *dev, FAR in_addr_t *ip)
 void igmp_removemcastmac(FAR struct net_driver_s *dev, FAR in_addr_t *ip)
 {
   uint8_t mcastmac[6];
+  uint8_t routermac[6];
 
   ninfo("Removing: IP %08x\n", *ip);
+
+  /* Keep the filter entry while any other group still maps to it */
+
+  if (igmp_grpmacshared(dev, *ip))
+    {
+      ninfo("MAC filter entry still in use\n");
+      return;
+    }
+
   if (dev->d_rmmac)
     {
       igmp_mcastmac(ip, mcastmac);
-      dev->d_rmmac(dev, mcastmac);
+
+      /* The all routers address is not a group but must also stay */
+
+      igmp_mcastmac(&g_ipv4_allrouters, routermac);
+      if (memcmp(mcastmac, routermac, 6) != 0)
+        {
+          dev->d_rmmac(dev, mcastmac);
+        }
     }
 }
 
@@ -103,6 +103,9 @@ struct inet_recvfrom_s
   FAR socklen_t           *ir_fromlen;   /* Number of bytes allocated for address of sender */
   ssize_t                  ir_recvlen;   /* The received length */
   int                      ir_result;    /* Success:OK, failure:negated errno */
+#ifdef CONFIG_NET_LATENCY
+  struct net_latency_s     ir_latency;   /* Latency trace of the received data */
+#endif
 };
 #endif /* NET_UDP_HAVE_STACK || NET_TCP_HAVE_STACK */
 
@@ -230,9 +233,9 @@ static inline void inet_tcp_newdata(FAR struct net_driver_s *dev,
 #ifdef CONFIG_DEBUG_NET
       uint16_t nsaved;
 
-      nsaved = tcp_datahandler(conn, buffer, buflen);
+      nsaved = tcp_datahandler(dev, conn, buffer, buflen);
 #else
-      (void)tcp_datahandler(conn, buffer, buflen);
+      (void)tcp_datahandler(dev, conn, buffer, buflen);
 #endif
 
       /* There are complicated buffering issues that are not addressed fully
@@ -335,6 +338,12 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
       recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen, 0);
       ninfo("Received %d bytes (of %d)\n", recvlen, iob->io_pktlen);
 
+      /* The packet has reached the application (no-op if the trace of
+       * this I/O buffer chain was already completed by an earlier read).
+       */
+
+      net_latency_done(&iob->io_latency);
+
       /* Update the accumulated size of the data read */
 
       inet_update_recvlen(pstate, recvlen);
@@ -662,6 +671,7 @@ static uint16_t inet_tcp_eventhandler(FAR struct net_driver_s *dev,
            * packet in the read-ahead buffer).
            */
 
+          net_latency_deliver(dev, &pstate->ir_latency);
           inet_tcp_newdata(dev, pstate);
 
           /* Save the sender's address in the caller's 'from' location */
@@ -1177,6 +1187,7 @@ static ssize_t inet_recvfrom_result(int result, struct inet_recvfrom_s *pstate)
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags (MSG_DONTWAIT is honored)
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1189,7 +1200,8 @@ static ssize_t inet_recvfrom_result(int result, struct inet_recvfrom_s *pstate)
 
 #ifdef NET_UDP_HAVE_STACK
 static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
@@ -1229,7 +1241,7 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 #ifdef CONFIG_NET_UDP_READAHEAD
   /* Handle non-blocking UDP sockets */
 
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1305,6 +1317,7 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags (MSG_DONTWAIT is honored)
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1317,7 +1330,8 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
 #ifdef NET_TCP_HAVE_STACK
 static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   struct inet_recvfrom_s state;
   int               ret;
@@ -1391,7 +1405,7 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
   else
 #ifdef CONFIG_NET_TCP_READAHEAD
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1451,6 +1465,12 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
           ret = net_lockedwait(&state.ir_sem);
 
+          /* The receiving task is running again; complete the latency trace
+           * of the last packet delivered directly to the user buffer.
+           */
+
+          net_latency_done(&state.ir_latency);
+
           /* Make sure that no further events are processed */
 
           tcp_callback_free(conn, state.ir_cb);
@@ -1557,7 +1577,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_STREAM:
       {
 #ifdef NET_TCP_HAVE_STACK
-        ret = inet_tcp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_tcp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
@@ -1569,7 +1589,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_DGRAM:
       {
 #ifdef NET_UDP_HAVE_STACK
-        ret = inet_udp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_udp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
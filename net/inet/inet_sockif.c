@@ -41,6 +41,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <stdbool.h>
 #include <assert.h>
 #include <errno.h>
@@ -58,6 +59,17 @@
 
 #ifdef HAVE_INET_SOCKETS
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Vectored sends are queued as one TCP write buffer */
+
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_WRITE_BUFFERS) && \
+    !defined(CONFIG_NET_6LOWPAN)
+#  define HAVE_INET_SENDV 1
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -92,6 +104,10 @@ static ssize_t    inet_sendto(FAR struct socket *psock, FAR const void *buf,
 static ssize_t    inet_sendfile(FAR struct socket *psock, FAR struct file *infile,
                     FAR off_t *offset, size_t count);
 #endif
+#ifdef HAVE_INET_SENDV
+static ssize_t    inet_sendv(FAR struct socket *psock,
+                    FAR const struct iovec *iov, int iovcnt, int flags);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -117,7 +133,15 @@ static const struct sock_intf_s g_inet_sockif =
   inet_sendfile,    /* si_sendfile */
 #endif
   inet_recvfrom,    /* si_recvfrom */
-  inet_close        /* si_close */
+  inet_close,       /* si_close */
+#ifdef CONFIG_NET_USRSOCK
+  NULL,             /* si_ioctl */
+#endif
+#ifdef HAVE_INET_SENDV
+  inet_sendv        /* si_sendv */
+#else
+  NULL              /* si_sendv */
+#endif
 };
 
 /****************************************************************************
@@ -1164,6 +1188,39 @@ static ssize_t inet_send(FAR struct socket *psock, FAR const void *buf,
   return ret;
 }
 
+/****************************************************************************
+ * Name: inet_sendv
+ *
+ * Description:
+ *   Implements the vectored send for the case of connected AF_INET and
+ *   AF_INET6 stream sockets.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iov      Data to send
+ *   iovcnt   Number of entries in iov
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a negated
+ *   errno value is returned (see send() for the list of appropriate error
+ *   values.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_INET_SENDV
+static ssize_t inet_sendv(FAR struct socket *psock,
+                          FAR const struct iovec *iov, int iovcnt, int flags)
+{
+  if (psock->s_type != SOCK_STREAM)
+    {
+      return -ENOTSUP;
+    }
+
+  return psock_tcp_sendv(psock, iov, iovcnt);
+}
+#endif
+
 /****************************************************************************
  * Name: inet_sendto
  *
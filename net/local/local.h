@@ -77,6 +77,13 @@
 #define LOCAL_SYNC_BYTE   0x42     /* Byte in sync sequence */
 #define LOCAL_END_BYTE    0xbd     /* End of sync seqence */
 
+#ifdef CONFIG_NET_LOCAL_RING
+#  ifndef CONFIG_NET_LOCAL_RING_SIZE
+#    define CONFIG_NET_LOCAL_RING_SIZE 1024
+#  endif
+#  define LOCAL_RING_NPOLLWAITERS 2
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -111,6 +118,39 @@ enum local_state_s
   LOCAL_STATE_DISCONNECTED     /* Peer disconnected */
 };
 
+#ifdef CONFIG_NET_LOCAL_RING
+/* One direction of a ring buffer connection.  The ring is shared by the
+ * writing peer (lc_txring) and the reading peer (lc_rxring) and is freed
+ * when both have detached.  All fields are protected by the network lock.
+ */
+
+struct local_ring_s
+{
+  size_t lr_head;              /* Index of the next byte to write */
+  size_t lr_tail;              /* Index of the next byte to read */
+  size_t lr_count;             /* Number of bytes in the ring */
+  sem_t lr_rdsem;              /* Reader waits here for data */
+  sem_t lr_wrsem;              /* Writer waits here for space */
+  bool lr_rdclosed;            /* The reading peer has detached */
+  bool lr_wrclosed;            /* The writing peer has detached */
+
+  /* A receiver blocked on an empty ring may post its buffer here so that
+   * the sender can copy directly into it, bypassing the ring.
+   */
+
+  FAR uint8_t *lr_rdbuf;       /* Buffer of the waiting receiver */
+  size_t lr_rdlen;             /* Size of that buffer */
+  size_t lr_rdcount;           /* Bytes copied into it by the sender */
+
+#ifdef HAVE_LOCAL_POLL
+  struct pollfd *lr_rdfds[LOCAL_RING_NPOLLWAITERS]; /* Waiting for POLLIN */
+  struct pollfd *lr_wrfds[LOCAL_RING_NPOLLWAITERS]; /* Waiting for POLLOUT */
+#endif
+
+  uint8_t lr_buffer[CONFIG_NET_LOCAL_RING_SIZE];
+};
+#endif
+
 /* Representation of a local connection.  There are four types of
  * connection structures:
  *
@@ -193,6 +233,13 @@ struct local_conn_s
       uint16_t lc_remaining;   /* Bytes remaining in the incoming stream */
     } peer;
   } u;
+
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Ring buffers used instead of the FIFOs by connected peers */
+
+  FAR struct local_ring_s *lc_txring; /* Outgoing data */
+  FAR struct local_ring_s *lc_rxring; /* Incoming data */
+#endif
 #endif /* CONFIG_NET_LOCAL_STREAM */
 };
 
@@ -652,6 +699,106 @@ int local_open_sender(FAR struct local_conn_s *conn, FAR const char *path,
 #endif
 
 
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Allocate the pair of ring buffers for a newly accepted connection and
+ *   attach them to both peers.
+ *
+ * Input Parameters:
+ *   server - The new, server-side connection created by accept()
+ *   client - The connecting client
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the rings could not be allocated.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_connect(FAR struct local_conn_s *server,
+                       FAR struct local_conn_s *client);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_disconnect
+ *
+ * Description:
+ *   Detach a peer from its ring buffers, waking up the other peer and
+ *   freeing each ring once both peers have detached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_disconnect(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Send stream data to the connected peer through the ring buffer.
+ *
+ * Input Parameters:
+ *   conn     - The sending peer
+ *   buf      - Data to send
+ *   len      - Length of data to send
+ *   nonblock - True: Do not wait for space in the ring
+ *
+ * Returned Value:
+ *   The number of bytes sent on success; a negated errno value on failure
+ *   (-EAGAIN if nonblocking and the ring is full, -EPIPE if the peer has
+ *   closed).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_send(FAR struct local_conn_s *conn, FAR const void *buf,
+                        size_t len, bool nonblock);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Receive stream data from the connected peer through the ring buffer.
+ *
+ * Input Parameters:
+ *   conn     - The receiving peer
+ *   buf      - Buffer to receive data
+ *   len      - Length of buffer
+ *   nonblock - True: Do not wait for data
+ *
+ * Returned Value:
+ *   The number of bytes received; zero if the peer has closed and no data
+ *   remains; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                        size_t len, bool nonblock);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_pollsetup
+ *
+ * Description:
+ *   Setup or teardown monitoring of events on a ring buffer connection.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(HAVE_LOCAL_POLL)
+int local_ring_pollsetup(FAR struct local_conn_s *conn,
+                         FAR struct pollfd *fds, bool setup);
+#endif
+
 /****************************************************************************
  * Name: local_accept_pollnotify
  ****************************************************************************/
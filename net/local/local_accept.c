@@ -184,6 +184,22 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               conn->lc_path[UNIX_PATH_MAX-1] = '\0';
               conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_RING
+              /* Share a pair of ring buffers with the client instead of
+               * opening the FIFOs.
+               */
+
+              net_lock();
+              ret = local_ring_connect(conn, client);
+              net_unlock();
+
+              if (ret < 0)
+                {
+                   nerr("ERROR: Failed to allocate rings for %s: %d\n",
+                        conn->lc_path, ret);
+                }
+            }
+#else
               /* Open the server-side write-only FIFO.  This should not
                * block.
                */
@@ -216,12 +232,15 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                         conn->lc_path, ret);
                 }
             }
+#endif /* CONFIG_NET_LOCAL_RING */
 
           /* Do we have a connection?  Are the FIFOs opened? */
 
           if (ret == OK)
             {
+#ifndef CONFIG_NET_LOCAL_RING
               DEBUGASSERT(conn->lc_infile.f_inode != NULL);
+#endif
 
               /* Return the address family */
 
@@ -241,6 +260,15 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               newsock->s_conn   = (FAR void *)conn;
             }
 
+#ifdef CONFIG_NET_LOCAL_RING
+          if (ret < 0 && conn != NULL)
+            {
+              net_lock();
+              local_ring_disconnect(conn);
+              net_unlock();
+            }
+#endif
+
           /* Signal the client with the result of the connection */
 
           client->u.client.lc_result = ret;
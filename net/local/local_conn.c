@@ -140,6 +140,12 @@ void local_free(FAR struct local_conn_s *conn)
       conn->lc_outfile.f_inode = NULL;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Detach from the ring buffers shared with the peer */
+
+  local_ring_disconnect(conn);
+#endif
+
 #ifdef CONFIG_NET_LOCAL_STREAM
   /* Destroy all FIFOs associted with the connection */
 
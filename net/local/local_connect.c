@@ -156,6 +156,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   server->u.server.lc_pending++;
   DEBUGASSERT(server->u.server.lc_pending != 0);
 
+#ifndef CONFIG_NET_LOCAL_RING
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(client);
@@ -183,6 +184,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
     }
 
   DEBUGASSERT(client->lc_outfile.f_inode != NULL);
+#endif /* CONFIG_NET_LOCAL_RING */
 
   /* Add ourself to the list of waiting connections and notify the server. */
 
@@ -209,6 +211,25 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
 
   /* Did we successfully connect? */
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to connect: %d\n", ret);
+
+      net_lock();
+      local_ring_disconnect(client);
+      net_unlock();
+
+      client->lc_state = LOCAL_STATE_BOUND;
+      return ret;
+    }
+
+  /* The server has attached the ring buffers; there are no FIFOs to open */
+
+  DEBUGASSERT(client->lc_rxring != NULL && client->lc_txring != NULL);
+  client->lc_state = LOCAL_STATE_CONNECTED;
+  return OK;
+#else
   if (ret < 0)
     {
       nerr("ERROR: Failed to connect: %d\n", ret);
@@ -237,6 +258,7 @@ errout_with_fifos:
   (void)local_release_fifos(client);
   client->lc_state = LOCAL_STATE_BOUND;
   return ret;
+#endif /* CONFIG_NET_LOCAL_RING */
 }
 
 /****************************************************************************
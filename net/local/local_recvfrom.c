@@ -159,6 +159,29 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return -ENOTCONN;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connected peers exchange data through the shared ring buffers */
+
+  if (conn->lc_rxring != NULL)
+    {
+      ssize_t nrecvd;
+
+      nrecvd = local_ring_recv(conn, buf, len,
+                               _SS_ISNONBLOCK(psock->s_flags) ||
+                               (flags & MSG_DONTWAIT) != 0);
+      if (nrecvd >= 0 && from != NULL)
+        {
+          ret = local_getaddr(conn, from, fromlen);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      return nrecvd;
+    }
+#endif
+
   /* The incoming FIFO should be open */
 
   DEBUGASSERT(conn->lc_infile.f_inode != NULL);
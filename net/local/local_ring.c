@@ -0,0 +1,642 @@
+/****************************************************************************
+ * net/local/local_ring.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <poll.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+#define RING_SPACE(r) (CONFIG_NET_LOCAL_RING_SIZE - (r)->lr_count)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_wakeup
+ *
+ * Description:
+ *   Wake up a thread waiting on the ring semaphore.  The count is not
+ *   allowed to grow beyond one; waiters re-check the ring state when they
+ *   are awakened.
+ *
+ ****************************************************************************/
+
+static void local_ring_wakeup(FAR sem_t *sem)
+{
+  int sval;
+
+  if (nxsem_getvalue(sem, &sval) >= 0 && sval < 1)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_notify
+ *
+ * Description:
+ *   Report poll events to one poll waiter.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+static void local_ring_notify(FAR struct pollfd *fds, pollevent_t eventset)
+{
+  fds->revents |= (fds->events & eventset) |
+                  (eventset & (POLLERR | POLLHUP));
+  if (fds->revents != 0)
+    {
+      ninfo("Report events: %02x\n", fds->revents);
+      nxsem_post(fds->sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_pollnotify
+ *
+ * Description:
+ *   Report poll events to every poll waiter in a slot array.
+ *
+ ****************************************************************************/
+
+static void local_ring_pollnotify(FAR struct pollfd **slots,
+                                  pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < LOCAL_RING_NPOLLWAITERS; i++)
+    {
+      if (slots[i] != NULL)
+        {
+          local_ring_notify(slots[i], eventset);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_pollslot
+ *
+ * Description:
+ *   Add a poll waiter to (fds != NULL) or remove one from a slot array.
+ *
+ ****************************************************************************/
+
+static int local_ring_pollslot(FAR struct pollfd **slots,
+                               FAR struct pollfd *match,
+                               FAR struct pollfd *fds)
+{
+  int i;
+
+  for (i = 0; i < LOCAL_RING_NPOLLWAITERS; i++)
+    {
+      if (slots[i] == match)
+        {
+          slots[i] = fds;
+          return OK;
+        }
+    }
+
+  return -EBUSY;
+}
+#else
+#  define local_ring_pollnotify(s,e)
+#endif
+
+/****************************************************************************
+ * Name: local_ring_alloc
+ ****************************************************************************/
+
+static FAR struct local_ring_s *local_ring_alloc(void)
+{
+  FAR struct local_ring_s *ring;
+
+  ring = (FAR struct local_ring_s *)kmm_zalloc(sizeof(struct local_ring_s));
+  if (ring != NULL)
+    {
+      /* These semaphores are used for signaling and, hence, should not have
+       * priority inheritance enabled.
+       */
+
+      nxsem_init(&ring->lr_rdsem, 0, 0);
+      nxsem_setprotocol(&ring->lr_rdsem, SEM_PRIO_NONE);
+      nxsem_init(&ring->lr_wrsem, 0, 0);
+      nxsem_setprotocol(&ring->lr_wrsem, SEM_PRIO_NONE);
+    }
+
+  return ring;
+}
+
+/****************************************************************************
+ * Name: local_ring_free
+ ****************************************************************************/
+
+static void local_ring_free(FAR struct local_ring_s *ring)
+{
+  nxsem_destroy(&ring->lr_rdsem);
+  nxsem_destroy(&ring->lr_wrsem);
+  kmm_free(ring);
+}
+
+/****************************************************************************
+ * Name: local_ring_put
+ *
+ * Description:
+ *   Copy data into the ring.  The caller has verified that there is space.
+ *
+ ****************************************************************************/
+
+static void local_ring_put(FAR struct local_ring_s *ring,
+                           FAR const uint8_t *src, size_t len)
+{
+  size_t ncopy = MIN(len, CONFIG_NET_LOCAL_RING_SIZE - ring->lr_head);
+
+  memcpy(&ring->lr_buffer[ring->lr_head], src, ncopy);
+  if (ncopy < len)
+    {
+      memcpy(ring->lr_buffer, src + ncopy, len - ncopy);
+    }
+
+  ring->lr_head += len;
+  if (ring->lr_head >= CONFIG_NET_LOCAL_RING_SIZE)
+    {
+      ring->lr_head -= CONFIG_NET_LOCAL_RING_SIZE;
+    }
+
+  ring->lr_count += len;
+}
+
+/****************************************************************************
+ * Name: local_ring_get
+ *
+ * Description:
+ *   Copy data out of the ring.  The caller has verified that it is present.
+ *
+ ****************************************************************************/
+
+static void local_ring_get(FAR struct local_ring_s *ring, FAR uint8_t *dest,
+                           size_t len)
+{
+  size_t ncopy = MIN(len, CONFIG_NET_LOCAL_RING_SIZE - ring->lr_tail);
+
+  memcpy(dest, &ring->lr_buffer[ring->lr_tail], ncopy);
+  if (ncopy < len)
+    {
+      memcpy(dest + ncopy, ring->lr_buffer, len - ncopy);
+    }
+
+  ring->lr_tail += len;
+  if (ring->lr_tail >= CONFIG_NET_LOCAL_RING_SIZE)
+    {
+      ring->lr_tail -= CONFIG_NET_LOCAL_RING_SIZE;
+    }
+
+  ring->lr_count -= len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Allocate the pair of ring buffers for a newly accepted connection and
+ *   attach them to both peers.
+ *
+ * Input Parameters:
+ *   server - The new, server-side connection created by accept()
+ *   client - The connecting client
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the rings could not be allocated.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int local_ring_connect(FAR struct local_conn_s *server,
+                       FAR struct local_conn_s *client)
+{
+  FAR struct local_ring_s *c2s;
+  FAR struct local_ring_s *s2c;
+
+  c2s = local_ring_alloc();
+  if (c2s == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  s2c = local_ring_alloc();
+  if (s2c == NULL)
+    {
+      local_ring_free(c2s);
+      return -ENOMEM;
+    }
+
+  client->lc_txring = c2s;
+  server->lc_rxring = c2s;
+  server->lc_txring = s2c;
+  client->lc_rxring = s2c;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_disconnect
+ *
+ * Description:
+ *   Detach a peer from its ring buffers, waking up the other peer and
+ *   freeing each ring once both peers have detached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_ring_disconnect(FAR struct local_conn_s *conn)
+{
+  FAR struct local_ring_s *ring;
+
+  /* The peer reading our outgoing ring sees end-of-file once it is empty */
+
+  ring = conn->lc_txring;
+  if (ring != NULL)
+    {
+      ring->lr_wrclosed = true;
+      local_ring_wakeup(&ring->lr_rdsem);
+      local_ring_pollnotify(ring->lr_rdfds, POLLIN | POLLHUP);
+
+      if (ring->lr_rdclosed)
+        {
+          local_ring_free(ring);
+        }
+
+      conn->lc_txring = NULL;
+    }
+
+  /* The peer writing our incoming ring gets EPIPE */
+
+  ring = conn->lc_rxring;
+  if (ring != NULL)
+    {
+      ring->lr_rdclosed = true;
+      ring->lr_rdbuf    = NULL;
+      local_ring_wakeup(&ring->lr_wrsem);
+      local_ring_pollnotify(ring->lr_wrfds, POLLERR | POLLHUP);
+
+      if (ring->lr_wrclosed)
+        {
+          local_ring_free(ring);
+        }
+
+      conn->lc_rxring = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Send stream data to the connected peer through the ring buffer.
+ *
+ * Input Parameters:
+ *   conn     - The sending peer
+ *   buf      - Data to send
+ *   len      - Length of data to send
+ *   nonblock - True: Do not wait for space in the ring
+ *
+ * Returned Value:
+ *   The number of bytes sent on success; a negated errno value on failure
+ *   (-EAGAIN if nonblocking and the ring is full, -EPIPE if the peer has
+ *   closed).
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn, FAR const void *buf,
+                        size_t len, bool nonblock)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)buf;
+  FAR struct local_ring_s *ring;
+  size_t sent = 0;
+  size_t ncopy;
+  int ret = OK;
+
+  net_lock();
+  while (sent < len)
+    {
+      ring = conn->lc_txring;
+      if (ring == NULL || ring->lr_rdclosed)
+        {
+          ret = -EPIPE;
+          break;
+        }
+
+      /* If the receiver is already waiting on an empty ring, copy straight
+       * into its buffer.
+       */
+
+      if (ring->lr_count == 0 && ring->lr_rdbuf != NULL)
+        {
+          ncopy = MIN(len - sent, ring->lr_rdlen);
+          memcpy(ring->lr_rdbuf, src + sent, ncopy);
+
+          ring->lr_rdcount = ncopy;
+          ring->lr_rdbuf   = NULL;
+          sent            += ncopy;
+
+          local_ring_wakeup(&ring->lr_rdsem);
+          continue;
+        }
+
+      /* Otherwise, copy as much as will fit into the ring */
+
+      if (RING_SPACE(ring) > 0)
+        {
+          ncopy = MIN(len - sent, RING_SPACE(ring));
+          local_ring_put(ring, src + sent, ncopy);
+          sent += ncopy;
+
+          local_ring_wakeup(&ring->lr_rdsem);
+          local_ring_pollnotify(ring->lr_rdfds, POLLIN);
+          continue;
+        }
+
+      /* The ring is full */
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      ret = net_lockedwait(&ring->lr_wrsem);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  net_unlock();
+  return sent > 0 ? (ssize_t)sent : ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Receive stream data from the connected peer through the ring buffer.
+ *
+ * Input Parameters:
+ *   conn     - The receiving peer
+ *   buf      - Buffer to receive data
+ *   len      - Length of buffer
+ *   nonblock - True: Do not wait for data
+ *
+ * Returned Value:
+ *   The number of bytes received; zero if the peer has closed and no data
+ *   remains; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                        size_t len, bool nonblock)
+{
+  FAR struct local_ring_s *ring;
+  ssize_t ret;
+  bool posted;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  net_lock();
+  for (; ; )
+    {
+      ring = conn->lc_rxring;
+      if (ring == NULL)
+        {
+          ret = -ENOTCONN;
+          break;
+        }
+
+      if (ring->lr_count > 0)
+        {
+          ret = MIN(len, ring->lr_count);
+          local_ring_get(ring, (FAR uint8_t *)buf, ret);
+
+          local_ring_wakeup(&ring->lr_wrsem);
+          local_ring_pollnotify(ring->lr_wrfds, POLLOUT);
+          break;
+        }
+
+      if (ring->lr_wrclosed)
+        {
+          /* End-of-file */
+
+          ret = 0;
+          break;
+        }
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      /* Offer our buffer to the sender unless another receiver (on a dup'ed
+       * descriptor) already has.
+       */
+
+      posted = false;
+      if (ring->lr_rdbuf == NULL && ring->lr_rdcount == 0)
+        {
+          ring->lr_rdbuf   = (FAR uint8_t *)buf;
+          ring->lr_rdlen   = len;
+          posted           = true;
+        }
+
+      ret = net_lockedwait(&ring->lr_rdsem);
+
+      if (posted)
+        {
+          size_t ncopied = ring->lr_rdcount;
+
+          ring->lr_rdbuf   = NULL;
+          ring->lr_rdcount = 0;
+
+          if (ncopied > 0)
+            {
+              ret = ncopied;
+              break;
+            }
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollsetup
+ *
+ * Description:
+ *   Setup or teardown monitoring of events on a ring buffer connection.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+int local_ring_pollsetup(FAR struct local_conn_s *conn,
+                         FAR struct pollfd *fds, bool setup)
+{
+  FAR struct local_ring_s *rx;
+  FAR struct local_ring_s *tx;
+  pollevent_t eventset;
+  int ret = OK;
+
+  net_lock();
+  rx = conn->lc_rxring;
+  tx = conn->lc_txring;
+
+  if (!setup)
+    {
+      if (rx != NULL)
+        {
+          (void)local_ring_pollslot(rx->lr_rdfds, fds, NULL);
+        }
+
+      if (tx != NULL)
+        {
+          (void)local_ring_pollslot(tx->lr_wrfds, fds, NULL);
+        }
+
+      fds->priv = NULL;
+      goto out;
+    }
+
+  if (rx == NULL || tx == NULL)
+    {
+      local_ring_notify(fds, POLLERR);
+      goto out;
+    }
+
+  if ((fds->events & POLLIN) != 0)
+    {
+      ret = local_ring_pollslot(rx->lr_rdfds, NULL, fds);
+      if (ret < 0)
+        {
+          goto out;
+        }
+    }
+
+  if ((fds->events & POLLOUT) != 0)
+    {
+      ret = local_ring_pollslot(tx->lr_wrfds, NULL, fds);
+      if (ret < 0)
+        {
+          (void)local_ring_pollslot(rx->lr_rdfds, fds, NULL);
+          goto out;
+        }
+    }
+
+  fds->priv = conn;
+
+  /* Report any events that are already pending */
+
+  eventset = 0;
+  if (rx->lr_count > 0 || rx->lr_wrclosed)
+    {
+      eventset |= POLLIN;
+    }
+
+  if (rx->lr_wrclosed)
+    {
+      eventset |= POLLHUP;
+    }
+
+  if (tx->lr_rdclosed)
+    {
+      eventset |= POLLERR | POLLHUP;
+    }
+  else if (RING_SPACE(tx) > 0)
+    {
+      eventset |= POLLOUT;
+    }
+
+  if (eventset != 0)
+    {
+      local_ring_notify(fds, eventset);
+    }
+
+out:
+  net_unlock();
+  return ret;
+}
+#endif /* HAVE_LOCAL_POLL */
+
+#endif /* CONFIG_NET_LOCAL_RING */
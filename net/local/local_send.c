@@ -46,6 +46,7 @@
 
 #include <nuttx/net/net.h>
 
+#include "socket/socket.h"
 #include "local/local.h"
 
 #ifdef CONFIG_NET_LOCAL_STREAM
@@ -82,6 +83,17 @@ ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
   DEBUGASSERT(psock && psock->s_conn && buf);
   peer = (FAR struct local_conn_s *)psock->s_conn;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connected peers exchange data through the shared ring buffers */
+
+  if (peer->lc_state == LOCAL_STATE_CONNECTED && peer->lc_txring != NULL)
+    {
+      return local_ring_send(peer, buf, len,
+                             _SS_ISNONBLOCK(psock->s_flags) ||
+                             (flags & MSG_DONTWAIT) != 0);
+    }
+#endif
+
   /* Verify that this is a connected peer socket and that it has opened the
    * outgoing FIFO for write-only access.
    */
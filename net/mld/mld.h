@@ -217,6 +217,9 @@ typedef FAR struct wdog_s *WDOG_ID;
 struct mld_group_s
 {
   struct mld_group_s *next;    /* Implements a singly-linked list */
+#ifdef CONFIG_NET_MLD_GRPHASH
+  struct mld_group_s *hnext;   /* Next group in the same hash chain */
+#endif
   net_ipv6addr_t      grpaddr; /* Group IPv6 address */
   struct work_s       work;    /* For deferred timeout operations */
   WDOG_ID             polldog; /* Timer used for periodic or delayed events */
@@ -357,6 +360,18 @@ FAR struct mld_group_s *mld_grpfind(FAR struct net_driver_s *dev,
 FAR struct mld_group_s *mld_grpallocfind(FAR struct net_driver_s *dev,
                                          FAR const net_ipv6addr_t addr);
 
+/****************************************************************************
+ * Name:  mld_grpmacshared
+ *
+ * Description:
+ *   Return true if some group other than 'addr' maps to the same multicast
+ *   MAC address as 'addr'.
+ *
+ ****************************************************************************/
+
+bool mld_grpmacshared(FAR struct net_driver_s *dev,
+                      FAR const net_ipv6addr_t addr);
+
 /****************************************************************************
  * Name:  mld_grpfree
  *
@@ -60,10 +60,41 @@
 
 #ifdef CONFIG_NET_MLD
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The low 32 bits of the group address are carried in the multicast MAC
+ * address (RFC 7042).  Groups with equal MAC bits share one MAC filter
+ * entry.
+ */
+
+#define MLD_MACBITS_EQ(a,b) ((a)[6] == (b)[6] && (a)[7] == (b)[7])
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name:  mld_grphash
+ *
+ * Description:
+ *   Return the hash chain for a group address.  Only the MAC bits are
+ *   hashed so that all groups that alias to the same MAC address are found
+ *   on a single chain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_MLD_GRPHASH
+static inline unsigned int mld_grphash(FAR const net_ipv6addr_t addr)
+{
+  uint32_t key = ((uint32_t)addr[6] << 16) | (uint32_t)addr[7];
+
+  key ^= (key >> 8) ^ (key >> 16) ^ (key >> 24);
+  return key % CONFIG_NET_MLD_GRPHASH_NBUCKETS;
+}
+#endif
+
 /****************************************************************************
  * Name:  mld_ngroups
  *
@@ -161,6 +192,17 @@ FAR struct mld_group_s *mld_grpalloc(FAR struct net_driver_s *dev,
       /* Add the group structure to the list in the device structure */
 
       sq_addfirst((FAR sq_entry_t *)group, &dev->d_mld.grplist);
+
+#ifdef CONFIG_NET_MLD_GRPHASH
+      /* And to the head of its hash chain */
+
+      {
+        unsigned int ndx = mld_grphash(group->grpaddr);
+
+        group->hnext            = dev->d_mld.grphash[ndx];
+        dev->d_mld.grphash[ndx] = group;
+      }
+#endif
     }
 
   return group;
@@ -191,9 +233,15 @@ FAR struct mld_group_s *mld_grpfind(FAR struct net_driver_s *dev,
           addr[0], addr[1], addr[2], addr[3], addr[4], addr[5], addr[6],
           addr[7]);
 
+#ifdef CONFIG_NET_MLD_GRPHASH
+  for (group = dev->d_mld.grphash[mld_grphash(addr)];
+       group;
+       group = group->hnext)
+#else
   for (group = (FAR struct mld_group_s *)dev->d_mld.grplist.head;
        group;
        group = group->next)
+#endif
     {
       mldinfo("Compare: %04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x\n",
               group->grpaddr[0], group->grpaddr[1], group->grpaddr[2],
@@ -235,6 +283,44 @@ FAR struct mld_group_s *mld_grpallocfind(FAR struct net_driver_s *dev,
   return group;
 }
 
+/****************************************************************************
+ * Name:  mld_grpmacshared
+ *
+ * Description:
+ *   Return true if some group other than 'addr' maps to the same multicast
+ *   MAC address as 'addr'.  In that case the device MAC filter entry is
+ *   already present and must be retained.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool mld_grpmacshared(FAR struct net_driver_s *dev,
+                      FAR const net_ipv6addr_t addr)
+{
+  FAR struct mld_group_s *group;
+
+#ifdef CONFIG_NET_MLD_GRPHASH
+  for (group = dev->d_mld.grphash[mld_grphash(addr)];
+       group;
+       group = group->hnext)
+#else
+  for (group = (FAR struct mld_group_s *)dev->d_mld.grplist.head;
+       group;
+       group = group->next)
+#endif
+    {
+      if (MLD_MACBITS_EQ(group->grpaddr, addr) &&
+          !net_ipv6addr_cmp(group->grpaddr, addr))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Name:  mld_grpfree
  *
@@ -258,6 +344,25 @@ void mld_grpfree(FAR struct net_driver_s *dev, FAR struct mld_group_s *group)
 
   sq_rem((FAR sq_entry_t *)group, &dev->d_mld.grplist);
 
+#ifdef CONFIG_NET_MLD_GRPHASH
+  /* And from its hash chain */
+
+  {
+    FAR struct mld_group_s **link;
+
+    for (link = &dev->d_mld.grphash[mld_grphash(group->grpaddr)];
+         *link != NULL;
+         link = &(*link)->hnext)
+      {
+        if (*link == group)
+          {
+            *link = group->hnext;
+            break;
+          }
+      }
+  }
+#endif
+
   /* Destroy the wait semaphore */
 
   (void)nxsem_destroy(&group->sem);
@@ -37,6 +37,7 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -46,6 +47,7 @@
 #include <nuttx/net/mld.h>
 
 #include "devif/devif.h"
+#include "inet/inet.h"
 #include "mld/mld.h"
 
 #ifdef CONFIG_NET_MLD
@@ -106,6 +108,14 @@ void mld_addmcastmac(FAR struct net_driver_s *dev,
 
   mldinfo("Adding MAC address filter\n");
 
+  /* Nothing to do if another group already holds the same filter entry */
+
+  if (mld_grpmacshared(dev, ipaddr))
+    {
+      mldinfo("MAC filter entry already present\n");
+      return;
+    }
+
   if (dev->d_addmac != NULL)
     {
       mld_mcastmac(ipaddr, mcastmac);
@@ -125,12 +135,36 @@ void mld_removemcastmac(FAR struct net_driver_s *dev,
                         FAR const net_ipv6addr_t ipaddr)
 {
   uint8_t mcastmac[6];
+  uint8_t routermac[6];
 
   mldinfo("Removing MAC address filter\n");
 
+  /* Keep the filter entry while any other group still maps to it */
+
+  if (mld_grpmacshared(dev, ipaddr))
+    {
+      mldinfo("MAC filter entry still in use\n");
+      return;
+    }
+
   if (dev->d_rmmac != NULL)
     {
       mld_mcastmac(ipaddr, mcastmac);
+
+      /* The router addresses are not groups but must also stay */
+
+      mld_mcastmac(g_ipv6_allrouters, routermac);
+      if (memcmp(mcastmac, routermac, 6) == 0)
+        {
+          return;
+        }
+
+      mld_mcastmac(g_ipv6_allmldv2routers, routermac);
+      if (memcmp(mcastmac, routermac, 6) == 0)
+        {
+          return;
+        }
+
       dev->d_rmmac(dev, mcastmac);
     }
 }
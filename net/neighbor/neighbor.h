@@ -64,6 +64,26 @@
 #  define CONFIG_NET_IPv6_NCONF_ENTRIES 8
 #endif
 
+#ifndef CONFIG_NET_IPv6_NCONF_NHASH
+#  define CONFIG_NET_IPv6_NCONF_NHASH 8
+#endif
+
+#if (CONFIG_NET_IPv6_NCONF_NHASH & (CONFIG_NET_IPv6_NCONF_NHASH - 1)) != 0
+#  error CONFIG_NET_IPv6_NCONF_NHASH must be a power of two
+#endif
+
+#if CONFIG_NET_IPv6_NCONF_ENTRIES >= UINT8_MAX
+#  error CONFIG_NET_IPv6_NCONF_ENTRIES too large (over 254)
+#endif
+
+/* Neighbor table entries are chained by their index plus one so that zero
+ * (NEIGHBOR_HASH_NONE) marks the end of a hash chain.
+ */
+
+#define NEIGHBOR_HASH_NONE     0
+#define NEIGHBOR_HASH_ENTRY(n) (&g_neighbors[(n) - 1])
+#define NEIGHBOR_HASH_NEXT(n)  g_neighbor_next[(n) - 1]
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -107,6 +127,13 @@ struct neighbor_entry
 
 extern struct neighbor_entry g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* Hash chains over g_neighbors[].  g_neighbor_hash[] links to the first
+ * entry in each chain and g_neighbor_next[] to the next entry.
+ */
+
+extern uint8_t g_neighbor_hash[CONFIG_NET_IPv6_NCONF_NHASH];
+extern uint8_t g_neighbor_next[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -131,6 +158,22 @@ struct net_driver_s; /* Forward reference */
 
 FAR struct neighbor_entry *neighbor_findentry(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain in the Neighbor Table for an IPv6 address.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to hash
+ *
+ * Returned Value:
+ *   A reference to the head of the hash chain.
+ *
+ ****************************************************************************/
+
+FAR uint8_t *neighbor_hash(const net_ipv6addr_t ipaddr);
+
 /****************************************************************************
  * Name: neighbor_add
  *
@@ -80,6 +80,7 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  FAR uint8_t *link;
   uint8_t lltype;
   clock_t oldest_time;
   int     oldest_ndx;
@@ -87,26 +88,61 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the first unused entry or the oldest used entry. */
+  /* Check for an existing entry in the hash chain for this address */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  lltype = dev->d_lltype;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (link = neighbor_hash(ipaddr);
+       *link != NEIGHBOR_HASH_NONE;
+       link = &NEIGHBOR_HASH_NEXT(*link))
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      FAR struct neighbor_entry *neighbor = NEIGHBOR_HASH_ENTRY(*link);
+
+      if (neighbor->ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
           break;
         }
+    }
+
+  if (*link != NEIGHBOR_HASH_NONE)
+    {
+      oldest_ndx = *link - 1;
+    }
+  else
+    {
+      /* Find the first unused entry or the oldest used entry. */
+
+      oldest_time = g_neighbors[0].ne_time;
+      oldest_ndx  = 0;
+
+      for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+        {
+          if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+            {
+              oldest_ndx = i;
+              oldest_time = g_neighbors[i].ne_time;
+            }
+        }
+
+      /* Unlink the entry from the hash chain of its old address (if it is
+       * in one) and link it into the chain for the new address.
+       */
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+      for (link = neighbor_hash(g_neighbors[oldest_ndx].ne_ipaddr);
+           *link != NEIGHBOR_HASH_NONE;
+           link = &NEIGHBOR_HASH_NEXT(*link))
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          if (*link == oldest_ndx + 1)
+            {
+              *link = NEIGHBOR_HASH_NEXT(oldest_ndx + 1);
+              break;
+            }
         }
+
+      link = neighbor_hash(ipaddr);
+      NEIGHBOR_HASH_NEXT(oldest_ndx + 1) = *link;
+      *link = oldest_ndx + 1;
     }
 
   /* Use the oldest or first free entry (either pointed to by the
@@ -52,6 +52,34 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain in the Neighbor Table for an IPv6 address.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to hash
+ *
+ * Returned Value:
+ *   A reference to the head of the hash chain.
+ *
+ ****************************************************************************/
+
+FAR uint8_t *neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  uint16_t hash;
+
+  /* Neighbors usually share the prefix, so hash the interface identifier
+   * (the low 64 bits).
+   */
+
+  hash = ipaddr[4] ^ ipaddr[5] ^ ipaddr[6] ^ ipaddr[7];
+  hash ^= hash >> 8;
+
+  return &g_neighbor_hash[hash & (CONFIG_NET_IPv6_NCONF_NHASH - 1)];
+}
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -70,11 +98,13 @@
 
 FAR struct neighbor_entry *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  uint8_t ndx;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (ndx = *neighbor_hash(ipaddr);
+       ndx != NEIGHBOR_HASH_NONE;
+       ndx = NEIGHBOR_HASH_NEXT(ndx))
     {
-      FAR struct neighbor_entry *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry *neighbor = NEIGHBOR_HASH_ENTRY(ndx);
 
       if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
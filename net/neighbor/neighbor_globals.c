@@ -56,3 +56,8 @@
 
 struct neighbor_entry g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* Hash chains over the Neighbor table */
+
+uint8_t g_neighbor_hash[CONFIG_NET_IPv6_NCONF_NHASH];
+uint8_t g_neighbor_next[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
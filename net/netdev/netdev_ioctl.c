@@ -89,6 +89,7 @@
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
 #include "route/route.h"
+#include "pkt/pkt.h"
 
 #if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
 
@@ -1467,6 +1468,48 @@ static int netdev_usrsock_ioctl(FAR struct socket *psock, int cmd,
 }
 #endif
 
+/****************************************************************************
+ * Name: netdev_pkt_ioctl
+ *
+ * Description:
+ *   Return the address of the receive ring of a packet socket so that
+ *   mmap() may be used on the socket descriptor.
+ *
+ * Parameters:
+ *   psock    Socket structure
+ *   cmd      The ioctl command
+ *   arg      The argument of the ioctl cmd
+ *
+ * Return:
+ *   >=0 on success (positive non-zero values are cmd-specific)
+ *   Negated errno returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+static int netdev_pkt_ioctl(FAR struct socket *psock, int cmd,
+                            unsigned long arg)
+{
+  FAR void **addr = (FAR void **)((uintptr_t)arg);
+  int ret;
+
+  if (cmd != FIOC_MMAP || psock->s_domain != PF_PACKET)
+    {
+      return -ENOTTY;
+    }
+
+  if (addr == NULL)
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+  ret = pkt_ring_mmap((FAR struct pkt_conn_s *)psock->s_conn, addr);
+  net_unlock();
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1704,6 +1747,15 @@ int psock_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
     }
 #endif
 
+#ifdef CONFIG_NET_PKT_RING
+  /* Check for a packet socket mmap() request */
+
+  if (ret == -ENOTTY)
+    {
+      ret = netdev_pkt_ioctl(psock, cmd, arg);
+    }
+#endif
+
   return ret;
 }
 
@@ -1765,12 +1817,15 @@ void netdev_ifup(FAR struct net_driver_s *dev)
         {
           /* No, bring the interface up now */
 
+          netdev_lock(dev);
           if (dev->d_ifup(dev) == OK)
             {
               /* Mark the interface as up */
 
               dev->d_flags |= IFF_UP;
             }
+
+          netdev_unlock(dev);
         }
     }
 }
@@ -1787,12 +1842,15 @@ void netdev_ifdown(FAR struct net_driver_s *dev)
         {
           /* No, take the interface down now */
 
+          netdev_lock(dev);
           if (dev->d_ifdown(dev) == OK)
             {
               /* Mark the interface as down */
 
               dev->d_flags &= ~IFF_UP;
             }
+
+          netdev_unlock(dev);
         }
 
       /* Notify clients that the network has been taken down */
@@ -345,6 +345,12 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       dev->d_conncb = NULL;
       dev->d_devcb = NULL;
 
+#ifdef CONFIG_NETDEV_LOCK
+      /* Initialize the per-device lock */
+
+      net_rlock_init(&dev->d_lock);
+#endif
+
       /* We need exclusive access for the following operations */
 
       net_lock();
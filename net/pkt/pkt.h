@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <queue.h>
 
 #ifdef CONFIG_NET_PKT
@@ -65,6 +66,7 @@
 /* Representation of a packet socket connection */
 
 struct devif_callback_s; /* Forward reference */
+struct pollfd;           /* Forward reference */
 
 struct pkt_conn_s
 {
@@ -74,6 +76,20 @@ struct pkt_conn_s
   uint16_t   proto;
   uint8_t    crefs;    /* Reference counts on this instance */
 
+#ifdef CONFIG_NET_PKT_RING
+  /* The PACKET_RX_RING frame ring shared with the application */
+
+  FAR uint8_t *rxring;    /* The ring memory (NULL: no ring) */
+  size_t     ringsize;    /* Size of the ring memory in bytes */
+  uint16_t   framesize;   /* Size of one frame, including its header */
+  uint16_t   nframes;     /* Number of frames in the ring */
+  uint16_t   rxhead;      /* Index of the next frame to be filled */
+  bool       losing;      /* Frames were dropped because the ring was full */
+#ifndef CONFIG_DISABLE_POLL
+  FAR struct pollfd *fds; /* Poll waiting for a ring frame */
+#endif
+#endif
+
   /* Defines the list of packet callbacks */
 
   struct devif_callback_s *list;
@@ -301,6 +317,95 @@ struct socket;
 ssize_t psock_pkt_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   Handle the SOL_PACKET socket options.  Only PACKET_RX_RING is
+ *   supported.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to modify
+ *   option    Identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame in dev->d_buf into the next free frame of the receive
+ *   ring of 'conn'.  The frame is dropped if the ring is full.
+ *
+ * Returned Value:
+ *   OK if the connection has a receive ring (whether or not the frame was
+ *   kept); -ENOENT if the connection has no receive ring.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+int pkt_ring_input(FAR struct net_driver_s *dev,
+                   FAR struct pkt_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_mmap
+ *
+ * Description:
+ *   Return the address of the receive ring in response to FIOC_MMAP.
+ *
+ * Returned Value:
+ *   OK on success; -ENODEV if no ring has been set up.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+int pkt_ring_mmap(FAR struct pkt_conn_s *conn, FAR void **addr);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down a poll for a filled frame in the receive ring.
+ *
+ * Returned Value:
+ *   OK on success; -ENOSYS if the connection has no receive ring; -EBUSY if
+ *   another poll is already waiting on the ring.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_PKT_RING) && !defined(CONFIG_DISABLE_POLL)
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_free
+ *
+ * Description:
+ *   Release the receive ring of a connection, if any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+void pkt_ring_free(FAR struct pkt_conn_s *conn);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
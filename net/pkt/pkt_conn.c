@@ -192,6 +192,12 @@ void pkt_free(FAR struct pkt_conn_s *conn)
 
   dq_rem(&conn->node, &g_active_pkt_connections);
 
+#ifdef CONFIG_NET_PKT_RING
+  /* Release any receive ring */
+
+  pkt_ring_free(conn);
+#endif
+
   /* Free the connection */
 
   dq_addlast(&conn->node, &g_free_pkt_connections);
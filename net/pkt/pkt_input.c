@@ -94,6 +94,17 @@ int pkt_input(struct net_driver_s *dev)
     {
       uint16_t flags;
 
+#ifdef CONFIG_NET_PKT_RING
+      /* If the socket has a receive ring, then the frame is placed in the
+       * ring rather than passed to a waiting recvfrom().
+       */
+
+      if (pkt_ring_input(dev, conn) == OK)
+        {
+          return OK;
+        }
+
+#endif
       /* Setup for the application callback */
 
       dev->d_appdata = dev->d_buf;
@@ -0,0 +1,405 @@
+/****************************************************************************
+ * net/pkt/pkt_ring.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_PKT_RING)
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ethernet.h>
+
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Address of frame 'n' in the receive ring of 'c' */
+
+#define PKT_RING_FRAME(c,n) \
+  ((FAR struct tpacket_hdr *)&(c)->rxring[(size_t)(n) * (c)->framesize])
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_readable
+ *
+ * Description:
+ *   Return true if the application has at least one filled frame to
+ *   consume.  Frames are filled and consumed in order, so it is sufficient
+ *   to check the most recently filled frame.
+ *
+ ****************************************************************************/
+
+static bool pkt_ring_readable(FAR struct pkt_conn_s *conn)
+{
+  uint16_t prev;
+
+  prev = (conn->rxhead == 0) ? conn->nframes - 1 : conn->rxhead - 1;
+  return PKT_RING_FRAME(conn, prev)->tp_status != TP_STATUS_KERNEL;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Validate a PACKET_RX_RING request and allocate the ring.
+ *
+ ****************************************************************************/
+
+static int pkt_ring_setup(FAR struct pkt_conn_s *conn,
+                          FAR const struct tpacket_req *req)
+{
+  FAR uint8_t *ring;
+  size_t ringsize;
+
+  if (req->tp_frame_size < TPACKET_HDRLEN ||
+      req->tp_frame_size > UINT16_MAX ||
+      (req->tp_frame_size & (TPACKET_ALIGNMENT - 1)) != 0 ||
+      req->tp_block_size < req->tp_frame_size ||
+      (req->tp_block_size % req->tp_frame_size) != 0 ||
+      req->tp_frame_nr > UINT16_MAX ||
+      req->tp_frame_nr !=
+        (req->tp_block_size / req->tp_frame_size) * req->tp_block_nr)
+    {
+      return -EINVAL;
+    }
+
+  /* The ring memory is accessed directly by the application, so it comes
+   * from the user heap.  Zeroing it gives all frames to the network
+   * (TP_STATUS_KERNEL).
+   */
+
+  ringsize = (size_t)req->tp_block_size * req->tp_block_nr;
+  ring     = (FAR uint8_t *)kumm_zalloc(ringsize);
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* A ring that is in use cannot be replaced; it could be mapped by the
+   * application.
+   */
+
+  net_lock();
+  if (conn->rxring != NULL)
+    {
+      net_unlock();
+      kumm_free(ring);
+      return -EBUSY;
+    }
+
+  conn->rxring    = ring;
+  conn->ringsize  = ringsize;
+  conn->framesize = (uint16_t)req->tp_frame_size;
+  conn->nframes   = (uint16_t)req->tp_frame_nr;
+  conn->rxhead    = 0;
+  conn->losing    = false;
+  net_unlock();
+
+  ninfo("RX ring: %u frames of %u bytes\n",
+        conn->nframes, conn->framesize);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   Handle the SOL_PACKET socket options.  Only PACKET_RX_RING is
+ *   supported.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to modify
+ *   option    Identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len)
+{
+  FAR const struct tpacket_req *req;
+  FAR struct pkt_conn_s *conn;
+
+  if (psock->s_domain != PF_PACKET || psock->s_conn == NULL)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  if (option != PACKET_RX_RING)
+    {
+      nerr("ERROR: Unrecognized SOL_PACKET option: %d\n", option);
+      return -ENOPROTOOPT;
+    }
+
+  if (value == NULL || value_len < sizeof(struct tpacket_req))
+    {
+      return -EINVAL;
+    }
+
+  conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  req  = (FAR const struct tpacket_req *)value;
+
+  /* tp_block_nr == 0 releases the ring */
+
+  if (req->tp_block_nr == 0)
+    {
+      net_lock();
+      pkt_ring_free(conn);
+      net_unlock();
+      return OK;
+    }
+
+  return pkt_ring_setup(conn, req);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame in dev->d_buf into the next free frame of the receive
+ *   ring of 'conn'.  The frame is dropped if the ring is full.
+ *
+ * Returned Value:
+ *   OK if the connection has a receive ring (whether or not the frame was
+ *   kept); -ENOENT if the connection has no receive ring.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int pkt_ring_input(FAR struct net_driver_s *dev,
+                   FAR struct pkt_conn_s *conn)
+{
+  FAR struct tpacket_hdr *hdr;
+  struct timespec ts;
+  unsigned long status;
+  uint16_t snaplen;
+
+  if (conn->rxring == NULL)
+    {
+      return -ENOENT;
+    }
+
+  hdr = PKT_RING_FRAME(conn, conn->rxhead);
+  if (hdr->tp_status != TP_STATUS_KERNEL)
+    {
+      /* The application has not yet released this frame; the ring is
+       * full.
+       */
+
+      ninfo("RX ring full, frame dropped\n");
+      conn->losing = true;
+      return OK;
+    }
+
+  status  = TP_STATUS_USER;
+  snaplen = dev->d_len;
+
+  if (snaplen > conn->framesize - TPACKET_HDRLEN)
+    {
+      snaplen = conn->framesize - TPACKET_HDRLEN;
+      status |= TP_STATUS_COPY;
+    }
+
+  if (conn->losing)
+    {
+      status      |= TP_STATUS_LOSING;
+      conn->losing = false;
+    }
+
+  memcpy((FAR uint8_t *)hdr + TPACKET_HDRLEN, dev->d_buf, snaplen);
+
+  (void)clock_gettime(CLOCK_REALTIME, &ts);
+
+  hdr->tp_len     = dev->d_len;
+  hdr->tp_snaplen = snaplen;
+  hdr->tp_mac     = TPACKET_HDRLEN;
+  hdr->tp_net     = TPACKET_HDRLEN + ETH_HDRLEN;
+  hdr->tp_sec     = ts.tv_sec;
+  hdr->tp_usec    = ts.tv_nsec / 1000;
+
+  /* The status is set last:  The frame now belongs to the application */
+
+  hdr->tp_status  = status;
+
+  if (++conn->rxhead >= conn->nframes)
+    {
+      conn->rxhead = 0;
+    }
+
+#ifndef CONFIG_DISABLE_POLL
+  /* Wake up any poll() waiting for a frame */
+
+  if (conn->fds != NULL && (conn->fds->events & POLLIN) != 0)
+    {
+      conn->fds->revents |= POLLIN;
+      nxsem_post(conn->fds->sem);
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_mmap
+ *
+ * Description:
+ *   Return the address of the receive ring in response to FIOC_MMAP.
+ *
+ * Returned Value:
+ *   OK on success; -ENODEV if no ring has been set up.
+ *
+ ****************************************************************************/
+
+int pkt_ring_mmap(FAR struct pkt_conn_s *conn, FAR void **addr)
+{
+  if (conn->rxring == NULL)
+    {
+      return -ENODEV;
+    }
+
+  *addr = conn->rxring;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down a poll for a filled frame in the receive ring.
+ *
+ * Returned Value:
+ *   OK on success; -ENOSYS if the connection has no receive ring; -EBUSY if
+ *   another poll is already waiting on the ring.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup)
+{
+  int ret = OK;
+
+  net_lock();
+  if (conn->rxring == NULL)
+    {
+      ret = -ENOSYS;
+    }
+  else if (setup)
+    {
+      if (conn->fds != NULL)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          conn->fds = fds;
+
+          /* Report immediately if a frame is already waiting */
+
+          if ((fds->events & POLLIN) != 0 && pkt_ring_readable(conn))
+            {
+              fds->revents |= POLLIN;
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+  else if (conn->fds == fds)
+    {
+      conn->fds = NULL;
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_free
+ *
+ * Description:
+ *   Release the receive ring of a connection, if any.
+ *
+ ****************************************************************************/
+
+void pkt_ring_free(FAR struct pkt_conn_s *conn)
+{
+  if (conn->rxring != NULL)
+    {
+      kumm_free(conn->rxring);
+      conn->rxring   = NULL;
+      conn->ringsize = 0;
+      conn->nframes  = 0;
+      conn->rxhead   = 0;
+    }
+
+#ifndef CONFIG_DISABLE_POLL
+  conn->fds = NULL;
+#endif
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_PKT_RING */
@@ -521,7 +521,13 @@ int pkt_listen(FAR struct socket *psock, int backlog)
 static int pkt_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
                           bool setup)
 {
+#ifdef CONFIG_NET_PKT_RING
+  /* Only a socket with a receive ring can be polled */
+
+  return pkt_ring_poll((FAR struct pkt_conn_s *)psock->s_conn, fds, setup);
+#else
   return -ENOSYS;
+#endif
 }
 #endif /* !CONFIG_DISABLE_POLL */
 
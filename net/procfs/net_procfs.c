@@ -75,12 +75,19 @@
 #  define STAT_INDEX     0
 #  ifdef CONFIG_NET_MLD
 #    define MLD_INDEX    1
-#    define _ROUTE_INDEX 2
+#    define _LAT_INDEX   2
 #  else
-#    define _ROUTE_INDEX 1
+#    define _LAT_INDEX   1
 #  endif
 #else
-#  define _ROUTE_INDEX   0
+#  define _LAT_INDEX     0
+#endif
+
+#ifdef CONFIG_NET_LATENCY
+#  define LATENCY_INDEX  _LAT_INDEX
+#  define _ROUTE_INDEX   (_LAT_INDEX + 1)
+#else
+#  define _ROUTE_INDEX   _LAT_INDEX
 #endif
 
 #ifdef CONFIG_NET_ROUTE
@@ -193,6 +200,19 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
 #endif
 #endif
 
+#ifdef CONFIG_NET_LATENCY
+  /* "net/latency" is an acceptable value for the relpath only if packet
+   * latency tracing is enabled.
+   */
+
+  if (strcmp(relpath, "net/latency") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_LATENCY;
+      dev   = NULL;
+    }
+  else
+#endif
+
 #ifdef CONFIG_NET_ROUTE
   /* "net/route" is an acceptable value for the relpath only if routing
    * table support is initialized.
@@ -320,6 +340,14 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
 #endif
 #endif
 
+#ifdef CONFIG_NET_LATENCY
+      case NETPROCFS_SUBDIR_LATENCY:
+        /* Show the packet latency histograms */
+
+        nreturned = netprocfs_read_latency(priv, buffer, buflen);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -440,6 +468,9 @@ static int netprocfs_opendir(FAR const char *relpath,
       level1->base.nentries++;
 #endif
 #endif
+#ifdef CONFIG_NET_LATENCY
+      level1->base.nentries++;
+#endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
 #endif
@@ -546,6 +577,16 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
       else
 #endif
 #endif
+#ifdef CONFIG_NET_LATENCY
+      if (index == LATENCY_INDEX)
+        {
+          /* Copy the packet latency directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "latency", NAME_MAX + 1);
+        }
+      else
+#endif
 #ifdef CONFIG_NET_ROUTE
       if (index == ROUTE_INDEX)
         {
@@ -677,6 +718,15 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
   else
 #endif
 #endif
+#ifdef CONFIG_NET_LATENCY
+  /* Check for packet latency histograms "net/latency" */
+
+  if (strcmp(relpath, "net/latency") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
 #ifdef CONFIG_NET_ROUTE
   /* Check for network statistics "net/stat" */
 
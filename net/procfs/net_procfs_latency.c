@@ -0,0 +1,275 @@
+/****************************************************************************
+ * net/procfs/net_procfs_latency.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Output format (one column per stage, latencies in microseconds):
+ *
+ *   usec        driver         ip        tcp       recv      total
+ *   <2      xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx
+ *   ...
+ *   >=32768 xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx
+ *   count   xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx
+ *   mean    xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx
+ *   max     xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx xxxxxxxxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <debug.h>
+
+#include <nuttx/net/netlatency.h>
+
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_LATENCY)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static int netprocfs_latency_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_bucket(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_count(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_mean(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_max(FAR struct netprocfs_file_s *netfile);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions.  The bucket lines must immediately follow the
+ * header line:  The bucket index is derived from the line number.
+ */
+
+static const linegen_t g_latency_linegen[] =
+{
+  netprocfs_latency_header,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_count,
+  netprocfs_latency_mean,
+  netprocfs_latency_max
+};
+
+#define NLATENCY_LINES (sizeof(g_latency_linegen) / sizeof(linegen_t))
+
+#if NET_LATENCY_NBUCKETS != 16
+#  error g_latency_linegen[] must have one bucket line for each bucket
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_latency_values
+ *
+ * Description:
+ *   Format a label followed by one value for each stage.
+ *
+ ****************************************************************************/
+
+static int netprocfs_latency_values(FAR struct netprocfs_file_s *netfile,
+                                    FAR const char *label,
+                                    FAR const uint32_t *values)
+{
+  int len;
+  int i;
+
+  len = snprintf(netfile->line, NET_LINELEN, "%-7s", label);
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %10lu",
+                      (unsigned long)values[i]);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_header
+ ****************************************************************************/
+
+static int netprocfs_latency_header(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "%-7s %10s %10s %10s %10s %10s\n",
+                  "usec", "driver", "ip", "tcp", "recv", "total");
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_bucket
+ ****************************************************************************/
+
+static int netprocfs_latency_bucket(FAR struct netprocfs_file_s *netfile)
+{
+  uint32_t values[NET_LATENCY_NSTAGES];
+  char label[8];
+  int bucket;
+  int i;
+
+  /* Line 0 is the header, so bucket n is on line n + 1.  lineno is
+   * incremented only after the line has been generated.
+   */
+
+  bucket = netfile->lineno - 1;
+  DEBUGASSERT(bucket >= 0 && bucket < NET_LATENCY_NBUCKETS);
+
+  if (bucket < NET_LATENCY_NBUCKETS - 1)
+    {
+      snprintf(label, sizeof(label), "<%lu", 2ul << bucket);
+    }
+  else
+    {
+      snprintf(label, sizeof(label), ">=%lu", 1ul << bucket);
+    }
+
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      values[i] = g_netlatency[i].lh_bucket[bucket];
+    }
+
+  return netprocfs_latency_values(netfile, label, values);
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_count
+ ****************************************************************************/
+
+static int netprocfs_latency_count(FAR struct netprocfs_file_s *netfile)
+{
+  uint32_t values[NET_LATENCY_NSTAGES];
+  int i;
+
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      values[i] = g_netlatency[i].lh_count;
+    }
+
+  return netprocfs_latency_values(netfile, "count", values);
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_mean
+ ****************************************************************************/
+
+static int netprocfs_latency_mean(FAR struct netprocfs_file_s *netfile)
+{
+  uint32_t values[NET_LATENCY_NSTAGES];
+  int i;
+
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      FAR struct net_lathist_s *hist = &g_netlatency[i];
+
+      values[i] = hist->lh_count > 0 ?
+                  (uint32_t)(hist->lh_total / hist->lh_count) : 0;
+    }
+
+  return netprocfs_latency_values(netfile, "mean", values);
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_max
+ ****************************************************************************/
+
+static int netprocfs_latency_max(FAR struct netprocfs_file_s *netfile)
+{
+  uint32_t values[NET_LATENCY_NSTAGES];
+  int i;
+
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      values[i] = g_netlatency[i].lh_max;
+    }
+
+  return netprocfs_latency_values(netfile, "max", values);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_latency
+ *
+ * Description:
+ *   Read and format the packet latency histograms.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_latency(FAR struct netprocfs_file_s *priv,
+                               FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_linegen(priv, buffer, buflen, g_latency_linegen,
+                                NLATENCY_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_LATENCY */
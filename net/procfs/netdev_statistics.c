@@ -78,6 +78,10 @@ static int netprocfs_rxpackets_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NETDEV_NAPI
+static int netprocfs_napistatistics_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_napistatistics(FAR struct netprocfs_file_s *netfile);
+#endif
 static int netprocfs_errors(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NETDEV_STATISTICS */
 
@@ -108,6 +112,10 @@ static const linegen_t g_netstat_linegen[] =
   netprocfs_rxpackets,
   netprocfs_txstatistics_header,
   netprocfs_txstatistics,
+#ifdef CONFIG_NETDEV_NAPI
+  netprocfs_napistatistics_header,
+  netprocfs_napistatistics,
+#endif
   netprocfs_errors
 #endif /* CONFIG_NETDEV_STATISTICS */
 };
@@ -523,6 +531,42 @@ static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
+/****************************************************************************
+ * Name: netprocfs_napistatistics_header
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_NAPI)
+static int netprocfs_napistatistics_header(FAR struct netprocfs_file_s *netfile)
+{
+  DEBUGASSERT(netfile != NULL);
+
+  return snprintf(netfile->line, NET_LINELEN, "\tNAPI: %-8s %-8s %-8s %-8s\n",
+                 "Sched", "Polls", "Budget", "Holdoff");
+}
+#endif /* CONFIG_NETDEV_STATISTICS && CONFIG_NETDEV_NAPI */
+
+/****************************************************************************
+ * Name: netprocfs_napistatistics
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_NAPI)
+static int netprocfs_napistatistics(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct netdev_statistics_s *stats;
+  FAR struct net_driver_s *dev;
+
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+  dev = netfile->dev;
+  stats = &dev->d_statistics;
+
+  return snprintf(netfile->line, NET_LINELEN, "\t      %08lx %08lx %08lx %08lx\n",
+                  (unsigned long)stats->napi_scheds,
+                  (unsigned long)stats->napi_polls,
+                  (unsigned long)stats->napi_exhausted,
+                  (unsigned long)stats->napi_holdoffs);
+}
+#endif /* CONFIG_NETDEV_STATISTICS && CONFIG_NETDEV_NAPI */
+
 /****************************************************************************
  * Name: netprocfs_errors
  ****************************************************************************/
@@ -49,6 +49,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "route/cacheroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -99,6 +100,15 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   (void)net_closeroute_ipv4(&fshandle);
+
+#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
+  /* The new route may be a better match for destinations that are already
+   * in the routing table cache.
+   */
+
+  net_flushcache_ipv4();
+#endif
+
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -133,6 +143,15 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   (void)net_closeroute_ipv6(&fshandle);
+
+#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
+  /* The new route may be a better match for destinations that are already
+   * in the routing table cache.
+   */
+
+  net_flushcache_ipv6();
+#endif
+
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -48,6 +48,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/cacheroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -126,6 +127,12 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
 
       net_freeroute_ipv4(route);
 
+#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
+      /* Cached results may refer to the deleted route */
+
+      net_flushcache_ipv4();
+#endif
+
       /* Return a non-zero value to terminate the traversal */
 
       return 1;
@@ -179,6 +186,12 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
 
       net_freeroute_ipv6(route);
 
+#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
+      /* Cached results may refer to the deleted route */
+
+      net_flushcache_ipv6();
+#endif
+
       /* Return a non-zero value to terminate the traversal */
 
       return 1;
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <errno.h>
 
@@ -48,27 +49,12 @@
 #include <nuttx/net/ip.h>
 
 #include "devif/devif.h"
+#include "utils/utils.h"
 #include "route/cacheroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
 
-/****************************************************************************
- * Pre-processor defintions
- ****************************************************************************/
-
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-#  define IPv4_ROUTER entry.router
-#else
-#  define IPv4_ROUTER router
-#endif
-
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-#  define IPv6_ROUTER entry.router
-#else
-#  define IPv6_ROUTER router
-#endif
-
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -77,11 +63,9 @@
 struct route_ipv4_match_s
 {
   in_addr_t target;              /* Target IPv4 address on remote network */
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-  struct net_route_ipv4_s entry; /* Full entry from the IPv4 routing table */
-#else
+  in_addr_t netmask;             /* Network mask of the best match so far */
   in_addr_t router;              /* IPv4 address of router a local networks */
-#endif
+  bool found;                    /* True if a matching route was found */
 };
 #endif
 
@@ -89,11 +73,9 @@ struct route_ipv4_match_s
 struct route_ipv6_match_s
 {
   net_ipv6addr_t target;         /* Target IPv6 address on remote network */
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-  struct net_route_ipv6_s entry; /* Full entry from the IPv6 routing table */
-#else
+  uint8_t preflen;               /* Prefix length of the best match so far */
   net_ipv6addr_t router;         /* IPv6 address of router a local networks */
-#endif
+  bool found;                    /* True if a matching route was found */
 };
 #endif
 
@@ -105,14 +87,15 @@ struct route_ipv6_match_s
  * Name: net_ipv4_match
  *
  * Description:
- *   Return 1 if the IPv4 route is available
+ *   Remember the IPv4 route if it is the longest prefix match so far
  *
  * Input Parameters:
  *   route - The next route to examine
  *   arg   - The match values (cast to void*)
  *
  * Returned Value:
- *   0 if the entry is not a match; 1 if the entry matched and was cleared.
+ *   0 to continue the search; 1 if the entry is a host route for the
+ *   target and no better match is possible.
  *
  ****************************************************************************/
 
@@ -122,22 +105,21 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
   FAR struct route_ipv4_match_s *match = (FAR struct route_ipv4_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, the route with the longest network mask wins.
    */
 
-  if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask))
+  if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask) &&
+      (!match->found || NTOHL(route->netmask) > NTOHL(match->netmask)))
     {
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-      /* They match.. Copy the entire routing table entry */
-
-      memcpy(&match->entry, route, sizeof(struct net_route_ipv4_s));
-#else
       /* They match.. Copy the router address */
 
       net_ipv4addr_copy(match->router, route->router);
-#endif
-      return 1;
+      net_ipv4addr_copy(match->netmask, route->netmask);
+      match->found = true;
+
+      /* A host route cannot be improved upon */
+
+      return net_ipv4addr_cmp(route->netmask, INADDR_NONE) ? 1 : 0;
     }
 
   return 0;
@@ -148,14 +130,15 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
  * Name: net_ipv6_match
  *
  * Description:
- *   Return 1 if the IPv6 route is available
+ *   Remember the IPv6 route if it is the longest prefix match so far
  *
  * Input Parameters:
  *   route - The next route to examine
  *   arg   - The match values (cast to void*)
  *
  * Returned Value:
- *   0 if the entry is not a match; 1 if the entry matched and was cleared.
+ *   0 to continue the search; 1 if the entry is a host route for the
+ *   target and no better match is possible.
  *
  ****************************************************************************/
 
@@ -163,24 +146,27 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
 static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 {
   FAR struct route_ipv6_match_s *match = (FAR struct route_ipv6_match_s *)arg;
+  uint8_t preflen;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, the route with the longest prefix wins.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask))
     {
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-      /* They match.. Copy the entire routing table entry */
+      preflen = net_ipv6_mask2pref(route->netmask);
+      if (!match->found || preflen > match->preflen)
+        {
+          /* They match.. Copy the router address */
 
-      memcpy(&match->entry, route, sizeof(struct net_route_ipv6_s));
-#else
-      /* They match.. Copy the router address */
+          net_ipv6addr_copy(match->router, route->router);
+          match->preflen = preflen;
+          match->found   = true;
 
-      net_ipv6addr_copy(match->router, route->router);
-#endif
-      return 1;
+          /* A host route cannot be improved upon */
+
+          return preflen >= 128 ? 1 : 0;
+        }
     }
 
   return 0;
@@ -197,6 +183,8 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
  * Description:
  *   Given an IPv4 address on a external network, return the address of the
  *   router on a local network that can forward to the external network.
+ *   If several routes match, the one with the longest network mask is
+ *   used.
  *
  * Input Parameters:
  *   target - An IPv4 address on a remote network to use in the lookup.
@@ -227,41 +215,49 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
   net_ipv4addr_copy(match.target, target);
 
 #ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-  /* First see if we can find a router entry in the cache */
+  /* First see if the result for this destination is in the cache.  The
+   * cache holds only host routes, so any hit is the final answer.
+   */
 
   ret = net_foreachcache_ipv4(net_ipv4_match, &match);
-  if (ret <= 0)
+  if (ret < 0 || !match.found)
 #endif
     {
-      /* Not found in the cache.  Try to find a router entry with the
-       * routing table that can forward to this address
+      /* Not found in the cache.  Find the best router entry in the routing
+       * table that can forward to this address
        */
 
       ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+
+#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
+      if (ret >= 0 && match.found)
+        {
+          struct net_route_ipv4_s entry;
+
+          /* Add the result to the cache as a host route for the target so
+           * that the next lookup does not need to search the table.
+           */
+
+          net_ipv4addr_copy(entry.target, target);
+          net_ipv4addr_copy(entry.netmask, INADDR_NONE);
+          net_ipv4addr_copy(entry.router, match.router);
+          (void)net_addcache_ipv4(&entry);
+        }
+#endif
     }
 
   /* Did we find a route? */
 
-  if (ret <= 0)
+  if (ret < 0 || !match.found)
     {
       /* No.. there is no route for this address */
 
       return -ENOENT;
     }
 
-  /* We found a route. */
-
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-  /* Add the route to the cache.  If the route is already in the cache, this
-   * will update it to the most recently accessed.
-   */
-
-  (void)net_addcache_ipv4(&match.entry);
-#endif
-
-  /* Return the router address. */
+  /* We found a route.  Return the router address. */
 
-  net_ipv4addr_copy(*router, match.IPv4_ROUTER);
+  net_ipv4addr_copy(*router, match.router);
   return OK;
 }
 #endif /* CONFIG_NET_IPv4 */
@@ -272,6 +268,7 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
  * Description:
  *   Given an IPv6 address on a external network, return the address of the
  *   router on a local network that can forward to the external network.
+ *   If several routes match, the one with the longest prefix is used.
  *
  * Input Parameters:
  *   target - An IPv6 address on a remote network to use in the lookup.
@@ -302,41 +299,49 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
   net_ipv6addr_copy(match.target, target);
 
 #ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-  /* First see if we can find a router entry in the cache */
+  /* First see if the result for this destination is in the cache.  The
+   * cache holds only host routes, so any hit is the final answer.
+   */
 
   ret = net_foreachcache_ipv6(net_ipv6_match, &match);
-  if (ret <= 0)
+  if (ret < 0 || !match.found)
 #endif
     {
-      /* Not found in the cache.  Try to find a router entry with the
-       * routing table that can forward to this address
+      /* Not found in the cache.  Find the best router entry in the routing
+       * table that can forward to this address
        */
 
       ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+
+#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
+      if (ret >= 0 && match.found)
+        {
+          struct net_route_ipv6_s entry;
+
+          /* Add the result to the cache as a host route for the target so
+           * that the next lookup does not need to search the table.
+           */
+
+          net_ipv6addr_copy(entry.target, target);
+          net_ipv6_pref2mask(128, entry.netmask);
+          net_ipv6addr_copy(entry.router, match.router);
+          (void)net_addcache_ipv6(&entry);
+        }
+#endif
     }
 
   /* Did we find a route? */
 
-  if (ret <= 0)
+  if (ret < 0 || !match.found)
     {
       /* No.. there is no route for this address */
 
       return -ENOENT;
     }
 
-  /* We found a route. */
-
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-  /* Add the route to the cache.  If the route is already in the cache, this
-   * will update it to the most recently accessed.
-   */
-
-  (void)net_addcache_ipv6(&match.entry);
-#endif
-
-  /* Return the router address. */
+  /* We found a route.  Return the router address. */
 
-  net_ipv6addr_copy(router, match.IPv6_ROUTER);
+  net_ipv6addr_copy(router, match.router);
   return OK;
 }
 #endif /* CONFIG_NET_IPv6 */
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <errno.h>
 
@@ -47,27 +48,12 @@
 #include <nuttx/net/ip.h>
 
 #include "netdev/netdev.h"
+#include "utils/utils.h"
 #include "route/cacheroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
 
-/****************************************************************************
- * Pre-processor defintions
- ****************************************************************************/
-
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-#  define IPv4_ROUTER entry.router
-#else
-#  define IPv4_ROUTER router
-#endif
-
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-#  define IPv6_ROUTER entry.router
-#else
-#  define IPv6_ROUTER router
-#endif
-
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -77,11 +63,9 @@ struct route_ipv4_devmatch_s
 {
   FAR struct net_driver_s *dev;  /* The route must use this device */
   in_addr_t target;              /* Target IPv4 address on remote network */
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-  struct net_route_ipv4_s entry; /* Full entry from the IPv4 routing table */
-#else
+  in_addr_t netmask;             /* Network mask of the best match so far */
   in_addr_t router;              /* IPv4 address of router a local networks */
-#endif
+  bool found;                    /* True if a matching route was found */
 };
 #endif
 
@@ -90,11 +74,9 @@ struct route_ipv6_devmatch_s
 {
   FAR struct net_driver_s *dev;  /* The route must use this device */
   net_ipv6addr_t target;         /* Target IPv4 address on remote network */
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-  struct net_route_ipv6_s entry; /* Full entry from the IPv6 routing table */
-#else
+  uint8_t preflen;               /* Prefix length of the best match so far */
   net_ipv6addr_t router;         /* IPv6 address of router a local networks */
-#endif
+  bool found;                    /* True if a matching route was found */
 };
 #endif
 
@@ -106,14 +88,16 @@ struct route_ipv6_devmatch_s
  * Name: net_ipv4_devmatch
  *
  * Description:
- *   Return 1 if the IPv4 route is available on the device's network.
+ *   Remember the IPv4 route if it is available on the device's network and
+ *   is the longest prefix match so far.
  *
  * Input Parameters:
  *   route - The next route to examine
  *   arg   - The match values (cast to void*)
  *
  * Returned Value:
- *   0 if the entry is not a match; 1 if the entry matched and was cleared.
+ *   0 to continue the search; 1 if the entry is a host route for the
+ *   target and no better match is possible.
  *
  ****************************************************************************/
 
@@ -128,23 +112,23 @@ static int net_ipv4_devmatch(FAR struct net_route_ipv4_s *route,
   /* To match, (1) the masked target addresses must be the same, and (2) the
    * router address must like on the network provided by the device.
    *
-   * In the event of multiple matches, only the first is returned.  There
-   * not (yet) any concept for the precedence of networks.
+   * In the event of multiple matches, the route with the longest network
+   * mask wins.
    */
 
   if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask) &&
-      net_ipv4addr_maskcmp(route->router, dev->d_ipaddr, dev->d_netmask))
+      net_ipv4addr_maskcmp(route->router, dev->d_ipaddr, dev->d_netmask) &&
+      (!match->found || NTOHL(route->netmask) > NTOHL(match->netmask)))
     {
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-      /* They match.. Copy the entire routing table entry */
-
-      memcpy(&match->entry, route, sizeof(struct net_route_ipv4_s));
-#else
       /* They match.. Copy the router address */
 
       net_ipv4addr_copy(match->router, route->router);
-#endif
-      return 1;
+      net_ipv4addr_copy(match->netmask, route->netmask);
+      match->found = true;
+
+      /* A host route cannot be improved upon */
+
+      return net_ipv4addr_cmp(route->netmask, INADDR_NONE) ? 1 : 0;
     }
 
   return 0;
@@ -155,14 +139,16 @@ static int net_ipv4_devmatch(FAR struct net_route_ipv4_s *route,
  * Name: net_ipv6_devmatch
  *
  * Description:
- *   Return 1 if the IPv6 route is available on the device's network.
+ *   Remember the IPv6 route if it is available on the device's network and
+ *   is the longest prefix match so far.
  *
  * Input Parameters:
  *   route - The next route to examine
  *   arg   - The match values (cast to void*)
  *
  * Returned Value:
- *   0 if the entry is not a match; 1 if the entry matched and was cleared.
+ *   0 to continue the search; 1 if the entry is a host route for the
+ *   target and no better match is possible.
  *
  ****************************************************************************/
 
@@ -173,28 +159,32 @@ static int net_ipv6_devmatch(FAR struct net_route_ipv6_s *route,
   FAR struct route_ipv6_devmatch_s *match =
     (FAR struct route_ipv6_devmatch_s *)arg;
   FAR struct net_driver_s *dev = match->dev;
+  uint8_t preflen;
 
   /* To match, (1) the masked target addresses must be the same, and (2) the
    * router address must like on the network provided by the device.
    *
-   * In the event of multiple matches, only the first is returned.  There
-   * not (yet) any concept for the precedence of networks.
+   * In the event of multiple matches, the route with the longest prefix
+   * wins.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask) &&
       net_ipv6addr_maskcmp(route->router, dev->d_ipv6addr,
                            dev->d_ipv6netmask))
     {
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-      /* They match.. Copy the entire routing table entry */
+      preflen = net_ipv6_mask2pref(route->netmask);
+      if (!match->found || preflen > match->preflen)
+        {
+          /* They match.. Copy the router address */
 
-      memcpy(&match->entry, route, sizeof(struct net_route_ipv6_s));
-#else
-      /* They match.. Copy the router address */
+          net_ipv6addr_copy(match->router, route->router);
+          match->preflen = preflen;
+          match->found   = true;
 
-      net_ipv6addr_copy(match->router, route->router);
-#endif
-      return 1;
+          /* A host route cannot be improved upon */
+
+          return preflen >= 128 ? 1 : 0;
+        }
     }
 
   return 0;
@@ -240,10 +230,15 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
   net_ipv4addr_copy(match.target, target);
 
 #ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-  /* First see if we can find a router entry in the cache */
+  /* First see if we can find a router entry in the cache.  The cache holds
+   * the best route overall for each destination; if that route is on this
+   * device's network, it is also the best route for this device.  The
+   * result of the constrained search below is not cached because it may
+   * differ from the unconstrained one.
+   */
 
   ret = net_foreachcache_ipv4(net_ipv4_devmatch, &match);
-  if (ret <= 0)
+  if (ret < 0 || !match.found)
 #endif
     {
       /* Not found in the cache.  Try to find a router entry with the
@@ -255,21 +250,11 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
 
   /* Did we find a route? */
 
-  if (ret > 0)
+  if (ret >= 0 && match.found)
     {
-      /* We found a route. */
+      /* We found a route.  Return the router address. */
 
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
-      /* Add the route to the cache.  If the route is already in the cache,
-       * this will update it to the most recently accessed.
-       */
-
-      ret = net_addcache_ipv4(&match.entry);
-#endif
-
-      /* We Return the router address. */
-
-      net_ipv4addr_copy(*router, match.IPv4_ROUTER);
+      net_ipv4addr_copy(*router, match.router);
     }
   else
     {
@@ -319,10 +304,12 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
   net_ipv6addr_copy(match.target, target);
 
 #ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-  /* First see if we can find a router entry in the cache */
+  /* First see if we can find a router entry in the cache (see
+   * netdev_ipv4_router() for why a hit is valid for this device).
+   */
 
   ret = net_foreachcache_ipv6(net_ipv6_devmatch, &match);
-  if (ret <= 0)
+  if (ret < 0 || !match.found)
 #endif
     {
       /* Not found in the cache.  Try to find a router entry with the
@@ -334,20 +321,11 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
 
   /* Did we find a route? */
 
-  if (ret > 0)
+  if (ret >= 0 && match.found)
     {
-      /* We found a route. */
-
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
-      /* Add the route to the cache.  If the route is already in the cache,
-       * this will update it to the most recently accessed.
-       */
-
-      ret = net_addcache_ipv6(&match.entry);
-#endif
-      /* Return the router address. */
+      /* We found a route.  Return the router address. */
 
-      net_ipv6addr_copy(router, match.IPv6_ROUTER);
+      net_ipv6addr_copy(router, match.router);
     }
   else
     {
@@ -60,6 +60,18 @@
 
 #define NET_6LOWPAN_TIMEOUT SEC2TICK(CONFIG_NET_6LOWPAN_MAXAGE)
 
+/* Size of the reassembly hash table */
+
+#ifndef CONFIG_NET_6LOWPAN_REASS_NHASH
+#  define CONFIG_NET_6LOWPAN_REASS_NHASH 8
+#endif
+
+#if (CONFIG_NET_6LOWPAN_REASS_NHASH & (CONFIG_NET_6LOWPAN_REASS_NHASH - 1)) != 0
+#  error CONFIG_NET_6LOWPAN_REASS_NHASH must be a power of two
+#endif
+
+#define REASS_HASH_MASK (CONFIG_NET_6LOWPAN_REASS_NHASH - 1)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -75,12 +87,17 @@ static FAR struct sixlowpan_reassbuf_s *g_free_reass;
 
 static FAR struct sixlowpan_reassbuf_s *g_active_reass;
 
+/* Active reassembly buffers hashed by reassembly tag and source address */
+
+static FAR struct sixlowpan_reassbuf_s *
+  g_reass_hash[CONFIG_NET_6LOWPAN_REASS_NHASH];
+
 /* Pool of pre-allocated reassembly buffer stuctures */
 
 static struct sixlowpan_reassbuf_s g_metadata_pool[CONFIG_NET_6LOWPAN_NREASSBUF];
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
@@ -115,6 +132,74 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
   return false;
 }
 
+/****************************************************************************
+ * Name: sixlowpan_reass_hash
+ *
+ * Description:
+ *   Return the hash bucket for a reassembly tag and fragment source address.
+ *
+ * Input Parameters:
+ *   reasstag - The reassembly tag.
+ *   fragsrc  - The source address of the fragment.
+ *
+ * Returned Value:
+ *   A reference to the head of the hash chain.
+ *
+ ****************************************************************************/
+
+static FAR struct sixlowpan_reassbuf_s **
+  sixlowpan_reass_hash(uint16_t reasstag,
+                       FAR const struct netdev_varaddr_s *fragsrc)
+{
+  uint32_t hash = reasstag;
+  int i;
+
+  for (i = 0; i < fragsrc->nv_addrlen; i++)
+    {
+      hash = hash * 31 + fragsrc->nv_addr[i];
+    }
+
+  hash ^= hash >> 16;
+  return &g_reass_hash[hash & REASS_HASH_MASK];
+}
+
+/****************************************************************************
+ * Name: sixlowpan_reass_expired
+ *
+ * Description:
+ *   Check if a reassembly buffer is no longer usable, either because the
+ *   reassembly completed or because it has timed out.
+ *
+ * Input Parameters:
+ *   reass - The reassembly buffer to check.
+ *
+ * Returned Value:
+ *   true if the reassembly buffer should be freed.
+ *
+ ****************************************************************************/
+
+static bool sixlowpan_reass_expired(FAR struct sixlowpan_reassbuf_s *reass)
+{
+  /* Free any inactive reassembly buffers.  This is done because the life
+   * the reassembly buffer is not cerain.
+   */
+
+  if (!reass->rb_active)
+    {
+      return true;
+    }
+
+  /* If the reassembly has expired, then free the reassembly buffer */
+
+  if (clock_systimer() - reass->rb_time > NET_6LOWPAN_TIMEOUT)
+    {
+      nwarn("WARNING: Reassembly timed out\n");
+      return true;
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Name: sixlowpan_reass_expire
  *
@@ -136,7 +221,6 @@ static void sixlowpan_reass_expire(void)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
   FAR struct sixlowpan_reassbuf_s *next;
-  clock_t elapsed;
 
   /* If reassembly timed out, cancel it */
 
@@ -146,28 +230,10 @@ static void sixlowpan_reass_expire(void)
 
       next = reass->rb_flink;
 
-      /* Free any inactive reassembly buffers.  This is done because the life
-       * the reassembly buffer is not cerain.
-       */
-
-      if (!reass->rb_active)
+      if (sixlowpan_reass_expired(reass))
         {
           sixlowpan_reass_free(reass);
         }
-      else
-        {
-          /* Get the elpased time of the reassembly */
-
-          elapsed = clock_systimer() - reass->rb_time;
-
-          /* If the reassembly has expired, then free the reassembly buffer */
-
-          if (elapsed > NET_6LOWPAN_TIMEOUT)
-            {
-              nwarn("WARNING: Reassembly timed out\n");
-              sixlowpan_reass_free(reass);
-            }
-        }
     }
 }
 
@@ -220,6 +286,40 @@ static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
   reass->rb_flink = NULL;
 }
 
+/****************************************************************************
+ * Name: sixlowpan_remove_hashed
+ *
+ * Description:
+ *   Remove a reassembly buffer from its hash chain.
+ *
+ * Input Parameters:
+ *   reass - The reassembly buffer to be removed.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void sixlowpan_remove_hashed(FAR struct sixlowpan_reassbuf_s *reass)
+{
+  FAR struct sixlowpan_reassbuf_s **link;
+
+  link = sixlowpan_reass_hash(reass->rb_reasstag, &reass->rb_fragsrc);
+  for (; *link != NULL; link = &(*link)->rb_hlink)
+    {
+      if (*link == reass)
+        {
+          *link = reass->rb_hlink;
+          break;
+        }
+    }
+
+  reass->rb_hlink = NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -251,6 +351,8 @@ void sixlowpan_reass_initialize(void)
    * available for allocation.
    */
 
+  memset(g_reass_hash, 0, sizeof(g_reass_hash));
+
   g_free_reass = NULL;
   for (i = 0, reass = g_metadata_pool;
        i < CONFIG_NET_6LOWPAN_NREASSBUF;
@@ -294,6 +396,7 @@ FAR struct sixlowpan_reassbuf_s *
   sixlowpan_reass_allocate(uint16_t reasstag,
                            FAR const struct netdev_varaddr_s *fragsrc)
 {
+  FAR struct sixlowpan_reassbuf_s **bucket;
   FAR struct sixlowpan_reassbuf_s *reass;
   uint8_t pool;
 
@@ -303,6 +406,16 @@ FAR struct sixlowpan_reassbuf_s *
 
   sixlowpan_reass_expire();
 
+  /* A repeated first fragment restarts the reassembly.  Release the stale
+   * buffer now rather than letting it hold a buffer until it times out.
+   */
+
+  reass = sixlowpan_reass_find(reasstag, fragsrc);
+  if (reass != NULL)
+    {
+      sixlowpan_reass_free(reass);
+    }
+
   /* Now, try the free list first */
 
   if (g_free_reass != NULL)
@@ -343,6 +456,12 @@ FAR struct sixlowpan_reassbuf_s *
 
       reass->rb_flink   = g_active_reass;
       g_active_reass    = reass;
+
+      /* And index it for sixlowpan_reass_find() */
+
+      bucket            = sixlowpan_reass_hash(reasstag, fragsrc);
+      reass->rb_hlink   = *bucket;
+      *bucket           = reass;
     }
 
   return reass;
@@ -373,17 +492,13 @@ FAR struct sixlowpan_reassbuf_s *
 {
   FAR struct sixlowpan_reassbuf_s *reass;
 
-  /* First, removed any expired or inactive reassembly buffers (we don't want
-   * to return old reassembly buffer with the same tag)
+  /* Search the hash chain for the matching reassembly buffer.  Only this
+   * chain is examined; other expired buffers are collected when the next
+   * reassembly buffer is allocated.
    */
 
-  sixlowpan_reass_expire();
-
-  /* Now search for the matching reassembly buffer in the remainng, active
-   * reassembly buffers.
-   */
-
-  for (reass = g_active_reass; reass != NULL; reass = reass->rb_flink)
+  reass = *sixlowpan_reass_hash(reasstag, fragsrc);
+  for (; reass != NULL; reass = reass->rb_hlink)
     {
       /* In order to be a match, it must have the same reassembly tag as
        * well as source address (different sources might use the same
@@ -393,6 +508,16 @@ FAR struct sixlowpan_reassbuf_s *
       if (reass->rb_reasstag == reasstag &&
           sixlowpan_compare_fragsrc(reass, fragsrc))
         {
+          /* We don't want to return an old reassembly buffer with the
+           * same tag.
+           */
+
+          if (sixlowpan_reass_expired(reass))
+            {
+              sixlowpan_reass_free(reass);
+              return NULL;
+            }
+
           return reass;
         }
     }
@@ -430,6 +555,13 @@ void sixlowpan_reass_free(FAR struct sixlowpan_reassbuf_s *reass)
 
   sixlowpan_remove_active(reass);
 
+  /* Buffers provided by the radio driver are never indexed */
+
+  if (reass->rb_pool != REASS_POOL_RADIO)
+    {
+      sixlowpan_remove_hashed(reass);
+    }
+
   /* If this is a pre-allocated reassembly buffer structure, then just put it back
    * in the free list.
    */
@@ -254,6 +254,12 @@ static int sixlowpan_tcp_header(FAR struct tcp_conn_s *conn,
   memcpy(ipv6tcp->tcp.ackno, conn->rcvseq, 4);    /* ACK number */
   memcpy(ipv6tcp->tcp.seqno, conn->sndseq, 4);    /* Sequence number */
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* This segment ACKs all data received so far */
+
+  conn->ackpend = false;
+#endif
+
   /* Set the TCP window */
 
   if (conn->tcpstateflags & TCP_STOPPED)
@@ -269,7 +275,7 @@ static int sixlowpan_tcp_header(FAR struct tcp_conn_s *conn,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -492,7 +498,7 @@ static uint16_t tcp_send_eventhandler(FAR struct net_driver_s *dev,
   if ((flags & WPAN_NEWDATA) == 0 && sinfo->s_sent < sinfo->s_buflen)
     {
       uint32_t seqno;
-      uint16_t winleft;
+      uint32_t winleft;
       uint16_t sndlen;
 
       /* Get the amount of TCP payload data that we can send in the next
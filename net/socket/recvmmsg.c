@@ -0,0 +1,227 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket in one
+ *   call.  Each entry of 'msgvec' describes one message exactly as for
+ *   recvmsg(); on return msg_len holds the number of bytes received into
+ *   that entry.  For the Internet address families the whole batch is
+ *   performed under a single hold of the network lock.
+ *
+ *   If MSG_WAITFORONE is set in 'flags', then only the first message may
+ *   block; the remainder are received as if MSG_DONTWAIT were set.  If
+ *   'timeout' is not NULL, no further messages are received once that
+ *   much time has elapsed (the timeout is checked after each message and
+ *   does not limit the wait for the first one).
+ *
+ *   This is an internal OS interface.  It is functionally equivalent to
+ *   recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message descriptions
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Receive flags
+ *   timeout - Time limit for the batch (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If the first
+ *   message could not be received, a negated errno value is returned (see
+ *   recvfrom() for the list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  FAR struct msghdr *msg;
+  unsigned int count;
+  clock_t start = 0;
+  clock_t ticks = 0;
+  ssize_t nrecvd;
+  bool locked;
+  int ret = OK;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      ticks = SEC2TICK(timeout->tv_sec) + NSEC2TICK(timeout->tv_nsec);
+      start = clock_systimer();
+    }
+
+  /* Take the network lock once for the whole batch.  The per-message
+   * net_lock() calls then only nest.
+   */
+
+  locked = _SS_ISINET(psock->s_domain);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (count = 0; count < vlen; count++)
+    {
+      msg    = &msgvec[count].msg_hdr;
+      nrecvd = psock_recvmsg(psock, msg, flags);
+      if (nrecvd < 0)
+        {
+          ret = (int)nrecvd;
+          break;
+        }
+
+      msgvec[count].msg_len = (unsigned int)nrecvd;
+
+      /* Only the first message may block if MSG_WAITFORONE was given */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL && clock_systimer() - start >= ticks)
+        {
+          count++;
+          break;
+        }
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Errors are reported only if nothing was received.  Otherwise the
+   * error will recur on the next call.
+   */
+
+  return count > 0 ? (int)count : ret;
+}
+
+/****************************************************************************
+ * Name: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives up to 'vlen' messages from a socket with one call.
+ *   See psock_recvmmsg() for a description of the semantics.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - The array of message descriptions
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Receive flags
+ *   timeout - Time limit for the batch (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -0,0 +1,306 @@
+/****************************************************************************
+ * net/socket/recvmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: recvmsg_stream
+ *
+ * Description:
+ *   Fill the I/O vector entries in order from a stream socket.  Only the
+ *   first entry may block; the remaining entries take whatever data is
+ *   already queued.  Stops at the first short read.
+ *
+ ****************************************************************************/
+
+static ssize_t recvmsg_stream(FAR struct socket *psock,
+                              FAR struct msghdr *msg, int flags,
+                              FAR socklen_t *fromlen)
+{
+  FAR const struct iovec *iov = msg->msg_iov;
+  ssize_t total = 0;
+  ssize_t nrecvd;
+  int i;
+
+  for (i = 0; i < (int)msg->msg_iovlen; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nrecvd = psock_recvfrom(psock, iov[i].iov_base, iov[i].iov_len, flags,
+                              total == 0 ?
+                              (FAR struct sockaddr *)msg->msg_name : NULL,
+                              total == 0 ? fromlen : NULL);
+      if (nrecvd < 0)
+        {
+          /* Errors (including -EAGAIN on the non-blocking entries) are
+           * reported only if nothing was received.
+           */
+
+          return total > 0 ? total : nrecvd;
+        }
+
+      total += nrecvd;
+      if ((size_t)nrecvd < iov[i].iov_len)
+        {
+          break;
+        }
+
+      /* Only the Internet and local domains honor MSG_DONTWAIT; elsewhere
+       * the next entry could block even though data has been received.
+       */
+
+      if (!_SS_ISINET(psock->s_domain) && psock->s_domain != PF_LOCAL)
+        {
+          break;
+        }
+
+      flags |= MSG_DONTWAIT;
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: recvmsg_dgram
+ *
+ * Description:
+ *   Receive one datagram into a temporary buffer and scatter it over the
+ *   I/O vector.  Any part of the datagram that does not fit is discarded,
+ *   just as with recvfrom().
+ *
+ ****************************************************************************/
+
+static ssize_t recvmsg_dgram(FAR struct socket *psock,
+                             FAR struct msghdr *msg, int flags,
+                             FAR socklen_t *fromlen)
+{
+  FAR const struct iovec *iov = msg->msg_iov;
+  FAR uint8_t *buffer;
+  FAR uint8_t *src;
+  size_t remaining;
+  size_t ncopy;
+  size_t len = 0;
+  ssize_t nrecvd;
+  int i;
+
+  for (i = 0; i < (int)msg->msg_iovlen; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(len > 0 ? len : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nrecvd = psock_recvfrom(psock, buffer, len, flags,
+                          (FAR struct sockaddr *)msg->msg_name, fromlen);
+  if (nrecvd > 0)
+    {
+      remaining = (size_t)nrecvd;
+      for (i = 0, src = buffer; remaining > 0; i++)
+        {
+          ncopy = iov[i].iov_len < remaining ? iov[i].iov_len : remaining;
+          memcpy(iov[i].iov_base, src, ncopy);
+          src       += ncopy;
+          remaining -= ncopy;
+        }
+    }
+
+  kmm_free(buffer);
+  return nrecvd;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives data into the I/O vector of 'msg'.  A single
+ *   entry is passed straight to psock_recvfrom().  On a stream socket
+ *   multiple entries are filled in order; on other sockets one message is
+ *   received and scattered over the entries.
+ *
+ *   This is an internal OS interface.  It is functionally equivalent to
+ *   recvmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msg     - The message description to receive into
+ *   flags   - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly
+ *   shutdown, zero is returned.  On any failure, a negated errno value is
+ *   returned (see recvfrom() for the list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  FAR socklen_t *fromlen = NULL;
+  socklen_t addrlen = 0;
+  ssize_t nrecvd;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0) ||
+      msg->msg_iovlen > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  if (msg->msg_name != NULL)
+    {
+      addrlen = (socklen_t)msg->msg_namelen;
+      fromlen = &addrlen;
+    }
+
+  if (msg->msg_iovlen == 0)
+    {
+      nrecvd = 0;
+    }
+  else if (msg->msg_iovlen == 1)
+    {
+      nrecvd = psock_recvfrom(psock, msg->msg_iov->iov_base,
+                              msg->msg_iov->iov_len, flags,
+                              (FAR struct sockaddr *)msg->msg_name,
+                              fromlen);
+    }
+  else if (psock->s_type == SOCK_STREAM)
+    {
+      nrecvd = recvmsg_stream(psock, msg, flags, fromlen);
+    }
+  else
+    {
+      nrecvd = recvmsg_dgram(psock, msg, flags, fromlen);
+    }
+
+  if (nrecvd >= 0)
+    {
+      msg->msg_namelen = (int)addrlen;
+      msg->msg_flags   = 0;
+    }
+
+  return nrecvd;
+}
+
+/****************************************************************************
+ * Name: recvmsg
+ *
+ * Description:
+ *   recvmsg() receives data into the I/O vector of 'msg'.  See
+ *   psock_recvmsg() for a description of the semantics.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msg     - The message description to receive into
+ *   flags   - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On error, -1
+ *   is returned, and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* recvmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_recvmsg() do all of the work */
+
+  ret = psock_recvmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
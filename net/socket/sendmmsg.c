@@ -0,0 +1,188 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' messages on a socket in one call.
+ *   Each entry of 'msgvec' describes one message exactly as for sendmsg();
+ *   on return msg_len holds the number of bytes sent from that entry.  For
+ *   the Internet address families the whole batch is queued under a single
+ *   hold of the network lock so that buffered datagrams are picked up by
+ *   the same device poll.
+ *
+ *   This is an internal OS interface.  It is functionally equivalent to
+ *   sendmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message descriptions
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  If the first message
+ *   could not be sent, a negated errno value is returned (see sendto() for
+ *   the list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  FAR struct msghdr *msg;
+  unsigned int count;
+  ssize_t nsent;
+  bool locked;
+  int ret = OK;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Take the network lock once for the whole batch.  The per-message
+   * net_lock() calls then only nest.
+   */
+
+  locked = _SS_ISINET(psock->s_domain);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (count = 0; count < vlen; count++)
+    {
+      msg   = &msgvec[count].msg_hdr;
+      nsent = psock_sendmsg(psock, msg, flags);
+      if (nsent < 0)
+        {
+          ret = (int)nsent;
+          break;
+        }
+
+      msgvec[count].msg_len = (unsigned int)nsent;
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Errors are reported only if nothing was sent */
+
+  return count > 0 ? (int)count : ret;
+}
+
+/****************************************************************************
+ * Name: sendmmsg
+ *
+ * Description:
+ *   sendmmsg() sends up to 'vlen' messages on a socket with one call.  See
+ *   psock_sendmmsg() for a description of the semantics.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - The array of message descriptions
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  On error, -1 is
+ *   returned, and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* sendmmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_sendmmsg() do all of the work */
+
+  ret = psock_sendmmsg(psock, msgvec, vlen, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -0,0 +1,274 @@
+/****************************************************************************
+ * net/socket/sendmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendmsg_stream
+ *
+ * Description:
+ *   Send each I/O vector entry on a connected stream socket.  The socket
+ *   interface may provide a vectored send method that queues all entries
+ *   at once; otherwise the entries are sent one at a time, stopping at the
+ *   first short send.
+ *
+ ****************************************************************************/
+
+static ssize_t sendmsg_stream(FAR struct socket *psock,
+                              FAR struct msghdr *msg, int flags)
+{
+  FAR const struct iovec *iov = msg->msg_iov;
+  ssize_t total = 0;
+  ssize_t nsent;
+  int i;
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+  if (psock->s_sockif->si_sendv != NULL)
+    {
+      nsent = psock->s_sockif->si_sendv(psock, iov, (int)msg->msg_iovlen,
+                                        flags);
+      if (nsent != -ENOTSUP)
+        {
+          return nsent;
+        }
+    }
+
+  for (i = 0; i < (int)msg->msg_iovlen; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nsent = psock_send(psock, iov[i].iov_base, iov[i].iov_len, flags);
+      if (nsent < 0)
+        {
+          /* Errors are reported only if nothing was sent */
+
+          return total > 0 ? total : nsent;
+        }
+
+      total += nsent;
+      if ((size_t)nsent < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: sendmsg_dgram
+ *
+ * Description:
+ *   Gather the I/O vector into a single buffer and send it as one
+ *   datagram so that message boundaries are preserved.
+ *
+ ****************************************************************************/
+
+static ssize_t sendmsg_dgram(FAR struct socket *psock,
+                             FAR struct msghdr *msg, int flags)
+{
+  FAR const struct iovec *iov = msg->msg_iov;
+  FAR uint8_t *buffer;
+  FAR uint8_t *dest;
+  size_t len = 0;
+  ssize_t nsent;
+  int i;
+
+  for (i = 0; i < (int)msg->msg_iovlen; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(len > 0 ? len : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0, dest = buffer; i < (int)msg->msg_iovlen; i++)
+    {
+      memcpy(dest, iov[i].iov_base, iov[i].iov_len);
+      dest += iov[i].iov_len;
+    }
+
+  nsent = psock_sendto(psock, buffer, len, flags,
+                       (FAR const struct sockaddr *)msg->msg_name,
+                       (socklen_t)msg->msg_namelen);
+
+  kmm_free(buffer);
+  return nsent;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends the data described by the I/O vector of 'msg'.
+ *   A single entry is passed straight to psock_sendto().  On a stream
+ *   socket multiple entries are sent in order; on other sockets they are
+ *   gathered and sent as one message to msg_name.
+ *
+ *   This is an internal OS interface.  It is functionally equivalent to
+ *   sendmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msg     - The message to send
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (see sendto() for the list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0) ||
+      msg->msg_iovlen > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  if (msg->msg_iovlen == 0)
+    {
+      return 0;
+    }
+
+  if (msg->msg_iovlen == 1)
+    {
+      return psock_sendto(psock, msg->msg_iov->iov_base,
+                          msg->msg_iov->iov_len, flags,
+                          (FAR const struct sockaddr *)msg->msg_name,
+                          (socklen_t)msg->msg_namelen);
+    }
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      return sendmsg_stream(psock, msg, flags);
+    }
+
+  return sendmsg_dgram(psock, msg, flags);
+}
+
+/****************************************************************************
+ * Name: sendmsg
+ *
+ * Description:
+ *   sendmsg() sends the data described by the I/O vector of 'msg'.  See
+ *   psock_sendmsg() for a description of the semantics.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msg     - The message to send
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On error, -1 is
+ *   returned, and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* sendmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_sendmsg() do all of the work */
+
+  ret = psock_sendmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -55,6 +55,7 @@
 #include "inet/inet.h"
 #include "tcp/tcp.h"
 #include "udp/udp.h"
+#include "pkt/pkt.h"
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 
@@ -400,6 +401,12 @@ int psock_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_PKT_RING
+      case SOL_PACKET: /* Packet socket options (see include/netpacket/packet.h) */
+        ret = pkt_setsockopt(psock, option, value, value_len);
+        break;
+#endif
+
       default:         /* The provided level is invalid */
         ret = -EINVAL;
         break;
@@ -89,6 +89,14 @@
 #define _SS_ISCONNECTED(s)  (((s) & _SF_CONNECTED) != 0)
 #define _SS_ISCLOSED(s)     (((s) & _SF_CLOSED)    != 0)
 
+/* Sockets of the Internet address families only ever block in
+ * net_lockedwait(), which releases the network lock while waiting.  Batched
+ * operations such as recvmmsg() may hold the lock across several calls on
+ * such a socket.
+ */
+
+#define _SS_ISINET(d)       ((d) == PF_INET || (d) == PF_INET6)
+
 /* This macro converts a socket option value into a bit setting */
 
 #define _SO_BIT(o)       (1 << (o))
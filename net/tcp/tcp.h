@@ -92,6 +92,15 @@
      (iob_copyin((wrb)->wb_iob,src,(n),0,false))
 #  define TCP_WBTRYCOPYIN(wrb,src,n) \
      (iob_trycopyin((wrb)->wb_iob,src,(n),0,false))
+#  define TCP_WBAPPEND(wrb,src,n) \
+     (iob_copyin((wrb)->wb_iob,src,(n),TCP_WBPKTLEN(wrb),false))
+#  define TCP_WBTRYAPPEND(wrb,src,n) \
+     (iob_trycopyin((wrb)->wb_iob,src,(n),TCP_WBPKTLEN(wrb),false))
+
+#  ifdef CONFIG_NET_TCP_SACK
+#    define TCP_WBSACKED(wrb)        ((wrb)->wb_sacked)
+#    define TCP_WBREXMIT(wrb)        ((wrb)->wb_rexmit)
+#  endif
 
 #  define TCP_WBTRIM(wrb,n) \
      do { (wrb)->wb_iob = iob_trimhead((wrb)->wb_iob,(n)); } while (0)
@@ -104,6 +113,51 @@
 #  endif
 #endif
 
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+/* The number of duplicate ACKs that trigger a fast retransmit (RFC 5681) */
+
+#  define TCP_FAST_REXMIT_THRESH     3
+
+/* Fast retransmissions requested by tcp_input() in tcp_conn_s fastrexmit */
+
+#  define TCP_FR_NONE                0 /* Nothing to retransmit */
+#  define TCP_FR_ENTER               1 /* Entering recovery: Retransmit the
+                                        * first un-ACKed write buffer */
+#  define TCP_FR_PARTIAL             2 /* Partial ACK during recovery:
+                                        * Retransmit the first un-ACKed
+                                        * write buffer */
+#  define TCP_FR_SACK                3 /* Duplicate ACK during recovery:
+                                        * Retransmit the next SACK hole */
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+/* The longest congestion control algorithm name, including the NUL */
+
+#  define TCP_CA_NAME_MAX            16
+
+/* The congestion control algorithm used unless the socket selects one */
+
+#  ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+#    define TCP_CC_DEFAULT           (&g_tcp_cubic)
+#  else
+#    define TCP_CC_DEFAULT           (&g_tcp_reno)
+#  endif
+#endif
+
+#ifdef CONFIG_NET_TCP_NAGLE
+/* The longest time that TCP_CORK holds back a partial segment (Linux uses
+ * the same ceiling).
+ */
+
+#  define TCP_CORK_TIMEOUT           MSEC2TICK(200)
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+/* The largest window scale shift count permitted by RFC 7323 */
+
+#  define TCP_MAX_WSCALE             14
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -120,11 +174,41 @@
 struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
+struct tcp_blcontainer_s; /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
 
+#ifdef CONFIG_NET_TCP_CC
+/* This structure describes one congestion control algorithm.  Slow start
+ * and the loss window after a timeout are common to all algorithms and are
+ * implemented by tcp_cc_ack() and tcp_cc_loss().  The algorithm provides:
+ *
+ *   name       - The name selected with setsockopt(TCP_CONGESTION).
+ *   init       - Reset the algorithm's private state in the connection.
+ *                May be NULL.
+ *   cong_avoid - Grow cwnd in congestion avoidance, i.e., once cwnd has
+ *                reached ssthresh.  'acked' is the number of bytes that
+ *                were newly ACKed.
+ *   ssthresh   - Return the new slow start threshold after a loss.
+ */
+
+struct tcp_conn_s;        /* Forward reference */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
 struct tcp_conn_s
 {
   dq_entry_t node;        /* Implements a doubly linked list */
+#ifdef CONFIG_NET_TCP_HASH
+  FAR struct tcp_conn_s *hash_flink;   /* Next in the active hash chain */
+  FAR struct tcp_conn_s *lhash_flink;  /* Next in the listener hash chain */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -146,7 +230,11 @@ struct tcp_conn_s
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current window size of the connection */
+#else
   uint16_t winsize;       /* Current window size of the connection */
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t unacked;       /* Number bytes sent but not yet ACKed */
 #else
@@ -188,6 +276,43 @@ struct tcp_conn_s
   uint32_t   sndseq_max;  /* The sequence number of next not-retransmitted
                            * segment (next greater sndseq) */
 #endif
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+  uint32_t   lastack;     /* The last cumulative ACK number received */
+  uint32_t   recover;     /* sndseq_max when fast recovery was entered */
+  uint8_t    dupacks;     /* Number of consecutive duplicate ACKs */
+  uint8_t    fastrexmit;  /* Pending fast retransmission.  See TCP_FR_* */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  bool       sackperm;    /* The peer accepted selective ACKs */
+#endif
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  bool       ackpend;     /* Received data has not been ACKed yet */
+#endif
+#ifdef CONFIG_NET_TCP_NAGLE
+  bool       nodelay;     /* True: Nagle's algorithm is disabled */
+  bool       cork;        /* True: Send only full-sized segments */
+  bool       corkwait;    /* True: A partial segment is held back */
+  clock_t    corktime;    /* Time when the partial segment was held back */
+#endif
+#ifdef CONFIG_NET_TCP_CC
+  FAR const struct tcp_cc_ops_s *cc; /* Congestion control algorithm */
+  uint32_t   cwnd;        /* Congestion window (bytes) */
+  uint32_t   ssthresh;    /* Slow start threshold (bytes) */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  uint32_t   cubic_wmax;  /* cwnd before the last reduction */
+  uint32_t   cubic_origin; /* Plateau of the current cubic curve */
+  uint32_t   cubic_k;     /* Epoch time (msec) at which the plateau is
+                           * reached */
+  uint32_t   cubic_west;  /* Window that Reno would have (RFC 8312) */
+  uint32_t   cubic_epoch; /* Start of the current epoch (msec) */
+  bool       cubic_inepoch; /* True: cubic_epoch is valid */
+#endif
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  bool       wscale;      /* Window scaling offered by us or by the peer */
+  uint8_t    snd_wscale;  /* Shift applied to the peer's window */
+  uint8_t    rcv_wscale;  /* Shift applied to our advertised window */
+#endif
 
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
@@ -195,13 +320,20 @@ struct tcp_conn_s
    *   blparent - The backlog parent.  If this connection is backlogged,
    *     this field will be non-null and will refer to the TCP connection
    *     structure in which this connection is backlogged.
+   *   blcont - The container that holds this connection in the backlog
+   *     of blparent, so that it can be removed without a search.
    *   backlog - The pending connection backlog.  If this connection is
    *     configured as a listener with backlog, then this refers to the
    *     struct tcp_backlog_s tear-off structure that manages that backlog.
    */
 
-  FAR struct tcp_conn_s    *blparent;
-  FAR struct tcp_backlog_s *backlog;
+  FAR struct tcp_conn_s        *blparent;
+  FAR struct tcp_blcontainer_s *blcont;
+  FAR struct tcp_backlog_s     *backlog;
+#endif
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+  bool       synrcvd;     /* Counted as a half-open connection */
 #endif
 
 #ifdef CONFIG_NET_TCP_KEEPALIVE
@@ -275,6 +407,10 @@ struct tcp_wrbuffer_s
   uint16_t   wb_sent;      /* Number of bytes sent from the I/O buffer chain */
   uint8_t    wb_nrtx;      /* The number of retransmissions for the last
                             * segment sent */
+#ifdef CONFIG_NET_TCP_SACK
+  bool       wb_sacked;    /* All of the data was selectively ACKed */
+  bool       wb_rexmit;    /* Fast retransmitted in the current recovery */
+#endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
 #endif
@@ -289,14 +425,14 @@ struct tcp_wrbuffer_s
 #ifdef CONFIG_NET_TCPBACKLOG
 struct tcp_blcontainer_s
 {
-  sq_entry_t bc_node;             /* Implements a singly linked list */
+  dq_entry_t bc_node;             /* Implements a doubly linked list */
   FAR struct tcp_conn_s *bc_conn; /* Holds reference to the new connection structure */
 };
 
 struct tcp_backlog_s
 {
-  sq_queue_t bl_free;             /* Implements a singly-linked list of free containers */
-  sq_queue_t bl_pending;          /* Implements a singly-linked list of pending connections */
+  dq_queue_t bl_free;             /* Implements a doubly-linked list of free containers */
+  dq_queue_t bl_pending;          /* Implements a doubly-linked list of pending connections */
 };
 #endif
 
@@ -322,6 +458,15 @@ extern "C"
 EXTERN struct net_driver_s *g_netdevices;
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* The congestion control algorithms */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_reno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -935,6 +1080,54 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 
 void tcp_reset(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: tcp_synack_stateless
+ *
+ * Description:
+ *   Answer the SYN in the device buffer with a SYNACK that does not refer
+ *   to any connection structure.  Only the MSS option is sent.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure to use in the send operation
+ *   isn - Our initial sequence number
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+void tcp_synack_stateless(FAR struct net_driver_s *dev, uint32_t isn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_ack_stateless
+ *
+ * Description:
+ *   Answer the segment in the device buffer with a bare ACK that does not
+ *   refer to any connection structure.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure to use in the send operation
+ *   seqno - The sequence number of the ACK
+ *   ackno - The sequence number being acknowledged
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMEWAIT
+void tcp_ack_stateless(FAR struct net_driver_s *dev, uint32_t seqno,
+                       uint32_t ackno);
+#endif
+
 /****************************************************************************
  * Name: tcp_ack
  *
@@ -1072,6 +1265,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev  - The device which was active when the event was detected.
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1089,7 +1283,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  ****************************************************************************/
 
 #ifdef CONFIG_NET_TCP_READAHEAD
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 #endif
 
@@ -1208,6 +1403,141 @@ int tcp_backlogdelete(FAR struct tcp_conn_s *conn,
 #  define tcp_backlogdelete(c,b) (-ENOSYS)
 #endif
 
+/****************************************************************************
+ * Name: tcp_synrcvd_add and tcp_synrcvd_done
+ *
+ * Description:
+ *   Account for connections in the SYN_RCVD state.  tcp_synrcvd_add() is
+ *   called when a connection enters the TCP_SYN_RCVD state;
+ *   tcp_synrcvd_done() when it leaves it or is freed (only the first call
+ *   has an effect).
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+void tcp_synrcvd_add(FAR struct tcp_conn_s *conn);
+void tcp_synrcvd_done(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_synrcvd_add(c)
+#  define tcp_synrcvd_done(c)
+#endif
+
+/****************************************************************************
+ * Name: tcp_syncookie_needed
+ *
+ * Description:
+ *   Return true if a SYN received on a listening port should be answered
+ *   with a SYN cookie rather than by allocating a connection.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+bool tcp_syncookie_needed(void);
+#endif
+
+/****************************************************************************
+ * Name: tcp_syncookie_send
+ *
+ * Description:
+ *   Answer the SYN in the device buffer with a SYNACK whose initial
+ *   sequence number is a SYN cookie.  No connection is allocated.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure holding the received SYN
+ *   tcp    - The TCP header of the received SYN
+ *   hdrlen - The offset of the TCP options in the device buffer
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+void tcp_syncookie_send(FAR struct net_driver_s *dev,
+                        FAR struct tcp_hdr_s *tcp, unsigned int hdrlen);
+#endif
+
+/****************************************************************************
+ * Name: tcp_syncookie_accept
+ *
+ * Description:
+ *   Check if the ACK in the device buffer acknowledges a SYN cookie.  If
+ *   so, allocate the connection in the TCP_SYN_RCVD state as if the SYN
+ *   had been accepted normally.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure holding the received ACK
+ *   tcp - The TCP header of the received ACK
+ *
+ * Returned Value:
+ *   The new connection; NULL if the ACK is not for a valid cookie or if no
+ *   connection structure could be allocated.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+FAR struct tcp_conn_s *tcp_syncookie_accept(FAR struct net_driver_s *dev,
+                                            FAR struct tcp_hdr_s *tcp);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timewait_add
+ *
+ * Description:
+ *   Record a connection that is being freed in the TIME_WAIT state as a
+ *   compact TIME_WAIT entry for the remainder of its TIME_WAIT period.
+ *
+ * Input Parameters:
+ *   conn - The connection in the TIME_WAIT state
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMEWAIT
+void tcp_timewait_add(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timewait_input
+ *
+ * Description:
+ *   Handle a received segment that matches no active connection but may
+ *   belong to a compact TIME_WAIT entry.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure holding the received segment
+ *   tcp - The TCP header of the received segment
+ *
+ * Returned Value:
+ *   true if the segment was consumed:  The device buffer then holds the
+ *   reply, if any.  false if no TIME_WAIT entry claims the segment and it
+ *   should be processed normally; the entry is discarded if the segment
+ *   is a SYN that may start a new connection.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMEWAIT
+bool tcp_timewait_input(FAR struct net_driver_s *dev,
+                        FAR struct tcp_hdr_s *tcp);
+#endif
+
 /****************************************************************************
  * Name: tcp_accept
  *
@@ -1295,6 +1625,30 @@ struct socket;
 ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+/****************************************************************************
+ * Name: psock_tcp_sendv
+ *
+ * Description:
+ *   The vectored form of psock_tcp_send().  The data of all entries of the
+ *   I/O vector is queued in one write buffer, so that it may leave in a
+ *   single segment.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iov      Data to send
+ *   iovcnt   Number of entries in iov
+ *
+ * Returned Value:
+ *   See psock_tcp_send().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+struct iovec;
+ssize_t psock_tcp_sendv(FAR struct socket *psock,
+                        FAR const struct iovec *iov, int iovcnt);
+#endif
+
 /****************************************************************************
  * Name: tcp_setsockopt
  *
@@ -1363,6 +1717,96 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len);
 #endif
 
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize congestion control when a connection is established.  The
+ *   default algorithm is used unless setsockopt(TCP_CONGESTION) already
+ *   selected one.
+ *
+ * Input Parameters:
+ *   conn - The connection that was just established.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select a congestion control algorithm by name.
+ *
+ * Input Parameters:
+ *   conn - The connection whose algorithm is changed.
+ *   name - The name of the algorithm.  Need not be NUL terminated.
+ *   len  - The maximum length of the name.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no algorithm of that name.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len);
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Grow the congestion window when new data is ACKed:  By up to one MSS
+ *   per ACK in slow start, and as the algorithm decides in congestion
+ *   avoidance.  The window does not grow during fast recovery.
+ *
+ * Input Parameters:
+ *   conn  - The connection that received the ACK.
+ *   acked - The number of bytes newly ACKed.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window on a loss.  The algorithm selects the new
+ *   slow start threshold.  After a fast retransmission cwnd continues from
+ *   that threshold; after a retransmission timeout it restarts from one
+ *   MSS.
+ *
+ * Input Parameters:
+ *   conn    - The connection that lost data.
+ *   timeout - True: The retransmission timer expired.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout);
+#endif /* CONFIG_NET_TCP_CC */
+
 /****************************************************************************
  * Name: tcp_get_recvwindow
  *
@@ -1370,14 +1814,38 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
  *   Calculate the TCP receive window for the specified device.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The connection whose window is advertised.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value of the TCP receive window to use.  This is the value of the
+ *   16-bit window field:  If window scaling is in effect on the connection,
+ *   it has already been shifted by the connection's scale factor.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_get_wscale
+ *
+ * Description:
+ *   Select the window scale factor that we will offer in a SYN or SYNACK.
+ *   The factor is the smallest shift that lets the largest window that the
+ *   IOB pool could ever back be advertised in the 16-bit window field.
+ *
+ * Input Parameters:
+ *   dev - The device that will carry the connection.
+ *
+ * Returned Value:
+ *   The window scale shift count, 0 through TCP_MAX_WSCALE.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_wscale(FAR struct net_driver_s *dev);
+#endif
 
 /****************************************************************************
  * Name: psock_tcp_cansend
@@ -124,7 +124,7 @@ int tcp_backlogcreate(FAR struct tcp_conn_s *conn, int nblg)
       blc = (FAR struct tcp_blcontainer_s *)(((FAR uint8_t *)bls) + offset);
       for (i = 0; i < nblg; i++)
         {
-          sq_addfirst(&blc->bc_node, &bls->bl_free);
+          dq_addfirst(&blc->bc_node, &bls->bl_free);
           blc++;
         }
     }
@@ -186,7 +186,7 @@ int tcp_backlogdestroy(FAR struct tcp_conn_s *conn)
 
        /* Handle any pending connections in the backlog */
 
-       while ((blc = (FAR struct tcp_blcontainer_s *)sq_remfirst(&blg->bl_pending)) != NULL)
+       while ((blc = (FAR struct tcp_blcontainer_s *)dq_remfirst(&blg->bl_pending)) != NULL)
          {
            blconn = blc->bc_conn;
            if (blconn)
@@ -194,6 +194,7 @@ int tcp_backlogdestroy(FAR struct tcp_conn_s *conn)
                /* REVISIT -- such connections really need to be gracefully closed */
 
                blconn->blparent = NULL;
+               blconn->blcont   = NULL;
                blconn->backlog  = NULL;
                blconn->crefs    = 0;
                tcp_free(blconn);
@@ -241,7 +242,7 @@ int tcp_backlogadd(FAR struct tcp_conn_s *conn, FAR struct tcp_conn_s *blconn)
     {
       /* Allocate a container for the connection from the free list */
 
-      blc = (FAR struct tcp_blcontainer_s *)sq_remfirst(&bls->bl_free);
+      blc = (FAR struct tcp_blcontainer_s *)dq_remfirst(&bls->bl_free);
       if (!blc)
         {
           nerr("ERROR: Failed to allocate container\n");
@@ -251,10 +252,14 @@ int tcp_backlogadd(FAR struct tcp_conn_s *conn, FAR struct tcp_conn_s *blconn)
         {
           /* Save the connection reference in the container and put the
            * container at the end of the pending connection list (FIFO).
+           * The connection remembers its container so that tcp_free()
+           * can remove it from the backlog without a search.
            */
 
-          blc->bc_conn = blconn;
-          sq_addlast(&blc->bc_node, &bls->bl_pending);
+          blc->bc_conn     = blconn;
+          blconn->blparent = conn;
+          blconn->blcont   = blc;
+          dq_addlast(&blc->bc_node, &bls->bl_pending);
           ret = OK;
         }
     }
@@ -277,7 +282,7 @@ int tcp_backlogadd(FAR struct tcp_conn_s *conn, FAR struct tcp_conn_s *blconn)
 #ifndef CONFIG_DISABLE_POLL
 bool tcp_backlogavailable(FAR struct tcp_conn_s *conn)
 {
-  return (conn && conn->backlog && !sq_empty(&conn->backlog->bl_pending));
+  return (conn && conn->backlog && !dq_empty(&conn->backlog->bl_pending));
 }
 #endif
 
@@ -313,16 +318,18 @@ FAR struct tcp_conn_s *tcp_backlogremove(FAR struct tcp_conn_s *conn)
        * (FIFO)
        */
 
-      blc = (FAR struct tcp_blcontainer_s *)sq_remfirst(&bls->bl_pending);
+      blc = (FAR struct tcp_blcontainer_s *)dq_remfirst(&bls->bl_pending);
       if (blc)
         {
           /* Extract the connection reference from the container and put
            * container in the free list
            */
 
-          blconn       = blc->bc_conn;
-          blc->bc_conn = NULL;
-          sq_addlast(&blc->bc_node, &bls->bl_free);
+          blconn           = blc->bc_conn;
+          blconn->blparent = NULL;
+          blconn->blcont   = NULL;
+          blc->bc_conn     = NULL;
+          dq_addlast(&blc->bc_node, &bls->bl_free);
         }
     }
 
@@ -348,7 +355,6 @@ int tcp_backlogdelete(FAR struct tcp_conn_s *conn,
 {
   FAR struct tcp_backlog_s     *bls;
   FAR struct tcp_blcontainer_s *blc;
-  FAR struct tcp_blcontainer_s *prev;
 
   ninfo("conn=%p blconn=%p\n", conn, blconn);
 
@@ -362,37 +368,22 @@ int tcp_backlogdelete(FAR struct tcp_conn_s *conn,
   bls = conn->backlog;
   if (bls)
     {
-      /* Find the container hold the connection */
+      /* The connection records the container that holds it */
 
-      for (blc = (FAR struct tcp_blcontainer_s *)sq_peek(&bls->bl_pending), prev = NULL;
-           blc;
-           prev = blc, blc = (FAR struct tcp_blcontainer_s *)sq_next(&blc->bc_node))
+      blc = blconn->blcont;
+      if (blc != NULL && blconn->blparent == conn)
         {
-          if (blc->bc_conn == blconn)
-            {
-              if (prev)
-                {
-                  /* Remove the a container from the middle of the list of
-                   * pending connections
-                   */
-
-                  (void)sq_remafter(&prev->bc_node, &bls->bl_pending);
-                }
-              else
-                {
-                  /* Remove the a container from the head of the list of
-                   * pending connections
-                   */
-
-                  (void)sq_remfirst(&bls->bl_pending);
-                }
-
-              /* Put container in the free list */
-
-              blc->bc_conn = NULL;
-              sq_addlast(&blc->bc_node, &bls->bl_free);
-              return OK;
-            }
+          /* Remove the container from the list of pending connections */
+
+          dq_rem(&blc->bc_node, &bls->bl_pending);
+
+          /* Put container in the free list */
+
+          blconn->blparent = NULL;
+          blconn->blcont   = NULL;
+          blc->bc_conn     = NULL;
+          dq_addlast(&blc->bc_node, &bls->bl_free);
+          return OK;
         }
 
       nerr("ERROR: Failed to find pending connection\n");
@@ -0,0 +1,331 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCP_CC_NALGS (sizeof(g_tcp_cc) / sizeof(g_tcp_cc[0]))
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_reno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t tcp_reno_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Reno congestion avoidance (RFC 5681) */
+
+const struct tcp_cc_ops_s g_tcp_reno =
+{
+  "reno",                 /* name */
+  NULL,                   /* init */
+  tcp_reno_cong_avoid,    /* cong_avoid */
+  tcp_reno_ssthresh       /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All of the algorithms that setsockopt(TCP_CONGESTION) can select */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc[] =
+{
+  &g_tcp_reno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cubic,
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_reno_cong_avoid
+ *
+ * Description:
+ *   Reno congestion avoidance:  Grow cwnd by about one MSS per round trip,
+ *   i.e., by MSS * MSS / cwnd on each ACK.
+ *
+ ****************************************************************************/
+
+static void tcp_reno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t incr;
+
+  UNUSED(acked);
+
+  incr = ((uint32_t)conn->mss * conn->mss) / conn->cwnd;
+  conn->cwnd += incr > 0 ? incr : 1;
+}
+
+/****************************************************************************
+ * Name: tcp_reno_ssthresh
+ *
+ * Description:
+ *   Reno halves the amount of data in flight on a loss, but never goes
+ *   below two segments.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_reno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t minthresh = 2 * (uint32_t)conn->mss;
+  uint32_t ssthresh  = conn->unacked / 2;
+
+  return ssthresh > minthresh ? ssthresh : minthresh;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize congestion control when a connection is established.  The
+ *   default algorithm is used unless setsockopt(TCP_CONGESTION) already
+ *   selected one.
+ *
+ * Input Parameters:
+ *   conn - The connection that was just established.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  uint32_t mss = conn->mss;
+
+  if (conn->cc == NULL)
+    {
+      conn->cc = TCP_CC_DEFAULT;
+    }
+
+  /* The initial window of RFC 5681, section 3.1 */
+
+  if (mss > 2190)
+    {
+      conn->cwnd = 2 * mss;
+    }
+  else if (mss > 1095)
+    {
+      conn->cwnd = 3 * mss;
+    }
+  else
+    {
+      conn->cwnd = 4 * mss;
+    }
+
+  /* Slow start until the first loss */
+
+  conn->ssthresh = UINT32_MAX;
+
+  if (conn->cc->init != NULL)
+    {
+      conn->cc->init(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select a congestion control algorithm by name.
+ *
+ * Input Parameters:
+ *   conn - The connection whose algorithm is changed.
+ *   name - The name of the algorithm.  Need not be NUL terminated.
+ *   len  - The maximum length of the name.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no algorithm of that name.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len)
+{
+  FAR const struct tcp_cc_ops_s *cc;
+  int i;
+
+  for (i = 0; i < TCP_CC_NALGS; i++)
+    {
+      cc = g_tcp_cc[i];
+      if (len >= strlen(cc->name) && strncmp(cc->name, name, len) == 0)
+        {
+          /* The window carries over to the new algorithm, but its private
+           * state starts over.
+           */
+
+          conn->cc = cc;
+          if (cc->init != NULL)
+            {
+              cc->init(conn);
+            }
+
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Grow the congestion window when new data is ACKed:  By up to one MSS
+ *   per ACK in slow start, and as the algorithm decides in congestion
+ *   avoidance.  The window does not grow during fast recovery.
+ *
+ * Input Parameters:
+ *   conn  - The connection that received the ACK.
+ *   acked - The number of bytes newly ACKed.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  /* Congestion control starts when the connection is established */
+
+  if (conn->cc == NULL || acked == 0)
+    {
+      return;
+    }
+
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+  /* cwnd was set when recovery was entered and stays there until the
+   * recovery point is ACKed.
+   */
+
+  if (conn->dupacks >= TCP_FAST_REXMIT_THRESH)
+    {
+      return;
+    }
+#endif
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start:  Appropriate byte counting with a limit of one MSS
+       * (RFC 3465).
+       */
+
+      conn->cwnd += acked < conn->mss ? acked : conn->mss;
+    }
+  else
+    {
+      conn->cc->cong_avoid(conn, acked);
+    }
+
+  ninfo("cwnd=%u ssthresh=%u acked=%u\n",
+        conn->cwnd, conn->ssthresh, acked);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window on a loss.  The algorithm selects the new
+ *   slow start threshold.  After a fast retransmission cwnd continues from
+ *   that threshold; after a retransmission timeout it restarts from one
+ *   MSS.
+ *
+ * Input Parameters:
+ *   conn    - The connection that lost data.
+ *   timeout - True: The retransmission timer expired.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  if (conn->cc == NULL)
+    {
+      return;
+    }
+
+  conn->ssthresh = conn->cc->ssthresh(conn);
+  conn->cwnd     = timeout ? conn->mss : conn->ssthresh;
+
+  ninfo("%s: cwnd=%u ssthresh=%u\n", timeout ? "RTO" : "Fast retransmit",
+        conn->cwnd, conn->ssthresh);
+}
+
+#endif /* CONFIG_NET_TCP_CC */
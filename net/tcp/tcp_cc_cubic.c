@@ -0,0 +1,299 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The constants of RFC 8312:  Multiplicative decrease factor beta = 0.7 and
+ * scaling constant C = 0.4, expressed as fractions.
+ */
+
+#define CUBIC_BETA_NUM        7
+#define CUBIC_BETA_DEN        10
+
+/* K^3 = (W_max - cwnd) / C in units of segments and seconds.  With time in
+ * milliseconds, 1 / C becomes 2500000000.
+ */
+
+#define CUBIC_INV_C_MSEC3     2500000000ull
+
+/* W(t) - W_max = C * t^3 in segments, evaluated as
+ * (t^3 / CUBIC_DIV1) * MSS / CUBIC_DIV2 with t in milliseconds so that the
+ * intermediate values stay within 64 bits.
+ */
+
+#define CUBIC_DIV1            2500000
+#define CUBIC_DIV2            1000
+
+/* Keep t^3 within 64 bits */
+
+#define CUBIC_MAX_MSEC        (1 << 20)
+
+/* The Reno-friendly window grows by alpha = 3 * (1 - beta) / (1 + beta),
+ * about 9 / 17, segments per round trip.
+ */
+
+#define CUBIC_ALPHA_NUM       9
+#define CUBIC_ALPHA_DEN       17
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked);
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* CUBIC congestion avoidance (RFC 8312) */
+
+const struct tcp_cc_ops_s g_tcp_cubic =
+{
+  "cubic",                /* name */
+  tcp_cubic_init,         /* init */
+  tcp_cubic_cong_avoid,   /* cong_avoid */
+  tcp_cubic_ssthresh      /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t value)
+{
+  uint32_t lo = 0;
+  uint32_t hi = CUBIC_MAX_MSEC;
+
+  while (lo < hi)
+    {
+      uint32_t mid = (lo + hi + 1) / 2;
+
+      if ((uint64_t)mid * mid * mid <= value)
+        {
+          lo = mid;
+        }
+      else
+        {
+          hi = mid - 1;
+        }
+    }
+
+  return lo;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_now
+ *
+ * Description:
+ *   Return the current time in milliseconds.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tcp_cubic_now(void)
+{
+  return (uint32_t)TICK2MSEC(clock_systimer());
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ *
+ * Description:
+ *   Forget any previous loss.  The first epoch starts with the next ACK in
+ *   congestion avoidance.
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cubic_wmax    = 0;
+  conn->cubic_inepoch = false;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd towards the cubic function W(t) = C * (t - K)^3 + W_max,
+ *   where t is the time since the epoch started, but never more slowly
+ *   than Reno would.
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked)
+{
+  uint32_t now = tcp_cubic_now();
+  uint32_t mss = conn->mss;
+  uint32_t target;
+  uint32_t incr;
+  int64_t  t;
+  int64_t  delta;
+
+  UNUSED(acked);
+
+  if (!conn->cubic_inepoch)
+    {
+      /* Start a new epoch.  Below the window at which the last loss
+       * occurred, the curve plateaus at that window after K msec.
+       * Otherwise, probe for more bandwidth right away.
+       */
+
+      conn->cubic_epoch   = now;
+      conn->cubic_inepoch = true;
+      conn->cubic_west    = conn->cwnd;
+
+      if (conn->cwnd < conn->cubic_wmax)
+        {
+          conn->cubic_k      =
+            tcp_cubic_cbrt((uint64_t)(conn->cubic_wmax - conn->cwnd) *
+                           CUBIC_INV_C_MSEC3 / mss);
+          conn->cubic_origin = conn->cubic_wmax;
+        }
+      else
+        {
+          conn->cubic_k      = 0;
+          conn->cubic_origin = conn->cwnd;
+        }
+    }
+
+  /* Evaluate W(t) */
+
+  t = (int64_t)(uint32_t)(now - conn->cubic_epoch) - conn->cubic_k;
+  if (t > CUBIC_MAX_MSEC)
+    {
+      t = CUBIC_MAX_MSEC;
+    }
+  else if (t < -CUBIC_MAX_MSEC)
+    {
+      t = -CUBIC_MAX_MSEC;
+    }
+
+  delta = (t * t * t / CUBIC_DIV1) * (int64_t)mss / CUBIC_DIV2;
+  if (delta < 0 && (uint64_t)-delta >= conn->cubic_origin)
+    {
+      target = mss;
+    }
+  else if (delta > (int64_t)conn->cwnd / 2 + conn->cwnd - conn->cubic_origin)
+    {
+      /* RFC 8312 limits the target to 1.5 * cwnd */
+
+      target = conn->cwnd + conn->cwnd / 2;
+    }
+  else
+    {
+      target = (uint32_t)(conn->cubic_origin + delta);
+    }
+
+  /* Approach the target over the next round trip */
+
+  if (target > conn->cwnd)
+    {
+      incr = (uint32_t)((uint64_t)(target - conn->cwnd) * mss / conn->cwnd);
+      conn->cwnd += incr > 0 ? incr : 1;
+    }
+
+  /* The TCP-friendly region:  Follow the window that Reno would have */
+
+  conn->cubic_west += (mss * mss / conn->cwnd) * CUBIC_ALPHA_NUM /
+                      CUBIC_ALPHA_DEN;
+  if (conn->cubic_west > conn->cwnd)
+    {
+      conn->cwnd = conn->cubic_west;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window at which the loss occurred and reduce the window
+ *   by the factor beta.  With fast convergence, a flow that lost before
+ *   returning to its previous W_max releases some bandwidth to new flows.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t minthresh = 2 * (uint32_t)conn->mss;
+  uint32_t ssthresh;
+
+  if (conn->cwnd < conn->cubic_wmax)
+    {
+      conn->cubic_wmax = (uint32_t)((uint64_t)conn->cwnd *
+                         (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+                         (2 * CUBIC_BETA_DEN));
+    }
+  else
+    {
+      conn->cubic_wmax = conn->cwnd;
+    }
+
+  conn->cubic_inepoch = false;
+
+  ssthresh = (uint32_t)((uint64_t)conn->cwnd * CUBIC_BETA_NUM /
+                        CUBIC_BETA_DEN);
+  return ssthresh > minthresh ? ssthresh : minthresh;
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
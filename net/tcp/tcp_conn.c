@@ -55,6 +55,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -72,13 +73,46 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The TCP connection structures are held in one or more pools:  The
+ * pre-allocated array and, if CONFIG_NET_TCP_ALLOC_CONNS is non-zero, any
+ * blocks that were later allocated from the heap.
+ */
+
+struct tcp_pool_s
+{
+  FAR struct tcp_pool_s *flink;  /* Next pool of connections */
+  FAR struct tcp_conn_s *conns;  /* The connections in this pool */
+  uint16_t nconns;               /* The number of connections in the pool */
+};
+
+#if CONFIG_NET_TCP_ALLOC_CONNS > 0
+/* One block of connections allocated from the heap */
+
+struct tcp_connblock_s
+{
+  struct tcp_pool_s pool;
+  struct tcp_conn_s conns[CONFIG_NET_TCP_ALLOC_CONNS];
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* The array containing all TCP connections. */
+#if CONFIG_NET_TCP_CONNS > 0
+/* The array containing all pre-allocated TCP connections. */
 
 static struct tcp_conn_s g_tcp_connections[CONFIG_NET_TCP_CONNS];
+static struct tcp_pool_s g_tcp_prealloc;
+#endif
+
+/* The list of all pools of TCP connections */
+
+static FAR struct tcp_pool_s *g_tcp_pools;
 
 /* A list of all free TCP connections */
 
@@ -88,6 +122,14 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_HASH
+/* The active connections hashed by local port, remote port and remote IP
+ * address.  Each chain is linked through hash_flink.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_hash[CONFIG_NET_TCP_HASH_SIZE];
+#endif
+
 /* Last port used by a TCP connection connection. */
 
 static uint16_t g_last_tcp_port;
@@ -96,6 +138,113 @@ static uint16_t g_last_tcp_port;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hash
+ *
+ * Description:
+ *   Return the index of the active hash chain for the connection with this
+ *   local port, remote port (both in network byte order) and folded remote
+ *   IP address.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static inline unsigned int tcp_hash(uint16_t lport, uint16_t rport,
+                                    uint32_t raddr)
+{
+  uint32_t key = raddr ^ (((uint32_t)lport << 16) | rport);
+
+  key ^= key >> 16;
+  key ^= key >> 8;
+  return key % CONFIG_NET_TCP_HASH_SIZE;
+}
+
+/****************************************************************************
+ * Name: tcp_ipv6_fold
+ *
+ * Description:
+ *   Fold an IPv6 address into 32 bits for use with tcp_hash().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *addr)
+{
+  return (((uint32_t)(addr[0] ^ addr[2] ^ addr[4] ^ addr[6])) << 16) |
+         (addr[1] ^ addr[3] ^ addr[5] ^ addr[7]);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_hash
+ *
+ * Description:
+ *   Return the index of the active hash chain for a connection whose
+ *   local port, remote port and remote address have been set.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_conn_hash(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_hash(conn->lport, conn->rport, conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_hash(conn->lport, conn->rport,
+                      tcp_ipv6_fold(conn->u.ipv6.raddr));
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: tcp_hash_insert and tcp_hash_remove
+ *
+ * Description:
+ *   Add a connection to or remove it from the active connection hash.
+ *   These accompany each insertion into and removal from the active list.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_insert(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx = tcp_conn_hash(conn);
+
+  conn->hash_flink = g_tcp_hash[ndx];
+  g_tcp_hash[ndx]  = conn;
+}
+
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link = &g_tcp_hash[tcp_conn_hash(conn)];
+
+  while (*link != NULL)
+    {
+      if (*link == conn)
+        {
+          *link = conn->hash_flink;
+          break;
+        }
+
+      link = &(*link)->hash_flink;
+    }
+
+  conn->hash_flink = NULL;
+}
+#endif /* CONFIG_NET_TCP_HASH */
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -112,21 +261,27 @@ static uint16_t g_last_tcp_port;
 static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
+  FAR struct tcp_pool_s *pool;
   FAR struct tcp_conn_s *conn;
   int i;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+  for (pool = g_tcp_pools; pool != NULL; pool = pool->flink)
     {
-      conn = &g_tcp_connections[i];
+      for (i = 0; i < pool->nconns; i++)
+        {
+          conn = &pool->conns[i];
 
-      /* Check if this connection is open and the local port assignment
-       * matches the requested port number.
-       */
+          /* Check if this connection is open and the local port assignment
+           * matches the requested port number.
+           */
+
+          if (conn->tcpstateflags == TCP_CLOSED || conn->lport != portno)
+            {
+              continue;
+            }
 
-      if (conn->tcpstateflags != TCP_CLOSED && conn->lport == portno)
-        {
           /* If there are multiple interface devices, then the local IP
            * address of the connection must also match.  INADDR_ANY is a
            * special case:  There can only be instance of a port number
@@ -163,21 +318,27 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
 static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
+  FAR struct tcp_pool_s *pool;
   FAR struct tcp_conn_s *conn;
   int i;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+  for (pool = g_tcp_pools; pool != NULL; pool = pool->flink)
     {
-      conn = &g_tcp_connections[i];
+      for (i = 0; i < pool->nconns; i++)
+        {
+          conn = &pool->conns[i];
 
-      /* Check if this connection is open and the local port assignment
-       * matches the requested port number.
-       */
+          /* Check if this connection is open and the local port assignment
+           * matches the requested port number.
+           */
+
+          if (conn->tcpstateflags == TCP_CLOSED || conn->lport != portno)
+            {
+              continue;
+            }
 
-      if (conn->tcpstateflags != TCP_CLOSED && conn->lport == portno)
-        {
           /* If there are multiple interface devices, then the local IP
            * address of the connection must also match.  The IPv6
            * unspecified address is a special case:  There can only be
@@ -327,9 +488,13 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+#ifdef CONFIG_NET_TCP_HASH
+  conn       = g_tcp_hash[tcp_hash(tcp->destport, tcp->srcport, srcipaddr)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -366,7 +531,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+      conn = conn->hash_flink;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -394,9 +563,14 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+#ifdef CONFIG_NET_TCP_HASH
+  conn       = g_tcp_hash[tcp_hash(tcp->destport, tcp->srcport,
+                                   tcp_ipv6_fold(ip->srcipaddr))];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -433,7 +607,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+      conn = conn->hash_flink;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -572,6 +750,56 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 }
 #endif /* CONFIG_NET_IPv6 */
 
+/****************************************************************************
+ * Name: tcp_pool_grow
+ *
+ * Description:
+ *   Allocate another block of CONFIG_NET_TCP_ALLOC_CONNS connection
+ *   structures from the heap and add them to the free list.
+ *
+ * Returned Value:
+ *   One of the new free connections, removed from the free list; NULL if
+ *   the allocation failed.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_TCP_ALLOC_CONNS > 0
+static FAR struct tcp_conn_s *tcp_pool_grow(void)
+{
+  FAR struct tcp_connblock_s *block;
+  int i;
+
+  block = (FAR struct tcp_connblock_s *)
+    kmm_zalloc(sizeof(struct tcp_connblock_s));
+
+  if (block == NULL)
+    {
+      nerr("ERROR: Failed to allocate TCP connections\n");
+      return NULL;
+    }
+
+  for (i = 0; i < CONFIG_NET_TCP_ALLOC_CONNS; i++)
+    {
+      /* Mark the connection closed and move it to the free list */
+
+      block->conns[i].tcpstateflags = TCP_CLOSED;
+      dq_addlast(&block->conns[i].node, &g_free_tcp_connections);
+    }
+
+  /* Make the new connections visible to tcp_listener() */
+
+  block->pool.conns  = block->conns;
+  block->pool.nconns = CONFIG_NET_TCP_ALLOC_CONNS;
+  block->pool.flink  = g_tcp_pools;
+  g_tcp_pools        = &block->pool;
+
+  return (FAR struct tcp_conn_s *)dq_remfirst(&g_free_tcp_connections);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -587,13 +815,16 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
 void tcp_initialize(void)
 {
+#if CONFIG_NET_TCP_CONNS > 0
   int i;
+#endif
 
   /* Initialize the queues */
 
   dq_init(&g_free_tcp_connections);
   dq_init(&g_active_tcp_connections);
 
+#if CONFIG_NET_TCP_CONNS > 0
   /* Now initialize each connection structure */
 
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
@@ -604,6 +835,13 @@ void tcp_initialize(void)
       dq_addlast(&g_tcp_connections[i].node, &g_free_tcp_connections);
     }
 
+  /* The pre-allocated connections are the first pool */
+
+  g_tcp_prealloc.conns  = g_tcp_connections;
+  g_tcp_prealloc.nconns = CONFIG_NET_TCP_CONNS;
+  g_tcp_pools           = &g_tcp_prealloc;
+#endif
+
   g_last_tcp_port = 1024;
 }
 
@@ -633,6 +871,15 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
   conn = (FAR struct tcp_conn_s *)dq_remfirst(&g_free_tcp_connections);
 
+#if CONFIG_NET_TCP_ALLOC_CONNS > 0
+  /* If the free list is empty, then grow the pool */
+
+  if (!conn)
+    {
+      conn = tcp_pool_grow();
+    }
+#endif
+
 #ifndef CONFIG_NET_SOLINGER
   /* Is the free list empty? */
 
@@ -772,6 +1019,9 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_HASH
+      tcp_hash_remove(conn);
+#endif
     }
 
 #ifdef CONFIG_NET_TCP_READAHEAD
@@ -812,6 +1062,23 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     }
 #endif
 
+  /* A connection freed before its handshake completed is no longer
+   * half-open.
+   */
+
+  tcp_synrcvd_done(conn);
+
+#ifdef CONFIG_NET_TCP_TIMEWAIT
+  /* A connection freed in the TIME_WAIT state keeps only a compact
+   * TIME_WAIT entry for the rest of its TIME_WAIT period.
+   */
+
+  if (conn->tcpstateflags == TCP_TIME_WAIT)
+    {
+      tcp_timewait_add(conn);
+    }
+#endif
+
   /* Mark the connection available and put it into the free list */
 
   conn->tcpstateflags = TCP_CLOSED;
@@ -1003,6 +1270,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->lport         = tcp->destport;
       conn->rport         = tcp->srcport;
       conn->tcpstateflags = TCP_SYN_RCVD;
+      tcp_synrcvd_add(conn);
 
       tcp_initsequence(conn->sndseq);
       conn->unacked       = 1;
@@ -1035,6 +1303,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_HASH
+      tcp_hash_insert(conn);
+#endif
     }
 
   return conn;
@@ -1270,6 +1541,9 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_HASH
+  tcp_hash_insert(conn);
+#endif
   ret = OK;
 
 errout_with_lock:
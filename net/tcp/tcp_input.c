@@ -66,6 +66,98 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_dupack
+ *
+ * Description:
+ *   Count duplicate ACKs and decide when the write buffer logic must
+ *   perform a fast retransmission (RFC 5681) or, during recovery, retransmit
+ *   after a partial ACK (RFC 6582).  The retransmission itself is done by
+ *   the send callback when it sees TCP_ACKDATA with conn->fastrexmit set.
+ *
+ * Input Parameters:
+ *   conn   - The connection that received the ACK
+ *   tcp    - The TCP header of the received segment
+ *   ackseq - The acknowledgment number of the received segment
+ *   len    - The length of the TCP payload of the received segment
+ *   oldwnd - The peer's window before this segment was received
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked and there is un-ACKed data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+static void tcp_dupack(FAR struct tcp_conn_s *conn,
+                       FAR struct tcp_hdr_s *tcp, uint32_t ackseq,
+                       int len, uint32_t oldwnd)
+{
+  if (ackseq == conn->lastack && len == 0 &&
+      (tcp->flags & (TCP_SYN | TCP_FIN)) == 0 &&
+      conn->winsize == oldwnd)
+    {
+      /* This is a duplicate ACK:  It carries no data, does not change the
+       * window, and does not ACK anything new.  The peer received a
+       * segment above a hole.
+       */
+
+      if (conn->dupacks < UINT8_MAX)
+        {
+          conn->dupacks++;
+        }
+
+      if (conn->dupacks == TCP_FAST_REXMIT_THRESH)
+        {
+          /* Enter recovery, remembering the highest sequence number sent
+           * so far.  Recovery ends when all of that has been ACKed.
+           */
+
+          ninfo("Fast retransmit: ackseq=%u recover=%u\n",
+                ackseq, conn->sndseq_max);
+
+          conn->recover    = conn->sndseq_max;
+          conn->fastrexmit = TCP_FR_ENTER;
+#ifdef CONFIG_NET_TCP_CC
+          tcp_cc_loss(conn, false);
+#endif
+        }
+#ifdef CONFIG_NET_TCP_SACK
+      else if (conn->dupacks > TCP_FAST_REXMIT_THRESH && conn->sackperm)
+        {
+          /* Still in recovery:  The SACK blocks may reveal another hole */
+
+          conn->fastrexmit = TCP_FR_SACK;
+        }
+#endif
+    }
+  else if ((int32_t)(ackseq - conn->lastack) > 0)
+    {
+      /* New data was ACKed.  A partial ACK during recovery means that the
+       * segment at the new ACK number was lost as well.
+       */
+
+      if (conn->dupacks >= TCP_FAST_REXMIT_THRESH &&
+          (int32_t)(ackseq - conn->recover) < 0)
+        {
+          ninfo("Partial ACK: ackseq=%u recover=%u\n",
+                ackseq, conn->recover);
+
+          conn->fastrexmit = TCP_FR_PARTIAL;
+        }
+      else
+        {
+          conn->dupacks    = 0;
+          conn->fastrexmit = TCP_FR_NONE;
+        }
+
+      conn->lastack = ackseq;
+    }
+}
+#endif /* CONFIG_NET_TCP_FAST_REXMIT */
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -98,6 +190,9 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   uint8_t  opt;
   int      len;
   int      i;
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+  uint32_t oldwnd;
+#endif
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -105,6 +200,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   g_netstats.tcp.recv++;
 #endif
 
+  /* IP layer processing of the packet is complete */
+
+  net_latency_stage(&dev->d_latency, NET_LATENCY_IP);
+
   /* Get a pointer to the TCP header.  The TCP header lies just after the
    * the link layer header and the IP header.
    */
@@ -125,11 +224,14 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
 
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code.  Compute and check the TCP
+   * checksum unless the MAC has already verified it.
+   */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM(dev, domain == PF_INET6 ? NETDEV_CSUM_TCPV6 :
+                                               NETDEV_CSUM_TCPV4) &&
+      tcp_chksum(dev) != 0xffff)
     {
-      /* Compute and check the TCP checksum. */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.tcp.drop++;
@@ -168,6 +270,15 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
    * it is an old packet and we send a RST.
    */
 
+#ifdef CONFIG_NET_TCP_TIMEWAIT
+  /* Unless it belongs to a compact TIME_WAIT connection */
+
+  if (tcp_timewait_input(dev, tcp))
+    {
+      return;
+    }
+#endif
+
   if ((tcp->flags & TCP_CTL) == TCP_SYN)
     {
       /* This is a SYN packet for a connection.  Find the connection
@@ -186,6 +297,18 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
            * response.
            */
 
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+          /* If too many connections are already half-open, answer with a
+           * SYN cookie instead of allocating a connection structure.
+           */
+
+          if (tcp_syncookie_needed())
+            {
+              tcp_syncookie_send(dev, tcp, hdrlen);
+              return;
+            }
+#endif
+
           /* First allocate a new connection structure and see if there is any
            * user application to accept it.
            */
@@ -224,11 +347,20 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                * or someone waiting to accept the connection.
                */
 
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+              /* Or, better, answer with a SYN cookie:  The connection
+               * structure is then only needed once the handshake is done.
+               */
+
+              tcp_syncookie_send(dev, tcp, hdrlen);
+              return;
+#else
 #ifdef CONFIG_NET_STATISTICS
               g_netstats.tcp.syndrop++;
 #endif
               nerr("ERROR: No free TCP connections\n");
               goto drop;
+#endif
             }
 
           net_incr32(conn->rcvseq, 1);
@@ -262,11 +394,39 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                       tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
                                (uint16_t)dev->d_buf[hdrlen + 3 + i];
                       conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+                      i += TCP_OPT_MSS_LEN;
+                    }
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (opt == TCP_OPT_SACK_PERM &&
+                           dev->d_buf[hdrlen + 1 + i] ==
+                           TCP_OPT_SACK_PERM_LEN)
+                    {
+                      /* The peer accepts selective ACKs.  Our SYNACK will
+                       * say that we do too.
+                       */
 
-                      /* And we are done processing options. */
+                      conn->sackperm = true;
+                      i += TCP_OPT_SACK_PERM_LEN;
+                    }
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+                  else if (opt == TCP_OPT_WS &&
+                           dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
+                    {
+                      /* The peer scales its window.  Our SYNACK will offer
+                       * our own scale factor.
+                       */
 
-                      break;
+                      conn->wscale     = true;
+                      conn->snd_wscale = dev->d_buf[hdrlen + 2 + i];
+                      if (conn->snd_wscale > TCP_MAX_WSCALE)
+                        {
+                          conn->snd_wscale = TCP_MAX_WSCALE;
+                        }
+
+                      i += TCP_OPT_WS_LEN;
                     }
+#endif
                   else
                     {
                       /* All other options have a length field, so that we easily
@@ -293,6 +453,27 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
         }
     }
 
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+  /* Without the SYN flag, this may also be the ACK that completes a
+   * handshake that we answered with a SYN cookie.  Only the handshake
+   * flags are tested:  That ACK may also carry PSH (and data) or FIN.
+   */
+
+  else if ((tcp->flags & (TCP_SYN | TCP_RST | TCP_ACK)) == TCP_ACK &&
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+           tcp_islistener(tcp->destport, domain))
+#else
+           tcp_islistener(tcp->destport))
+#endif
+    {
+      conn = tcp_syncookie_accept(dev, tcp);
+      if (conn != NULL)
+        {
+          goto found;
+        }
+    }
+#endif
+
   nwarn("WARNING: SYN with no listener (or old packet) .. reset\n");
 
   /* This is (1) an old duplicate packet or (2) a SYN packet but with
@@ -316,10 +497,25 @@ reset:
 
 found:
 
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+  /* Remember the previous window:  A window update is not a duplicate ACK */
+
+  oldwnd = conn->winsize;
+#endif
+
   /* Update the connection's window size */
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window field of a SYN or SYNACK is never scaled (RFC 7323) */
+
+  if ((tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_wscale;
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -485,6 +681,12 @@ found:
 
       ackseq = tcp_getsequence(tcp->ackno);
 
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+      /* Detect duplicate and partial ACKs for fast retransmission */
+
+      tcp_dupack(conn, tcp, ackseq, dev->d_len, oldwnd);
+#endif
+
       /* Check how many of the outstanding bytes have been acknowledged. For
        * most send operations, this should always be true.  However,
        * the send() API sends data ahead when it can without waiting for
@@ -580,6 +782,7 @@ found:
              */
 
             conn->tcpstateflags = TCP_ESTABLISHED;
+            tcp_synrcvd_done(conn);
 
             /* Wake up any listener waiting for a connection on this port */
 
@@ -607,8 +810,14 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+            conn->lastack       = conn->isn;
+#endif
             conn->sent          = 0;
             conn->sndseq_max    = 0;
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
+#endif
 #endif
             conn->unacked       = 0;
             flags               = TCP_CONNECTED;
@@ -645,6 +854,12 @@ found:
 
         if ((flags & TCP_ACKDATA) != 0 && (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+            /* Window scaling is used only if the SYNACK agrees to it */
+
+            conn->wscale = false;
+#endif
+
             /* Parse the TCP MSS option, if present. */
 
             if ((tcp->tcpoffset & 0xf0) > 0x50)
@@ -675,11 +890,39 @@ found:
                           (dev->d_buf[hdrlen + 2 + i] << 8) |
                           dev->d_buf[hdrlen + 3 + i];
                         conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+                        i += TCP_OPT_MSS_LEN;
+                      }
+#ifdef CONFIG_NET_TCP_SACK
+                    else if (opt == TCP_OPT_SACK_PERM &&
+                             dev->d_buf[hdrlen + 1 + i] ==
+                             TCP_OPT_SACK_PERM_LEN)
+                      {
+                        /* The peer accepted the selective ACKs offered in
+                         * our SYN.
+                         */
 
-                        /* And we are done processing options. */
+                        conn->sackperm = true;
+                        i += TCP_OPT_SACK_PERM_LEN;
+                      }
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+                    else if (opt == TCP_OPT_WS &&
+                             dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
+                      {
+                        /* The peer accepted the window scaling offered in
+                         * our SYN.
+                         */
 
-                        break;
+                        conn->wscale     = true;
+                        conn->snd_wscale = dev->d_buf[hdrlen + 2 + i];
+                        if (conn->snd_wscale > TCP_MAX_WSCALE)
+                          {
+                            conn->snd_wscale = TCP_MAX_WSCALE;
+                          }
+
+                        i += TCP_OPT_WS_LEN;
                       }
+#endif
                     else
                       {
                         /* All other options have a length field, so that we
@@ -699,6 +942,13 @@ found:
                   }
               }
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+            if (!conn->wscale)
+              {
+                conn->rcv_wscale = 0;
+              }
+#endif
+
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
 
@@ -708,6 +958,12 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+            conn->lastack       = conn->isn;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
+#endif
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -890,6 +1146,19 @@ found:
                 /* Update the sequence number using the saved length */
 
                 net_incr32(conn->rcvseq, len);
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+                /* Unless the response carries data anyway, delay the ACK of
+                 * the first segment.  The ACK of the second one will cover
+                 * both.  tcp_timer() sends the ACK if nothing else does.
+                 */
+
+                if (len > 0 && dev->d_sndlen == 0 && !conn->ackpend)
+                  {
+                    conn->ackpend = true;
+                    result &= ~TCP_SNDACK;
+                  }
+#endif
               }
 
             /* Send the response, ACKing the data or not, as appropriate */
@@ -62,6 +62,19 @@
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
 
+#ifdef CONFIG_NET_TCP_HASH
+/* The same listeners hashed by local port.  Each chain is linked through
+ * lhash_flink.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_listenhash[CONFIG_NET_TCP_HASH_SIZE];
+
+/* Index of the listener hash chain for a local port (network order) */
+
+#  define TCP_LISTENHASH(p) \
+     ((unsigned int)((p) ^ ((p) >> 8)) % CONFIG_NET_TCP_HASH_SIZE)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -83,6 +96,27 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno, uint8_t domain)
 FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 #endif
 {
+#ifdef CONFIG_NET_TCP_HASH
+  FAR struct tcp_conn_s *conn;
+
+  /* Examine only the listeners that hash to this port number */
+
+  for (conn = g_tcp_listenhash[TCP_LISTENHASH(portno)];
+       conn != NULL;
+       conn = conn->lhash_flink)
+    {
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      if (conn->lport == portno && conn->domain == domain)
+#else
+      if (conn->lport == portno)
+#endif
+        {
+          /* Yes.. we found a listener on this port */
+
+          return conn;
+        }
+    }
+#else
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
@@ -105,6 +139,7 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
           return conn;
         }
     }
+#endif /* CONFIG_NET_TCP_HASH */
 
   /* No listener for this port */
 
@@ -134,6 +169,13 @@ void tcp_listen_initialize(void)
     {
       tcp_listenports[ndx] = NULL;
     }
+
+#ifdef CONFIG_NET_TCP_HASH
+  for (ndx = 0; ndx < CONFIG_NET_TCP_HASH_SIZE; ndx++)
+    {
+      g_tcp_listenhash[ndx] = NULL;
+    }
+#endif
 }
 
 /****************************************************************************
@@ -163,6 +205,29 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
         }
     }
 
+#ifdef CONFIG_NET_TCP_HASH
+  if (ret == OK)
+    {
+      FAR struct tcp_conn_s **link =
+        &g_tcp_listenhash[TCP_LISTENHASH(conn->lport)];
+
+      /* Remove the connection from its listener hash chain */
+
+      while (*link != NULL)
+        {
+          if (*link == conn)
+            {
+              *link = conn->lhash_flink;
+              break;
+            }
+
+          link = &(*link)->lhash_flink;
+        }
+
+      conn->lhash_flink = NULL;
+    }
+#endif
+
   net_unlock();
   return ret;
 }
@@ -220,6 +285,11 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               /* Yes.. we found it */
 
               tcp_listenports[ndx] = conn;
+#ifdef CONFIG_NET_TCP_HASH
+              conn->lhash_flink =
+                g_tcp_listenhash[TCP_LISTENHASH(conn->lport)];
+              g_tcp_listenhash[TCP_LISTENHASH(conn->lport)] = conn;
+#endif
               ret = OK;
               break;
             }
@@ -232,7 +232,8 @@ static inline void tcp_iob_work(FAR void *arg)
         {
           /* No.. ask for the IOB free notification again */
 
-          pinfo->key = iob_notifier_setup(LPWORK, tcp_iob_work, pinfo);
+          pinfo->key = iob_notifier_setup_user(LPWORK, tcp_iob_work, pinfo,
+                                               IOB_USER_TCP_WRB);
         }
     }
 
@@ -462,7 +463,8 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Ask for the IOB free notification */
 
-      info->key = iob_notifier_setup(LPWORK, tcp_iob_work, info);
+      info->key = iob_notifier_setup_user(LPWORK, tcp_iob_work, info,
+                                          IOB_USER_TCP_WRB);
     }
 
 #else
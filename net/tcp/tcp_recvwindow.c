@@ -53,32 +53,26 @@
 #include "tcp/tcp.h"
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: tcp_get_recvwindow
+ * Name: tcp_recv_mss
  *
  * Description:
- *   Calculate the TCP receive window for the specified device.
+ *   Calculate the MSS of packets received on the specified device.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev - The device that receives the packets.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The packet MSS.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
+static uint16_t tcp_recv_mss(FAR struct net_driver_s *dev)
 {
   uint16_t iplen;
-  uint16_t mss;
-  uint16_t recvwndo;
-#ifdef CONFIG_NET_TCP_READAHEAD
-  int  niob_avail;
-  int  nqentry_avail;
-#endif
 
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
@@ -104,7 +98,53 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
    * is the minimum size.
    */
 
-  mss = dev->d_pktsize - (NET_LL_HDRLEN(dev) + iplen + TCP_HDRLEN);
+  return dev->d_pktsize - (NET_LL_HDRLEN(dev) + iplen + TCP_HDRLEN);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_get_recvwindow
+ *
+ * Description:
+ *   Calculate the TCP receive window for the specified device.
+ *
+ * Input Parameters:
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The connection whose window is advertised.
+ *
+ * Returned Value:
+ *   The value of the TCP receive window to use.
+ *
+ ****************************************************************************/
+
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
+{
+  uint16_t mss;
+  uint32_t recvwndo;
+  uint32_t maxwndo;
+#ifdef CONFIG_NET_TCP_READAHEAD
+  int  niob_avail;
+  int  nqentry_avail;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint8_t  state;
+  uint8_t  shift;
+
+  /* The window field of a SYN or a SYNACK is never scaled (RFC 7323) */
+
+  state = conn->tcpstateflags & TCP_STATE_MASK;
+  shift = (state == TCP_SYN_SENT || state == TCP_SYN_RCVD) ?
+          0 : conn->rcv_wscale;
+  maxwndo = (uint32_t)UINT16_MAX << shift;
+#else
+  maxwndo = UINT16_MAX;
+#endif
+
+  mss = tcp_recv_mss(dev);
 
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Update the TCP received window based on read-ahead I/O buffer
@@ -139,8 +179,6 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
 
   if (nqentry_avail > 0 && niob_avail > 0)
     {
-      uint32_t rwnd;
-
       /* The optimal TCP window size is the amount of TCP data that we can
        * currently buffer via TCP read-ahead buffering plus MSS for the
        * device packet buffer.  This logic here assumes that all IOBs are
@@ -157,15 +195,11 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        * buffering for this connection.
        */
 
-      rwnd = (niob_avail * CONFIG_IOB_BUFSIZE) + mss;
-      if (rwnd > UINT16_MAX)
+      recvwndo = ((uint32_t)niob_avail * CONFIG_IOB_BUFSIZE) + mss;
+      if (recvwndo > maxwndo)
         {
-          rwnd = UINT16_MAX;
+          recvwndo = maxwndo;
         }
-
-      /* Save the new receive window size */
-
-      recvwndo = (uint16_t)rwnd;
     }
   else /* nqentry_avail == 0 || niob_avail == 0 */
 #endif
@@ -181,5 +215,63 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
       recvwndo = mss;
     }
 
-  return recvwndo;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* Scale the window for the 16-bit window field.  Round up so that the
+   * last MSS of a nearly exhausted IOB pool is not advertised as a zero
+   * window.
+   */
+
+  recvwndo = (recvwndo + (1 << shift) - 1) >> shift;
+  if (recvwndo > UINT16_MAX)
+    {
+      recvwndo = UINT16_MAX;
+    }
+#else
+  UNUSED(conn);
+  UNUSED(maxwndo);
+#endif
+
+  return (uint16_t)recvwndo;
 }
+
+/****************************************************************************
+ * Name: tcp_get_wscale
+ *
+ * Description:
+ *   Select the window scale factor that we will offer in a SYN or SYNACK.
+ *   The factor is the smallest shift that lets the largest window that the
+ *   IOB pool could ever back be advertised in the 16-bit window field.
+ *
+ * Input Parameters:
+ *   dev - The device that will carry the connection.
+ *
+ * Returned Value:
+ *   The window scale shift count, 0 through TCP_MAX_WSCALE.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_wscale(FAR struct net_driver_s *dev)
+{
+  uint32_t maxwndo;
+  uint8_t shift;
+
+  /* This is the largest window that tcp_get_recvwindow() can compute:
+   * every IOB above the throttle threshold free plus the packet buffer.
+   */
+
+  maxwndo = tcp_recv_mss(dev);
+#ifdef CONFIG_NET_TCP_READAHEAD
+  maxwndo += (uint32_t)(CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE) *
+             CONFIG_IOB_BUFSIZE;
+#endif
+
+  shift = 0;
+  while (shift < TCP_MAX_WSCALE && (maxwndo >> shift) > UINT16_MAX)
+    {
+      shift++;
+    }
+
+  return shift;
+}
+#endif
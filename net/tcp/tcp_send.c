@@ -152,7 +152,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]      = 0;
 
   tcp->tcpchksum    = 0;
-  tcp->tcpchksum    = ~tcp_ipv4_chksum(dev);
+  if (!NETDEV_TXCSUM(dev, NETDEV_CSUM_TCPV4))
+    {
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+    }
 
   /* Finish initializing the IP header and calculate the IP checksum */
 
@@ -167,7 +170,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~ipv4_chksum(dev);
+  if (!NETDEV_TXCSUM(dev, NETDEV_CSUM_IPV4))
+    {
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
 
   ninfo("IPv4 length: %d\n", ((int)ipv4->len[0] << 8) + ipv4->len[1]);
 
@@ -224,7 +230,10 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]     = 0;
 
   tcp->tcpchksum   = 0;
-  tcp->tcpchksum   = ~tcp_ipv6_chksum(dev);
+  if (!NETDEV_TXCSUM(dev, NETDEV_CSUM_TCPV6))
+    {
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
 
   /* Finish initializing the IP header (no IPv6 checksum) */
 
@@ -261,6 +270,17 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
 static void tcp_sendcomplete(FAR struct net_driver_s *dev,
                              FAR struct tcp_hdr_s *tcp)
 {
+#ifdef CONFIG_NETDEV_TXIOB
+  /* Only a segment with payload can refer to an IOB chain.  The payload
+   * may have been discarded (e.g., the connection is being reset).
+   */
+
+  if (dev->d_sndlen == 0)
+    {
+      dev->d_iob = NULL;
+    }
+#endif
+
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -341,6 +361,12 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
   memcpy(tcp->ackno, conn->rcvseq, 4);
   memcpy(tcp->seqno, conn->sndseq, 4);
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* Every segment ACKs all data received so far */
+
+  conn->ackpend = false;
+#endif
+
   tcp->srcport  = conn->lport;
   tcp->destport = conn->rport;
 
@@ -359,7 +385,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -372,6 +398,79 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
   tcp_sendcomplete(dev, tcp);
 }
 
+/****************************************************************************
+ * Name: tcp_reply
+ *
+ * Description:
+ *   Turn the received TCP segment in the device buffer into a reply to its
+ *   sender:  Swap the port numbers and IP addresses, set the packet length
+ *   and send it.  The TCP header must be complete except for the ports.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure to use in the send operation
+ *   tcp    - The TCP header in the device buffer
+ *   optlen - The length of the TCP options in the reply
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_reply(FAR struct net_driver_s *dev,
+                      FAR struct tcp_hdr_s *tcp, uint16_t optlen)
+{
+  uint16_t tmp16;
+
+  /* Swap port numbers. */
+
+  tmp16         = tcp->srcport;
+  tcp->srcport  = tcp->destport;
+  tcp->destport = tmp16;
+
+  /* Set the packet length and swap IP addresses. */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      /* Set the packet length to the size of the IPv6 + TCP headers */
+
+      dev->d_len = IPv6TCP_HDRLEN + optlen;
+
+      /* Swap IPv6 addresses */
+
+      net_ipv6addr_hdrcopy(ipv6->destipaddr, ipv6->srcipaddr);
+      net_ipv6addr_hdrcopy(ipv6->srcipaddr, dev->d_ipv6addr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      /* Set the packet length to the size of the IPv4 + TCP headers */
+
+      dev->d_len = IPv4TCP_HDRLEN + optlen;
+
+      /* Swap IPv4 addresses */
+
+      net_ipv4addr_hdrcopy(ipv4->destipaddr, ipv4->srcipaddr);
+      net_ipv4addr_hdrcopy(ipv4->srcipaddr, &dev->d_ipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  tcp_sendcomplete(dev, tcp);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -428,7 +527,6 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 void tcp_reset(FAR struct net_driver_s *dev)
 {
   FAR struct tcp_hdr_s *tcp = tcp_header(dev);
-  uint16_t tmp16;
   uint8_t seqbyte;
 
 #ifdef CONFIG_NET_STATISTICS
@@ -474,54 +572,120 @@ void tcp_reset(FAR struct net_driver_s *dev)
         }
     }
 
-  /* Swap port numbers. */
+  /* And send out the RST packet */
 
-  tmp16         = tcp->srcport;
-  tcp->srcport  = tcp->destport;
-  tcp->destport = tmp16;
+  tcp_reply(dev, tcp, 0);
+}
 
-  /* Set the packet length and swap IP addresses. */
+/****************************************************************************
+ * Name: tcp_synack_stateless
+ *
+ * Description:
+ *   Answer the SYN in the device buffer with a SYNACK that does not refer
+ *   to any connection structure (see tcp_syncookie_send()).
+ *
+ * Input Parameters:
+ *   dev - The device driver structure to use in the send operation
+ *   isn - Our initial sequence number
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+void tcp_synack_stateless(FAR struct net_driver_s *dev, uint32_t isn)
+{
+  FAR struct tcp_hdr_s *tcp = tcp_header(dev);
+  uint16_t tcp_mss;
+
+  /* Get the MSS value for this packet */
 
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
 #endif
     {
-      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
-
-      /* Set the packet length to the size of the IPv6 + TCP headers */
-
-      dev->d_len = IPv6TCP_HDRLEN;
-
-      /* Swap IPv6 addresses */
-
-      net_ipv6addr_hdrcopy(ipv6->destipaddr, ipv6->srcipaddr);
-      net_ipv6addr_hdrcopy(ipv6->srcipaddr, dev->d_ipv6addr);
+      tcp_mss = TCP_IPv6_MSS(dev);
     }
-#endif /* CONFIG_NET_IPv6 */
+#endif
 
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   else
 #endif
     {
-      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+      tcp_mss = TCP_IPv4_MSS(dev);
+    }
+#endif
 
-      /* Set the packet length to the size of the IPv4 + TCP headers */
+  /* Acknowledge the SYN and send our own */
 
-      dev->d_len = IPv4TCP_HDRLEN;
+  tcp_setsequence(tcp->ackno, tcp_getsequence(tcp->seqno) + 1);
+  tcp_setsequence(tcp->seqno, isn);
+  tcp->flags      = TCP_SYN | TCP_ACK;
 
-      /* Swap IPv4 addresses */
+  /* Advertise one segment:  The window is updated once the connection
+   * exists.
+   */
 
-      net_ipv4addr_hdrcopy(ipv4->destipaddr, ipv4->srcipaddr);
-      net_ipv4addr_hdrcopy(ipv4->srcipaddr, &dev->d_ipaddr);
-    }
-#endif /* CONFIG_NET_IPv4 */
+  tcp->wnd[0]     = tcp_mss >> 8;
+  tcp->wnd[1]     = tcp_mss & 0xff;
 
-  /* And send out the RST packet */
+  /* Only the TCP Maximum Segment Size option is sent */
 
-  tcp_sendcomplete(dev, tcp);
+  tcp->optdata[0] = TCP_OPT_MSS;
+  tcp->optdata[1] = TCP_OPT_MSS_LEN;
+  tcp->optdata[2] = tcp_mss >> 8;
+  tcp->optdata[3] = tcp_mss & 0xff;
+  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+
+  tcp_reply(dev, tcp, TCP_OPT_MSS_LEN);
 }
+#endif
+
+/****************************************************************************
+ * Name: tcp_ack_stateless
+ *
+ * Description:
+ *   Answer the segment in the device buffer with a bare ACK that does not
+ *   refer to any connection structure (see tcp_timewait_input()).
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure to use in the send operation
+ *   seqno - The sequence number of the ACK
+ *   ackno - The sequence number being acknowledged
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMEWAIT
+void tcp_ack_stateless(FAR struct net_driver_s *dev, uint32_t seqno,
+                       uint32_t ackno)
+{
+  FAR struct tcp_hdr_s *tcp = tcp_header(dev);
+
+  tcp_setsequence(tcp->seqno, seqno);
+  tcp_setsequence(tcp->ackno, ackno);
+  tcp->flags     = TCP_ACK;
+  tcp->tcpoffset = 5 << 4;
+
+  /* The connection is closed in both directions:  There is no window */
+
+  tcp->wnd[0]    = 0;
+  tcp->wnd[1]    = 0;
+
+  tcp_reply(dev, tcp, 0);
+}
+#endif
 
 /****************************************************************************
  * Name: tcp_ack
@@ -594,6 +758,49 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->optdata[3] = tcp_mss & 0xff;
   tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
 
+#ifdef CONFIG_NET_TCP_SACK
+  /* Offer selective ACKs in our SYN.  In a SYNACK, agree to them only if
+   * the peer offered them in its SYN.
+   */
+
+  if (ack == TCP_SYN || conn->sackperm)
+    {
+      FAR uint8_t *optdata = (FAR uint8_t *)tcp + TCP_HDRLEN +
+                             TCP_OPT_MSS_LEN;
+
+      optdata[0]      = TCP_OPT_NOOP;
+      optdata[1]      = TCP_OPT_NOOP;
+      optdata[2]      = TCP_OPT_SACK_PERM;
+      optdata[3]      = TCP_OPT_SACK_PERM_LEN;
+      tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN + 4) / 4) << 4;
+      dev->d_len     += 4;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* Offer window scaling in our SYN.  In a SYNACK, agree to it only if the
+   * peer offered it in its SYN.  Either way, the shift that we announce is
+   * the one that we will apply to our window once the connection is
+   * established.
+   */
+
+  if (ack == TCP_SYN || conn->wscale)
+    {
+      FAR uint8_t *optdata = (FAR uint8_t *)tcp +
+                             ((tcp->tcpoffset >> 4) << 2);
+
+      conn->wscale     = true;
+      conn->rcv_wscale = tcp_get_wscale(dev);
+
+      optdata[0]       = TCP_OPT_NOOP;
+      optdata[1]       = TCP_OPT_WS;
+      optdata[2]       = TCP_OPT_WS_LEN;
+      optdata[3]       = conn->rcv_wscale;
+      tcp->tcpoffset  += 1 << 4;  /* One more 32-bit word of options */
+      dev->d_len      += 4;
+    }
+#endif
+
   /* Complete the common portions of the TCP message */
 
   tcp_sendcommon(dev, conn, tcp);
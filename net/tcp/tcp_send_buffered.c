@@ -52,6 +52,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -156,6 +157,233 @@ static void psock_insert_segment(FAR struct tcp_wrbuffer_s *wrb,
     }
 }
 
+/****************************************************************************
+ * Name: psock_sack_mark
+ *
+ * Description:
+ *   Parse the SACK option of a received ACK and mark each un-ACKed write
+ *   buffer whose data lies entirely within one of the SACK blocks.
+ *
+ * Input Parameters:
+ *   conn  The TCP connection structure
+ *   tcp   The TCP header of the received ACK
+ *   ackno The cumulative ACK number of the received ACK
+ *
+ * Returned Value:
+ *   The highest sequence number selectively ACKed, or ackno if the ACK
+ *   holds no SACK blocks.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+static uint32_t psock_sack_mark(FAR struct tcp_conn_s *conn,
+                                FAR struct tcp_hdr_s *tcp, uint32_t ackno)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR uint8_t *optdata = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  unsigned int optlen = ((tcp->tcpoffset >> 4) << 2) - TCP_HDRLEN;
+  unsigned int i = 0;
+  unsigned int j;
+  uint32_t sackhigh = ackno;
+  uint32_t left;
+  uint32_t right;
+
+  while (i < optlen && optdata[i] != TCP_OPT_END)
+    {
+      if (optdata[i] == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+
+      if (i + 1 >= optlen || optdata[i + 1] < 2 ||
+          i + optdata[i + 1] > optlen)
+        {
+          /* Malformed options */
+
+          break;
+        }
+
+      if (optdata[i] == TCP_OPT_SACK)
+        {
+          /* Each block is a pair of 32-bit sequence numbers:  The first
+           * byte selectively ACKed and the byte following the last one.
+           */
+
+          for (j = i + 2; j + 8 <= i + optdata[i + 1]; j += 8)
+            {
+              left  = tcp_getsequence(&optdata[j]);
+              right = tcp_getsequence(&optdata[j + 4]);
+
+              if ((int32_t)(right - sackhigh) > 0)
+                {
+                  sackhigh = right;
+                }
+
+              for (entry = sq_peek(&conn->unacked_q); entry;
+                   entry = sq_next(entry))
+                {
+                  wrb = (FAR struct tcp_wrbuffer_s *)entry;
+                  if ((int32_t)(TCP_WBSEQNO(wrb) - left) >= 0 &&
+                      (int32_t)(right - TCP_WBSEQNO(wrb) -
+                                TCP_WBPKTLEN(wrb)) >= 0)
+                    {
+                      TCP_WBSACKED(wrb) = true;
+                    }
+                }
+            }
+        }
+
+      i += optdata[i + 1];
+    }
+
+  return sackhigh;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/****************************************************************************
+ * Name: psock_fast_rexmit
+ *
+ * Description:
+ *   Perform the fast retransmission requested by tcp_input():  Move one
+ *   un-ACKed write buffer back to the write_q so that it is sent next,
+ *   without waiting for the retransmission timer and without resending
+ *   the data that follows it.
+ *
+ * Input Parameters:
+ *   conn     The TCP connection structure
+ *   sackhigh The highest sequence number selectively ACKed (SACK only)
+ *
+ * Returned Value:
+ *   true if there is now data to retransmit.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+static bool psock_fast_rexmit(FAR struct tcp_conn_s *conn, uint32_t sackhigh)
+{
+  FAR struct tcp_wrbuffer_s *wrb = NULL;
+  uint8_t mode = conn->fastrexmit;
+  bool unacked = true;
+  uint16_t sent;
+
+  conn->fastrexmit = TCP_FR_NONE;
+
+#ifdef CONFIG_NET_TCP_SACK
+  if (mode == TCP_FR_ENTER || mode == TCP_FR_SACK)
+    {
+      FAR struct tcp_wrbuffer_s *tmp;
+      FAR sq_entry_t *entry;
+
+      for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+        {
+          tmp = (FAR struct tcp_wrbuffer_s *)entry;
+
+          if (mode == TCP_FR_ENTER)
+            {
+              /* A new recovery:  Nothing has been retransmitted in it */
+
+              TCP_WBREXMIT(tmp) = false;
+            }
+
+          /* After a further duplicate ACK, pick the lowest write buffer
+           * below the highest SACKed data that was neither SACKed nor
+           * already retransmitted.
+           */
+
+          else if (!TCP_WBSACKED(tmp) && !TCP_WBREXMIT(tmp) &&
+                   (int32_t)(TCP_WBSEQNO(tmp) - sackhigh) < 0)
+            {
+              wrb = tmp;
+              break;
+            }
+        }
+
+      if (mode == TCP_FR_SACK && wrb == NULL)
+        {
+          return false;
+        }
+    }
+#else
+  UNUSED(sackhigh);
+#endif
+
+  if (mode != TCP_FR_SACK)
+    {
+      /* On entering recovery or after a partial ACK, retransmit the first
+       * un-ACKed data.
+       */
+
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->unacked_q);
+      if (wrb == NULL)
+        {
+          /* The un-ACKed data may be the sent part of the head of the
+           * write_q.  Just start sending that write buffer again.
+           */
+
+          wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+          if (wrb == NULL || TCP_WBSENT(wrb) == 0)
+            {
+              return false;
+            }
+
+          unacked = false;
+        }
+    }
+
+  ninfo("FASTREXMIT: wrb=%p seqno=%u sent=%u mode=%u\n",
+        wrb, TCP_WBSEQNO(wrb), TCP_WBSENT(wrb), mode);
+
+  /* Reset the number of bytes sent from the write buffer, as the timer
+   * driven retransmission does.
+   */
+
+  sent = TCP_WBSENT(wrb);
+  if (conn->unacked > sent)
+    {
+      conn->unacked -= sent;
+    }
+  else
+    {
+      conn->unacked = 0;
+    }
+
+  if (conn->sent > sent)
+    {
+      conn->sent -= sent;
+    }
+  else
+    {
+      conn->sent = 0;
+    }
+
+  TCP_WBSENT(wrb) = 0;
+  TCP_WBNRTX(wrb)++;
+#ifdef CONFIG_NET_TCP_SACK
+  TCP_WBREXMIT(wrb) = true;
+#endif
+
+  /* Move a write buffer taken from the unacked_q to the write_q, in
+   * sequence number order, so that it is the next one sent.
+   */
+
+  if (unacked)
+    {
+      sq_rem(&wrb->wb_node, &conn->unacked_q);
+      psock_insert_segment(wrb, &conn->write_q);
+    }
+
+  return true;
+}
+#endif /* CONFIG_NET_TCP_FAST_REXMIT */
+
 /****************************************************************************
  * Name: psock_lost_connection
  *
@@ -411,6 +639,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)pvconn;
   FAR struct socket *psock = (FAR struct socket *)pvpriv;
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+  bool rexmit = false;
+#endif
 
   /* The TCP socket is connected and, hence, should be bound to a device.
    * Make sure that the polling device is the one that we are bound to.
@@ -435,6 +666,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
       uint32_t ackno;
+#ifdef CONFIG_NET_TCP_SACK
+      uint32_t sackhigh;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+      uint32_t acked = 0;
+#endif
 
       /* Get the offset address of the TCP header */
 
@@ -463,6 +700,16 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       ackno = tcp_getsequence(tcp->ackno);
       ninfo("ACK: ackno=%u flags=%04x\n", ackno, flags);
 
+#ifdef CONFIG_NET_TCP_SACK
+      /* Mark the write buffers that the peer has selectively ACKed */
+
+      sackhigh = ackno;
+      if (conn->sackperm)
+        {
+          sackhigh = psock_sack_mark(conn, tcp, ackno);
+        }
+#endif
+
       /* Look at every write buffer in the unacked_q.  The unacked_q
        * holds write buffers that have been entirely sent, but which
        * have not yet been ACKed.
@@ -497,6 +744,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                 {
                   ninfo("ACK: wrb=%p Freeing write buffer\n", wrb);
 
+#ifdef CONFIG_NET_TCP_CC
+                  acked += lastseq - TCP_WBSEQNO(wrb);
+#endif
+
                   /* Yes... Remove the write buffer from ACK waiting queue */
 
                   sq_rem(entry, &conn->unacked_q);
@@ -524,6 +775,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                     }
 
                   ninfo("ACK: wrb=%p trim %u bytes\n", wrb, trimlen);
+#ifdef CONFIG_NET_TCP_CC
+                  acked += trimlen;
+#endif
 
                   TCP_WBTRIM(wrb, trimlen);
                   TCP_WBSEQNO(wrb) = ackno;
@@ -560,6 +814,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u nacked=%u sent=%u ackno=%u\n",
                 wrb, TCP_WBSEQNO(wrb), nacked, TCP_WBSENT(wrb), ackno);
 
+#ifdef CONFIG_NET_TCP_CC
+          acked += nacked;
+#endif
+
           /* Trim the ACKed bytes from the beginning of the write buffer. */
 
           TCP_WBTRIM(wrb, nacked);
@@ -569,6 +827,27 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Open the congestion window by the amount of data just ACKed */
+
+      tcp_cc_ack(conn, acked);
+#endif
+
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+      /* Perform any fast retransmission requested by tcp_input() now,
+       * while handling the ACK that requested it.
+       */
+
+      if (conn->fastrexmit != TCP_FR_NONE)
+        {
+#ifdef CONFIG_NET_TCP_SACK
+          rexmit = psock_fast_rexmit(conn, sackhigh);
+#else
+          rexmit = psock_fast_rexmit(conn, ackno);
+#endif
+        }
+#endif
     }
 
   /* Check for a loss of connection */
@@ -764,7 +1043,11 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
    */
 
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+      ((flags & (TCP_POLL | TCP_REXMIT)) || rexmit) &&
+#else
       (flags & (TCP_POLL | TCP_REXMIT)) &&
+#endif
       !(sq_empty(&conn->write_q)))
     {
       /* Check if the destination IP address is in the ARP  or Neighbor
@@ -803,6 +1086,60 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = conn->winsize;
             }
 
+#ifdef CONFIG_NET_TCP_CC
+          /* Do not put more data in flight than the congestion window
+           * allows.  The window may be overshot by less than one segment
+           * so that full-sized segments are sent.  A fast retransmission
+           * is sent regardless (RFC 5681).
+           */
+
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+          if (!rexmit && conn->unacked >= conn->cwnd)
+#else
+          if (conn->unacked >= conn->cwnd)
+#endif
+            {
+              ninfo("SEND: cwnd=%u full, unacked=%u\n",
+                    conn->cwnd, conn->unacked);
+              return flags;
+            }
+#endif
+
+#ifdef CONFIG_NET_TCP_NAGLE
+          /* Hold back a segment smaller than the MSS:  With TCP_CORK, until
+           * more data fills it or it has waited for TCP_CORK_TIMEOUT.
+           * Otherwise, while earlier data is still un-ACKed (RFC 896).
+           * Retransmissions are never held back.
+           */
+
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+          if (sndlen < conn->mss && TCP_WBNRTX(wrb) == 0 && !rexmit)
+#else
+          if (sndlen < conn->mss && TCP_WBNRTX(wrb) == 0)
+#endif
+            {
+              if (conn->cork)
+                {
+                  if (!conn->corkwait)
+                    {
+                      conn->corkwait = true;
+                      conn->corktime = clock_systimer();
+                    }
+
+                  if (clock_systimer() - conn->corktime < TCP_CORK_TIMEOUT)
+                    {
+                      return flags;
+                    }
+                }
+              else if (!conn->nodelay && conn->unacked > 0)
+                {
+                  return flags;
+                }
+            }
+
+          conn->corkwait = false;
+#endif
+
           ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u\n",
                 wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen);
 
@@ -839,7 +1176,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
            * won't actually happen until the polling cycle completes).
            */
 
-          devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
+          devif_iob_sendref(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
 
           /* Remember how much data we send out now so that we know
            * when everything has been acknowledged.  Just increment
@@ -952,21 +1289,77 @@ static inline void send_txnotify(FAR struct socket *psock,
 #endif /* CONFIG_NET_IPv6 */
 }
 
+/****************************************************************************
+ * Name: psock_wrb_copyin
+ *
+ * Description:
+ *   Append the data described by an I/O vector to a write buffer.  If
+ *   'nonblock' is true, no I/O buffers are waited for and less than all of
+ *   the data may be appended.
+ *
+ * Returned Value:
+ *   The number of bytes appended or, if nothing could be appended, a
+ *   negated errno value.
+ *
+ ****************************************************************************/
+
+static ssize_t psock_wrb_copyin(FAR struct tcp_wrbuffer_s *wrb,
+                                FAR const struct iovec *iov, int iovcnt,
+                                bool nonblock)
+{
+  unsigned int pktlen = TCP_WBPKTLEN(wrb);
+  int ret = OK;
+  int i;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      if (nonblock)
+        {
+          ret = TCP_WBTRYAPPEND(wrb, (FAR uint8_t *)iov[i].iov_base,
+                                iov[i].iov_len);
+        }
+      else
+        {
+          ret = TCP_WBAPPEND(wrb, (FAR uint8_t *)iov[i].iov_base,
+                             iov[i].iov_len);
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  if (TCP_WBPKTLEN(wrb) > pktlen || ret >= 0)
+    {
+      return TCP_WBPKTLEN(wrb) - pktlen;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: psock_tcp_send
+ * Name: psock_tcp_sendv
  *
  * Description:
- *   psock_tcp_send() call may be used only when the TCP socket is in a
- *   connected state (so that the intended recipient is known).
+ *   psock_tcp_sendv() call may be used only when the TCP socket is in a
+ *   connected state (so that the intended recipient is known).  The data
+ *   of all entries of the I/O vector is queued in one write buffer and so
+ *   may be sent in a single segment.
  *
  * Input Parameters:
  *   psock    An instance of the internal socket structure.
- *   buf      Data to send
- *   len      Length of data to send
+ *   iov      Data to send
+ *   iovcnt   Number of entries in iov
  *
  * Returned Value:
  *   On success, returns the number of characters sent.  On  error,
@@ -1011,13 +1404,20 @@ static inline void send_txnotify(FAR struct socket *psock,
  *
  ****************************************************************************/
 
-ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
-                       size_t len)
+ssize_t psock_tcp_sendv(FAR struct socket *psock,
+                        FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
   ssize_t    result = 0;
+  size_t     len = 0;
   int        ret = OK;
+  int        i;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
 
   if (psock == NULL || psock->s_crefs <= 0)
     {
@@ -1073,7 +1473,10 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   /* Dump the incoming buffer */
 
-  BUF_DUMP("psock_tcp_send", buf, len);
+  for (i = 0; i < iovcnt; i++)
+    {
+      BUF_DUMP("psock_tcp_sendv", iov[i].iov_base, iov[i].iov_len);
+    }
 
   /* Set the socket state to sending */
 
@@ -1081,11 +1484,46 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   if (len > 0)
     {
+      net_lock();
+
+#ifdef CONFIG_NET_TCP_NAGLE
+      /* Try to coalesce a small write with the write buffer at the tail of
+       * the write_q.  That is possible if nothing has been sent from that
+       * write buffer yet and if the result still fits in one segment.
+       */
+
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_tail(&conn->write_q);
+      if (wrb != NULL && TCP_WBSEQNO(wrb) == (unsigned)-1 &&
+          TCP_WBSENT(wrb) == 0 && TCP_WBPKTLEN(wrb) + len <= conn->mss)
+        {
+          if (_SS_ISNONBLOCK(psock->s_flags))
+            {
+              /* Report any part of the data that could be appended */
+
+              result = psock_wrb_copyin(wrb, iov, iovcnt, true);
+              if (result <= 0)
+                {
+                  ret = -EWOULDBLOCK;
+                  goto errout_with_lock;
+                }
+            }
+          else
+            {
+              result = psock_wrb_copyin(wrb, iov, iovcnt, false);
+            }
+
+          ninfo("Appended to WRB=%p pktlen=%u\n", wrb, TCP_WBPKTLEN(wrb));
+
+          send_txnotify(psock, conn);
+          net_unlock();
+          goto out;
+        }
+#endif
+
       /* Allocate a write buffer.  Careful, the network will be momentarily
        * unlocked here.
        */
 
-      net_lock();
       if (_SS_ISNONBLOCK(psock->s_flags))
         {
           wrb = tcp_wrbuffer_tryalloc();
@@ -1140,37 +1578,27 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
       if (_SS_ISNONBLOCK(psock->s_flags))
         {
-          /* The return value from TCP_WBTRYCOPYIN is either OK or
-           * -ENOMEM if less than the entire data chunk could be allocated.
-           * If -ENOMEM is returned, check if at least a part of the data
-           * chunk was allocated. If more than zero bytes were sent
-           * we return that number and let the caller deal with sending the
-           * remaining data.
+          /* psock_wrb_copyin() returns the number of bytes that could be
+           * added to the I/O buffer chain.  If that is less than all of the
+           * data, we return that number and let the caller deal with
+           * sending the remaining data.
            */
 
-          result = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)buf, len);
-          if (result == -ENOMEM)
+          result = psock_wrb_copyin(wrb, iov, iovcnt, true);
+          if (result <= 0)
             {
-              if (TCP_WBPKTLEN(wrb) > 0)
-                {
-                  ninfo("INFO: Allocated part of the requested data\n");
-                  result = TCP_WBPKTLEN(wrb);
-                }
-              else
-                {
-                  nerr("ERROR: Failed to add data to the I/O buffer chain\n");
-                  ret = -EWOULDBLOCK;
-                  goto errout_with_wrb;
-                }
+              nerr("ERROR: Failed to add data to the I/O buffer chain\n");
+              ret = -EWOULDBLOCK;
+              goto errout_with_wrb;
             }
-          else
+          else if (result < len)
             {
-              result = len;
+              ninfo("INFO: Allocated part of the requested data\n");
             }
         }
       else
         {
-          result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)buf, len);
+          result = psock_wrb_copyin(wrb, iov, iovcnt, false);
         }
 
       /* Dump I/O buffer chain */
@@ -1192,6 +1620,10 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       net_unlock();
     }
 
+#ifdef CONFIG_NET_TCP_NAGLE
+out:
+#endif
+
   /* Set the socket state to idle */
 
   psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_IDLE);
@@ -1225,6 +1657,32 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_tcp_send
+ *
+ * Description:
+ *   psock_tcp_send() call may be used only when the TCP socket is in a
+ *   connected state (so that the intended recipient is known).  See
+ *   psock_tcp_sendv() for the description of the returned value.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   buf      Data to send
+ *   len      Length of data to send
+ *
+ ****************************************************************************/
+
+ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
+                       size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buf;
+  iov.iov_len  = len;
+
+  return psock_tcp_sendv(psock, &iov, 1);
+}
+
 /****************************************************************************
  * Name: psock_tcp_cansend
  *
@@ -1275,7 +1733,7 @@ int psock_tcp_cansend(FAR struct socket *psock)
    * need to have more than one free IOB, but we don't know how many more.
    */
 
-  if (tcp_wrbuffer_test() < 0 || iob_navail(false) <= 0)
+  if (tcp_wrbuffer_test() < 0 || iob_navail_user(IOB_USER_TCP_WRB) <= 0)
     {
       return -EWOULDBLOCK;
     }
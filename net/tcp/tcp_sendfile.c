@@ -58,6 +58,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -99,8 +100,10 @@ struct sendfile_s
   FAR struct devif_callback_s *snd_datacb; /* Data callback */
   FAR struct devif_callback_s *snd_ackcb;  /* ACK callback */
   FAR struct file   *snd_file;    /* File structure of the input file */
+  FAR const uint8_t *snd_map;     /* Memory-mapped file data (or NULL) */
   sem_t              snd_sem;     /* Used to wake up the waiting thread */
   off_t              snd_foffset; /* Input file offset */
+  off_t              snd_fpos;    /* Current input file position */
   size_t             snd_flen;    /* File length */
   ssize_t            snd_sent;    /* The number of bytes sent */
   uint32_t           snd_isn;     /* Initial sequence number */
@@ -179,7 +182,7 @@ static uint16_t ack_eventhandler(FAR struct net_driver_s *dev,
       if (IFF_IS_IPv6(dev->d_flags))
 #endif
         {
-          DEBUGASSERT(pstate->snd_sock == PF_INET6);
+          DEBUGASSERT(pstate->snd_sock->s_domain == PF_INET6);
           tcp = TCPIPv6BUF;
         }
 #endif /* CONFIG_NET_IPv6 */
@@ -189,7 +192,7 @@ static uint16_t ack_eventhandler(FAR struct net_driver_s *dev,
       else
 #endif
         {
-          DEBUGASSERT(pstate->snd_sock == PF_INET);
+          DEBUGASSERT(pstate->snd_sock->s_domain == PF_INET);
           tcp = TCPIPv4BUF;
         }
 #endif /* CONFIG_NET_IPv4 */
@@ -318,9 +321,72 @@ static inline bool sendfile_addrcheck(FAR struct tcp_conn_s *conn)
 }
 
 #else /* CONFIG_NET_ETHERNET */
-#  sendfile_addrcheck(r) (true)
+#  define sendfile_addrcheck(r) (true)
 #endif /* CONFIG_NET_ETHERNET */
 
+/****************************************************************************
+ * Name: sendfile_read
+ *
+ * Description:
+ *   Copy the next 'sndlen' bytes of the file, starting at the current send
+ *   offset, into the device packet buffer.  Memory-mapped files (ROMFS with
+ *   XIP, TMPFS) are copied directly from the file data; otherwise the data
+ *   are read straight into the packet buffer, seeking only when the
+ *   position has moved because of a retransmission.
+ *
+ * Input Parameters:
+ *   pstate - send state structure
+ *   buffer - The packet buffer to receive the data
+ *   sndlen - The number of bytes to copy
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static int sendfile_read(FAR struct sendfile_s *pstate, FAR uint8_t *buffer,
+                         size_t sndlen)
+{
+  off_t pos = pstate->snd_foffset + pstate->snd_sent;
+  ssize_t nread;
+
+  if (pstate->snd_map != NULL)
+    {
+      memcpy(buffer, pstate->snd_map + pos, sndlen);
+      return OK;
+    }
+
+  if (pos != pstate->snd_fpos)
+    {
+      off_t ret = file_seek(pstate->snd_file, pos, SEEK_SET);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to lseek: %d\n", (int)ret);
+          pstate->snd_fpos = -1;
+          return (int)ret;
+        }
+
+      pstate->snd_fpos = pos;
+    }
+
+  /* The send length was clipped to the file size when the transfer was
+   * started, so a short read indicates that the file has changed.
+   */
+
+  nread = file_read(pstate->snd_file, buffer, sndlen);
+  if (nread < 0)
+    {
+      pstate->snd_fpos = -1;
+      return (int)nread;
+    }
+
+  pstate->snd_fpos += nread;
+  return ((size_t)nread == sndlen) ? OK : -EIO;
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -418,19 +484,10 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
-          if (ret < 0)
-            {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
-            }
-
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+          ret = sendfile_read(pstate, dev->d_appdata, sndlen);
           if (ret < 0)
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
+              nerr("ERROR: Failed to read from input file: %d\n", ret);
               pstate->snd_sent = ret;
               goto end_wait;
             }
@@ -584,8 +641,12 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
                       FAR off_t *offset, size_t count)
 {
   FAR struct tcp_conn_s *conn;
+  FAR void *map = NULL;
   struct sendfile_s state;
-  int ret;
+  off_t origpos;
+  off_t startpos;
+  off_t fsize;
+  int ret = OK;
 
   /* If this is an un-connected socket, then return ENOTCONN */
 
@@ -631,6 +692,48 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
+  /* Find where the transfer starts and clip it to the end of the file so
+   * that every packet can be filled completely.
+   */
+
+  origpos = file_seek(infile, 0, SEEK_CUR);
+  if (origpos < 0)
+    {
+      return (ssize_t)origpos;
+    }
+
+  startpos = (offset != NULL) ? *offset : origpos;
+
+  fsize = file_seek(infile, 0, SEEK_END);
+  if (fsize < 0)
+    {
+      return (ssize_t)fsize;
+    }
+
+  if (startpos >= fsize)
+    {
+      count = 0;
+    }
+  else if (count > (size_t)(fsize - startpos))
+    {
+      count = fsize - startpos;
+    }
+
+  if (count == 0)
+    {
+      (void)file_seek(infile, origpos, SEEK_SET);
+      return 0;
+    }
+
+  /* If the file data are directly addressable (ROMFS with XIP, TMPFS), copy
+   * from them into the packet buffer without going through file_read().
+   */
+
+  if (file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&map)) < 0)
+    {
+      map = NULL;
+    }
+
   /* Set the socket state to sending */
 
   psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
@@ -651,9 +754,11 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   nxsem_setprotocol(&state.snd_sem, SEM_PRIO_NONE);
 
   state.snd_sock    = psock;                /* Socket descriptor to use */
-  state.snd_foffset = offset ? *offset : 0; /* Input file offset */
+  state.snd_foffset = startpos;             /* Input file offset */
+  state.snd_fpos    = -1;                   /* Forces the first seek */
   state.snd_flen    = count;                /* Number of bytes to send */
   state.snd_file    = infile;               /* File to read from */
+  state.snd_map     = (FAR const uint8_t *)map;
 
   /* Allocate resources to receive a callback */
 
@@ -726,6 +831,25 @@ errout_locked:
   nxsem_destroy(&state. snd_sem);
   net_unlock();
 
+  /* Report the new offset.  If an offset was provided, the file position
+   * is left unchanged; otherwise the file position is advanced.
+   */
+
+  if (ret >= 0 && state.snd_sent > 0)
+    {
+      startpos += state.snd_sent;
+    }
+
+  if (offset != NULL)
+    {
+      *offset = startpos;
+      (void)file_seek(infile, origpos, SEEK_SET);
+    }
+  else
+    {
+      (void)file_seek(infile, startpos, SEEK_SET);
+    }
+
   if (ret < 0)
     {
       return ret;
@@ -51,6 +51,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/tcp.h>
 
+#include "netdev/netdev.h"
 #include "socket/socket.h"
 #include "utils/utils.h"
 #include "tcp/tcp.h"
@@ -88,9 +89,10 @@
 int tcp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_NAGLE)
+  /* Keep alive, congestion control and segment coalescing options are the
+   * only TCP protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -110,10 +112,58 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
+  /* Handle the TCP protocol options */
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_NAGLE
+      case TCP_NODELAY: /* Avoid coalescing of small segments. */
+      case TCP_CORK:    /* Send only full-sized segments */
+        if (value_len != sizeof(int))
+          {
+            ret = -EDOM;
+          }
+        else
+          {
+            int enable = *(FAR int *)value;
+
+            if (enable != 0 && enable != 1)
+              {
+                nerr("ERROR: TCP option %d value out of range: %d\n",
+                     option, enable);
+                return -EDOM;
+              }
+
+            net_lock();
+            if (option == TCP_NODELAY)
+              {
+                conn->nodelay = (bool)enable;
+              }
+            else
+              {
+                conn->cork     = (bool)enable;
+                conn->corkwait = false;
+              }
+
+            /* Segments that were held back may be sendable now */
+
+            if (conn->dev != NULL && (!conn->cork || conn->nodelay))
+              {
+                netdev_txnotify_dev(conn->dev);
+              }
+
+            net_unlock();
+            ret = OK;
+          }
+        break;
+#else
+      case TCP_NODELAY: /* Avoid coalescing of small segments. */
+        nerr("ERROR: TCP_NODELAY not supported\n");
+        ret = -ENOSYS;
+        break;
+#endif
+
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -148,11 +198,6 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
-      case TCP_NODELAY: /* Avoid coalescing of small segments. */
-        nerr("ERROR: TCP_NODELAY not supported\n");
-        ret = -ENOSYS;
-        break;
-
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (value_len != sizeof(struct timeval))
           {
@@ -251,6 +296,34 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        if (value_len == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            /* The name need not be NUL terminated, but it cannot be longer
+             * than any algorithm's name.
+             */
+
+            net_lock();
+            ret = tcp_cc_select(conn, (FAR const char *)value,
+                                value_len < TCP_CA_NAME_MAX ?
+                                value_len : TCP_CA_NAME_MAX);
+            net_unlock();
+
+            if (ret < 0)
+              {
+                nerr("ERROR: Unknown congestion control: %.*s\n",
+                     (int)value_len, (FAR const char *)value);
+              }
+          }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -261,7 +334,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || CONFIG_NET_TCP_NAGLE */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
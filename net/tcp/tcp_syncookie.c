@@ -0,0 +1,462 @@
+/****************************************************************************
+ * net/tcp/tcp_syncookie.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_SYNCOOKIES)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#ifdef CONFIG_CRYPTO_RANDOM_POOL
+#  include <sys/random.h>
+#endif
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+/* The cookie is our initial sequence number:
+ *
+ *   Bits 27-31: Time stamp in units of TCP_COOKIE_PERIOD seconds
+ *   Bits 24-26: Index of the peer's MSS in g_cookie_mss[]
+ *   Bits  0-23: Keyed hash of the addresses, ports, the peer's initial
+ *               sequence number and bits 24-31
+ *
+ * A cookie is accepted for TCP_COOKIE_MAXAGE periods after the one in
+ * which it was sent.
+ */
+
+#define TCP_COOKIE_PERIOD    64
+#define TCP_COOKIE_MAXAGE    1
+#define TCP_COOKIE_TSHIFT    27
+#define TCP_COOKIE_TMASK     0x1f
+#define TCP_COOKIE_MSSSHIFT  24
+#define TCP_COOKIE_MSSMASK   0x07
+#define TCP_COOKIE_HASHMASK  0x00ffffff
+
+/* The TCP default MSS when the peer sends no MSS option (RFC 879) */
+
+#define TCP_COOKIE_DEFMSS    536
+
+#define HSIP_ROTL(x,b)       (uint32_t)(((x) << (b)) | ((x) >> (32 - (b))))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The MSS values that can be encoded in a cookie, in ascending order */
+
+static const uint16_t g_cookie_mss[TCP_COOKIE_MSSMASK + 1] =
+{
+  536, 1024, 1220, 1360, 1400, 1440, 1452, 1460
+};
+
+/* The hash key; it is set up on first use */
+
+static uint32_t g_cookie_key[2];
+static bool g_cookie_keyed;
+
+/* The number of connections in the SYN_RCVD state */
+
+static uint16_t g_nsynrcvd;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cookie_time
+ *
+ * Description:
+ *   Return the current cookie time stamp.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tcp_cookie_time(void)
+{
+  return (uint32_t)(clock_systimer() / SEC2TICK(TCP_COOKIE_PERIOD)) &
+         TCP_COOKIE_TMASK;
+}
+
+/****************************************************************************
+ * Name: tcp_cookie_hash
+ *
+ * Description:
+ *   Compute the keyed hash of the addresses and ports of the received
+ *   segment, the peer's initial sequence number and a tag.  This is
+ *   HalfSipHash-2-4 over whole 32-bit words.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cookie_hash(FAR struct net_driver_s *dev,
+                                FAR struct tcp_hdr_s *tcp,
+                                uint32_t peerisn, uint32_t tag)
+{
+  uint32_t msg[11];
+  uint32_t v0;
+  uint32_t v1;
+  uint32_t v2;
+  uint32_t v3;
+  uint32_t b;
+  int nwords = 0;
+  int i;
+  int j;
+
+  if (!g_cookie_keyed)
+    {
+#ifdef CONFIG_CRYPTO_RANDOM_POOL
+      getrandom(g_cookie_key, sizeof(g_cookie_key));
+#else
+      /* REVISIT:  The system timer is only a weak source of entropy */
+
+      g_cookie_key[0] = (uint32_t)clock_systimer() * 0x9e3779b9;
+      g_cookie_key[1] = HSIP_ROTL(g_cookie_key[0], 13) ^ 0x85ebca6b;
+#endif
+      g_cookie_keyed  = true;
+    }
+
+  /* Collect the message words */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      for (i = 0; i < 8; i += 2)
+        {
+          msg[nwords++] = (uint32_t)ipv6->srcipaddr[i] << 16 |
+                          ipv6->srcipaddr[i + 1];
+        }
+
+      for (i = 0; i < 8; i += 2)
+        {
+          msg[nwords++] = (uint32_t)ipv6->destipaddr[i] << 16 |
+                          ipv6->destipaddr[i + 1];
+        }
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      msg[nwords++] = net_ip4addr_conv32(ipv4->srcipaddr);
+      msg[nwords++] = net_ip4addr_conv32(ipv4->destipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  msg[nwords++] = (uint32_t)tcp->srcport << 16 | tcp->destport;
+  msg[nwords++] = peerisn;
+  msg[nwords++] = tag;
+
+  /* And hash them */
+
+  v0 = g_cookie_key[0];
+  v1 = g_cookie_key[1];
+  v2 = 0x6c796765 ^ g_cookie_key[0];
+  v3 = 0x74656462 ^ g_cookie_key[1];
+
+#define HSIP_ROUND() \
+  do \
+    { \
+      v0 += v1; v1 = HSIP_ROTL(v1, 5); v1 ^= v0; v0 = HSIP_ROTL(v0, 16); \
+      v2 += v3; v3 = HSIP_ROTL(v3, 8); v3 ^= v2; \
+      v0 += v3; v3 = HSIP_ROTL(v3, 7); v3 ^= v0; \
+      v2 += v1; v1 = HSIP_ROTL(v1, 13); v1 ^= v2; v2 = HSIP_ROTL(v2, 16); \
+    } \
+  while (0)
+
+  for (i = 0; i < nwords; i++)
+    {
+      v3 ^= msg[i];
+      HSIP_ROUND();
+      HSIP_ROUND();
+      v0 ^= msg[i];
+    }
+
+  b   = (uint32_t)(nwords * 4) << 24;
+  v3 ^= b;
+  HSIP_ROUND();
+  HSIP_ROUND();
+  v0 ^= b;
+  v2 ^= 0xff;
+
+  for (j = 0; j < 4; j++)
+    {
+      HSIP_ROUND();
+    }
+
+#undef HSIP_ROUND
+
+  return v1 ^ v3;
+}
+
+/****************************************************************************
+ * Name: tcp_cookie_peermss
+ *
+ * Description:
+ *   Return the MSS option of the received SYN or the TCP default MSS.
+ *
+ ****************************************************************************/
+
+static uint16_t tcp_cookie_peermss(FAR struct net_driver_s *dev,
+                                   FAR struct tcp_hdr_s *tcp,
+                                   unsigned int hdrlen)
+{
+  FAR const uint8_t *opts = &dev->d_buf[hdrlen];
+  int optlen = (((tcp->tcpoffset >> 4) - 5) << 2);
+  int i;
+
+  for (i = 0; i < optlen; )
+    {
+      if (opts[i] == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opts[i] == TCP_OPT_NOOP)
+        {
+          i++;
+        }
+      else if (i + 1 >= optlen || opts[i + 1] == 0)
+        {
+          /* The options are malformed */
+
+          break;
+        }
+      else if (opts[i] == TCP_OPT_MSS && opts[i + 1] == TCP_OPT_MSS_LEN &&
+               i + TCP_OPT_MSS_LEN <= optlen)
+        {
+          return ((uint16_t)opts[i + 2] << 8) | (uint16_t)opts[i + 3];
+        }
+      else
+        {
+          i += opts[i + 1];
+        }
+    }
+
+  return TCP_COOKIE_DEFMSS;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_synrcvd_add and tcp_synrcvd_done
+ *
+ * Description:
+ *   Account for connections in the SYN_RCVD state.  tcp_synrcvd_add() is
+ *   called when a connection enters the TCP_SYN_RCVD state;
+ *   tcp_synrcvd_done() when it leaves it or is freed (only the first call
+ *   has an effect).
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+void tcp_synrcvd_add(FAR struct tcp_conn_s *conn)
+{
+  if (!conn->synrcvd)
+    {
+      conn->synrcvd = true;
+      g_nsynrcvd++;
+    }
+}
+
+void tcp_synrcvd_done(FAR struct tcp_conn_s *conn)
+{
+  if (conn->synrcvd)
+    {
+      DEBUGASSERT(g_nsynrcvd > 0);
+      conn->synrcvd = false;
+      g_nsynrcvd--;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_syncookie_needed
+ *
+ * Description:
+ *   Return true if a SYN received on a listening port should be answered
+ *   with a SYN cookie rather than by allocating a connection.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+bool tcp_syncookie_needed(void)
+{
+  return g_nsynrcvd >= CONFIG_NET_TCP_MAX_SYNRCVD;
+}
+
+/****************************************************************************
+ * Name: tcp_syncookie_send
+ *
+ * Description:
+ *   Answer the SYN in the device buffer with a SYNACK whose initial
+ *   sequence number is a SYN cookie.  No connection is allocated.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure holding the received SYN
+ *   tcp    - The TCP header of the received SYN
+ *   hdrlen - The offset of the TCP options in the device buffer
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+void tcp_syncookie_send(FAR struct net_driver_s *dev,
+                        FAR struct tcp_hdr_s *tcp, unsigned int hdrlen)
+{
+  uint16_t peermss;
+  uint32_t tag;
+  uint32_t cookie;
+  int idx;
+
+  /* Select the largest MSS that we can encode that the peer accepts */
+
+  peermss = tcp_cookie_peermss(dev, tcp, hdrlen);
+  for (idx = TCP_COOKIE_MSSMASK; idx > 0 && g_cookie_mss[idx] > peermss;
+       idx--);
+
+  tag    = tcp_cookie_time() << (TCP_COOKIE_TSHIFT - TCP_COOKIE_MSSSHIFT) |
+           (uint32_t)idx;
+  cookie = tag << TCP_COOKIE_MSSSHIFT |
+           (tcp_cookie_hash(dev, tcp, tcp_getsequence(tcp->seqno), tag) &
+            TCP_COOKIE_HASHMASK);
+
+  ninfo("SYN cookie %08x (MSS %u)\n", cookie, g_cookie_mss[idx]);
+  tcp_synack_stateless(dev, cookie);
+}
+
+/****************************************************************************
+ * Name: tcp_syncookie_accept
+ *
+ * Description:
+ *   Check if the ACK in the device buffer acknowledges a SYN cookie.  If
+ *   so, allocate the connection in the TCP_SYN_RCVD state as if the SYN
+ *   had been accepted normally.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure holding the received ACK
+ *   tcp - The TCP header of the received ACK
+ *
+ * Returned Value:
+ *   The new connection; NULL if the ACK is not for a valid cookie or if no
+ *   connection structure could be allocated.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+FAR struct tcp_conn_s *tcp_syncookie_accept(FAR struct net_driver_s *dev,
+                                            FAR struct tcp_hdr_s *tcp)
+{
+  FAR struct tcp_conn_s *conn;
+  uint32_t cookie;
+  uint32_t tag;
+  uint32_t age;
+  uint16_t mss;
+
+  /* The ACK acknowledges our SYN and follows the peer's SYN */
+
+  cookie = tcp_getsequence(tcp->ackno) - 1;
+  tag    = cookie >> TCP_COOKIE_MSSSHIFT;
+
+  age    = (tcp_cookie_time() - (cookie >> TCP_COOKIE_TSHIFT)) &
+           TCP_COOKIE_TMASK;
+  if (age > TCP_COOKIE_MAXAGE)
+    {
+      return NULL;
+    }
+
+  if ((tcp_cookie_hash(dev, tcp, tcp_getsequence(tcp->seqno) - 1, tag) &
+       TCP_COOKIE_HASHMASK) != (cookie & TCP_COOKIE_HASHMASK))
+    {
+      return NULL;
+    }
+
+  /* The cookie is valid.  Create the connection just as for a SYN:  The
+   * ACK sequence number is the one that we expect to receive next.
+   */
+
+  conn = tcp_alloc_accept(dev, tcp);
+  if (conn == NULL)
+    {
+      nerr("ERROR: No free TCP connections for SYN cookie\n");
+      return NULL;
+    }
+
+  conn->crefs = 1;
+  tcp_setsequence(conn->sndseq, cookie);
+
+  mss = g_cookie_mss[tag & TCP_COOKIE_MSSMASK];
+  if (mss < conn->mss)
+    {
+      conn->mss = mss;
+    }
+
+  ninfo("SYN cookie %08x accepted: conn=%p\n", cookie, conn);
+  return conn;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_SYNCOOKIES */
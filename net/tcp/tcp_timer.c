@@ -329,6 +329,19 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                      * the code for sending out the packet.
                      */
 
+#ifdef CONFIG_NET_TCP_FAST_REXMIT
+                    /* A timeout ends any fast recovery.  All un-ACKed data
+                     * will be sent again.
+                     */
+
+                    conn->dupacks    = 0;
+                    conn->fastrexmit = TCP_FR_NONE;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+                    /* Restart from the loss window */
+
+                    tcp_cc_loss(conn, true);
+#endif
                     result = tcp_callback(dev, conn, TCP_REXMIT);
                     tcp_rexmit(dev, conn, result);
                     goto done;
@@ -483,6 +496,16 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   dev->d_len = 0;
 
 done:
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* If nothing was sent that could carry it, send the delayed ACK now */
+
+  if (dev->d_len == 0 && conn->ackpend && conn->dev == dev &&
+      (conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+    {
+      tcp_send(dev, conn, TCP_ACK, hdrlen);
+    }
+#endif
+
   return;
 }
 
@@ -0,0 +1,356 @@
+/****************************************************************************
+ * net/tcp/tcp_timewait.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_TIMEWAIT)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+/* The length of one TCP timer period (TCP_TIME_WAIT_TIMEOUT units) */
+
+#define TCP_TW_HSEC_TICKS    MSEC2TICK(500)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A compact TIME_WAIT connection.  All that is kept is what is needed to
+ * recognize and acknowledge a retransmission of the peer's FIN.  An entry
+ * with lport == 0 is unused.
+ */
+
+struct tcp_timewait_s
+{
+  union ip_binding_u u;    /* Local and remote IP addresses */
+  clock_t  expires;        /* Time when the TIME_WAIT period ends */
+  uint32_t sndseq;         /* Our next sequence number */
+  uint32_t rcvseq;         /* The next sequence number from the peer */
+  uint16_t lport;          /* Local port (network order) */
+  uint16_t rport;          /* Remote port (network order) */
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  uint8_t  domain;         /* IP domain: PF_INET or PF_INET6 */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The entries form a FIFO in the order they were added.  All entries have
+ * (about) the same lifetime, so the oldest entry is also the first to
+ * expire and only the head of the FIFO needs to be checked; no timer is
+ * needed.
+ */
+
+static struct tcp_timewait_s g_tcp_timewait[CONFIG_NET_TCP_TIMEWAIT_CONNS];
+static uint16_t g_tw_head;
+static uint16_t g_tw_count;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_timewait_expired
+ *
+ * Description:
+ *   Return true if the entry is unused or its TIME_WAIT period is over.
+ *
+ ****************************************************************************/
+
+static inline bool tcp_timewait_expired(FAR struct tcp_timewait_s *tw,
+                                        clock_t now)
+{
+  return tw->lport == 0 || (sclock_t)(tw->expires - now) <= 0;
+}
+
+/****************************************************************************
+ * Name: tcp_timewait_expire
+ *
+ * Description:
+ *   Remove expired and unused entries from the head of the FIFO.
+ *
+ ****************************************************************************/
+
+static void tcp_timewait_expire(clock_t now)
+{
+  while (g_tw_count > 0 &&
+         tcp_timewait_expired(&g_tcp_timewait[g_tw_head], now))
+    {
+      g_tcp_timewait[g_tw_head].lport = 0;
+
+      if (++g_tw_head >= CONFIG_NET_TCP_TIMEWAIT_CONNS)
+        {
+          g_tw_head = 0;
+        }
+
+      g_tw_count--;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_timewait_match
+ *
+ * Description:
+ *   Return true if the entry holds the connection of the received segment.
+ *
+ ****************************************************************************/
+
+static bool tcp_timewait_match(FAR struct net_driver_s *dev,
+                               FAR struct tcp_hdr_s *tcp,
+                               FAR struct tcp_timewait_s *tw)
+{
+  if (tcp->destport != tw->lport || tcp->srcport != tw->rport)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+#ifdef CONFIG_NET_IPv4
+      if (tw->domain != PF_INET6)
+        {
+          return false;
+        }
+#endif
+
+      return net_ipv6addr_cmp(ipv6->srcipaddr, tw->u.ipv6.raddr) &&
+             net_ipv6addr_cmp(ipv6->destipaddr, tw->u.ipv6.laddr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+#ifdef CONFIG_NET_IPv6
+      if (tw->domain != PF_INET)
+        {
+          return false;
+        }
+#endif
+
+      return net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->srcipaddr),
+                              tw->u.ipv4.raddr) &&
+             net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                              tw->u.ipv4.laddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_timewait_add
+ *
+ * Description:
+ *   Record a connection that is being freed in the TIME_WAIT state as a
+ *   compact TIME_WAIT entry for the remainder of its TIME_WAIT period.
+ *
+ * Input Parameters:
+ *   conn - The connection in the TIME_WAIT state
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+void tcp_timewait_add(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_timewait_s *tw;
+  clock_t now = clock_systimer();
+  unsigned int remaining;
+  unsigned int ndx;
+
+  DEBUGASSERT(conn->tcpstateflags == TCP_TIME_WAIT);
+
+  /* In the TIME_WAIT state, the connection timer counts up to
+   * TCP_TIME_WAIT_TIMEOUT.
+   */
+
+  if (conn->timer >= TCP_TIME_WAIT_TIMEOUT)
+    {
+      return;
+    }
+
+  remaining = TCP_TIME_WAIT_TIMEOUT - conn->timer;
+
+  /* Make room, discarding the oldest entry if the FIFO is full */
+
+  tcp_timewait_expire(now);
+  if (g_tw_count >= CONFIG_NET_TCP_TIMEWAIT_CONNS)
+    {
+      nwarn("WARNING: Discarding oldest TIME_WAIT connection\n");
+
+      g_tcp_timewait[g_tw_head].lport = 0;
+      tcp_timewait_expire(now);
+    }
+
+  ndx = g_tw_head + g_tw_count;
+  if (ndx >= CONFIG_NET_TCP_TIMEWAIT_CONNS)
+    {
+      ndx -= CONFIG_NET_TCP_TIMEWAIT_CONNS;
+    }
+
+  tw          = &g_tcp_timewait[ndx];
+  tw->u       = conn->u;
+  tw->expires = now + remaining * TCP_TW_HSEC_TICKS;
+  tw->sndseq  = tcp_getsequence(conn->sndseq);
+  tw->rcvseq  = tcp_getsequence(conn->rcvseq);
+  tw->lport   = conn->lport;
+  tw->rport   = conn->rport;
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  tw->domain  = conn->domain;
+#endif
+
+  g_tw_count++;
+}
+
+/****************************************************************************
+ * Name: tcp_timewait_input
+ *
+ * Description:
+ *   Handle a received segment that matches no active connection but may
+ *   belong to a compact TIME_WAIT entry.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure holding the received segment
+ *   tcp - The TCP header of the received segment
+ *
+ * Returned Value:
+ *   true if the segment was consumed:  The device buffer then holds the
+ *   reply, if any.  false if no TIME_WAIT entry claims the segment and it
+ *   should be processed normally; the entry is discarded if the segment
+ *   is a SYN that may start a new connection.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+bool tcp_timewait_input(FAR struct net_driver_s *dev,
+                        FAR struct tcp_hdr_s *tcp)
+{
+  FAR struct tcp_timewait_s *tw;
+  clock_t now = clock_systimer();
+  unsigned int ndx;
+  unsigned int i;
+
+  tcp_timewait_expire(now);
+
+  for (i = 0, ndx = g_tw_head; i < g_tw_count; i++)
+    {
+      tw = &g_tcp_timewait[ndx];
+      if (!tcp_timewait_expired(tw, now) &&
+          tcp_timewait_match(dev, tcp, tw))
+        {
+          if ((tcp->flags & TCP_RST) != 0)
+            {
+              /* The peer has reset the connection: Forget it */
+
+              tw->lport  = 0;
+              dev->d_len = 0;
+              return true;
+            }
+
+          if ((tcp->flags & TCP_CTL) == TCP_SYN &&
+              (int32_t)(tcp_getsequence(tcp->seqno) - tw->rcvseq) > 0)
+            {
+              /* A new connection beyond the old sequence space (RFC 1122,
+               * 4.2.2.13): Let a listener accept it.
+               */
+
+              tw->lport = 0;
+              return false;
+            }
+
+          /* Anything else, most likely a retransmitted FIN, is answered
+           * with the final ACK.
+           */
+
+          tcp_ack_stateless(dev, tw->sndseq, tw->rcvseq);
+          return true;
+        }
+
+      if (++ndx >= CONFIG_NET_TCP_TIMEWAIT_CONNS)
+        {
+          ndx = 0;
+        }
+    }
+
+  return false;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_TIMEWAIT */
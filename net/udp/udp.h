@@ -108,6 +108,9 @@ struct udp_hdr_s;         /* Forward reference */
 struct udp_conn_s
 {
   dq_entry_t node;        /* Supports a doubly linked list */
+#ifdef CONFIG_NET_UDP_HASH
+  FAR struct udp_conn_s *hash_flink; /* Next in the local port hash chain */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
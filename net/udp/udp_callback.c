@@ -94,7 +94,7 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev, FAR struct udp_con
    * We will not wait for an I/O buffer to become available in this context.
    */
 
-  iob = iob_tryalloc(true);
+  iob = iob_tryalloc_user(true, IOB_USER_UDP);
   if (iob == NULL)
     {
       nerr("ERROR: Failed to create new I/O buffer chain\n");
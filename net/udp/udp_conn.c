@@ -73,6 +73,15 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_UDP_HASH
+/* Index of the hash chain for a local port number (network order) */
+
+#  define UDP_HASH(p) \
+     ((unsigned int)((p) ^ ((p) >> 8)) % CONFIG_NET_UDP_HASH_SIZE)
+#else
+#  define udp_setlport(conn, port) do { (conn)->lport = (port); } while (0)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,6 +99,14 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_HASH
+/* The bound UDP connections hashed by local port.  Each chain is linked
+ * through hash_flink.  Connections with no local port are not in the hash.
+ */
+
+static FAR struct udp_conn_s *g_udp_hash[CONFIG_NET_UDP_HASH_SIZE];
+#endif
+
 /* Last port used by a UDP connection connection. */
 
 static uint16_t g_last_udp_port;
@@ -126,6 +143,61 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_setlport
+ *
+ * Description:
+ *   Set the local port number (network order) of the connection and move
+ *   the connection to the matching hash chain.  A port number of zero
+ *   removes the connection from the hash.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_HASH
+static void udp_setlport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+  FAR struct udp_conn_s **link;
+
+  net_lock();
+
+  /* Remove the connection from the chain of its current port */
+
+  if (conn->lport != 0)
+    {
+      for (link = &g_udp_hash[UDP_HASH(conn->lport)];
+           *link != NULL;
+           link = &(*link)->hash_flink)
+        {
+          if (*link == conn)
+            {
+              *link = conn->hash_flink;
+              break;
+            }
+        }
+    }
+
+  conn->hash_flink = NULL;
+  conn->lport      = portno;
+
+  /* Then append it to the chain of the new port so that, as with the
+   * active list, the earliest bound connection is matched first.
+   */
+
+  if (portno != 0)
+    {
+      link = &g_udp_hash[UDP_HASH(portno)];
+      while (*link != NULL)
+        {
+          link = &(*link)->hash_flink;
+        }
+
+      *link = conn;
+    }
+
+  net_unlock();
+}
+#endif /* CONFIG_NET_UDP_HASH */
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -142,13 +214,22 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
+#ifndef CONFIG_NET_UDP_HASH
   int i;
+#endif
 
   /* Now search each connection structure. */
 
+#ifdef CONFIG_NET_UDP_HASH
+  for (conn = g_udp_hash[UDP_HASH(portno)];
+       conn != NULL;
+       conn = conn->hash_flink)
+    {
+#else
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       conn = &g_udp_connections[i];
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -266,7 +347,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_HASH
+  conn = g_udp_hash[UDP_HASH(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -379,7 +464,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_HASH
+      conn = conn->hash_flink;
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -405,7 +494,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_HASH
+  conn = g_udp_hash[UDP_HASH(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -517,7 +610,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_HASH
+      conn = conn->hash_flink;
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -587,6 +684,9 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       conn->boundto = 0;  /* Not bound to any interface */
 #endif
       conn->lport   = 0;
+#ifdef CONFIG_NET_UDP_HASH
+      conn->hash_flink = NULL;
+#endif
       conn->ttl     = IP_TTL;
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
@@ -623,7 +723,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_setlport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -772,7 +872,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_setlport(conn, htons(udp_select_port(conn->domain, &conn->u)));
       ret         = OK;
     }
   else
@@ -787,7 +887,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setlport(conn, portno);
           ret         = OK;
         }
       else
@@ -840,7 +940,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_setlport(conn, htons(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
@@ -131,7 +131,8 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
       if (IFF_IS_IPv6(dev->d_flags))
 #endif
         {
-          chksum = ~udp_ipv6_chksum(dev);
+          chksum = NETDEV_RXCSUM(dev, NETDEV_CSUM_UDPV6) ?
+                   0 : ~udp_ipv6_chksum(dev);
         }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -140,7 +141,8 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
       else
 #endif
         {
-          chksum = ~udp_ipv4_chksum(dev);
+          chksum = NETDEV_RXCSUM(dev, NETDEV_CSUM_UDPV4) ?
+                   0 : ~udp_ipv4_chksum(dev);
         }
 #endif /* CONFIG_NET_IPv6 */
      }
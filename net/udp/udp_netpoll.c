@@ -205,7 +205,8 @@ static inline void udp_iob_work(FAR void *arg)
         {
           /* No.. ask for the IOB free notification again */
 
-          pinfo->key = iob_notifier_setup(LPWORK, udp_iob_work, pinfo);
+          pinfo->key = iob_notifier_setup_user(LPWORK, udp_iob_work, pinfo,
+                                               IOB_USER_UDP);
         }
     }
 
@@ -404,7 +405,8 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Ask for the IOB free notification */
 
-      info->key = iob_notifier_setup(LPWORK, udp_iob_work, info);
+      info->key = iob_notifier_setup_user(LPWORK, udp_iob_work, info,
+                                          IOB_USER_UDP);
     }
 
 #else
@@ -922,7 +922,7 @@ int psock_udp_cansend(FAR struct socket *psock)
    * need to have more than one free IOB, but we don't know how many more.
    */
 
-  if (udp_wrbuffer_test() < 0 || iob_navail(false) <= 0)
+  if (udp_wrbuffer_test() < 0 || iob_navail_user(IOB_USER_UDP) <= 0)
     {
       return -EWOULDBLOCK;
     }
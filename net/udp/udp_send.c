@@ -100,6 +100,9 @@
 void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
 {
   FAR struct udp_hdr_s *udp;
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+  bool hwcsum = false;
+#endif
 
   ninfo("UDP payload: %d (%d) bytes\n", dev->d_sndlen, dev->d_len);
 
@@ -163,7 +166,10 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
           /* Calculate IP checksum. */
 
           ipv4->ipchksum    = 0;
-          ipv4->ipchksum    = ~ipv4_chksum(dev);
+          if (!NETDEV_TXCSUM(dev, NETDEV_CSUM_IPV4))
+            {
+              ipv4->ipchksum = ~ipv4_chksum(dev);
+            }
 
 #ifdef CONFIG_NET_STATISTICS
           g_netstats.ipv4.sent++;
@@ -225,7 +231,7 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
       udp->udpchksum   = 0;
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
-      /* Calculate UDP checksum. */
+      /* Calculate UDP checksum, unless the MAC will insert it. */
 
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
@@ -234,7 +240,11 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
            ip6_is_ipv4addr((FAR struct in6_addr *)conn->u.ipv6.raddr)))
 #endif
         {
-          udp->udpchksum = ~udp_ipv4_chksum(dev);
+          hwcsum = NETDEV_TXCSUM(dev, NETDEV_CSUM_UDPV4);
+          if (!hwcsum)
+            {
+              udp->udpchksum = ~udp_ipv4_chksum(dev);
+            }
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -243,11 +253,15 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
       else
 #endif
         {
-          udp->udpchksum = ~udp_ipv6_chksum(dev);
+          hwcsum = NETDEV_TXCSUM(dev, NETDEV_CSUM_UDPV6);
+          if (!hwcsum)
+            {
+              udp->udpchksum = ~udp_ipv6_chksum(dev);
+            }
         }
 #endif /* CONFIG_NET_IPv6 */
 
-      if (udp->udpchksum == 0)
+      if (!hwcsum && udp->udpchksum == 0)
         {
           udp->udpchksum = 0xffff;
         }
@@ -42,6 +42,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <queue.h>
 #include <stdint.h>
 #include <unistd.h>
 #include <string.h>
@@ -73,6 +74,22 @@
  * Private Types
  ****************************************************************************/
 
+/* Queued request.  Lives on the stack of the requesting thread until the
+ * daemon has taken delivery of it.
+ */
+
+struct usrsockdev_reqline_s
+{
+  sq_entry_t node;               /* Supports a singly linked list */
+  FAR const struct iovec *iov;   /* Request buffers */
+  int     iovcnt;                /* Number of request buffers */
+  size_t  total;                 /* Total length of request buffers */
+  uint8_t xid;                   /* Exchange id of request */
+  int     result;                /* OK when delivered, otherwise negated
+                                  * errno */
+  sem_t   acksem;                /* Request delivery notification */
+};
+
 struct usrsockdev_s
 {
   sem_t   devsem;     /* Lock for device node */
@@ -80,15 +97,8 @@ struct usrsockdev_s
 
   struct
   {
-    FAR const struct iovec *iov; /* Pending request buffers */
-    int     iovcnt;              /* Number of request buffers */
-    size_t  pos;                 /* Reader position on request buffer */
-    sem_t   sem;                 /* Request semaphore (only one outstanding
-                                  * request) */
-    sem_t   acksem;              /* Request acknowledgment notification */
-    uint8_t ack_xid;             /* Exchange id for which waiting ack */
-    uint16_t nbusy;              /* Number of requests blocked from different
-                                  * threads */
+    sq_queue_t queue;            /* Queued requests, head is being read */
+    size_t  pos;                 /* Reader position on head request */
   } req;
 
   FAR struct usrsock_conn_s *datain_conn; /* Connection instance to receive
@@ -361,6 +371,72 @@ static void usrsockdev_pollnotify(FAR struct usrsockdev_s *dev, pollevent_t even
 #endif
 }
 
+/****************************************************************************
+ * Name: usrsockdev_complete_request
+ *
+ * Description:
+ *   Remove request from the request queue and wake up the requesting
+ *   thread.  If more requests are queued, the daemon is notified that the
+ *   next one is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_complete_request(FAR struct usrsockdev_s *dev,
+                                        FAR struct usrsockdev_reqline_s *line,
+                                        int result)
+{
+  if (sq_peek(&dev->req.queue) == &line->node)
+    {
+      (void)sq_remfirst(&dev->req.queue);
+      dev->req.pos = 0;
+    }
+  else
+    {
+      sq_rem(&line->node, &dev->req.queue);
+    }
+
+  line->result = result;
+  nxsem_post(&line->acksem);
+
+  if (!sq_empty(&dev->req.queue))
+    {
+      usrsockdev_pollnotify(dev, POLLIN);
+    }
+}
+
+/****************************************************************************
+ * Name: usrsockdev_find_request
+ *
+ * Description:
+ *   Find queued request with matching exchange id.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static FAR struct usrsockdev_reqline_s *
+usrsockdev_find_request(FAR struct usrsockdev_s *dev, uint8_t xid)
+{
+  FAR sq_entry_t *node;
+
+  for (node = sq_peek(&dev->req.queue); node != NULL; node = sq_next(node))
+    {
+      FAR struct usrsockdev_reqline_s *line =
+        (FAR struct usrsockdev_reqline_s *)node;
+
+      if (line->xid == xid)
+        {
+          return line;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: usrsockdev_read
  ****************************************************************************/
@@ -370,6 +446,8 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct inode        *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_reqline_s *line;
+  ssize_t nread = 0;
 
   if (len == 0)
     {
@@ -392,35 +470,47 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
 
   /* Is request available? */
 
-  if (dev->req.iov)
+  while (len > 0 &&
+         (line = (FAR struct usrsockdev_reqline_s *)
+                 sq_peek(&dev->req.queue)) != NULL)
     {
       ssize_t rlen;
 
       /* Copy request to user-space. */
 
-      rlen = iovec_get(buffer, len, dev->req.iov, dev->req.iovcnt,
-                       dev->req.pos);
+      rlen = iovec_get(buffer, len, line->iov, line->iovcnt, dev->req.pos);
       if (rlen < 0)
         {
           /* Tried reading beyond buffer. */
 
-          len = 0;
+          rlen = 0;
         }
-      else
+
+      dev->req.pos += rlen;
+      buffer += rlen;
+      len -= rlen;
+      nread += rlen;
+
+#ifdef CONFIG_NET_USRSOCK_BATCH
+      /* Fully read requests are delivered right away, the requesting
+       * thread does not need to wait for the acknowledgment.  Continue
+       * with the next queued request while there is room in the buffer.
+       */
+
+      if (dev->req.pos >= line->total)
         {
-          dev->req.pos += rlen;
-          len = rlen;
+          usrsockdev_complete_request(dev, line, OK);
+          continue;
         }
-    }
-  else
-    {
-      len = 0;
+#endif
+
+      break;
     }
 
   net_unlock();
   usrsockdev_semgive(&dev->devsem);
 
-  return len;
+  return nread;
 }
 
 /****************************************************************************
@@ -431,6 +521,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset, int whence)
 {
   FAR struct inode        *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_reqline_s *line;
   off_t pos;
 
   if (whence != SEEK_CUR && whence != SEEK_SET)
@@ -449,7 +540,8 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Is request available? */
 
-  if (dev->req.iov)
+  line = (FAR struct usrsockdev_reqline_s *)sq_peek(&dev->req.queue);
+  if (line)
     {
       ssize_t rlen;
 
@@ -464,7 +556,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset, int whence)
 
       /* Copy request to user-space. */
 
-      rlen = iovec_get(NULL, 0, dev->req.iov, dev->req.iovcnt, pos);
+      rlen = iovec_get(NULL, 0, line->iov, line->iovcnt, pos);
       if (rlen < 0)
         {
           /* Tried seek beyond buffer. */
@@ -730,6 +822,7 @@ static ssize_t usrsockdev_handle_req_response(FAR struct usrsockdev_s *dev,
                                               size_t len)
 {
   FAR const struct usrsock_message_req_ack_s *hdr = buffer;
+  FAR struct usrsockdev_reqline_s *line;
   FAR struct usrsock_conn_s *conn;
   unsigned int hdrlen;
   ssize_t ret;
@@ -786,14 +879,13 @@ static ssize_t usrsockdev_handle_req_response(FAR struct usrsockdev_s *dev,
       goto unlock_out;
     }
 
-  if (dev->req.ack_xid == hdr->xid && dev->req.iov)
+  line = usrsockdev_find_request(dev, hdr->xid);
+  if (line)
     {
       /* Signal that request was received and read by daemon and acknowledgment
        * response was received. */
 
-      dev->req.iov = NULL;
-
-      nxsem_post(&dev->req.acksem);
+      usrsockdev_complete_request(dev, line, OK);
     }
 
   ret = handle_response(dev, conn, buffer);
@@ -857,69 +949,90 @@ static ssize_t usrsockdev_write(FAR struct file *filep, FAR const char *buffer,
 
   usrsockdev_semtake(&dev->devsem);
 
-  if (!dev->datain_conn)
-    {
-      /* Start of message, buffer length should be at least size of common
-       * message header. */
+  /* A single write may carry several messages back-to-back, each possibly
+   * followed by its data payload.  Handle them all in order.
+   */
 
-      if (len < sizeof(struct usrsock_message_common_s))
+  while (len > 0)
+    {
+      if (!dev->datain_conn)
         {
-          nwarn("message too short, %d < %d.\n", len,
-                sizeof(struct usrsock_message_common_s));
+          /* Start of message, buffer length should be at least size of
+           * common message header.
+           */
 
-          ret = -EINVAL;
-          goto errout;
-        }
+          if (len < sizeof(struct usrsock_message_common_s))
+            {
+              nwarn("message too short, %d < %d.\n", len,
+                    sizeof(struct usrsock_message_common_s));
 
-      /* Handle message. */
+              ret = -EINVAL;
+              break;
+            }
+
+          /* Handle message. */
+
+          ret = usrsockdev_handle_message(dev, buffer, len);
+          if (ret < 0)
+            {
+              break;
+            }
 
-      ret = usrsockdev_handle_message(dev, buffer, len);
-      if (ret >= 0)
-        {
           buffer += ret;
           len -= ret;
-          ret = origlen - len;
         }
-    }
 
-  /* Data input handling. */
+      /* Data input handling. */
 
-  if (dev->datain_conn)
-    {
-      conn = dev->datain_conn;
+      if (dev->datain_conn)
+        {
+          conn = dev->datain_conn;
 
-      /* Copy data from user-space. */
+          /* Copy data from user-space. */
 
-      ret = iovec_put(conn->resp.datain.iov, conn->resp.datain.iovcnt,
-                      conn->resp.datain.pos, buffer, len);
-      if (ret < 0)
-        {
-          /* Tried writing beyond buffer. */
+          ret = iovec_put(conn->resp.datain.iov, conn->resp.datain.iovcnt,
+                          conn->resp.datain.pos, buffer, len);
+          if (ret < 0)
+            {
+              /* Tried writing beyond buffer. */
 
-          ret = -EINVAL;
-          conn->resp.result = -EINVAL;
-          conn->resp.datain.pos =
-              conn->resp.datain.total;
-        }
-      else
-        {
-          conn->resp.datain.pos += ret;
-          buffer += ret;
-          len -= ret;
-          ret = origlen - len;
-        }
+              conn->resp.result = -EINVAL;
+              conn->resp.datain.pos =
+                  conn->resp.datain.total;
+            }
+          else
+            {
+              conn->resp.datain.pos += ret;
+              buffer += ret;
+              len -= ret;
+            }
 
-      if (conn->resp.datain.pos == conn->resp.datain.total)
-        {
-          dev->datain_conn = NULL;
+          if (conn->resp.datain.pos == conn->resp.datain.total)
+            {
+              dev->datain_conn = NULL;
 
-          /* Done with data response. */
+              /* Done with data response. */
 
-          (void)usrsock_event(conn, USRSOCK_EVENT_REQ_COMPLETE);
+              (void)usrsock_event(conn, USRSOCK_EVENT_REQ_COMPLETE);
+            }
+
+          if (ret < 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
         }
     }
 
-errout:
+  /* Report the messages consumed before any error, the daemon will see
+   * the error when it writes the remainder again.
+   */
+
+  if (len < origlen)
+    {
+      ret = origlen - len;
+    }
+
   usrsockdev_semgive(&dev->devsem);
   return ret;
 }
@@ -975,7 +1088,6 @@ static int usrsockdev_close(FAR struct file *filep)
   FAR struct inode *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
   FAR struct usrsock_conn_s *conn;
-  struct timespec abstime;
   int ret;
 
   DEBUGASSERT(inode);
@@ -1012,57 +1124,16 @@ static int usrsockdev_close(FAR struct file *filep)
   DEBUGASSERT(dev->ocount == 0);
   ret = OK;
 
-  do
-    {
-      /* Give other threads short time window to complete recently completed
-       * requests.
-       */
-
-      DEBUGVERIFY(clock_gettime(CLOCK_REALTIME, &abstime));
-
-      abstime.tv_sec += 0;
-      abstime.tv_nsec += 10 * NSEC_PER_MSEC;
-      if (abstime.tv_nsec >= NSEC_PER_SEC)
-        {
-          abstime.tv_sec++;
-          abstime.tv_nsec -= NSEC_PER_SEC;
-        }
+  /* Wake-up pending requests, the daemon will never read them. */
 
-      ret = net_timedwait(&dev->req.sem, &abstime);
-      if (ret < 0)
-        {
-          if (ret != -ETIMEDOUT && ret != -EINTR)
-            {
-              ninfo("net_timedwait errno: %d\n", ret);
-              DEBUGASSERT(false);
-            }
-        }
-      else
-        {
-          usrsockdev_semgive(&dev->req.sem);
-        }
-
-      /* Wake-up pending requests. */
-
-      if (dev->req.nbusy == 0)
-        {
-          break;
-        }
-
-      dev->req.iov = NULL;
-      nxsem_post(&dev->req.acksem);
+  while (!sq_empty(&dev->req.queue))
+    {
+      usrsockdev_complete_request(dev, (FAR struct usrsockdev_reqline_s *)
+                                  sq_peek(&dev->req.queue), -ESHUTDOWN);
     }
-  while (true);
 
   net_unlock();
 
-  /* Check if request line is active */
-
-  if (dev->req.iov != NULL)
-    {
-      dev->req.iov = NULL;
-    }
-
   usrsockdev_semgive(&dev->devsem);
 
   return ret;
@@ -1078,6 +1149,7 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_reqline_s *line;
   pollevent_t eventset;
   int ret = OK;
   int i;
@@ -1132,9 +1204,8 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       /* Notify the POLLIN event if pending request. */
 
-      if (dev->req.iov != NULL &&
-          !(iovec_get(NULL, 0, dev->req.iov,
-                      dev->req.iovcnt, dev->req.pos) < 0))
+      line = (FAR struct usrsockdev_reqline_s *)sq_peek(&dev->req.queue);
+      if (line != NULL && dev->req.pos < line->total)
         {
           eventset |= POLLIN;
         }
@@ -1182,6 +1253,8 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
 {
   FAR struct usrsockdev_s *dev = conn->dev;
   FAR struct usrsock_request_common_s *req_head = iov[0].iov_base;
+  struct usrsockdev_reqline_s line;
+  unsigned int i;
   int ret;
 
   if (!dev)
@@ -1209,45 +1282,47 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
   conn->resp.xid = req_head->xid;
   conn->resp.result = -EACCES;
 
-  ++dev->req.nbusy; /* net_lock held. */
+  /* Queue request for daemon to handle.  Requests from different sockets
+   * may be outstanding at the same time, the daemon reads them in order.
+   */
 
-  /* Set outstanding request for daemon to handle. */
+  line.iov = iov;
+  line.iovcnt = iovcnt;
+  line.total = 0;
+  line.xid = req_head->xid;
+  line.result = -ESHUTDOWN;
 
-  while ((ret = net_lockedwait(&dev->req.sem)) < 0)
+  for (i = 0; i < iovcnt; i++)
     {
-      DEBUGASSERT(ret == -EINTR || ret == -ECANCELED);
+      line.total += iov[i].iov_len;
     }
 
-  if (usrsockdev_is_opened(dev))
-    {
-      DEBUGASSERT(dev->req.iov == NULL);
-      dev->req.ack_xid = req_head->xid;
-      dev->req.iov = iov;
-      dev->req.pos = 0;
-      dev->req.iovcnt = iovcnt;
+  nxsem_init(&line.acksem, 0, 0);
+  nxsem_setprotocol(&line.acksem, SEM_PRIO_NONE);
+
+  sq_addlast(&line.node, &dev->req.queue); /* net_lock held. */
 
-      /* Notify daemon of new request. */
+  /* Notify daemon of new request. */
 
+  if (sq_peek(&dev->req.queue) == &line.node)
+    {
       usrsockdev_pollnotify(dev, POLLIN);
+    }
 
-      /* Wait ack for request. */
+  /* Wait ack for request (or delivery, with batching). */
 
-      while ((ret = net_lockedwait(&dev->req.acksem)) < 0)
-        {
-          DEBUGASSERT(ret == -EINTR || ret == -ECANCELED);
-        }
-    }
-  else
+  while ((ret = net_lockedwait(&line.acksem)) < 0)
     {
-      ninfo("usockid=%d; daemon abruptly closed /usr/usrsock.\n", conn->usockid);
-      ret = -ESHUTDOWN;
+      DEBUGASSERT(ret == -EINTR || ret == -ECANCELED);
     }
 
-  /* Free request line for next command. */
+  nxsem_destroy(&line.acksem);
 
-  usrsockdev_semgive(&dev->req.sem);
-
-  --dev->req.nbusy; /* net_lock held. */
+  ret = line.result;
+  if (ret < 0)
+    {
+      ninfo("usockid=%d; daemon abruptly closed /usr/usrsock.\n", conn->usockid);
+    }
 
   return ret;
 }
@@ -1265,11 +1340,9 @@ void usrsockdev_register(void)
   /* Initialize device private structure. */
 
   g_usrsockdev.ocount = 0;
-  g_usrsockdev.req.nbusy = 0;
+  g_usrsockdev.req.pos = 0;
+  sq_init(&g_usrsockdev.req.queue);
   nxsem_init(&g_usrsockdev.devsem, 0, 1);
-  nxsem_init(&g_usrsockdev.req.sem, 0, 1);
-  nxsem_init(&g_usrsockdev.req.acksem, 0, 0);
-  nxsem_setprotocol(&g_usrsockdev.req.acksem, SEM_PRIO_NONE);
 
   (void)register_driver("/dev/usrsock", &g_usrsockdevops, 0666, &g_usrsockdev);
 }
@@ -41,8 +41,13 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
 #include <debug.h>
 
+#ifdef CONFIG_NETDEV_TXIOB
+#  include <nuttx/mm/iob.h>
+#endif
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -82,42 +87,191 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
+  FAR const uint32_t *wptr;
+  uint32_t acc = 0;
+  uint32_t w;
+  bool odd;
+
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* The one's complement sum is independent of byte order (RFC 1071):  The
+   * data is summed as native 16-bit words loaded from aligned addresses
+   * and the result is converted to host order at the end.  If the data
+   * begins on an odd address, the first byte is summed alone and the bytes
+   * of the result are swapped to restore the pairing.
+   */
+
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc   = *data;
+#else
+      acc   = (uint32_t)*data << 8;
+#endif
+      data++;
+      len--;
+    }
+
+  /* Reach 32-bit alignment */
+
+  if (len >= 2 && ((uintptr_t)data & 2) != 0)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* Sum 32-bit words, four at a time.  Each word is added as two 16-bit
+   * halves so that the accumulator cannot overflow for any 16-bit length.
+   */
+
+  wptr = (FAR const uint32_t *)data;
+  while (len >= 16)
+    {
+      w    = wptr[0];
+      acc += (w & 0xffff) + (w >> 16);
+      w    = wptr[1];
+      acc += (w & 0xffff) + (w >> 16);
+      w    = wptr[2];
+      acc += (w & 0xffff) + (w >> 16);
+      w    = wptr[3];
+      acc += (w & 0xffff) + (w >> 16);
+      wptr += 4;
+      len  -= 16;
+    }
+
+  while (len >= 4)
+    {
+      w    = *wptr++;
+      acc += (w & 0xffff) + (w >> 16);
+      len -= 4;
+    }
+
+  data = (FAR const uint8_t *)wptr;
+  if (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* A trailing byte is the high order byte of a zero-padded word */
+
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint32_t)*data << 8;
+#else
+      acc += *data;
+#endif
+    }
+
+  /* Fold to 16 bits, undo the odd start and convert to host order */
+
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  if (odd)
+    {
+      acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+#ifndef CONFIG_ENDIAN_BIG
+  acc = ((acc & 0xff) << 8) | (acc >> 8);
+#endif
+
+  /* Add the partial sum carried over from a previous call */
+
+  acc += sum;
+  acc  = (acc & 0xffff) + (acc >> 16);
+
+  /* Return sum in host byte order. */
+
+  return (uint16_t)acc;
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
+/****************************************************************************
+ * Name: chksum_iob
+ *
+ * Description:
+ *   Like chksum(), but calculate the raw checksum over 'len' bytes of an
+ *   I/O buffer chain, beginning at 'offset'.  The data in each I/O buffer
+ *   may have an odd length:  The byte following an odd length fragment is
+ *   the low order byte of the 16-bit word begun by that fragment.
+ *
+ * Input Parameters:
+ *   sum    - Partial calculations carried over from a previous call to
+ *            chksum().  The data summed before must be of even length.
+ *   iob    - The I/O buffer chain holding the data
+ *   offset - Offset to the beginning of the data in the chain
+ *   len    - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_TXIOB) && !defined(CONFIG_NET_ARCH_CHKSUM)
+uint16_t chksum_iob(uint16_t sum, FAR const struct iob_s *iob,
+                    unsigned int offset, unsigned int len)
+{
+  FAR const uint8_t *data;
+  unsigned int ncopy;
+  bool odd = false;
   uint16_t t;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* Skip to the I/O buffer containing the first byte */
 
-  while (dataptr < last_byte)
+  while (iob != NULL && offset >= iob->io_len)
     {
-      /* At least two more bytes */
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
+  for (; iob != NULL && len > 0; iob = iob->io_flink, offset = 0)
+    {
+      data  = &iob->io_data[iob->io_offset + offset];
+      ncopy = iob->io_len - offset;
+      if (ncopy > len)
         {
-          sum++; /* carry */
+          ncopy = len;
         }
 
-      dataptr += 2;
-    }
+      if (ncopy == 0)
+        {
+          continue;
+        }
 
-  if (dataptr == last_byte)
-    {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
+      len -= ncopy;
+
+      if (odd)
         {
-          sum++; /* carry */
+          /* Complete the word begun by the previous I/O buffer */
+
+          t    = data[0];
+          sum += t;
+          if (sum < t)
+            {
+              sum++; /* carry */
+            }
+
+          data++;
+          ncopy--;
         }
-    }
 
-  /* Return sum in host byte order. */
+      sum = chksum(sum, data, ncopy);
+      odd = (ncopy & 1) != 0;
+    }
 
+  DEBUGASSERT(len == 0);
   return sum;
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* CONFIG_NETDEV_TXIOB && !CONFIG_NET_ARCH_CHKSUM */
 
 /****************************************************************************
  * Name: net_chksum
@@ -111,7 +111,23 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[IPv4_HDRLEN + NET_LL_HDRLEN(dev)], upperlen);
+#ifdef CONFIG_NETDEV_TXIOB
+  if (dev->d_iob != NULL)
+    {
+      /* The protocol header is in d_buf, the payload in the IOB chain */
+
+      DEBUGASSERT(upperlen >= dev->d_sndlen);
+      sum = chksum(sum, &dev->d_buf[IPv4_HDRLEN + NET_LL_HDRLEN(dev)],
+                   upperlen - dev->d_sndlen);
+      sum = chksum_iob(sum, dev->d_iob, dev->d_iobofs, dev->d_sndlen);
+    }
+  else
+#endif
+    {
+      sum = chksum(sum, &dev->d_buf[IPv4_HDRLEN + NET_LL_HDRLEN(dev)],
+                   upperlen);
+    }
+
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -177,7 +193,22 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+#ifdef CONFIG_NETDEV_TXIOB
+  if (dev->d_iob != NULL)
+    {
+      /* The protocol header is in d_buf, the payload in the IOB chain */
+
+      DEBUGASSERT(upperlen >= dev->d_sndlen);
+      sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen],
+                   upperlen - dev->d_sndlen);
+      sum = chksum_iob(sum, dev->d_iob, dev->d_iobofs, dev->d_sndlen);
+    }
+  else
+#endif
+    {
+      sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+    }
+
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
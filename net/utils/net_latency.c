@@ -0,0 +1,243 @@
+/****************************************************************************
+ * net/utils/net_latency.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netlatency.h>
+
+#ifdef CONFIG_NET_LATENCY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_LATENCY_NOTE_CATEGORY
+#  define CONFIG_NET_LATENCY_NOTE_CATEGORY 8
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+struct net_lathist_s g_netlatency[NET_LATENCY_NSTAGES];
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+static FAR const char *g_stage_names[NET_LATENCY_NSTAGES] =
+{
+  "driver", "ip", "tcp", "recv", "total"
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_latency_record
+ *
+ * Description:
+ *   Add an elapsed time, in net_latency_now() units, to the histogram of
+ *   'stage' and emit it as a note if tracing is enabled.
+ *
+ ****************************************************************************/
+
+static void net_latency_record(int stage, uint32_t elapsed)
+{
+  FAR struct net_lathist_s *hist = &g_netlatency[stage];
+  uint32_t usec;
+  int bucket;
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+  usec = (uint32_t)(((uint64_t)elapsed * USEC_PER_SEC) / up_perf_getfreq());
+#else
+  usec = elapsed * USEC_PER_TICK;
+#endif
+
+  /* Find the power-of-two bucket */
+
+  for (bucket = 0;
+       bucket < NET_LATENCY_NBUCKETS - 1 && (usec >> (bucket + 1)) != 0;
+       bucket++)
+    {
+    }
+
+  hist->lh_count++;
+  hist->lh_total += usec;
+  hist->lh_bucket[bucket]++;
+
+  if (usec > hist->lh_max)
+    {
+      hist->lh_max = usec;
+    }
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+  if (sched_note_enabled(CONFIG_NET_LATENCY_NOTE_CATEGORY))
+    {
+      sched_note_printf(CONFIG_NET_LATENCY_NOTE_CATEGORY,
+                        "net latency %s %u", g_stage_names[stage],
+                        (unsigned int)usec);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_latency_now
+ *
+ * Description:
+ *   Return the current time in the units used by the packet time stamps.
+ *
+ ****************************************************************************/
+
+uint32_t net_latency_now(void)
+{
+  uint32_t now;
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+  now = up_perf_gettime();
+#else
+  now = (uint32_t)clock_systimer();
+#endif
+
+  /* Zero means "no time stamp" */
+
+  return now != 0 ? now : 1;
+}
+
+/****************************************************************************
+ * Name: net_latency_input
+ *
+ * Description:
+ *   Start the trace of a packet received on 'dev'.
+ *
+ ****************************************************************************/
+
+void net_latency_input(FAR struct net_driver_s *dev)
+{
+  FAR struct net_latency_s *lat = &dev->d_latency;
+  uint32_t now = net_latency_now();
+
+  if (dev->d_rxstamp != 0)
+    {
+      lat->lt_start  = dev->d_rxstamp;
+      dev->d_rxstamp = 0;
+      net_latency_record(NET_LATENCY_DRIVER, now - lat->lt_start);
+    }
+  else
+    {
+      lat->lt_start  = now;
+    }
+
+  lat->lt_last = now;
+}
+
+/****************************************************************************
+ * Name: net_latency_stage
+ *
+ * Description:
+ *   Record the time since the last stage of the traced packet 'lat'.
+ *
+ ****************************************************************************/
+
+void net_latency_stage(FAR struct net_latency_s *lat, int stage)
+{
+  uint32_t now;
+
+  if (lat->lt_start != 0)
+    {
+      now = net_latency_now();
+      net_latency_record(stage, now - lat->lt_last);
+      lat->lt_last = now;
+    }
+}
+
+/****************************************************************************
+ * Name: net_latency_deliver
+ *
+ * Description:
+ *   Record the TCP stage and move the trace of the packet being processed
+ *   on 'dev' to 'dest'.
+ *
+ ****************************************************************************/
+
+void net_latency_deliver(FAR struct net_driver_s *dev,
+                         FAR struct net_latency_s *dest)
+{
+  net_latency_stage(&dev->d_latency, NET_LATENCY_TCP);
+
+  /* The trace now belongs to the delivered data.  Any further data from
+   * this packet is not traced.
+   */
+
+  *dest = dev->d_latency;
+  dev->d_latency.lt_start = 0;
+}
+
+/****************************************************************************
+ * Name: net_latency_done
+ *
+ * Description:
+ *   Record the final stage and the total latency and end the trace.
+ *
+ ****************************************************************************/
+
+void net_latency_done(FAR struct net_latency_s *lat)
+{
+  if (lat->lt_start != 0)
+    {
+      net_latency_stage(lat, NET_LATENCY_RECV);
+      net_latency_record(NET_LATENCY_TOTAL, lat->lt_last - lat->lt_start);
+      lat->lt_start = 0;
+    }
+}
+
+#endif /* CONFIG_NET_LATENCY */
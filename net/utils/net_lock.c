@@ -63,9 +63,12 @@
  * Private Data
  ****************************************************************************/
 
-static sem_t        g_netlock;
-static pid_t        g_holder  = NO_HOLDER;
-static unsigned int g_count   = 0;
+/* The global network lock */
+
+static struct net_rlock_s g_netlock =
+{
+  SEM_INITIALIZER(1), NO_HOLDER, 0
+};
 
 /****************************************************************************
  * Private Functions
@@ -80,7 +83,7 @@ static unsigned int g_count   = 0;
  *
  ****************************************************************************/
 
-static void _net_takesem(void)
+static void _net_takesem(FAR struct net_rlock_s *lock)
 {
   int ret;
 
@@ -88,7 +91,7 @@ static void _net_takesem(void)
     {
       /* Take the semaphore (perhaps waiting) */
 
-      ret = nxsem_wait(&g_netlock);
+      ret = nxsem_wait(&lock->rl_sem);
 
       /* The only case that an error should occur here is if the wait was
        * awakened by a signal.
@@ -113,24 +116,45 @@ static void _net_takesem(void)
 
 void net_lockinitialize(void)
 {
-  nxsem_init(&g_netlock, 0, 1);
+  net_rlock_init(&g_netlock);
 }
 
 /****************************************************************************
- * Name: net_lock
+ * Name: net_rlock_init
  *
  * Description:
- *   Take the network lock
+ *   Initialize a re-entrant network lock
  *
  * Input Parameters:
+ *   lock - The lock to initialize
+ *
+ * Returned Value:
  *   None
  *
+ ****************************************************************************/
+
+void net_rlock_init(FAR struct net_rlock_s *lock)
+{
+  nxsem_init(&lock->rl_sem, 0, 1);
+  lock->rl_holder = NO_HOLDER;
+  lock->rl_count  = 0;
+}
+
+/****************************************************************************
+ * Name: net_rlock_take
+ *
+ * Description:
+ *   Take a re-entrant network lock
+ *
+ * Input Parameters:
+ *   lock - The lock to take
+ *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-void net_lock(void)
+void net_rlock_take(FAR struct net_rlock_s *lock)
 {
 #ifdef CONFIG_SMP
   irqstate_t flags = enter_critical_section();
@@ -139,22 +163,22 @@ void net_lock(void)
 
   /* Does this thread already hold the semaphore? */
 
-  if (g_holder == me)
+  if (lock->rl_holder == me)
     {
       /* Yes.. just increment the reference count */
 
-      g_count++;
+      lock->rl_count++;
     }
   else
     {
       /* No.. take the semaphore (perhaps waiting) */
 
-      _net_takesem();
+      _net_takesem(lock);
 
       /* Now this thread holds the semaphore */
 
-      g_holder = me;
-      g_count  = 1;
+      lock->rl_holder = me;
+      lock->rl_count  = 1;
     }
 
 #ifdef CONFIG_SMP
@@ -163,41 +187,41 @@ void net_lock(void)
 }
 
 /****************************************************************************
- * Name: net_unlock
+ * Name: net_rlock_give
  *
  * Description:
- *   Release the network lock.
+ *   Release a re-entrant network lock.
  *
  * Input Parameters:
- *   None
+ *   lock - The lock to release
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-void net_unlock(void)
+void net_rlock_give(FAR struct net_rlock_s *lock)
 {
 #ifdef CONFIG_SMP
   irqstate_t flags = enter_critical_section();
 #endif
-  DEBUGASSERT(g_holder == getpid() && g_count > 0);
+  DEBUGASSERT(lock->rl_holder == getpid() && lock->rl_count > 0);
 
   /* If the count would go to zero, then release the semaphore */
 
-  if (g_count == 1)
+  if (lock->rl_count == 1)
     {
       /* We no longer hold the semaphore */
 
-      g_holder = NO_HOLDER;
-      g_count  = 0;
-      nxsem_post(&g_netlock);
+      lock->rl_holder = NO_HOLDER;
+      lock->rl_count  = 0;
+      nxsem_post(&lock->rl_sem);
     }
   else
     {
       /* We still hold the semaphore. Just decrement the count */
 
-      g_count--;
+      lock->rl_count--;
     }
 
 #ifdef CONFIG_SMP
@@ -205,6 +229,44 @@ void net_unlock(void)
 #endif
 }
 
+/****************************************************************************
+ * Name: net_lock
+ *
+ * Description:
+ *   Take the network lock
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_lock(void)
+{
+  net_rlock_take(&g_netlock);
+}
+
+/****************************************************************************
+ * Name: net_unlock
+ *
+ * Description:
+ *   Release the network lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_unlock(void)
+{
+  net_rlock_give(&g_netlock);
+}
+
 /****************************************************************************
  * Name: net_breaklock
  *
@@ -223,18 +285,18 @@ int net_breaklock(FAR unsigned int *count)
   DEBUGASSERT(count != NULL);
 
   flags = enter_critical_section(); /* No interrupts */
-  if (g_holder == me)
+  if (g_netlock.rl_holder == me)
     {
       /* Return the lock setting */
 
-      *count   = g_count;
+      *count   = g_netlock.rl_count;
 
       /* Release the network lock  */
 
-      g_holder = NO_HOLDER;
-      g_count  = 0;
+      g_netlock.rl_holder = NO_HOLDER;
+      g_netlock.rl_count  = 0;
 
-      (void)nxsem_post(&g_netlock);
+      (void)nxsem_post(&g_netlock.rl_sem);
       ret      = OK;
     }
 
@@ -254,13 +316,13 @@ void net_restorelock(unsigned int count)
 {
   pid_t me = getpid();
 
-  DEBUGASSERT(g_holder != me);
+  DEBUGASSERT(g_netlock.rl_holder != me);
 
   /* Recover the network lock at the proper count */
 
-  _net_takesem();
-  g_holder = me;
-  g_count  = count;
+  _net_takesem(&g_netlock);
+  g_netlock.rl_holder = me;
+  g_netlock.rl_count  = count;
 }
 
 /****************************************************************************
@@ -367,6 +429,7 @@ int net_lockedwait(sem_t *sem)
  *
  * Input Parameters:
  *   throttled - An indication of the IOB allocation is "throttled"
+ *   user      - The consumer that the IOB is charged to
  *
  * Returned Value:
  *   A pointer to the newly allocated IOB is returned on success.  NULL is
@@ -375,11 +438,11 @@ int net_lockedwait(sem_t *sem)
  ****************************************************************************/
 
 #ifdef CONFIG_MM_IOB
-FAR struct iob_s *net_ioballoc(bool throttled)
+FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e user)
 {
   FAR struct iob_s *iob;
 
-  iob = iob_tryalloc(throttled);
+  iob = iob_tryalloc_user(throttled, user);
   if (iob == NULL)
     {
       irqstate_t flags;
@@ -392,7 +455,7 @@ FAR struct iob_s *net_ioballoc(bool throttled)
 
       flags    = enter_critical_section();
       blresult = net_breaklock(&count);
-      iob      = iob_alloc(throttled);
+      iob      = iob_alloc_user(throttled, user);
       if (blresult >= 0)
         {
           net_restorelock(count);
@@ -234,6 +234,21 @@ void net_ipv6_pref2mask(uint8_t preflen, net_ipv6addr_t mask);
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 #endif
 
+/****************************************************************************
+ * Name: chksum_iob
+ *
+ * Description:
+ *   Like chksum(), but calculate the raw checksum over 'len' bytes of an
+ *   I/O buffer chain, beginning at 'offset'.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_TXIOB) && !defined(CONFIG_NET_ARCH_CHKSUM)
+struct iob_s; /* Forward reference */
+uint16_t chksum_iob(uint16_t sum, FAR const struct iob_s *iob,
+                    unsigned int offset, unsigned int len);
+#endif
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -49,6 +49,9 @@
 #include <nuttx/arch.h>
 
 #include "clock/clock.h"
+#ifdef CONFIG_SCHED_CPUTIME
+#  include "sched/sched.h"
+#endif
 #ifdef CONFIG_CLOCK_TIMEKEEPING
 #  include "clock/clock_timekeeping.h"
 #endif
@@ -98,6 +101,23 @@ int clock_gettime(clockid_t clock_id, struct timespec *tp)
   else
 #endif
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* CLOCK_THREAD_CPUTIME_ID is the CPU time consumed by the calling thread
+   * as measured by the architecture's cycle counter.
+   */
+
+  if (clock_id == CLOCK_THREAD_CPUTIME_ID)
+    {
+      uint64_t cputime = sched_cputime(this_task());
+      uint32_t freq    = up_perf_getfreq();
+
+      tp->tv_sec  = (time_t)(cputime / freq);
+      tp->tv_nsec = (long)(((cputime % freq) * NSEC_PER_SEC) / freq);
+      ret         = OK;
+    }
+  else
+#endif
+
   /* CLOCK_REALTIME - POSIX demands this to be present.  CLOCK_REALTIME
    * represents the machine's best-guess as to the current wall-clock,
    * time-of-day time. This means that CLOCK_REALTIME can jump forward and
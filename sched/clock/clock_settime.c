@@ -113,6 +113,7 @@ int clock_settime(clockid_t clock_id, FAR const struct timespec *tp)
 
       g_basetime.tv_nsec -= bias.tv_nsec;
       g_basetime.tv_sec  -= bias.tv_sec;
+      clock_vdso_update();
 
       /* Setup the RTC (lo- or high-res) */
 
@@ -0,0 +1,99 @@
+/****************************************************************************
+ * sched/clock/clock_vdso.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <time.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/userspace.h>
+
+#include "clock/clock.h"
+
+#ifdef CONFIG_CLOCK_VDSO
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_vdso_update
+ *
+ * Description:
+ *   Copy the system timer and the time-of-day base time into the user-space
+ *   clock page, if the user-space blob provided one.  This must be called
+ *   whenever g_system_timer or g_basetime change.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from the timer interrupt handler.
+ *
+ ****************************************************************************/
+
+void clock_vdso_update(void)
+{
+  FAR struct clock_vdso_s *vdso = USERSPACE->us_vdso;
+  irqstate_t flags;
+
+  if (vdso != NULL)
+    {
+      flags = spin_lock_irqsave();
+
+      /* An odd sequence count tells readers that an update is in progress.
+       * All fields are volatile so the compiler will not reorder these
+       * stores.
+       */
+
+      vdso->seq++;
+      vdso->ticks     = g_system_timer;
+      vdso->base_sec  = g_basetime.tv_sec;
+      vdso->base_nsec = g_basetime.tv_nsec;
+      vdso->seq++;
+
+      spin_unlock_irqrestore(flags);
+    }
+}
+
+#endif /* CONFIG_CLOCK_VDSO */
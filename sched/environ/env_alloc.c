@@ -0,0 +1,208 @@
+/****************************************************************************
+ * sched/environ/env_alloc.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#ifndef CONFIG_DISABLE_ENVIRON
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "environ/environ.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_ENV_SHARED
+/* Shared environment strings are preceded by a reference count */
+
+struct env_hdr_s
+{
+  uint16_t eh_refs;                 /* Number of task groups using the strings */
+};
+
+#define ENV_HDR(envp) \
+  ((FAR struct env_hdr_s *)((FAR char *)(envp) - sizeof(struct env_hdr_s)))
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: env_realloc
+ *
+ * Description:
+ *   Allocate or resize the environment strings of a task group.  The
+ *   environment must not be shared (see env_unshare()).
+ *
+ * Input Parameters:
+ *   group   - The task group owning the environment
+ *   newsize - The new size of the name=value strings
+ *
+ * Returned Value:
+ *   The new environment strings or NULL if the allocation failed (the old
+ *   allocation is then unchanged).  The caller must update tg_envp.
+ *
+ ****************************************************************************/
+
+FAR char *env_realloc(FAR struct task_group_s *group, size_t newsize)
+{
+#ifdef CONFIG_ENV_SHARED
+  FAR struct env_hdr_s *hdr = NULL;
+
+  if (group->tg_envp != NULL)
+    {
+      hdr = ENV_HDR(group->tg_envp);
+      DEBUGASSERT(hdr->eh_refs == 1);
+    }
+
+  hdr = (FAR struct env_hdr_s *)
+    kumm_realloc(hdr, sizeof(struct env_hdr_s) + newsize);
+  if (hdr == NULL)
+    {
+      return NULL;
+    }
+
+  hdr->eh_refs = 1;
+  return (FAR char *)(hdr + 1);
+#else
+  return (FAR char *)kumm_realloc(group->tg_envp, newsize);
+#endif
+}
+
+/****************************************************************************
+ * Name: env_free
+ *
+ * Description:
+ *   Release one reference to environment strings, freeing them if no task
+ *   group still uses them.
+ *
+ ****************************************************************************/
+
+void env_free(FAR char *envp)
+{
+#ifdef CONFIG_ENV_SHARED
+  FAR struct env_hdr_s *hdr = ENV_HDR(envp);
+
+  DEBUGASSERT(hdr->eh_refs > 0);
+  if (--hdr->eh_refs == 0)
+    {
+      sched_ufree(hdr);
+    }
+#else
+  sched_ufree(envp);
+#endif
+}
+
+/****************************************************************************
+ * Name: env_share
+ *
+ * Description:
+ *   Add a reference to the environment strings of 'parent' and use them as
+ *   the environment of 'group'.
+ *
+ * Assumptions:
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENV_SHARED
+void env_share(FAR struct task_group_s *group,
+               FAR struct task_group_s *parent)
+{
+  FAR struct env_hdr_s *hdr = ENV_HDR(parent->tg_envp);
+
+  DEBUGASSERT(hdr->eh_refs < UINT16_MAX);
+  hdr->eh_refs++;
+
+  group->tg_envsize = parent->tg_envsize;
+  group->tg_envp    = parent->tg_envp;
+}
+
+/****************************************************************************
+ * Name: env_unshare
+ *
+ * Description:
+ *   Give the task group a private copy of its environment if it is shared
+ *   with other task groups.  This must be done before the environment
+ *   strings are modified.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the copy could not be allocated.
+ *
+ * Assumptions:
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+int env_unshare(FAR struct task_group_s *group)
+{
+  FAR struct env_hdr_s *hdr;
+
+  if (group->tg_envp == NULL || ENV_HDR(group->tg_envp)->eh_refs == 1)
+    {
+      return OK;
+    }
+
+  hdr = (FAR struct env_hdr_s *)
+    kumm_malloc(sizeof(struct env_hdr_s) + group->tg_envsize);
+  if (hdr == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The offsets of the strings do not change, so the index (if any) is
+   * still valid.
+   */
+
+  hdr->eh_refs = 1;
+  memcpy(hdr + 1, group->tg_envp, group->tg_envsize);
+
+  ENV_HDR(group->tg_envp)->eh_refs--;
+  group->tg_envp = (FAR char *)(hdr + 1);
+  return OK;
+}
+#endif
+
+#endif /* CONFIG_DISABLE_ENVIRON */
@@ -78,8 +78,10 @@
 int env_dup(FAR struct task_group_s *group)
 {
   FAR struct tcb_s *ptcb = this_task();
+#ifndef CONFIG_ENV_SHARED
   FAR char *envp = NULL;
   size_t envlen;
+#endif
   int ret = OK;
 
   DEBUGASSERT(group != NULL && ptcb != NULL && ptcb->group != NULL);
@@ -94,6 +96,13 @@ int env_dup(FAR struct task_group_s *group)
 
   if (ptcb->group != NULL && ptcb->group->tg_envp != NULL)
     {
+#ifdef CONFIG_ENV_SHARED
+      /* Yes.. Share it.  A private copy is made by the first task group
+       * that modifies it.
+       */
+
+      env_share(group, ptcb->group);
+#else
       /* Yes.. The parent task has an environment allocation. */
 
       envlen = ptcb->group->tg_envsize;
@@ -130,6 +139,7 @@ int env_dup(FAR struct task_group_s *group)
 
       group->tg_envsize = envlen;
       group->tg_envp    = envp;
+#endif
     }
 
   sched_unlock();
@@ -42,11 +42,22 @@
 #ifndef CONFIG_DISABLE_ENVIRON
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <sched.h>
 
+#include <nuttx/kmalloc.h>
+
 #include "environ/environ.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Minimum number of hash index slots */
+
+#define ENV_NDX_MINSLOTS 8
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -73,6 +84,97 @@ static bool env_cmpname(const char *pszname, const char *peqname)
   return false;
 }
 
+/****************************************************************************
+ * Name: env_hash
+ *
+ * Description:
+ *   Hash a variable name terminated by either '\0' or '='.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENV_INDEX
+static uint16_t env_hash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  for (; *name != '\0' && *name != '='; name++)
+    {
+      hash = (hash ^ (uint8_t)*name) * 16777619u;
+    }
+
+  return (uint16_t)(hash ^ (hash >> 16));
+}
+
+/****************************************************************************
+ * Name: env_ndxinsert
+ *
+ * Description:
+ *   Insert one name=value string into the index (linear probing).
+ *
+ ****************************************************************************/
+
+static void env_ndxinsert(FAR struct task_group_s *group, size_t offset)
+{
+  uint16_t slot = env_hash(&group->tg_envp[offset]) & group->tg_envndxmask;
+
+  while (group->tg_envndx[slot] != 0)
+    {
+      slot = (slot + 1) & group->tg_envndxmask;
+    }
+
+  group->tg_envndx[slot] = (uint16_t)(offset + 1);
+  group->tg_envndxused++;
+}
+
+/****************************************************************************
+ * Name: env_ndxbuild
+ *
+ * Description:
+ *   Build the hash index of the environment.  No index is built if the
+ *   environment is too large for 16-bit offsets or if memory is not
+ *   available; lookups then fall back to a linear search.
+ *
+ ****************************************************************************/
+
+static void env_ndxbuild(FAR struct task_group_s *group)
+{
+  FAR char *ptr;
+  FAR char *end;
+  unsigned int nvars = 0;
+  unsigned int nslots;
+
+  if (group->tg_envp == NULL || group->tg_envsize == 0 ||
+      group->tg_envsize >= UINT16_MAX)
+    {
+      return;
+    }
+
+  end = &group->tg_envp[group->tg_envsize];
+  for (ptr = group->tg_envp; ptr < end; ptr += (strlen(ptr) + 1))
+    {
+      nvars++;
+    }
+
+  /* Keep the index at most half full */
+
+  for (nslots = ENV_NDX_MINSLOTS; nslots < 2 * nvars; nslots <<= 1);
+
+  group->tg_envndx = (FAR uint16_t *)kmm_zalloc(nslots * sizeof(uint16_t));
+  if (group->tg_envndx == NULL)
+    {
+      return;
+    }
+
+  group->tg_envndxmask = nslots - 1;
+  group->tg_envndxused = 0;
+
+  for (ptr = group->tg_envp; ptr < end; ptr += (strlen(ptr) + 1))
+    {
+      env_ndxinsert(group, ptr - group->tg_envp);
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -106,6 +208,33 @@ FAR char *env_findvar(FAR struct task_group_s *group, FAR const char *pname)
 
   DEBUGASSERT(group != NULL && pname != NULL);
 
+#ifdef CONFIG_ENV_INDEX
+  /* Use the hash index, building it if necessary */
+
+  if (group->tg_envndx == NULL)
+    {
+      env_ndxbuild(group);
+    }
+
+  if (group->tg_envndx != NULL)
+    {
+      uint16_t slot = env_hash(pname) & group->tg_envndxmask;
+
+      while (group->tg_envndx[slot] != 0)
+        {
+          ptr = &group->tg_envp[group->tg_envndx[slot] - 1];
+          if (env_cmpname(pname, ptr))
+            {
+              return ptr;
+            }
+
+          slot = (slot + 1) & group->tg_envndxmask;
+        }
+
+      return NULL;
+    }
+#endif
+
   /* Search for a name=value string with matching name */
 
   end = &group->tg_envp[group->tg_envsize];
@@ -118,4 +247,56 @@ FAR char *env_findvar(FAR struct task_group_s *group, FAR const char *pname)
   return (ptr < end) ? ptr : NULL;
 }
 
+/****************************************************************************
+ * Name: env_ndxadd
+ *
+ * Description:
+ *   Add the name=value string at 'offset' to the hash index, if the index
+ *   exists.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENV_INDEX
+void env_ndxadd(FAR struct task_group_s *group, size_t offset)
+{
+  if (group->tg_envndx == NULL)
+    {
+      return;
+    }
+
+  /* Rebuild (larger) on the next lookup if the index would become more
+   * than half full or the offset does not fit.
+   */
+
+  if (2 * (group->tg_envndxused + 1) >
+      (unsigned int)group->tg_envndxmask + 1 ||
+      group->tg_envsize >= UINT16_MAX)
+    {
+      env_ndxinvalidate(group);
+      return;
+    }
+
+  env_ndxinsert(group, offset);
+}
+
+/****************************************************************************
+ * Name: env_ndxinvalidate
+ *
+ * Description:
+ *   Discard the hash index.  It is rebuilt on the next lookup.
+ *
+ ****************************************************************************/
+
+void env_ndxinvalidate(FAR struct task_group_s *group)
+{
+  if (group->tg_envndx != NULL)
+    {
+      sched_kfree(group->tg_envndx);
+      group->tg_envndx     = NULL;
+      group->tg_envndxmask = 0;
+      group->tg_envndxused = 0;
+    }
+}
+#endif
+
 #endif /* CONFIG_DISABLE_ENVIRON */
@@ -81,11 +81,13 @@ void env_release(FAR struct task_group_s *group)
 
   if (group->tg_envp)
     {
-      /* Free the environment */
+      /* Free the environment (or drop our reference to a shared one) */
 
-      sched_ufree(group->tg_envp);
+      env_free(group->tg_envp);
     }
 
+  env_ndxinvalidate(group);
+
   /* In any event, make sure that all environment-related varialbles in the
    * task group structure are reset to initial values.
    */
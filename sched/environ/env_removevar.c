@@ -68,6 +68,7 @@
  *   - Not called from an interrupt handler
  *   - Caller has pre-emption disabled
  *   - Caller will reallocate the environment structure to the correct size
+ *   - The environment is not shared (see env_unshare())
  *
  ****************************************************************************/
 
@@ -109,6 +110,10 @@ int env_removevar(FAR struct task_group_s *group, FAR char *pvar)
 
       group->tg_envsize -= len;
       ret = OK;
+
+      /* The offsets of the following strings have changed */
+
+      env_ndxinvalidate(group);
     }
 
   return ret;
@@ -85,6 +85,7 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
   FAR struct task_group_s *group;
   FAR char *pvar;
   FAR char *newenvp;
+  size_t offset;
   int newsize;
   int varlen;
   int ret = OK;
@@ -126,6 +127,7 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
 
   /* Check if the variable already exists */
 
+  pvar = NULL;
   if (group->tg_envp && (pvar = env_findvar(group, name)) != NULL)
     {
       /* It does! Do we have permission to overwrite the existing value? */
@@ -137,10 +139,39 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
           sched_unlock();
           return OK;
         }
+    }
+
+  /* The environment is about to be modified.  Make sure that it is not
+   * shared with other task groups.
+   */
+
+  offset = (pvar != NULL) ? pvar - group->tg_envp : 0;
+  if (env_unshare(group) < 0)
+    {
+      ret = ENOMEM;
+      goto errout_with_lock;
+    }
 
-      /* Yes.. just remove the name=value pair from the environment.  It will
-       * be added again below.  Note that we are responsible for reallocating
-       * the environment buffer; this will happen below.
+  if (pvar != NULL)
+    {
+      FAR char *pvalue;
+
+      /* If the new value has the same length as the old one, then just
+       * overwrite it in place.
+       */
+
+      pvar   = &group->tg_envp[offset];
+      pvalue = strchr(pvar, '=') + 1;
+      if (strlen(pvalue) == strlen(value))
+        {
+          strcpy(pvalue, value);
+          sched_unlock();
+          return OK;
+        }
+
+      /* Otherwise, just remove the name=value pair from the environment.
+       * It will be added again below.  Note that we are responsible for
+       * reallocating the environment buffer; this will happen below.
        */
 
       (void)env_removevar(group, pvar);
@@ -154,39 +185,28 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
 
   /* Then allocate or reallocate the environment buffer */
 
-  if (group->tg_envp)
+  offset  = group->tg_envp ? group->tg_envsize : 0;
+  newsize = offset + varlen;
+  newenvp = env_realloc(group, newsize);
+  if (!newenvp)
     {
-      newsize = group->tg_envsize + varlen;
-      newenvp = (FAR char *)kumm_realloc(group->tg_envp, newsize);
-      if (!newenvp)
-        {
-          ret = ENOMEM;
-          goto errout_with_lock;
-        }
-
-      pvar = &newenvp[group->tg_envsize];
+      ret = ENOMEM;
+      goto errout_with_lock;
     }
-  else
-    {
-      newsize = varlen;
-      newenvp = (FAR char *)kumm_malloc(varlen);
-      if (!newenvp)
-        {
-          ret = ENOMEM;
-          goto errout_with_lock;
-        }
 
-      pvar = newenvp;
-    }
+  pvar = &newenvp[offset];
 
   /* Save the new buffer and size */
 
   group->tg_envp    = newenvp;
   group->tg_envsize = newsize;
 
-  /* Now, put the new name=value string into the environment buffer */
+  /* Now, put the new name=value string into the environment buffer and
+   * add it to the index.
+   */
 
   sprintf(pvar, "%s=%s", name, value);
+  env_ndxadd(group, offset);
   sched_unlock();
   return OK;
 
@@ -88,9 +88,22 @@ int unsetenv(FAR const char *name)
   sched_lock();
   if (group && (pvar = env_findvar(group, name)) != NULL)
     {
-      /* It does!  Remove the name=value pair from the environment. */
+      /* It does!  Make sure that the environment is not shared with other
+       * task groups before modifying it.
+       */
 
-      (void)env_removevar(group, pvar);
+      size_t offset = pvar - group->tg_envp;
+
+      if (env_unshare(group) < 0)
+        {
+          set_errno(ENOMEM);
+          sched_unlock();
+          return ERROR;
+        }
+
+      /* Remove the name=value pair from the environment. */
+
+      (void)env_removevar(group, &group->tg_envp[offset]);
 
       /* Reallocate the new environment buffer */
 
@@ -101,7 +114,7 @@ int unsetenv(FAR const char *name)
 
           if (group->tg_envp != NULL)
             {
-              kumm_free(group->tg_envp);
+              env_free(group->tg_envp);
               group->tg_envp = NULL;
             }
 
@@ -111,7 +124,7 @@ int unsetenv(FAR const char *name)
         {
           /* Reallocate the environment to reclaim a little memory */
 
-          newenvp = (FAR char *)kumm_realloc(group->tg_envp, newsize);
+          newenvp = env_realloc(group, newsize);
           if (newenvp == NULL)
             {
               set_errno(ENOMEM);
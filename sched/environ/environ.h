@@ -53,6 +53,15 @@
 #  define env_release(group) (0)
 #else
 
+#ifndef CONFIG_ENV_INDEX
+#  define env_ndxadd(group,offset)
+#  define env_ndxinvalidate(group)
+#endif
+
+#ifndef CONFIG_ENV_SHARED
+#  define env_unshare(group) (OK)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -154,11 +163,97 @@ FAR char *env_findvar(FAR struct task_group_s *group, FAR const char *pname);
  *   - Not called from an interrupt handler
  *   - Caller has pre-emption disabled
  *   - Caller will reallocate the environment structure to the correct size
+ *   - The environment is not shared (see env_unshare())
  *
  ****************************************************************************/
 
 int env_removevar(FAR struct task_group_s *group, FAR char *pvar);
 
+/****************************************************************************
+ * Name: env_realloc
+ *
+ * Description:
+ *   Allocate or resize the environment strings of a task group.  The
+ *   environment must not be shared (see env_unshare()).
+ *
+ * Input Parameters:
+ *   group   - The task group owning the environment
+ *   newsize - The new size of the name=value strings
+ *
+ * Returned Value:
+ *   The new environment strings or NULL if the allocation failed (the old
+ *   allocation is then unchanged).  The caller must update tg_envp.
+ *
+ ****************************************************************************/
+
+FAR char *env_realloc(FAR struct task_group_s *group, size_t newsize);
+
+/****************************************************************************
+ * Name: env_free
+ *
+ * Description:
+ *   Release one reference to environment strings, freeing them if no task
+ *   group still uses them.
+ *
+ ****************************************************************************/
+
+void env_free(FAR char *envp);
+
+/****************************************************************************
+ * Name: env_unshare
+ *
+ * Description:
+ *   Give the task group a private copy of its environment if it is shared
+ *   with other task groups.  This must be done before the environment
+ *   strings are modified.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the copy could not be allocated.
+ *
+ * Assumptions:
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENV_SHARED
+int env_unshare(FAR struct task_group_s *group);
+
+/****************************************************************************
+ * Name: env_share
+ *
+ * Description:
+ *   Add a reference to the environment strings of 'parent' and use them as
+ *   the environment of 'group'.
+ *
+ ****************************************************************************/
+
+void env_share(FAR struct task_group_s *group,
+               FAR struct task_group_s *parent);
+#endif
+
+/****************************************************************************
+ * Name: env_ndxadd
+ *
+ * Description:
+ *   Add the name=value string at 'offset' to the hash index, if the index
+ *   exists.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENV_INDEX
+void env_ndxadd(FAR struct task_group_s *group, size_t offset);
+
+/****************************************************************************
+ * Name: env_ndxinvalidate
+ *
+ * Description:
+ *   Discard the hash index.  It is rebuilt on the next lookup.
+ *
+ ****************************************************************************/
+
+void env_ndxinvalidate(FAR struct task_group_s *group);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
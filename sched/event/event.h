@@ -0,0 +1,82 @@
+/****************************************************************************
+ * sched/event/event.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __SCHED_EVENT_EVENT_H
+#define __SCHED_EVENT_EVENT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+#include <queue.h>
+
+#include <nuttx/event.h>
+
+#ifdef CONFIG_SCHED_EVENTS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* True if the set of events 'e' satisfies the waiter 'w' */
+
+#define nxevent_satisfied(e,w,f) \
+  (((f) & NXEVENT_WAIT_ALL) != 0 ? ((e) & (w)) == (w) : ((e) & (w)) != 0)
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* One of these is allocated on the stack of each waiting task and is
+ * retained in the event group's waitlist while the task is waiting.
+ */
+
+struct nxevent_wait_s
+{
+  dq_entry_t node;                 /* Supports a doubly linked list */
+  sem_t sem;                       /* Waiter blocks on this semaphore */
+  nxevent_mask_t expect;           /* Events being waited for */
+  nxevent_mask_t result;           /* Events that satisfied the wait */
+  uint8_t eflags;                  /* NXEVENT_WAIT_* flags */
+  int16_t status;                  /* -EBUSY while waiting, then result */
+};
+
+#endif /* CONFIG_SCHED_EVENTS */
+#endif /* __SCHED_EVENT_EVENT_H */
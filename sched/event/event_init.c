@@ -0,0 +1,113 @@
+/****************************************************************************
+ * sched/event/event_init.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/semaphore.h>
+
+#include "event/event.h"
+
+#ifdef CONFIG_SCHED_EVENTS
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_init
+ *
+ * Description:
+ *   Initialize an event group.
+ *
+ * Input Parameters:
+ *   event  - The event group to be initialized
+ *   events - The initial set of events
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxevent_init(FAR struct nxevent_s *event, nxevent_mask_t events)
+{
+  DEBUGASSERT(event != NULL);
+
+  event->events = events;
+  dq_init(&event->waitlist);
+}
+
+/****************************************************************************
+ * Name: nxevent_destroy
+ *
+ * Description:
+ *   Destroy an event group.  Any tasks still waiting on the event group are
+ *   awakened with -ECANCELED.
+ *
+ * Input Parameters:
+ *   event - The event group to be destroyed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxevent_destroy(FAR struct nxevent_s *event)
+{
+  FAR struct nxevent_wait_s *wait;
+  irqstate_t flags;
+
+  DEBUGASSERT(event != NULL);
+
+  flags = enter_critical_section();
+  while ((wait = (FAR struct nxevent_wait_s *)
+                 dq_remfirst(&event->waitlist)) != NULL)
+    {
+      wait->status = -ECANCELED;
+      (void)nxsem_post(&wait->sem);
+    }
+
+  event->events = 0;
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SCHED_EVENTS */
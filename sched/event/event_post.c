@@ -0,0 +1,152 @@
+/****************************************************************************
+ * sched/event/event_post.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/semaphore.h>
+
+#include "event/event.h"
+
+#ifdef CONFIG_SCHED_EVENTS
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_post
+ *
+ * Description:
+ *   Set events in an event group and wake up every waiter whose condition
+ *   is now satisfied.  Unless a waiter specified NXEVENT_WAIT_NOCLEAR, the
+ *   events that satisfied it are cleared after all waiters are examined.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to be set
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void nxevent_post(FAR struct nxevent_s *event, nxevent_mask_t events)
+{
+  FAR struct nxevent_wait_s *wait;
+  FAR struct nxevent_wait_s *next;
+  nxevent_mask_t clear = 0;
+  irqstate_t flags;
+
+  DEBUGASSERT(event != NULL);
+
+  flags = enter_critical_section();
+  event->events |= events;
+
+  /* Wake only the waiters that are satisfied by the new set of events.
+   * The events consumed by the waiters are not cleared until all waiters
+   * have been examined so that a single post can release every task that
+   * is waiting for the same event.
+   */
+
+  for (wait = (FAR struct nxevent_wait_s *)dq_peek(&event->waitlist);
+       wait != NULL;
+       wait = next)
+    {
+      next = (FAR struct nxevent_wait_s *)dq_next(&wait->node);
+
+      if (nxevent_satisfied(event->events, wait->expect, wait->eflags))
+        {
+          wait->result = event->events & wait->expect;
+          wait->status = OK;
+
+          if ((wait->eflags & NXEVENT_WAIT_NOCLEAR) == 0)
+            {
+              clear |= wait->result;
+            }
+
+          dq_rem(&wait->node, &event->waitlist);
+          (void)nxsem_post(&wait->sem);
+        }
+    }
+
+  event->events &= ~clear;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxevent_clear
+ *
+ * Description:
+ *   Clear events in an event group.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to be cleared
+ *
+ * Returned Value:
+ *   The set of events before they were cleared.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+nxevent_mask_t nxevent_clear(FAR struct nxevent_s *event,
+                             nxevent_mask_t events)
+{
+  nxevent_mask_t prev;
+  irqstate_t flags;
+
+  DEBUGASSERT(event != NULL);
+
+  flags = enter_critical_section();
+  prev = event->events;
+  event->events = prev & ~events;
+  leave_critical_section(flags);
+
+  return prev;
+}
+
+#endif /* CONFIG_SCHED_EVENTS */
@@ -0,0 +1,207 @@
+/****************************************************************************
+ * sched/event/event_wait.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
+
+#include "event/event.h"
+
+#ifdef CONFIG_SCHED_EVENTS
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_waitcommon
+ *
+ * Description:
+ *   Common logic for nxevent_wait() and nxevent_tickwait().
+ *
+ ****************************************************************************/
+
+static int nxevent_waitcommon(FAR struct nxevent_s *event,
+                              nxevent_mask_t events, uint8_t eflags,
+                              bool forever, uint32_t delay,
+                              FAR nxevent_mask_t *result)
+{
+  struct nxevent_wait_s wait;
+  nxevent_mask_t set = 0;
+  irqstate_t flags;
+  int ret;
+
+  DEBUGASSERT(event != NULL && events != 0);
+  DEBUGASSERT((!forever && delay == 0) || !up_interrupt_context());
+
+  flags = enter_critical_section();
+
+  /* Are the events already set? */
+
+  if (nxevent_satisfied(event->events, events, eflags))
+    {
+      set = event->events & events;
+      if ((eflags & NXEVENT_WAIT_NOCLEAR) == 0)
+        {
+          event->events &= ~set;
+        }
+
+      ret = OK;
+      goto out;
+    }
+
+  if (!forever && delay == 0)
+    {
+      ret = -EAGAIN;
+      goto out;
+    }
+
+  /* No.. we will have to wait.  The wait structure lives on this stack and
+   * is only linked into the waitlist while we are blocked.  Interrupts
+   * remain disabled until we block so that no post can be missed.
+   */
+
+  (void)nxsem_init(&wait.sem, 0, 0);
+  (void)nxsem_setprotocol(&wait.sem, SEM_PRIO_NONE);
+
+  wait.expect = events;
+  wait.result = 0;
+  wait.eflags = eflags;
+  wait.status = -EBUSY;
+  dq_addlast(&wait.node, &event->waitlist);
+
+  if (forever)
+    {
+      ret = nxsem_wait(&wait.sem);
+    }
+  else
+    {
+      ret = nxsem_tickwait(&wait.sem, clock_systimer(), delay);
+    }
+
+  /* A post may have satisfied the wait after a timeout or signal woke us
+   * but before we could run.  Honor that post rather than losing the
+   * events that it consumed for us.
+   */
+
+  if (wait.status != -EBUSY)
+    {
+      ret = wait.status;
+      set = wait.result;
+    }
+  else
+    {
+      dq_rem(&wait.node, &event->waitlist);
+    }
+
+  (void)nxsem_destroy(&wait.sem);
+
+out:
+  leave_critical_section(flags);
+
+  if (ret == OK && result != NULL)
+    {
+      *result = set;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_wait
+ *
+ * Description:
+ *   Wait until any (or, with NXEVENT_WAIT_ALL, all) of the requested events
+ *   are set.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to wait for
+ *   eflags - NXEVENT_WAIT_* flags
+ *   result - Location to return the requested events that were set when
+ *            the wait was satisfied.  May be NULL.
+ *
+ * Returned Value:
+ *   This is an internal OS interface and should not be used by applications.
+ *   It follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned on success.  A negated errno value is returned on failure:
+ *   -EINTR if the wait was interrupted by a signal or -ECANCELED if the
+ *   event group was destroyed.
+ *
+ ****************************************************************************/
+
+int nxevent_wait(FAR struct nxevent_s *event, nxevent_mask_t events,
+                 uint8_t eflags, FAR nxevent_mask_t *result)
+{
+  return nxevent_waitcommon(event, events, eflags, true, 0, result);
+}
+
+/****************************************************************************
+ * Name: nxevent_tickwait
+ *
+ * Description:
+ *   Like nxevent_wait() but give up after 'delay' system clock ticks.  If
+ *   'delay' is zero, the events are only polled.
+ *
+ * Returned Value:
+ *   As for nxevent_wait().  In addition, -EAGAIN is returned if 'delay' is
+ *   zero and the events are not set and -ETIMEDOUT is returned if the
+ *   delay expires.
+ *
+ ****************************************************************************/
+
+int nxevent_tickwait(FAR struct nxevent_s *event, nxevent_mask_t events,
+                     uint8_t eflags, uint32_t delay,
+                     FAR nxevent_mask_t *result)
+{
+  return nxevent_waitcommon(event, events, eflags, false, delay, result);
+}
+
+#endif /* CONFIG_SCHED_EVENTS */
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * sched/init/os_bootphase.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/init.h>
+
+#ifdef CONFIG_SCHED_BOOTPHASE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One recorded boot phase */
+
+struct bootphase_s
+{
+  FAR const char *name;      /* Name of the phase */
+  uint32_t count;            /* up_perf_gettime() at the end of the phase */
+#ifdef CONFIG_SMP
+  uint8_t cpu;               /* CPU that recorded the phase */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct bootphase_s g_bootphase[CONFIG_SCHED_BOOTPHASE_NPHASES];
+static uint8_t g_nbootphases;
+
+#ifdef CONFIG_SMP
+/* The first phases are recorded before the task lists are initialized so
+ * enter_critical_section() cannot be used.
+ */
+
+static volatile spinlock_t g_bootphase_lock SP_SECTION;
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: os_bootphase
+ *
+ * Description:
+ *   Record the end of the named phase of the boot-up sequence.  The first
+ *   phase is recorded on entry into os_start() and serves as the time
+ *   reference for all later phases.
+ *
+ ****************************************************************************/
+
+void os_bootphase(FAR const char *name)
+{
+  FAR struct bootphase_s *phase;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock(&g_bootphase_lock);
+#endif
+
+  if (g_nbootphases < CONFIG_SCHED_BOOTPHASE_NPHASES)
+    {
+      phase        = &g_bootphase[g_nbootphases++];
+      phase->name  = name;
+      phase->count = up_perf_gettime();
+#ifdef CONFIG_SMP
+      phase->cpu   = up_cpu_index();
+#endif
+    }
+
+#ifdef CONFIG_SMP
+  spin_unlock(&g_bootphase_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: os_bootphase_get
+ *
+ * Description:
+ *   Return the recorded boot phase at 'index'.
+ *
+ ****************************************************************************/
+
+int os_bootphase_get(int index, FAR const char **name, FAR uint32_t *usec,
+                     FAR int *cpu)
+{
+  FAR struct bootphase_s *phase;
+  uint32_t elapsed;
+
+  if (index < 0 || index >= g_nbootphases)
+    {
+      return -ENOENT;
+    }
+
+  phase   = &g_bootphase[index];
+  elapsed = phase->count - g_bootphase[0].count;
+
+  *name   = phase->name;
+  *usec   = (uint32_t)(((uint64_t)elapsed * 1000000) / up_perf_getfreq());
+#ifdef CONFIG_SMP
+  *cpu    = phase->cpu;
+#else
+  *cpu    = 0;
+#endif
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_BOOTPHASE */
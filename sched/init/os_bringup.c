@@ -63,6 +63,9 @@
 #endif
 # include "wqueue/wqueue.h"
 # include "init/init.h"
+#ifdef CONFIG_STACK_MONITOR
+#  include "sched/sched.h"
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -210,6 +213,13 @@ static inline void os_workqueues(void)
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#ifdef CONFIG_SCHED_CPUWORK
+  /* Start the per-CPU worker threads */
+
+  (void)work_cpustart();
+
+#endif /* CONFIG_SCHED_CPUWORK */
+
 #ifdef CONFIG_LIB_USRWORK
   /* Start the user-space work queue */
 
@@ -251,6 +261,7 @@ static inline void os_do_appstart(void)
    */
 
   board_initialize();
+  os_bootphase("board");
 #endif
 
   /* Start the application initialization task.  In a flat build, this is
@@ -274,6 +285,8 @@ static inline void os_do_appstart(void)
 #endif
   DEBUGASSERT(pid > 0);
   UNUSED(pid);
+
+  os_bootphase("appstart");
 }
 
 #elif defined(CONFIG_INIT_FILEPATH)
@@ -287,6 +300,7 @@ static inline void os_do_appstart(void)
    */
 
   board_initialize();
+  os_bootphase("board");
 #endif
 
 #ifdef CONFIG_INIT_MOUNT
@@ -310,6 +324,8 @@ static inline void os_do_appstart(void)
              CONFIG_INIT_NEXPORTS);
   DEBUGASSERT(ret >= 0);
   UNUSED(ret);
+
+  os_bootphase("appstart");
 }
 
 #elif defined(CONFIG_INIT_NONE)
@@ -453,6 +469,12 @@ int os_bringup(void)
 
   os_workqueues();
 
+#ifdef CONFIG_STACK_MONITOR
+  /* Start sampling the stack usage of all threads */
+
+  sched_stackmon_start();
+#endif
+
   /* Once the operating system has been initialized, the system must be
    * started by spawning the user initialization thread of execution.  This
    * will be the first user-mode thread.
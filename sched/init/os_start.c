@@ -95,8 +95,9 @@
  * and by a series of task lists.  All of these tasks lists are declared
  * below. Although it is not always necessary, most of these lists are
  * prioritized so that common list handling logic can be used (only the
- * g_readytorun, the g_pendingtasks, and the g_waitingforsemaphore lists
- * need to be prioritized).
+ * g_readytorun, the g_pendingtasks, and the semaphore wait lists need to
+ * be prioritized).  Tasks waiting for a semaphore are held in the wait list
+ * of that semaphore (see sem_t) so that there is no global list for them.
  */
 
 /* This is the list of all tasks that are ready to run.  This is a
@@ -161,10 +162,6 @@ FAR struct tcb_s *g_running_tasks[1];
 
 volatile dq_queue_t g_pendingtasks;
 
-/* This is the list of all tasks that are blocked waiting for a semaphore */
-
-volatile dq_queue_t g_waitingforsemaphore;
-
 #ifndef CONFIG_DISABLE_SIGNALS
 /* This is the list of all tasks that are blocked waiting for a signal */
 
@@ -289,7 +286,7 @@ const struct tasklist_s g_tasklisttable[NUM_TASK_STATES] =
     0
   },
   {                                              /* TSTATE_WAIT_SEM */
-    &g_waitingforsemaphore,
+    NULL,                                        /* See sem_t waitlist */
     TLIST_ATTR_PRIORITIZED
   }
 #ifndef CONFIG_DISABLE_SIGNALS
@@ -405,13 +402,13 @@ void os_start(void)
   /* Boot up is complete */
 
   g_os_initstate = OSINIT_BOOT;
+  os_bootphase("boot");
 
   /* Initialize RTOS Data ***************************************************/
   /* Initialize all task lists */
 
   dq_init(&g_readytorun);
   dq_init(&g_pendingtasks);
-  dq_init(&g_waitingforsemaphore);
 #ifndef CONFIG_DISABLE_SIGNALS
   dq_init(&g_waitingforsignal);
 #endif
@@ -619,6 +616,12 @@ void os_start(void)
 
   g_os_initstate = OSINIT_MEMORY;
 
+#ifdef HAVE_TCBPOOL
+  /* Create the pool of TCBs */
+
+  sched_tcbpool_initialize();
+#endif
+
 #if defined(CONFIG_SCHED_HAVE_PARENT) && defined(CONFIG_SCHED_CHILD_STATUS)
   /* Initialize tasking data structures */
 
@@ -722,6 +725,7 @@ void os_start(void)
   /* Hardware resources are available */
 
   g_os_initstate = OSINIT_HARDWARE;
+  os_bootphase("hardware");
 
 #ifdef CONFIG_MM_SHM
   /* Initialize shared memory support */
@@ -812,6 +816,7 @@ void os_start(void)
   /* Then start the other CPUs */
 
   DEBUGVERIFY(os_smp_start());
+  os_bootphase("smp");
 
 #endif /* CONFIG_SMP */
 
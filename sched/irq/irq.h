@@ -83,6 +83,16 @@ struct irq_info_s
   uint32_t lscount;  /* Number of interrupts on this IRQ (LS) */
 #endif
   uint32_t time;     /* Maximum execution time on this IRQ */
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+  uint32_t exmax;    /* Maximum exclusive execution time (critmon units) */
+  uint32_t exhist[CONFIG_SCHED_IRQMONITOR_NBUCKETS];
+                     /* log2 histogram of exclusive execution times */
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+  uint32_t ltmax;    /* Maximum latency (critmon units) */
+  uint32_t lthist[CONFIG_SCHED_IRQMONITOR_NBUCKETS];
+                     /* log2 histogram of latencies */
+#endif
+#endif
 #endif
 };
 
@@ -40,6 +40,7 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
 #include <errno.h>
 
 #include <nuttx/irq.h>
@@ -139,6 +140,14 @@ int irq_attach(int irq, xcpt_t isr, FAR void *arg)
       g_irqvector[ndx].mscount = 0;
       g_irqvector[ndx].lscount = 0;
 #endif
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+      g_irqvector[ndx].exmax   = 0;
+      memset(g_irqvector[ndx].exhist, 0, sizeof(g_irqvector[ndx].exhist));
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+      g_irqvector[ndx].ltmax   = 0;
+      memset(g_irqvector[ndx].lthist, 0, sizeof(g_irqvector[ndx].lthist));
+#endif
+#endif
 #endif
 
       leave_critical_section(flags);
@@ -377,6 +377,9 @@ try_again:
 
               /* Note that we have entered the critical section */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+              rtcb->crit_caller = return_address();
+#endif
 #ifdef CONFIG_SCHED_CRITMONITOR
               sched_critmon_csection(rtcb, true);
 #endif
@@ -420,6 +423,9 @@ irqstate_t enter_critical_section(void)
         {
           /* Note that we have entered the critical section */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+          rtcb->crit_caller = return_address();
+#endif
 #ifdef CONFIG_SCHED_CRITMONITOR
           sched_critmon_csection(rtcb, true);
 #endif
@@ -82,6 +82,9 @@
 #ifndef CONFIG_SCHED_IRQMONITOR
 #  define CALL_VECTOR(ndx, vector, irq, context, arg) \
      vector(irq, context, arg)
+#elif defined(CONFIG_SCHED_IRQMONITOR_HISTOGRAM)
+#  define CALL_VECTOR(ndx, vector, irq, context, arg) \
+     irq_monitor_vector(ndx, vector, irq, context, arg)
 #elif defined(CONFIG_SCHED_CRITMONITOR)
 #  define CALL_VECTOR(ndx, vector, irq, context, arg) \
      do \
@@ -118,6 +121,126 @@
      while (0)
 #endif /* CONFIG_SCHED_IRQMONITOR */
 
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+#  ifdef CONFIG_SMP
+#    define IRQMON_NCPUS CONFIG_SMP_NCPUS
+#  else
+#    define IRQMON_NCPUS 1
+#  endif
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+/* The time spent in interrupt handlers that nested within the interrupt
+ * handler currently executing on each CPU.
+ */
+
+static uint32_t g_irqnested[IRQMON_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+/****************************************************************************
+ * Name: irq_monitor_bucket
+ *
+ * Description:
+ *   Return the log2 histogram bucket of a duration:  The number of
+ *   significant bits in the value, saturated at the last bucket.
+ *
+ ****************************************************************************/
+
+static inline unsigned int irq_monitor_bucket(uint32_t value)
+{
+  unsigned int bucket = 0;
+
+  while (value != 0 && bucket < CONFIG_SCHED_IRQMONITOR_NBUCKETS - 1)
+    {
+      value >>= 1;
+      bucket++;
+    }
+
+  return bucket;
+}
+
+/****************************************************************************
+ * Name: irq_monitor_vector
+ *
+ * Description:
+ *   Call the interrupt handler and account its latency and execution time.
+ *
+ *   Higher priority interrupts may nest within the handler.  Each level
+ *   saves the time accumulated by the nested interrupts of its parent,
+ *   starts its own from zero and, on completion, adds its total execution
+ *   time to the parent.  The time of a handler less the time accumulated by
+ *   its nested interrupts is then its exclusive execution time.
+ *
+ ****************************************************************************/
+
+static void irq_monitor_vector(unsigned int ndx, xcpt_t vector, int irq,
+                               FAR void *context, FAR void *arg)
+{
+  FAR struct irq_info_s *info = &g_irqvector[ndx];
+  struct timespec delta;
+  uint32_t saved;
+  uint32_t start;
+  uint32_t elapsed;
+  uint32_t self;
+  int cpu = this_cpu();
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+  uint32_t stamp;
+#endif
+
+  saved            = g_irqnested[cpu];
+  g_irqnested[cpu] = 0;
+  start            = up_critmon_gettime();
+
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+  if (up_irq_asserttime(irq, &stamp))
+    {
+      uint32_t latency = start - stamp;
+
+      if (latency > info->ltmax)
+        {
+          info->ltmax = latency;
+        }
+
+      info->lthist[irq_monitor_bucket(latency)]++;
+    }
+#endif
+
+  vector(irq, context, arg);
+
+  /* An interrupt nesting after this point is not charged to the parent
+   * handler.  That is a few instructions and not worth a critical section.
+   */
+
+  elapsed          = up_critmon_gettime() - start;
+  self             = elapsed - g_irqnested[cpu];
+  g_irqnested[cpu] = saved + elapsed;
+
+  if (self > info->exmax)
+    {
+      info->exmax = self;
+    }
+
+  info->exhist[irq_monitor_bucket(self)]++;
+
+  /* The maximum inclusive time in nanoseconds is still reported */
+
+  up_critmon_convert(elapsed, &delta);
+  if (delta.tv_nsec > info->time)
+    {
+      info->time = delta.tv_nsec;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -46,6 +46,8 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -69,17 +71,43 @@
  * NOTE:  This assumes that an address can be represented in 32-bits.  In
  * the typical configuration where CONFIG_HAVE_LONG_LONG=y, the COUNT field
  * may not be wide enough.
+ *
+ * With CONFIG_SCHED_IRQMONITOR_HISTOGRAM, the maximum, median and 99th
+ * percentile of the exclusive execution time (EX*) and, with
+ * CONFIG_SCHED_IRQMONITOR_LATENCY, of the latency (LT*) are appended to
+ * each line.  TIME and all of these are in microseconds.  The percentiles
+ * are the upper bounds of the log2 histogram buckets that contain them.
+ * A latency of '-' means that the IRQ has no known assertion time.
  */
 
-#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME\n"
-#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu\n"
+#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME"
+#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu"
+
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+#  define EXHDR_FMT  "  EXMAX  EXP50  EXP99"
+#  define LTHDR_FMT  "  LTMAX  LTP50  LTP99"
+#  define HIST_FMT   " %6lu %6lu %6lu"
+#  define NOHIST_FMT "      -      -      -"
+#else
+#  define EXHDR_FMT  ""
+#endif
+
+#ifndef CONFIG_SCHED_IRQMONITOR_LATENCY
+#  define LTHDR_FMT  ""
+#endif
 
 /* Determines the size of an intermediate buffer that must be large enough
  * to handle the longest line generated by this logic (plus a couple of
- * bytes).
+ * bytes).  The histogram fields are sized for ten digits each.
  */
 
-#define IRQ_LINELEN 50
+#if defined(CONFIG_SCHED_IRQMONITOR_LATENCY)
+#  define IRQ_LINELEN 118
+#elif defined(CONFIG_SCHED_IRQMONITOR_HISTOGRAM)
+#  define IRQ_LINELEN 84
+#else
+#  define IRQ_LINELEN 50
+#endif
 
 /****************************************************************************
  * Private Types
@@ -101,6 +129,16 @@ struct irq_file_s
  * Private Function Prototypes
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+/* Histogram statistics */
+
+static unsigned long irq_usec(uint32_t elapsed);
+static uint32_t irq_percentile(FAR const uint32_t *hist, uint32_t max,
+                 unsigned int percent);
+static size_t  irq_histline(FAR char *line, size_t linelen,
+                 FAR const uint32_t *hist, uint32_t max);
+#endif
+
 /* irq_foreach() callback function */
 
 static int     irq_callback(int irq, FAR struct irq_info_s *info,
@@ -147,6 +185,88 @@ const struct procfs_operations irq_operations =
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+/****************************************************************************
+ * Name: irq_usec
+ *
+ * Description:
+ *   Convert an elapsed up_critmon_gettime() time to microseconds.
+ *
+ ****************************************************************************/
+
+static unsigned long irq_usec(uint32_t elapsed)
+{
+  struct timespec ts;
+
+  up_critmon_convert(elapsed, &ts);
+  return (unsigned long)ts.tv_sec * USEC_PER_SEC +
+         (unsigned long)ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: irq_percentile
+ *
+ * Description:
+ *   Return an upper bound on the given percentile of a log2 histogram:  The
+ *   upper bound of the bucket that contains it or the maximum, whichever is
+ *   less.
+ *
+ ****************************************************************************/
+
+static uint32_t irq_percentile(FAR const uint32_t *hist, uint32_t max,
+                               unsigned int percent)
+{
+  uint64_t total = 0;
+  uint64_t rank;
+  uint64_t sum;
+  uint32_t bound;
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_IRQMONITOR_NBUCKETS; i++)
+    {
+      total += hist[i];
+    }
+
+  /* The rank of the percentile sample, rounded up */
+
+  rank = (total * percent + 99) / 100;
+  sum  = 0;
+
+  for (i = 0; i < CONFIG_SCHED_IRQMONITOR_NBUCKETS - 1; i++)
+    {
+      sum += hist[i];
+      if (sum >= rank)
+        {
+          /* Bucket i holds durations up to 2^i - 1 */
+
+          bound = ((uint32_t)1 << i) - 1;
+          return bound < max ? bound : max;
+        }
+    }
+
+  /* The last bucket is unbounded */
+
+  return max;
+}
+
+/****************************************************************************
+ * Name: irq_histline
+ *
+ * Description:
+ *   Format the maximum, median and 99th percentile of one histogram.
+ *
+ ****************************************************************************/
+
+static size_t irq_histline(FAR char *line, size_t linelen,
+                           FAR const uint32_t *hist, uint32_t max)
+{
+  return snprintf(line, linelen, HIST_FMT,
+                  irq_usec(max),
+                  irq_usec(irq_percentile(hist, max, 50)),
+                  irq_usec(irq_percentile(hist, max, 99)));
+}
+#endif
+
 /****************************************************************************
  * Name: irq_callback
  ****************************************************************************/
@@ -180,6 +300,14 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   info->lscount = 0;
 #endif
   info->time    = 0;
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+  info->exmax   = 0;
+  memset(info->exhist, 0, sizeof(info->exhist));
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+  info->ltmax   = 0;
+  memset(info->lthist, 0, sizeof(info->lthist));
+#endif
+#endif
   leave_critical_section(flags);
 
   /* Don't bother if count == 0.
@@ -255,6 +383,30 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
                       count, intpart, fracpart,
                       (unsigned long)copy.time / 1000);
 
+#ifdef CONFIG_SCHED_IRQMONITOR_HISTOGRAM
+  linesize += irq_histline(&irqfile->line[linesize], IRQ_LINELEN - linesize,
+                           copy.exhist, copy.exmax);
+
+#ifdef CONFIG_SCHED_IRQMONITOR_LATENCY
+  /* Latencies of zero are counted in bucket 0 */
+
+  if (copy.ltmax > 0 || copy.lthist[0] > 0)
+    {
+      linesize += irq_histline(&irqfile->line[linesize],
+                               IRQ_LINELEN - linesize,
+                               copy.lthist, copy.ltmax);
+    }
+  else
+    {
+      linesize += snprintf(&irqfile->line[linesize],
+                           IRQ_LINELEN - linesize, NOHIST_FMT);
+    }
+#endif
+#endif
+
+  linesize += snprintf(&irqfile->line[linesize], IRQ_LINELEN - linesize,
+                       "\n");
+
   copysize  = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                             irqfile->remaining, &irqfile->offset);
 
@@ -366,7 +518,8 @@ static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
 
   /* The first line to output is the header */
 
-  linesize = snprintf(irqfile->line, IRQ_LINELEN, HDR_FMT);
+  linesize = snprintf(irqfile->line, IRQ_LINELEN,
+                      HDR_FMT EXHDR_FMT LTHDR_FMT "\n");
 
   copysize = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                            irqfile->remaining, &irqfile->offset);
@@ -0,0 +1,301 @@
+/****************************************************************************
+ * sched/irq/irq_thread.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sched.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+
+#include "irq/irq.h"
+
+#ifdef CONFIG_IRQ_THREAD
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one threaded interrupt */
+
+struct irq_thread_s
+{
+  FAR struct irq_thread_s *flink; /* Supports a singly linked list */
+  xcpt_t isr;                     /* Interrupt level handler (may be NULL) */
+  xcpt_t isrthread;               /* Thread level handler */
+  FAR void *arg;                  /* Argument of both handlers */
+  sem_t sem;                      /* Posted to wake up the thread */
+  pid_t pid;                      /* Process ID of the thread */
+  int16_t irq;                    /* The IRQ number */
+  volatile bool exit;             /* True: The thread should exit */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of threaded interrupts.  Used only to find the state of an IRQ
+ * when it is detached.
+ */
+
+static FAR struct irq_thread_s *g_irqthreads;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_thread_isr
+ *
+ * Description:
+ *   The interrupt handler attached with irq_attach().  This does no more
+ *   than wake up the thread.  The post is skipped if a wakeup is already
+ *   pending:  The thread level handler will then handle this interrupt as
+ *   well.
+ *
+ ****************************************************************************/
+
+static int irq_thread_isr(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct irq_thread_s *info = (FAR struct irq_thread_s *)arg;
+  int ret = IRQ_WAKE_THREAD;
+
+  if (info->isr != NULL)
+    {
+      ret = info->isr(irq, context, info->arg);
+    }
+
+  if (ret == IRQ_WAKE_THREAD)
+    {
+      if (info->sem.semcount <= 0)
+        {
+          (void)nxsem_post(&info->sem);
+        }
+
+      ret = OK;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: irq_thread_main
+ ****************************************************************************/
+
+static int irq_thread_main(int argc, FAR char *argv[])
+{
+  FAR struct irq_thread_s *info;
+
+  /* The interrupt state is passed as a hexadecimal address in argv[1] */
+
+  DEBUGASSERT(argc == 2);
+  info = (FAR struct irq_thread_s *)((uintptr_t)strtoul(argv[1], NULL, 16));
+
+  for (; ; )
+    {
+      (void)nxsem_wait_uninterruptible(&info->sem);
+      if (info->exit)
+        {
+          break;
+        }
+
+      (void)info->isrthread(info->irq, NULL, info->arg);
+    }
+
+  nxsem_destroy(&info->sem);
+  kmm_free(info);
+  return EXIT_SUCCESS;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Attach a threaded interrupt handler.  See include/nuttx/irq.h.
+ *
+ ****************************************************************************/
+
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size, int cpu)
+{
+  FAR struct irq_thread_s *info;
+  FAR char *argv[2];
+  char name[16];
+  char arg1[16];
+  irqstate_t flags;
+  int ret;
+
+  if ((unsigned)irq >= NR_IRQS || isrthread == NULL)
+    {
+      return -EINVAL;
+    }
+
+  info = (FAR struct irq_thread_s *)kmm_zalloc(sizeof(struct irq_thread_s));
+  if (info == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  info->isr       = isr;
+  info->isrthread = isrthread;
+  info->arg       = arg;
+  info->irq       = irq;
+
+  /* The semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&info->sem, 0, 0);
+  nxsem_setprotocol(&info->sem, SEM_PRIO_NONE);
+
+  /* Start the thread */
+
+  snprintf(name, sizeof(name), "irq%d", irq);
+  snprintf(arg1, sizeof(arg1), "%lx", (unsigned long)((uintptr_t)info));
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  ret = kthread_create(name, priority,
+                       stack_size > 0 ? stack_size :
+                       CONFIG_IRQ_THREAD_STACKSIZE,
+                       irq_thread_main, (FAR char * const *)argv);
+  if (ret < 0)
+    {
+      serr("ERROR: Failed to start the thread of IRQ %d: %d\n", irq, ret);
+      nxsem_destroy(&info->sem);
+      kmm_free(info);
+      return ret;
+    }
+
+  info->pid = (pid_t)ret;
+
+#ifdef CONFIG_SMP
+  if (cpu >= 0)
+    {
+      cpu_set_t cpuset;
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      ret = nxsched_setaffinity(info->pid, sizeof(cpu_set_t), &cpuset);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to bind IRQ %d to CPU %d: %d\n",
+               irq, cpu, ret);
+        }
+    }
+#else
+  UNUSED(cpu);
+#endif
+
+  /* Then attach the interrupt handler */
+
+  ret = irq_attach(irq, irq_thread_isr, info);
+  if (ret < 0)
+    {
+      info->exit = true;
+      (void)nxsem_post(&info->sem);
+      return ret;
+    }
+
+  flags        = enter_critical_section();
+  info->flink  = g_irqthreads;
+  g_irqthreads = info;
+  leave_critical_section(flags);
+
+  return info->pid;
+}
+
+/****************************************************************************
+ * Name: irq_detach_thread
+ *
+ * Description:
+ *   Detach a threaded interrupt handler.  See include/nuttx/irq.h.
+ *
+ ****************************************************************************/
+
+int irq_detach_thread(int irq)
+{
+  FAR struct irq_thread_s *info;
+  FAR struct irq_thread_s *prev;
+  irqstate_t flags;
+
+  /* Find and remove the state of the IRQ */
+
+  flags = enter_critical_section();
+  for (prev = NULL, info = g_irqthreads;
+       info != NULL && info->irq != irq;
+       prev = info, info = info->flink);
+
+  if (info == NULL)
+    {
+      leave_critical_section(flags);
+      return -ENOENT;
+    }
+
+  if (prev != NULL)
+    {
+      prev->flink = info->flink;
+    }
+  else
+    {
+      g_irqthreads = info->flink;
+    }
+
+  (void)irq_detach(irq);
+  leave_critical_section(flags);
+
+  /* The thread frees the state when it exits */
+
+  info->exit = true;
+  return nxsem_post(&info->sem);
+}
+
+#endif /* CONFIG_IRQ_THREAD */
@@ -81,6 +81,18 @@ sq_queue_t  g_msgfreeirq;
 
 sq_queue_t  g_desfree;
 
+#ifdef HAVE_MSGQPOOL
+/* g_msgqpool is the pool of struct mqueue_inode_s */
+
+FAR struct objpool_s *g_msgqpool;
+#endif
+
+#ifdef CONFIG_MQ_ZEROCOPY
+/* g_mqzcpool is the pool of zero-copy message buffers */
+
+FAR struct objpool_s *g_mqzcpool;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -189,6 +201,20 @@ void nxmq_initialize(void)
   /* Allocate a block of message queue descriptors */
 
   nxmq_alloc_desblock();
+
+#ifdef HAVE_MSGQPOOL
+  /* Create the pool of message queue structures */
+
+  g_msgqpool = OBJPOOL_CREATE("mqueue", struct mqueue_inode_s,
+                              CONFIG_PREALLOC_MQ_QUEUES);
+#endif
+
+#ifdef CONFIG_MQ_ZEROCOPY
+  /* Create the pool of zero-copy message buffers */
+
+  g_mqzcpool = objpool_create("mqzc", CONFIG_MQ_ZCBUFSIZE,
+                              CONFIG_MQ_NZCBUFFERS);
+#endif
 }
 
 /****************************************************************************
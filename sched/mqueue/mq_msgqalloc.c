@@ -87,10 +87,24 @@ FAR struct mqueue_inode_s *nxmq_alloc_msgq(mode_t mode,
       return NULL;
     }
 
-  /* Allocate memory for the new message queue. */
+  /* Allocate memory for the new message queue.  Use the pool of message
+   * queue structures first (if any).
+   */
+
+  msgq = NULL;
+
+#ifdef HAVE_MSGQPOOL
+  if (g_msgqpool != NULL)
+    {
+      msgq = (FAR struct mqueue_inode_s *)objpool_zalloc(g_msgqpool);
+    }
 
-  msgq = (FAR struct mqueue_inode_s *)
-    kmm_zalloc(sizeof(struct mqueue_inode_s));
+  if (msgq == NULL)
+#endif
+    {
+      msgq = (FAR struct mqueue_inode_s *)
+        kmm_zalloc(sizeof(struct mqueue_inode_s));
+    }
 
   if (msgq)
     {
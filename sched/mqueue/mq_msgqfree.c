@@ -78,11 +78,23 @@ void nxmq_free_msgq(FAR struct mqueue_inode_s *msgq)
       /* Deallocate the message structure. */
 
       next = curr->next;
+#ifdef CONFIG_MQ_ZEROCOPY
+      nxmq_zcrecover(curr);
+#endif
       nxmq_free_msg(curr);
       curr = next;
     }
 
   /* Then deallocate the message queue itself */
 
-  sched_kfree(msgq);
+#ifdef HAVE_MSGQPOOL
+  if (g_msgqpool != NULL && objpool_member(g_msgqpool, msgq))
+    {
+      objpool_free(g_msgqpool, msgq);
+    }
+  else
+#endif
+    {
+      sched_kfree(msgq);
+    }
 }
@@ -0,0 +1,228 @@
+/****************************************************************************
+ *  sched/mqueue/mq_zerocopy.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <mqueue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/mqueue.h>
+#include <nuttx/mm/objpool.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_ZEROCOPY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_MQ_MAXMSGSIZE < 12
+#  error CONFIG_MQ_MAXMSGSIZE is too small for zero-copy messages
+#endif
+
+/* Identifies the descriptor of a zero-copy message */
+
+#define MQ_ZCMAGIC 0x4d515a43 /* "MQZC" */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_zcverify
+ *
+ * Description:
+ *   Check a received descriptor and return the buffer that it describes.
+ *
+ ****************************************************************************/
+
+static ssize_t nxmq_zcverify(FAR const struct mq_zcmsg_s *zcmsg,
+                             ssize_t nbytes, FAR void **buffer)
+{
+  if (nbytes < 0)
+    {
+      return nbytes;
+    }
+
+  /* Something other than a zero-copy message was sent to the queue */
+
+  if (nbytes != MQ_ZCMSGSIZE || zcmsg->magic != MQ_ZCMAGIC)
+    {
+      return -EBADMSG;
+    }
+
+  *buffer = zcmsg->buffer;
+  return (ssize_t)zcmsg->buflen;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_zcalloc
+ *
+ * Description:
+ *   Allocate a buffer from the zero-copy buffer pool.
+ *
+ ****************************************************************************/
+
+FAR void *nxmq_zcalloc(void)
+{
+  if (g_mqzcpool == NULL)
+    {
+      return NULL;
+    }
+
+  return objpool_alloc(g_mqzcpool);
+}
+
+/****************************************************************************
+ * Name: nxmq_zcfree
+ *
+ * Description:
+ *   Return a buffer to the zero-copy buffer pool.
+ *
+ ****************************************************************************/
+
+void nxmq_zcfree(FAR void *buffer)
+{
+  DEBUGASSERT(g_mqzcpool != NULL && objpool_member(g_mqzcpool, buffer));
+  objpool_free(g_mqzcpool, buffer);
+}
+
+/****************************************************************************
+ * Name: nxmq_zcsend
+ *
+ * Description:
+ *   Queue a descriptor of a zero-copy buffer.  The message goes through
+ *   nxmq_send() so that it is subject to the same priority ordering,
+ *   blocking behavior and notification as any other message.
+ *
+ ****************************************************************************/
+
+int nxmq_zcsend(mqd_t mqdes, FAR void *buffer, size_t buflen, int prio)
+{
+  struct mq_zcmsg_s zcmsg;
+
+  if (g_mqzcpool == NULL || !objpool_member(g_mqzcpool, buffer) ||
+      buflen > CONFIG_MQ_ZCBUFSIZE)
+    {
+      return -EINVAL;
+    }
+
+  zcmsg.magic  = MQ_ZCMAGIC;
+  zcmsg.buffer = buffer;
+  zcmsg.buflen = buflen;
+
+  return nxmq_send(mqdes, (FAR const char *)&zcmsg, MQ_ZCMSGSIZE, prio);
+}
+
+/****************************************************************************
+ * Name: nxmq_zcreceive
+ *
+ * Description:
+ *   Receive a zero-copy buffer.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_zcreceive(mqd_t mqdes, FAR void **buffer, FAR int *prio)
+{
+  struct mq_zcmsg_s zcmsg;
+  ssize_t nbytes;
+
+  DEBUGASSERT(buffer != NULL);
+
+  nbytes = nxmq_receive(mqdes, (FAR char *)&zcmsg, MQ_ZCMSGSIZE, prio);
+  return nxmq_zcverify(&zcmsg, nbytes, buffer);
+}
+
+/****************************************************************************
+ * Name: nxmq_zctimedreceive
+ *
+ * Description:
+ *   Receive a zero-copy buffer, waiting no longer than abstime.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_zctimedreceive(mqd_t mqdes, FAR void **buffer, FAR int *prio,
+                            FAR const struct timespec *abstime)
+{
+  struct mq_zcmsg_s zcmsg;
+  ssize_t nbytes;
+
+  DEBUGASSERT(buffer != NULL);
+
+  nbytes = nxmq_timedreceive(mqdes, (FAR char *)&zcmsg, MQ_ZCMSGSIZE,
+                             prio, abstime);
+  return nxmq_zcverify(&zcmsg, nbytes, buffer);
+}
+
+/****************************************************************************
+ * Name: nxmq_zcrecover
+ *
+ * Description:
+ *   Called when a message queue is freed with messages still queued.  If
+ *   the message is a zero-copy message, return its buffer to the pool;
+ *   nobody else will.
+ *
+ * Input Parameters:
+ *   mqmsg - The stranded message
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxmq_zcrecover(FAR struct mqueue_msg_s *mqmsg)
+{
+  FAR struct mq_zcmsg_s *zcmsg = (FAR struct mq_zcmsg_s *)mqmsg->mail;
+
+  if (mqmsg->msglen == MQ_ZCMSGSIZE && zcmsg->magic == MQ_ZCMAGIC &&
+      g_mqzcpool != NULL && objpool_member(g_mqzcpool, zcmsg->buffer))
+    {
+      objpool_free(g_mqzcpool, zcmsg->buffer);
+    }
+}
+
+#endif /* CONFIG_MQ_ZEROCOPY */
@@ -51,6 +51,7 @@
 #include <sched.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/mm/objpool.h>
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -74,6 +75,14 @@
 
 #define NUM_INTERRUPT_MSGS   8
 
+/* Message queue structures are allocated from a pool if
+ * CONFIG_PREALLOC_MQ_QUEUES > 0
+ */
+
+#if defined(CONFIG_MM_OBJPOOL) && CONFIG_PREALLOC_MQ_QUEUES > 0
+#  define HAVE_MSGQPOOL 1
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -131,6 +140,18 @@ EXTERN sq_queue_t  g_msgfreeirq;
 
 EXTERN sq_queue_t  g_desfree;
 
+#ifdef HAVE_MSGQPOOL
+/* g_msgqpool is the pool of struct mqueue_inode_s */
+
+EXTERN FAR struct objpool_s *g_msgqpool;
+#endif
+
+#ifdef CONFIG_MQ_ZEROCOPY
+/* g_mqzcpool is the pool of zero-copy message buffers */
+
+EXTERN FAR struct objpool_s *g_mqzcpool;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -144,6 +165,12 @@ void weak_function nxmq_initialize(void);
 void nxmq_alloc_desblock(void);
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
 
+/* mq_zerocopy.c ***********************************************************/
+
+#ifdef CONFIG_MQ_ZEROCOPY
+void nxmq_zcrecover(FAR struct mqueue_msg_s *mqmsg);
+#endif
+
 /* mq_waitirq.c ************************************************************/
 
 void nxmq_wait_irq(FAR struct tcb_s *wtcb, int errcode);
@@ -50,6 +50,24 @@
 
 #include <nuttx/compiler.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With priority inheritance, only mutexes created with the PTHREAD_PRIO_NONE
+ * protocol use the fast path:  A thread that takes the lock on the fast
+ * path is not known to the semaphore as a holder and could not be boosted.
+ */
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#  ifdef CONFIG_PRIORITY_INHERITANCE
+#    define pthread_mutex_isfast(m) \
+       (((m)->sem.flags & PRIOINHERIT_FLAGS_DISABLE) != 0)
+#  else
+#    define pthread_mutex_isfast(m) (true)
+#  endif
+#endif
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
@@ -119,12 +137,24 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
 void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
+#elif defined(CONFIG_PTHREAD_MUTEX_FASTPATH)
+int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr);
+int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
+int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
 #else
 #  define pthread_mutex_take(m,i)  pthread_sem_take(&(m)->sem,(i))
 #  define pthread_mutex_trytake(m) pthread_sem_trytake(&(m)->sem)
 #  define pthread_mutex_give(m)    pthread_sem_give(&(m)->sem)
 #endif
 
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+#  ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+int pthread_mutex_handoff(FAR struct pthread_mutex_s *mutex);
+#  else
+#    define pthread_mutex_handoff(m) (OK)
+#  endif
+#endif
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 int pthread_mutexattr_verifytype(int type);
 #endif
@@ -44,8 +44,91 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
 #include "pthread/pthread.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_morph
+ *
+ * Description:
+ *   Move the threads waiting in pthread_cond_wait() from the wait list of
+ *   the condition variable to the wait list of the mutex, provided that
+ *   the mutex is held.  Those threads would otherwise only wake up to block
+ *   again on the mutex.  Each release of the mutex will now wake up one of
+ *   them as the new owner of the mutex.
+ *
+ * Input Parameters:
+ *   cond - the condition variable to broadcast
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Pre-emption is disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+static void pthread_cond_morph(FAR pthread_cond_t *cond)
+{
+  FAR pthread_mutex_t *mutex = cond->mutex;
+  FAR struct tcb_s *stcb;
+  FAR struct tcb_s *next;
+  irqstate_t flags;
+
+  /* The waiters cannot be handed a mutex that is taken on the fast path or
+   * that would have to boost the priority of its holder.
+   */
+
+  if (mutex == NULL)
+    {
+      return;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  if (pthread_mutex_isfast(mutex))
+    {
+      return;
+    }
+#endif
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if ((mutex->sem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      return;
+    }
+#endif
+
+  flags = enter_critical_section();
+
+  /* Waiters in pthread_cond_timedwait() are recognized by their watchdog.
+   * They are left in place to be awakened below:  A timeout must not be
+   * mistaken for the loss of a mutex wait.
+   */
+
+  for (stcb = (FAR struct tcb_s *)dq_peek(&cond->sem.waitlist);
+       stcb != NULL && mutex->sem.semcount <= 0;
+       stcb = next)
+    {
+      next = stcb->flink;
+      if (stcb->waitdog == NULL)
+        {
+          nxsem_requeue(stcb, &mutex->sem);
+          stcb->flags |= TCB_FLAG_COND_MORPHED;
+        }
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -86,6 +169,12 @@ int pthread_cond_broadcast(FAR pthread_cond_t *cond)
 
       sched_lock();
 
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+      /* Hand the waiters over to the mutex if it is held */
+
+      pthread_cond_morph(cond);
+#endif
+
       /* Get the current value of the semaphore */
 
       if (nxsem_getvalue((FAR sem_t *)&cond->sem, &sval) != OK)
@@ -45,10 +45,84 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/cancelpt.h>
 
+#include "sched/sched.h"
 #include "pthread/pthread.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_morphwait
+ *
+ * Description:
+ *   Wait on the condition semaphore.  pthread_cond_broadcast() may move
+ *   the caller to the wait list of the mutex while it waits.  If so, the
+ *   caller returns owning the semaphore of the mutex unless the wait was
+ *   interrupted.
+ *
+ * Input Parameters:
+ *   cond    - the condition variable to wait on
+ *   mutex   - the mutex that protects the condition variable
+ *   morphed - Location to return true if the caller was moved to the wait
+ *             list of the mutex
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ * Assumptions:
+ *   Pre-emption is disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+static int pthread_cond_morphwait(FAR pthread_cond_t *cond,
+                                  FAR pthread_mutex_t *mutex,
+                                  FAR bool *morphed)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  irqstate_t flags;
+  int ret;
+
+  /* Let pthread_cond_broadcast() know where the waiters may be moved */
+
+  cond->mutex = mutex;
+  *morphed    = false;
+
+  do
+    {
+      ret = nxsem_wait((FAR sem_t *)&cond->sem);
+
+      flags = enter_critical_section();
+      if ((rtcb->flags & TCB_FLAG_COND_MORPHED) != 0)
+        {
+          rtcb->flags &= ~TCB_FLAG_COND_MORPHED;
+          *morphed     = true;
+        }
+
+      leave_critical_section(flags);
+    }
+  while (ret == -EINTR && !*morphed);
+
+  /* The condition was signalled if we were moved.  If the subsequent wait
+   * for the mutex was interrupted by a signal, the mutex still has to be
+   * taken normally.
+   */
+
+  if (*morphed && ret == -EINTR)
+    {
+      *morphed = false;
+      ret      = OK;
+    }
+
+  DEBUGASSERT(ret == OK || ret == -ECANCELED);
+  return -ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -71,6 +145,9 @@
 
 int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 {
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+  bool morphed = false;
+#endif
   int status;
   int ret;
 
@@ -105,7 +182,11 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 
       /* Take the semaphore */
 
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+      status = pthread_cond_morphwait(cond, mutex, &morphed);
+#else
       status = pthread_sem_take((FAR sem_t *)&cond->sem, false);
+#endif
       if (ret == OK)
         {
           /* Report the first failure that occurs */
@@ -124,7 +205,18 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 
       sinfo("Reacquire mutex...\n");
 
-      status = pthread_mutex_take(mutex, false);
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+      if (morphed && status == OK)
+        {
+          /* The mutex was handed to us when it was released */
+
+          status = pthread_mutex_handoff(mutex);
+        }
+      else
+#endif
+        {
+          status = pthread_mutex_take(mutex, false);
+        }
       if (ret == OK)
         {
           /* Report the first failure that occurs */
@@ -261,7 +261,8 @@ int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
 
   /* Allocate a TCB for the new task. */
 
-  ptcb = (FAR struct pthread_tcb_s *)kmm_zalloc(sizeof(struct pthread_tcb_s));
+  ptcb = (FAR struct pthread_tcb_s *)
+    sched_tcballoc(sizeof(struct pthread_tcb_s));
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -491,6 +492,16 @@ int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
         break;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        /* Deadline bandwidth is admitted per thread and is not inherited.
+         * The new thread may use sched_setscheduler() to request its own.
+         */
+
+        ptcb->cmn.flags    |= TCB_FLAG_SCHED_FIFO;
+        break;
+#endif
+
 #if 0 /* Not supported */
       case SCHED_OTHER:
         ptcb->cmn.flags    |= TCB_FLAG_SCHED_OTHER;
@@ -230,6 +230,51 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr)
   return ret;
 }
 
+/****************************************************************************
+ * Name: pthread_mutex_handoff
+ *
+ * Description:
+ *   Complete taking a pthread_mutex whose underlying semaphore count was
+ *   handed to the calling thread while it was waiting on the semaphore
+ *   (see pthread_cond_broadcast()).  If successful, add the mutex to the
+ *   list of mutexes held by this thread.
+ *
+ * Input Parameters:
+ *  mutex - The mutex that was handed to the caller
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+int pthread_mutex_handoff(FAR struct pthread_mutex_s *mutex)
+{
+  int ret = OK;
+
+  DEBUGASSERT(mutex != NULL);
+
+  sched_lock();
+
+  /* Check if the holder of the mutex has terminated without releasing. */
+
+  if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
+    {
+      ret = EOWNERDEAD;
+    }
+
+  /* Add the mutex to the list of mutexes held by this task */
+
+  else
+    {
+      pthread_mutex_add(mutex);
+    }
+
+  sched_unlock();
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: pthread_mutex_trytake
  *
@@ -107,6 +107,17 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
 
               mutex->pid = -1;
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+              /* Release the lock of a fast path mutex.  The reset below
+               * then wakes up any waiters to retry the lock.
+               */
+
+              if (pthread_mutex_isfast(mutex))
+                {
+                  mutex->lock = SP_UNLOCKED;
+                }
+#endif
+
               /* Reset the semaphore.  If threads are were on this
                * semaphore, then this will awakened them and make
                * destruction of the semaphore impossible here.
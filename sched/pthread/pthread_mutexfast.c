@@ -0,0 +1,212 @@
+/****************************************************************************
+ * sched/pthread/pthread_mutexfast.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
+
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_take
+ *
+ * Description:
+ *   Take the pthread_mutex, waiting if necessary.  An uncontended mutex is
+ *   taken with a single atomic test-and-set of the mutex lock.  Only if the
+ *   lock is already held does the caller register as a waiter and sleep on
+ *   the semaphore until the lock is released.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be locked
+ *  intr  - false: ignore EINTR errors when locking; true treat EINTR as
+ *          other errors by returning the errno value.  The fast path wait
+ *          is never interrupted.
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(mutex != NULL);
+
+  if (!pthread_mutex_isfast(mutex))
+    {
+      return pthread_sem_take(&mutex->sem, intr);
+    }
+
+  /* Try the uncontended case first */
+
+  if (up_testset(&mutex->lock) == SP_UNLOCKED)
+    {
+      SP_DMB();
+      return OK;
+    }
+
+  /* The mutex is held.  Register as a waiter so that the next unlock will
+   * post the semaphore, then retry until the lock is obtained.  A post may
+   * arrive after the lock was already taken by someone else; that just
+   * causes another pass through the loop.
+   *
+   * The wait cannot be abandoned on a signal:  A count posted for this
+   * thread would then be left on the semaphore.
+   */
+
+  flags = enter_critical_section();
+  mutex->nwaiters++;
+  leave_critical_section(flags);
+
+  while (up_testset(&mutex->lock) != SP_UNLOCKED)
+    {
+      (void)nxsem_wait_uninterruptible(&mutex->sem);
+    }
+
+  flags = enter_critical_section();
+  mutex->nwaiters--;
+  leave_critical_section(flags);
+
+  SP_DMB();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_trytake
+ *
+ * Description:
+ *   Try to take the pthread_mutex without waiting.  Like
+ *   pthread_sem_trytake(), EAGAIN is returned if the mutex is held.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be locked
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
+{
+  DEBUGASSERT(mutex != NULL);
+
+  if (!pthread_mutex_isfast(mutex))
+    {
+      return pthread_sem_trytake(&mutex->sem);
+    }
+
+  if (up_testset(&mutex->lock) == SP_UNLOCKED)
+    {
+      SP_DMB();
+      return OK;
+    }
+
+  return EAGAIN;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_give
+ *
+ * Description:
+ *   Release the pthread_mutex.  The semaphore is posted only if there are
+ *   threads waiting for the lock.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be unlocked
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(mutex != NULL);
+
+  if (!pthread_mutex_isfast(mutex))
+    {
+      return pthread_sem_give(&mutex->sem);
+    }
+
+  /* Release the lock.  The release must be visible before the waiter
+   * count is examined:  A thread that registered as a waiter after this
+   * point will find the lock available.
+   */
+
+  SP_DMB();
+  mutex->lock = SP_UNLOCKED;
+  SP_DSB();
+
+  if (mutex->nwaiters > 0)
+    {
+      /* Wake up one waiter.  One pending count is enough to let a waiter
+       * retry the lock; don't accumulate more.
+       */
+
+      flags = enter_critical_section();
+      if (mutex->sem.semcount < 1)
+        {
+          ret = pthread_sem_give(&mutex->sem);
+        }
+
+      leave_critical_section(flags);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
@@ -85,6 +85,10 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
   uint8_t robust = PTHREAD_MUTEX_ROBUST;
 #endif
 #endif
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+  uint8_t adaptive = 0;
+#endif
+  int semcount = 1;
   int ret = OK;
   int status;
 
@@ -109,6 +113,9 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
 #endif
 #ifdef CONFIG_PTHREAD_MUTEX_BOTH
           robust  = attr->robust;
+#endif
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+          adaptive = attr->adaptive;
 #endif
         }
 
@@ -116,9 +123,30 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
 
       mutex->pid = -1;
 
-      /* Initialize the mutex like a semaphore with initial count = 1 */
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+      mutex->adaptive = adaptive;
+#endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      /* A fast path mutex is held via its lock.  The semaphore then has no
+       * initial count; it is only posted to wake up waiters.
+       */
+
+      mutex->lock     = SP_UNLOCKED;
+      mutex->nwaiters = 0;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      if (proto == PTHREAD_PRIO_NONE)
+#endif
+        {
+          semcount = 0;
+        }
+#endif
+
+      /* Initialize the mutex like a semaphore with initial count = 1 (or
+       * zero for the fast path).
+       */
 
-      status = nxsem_init((FAR sem_t *)&mutex->sem, pshared, 1);
+      status = nxsem_init((FAR sem_t *)&mutex->sem, pshared, semcount);
       if (status < 0)
         {
           ret = -ret;
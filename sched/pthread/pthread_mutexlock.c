@@ -48,8 +48,82 @@
 
 #include <nuttx/sched.h>
 
+#include "sched/sched.h"
 #include "pthread/pthread.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_spin
+ *
+ * Description:
+ *   Spin on an adaptive mutex for as long as its holder is running on
+ *   another CPU, up to CONFIG_PTHREAD_MUTEX_SPINCOUNT times.  This returns
+ *   when the mutex appears to be available, when the holder is no longer
+ *   running, or when the spin limit is reached.  The caller then takes the
+ *   mutex in the normal way, blocking if it is still held.
+ *
+ *   The holder's TCB is sampled without entering a critical section.  The
+ *   state that is read is only a hint:  In the worst case the caller spins
+ *   for too long or blocks too early; correctness is unaffected.
+ *
+ * Input Parameters:
+ *   mutex - The mutex to be locked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+static void pthread_mutex_spin(FAR struct pthread_mutex_s *mutex)
+{
+  FAR struct tcb_s *htcb = NULL;
+  pid_t hpid = -1;
+  pid_t pid;
+  int i;
+
+  for (i = 0; i < CONFIG_PTHREAD_MUTEX_SPINCOUNT; i++)
+    {
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      if (pthread_mutex_isfast(mutex) ? mutex->lock == SP_UNLOCKED :
+          mutex->sem.semcount > 0)
+#else
+      if (mutex->sem.semcount > 0)
+#endif
+        {
+          /* The mutex has been released */
+
+          return;
+        }
+
+      /* Look up the holder only when it changes.  The holder pid may not
+       * be valid yet if the mutex was just taken.
+       */
+
+      pid = mutex->pid;
+      if (pid > 0 && pid != hpid)
+        {
+          htcb = sched_gettcb(pid);
+          hpid = pid;
+        }
+
+      if (pid > 0 &&
+          (htcb == NULL || htcb->task_state != TSTATE_TASK_RUNNING ||
+           htcb->cpu == this_cpu()))
+        {
+          /* The holder is not running on another CPU.  It will not release
+           * the mutex until we give up the CPU.
+           */
+
+          return;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -114,6 +188,36 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 
   if (mutex != NULL)
     {
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      /* Uncontended fast path:  Take an available mutex without locking
+       * the scheduler.  Relocking by the holder and contention are handled
+       * below.
+       */
+
+      if (pthread_mutex_isfast(mutex) && mutex->pid != mypid &&
+          pthread_mutex_trytake(mutex) == OK)
+        {
+          mutex->pid    = mypid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          mutex->nlocks = 1;
+#endif
+          return OK;
+        }
+#endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+      /* If the mutex is held by a thread running on another CPU, it may
+       * well be released before we could block and be restarted.  Spin
+       * for a while first.  This must be done before the scheduler is
+       * locked.
+       */
+
+      if (mutex->adaptive && mutex->pid != mypid)
+        {
+          pthread_mutex_spin(mutex);
+        }
+#endif
+
       /* Make sure the semaphore is stable while we make the following
        * checks.  This all needs to be one atomic action.
        */
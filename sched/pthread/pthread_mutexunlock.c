@@ -68,7 +68,18 @@
 
 static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
 {
-  int semcount = mutex->sem.semcount;
+  int semcount;
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* A fast path mutex is locked if its lock is held */
+
+  if (pthread_mutex_isfast(mutex))
+    {
+      return mutex->lock == SP_LOCKED;
+    }
+#endif
+
+  semcount = mutex->sem.semcount;
 
   /* The underlying semaphore should have a count less than 2:
    *
@@ -123,6 +134,25 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
       return EINVAL;
     }
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* Fast path:  The holder releases the mutex (or the outermost lock of a
+   * recursive mutex) without locking the scheduler.
+   */
+
+  if (pthread_mutex_isfast(mutex) && mutex->pid == (int)getpid()
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      && (mutex->type != PTHREAD_MUTEX_RECURSIVE || mutex->nlocks <= 1)
+#endif
+     )
+    {
+      mutex->pid    = -1;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      mutex->nlocks = 0;
+#endif
+      return pthread_mutex_give(mutex);
+    }
+#endif
+
   /* Make sure the semaphore is stable while we make the following checks.
    * This all needs to be one atomic action.
    */
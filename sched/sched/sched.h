@@ -70,6 +70,38 @@
 #define MAX_TASKS_MASK           (CONFIG_MAX_TASKS-1)
 #define PIDHASH(pid)             ((pid) & MAX_TASKS_MASK)
 
+/* With CONFIG_SCHED_CPUTIME, CPU load is charged in units of 100
+ * microseconds of measured CPU time.
+ */
+
+#define CPULOAD_CPUTIME_FREQ     10000
+
+/* CPUs that are excluded from automatic task placement.  An isolated CPU
+ * runs only tasks whose affinity includes no other (housekeeping) CPU.
+ * CPU0 runs the system timer and the watchdog timers and cannot be
+ * isolated.
+ */
+
+#ifdef CONFIG_SMP
+#  ifndef CONFIG_SMP_ISOLATED_CPUS
+#    define CONFIG_SMP_ISOLATED_CPUS 0
+#  endif
+
+#  if (CONFIG_SMP_ISOLATED_CPUS & 1) != 0
+#    error CPU0 cannot be included in CONFIG_SMP_ISOLATED_CPUS
+#  endif
+
+#  define sched_cpu_isolated(cpu) \
+     ((CONFIG_SMP_ISOLATED_CPUS & (1 << (cpu))) != 0)
+
+/* True if the scheduler may move the task to the CPU on its own */
+
+#  define sched_cpu_allowed(tcb, cpu) \
+     (CPU_ISSET(cpu, &(tcb)->affinity) && \
+      (!sched_cpu_isolated(cpu) || \
+       ((tcb)->affinity & ~CONFIG_SMP_ISOLATED_CPUS) == 0))
+#endif
+
 /* These are macros to access the current CPU and the current task on a CPU.
  * These macros are intended to support a future SMP implementation.
  * NOTE: this_task() for SMP is implemented in sched_thistask.c if the CPU
@@ -96,6 +128,15 @@
 #define running_task() \
   (up_interrupt_context() ? g_running_tasks[this_cpu()] : this_task())
 
+/* TCBs are allocated from a pool if CONFIG_PREALLOC_TCBS > 0 */
+
+#if defined(CONFIG_MM_OBJPOOL) && CONFIG_PREALLOC_TCBS > 0
+#  define HAVE_TCBPOOL 1
+#else
+#  define sched_tcballoc(s)      kmm_zalloc(s)
+#  define sched_tcbfree(t)       sched_kfree(t)
+#endif
+
 /* List attribute flags */
 
 #define TLIST_ATTR_PRIORITIZED   (1 << 0) /* Bit 0: List is prioritized */
@@ -113,12 +154,20 @@
 #ifdef CONFIG_SMP
 #  define TLIST_HEAD(s,c) \
   ((TLIST_ISINDEXED(s)) ? __TLIST_HEADINDEXED(s,c) : __TLIST_HEAD(s))
-#  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
 #else
 #  define TLIST_HEAD(s)          __TLIST_HEAD(s)
-#  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
 #endif
 
+/* Tasks waiting for a semaphore are not kept in a global list but in the
+ * wait list of the semaphore itself (tcb->waitsem must be valid).  The
+ * blocked list of a task must therefore be selected from its TCB.
+ */
+
+#define TLIST_WAITSEM(t)         ((FAR dq_queue_t *)&(t)->waitsem->waitlist)
+#define TLIST_BLOCKED(t) \
+  (((t)->task_state == TSTATE_WAIT_SEM) ? TLIST_WAITSEM(t) : \
+   __TLIST_HEAD((t)->task_state))
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -163,8 +212,8 @@ struct tasklist_s
  * and by a series of task lists.  All of these tasks lists are declared
  * below. Although it is not always necessary, most of these lists are
  * prioritized so that common list handling logic can be used (only the
- * g_readytorun, the g_pendingtasks, and the g_waitingforsemaphore lists
- * need to be prioritized).
+ * g_readytorun, the g_pendingtasks, and the semaphore wait lists need to
+ * be prioritized).
  */
 
 /* This is the list of all tasks that are ready to run.  This is a
@@ -205,6 +254,10 @@ extern volatile dq_queue_t g_readytorun;
  * CPU.  Tasks after the active task are ready-to-run and assigned to this
  * CPU. The tail of this assigned task list, the lowest priority task, is
  * always the CPU's IDLE task.
+ *
+ * If CONFIG_SMP_PERCPU_READYTORUN is selected, the assigned task lists also
+ * hold unlocked tasks that are merely queued on a CPU.  Such tasks may be
+ * stolen by another CPU in their affinity set (see sched_removereadytorun()).
  */
 
 extern volatile dq_queue_t g_assignedtasks[CONFIG_SMP_NCPUS];
@@ -229,10 +282,6 @@ extern FAR struct tcb_s *g_running_tasks[1];
 
 extern volatile dq_queue_t g_pendingtasks;
 
-/* This is the list of all tasks that are blocked waiting for a semaphore */
-
-extern volatile dq_queue_t g_waitingforsemaphore;
-
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 #ifndef CONFIG_DISABLE_SIGNALS
@@ -458,6 +507,29 @@ uint32_t sched_sporadic_process(FAR struct tcb_s *tcb, uint32_t ticks,
 void sched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  sched_deadline_start(FAR struct tcb_s *tcb,
+                          FAR const struct sched_param *param);
+void sched_deadline_stop(FAR struct tcb_s *tcb);
+void sched_deadline_wakeup(FAR struct tcb_s *tcb);
+void sched_deadline_replenish(FAR struct tcb_s *tcb);
+uint32_t sched_deadline_process(FAR struct tcb_s *tcb, uint32_t ticks,
+                                bool noswitches);
+
+/* True if the deadline thread 'a' must be run before the deadline thread
+ * 'b' of the same priority.  A thread with pre-emption disabled is never
+ * overtaken.
+ */
+
+#  define sched_deadline_before(a,b) \
+     (((a)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      ((b)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      (b)->lockcount == 0 && \
+      (sclock_t)((a)->deadline.absdeadline - (b)->deadline.absdeadline) < 0)
+#else
+#  define sched_deadline_before(a,b) (false)
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void sched_suspend(FAR struct tcb_s *tcb);
 void sched_continue(FAR struct tcb_s *tcb);
@@ -469,6 +541,7 @@ FAR struct tcb_s *this_task(void);
 #endif
 
 int  sched_cpu_select(cpu_set_t affinity);
+int  sched_cpu_housekeeping(int n);
 int  sched_cpu_pause(FAR struct tcb_s *tcb);
 
 irqstate_t sched_tasklist_lock(void);
@@ -486,6 +559,7 @@ void sched_tasklist_unlock(irqstate_t lock);
 
 #else
 #  define sched_cpu_select(a)     (0)
+#  define sched_cpu_housekeeping(n) (0)
 #  define sched_cpu_pause(t)      (-38)  /* -ENOSYS */
 #  define sched_islocked_tcb(tcb) ((tcb)->lockcount > 0)
 #endif
@@ -496,6 +570,25 @@ void sched_tasklist_unlock(irqstate_t lock);
 void weak_function sched_process_cpuload(void);
 #endif
 
+#if defined(CONFIG_SCHED_CPULOAD) && defined(CONFIG_SCHED_CPUTIME)
+void sched_cpuload_charge(FAR struct tcb_s *tcb, uint32_t count);
+#endif
+
+/* CPU time accounting */
+
+#ifdef CONFIG_SCHED_CPUTIME
+void sched_cputime_suspend(FAR struct tcb_s *tcb);
+void sched_cputime_resume(FAR struct tcb_s *tcb);
+void sched_cputime_tick(void);
+uint64_t sched_cputime(FAR struct tcb_s *tcb);
+#endif
+
+/* Stack usage sampler */
+
+#ifdef CONFIG_STACK_MONITOR
+void sched_stackmon_start(void);
+#endif
+
 /* Critical section monitor */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
@@ -510,4 +603,10 @@ void sched_critmon_suspend(FAR struct tcb_s *tcb);
 bool sched_verifytcb(FAR struct tcb_s *tcb);
 int  sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype);
 
+#ifdef HAVE_TCBPOOL
+void sched_tcbpool_initialize(void);
+FAR void *sched_tcballoc(size_t size);
+void sched_tcbfree(FAR struct tcb_s *tcb);
+#endif
+
 #endif /* __SCHED_SCHED_SCHED_H */
@@ -83,9 +83,12 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state)
   irqstate_t lock = sched_tasklist_lock();
 #endif
 
-  /* Add the TCB to the blocked task list associated with this state. */
+  /* Add the TCB to the blocked task list associated with this state.  The
+   * state must be set first:  It selects the list.
+   */
 
-  tasklist = TLIST_BLOCKED(task_state);
+  btcb->task_state = task_state;
+  tasklist = TLIST_BLOCKED(btcb);
 
   /* Determine if the task is to be added to a prioritized task list. */
 
@@ -107,8 +110,4 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state)
 
   sched_tasklist_unlock(lock);
 #endif
-
-  /* Make sure the TCB's state corresponds to the list */
-
-  btcb->task_state = task_state;
 }
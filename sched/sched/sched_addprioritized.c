@@ -44,6 +44,8 @@
 #include <queue.h>
 #include <assert.h>
 
+#include <nuttx/clock.h>
+
 #include "sched/sched.h"
 
 /****************************************************************************
@@ -89,10 +91,14 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
+   * Deadline threads of the same priority are kept in order of increasing
+   * absolute deadline (EDF).
    */
 
   for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
+       (next && (sched_priority < next->sched_priority ||
+                 (sched_priority == next->sched_priority &&
+                  !sched_deadline_before(tcb, next))));
        next = next->flink);
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
@@ -85,6 +85,12 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Assign a new deadline if the thread cannot meet the current one */
+
+  sched_deadline_wakeup(btcb);
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
@@ -170,6 +176,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
   FAR dq_queue_t *tasklist;
   bool switched;
   bool doswitch;
+  bool dopause;
   int task_state;
   int cpu;
   int me;
@@ -178,6 +185,12 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
 
   irqstate_t lock = sched_tasklist_lock();
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Assign a new deadline if the thread cannot meet the current one */
+
+  sched_deadline_wakeup(btcb);
+#endif
+
   /* Check if the blocked TCB is locked to this CPU */
 
   if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
@@ -219,6 +232,18 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
       cpu = btcb->cpu;
     }
 
+#ifdef CONFIG_SMP_PERCPU_READYTORUN
+  /* Otherwise, it will be ready-to-run, but not yet running.  Queue it in
+   * the assigned task list of the selected CPU, behind the running task.
+   * That CPU or any other CPU in the affinity set will pick it up later.
+   */
+
+  else
+    {
+      task_state = TSTATE_TASK_ASSIGNED;
+    }
+
+#else
   /* Otherwise, it will be ready-to-run, but not not yet running */
 
   else
@@ -226,6 +251,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
       task_state = TSTATE_TASK_READYTORUN;
       cpu = 0;  /* CPU does not matter */
     }
+#endif
 
   /* If the selected state is TSTATE_TASK_RUNNING, then we would like to
    * start running the task.  Be we cannot do that if pre-emption is
@@ -270,10 +296,18 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
   else /* (task_state == TSTATE_TASK_ASSIGNED || task_state == TSTATE_TASK_RUNNING) */
     {
       /* If we are modifying some assigned task list other than our own, we
-       * will need to stop that CPU.
+       * will need to stop that CPU.  That is not necessary if we will not
+       * modify the head of the list:  The list itself is protected by the
+       * tasklist lock and the other CPU only needs the head of the list.
        */
 
-      if (cpu != me)
+#ifdef CONFIG_SMP_PERCPU_READYTORUN
+      dopause = (cpu != me && task_state == TSTATE_TASK_RUNNING);
+#else
+      dopause = (cpu != me);
+#endif
+
+      if (dopause)
         {
           sched_tasklist_unlock(lock);
           DEBUGVERIFY(up_cpu_pause(cpu));
@@ -378,6 +412,17 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
               DEBUGASSERT(next->cpu == cpu);
               next->task_state = TSTATE_TASK_ASSIGNED;
             }
+#ifdef CONFIG_SMP_PERCPU_READYTORUN
+          else if (!sched_islocked_global())
+            {
+              /* With per-CPU ready-to-run queues, the pre-empted task
+               * simply remains queued in this CPU's assigned task list.
+               */
+
+              DEBUGASSERT(next->cpu == cpu);
+              next->task_state = TSTATE_TASK_ASSIGNED;
+            }
+#endif
           else
             {
               /* Remove the task from the assigned task list */
@@ -421,13 +466,18 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
 
           btcb->cpu        = cpu;
           btcb->task_state = TSTATE_TASK_ASSIGNED;
+          doswitch         = false;
         }
 
       /* All done, restart the other CPU (if it was paused). */
 
       if (cpu != me)
         {
-          DEBUGVERIFY(up_cpu_resume(cpu));
+          if (dopause)
+            {
+              DEBUGVERIFY(up_cpu_resume(cpu));
+            }
+
           doswitch = false;
         }
     }
@@ -52,11 +52,14 @@
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
-/* Are we using the system timer, or an external clock?  Get the rate
- * of the sampling in ticks per second for the selected timer.
+/* Are we using the system timer, an external clock, or the CPU time
+ * accounting?  Get the rate of the sampling in ticks per second for the
+ * selected source.
  */
 
-#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+#if defined(CONFIG_SCHED_CPUTIME)
+#  define CPULOAD_TICKSPERSEC CPULOAD_CPUTIME_FREQ
+#elif defined(CONFIG_SCHED_CPULOAD_EXTCLK)
 #  ifndef CONFIG_SCHED_CPULOAD_TICKSPERSEC
 #    error CONFIG_SCHED_CPULOAD_TICKSPERSEC is not defined
 #  endif
@@ -122,6 +125,7 @@ volatile uint32_t g_cpuload_total;
  *
  ****************************************************************************/
 
+#ifndef CONFIG_SCHED_CPUTIME
 static inline void sched_cpu_process_cpuload(int cpu)
 {
   FAR struct tcb_s *rtcb  = current_task(cpu);
@@ -145,6 +149,7 @@ static inline void sched_cpu_process_cpuload(int cpu)
 
   g_cpuload_total++;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -175,20 +180,24 @@ void weak_function sched_process_cpuload(void)
 #ifdef CONFIG_SMP
   irqstate_t flags;
 
-  /* Perform scheduler operations on all CPUs. */
-
   flags = enter_critical_section();
+#endif
+
+#ifndef CONFIG_SCHED_CPUTIME
+  /* Perform scheduler operations on all CPUs.  With CONFIG_SCHED_CPUTIME,
+   * the counts are instead charged by sched_cpuload_charge() when the
+   * CPU time of the running thread is accounted.
+   */
+
+#ifdef CONFIG_SMP
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
       sched_cpu_process_cpuload(i);
     }
-
 #else
-  /* Perform scheduler operations on the single CPU. */
-
   sched_cpu_process_cpuload(0);
-
 #endif
+#endif /* CONFIG_SCHED_CPUTIME */
 
   /* If the accumulated tick value exceed a time constant, then shift the
    * accumulators and recalculate the total.
@@ -218,6 +227,32 @@ void weak_function sched_process_cpuload(void)
 #endif
 }
 
+/****************************************************************************
+ * Name: sched_cpuload_charge
+ *
+ * Description:
+ *   Charge CPU load counts measured by the CPU time accounting to a thread.
+ *
+ * Input Parameters:
+ *   tcb   - The thread that ran
+ *   count - The time that it ran in units of 1/CPULOAD_CPUTIME_FREQ seconds
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUTIME
+void sched_cpuload_charge(FAR struct tcb_s *tcb, uint32_t count)
+{
+  g_pidhash[PIDHASH(tcb->pid)].ticks += count;
+  g_cpuload_total                    += count;
+}
+#endif
+
 /****************************************************************************
  * Name:  clock_cpuload
  *
@@ -82,6 +82,15 @@ int sched_cpu_select(cpu_set_t affinity)
   int cpu;
   int i;
 
+  /* A task that may run on a housekeeping CPU is never placed on an
+   * isolated CPU.
+   */
+
+  if ((affinity & ~CONFIG_SMP_ISOLATED_CPUS) != 0)
+    {
+      affinity &= ~CONFIG_SMP_ISOLATED_CPUS;
+    }
+
   /* Otherwise, find the CPU that is executing the lowest priority task
    * (possibly its IDLE task).
    */
@@ -123,4 +132,39 @@ int sched_cpu_select(cpu_set_t affinity)
   return cpu;
 }
 
+/****************************************************************************
+ * Name:  sched_cpu_housekeeping
+ *
+ * Description:
+ *   Return the index of the n'th (modulo the number of such CPUs) CPU that
+ *   is not in CONFIG_SMP_ISOLATED_CPUS.  Used to spread threads that are
+ *   pinned at creation across the housekeeping CPUs.
+ *
+ ****************************************************************************/
+
+int sched_cpu_housekeeping(int n)
+{
+  int ncpus = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (!sched_cpu_isolated(i))
+        {
+          ncpus++;
+        }
+    }
+
+  n %= ncpus;
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (!sched_cpu_isolated(i) && n-- == 0)
+        {
+          break;
+        }
+    }
+
+  return i;
+}
+
 #endif /* CONFIG_SMP */
@@ -0,0 +1,226 @@
+/****************************************************************************
+ * sched/sched/sched_cputime.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_CPUTIME
+
+#ifndef CONFIG_HAVE_LONG_LONG
+#  error CONFIG_SCHED_CPUTIME requires 64-bit integer support
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define CPUTIME_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define CPUTIME_NCPUS 1
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The up_perf_gettime() value when the time of the running thread was last
+ * charged on each CPU.  Zero means that the CPU has not started accounting.
+ */
+
+static uint32_t g_cputime_start[CPUTIME_NCPUS];
+
+#ifdef CONFIG_SCHED_CPULOAD
+/* Counts not yet converted to CPU load units on each CPU.  Carrying them
+ * over keeps the total load exact.
+ */
+
+static uint32_t g_cputime_carry[CPUTIME_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cputime_charge
+ *
+ * Description:
+ *   Charge the time since the last charge on this CPU to the thread.
+ *
+ ****************************************************************************/
+
+static void sched_cputime_charge(int cpu, FAR struct tcb_s *tcb)
+{
+  uint32_t now = up_perf_gettime();
+  uint32_t elapsed;
+#ifdef CONFIG_SCHED_CPULOAD
+  uint32_t divisor;
+#endif
+
+  if (g_cputime_start[cpu] != 0)
+    {
+      elapsed       = now - g_cputime_start[cpu];
+      tcb->cputime += elapsed;
+
+#ifdef CONFIG_SCHED_CPULOAD
+      /* Convert to load units, carrying the remainder to the next charge */
+
+      divisor               = up_perf_getfreq() / CPULOAD_CPUTIME_FREQ;
+      elapsed              += g_cputime_carry[cpu];
+      g_cputime_carry[cpu]  = elapsed % divisor;
+      sched_cpuload_charge(tcb, elapsed / divisor);
+#endif
+    }
+
+  /* Avoid the zero value that means "not started" */
+
+  g_cputime_start[cpu] = now != 0 ? now : 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cputime_suspend
+ *
+ * Description:
+ *   Called when a thread is suspended to charge it with the time that it
+ *   has run.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void sched_cputime_suspend(FAR struct tcb_s *tcb)
+{
+  sched_cputime_charge(this_cpu(), tcb);
+}
+
+/****************************************************************************
+ * Name: sched_cputime_resume
+ *
+ * Description:
+ *   Called when a thread is resumed.  The time since the last suspension is
+ *   charged to the next thread that is suspended, so this only starts the
+ *   accounting the first time that a thread runs on the CPU.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void sched_cputime_resume(FAR struct tcb_s *tcb)
+{
+  int cpu = this_cpu();
+
+  if (g_cputime_start[cpu] == 0)
+    {
+      uint32_t now = up_perf_gettime();
+      g_cputime_start[cpu] = now != 0 ? now : 1;
+    }
+}
+
+/****************************************************************************
+ * Name: sched_cputime_tick
+ *
+ * Description:
+ *   Called from the system timer interrupt to charge the running thread
+ *   before the 32-bit counter can wrap.
+ *
+ * Assumptions:
+ *   Called from the timer interrupt handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_cputime_tick(void)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags = enter_critical_section();
+#endif
+  int cpu = this_cpu();
+
+  sched_cputime_charge(cpu, current_task(cpu));
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+}
+
+/****************************************************************************
+ * Name: sched_cputime
+ *
+ * Description:
+ *   Return the CPU time of a thread in up_perf_gettime() units.  The time
+ *   that the calling thread has run since it was last charged is included.
+ *   That of a thread that is running on another CPU is not.
+ *
+ ****************************************************************************/
+
+uint64_t sched_cputime(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+  uint64_t cputime;
+  int cpu;
+
+  flags   = enter_critical_section();
+  cpu     = this_cpu();
+  cputime = tcb->cputime;
+
+  if (tcb == current_task(cpu) && g_cputime_start[cpu] != 0)
+    {
+      cputime += up_perf_gettime() - g_cputime_start[cpu];
+    }
+
+  leave_critical_section(flags);
+  return cputime;
+}
+
+#endif /* CONFIG_SCHED_CPUTIME */
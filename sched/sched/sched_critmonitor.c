@@ -74,6 +74,99 @@ uint32_t g_premp_max[1];
 uint32_t g_crit_max[1];
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+/* Call sites that kept pre-emption disabled or held the critical section */
+
+#ifdef CONFIG_SMP_NCPUS
+struct critmon_hotspots_s g_premp_hotspots[CONFIG_SMP_NCPUS];
+struct critmon_hotspots_s g_crit_hotspots[CONFIG_SMP_NCPUS];
+#else
+struct critmon_hotspots_s g_premp_hotspots[1];
+struct critmon_hotspots_s g_crit_hotspots[1];
+#endif
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_critmon_update
+ *
+ * Description:
+ *   Account one holding by a call site in a hot spot table.  If the call
+ *   site is not yet in the table, it replaces the entry with the shortest
+ *   maximum time (longest != 0) or the smallest count.  Unused entries have
+ *   a zero maximum and count and are replaced first.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+static void sched_critmon_update(FAR struct critmon_hotspot_s *table,
+                                 FAR void *caller, uint32_t elapsed,
+                                 bool longest)
+{
+  FAR struct critmon_hotspot_s *victim = &table[0];
+  FAR struct critmon_hotspot_s *entry;
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_NHOTSPOTS; i++)
+    {
+      entry = &table[i];
+      if (entry->caller == caller && (entry->count > 0 || entry->max > 0))
+        {
+          entry->count++;
+          if (elapsed > entry->max)
+            {
+              entry->max = elapsed;
+            }
+
+          return;
+        }
+
+      if (longest ? entry->max < victim->max : entry->count < victim->count)
+        {
+          victim = entry;
+        }
+    }
+
+  if (longest)
+    {
+      /* Only replace a shorter holder */
+
+      if (elapsed > victim->max)
+        {
+          victim->caller = caller;
+          victim->count  = 1;
+          victim->max    = elapsed;
+        }
+    }
+  else
+    {
+      /* Space-Saving:  The new call site inherits the evicted count */
+
+      victim->caller = caller;
+      victim->count++;
+      victim->max    = elapsed;
+    }
+}
+
+/****************************************************************************
+ * Name: sched_critmon_hotspot
+ *
+ * Description:
+ *   Account one holding by a call site for the current CPU.
+ *
+ ****************************************************************************/
+
+static void sched_critmon_hotspot(FAR struct critmon_hotspots_s *hotspots,
+                                  FAR void *caller, uint32_t elapsed)
+{
+  sched_critmon_update(hotspots->longest, caller, elapsed, true);
+  sched_critmon_update(hotspots->frequent, caller, elapsed, false);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -128,6 +221,11 @@ void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
           tcb->premp_max = elapsed;
         }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+      sched_critmon_hotspot(&g_premp_hotspots[cpu], tcb->premp_caller,
+                            elapsed);
+#endif
+
       /* Check for the global max elapsed time */
 
       if (g_premp_start[cpu] != 0)
@@ -192,6 +290,11 @@ void sched_critmon_csection(FAR struct tcb_s *tcb, bool state)
           tcb->crit_max = elapsed;
         }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+      sched_critmon_hotspot(&g_crit_hotspots[cpu], tcb->crit_caller,
+                            elapsed);
+#endif
+
       /* Check for the global max elapsed time */
 
       if (g_crit_start[cpu] != 0)
@@ -300,6 +403,9 @@ void sched_critmon_resume(FAR struct tcb_s *tcb)
 void sched_critmon_suspend(FAR struct tcb_s *tcb)
 {
   uint32_t elapsed;
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+  int cpu = this_cpu();
+#endif
 
   /* Did this task disable preemption? */
 
@@ -314,6 +420,11 @@ void sched_critmon_suspend(FAR struct tcb_s *tcb)
         {
           tcb->premp_max = elapsed;
         }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+      sched_critmon_hotspot(&g_premp_hotspots[cpu], tcb->premp_caller,
+                            elapsed);
+#endif
     }
 
   /* Is this task in a critical section? */
@@ -329,6 +440,11 @@ void sched_critmon_suspend(FAR struct tcb_s *tcb)
         {
           tcb->crit_max = elapsed;
         }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+      sched_critmon_hotspot(&g_crit_hotspots[cpu], tcb->crit_caller,
+                            elapsed);
+#endif
     }
 }
 
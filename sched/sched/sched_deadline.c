@@ -0,0 +1,344 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+
+#include "clock/clock.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifdef CONFIG_SMP
+#  define DEADLINE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define DEADLINE_NCPUS 1
+#endif
+
+/* Densities are in parts per million of one CPU */
+
+#define DEADLINE_DENSITY_ONE  1000000
+#define DEADLINE_DENSITY_MAX \
+  ((uint32_t)CONFIG_SCHED_DEADLINE_MAXUTIL * 10000 * DEADLINE_NCPUS)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The sum of the densities of all deadline threads.  Protected by the
+ * critical section.
+ */
+
+static uint32_t g_deadline_density;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_ticks
+ *
+ * Description:
+ *   Convert a deadline parameter to clock ticks in the range 0..INT32_MAX.
+ *
+ ****************************************************************************/
+
+static int32_t deadline_ticks(FAR const struct timespec *ts)
+{
+  sclock_t ticks;
+
+  (void)clock_time2ticks(ts, &ticks);
+  if (ticks < 0)
+    {
+      return 0;
+    }
+
+  return ticks > INT32_MAX ? INT32_MAX : (int32_t)ticks;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_deadline_start
+ *
+ * Description:
+ *   Validate the SCHED_DEADLINE parameters of a thread and perform the
+ *   admission control.  On success, the thread starts a new period with a
+ *   full budget.  The thread may already use SCHED_DEADLINE; its old
+ *   parameters are then replaced.
+ *
+ * Input Parameters:
+ *   tcb   - The TCB of the thread
+ *   param - The new scheduling parameters
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure:
+ *
+ *   -EINVAL - The parameters are invalid.  0 < runtime <= deadline <=
+ *             period is required.  A zero deadline means the period.
+ *   -EBUSY  - The thread would over-subscribe the CPU(s)
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+int sched_deadline_start(FAR struct tcb_s *tcb,
+                         FAR const struct sched_param *param)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+  uint32_t olddensity = 0;
+  uint32_t density;
+  int32_t runtime;
+  int32_t reldeadline;
+  int32_t period;
+
+  runtime     = deadline_ticks(&param->sched_dl_runtime);
+  reldeadline = deadline_ticks(&param->sched_dl_deadline);
+  period      = deadline_ticks(&param->sched_dl_period);
+
+  if (reldeadline == 0)
+    {
+      reldeadline = period;
+    }
+
+  if (runtime < 1 || reldeadline < runtime || period < reldeadline)
+    {
+      return -EINVAL;
+    }
+
+  /* The density of a thread is runtime / min(deadline, period).  If the
+   * sum over all deadline threads does not exceed one CPU, EDF meets all
+   * deadlines.
+   */
+
+  density = (uint32_t)(((uint64_t)runtime * DEADLINE_DENSITY_ONE) /
+                       reldeadline);
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      olddensity = dl->density;
+    }
+
+  if (g_deadline_density - olddensity + density > DEADLINE_DENSITY_MAX)
+    {
+      return -EBUSY;
+    }
+
+  g_deadline_density = g_deadline_density - olddensity + density;
+
+  dl->runtime     = runtime;
+  dl->reldeadline = reldeadline;
+  dl->period      = period;
+  dl->density     = density;
+  dl->absdeadline = clock_systimer() + reldeadline;
+  tcb->timeslice  = runtime;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sched_deadline_stop
+ *
+ * Description:
+ *   The thread no longer uses SCHED_DEADLINE (it changes its policy or it
+ *   exits).  Release its bandwidth.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void sched_deadline_stop(FAR struct tcb_s *tcb)
+{
+  DEBUGASSERT(g_deadline_density >= tcb->deadline.density);
+
+  g_deadline_density   -= tcb->deadline.density;
+  tcb->deadline.density = 0;
+}
+
+/****************************************************************************
+ * Name: sched_deadline_wakeup
+ *
+ * Description:
+ *   Called when a thread is added to the ready-to-run list.  If a deadline
+ *   thread could not use its remaining budget before its deadline without
+ *   exceeding its bandwidth, it starts a new period with a full budget and
+ *   a new deadline (constant bandwidth server wakeup rule).  This keeps a
+ *   thread that slept from claiming more than its share.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_deadline_wakeup(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+  sclock_t laxity;
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) != TCB_FLAG_SCHED_DEADLINE)
+    {
+      return;
+    }
+
+  /* Renew if the deadline has passed or if
+   *
+   *   budget / (deadline - now) > runtime / reldeadline
+   */
+
+  laxity = (sclock_t)(dl->absdeadline - clock_systimer());
+  if (laxity <= 0 ||
+      (int64_t)tcb->timeslice * dl->reldeadline >
+      (int64_t)laxity * dl->runtime)
+    {
+      dl->absdeadline = clock_systimer() + dl->reldeadline;
+      tcb->timeslice  = dl->runtime;
+    }
+}
+
+/****************************************************************************
+ * Name: sched_deadline_replenish
+ *
+ * Description:
+ *   The running deadline thread has used up the budget of its period.
+ *   Postpone its deadline by one period, replenish the budget and move it
+ *   behind the deadline threads of the same priority with earlier
+ *   deadlines.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the running thread
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_deadline_replenish(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+
+  dl->absdeadline += dl->period;
+  tcb->timeslice   = dl->runtime;
+
+  /* Re-insert the thread into the ready-to-run list at its current
+   * priority.  That sorts it by its new deadline.
+   */
+
+  if (tcb->flink != NULL &&
+      tcb->flink->sched_priority >= tcb->sched_priority)
+    {
+      up_reprioritize_rtr(tcb, tcb->sched_priority);
+    }
+}
+
+/****************************************************************************
+ * Name: sched_deadline_process
+ *
+ * Description:
+ *   Process the elapsed time interval for the running deadline thread.
+ *   Called from the timer interrupt handler.
+ *
+ * Input Parameters:
+ *   tcb        - The TCB of the thread that is running
+ *   ticks      - The number of ticks that have elapsed
+ *   noswitches - True: Can't do context switches now
+ *
+ * Returned Value:
+ *   The number of ticks remaining in the budget.  The value one is returned
+ *   if the budget is used up but the context switch had to be deferred.
+ *
+ ****************************************************************************/
+
+uint32_t sched_deadline_process(FAR struct tcb_s *tcb, uint32_t ticks,
+                                bool noswitches)
+{
+  DEBUGASSERT(tcb != NULL);
+
+  /* Decrement the budget.  As with round robin, any excess of ticks over
+   * the remaining budget is ignored.
+   */
+
+  tcb->timeslice -= MIN(tcb->timeslice, (int32_t)ticks);
+  if (tcb->timeslice <= 0 && !sched_islocked_tcb(tcb))
+    {
+      /* If the context switch cannot be performed now, then return one so
+       * that the timer expires again as soon as possible.  If pre-emption
+       * is disabled, sched_unlock() replenishes the budget.
+       */
+
+      if (noswitches)
+        {
+          return 1;
+        }
+
+      sched_deadline_replenish(tcb);
+    }
+
+  return tcb->timeslice;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
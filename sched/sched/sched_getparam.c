@@ -149,6 +149,31 @@ int nxsched_getparam (pid_t pid, FAR struct sched_param *param)
               param->sched_ss_init_budget.tv_nsec = 0;
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+            {
+              FAR struct deadline_s *dl = &tcb->deadline;
+
+              /* Return parameters associated with SCHED_DEADLINE */
+
+              clock_ticks2time((sclock_t)dl->runtime,
+                               &param->sched_dl_runtime);
+              clock_ticks2time((sclock_t)dl->reldeadline,
+                               &param->sched_dl_deadline);
+              clock_ticks2time((sclock_t)dl->period,
+                               &param->sched_dl_period);
+            }
+          else
+            {
+              param->sched_dl_runtime.tv_sec   = 0;
+              param->sched_dl_runtime.tv_nsec  = 0;
+              param->sched_dl_deadline.tv_sec  = 0;
+              param->sched_dl_deadline.tv_nsec = 0;
+              param->sched_dl_period.tv_sec    = 0;
+              param->sched_dl_period.tv_nsec   = 0;
+            }
+#endif
         }
 
       sched_unlock();
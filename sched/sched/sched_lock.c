@@ -258,6 +258,9 @@ int sched_lock(void)
         {
           /* Note that we have pre-emption locked */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+          rtcb->premp_caller = return_address();
+#endif
 #ifdef CONFIG_SCHED_CRITMONITOR
           sched_critmon_preemption(rtcb, true);
 #endif
@@ -313,6 +316,9 @@ int sched_lock(void)
         {
           /* Note that we have pre-emption locked */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HOTSPOTS
+          rtcb->premp_caller = return_address();
+#endif
 #ifdef CONFIG_SCHED_CRITMONITOR
           sched_critmon_preemption(rtcb, true);
 #endif
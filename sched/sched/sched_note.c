@@ -45,6 +45,7 @@
 #include <errno.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
@@ -82,21 +83,65 @@ struct note_startalloc_s
 #  define SIZEOF_NOTE_START(n) (sizeof(struct note_start_s))
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+struct note_stringalloc_s
+{
+  struct note_common_s nst_cmn; /* Common note parameters */
+  uint8_t nst_category;         /* User category (0-31) */
+  char nst_data[CONFIG_SCHED_NOTE_DUMP_MAXLEN];
+};
+
+struct note_printfalloc_s
+{
+  struct note_common_s npt_cmn; /* Common note parameters */
+  uint8_t npt_category;         /* User category (0-31) */
+  uint8_t npt_fmtlen;           /* Length of the format string */
+  uint8_t npt_data[CONFIG_SCHED_NOTE_DUMP_MAXLEN];
+};
+
+#  define SIZEOF_NOTE_STRING(n) (sizeof(struct note_string_s) + (n) - 1)
+#  define SIZEOF_NOTE_PRINTF(n) (sizeof(struct note_printf_s) + (n) - 1)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
 static void note_add(FAR const uint8_t *note, uint8_t notelen);
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+/* Mask of user note categories that are being recorded */
+
+volatile uint32_t g_note_categories = CONFIG_SCHED_NOTE_CATEGORIES;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+/* With per-CPU buffers, each CPU is the only producer for its own buffer
+ * and the reader is the only consumer.  The head is only changed by the
+ * producer and the tail only by the consumer so the note hooks need no
+ * lock.  The spinlock only serializes concurrent readers.
+ */
+
+static struct note_info_s g_note_info[CONFIG_SMP_NCPUS];
+#ifdef CONFIG_SCHED_NOTE_GET
+static volatile spinlock_t g_note_rdlock;
+static unsigned int g_note_rdcpu;
+#endif
+#else
 static struct note_info_s g_note_info;
 
 #ifdef CONFIG_SMP
 static volatile spinlock_t g_note_lock;
 #endif
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -148,7 +193,11 @@ static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
 static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
+#ifdef CONFIG_SCHED_NOTE_ARCH_TIME
+  uint32_t systime    = up_note_gettime();
+#else
   uint32_t systime    = (uint32_t)clock_systimer();
+#endif
 
   /* Save all of the common fields */
 
@@ -209,18 +258,19 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
  *   Length of data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   Length of data currently in circular buffer.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
-static unsigned int note_length(void)
+#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS) || \
+    defined(CONFIG_SCHED_NOTE_PERCPU)
+static unsigned int note_length(FAR struct note_info_s *info)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
+  unsigned int head = info->ni_head;
+  unsigned int tail = info->ni_tail;
 
   if (tail > head)
     {
@@ -238,17 +288,19 @@ static unsigned int note_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   We are within a critical section (or, with per-CPU buffers, we are the
+ *   only reader).
  *
  ****************************************************************************/
 
-static void note_remove(void)
+#if !defined(CONFIG_SCHED_NOTE_PERCPU) || defined(CONFIG_SCHED_NOTE_GET)
+static void note_remove(FAR struct note_info_s *info)
 {
   FAR struct note_common_s *note;
   unsigned int tail;
@@ -256,27 +308,32 @@ static void note_remove(void)
 
   /* Get the tail index of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note   = (FAR struct note_common_s *)&info->ni_buffer[tail];
   length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+  DEBUGASSERT(length <= note_length(info));
 
   /* Increment the tail index to remove the entire note from the circular
    * buffer.
    */
 
-  g_note_info.ni_tail = note_next(tail, length);
+  info->ni_tail = note_next(tail, length);
 }
+#endif
 
 /****************************************************************************
  * Name: note_add
  *
  * Description:
- *   Add the variable length note to the head of the circular buffer
+ *   Add the variable length note to the head of the circular buffer.
+ *
+ *   With per-CPU buffers, the note is added to this CPU's buffer.  If there
+ *   is not room for the note, the note is dropped rather than overwriting
+ *   older notes:  Only the reader may move the tail.
  *
  * Input Parameters:
  *   None
@@ -285,10 +342,66 @@ static void note_remove(void)
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   We are within a critical section (except with per-CPU buffers).
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+static void note_add(FAR const uint8_t *note, uint8_t notelen)
+{
+  FAR struct note_info_s *info;
+  irqstate_t flags;
+  unsigned int head;
+  unsigned int first;
+  int cpu;
+
+  /* Disabling local interrupts is sufficient to keep notes from interrupt
+   * handlers on this CPU from being interleaved with this note.
+   */
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+
+  /* Ignore notes that are not in the set of monitored CPUs */
+
+  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << cpu)) == 0)
+    {
+      up_irq_restore(flags);
+      return;
+    }
+
+  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
+  info = &g_note_info[cpu];
+
+  /* Is there room for the note?  One byte is always left unused so that a
+   * full buffer can be distinguished from an empty buffer.
+   */
+
+  if (notelen > CONFIG_SCHED_NOTE_BUFSIZE - 1 - note_length(info))
+    {
+      up_irq_restore(flags);
+      return;
+    }
+
+  /* Copy the note into the buffer, in two pieces if it wraps */
+
+  head  = info->ni_head;
+  first = CONFIG_SCHED_NOTE_BUFSIZE - head;
+  if (first > notelen)
+    {
+      first = notelen;
+    }
+
+  memcpy(&info->ni_buffer[head], note, first);
+  memcpy(info->ni_buffer, note + first, notelen - first);
+
+  /* The note must be visible to the reader before the new head is */
+
+  SP_DMB();
+  info->ni_head = note_next(head, notelen);
+  up_irq_restore(flags);
+}
+#else
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
   unsigned int head;
@@ -328,7 +441,7 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
         {
           /* Yes, then remove the note at the tail index */
 
-          note_remove();
+          note_remove(&g_note_info);
         }
 
       /* Save the next byte at the head index */
@@ -346,6 +459,231 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
   up_irq_restore(flags);
 #endif
 }
+#endif
+
+/****************************************************************************
+ * Name: note_dumpstring
+ *
+ * Description:
+ *   Common logic for NOTE_DUMP_STRING, NOTE_DUMP_BEGIN, and NOTE_DUMP_END
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+static void note_dumpstring(uint8_t type, uint8_t category,
+                            FAR const char *str)
+{
+  struct note_stringalloc_s note;
+  unsigned int length;
+  size_t len;
+
+  DEBUGASSERT(category < 32 && str != NULL);
+
+  if (!sched_note_enabled(category))
+    {
+      return;
+    }
+
+  /* Copy the string, truncating it if necessary */
+
+  len = strlen(str);
+  if (len >= CONFIG_SCHED_NOTE_DUMP_MAXLEN)
+    {
+      len = CONFIG_SCHED_NOTE_DUMP_MAXLEN - 1;
+    }
+
+  memcpy(note.nst_data, str, len);
+  note.nst_data[len] = '\0';
+  length = SIZEOF_NOTE_STRING(len + 1);
+
+  /* Finish formatting the note */
+
+  note_common(this_task(), &note.nst_cmn, length, type);
+  note.nst_category = category;
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, length);
+}
+#endif
+
+/****************************************************************************
+ * Name: note_pack
+ *
+ * Description:
+ *   Append 'size' bytes of 'value' to the packed printf arguments in little
+ *   endian order.  Returns false if there is no room.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+static bool note_pack(FAR uint8_t *data, FAR unsigned int *pos,
+                      uint64_t value, unsigned int size)
+{
+  unsigned int ndx = *pos;
+
+  if (ndx + size > CONFIG_SCHED_NOTE_DUMP_MAXLEN)
+    {
+      return false;
+    }
+
+  for (; size > 0; size--)
+    {
+      data[ndx++] = (uint8_t)(value & 0xff);
+      value >>= 8;
+    }
+
+  *pos = ndx;
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: note_rdlock and note_rdunlock
+ *
+ * Description:
+ *   Serialize readers of the circular buffer(s).  With per-CPU buffers this
+ *   does not exclude the note hooks, which never take this lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static inline irqstate_t note_rdlock(void)
+{
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  irqstate_t flags = up_irq_save();
+  spin_lock_wo_note(&g_note_rdlock);
+  return flags;
+#else
+  return enter_critical_section();
+#endif
+}
+
+static inline void note_rdunlock(irqstate_t flags)
+{
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  spin_unlock_wo_note(&g_note_rdlock);
+  up_irq_restore(flags);
+#else
+  leave_critical_section(flags);
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: note_size
+ *
+ * Description:
+ *   Return the size of the note at the tail of a circular buffer.
+ *
+ * Input Parameters:
+ *   info - The circular buffer
+ *
+ * Returned Value:
+ *   Zero if the circular buffer is empty; otherwise the size of the note.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static ssize_t note_size(FAR struct note_info_s *info)
+{
+  FAR struct note_common_s *note;
+  unsigned int tail;
+  ssize_t notelen;
+  size_t circlen;
+
+  /* Verify that the circular buffer is not empty */
+
+  circlen = note_length(info);
+  if (circlen <= 0)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  /* Read the head before reading the note that it covers */
+
+  SP_DMB();
+#endif
+
+  /* Get the index to the tail of the circular buffer */
+
+  tail    = info->ni_tail;
+  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+
+  /* Get the length of the note at the tail index */
+
+  note    = (FAR struct note_common_s *)&info->ni_buffer[tail];
+  notelen = note->nc_length;
+  DEBUGASSERT(notelen <= circlen);
+
+  return notelen;
+}
+#endif
+
+/****************************************************************************
+ * Name: note_getone
+ *
+ * Description:
+ *   Remove the note at the tail of a circular buffer and copy it to the
+ *   user buffer.
+ *
+ * Input Parameters:
+ *   info   - The circular buffer
+ *   buffer - Location to return the next note
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   As for sched_note_get()
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static ssize_t note_getone(FAR struct note_info_s *info,
+                           FAR uint8_t *buffer, size_t buflen)
+{
+  unsigned int tail;
+  unsigned int first;
+  ssize_t notelen;
+
+  notelen = note_size(info);
+  if (notelen <= 0)
+    {
+      return 0;
+    }
+
+  /* Is the user buffer large enough to hold the note? */
+
+  if (buflen < notelen)
+    {
+      /* Remove the large note so that we do not get constipated. */
+
+      note_remove(info);
+      return -EFBIG;
+    }
+
+  /* Copy the note to the user buffer, in two pieces if it wraps */
+
+  tail  = info->ni_tail;
+  first = CONFIG_SCHED_NOTE_BUFSIZE - tail;
+  if (first > notelen)
+    {
+      first = notelen;
+    }
+
+  memcpy(buffer, &info->ni_buffer[tail], first);
+  memcpy(buffer + first, info->ni_buffer, notelen - first);
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  /* Finish reading the note before releasing its space to the producer */
+
+  SP_DMB();
+#endif
+
+  info->ni_tail = note_next(tail, notelen);
+  return notelen;
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -588,6 +926,330 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 }
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+void sched_note_string(uint8_t category, FAR const char *str)
+{
+  note_dumpstring(NOTE_DUMP_STRING, category, str);
+}
+
+void sched_note_begin(uint8_t category, FAR const char *name)
+{
+  note_dumpstring(NOTE_DUMP_BEGIN, category, name);
+}
+
+void sched_note_end(uint8_t category, FAR const char *name)
+{
+  note_dumpstring(NOTE_DUMP_END, category, name);
+}
+
+void sched_note_vprintf(uint8_t category, FAR const char *fmt, va_list ap)
+{
+  struct note_printfalloc_s note;
+  FAR uint8_t *data = note.npt_data;
+  FAR const char *ptr;
+  unsigned int length;
+  unsigned int pos;
+  size_t fmtlen;
+  bool ok = true;
+  int lng;
+
+  DEBUGASSERT(category < 32 && fmt != NULL);
+
+  if (!sched_note_enabled(category))
+    {
+      return;
+    }
+
+  /* Copy the format string.  It will be interpreted on the host. */
+
+  fmtlen = strlen(fmt);
+  if (fmtlen > CONFIG_SCHED_NOTE_DUMP_MAXLEN)
+    {
+      fmtlen = CONFIG_SCHED_NOTE_DUMP_MAXLEN;
+    }
+
+  memcpy(data, fmt, fmtlen);
+  pos = fmtlen;
+
+  /* Then pack the arguments as described for struct note_printf_s */
+
+  for (ptr = fmt; *ptr != '\0' && ok; )
+    {
+      if (*ptr++ != '%')
+        {
+          continue;
+        }
+
+      /* Skip over the flags */
+
+      while (*ptr == '-' || *ptr == '+' || *ptr == ' ' || *ptr == '#' ||
+             *ptr == '0')
+        {
+          ptr++;
+        }
+
+      /* The field width and precision may be '*' arguments */
+
+      if (*ptr == '*')
+        {
+          ok = note_pack(data, &pos, (uint32_t)va_arg(ap, int), 4);
+          ptr++;
+        }
+
+      while (*ptr >= '0' && *ptr <= '9')
+        {
+          ptr++;
+        }
+
+      if (*ptr == '.')
+        {
+          ptr++;
+          if (*ptr == '*')
+            {
+              ok = ok && note_pack(data, &pos, (uint32_t)va_arg(ap, int), 4);
+              ptr++;
+            }
+
+          while (*ptr >= '0' && *ptr <= '9')
+            {
+              ptr++;
+            }
+        }
+
+      /* Length modifiers:  0=none/h/hh, 1=l, 2=ll, 3=j, 4=z, 5=t */
+
+      lng = 0;
+      switch (*ptr)
+        {
+          case 'h':
+            if (*++ptr == 'h')
+              {
+                ptr++;
+              }
+            break;
+
+          case 'l':
+            lng = 1;
+            if (*++ptr == 'l')
+              {
+                lng = 2;
+                ptr++;
+              }
+            break;
+
+          case 'j':
+            lng = 3;
+            ptr++;
+            break;
+
+          case 'z':
+            lng = 4;
+            ptr++;
+            break;
+
+          case 't':
+            lng = 5;
+            ptr++;
+            break;
+
+          default:
+            break;
+        }
+
+      if (!ok)
+        {
+          break;
+        }
+
+      /* And the conversion itself */
+
+      switch (*ptr++)
+        {
+          case '%':
+            break;
+
+          case 'd':
+          case 'i':
+            switch (lng)
+              {
+                case 0:
+                  ok = note_pack(data, &pos, (uint32_t)va_arg(ap, int), 4);
+                  break;
+
+                case 1:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)(int64_t)va_arg(ap, long), 8);
+                  break;
+
+                case 2:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)va_arg(ap, long long), 8);
+                  break;
+
+                case 3:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)(int64_t)va_arg(ap, intmax_t), 8);
+                  break;
+
+                case 4:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)(int64_t)va_arg(ap, ssize_t), 8);
+                  break;
+
+                default:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)(int64_t)va_arg(ap, ptrdiff_t), 8);
+                  break;
+              }
+            break;
+
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+            switch (lng)
+              {
+                case 0:
+                  ok = note_pack(data, &pos,
+                                 (uint32_t)va_arg(ap, unsigned int), 4);
+                  break;
+
+                case 1:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)va_arg(ap, unsigned long), 8);
+                  break;
+
+                case 2:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)va_arg(ap, unsigned long long), 8);
+                  break;
+
+                case 3:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)va_arg(ap, uintmax_t), 8);
+                  break;
+
+                case 4:
+                  ok = note_pack(data, &pos, (uint64_t)va_arg(ap, size_t), 8);
+                  break;
+
+                default:
+                  ok = note_pack(data, &pos,
+                                 (uint64_t)(int64_t)va_arg(ap, ptrdiff_t), 8);
+                  break;
+              }
+            break;
+
+          case 'p':
+            ok = note_pack(data, &pos,
+                           (uint64_t)(uintptr_t)va_arg(ap, FAR void *), 8);
+            break;
+
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            {
+              double value = va_arg(ap, double);
+              uint64_t bits;
+
+              memcpy(&bits, &value, sizeof(bits));
+              ok = note_pack(data, &pos, bits, 8);
+            }
+            break;
+
+          case 's':
+            {
+              FAR const char *str = va_arg(ap, FAR const char *);
+              size_t len;
+
+              if (str == NULL)
+                {
+                  str = "(null)";
+                }
+
+              /* Copy the string with its NUL terminator, truncating it if
+               * necessary.
+               */
+
+              if (pos >= CONFIG_SCHED_NOTE_DUMP_MAXLEN)
+                {
+                  ok = false;
+                  break;
+                }
+
+              len = strlen(str);
+              if (len > CONFIG_SCHED_NOTE_DUMP_MAXLEN - pos - 1)
+                {
+                  len = CONFIG_SCHED_NOTE_DUMP_MAXLEN - pos - 1;
+                }
+
+              memcpy(&data[pos], str, len);
+              pos += len;
+              data[pos++] = '\0';
+            }
+            break;
+
+          default:
+
+            /* %n or an unsupported conversion.  Stop here since the
+             * remaining arguments cannot be located.
+             */
+
+            ok = false;
+            break;
+        }
+    }
+
+  /* Finish formatting the note */
+
+  length = SIZEOF_NOTE_PRINTF(pos);
+  note_common(this_task(), &note.npt_cmn, length, NOTE_DUMP_PRINTF);
+  note.npt_category = category;
+  note.npt_fmtlen   = (uint8_t)fmtlen;
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, length);
+}
+
+void sched_note_printf(uint8_t category, FAR const char *fmt, ...)
+{
+  va_list ap;
+
+  va_start(ap, fmt);
+  sched_note_vprintf(category, fmt, ap);
+  va_end(ap);
+}
+
+/****************************************************************************
+ * Name: sched_note_filter
+ *
+ * Description:
+ *   Set the mask of user note categories that are recorded.
+ *
+ * Input Parameters:
+ *   categories - The new category mask.  Bit n enables category n.
+ *
+ * Returned Value:
+ *   The previous mask.
+ *
+ ****************************************************************************/
+
+uint32_t sched_note_filter(uint32_t categories)
+{
+  uint32_t prev = g_note_categories;
+
+  g_note_categories = categories;
+  return prev;
+}
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
@@ -609,69 +1271,34 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
   irqstate_t flags;
-  unsigned int remaining;
-  unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  int i;
+#endif
 
   DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
-
-  /* Verify that the circular buffer is not empty */
-
-  circlen = note_length();
-  if (circlen <= 0)
-    {
-      notelen = 0;
-      goto errout_with_csection;
-    }
-
-  /* Get the index to the tail of the circular buffer */
-
-  tail    = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
-  /* Get the length of the note at the tail index */
-
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  flags = note_rdlock();
 
-  /* Is the user buffer large enough to hold the note? */
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  /* Take the next note from the first non-empty buffer, starting with a
+   * different CPU each time so that no CPU's notes are starved.
+   */
 
-  if (buflen < notelen)
+  notelen = 0;
+  for (i = 0; i < CONFIG_SMP_NCPUS && notelen == 0; i++)
     {
-      /* Remove the large note so that we do not get constipated. */
-
-      note_remove();
-
-      /* and return an error */
-
-      notelen = -EFBIG;
-      goto errout_with_csection;
+      notelen = note_getone(&g_note_info[(g_note_rdcpu + i) %
+                                         CONFIG_SMP_NCPUS],
+                            buffer, buflen);
     }
 
-  /* Loop until the note has been transferred to the user buffer */
-
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the tail index */
-
-      *buffer++ = g_note_info.ni_buffer[tail];
-
-      /* Adjust indices and counts */
-
-      tail = note_next(tail, 1);
-      remaining--;
-    }
-
-  g_note_info.ni_tail = tail;
+  g_note_rdcpu = (g_note_rdcpu + 1) % CONFIG_SMP_NCPUS;
+#else
+  notelen = note_getone(&g_note_info, buffer, buflen);
+#endif
 
-errout_with_csection:
-  leave_critical_section(flags);
+  note_rdunlock(flags);
   return notelen;
 }
 #endif
@@ -694,37 +1321,103 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
-  FAR struct note_common_s *note;
   irqstate_t flags;
-  unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
-
-  flags = enter_critical_section();
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  int i;
+#endif
 
-  /* Verify that the circular buffer is not empty */
+  flags = note_rdlock();
 
-  circlen = note_length();
-  if (circlen <= 0)
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  notelen = 0;
+  for (i = 0; i < CONFIG_SMP_NCPUS && notelen == 0; i++)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      notelen = note_size(&g_note_info[(g_note_rdcpu + i) %
+                                       CONFIG_SMP_NCPUS]);
     }
+#else
+  notelen = note_size(&g_note_info);
+#endif
 
-  /* Get the index to the tail of the circular buffer */
+  note_rdunlock(flags);
+  return notelen;
+}
+#endif
 
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+/****************************************************************************
+ * Name: sched_note_getbuf
+ *
+ * Description:
+ *   Remove as many complete notes as will fit from the circular buffer(s)
+ *   and copy them to the user buffer.  The notes from each CPU are in
+ *   order, but notes from different CPUs are not merged by time.
+ *
+ * Input Parameters:
+ *   buffer - Location to return the notes
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   On success, the total length of the returned notes is provided.  Zero
+ *   is returned only if the circular buffer is empty.  -EFBIG is returned
+ *   (and the note is discarded) if not even the first note will fit.
+ *
+ ****************************************************************************/
 
-  /* Get the length of the note at the tail index */
+#ifdef CONFIG_SCHED_NOTE_GET
+ssize_t sched_note_getbuf(FAR uint8_t *buffer, size_t buflen)
+{
+  FAR struct note_info_s *toobig = NULL;
+  FAR struct note_info_s *info;
+  irqstate_t flags;
+  ssize_t notelen;
+  ssize_t total = 0;
+  int i;
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  DEBUGASSERT(buffer != NULL);
+  flags = note_rdlock();
 
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+#else
+  for (i = 0; i < 1; i++)
+#endif
+    {
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+      info = &g_note_info[(g_note_rdcpu + i) % CONFIG_SMP_NCPUS];
+#else
+      info = &g_note_info;
+#endif
+
+      while ((notelen = note_size(info)) > 0)
+        {
+          if (notelen > buflen - total)
+            {
+              if (toobig == NULL)
+                {
+                  toobig = info;
+                }
+
+              break;
+            }
+
+          total += note_getone(info, &buffer[total], buflen - total);
+        }
+    }
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  g_note_rdcpu = (g_note_rdcpu + 1) % CONFIG_SMP_NCPUS;
+#endif
+
+  /* If nothing fit, discard the first note and report the error */
+
+  if (total == 0 && toobig != NULL)
+    {
+      total = note_getone(toobig, buffer, buflen);
+    }
+
+  note_rdunlock(flags);
+  return total;
 }
 #endif
 
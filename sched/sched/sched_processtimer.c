@@ -73,7 +73,8 @@
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static inline void sched_cpu_scheduler(int cpu)
 {
   FAR struct tcb_s *rtcb = current_task(cpu);
@@ -103,6 +104,65 @@ static inline void sched_cpu_scheduler(int cpu)
       (void)sched_sporadic_process(rtcb, 1, false);
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Check if the currently executing task uses deadline scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Yes, check if the currently executing task has exceeded its
+       * budget.
+       */
+
+      (void)sched_deadline_process(rtcb, 1, false);
+    }
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name:  sched_cpu_nohz
+ *
+ * Description:
+ *   Return true if the scheduler operations can be skipped on an isolated
+ *   CPU:  The CPU runs a single task and no other task may run there.
+ *   Time slices and budgets of that task are then not charged, so that the
+ *   CPU is never paused by the timer.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && (CONFIG_RR_INTERVAL > 0 || \
+    defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE))
+static inline bool sched_cpu_nohz(int cpu)
+{
+  FAR struct tcb_s *rtcb = current_task(cpu);
+  FAR struct tcb_s *tcb;
+
+  if (!sched_cpu_isolated(cpu))
+    {
+      return false;
+    }
+
+  /* Is anything other than the IDLE task queued behind the running task? */
+
+  if (rtcb->flink != NULL && rtcb->flink->flink != NULL)
+    {
+      return false;
+    }
+
+  /* Is any ready-to-run task waiting for this CPU? */
+
+  for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+       tcb != NULL;
+       tcb = (FAR struct tcb_s *)tcb->flink)
+    {
+      if (sched_cpu_allowed(tcb, cpu))
+        {
+          return false;
+        }
+    }
+
+  return true;
 }
 #endif
 
@@ -121,7 +181,8 @@ static inline void sched_cpu_scheduler(int cpu)
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static inline void sched_process_scheduler(void)
 {
 #ifdef CONFIG_SMP
@@ -142,7 +203,10 @@ static inline void sched_process_scheduler(void)
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
-      sched_cpu_scheduler(i);
+      if (!sched_cpu_nohz(i))
+        {
+          sched_cpu_scheduler(i);
+        }
     }
 
   leave_critical_section(flags);
@@ -217,6 +281,12 @@ void sched_process_timer(void)
     }
 #endif
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Charge the running thread before the cycle counter can wrap */
+
+  sched_cputime_tick();
+#endif
+
   /* Check if the currently executing task has exceeded its
    * timeslice.
    */
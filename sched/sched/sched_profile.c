@@ -0,0 +1,266 @@
+/****************************************************************************
+ * sched/sched/sched_profile.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/sched_profile.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define PROFILE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define PROFILE_NCPUS 1
+#endif
+
+/* No memory barrier is needed without spinlocks:  There is only one CPU
+ * and the reader keeps its timer interrupt disabled.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The sample buffer of one CPU.  It is written only by the timer interrupt
+ * of that CPU and read only within a critical section, so the head and
+ * tail indices need no lock:  The writer only advances the head and the
+ * reader only advances the tail.
+ */
+
+struct profile_info_s
+{
+  volatile unsigned int pi_head;   /* Index of the next sample to write */
+  volatile unsigned int pi_tail;   /* Index of the next sample to read */
+  unsigned int pi_skip;            /* Ticks until the next sample */
+  struct profile_sample_s pi_buffer[CONFIG_SCHED_PROFILE_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct profile_info_s g_profile_info[PROFILE_NCPUS];
+static volatile bool g_profile_enabled;
+static unsigned int g_profile_rdcpu;   /* CPU to drain first, round robin */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_next
+ ****************************************************************************/
+
+static inline unsigned int profile_next(unsigned int ndx)
+{
+  return ++ndx >= CONFIG_SCHED_PROFILE_BUFSIZE ? 0 : ndx;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_profile_sample
+ *
+ * Description:
+ *   Take one profile sample.  This must be called from the system timer
+ *   interrupt handler of each CPU with the program counter that was
+ *   interrupted.
+ *
+ * Assumptions:
+ *   Called from the timer interrupt with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_profile_sample(uintptr_t pc)
+{
+  FAR struct profile_info_s *info;
+  FAR struct profile_sample_s *sample;
+  FAR struct tcb_s *tcb;
+  unsigned int head;
+  unsigned int next;
+  int cpu;
+
+  if (!g_profile_enabled)
+    {
+      return;
+    }
+
+  cpu  = this_cpu();
+  info = &g_profile_info[cpu];
+
+  if (info->pi_skip > 0)
+    {
+      info->pi_skip--;
+      return;
+    }
+
+  info->pi_skip = CONFIG_SCHED_PROFILE_INTERVAL - 1;
+
+  /* Discard the sample if the buffer is full */
+
+  head = info->pi_head;
+  next = profile_next(head);
+  if (next == info->pi_tail)
+    {
+      return;
+    }
+
+  tcb            = this_task();
+  sample         = &info->pi_buffer[head];
+  sample->ps_pc  = (uint32_t)pc;
+  sample->ps_pid = tcb != NULL ? (uint16_t)tcb->pid : 0;
+  sample->ps_cpu = (uint8_t)cpu;
+  sample->ps_pad = 0;
+
+  /* The sample must be complete before the reader can see it */
+
+  SP_DMB();
+  info->pi_head = next;
+}
+
+/****************************************************************************
+ * Name: sched_profile_enable
+ *
+ * Description:
+ *   Start or stop profiling.  Starting discards any old samples.
+ *
+ ****************************************************************************/
+
+void sched_profile_enable(bool enable)
+{
+  irqstate_t flags;
+  int cpu;
+
+  flags = enter_critical_section();
+
+  if (enable && !g_profile_enabled)
+    {
+      for (cpu = 0; cpu < PROFILE_NCPUS; cpu++)
+        {
+          g_profile_info[cpu].pi_tail = g_profile_info[cpu].pi_head;
+          g_profile_info[cpu].pi_skip = 0;
+        }
+    }
+
+  g_profile_enabled = enable;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: sched_profile_getbuf
+ *
+ * Description:
+ *   Remove as many samples as will fit from the per-CPU sample buffers and
+ *   copy them to the user buffer.
+ *
+ ****************************************************************************/
+
+size_t sched_profile_getbuf(FAR uint8_t *buffer, size_t nsamples)
+{
+  FAR struct profile_info_s *info;
+  irqstate_t flags;
+  unsigned int head;
+  unsigned int tail;
+  size_t nread = 0;
+  int i;
+
+  DEBUGASSERT(buffer != NULL);
+
+  /* The critical section serializes readers.  It does not keep the timer
+   * interrupt of another CPU from adding samples to its own buffer.
+   */
+
+  flags = enter_critical_section();
+
+  /* Start with a different CPU each time so that no CPU is starved when
+   * the user buffer is small.
+   */
+
+  for (i = 0; i < PROFILE_NCPUS && nread < nsamples; i++)
+    {
+      info = &g_profile_info[(g_profile_rdcpu + i) % PROFILE_NCPUS];
+      head = info->pi_head;
+      tail = info->pi_tail;
+
+      /* Do not read the samples before the head that publishes them */
+
+      SP_DMB();
+
+      while (tail != head && nread < nsamples)
+        {
+          /* The user buffer may not be aligned */
+
+          memcpy(&buffer[nread * sizeof(struct profile_sample_s)],
+                 &info->pi_buffer[tail], sizeof(struct profile_sample_s));
+
+          nread++;
+          tail = profile_next(tail);
+        }
+
+      /* The samples must be copied before the writer can reuse them */
+
+      SP_DMB();
+      info->pi_tail = tail;
+    }
+
+  g_profile_rdcpu = (g_profile_rdcpu + 1) % PROFILE_NCPUS;
+  leave_critical_section(flags);
+  return nread;
+}
+
+#endif /* CONFIG_SCHED_PROFILE */
@@ -142,6 +142,15 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
           sched_releasepid(tcb->pid);
         }
 
+#if CONFIG_SIG_PREALLOC_TCB > 0
+      /* Release the signal actions reserved for this thread */
+
+      if (tcb->sigactpool != NULL)
+        {
+          sched_kfree(tcb->sigactpool);
+        }
+#endif
+
       /* Delete the thread's stack if one has been allocated */
 
       if (tcb->stack_alloc_ptr)
@@ -200,7 +209,7 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
 
       /* And, finally, release the TCB itself */
 
-      sched_kfree(tcb);
+      sched_tcbfree(tcb);
     }
 
   return ret;
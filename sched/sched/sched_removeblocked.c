@@ -80,7 +80,16 @@ void sched_removeblocked(FAR struct tcb_s *btcb)
    * with this state
    */
 
-  dq_rem((FAR dq_entry_t *)btcb, TLIST_BLOCKED(task_state));
+  dq_rem((FAR dq_entry_t *)btcb, TLIST_BLOCKED(btcb));
+
+  /* A task waiting for a semaphore is no longer waiting once it has been
+   * removed from the semaphore's wait list.
+   */
+
+  if (task_state == TSTATE_WAIT_SEM)
+    {
+      btcb->waitsem = NULL;
+    }
 
   /* Make sure the TCB's state corresponds to not being in
    * any list
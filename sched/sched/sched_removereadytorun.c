@@ -47,6 +47,74 @@
 #include "irq/irq.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_steal_task
+ *
+ * Description:
+ *   Find the highest priority task that is queued, but not running, in the
+ *   assigned task list of some other CPU and that could run on this CPU.
+ *
+ * Input Parameters:
+ *   cpu  - The CPU that is looking for work.
+ *   list - Location to return the assigned task list that holds the TCB.
+ *
+ * Returned Value:
+ *   The TCB of the task that could be stolen or NULL if there is none.
+ *
+ * Assumptions:
+ *   The caller holds the tasklist lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_PERCPU_READYTORUN
+static FAR struct tcb_s *sched_steal_task(int cpu,
+                                          FAR dq_queue_t **list)
+{
+  FAR struct tcb_s *best = NULL;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      /* Skip over the running task at the head of the list.  The list is
+       * prioritized so the first eligible TCB is the best one in this list.
+       * The IDLE task at the end of the list is always locked to its CPU.
+       */
+
+      tcb = (FAR struct tcb_s *)g_assignedtasks[i].head;
+      DEBUGASSERT(tcb != NULL);
+
+      for (tcb = (FAR struct tcb_s *)tcb->flink;
+           tcb != NULL;
+           tcb = (FAR struct tcb_s *)tcb->flink)
+        {
+          if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+              sched_cpu_allowed(tcb, cpu))
+            {
+              if (best == NULL || tcb->sched_priority > best->sched_priority)
+                {
+                  best  = tcb;
+                  *list = (FAR dq_queue_t *)&g_assignedtasks[i];
+                }
+
+              break;
+            }
+        }
+    }
+
+  return best;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -171,6 +239,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
     {
       FAR struct tcb_s *nxttcb;
       FAR struct tcb_s *rtrtcb = NULL;
+      FAR dq_queue_t *rtrlist;
       int me;
 
       /* There must always be at least one task in the list (the IDLE task)
@@ -210,15 +279,39 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * REVISIT: What if it is not the IDLE thread?
        */
 
+      rtrlist = (FAR dq_queue_t *)&g_readytorun;
+
       if (!sched_islocked_global() && !irq_cpu_locked(me))
         {
+#ifdef CONFIG_SMP_PERCPU_READYTORUN
+          FAR struct tcb_s *victim;
+          FAR dq_queue_t *victimlist;
+#endif
+
           /* Search for the highest priority task that can run on this
            * CPU.
            */
 
           for (rtrtcb = (FAR struct tcb_s *)g_readytorun.head;
-               rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
+               rtrtcb != NULL && !sched_cpu_allowed(rtrtcb, cpu);
                rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
+
+#ifdef CONFIG_SMP_PERCPU_READYTORUN
+          /* Is there a better task waiting in the assigned task list of
+           * some other CPU?  Only steal it if it has a strictly higher
+           * priority than the task that would run here anyway.
+           */
+
+          victim = sched_steal_task(cpu, &victimlist);
+          if (victim != NULL &&
+              victim->sched_priority > nxttcb->sched_priority &&
+              (rtrtcb == NULL ||
+               victim->sched_priority > rtrtcb->sched_priority))
+            {
+              rtrtcb  = victim;
+              rtrlist = victimlist;
+            }
+#endif
         }
 
       /* Did we find a task in the g_readytorun list?  Which task should
@@ -230,20 +323,16 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
 
       if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority)
         {
-          FAR struct tcb_s *tmptcb;
-
-          /* The TCB at the head of the ready to run list has the higher
-           * priority.  Remove that task from the head of the g_readytorun
-           * list and add to the head of the g_assignedtasks[cpu] list.
+          /* The selected TCB has the higher priority.  Remove that task
+           * from its list and add to the head of the g_assignedtasks[cpu]
+           * list.
            */
 
-          tmptcb = (FAR struct tcb_s *)
-            dq_remfirst((FAR dq_queue_t *)&g_readytorun);
-
-          dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          dq_rem((FAR dq_entry_t *)rtrtcb, rtrlist);
+          dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
 
-          tmptcb->cpu = cpu;
-          nxttcb = tmptcb;
+          rtrtcb->cpu = cpu;
+          nxttcb = rtrtcb;
         }
 
       /* Will pre-emption be disabled after the switch?  If the lockcount is
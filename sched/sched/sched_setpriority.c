@@ -88,7 +88,7 @@ static FAR struct tcb_s *sched_nexttcb(FAR struct tcb_s *tcb)
       /* Search for the highest priority task that can run on this CPU. */
 
       for (rtrtcb = (FAR struct tcb_s *)g_readytorun.head;
-           rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
+           rtrtcb != NULL && !sched_cpu_allowed(rtrtcb, cpu);
            rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
 
       /* Return the TCB from the readyt-to-run list if it is the next
@@ -284,7 +284,7 @@ static inline void sched_blocked_setpriority(FAR struct tcb_s *tcb,
 
   /* CASE 3a. The task resides in a prioritized list. */
 
-  tasklist = TLIST_BLOCKED(task_state);
+  tasklist = TLIST_BLOCKED(tcb);
   if (TLIST_ISPRIORITIZED(task_state))
     {
       /* Remove the TCB from the prioritized task list */
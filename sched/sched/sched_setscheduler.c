@@ -88,6 +88,8 @@
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  SCHED_DEADLINE was requested but the thread would over-
+ *          subscribe the CPU(s).
  *
  ****************************************************************************/
 
@@ -106,6 +108,9 @@ int nxsched_setscheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
 #endif
      )
     {
@@ -136,6 +141,26 @@ int nxsched_setscheduler(pid_t pid, int policy,
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if (policy == SCHED_DEADLINE)
+    {
+      /* Admit the thread before it gives up its current policy */
+
+      ret = sched_deadline_start(tcb, param);
+      if (ret < 0)
+        {
+          goto errout_with_irq;
+        }
+    }
+  else if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Release the bandwidth of the thread */
+
+      sched_deadline_stop(tcb);
+    }
+#endif
+
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -156,7 +181,8 @@ int nxsched_setscheduler(pid_t pid, int policy,
           /* Save the FIFO scheduling parameters */
 
           tcb->flags       |= TCB_FLAG_SCHED_FIFO;
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
           tcb->timeslice    = 0;
 #endif
         }
@@ -271,6 +297,16 @@ int nxsched_setscheduler(pid_t pid, int policy,
         break;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          /* The parameters were saved by sched_deadline_start() */
+
+          tcb->flags       |= TCB_FLAG_SCHED_DEADLINE;
+        }
+        break;
+#endif
+
 #if 0 /* Not supported */
       case SCHED_OTHER:
         tcb->flags    |= TCB_FLAG_SCHED_OTHER;
@@ -286,7 +322,7 @@ int nxsched_setscheduler(pid_t pid, int policy,
   sched_unlock();
   return ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
   leave_critical_section(flags);
   sched_unlock();
@@ -320,6 +356,8 @@ errout_with_irq:
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  SCHED_DEADLINE was requested but the thread would over-
+ *          subscribe the CPU(s).
  *
  ****************************************************************************/
 
@@ -0,0 +1,107 @@
+/****************************************************************************
+ * sched/sched/sched_stackmon.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_STACK_MONITOR
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct work_s g_stackmon_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_stackmon_check
+ *
+ * Description:
+ *   Check the stack of one thread.  The result is discarded:  Calling
+ *   up_check_tcbstack() is what keeps the architecture's high water mark
+ *   up to date.
+ *
+ ****************************************************************************/
+
+static void sched_stackmon_check(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  (void)up_check_tcbstack(tcb);
+}
+
+/****************************************************************************
+ * Name: sched_stackmon_worker
+ *
+ * Description:
+ *   Sample the stacks of all threads and re-queue the work.
+ *
+ ****************************************************************************/
+
+static void sched_stackmon_worker(FAR void *arg)
+{
+  sched_foreach(sched_stackmon_check, NULL);
+  (void)work_queue(LPWORK, &g_stackmon_work, sched_stackmon_worker, NULL,
+                   MSEC2TICK(CONFIG_STACK_MONITOR_INTERVAL));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_stackmon_start
+ *
+ * Description:
+ *   Start the periodic stack usage sampler on the low priority work queue.
+ *
+ ****************************************************************************/
+
+void sched_stackmon_start(void)
+{
+  (void)work_queue(LPWORK, &g_stackmon_work, sched_stackmon_worker, NULL, 0);
+}
+
+#endif /* CONFIG_STACK_MONITOR */
@@ -88,6 +88,9 @@ void sched_suspend_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_CRITMONITOR
   sched_critmon_suspend(tcb);
 #endif
+#ifdef CONFIG_SCHED_CPUTIME
+  sched_cputime_suspend(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_suspend(tcb);
 #endif
@@ -0,0 +1,150 @@
+/****************************************************************************
+ * sched/sched/sched_tcbpool.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/mm/objpool.h>
+
+#include "sched/sched.h"
+
+#ifdef HAVE_TCBPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Pool objects must be large enough for the TCB of a task or a pthread */
+
+#ifdef CONFIG_DISABLE_PTHREAD
+#  define TCBPOOL_OBJSIZE sizeof(struct task_tcb_s)
+#else
+#  define TCBPOOL_OBJSIZE \
+  (sizeof(struct task_tcb_s) > sizeof(struct pthread_tcb_s) ? \
+   sizeof(struct task_tcb_s) : sizeof(struct pthread_tcb_s))
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct objpool_s *g_tcbpool;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_tcbpool_initialize
+ *
+ * Description:
+ *   Create the pool of CONFIG_PREALLOC_TCBS TCBs.  This is called once
+ *   during OS initialization after the heap has been initialized.
+ *
+ ****************************************************************************/
+
+void sched_tcbpool_initialize(void)
+{
+  g_tcbpool = objpool_create("tcb", TCBPOOL_OBJSIZE, CONFIG_PREALLOC_TCBS);
+  if (g_tcbpool == NULL)
+    {
+      serr("ERROR: Failed to create the TCB pool\n");
+    }
+}
+
+/****************************************************************************
+ * Name: sched_tcballoc
+ *
+ * Description:
+ *   Allocate a zeroed TCB of 'size' bytes.  The TCB is taken from the TCB
+ *   pool; the kernel heap is only used if the pool is exhausted.
+ *
+ * Input Parameters:
+ *   size - sizeof(struct task_tcb_s) or sizeof(struct pthread_tcb_s)
+ *
+ * Returned Value:
+ *   The allocated TCB or NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR void *sched_tcballoc(size_t size)
+{
+  FAR void *tcb = NULL;
+
+  DEBUGASSERT(size <= TCBPOOL_OBJSIZE);
+
+  if (g_tcbpool != NULL)
+    {
+      tcb = objpool_zalloc(g_tcbpool);
+    }
+
+  if (tcb == NULL)
+    {
+      tcb = kmm_zalloc(size);
+    }
+
+  return tcb;
+}
+
+/****************************************************************************
+ * Name: sched_tcbfree
+ *
+ * Description:
+ *   Release a TCB allocated with sched_tcballoc().  This may be called
+ *   from interrupt handlers.
+ *
+ ****************************************************************************/
+
+void sched_tcbfree(FAR struct tcb_s *tcb)
+{
+  if (g_tcbpool != NULL && objpool_member(g_tcbpool, tcb))
+    {
+      objpool_free(g_tcbpool, tcb);
+    }
+  else
+    {
+      sched_kfree(tcb);
+    }
+}
+
+#endif /* HAVE_TCBPOOL */
@@ -116,10 +116,12 @@ uint32_t g_oneshot_maxticks = UINT32_MAX;
  * Private Function Prototypes
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t sched_cpu_scheduler(int cpu, uint32_t ticks, bool noswitches);
 #endif
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t sched_process_scheduler(uint32_t ticks, bool noswitches);
 #endif
 static unsigned int sched_timer_process(unsigned int ticks, bool noswitches);
@@ -180,7 +182,8 @@ static struct timespec g_sched_time;
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t sched_cpu_scheduler(int cpu, uint32_t ticks, bool noswitches)
 {
   FAR struct tcb_s *rtcb = current_task(cpu);
@@ -227,6 +230,19 @@ static uint32_t sched_cpu_scheduler(int cpu, uint32_t ticks, bool noswitches)
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Check if the currently executing task uses deadline scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Yes, check if the currently executing task has exceeded its
+       * budget.
+       */
+
+      ret = sched_deadline_process(rtcb, ticks, noswitches);
+    }
+#endif
+
   /* If a context switch occurred, then need to return delay remaining for
    * the new task at the head of the ready to run list.
    */
@@ -281,7 +297,8 @@ static uint32_t sched_cpu_scheduler(int cpu, uint32_t ticks, bool noswitches)
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t sched_process_scheduler(uint32_t ticks, bool noswitches)
 {
 #ifdef CONFIG_SMP
@@ -352,6 +369,12 @@ static unsigned int sched_timer_process(unsigned int ticks, bool noswitches)
   clock_update_wall_time();
 #endif
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Charge the running thread before the cycle counter can wrap */
+
+  sched_cputime_tick();
+#endif
+
   /* Process watchdogs */
 
   tmp = wd_timer(ticks);
@@ -220,6 +220,30 @@ int sched_unlock(void)
 #endif
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+          else
+#endif
+          /* If (1) the task that was running supported deadline scheduling
+           * and (2) if its budget has already expired, but (3) it could not
+           * be replenished because pre-emption was disabled, then postpone
+           * its deadline now and reassess the interval timer.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE &&
+              rtcb->timeslice <= 0)
+            {
+              sched_deadline_replenish(rtcb);
+
+#ifdef CONFIG_SCHED_TICKLESS
+              if (rtcb == current_task(cpu))
+                {
+                  sched_timer_reassess();
+                }
+#endif
+            }
+#endif
         }
 
       leave_critical_section(flags);
@@ -351,6 +375,30 @@ int sched_unlock(void)
 #endif
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+          else
+#endif
+          /* If (1) the task that was running supported deadline scheduling
+           * and (2) if its budget has already expired, but (3) it could not
+           * be replenished because pre-emption was disabled, then postpone
+           * its deadline now and reassess the interval timer.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE &&
+              rtcb->timeslice <= 0)
+            {
+              sched_deadline_replenish(rtcb);
+
+#ifdef CONFIG_SCHED_TICKLESS
+              if (rtcb == this_task())
+                {
+                  sched_timer_reassess();
+                }
+#endif
+            }
+#endif
         }
 
       leave_critical_section(flags);
@@ -45,6 +45,8 @@
 #include <assert.h>
 #include <debug.h>
 #include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -61,6 +63,22 @@
 #  define CONFIG_SEM_PREALLOCHOLDERS 0
 #endif
 
+#if CONFIG_SEM_PREALLOCHOLDERS < 1 || !defined(CONFIG_SEM_HOLDEREXTEND) || \
+    !defined(CONFIG_SCHED_WORKQUEUE)
+#  undef  CONFIG_SEM_HOLDEREXTEND
+#  define CONFIG_SEM_HOLDEREXTEND 0
+#endif
+
+/* The pool is extended on the low priority work queue, if available */
+
+#if CONFIG_SEM_HOLDEREXTEND > 0
+#  ifdef CONFIG_SCHED_LPWORK
+#    define HOLDERWORK LPWORK
+#  else
+#    define HOLDERWORK HPWORK
+#  endif
+#endif
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -79,6 +97,55 @@ static struct semholder_s g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS];
 static FAR struct semholder_s *g_freeholders;
 #endif
 
+/* Extension of the holder pool */
+
+#if CONFIG_SEM_HOLDEREXTEND > 0
+static struct work_s g_holderwork;   /* Work to extend the pool */
+static unsigned int g_nfreeholders;  /* Number of holders in the free list */
+#endif
+
+/****************************************************************************
+ * Name: nxsem_extendholders
+ *
+ * Description:
+ *   Fewer than CONFIG_SEM_HOLDEREXTEND free holders remain.  Allocate a
+ *   new block of CONFIG_SEM_HOLDEREXTEND holders from the kernel heap and
+ *   add them to the free list.  The holders are never returned to the
+ *   heap; they simply become part of the pool.
+ *
+ *   This runs on a work queue, never on the paths that take or release a
+ *   semaphore:  The heap is itself protected by a priority inheritance
+ *   semaphore, so allocating while adding a holder could re-enter that
+ *   semaphore.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SEM_HOLDEREXTEND > 0
+static void nxsem_extendholders(FAR void *arg)
+{
+  FAR struct semholder_s *pholders;
+  irqstate_t flags;
+  int i;
+
+  pholders = (FAR struct semholder_s *)
+    kmm_malloc(CONFIG_SEM_HOLDEREXTEND * sizeof(struct semholder_s));
+
+  if (pholders != NULL)
+    {
+      for (i = 0; i < (CONFIG_SEM_HOLDEREXTEND - 1); i++)
+        {
+          pholders[i].flink = &pholders[i + 1];
+        }
+
+      flags = enter_critical_section();
+      pholders[CONFIG_SEM_HOLDEREXTEND - 1].flink = g_freeholders;
+      g_freeholders   = pholders;
+      g_nfreeholders += CONFIG_SEM_HOLDEREXTEND;
+      leave_critical_section(flags);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nxsem_allocholder
  ****************************************************************************/
@@ -96,12 +163,32 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
   pholder = g_freeholders;
   if (pholder != NULL)
     {
-      /* Remove the holder from the free list an put it into the semaphore's
-       * holder list
+#if CONFIG_SEM_HOLDEREXTEND > 0
+      /* Extend the pool before it is exhausted.  The allocation is
+       * deferred to the work queue; the work is queued only once.
+       */
+
+      if (--g_nfreeholders < CONFIG_SEM_HOLDEREXTEND &&
+          work_available(&g_holderwork))
+        {
+          (void)work_queue(HOLDERWORK, &g_holderwork, nxsem_extendholders,
+                           NULL, 0);
+        }
+
+#endif
+      /* Remove the holder from the free list an put it at the head of the
+       * semaphore's holder list
        */
 
       g_freeholders    = pholder->flink;
       pholder->flink   = sem->hhead;
+      pholder->blink   = NULL;
+
+      if (sem->hhead != NULL)
+        {
+          sem->hhead->blink = pholder;
+        }
+
       sem->hhead       = pholder;
 
       /* Make sure the initial count is zero */
@@ -199,41 +286,40 @@ nxsem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
 static inline void nxsem_freeholder(sem_t *sem,
                                     FAR struct semholder_s *pholder)
 {
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-  FAR struct semholder_s *curr;
-  FAR struct semholder_s *prev;
-#endif
-
   /* Release the holder and counts */
 
   pholder->htcb   = NULL;
   pholder->counts = 0;
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  /* Search the list for the matching holder */
-
-  for (prev = NULL, curr = sem->hhead;
-       curr && curr != pholder;
-       prev = curr, curr = curr->flink);
+  /* Remove the holder from the semaphore's list.  The holder is always in
+   * the list of the semaphore that it was found in so, with the list doubly
+   * linked, there is no need to search for it.
+   */
 
-  if (curr != NULL)
+  if (pholder->blink != NULL)
     {
-      /* Remove the holder from the list */
+      pholder->blink->flink = pholder->flink;
+    }
+  else
+    {
+      DEBUGASSERT(sem->hhead == pholder);
+      sem->hhead = pholder->flink;
+    }
 
-      if (prev != NULL)
-        {
-          prev->flink = pholder->flink;
-        }
-      else
-        {
-          sem->hhead = pholder->flink;
-        }
+  if (pholder->flink != NULL)
+    {
+      pholder->flink->blink = pholder->blink;
+    }
 
-      /* And put it in the free list */
+  /* And put it in the free list */
 
-      pholder->flink = g_freeholders;
-      g_freeholders  = pholder;
-    }
+  pholder->flink = g_freeholders;
+  pholder->blink = NULL;
+  g_freeholders  = pholder;
+#if CONFIG_SEM_HOLDEREXTEND > 0
+  g_nfreeholders++;
+#endif
 #endif
 }
 
@@ -869,6 +955,9 @@ void nxsem_initholders(void)
     }
 
   g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS - 1].flink = NULL;
+#if CONFIG_SEM_HOLDEREXTEND > 0
+  g_nfreeholders = CONFIG_SEM_PREALLOCHOLDERS;
+#endif
 #endif
 }
 
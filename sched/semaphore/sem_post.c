@@ -139,15 +139,12 @@ int nxsem_post(FAR sem_t *sem)
 
       if (sem->semcount <= 0)
         {
-          /* Check if there are any tasks in the waiting for semaphore
-           * task list that are waiting for this semaphore. This is a
-           * prioritized list so the first one we encounter is the one
-           * that we want.
+          /* The tasks waiting for this semaphore are held in its own
+           * wait list. This is a prioritized list so the task at the
+           * head is the one that we want.
            */
 
-          for (stcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
-               (stcb && stcb->waitsem != sem);
-               stcb = stcb->flink);
+          stcb = (FAR struct tcb_s *)dq_peek(&sem->waitlist);
 
           if (stcb != NULL)
             {
@@ -157,11 +154,10 @@ int nxsem_post(FAR sem_t *sem)
 
               nxsem_addholder_tcb(stcb, sem);
 
-              /* It is, let the task take the semaphore */
-
-              stcb->waitsem = NULL;
-
-              /* Restart the waiting task. */
+              /* Restart the waiting task.  Removing it from the wait list
+               * of the semaphore also ends the wait (tcb->waitsem is
+               * nullified).
+               */
 
               up_unblock_task(stcb);
             }
@@ -112,13 +112,10 @@ void nxsem_recover(FAR struct tcb_s *tcb)
 
       sem->semcount++;
 
-      /* Clear the semaphore to assure that it is not reused.  But leave the
-       * state as TSTATE_WAIT_SEM.  This is necessary because this is a
-       * necessary indication that the TCB still resides in the waiting-for-
-       * semaphore list.
+      /* Leave the state as TSTATE_WAIT_SEM and do not clear the semaphore.
+       * The TCB still resides in the wait list of the semaphore and waitsem
+       * is needed to find that list when the TCB is finally removed from it.
        */
-
-      tcb->waitsem = NULL;
     }
 
   leave_critical_section(flags);
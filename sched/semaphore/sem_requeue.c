@@ -0,0 +1,126 @@
+/****************************************************************************
+ * sched/semaphore/sem_requeue.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <semaphore.h>
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_requeue
+ *
+ * Description:
+ *   Move a thread that is blocked waiting on a semaphore to the wait list
+ *   of another semaphore without waking it up.  The count taken on the
+ *   original semaphore is released as if the semaphore had been posted for
+ *   the thread and a count is taken on the new semaphore as if the thread
+ *   had called nxsem_wait() on it.  When the thread is eventually awakened,
+ *   it returns from its original semaphore wait owning a count on the new
+ *   semaphore.
+ *
+ * Input Parameters:
+ *   wtcb - The TCB of the task waiting on a semaphore
+ *   sem  - The semaphore to wait on instead.  Priority inheritance must be
+ *          disabled for this semaphore:  There is no running thread here
+ *          whose priority could be propagated to the holders.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section and has disabled
+ *   pre-emption.
+ *
+ ****************************************************************************/
+
+void nxsem_requeue(FAR struct tcb_s *wtcb, FAR sem_t *sem)
+{
+  FAR sem_t *from = wtcb->waitsem;
+#ifdef CONFIG_SMP
+  irqstate_t lock;
+#endif
+
+  DEBUGASSERT(wtcb->task_state == TSTATE_WAIT_SEM && from != NULL &&
+              from->semcount < 0 && sem != NULL && sem != from);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  DEBUGASSERT((sem->flags & PRIOINHERIT_FLAGS_DISABLE) != 0);
+
+  /* Restore the correct priority of all threads that hold references to
+   * the original semaphore.
+   */
+
+  nxsem_canceled(wtcb, from);
+#endif
+
+#ifdef CONFIG_SMP
+  /* Lock the tasklists before accessing */
+
+  lock = sched_tasklist_lock();
+#endif
+
+  /* Release the count that was taken on the original semaphore */
+
+  dq_rem((FAR dq_entry_t *)wtcb, TLIST_WAITSEM(wtcb));
+  from->semcount++;
+
+  /* And wait for the new semaphore, in priority order */
+
+  sem->semcount--;
+  wtcb->waitsem = sem;
+  (void)sched_addprioritized(wtcb, TLIST_WAITSEM(wtcb));
+
+#ifdef CONFIG_SMP
+  /* Unlock the tasklists */
+
+  sched_tasklist_unlock(lock);
+#endif
+}
+
+#endif /* CONFIG_PTHREAD_COND_MORPHING */
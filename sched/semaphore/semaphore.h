@@ -73,6 +73,12 @@ void nxsem_initialize(void);
 
 void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 
+/* Move a thread waiting on one semaphore to the wait list of another */
+
+#ifdef CONFIG_PTHREAD_COND_MORPHING
+void nxsem_requeue(FAR struct tcb_s *wtcb, FAR sem_t *sem);
+#endif
+
 /* Handle semaphore timer expiration */
 
 void nxsem_timeout(int argc, wdparm_t pid);
@@ -441,6 +441,116 @@ void spin_unlockr(FAR struct spinlock_s *lock)
 #endif /* CONFIG_SMP */
 }
 
+/****************************************************************************
+ * Name: spin_lockr_irqsave
+ *
+ * Description:
+ *   Disable interrupts on this CPU and take a subsystem-scoped, re-entrant
+ *   spinlock.  This is a light-weight alternative to
+ *   enter_critical_section() for data that is private to one subsystem:
+ *   Other CPUs are stalled only if they attempt to take the same lock.
+ *
+ * Input Parameters:
+ *   lock - A reference to the subsystem spinlock to lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lockr_irqsave().
+ *
+ * Assumptions:
+ *   May be called from the interrupt level.
+ *
+ ****************************************************************************/
+
+irqstate_t spin_lockr_irqsave(FAR struct spinlock_s *lock)
+{
+  irqstate_t flags;
+#ifdef CONFIG_SMP
+  uint8_t cpu;
+#endif
+
+  DEBUGASSERT(lock != NULL);
+
+  /* Disable local interrupts to prevent being re-entered from an interrupt
+   * on the same CPU.
+   */
+
+  flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  /* Do we already hold the lock on this CPU? */
+
+  cpu = this_cpu();
+  if (lock->sp_cpu == cpu)
+    {
+      /* Yes... just increment the number of references we have on the lock */
+
+      lock->sp_count++;
+      DEBUGASSERT(lock->sp_lock == SP_LOCKED && lock->sp_count > 0);
+    }
+  else
+    {
+      /* No.. spin until the other CPU releases the lock.  Interrupts remain
+       * disabled on this CPU so this is safe at the interrupt level.
+       */
+
+      spin_lock(&lock->sp_lock);
+
+      /* Take one count on the lock */
+
+      lock->sp_cpu   = cpu;
+      lock->sp_count = 1;
+    }
+#endif
+
+  return flags;
+}
+
+/****************************************************************************
+ * Name: spin_unlockr_irqrestore
+ *
+ * Description:
+ *   Release one count on a subsystem-scoped spinlock taken by
+ *   spin_lockr_irqsave() and restore the interrupt state.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the subsystem spinlock to unlock.
+ *   flags - The value returned by the matching spin_lockr_irqsave().
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from the interrupt level.
+ *
+ ****************************************************************************/
+
+void spin_unlockr_irqrestore(FAR struct spinlock_s *lock, irqstate_t flags)
+{
+  DEBUGASSERT(lock != NULL);
+
+#ifdef CONFIG_SMP
+  DEBUGASSERT(lock->sp_lock == SP_LOCKED && lock->sp_cpu == this_cpu() &&
+              lock->sp_count > 0);
+
+  if (lock->sp_count <= 1)
+    {
+      /* The count will decrement to zero.  Release the lock. */
+
+      lock->sp_count = 0;
+      lock->sp_cpu   = IMPOSSIBLE_CPU;
+      spin_unlock(&lock->sp_lock);
+    }
+  else
+    {
+      lock->sp_count--;
+    }
+#endif
+
+  up_irq_restore(flags);
+}
+
+#ifdef CONFIG_SMP
 /****************************************************************************
  * Name: spin_setbit
  *
@@ -560,5 +670,6 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
   spin_unlock(setlock);
   up_irq_restore(flags);
 }
+#endif /* CONFIG_SMP */
 
 #endif /* CONFIG_SPINLOCK */
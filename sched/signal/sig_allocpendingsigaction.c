@@ -40,10 +40,12 @@
 #include <nuttx/config.h>
 
 #include <signal.h>
+#include <queue.h>
 #include <assert.h>
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
 
 #include "signal/signal.h"
 
@@ -116,3 +118,61 @@ FAR sigq_t *nxsig_alloc_pendingsigaction(void)
   return sigq;
 }
 
+/****************************************************************************
+ * Name: nxsig_alloc_tcbactions
+ *
+ * Description:
+ *   Allocate the CONFIG_SIG_PREALLOC_TCB pending signal action structures
+ *   of a new thread.  If the allocation fails, the thread uses the shared
+ *   structures only.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SIG_PREALLOC_TCB > 0
+void nxsig_alloc_tcbactions(FAR struct tcb_s *tcb)
+{
+  FAR sigq_t *sigq;
+  int i;
+
+  sq_init(&tcb->sigactfree);
+
+  sigq = (FAR sigq_t *)kmm_malloc(CONFIG_SIG_PREALLOC_TCB * sizeof(sigq_t));
+  tcb->sigactpool = sigq;
+
+  if (sigq != NULL)
+    {
+      for (i = 0; i < CONFIG_SIG_PREALLOC_TCB; i++, sigq++)
+        {
+          sigq->type = SIG_ALLOC_TCB;
+          sq_addlast((FAR sq_entry_t *)sigq, &tcb->sigactfree);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsig_alloc_tcbaction
+ *
+ * Description:
+ *   Allocate a new element for the pending signal action queue of stcb,
+ *   preferably from the structures preallocated in stcb.  Unlike the
+ *   shared structures, these are available from interrupt handlers.
+ *
+ ****************************************************************************/
+
+FAR sigq_t *nxsig_alloc_tcbaction(FAR struct tcb_s *stcb)
+{
+  FAR sigq_t *sigq;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  sigq  = (FAR sigq_t *)sq_remfirst(&stcb->sigactfree);
+  leave_critical_section(flags);
+
+  if (sigq == NULL)
+    {
+      sigq = nxsig_alloc_pendingsigaction();
+    }
+
+  return sigq;
+}
+#endif
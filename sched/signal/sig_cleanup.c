@@ -64,20 +64,23 @@ void nxsig_cleanup(FAR struct tcb_s *stcb)
 
   while ((sigq = (FAR sigq_t *)sq_remfirst(&stcb->sigpendactionq)) != NULL)
     {
-      nxsig_release_pendingsigaction(sigq);
+      nxsig_release_tcbaction(stcb, sigq);
     }
 
   /* Deallocate all entries in the list of posted signal actions */
 
   while ((sigq = (FAR sigq_t *)sq_remfirst(&stcb->sigpostedq)) != NULL)
     {
-      nxsig_release_pendingsigaction(sigq);
+      nxsig_release_tcbaction(stcb, sigq);
     }
 
   /* Misc. signal-related clean-up */
 
   stcb->sigprocmask  = ALL_SIGNAL_SET;
   stcb->sigwaitmask  = NULL_SIGNAL_SET;
+#ifdef CONFIG_SIG_COALESCE
+  stcb->sigactpend   = NULL_SIGNAL_SET;
+#endif
 }
 
 /****************************************************************************
@@ -96,6 +96,16 @@ void nxsig_deliver(FAR struct tcb_s *stcb)
       flags = enter_critical_section();
       sq_rem((FAR sq_entry_t *)sigq, &(stcb->sigpendactionq));
       sq_addlast((FAR sq_entry_t *)sigq, &(stcb->sigpostedq));
+#ifdef CONFIG_SIG_COALESCE
+      /* The signal is no longer pending.  The same signal received from
+       * now on is queued again.
+       */
+
+      if (sigq->info.si_code == SI_USER)
+        {
+          sigdelset(&stcb->sigactpend, sigq->info.si_signo);
+        }
+#endif
       leave_critical_section(flags);
 
       /* Call the signal handler (unless the signal was cancelled)
@@ -174,7 +184,7 @@ void nxsig_deliver(FAR struct tcb_s *stcb)
 
       /* Then deallocate it */
 
-      nxsig_release_pendingsigaction(sigq);
+      nxsig_release_tcbaction(stcb, sigq);
     }
 
   stcb->pterrno = saved_errno;
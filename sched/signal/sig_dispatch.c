@@ -67,7 +67,9 @@
  *   Queue a signal action for delivery to a task.
  *
  * Returned Value:
- *   Returns 0 (OK) on success or a negated errno value on failure.
+ *   Returns 0 (OK) on success or a negated errno value on failure.  One is
+ *   returned if a non-queued signal was merged with the same signal that
+ *   is already pending for the handler (CONFIG_SIG_COALESCE).
  *
  ****************************************************************************/
 
@@ -91,11 +93,34 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
 
   if ((sigact) && (sigact->act.sa_u._sa_sigaction))
     {
+#ifdef CONFIG_SIG_COALESCE
+      /* A signal sent by kill() is not queued.  If it is already pending
+       * for the handler, both are delivered once.
+       */
+
+      if (info->si_code == SI_USER)
+        {
+          flags = enter_critical_section();
+          if (sigismember(&stcb->sigactpend, info->si_signo))
+            {
+              leave_critical_section(flags);
+              sched_unlock();
+              return 1;
+            }
+
+          leave_critical_section(flags);
+        }
+#endif
+
       /* Allocate a new element for the signal queue.  NOTE:
        * nxsig_alloc_pendingsigaction will force a system crash if it is
        * unable to allocate memory for the signal data */
 
+#if CONFIG_SIG_PREALLOC_TCB > 0
+      sigq = nxsig_alloc_tcbaction(stcb);
+#else
       sigq = nxsig_alloc_pendingsigaction();
+#endif
       if (!sigq)
         {
           ret = -ENOMEM;
@@ -112,6 +137,12 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
 
           flags = enter_critical_section();
           sq_addlast((FAR sq_entry_t *)sigq, &(stcb->sigpendactionq));
+#ifdef CONFIG_SIG_COALESCE
+          if (info->si_code == SI_USER)
+            {
+              sigaddset(&stcb->sigactpend, info->si_signo);
+            }
+#endif
           leave_critical_section(flags);
         }
     }
@@ -359,7 +390,20 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
        * up_schedule_sigaction()
        */
 
-      up_schedule_sigaction(stcb, nxsig_deliver);
+#ifdef CONFIG_SIG_COALESCE
+      if (ret > 0)
+        {
+          /* Merged with a pending signal whose delivery is already
+           * scheduled.
+           */
+
+          ret = OK;
+        }
+      else
+#endif
+        {
+          up_schedule_sigaction(stcb, nxsig_deliver);
+        }
 
       /* Check if the task is waiting for an unmasked signal.  If so, then
        * unblock it. This must be performed in a critical section because
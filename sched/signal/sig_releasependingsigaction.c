@@ -99,3 +99,31 @@ void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
       sched_kfree(sigq);
     }
 }
+
+/****************************************************************************
+ * Name: nxsig_release_tcbaction
+ *
+ * Description:
+ *   Deallocate a pending signal action of the thread stcb.  Structures
+ *   preallocated in stcb are returned to stcb; all others are released
+ *   with nxsig_release_pendingsigaction().
+ *
+ ****************************************************************************/
+
+void nxsig_release_tcbaction(FAR struct tcb_s *stcb, FAR sigq_t *sigq)
+{
+#if CONFIG_SIG_PREALLOC_TCB > 0
+  irqstate_t flags;
+
+  if (sigq->type == SIG_ALLOC_TCB)
+    {
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)sigq, &stcb->sigactfree);
+      leave_critical_section(flags);
+    }
+  else
+#endif
+    {
+      nxsig_release_pendingsigaction(sigq);
+    }
+}
@@ -74,7 +74,8 @@ enum sigalloc_e
 {
   SIG_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
   SIG_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  SIG_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  SIG_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  SIG_ALLOC_TCB         /* Preallocated in the TCB of the receiving thread */
 };
 
 /* The following defines the sigaction queue entry */
@@ -201,6 +202,18 @@ void               nxsig_release(FAR struct task_group_s *group);
 void nxsig_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 #endif
 
+/* sig_allocpendingsigaction.c */
+
+#if CONFIG_SIG_PREALLOC_TCB > 0
+void               nxsig_alloc_tcbactions(FAR struct tcb_s *tcb);
+FAR sigq_t        *nxsig_alloc_tcbaction(FAR struct tcb_s *stcb);
+#endif
+
+/* sig_releasependingsigaction.c */
+
+void               nxsig_release_tcbaction(FAR struct tcb_s *stcb,
+                                           FAR sigq_t *sigq);
+
 /* In files of the same name */
 
 FAR sigq_t        *nxsig_alloc_pendingsigaction(void);
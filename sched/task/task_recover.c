@@ -41,6 +41,7 @@
 
 #include <assert.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
 #include <nuttx/sched.h>
@@ -100,4 +101,17 @@ void task_recover(FAR struct tcb_s *tcb)
       DEBUGVERIFY(sched_sporadic_stop(tcb));
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      irqstate_t flags;
+
+      /* Release the bandwidth of the deadline thread */
+
+      flags = enter_critical_section();
+      sched_deadline_stop(tcb);
+      leave_critical_section(flags);
+    }
+#endif
 }
@@ -149,14 +149,22 @@ int task_restart(pid_t pid)
    * should no longer be accessible to the system
    */
 
+  if (tcb->cmn.task_state == TSTATE_WAIT_SEM)
+    {
+      tasklist = TLIST_WAITSEM(&tcb->cmn);
+    }
+  else
+    {
 #ifdef CONFIG_SMP
-  tasklist = TLIST_HEAD(tcb->cmn.task_state, tcb->cmn.cpu);
+      tasklist = TLIST_HEAD(tcb->cmn.task_state, tcb->cmn.cpu);
 #else
-  tasklist = TLIST_HEAD(tcb->cmn.task_state);
+      tasklist = TLIST_HEAD(tcb->cmn.task_state);
 #endif
+    }
 
   dq_rem((FAR dq_entry_t *)tcb, tasklist);
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
+  tcb->cmn.waitsem    = NULL;
 
 #ifndef CONFIG_DISABLE_SIGNALS
   /* Deallocate anything left in the TCB's signal queues */
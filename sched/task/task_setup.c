@@ -52,6 +52,7 @@
 #include "sched/sched.h"
 #include "pthread/pthread.h"
 #include "group/group.h"
+#include "signal/signal.h"
 #include "task/task.h"
 
 /****************************************************************************
@@ -409,6 +410,12 @@ static int thread_schedsetup(FAR struct tcb_s *tcb, int priority,
        */
 
       (void)nxsig_procmask(SIG_SETMASK, NULL, &tcb->sigprocmask);
+
+#if CONFIG_SIG_PREALLOC_TCB > 0
+      /* Allocate the signal actions reserved for this thread */
+
+      nxsig_alloc_tcbactions(tcb);
+#endif
 #endif
 
       /* Initialize the task state.  It does not get a valid state
@@ -145,22 +145,35 @@ int task_terminate(pid_t pid, bool nonblocking)
    */
 
   cpu = sched_cpu_pause(dtcb);
+#endif
+
+  if (dtcb->task_state == TSTATE_WAIT_SEM)
+    {
+      /* The task is waiting in the wait list of a semaphore */
 
-  /* Get the task list associated with the thread's state and CPU */
+      tasklist = TLIST_WAITSEM(dtcb);
+    }
+  else
+    {
+#ifdef CONFIG_SMP
+      /* Get the task list associated with the thread's state and CPU */
 
-  tasklist = TLIST_HEAD(dtcb->task_state, cpu);
+      tasklist = TLIST_HEAD(dtcb->task_state, cpu);
 #else
-  /* In the non-SMP case, we can be assured that the task to be terminated
-   * is not running.  get the task list associated with the task state.
-   */
+      /* In the non-SMP case, we can be assured that the task to be
+       * terminated is not running.  get the task list associated with the
+       * task state.
+       */
 
-  tasklist = TLIST_HEAD(dtcb->task_state);
+      tasklist = TLIST_HEAD(dtcb->task_state);
 #endif
+    }
 
   /* Remove the task from the task list */
 
   dq_rem((FAR dq_entry_t *)dtcb, tasklist);
   dtcb->task_state = TSTATE_TASK_INVALID;
+  dtcb->waitsem    = NULL;
 
   /* At this point, the TCB should no longer be accessible to the system */
 
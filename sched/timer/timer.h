@@ -44,8 +44,10 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/clock.h>
 #include <nuttx/signal.h>
 #include <nuttx/wdog.h>
 
@@ -53,6 +55,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_TIMER_SLACK
+#  define CONFIG_TIMER_SLACK 0
+#endif
+
 #define PT_FLAGS_PREALLOCATED 0x01 /* Timer comes from a pool of preallocated timers */
 
 /****************************************************************************
@@ -73,6 +79,17 @@ struct posix_timer_s
   WDOG_ID          pt_wdog;        /* The watchdog that provides the timing */
   struct sigevent  pt_event;       /* Notification information */
   struct sigwork_s pt_work;
+#if CONFIG_TIMER_SLACK > 0
+  clock_t          pt_expiry;      /* Nominal expiry of a coalesced timer */
+#endif
+#ifdef CONFIG_TIMER_HIRES
+  FAR struct posix_timer_s *pt_hlink; /* Link in the high resolution queue */
+  uint64_t         pt_hexpiry;     /* High resolution expiry (nsec) */
+  uint64_t         pt_hinterval;   /* High resolution reload (nsec) */
+  bool             pt_hactive;     /* In the high resolution queue */
+#endif
+  nxtimer_callback_t pt_callback;  /* Kernel callback instead of pt_event */
+  FAR void        *pt_arg;         /* Argument of pt_callback */
 };
 
 /****************************************************************************
@@ -99,5 +116,15 @@ extern volatile sq_queue_t g_alloctimers;
 void weak_function timer_initialize(void);
 void weak_function timer_deleteall(pid_t pid);
 int timer_release(FAR struct posix_timer_s *timer);
+bool timer_expire(FAR struct posix_timer_s *timer);
+
+#ifdef CONFIG_TIMER_HIRES
+bool timer_hires_available(void);
+int timer_hires_settime(FAR struct posix_timer_s *timer, int flags,
+                        FAR const struct itimerspec *value);
+void timer_hires_cancel(FAR struct posix_timer_s *timer);
+void timer_hires_gettime(FAR struct posix_timer_s *timer,
+                         FAR struct itimerspec *value);
+#endif
 
 #endif /* __SCHED_TIMER_TIMER_H */
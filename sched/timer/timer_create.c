@@ -49,6 +49,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
 
 #include "timer/timer.h"
 
@@ -239,4 +240,55 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp,
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxtimer_create
+ *
+ * Description:
+ *   Create a POSIX timer for use inside the OS.  Instead of delivering a
+ *   signal, the timer calls 'callback' on each expiration.  The callback
+ *   runs in the context of the timer interrupt.  The timer is not owned by
+ *   the calling task and must be deleted with timer_delete().
+ *
+ * Input Parameters:
+ *   callback - The function to call on each expiration
+ *   arg      - The argument that accompanies the callback
+ *   timerid  - The location to return the new timer
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxtimer_create(nxtimer_callback_t callback, FAR void *arg,
+                   FAR timer_t *timerid)
+{
+  FAR struct posix_timer_s *timer;
+  struct sigevent event;
+
+  if (callback == NULL || timerid == NULL)
+    {
+      return -EINVAL;
+    }
+
+  memset(&event, 0, sizeof(struct sigevent));
+  event.sigev_notify = SIGEV_NONE;
+
+  if (timer_create(CLOCK_REALTIME, &event, timerid) < 0)
+    {
+      return -get_errno();
+    }
+
+  timer              = (FAR struct posix_timer_s *)*timerid;
+  timer->pt_callback = callback;
+  timer->pt_arg      = arg;
+
+  /* The timer belongs to the OS, not to the task that happened to create
+   * it, so it must not be deleted by timer_deleteall() when that task
+   * exits.
+   */
+
+  timer->pt_owner    = INVALID_PROCESS_ID;
+  return OK;
+}
+
 #endif /* CONFIG_DISABLE_POSIX_TIMERS */
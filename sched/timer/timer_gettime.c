@@ -94,6 +94,16 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
       return ERROR;
     }
 
+#ifdef CONFIG_TIMER_HIRES
+  /* Timers armed on the oneshot timer keep their own time */
+
+  if (timer->pt_hactive)
+    {
+      timer_hires_gettime(timer, value);
+      return OK;
+    }
+#endif
+
   /* Get the number of ticks before the underlying watchdog expires */
 
   ticks = wd_gettime(timer->pt_wdog);
@@ -0,0 +1,409 @@
+/****************************************************************************
+ * sched/timer/timer_hires.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/timers/oneshot.h>
+
+#include "timer/timer.h"
+
+#ifdef CONFIG_TIMER_HIRES
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void timer_hires_callback(FAR struct oneshot_lowerhalf_s *lower,
+                                 FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The oneshot timer and the queue of armed timers, ordered by expiry.  Both
+ * are protected by the critical section.
+ */
+
+static FAR struct oneshot_lowerhalf_s *g_hires_lower;
+static FAR struct posix_timer_s *g_hires_head;
+static uint64_t g_hires_maxdelay;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: timer_ts2nsec and timer_nsec2ts
+ ****************************************************************************/
+
+static inline uint64_t timer_ts2nsec(FAR const struct timespec *ts)
+{
+  return (uint64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static inline void timer_nsec2ts(uint64_t nsec, FAR struct timespec *ts)
+{
+  ts->tv_sec  = (time_t)(nsec / NSEC_PER_SEC);
+  ts->tv_nsec = (long)(nsec % NSEC_PER_SEC);
+}
+
+/****************************************************************************
+ * Name: timer_hires_now
+ *
+ * Description:
+ *   Return the current time of the oneshot timer in nanoseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t timer_hires_now(void)
+{
+  struct timespec ts;
+
+  DEBUGVERIFY(ONESHOT_CURRENT(g_hires_lower, &ts));
+  return timer_ts2nsec(&ts);
+}
+
+/****************************************************************************
+ * Name: timer_hires_program
+ *
+ * Description:
+ *   (Re-)start the oneshot timer for the earliest armed timer.  Called in a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void timer_hires_program(uint64_t now)
+{
+  struct timespec ts;
+  uint64_t delay;
+
+  (void)ONESHOT_CANCEL(g_hires_lower, &ts);
+
+  if (g_hires_head == NULL)
+    {
+      return;
+    }
+
+  delay = g_hires_head->pt_hexpiry > now ?
+          g_hires_head->pt_hexpiry - now : 0;
+
+  /* Timers further away than the lower half can time are simply
+   * re-evaluated when the oneshot fires.
+   */
+
+  if (delay > g_hires_maxdelay)
+    {
+      delay = g_hires_maxdelay;
+    }
+  else if (delay < NSEC_PER_USEC)
+    {
+      delay = NSEC_PER_USEC;
+    }
+
+  timer_nsec2ts(delay, &ts);
+  DEBUGVERIFY(ONESHOT_START(g_hires_lower, timer_hires_callback, NULL, &ts));
+}
+
+/****************************************************************************
+ * Name: timer_hires_insert
+ *
+ * Description:
+ *   Add a timer to the queue in order of expiry.  Called in a critical
+ *   section.
+ *
+ ****************************************************************************/
+
+static void timer_hires_insert(FAR struct posix_timer_s *timer)
+{
+  FAR struct posix_timer_s *prev;
+  FAR struct posix_timer_s *curr;
+
+  for (prev = NULL, curr = g_hires_head;
+       curr != NULL && curr->pt_hexpiry <= timer->pt_hexpiry;
+       prev = curr, curr = curr->pt_hlink);
+
+  timer->pt_hlink = curr;
+  if (prev != NULL)
+    {
+      prev->pt_hlink = timer;
+    }
+  else
+    {
+      g_hires_head = timer;
+    }
+
+  timer->pt_hactive = true;
+}
+
+/****************************************************************************
+ * Name: timer_hires_callback
+ *
+ * Description:
+ *   The oneshot timer expired:  Notify every timer that is due, re-queue
+ *   the periodic ones and restart the oneshot for the next.
+ *
+ ****************************************************************************/
+
+static void timer_hires_callback(FAR struct oneshot_lowerhalf_s *lower,
+                                 FAR void *arg)
+{
+  FAR struct posix_timer_s *timer;
+  irqstate_t flags;
+  uint64_t now;
+
+  flags = enter_critical_section();
+  now   = timer_hires_now();
+
+  while ((timer = g_hires_head) != NULL && timer->pt_hexpiry <= now)
+    {
+      g_hires_head      = timer->pt_hlink;
+      timer->pt_hactive = false;
+
+      if (timer_expire(timer) && timer->pt_hinterval > 0 &&
+          !timer->pt_hactive)
+        {
+          /* Advance by whole periods so that the period does not drift.
+           * Expirations that were missed altogether are skipped.
+           */
+
+          timer->pt_hexpiry += timer->pt_hinterval;
+          if (timer->pt_hexpiry <= now)
+            {
+              timer->pt_hexpiry += ((now - timer->pt_hexpiry) /
+                                    timer->pt_hinterval + 1) *
+                                   timer->pt_hinterval;
+            }
+
+          timer_hires_insert(timer);
+        }
+    }
+
+  timer_hires_program(now);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  timer_hires_initialize
+ *
+ * Description:
+ *   Drive POSIX timers from a oneshot timer as described in
+ *   include/nuttx/timers/oneshot.h.  The oneshot timer must support the
+ *   current() method.  Timers armed after this call have the resolution of
+ *   the oneshot timer instead of the system tick.
+ *
+ * Input Parameters:
+ *   lower - An instance of the oneshot timer interface as defined in
+ *           include/nuttx/timers/oneshot.h
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int timer_hires_initialize(FAR struct oneshot_lowerhalf_s *lower)
+{
+  struct timespec ts;
+  int ret;
+
+  if (lower == NULL || lower->ops->current == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = ONESHOT_MAX_DELAY(lower, &ts);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  g_hires_maxdelay = timer_ts2nsec(&ts);
+  g_hires_lower    = lower;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: timer_hires_available
+ *
+ * Description:
+ *   Return true if a oneshot timer has been provided.
+ *
+ ****************************************************************************/
+
+bool timer_hires_available(void)
+{
+  return g_hires_lower != NULL;
+}
+
+/****************************************************************************
+ * Name: timer_hires_settime
+ *
+ * Description:
+ *   Arm a timer on the oneshot timer.  The timer has already been disarmed
+ *   and 'value' holds a non-zero it_value.
+ *
+ ****************************************************************************/
+
+int timer_hires_settime(FAR struct posix_timer_s *timer, int flags,
+                        FAR const struct itimerspec *value)
+{
+  struct timespec ts;
+  irqstate_t intflags;
+  uint64_t expiry;
+  uint64_t now;
+
+  if (value->it_value.tv_nsec < 0 || value->it_value.tv_nsec >= NSEC_PER_SEC ||
+      value->it_interval.tv_nsec < 0 ||
+      value->it_interval.tv_nsec >= NSEC_PER_SEC)
+    {
+      return -EINVAL;
+    }
+
+  timer->pt_hinterval = timer_ts2nsec(&value->it_interval);
+  expiry              = timer_ts2nsec(&value->it_value);
+
+  if ((flags & TIMER_ABSTIME) != 0)
+    {
+      /* Convert the absolute CLOCK_REALTIME time to a delay.  A time in the
+       * past expires at once.
+       */
+
+      (void)clock_gettime(CLOCK_REALTIME, &ts);
+      now    = timer_ts2nsec(&ts);
+      expiry = expiry > now ? expiry - now : 0;
+    }
+
+  intflags          = enter_critical_section();
+  now               = timer_hires_now();
+  timer->pt_hexpiry = now + expiry;
+  timer_hires_insert(timer);
+
+  if (g_hires_head == timer)
+    {
+      timer_hires_program(now);
+    }
+
+  leave_critical_section(intflags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: timer_hires_cancel
+ *
+ * Description:
+ *   Remove a timer from the queue if it is armed.
+ *
+ ****************************************************************************/
+
+void timer_hires_cancel(FAR struct posix_timer_s *timer)
+{
+  FAR struct posix_timer_s *prev;
+  FAR struct posix_timer_s *curr;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (timer->pt_hactive)
+    {
+      for (prev = NULL, curr = g_hires_head;
+           curr != NULL && curr != timer;
+           prev = curr, curr = curr->pt_hlink);
+
+      DEBUGASSERT(curr == timer);
+      if (prev != NULL)
+        {
+          prev->pt_hlink = timer->pt_hlink;
+        }
+      else
+        {
+          /* The earliest timer changed */
+
+          g_hires_head = timer->pt_hlink;
+          timer_hires_program(timer_hires_now());
+        }
+
+      timer->pt_hactive = false;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: timer_hires_gettime
+ *
+ * Description:
+ *   Return the time remaining and the reload value of a timer armed on the
+ *   oneshot timer.
+ *
+ ****************************************************************************/
+
+void timer_hires_gettime(FAR struct posix_timer_s *timer,
+                         FAR struct itimerspec *value)
+{
+  irqstate_t flags;
+  uint64_t remaining = 0;
+  uint64_t now;
+
+  flags = enter_critical_section();
+  if (timer->pt_hactive)
+    {
+      now = timer_hires_now();
+      if (timer->pt_hexpiry > now)
+        {
+          remaining = timer->pt_hexpiry - now;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  timer_nsec2ts(remaining, &value->it_value);
+  timer_nsec2ts(timer->pt_hinterval, &value->it_interval);
+}
+
+#endif /* CONFIG_TIMER_HIRES */
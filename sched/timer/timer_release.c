@@ -139,6 +139,9 @@ int timer_release(FAR struct posix_timer_s *timer)
    */
 
   (void)wd_delete(timer->pt_wdog);
+#ifdef CONFIG_TIMER_HIRES
+  timer_hires_cancel(timer);
+#endif
 
   /* Cancel any pending notification */
 
@@ -89,6 +89,29 @@ static inline void timer_signotify(FAR struct posix_timer_s *timer)
                                  SI_TIMER, &timer->pt_work));
 }
 
+/****************************************************************************
+ * Name: timer_slackdelay
+ *
+ * Description:
+ *   Return the delay to the first tick at or after 'expiry' that is a
+ *   multiple of CONFIG_TIMER_SLACK.  All coalesced timers expiring within
+ *   the same window then share one timer interrupt.
+ *
+ ****************************************************************************/
+
+#if CONFIG_TIMER_SLACK > 0
+static inline sclock_t timer_slackdelay(clock_t expiry)
+{
+  sclock_t delay;
+
+  expiry += CONFIG_TIMER_SLACK - 1;
+  expiry -= expiry % CONFIG_TIMER_SLACK;
+
+  delay = (sclock_t)(expiry - clock_systimer());
+  return delay > 0 ? delay : 1;
+}
+#endif
+
 /****************************************************************************
  * Name: timer_restart
  *
@@ -113,8 +136,19 @@ static inline void timer_restart(FAR struct posix_timer_s *timer,
 
   if (timer->pt_delay)
     {
+      sclock_t delay = timer->pt_delay;
+
+#if CONFIG_TIMER_SLACK > 0
+      /* Advance the nominal expiry so that rounding does not accumulate
+       * into the period.
+       */
+
+      timer->pt_expiry += timer->pt_delay;
+      delay = timer_slackdelay(timer->pt_expiry);
+#endif
+
       timer->pt_last = timer->pt_delay;
-      (void)wd_start(timer->pt_wdog, timer->pt_delay,
+      (void)wd_start(timer->pt_wdog, delay,
                      (wdentry_t)timer_timeout, 1, itimer);
     }
 }
@@ -155,19 +189,11 @@ static void timer_timeout(int argc, wdparm_t itimer)
 
   u.itimer = itimer;
 
-  /* Send the specified signal to the specified task.   Increment the
-   * reference count on the timer first so that will not be deleted until
-   * after the signal handler returns.
+  /* Send the specified signal to the specified task.  timer_expire() will
+   * return true if the timer was not deleted.
    */
 
-  u.timer->pt_crefs++;
-  timer_signotify(u.timer);
-
-  /* Release the reference.  timer_release will return nonzero if the timer
-   * was not deleted.
-   */
-
-  if (timer_release(u.timer))
+  if (timer_expire(u.timer))
     {
       /* If this is a repetitive timer, then restart the watchdog */
 
@@ -176,19 +202,11 @@ static void timer_timeout(int argc, wdparm_t itimer)
 #else
   FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)itimer;
 
-  /* Send the specified signal to the specified task.   Increment the
-   * reference count on the timer first so that will not be deleted until
-   * after the signal handler returns.
-   */
-
-  timer->pt_crefs++;
-  timer_signotify(timer);
-
-  /* Release the reference.  timer_release will return nonzero if the timer
-   * was not deleted.
+  /* Send the specified signal to the specified task.  timer_expire() will
+   * return true if the timer was not deleted.
    */
 
-  if (timer_release(timer))
+  if (timer_expire(timer))
     {
       /* If this is a repetitive timer, the restart the watchdog */
 
@@ -201,6 +219,45 @@ static void timer_timeout(int argc, wdparm_t itimer)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: timer_expire
+ *
+ * Description:
+ *   Deliver the notification of one expiration of a POSIX timer.  The
+ *   reference count on the timer is incremented first so that it will not
+ *   be deleted until after the notification has been delivered.
+ *
+ * Input Parameters:
+ *   timer - A reference to the POSIX timer that just timed out
+ *
+ * Returned Value:
+ *   True if the timer still exists and may be restarted.
+ *
+ * Assumptions:
+ *   This function executes in the context of the timer interrupt.
+ *
+ ****************************************************************************/
+
+bool timer_expire(FAR struct posix_timer_s *timer)
+{
+  timer->pt_crefs++;
+
+  if (timer->pt_callback != NULL)
+    {
+      timer->pt_callback(timer->pt_arg);
+    }
+  else
+    {
+      timer_signotify(timer);
+    }
+
+  /* Release the reference.  timer_release will return nonzero if the timer
+   * was not deleted.
+   */
+
+  return timer_release(timer) != 0;
+}
+
 /****************************************************************************
  * Name: timer_settime
  *
@@ -287,6 +344,9 @@ int timer_settime(timer_t timerid, int flags,
    */
 
   (void)wd_cancel(timer->pt_wdog);
+#ifdef CONFIG_TIMER_HIRES
+  timer_hires_cancel(timer);
+#endif
 
   /* Cancel any pending notification */
 
@@ -299,6 +359,22 @@ int timer_settime(timer_t timerid, int flags,
       return OK;
     }
 
+#ifdef CONFIG_TIMER_HIRES
+  /* Use the oneshot timer instead of a watchdog if one has been provided */
+
+  if (timer_hires_available())
+    {
+      ret = timer_hires_settime(timer, flags, value);
+      if (ret < 0)
+        {
+          set_errno(-ret);
+          return ERROR;
+        }
+
+      return OK;
+    }
+#endif
+
   /* Setup up any repetitive timer */
 
   if (value->it_interval.tv_sec > 0 || value->it_interval.tv_nsec > 0)
@@ -359,6 +435,12 @@ int timer_settime(timer_t timerid, int flags,
        */
 
       timer->pt_last = delay;
+
+#if CONFIG_TIMER_SLACK > 0
+      timer->pt_expiry = clock_systimer() + delay;
+      delay = timer_slackdelay(timer->pt_expiry);
+#endif
+
       ret = wd_start(timer->pt_wdog, delay, (wdentry_t)timer_timeout,
                      1, (uint32_t)((wdparm_t)timer));
       if (ret < 0)
@@ -73,8 +73,10 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifndef CONFIG_WDOG_TIMING_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -82,7 +84,7 @@ int wd_cancel(WDOG_ID wdog)
    * cancellation is complete
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
 
   /* Make sure that the watchdog is initialized (non-NULL) and is still
    * active.
@@ -90,6 +92,11 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+      /* Just unlink the watchdog from its slot of the timing wheel */
+
+      wd_wheel_remove(wdog);
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -139,6 +146,7 @@ int wd_cancel(WDOG_ID wdog)
 
           sched_timer_reassess();
         }
+#endif /* CONFIG_WDOG_TIMING_WHEEL */
 
       /* Mark the watchdog inactive */
 
@@ -150,6 +158,6 @@ int wd_cancel(WDOG_ID wdog)
       ret = OK;
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return ret;
 }
@@ -39,6 +39,8 @@
 
 #include <nuttx/config.h>
 
+#include <limits.h>
+
 #include <nuttx/wdog.h>
 #include <nuttx/irq.h>
 
@@ -71,9 +73,17 @@ int wd_gettime(WDOG_ID wdog)
 
   /* Verify the wdog */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+      /* The lag holds the absolute expiration tick */
+
+      int delay = (int)((unsigned int)wdog->lag - g_wdtick);
+
+      wd_unlock(flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -89,12 +99,76 @@ int wd_gettime(WDOG_ID wdog)
           if (curr == wdog)
             {
               delay -= wd_elapse();
-              leave_critical_section(flags);
+              wd_unlock(flags);
               return delay;
             }
         }
+#endif
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return 0;
 }
+
+/****************************************************************************
+ * Name: wd_nexttime
+ *
+ * Description:
+ *   This function returns the time remaining before the next active
+ *   watchdog timer expires.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the next watchdog expires.
+ *   INT_MAX is returned if no watchdog is active.
+ *
+ ****************************************************************************/
+
+int wd_nexttime(void)
+{
+  irqstate_t flags;
+  int next = INT_MAX;
+
+  flags = wd_lock();
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+  {
+    FAR struct wdog_s *curr;
+    unsigned int ndx;
+
+    /* Visit the slots in the order of their next expiration tick.  A
+     * watchdog that expires 'ndx' ticks from now is in slot 'ndx', so the
+     * search ends with the first one found in its own slot.  Watchdogs
+     * that are more than one wheel revolution away are also found in
+     * the slots that are visited.
+     */
+
+    for (ndx = 0; ndx < WDOG_WHEEL_NSLOTS && next > (int)ndx; ndx++)
+      {
+        for (curr = wd_slot(g_wdtick + ndx)->head;
+             curr != NULL;
+             curr = curr->next)
+          {
+            int delay = (int)((unsigned int)curr->lag - g_wdtick);
+
+            if (delay < next)
+              {
+                next = delay;
+              }
+          }
+      }
+  }
+#else
+  /* The first watchdog in the list expires first */
+
+  if (g_wdactivelist.head != NULL)
+    {
+      next = ((FAR struct wdog_s *)g_wdactivelist.head)->lag - wd_elapse();
+    }
+#endif
+
+  wd_unlock(flags);
+  return next < 0 ? 0 : next;
+}
@@ -53,12 +53,25 @@
 
 sq_queue_t g_wdfreelist;
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* The timing wheel of active watchdogs and the current wheel tick */
+
+struct wd_slot_s g_wdwheel[WDOG_WHEEL_NSLOTS];
+unsigned int g_wdtick;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
+#endif
+
+/* The spinlock that protects g_wdactivelist in the SMP case */
+
+#ifdef WDOG_SPINLOCK
+struct spinlock_s g_wdspinlock SP_SECTION = SP_INITIALIZER;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -116,7 +129,17 @@ void wd_initialize(void)
   /* Initialize watchdog lists */
 
   sq_init(&g_wdfreelist);
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+  for (i = 0; i < WDOG_WHEEL_NSLOTS; i++)
+    {
+      g_wdwheel[i].head = NULL;
+      g_wdwheel[i].tail = NULL;
+    }
+
+  g_wdtick = 0;
+#else
   sq_init(&g_wdactivelist);
+#endif
 
   /* The g_wdfreelist must be loaded at initialization time to hold the
    * configured number of watchdogs.
@@ -91,6 +91,63 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_callback
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void wd_callback(FAR struct wdog_s *wdog)
+{
+  /* Execute the watchdog function */
+
+  up_setpicbase(wdog->picbase);
+  switch (wdog->argc)
+    {
+      default:
+        DEBUGPANIC();
+        break;
+
+      case 0:
+        (*((wdentry0_t)(wdog->func)))(0);
+        break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+      case 1:
+        (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+      case 2:
+        (*((wdentry2_t)(wdog->func)))(2,
+                        wdog->parm[0], wdog->parm[1]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+      case 3:
+        (*((wdentry3_t)(wdog->func)))(3,
+                        wdog->parm[0], wdog->parm[1],
+                        wdog->parm[2]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+      case 4:
+        (*((wdentry4_t)(wdog->func)))(4,
+                        wdog->parm[0], wdog->parm[1],
+                        wdog->parm[2], wdog->parm[3]);
+        break;
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -98,17 +155,76 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run.  If so, remove the watchdog from the list and execute it.
  *
+ *   With the timing wheel, check all watchdogs in the slot of the current
+ *   tick instead.
+ *
  * Input Parameters:
- *   None
+ *   flags - The value returned by wd_lock().  In the SMP case the watchdog
+ *     lock is released while the watchdog function executes.
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-static inline void wd_expiration(void)
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+static inline void wd_expiration(FAR irqstate_t *flags)
+{
+  FAR struct wd_slot_s *slot = wd_slot(g_wdtick);
+  FAR struct wdog_s *wdog;
+#ifdef WDOG_SPINLOCK
+  struct wdog_s expired;
+#endif
+
+  wdog = slot->head;
+  while (wdog != NULL)
+    {
+      /* The slot also holds watchdogs that expire on a later turn of the
+       * wheel.
+       */
+
+      if ((int)((unsigned int)wdog->lag - g_wdtick) > 0)
+        {
+          wdog = wdog->next;
+          continue;
+        }
+
+      /* Remove the watchdog from the wheel and indicate that it is no
+       * longer active.
+       */
+
+      wd_wheel_remove(wdog);
+      WDOG_CLRACTIVE(wdog);
+
+#ifdef WDOG_SPINLOCK
+      /* The watchdog function may start or cancel watchdogs (possibly
+       * this same one from another CPU), so we must not hold the
+       * watchdog lock while it runs.  Work on a copy of the watchdog.
+       */
+
+      expired = *wdog;
+      wdog    = &expired;
+      wd_unlock(*flags);
+#endif
+
+      wd_callback(wdog);
+
+#ifdef WDOG_SPINLOCK
+      *flags = wd_lock();
+#endif
+
+      /* The watchdog function may have modified the slot.  Start over. */
+
+      wdog = slot->head;
+    }
+}
+#else
+static inline void wd_expiration(FAR irqstate_t *flags)
 {
   FAR struct wdog_s *wdog;
+#ifdef WDOG_SPINLOCK
+  struct wdog_s expired;
+#endif
 
   /* Check if the watchdog at the head of the list is ready to run */
 
@@ -138,48 +254,26 @@ static inline void wd_expiration(void)
 
           WDOG_CLRACTIVE(wdog);
 
-          /* Execute the watchdog function */
+#ifdef WDOG_SPINLOCK
+          /* The watchdog function may start or cancel watchdogs (possibly
+           * this same one from another CPU), so we must not hold the
+           * watchdog lock while it runs.  Work on a copy of the watchdog.
+           */
 
-          up_setpicbase(wdog->picbase);
-          switch (wdog->argc)
-            {
-              default:
-                DEBUGPANIC();
-                break;
+          expired = *wdog;
+          wdog    = &expired;
+          wd_unlock(*flags);
+#endif
 
-              case 0:
-                (*((wdentry0_t)(wdog->func)))(0);
-                break;
+          wd_callback(wdog);
 
-#if CONFIG_MAX_WDOGPARMS > 0
-              case 1:
-                (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-              case 2:
-                (*((wdentry2_t)(wdog->func)))(2,
-                                wdog->parm[0], wdog->parm[1]);
-                break;
+#ifdef WDOG_SPINLOCK
+          *flags = wd_lock();
 #endif
-#if CONFIG_MAX_WDOGPARMS > 2
-              case 3:
-                (*((wdentry3_t)(wdog->func)))(3,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 3
-              case 4:
-                (*((wdentry4_t)(wdog->func)))(4,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2], wdog->parm[3]);
-                break;
-#endif
-            }
         }
     }
 }
+#endif /* CONFIG_WDOG_TIMING_WHEEL */
 
 /****************************************************************************
  * Public Functions
@@ -222,10 +316,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
+#ifndef CONFIG_WDOG_TIMING_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
   int i;
 
@@ -242,7 +338,7 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
    * the critical section is established.
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (WDOG_ISACTIVE(wdog))
     {
       wd_cancel(wdog);
@@ -278,6 +374,12 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
       delay--;
     }
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+  /* Hash the watchdog into the slot of its expiration tick */
+
+  wdog->lag = (int)(g_wdtick + (unsigned int)delay);
+  wd_wheel_insert(wdog);
+#else
 #ifdef CONFIG_SCHED_TICKLESS
   /* Cancel the interval timer that drives the timing events.  This will cause
    * wd_timer to be called which update the delay value for the first time
@@ -379,9 +481,13 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
         }
     }
 
-  /* Put the lag into the watchdog structure and mark it as active. */
+  /* Put the lag into the watchdog structure */
 
   wdog->lag = delay;
+#endif /* CONFIG_WDOG_TIMING_WHEEL */
+
+  /* Mark the watchdog as active. */
+
   WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -393,7 +499,7 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
   sched_timer_resume();
 #endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return OK;
 }
 
@@ -473,7 +579,7 @@ unsigned int wd_timer(int ticks)
 
       /* Check if the watchdog at the head of the list is ready to run */
 
-      wd_expiration();
+      wd_expiration(NULL);
     }
 
   /* Update clock tickbase */
@@ -497,6 +603,9 @@ unsigned int wd_timer(int ticks)
 #else
 void wd_timer(void)
 {
+#ifdef WDOG_SPINLOCK
+  irqstate_t lock;
+#endif
 #ifdef CONFIG_SMP
   irqstate_t flags;
 
@@ -512,6 +621,25 @@ void wd_timer(void)
   flags = enter_critical_section();
 #endif
 
+#ifdef WDOG_SPINLOCK
+  /* The list of active watchdogs has its own lock */
+
+  lock = wd_lock();
+#endif
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+  /* Advance the wheel by one tick and run the watchdogs that expire on
+   * this tick.
+   */
+
+  g_wdtick++;
+
+#ifdef WDOG_SPINLOCK
+  wd_expiration(&lock);
+#else
+  wd_expiration(NULL);
+#endif
+#else
   /* Check if there are any active watchdogs to process */
 
   if (g_wdactivelist.head)
@@ -522,8 +650,17 @@ void wd_timer(void)
 
       /* Check if the watchdog at the head of the list is ready to run */
 
-      wd_expiration();
+#ifdef WDOG_SPINLOCK
+      wd_expiration(&lock);
+#else
+      wd_expiration(NULL);
+#endif
     }
+#endif /* CONFIG_WDOG_TIMING_WHEEL */
+
+#ifdef WDOG_SPINLOCK
+  wd_unlock(lock);
+#endif
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
@@ -0,0 +1,137 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog to the tail of the slot of the timing wheel selected by
+ *   its expiration tick (wdog->lag).  Watchdogs that expire on the same
+ *   tick are then executed in the order in which they were started.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to be inserted
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called with the watchdog lock held (see wd_lock()).
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  FAR struct wd_slot_s *slot = wd_slot(wdog->lag);
+
+  wdog->next = NULL;
+  wdog->prev = slot->tail;
+
+  if (slot->tail != NULL)
+    {
+      slot->tail->next = wdog;
+    }
+  else
+    {
+      slot->head = wdog;
+    }
+
+  slot->tail = wdog;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove a watchdog from its slot of the timing wheel.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to be removed
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called with the watchdog lock held (see wd_lock()).  The watchdog
+ *   is in the timing wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  FAR struct wd_slot_s *slot = wd_slot(wdog->lag);
+
+  if (wdog->prev != NULL)
+    {
+      wdog->prev->next = wdog->next;
+    }
+  else
+    {
+      slot->head = wdog->next;
+    }
+
+  if (wdog->next != NULL)
+    {
+      wdog->next->prev = wdog->prev;
+    }
+  else
+    {
+      slot->tail = wdog->prev;
+    }
+
+  wdog->next = NULL;
+  wdog->prev = NULL;
+}
+
+#endif /* CONFIG_WDOG_TIMING_WHEEL */
@@ -47,12 +47,46 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* In the SMP case, the list of active watchdogs is protected by its own
+ * spinlock so that starting or cancelling a watchdog on one CPU does not
+ * stall the other CPUs in enter_critical_section().  This is not possible
+ * in the tickless case because the interval timer logic called from
+ * wd_start() and wd_cancel() depends on the critical section.
+ *
+ * wd_lock() and wd_unlock() protect only g_wdactivelist (or the timing
+ * wheel).  Watchdog
+ * functions are still called from within the critical section.
+ */
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+#  define WDOG_SPINLOCK 1
+#  define wd_lock()        spin_lockr_irqsave(&g_wdspinlock)
+#  define wd_unlock(flags) spin_unlockr_irqrestore(&g_wdspinlock, flags)
+#else
+#  undef  WDOG_SPINLOCK
+#  define wd_lock()        enter_critical_section()
+#  define wd_unlock(flags) leave_critical_section(flags)
+#endif
+
+/* The timing wheel has WDOG_WHEEL_NSLOTS slots.  A watchdog that expires
+ * at tick 't' is kept in slot wd_slot(t).  In this case, the lag field of
+ * the watchdog holds the absolute expiration tick instead of a delta.
+ */
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+#  define WDOG_WHEEL_NSLOTS (1 << CONFIG_WDOG_WHEEL_ORDER)
+#  define WDOG_WHEEL_MASK   (WDOG_WHEEL_NSLOTS - 1)
+#  define wd_slot(t)        (&g_wdwheel[(unsigned int)(t) & WDOG_WHEEL_MASK])
+#endif
+
 /****************************************************************************
  * Name: wd_elapse
  *
@@ -70,6 +104,22 @@
 #  define wd_elapse() (0)
 #endif
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* One slot of the timing wheel:  A doubly linked list of the watchdogs
+ * hashed into the slot, in the order in which they were started.
+ */
+
+struct wd_slot_s
+{
+  FAR struct wdog_s *head;
+  FAR struct wdog_s *tail;
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -88,12 +138,27 @@ extern "C"
 
 extern sq_queue_t g_wdfreelist;
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* The timing wheel of active watchdogs and the current wheel tick (the
+ * number of calls to wd_timer()).
+ */
+
+extern struct wd_slot_s g_wdwheel[WDOG_WHEEL_NSLOTS];
+extern unsigned int g_wdtick;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
+
+/* The spinlock that protects g_wdactivelist (see wd_lock()) */
+
+#ifdef WDOG_SPINLOCK
+extern struct spinlock_s g_wdspinlock;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -188,6 +253,29 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_insert and wd_wheel_remove
+ *
+ * Description:
+ *   Add a watchdog to (or remove it from) the slot of the timing wheel
+ *   selected by its expiration tick (wdog->lag).
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to be inserted or removed
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called with the watchdog lock held (see wd_lock()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+void wd_wheel_insert(FAR struct wdog_s *wdog);
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -92,6 +92,18 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   flags = enter_critical_section();
   if (work->worker != NULL)
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_WDOG
+      /* Delayed work is not in the work queue until its timer expires */
+
+      if (WDOG_ISACTIVE(&work->timer))
+        {
+          (void)wd_cancel(&work->timer);
+          work->worker = NULL;
+          leave_critical_section(flags);
+          return OK;
+        }
+
+#endif
       /* A little test of the integrity of the work queue */
 
       DEBUGASSERT(work->dq.flink != NULL ||
@@ -125,7 +137,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
  *   by calling work_queue() again.
  *
  * Input Parameters:
- *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   qid    - The work queue ID (HPWORK, LPWORK or a work pool)
  *   work   - The previously queue work structure to cancel
  *
  * Returned Value:
@@ -156,6 +168,15 @@ int work_cancel(int qid, FAR struct work_s *work)
       return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
     }
   else
+#endif
+#ifdef HAVE_WORKPOOLS
+  if (work_pool(qid) != NULL)
+    {
+      /* Cancel work from a work pool */
+
+      return work_qcancel((FAR struct kwork_wqueue_s *)work_pool(qid), work);
+    }
+  else
 #endif
     {
       return -EINVAL;
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * sched/wqueue/kwork_cpu.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/wqueue.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_CPUWORK)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if !defined(HAVE_WORKPOOLS) || CONFIG_SCHED_WORKPOOLS < CONFIG_SMP_NCPUS
+#  error CONFIG_SCHED_CPUWORK needs one work pool for each CPU
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The work queue ID of the pool of each CPU.  Zero: Not yet created */
+
+static int16_t g_cpuwork[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_cpustart
+ *
+ * Description:
+ *   Create the per-CPU work queues:  One work pool for each CPU, served by
+ *   a single worker thread that may only run on that CPU.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int work_cpustart(void)
+{
+  struct work_poolattr_s attr;
+  int qid;
+  int cpu;
+
+  attr.name      = CPUWORKNAME;
+  attr.priority  = CONFIG_SCHED_CPUWORKPRIORITY;
+  attr.nthreads  = 1;
+  attr.stacksize = CONFIG_SCHED_CPUWORKSTACKSIZE;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      CPU_ZERO(&attr.affinity);
+      CPU_SET(cpu, &attr.affinity);
+
+      qid = work_pool_create(&attr);
+      if (qid < 0)
+        {
+          serr("ERROR: work_pool_create for CPU%d failed: %d\n", cpu, qid);
+          return qid;
+        }
+
+      g_cpuwork[cpu] = qid;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: work_cpuqid
+ *
+ * Description:
+ *   Return the ID of the per-CPU work queue selected by a hash value.
+ *
+ * Input Parameters:
+ *   hash - A hash of the object that the work is for
+ *
+ * Returned Value:
+ *   The work queue ID is returned on success.  -EAGAIN is returned if the
+ *   per-CPU work queues have not been started yet.
+ *
+ ****************************************************************************/
+
+int work_cpuqid(uint32_t hash)
+{
+  int qid = g_cpuwork[hash % CONFIG_SMP_NCPUS];
+  return qid > 0 ? qid : -EAGAIN;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE && CONFIG_SCHED_CPUWORK */
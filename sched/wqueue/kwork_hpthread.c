@@ -46,11 +46,13 @@
 #include <queue.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
 
+#include "sched/sched.h"
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_HPWORK
@@ -210,6 +212,20 @@ int work_hpstart(void)
 
       g_hpwork.worker[wndx].pid  = pid;
       g_hpwork.worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_HPWORKAFFINITY
+      /* Spread the worker threads across the CPUs so that work queued
+       * while one worker is busy can be serviced in parallel.
+       */
+
+      {
+        cpu_set_t cpuset;
+
+        CPU_ZERO(&cpuset);
+        CPU_SET(sched_cpu_housekeeping(wndx), &cpuset);
+        nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+      }
+#endif
     }
 
   sched_unlock();
@@ -46,11 +46,13 @@
 #include <queue.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
 
+#include "sched/sched.h"
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_LPWORK
@@ -206,6 +208,20 @@ int work_lpstart(void)
 
       g_lpwork.worker[wndx].pid  = pid;
       g_lpwork.worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_LPWORKAFFINITY
+      /* Spread the worker threads across the CPUs so that work queued
+       * while one worker is busy can be serviced in parallel.
+       */
+
+      {
+        cpu_set_t cpuset;
+
+        CPU_ZERO(&cpuset);
+        CPU_SET(sched_cpu_housekeeping(wndx), &cpuset);
+        nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+      }
+#endif
     }
 
   sched_unlock();
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * sched/wqueue/kwork_pool.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <queue.h>
+#include <debug.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/kthread.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(HAVE_WORKPOOLS)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The state of the kernel mode work pools */
+
+struct kwork_pool_s g_workpool[CONFIG_SCHED_WORKPOOLS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_poolthread
+ *
+ * Description:
+ *   These are the worker threads of a work pool.  The index of the pool is
+ *   passed in argv[1].  Unlike the low priority work queue, no thread of a
+ *   pool performs garbage collection.
+ *
+ * Input Parameters:
+ *   argc, argv (not used)
+ *
+ * Returned Value:
+ *   Does not return
+ *
+ ****************************************************************************/
+
+static int work_poolthread(int argc, char *argv[])
+{
+  FAR struct kwork_pool_s *pool;
+  pid_t me = getpid();
+  int wndx;
+
+  DEBUGASSERT(argc > 1);
+  pool = &g_workpool[atoi(argv[1])];
+
+  /* Find out thread index by search the workers of the pool.  The creator
+   * holds the scheduler locked until all pids have been recorded.
+   */
+
+  for (wndx = 0; wndx < CONFIG_SCHED_WORKPOOL_NTHREADS; wndx++)
+    {
+      if (pool->worker[wndx].pid == me)
+        {
+          break;
+        }
+    }
+
+  DEBUGASSERT(wndx < CONFIG_SCHED_WORKPOOL_NTHREADS);
+
+  /* Loop forever */
+
+  for (; ; )
+    {
+      /* Process queued work.  work_process will not return until: (1) there
+       * is no further work in the work queue, and (2) signal is triggered,
+       * or delayed work expires.
+       */
+
+      work_process((FAR struct kwork_wqueue_s *)pool, wndx);
+    }
+
+  return OK; /* To keep some compilers happy */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_pool_create
+ *
+ * Description:
+ *   Create a named pool of kernel worker threads serving their own work
+ *   queue.
+ *
+ * Input Parameters:
+ *   attr - Describes the pool
+ *
+ * Returned Value:
+ *   The work queue ID of the new pool is returned on success.  A negated
+ *   errno value is returned on failure:
+ *
+ *   -EINVAL - The attributes are invalid
+ *   -ENOSPC - All CONFIG_SCHED_WORKPOOLS pools have already been created
+ *
+ ****************************************************************************/
+
+int work_pool_create(FAR const struct work_poolattr_s *attr)
+{
+  FAR struct kwork_pool_s *pool;
+  FAR char *argv[2];
+  char arg1[8];
+  pid_t pid;
+  int index;
+  int wndx;
+
+  if (attr == NULL || attr->nthreads < 1 ||
+      attr->nthreads > CONFIG_SCHED_WORKPOOL_NTHREADS)
+    {
+      return -EINVAL;
+    }
+
+  /* Don't permit any of the threads to run until we have fully initialized
+   * the pool.
+   */
+
+  sched_lock();
+
+  /* Find an unused pool.  A pool is in use once any thread has been
+   * created for it.
+   */
+
+  for (index = 0; index < CONFIG_SCHED_WORKPOOLS; index++)
+    {
+      if (g_workpool[index].worker[0].pid == 0)
+        {
+          break;
+        }
+    }
+
+  if (index >= CONFIG_SCHED_WORKPOOLS)
+    {
+      sched_unlock();
+      return -ENOSPC;
+    }
+
+  pool = &g_workpool[index];
+  dq_init(&pool->q);
+
+  /* Start the worker threads */
+
+  sinfo("Starting work pool %s with %d thread(s)\n",
+        attr->name, attr->nthreads);
+
+  snprintf(arg1, sizeof(arg1), "%d", index);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  for (wndx = 0; wndx < attr->nthreads; wndx++)
+    {
+      pid = kthread_create(attr->name, attr->priority, attr->stacksize,
+                           (main_t)work_poolthread,
+                           (FAR char * const *)argv);
+
+      DEBUGASSERT(pid > 0);
+      if (pid < 0)
+        {
+          /* The threads already created are left running with no work.
+           * The pool is never marked as created and cannot be used.
+           */
+
+          serr("ERROR: kthread_create %d failed: %d\n", wndx, (int)pid);
+          sched_unlock();
+          return (int)pid;
+        }
+
+      pool->worker[wndx].pid  = pid;
+      pool->worker[wndx].busy = true;
+
+#ifdef CONFIG_SMP
+      if (attr->affinity != 0)
+        {
+          cpu_set_t cpuset = attr->affinity;
+          (void)nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+        }
+#endif
+    }
+
+  /* Now the pool may be used */
+
+  pool->nthreads = attr->nthreads;
+  sched_unlock();
+  return WORKPOOL_BASE + index;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE && HAVE_WORKPOOLS */
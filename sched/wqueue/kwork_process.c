@@ -228,9 +228,14 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
    * works, then sleep. The unexpired works are left in the queue. They
    * will be handled by thread 0 when it finishes current work and iterate
    * over the queue again.
+   *
+   * But while thread 0 is itself busy with (possibly slow) work, an idle
+   * thread takes over and waits only until the next work expires.
+   * Otherwise expired work would wait for thread 0 even though idle
+   * threads are available.
    */
 
-  if (wndx > 0 || next == WORK_DELAY_MAX)
+  if (next == WORK_DELAY_MAX || (wndx > 0 && !wqueue->worker[0].busy))
     {
       sigset_t set;
 
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdarg.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
@@ -47,6 +48,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -57,6 +59,98 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qinsert
+ *
+ * Description:
+ *   Add work that is ready to be performed to the work queue.  Must be
+ *   called with interrupts disabled.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The work structure to add
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void work_qinsert(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work)
+{
+#ifdef CONFIG_SCHED_WORKITEM_PRIO
+  FAR struct work_s *prev;
+
+  /* Keep the queue in order of decreasing priority, FIFO within the same
+   * priority.  Search from the tail so that queuing work of the lowest
+   * priority, the normal case, does not walk the queue.
+   */
+
+  for (prev = (FAR struct work_s *)wqueue->q.tail;
+       prev != NULL && prev->prio < work->prio;
+       prev = (FAR struct work_s *)prev->dq.blink);
+
+  if (prev != NULL)
+    {
+      dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+                  &wqueue->q);
+    }
+  else
+    {
+      dq_addfirst((FAR dq_entry_t *)work, &wqueue->q);
+    }
+#else
+  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#endif
+}
+
+/****************************************************************************
+ * Name: work_timeout
+ *
+ * Description:
+ *   The delay of delayed work has expired.  Move the work to the work queue
+ *   and wake up a worker thread.  Runs from the timer interrupt.
+ *
+ * Input Parameters:
+ *   argc - The number of arguments (3)
+ *   arg1 - The work queue
+ *   ...  - The work structure and the work queue ID
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_WDOG
+static void work_timeout(int argc, wdparm_t arg1, ...)
+{
+  FAR struct kwork_wqueue_s *wqueue = (FAR struct kwork_wqueue_s *)arg1;
+  FAR struct work_s *work;
+  irqstate_t flags;
+  va_list ap;
+  int qid;
+
+  DEBUGASSERT(argc == 3);
+
+  va_start(ap, arg1);
+  work = (FAR struct work_s *)va_arg(ap, wdparm_t);
+  qid  = (int)va_arg(ap, wdparm_t);
+  va_end(ap);
+
+  flags = enter_critical_section();
+
+  /* The work is now ready.  A zero delay lets work_process() perform it
+   * without looking at the time.
+   */
+
+  work->delay = 0;
+  work_qinsert(wqueue, work);
+  leave_critical_section(flags);
+
+  (void)work_signal(qid);
+}
+#endif
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -73,6 +167,7 @@
  *
  * Input Parameters:
  *   qid    - The work queue ID (index)
+ *   wqueue - The work queue
  *   work   - The work structure to queue
  *   worker - The worker callback to be invoked.  The callback will invoked
  *            on the worker thread of execution.
@@ -80,15 +175,16 @@
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   prio   - The priority of the work
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
+static void work_qqueue(int qid, FAR struct kwork_wqueue_s *wqueue,
                         FAR struct work_s *work, worker_t worker,
-                        FAR void *arg, clock_t delay)
+                        FAR void *arg, clock_t delay, uint8_t prio)
 {
   irqstate_t flags;
 
@@ -108,7 +204,18 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
        * end of the work queue.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_SCHED_WORKQUEUE_WDOG
+      /* Delayed work is not in the work queue until its timer expires */
+
+      if (WDOG_ISACTIVE(&work->timer))
+        {
+          (void)wd_cancel(&work->timer);
+        }
+      else
+#endif
+        {
+          dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+        }
     }
 
   /* Initialize the work structure. */
@@ -116,12 +223,35 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
   work->worker = worker;           /* Work callback. non-NULL means queued */
   work->arg    = arg;              /* Callback argument */
   work->delay  = delay;            /* Delay until work performed */
+#ifdef CONFIG_SCHED_WORKITEM_PRIO
+  work->prio   = prio;             /* Work priority */
+#endif
 
   /* Now, time-tag that entry and put it in the work queue */
 
   work->qtime  = clock_systimer(); /* Time work queued */
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_SCHED_WORKQUEUE_WDOG
+  /* Delayed work waits on its own timer and is added to the work queue
+   * only when the delay expires.  The worker threads then never have to
+   * scan the queue for expired work.
+   */
+
+  if (delay > 0)
+    {
+      if (delay > INT32_MAX)
+        {
+          delay = INT32_MAX;
+        }
+
+      (void)wd_start(&work->timer, (int32_t)delay, work_timeout, 3,
+                     (wdparm_t)wqueue, (wdparm_t)work, (wdparm_t)qid);
+    }
+  else
+#endif
+    {
+      work_qinsert(wqueue, work);
+    }
 
   leave_critical_section(flags);
 }
@@ -131,36 +261,35 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_queue
+ * Name: work_queue_prio
  *
  * Description:
- *   Queue kernel-mode work to be performed at a later time.  All queued work
- *   will be performed on the worker thread of of execution (not the caller's).
- *
- *   The work structure is allocated and must be initialized to all zero by
- *   the caller.  Otherwise, the work structure is completely managed by the
- *   work queue logic.  The caller should never modify the contents of the
- *   work queue structure directly.  If work_queue() is called before the
- *   previous work as been performed and removed from the queue, then any
- *   pending work will be canceled and lost.
+ *   Queue kernel-mode work with a priority.  Ready work is performed in
+ *   order of decreasing priority.  Without CONFIG_SCHED_WORKITEM_PRIO this
+ *   is only the common implementation of work_queue() and the priority is
+ *   ignored.
  *
  * Input Parameters:
  *   qid    - The work queue ID (index)
  *   work   - The work structure to queue
- *   worker - The worker callback to be invoked.  The callback will invoked
- *            on the worker thread of execution.
- *   arg    - The argument that will be passed to the workder callback when
- *            int is invoked.
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   prio   - The priority of the work
  *
  * Returned Value:
  *   Zero on success, a negated errno on failure
  *
  ****************************************************************************/
 
-int work_queue(int qid, FAR struct work_s *work, worker_t worker,
-               FAR void *arg, clock_t delay)
+#ifdef CONFIG_SCHED_WORKITEM_PRIO
+int work_queue_prio(int qid, FAR struct work_s *work, worker_t worker,
+                    FAR void *arg, clock_t delay, uint8_t prio)
+#else
+static int work_queue_prio(int qid, FAR struct work_s *work, worker_t worker,
+                           FAR void *arg, clock_t delay, uint8_t prio)
+#endif
 {
   /* Queue the new work */
 
@@ -169,7 +298,8 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue high priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
+      work_qqueue(HPWORK, (FAR struct kwork_wqueue_s *)&g_hpwork,
+                  work, worker, arg, delay, prio);
       return work_signal(HPWORK);
     }
   else
@@ -179,14 +309,61 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue low priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker, arg, delay);
+      work_qqueue(LPWORK, (FAR struct kwork_wqueue_s *)&g_lpwork,
+                  work, worker, arg, delay, prio);
       return work_signal(LPWORK);
     }
   else
+#endif
+#ifdef HAVE_WORKPOOLS
+  if (work_pool(qid) != NULL)
+    {
+      /* Queue work to a work pool */
+
+      work_qqueue(qid, (FAR struct kwork_wqueue_s *)work_pool(qid),
+                  work, worker, arg, delay, prio);
+      return work_signal(qid);
+    }
+  else
 #endif
     {
       return -EINVAL;
     }
 }
 
+/****************************************************************************
+ * Name: work_queue
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed at a later time.  All queued work
+ *   will be performed on the worker thread of of execution (not the caller's).
+ *
+ *   The work structure is allocated and must be initialized to all zero by
+ *   the caller.  Otherwise, the work structure is completely managed by the
+ *   work queue logic.  The caller should never modify the contents of the
+ *   work queue structure directly.  If work_queue() is called before the
+ *   previous work as been performed and removed from the queue, then any
+ *   pending work will be canceled and lost.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the workder callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker,
+               FAR void *arg, clock_t delay)
+{
+  return work_queue_prio(qid, work, worker, arg, delay, 0);
+}
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -92,6 +92,16 @@ int work_signal(int qid)
       threads = CONFIG_SCHED_LPNTHREADS;
     }
   else
+#endif
+#ifdef HAVE_WORKPOOLS
+  if (work_pool(qid) != NULL)
+    {
+      FAR struct kwork_pool_s *pool = work_pool(qid);
+
+      work = (FAR struct kwork_wqueue_s *)pool;
+      threads = pool->nthreads;
+    }
+  else
 #endif
     {
       return -EINVAL;
@@ -58,6 +58,19 @@
 
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
+#define CPUWORKNAME "cpuwork"
+
+#if defined(CONFIG_SCHED_WORKPOOLS) && CONFIG_SCHED_WORKPOOLS > 0
+#  define HAVE_WORKPOOLS 1
+
+/* Return the work pool with the ID qid or NULL if it does not exist */
+
+#  define WORKPOOL_INDEX(qid) ((unsigned int)((qid) - WORKPOOL_BASE))
+#  define work_pool(qid) \
+     (WORKPOOL_INDEX(qid) < CONFIG_SCHED_WORKPOOLS && \
+      g_workpool[WORKPOOL_INDEX(qid)].nthreads > 0 ? \
+      &g_workpool[WORKPOOL_INDEX(qid)] : NULL)
+#endif
 
 /****************************************************************************
  * Public Type Definitions
@@ -109,6 +122,22 @@ struct lp_wqueue_s
 };
 #endif
 
+/* This structure defines the state of one work pool.  This structure must
+ * be cast compatible with kwork_wqueue_s
+ */
+
+#ifdef HAVE_WORKPOOLS
+struct kwork_pool_s
+{
+  struct dq_queue_s q;      /* The queue of pending work */
+
+  /* Describes each thread in the pool */
+
+  struct kworker_s  worker[CONFIG_SCHED_WORKPOOL_NTHREADS];
+  uint8_t nthreads;         /* Number of threads. Zero: pool not created */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -125,6 +154,12 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef HAVE_WORKPOOLS
+/* The state of the work pools */
+
+extern struct kwork_pool_s g_workpool[CONFIG_SCHED_WORKPOOLS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -167,6 +202,25 @@ int work_hpstart(void);
 int work_lpstart(void);
 #endif
 
+/****************************************************************************
+ * Name: work_cpustart
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode work queues.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+int work_cpustart(void);
+#endif
+
 /****************************************************************************
  * Name: work_process
  *
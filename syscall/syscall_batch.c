@@ -0,0 +1,131 @@
+/****************************************************************************
+ * syscall/syscall_batch.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <syscall.h>
+#include <errno.h>
+
+#ifdef CONFIG_LIB_SYSCALL_BATCH
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Every stub is called as if it took all six parameters.  As with the
+ * architecture dispatch logic, the unused trailing parameters are simply
+ * ignored by stubs that take fewer.
+ */
+
+typedef uintptr_t (*syscall_stub_t)(int nbr, uintptr_t parm1,
+                                    uintptr_t parm2, uintptr_t parm3,
+                                    uintptr_t parm4, uintptr_t parm5,
+                                    uintptr_t parm6);
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syscall_batch
+ *
+ * Description:
+ *   Perform 'nbatch' system calls in order on behalf of the caller.  This
+ *   is the kernel side of the syscall_batch() system call; it runs in
+ *   privileged mode so each operation is a direct call through the stub
+ *   lookup table rather than a separate software trap.
+ *
+ * Input Parameters:
+ *   batch  - The array of operations
+ *   nbatch - The number of entries in batch
+ *
+ * Returned Value:
+ *   The number of operations performed.  On failure, -1 is returned and
+ *   errno is set to EINVAL.
+ *
+ ****************************************************************************/
+
+int syscall_batch(FAR struct syscall_batch_s *batch, int nbatch)
+{
+  FAR struct syscall_batch_s *op;
+  syscall_stub_t stub;
+  uintptr_t nbr;
+  int i;
+
+  if (nbatch < 0 || (batch == NULL && nbatch > 0))
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  for (i = 0; i < nbatch; i++)
+    {
+      op  = &batch[i];
+      nbr = op->sb_nbr;
+
+      /* A nested batch would recurse without limit and vfork() must be
+       * called from the context that it duplicates.
+       */
+
+      if (nbr < CONFIG_SYS_RESERVED || nbr >= SYS_maxsyscall ||
+#ifdef SYS_vfork
+          nbr == SYS_vfork ||
+#endif
+          nbr == SYS_syscall_batch)
+        {
+          op->sb_result = (uintptr_t)ERROR;
+          op->sb_errno  = ENOSYS;
+          continue;
+        }
+
+      nbr -= CONFIG_SYS_RESERVED;
+      stub = (syscall_stub_t)g_stublookup[nbr];
+
+      set_errno(0);
+      op->sb_result = stub((int)nbr, op->sb_parm[0], op->sb_parm[1],
+                           op->sb_parm[2], op->sb_parm[3], op->sb_parm[4],
+                           op->sb_parm[5]);
+      op->sb_errno  = get_errno();
+    }
+
+  return nbatch;
+}
+
+#endif /* CONFIG_LIB_SYSCALL_BATCH */
@@ -201,6 +201,8 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(write,                    3, STUB_write)
   SYSCALL_LOOKUP(pread,                    4, STUB_pread)
   SYSCALL_LOOKUP(pwrite,                   4, STUB_pwrite)
+  SYSCALL_LOOKUP(readv,                    3, STUB_readv)
+  SYSCALL_LOOKUP(writev,                   3, STUB_writev)
 #  ifdef CONFIG_FS_AIO
   SYSCALL_LOOKUP(aio_read,                 1, STUB_aio_read)
   SYSCALL_LOOKUP(aio_write,                1, STUB_aio_write)
@@ -293,6 +295,15 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(shmdt,                    1, STUB_shmdt)
 #endif
 
+/* Shared memory objects */
+
+#ifdef CONFIG_FS_SHM
+  SYSCALL_LOOKUP(shm_open,                 3, STUB_shm_open)
+  SYSCALL_LOOKUP(shm_unlink,               1, STUB_shm_unlink)
+  SYSCALL_LOOKUP(memfd_create,             2, STUB_memfd_create)
+  SYSCALL_LOOKUP(munmap,                   2, STUB_munmap)
+#endif
+
 /* The following are defined if pthreads are enabled */
 
 #ifndef CONFIG_DISABLE_PTHREAD
@@ -380,6 +391,10 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(send,                     4, STUB_send)
   SYSCALL_LOOKUP(sendto,                   6, STUB_sendto)
   SYSCALL_LOOKUP(setsockopt,               5, STUB_setsockopt)
+  SYSCALL_LOOKUP(recvmmsg,                 5, STUB_recvmmsg)
+  SYSCALL_LOOKUP(sendmmsg,                 4, STUB_sendmmsg)
+  SYSCALL_LOOKUP(recvmsg,                  3, STUB_recvmsg)
+  SYSCALL_LOOKUP(sendmsg,                  3, STUB_sendmsg)
   SYSCALL_LOOKUP(socket,                   3, STUB_socket)
 #endif
 
@@ -396,6 +411,12 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(getrandom,               2, STUB_getrandom)
 #endif
 
+/* The following is defined only if batched system calls are enabled */
+
+#ifdef CONFIG_LIB_SYSCALL_BATCH
+  SYSCALL_LOOKUP(syscall_batch,           2, STUB_syscall_batch)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -201,6 +201,10 @@ uintptr_t STUB_pread(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4);
 uintptr_t STUB_pwrite(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_readv(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
+uintptr_t STUB_writev(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
 uintptr_t STUB_poll(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3);
 uintptr_t STUB_select(int nbr, uintptr_t parm1, uintptr_t parm2,
@@ -291,6 +295,14 @@ uintptr_t STUB_shmctl(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3);
 uintptr_t STUB_shmdt(int nbr, uintptr_t parm1);
 
+/* Shared memory objects */
+
+uintptr_t STUB_shm_open(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
+uintptr_t STUB_shm_unlink(int nbr, uintptr_t parm1);
+uintptr_t STUB_memfd_create(int nbr, uintptr_t parm1, uintptr_t parm2);
+uintptr_t STUB_munmap(int nbr, uintptr_t parm1, uintptr_t parm2);
+
 /* The following are defined if pthreads are enabled */
 
 uintptr_t STUB_pthread_cancel(int nbr, uintptr_t parm1);
@@ -397,6 +409,14 @@ uintptr_t STUB_sendto(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm6);
 uintptr_t STUB_setsockopt(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
+uintptr_t STUB_recvmmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
+uintptr_t STUB_sendmmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_recvmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
+uintptr_t STUB_sendmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
 uintptr_t STUB_socket(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3);
 
@@ -410,6 +430,10 @@ uintptr_t STUB_prctl(int nbr, uintptr_t parm1, uintptr_t parm2,
 
 uintptr_t STUB_getrandom(int nbr, uintptr_t parm1, uintptr_t parm2);
 
+/* The following is defined only if batched system calls are enabled */
+
+uintptr_t STUB_syscall_batch(int nbr, uintptr_t parm1, uintptr_t parm2);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
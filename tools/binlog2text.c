@@ -0,0 +1,611 @@
+/****************************************************************************
+ * tools/binlog2text.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These must agree with include/nuttx/syslog/binlog.h */
+
+#define BINLOG_MAGIC      0xb7
+#define BINLOG_HDRWORDS   3
+#define BINLOG_MAXARGS    8
+
+/* The few ELF definitions that are needed */
+
+#define EI_CLASS          4
+#define EI_DATA           5
+#define ELFCLASS32        1
+#define ELFCLASS64        2
+#define ELFDATA2MSB       2
+#define SHT_PROGBITS      1
+#define SHF_ALLOC         2
+
+#define MAX_SPEC          64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One loaded section of the ELF file */
+
+struct section_s
+{
+  uint64_t addr;
+  uint64_t size;
+  const uint8_t *data;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t *g_elf;
+static size_t g_elfsize;
+static struct section_s *g_sections;
+static size_t g_nsections;
+static bool g_bigendian;
+static unsigned int g_wordsize;
+static uint64_t g_bias;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+  fprintf(stderr, "USAGE: %s [-a <bias>] [-c] [-t] <elf-file> "
+                  "<binlog-file> [<text-file>]\n", progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  -a <bias>:  Subtract <bias> from the recorded "
+                  "addresses, for images that\n"
+                  "       were loaded at an offset from their link "
+                  "address.  Default: 0\n");
+  fprintf(stderr, "  -c:  Show the CPU of each record\n");
+  fprintf(stderr, "  -t:  Do not show the time stamp of each record\n");
+  fprintf(stderr, "  <elf-file>:  The nuttx ELF file that made the "
+                  "records\n");
+  fprintf(stderr, "  <binlog-file>:  Binary records read from "
+                  "/dev/binlog\n");
+  fprintf(stderr, "  <text-file>:  The formatted output.  Default: "
+                  "stdout\n");
+  exit(exitcode);
+}
+
+static uint64_t get_uint(const uint8_t *data, unsigned int size)
+{
+  uint64_t value = 0;
+  unsigned int i;
+
+  for (i = 0; i < size; i++)
+    {
+      unsigned int ndx = g_bigendian ? i : size - 1 - i;
+      value = value << 8 | data[ndx];
+    }
+
+  return value;
+}
+
+/* Read the ELF file and remember its loaded sections */
+
+static void load_elf(const char *path)
+{
+  const uint8_t *shdr;
+  uint64_t shoff;
+  unsigned int shentsize;
+  unsigned int shnum;
+  unsigned int i;
+  long size;
+  FILE *stream;
+
+  stream = fopen(path, "rb");
+  if (stream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s\n", path);
+      exit(EXIT_FAILURE);
+    }
+
+  fseek(stream, 0, SEEK_END);
+  size = ftell(stream);
+  fseek(stream, 0, SEEK_SET);
+
+  g_elf = malloc(size > 0 ? size : 1);
+  if (g_elf == NULL)
+    {
+      fprintf(stderr, "ERROR: Out of memory\n");
+      exit(EXIT_FAILURE);
+    }
+
+  if (size < 64 || fread(g_elf, size, 1, stream) != 1 ||
+      memcmp(g_elf, "\177ELF", 4) != 0)
+    {
+      fprintf(stderr, "ERROR: %s is not an ELF file\n", path);
+      exit(EXIT_FAILURE);
+    }
+
+  fclose(stream);
+  g_elfsize = size;
+
+  /* The word size and byte order of the records follow the ELF file */
+
+  g_bigendian = g_elf[EI_DATA] == ELFDATA2MSB;
+
+  if (g_elf[EI_CLASS] == ELFCLASS64)
+    {
+      g_wordsize = 8;
+      shoff      = get_uint(&g_elf[0x28], 8);
+      shentsize  = get_uint(&g_elf[0x3a], 2);
+      shnum      = get_uint(&g_elf[0x3c], 2);
+    }
+  else if (g_elf[EI_CLASS] == ELFCLASS32)
+    {
+      g_wordsize = 4;
+      shoff      = get_uint(&g_elf[0x20], 4);
+      shentsize  = get_uint(&g_elf[0x2e], 2);
+      shnum      = get_uint(&g_elf[0x30], 2);
+    }
+  else
+    {
+      fprintf(stderr, "ERROR: Unsupported ELF class in %s\n", path);
+      exit(EXIT_FAILURE);
+    }
+
+  if (shoff + (uint64_t)shentsize * shnum > g_elfsize)
+    {
+      fprintf(stderr, "ERROR: Bad section headers in %s\n", path);
+      exit(EXIT_FAILURE);
+    }
+
+  g_sections = calloc(shnum ? shnum : 1, sizeof(struct section_s));
+  if (g_sections == NULL)
+    {
+      fprintf(stderr, "ERROR: Out of memory\n");
+      exit(EXIT_FAILURE);
+    }
+
+  /* Keep the sections with contents that are part of the image.  Format
+   * strings and string literals are in .rodata, but some toolchains put
+   * them in .text or .data.
+   */
+
+  for (i = 0; i < shnum; i++)
+    {
+      uint64_t flags;
+      uint64_t addr;
+      uint64_t offset;
+      uint64_t secsize;
+
+      shdr = &g_elf[shoff + (uint64_t)i * shentsize];
+
+      if (get_uint(&shdr[4], 4) != SHT_PROGBITS)
+        {
+          continue;
+        }
+
+      if (g_wordsize == 8)
+        {
+          flags   = get_uint(&shdr[8], 8);
+          addr    = get_uint(&shdr[16], 8);
+          offset  = get_uint(&shdr[24], 8);
+          secsize = get_uint(&shdr[32], 8);
+        }
+      else
+        {
+          flags   = get_uint(&shdr[8], 4);
+          addr    = get_uint(&shdr[12], 4);
+          offset  = get_uint(&shdr[16], 4);
+          secsize = get_uint(&shdr[20], 4);
+        }
+
+      if ((flags & SHF_ALLOC) == 0 || offset + secsize > g_elfsize)
+        {
+          continue;
+        }
+
+      g_sections[g_nsections].addr = addr;
+      g_sections[g_nsections].size = secsize;
+      g_sections[g_nsections].data = &g_elf[offset];
+      g_nsections++;
+    }
+}
+
+/* Return the NUL terminated string at a target address, or NULL */
+
+static const char *find_string(uint64_t addr)
+{
+  size_t i;
+
+  addr -= g_bias;
+
+  for (i = 0; i < g_nsections; i++)
+    {
+      const struct section_s *sec = &g_sections[i];
+
+      if (addr >= sec->addr && addr < sec->addr + sec->size)
+        {
+          uint64_t offset = addr - sec->addr;
+
+          if (memchr(&sec->data[offset], '\0', sec->size - offset) == NULL)
+            {
+              return NULL;
+            }
+
+          return (const char *)&sec->data[offset];
+        }
+    }
+
+  return NULL;
+}
+
+/* Return an argument of the given size in bytes, sign extended */
+
+static int64_t to_signed(uint64_t value, unsigned int size)
+{
+  if (size < 8)
+    {
+      uint64_t sign = (uint64_t)1 << (8 * size - 1);
+
+      value &= (sign << 1) - 1;
+      return (int64_t)(value ^ sign) - (int64_t)sign;
+    }
+
+  return (int64_t)value;
+}
+
+static uint64_t to_unsigned(uint64_t value, unsigned int size)
+{
+  return size < 8 ? value & (((uint64_t)1 << (8 * size)) - 1) : value;
+}
+
+/* Render one record's format string with its arguments.  Each conversion
+ * is passed to the host printf() without its length modifier and with the
+ * argument widened to 64 bits.
+ */
+
+static void print_message(FILE *stream, const char *fmt,
+                          const uint64_t *args, unsigned int nargs)
+{
+  char spec[MAX_SPEC];
+  unsigned int argndx = 0;
+
+  while (*fmt != '\0')
+    {
+      unsigned int size;
+      unsigned int len;
+      uint64_t value;
+      const char *str;
+
+      if (*fmt != '%')
+        {
+          fputc(*fmt++, stream);
+          continue;
+        }
+
+      if (fmt[1] == '%')
+        {
+          fputc('%', stream);
+          fmt += 2;
+          continue;
+        }
+
+      /* Copy the flags, width and precision.  A '*' consumes an argument
+       * that is substituted in the specification.
+       */
+
+      spec[0] = *fmt++;
+      len     = 1;
+
+      while (*fmt != '\0' && strchr("-+ #0123456789.*", *fmt) != NULL &&
+             len < MAX_SPEC - 24)
+        {
+          if (*fmt == '*')
+            {
+              value = argndx < nargs ? args[argndx++] : 0;
+              len  += snprintf(&spec[len], MAX_SPEC - len, "%d",
+                               (int)to_signed(value, 4));
+            }
+          else
+            {
+              spec[len++] = *fmt;
+            }
+
+          fmt++;
+        }
+
+      /* The length modifier gives the size of the argument on the target */
+
+      size = 4;
+      if (fmt[0] == 'h' && fmt[1] == 'h')
+        {
+          size = 1;
+          fmt += 2;
+        }
+      else if (fmt[0] == 'h')
+        {
+          size = 2;
+          fmt++;
+        }
+      else if (fmt[0] == 'l' && fmt[1] == 'l')
+        {
+          size = 8;
+          fmt += 2;
+        }
+      else if (*fmt == 'l' || *fmt == 'z' || *fmt == 'j' || *fmt == 't')
+        {
+          size = g_wordsize;
+          fmt++;
+        }
+
+      if (*fmt == '\0')
+        {
+          break;
+        }
+
+      /* Arguments were converted to pointer-sized words on the target */
+
+      if (size > g_wordsize)
+        {
+          size = g_wordsize;
+        }
+
+      value = argndx < nargs ? args[argndx++] : 0;
+
+      switch (*fmt)
+        {
+          case 'd':
+          case 'i':
+            strcpy(&spec[len], "lld");
+            fprintf(stream, spec, (long long)to_signed(value, size));
+            break;
+
+          case 'u':
+          case 'x':
+          case 'X':
+          case 'o':
+            spec[len++] = 'l';
+            spec[len++] = 'l';
+            spec[len++] = *fmt;
+            spec[len]   = '\0';
+            fprintf(stream, spec,
+                    (unsigned long long)to_unsigned(value, size));
+            break;
+
+          case 'c':
+            strcpy(&spec[len], "c");
+            fprintf(stream, spec, (int)(value & 0xff));
+            break;
+
+          case 'p':
+            fprintf(stream, "0x%llx", (unsigned long long)value);
+            break;
+
+          case 's':
+            str = find_string(value);
+            if (str != NULL)
+              {
+                strcpy(&spec[len], "s");
+                fprintf(stream, spec, str);
+              }
+            else
+              {
+                fprintf(stream, "<0x%llx>", (unsigned long long)value);
+              }
+            break;
+
+          case 'n':
+            break;
+
+          default:
+
+            /* Floating point and other conversions can not be recovered
+             * from the recorded words.
+             */
+
+            fprintf(stream, "<%%%c 0x%llx>", *fmt,
+                    (unsigned long long)value);
+            break;
+        }
+
+      fmt++;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  uint8_t record[(BINLOG_HDRWORDS + BINLOG_MAXARGS) * 8];
+  uint64_t args[BINLOG_MAXARGS];
+  bool showcpu = false;
+  bool showtime = true;
+  unsigned long nrecords = 0;
+  unsigned long nbad = 0;
+  FILE *instream;
+  FILE *outstream;
+  int option;
+
+  while ((option = getopt(argc, argv, "a:cth")) > 0)
+    {
+      switch (option)
+        {
+          case 'a':
+            g_bias = strtoull(optarg, NULL, 0);
+            break;
+
+          case 'c':
+            showcpu = true;
+            break;
+
+          case 't':
+            showtime = false;
+            break;
+
+          case 'h':
+            show_usage(argv[0], EXIT_SUCCESS);
+            break;
+
+          default:
+            fprintf(stderr, "ERROR: Unrecognized option\n");
+            show_usage(argv[0], EXIT_FAILURE);
+            break;
+        }
+    }
+
+  if (optind + 2 != argc && optind + 3 != argc)
+    {
+      fprintf(stderr, "ERROR: Missing file names\n");
+      show_usage(argv[0], EXIT_FAILURE);
+    }
+
+  load_elf(argv[optind]);
+
+  instream = fopen(argv[optind + 1], "rb");
+  if (instream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind + 1]);
+      return EXIT_FAILURE;
+    }
+
+  if (optind + 3 == argc)
+    {
+      outstream = fopen(argv[optind + 2], "w");
+      if (outstream == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind + 2]);
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      outstream = stdout;
+    }
+
+  /* Each record starts with a header word that gives its length */
+
+  while (fread(record, g_wordsize, 1, instream) == 1)
+    {
+      uint64_t header = get_uint(record, g_wordsize);
+      unsigned int nargs = (header >> 8) & 0xff;
+      unsigned int cpu = (header >> 16) & 0xff;
+      unsigned long long systime;
+      uint64_t fmtaddr;
+      const char *fmt;
+      unsigned int i;
+
+      if ((header & 0xff) != BINLOG_MAGIC || nargs > BINLOG_MAXARGS)
+        {
+          /* Not a record.  Skip a word to resynchronize. */
+
+          nbad++;
+          continue;
+        }
+
+      if (fread(&record[g_wordsize], g_wordsize,
+                BINLOG_HDRWORDS - 1 + nargs, instream) !=
+          BINLOG_HDRWORDS - 1 + nargs)
+        {
+          fprintf(stderr, "WARNING: Truncated last record\n");
+          break;
+        }
+
+      systime = get_uint(&record[g_wordsize], g_wordsize);
+      fmtaddr = get_uint(&record[2 * g_wordsize], g_wordsize);
+
+      for (i = 0; i < nargs; i++)
+        {
+          args[i] = get_uint(&record[(BINLOG_HDRWORDS + i) * g_wordsize],
+                             g_wordsize);
+        }
+
+      if (showtime)
+        {
+          fprintf(outstream, "[%10llu] ", systime);
+        }
+
+      if (showcpu)
+        {
+          fprintf(outstream, "CPU%u: ", cpu);
+        }
+
+      if (fmtaddr == 0)
+        {
+          fprintf(outstream, "[binlog: %llu records dropped]\n",
+                  (unsigned long long)(nargs > 0 ? args[0] : 0));
+        }
+      else if ((fmt = find_string(fmtaddr)) != NULL)
+        {
+          print_message(outstream, fmt, args, nargs);
+          if (fmt[0] == '\0' || fmt[strlen(fmt) - 1] != '\n')
+            {
+              fputc('\n', outstream);
+            }
+        }
+      else
+        {
+          fprintf(outstream, "<unknown format 0x%llx>\n",
+                  (unsigned long long)fmtaddr);
+        }
+
+      nrecords++;
+    }
+
+  if (nbad > 0)
+    {
+      fprintf(stderr, "WARNING: Skipped %lu words that were not records\n",
+              nbad);
+    }
+
+  fprintf(stderr, "%lu records\n", nrecords);
+
+  fclose(instream);
+  if (outstream != stdout)
+    {
+      fclose(outstream);
+    }
+
+  return EXIT_SUCCESS;
+}
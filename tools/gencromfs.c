@@ -116,6 +116,8 @@
 #define CROMFS_MAGIC       0x4d4f5243
 #define CROMFS_BLOCKSIZE   512
 
+#define CROMFS_NODE_INDEXED (1 << 0) /* File data is preceded by a block index */
+
 #define LZF_BUFSIZE        512
 #define LZF_HLOG           13
 #define LZF_HSIZE          (1 << LZF_HLOG)
@@ -164,7 +166,7 @@ struct cromfs_volume_s
 struct cromfs_node_s
 {
   uint16_t cn_mode;       /* File type, attributes, and access mode bits */
-  uint16_t cn_pad;        /* Not used */
+  uint16_t cn_flags;      /* See CROMFS_NODE_* definitions */
   uint32_t cn_name;       /* Offset from the beginning of the volume header to the
                            * node name string.  NUL-terminated. */
   uint32_t cn_size;       /* Size of the uncompressed data (in bytes) */
@@ -912,7 +914,7 @@ static void gen_dirlink(const char *name, uint32_t tgtoffs, bool dirempty)
           (unsigned long)g_offset, name);
 
   node.cn_mode    = TGT_UINT16(DIRLINK_MODEFLAGS);
-  node.cn_pad     = 0;
+  node.cn_flags   = 0;
 
   g_offset       += sizeof(struct cromfs_node_s);
   node.cn_name    = TGT_UINT32(g_offset);
@@ -995,7 +997,7 @@ static void gen_directory(const char *path, const char *name, mode_t mode,
           (unsigned long)save_offset, path);
 
   node.cn_mode    = TGT_UINT16(NUTTX_IFDIR | get_mode(mode));
-  node.cn_pad     = 0;
+  node.cn_flags   = 0;
 
   save_offset    += sizeof(struct cromfs_node_s);
   node.cn_name    = TGT_UINT32(save_offset);
@@ -1025,21 +1027,18 @@ static void gen_file(const char *path, const char *name, mode_t mode,
   FILE *outstream;
   FILE *instream;
   uint8_t iobuffer[LZF_BUFSIZE];
+  uint32_t *index;
   size_t nread;
   size_t ntotal;
   size_t blklen;
   size_t blktotal;
   unsigned int blkno;
+  unsigned int nindex;
+  long fsize;
   int namlen;
 
   namlen      = strlen(name) + 1;
 
-  /* Open a new temporary file */
-
-  outstream   = open_tmpfile();
-  g_tmpstream = outstream;
-  g_offset    = nodeoffs + sizeof(struct cromfs_node_s) + namlen;
-
   /* Open the source data file */
 
   instream    = fopen(path, "r");
@@ -1050,6 +1049,40 @@ static void gen_file(const char *path, const char *name, mode_t mode,
       exit(1);
     }
 
+  /* Get the number of blocks in the file.  The block index that precedes
+   * the compressed data holds the image offset of each block.  Every block
+   * but the last holds CROMFS_BLOCKSIZE bytes of uncompressed data so that
+   * the file system can find the block containing a file offset directly.
+   */
+
+  if (fseek(instream, 0, SEEK_END) < 0 || (fsize = ftell(instream)) < 0 ||
+      fseek(instream, 0, SEEK_SET) < 0)
+    {
+      fprintf(stderr, "Failed to get size of source file %s: %s\n",
+              path, strerror(errno));
+      exit(1);
+    }
+
+  nindex      = (fsize + CROMFS_BLOCKSIZE - 1) / CROMFS_BLOCKSIZE;
+  index       = NULL;
+
+  if (nindex > 0)
+    {
+      index   = (uint32_t *)malloc(nindex * sizeof(uint32_t));
+      if (!index)
+        {
+          fprintf(stderr, "Failed to allocate block index for %s\n", path);
+          exit(1);
+        }
+    }
+
+  /* Open a new temporary file */
+
+  outstream   = open_tmpfile();
+  g_tmpstream = outstream;
+  g_offset    = nodeoffs + sizeof(struct cromfs_node_s) + namlen +
+                nindex * sizeof(uint32_t);
+
   /* Then read data from the file, compress it, and write it to the new
    * temporary file
    */
@@ -1067,6 +1100,17 @@ static void gen_file(const char *path, const char *name, mode_t mode,
         {
           uint16_t clen;
 
+          /* Add the block to the block index */
+
+          if (blkno >= nindex)
+            {
+              fprintf(stderr, "Source file %s grew while being read\n",
+                      path);
+              exit(1);
+            }
+
+          index[blkno] = TGT_UINT32(g_offset);
+
           /* Compress the chunk */
 
           blklen = lzf_compress(iobuffer, nread, &result);
@@ -1098,6 +1142,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
     }
   while (nread > 0);
 
+  if (blkno != nindex)
+    {
+      fprintf(stderr, "Source file %s shrank while being read\n", path);
+      exit(1);
+    }
+
+  fclose(instream);
+
   /* Restore the old tmpfile context */
 
   g_tmpstream        = save_tmpstream;
@@ -1112,14 +1164,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
           (unsigned long)blktotal);
 
   node.cn_mode       = TGT_UINT16(NUTTX_IFREG | get_mode(mode));
-  node.cn_pad        = 0;
+  node.cn_flags      = TGT_UINT16(CROMFS_NODE_INDEXED);
 
   nodeoffs          += sizeof(struct cromfs_node_s);
   node.cn_name       = TGT_UINT32(nodeoffs);
 
   node.cn_size       = TGT_UINT32(ntotal);
 
-  nodeoffs          += namlen;
+  nodeoffs          += namlen + nindex * sizeof(uint32_t);
   node.u.cn_blocks   = TGT_UINT32(nodeoffs);
 
   nodeoffs          += blktotal;
@@ -1128,6 +1180,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
   dump_hexbuffer(g_tmpstream, &node, sizeof(struct cromfs_node_s));
   dump_hexbuffer(g_tmpstream, name, namlen);
 
+  if (nindex > 0)
+    {
+      dump_nextline(g_tmpstream);
+      fprintf(g_tmpstream, "\n  /* Block index: %u blocks */\n\n", nindex);
+      dump_hexbuffer(g_tmpstream, index, nindex * sizeof(uint32_t));
+      free(index);
+    }
+
   g_nnodes++;
 
   /* Now append the sub-tree nodes in the new tmpfile to the previous tmpfile */
@@ -57,6 +57,12 @@
  * Private Types
  ****************************************************************************/
 
+struct symbol_s
+{
+  char *name;
+  char *cond;
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -64,6 +70,9 @@
 static const char *g_hdrfiles[MAX_HEADER_FILES];
 static int nhdrfiles;
 
+static struct symbol_s *g_symbols;
+static int nsymbols;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -111,6 +120,28 @@ static void add_hdrfile(const char *hdrfile)
     }
 }
 
+static void add_symbol(const char *name, const char *cond)
+{
+  g_symbols = realloc(g_symbols, (nsymbols + 1) * sizeof(struct symbol_s));
+  if (!g_symbols)
+    {
+      fprintf(stderr, "ERROR:  Failed to allocate symbol %s\n", name);
+      exit(EXIT_FAILURE);
+    }
+
+  g_symbols[nsymbols].name = strdup(name);
+  g_symbols[nsymbols].cond = (cond && strlen(cond) > 0) ? strdup(cond) : NULL;
+  nsymbols++;
+}
+
+static int compare_symbols(const void *arg1, const void *arg2)
+{
+  const struct symbol_s *sym1 = (const struct symbol_s *)arg1;
+  const struct symbol_s *sym2 = (const struct symbol_s *)arg2;
+
+  return strcmp(sym1->name, sym2->name);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -212,11 +243,17 @@ int main(int argc, char **argv, char **envp)
       /* Add the header file to the list of header files we need to include */
 
       add_hdrfile(g_parm[HEADER_INDEX]);
+
+      /* And the symbol to the list of symbols */
+
+      add_symbol(g_parm[NAME_INDEX], g_parm[COND_INDEX]);
     }
 
-  /* Back to the beginning */
+  /* Sort the symbols by name so that the symbol table may be searched with
+   * symtab_findorderedbyname() (CONFIG_SYMTAB_ORDEREDBYNAME).
+   */
 
-  rewind(instream);
+  qsort(g_symbols, nsymbols, sizeof(struct symbol_s), compare_symbols);
 
   /* Output up-front file boilerplate */
 
@@ -237,35 +274,26 @@ int main(int argc, char **argv, char **envp)
   fprintf(outstream, "\nconst struct symtab_s %s[] =\n", SYMTAB_NAME);
   fprintf(outstream, "{\n");
 
-  /* Parse each line in the CVS file */
+  /* Output each symbol in sorted order */
 
   nextterm  = "";
   finalterm = "";
 
-  while ((ptr = read_line(instream)) != NULL)
+  for (i = 0; i < nsymbols; i++)
     {
-      /* Parse the line from the CVS file */
-
-      int nargs = parse_csvline(ptr);
-      if (nargs < PARM1_INDEX)
-        {
-          fprintf(stderr, "Only %d arguments found: %s\n", nargs, g_line);
-          exit(EXIT_FAILURE);
-        }
-
       /* Output any conditional compilation */
 
-      cond = (g_parm[COND_INDEX] && strlen(g_parm[COND_INDEX]) > 0);
+      cond = (g_symbols[i].cond != NULL);
       if (cond)
         {
-          fprintf(outstream, "%s#if %s\n", nextterm, g_parm[COND_INDEX]);
+          fprintf(outstream, "%s#if %s\n", nextterm, g_symbols[i].cond);
           nextterm  = "";
         }
 
       /* Output the symbol table entry */
 
       fprintf(outstream, "%s  { \"%s\", (FAR const void *)%s }",
-              nextterm, g_parm[NAME_INDEX], g_parm[NAME_INDEX]);
+              nextterm, g_symbols[i].name, g_symbols[i].name);
 
       if (cond)
         {
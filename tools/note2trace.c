@@ -0,0 +1,730 @@
+/****************************************************************************
+ * tools/note2trace.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <unistd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Note types.  These must agree with enum note_type_e in
+ * include/nuttx/sched_note.h.
+ */
+
+#define NOTE_START            0
+#define NOTE_STOP             1
+#define NOTE_SUSPEND          2
+#define NOTE_RESUME           3
+#define NOTE_CPU_START        4
+#define NOTE_CPU_STARTED      5
+#define NOTE_CPU_PAUSE        6
+#define NOTE_CPU_PAUSED       7
+#define NOTE_CPU_RESUME       8
+#define NOTE_CPU_RESUMED      9
+#define NOTE_PREEMPT_LOCK     10
+#define NOTE_PREEMPT_UNLOCK   11
+#define NOTE_CSECTION_ENTER   12
+#define NOTE_CSECTION_LEAVE   13
+#define NOTE_SPINLOCK_LOCK    14
+#define NOTE_SPINLOCK_LOCKED  15
+#define NOTE_SPINLOCK_UNLOCK  16
+#define NOTE_SPINLOCK_ABORT   17
+#define NOTE_DUMP_STRING      18
+#define NOTE_DUMP_BEGIN       19
+#define NOTE_DUMP_END         20
+#define NOTE_DUMP_PRINTF      21
+#define NOTE_NTYPES           22
+
+#define MAX_CPUS              32
+#define MAX_PIDS              65536
+#define MAX_NAME              32
+#define MAX_TEXT              512
+
+/* Trace "processes":  One track per CPU and one track per task for user
+ * begin/end notes.
+ */
+
+#define PROC_CPUS             0
+#define PROC_TASKS            1
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct cpu_state_s
+{
+  bool     seen;         /* A note from this CPU has been seen */
+  bool     running;      /* A task slice is open on this CPU */
+  uint32_t lasttime;     /* Last raw time stamp */
+  uint64_t hitime;       /* Accumulated wraparounds of the time stamp */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_typename[NOTE_NTYPES] =
+{
+  "start", "stop", "suspend", "resume",
+  "cpu_start", "cpu_started", "cpu_pause", "cpu_paused",
+  "cpu_resume", "cpu_resumed",
+  "preempt_lock", "preempt_unlock",
+  "csection_enter", "csection_leave",
+  "spin_lock", "spin_locked", "spin_unlock", "spin_abort",
+  "string", "begin", "end", "printf"
+};
+
+static struct cpu_state_s g_cpu[MAX_CPUS];
+static char g_names[MAX_PIDS][MAX_NAME];
+static bool g_trackseen[MAX_PIDS];
+static bool g_first = true;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+  fprintf(stderr, "USAGE: %s [-s] [-f <freq>] <note-file> <json-file>\n",
+          progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  -s:  The notes were generated with CONFIG_SMP=y and "
+                  "include the CPU number\n");
+  fprintf(stderr, "  -f <freq>:  Frequency of the time stamps in Hz.  "
+                  "Default: 100\n");
+  fprintf(stderr, "  <note-file>:  Binary notes read from /dev/note\n");
+  fprintf(stderr, "  <json-file>:  Chrome/Perfetto trace event output\n");
+  exit(exitcode);
+}
+
+static void print_string(FILE *stream, const char *str)
+{
+  for (; *str != '\0'; str++)
+    {
+      if (*str == '"' || *str == '\\')
+        {
+          fprintf(stream, "\\%c", *str);
+        }
+      else if (isprint((unsigned char)*str))
+        {
+          fputc(*str, stream);
+        }
+      else
+        {
+          fprintf(stream, "\\u%04x", (unsigned char)*str);
+        }
+    }
+}
+
+static void print_event(FILE *stream, const char *ph, const char *name,
+                        int proc, int tid, double ts, const char *args)
+{
+  fprintf(stream, "%s\n  {\"ph\":\"%s\",\"name\":\"", g_first ? "" : ",",
+          ph);
+  print_string(stream, name);
+  fprintf(stream, "\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f", proc, tid,
+          ts);
+
+  if (ph[0] == 'i')
+    {
+      fprintf(stream, ",\"s\":\"t\"");
+    }
+
+  if (args != NULL)
+    {
+      fprintf(stream, ",\"args\":{%s}", args);
+    }
+
+  fprintf(stream, "}");
+  g_first = false;
+}
+
+static const char *task_name(unsigned int pid)
+{
+  static char name[MAX_NAME];
+
+  if (g_names[pid][0] != '\0')
+    {
+      return g_names[pid];
+    }
+
+  snprintf(name, MAX_NAME, "pid %u", pid);
+  return name;
+}
+
+/* Get a little endian value of 'size' bytes from the packed printf
+ * arguments.  Returns false if the arguments were truncated.
+ */
+
+static bool get_arg(const uint8_t *args, size_t argslen, size_t *pos,
+                    unsigned int size, uint64_t *value)
+{
+  unsigned int i;
+
+  if (*pos + size > argslen)
+    {
+      return false;
+    }
+
+  *value = 0;
+  for (i = 0; i < size; i++)
+    {
+      *value |= (uint64_t)args[*pos + i] << (8 * i);
+    }
+
+  *pos += size;
+  return true;
+}
+
+/* Render a NOTE_DUMP_PRINTF note.  The argument encoding is described with
+ * struct note_printf_s in include/nuttx/sched_note.h.
+ */
+
+static void render_printf(const char *fmt, size_t fmtlen,
+                          const uint8_t *args, size_t argslen,
+                          char *out, size_t outlen)
+{
+  const char *end = fmt + fmtlen;
+  size_t pos = 0;
+  size_t len = 0;
+
+  out[0] = '\0';
+
+  while (fmt < end && len + 1 < outlen)
+    {
+      char spec[32];
+      size_t nspec = 0;
+      int star[2];
+      int nstar = 0;
+      int lng = 0;
+      uint64_t value;
+      char conv;
+      int n = 0;
+
+      if (*fmt != '%')
+        {
+          out[len++] = *fmt++;
+          out[len] = '\0';
+          continue;
+        }
+
+      /* Collect the flags, width, and precision.  Length modifiers are
+       * dropped and replaced to match the size of the packed argument.
+       */
+
+      spec[nspec++] = *fmt++;
+      while (fmt < end && nspec < sizeof(spec) - 4 &&
+             strchr("-+ #0123456789.*", *fmt) != NULL)
+        {
+          if (*fmt == '*')
+            {
+              if (nstar >= 2 || !get_arg(args, argslen, &pos, 4, &value))
+                {
+                  goto truncated;
+                }
+
+              star[nstar++] = (int32_t)value;
+            }
+
+          spec[nspec++] = *fmt++;
+        }
+
+      while (fmt < end && strchr("hljzt", *fmt) != NULL)
+        {
+          if (*fmt != 'h')
+            {
+              lng = 1;
+            }
+
+          fmt++;
+        }
+
+      if (fmt >= end)
+        {
+          break;
+        }
+
+      conv = *fmt++;
+      spec[nspec] = '\0';
+
+      switch (conv)
+        {
+          case '%':
+            n = snprintf(&out[len], outlen - len, "%%");
+            break;
+
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+            if (!get_arg(args, argslen, &pos, lng ? 8 : 4, &value))
+              {
+                goto truncated;
+              }
+
+            if (lng)
+              {
+                spec[nspec++] = 'l';
+                spec[nspec++] = 'l';
+              }
+
+            spec[nspec++] = conv;
+            spec[nspec] = '\0';
+
+            if (lng)
+              {
+                n = nstar == 2 ? snprintf(&out[len], outlen - len, spec,
+                                          star[0], star[1],
+                                          (long long)value) :
+                    nstar == 1 ? snprintf(&out[len], outlen - len, spec,
+                                          star[0], (long long)value) :
+                    snprintf(&out[len], outlen - len, spec,
+                             (long long)value);
+              }
+            else
+              {
+                n = nstar == 2 ? snprintf(&out[len], outlen - len, spec,
+                                          star[0], star[1], (int)value) :
+                    nstar == 1 ? snprintf(&out[len], outlen - len, spec,
+                                          star[0], (int)value) :
+                    snprintf(&out[len], outlen - len, spec, (int)value);
+              }
+            break;
+
+          case 'p':
+            if (!get_arg(args, argslen, &pos, 8, &value))
+              {
+                goto truncated;
+              }
+
+            n = snprintf(&out[len], outlen - len, "0x%llx",
+                         (unsigned long long)value);
+            break;
+
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            {
+              double dvalue;
+
+              if (!get_arg(args, argslen, &pos, 8, &value))
+                {
+                  goto truncated;
+                }
+
+              memcpy(&dvalue, &value, sizeof(dvalue));
+              spec[nspec++] = conv;
+              spec[nspec] = '\0';
+
+              n = nstar == 2 ? snprintf(&out[len], outlen - len, spec,
+                                        star[0], star[1], dvalue) :
+                  nstar == 1 ? snprintf(&out[len], outlen - len, spec,
+                                        star[0], dvalue) :
+                  snprintf(&out[len], outlen - len, spec, dvalue);
+            }
+            break;
+
+          case 's':
+            {
+              char str[256];
+              size_t slen;
+
+              if (pos >= argslen)
+                {
+                  goto truncated;
+                }
+
+              slen = strnlen((const char *)&args[pos], argslen - pos);
+              if (slen >= sizeof(str))
+                {
+                  slen = sizeof(str) - 1;
+                }
+
+              memcpy(str, &args[pos], slen);
+              str[slen] = '\0';
+              pos += slen + 1;
+              spec[nspec++] = 's';
+              spec[nspec] = '\0';
+
+              n = nstar == 2 ? snprintf(&out[len], outlen - len, spec,
+                                        star[0], star[1], str) :
+                  nstar == 1 ? snprintf(&out[len], outlen - len, spec,
+                                        star[0], str) :
+                  snprintf(&out[len], outlen - len, spec, str);
+            }
+            break;
+
+          default:
+            goto truncated;
+        }
+
+      if (n < 0)
+        {
+          break;
+        }
+
+      len += (size_t)n;
+      if (len >= outlen)
+        {
+          len = outlen - 1;
+          break;
+        }
+    }
+
+  return;
+
+truncated:
+  snprintf(&out[len], outlen - len, "...");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  struct cpu_state_s *state;
+  const uint8_t *note;
+  uint8_t *buffer = NULL;
+  size_t buflen = 0;
+  size_t offset;
+  FILE *instream;
+  FILE *outstream;
+  unsigned long freq = 100;
+  bool smp = false;
+  double ts;
+  char args[96];
+  int option;
+
+  while ((option = getopt(argc, argv, "sf:h")) > 0)
+    {
+      switch (option)
+        {
+          case 's':
+            smp = true;
+            break;
+
+          case 'f':
+            freq = strtoul(optarg, NULL, 0);
+            if (freq == 0)
+              {
+                fprintf(stderr, "ERROR: Invalid frequency: %s\n", optarg);
+                show_usage(argv[0], EXIT_FAILURE);
+              }
+            break;
+
+          case 'h':
+            show_usage(argv[0], EXIT_SUCCESS);
+            break;
+
+          default:
+            fprintf(stderr, "ERROR: Unrecognized option\n");
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+    }
+
+  if (optind + 2 != argc)
+    {
+      fprintf(stderr, "ERROR: Expected <note-file> and <json-file>\n");
+      show_usage(argv[0], EXIT_FAILURE);
+    }
+
+  /* Read the entire binary note stream into memory */
+
+  instream = fopen(argv[optind], "rb");
+  if (instream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind]);
+      return EXIT_FAILURE;
+    }
+
+  for (; ; )
+    {
+      uint8_t *newbuf = realloc(buffer, buflen + 4096);
+      size_t nread;
+
+      if (newbuf == NULL)
+        {
+          fprintf(stderr, "ERROR: Out of memory\n");
+          return EXIT_FAILURE;
+        }
+
+      buffer = newbuf;
+      nread  = fread(&buffer[buflen], 1, 4096, instream);
+      buflen += nread;
+
+      if (nread < 4096)
+        {
+          break;
+        }
+    }
+
+  fclose(instream);
+
+  outstream = fopen(argv[optind + 1], "w");
+  if (outstream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind + 1]);
+      return EXIT_FAILURE;
+    }
+
+  fprintf(outstream, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  print_event(outstream, "M", "process_name", PROC_CPUS, 0, 0.0,
+              "\"name\":\"CPUs\"");
+  print_event(outstream, "M", "process_name", PROC_TASKS, 0, 0.0,
+              "\"name\":\"Tasks\"");
+
+  /* The common note header is:
+   *
+   *   length, type, priority, [cpu,] pid[2], systime[4]
+   */
+
+  for (offset = 0; offset < buflen; offset += note[0])
+    {
+      unsigned int hdrlen = smp ? 9 : 8;
+      unsigned int type;
+      unsigned int prio;
+      unsigned int cpu = 0;
+      unsigned int pid;
+      uint32_t systime;
+      const uint8_t *data;
+
+      note = &buffer[offset];
+      if (note[0] < hdrlen || offset + note[0] > buflen)
+        {
+          fprintf(stderr, "ERROR: Bad note at offset %lu\n",
+                  (unsigned long)offset);
+          break;
+        }
+
+      type = note[1];
+      prio = note[2];
+      data = &note[3];
+
+      if (smp)
+        {
+          cpu = *data++;
+          if (cpu >= MAX_CPUS)
+            {
+              fprintf(stderr, "ERROR: Bad CPU %u at offset %lu\n", cpu,
+                      (unsigned long)offset);
+              break;
+            }
+        }
+
+      pid     = (unsigned int)data[0] | ((unsigned int)data[1] << 8);
+      systime = (uint32_t)data[2] | ((uint32_t)data[3] << 8) |
+                ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24);
+      data   += 6;
+
+      /* Extend the 32-bit time stamp.  Time stamps are only monotonic per
+       * CPU, so each CPU is extended separately.
+       */
+
+      state = &g_cpu[cpu];
+      if (state->seen && systime < state->lasttime)
+        {
+          state->hitime += (uint64_t)1 << 32;
+        }
+
+      state->lasttime = systime;
+      ts = (double)(state->hitime + systime) * 1000000.0 / (double)freq;
+
+      if (!state->seen)
+        {
+          state->seen = true;
+          snprintf(args, sizeof(args), "\"name\":\"CPU %u\"", cpu);
+          print_event(outstream, "M", "thread_name", PROC_CPUS, cpu, 0.0, args);
+        }
+
+      switch (type)
+        {
+          case NOTE_START:
+            if (note[0] > hdrlen)
+              {
+                size_t namelen = note[0] - hdrlen;
+
+                if (namelen >= MAX_NAME)
+                  {
+                    namelen = MAX_NAME - 1;
+                  }
+
+                memcpy(g_names[pid], data, namelen);
+                g_names[pid][namelen] = '\0';
+              }
+
+            snprintf(args, sizeof(args), "\"pid\":%u,\"priority\":%u",
+                     pid, prio);
+            print_event(outstream, "i", "start", PROC_CPUS, cpu, ts, args);
+            break;
+
+          case NOTE_RESUME:
+
+            /* The task now runs on this CPU.  A missing suspend (e.g., a
+             * dropped note) closes the previous slice here.
+             */
+
+            if (state->running)
+              {
+                print_event(outstream, "E", "", PROC_CPUS, cpu, ts, NULL);
+              }
+
+            snprintf(args, sizeof(args), "\"pid\":%u,\"priority\":%u",
+                     pid, prio);
+            print_event(outstream, "B", task_name(pid), PROC_CPUS, cpu, ts, args);
+            state->running = true;
+            break;
+
+          case NOTE_SUSPEND:
+          case NOTE_STOP:
+            if (state->running)
+              {
+                snprintf(args, sizeof(args), "\"state\":%u",
+                         note[0] > hdrlen ? data[0] : 0);
+                print_event(outstream, "E", "", PROC_CPUS, cpu, ts, args);
+                state->running = false;
+              }
+
+            if (type == NOTE_STOP)
+              {
+                snprintf(args, sizeof(args), "\"pid\":%u", pid);
+                print_event(outstream, "i", "stop", PROC_CPUS, cpu, ts, args);
+              }
+            break;
+
+          case NOTE_DUMP_STRING:
+          case NOTE_DUMP_BEGIN:
+          case NOTE_DUMP_END:
+          case NOTE_DUMP_PRINTF:
+            {
+              char text[MAX_TEXT];
+              unsigned int category;
+
+              if (note[0] < hdrlen + 2)
+                {
+                  break;
+                }
+
+              category = data[0];
+              if (type == NOTE_DUMP_PRINTF)
+                {
+                  size_t fmtlen  = data[1];
+                  size_t datalen = note[0] - hdrlen - 2;
+
+                  if (fmtlen > datalen)
+                    {
+                      fmtlen = datalen;
+                    }
+
+                  render_printf((const char *)&data[2], fmtlen,
+                                &data[2 + fmtlen], datalen - fmtlen,
+                                text, sizeof(text));
+                }
+              else
+                {
+                  size_t textlen = note[0] - hdrlen - 1;
+
+                  if (textlen >= sizeof(text))
+                    {
+                      textlen = sizeof(text) - 1;
+                    }
+
+                  memcpy(text, &data[1], textlen);
+                  text[textlen] = '\0';
+                }
+
+              snprintf(args, sizeof(args), "\"pid\":%u,\"category\":%u",
+                       pid, category);
+
+              if (type == NOTE_DUMP_STRING || type == NOTE_DUMP_PRINTF)
+                {
+                  print_event(outstream, "i", text, PROC_CPUS, cpu, ts,
+                              args);
+                  break;
+                }
+
+              /* Begin/end pairs are shown on a track for the task so that
+               * they nest properly even if the task migrates or is
+               * preempted.
+               */
+
+              if (!g_trackseen[pid])
+                {
+                  char name[MAX_NAME + 32];
+
+                  g_trackseen[pid] = true;
+                  snprintf(name, sizeof(name), "\"name\":\"%s\"",
+                           task_name(pid));
+                  print_event(outstream, "M", "thread_name", PROC_TASKS, pid,
+                              0.0, name);
+                }
+
+              print_event(outstream, type == NOTE_DUMP_BEGIN ? "B" : "E",
+                          text, PROC_TASKS, pid, ts, args);
+            }
+            break;
+
+          default:
+            snprintf(args, sizeof(args), "\"pid\":%u", pid);
+            print_event(outstream, "i",
+                        type < NOTE_NTYPES ? g_typename[type] : "unknown",
+                        PROC_CPUS, cpu, ts, args);
+            break;
+        }
+    }
+
+  fprintf(outstream, "\n]}\n");
+  fclose(outstream);
+  free(buffer);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,436 @@
+/****************************************************************************
+ * tools/profile2folded.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of one sample.  This must agree with struct profile_sample_s in
+ * include/nuttx/sched_profile.h.
+ */
+
+#define SAMPLE_SIZE   8
+
+#define MAX_LINE      512
+#define MAX_COMMAND   1024
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct symbol_s
+{
+  uint32_t addr;
+  uint32_t size;     /* Zero if unknown */
+  char *name;
+};
+
+/* One sample reduced to the key that is counted */
+
+struct key_s
+{
+  unsigned int cpu;
+  unsigned int pid;
+  long sym;          /* Index into g_symbols or -1 if unknown */
+  uint32_t pc;       /* Only used if sym == -1 */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct symbol_s *g_symbols;
+static size_t g_nsymbols;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+  fprintf(stderr, "USAGE: %s [-n <nm>] [-c] [-p] [-b] <elf-file> "
+                  "<profile-file> [<folded-file>]\n", progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  -n <nm>:  The nm program of the target toolchain.  "
+                  "Default: nm\n");
+  fprintf(stderr, "  -c:  Add the CPU as the root frame\n");
+  fprintf(stderr, "  -p:  Do not add the thread ID as a frame\n");
+  fprintf(stderr, "  -b:  The samples are big endian.  Default: little "
+                  "endian\n");
+  fprintf(stderr, "  <elf-file>:  The nuttx ELF file that was profiled\n");
+  fprintf(stderr, "  <profile-file>:  Binary samples read from "
+                  "/dev/profile\n");
+  fprintf(stderr, "  <folded-file>:  Folded stacks for flamegraph.pl.  "
+                  "Default: stdout\n");
+  exit(exitcode);
+}
+
+static int compare_symbol(const void *a, const void *b)
+{
+  const struct symbol_s *sa = a;
+  const struct symbol_s *sb = b;
+
+  return sa->addr < sb->addr ? -1 : sa->addr > sb->addr ? 1 : 0;
+}
+
+static int compare_key(const void *a, const void *b)
+{
+  const struct key_s *ka = a;
+  const struct key_s *kb = b;
+
+  if (ka->cpu != kb->cpu)
+    {
+      return ka->cpu < kb->cpu ? -1 : 1;
+    }
+
+  if (ka->pid != kb->pid)
+    {
+      return ka->pid < kb->pid ? -1 : 1;
+    }
+
+  if (ka->sym != kb->sym)
+    {
+      return ka->sym < kb->sym ? -1 : 1;
+    }
+
+  if (ka->sym < 0 && ka->pc != kb->pc)
+    {
+      return ka->pc < kb->pc ? -1 : 1;
+    }
+
+  return 0;
+}
+
+/* Read the text symbols of the ELF file with nm */
+
+static void load_symbols(const char *nm, const char *elf)
+{
+  char command[MAX_COMMAND];
+  char line[MAX_LINE];
+  char name[MAX_LINE];
+  unsigned long addr;
+  unsigned long size;
+  size_t allocated = 0;
+  char type;
+  FILE *stream;
+
+  snprintf(command, MAX_COMMAND, "%s -S --defined-only \"%s\"", nm, elf);
+  stream = popen(command, "r");
+  if (stream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to run: %s\n", command);
+      exit(EXIT_FAILURE);
+    }
+
+  while (fgets(line, MAX_LINE, stream) != NULL)
+    {
+      /* Symbols without a size have only three fields */
+
+      if (sscanf(line, "%lx %lx %c %s", &addr, &size, &type, name) != 4)
+        {
+          size = 0;
+          if (sscanf(line, "%lx %c %s", &addr, &type, name) != 3)
+            {
+              continue;
+            }
+        }
+
+      /* Only functions (text symbols, including weak ones) */
+
+      if (type != 't' && type != 'T' && type != 'w' && type != 'W')
+        {
+          continue;
+        }
+
+      if (g_nsymbols >= allocated)
+        {
+          allocated = allocated ? 2 * allocated : 1024;
+          g_symbols = realloc(g_symbols, allocated * sizeof(struct symbol_s));
+          if (g_symbols == NULL)
+            {
+              fprintf(stderr, "ERROR: Out of memory\n");
+              exit(EXIT_FAILURE);
+            }
+        }
+
+      /* Thumb function addresses have bit 0 set */
+
+      g_symbols[g_nsymbols].addr = (uint32_t)addr & ~1u;
+      g_symbols[g_nsymbols].size = (uint32_t)size;
+      g_symbols[g_nsymbols].name = strdup(name);
+      g_nsymbols++;
+    }
+
+  if (pclose(stream) != 0 || g_nsymbols == 0)
+    {
+      fprintf(stderr, "ERROR: No symbols from: %s\n", command);
+      exit(EXIT_FAILURE);
+    }
+
+  qsort(g_symbols, g_nsymbols, sizeof(struct symbol_s), compare_symbol);
+}
+
+/* Return the index of the function containing pc, or -1 */
+
+static long find_symbol(uint32_t pc)
+{
+  size_t low = 0;
+  size_t high = g_nsymbols;
+
+  /* Find the last symbol at or below pc */
+
+  while (low < high)
+    {
+      size_t mid = (low + high) / 2;
+
+      if (g_symbols[mid].addr <= pc)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+
+  if (low == 0)
+    {
+      return -1;
+    }
+
+  /* Not in any function if beyond the end of the preceding one */
+
+  low--;
+  if (g_symbols[low].size != 0 &&
+      pc - g_symbols[low].addr >= g_symbols[low].size)
+    {
+      return -1;
+    }
+
+  return (long)low;
+}
+
+static uint32_t get_uint32(const uint8_t *data, bool bigendian)
+{
+  if (bigendian)
+    {
+      return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 |
+             (uint32_t)data[2] << 8 | (uint32_t)data[3];
+    }
+
+  return (uint32_t)data[3] << 24 | (uint32_t)data[2] << 16 |
+         (uint32_t)data[1] << 8 | (uint32_t)data[0];
+}
+
+static unsigned int get_uint16(const uint8_t *data, bool bigendian)
+{
+  return bigendian ? (unsigned int)data[0] << 8 | data[1] :
+                     (unsigned int)data[1] << 8 | data[0];
+}
+
+static void print_key(FILE *stream, const struct key_s *key, bool showcpu,
+                      bool showpid, unsigned long count)
+{
+  if (showcpu)
+    {
+      fprintf(stream, "cpu%u;", key->cpu);
+    }
+
+  if (showpid)
+    {
+      if (key->pid == 0)
+        {
+          fprintf(stream, "idle;");
+        }
+      else
+        {
+          fprintf(stream, "pid %u;", key->pid);
+        }
+    }
+
+  if (key->sym >= 0)
+    {
+      fprintf(stream, "%s %lu\n", g_symbols[key->sym].name, count);
+    }
+  else
+    {
+      fprintf(stream, "0x%08lx %lu\n", (unsigned long)key->pc, count);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  uint8_t sample[SAMPLE_SIZE];
+  struct key_s *keys = NULL;
+  size_t nkeys = 0;
+  size_t allocated = 0;
+  size_t i;
+  size_t j;
+  const char *nm = "nm";
+  bool showcpu = false;
+  bool showpid = true;
+  bool bigendian = false;
+  FILE *instream;
+  FILE *outstream;
+  int option;
+
+  while ((option = getopt(argc, argv, "n:cpbh")) > 0)
+    {
+      switch (option)
+        {
+          case 'n':
+            nm = optarg;
+            break;
+
+          case 'c':
+            showcpu = true;
+            break;
+
+          case 'p':
+            showpid = false;
+            break;
+
+          case 'b':
+            bigendian = true;
+            break;
+
+          case 'h':
+            show_usage(argv[0], EXIT_SUCCESS);
+            break;
+
+          default:
+            fprintf(stderr, "ERROR: Unrecognized option\n");
+            show_usage(argv[0], EXIT_FAILURE);
+            break;
+        }
+    }
+
+  if (optind + 2 != argc && optind + 3 != argc)
+    {
+      fprintf(stderr, "ERROR: Missing file names\n");
+      show_usage(argv[0], EXIT_FAILURE);
+    }
+
+  load_symbols(nm, argv[optind]);
+
+  instream = fopen(argv[optind + 1], "rb");
+  if (instream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind + 1]);
+      return EXIT_FAILURE;
+    }
+
+  /* Reduce each sample to its key */
+
+  while (fread(sample, SAMPLE_SIZE, 1, instream) == 1)
+    {
+      if (nkeys >= allocated)
+        {
+          allocated = allocated ? 2 * allocated : 4096;
+          keys = realloc(keys, allocated * sizeof(struct key_s));
+          if (keys == NULL)
+            {
+              fprintf(stderr, "ERROR: Out of memory\n");
+              return EXIT_FAILURE;
+            }
+        }
+
+      keys[nkeys].pc  = get_uint32(&sample[0], bigendian);
+      keys[nkeys].pid = get_uint16(&sample[4], bigendian);
+      keys[nkeys].cpu = showcpu ? sample[6] : 0;
+      keys[nkeys].sym = find_symbol(keys[nkeys].pc);
+
+      if (!showpid)
+        {
+          keys[nkeys].pid = 0;
+        }
+
+      nkeys++;
+    }
+
+  fclose(instream);
+
+  if (optind + 3 == argc)
+    {
+      outstream = fopen(argv[optind + 2], "w");
+      if (outstream == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind + 2]);
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      outstream = stdout;
+    }
+
+  /* Sort the keys and output the count of each distinct key */
+
+  qsort(keys, nkeys, sizeof(struct key_s), compare_key);
+
+  for (i = 0; i < nkeys; i = j)
+    {
+      for (j = i + 1; j < nkeys && compare_key(&keys[i], &keys[j]) == 0;
+           j++)
+        {
+        }
+
+      print_key(outstream, &keys[i], showcpu, showpid,
+                (unsigned long)(j - i));
+    }
+
+  if (outstream != stdout)
+    {
+      fclose(outstream);
+    }
+
+  free(keys);
+  return EXIT_SUCCESS;
+}
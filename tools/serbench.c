@@ -0,0 +1,235 @@
+/****************************************************************************
+ * tools/serbench.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <termios.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define DEFAULT_SECONDS   10
+#define DEFAULT_BLOCKSIZE 4096
+#define MAX_BLOCKSIZE     65536
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t g_buffer[MAX_BLOCKSIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+  fprintf(stderr, "USAGE: %s [-w] [-t <seconds>] [-b <blocksize>] "
+                  "<tty-device>\n", progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  -w:  Measure host-to-target throughput by writing.  "
+                  "Default: Measure\n"
+                  "       target-to-host throughput by reading\n");
+  fprintf(stderr, "  -t <seconds>:  The duration of the measurement.  "
+                  "Default: %d\n", DEFAULT_SECONDS);
+  fprintf(stderr, "  -b <blocksize>:  The size of each read() or "
+                  "write().  Default: %d\n", DEFAULT_BLOCKSIZE);
+  fprintf(stderr, "  <tty-device>:  The serial device, for example "
+                  "/dev/ttyACM0\n");
+  exit(exitcode);
+}
+
+static double now(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  struct termios tio;
+  bool writing = false;
+  unsigned long seconds = DEFAULT_SECONDS;
+  unsigned long blocksize = DEFAULT_BLOCKSIZE;
+  unsigned long long total = 0;
+  unsigned long long interval = 0;
+  unsigned long calls = 0;
+  double start;
+  double last;
+  double current;
+  ssize_t nbytes;
+  int option;
+  int fd;
+
+  while ((option = getopt(argc, argv, "wt:b:h")) > 0)
+    {
+      switch (option)
+        {
+          case 'w':
+            writing = true;
+            break;
+
+          case 't':
+            seconds = strtoul(optarg, NULL, 0);
+            break;
+
+          case 'b':
+            blocksize = strtoul(optarg, NULL, 0);
+            if (blocksize < 1 || blocksize > MAX_BLOCKSIZE)
+              {
+                fprintf(stderr, "ERROR: Block size must be 1-%d\n",
+                        MAX_BLOCKSIZE);
+                show_usage(argv[0], EXIT_FAILURE);
+              }
+            break;
+
+          case 'h':
+            show_usage(argv[0], EXIT_SUCCESS);
+            break;
+
+          default:
+            fprintf(stderr, "ERROR: Unrecognized option\n");
+            show_usage(argv[0], EXIT_FAILURE);
+            break;
+        }
+    }
+
+  if (optind + 1 != argc)
+    {
+      fprintf(stderr, "ERROR: Missing device name\n");
+      show_usage(argv[0], EXIT_FAILURE);
+    }
+
+  fd = open(argv[optind], writing ? O_WRONLY | O_NOCTTY :
+                                    O_RDONLY | O_NOCTTY);
+  if (fd < 0)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s: %s\n", argv[optind],
+              strerror(errno));
+      return EXIT_FAILURE;
+    }
+
+  /* Raw mode so that the host line discipline does not alter or throttle
+   * the data.  Reads return as soon as any data is available.
+   */
+
+  if (tcgetattr(fd, &tio) == 0)
+    {
+      cfmakeraw(&tio);
+      tio.c_cc[VMIN]  = 1;
+      tio.c_cc[VTIME] = 0;
+      (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+
+  memset(g_buffer, 'U', sizeof(g_buffer));
+
+  start   = now();
+  last    = start;
+  current = start;
+
+  do
+    {
+      if (writing)
+        {
+          nbytes = write(fd, g_buffer, blocksize);
+        }
+      else
+        {
+          nbytes = read(fd, g_buffer, blocksize);
+        }
+
+      if (nbytes < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+
+          fprintf(stderr, "ERROR: %s failed: %s\n",
+                  writing ? "write" : "read", strerror(errno));
+          break;
+        }
+      else if (nbytes == 0 && !writing)
+        {
+          fprintf(stderr, "End of file\n");
+          break;
+        }
+
+      total    += nbytes;
+      interval += nbytes;
+      calls++;
+
+      /* Report the throughput of each one second interval */
+
+      current = now();
+      if (current - last >= 1.0)
+        {
+          printf("%8.1f s: %10.0f bytes/s\n", current - start,
+                 (double)interval / (current - last));
+          fflush(stdout);
+
+          interval = 0;
+          last     = current;
+        }
+    }
+  while (current - start < (double)seconds);
+
+  current = now();
+  printf("Total: %llu bytes in %.2f s: %.0f bytes/s, "
+         "%.1f bytes per %s()\n",
+         total, current - start, (double)total / (current - start),
+         calls > 0 ? (double)total / calls : 0.0,
+         writing ? "write" : "read");
+
+  close(fd);
+  return EXIT_SUCCESS;
+}
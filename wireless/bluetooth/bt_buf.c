@@ -289,7 +289,7 @@ FAR struct bt_buf_s *bt_buf_alloc(enum bt_buf_type_e type,
           buf           = g_buf_free;
           g_buf_free    = buf->flink;
 
-          leave_critical_section(flags);
+          spin_unlock_irqrestore(flags);
           pool          = POOL_BUFFER_GENERAL;
         }
       else
@@ -299,7 +299,7 @@ FAR struct bt_buf_s *bt_buf_alloc(enum bt_buf_type_e type,
            * will have to allocate one from the kernel memory pool.
            */
 
-          leave_critical_section(flags);
+          spin_unlock_irqrestore(flags);
           buf = (FAR struct bt_buf_s *)kmm_malloc((sizeof (struct bt_buf_s)));
 
           /* Check if we successfully allocated the buffer structure */
@@ -348,7 +348,7 @@ FAR struct bt_buf_s *bt_buf_alloc(enum bt_buf_type_e type,
        * available buffers.
        */
 
-      buf->frame = iob_alloc(false);
+      buf->frame = iob_alloc_user(false, IOB_USER_BLUETOOTH);
       if (!buf->frame)
         {
           wlerr("ERROR:  Failed to allocate an IOB\n");
@@ -123,13 +123,15 @@ static struct work_s g_hp_work;
  * Name: bt_enqueue_bufwork
  *
  * Description:
- *   Add the provided buffer 'buf' to the head selected buffer list 'list'
+ *   Add the provided buffer 'buf' to the tail of the selected buffer list
+ *   'list'
  *
  * Input Parameters:
  *   list - The buffer list to use
- *   buf  - The buffer to be added to the head of the buffer list
+ *   buf  - The buffer to be added to the tail of the buffer list
  *
  * Returned Value:
+ *   None
  *
  ****************************************************************************/
 
@@ -138,68 +140,91 @@ static void bt_enqueue_bufwork(FAR struct bt_bufferlist_s *list,
 {
   irqstate_t flags;
 
-  flags      = spin_lock_irqsave();
-  buf->flink = list->head;
-  if (list->head == NULL)
+  buf->flink = NULL;
+
+  flags = spin_lock_irqsave();
+  if (list->tail == NULL)
+    {
+      list->head = buf;
+    }
+  else
     {
-      list->tail = buf;
+      list->tail->flink = buf;
     }
 
-  list->head = buf;
+  list->tail = buf;
   spin_unlock_irqrestore(flags);
 }
 
 /****************************************************************************
- * Name: bt_dequeue_bufwork
+ * Name: bt_detach_bufwork
  *
  * Description:
- *   Remove and return the buffer at the tail of the buffer list specified
- *   by 'list'.
+ *   Remove all of the buffers from the buffer list specified by 'list' and
+ *   return them, oldest first, linked through their flink fields.  The work
+ *   functions process the entire batch with a single lock operation rather
+ *   than locking once per buffer.
  *
  * Input Parameters:
  *   list - The buffer list to use
  *
  * Returned Value:
- *   A pointer to the buffer that was at the tail of the buffer list.  NULL
+ *   A pointer to the buffer that was at the head of the buffer list.  NULL
  *   is returned if the list was empty.
  *
  ****************************************************************************/
 
-static FAR struct bt_buf_s *bt_dequeue_bufwork(FAR struct bt_bufferlist_s *list)
+static FAR struct bt_buf_s *bt_detach_bufwork(FAR struct bt_bufferlist_s *list)
 {
   FAR struct bt_buf_s *buf;
   irqstate_t flags;
 
-  flags = spin_lock_irqsave();
-  buf   = list->tail;
-  if (buf != NULL)
-    {
-      if (list->head == list->tail)
-        {
-          list->head = NULL;
-          list->tail = NULL;
-        }
-      else
-        {
-          FAR struct bt_buf_s *prev;
+  flags      = spin_lock_irqsave();
+  buf        = list->head;
+  list->head = NULL;
+  list->tail = NULL;
+  spin_unlock_irqrestore(flags);
 
-          for (prev = list->head;
-               prev && prev->flink != buf;
-               prev = prev->flink)
-           {
-           }
+  return buf;
+}
 
-          if (prev != NULL)
-            {
-              prev->flink = NULL;
-              list->tail  = prev;
-            }
-        }
+/****************************************************************************
+ * Name: bt_next_bufwork
+ *
+ * Description:
+ *   Return the next buffer to be processed by a work function.  Buffers are
+ *   taken from the local 'batch' list; when that is empty, all of the
+ *   buffers pending in 'list' are detached as the next batch.
+ *
+ * Input Parameters:
+ *   list  - The buffer list to use
+ *   batch - The work function's local list of detached buffers.  Must be
+ *           initialized to NULL.
+ *
+ * Returned Value:
+ *   A pointer to the next buffer, oldest first.  NULL is returned if there
+ *   are no further buffers.
+ *
+ ****************************************************************************/
 
+static FAR struct bt_buf_s *bt_next_bufwork(FAR struct bt_bufferlist_s *list,
+                                            FAR struct bt_buf_s **batch)
+{
+  FAR struct bt_buf_s *buf = *batch;
+
+  if (buf == NULL)
+    {
+      buf = bt_detach_bufwork(list);
+    }
+
+  if (buf != NULL)
+    {
+      /* Unlink it now:  The handlers may re-use the flink field */
+
+      *batch     = buf->flink;
       buf->flink = NULL;
     }
 
-  spin_unlock_irqrestore(flags);
   return buf;
 }
 
@@ -1031,12 +1056,13 @@ static int hci_tx_kthread(int argc, FAR char *argv[])
 static void hci_rx_work(FAR void *arg)
 {
   FAR struct bt_bufferlist_s *list = (FAR struct bt_bufferlist_s *)arg;
+  FAR struct bt_buf_s *batch = NULL;
   FAR struct bt_buf_s *buf;
 
   wlinfo("list %p\n", list);
   DEBUGASSERT(list != NULL);
 
-  while ((buf = bt_dequeue_bufwork(list)) != NULL)
+  while ((buf = bt_next_bufwork(list, &batch)) != NULL)
     {
       wlinfo("buf %p type %u len %u\n", buf, buf->type, buf->len);
 
@@ -1076,12 +1102,13 @@ static void hci_rx_work(FAR void *arg)
 static void priority_rx_work(FAR void *arg)
 {
   FAR struct bt_bufferlist_s *list = (FAR struct bt_bufferlist_s *)arg;
+  FAR struct bt_buf_s *batch = NULL;
   FAR struct bt_buf_s *buf;
 
   wlinfo("list %p\n", list);
   DEBUGASSERT(list != NULL);
 
-  while ((buf = bt_dequeue_bufwork(list)) != NULL)
+  while ((buf = bt_next_bufwork(list, &batch)) != NULL)
     {
       FAR struct bt_hci_evt_hdr_s *hdr = (FAR void *)buf->data;
 
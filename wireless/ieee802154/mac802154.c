@@ -50,6 +50,7 @@
 #include <debug.h>
 #include <string.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/semaphore.h>
@@ -74,6 +75,16 @@
 
 static void mac802154_resetqueues(FAR struct ieee802154_privmac_s *priv);
 
+/* Indirect transaction list and destination index */
+
+static void mac802154_indirect_add(FAR struct ieee802154_privmac_s *priv,
+                                   FAR struct ieee802154_txdesc_s *txdesc);
+static void mac802154_indirect_rem(FAR struct ieee802154_privmac_s *priv,
+                                   FAR struct ieee802154_txdesc_s *txdesc);
+static FAR struct ieee802154_txdesc_s *
+  mac802154_indirect_find(FAR struct ieee802154_privmac_s *priv,
+                          FAR const struct ieee802154_addr_s *addr);
+
 /* IEEE 802.15.4 PHY Interface OPs */
 
 static int mac802154_radiopoll(FAR const struct ieee802154_radiocb_s *radiocb,
@@ -120,11 +131,17 @@ static void mac802154_resetqueues(FAR struct ieee802154_privmac_s *priv)
 
   sq_init(&priv->txdone_queue);
   sq_init(&priv->csma_queue);
+  sq_init(&priv->csma_cmdqueue);
   sq_init(&priv->gts_queue);
-  sq_init(&priv->indirect_queue);
+  dq_init(&priv->indirect_queue);
   sq_init(&priv->dataind_queue);
   sq_init(&priv->primitive_queue);
 
+  for (i = 0; i < CONFIG_MAC802154_INDIRECT_HASHSIZE; i++)
+    {
+      priv->indirect_hash[i] = NULL;
+    }
+
   /* Initialize the tx descriptor allocation pool */
 
   sq_init(&priv->txdesc_queue);
@@ -136,6 +153,151 @@ static void mac802154_resetqueues(FAR struct ieee802154_privmac_s *priv)
   nxsem_init(&priv->txdesc_sem, 0, CONFIG_MAC802154_NTXDESC);
 }
 
+/****************************************************************************
+ * Name: mac802154_indirect_hash
+ *
+ * Description:
+ *   Return the index bucket for an indirect transaction destination address.
+ *
+ ****************************************************************************/
+
+static unsigned int
+  mac802154_indirect_hash(FAR const struct ieee802154_addr_s *addr)
+{
+  FAR const uint8_t *ptr;
+  unsigned int hash = 0;
+  int len;
+
+  if (addr->mode == IEEE802154_ADDRMODE_SHORT)
+    {
+      ptr = addr->saddr;
+      len = IEEE802154_SADDRSIZE;
+    }
+  else
+    {
+      ptr = addr->eaddr;
+      len = IEEE802154_EADDRSIZE;
+    }
+
+  while (len-- > 0)
+    {
+      hash ^= *ptr++;
+    }
+
+  return hash & (CONFIG_MAC802154_INDIRECT_HASHSIZE - 1);
+}
+
+/****************************************************************************
+ * Name: mac802154_indirect_add
+ *
+ * Description:
+ *   Link a transaction at the end of the indirect list and into the tail of
+ *   its destination bucket so that both stay in order of arrival (and thus
+ *   in order of expiry).
+ *
+ * Assumptions:
+ *    Called with the MAC locked
+ *
+ ****************************************************************************/
+
+static void mac802154_indirect_add(FAR struct ieee802154_privmac_s *priv,
+                                   FAR struct ieee802154_txdesc_s *txdesc)
+{
+  FAR struct ieee802154_txdesc_s **link;
+
+  dq_addlast((FAR dq_entry_t *)txdesc, &priv->indirect_queue);
+
+  link = &priv->indirect_hash[mac802154_indirect_hash(&txdesc->destaddr)];
+  while (*link != NULL)
+    {
+      link = &(*link)->hlink;
+    }
+
+  txdesc->hlink = NULL;
+  *link = txdesc;
+}
+
+/****************************************************************************
+ * Name: mac802154_indirect_rem
+ *
+ * Description:
+ *   Unlink a transaction from the indirect list and the destination index.
+ *
+ * Assumptions:
+ *    Called with the MAC locked
+ *
+ ****************************************************************************/
+
+static void mac802154_indirect_rem(FAR struct ieee802154_privmac_s *priv,
+                                   FAR struct ieee802154_txdesc_s *txdesc)
+{
+  FAR struct ieee802154_txdesc_s **link;
+
+  dq_rem((FAR dq_entry_t *)txdesc, &priv->indirect_queue);
+
+  link = &priv->indirect_hash[mac802154_indirect_hash(&txdesc->destaddr)];
+  while (*link != NULL)
+    {
+      if (*link == txdesc)
+        {
+          *link = txdesc->hlink;
+          break;
+        }
+
+      link = &(*link)->hlink;
+    }
+
+  txdesc->hlink = NULL;
+}
+
+/****************************************************************************
+ * Name: mac802154_indirect_find
+ *
+ * Description:
+ *   Return the oldest indirect transaction pending for the given address,
+ *   or NULL if there is none.
+ *
+ * Assumptions:
+ *    Called with the MAC locked
+ *
+ ****************************************************************************/
+
+static FAR struct ieee802154_txdesc_s *
+  mac802154_indirect_find(FAR struct ieee802154_privmac_s *priv,
+                          FAR const struct ieee802154_addr_s *addr)
+{
+  FAR struct ieee802154_txdesc_s *txdesc;
+
+  if (addr->mode != IEEE802154_ADDRMODE_SHORT &&
+      addr->mode != IEEE802154_ADDRMODE_EXTENDED)
+    {
+      return NULL;
+    }
+
+  txdesc = priv->indirect_hash[mac802154_indirect_hash(addr)];
+  for (; txdesc != NULL; txdesc = txdesc->hlink)
+    {
+      if (txdesc->destaddr.mode != addr->mode)
+        {
+          continue;
+        }
+
+      if (addr->mode == IEEE802154_ADDRMODE_SHORT)
+        {
+          if (IEEE802154_SADDRCMP(txdesc->destaddr.saddr, addr->saddr))
+            {
+              return txdesc;
+            }
+        }
+      else if (IEEE802154_EADDRCMP(txdesc->destaddr.eaddr, addr->eaddr))
+        {
+          return txdesc;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: mac802154_txdesc_pool
  *
@@ -577,7 +739,7 @@ void mac802154_updatebeacon(FAR struct ieee802154_privmac_s *priv)
 
   pendaddrspec_ind = beacon->bf_len++;
 
-  txdesc = (FAR struct ieee802154_txdesc_s *)sq_peek(&priv->indirect_queue);
+  txdesc = (FAR struct ieee802154_txdesc_s *)dq_peek(&priv->indirect_queue);
 
   while(txdesc != NULL)
     {
@@ -603,7 +765,7 @@ void mac802154_updatebeacon(FAR struct ieee802154_privmac_s *priv)
 
       /* Get the next pending indirect transation */
 
-      txdesc = (FAR struct ieee802154_txdesc_s *)sq_next((FAR sq_entry_t *)txdesc);
+      txdesc = (FAR struct ieee802154_txdesc_s *)dq_next((FAR dq_entry_t *)txdesc);
     }
 
   /* At this point, we know how many of each transaction we have, we can setup
@@ -643,7 +805,7 @@ void mac802154_setupindirect(FAR struct ieee802154_privmac_s *priv,
 
   /* Link the tx descriptor into the list */
 
-  sq_addlast((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
+  mac802154_indirect_add(priv, txdesc);
 
   /* Update the timestamp for purging the transaction */
 
@@ -720,7 +882,7 @@ static void mac802154_purge_worker(FAR void *arg)
      * passed.
      */
 
-    txdesc = (FAR struct ieee802154_txdesc_s *)sq_peek(&priv->indirect_queue);
+    txdesc = (FAR struct ieee802154_txdesc_s *)dq_peek(&priv->indirect_queue);
 
     if (txdesc == NULL)
       {
@@ -736,7 +898,7 @@ static void mac802154_purge_worker(FAR void *arg)
       {
         /* Unlink the transaction */
 
-        sq_remfirst(&priv->indirect_queue);
+        mac802154_indirect_rem(priv, txdesc);
 
         /* Free the IOB, the notification, and the tx descriptor */
 
@@ -793,9 +955,15 @@ static int mac802154_radiopoll(FAR const struct ieee802154_radiocb_s *radiocb,
     }
   else
     {
-      /* Check to see if there are any CSMA transactions waiting */
+      /* Check to see if there are any CSMA transactions waiting.  Pending
+       * MAC commands are always sent ahead of queued data frames.
+       */
 
-      *txdesc = (FAR struct ieee802154_txdesc_s *)sq_remfirst(&priv->csma_queue);
+      *txdesc = (FAR struct ieee802154_txdesc_s *)sq_remfirst(&priv->csma_cmdqueue);
+      if (*txdesc == NULL)
+        {
+          *txdesc = (FAR struct ieee802154_txdesc_s *)sq_remfirst(&priv->csma_queue);
+        }
     }
 
   mac802154_unlock(priv)
@@ -819,6 +987,10 @@ static int mac802154_radiopoll(FAR const struct ieee802154_radiocb_s *radiocb,
  *   transaction.  This function copies the descriptor and schedules work to
  *   handle the transaction without blocking the radio.
  *
+ *   The completion queue is protected by a critical section rather than the
+ *   MAC lock so that the radio's ACK/TX done path never waits behind a MAC
+ *   operation in progress and so it is safe to call from interrupt level.
+ *
  ****************************************************************************/
 
 static void mac802154_txdone(FAR const struct ieee802154_radiocb_s *radiocb,
@@ -827,19 +999,14 @@ static void mac802154_txdone(FAR const struct ieee802154_radiocb_s *radiocb,
   FAR struct mac802154_radiocb_s *cb =
     (FAR struct mac802154_radiocb_s *)radiocb;
   FAR struct ieee802154_privmac_s *priv;
+  irqstate_t flags;
 
   DEBUGASSERT(cb != NULL && cb->priv != NULL);
   priv = cb->priv;
 
-  /* Get exclusive access to the driver structure.  We don't care about any
-   * signals so don't allow interruptions
-   */
-
-  mac802154_lock(priv, false);
-
+  flags = enter_critical_section();
   sq_addlast((FAR sq_entry_t *)txdesc, &priv->txdone_queue);
-
-  mac802154_unlock(priv)
+  leave_critical_section(flags);
 
   /* Schedule work with the work queue to process the completion further */
 
@@ -866,6 +1033,14 @@ static void mac802154_txdone_worker(FAR void *arg)
     (FAR struct ieee802154_privmac_s *)arg;
   FAR struct ieee802154_txdesc_s *txdesc;
   FAR struct ieee802154_primitive_s *primitive;
+  sq_queue_t txdone;
+  irqstate_t flags;
+
+  /* Detach all of the completed transactions at once */
+
+  flags = enter_critical_section();
+  sq_move(&priv->txdone_queue, &txdone);
+  leave_critical_section(flags);
 
   /* Get exclusive access to the driver structure.  We don't care about any
    * signals so don't allow interruptions
@@ -875,7 +1050,7 @@ static void mac802154_txdone_worker(FAR void *arg)
 
   while (1)
     {
-      txdesc = (FAR struct ieee802154_txdesc_s *)sq_remfirst(&priv->txdone_queue);
+      txdesc = (FAR struct ieee802154_txdesc_s *)sq_remfirst(&txdone);
 
       if (txdesc == NULL)
         {
@@ -1428,60 +1603,27 @@ static void mac802154_rxdatareq(FAR struct ieee802154_privmac_s *priv,
    * need to check for this condition.
    */
 
-  txdesc = (FAR struct ieee802154_txdesc_s *)sq_peek(&priv->indirect_queue);
-
-  while(txdesc != NULL)
+  txdesc = mac802154_indirect_find(priv, &ind->src);
+  if (txdesc != NULL)
     {
-      if (txdesc->destaddr.mode == ind->src.mode)
-        {
-          if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_SHORT)
-            {
-              if (IEEE802154_SADDRCMP(txdesc->destaddr.saddr, ind->src.saddr))
-                {
-                  /* Remove the transaction from the queue */
-
-                  sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
+      /* Remove the transaction from the queue */
 
-                  /* NOTE: We don't do anything with the purge timeout, because
-                   * we really don't need to. As of now, I see no disadvantage
-                   * to just letting the timeout expire, which won't purge the
-                   * transaction since it is no longer on the list, and then it
-                   * will reschedule the next timeout appropriately. The logic
-                   * otherwise may get complicated even though it may save a few
-                   * clock cycles.
-                   */
+      mac802154_indirect_rem(priv, txdesc);
 
-                  /* The addresses match, send the transaction immediately */
-
-                  priv->radio->txdelayed(priv->radio, txdesc, 0);
-                  priv->beaconupdate = true;
-                  mac802154_unlock(priv)
-                  return;
-                }
-            }
-          else if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_EXTENDED)
-            {
-              if (IEEE802154_EADDRCMP(txdesc->destaddr.eaddr, ind->src.eaddr))
-                {
-                  /* Remove the transaction from the queue */
-
-                  sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
-
-                  /* The addresses match, send the transaction immediately */
+      /* NOTE: We don't do anything with the purge timeout, because we really
+       * don't need to. As of now, I see no disadvantage to just letting the
+       * timeout expire, which won't purge the transaction since it is no
+       * longer on the list, and then it will reschedule the next timeout
+       * appropriately. The logic otherwise may get complicated even though
+       * it may save a few clock cycles.
+       */
 
-                  priv->radio->txdelayed(priv->radio, txdesc, 0);
-                  priv->beaconupdate = true;
-                  mac802154_unlock(priv)
-                  return;
-                }
-            }
-          else
-            {
-              DEBUGASSERT(false);
-            }
-        }
+      /* The addresses match, send the transaction immediately */
 
-      txdesc = (FAR struct ieee802154_txdesc_s *)sq_next((FAR sq_entry_t *)txdesc);
+      priv->radio->txdelayed(priv->radio, txdesc, 0);
+      priv->beaconupdate = true;
+      mac802154_unlock(priv)
+      return;
     }
 
   /* If there is no data frame pending for the requesting device, the coordinator
@@ -1890,7 +2032,7 @@ static void mac802154_rxbeaconframe(FAR struct ieee802154_privmac_s *priv,
 
           /* Link the transaction into the CSMA transaction list */
 
-          sq_addlast((FAR sq_entry_t *)respdesc, &priv->csma_queue);
+          mac802154_csma_enqueue(priv, respdesc);
 
           /* Notify the radio driver that there is data available */
 
@@ -1949,7 +2091,7 @@ static void mac802154_rxbeaconframe(FAR struct ieee802154_privmac_s *priv,
 
                   /* Link the transaction into the CSMA transaction list */
 
-                  sq_addlast((FAR sq_entry_t *)respdesc, &priv->csma_queue);
+                  mac802154_csma_enqueue(priv, respdesc);
 
                   /* Notify the radio driver that there is data available */
 
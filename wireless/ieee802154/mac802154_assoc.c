@@ -296,7 +296,7 @@ int mac802154_req_associate(MACHANDLE mac,
 
       /* Link the transaction into the CSMA transaction list */
 
-      sq_addlast((FAR sq_entry_t *)txdesc, &priv->csma_queue);
+      mac802154_csma_enqueue(priv, txdesc);
 
       /* Notify the radio driver that there is data available */
 
@@ -80,6 +80,17 @@
 #  define CONFIG_MAC802154_NTXDESC 5
 #endif
 
+#if !defined(CONFIG_MAC802154_INDIRECT_HASHSIZE) || \
+    CONFIG_MAC802154_INDIRECT_HASHSIZE <= 0
+#  undef CONFIG_MAC802154_INDIRECT_HASHSIZE
+#  define CONFIG_MAC802154_INDIRECT_HASHSIZE 16
+#endif
+
+#if (CONFIG_MAC802154_INDIRECT_HASHSIZE & \
+     (CONFIG_MAC802154_INDIRECT_HASHSIZE - 1)) != 0
+#  error CONFIG_MAC802154_INDIRECT_HASHSIZE must be a power of two
+#endif
+
 #if !defined(CONFIG_IEEE802154_DEFAULT_EADDR)
 #  define CONFIG_IEEE802154_DEFAULT_EADDR 0xFFFFFFFFFFFFFFFF
 #endif
@@ -181,15 +192,27 @@ struct ieee802154_privmac_s
   sq_queue_t csma_queue;
   sq_queue_t gts_queue;
 
+  /* MAC command frames are queued separately and are always offered to the
+   * radio ahead of any queued CSMA data frames so that control traffic
+   * (association, data requests, etc.) is not delayed behind bulk data.
+   */
+
+  sq_queue_t csma_cmdqueue;
+
   /* Support a singly linked list of transactions that will be sent indirectly.
    * This list should only be used by a MAC acting as a coordinator.  These
    * transactions will stay here until the data is extracted by the destination
    * device sending a Data Request MAC command or if too much time passes. This
    * list should also be used to populate the address list of the outgoing
    * beacon frame.
+   *
+   * The list is doubly linked so that a transaction can be unlinked in
+   * constant time.  The index hashes each transaction by destination address
+   * so that a Data Request does not need to scan the whole list.
    */
 
-  sq_queue_t indirect_queue;
+  dq_queue_t indirect_queue;
+  FAR struct ieee802154_txdesc_s *indirect_hash[CONFIG_MAC802154_INDIRECT_HASHSIZE];
 
   /* Support a singly linked list of frames received */
 
@@ -795,4 +818,22 @@ static inline void mac802154_setdevmode(FAR struct ieee802154_privmac_s *priv,
                         (FAR const union ieee802154_attr_u *)&mode);
 }
 
+/* Queue a TX descriptor for transmission using CSMA.  MAC command frames go
+ * to the command queue, which the radio drains first.  Must be called with
+ * the MAC locked.
+ */
+
+static inline void mac802154_csma_enqueue(FAR struct ieee802154_privmac_s *priv,
+                                          FAR struct ieee802154_txdesc_s *txdesc)
+{
+  if (txdesc->frametype == IEEE802154_FRAME_COMMAND)
+    {
+      sq_addlast((FAR sq_entry_t *)txdesc, &priv->csma_cmdqueue);
+    }
+  else
+    {
+      sq_addlast((FAR sq_entry_t *)txdesc, &priv->csma_queue);
+    }
+}
+
 #endif /* __WIRELESS_IEEE802154__MAC802154_INTERNAL_H */
@@ -44,6 +44,7 @@
 #include <string.h>
 #include <errno.h>
 #include <assert.h>
+#include <syslog.h>
 #include <debug.h>
 
 #include <arpa/inet.h>
@@ -103,6 +104,18 @@
 #  define MAC_HDRLEN   0
 #endif
 
+/* Loopback batching, latency and loss (see Kconfig) */
+
+#define LO_BATCH     CONFIG_PKTRADIO_LOOPBACK_BATCH
+#define LO_LATENCY   MSEC2TICK(CONFIG_PKTRADIO_LOOPBACK_LATENCY)
+#define LO_LOSS      CONFIG_PKTRADIO_LOOPBACK_LOSS
+
+#ifdef CONFIG_PKTRADIO_LOOPBACK_STATS
+#  define LO_STAT(priv,name,n) ((priv)->name += (n))
+#else
+#  define LO_STAT(priv,name,n)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -118,8 +131,19 @@ struct lo_driver_s
   uint8_t lo_panid[2];         /* Fake PAN ID for testing */
   WDOG_ID lo_polldog;          /* TX poll timer */
   struct work_s lo_work;       /* For deferring poll work to the work queue */
+  struct work_s lo_lbwork;     /* For deferring loopback to the work queue */
   FAR struct iob_s *lo_head;   /* Head of IOBs queued for loopback */
   FAR struct iob_s *lo_tail;   /* Tail of IOBs queued for loopback */
+#if LO_LOSS > 0
+  uint32_t lo_seed;            /* Pseudo-random state for frame loss */
+#endif
+#ifdef CONFIG_PKTRADIO_LOOPBACK_STATS
+  clock_t lo_stattime;         /* Start of the statistics interval */
+  uint32_t lo_nframes;         /* Frames looped back in the interval */
+  uint32_t lo_nbytes;          /* Bytes looped back in the interval */
+  uint32_t lo_ndropped;        /* Frames lost in the interval */
+  uint32_t lo_nbatches;        /* Loopback work cycles in the interval */
+#endif
 
   /* This holds the information visible to the NuttX network */
 
@@ -157,8 +181,13 @@ static inline void lo_netmask(FAR struct net_driver_s *dev);
 
 /* Polling logic */
 
-static int  lo_loopback(FAR struct net_driver_s *dev);
+static unsigned int lo_loopback(FAR struct lo_driver_s *priv,
+              unsigned int maxframes);
+static int  lo_txpoll(FAR struct net_driver_s *dev);
 static void lo_loopback_work(FAR void *arg);
+#ifdef CONFIG_PKTRADIO_LOOPBACK_STATS
+static void lo_report(FAR struct lo_driver_s *priv);
+#endif
 static void lo_poll_work(FAR void *arg);
 static void lo_poll_expiry(int argc, wdparm_t arg, ...);
 
@@ -286,25 +315,24 @@ static inline void lo_netmask(FAR struct net_driver_s *dev)
  * Name: lo_loopback
  *
  * Description:
- *   Check if the network has any outgoing packets ready to send.  This is
- *   a callback from devif_poll() or devif_timer().  devif_poll() will be
- *   called only during normal TX polling.
+ *   Return the queued frames to the network.
  *
  * Input Parameters:
- *   dev - Reference to the NuttX driver state structure
+ *   priv      - Reference to the driver state structure
+ *   maxframes - The maximum number of frames to loop back
  *
  * Returned Value:
- *   OK on success; a negated errno on failure
+ *   The number of frames looped back
  *
  * Assumptions:
- *   May or may not be called from an interrupt handler.  In either case,
- *   the network is locked.
+ *   The network is locked.
  *
  ****************************************************************************/
 
-static int lo_loopback(FAR struct net_driver_s *dev)
+static unsigned int lo_loopback(FAR struct lo_driver_s *priv,
+                                unsigned int maxframes)
 {
-  FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
+  unsigned int nframes = 0;
   struct pktradio_metadata_s pktmeta;
   FAR struct iob_s *iob;
   int ret;
@@ -326,20 +354,16 @@ static int lo_loopback(FAR struct net_driver_s *dev)
    * for this driver.
    */
 
-  while (priv->lo_head != NULL)
+  while (priv->lo_head != NULL && nframes < maxframes)
     {
-      ninfo("Looping frame IOB %p\n", iob);
-
-      /* Increment statistics */
-
-      NETDEV_RXPACKETS(&priv->lo_radio.r_dev);
-
       /* Remove the IOB from the queue */
 
       iob           = priv->lo_head;
       priv->lo_head = iob->io_flink;
       iob->io_flink = NULL;
 
+      ninfo("Looping frame IOB %p\n", iob);
+
       /* Did the framelist become empty? */
 
       if (priv->lo_head == NULL)
@@ -347,6 +371,13 @@ static int lo_loopback(FAR struct net_driver_s *dev)
           priv->lo_tail = NULL;
         }
 
+      /* Increment statistics */
+
+      NETDEV_RXPACKETS(&priv->lo_radio.r_dev);
+      LO_STAT(priv, lo_nframes, 1);
+      LO_STAT(priv, lo_nbytes, iob->io_len);
+      nframes++;
+
       /* Make sure the our single packet buffer is attached */
 
       priv->lo_radio.r_dev.d_buf = g_iobuffer.rb_buf;
@@ -360,16 +391,51 @@ static int lo_loopback(FAR struct net_driver_s *dev)
 
       /* Increment statistics */
 
-      NETDEV_TXPACKETS(&priv->lo_radio.r_dev);
+      NETDEV_TXDONE(&priv->lo_radio.r_dev);
 
       if (ret < 0)
         {
           nerr("ERROR: sixlowpan_input returned %d\n", ret);
-          NETDEV_TXERRORS(&priv->lo_radio.r_dev);
-          NETDEV_ERRORS(&priv->lo_radio.r_dev);
+          NETDEV_RXERRORS(&priv->lo_radio.r_dev);
         }
     }
 
+  return nframes;
+}
+
+/****************************************************************************
+ * Name: lo_txpoll
+ *
+ * Description:
+ *   Check if the network has any outgoing packets ready to send.  This is
+ *   a callback from devif_poll() or devif_timer().  devif_poll() will be
+ *   called only during normal TX polling.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   OK on success; a negated errno on failure
+ *
+ * Assumptions:
+ *   May or may not be called from an interrupt handler.  In either case,
+ *   the network is locked.
+ *
+ ****************************************************************************/
+
+static int lo_txpoll(FAR struct net_driver_s *dev)
+{
+#if CONFIG_PKTRADIO_LOOPBACK_LATENCY == 0
+  FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
+
+  /* Frames sent during the poll were queued by lo_req_data().  Loop them
+   * back now.  With a simulated latency, they are left for the delayed
+   * loopback work instead.
+   */
+
+  (void)lo_loopback(priv, LO_BATCH);
+#endif
+
   return 0;
 }
 
@@ -377,7 +443,10 @@ static int lo_loopback(FAR struct net_driver_s *dev)
  * Name: lo_loopback_work
  *
  * Description:
- *   Perform loopback of received framelist.
+ *   Perform loopback of received framelist.  A TX poll that was deferred
+ *   while frames were queued is performed after the frames have been
+ *   looped back so that the network can send its next frames in the same
+ *   work cycle, up to CONFIG_PKTRADIO_LOOPBACK_BATCH frames.
  *
  * Input Parameters:
  *   arg - The argument passed when work_queue() as called.
@@ -393,14 +462,89 @@ static int lo_loopback(FAR struct net_driver_s *dev)
 static void lo_loopback_work(FAR void *arg)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)arg;
+  unsigned int nframes = 0;
 
   /* Perform the loopback */
 
   net_lock();
-  (void)lo_loopback(&priv->lo_radio.r_dev);
+  do
+    {
+      nframes += lo_loopback(priv, LO_BATCH - nframes);
+
+      /* Perform any deferred TX poll now that the queue has drained */
+
+      if (priv->lo_pending && priv->lo_head == NULL && priv->lo_bifup)
+        {
+          priv->lo_pending = false;
+#ifdef CONFIG_NET_6LOWPAN
+          priv->lo_radio.r_dev.d_buf = g_iobuffer.rb_buf;
+#endif
+          (void)devif_poll(&priv->lo_radio.r_dev, lo_txpoll);
+        }
+    }
+#if CONFIG_PKTRADIO_LOOPBACK_LATENCY == 0
+  while (priv->lo_head != NULL && nframes < LO_BATCH);
+#else
+  while (0);
+#endif
+
+  LO_STAT(priv, lo_nbatches, 1);
+
+  /* If the batch limit was reached, yield the work queue to other work
+   * and continue with the remaining frames later.
+   */
+
+  if (priv->lo_head != NULL && work_available(&priv->lo_lbwork))
+    {
+      work_queue(LPBKWORK, &priv->lo_lbwork, lo_loopback_work, priv,
+                 LO_LATENCY);
+    }
+
   net_unlock();
 }
 
+/****************************************************************************
+ * Name: lo_report
+ *
+ * Description:
+ *   Report the loopback throughput since the last report and start a new
+ *   statistics interval.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PKTRADIO_LOOPBACK_STATS
+static void lo_report(FAR struct lo_driver_s *priv)
+{
+  clock_t now = clock_systimer();
+
+  if (priv->lo_nframes > 0 || priv->lo_ndropped > 0)
+    {
+      syslog(LOG_INFO, "pktradio loopback: %lu frames %lu bytes %lu lost "
+             "%lu batches in %lu msec\n",
+             (unsigned long)priv->lo_nframes,
+             (unsigned long)priv->lo_nbytes,
+             (unsigned long)priv->lo_ndropped,
+             (unsigned long)priv->lo_nbatches,
+             (unsigned long)TICK2MSEC(now - priv->lo_stattime));
+    }
+
+  priv->lo_stattime = now;
+  priv->lo_nframes  = 0;
+  priv->lo_nbytes   = 0;
+  priv->lo_ndropped = 0;
+  priv->lo_nbatches = 0;
+}
+#endif
+
 /****************************************************************************
  * Name: lo_poll_work
  *
@@ -434,7 +578,13 @@ static void lo_poll_work(FAR void *arg)
 
   /* And perform the poll */
 
-  (void)devif_timer(&priv->lo_radio.r_dev, lo_loopback);
+  (void)devif_timer(&priv->lo_radio.r_dev, lo_txpoll);
+
+#ifdef CONFIG_PKTRADIO_LOOPBACK_STATS
+  /* Report the throughput over the last poll interval */
+
+  lo_report(priv);
+#endif
 
   /* Setup the watchdog poll timer again */
 
@@ -464,16 +614,17 @@ static void lo_poll_expiry(int argc, wdparm_t arg, ...)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)arg;
 
-  if (!work_available(&priv->lo_work) || priv->lo_head != NULL)
+  if (!work_available(&priv->lo_work))
     {
+      /* A TX poll is already pending.  Just restart the timer. */
+
       nwarn("WARNING: lo_work NOT available\n");
-      priv->lo_pending = true;
+      (void)wd_start(priv->lo_polldog, LO_WDDELAY, lo_poll_expiry, 1, priv);
     }
   else
     {
       /* Schedule to perform the interrupt processing on the worker thread. */
 
-      priv->lo_pending = false;
       work_queue(LPBKWORK, &priv->lo_work, lo_poll_work, priv, 0);
     }
 }
@@ -599,7 +750,7 @@ static void lo_txavail_work(FAR void *arg)
 
       /* Then perform the poll */
 
-      (void)devif_poll(&priv->lo_radio.r_dev, lo_loopback);
+      (void)devif_poll(&priv->lo_radio.r_dev, lo_txpoll);
     }
 
   net_unlock();
@@ -630,21 +781,23 @@ static int lo_txavail(FAR struct net_driver_s *dev)
 
   ninfo("Available: %u\n", work_available(&priv->lo_work));
 
-  /* Is our single work structure available?  It may not be if there are
-   * pending actions and we will have to ignore the Tx availability
-   * action.
+  /* If frames are queued for loopback, the loopback work will perform the
+   * poll when they have been returned to the network.
    */
 
-  if (!work_available(&priv->lo_work) || priv->lo_head != NULL)
+  if (priv->lo_head != NULL)
     {
-      nwarn("WARNING: lo_work NOT available\n");
       priv->lo_pending = true;
     }
-  else
+
+  /* Otherwise, is our poll work structure available?  It may not be if a
+   * poll is already pending.  That poll will pick up the new TX data.
+   */
+
+  else if (work_available(&priv->lo_work))
     {
       /* Schedule to perform the interrupt processing on the worker thread. */
 
-      priv->lo_pending = false;
       work_queue(LPBKWORK, &priv->lo_work, lo_txavail_work, priv, 0);
     }
 
@@ -899,13 +1052,28 @@ static int lo_req_data(FAR struct radio_driver_s *netdev,
     {
       /* Increment statistics */
 
-      NETDEV_RXPACKETS(&priv->lo_radio.r_dev);
+      NETDEV_TXPACKETS(&priv->lo_radio.r_dev);
 
       /* Remove the IOB from the queue */
 
       framelist     = iob->io_flink;
       iob->io_flink = NULL;
 
+#if LO_LOSS > 0
+      /* Simulate frame loss.  A private generator keeps the loss pattern
+       * reproducible from run to run.
+       */
+
+      priv->lo_seed = priv->lo_seed * 1103515245 + 12345;
+      if (((priv->lo_seed >> 16) % 1000) < LO_LOSS)
+        {
+          ninfo("Dropping frame IOB %p\n", iob);
+          LO_STAT(priv, lo_ndropped, 1);
+          iob_free(iob);
+          continue;
+        }
+#endif
+
       ninfo("Queuing frame IOB %p\n", iob);
 
       /* Just zero the MAC header for test purposes */
@@ -927,9 +1095,16 @@ static int lo_req_data(FAR struct radio_driver_s *netdev,
       priv->lo_tail = iob;
     }
 
-  /* Schedule to serialize the poll on the worker thread. */
+  /* Schedule to serialize the loopback on the worker thread.  Frames that
+   * are queued before the work runs are looped back in the same batch.
+   */
+
+  if (priv->lo_head != NULL && work_available(&priv->lo_lbwork))
+    {
+      work_queue(LPBKWORK, &priv->lo_lbwork, lo_loopback_work, priv,
+                 LO_LATENCY);
+    }
 
-  work_queue(LPBKWORK, &priv->lo_work, lo_loopback_work, priv, 0);
   return OK;
 }
 
@@ -1018,6 +1193,12 @@ int pktradio_loopback(void)
   /* Initialize the driver structure */
 
   memset(priv, 0, sizeof(struct lo_driver_s));
+#if LO_LOSS > 0
+  priv->lo_seed       = 1;
+#endif
+#ifdef CONFIG_PKTRADIO_LOOPBACK_STATS
+  priv->lo_stattime   = clock_systimer();
+#endif
 
   radio               = &priv->lo_radio;
   dev                 = &radio->r_dev;